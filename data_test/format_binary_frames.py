@@ -5,16 +5,68 @@ from __future__ import annotations
 
 import argparse
 import csv
+import mmap
 import struct
 import sys
+import zlib
 from pathlib import Path
 from typing import Any, Iterable, Optional, Sequence
 
 HEADER_STRUCT = struct.Struct("<4sHHII")
 HEADER_MAGIC = b"RADR"
-SUPPORTED_VERSION = 1
+# Version 2 appends sample_format, flags and payload_size to the v1 header.
+HEADER_V2_EXT_STRUCT = struct.Struct("<HHI")
+# Version 3 appends the frame timestamp (us, wraps at 2**32) and the payload CRC-32.
+HEADER_V3_EXT_STRUCT = struct.Struct("<II")
+# Version 4 appends the region of interest of the sensor frame: rx_mask,
+# first_chirp, num_chirps, first_sample, num_samples (rx_mask 0 otherwise).
+HEADER_V4_EXT_STRUCT = struct.Struct("<HHHHH")
+SUPPORTED_VERSIONS = (1, 2, 3, 4)
+HEADER_SIZES = {1: HEADER_STRUCT.size}
+HEADER_SIZES[2] = HEADER_SIZES[1] + HEADER_V2_EXT_STRUCT.size
+HEADER_SIZES[3] = HEADER_SIZES[2] + HEADER_V3_EXT_STRUCT.size
+HEADER_SIZES[4] = HEADER_SIZES[3] + HEADER_V4_EXT_STRUCT.size
 SUPPORTED_SAMPLE_SIZES = {1: "B", 2: "H", 4: "I"}
 
+SAMPLE_FORMAT_U16LE = 0
+SAMPLE_FORMAT_PACKED12 = 1
+SAMPLE_FORMAT_RANGE_CINT16 = 2
+SAMPLE_FORMAT_RANGE_MAG_U16 = 3
+SAMPLE_FORMAT_PRESENCE = 4
+SAMPLE_FORMAT_CONTROL = 5
+RANGE_FORMATS = (SAMPLE_FORMAT_RANGE_CINT16, SAMPLE_FORMAT_RANGE_MAG_U16)
+# present, changed, range_bin, distance_mm, level (src/main.c presence_event_t)
+PRESENCE_EVENT_STRUCT = struct.Struct("<BBHHH")
+# request_id, opcode, status (src/control.h control_response_header_t)
+CONTROL_RESPONSE_STRUCT = struct.Struct("<HBB")
+# Fractional bits of the firmware's range bins (src/range_fft.h)
+RANGE_FFT_FRAC_BITS = 4
+
+# Header flags
+FLAG_DELTA_RICE = 0x0001
+FLAG_FIFO_OVERFLOW = 0x0002
+# The motion trigger of a pre-trigger session fired on this frame
+FLAG_TRIGGER = 0x0004
+# Flags that vary from frame to frame without changing the payload layout
+FLAG_PER_FRAME = FLAG_FIFO_OVERFLOW | FLAG_TRIGGER
+# log2 of the chirps averaged (bits 8-11) and of the fast-time decimation (bits 12-15)
+FLAG_CHIRP_SHIFT_POS = 8
+FLAG_SAMPLE_SHIFT_POS = 12
+FLAG_SHIFT_MASK = 0x0F
+
+# Indexed capture container written by radr_capture --indexed / radr_index
+# (data_test/radr_capture/radr_file.h): file header, then header_offset of
+# each radr_index_entry_t
+CONTAINER_MAGIC = b"RCAP"
+CONTAINER_HEADER_STRUCT = struct.Struct("<4sHHIIQQQ24x")
+CONTAINER_ENTRY_STRUCT = struct.Struct("<Q24x")
+
+# Parameters of the firmware's src/rice_codec.h bitstream
+RICE_K_BITS = 4
+RICE_ESCAPE = 24
+RICE_RAW_BITS = 13
+RICE_MIDSCALE = 2048
+
 
 class FrameDecodeError(RuntimeError):
     """Raised when a captured log cannot be decoded."""
@@ -27,7 +79,111 @@ def _read_exact(stream, size: int) -> bytes:
     return data
 
 
-def _unpack_samples(payload: bytes, sample_size: int, sample_count: int, signed: bool) -> Sequence[int]:
+def _unpack_packed12(payload: bytes, sample_count: int) -> list[int]:
+    """Decode two 12-bit samples per three bytes (strata Packed12 layout)."""
+
+    expected = (sample_count + 1) // 2 * 3
+    if len(payload) != expected:
+        raise FrameDecodeError(
+            f"Packed12 payload size mismatch: expected {expected} bytes, got {len(payload)}"
+        )
+
+    b0 = payload[0::3]
+    b1 = payload[1::3]
+    b2 = payload[2::3]
+    samples = [0] * (len(b0) * 2)
+    samples[0::2] = [(x << 4) | (y >> 4) for x, y in zip(b0, b1)]
+    samples[1::2] = [((y & 0x0F) << 8) | z for y, z in zip(b1, b2)]
+    return samples[:sample_count]
+
+
+def _decode_delta_rice(
+    payload: bytes, sample_count: int, rx_antennas: int, samples_per_chirp: int
+) -> list[int]:
+    """Invert the firmware's chirp-to-chirp delta + Rice coding (src/rice_codec.c)."""
+
+    lanes = max(rx_antennas, 1)
+    chirp_stride = lanes * samples_per_chirp if samples_per_chirp > 0 else sample_count
+    if chirp_stride <= 0 or sample_count % chirp_stride != 0:
+        raise FrameDecodeError("Compressed frame does not match --rx-antennas/--samples-per-chirp")
+
+    bits = "".join(f"{byte:08b}" for byte in payload)
+    pos = 0
+    samples = [0] * sample_count
+
+    try:
+        for first in range(0, sample_count, chirp_stride):
+            k = int(bits[pos : pos + RICE_K_BITS], 2)
+            pos += RICE_K_BITS
+
+            for i in range(first, first + chirp_stride):
+                zero = bits.find("0", pos, pos + RICE_ESCAPE)
+                if zero == -1:
+                    pos += RICE_ESCAPE
+                    value = int(bits[pos : pos + RICE_RAW_BITS], 2)
+                    pos += RICE_RAW_BITS
+                else:
+                    value = (zero - pos) << k
+                    pos = zero + 1
+                    if k:
+                        value |= int(bits[pos : pos + k], 2)
+                        pos += k
+
+                residual = (value >> 1) ^ -(value & 1)
+
+                if i >= chirp_stride:
+                    prediction = samples[i - chirp_stride]
+                elif i >= lanes:
+                    prediction = samples[i - lanes]
+                else:
+                    prediction = RICE_MIDSCALE
+
+                samples[i] = prediction + residual
+    except ValueError as exc:
+        raise FrameDecodeError("Truncated compressed payload") from exc
+
+    return samples
+
+
+def _unpack_range_bins(payload: bytes, bin_count: int, sample_format: int) -> list[Any]:
+    """Decode range FFT bins into ADC counts (complex or magnitude)."""
+
+    scale = 1.0 / (1 << RANGE_FFT_FRAC_BITS)
+
+    if sample_format == SAMPLE_FORMAT_RANGE_CINT16:
+        expected = bin_count * 4
+        if len(payload) != expected:
+            raise FrameDecodeError(
+                f"Range bin payload size mismatch: expected {expected} bytes, got {len(payload)}"
+            )
+        values = struct.unpack(f"<{bin_count * 2}h", payload)
+        return [complex(re * scale, im * scale) for re, im in zip(values[0::2], values[1::2])]
+
+    expected = bin_count * 2
+    if len(payload) != expected:
+        raise FrameDecodeError(
+            f"Range bin payload size mismatch: expected {expected} bytes, got {len(payload)}"
+        )
+    return [value * scale for value in struct.unpack(f"<{bin_count}H", payload)]
+
+
+def _unpack_samples(
+    payload: bytes,
+    sample_size: int,
+    sample_count: int,
+    signed: bool,
+    sample_format: int = SAMPLE_FORMAT_U16LE,
+) -> Sequence[int]:
+    if sample_format == SAMPLE_FORMAT_PACKED12:
+        # 12-bit values are identical as signed or unsigned 16-bit integers.
+        return _unpack_packed12(payload, sample_count)
+
+    if sample_format in RANGE_FORMATS:
+        return _unpack_range_bins(payload, sample_count, sample_format)
+
+    if sample_format != SAMPLE_FORMAT_U16LE:
+        raise FrameDecodeError(f"Unsupported sample format: {sample_format}")
+
     expected = sample_size * sample_count
     if len(payload) != expected:
         raise FrameDecodeError(
@@ -44,11 +200,26 @@ def _unpack_samples(payload: bytes, sample_size: int, sample_count: int, signed:
     return struct.unpack(f"<{sample_count}{type_char}", payload)
 
 
+def _write_presence_text(handle, frame_index: int, payload: bytes) -> None:
+    if len(payload) != PRESENCE_EVENT_STRUCT.size:
+        raise FrameDecodeError(
+            f"Presence event size mismatch: expected {PRESENCE_EVENT_STRUCT.size} bytes, got {len(payload)}"
+        )
+
+    present, changed, range_bin, distance_mm, level = PRESENCE_EVENT_STRUCT.unpack(payload)
+    state = "present" if present else "absent"
+    marker = " (changed)" if changed else ""
+    handle.write(
+        f"Frame {frame_index}: {state}{marker}, bin {range_bin}, {distance_mm / 1000:.3f} m, "
+        f"level {level / (1 << RANGE_FFT_FRAC_BITS):.2f}\n"
+    )
+
+
 def _write_frame_text(
     handle,
     *,
     frame_index: int,
-    samples: Sequence[int],
+    samples: Sequence[Any],
     rx_antennas: int,
     samples_per_chirp: int,
 ) -> None:
@@ -97,7 +268,7 @@ def _write_frame_text(
 def _maybe_write_csv(
     csv_writer: Optional[Any],
     frame_index: int,
-    samples: Sequence[int],
+    samples: Sequence[Any],
     rx_antennas: int,
     samples_per_chirp: int,
 ) -> None:
@@ -131,27 +302,280 @@ def _maybe_write_csv(
             cursor += rx_antennas
 
 
-def _iter_frames(stream) -> Iterable[tuple[int, int, int, int, bytes]]:
+Roi = tuple[int, int, int, int, int]
+FrameTuple = tuple[int, int, int, int, int, Optional[int], bool, Optional[Roi], bytes]
+
+
+def _iter_frames(stream) -> Iterable[FrameTuple]:
+    """Yield (frame_index, sample_size, sample_count, sample_format, flags,
+    timestamp_us, crc_ok, roi, payload) per frame; v1/v2 frames have no
+    timestamp and always pass the CRC check, frames before v4 have no roi."""
+    if stream.peek(len(CONTAINER_MAGIC))[: len(CONTAINER_MAGIC)] == CONTAINER_MAGIC:
+        yield from _iter_container_frames(stream)
+        return
+
     while True:
-        header_bytes = stream.read(HEADER_STRUCT.size)
-        if not header_bytes:
+        frame = _read_frame(stream)
+        if frame is None:
             break
-        if len(header_bytes) != HEADER_STRUCT.size:
-            raise FrameDecodeError("Trailing bytes detected while reading header")
+        yield frame
+
 
-        magic, version, sample_size, frame_index, sample_count = HEADER_STRUCT.unpack(
-            header_bytes
+def _container_index(header_bytes: bytes) -> tuple[int, int]:
+    """(index_offset, frame_count) of an .rcap container header."""
+    _, version, _, _, _, _, index_offset, frame_count = CONTAINER_HEADER_STRUCT.unpack_from(header_bytes)
+    if version != 1:
+        raise FrameDecodeError(f"Unsupported container version {version}")
+    if index_offset == 0:
+        raise FrameDecodeError("Container has no index; run 'radr_index recover' on it first")
+    return index_offset, frame_count
+
+
+def _iter_container_frames(stream) -> Iterable[FrameTuple]:
+    """Yield the frames of an .rcap container in index order."""
+    index_offset, frame_count = _container_index(_read_exact(stream, CONTAINER_HEADER_STRUCT.size))
+
+    stream.seek(index_offset)
+    index = _read_exact(stream, CONTAINER_ENTRY_STRUCT.size * frame_count)
+
+    for (header_offset,) in CONTAINER_ENTRY_STRUCT.iter_unpack(index):
+        stream.seek(header_offset)
+        frame = _read_frame(stream)
+        if frame is None:
+            raise FrameDecodeError("Container index points past the end of the file")
+        yield frame
+
+
+def _header_size(data, offset: int = 0) -> int:
+    """Check the fixed part of the frame header at offset; returns the size of
+    the complete header."""
+    magic, version = struct.unpack_from("<4sH", data, offset)
+    if magic != HEADER_MAGIC:
+        raise FrameDecodeError("Bad header magic. Is this a valid capture?")
+    if version not in SUPPORTED_VERSIONS:
+        raise FrameDecodeError(
+            f"Unsupported header version {version}; expected one of {SUPPORTED_VERSIONS}"
         )
+    return HEADER_SIZES[version]
+
+
+def _unpack_header(
+    data, offset: int = 0
+) -> tuple[int, int, int, int, int, int, Optional[int], Optional[int], Optional[Roi]]:
+    """(frame_index, sample_size, sample_count, sample_format, flags,
+    payload_size, timestamp_us, payload_crc, roi) of the complete header at
+    offset. roi is None unless the header describes the region of interest of
+    a sensor frame."""
+    _, version, sample_size, frame_index, sample_count = HEADER_STRUCT.unpack_from(data, offset)
+    offset += HEADER_STRUCT.size
+
+    sample_format = SAMPLE_FORMAT_U16LE
+    flags = 0
+    payload_size = sample_size * sample_count
+
+    if version >= 2:
+        sample_format, flags, payload_size = HEADER_V2_EXT_STRUCT.unpack_from(data, offset)
+        offset += HEADER_V2_EXT_STRUCT.size
+
+    timestamp_us = None
+    payload_crc = None
+
+    if version >= 3:
+        timestamp_us, payload_crc = HEADER_V3_EXT_STRUCT.unpack_from(data, offset)
+        offset += HEADER_V3_EXT_STRUCT.size
+
+    roi = None
+
+    if version >= 4:
+        roi = HEADER_V4_EXT_STRUCT.unpack_from(data, offset)
+        if roi[0] == 0:
+            roi = None
+
+    return frame_index, sample_size, sample_count, sample_format, flags, payload_size, timestamp_us, payload_crc, roi
+
+
+def _frame_geometry(roi: Optional[Roi], rx_antennas: int, samples_per_chirp: int) -> tuple[int, int]:
+    """(rx_antennas, samples_per_chirp) of a frame before averaging and
+    decimation: the region of interest when the header carries one, the
+    command line geometry otherwise."""
+    if roi is None:
+        return rx_antennas, samples_per_chirp
+    return bin(roi[0]).count("1"), roi[4]
+
+
+def _read_frame(stream) -> Optional[FrameTuple]:
+    """Read one frame record; None at the end of the stream."""
+    header_bytes = stream.read(HEADER_STRUCT.size)
+    if not header_bytes:
+        return None
+    if len(header_bytes) != HEADER_STRUCT.size:
+        raise FrameDecodeError("Trailing bytes detected while reading header")
+
+    header_bytes += _read_exact(stream, _header_size(header_bytes) - HEADER_STRUCT.size)
+    (
+        frame_index, sample_size, sample_count, sample_format, flags, payload_size, timestamp_us, payload_crc, roi
+    ) = _unpack_header(header_bytes)
+
+    payload = _read_exact(stream, payload_size)
+    crc_ok = payload_crc is None or zlib.crc32(payload) == payload_crc
+    return frame_index, sample_size, sample_count, sample_format, flags, timestamp_us, crc_ok, roi, payload
+
+
+def _scan_records(data) -> list[tuple[int, int, int, int, int, int, Optional[int], Optional[int], Optional[Roi], int]]:
+    """Walk the frame headers of a mapped capture (raw or .rcap) without
+    touching the payloads. Returns the _unpack_header() fields of every frame
+    plus its payload offset."""
+    offsets = None
+    if data[: len(CONTAINER_MAGIC)] == CONTAINER_MAGIC:
+        index_offset, frame_count = _container_index(data[: CONTAINER_HEADER_STRUCT.size])
+        index_end = index_offset + CONTAINER_ENTRY_STRUCT.size * frame_count
+        if index_end > len(data):
+            raise FrameDecodeError("Unexpected end of file while reading the container index")
+        offsets = [offset for (offset,) in CONTAINER_ENTRY_STRUCT.iter_unpack(data[index_offset:index_end])]
+
+    records = []
+    offset = 0
 
-        if magic != HEADER_MAGIC:
-            raise FrameDecodeError("Bad header magic. Is this a valid capture?")
-        if version != SUPPORTED_VERSION:
-            raise FrameDecodeError(
-                f"Unsupported header version {version}; expected {SUPPORTED_VERSION}"
-            )
+    while True:
+        if offsets is not None:
+            if len(records) == len(offsets):
+                break
+            offset = offsets[len(records)]
+        elif offset == len(data):
+            break
+
+        if len(data) - offset < HEADER_STRUCT.size:
+            raise FrameDecodeError("Trailing bytes detected while reading header")
+        header_size = _header_size(data, offset)
+        if len(data) - offset < header_size:
+            raise FrameDecodeError("Unexpected end of file while reading frame data")
+
+        header = _unpack_header(data, offset)
+        payload_offset = offset + header_size
+        offset = payload_offset + header[5]
+        if offset > len(data):
+            raise FrameDecodeError("Unexpected end of file while reading frame data")
+        records.append(header + (payload_offset,))
 
-        payload = _read_exact(stream, sample_size * sample_count)
-        yield frame_index, sample_size, sample_count, len(payload), payload
+    return records
+
+
+def load_frame_arrays(
+    input_path: Path,
+    *,
+    rx_antennas: int,
+    samples_per_chirp: int,
+    signed: bool = False,
+    limit: Optional[int] = None,
+) -> dict[str, Any]:
+    """Decode the sensor frames of a capture into numpy arrays in bulk.
+
+    The file is memory-mapped, only the headers are parsed in Python and each
+    payload is converted with whole-array operations, so this runs at about
+    disk speed (delta/Rice frames still go through the bit-level decoder).
+    Returns "samples" shaped (frames, rx, chirps, samples): ADC codes, or ADC
+    counts for range frames (complex64 bins / float32 magnitudes), plus the
+    per-frame "frame_index", "timestamp_us" (0 before header version 3),
+    "flags" and "crc_ok" arrays. Rows of frames that fail the CRC check are
+    not meaningful. All frames must share one format and geometry; presence
+    events and control responses are skipped. Frames that carry a region of
+    interest are shaped by it instead of rx_antennas/samples_per_chirp.
+    """
+    try:
+        import numpy as np
+    except ImportError as exc:
+        raise FrameDecodeError("Array output needs numpy (pip install numpy)") from exc
+
+    if rx_antennas <= 0 or samples_per_chirp <= 0:
+        raise FrameDecodeError("Array output needs --rx-antennas and --samples-per-chirp")
+    if input_path.stat().st_size == 0:
+        raise FrameDecodeError("Capture is empty")
+
+    with input_path.open("rb") as handle, mmap.mmap(handle.fileno(), 0, access=mmap.ACCESS_READ) as data:
+        records = [
+            record
+            for record in _scan_records(data)
+            if record[3] not in (SAMPLE_FORMAT_PRESENCE, SAMPLE_FORMAT_CONTROL)
+        ]
+        if limit is not None:
+            records = records[:limit]
+        if not records:
+            raise FrameDecodeError("Capture holds no sensor frames")
+
+        _, sample_size, sample_count, sample_format, flags, payload_size, _, _, roi, _ = records[0]
+        layout = (sample_size, sample_count, sample_format, flags & ~FLAG_PER_FRAME, roi)
+        compressed = bool(flags & FLAG_DELTA_RICE)
+
+        for record in records:
+            if (record[1], record[2], record[3], record[4] & ~FLAG_PER_FRAME, record[8]) != layout or (
+                not compressed and record[5] != payload_size
+            ):
+                raise FrameDecodeError(f"Frame {record[0]} differs in format or geometry from the first frame")
+
+        # Same geometry rules as decode_frames().
+        rx_antennas, samples_per_chirp = _frame_geometry(roi, rx_antennas, samples_per_chirp)
+        values_per_chirp = samples_per_chirp >> ((flags >> FLAG_SAMPLE_SHIFT_POS) & FLAG_SHIFT_MASK)
+        if sample_format in RANGE_FORMATS:
+            values_per_chirp //= 2
+        if values_per_chirp <= 0 or sample_count % (rx_antennas * values_per_chirp) != 0:
+            raise FrameDecodeError("Frames do not match --rx-antennas/--samples-per-chirp")
+        chirps = sample_count // (rx_antennas * values_per_chirp)
+
+        frames = len(records)
+        crc_ok = np.ones(frames, dtype=bool)
+
+        if compressed:
+            samples = np.empty((frames, sample_count), dtype=np.uint16)
+            for row, record in enumerate(records):
+                payload = data[record[9] : record[9] + record[5]]
+                crc_ok[row] = record[7] is None or zlib.crc32(payload) == record[7]
+                if crc_ok[row]:
+                    samples[row] = _decode_delta_rice(payload, sample_count, rx_antennas, values_per_chirp)
+                else:
+                    samples[row] = 0
+        else:
+            payloads = np.empty((frames, payload_size), dtype=np.uint8)
+            for row, record in enumerate(records):
+                payloads[row] = np.frombuffer(data, dtype=np.uint8, count=payload_size, offset=record[9])
+                crc_ok[row] = record[7] is None or zlib.crc32(payloads[row]) == record[7]
+
+            if sample_format == SAMPLE_FORMAT_PACKED12:
+                if payload_size != (sample_count + 1) // 2 * 3:
+                    raise FrameDecodeError("Packed12 payload size does not match the sample count")
+                triplets = payloads.reshape(frames, -1, 3).astype(np.uint16)
+                samples = np.empty((frames, triplets.shape[1] * 2), dtype=np.uint16)
+                samples[:, 0::2] = (triplets[:, :, 0] << 4) | (triplets[:, :, 1] >> 4)
+                samples[:, 1::2] = ((triplets[:, :, 1] & 0x0F) << 8) | triplets[:, :, 2]
+                samples = samples[:, :sample_count]
+            elif sample_format == SAMPLE_FORMAT_RANGE_CINT16:
+                if payload_size != sample_count * 4:
+                    raise FrameDecodeError("Range bin payload size does not match the bin count")
+                pairs = payloads.view("<i2").reshape(frames, sample_count, 2)
+                samples = np.empty((frames, sample_count), dtype=np.complex64)
+                samples.real = pairs[:, :, 0]
+                samples.imag = pairs[:, :, 1]
+                samples *= 1.0 / (1 << RANGE_FFT_FRAC_BITS)
+            elif sample_format == SAMPLE_FORMAT_RANGE_MAG_U16:
+                if payload_size != sample_count * 2:
+                    raise FrameDecodeError("Range bin payload size does not match the bin count")
+                samples = payloads.view("<u2").astype(np.float32) * np.float32(1.0 / (1 << RANGE_FFT_FRAC_BITS))
+            elif sample_format == SAMPLE_FORMAT_U16LE:
+                if sample_size not in SUPPORTED_SAMPLE_SIZES or payload_size != sample_size * sample_count:
+                    raise FrameDecodeError("Payload size does not match the sample count")
+                samples = payloads.view(f"<{'i' if signed else 'u'}{sample_size}")
+            else:
+                raise FrameDecodeError(f"Unsupported sample format: {sample_format}")
+
+        # Firmware order is [chirp][sample][rx].
+        samples = samples.reshape(frames, chirps, values_per_chirp, rx_antennas).transpose(0, 3, 1, 2)
+
+        return {
+            "samples": np.ascontiguousarray(samples),
+            "frame_index": np.array([record[0] for record in records], dtype=np.uint32),
+            "timestamp_us": np.array([record[6] or 0 for record in records], dtype=np.uint32),
+            "flags": np.array([record[4] for record in records], dtype=np.uint16),
+            "crc_ok": crc_ok,
+        }
 
 
 def decode_frames(
@@ -170,7 +594,20 @@ def decode_frames(
         "last_frame": None,
         "bytes": input_path.stat().st_size,
         "samples": 0,
+        "compressed_frames": 0,
+        "range_frames": 0,
+        "presence_events": 0,
+        "presence_changes": 0,
+        "control_responses": 0,
+        "crc_errors": 0,
+        "overflow_frames": 0,
+        "trigger_frames": 0,
+        "reduced_frames": 0,
+        "frame_interval_us": None,
     }
+    first_timestamp = None
+    last_timestamp = None
+    timed_frames = 0
 
     text_handle = open(output_text, "w", encoding="utf-8") if output_text else None
     csv_handle = open(output_csv, "w", encoding="utf-8", newline="") if output_csv else None
@@ -182,29 +619,95 @@ def decode_frames(
             csv_writer.writerow(("frame", "chirp", "sample", "rx", "value"))
 
         with input_path.open("rb") as stream:
-            for frame_idx, sample_size, sample_count, payload_size, payload in _iter_frames(stream):
+            for (
+                frame_idx, sample_size, sample_count, sample_format, flags, timestamp_us, crc_ok, roi, payload
+            ) in _iter_frames(stream):
+                if sample_format == SAMPLE_FORMAT_CONTROL:
+                    # Answers to binary control requests are not sensor frames.
+                    stats["control_responses"] += 1
+                    if text_handle and crc_ok and len(payload) >= CONTROL_RESPONSE_STRUCT.size:
+                        request_id, opcode, status = CONTROL_RESPONSE_STRUCT.unpack_from(payload)
+                        text_handle.write(
+                            f"Control response: request {request_id}, opcode 0x{opcode:02x}, status {status}, "
+                            f"{len(payload) - CONTROL_RESPONSE_STRUCT.size} data bytes\n\n"
+                        )
+                    continue
+
                 stats["frames"] += 1
                 stats["samples"] += sample_count
                 stats["first_frame"] = frame_idx if stats["first_frame"] is None else stats["first_frame"]
                 stats["last_frame"] = frame_idx
 
-                samples = _unpack_samples(payload, sample_size, sample_count, signed=signed)
+                if flags & FLAG_FIFO_OVERFLOW:
+                    stats["overflow_frames"] += 1
+                if flags & FLAG_TRIGGER:
+                    stats["trigger_frames"] += 1
+
+                if timestamp_us is not None:
+                    if first_timestamp is None:
+                        first_timestamp = timestamp_us
+                        last_timestamp = timestamp_us
+                    else:
+                        # Unwrap the 32-bit firmware counter.
+                        last_timestamp += (timestamp_us - last_timestamp) % (1 << 32)
+                    timed_frames += 1
+
+                if not crc_ok:
+                    # Do not decode a payload that was corrupted on the wire.
+                    stats["crc_errors"] += 1
+                    if text_handle:
+                        text_handle.write(f"Frame {frame_idx}: payload CRC mismatch, skipped\n\n")
+                    if limit is not None and stats["frames"] >= limit:
+                        break
+                    continue
+
+                if sample_format == SAMPLE_FORMAT_PRESENCE:
+                    stats["presence_events"] += 1
+                    if len(payload) == PRESENCE_EVENT_STRUCT.size and payload[1]:
+                        stats["presence_changes"] += 1
+                    if text_handle:
+                        _write_presence_text(text_handle, frame_idx, payload)
+                    if limit is not None and stats["frames"] >= limit:
+                        break
+                    continue
+
+                # Averaged frames keep their chirp count per sample; decimated
+                # ones carry fewer samples per chirp.
+                frame_rx_antennas, frame_samples_per_chirp = _frame_geometry(roi, rx_antennas, samples_per_chirp)
+                sample_shift = (flags >> FLAG_SAMPLE_SHIFT_POS) & FLAG_SHIFT_MASK
+                frame_samples_per_chirp >>= sample_shift
+                if (flags >> FLAG_CHIRP_SHIFT_POS) & 0xFF:
+                    stats["reduced_frames"] += 1
+
+                if flags & FLAG_DELTA_RICE:
+                    samples = _decode_delta_rice(payload, sample_count, frame_rx_antennas, frame_samples_per_chirp)
+                    stats["compressed_frames"] += 1
+                else:
+                    samples = _unpack_samples(
+                        payload, sample_size, sample_count, signed=signed, sample_format=sample_format
+                    )
+
+                # Range frames hold the positive half of each chirp's FFT.
+                values_per_chirp = frame_samples_per_chirp
+                if sample_format in RANGE_FORMATS:
+                    values_per_chirp = frame_samples_per_chirp // 2
+                    stats["range_frames"] += 1
 
                 if text_handle:
                     _write_frame_text(
                         text_handle,
                         frame_index=frame_idx,
                         samples=samples,
-                        rx_antennas=rx_antennas,
-                        samples_per_chirp=samples_per_chirp,
+                        rx_antennas=frame_rx_antennas,
+                        samples_per_chirp=values_per_chirp,
                     )
 
                 _maybe_write_csv(
                     csv_writer,
                     frame_idx,
                     samples,
-                    rx_antennas,
-                    samples_per_chirp,
+                    frame_rx_antennas,
+                    values_per_chirp,
                 )
 
                 if limit is not None and stats["frames"] >= limit:
@@ -215,20 +718,29 @@ def decode_frames(
         if csv_handle:
             csv_handle.close()
 
+    if timed_frames > 1:
+        stats["frame_interval_us"] = (last_timestamp - first_timestamp) / (timed_frames - 1)
+
     return stats
 
 
 def parse_args(argv: Optional[Sequence[str]] = None) -> argparse.Namespace:
     parser = argparse.ArgumentParser(
-        description="Decode binary radar frames captured by serial_logger.py",
+        description="Decode binary radar frames captured by serial_logger.py or radr_capture",
     )
-    parser.add_argument("--input", required=True, type=Path, help="Path to the binary capture file.")
+    parser.add_argument("--input", required=True, type=Path, help="Path to the binary capture file (raw or .rcap).")
     parser.add_argument(
         "--output-text", type=Path, help="Optional destination for a human-readable dump.",
     )
     parser.add_argument(
         "--output-csv", type=Path, help="Optional destination for a CSV dump (frame, chirp, sample, rx, value).",
     )
+    parser.add_argument(
+        "--output-npz",
+        type=Path,
+        help="Optional destination for numpy arrays (samples as frames x rx x chirps x samples, "
+        "frame_index, timestamp_us, flags, crc_ok); decodes in bulk and needs numpy.",
+    )
     parser.add_argument(
         "--rx-antennas",
         type=int,
@@ -266,10 +778,34 @@ def main(argv: Optional[Sequence[str]] = None) -> int:
         sys.stderr.write(f"Input file not found: {args.input}\n")
         return 1
 
-    if args.summary_only and (args.output_text or args.output_csv):
+    if args.summary_only and (args.output_text or args.output_csv or args.output_npz):
         sys.stderr.write("--summary-only cannot be combined with output options.\n")
         return 1
 
+    if args.output_npz:
+        # Bulk path; text and CSV dumps below stay available as the slow path.
+        try:
+            arrays = load_frame_arrays(
+                args.input,
+                rx_antennas=args.rx_antennas,
+                samples_per_chirp=args.samples_per_chirp,
+                signed=args.signed,
+                limit=args.limit,
+            )
+            import numpy as np
+
+            np.savez(args.output_npz, **arrays)
+        except FrameDecodeError as exc:
+            sys.stderr.write(f"Decode failed: {exc}\n")
+            return 1
+
+        sys.stderr.write(
+            f"Wrote {arrays['samples'].shape[0]} frames, samples {arrays['samples'].shape} "
+            f"{arrays['samples'].dtype}, {int((~arrays['crc_ok']).sum())} CRC errors to {args.output_npz}\n"
+        )
+        if not args.output_text and not args.output_csv:
+            return 0
+
     try:
         stats = decode_frames(
             args.input,
@@ -290,8 +826,19 @@ def main(argv: Optional[Sequence[str]] = None) -> int:
         f"First frame index: {stats['first_frame']}",
         f"Last frame index: {stats['last_frame']}",
         f"Input bytes: {stats['bytes']}",
+        f"Compressed frames: {stats['compressed_frames']}",
+        f"Range FFT frames: {stats['range_frames']}",
+        f"Presence events: {stats['presence_events']} ({stats['presence_changes']} state changes)",
+        f"Control responses: {stats['control_responses']}",
+        f"Payload CRC errors: {stats['crc_errors']}",
+        f"Frames after FIFO overflow: {stats['overflow_frames']}",
+        f"Trigger frames: {stats['trigger_frames']}",
+        f"Averaged/decimated frames: {stats['reduced_frames']}",
     ]
 
+    if stats["frame_interval_us"] is not None:
+        summary.append(f"Mean frame interval: {stats['frame_interval_us'] / 1000:.3f} ms")
+
     if not args.summary_only and args.output_text is None and args.output_csv is None:
         for line in summary:
             print(line)
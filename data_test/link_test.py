@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+"""Run the firmware's link test and check every byte of the synthetic frames.
+
+'start test RATE' makes the board send frames of a known pattern at RATE
+frames per second without touching the sensor (src/link_test.h). This script
+requests such a session, regenerates each frame's pattern, and reports
+sustained throughput, lost frames and the jitter of frame arrival, so the
+highest frame rate a board and cable carry without loss can be found.
+"""
+
+from __future__ import annotations
+
+import argparse
+import statistics
+import struct
+import sys
+import time
+import zlib
+from typing import Optional
+
+import serial
+
+from format_binary_frames import (
+    FLAG_DELTA_RICE,
+    FLAG_FIFO_OVERFLOW,
+    HEADER_STRUCT,
+    SAMPLE_FORMAT_CONTROL,
+    SAMPLE_FORMAT_PACKED12,
+    FrameDecodeError,
+    _decode_delta_rice,
+    _header_size,
+    _unpack_header,
+    _unpack_packed12,
+)
+from serial_logger import (
+    BAUD_CANDIDATES,
+    _align_stream,
+    _fill_buffer,
+    _negotiate_baud,
+    _parse_rates,
+    _parse_window,
+)
+
+# Pattern of src/link_test.h: Galois LFSR seeded with frame_index ^ SEED,
+# sample i = (state after i + 1 steps + i) & SAMPLE_MASK.
+LFSR_TAPS = 0xB400
+LFSR_SEED = 0xACE1
+LFSR_PERIOD = 0xFFFF
+SAMPLE_MASK = 0x0FFF
+MAX_RATE_HZ = 10000
+
+
+class LinkPattern:
+    """Expected samples of a link test frame. The LFSR runs through all
+    65535 non-zero states, so one pass over the cycle serves every seed."""
+
+    def __init__(self) -> None:
+        self._cycle = [0] * LFSR_PERIOD
+        self._position = [0] * (LFSR_PERIOD + 1)
+        state = LFSR_SEED
+        for step in range(LFSR_PERIOD):
+            self._cycle[step] = state
+            self._position[state] = step
+            state = (state >> 1) ^ (LFSR_TAPS if state & 1 else 0)
+
+    def samples(self, frame_index: int, first: int, count: int) -> list[int]:
+        seed = (frame_index ^ LFSR_SEED) & 0xFFFF or LFSR_SEED
+        start = self._position[seed] + 1
+        cycle = self._cycle
+        return [(cycle[(start + i) % LFSR_PERIOD] + i) & SAMPLE_MASK for i in range(first, first + count)]
+
+
+def _decode(payload: bytes, sample_count: int, sample_format: int, flags: int, roi) -> list[int]:
+    if flags & FLAG_DELTA_RICE:
+        return _decode_delta_rice(payload, sample_count, bin(roi[0]).count("1"), roi[4])
+    if sample_format == SAMPLE_FORMAT_PACKED12:
+        return _unpack_packed12(payload, sample_count)
+    if len(payload) != sample_count * 2:
+        raise FrameDecodeError("Payload size does not match header metadata.")
+    return list(struct.unpack(f"<{sample_count}H", payload))
+
+
+def _interval_summary(name: str, intervals_us: list[float], nominal_us: float) -> str:
+    if len(intervals_us) < 2:
+        return f"{name}: not enough frames"
+    mean = statistics.fmean(intervals_us)
+    return (
+        f"{name}: mean {mean / 1000:.3f} ms (nominal {nominal_us / 1000:.3f} ms), "
+        f"std {statistics.pstdev(intervals_us) / 1000:.3f} ms, "
+        f"min {min(intervals_us) / 1000:.3f} ms, max {max(intervals_us) / 1000:.3f} ms"
+    )
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Measure the UART link with the firmware's synthetic frames.")
+    parser.add_argument("--port", required=True, help="Serial port connected to the board (e.g. COM8 or /dev/ttyUSB0).")
+    parser.add_argument(
+        "--baud",
+        type=int,
+        default=115200,
+        help="UART baud rate the firmware runs at now: STREAM_UART_BAUDRATE after reset (default: 115200).",
+    )
+    parser.add_argument(
+        "--negotiate-baud",
+        nargs="?",
+        const=BAUD_CANDIDATES,
+        type=_parse_rates,
+        metavar="RATE[,RATE...]",
+        help="Before the test, switch the board and the port to the first of these rates that passes the "
+        f"firmware's verify exchange (default list: {','.join(map(str, BAUD_CANDIDATES))}).",
+    )
+    parser.add_argument("--rate", type=int, required=True, help=f"Frames per second to request (1-{MAX_RATE_HZ}).")
+    parser.add_argument(
+        "--frames",
+        type=int,
+        default=1000,
+        help="Frames to request; 0 runs until interrupted (default: 1000).",
+    )
+    parser.add_argument(
+        "--format",
+        choices=("u16", "packed12"),
+        help="Payload encoding to request from the firmware (default: firmware default).",
+    )
+    parser.add_argument("--compress", action="store_true", help="Request lossless delta/Rice compressed payloads.")
+    parser.add_argument(
+        "--chirps",
+        type=_parse_window,
+        help="Send only COUNT chirps of each frame, from chirp FIRST, to vary the frame size (default: all).",
+    )
+    parser.add_argument("--timeout", type=float, default=0.1, help="Serial read timeout in seconds (default: 0.1).")
+    parser.add_argument(
+        "--report-interval",
+        type=float,
+        default=1.0,
+        help="Seconds between progress lines on stderr; 0 disables them (default: 1).",
+    )
+    args = parser.parse_args()
+
+    if not 1 <= args.rate <= MAX_RATE_HZ:
+        parser.error(f"--rate must be between 1 and {MAX_RATE_HZ}")
+    if args.frames < 0:
+        parser.error("--frames must be >= 0")
+
+    command = ["start"]
+    if args.frames:
+        command.append(str(args.frames))
+    command.extend(("test", str(args.rate)))
+    if args.format:
+        command.append(args.format)
+    if args.compress:
+        command.append("rice")
+    if args.chirps is not None:
+        command.extend(("chirps", f"{args.chirps[0]}:{args.chirps[1]}"))
+
+    pattern = LinkPattern()
+    nominal_us = 1e6 / args.rate
+    frames = 0
+    lost = 0
+    overflow_frames = 0
+    crc_errors = 0
+    bad_frames = 0
+    bad_samples = 0
+    wire_bytes = 0
+    last_index: Optional[int] = None
+    last_timestamp: Optional[int] = None
+    last_arrival: Optional[float] = None
+    device_intervals: list[float] = []
+    arrival_intervals: list[float] = []
+    first_arrival = 0.0
+    last_report = 0.0
+
+    try:
+        with serial.Serial(args.port, baudrate=args.baud, timeout=args.timeout) as ser:
+            ser.reset_input_buffer()
+            ser.reset_output_buffer()
+            if args.negotiate_baud:
+                _negotiate_baud(ser, args.negotiate_baud)
+                ser.reset_input_buffer()
+            ser.write((" ".join(command) + "\r\n").encode("ascii"))
+            ser.flush()
+
+            status_text, buffer = _align_stream(ser)
+            if status_text:
+                sys.stderr.write(status_text if status_text.endswith("\n") else status_text + "\n")
+            sys.stderr.write(f"Link test: {' '.join(command)} at {ser.baudrate} baud\n")
+
+            try:
+                while not args.frames or frames < args.frames:
+                    _fill_buffer(ser, buffer, HEADER_STRUCT.size)
+                    header_size = _header_size(buffer)
+                    _fill_buffer(ser, buffer, header_size)
+                    (
+                        frame_index, _, sample_count, sample_format, flags, payload_size, timestamp_us, payload_crc, roi
+                    ) = _unpack_header(buffer)
+                    _fill_buffer(ser, buffer, header_size + payload_size)
+                    arrival = time.perf_counter()
+                    payload = bytes(buffer[header_size:header_size + payload_size])
+                    del buffer[:header_size + payload_size]
+
+                    if sample_format == SAMPLE_FORMAT_CONTROL:
+                        continue
+                    if roi is None or timestamp_us is None:
+                        raise FrameDecodeError("Link test frames need a version 4 header.")
+
+                    if frames == 0:
+                        first_arrival = arrival
+                        last_report = arrival
+                    else:
+                        wire_bytes += header_size + payload_size
+                        arrival_intervals.append((arrival - last_arrival) * 1e6)
+                        device_intervals.append((timestamp_us - last_timestamp) & 0xFFFFFFFF)
+                    frames += 1
+
+                    if last_index is not None and frame_index != last_index + 1:
+                        lost += (frame_index - last_index - 1) & 0xFFFFFFFF
+                    if flags & FLAG_FIFO_OVERFLOW:
+                        overflow_frames += 1
+                    last_index = frame_index
+                    last_timestamp = timestamp_us
+                    last_arrival = arrival
+
+                    if payload_crc is not None and zlib.crc32(payload) != payload_crc:
+                        crc_errors += 1
+                        bad_frames += 1
+                        continue
+
+                    # Only whole chirps of every antenna are cut from a test
+                    # frame, so the region is one run of the pattern.
+                    chirp_samples = bin(roi[0]).count("1") * roi[4]
+                    expected = pattern.samples(frame_index, roi[1] * chirp_samples, sample_count)
+                    try:
+                        received = _decode(payload, sample_count, sample_format, flags, roi)
+                    except FrameDecodeError:
+                        received = []
+                    mismatches = sum(1 for a, b in zip(received, expected) if a != b)
+                    mismatches += abs(len(expected) - len(received))
+                    if mismatches:
+                        bad_frames += 1
+                        bad_samples += mismatches
+
+                    if args.report_interval > 0 and arrival - last_report >= args.report_interval:
+                        elapsed = arrival - first_arrival
+                        sys.stderr.write(
+                            f"{frames} frames, {wire_bytes / elapsed:.0f} B/s, {lost} lost, {bad_frames} bad\n"
+                        )
+                        last_report = arrival
+            except KeyboardInterrupt:
+                sys.stderr.write("Link test interrupted by user.\n")
+            finally:
+                try:
+                    ser.write(b"stop\r\n")
+                    ser.flush()
+                except serial.SerialException:
+                    pass
+    except serial.SerialException as exc:
+        sys.stderr.write(f"Serial error: {exc}\n")
+        return 1
+    except FrameDecodeError as exc:
+        sys.stderr.write(f"Stream error: {exc}\n")
+        return 1
+
+    elapsed = (last_arrival - first_arrival) if frames > 1 else 0.0
+    summary = [
+        f"Frames received: {frames}",
+        f"Frames lost: {lost} ({overflow_frames} frames marked after a board-side drop)",
+        f"Frames with errors: {bad_frames} ({crc_errors} CRC mismatches, {bad_samples} wrong samples)",
+    ]
+    if elapsed > 0:
+        summary.append(
+            f"Throughput: {wire_bytes / elapsed:.0f} B/s, {(frames - 1) / elapsed:.2f} frames/s "
+            f"({args.rate} requested)"
+        )
+    summary.append(_interval_summary("Device frame interval", device_intervals, nominal_us))
+    summary.append(_interval_summary("Host arrival interval", arrival_intervals, nominal_us))
+    print("\n".join(summary))
+
+    return 0 if frames and not lost and not bad_frames else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,800 @@
+/* Native capture of the firmware's RADR binary stream.
+
+   A reader thread pulls the serial port (ifxComPort from the radar SDK) into
+   a lock-free single-producer/single-consumer byte ring in large reads; a
+   writer thread parses frames straight out of the ring, verifies them and
+   writes them to the output file. The file holds the same header + payload
+   records serial_logger.py writes, or with --indexed an .rcap container
+   (radr_file.h); format_binary_frames.py decodes both. With --publish it
+   also serves every record to local subscribers through a shared memory
+   ring (radr_shm.h), so one serial reader feeds several consumers. */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ifxComPort/COMPort.h"
+
+#include "radr_file.h"
+#include "radr_metadata.h"
+#include "radr_shm.h"
+
+namespace {
+
+/*******************************************************************************
+* Stream format (src/main.c binary_frame_header_t)
+*******************************************************************************/
+constexpr uint8_t header_magic[4] = {'R', 'A', 'D', 'R'};
+constexpr size_t header_v1_size = 16;
+constexpr size_t header_v2_size = 24;
+constexpr size_t header_v3_size = 32;
+constexpr size_t header_v4_size = 42;
+
+constexpr uint16_t sample_format_control = 5;
+constexpr uint16_t flag_fifo_overflow = 0x0002;
+
+constexpr uint32_t default_baudrate = 115200;
+constexpr size_t default_ring_mib = 16;
+constexpr size_t read_chunk_bytes = 16 * 1024;
+constexpr uint32_t read_timeout_ms = 10;
+constexpr size_t metadata_max_bytes = 4096;
+constexpr uint32_t default_shm_slots = 64;
+constexpr uint32_t default_shm_slot_kib = 128;
+constexpr uint32_t default_shm_block_ms = 1000;
+
+struct frame_header_t
+{
+    uint16_t version;
+    uint32_t frame_index;
+    uint16_t sample_format;
+    uint16_t flags;
+    uint32_t payload_size;
+    uint32_t payload_crc32;
+    size_t size;            // bytes of the header on the wire
+};
+
+uint16_t get_u16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/* Bytes of a header of the given version, 0 for a version this tool does
+   not know. */
+size_t header_size(uint16_t version)
+{
+    switch (version)
+    {
+        case 1:
+            return header_v1_size;
+        case 2:
+            return header_v2_size;
+        case 3:
+            return header_v3_size;
+        case 4:
+            return header_v4_size;
+        default:
+            return 0;
+    }
+}
+
+/* Parses a complete header of a known version. */
+void parse_header(const uint8_t* p, frame_header_t& header)
+{
+    header.version = get_u16(p + 4);
+
+    const uint16_t sample_size = get_u16(p + 6);
+    const uint32_t sample_count = get_u32(p + 12);
+
+    header.frame_index = get_u32(p + 8);
+    header.sample_format = 0;
+    header.flags = 0;
+    header.payload_size = sample_size * sample_count;
+    header.payload_crc32 = 0;
+    header.size = header_v1_size;
+
+    if (header.version >= 2)
+    {
+        header.sample_format = get_u16(p + 16);
+        header.flags = get_u16(p + 18);
+        header.payload_size = get_u32(p + 20);
+        header.size = header_v2_size;
+    }
+
+    if (header.version >= 3)
+    {
+        header.payload_crc32 = get_u32(p + 28);
+        header.size = header_v3_size;
+    }
+
+    if (header.version >= 4)
+    {
+        header.size = header_v4_size;
+    }
+}
+
+/*******************************************************************************
+* Byte ring
+*******************************************************************************/
+/* Lock-free byte ring between one producer and one consumer thread. head and
+   tail are free-running byte counters, so (head - tail) is the fill level.
+   Both sides work on contiguous spans inside the ring, so data is copied
+   only by the port read and the file write. */
+class ByteRing
+{
+public:
+    explicit ByteRing(size_t capacity) :
+        m_buffer(capacity),
+        m_mask(capacity - 1)
+    {
+    }
+
+    size_t capacity() const
+    {
+        return m_buffer.size();
+    }
+
+    // producer: largest contiguous free span
+    size_t writable(uint8_t** data)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        const size_t free_bytes = capacity() - (head - tail);
+        const size_t offset = head & m_mask;
+
+        *data = &m_buffer[offset];
+        return std::min(free_bytes, capacity() - offset);
+    }
+
+    void commit(size_t count)
+    {
+        m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // consumer
+    size_t readable() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    uint8_t at(size_t offset) const
+    {
+        return m_buffer[(m_tail.load(std::memory_order_relaxed) + offset) & m_mask];
+    }
+
+    /* Contiguous span of readable data starting offset bytes in, at most
+       count bytes. */
+    size_t span(size_t offset, size_t count, const uint8_t** data) const
+    {
+        const size_t start = (m_tail.load(std::memory_order_relaxed) + offset) & m_mask;
+
+        *data = &m_buffer[start];
+        return std::min(count, capacity() - start);
+    }
+
+    void copy_out(size_t offset, uint8_t* dst, size_t count) const
+    {
+        while (count > 0)
+        {
+            const uint8_t* data;
+            const size_t n = span(offset, count, &data);
+
+            std::memcpy(dst, data, n);
+            dst += n;
+            offset += n;
+            count -= n;
+        }
+    }
+
+    void release(size_t count)
+    {
+        m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    std::vector<uint8_t> m_buffer;
+    const size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head {0};
+    alignas(64) std::atomic<size_t> m_tail {0};
+};
+
+/*******************************************************************************
+* Capture
+*******************************************************************************/
+struct options_t
+{
+    std::string port;
+    std::string output;
+    uint32_t baudrate = default_baudrate;
+    uint32_t frames = 0;        // 0: until interrupted
+    std::string start_args;     // appended to 'start'
+    bool send_start = true;
+    bool stop_on_exit = false;
+    bool indexed = false;
+    std::vector<const char*> metadata;  // extra key=value lines
+    size_t ring_mib = default_ring_mib;
+    std::string publish;        // shared memory ring name, empty: none
+    uint32_t shm_slots = default_shm_slots;
+    uint32_t shm_slot_kib = default_shm_slot_kib;
+    uint32_t shm_block_ms = default_shm_block_ms;
+};
+
+struct stats_t
+{
+    std::atomic<uint64_t> bytes_received {0};
+    std::atomic<size_t> ring_high_water {0};
+    std::atomic<uint32_t> ring_full_waits {0};
+    uint64_t bytes_written = 0;
+    uint32_t frames = 0;
+    uint32_t control_responses = 0;
+    uint32_t crc_errors = 0;
+    uint32_t resyncs = 0;
+    uint32_t frames_lost_link = 0;      // index gap without the overflow flag
+    uint32_t frames_lost_firmware = 0;  // index gap the firmware flagged
+    uint32_t frames_too_large = 0;      // for a shared memory slot
+};
+
+std::atomic<bool> g_stop {false};
+
+void handle_signal(int)
+{
+    g_stop = true;
+}
+
+void reader_thread(com_t* port, ByteRing& ring, stats_t& stats)
+{
+    while (!g_stop)
+    {
+        uint8_t* data;
+        const size_t space = ring.writable(&data);
+
+        if (space == 0)
+        {
+            // The writer fell behind; the OS buffers the port meanwhile.
+            stats.ring_full_waits++;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            continue;
+        }
+
+        const size_t received = ifx_comport_get_data(port, data, std::min(space, read_chunk_bytes));
+
+        if (received == 0 || received > space)
+            continue;
+
+        ring.commit(received);
+        stats.bytes_received += received;
+
+        const size_t level = ring.readable();
+        if (level > stats.ring_high_water)
+            stats.ring_high_water = level;
+    }
+}
+
+class FrameWriter
+{
+public:
+    /* Writes raw records to file, or to container if that is not null, and
+       publishes them to shm if that is not null. */
+    FrameWriter(ByteRing& ring, FILE* file, radr_file_writer_t* container, radr_shm_t* shm, stats_t& stats,
+                uint32_t frame_limit) :
+        m_ring(ring),
+        m_file(file),
+        m_container(container),
+        m_shm(shm),
+        m_stats(stats),
+        m_frame_limit(frame_limit)
+    {
+    }
+
+    bool failed() const
+    {
+        return m_failed;
+    }
+
+    /* Consumes everything that is complete in the ring. Returns false once the
+       frame limit is reached or the file cannot be written. */
+    bool service()
+    {
+        for (;;)
+        {
+            const size_t level = m_ring.readable();
+
+            if (!m_synced)
+            {
+                if (!sync(level))
+                    return true;
+                continue;
+            }
+
+            if (level < header_v1_size)
+                return true;
+
+            uint8_t raw[header_v4_size];
+            frame_header_t header;
+
+            m_ring.copy_out(0, raw, header_v1_size);
+
+            if (std::memcmp(raw, header_magic, sizeof(header_magic)) != 0)
+            {
+                // Status text after the stream, or a corrupted header.
+                m_synced = false;
+                continue;
+            }
+
+            const size_t size = header_size(get_u16(raw + 4));
+
+            if (size == 0)
+            {
+                resync();
+                continue;
+            }
+
+            if (level < size)
+                return true;
+
+            m_ring.copy_out(0, raw, size);
+            parse_header(raw, header);
+
+            if (header.size + header.payload_size > m_ring.capacity() / 2)
+            {
+                resync();
+                continue;
+            }
+
+            if (level < header.size + header.payload_size)
+                return true;
+
+            if (header.version >= 3 && compute_crc(header) != header.payload_crc32)
+                m_stats.crc_errors++;
+
+            if (m_shm != nullptr)
+                publish(raw, header);
+
+            if (!write_out(raw, header))
+            {
+                m_failed = true;
+                return false;
+            }
+
+            m_ring.release(header.size + header.payload_size);
+
+            if (header.sample_format == sample_format_control)
+            {
+                m_stats.control_responses++;
+                continue;
+            }
+
+            count_frame(header);
+
+            if (m_frame_limit > 0 && m_stats.frames >= m_frame_limit)
+                return false;
+        }
+    }
+
+private:
+    /* Skips the magic of a header that makes no sense and searches for the
+       next one. */
+    void resync()
+    {
+        m_stats.resyncs++;
+        m_ring.release(1);
+        m_synced = false;
+    }
+
+    /* Drops and echoes status text up to the next header magic. Returns false
+       if more data is needed. */
+    bool sync(size_t level)
+    {
+        size_t skip = 0;
+
+        while (skip + sizeof(header_magic) <= level)
+        {
+            bool match = true;
+
+            for (size_t i = 0; i < sizeof(header_magic) && match; i++)
+                match = (m_ring.at(skip + i) == header_magic[i]);
+
+            if (match)
+                break;
+
+            const char c = static_cast<char>(m_ring.at(skip));
+            if (c == '\n' || c == '\r' || c == '\t' || (c >= ' ' && c < 0x7F))
+                std::fputc(c, stderr);
+            skip++;
+        }
+
+        m_ring.release(skip);
+
+        if (skip + sizeof(header_magic) > level)
+            return false;
+
+        m_synced = true;
+        return true;
+    }
+
+    uint32_t compute_crc(const frame_header_t& header) const
+    {
+        uint32_t crc = 0;
+        size_t offset = header.size;
+        size_t remaining = header.payload_size;
+
+        while (remaining > 0)
+        {
+            const uint8_t* data;
+            const size_t n = m_ring.span(offset, remaining, &data);
+
+            crc = radr_crc32(crc, data, n);
+            offset += n;
+            remaining -= n;
+        }
+
+        return crc;
+    }
+
+    /* The payload of the frame at the start of the ring as up to two
+       contiguous spans (it may wrap around the end of the ring). */
+    void payload_spans(const frame_header_t& header, radr_shm_part_t spans[2]) const
+    {
+        const uint8_t* part1;
+        const uint8_t* part2 = nullptr;
+        const size_t size1 = m_ring.span(header.size, header.payload_size, &part1);
+        const size_t size2 = header.payload_size - size1;
+
+        if (size2 > 0)
+            m_ring.span(header.size + size1, size2, &part2);
+
+        spans[0] = {part1, size1};
+        spans[1] = {part2, size2};
+    }
+
+    void publish(const uint8_t* raw, const frame_header_t& header)
+    {
+        radr_shm_part_t parts[3] = {{raw, header.size}};
+
+        payload_spans(header, &parts[1]);
+
+        if (!radr_shm_publish(m_shm, parts, 3))
+            m_stats.frames_too_large++;
+    }
+
+    bool write_out(const uint8_t* raw, const frame_header_t& header)
+    {
+        const size_t count = header.size + header.payload_size;
+
+        if (m_file == nullptr && m_container == nullptr)
+            return true;
+
+        if (m_container != nullptr)
+        {
+            radr_shm_part_t spans[2];
+
+            payload_spans(header, spans);
+
+            if (!radr_file_writer_add(m_container, raw, header.size,
+                                      static_cast<const uint8_t*>(spans[0].data), spans[0].size,
+                                      static_cast<const uint8_t*>(spans[1].data), spans[1].size))
+                return false;
+
+            m_stats.bytes_written += count;
+            return true;
+        }
+
+        size_t offset = 0;
+
+        while (offset < count)
+        {
+            const uint8_t* data;
+            const size_t n = m_ring.span(offset, count - offset, &data);
+
+            if (std::fwrite(data, 1, n, m_file) != n)
+                return false;
+            offset += n;
+        }
+
+        m_stats.bytes_written += count;
+        return true;
+    }
+
+    void count_frame(const frame_header_t& header)
+    {
+        if (m_have_index && header.frame_index != m_next_index)
+        {
+            const uint32_t gap = header.frame_index - m_next_index;
+
+            if (header.flags & flag_fifo_overflow)
+                m_stats.frames_lost_firmware += gap;
+            else
+                m_stats.frames_lost_link += gap;
+        }
+
+        m_have_index = true;
+        m_next_index = header.frame_index + 1;
+        m_stats.frames++;
+    }
+
+    ByteRing& m_ring;
+    FILE* m_file;
+    radr_file_writer_t* m_container;
+    radr_shm_t* m_shm;
+    stats_t& m_stats;
+    const uint32_t m_frame_limit;
+    bool m_synced = false;
+    bool m_failed = false;
+    bool m_have_index = false;
+    uint32_t m_next_index = 0;
+};
+
+void print_progress(const stats_t& stats, double seconds)
+{
+    const double rate = (seconds > 0) ? static_cast<double>(stats.bytes_received) / seconds : 0.0;
+
+    std::fprintf(stderr, "%.1f s: %u frames, %llu bytes, %.0f B/s, ring high water %zu bytes\n",
+                 seconds, stats.frames,
+                 static_cast<unsigned long long>(stats.bytes_received.load()), rate,
+                 stats.ring_high_water.load());
+}
+
+void print_summary(const stats_t& stats, double seconds)
+{
+    const double rate = (seconds > 0) ? static_cast<double>(stats.bytes_received) / seconds : 0.0;
+
+    std::fprintf(stderr,
+                 "Frames captured: %u\n"
+                 "Control responses: %u\n"
+                 "Bytes received: %llu (%llu written)\n"
+                 "Sustained throughput: %.0f B/s over %.1f s\n"
+                 "Ring high water: %zu bytes, full waits: %u\n"
+                 "Payload CRC errors: %u\n"
+                 "Resyncs: %u\n"
+                 "Frames lost on the link: %u\n"
+                 "Frames dropped by the firmware: %u\n",
+                 stats.frames,
+                 stats.control_responses,
+                 static_cast<unsigned long long>(stats.bytes_received.load()),
+                 static_cast<unsigned long long>(stats.bytes_written),
+                 rate, seconds,
+                 stats.ring_high_water.load(), stats.ring_full_waits.load(),
+                 stats.crc_errors,
+                 stats.resyncs,
+                 stats.frames_lost_link,
+                 stats.frames_lost_firmware);
+}
+
+void print_subscribers(const radr_shm_t* shm)
+{
+    for (uint32_t i = 0; i < RADR_SHM_MAX_SUBSCRIBERS; i++)
+    {
+        radr_shm_subscriber_info_t info;
+
+        if (!radr_shm_subscriber_info(shm, i, &info))
+            continue;
+
+        std::fprintf(stderr, "Subscriber %u (pid %u, %s): %llu received, %llu dropped, %llu behind\n",
+                     i, info.pid, (info.mode == RADR_SHM_BLOCK) ? "block" : "drop",
+                     static_cast<unsigned long long>(info.received),
+                     static_cast<unsigned long long>(info.dropped),
+                     static_cast<unsigned long long>(info.lag));
+    }
+}
+
+void usage(const char* name)
+{
+    std::fprintf(stderr,
+                 "Usage: %s --port <device> --output <file> | --publish <name> [options]\n"
+                 "  --baud <rate>       UART baud rate, must match STREAM_UART_BAUDRATE (default %u)\n"
+                 "  --frames <n>        stop after n sensor frames (default: until Ctrl+C)\n"
+                 "  --start-args <str>  appended to the 'start' command, e.g. \"packed12 rice\"\n"
+                 "  --no-start          only record; do not send 'start'\n"
+                 "  --stop-on-exit      send 'stop' before exiting\n"
+                 "  --indexed           write an indexed .rcap container (see radr_file.h)\n"
+                 "  --meta <key=value>  add or replace a container metadata line, e.g. after 'profile apply'\n"
+                 "  --ring-mib <n>      reader/writer ring size in MiB, rounded up to a power of two (default %zu)\n"
+                 "  --publish <name>    serve the frames to radr_subscribe and other subscribers (radr_shm.h)\n"
+                 "  --shm-slots <n>     frames the shared memory ring holds (default %u)\n"
+                 "  --shm-slot-kib <n>  largest frame record in KiB (default %u)\n"
+                 "  --shm-block-ms <n>  longest wait per frame for a blocking subscriber (default %u)\n",
+                 name, default_baudrate, default_ring_mib, default_shm_slots, default_shm_slot_kib,
+                 default_shm_block_ms);
+}
+
+bool parse_options(int argc, char* argv[], options_t& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if (arg == "--port" && has_value)
+            options.port = argv[++i];
+        else if (arg == "--output" && has_value)
+            options.output = argv[++i];
+        else if (arg == "--baud" && has_value)
+            options.baudrate = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--frames" && has_value)
+            options.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--start-args" && has_value)
+            options.start_args = argv[++i];
+        else if (arg == "--no-start")
+            options.send_start = false;
+        else if (arg == "--stop-on-exit")
+            options.stop_on_exit = true;
+        else if (arg == "--indexed")
+            options.indexed = true;
+        else if (arg == "--meta" && has_value && std::strchr(argv[i + 1], '=') != nullptr)
+            options.metadata.push_back(argv[++i]);
+        else if (arg == "--ring-mib" && has_value)
+            options.ring_mib = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--publish" && has_value)
+            options.publish = argv[++i];
+        else if (arg == "--shm-slots" && has_value)
+            options.shm_slots = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--shm-slot-kib" && has_value)
+            options.shm_slot_kib = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--shm-block-ms" && has_value)
+            options.shm_block_ms = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+            return false;
+    }
+
+    return !options.port.empty() && (!options.output.empty() || !options.publish.empty()) &&
+           options.baudrate > 0 && options.ring_mib > 0 && !(options.indexed && options.output.empty());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    options_t options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    size_t ring_bytes = 1;
+    while (ring_bytes < options.ring_mib * 1024 * 1024)
+        ring_bytes <<= 1;
+
+    com_t* port = ifx_comport_open(options.port.c_str(), options.baudrate);
+    if (port == nullptr)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", options.port.c_str());
+        return 1;
+    }
+
+    FILE* file = nullptr;
+    radr_file_writer_t* container = nullptr;
+    radr_shm_t* shm = nullptr;
+
+    if (!options.publish.empty())
+    {
+        shm = radr_shm_create(options.publish.c_str(), options.shm_slots, options.shm_slot_kib * 1024,
+                              options.shm_block_ms);
+        if (shm == nullptr)
+        {
+            std::fprintf(stderr, "Cannot create the shared memory ring '%s'\n", options.publish.c_str());
+            ifx_comport_close(port);
+            return 1;
+        }
+    }
+
+    if (options.output.empty())
+    {
+        // Publishing only.
+    }
+    else if (options.indexed)
+    {
+        char metadata[metadata_max_bytes];
+        const size_t metadata_size =
+            radr_build_metadata(metadata, sizeof(metadata), options.metadata.data(), options.metadata.size());
+
+        if (metadata_size > 0)
+            container = radr_file_writer_open(options.output.c_str(), metadata, metadata_size);
+    }
+    else
+    {
+        file = std::fopen(options.output.c_str(), "wb");
+    }
+
+    if (!options.output.empty() && file == nullptr && container == nullptr)
+    {
+        std::fprintf(stderr, "Cannot create %s\n", options.output.c_str());
+        radr_shm_close(shm);
+        ifx_comport_close(port);
+        return 1;
+    }
+
+    // Writes go out in large blocks, independent of the frame size.
+    if (file != nullptr)
+        std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    ifx_comport_set_timeout(port, read_timeout_ms);
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    if (options.send_start)
+    {
+        std::string command = "start";
+
+        if (options.frames > 0)
+            command += " " + std::to_string(options.frames);
+        if (!options.start_args.empty())
+            command += " " + options.start_args;
+        command += "\r\n";
+
+        ifx_comport_send_data(port, command.data(), command.size());
+    }
+
+    ByteRing ring(ring_bytes);
+    stats_t stats;
+    FrameWriter writer(ring, file, container, shm, stats, options.frames);
+    const auto start_time = std::chrono::steady_clock::now();
+    auto last_report = start_time;
+    bool write_failed = false;
+
+    std::thread reader(reader_thread, port, std::ref(ring), std::ref(stats));
+
+    while (!g_stop)
+    {
+        if (!writer.service())
+        {
+            write_failed = writer.failed();
+            break;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_report >= std::chrono::seconds(1))
+        {
+            print_progress(stats, std::chrono::duration<double>(now - start_time).count());
+            if (shm != nullptr)
+                print_subscribers(shm);
+            last_report = now;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    g_stop = true;
+    reader.join();
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    if (options.stop_on_exit)
+    {
+        static const char stop_command[] = "stop\r\n";
+        ifx_comport_send_data(port, stop_command, sizeof(stop_command) - 1);
+    }
+
+    if (file != nullptr)
+        write_failed = (std::fclose(file) != 0) || write_failed;
+    else if (container != nullptr)
+        write_failed = !radr_file_writer_close(container) || write_failed;
+    ifx_comport_close(port);
+
+    if (write_failed)
+        std::fprintf(stderr, "Failed to write %s\n", options.output.c_str());
+
+    print_summary(stats, seconds);
+
+    if (shm != nullptr)
+    {
+        std::fprintf(stderr, "Frames too large to publish: %u\n", stats.frames_too_large);
+        print_subscribers(shm);
+        radr_shm_close(shm);
+    }
+
+    const bool lossless = !write_failed && stats.crc_errors == 0 && stats.resyncs == 0 && stats.frames_lost_link == 0;
+    return lossless ? 0 : 2;
+}
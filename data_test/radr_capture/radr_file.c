@@ -0,0 +1,642 @@
+/* fseeko() and 64-bit file offsets for recordings beyond 2 GiB. */
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE                     200809L
+#define _FILE_OFFSET_BITS                   64
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "radr_file.h"
+
+/* The format is little endian and the structs are read in place. */
+_Static_assert(sizeof(radr_file_header_t) == 64, "radr_file_header_t layout");
+_Static_assert(sizeof(radr_index_entry_t) == 32, "radr_index_entry_t layout");
+
+/* Stream header (src/main.c binary_frame_header_t) */
+#define STREAM_MAGIC                        "RADR"
+#define STREAM_HEADER_V1_SIZE               (16U)
+#define STREAM_HEADER_V2_SIZE               (24U)
+#define STREAM_HEADER_V3_SIZE               (32U)
+#define STREAM_HEADER_V4_SIZE               (42U)
+
+struct radr_file_s
+{
+    const uint8_t *data;
+    size_t size;
+    const radr_file_header_t *header;
+    const radr_index_entry_t *index;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+struct radr_file_writer_s
+{
+    FILE *file;
+    uint64_t position;
+    radr_index_entry_t *index;
+    uint64_t count;
+    uint64_t capacity;
+    radr_file_header_t header;
+    bool failed;
+};
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t stream_header_size(uint16_t version)
+{
+    switch (version)
+    {
+        case 1:
+            return STREAM_HEADER_V1_SIZE;
+        case 2:
+            return STREAM_HEADER_V2_SIZE;
+        case 3:
+            return STREAM_HEADER_V3_SIZE;
+        case 4:
+            return STREAM_HEADER_V4_SIZE;
+        default:
+            return 0;
+    }
+}
+
+/* Fills the index fields that come from the stream header. */
+static void describe_frame(const uint8_t *header, size_t header_size, radr_index_entry_t *entry)
+{
+    entry->frame_index = get_u32(header + 8);
+    entry->sample_format = (header_size >= STREAM_HEADER_V2_SIZE) ? get_u16(header + 16) : 0U;
+    entry->flags = (header_size >= STREAM_HEADER_V2_SIZE) ? get_u16(header + 18) : 0U;
+    entry->timestamp_us = (header_size >= STREAM_HEADER_V3_SIZE) ? get_u32(header + 24) : 0U;
+}
+
+static int seek_to(FILE *file, uint64_t position)
+{
+#if defined(_WIN32)
+    return _fseeki64(file, (__int64)position, SEEK_SET);
+#else
+    return fseeko(file, (off_t)position, SEEK_SET);
+#endif
+}
+
+static bool header_valid(const radr_file_header_t *header)
+{
+    return (memcmp(header->magic, RADR_FILE_MAGIC, 4) == 0) &&
+           (header->version == RADR_FILE_VERSION) &&
+           (header->header_size == sizeof(radr_file_header_t)) &&
+           (header->alignment > 0U);
+}
+
+/*******************************************************************************
+* Reader
+*******************************************************************************/
+static void unmap(radr_file_t *file)
+{
+#if defined(_WIN32)
+    if (file->data != NULL)
+    {
+        UnmapViewOfFile(file->data);
+    }
+    if (file->mapping != NULL)
+    {
+        CloseHandle(file->mapping);
+    }
+    if (file->file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file->file);
+    }
+#else
+    if (file->data != NULL)
+    {
+        munmap((void *)file->data, file->size);
+    }
+#endif
+}
+
+static bool map(radr_file_t *file, const char *path)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+
+    file->mapping = NULL;
+    file->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, NULL);
+    if ((file->file == INVALID_HANDLE_VALUE) || !GetFileSizeEx(file->file, &size) || (size.QuadPart == 0))
+    {
+        return false;
+    }
+
+    file->size = (size_t)size.QuadPart;
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (file->mapping == NULL)
+    {
+        return false;
+    }
+
+    file->data = (const uint8_t *)MapViewOfFile(file->mapping, FILE_MAP_READ, 0, 0, 0);
+    return file->data != NULL;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    if ((fstat(fd, &st) != 0) || (st.st_size == 0))
+    {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    file->data = data;
+    file->size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+radr_file_t *radr_file_open(const char *path)
+{
+    radr_file_t *file = calloc(1, sizeof(*file));
+
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    if (!map(file, path) || (file->size < sizeof(radr_file_header_t)))
+    {
+        radr_file_close(file);
+        return NULL;
+    }
+
+    file->header = (const radr_file_header_t *)file->data;
+
+    const radr_file_header_t *header = file->header;
+    const uint64_t index_bytes = header->frame_count * sizeof(radr_index_entry_t);
+
+    if (!header_valid(header) || (header->index_offset == 0U) ||
+        (header->metadata_offset + header->metadata_size > file->size) ||
+        (header->frame_count > (file->size / sizeof(radr_index_entry_t))) ||
+        (header->index_offset > file->size) || (index_bytes > (file->size - header->index_offset)) ||
+        ((header->index_offset % sizeof(uint64_t)) != 0U))
+    {
+        radr_file_close(file);
+        return NULL;
+    }
+
+    file->index = (const radr_index_entry_t *)(file->data + header->index_offset);
+    return file;
+}
+
+void radr_file_close(radr_file_t *file)
+{
+    if (file != NULL)
+    {
+        unmap(file);
+        free(file);
+    }
+}
+
+uint64_t radr_file_frame_count(const radr_file_t *file)
+{
+    return (file != NULL) ? file->header->frame_count : 0U;
+}
+
+const char *radr_file_metadata(const radr_file_t *file, size_t *length)
+{
+    if (file == NULL)
+    {
+        return NULL;
+    }
+
+    if (length != NULL)
+    {
+        *length = file->header->metadata_size;
+    }
+
+    return (const char *)(file->data + file->header->metadata_offset);
+}
+
+bool radr_file_get_metadata(const radr_file_t *file, const char *key, char *value, size_t value_size)
+{
+    size_t length = 0;
+    const char *text = radr_file_metadata(file, &length);
+    const size_t key_length = (key != NULL) ? strlen(key) : 0U;
+
+    if ((text == NULL) || (key_length == 0U) || (value == NULL) || (value_size == 0U))
+    {
+        return false;
+    }
+
+    const char *end = text + length;
+
+    for (const char *line = text; line < end;)
+    {
+        const char *line_end = memchr(line, '\n', (size_t)(end - line));
+
+        if (line_end == NULL)
+        {
+            line_end = end;
+        }
+
+        if (((size_t)(line_end - line) > key_length) && (memcmp(line, key, key_length) == 0) &&
+            (line[key_length] == '='))
+        {
+            const char *start = line + key_length + 1;
+            size_t n = (size_t)(line_end - start);
+
+            if (n >= value_size)
+            {
+                n = value_size - 1U;
+            }
+
+            memcpy(value, start, n);
+            value[n] = '\0';
+            return true;
+        }
+
+        line = line_end + 1;
+    }
+
+    return false;
+}
+
+bool radr_file_frame(const radr_file_t *file, uint64_t n, radr_frame_view_t *view)
+{
+    if ((file == NULL) || (view == NULL) || (n >= file->header->frame_count))
+    {
+        return false;
+    }
+
+    const radr_index_entry_t *entry = &file->index[n];
+
+    if ((entry->header_offset >= entry->payload_offset) ||
+        (entry->payload_offset > file->size) ||
+        (entry->payload_size > (file->size - entry->payload_offset)))
+    {
+        return false;
+    }
+
+    view->entry = entry;
+    view->header = file->data + entry->header_offset;
+    view->header_size = (size_t)(entry->payload_offset - entry->header_offset);
+    view->payload = file->data + entry->payload_offset;
+    return true;
+}
+
+bool radr_file_find(const radr_file_t *file, uint32_t frame_index, radr_frame_view_t *view)
+{
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    uint64_t low = 0U;
+    uint64_t high = file->header->frame_count;
+
+    while (low < high)
+    {
+        const uint64_t mid = low + ((high - low) / 2U);
+
+        if (file->index[mid].frame_index < frame_index)
+        {
+            low = mid + 1U;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return (low < file->header->frame_count) && (file->index[low].frame_index == frame_index) &&
+           radr_file_frame(file, low, view);
+}
+
+/*******************************************************************************
+* Writer
+*******************************************************************************/
+static void write_bytes(radr_file_writer_t *writer, const void *data, size_t size)
+{
+    if (!writer->failed && (size > 0U) && (fwrite(data, 1, size, writer->file) != size))
+    {
+        writer->failed = true;
+    }
+
+    writer->position += size;
+}
+
+static void write_padding(radr_file_writer_t *writer, size_t size)
+{
+    static const uint8_t zeros[RADR_FILE_ALIGNMENT] = {0};
+
+    while (size > 0U)
+    {
+        const size_t n = (size < sizeof(zeros)) ? size : sizeof(zeros);
+
+        write_bytes(writer, zeros, n);
+        size -= n;
+    }
+}
+
+static bool append_entry(radr_file_writer_t *writer, const radr_index_entry_t *entry)
+{
+    if (writer->count == writer->capacity)
+    {
+        const uint64_t capacity = (writer->capacity > 0U) ? (writer->capacity * 2U) : 1024U;
+        radr_index_entry_t *index = realloc(writer->index, (size_t)capacity * sizeof(*index));
+
+        if (index == NULL)
+        {
+            return false;
+        }
+
+        writer->index = index;
+        writer->capacity = capacity;
+    }
+
+    writer->index[writer->count++] = *entry;
+    return true;
+}
+
+radr_file_writer_t *radr_file_writer_open(const char *path, const char *metadata, size_t metadata_size)
+{
+    return radr_file_writer_open_buffered(path, metadata, metadata_size, 0U);
+}
+
+radr_file_writer_t *radr_file_writer_open_buffered(const char *path, const char *metadata, size_t metadata_size,
+                                                   size_t buffer_size)
+{
+    radr_file_writer_t *writer = calloc(1, sizeof(*writer));
+
+    if (writer == NULL)
+    {
+        return NULL;
+    }
+
+    writer->file = fopen(path, "wb");
+
+    if (writer->file == NULL)
+    {
+        free(writer);
+        return NULL;
+    }
+
+    if ((buffer_size > 0U) && (setvbuf(writer->file, NULL, _IOFBF, buffer_size) != 0))
+    {
+        fclose(writer->file);
+        free(writer);
+        return NULL;
+    }
+
+    memcpy(writer->header.magic, RADR_FILE_MAGIC, 4);
+    writer->header.version = RADR_FILE_VERSION;
+    writer->header.header_size = sizeof(radr_file_header_t);
+    writer->header.alignment = RADR_FILE_ALIGNMENT;
+    writer->header.metadata_size = (uint32_t)metadata_size;
+    writer->header.metadata_offset = sizeof(radr_file_header_t);
+
+    write_bytes(writer, &writer->header, sizeof(writer->header));
+    write_bytes(writer, metadata, metadata_size);
+    return writer;
+}
+
+bool radr_file_writer_add(radr_file_writer_t *writer, const uint8_t *header, size_t header_size,
+                          const uint8_t *payload1, size_t size1,
+                          const uint8_t *payload2, size_t size2)
+{
+    if ((writer == NULL) || (header == NULL) || (header_size < STREAM_HEADER_V1_SIZE) ||
+        (header_size >= RADR_FILE_ALIGNMENT) || ((size1 + size2) > UINT32_MAX))
+    {
+        return false;
+    }
+
+    const uint64_t payload_offset = (writer->position + header_size + RADR_FILE_ALIGNMENT - 1U) &
+                                    ~(uint64_t)(RADR_FILE_ALIGNMENT - 1U);
+    radr_index_entry_t entry = {
+        .header_offset = payload_offset - header_size,
+        .payload_offset = payload_offset,
+        .payload_size = (uint32_t)(size1 + size2)
+    };
+
+    describe_frame(header, header_size, &entry);
+    write_padding(writer, (size_t)(entry.header_offset - writer->position));
+    write_bytes(writer, header, header_size);
+    write_bytes(writer, payload1, size1);
+    write_bytes(writer, payload2, size2);
+
+    if (!append_entry(writer, &entry))
+    {
+        writer->failed = true;
+    }
+
+    return !writer->failed;
+}
+
+/* Writes index at the current position (8-byte aligned) and patches the file
+   header. */
+static bool finalise(FILE *file, radr_file_header_t *header, uint64_t position,
+                     const radr_index_entry_t *index, uint64_t count)
+{
+    static const uint8_t zeros[sizeof(uint64_t)] = {0};
+    const size_t padding = (size_t)((sizeof(uint64_t) - (position % sizeof(uint64_t))) % sizeof(uint64_t));
+    bool ok = (fwrite(zeros, 1, padding, file) == padding);
+
+    header->index_offset = position + padding;
+    header->frame_count = count;
+
+    ok = ok && ((count == 0U) || (fwrite(index, sizeof(*index), (size_t)count, file) == (size_t)count));
+    ok = ok && (seek_to(file, 0U) == 0);
+    ok = ok && (fwrite(header, sizeof(*header), 1, file) == 1U);
+    return ok;
+}
+
+bool radr_file_writer_close(radr_file_writer_t *writer)
+{
+    if (writer == NULL)
+    {
+        return false;
+    }
+
+    bool ok = !writer->failed && finalise(writer->file, &writer->header, writer->position,
+                                          writer->index, writer->count);
+
+    ok = (fclose(writer->file) == 0) && ok;
+    free(writer->index);
+    free(writer);
+    return ok;
+}
+
+int64_t radr_file_recover(const char *path)
+{
+    FILE *file = fopen(path, "r+b");
+    radr_file_header_t header;
+
+    if (file == NULL)
+    {
+        return -1;
+    }
+
+    if ((fread(&header, sizeof(header), 1, file) != 1U) || !header_valid(&header))
+    {
+        fclose(file);
+        return -1;
+    }
+
+    radr_file_writer_t walker = {.file = file};
+    uint64_t position = header.metadata_offset + header.metadata_size;
+    uint8_t raw[RADR_FILE_ALIGNMENT + STREAM_HEADER_V3_SIZE];
+
+    /* Each record is at most alignment - 1 bytes of zero padding, then the
+       stream header. Stop at the first record that is incomplete. */
+    for (;;)
+    {
+        if (seek_to(file, position) != 0)
+        {
+            break;
+        }
+
+        const size_t got = fread(raw, 1, sizeof(raw), file);
+        size_t skip = 0U;
+
+        while ((skip < header.alignment) && (skip < got) && (raw[skip] == 0U))
+        {
+            skip++;
+        }
+
+        if ((skip + STREAM_HEADER_V1_SIZE > got) || (memcmp(&raw[skip], STREAM_MAGIC, 4) != 0))
+        {
+            break;
+        }
+
+        const uint8_t *stream_header = &raw[skip];
+        const uint16_t version = get_u16(stream_header + 4);
+        const size_t size = stream_header_size(version);
+
+        if ((size == 0U) || (skip + size > got))
+        {
+            break;
+        }
+
+        const uint32_t payload_size = (version >= 2U) ? get_u32(stream_header + 20) :
+                                      (uint32_t)(get_u16(stream_header + 6) * get_u32(stream_header + 12));
+        radr_index_entry_t entry = {
+            .header_offset = position + skip,
+            .payload_offset = position + skip + size,
+            .payload_size = payload_size
+        };
+
+        describe_frame(stream_header, size, &entry);
+
+        if ((payload_size > 0U) && ((seek_to(file, entry.payload_offset + payload_size - 1U) != 0) ||
+            (fgetc(file) == EOF)))
+        {
+            break;
+        }
+
+        if (!append_entry(&walker, &entry))
+        {
+            free(walker.index);
+            fclose(file);
+            return -1;
+        }
+
+        position = entry.payload_offset + payload_size;
+    }
+
+    bool ok = (seek_to(file, position) == 0) &&
+              finalise(file, &header, position, walker.index, walker.count);
+
+    ok = (fclose(file) == 0) && ok;
+    free(walker.index);
+    return ok ? (int64_t)walker.count : -1;
+}
+
+/*******************************************************************************
+* Checksum
+*******************************************************************************/
+/* Table of the reflected polynomial 0xEDB88320, one entry per byte value. */
+static const uint32_t crc32_table[256] = {
+    0x00000000U, 0x77073096U, 0xEE0E612CU, 0x990951BAU, 0x076DC419U, 0x706AF48FU,
+    0xE963A535U, 0x9E6495A3U, 0x0EDB8832U, 0x79DCB8A4U, 0xE0D5E91EU, 0x97D2D988U,
+    0x09B64C2BU, 0x7EB17CBDU, 0xE7B82D07U, 0x90BF1D91U, 0x1DB71064U, 0x6AB020F2U,
+    0xF3B97148U, 0x84BE41DEU, 0x1ADAD47DU, 0x6DDDE4EBU, 0xF4D4B551U, 0x83D385C7U,
+    0x136C9856U, 0x646BA8C0U, 0xFD62F97AU, 0x8A65C9ECU, 0x14015C4FU, 0x63066CD9U,
+    0xFA0F3D63U, 0x8D080DF5U, 0x3B6E20C8U, 0x4C69105EU, 0xD56041E4U, 0xA2677172U,
+    0x3C03E4D1U, 0x4B04D447U, 0xD20D85FDU, 0xA50AB56BU, 0x35B5A8FAU, 0x42B2986CU,
+    0xDBBBC9D6U, 0xACBCF940U, 0x32D86CE3U, 0x45DF5C75U, 0xDCD60DCFU, 0xABD13D59U,
+    0x26D930ACU, 0x51DE003AU, 0xC8D75180U, 0xBFD06116U, 0x21B4F4B5U, 0x56B3C423U,
+    0xCFBA9599U, 0xB8BDA50FU, 0x2802B89EU, 0x5F058808U, 0xC60CD9B2U, 0xB10BE924U,
+    0x2F6F7C87U, 0x58684C11U, 0xC1611DABU, 0xB6662D3DU, 0x76DC4190U, 0x01DB7106U,
+    0x98D220BCU, 0xEFD5102AU, 0x71B18589U, 0x06B6B51FU, 0x9FBFE4A5U, 0xE8B8D433U,
+    0x7807C9A2U, 0x0F00F934U, 0x9609A88EU, 0xE10E9818U, 0x7F6A0DBBU, 0x086D3D2DU,
+    0x91646C97U, 0xE6635C01U, 0x6B6B51F4U, 0x1C6C6162U, 0x856530D8U, 0xF262004EU,
+    0x6C0695EDU, 0x1B01A57BU, 0x8208F4C1U, 0xF50FC457U, 0x65B0D9C6U, 0x12B7E950U,
+    0x8BBEB8EAU, 0xFCB9887CU, 0x62DD1DDFU, 0x15DA2D49U, 0x8CD37CF3U, 0xFBD44C65U,
+    0x4DB26158U, 0x3AB551CEU, 0xA3BC0074U, 0xD4BB30E2U, 0x4ADFA541U, 0x3DD895D7U,
+    0xA4D1C46DU, 0xD3D6F4FBU, 0x4369E96AU, 0x346ED9FCU, 0xAD678846U, 0xDA60B8D0U,
+    0x44042D73U, 0x33031DE5U, 0xAA0A4C5FU, 0xDD0D7CC9U, 0x5005713CU, 0x270241AAU,
+    0xBE0B1010U, 0xC90C2086U, 0x5768B525U, 0x206F85B3U, 0xB966D409U, 0xCE61E49FU,
+    0x5EDEF90EU, 0x29D9C998U, 0xB0D09822U, 0xC7D7A8B4U, 0x59B33D17U, 0x2EB40D81U,
+    0xB7BD5C3BU, 0xC0BA6CADU, 0xEDB88320U, 0x9ABFB3B6U, 0x03B6E20CU, 0x74B1D29AU,
+    0xEAD54739U, 0x9DD277AFU, 0x04DB2615U, 0x73DC1683U, 0xE3630B12U, 0x94643B84U,
+    0x0D6D6A3EU, 0x7A6A5AA8U, 0xE40ECF0BU, 0x9309FF9DU, 0x0A00AE27U, 0x7D079EB1U,
+    0xF00F9344U, 0x8708A3D2U, 0x1E01F268U, 0x6906C2FEU, 0xF762575DU, 0x806567CBU,
+    0x196C3671U, 0x6E6B06E7U, 0xFED41B76U, 0x89D32BE0U, 0x10DA7A5AU, 0x67DD4ACCU,
+    0xF9B9DF6FU, 0x8EBEEFF9U, 0x17B7BE43U, 0x60B08ED5U, 0xD6D6A3E8U, 0xA1D1937EU,
+    0x38D8C2C4U, 0x4FDFF252U, 0xD1BB67F1U, 0xA6BC5767U, 0x3FB506DDU, 0x48B2364BU,
+    0xD80D2BDAU, 0xAF0A1B4CU, 0x36034AF6U, 0x41047A60U, 0xDF60EFC3U, 0xA867DF55U,
+    0x316E8EEFU, 0x4669BE79U, 0xCB61B38CU, 0xBC66831AU, 0x256FD2A0U, 0x5268E236U,
+    0xCC0C7795U, 0xBB0B4703U, 0x220216B9U, 0x5505262FU, 0xC5BA3BBEU, 0xB2BD0B28U,
+    0x2BB45A92U, 0x5CB36A04U, 0xC2D7FFA7U, 0xB5D0CF31U, 0x2CD99E8BU, 0x5BDEAE1DU,
+    0x9B64C2B0U, 0xEC63F226U, 0x756AA39CU, 0x026D930AU, 0x9C0906A9U, 0xEB0E363FU,
+    0x72076785U, 0x05005713U, 0x95BF4A82U, 0xE2B87A14U, 0x7BB12BAEU, 0x0CB61B38U,
+    0x92D28E9BU, 0xE5D5BE0DU, 0x7CDCEFB7U, 0x0BDBDF21U, 0x86D3D2D4U, 0xF1D4E242U,
+    0x68DDB3F8U, 0x1FDA836EU, 0x81BE16CDU, 0xF6B9265BU, 0x6FB077E1U, 0x18B74777U,
+    0x88085AE6U, 0xFF0F6A70U, 0x66063BCAU, 0x11010B5CU, 0x8F659EFFU, 0xF862AE69U,
+    0x616BFFD3U, 0x166CCF45U, 0xA00AE278U, 0xD70DD2EEU, 0x4E048354U, 0x3903B3C2U,
+    0xA7672661U, 0xD06016F7U, 0x4969474DU, 0x3E6E77DBU, 0xAED16A4AU, 0xD9D65ADCU,
+    0x40DF0B66U, 0x37D83BF0U, 0xA9BCAE53U, 0xDEBB9EC5U, 0x47B2CF7FU, 0x30B5FFE9U,
+    0xBDBDF21CU, 0xCABAC28AU, 0x53B39330U, 0x24B4A3A6U, 0xBAD03605U, 0xCDD70693U,
+    0x54DE5729U, 0x23D967BFU, 0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U,
+    0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU
+};
+
+uint32_t radr_crc32(uint32_t crc, const void *data, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)data;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++)
+    {
+        crc = crc32_table[(crc ^ p[i]) & 0xFFU] ^ (crc >> 8);
+    }
+    return ~crc;
+}
@@ -0,0 +1,134 @@
+#ifndef RADR_FILE_H
+#define RADR_FILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+* File format
+*******************************************************************************/
+/* Indexed capture container (.rcap), all fields little endian:
+
+     radr_file_header_t            at offset 0
+     metadata                      metadata_size bytes of "key=value\n" text
+     frame records                 each the stream's binary_frame_header_t
+                                   followed by its payload; padding in front
+                                   of the header makes every payload start at
+                                   a multiple of RADR_FILE_ALIGNMENT
+     radr_index_entry_t[]          frame_count entries at index_offset
+
+   index_offset stays 0 until the writer is closed, so a file whose recording
+   was cut off is recognisable (radr_file_recover() rebuilds the index). */
+#define RADR_FILE_MAGIC                     "RCAP"
+#define RADR_FILE_VERSION                   (1U)
+#define RADR_FILE_ALIGNMENT                 (64U)
+
+typedef struct
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t header_size;           /* sizeof(radr_file_header_t) */
+    uint32_t alignment;             /* of every payload */
+    uint32_t metadata_size;
+    uint64_t metadata_offset;
+    uint64_t index_offset;          /* 0: not finalised */
+    uint64_t frame_count;
+    uint8_t reserved[24];
+} radr_file_header_t;
+
+typedef struct
+{
+    uint64_t header_offset;         /* of the frame's binary_frame_header_t */
+    uint64_t payload_offset;
+    uint32_t frame_index;
+    uint32_t payload_size;
+    uint32_t timestamp_us;          /* 0 for headers before version 3 */
+    uint16_t sample_format;
+    uint16_t flags;
+} radr_index_entry_t;
+
+/*******************************************************************************
+* Reader
+*******************************************************************************/
+typedef struct radr_file_s radr_file_t;
+
+/* Zero-copy view of one frame; valid until radr_file_close(). */
+typedef struct
+{
+    const radr_index_entry_t *entry;
+    const uint8_t *header;          /* the frame's stream header */
+    size_t header_size;
+    const uint8_t *payload;         /* RADR_FILE_ALIGNMENT aligned */
+} radr_frame_view_t;
+
+/* Maps a finalised container read-only. Returns NULL if the file cannot be
+   mapped or is not a valid container. */
+radr_file_t *radr_file_open(const char *path);
+void radr_file_close(radr_file_t *file);
+
+uint64_t radr_file_frame_count(const radr_file_t *file);
+
+/* The metadata text (not NUL terminated) and its length. */
+const char *radr_file_metadata(const radr_file_t *file, size_t *length);
+
+/* Copies the value of key into value (NUL terminated, truncated to
+   value_size). Returns false if the key is missing. */
+bool radr_file_get_metadata(const radr_file_t *file, const char *key, char *value, size_t value_size);
+
+/* View of the n-th frame in the file, O(1). */
+bool radr_file_frame(const radr_file_t *file, uint64_t n, radr_frame_view_t *view);
+
+/* View of the frame with the given stream frame_index, found by binary
+   search (indices only grow within a recording). */
+bool radr_file_find(const radr_file_t *file, uint32_t frame_index, radr_frame_view_t *view);
+
+/*******************************************************************************
+* Writer
+*******************************************************************************/
+typedef struct radr_file_writer_s radr_file_writer_t;
+
+/* Creates path and writes the file header and metadata. */
+radr_file_writer_t *radr_file_writer_open(const char *path, const char *metadata, size_t metadata_size);
+
+/* As radr_file_writer_open(), but the file is written through a buffer of
+   buffer_size bytes, so that high-rate recordings reach the disk in few
+   large writes. 0 keeps the stdio default. */
+radr_file_writer_t *radr_file_writer_open_buffered(const char *path, const char *metadata, size_t metadata_size,
+                                                   size_t buffer_size);
+
+/* Appends one frame. header is the complete stream header (16, 24 or 32
+   bytes); the payload may be split in two parts (e.g. across the end of a
+   ring buffer), part2 may be empty. */
+bool radr_file_writer_add(radr_file_writer_t *writer, const uint8_t *header, size_t header_size,
+                          const uint8_t *payload1, size_t size1,
+                          const uint8_t *payload2, size_t size2);
+
+/* Writes the index and finalises the file header. Returns false if any write
+   failed; the writer is freed either way. */
+bool radr_file_writer_close(radr_file_writer_t *writer);
+
+/* Rebuilds the index of a container whose writer never got closed by
+   walking its frame records. Returns the number of frames indexed, or -1 if
+   the file is not a container. */
+int64_t radr_file_recover(const char *path);
+
+/*******************************************************************************
+* Checksum
+*******************************************************************************/
+/* Reflected CRC-32 as in zlib.crc32(), the payload_crc32 of stream headers
+   from version 3 on. Start with crc 0 and pass the previous result to
+   continue over further data. */
+uint32_t radr_crc32(uint32_t crc, const void *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADR_FILE_H */
@@ -0,0 +1,231 @@
+/* Converts raw RADR captures (serial_logger.py / radr_capture output) into
+   indexed .rcap containers and inspects them through the mmap reader. */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "radr_file.h"
+#include "radr_metadata.h"
+
+#define METADATA_MAX_BYTES                  (4096U)
+#define STREAM_HEADER_MAX_BYTES             (42U)
+
+static uint16_t get_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static int convert(const char *input, const char *output, const char *const *extra, size_t num_extra)
+{
+    static char metadata[METADATA_MAX_BYTES];
+    const size_t metadata_size = radr_build_metadata(metadata, sizeof(metadata), extra, num_extra);
+    FILE *in = fopen(input, "rb");
+    uint8_t *payload = NULL;
+    size_t payload_capacity = 0U;
+    uint64_t frames = 0U;
+    int status = 0;
+
+    if ((in == NULL) || (metadata_size == 0U))
+    {
+        fprintf(stderr, "Cannot read %s\n", input);
+        if (in != NULL)
+        {
+            fclose(in);
+        }
+        return 1;
+    }
+
+    radr_file_writer_t *writer = radr_file_writer_open(output, metadata, metadata_size);
+
+    if (writer == NULL)
+    {
+        fprintf(stderr, "Cannot create %s\n", output);
+        fclose(in);
+        return 1;
+    }
+
+    for (;;)
+    {
+        uint8_t header[STREAM_HEADER_MAX_BYTES];
+        const size_t got = fread(header, 1, 16U, in);
+
+        if (got == 0U)
+        {
+            break;
+        }
+
+        const uint16_t version = (got == 16U) ? get_u16(header + 4) : 0U;
+        const size_t header_size = (version == 1U) ? 16U : (version == 2U) ? 24U : (version == 3U) ? 32U :
+                                   (version == 4U) ? 42U : 0U;
+
+        if ((got != 16U) || (memcmp(header, "RADR", 4) != 0) || (header_size == 0U) ||
+            (fread(header + 16, 1, header_size - 16U, in) != (header_size - 16U)))
+        {
+            fprintf(stderr, "Bad frame header after %" PRIu64 " frames\n", frames);
+            status = 1;
+            break;
+        }
+
+        const size_t payload_size = (version >= 2U) ? get_u32(header + 20) :
+                                    ((size_t)get_u16(header + 6) * get_u32(header + 12));
+
+        if (payload_size > payload_capacity)
+        {
+            uint8_t *grown = realloc(payload, payload_size);
+
+            if (grown == NULL)
+            {
+                status = 1;
+                break;
+            }
+
+            payload = grown;
+            payload_capacity = payload_size;
+        }
+
+        if (fread(payload, 1, payload_size, in) != payload_size)
+        {
+            fprintf(stderr, "Truncated payload after %" PRIu64 " frames\n", frames);
+            status = 1;
+            break;
+        }
+
+        if (!radr_file_writer_add(writer, header, header_size, payload, payload_size, NULL, 0U))
+        {
+            status = 1;
+            break;
+        }
+
+        frames++;
+    }
+
+    if (!radr_file_writer_close(writer))
+    {
+        fprintf(stderr, "Failed to write %s\n", output);
+        status = 1;
+    }
+
+    fclose(in);
+    free(payload);
+    printf("%" PRIu64 " frames indexed\n", frames);
+    return status;
+}
+
+static int info(const char *path)
+{
+    radr_file_t *file = radr_file_open(path);
+    radr_frame_view_t first;
+    radr_frame_view_t last;
+    size_t metadata_size = 0U;
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s is not a finalised container (try 'recover')\n", path);
+        return 1;
+    }
+
+    const uint64_t count = radr_file_frame_count(file);
+    const char *metadata = radr_file_metadata(file, &metadata_size);
+
+    printf("Frames: %" PRIu64 "\n", count);
+
+    if ((count > 0U) && radr_file_frame(file, 0U, &first) && radr_file_frame(file, count - 1U, &last))
+    {
+        printf("Frame indices: %" PRIu32 " ... %" PRIu32 "\n", first.entry->frame_index, last.entry->frame_index);
+    }
+
+    printf("Metadata:\n%.*s", (int)metadata_size, metadata);
+    radr_file_close(file);
+    return 0;
+}
+
+static int show_frame(const char *path, const char *index_arg)
+{
+    radr_file_t *file = radr_file_open(path);
+    radr_frame_view_t view;
+    const uint32_t frame_index = (uint32_t)strtoul(index_arg, NULL, 0);
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "%s is not a finalised container (try 'recover')\n", path);
+        return 1;
+    }
+
+    if (!radr_file_find(file, frame_index, &view))
+    {
+        fprintf(stderr, "Frame %" PRIu32 " is not in %s\n", frame_index, path);
+        radr_file_close(file);
+        return 1;
+    }
+
+    printf("Frame %" PRIu32 ": format %u, flags 0x%04x, timestamp %" PRIu32 " us, %" PRIu32
+           " payload bytes at offset %" PRIu64 "\n",
+           view.entry->frame_index,
+           (unsigned int)view.entry->sample_format,
+           (unsigned int)view.entry->flags,
+           view.entry->timestamp_us,
+           view.entry->payload_size,
+           view.entry->payload_offset);
+
+    printf("Payload:");
+    for (uint32_t i = 0U; (i < view.entry->payload_size) && (i < 16U); i++)
+    {
+        printf(" %02x", view.payload[i]);
+    }
+    printf("%s\n", (view.entry->payload_size > 16U) ? " ..." : "");
+
+    radr_file_close(file);
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Usage: %s convert <raw capture> <out.rcap> [key=value ...]\n"
+            "       %s info <file.rcap>\n"
+            "       %s frame <file.rcap> <frame index>\n"
+            "       %s recover <file.rcap>\n",
+            name, name, name, name);
+}
+
+int main(int argc, char *argv[])
+{
+    if ((argc >= 4) && (strcmp(argv[1], "convert") == 0))
+    {
+        return convert(argv[2], argv[3], (const char *const *)&argv[4], (size_t)(argc - 4));
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "info") == 0))
+    {
+        return info(argv[2]);
+    }
+
+    if ((argc == 4) && (strcmp(argv[1], "frame") == 0))
+    {
+        return show_frame(argv[2], argv[3]);
+    }
+
+    if ((argc == 3) && (strcmp(argv[1], "recover") == 0))
+    {
+        const int64_t frames = radr_file_recover(argv[2]);
+
+        if (frames < 0)
+        {
+            fprintf(stderr, "%s is not a container\n", argv[2]);
+            return 1;
+        }
+
+        printf("%" PRId64 " frames indexed\n", frames);
+        return 0;
+    }
+
+    usage(argv[0]);
+    return 1;
+}
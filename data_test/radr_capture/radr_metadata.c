@@ -0,0 +1,124 @@
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "radr_metadata.h"
+
+#define XENSIV_BGT60TRXX_CONF_IMPL
+#include "presence_radar_settings.h"
+
+#define RADR_STRINGIFY(x)                   #x
+#define RADR_STRING(x)                      RADR_STRINGIFY(x)
+
+typedef struct
+{
+    char *buffer;
+    size_t size;
+    size_t length;
+    bool overflow;
+    const char *const *extra;
+    size_t num_extra;
+} text_t;
+
+static bool overridden(const text_t *text, const char *key)
+{
+    const size_t key_length = strlen(key);
+
+    for (size_t i = 0; i < text->num_extra; i++)
+    {
+        if ((strncmp(text->extra[i], key, key_length) == 0) && (text->extra[i][key_length] == '='))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void append(text_t *text, const char *fmt, ...)
+{
+    va_list args;
+
+    if (text->overflow)
+    {
+        return;
+    }
+
+    va_start(args, fmt);
+    const int n = vsnprintf(text->buffer + text->length, text->size - text->length, fmt, args);
+    va_end(args);
+
+    if ((n < 0) || ((size_t)n >= (text->size - text->length)))
+    {
+        text->overflow = true;
+        return;
+    }
+
+    text->length += (size_t)n;
+}
+
+/* Appends key=value unless an extra line replaces it. value is a stringified
+   settings macro; the parentheses around its expansion are dropped. */
+static void append_key(text_t *text, const char *key, const char *value)
+{
+    size_t length = strlen(value);
+
+    if ((length >= 2U) && (value[0] == '(') && (value[length - 1U] == ')'))
+    {
+        value++;
+        length -= 2U;
+    }
+
+    if (!overridden(text, key))
+    {
+        append(text, "%s=%.*s\n", key, (int)length, value);
+    }
+}
+
+size_t radr_build_metadata(char *buffer, size_t buffer_size, const char *const *extra, size_t num_extra)
+{
+    text_t text = {
+        .buffer = buffer,
+        .size = buffer_size,
+        .extra = extra,
+        .num_extra = (extra != NULL) ? num_extra : 0U
+    };
+
+    if ((buffer == NULL) || (buffer_size == 0U))
+    {
+        return 0U;
+    }
+
+    buffer[0] = '\0';
+    append_key(&text, "device", RADR_STRING(XENSIV_BGT60TRXX_CONF_DEVICE));
+    append_key(&text, "start_freq_hz", RADR_STRING(XENSIV_BGT60TRXX_CONF_START_FREQ_HZ));
+    append_key(&text, "end_freq_hz", RADR_STRING(XENSIV_BGT60TRXX_CONF_END_FREQ_HZ));
+    append_key(&text, "num_samples_per_chirp", RADR_STRING(XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP));
+    append_key(&text, "num_chirps_per_frame", RADR_STRING(XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME));
+    append_key(&text, "num_rx_antennas", RADR_STRING(XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS));
+    append_key(&text, "num_tx_antennas", RADR_STRING(XENSIV_BGT60TRXX_CONF_NUM_TX_ANTENNAS));
+    append_key(&text, "sample_rate", RADR_STRING(XENSIV_BGT60TRXX_CONF_SAMPLE_RATE));
+    append_key(&text, "chirp_repetition_time_s", RADR_STRING(XENSIV_BGT60TRXX_CONF_CHIRP_REPETITION_TIME_S));
+    append_key(&text, "frame_repetition_time_s", RADR_STRING(XENSIV_BGT60TRXX_CONF_FRAME_REPETITION_TIME_S));
+
+    if (!overridden(&text, "registers"))
+    {
+        append(&text, "registers=");
+
+        for (size_t i = 0; i < (sizeof(register_list) / sizeof(register_list[0])); i++)
+        {
+            append(&text, "%s0x%08lx", (i > 0U) ? "," : "", (unsigned long)register_list[i]);
+        }
+
+        append(&text, "\n");
+    }
+
+    for (size_t i = 0; i < text.num_extra; i++)
+    {
+        append(&text, "%s\n", text.extra[i]);
+    }
+
+    return text.overflow ? 0U : text.length;
+}
@@ -0,0 +1,23 @@
+#ifndef RADR_METADATA_H
+#define RADR_METADATA_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Writes the radar configuration the firmware is built with
+   (XENSIV_BGT60TRXX_CONF_* and the register list of
+   src/presence_radar_settings.h) as "key=value\n" lines, followed by the
+   given extra lines (each "key=value", may be NULL). A key given as extra
+   line replaces the built-in one, e.g. after 'profile apply'. Returns the
+   text length, or 0 if buffer is too small. */
+size_t radr_build_metadata(char *buffer, size_t buffer_size, const char *const *extra, size_t num_extra);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADR_METADATA_H */
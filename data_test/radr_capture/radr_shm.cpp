@@ -0,0 +1,504 @@
+/* Shared memory frame ring between radr_capture --publish and local
+   subscribers (radr_shm.h). The ring is a broadcast sequence lock: the broker
+   marks a slot as being written, copies the record and stamps the slot with
+   the record's sequence number; a subscriber reads a slot in place and
+   checks afterwards that the stamp did not change. */
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "radr_shm.h"
+
+namespace {
+
+constexpr uint32_t shm_magic = 0x4D485352u;     // "RSHM"
+constexpr uint32_t shm_version = 1;
+constexpr size_t line_size = 64;
+constexpr uint64_t slot_writing = ~0ull;
+
+constexpr uint32_t subscriber_free = 0;
+constexpr uint32_t subscriber_claimed = 1;
+constexpr uint32_t subscriber_active = 2;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "64-bit atomics must work across processes");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "32-bit atomics must work across processes");
+
+struct alignas(line_size) subscriber_t
+{
+    std::atomic<uint32_t> state;
+    uint32_t pid;
+    uint32_t mode;
+    std::atomic<uint64_t> read_seq;     // next record to read
+    std::atomic<uint64_t> received;
+    std::atomic<uint64_t> dropped;
+};
+
+struct alignas(line_size) control_t
+{
+    std::atomic<uint32_t> magic;        // written last by the broker
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    uint64_t slot_stride;
+    uint32_t broker_pid;
+    std::atomic<uint32_t> closed;
+    alignas(line_size) std::atomic<uint64_t> write_seq;     // next record to publish
+    subscriber_t subscribers[RADR_SHM_MAX_SUBSCRIBERS];
+};
+
+struct alignas(line_size) slot_t
+{
+    std::atomic<uint64_t> seq;          // sequence of the record held, slot_writing while copying
+    uint64_t size;
+};
+
+static_assert(sizeof(slot_t) == line_size, "slot header is one cache line");
+
+uint32_t current_pid()
+{
+#if defined(_WIN32)
+    return static_cast<uint32_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint32_t>(getpid());
+#endif
+}
+
+bool process_alive(uint32_t pid)
+{
+#if defined(_WIN32)
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, pid);
+
+    if (process == nullptr)
+        return false;
+
+    const bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+std::string object_name(const char* name)
+{
+#if defined(_WIN32)
+    return std::string("Local\\radr_") + name;
+#else
+    return std::string("/radr_") + name;
+#endif
+}
+
+}  // namespace
+
+struct radr_shm_s
+{
+    void* base = nullptr;
+    size_t size = 0;
+    control_t* control = nullptr;
+    bool broker = false;
+    uint32_t block_timeout_ms = 0;
+    std::string name;
+#if defined(_WIN32)
+    HANDLE mapping = nullptr;
+#endif
+
+    // subscriber
+    subscriber_t* subscriber = nullptr;
+    bool holding = false;
+    uint64_t held_seq = 0;
+
+    slot_t* slot(uint64_t seq) const
+    {
+        auto* slots = static_cast<uint8_t*>(base) + sizeof(control_t);
+        return reinterpret_cast<slot_t*>(slots + (seq % control->slot_count) * control->slot_stride);
+    }
+
+    uint8_t* slot_data(slot_t* s) const
+    {
+        return reinterpret_cast<uint8_t*>(s) + sizeof(slot_t);
+    }
+};
+
+namespace {
+
+bool map_object(radr_shm_s& shm, bool create, size_t size)
+{
+#if defined(_WIN32)
+    if (create)
+    {
+        shm.mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                         static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                         static_cast<DWORD>(size), shm.name.c_str());
+    }
+    else
+    {
+        shm.mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, shm.name.c_str());
+    }
+
+    if (shm.mapping == nullptr)
+        return false;
+
+    shm.base = MapViewOfFile(shm.mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (shm.base == nullptr)
+        return false;
+
+    if (size == 0)
+    {
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(shm.base, &info, sizeof(info));
+        size = info.RegionSize;
+    }
+#else
+    const int fd = create ? shm_open(shm.name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600)
+                          : shm_open(shm.name.c_str(), O_RDWR, 0);
+
+    if (fd < 0)
+        return false;
+
+    if (create && ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    if (size == 0)
+    {
+        const off_t end = lseek(fd, 0, SEEK_END);
+        size = (end > 0) ? static_cast<size_t>(end) : 0;
+    }
+
+    shm.base = (size > 0) ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+
+    if (shm.base == MAP_FAILED)
+    {
+        shm.base = nullptr;
+        return false;
+    }
+#endif
+
+    shm.size = size;
+    shm.control = static_cast<control_t*>(shm.base);
+    return true;
+}
+
+void unmap_object(radr_shm_s& shm)
+{
+#if defined(_WIN32)
+    if (shm.base != nullptr)
+        UnmapViewOfFile(shm.base);
+    if (shm.mapping != nullptr)
+        CloseHandle(shm.mapping);
+#else
+    if (shm.base != nullptr)
+        munmap(shm.base, shm.size);
+    if (shm.broker)
+        shm_unlink(shm.name.c_str());
+#endif
+}
+
+void pause_briefly()
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+}
+
+}  // namespace
+
+/*******************************************************************************
+* Broker
+*******************************************************************************/
+radr_shm_t* radr_shm_create(const char* name, uint32_t slot_count, uint32_t slot_size, uint32_t block_timeout_ms)
+{
+    if (name == nullptr || slot_count < 2 || slot_size == 0)
+        return nullptr;
+
+    auto* shm = new (std::nothrow) radr_shm_s;
+    if (shm == nullptr)
+        return nullptr;
+
+    const uint64_t stride = sizeof(slot_t) + (slot_size + line_size - 1) / line_size * line_size;
+
+    shm->name = object_name(name);
+    shm->broker = true;
+    shm->block_timeout_ms = block_timeout_ms;
+
+#if !defined(_WIN32)
+    // A broker that was killed leaves its object behind.
+    shm_unlink(shm->name.c_str());
+#endif
+
+    if (!map_object(*shm, true, sizeof(control_t) + slot_count * stride))
+    {
+        unmap_object(*shm);
+        delete shm;
+        return nullptr;
+    }
+
+    control_t* control = new (shm->base) control_t;
+
+    control->version = shm_version;
+    control->slot_count = slot_count;
+    control->slot_size = slot_size;
+    control->slot_stride = stride;
+    control->broker_pid = current_pid();
+    control->closed.store(0, std::memory_order_relaxed);
+    control->write_seq.store(0, std::memory_order_relaxed);
+
+    for (auto& subscriber : control->subscribers)
+        subscriber.state.store(subscriber_free, std::memory_order_relaxed);
+
+    for (uint32_t i = 0; i < slot_count; i++)
+        new (shm->slot(i)) slot_t {{slot_writing}, 0};
+
+    control->magic.store(shm_magic, std::memory_order_release);
+    return shm;
+}
+
+bool radr_shm_publish(radr_shm_t* shm, const radr_shm_part_t* parts, size_t num_parts)
+{
+    control_t* control = shm->control;
+    size_t total = 0;
+
+    for (size_t i = 0; i < num_parts; i++)
+        total += parts[i].size;
+
+    if (total > control->slot_size)
+        return false;
+
+    const uint64_t seq = control->write_seq.load(std::memory_order_relaxed);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(shm->block_timeout_ms);
+
+    // Backpressure: wait until every blocking subscriber has released the
+    // record this slot still holds.
+    for (auto& subscriber : control->subscribers)
+    {
+        if (subscriber.state.load(std::memory_order_acquire) != subscriber_active || subscriber.mode != RADR_SHM_BLOCK)
+            continue;
+
+        while (seq - subscriber.read_seq.load(std::memory_order_acquire) >= control->slot_count)
+        {
+            if (!process_alive(subscriber.pid))
+            {
+                subscriber.state.store(subscriber_free, std::memory_order_release);
+                break;
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
+
+            pause_briefly();
+        }
+    }
+
+    slot_t* slot = shm->slot(seq);
+    uint8_t* data = shm->slot_data(slot);
+
+    slot->seq.store(slot_writing, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < num_parts; i++)
+    {
+        std::memcpy(data, parts[i].data, parts[i].size);
+        data += parts[i].size;
+    }
+
+    slot->size = total;
+    slot->seq.store(seq, std::memory_order_release);
+    control->write_seq.store(seq + 1, std::memory_order_release);
+    return true;
+}
+
+bool radr_shm_subscriber_info(const radr_shm_t* shm, uint32_t index, radr_shm_subscriber_info_t* info)
+{
+    if (index >= RADR_SHM_MAX_SUBSCRIBERS)
+        return false;
+
+    const subscriber_t& subscriber = shm->control->subscribers[index];
+
+    if (subscriber.state.load(std::memory_order_acquire) != subscriber_active)
+        return false;
+
+    info->pid = subscriber.pid;
+    info->mode = static_cast<radr_shm_mode_t>(subscriber.mode);
+    info->received = subscriber.received.load(std::memory_order_relaxed);
+    info->dropped = subscriber.dropped.load(std::memory_order_relaxed);
+    info->lag = shm->control->write_seq.load(std::memory_order_relaxed) -
+                subscriber.read_seq.load(std::memory_order_relaxed);
+    return true;
+}
+
+/*******************************************************************************
+* Subscriber
+*******************************************************************************/
+radr_shm_t* radr_shm_attach(const char* name, radr_shm_mode_t mode)
+{
+    if (name == nullptr)
+        return nullptr;
+
+    auto* shm = new (std::nothrow) radr_shm_s;
+    if (shm == nullptr)
+        return nullptr;
+
+    shm->name = object_name(name);
+
+    if (!map_object(*shm, false, 0) || shm->size < sizeof(control_t) ||
+        shm->control->magic.load(std::memory_order_acquire) != shm_magic ||
+        shm->control->version != shm_version ||
+        shm->control->closed.load(std::memory_order_acquire) != 0)
+    {
+        unmap_object(*shm);
+        delete shm;
+        return nullptr;
+    }
+
+    control_t* control = shm->control;
+
+    for (int pass = 0; pass < 2 && shm->subscriber == nullptr; pass++)
+    {
+        for (auto& subscriber : control->subscribers)
+        {
+            uint32_t state = subscriber.state.load(std::memory_order_acquire);
+
+            // Second pass: take over slots of subscribers that died.
+            if (pass == 1 && state == subscriber_active && !process_alive(subscriber.pid))
+            {
+                if (subscriber.state.compare_exchange_strong(state, subscriber_free))
+                    state = subscriber_free;
+            }
+
+            uint32_t expected = subscriber_free;
+            if (state != subscriber_free || !subscriber.state.compare_exchange_strong(expected, subscriber_claimed))
+                continue;
+
+            subscriber.pid = current_pid();
+            subscriber.mode = static_cast<uint32_t>(mode);
+            subscriber.received.store(0, std::memory_order_relaxed);
+            subscriber.dropped.store(0, std::memory_order_relaxed);
+            subscriber.read_seq.store(control->write_seq.load(std::memory_order_acquire), std::memory_order_relaxed);
+            subscriber.state.store(subscriber_active, std::memory_order_release);
+            shm->subscriber = &subscriber;
+            break;
+        }
+    }
+
+    if (shm->subscriber == nullptr)
+    {
+        unmap_object(*shm);
+        delete shm;
+        return nullptr;
+    }
+
+    return shm;
+}
+
+int radr_shm_next(radr_shm_t* shm, radr_shm_frame_t* frame, uint32_t timeout_ms)
+{
+    control_t* control = shm->control;
+    subscriber_t* subscriber = shm->subscriber;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    if (shm->holding)
+        radr_shm_release(shm);
+
+    for (;;)
+    {
+        uint64_t read = subscriber->read_seq.load(std::memory_order_relaxed);
+        const uint64_t write = control->write_seq.load(std::memory_order_acquire);
+
+        if (read == write)
+        {
+            if (control->closed.load(std::memory_order_acquire) != 0)
+                return -1;
+            if (std::chrono::steady_clock::now() >= deadline)
+                return 0;
+            pause_briefly();
+            continue;
+        }
+
+        // Records before the last slot_count are gone; the oldest one of
+        // those may be rewritten right now, which the slot stamp tells.
+        const uint64_t oldest = (write > control->slot_count) ? write - control->slot_count : 0;
+
+        if (read < oldest)
+        {
+            subscriber->dropped.fetch_add(oldest - read, std::memory_order_relaxed);
+            read = oldest;
+            subscriber->read_seq.store(read, std::memory_order_release);
+        }
+
+        slot_t* slot = shm->slot(read);
+
+        if (slot->seq.load(std::memory_order_acquire) != read)
+        {
+            subscriber->dropped.fetch_add(1, std::memory_order_relaxed);
+            subscriber->read_seq.store(read + 1, std::memory_order_release);
+            continue;
+        }
+
+        frame->data = shm->slot_data(slot);
+        frame->size = slot->size;
+        frame->sequence = read;
+        shm->holding = true;
+        shm->held_seq = read;
+        return 1;
+    }
+}
+
+bool radr_shm_release(radr_shm_t* shm)
+{
+    if (!shm->holding)
+        return false;
+
+    subscriber_t* subscriber = shm->subscriber;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const bool intact = shm->slot(shm->held_seq)->seq.load(std::memory_order_relaxed) == shm->held_seq;
+
+    if (intact)
+        subscriber->received.fetch_add(1, std::memory_order_relaxed);
+    else
+        subscriber->dropped.fetch_add(1, std::memory_order_relaxed);
+
+    subscriber->read_seq.store(shm->held_seq + 1, std::memory_order_release);
+    shm->holding = false;
+    return intact;
+}
+
+void radr_shm_stats(const radr_shm_t* shm, uint64_t* received, uint64_t* dropped)
+{
+    if (shm->subscriber == nullptr)
+        return;
+
+    if (received != nullptr)
+        *received = shm->subscriber->received.load(std::memory_order_relaxed);
+    if (dropped != nullptr)
+        *dropped = shm->subscriber->dropped.load(std::memory_order_relaxed);
+}
+
+void radr_shm_close(radr_shm_t* shm)
+{
+    if (shm == nullptr)
+        return;
+
+    if (shm->broker)
+        shm->control->closed.store(1, std::memory_order_release);
+    else if (shm->subscriber != nullptr)
+        shm->subscriber->state.store(subscriber_free, std::memory_order_release);
+
+    unmap_object(*shm);
+    delete shm;
+}
@@ -0,0 +1,106 @@
+#ifndef RADR_SHM_H
+#define RADR_SHM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*******************************************************************************
+* Shared memory frame ring
+*******************************************************************************/
+/* One broker (radr_capture --publish) writes every frame record (stream
+   header + payload, as in a raw capture file) once into a ring of fixed-size
+   slots in a named shared memory object. Any number of local processes, up to
+   RADR_SHM_MAX_SUBSCRIBERS at a time, attach and read the records in place,
+   each at its own position:
+
+     RADR_SHM_DROP    the subscriber never slows the broker down; when it
+                      falls more than a ring behind, the oldest records are
+                      skipped and counted as dropped
+     RADR_SHM_BLOCK   the broker waits for the subscriber before reusing a
+                      slot it has not released yet, for at most the broker's
+                      block timeout per frame; after that the subscriber loses
+                      frames like a dropping one
+
+   Counters of every subscriber live in the shared memory, so the broker can
+   report them. */
+#define RADR_SHM_MAX_SUBSCRIBERS            (16U)
+
+typedef struct radr_shm_s radr_shm_t;
+
+typedef enum
+{
+    RADR_SHM_DROP = 0,
+    RADR_SHM_BLOCK = 1
+} radr_shm_mode_t;
+
+typedef struct
+{
+    const void *data;
+    size_t size;
+} radr_shm_part_t;
+
+/* A record in the ring; valid until radr_shm_release(). */
+typedef struct
+{
+    const uint8_t *data;            /* 64-byte aligned */
+    size_t size;
+    uint64_t sequence;              /* number of the record since the broker started */
+} radr_shm_frame_t;
+
+typedef struct
+{
+    uint32_t pid;
+    radr_shm_mode_t mode;
+    uint64_t received;
+    uint64_t dropped;
+    uint64_t lag;                   /* records published but not read yet */
+} radr_shm_subscriber_info_t;
+
+/*******************************************************************************
+* Broker
+*******************************************************************************/
+/* Creates (or replaces) the shared memory object name with slot_count slots
+   of slot_size bytes. */
+radr_shm_t *radr_shm_create(const char *name, uint32_t slot_count, uint32_t slot_size, uint32_t block_timeout_ms);
+
+/* Copies the concatenated parts into the next slot and publishes it. Returns
+   false if the record does not fit into a slot. */
+bool radr_shm_publish(radr_shm_t *shm, const radr_shm_part_t *parts, size_t num_parts);
+
+/* Counters of subscriber slot index (0 ... RADR_SHM_MAX_SUBSCRIBERS - 1).
+   Returns false if nobody is attached there. */
+bool radr_shm_subscriber_info(const radr_shm_t *shm, uint32_t index, radr_shm_subscriber_info_t *info);
+
+/*******************************************************************************
+* Subscriber
+*******************************************************************************/
+/* Attaches to a running broker; reading starts with the next record
+   published. Returns NULL if there is no broker or no free subscriber slot. */
+radr_shm_t *radr_shm_attach(const char *name, radr_shm_mode_t mode);
+
+/* Waits up to timeout_ms for the next record. Returns 1 with frame filled in,
+   0 on timeout and -1 once the broker has closed the ring. */
+int radr_shm_next(radr_shm_t *shm, radr_shm_frame_t *frame, uint32_t timeout_ms);
+
+/* Hands the record from radr_shm_next() back. Returns false if the broker
+   overwrote it in the meantime, i.e. the data read from it is not valid (the
+   record is counted as dropped then). */
+bool radr_shm_release(radr_shm_t *shm);
+
+void radr_shm_stats(const radr_shm_t *shm, uint64_t *received, uint64_t *dropped);
+
+/* Detaches a subscriber, or closes the ring of the broker (attached
+   subscribers see radr_shm_next() return -1). */
+void radr_shm_close(radr_shm_t *shm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RADR_SHM_H */
@@ -0,0 +1,168 @@
+/* Subscriber of the frame ring radr_capture --publish serves (radr_shm.h).
+   Writes the records it receives to a raw capture file, or just counts them,
+   and reports received and dropped frames. */
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "radr_shm.h"
+
+namespace {
+
+constexpr uint32_t poll_timeout_ms = 100;
+
+struct options_t
+{
+    std::string name = "radr";
+    std::string output;         // empty: count only
+    radr_shm_mode_t mode = RADR_SHM_DROP;
+    uint64_t frames = 0;        // 0: until interrupted or the broker exits
+};
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void handle_signal(int)
+{
+    g_stop = 1;
+}
+
+void usage(const char* name)
+{
+    std::fprintf(stderr,
+                 "Usage: %s [options]\n"
+                 "  --name <name>       ring published by radr_capture --publish (default radr)\n"
+                 "  --output <file>     write the records as raw capture\n"
+                 "  --block             hold the broker back instead of dropping frames\n"
+                 "  --frames <n>        stop after n records\n",
+                 name);
+}
+
+bool parse_options(int argc, char* argv[], options_t& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if (arg == "--name" && has_value)
+            options.name = argv[++i];
+        else if (arg == "--output" && has_value)
+            options.output = argv[++i];
+        else if (arg == "--block")
+            options.mode = RADR_SHM_BLOCK;
+        else if (arg == "--frames" && has_value)
+            options.frames = std::strtoull(argv[++i], nullptr, 10);
+        else
+            return false;
+    }
+
+    return !options.name.empty();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    options_t options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    radr_shm_t* shm = radr_shm_attach(options.name.c_str(), options.mode);
+    if (shm == nullptr)
+    {
+        std::fprintf(stderr, "No broker on '%s' or no free subscriber slot\n", options.name.c_str());
+        return 1;
+    }
+
+    FILE* file = nullptr;
+    if (!options.output.empty())
+    {
+        file = std::fopen(options.output.c_str(), "wb");
+        if (file == nullptr)
+        {
+            std::fprintf(stderr, "Cannot create %s\n", options.output.c_str());
+            radr_shm_close(shm);
+            return 1;
+        }
+        std::setvbuf(file, nullptr, _IOFBF, 1 << 20);
+    }
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    const auto start_time = std::chrono::steady_clock::now();
+    auto last_report = start_time;
+    std::vector<uint8_t> record;
+    uint64_t records = 0;
+    bool write_failed = false;
+
+    while (!g_stop && (options.frames == 0 || records < options.frames))
+    {
+        radr_shm_frame_t frame;
+        const int result = radr_shm_next(shm, &frame, poll_timeout_ms);
+
+        if (result < 0)
+        {
+            std::fprintf(stderr, "Broker closed the ring\n");
+            break;
+        }
+
+        if (result > 0)
+        {
+            // The record is taken out of the slot before it is validated;
+            // in drop mode the broker may overwrite it while it is read.
+            if (file != nullptr)
+                record.assign(frame.data, frame.data + frame.size);
+
+            if (radr_shm_release(shm))
+            {
+                records++;
+
+                if (file != nullptr && std::fwrite(record.data(), 1, record.size(), file) != record.size())
+                {
+                    write_failed = true;
+                    break;
+                }
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_report >= std::chrono::seconds(1))
+        {
+            uint64_t received = 0;
+            uint64_t dropped = 0;
+
+            radr_shm_stats(shm, &received, &dropped);
+            std::fprintf(stderr, "%.1f s: %llu received, %llu dropped\n",
+                         std::chrono::duration<double>(now - start_time).count(),
+                         static_cast<unsigned long long>(received), static_cast<unsigned long long>(dropped));
+            last_report = now;
+        }
+    }
+
+    uint64_t received = 0;
+    uint64_t dropped = 0;
+    radr_shm_stats(shm, &received, &dropped);
+    radr_shm_close(shm);
+
+    if (file != nullptr)
+        write_failed = (std::fclose(file) != 0) || write_failed;
+
+    if (write_failed)
+        std::fprintf(stderr, "Failed to write %s\n", options.output.c_str());
+
+    std::fprintf(stderr, "Records received: %llu\nRecords dropped: %llu\n",
+                 static_cast<unsigned long long>(received), static_cast<unsigned long long>(dropped));
+
+    return (write_failed || dropped > 0) ? 2 : 0;
+}
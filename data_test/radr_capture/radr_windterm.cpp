@@ -0,0 +1,768 @@
+/* Converts WindTerm text captures of the old firmware's frame dumps into
+   indexed .rcap containers (radr_file.h).
+
+   The log is mapped read-only and cut into chunks that each start at a frame
+   header line. Worker threads tokenize their chunks by hand (no regex, no
+   per-line allocation) and encode every complete frame as a version 4 stream
+   header plus U16LE payload in the firmware's [chirp][sample][rx] order; the
+   main thread appends the encoded chunks to the container in file order.
+   Three dump layouts are recognised, also mixed in one file:
+
+     [ts] ==== Frame N ====               --- RX Antenna K ---
+                                          Chirp C: v v v ...    (values may
+                                                                 continue on
+                                                                 the next lines)
+     [ts] === Frame N ... ===             [ts] Chirp C:
+                                          [ts] Sample S: [rx1, rx2, rx3]
+     [Frame N:]                           RXK:
+                                            ChirpC: v v v ...   (windterm/format.py)
+
+   The "[ts]" WindTerm timestamp prefix is optional on every line. */
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "radr_file.h"
+#include "radr_metadata.h"
+
+namespace {
+
+/*******************************************************************************
+* Stream format (src/main.c binary_frame_header_t)
+*******************************************************************************/
+constexpr size_t header_v4_size = 42;
+constexpr uint16_t header_version = 4;
+constexpr uint16_t sample_format_u16le = 0;
+
+constexpr uint32_t max_rx = 3;
+constexpr size_t default_chunk_mib = 8;
+constexpr size_t write_buffer_bytes = 4 * 1024 * 1024;
+constexpr size_t metadata_max_bytes = 4096;
+
+void put_u16(uint8_t* p, uint16_t value)
+{
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void put_u32(uint8_t* p, uint32_t value)
+{
+    put_u16(p, static_cast<uint16_t>(value));
+    put_u16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+/*******************************************************************************
+* Input mapping
+*******************************************************************************/
+class MappedFile
+{
+public:
+    ~MappedFile()
+    {
+#if defined(_WIN32)
+        if (m_data != nullptr)
+            UnmapViewOfFile(m_data);
+        if (m_mapping != nullptr)
+            CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE)
+            CloseHandle(m_file);
+#else
+        if (m_data != nullptr)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    bool open(const char* path)
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER size;
+
+        m_file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            return false;
+
+        m_size = static_cast<size_t>(size.QuadPart);
+        m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr)
+            return false;
+
+        m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        return m_data != nullptr;
+#else
+        struct stat st;
+        const int fd = ::open(path, O_RDONLY);
+
+        if (fd < 0)
+            return false;
+
+        if (fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+
+        if (data == MAP_FAILED)
+            return false;
+
+        // read once front to back by the chunk workers
+        madvise(data, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    const char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32)
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#endif
+};
+
+/*******************************************************************************
+* Tokenizer
+*******************************************************************************/
+enum class LineKind
+{
+    other,
+    frame,          // number: frame index
+    rx,             // number: antenna (1-based)
+    chirp,          // number: chirp; values may follow
+    sample,         // values: one per antenna
+    values          // continuation of the previous chirp's values
+};
+
+struct Line
+{
+    LineKind kind = LineKind::other;
+    uint32_t number = 0;
+    const char* rest = nullptr;     // values after the keyword
+};
+
+bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+const char* skip_space(const char* p, const char* end)
+{
+    while (p < end && is_space(*p))
+        p++;
+    return p;
+}
+
+/* Matches the literal word at p; returns the position after it or nullptr. */
+const char* match(const char* p, const char* end, const char* word)
+{
+    const size_t length = std::strlen(word);
+
+    if (static_cast<size_t>(end - p) < length || std::memcmp(p, word, length) != 0)
+        return nullptr;
+    return p + length;
+}
+
+const char* parse_number(const char* p, const char* end, uint32_t& value)
+{
+    uint64_t result = 0;
+    const char* start = p;
+
+    while (p < end && is_digit(*p))
+    {
+        result = result * 10 + static_cast<uint64_t>(*p - '0');
+        if (result > 0xFFFFFFFFu)
+            return nullptr;
+        p++;
+    }
+    value = static_cast<uint32_t>(result);
+    return (p == start) ? nullptr : p;
+}
+
+/* "Frame N" after the '=' run of a dump header. */
+bool parse_frame_title(const char* p, const char* end, Line& line)
+{
+    p = match(skip_space(p, end), end, "Frame");
+    if (p == nullptr || p == end || !is_space(*p))
+        return false;
+    if (parse_number(skip_space(p, end), end, line.number) == nullptr)
+        return false;
+    line.kind = LineKind::frame;
+    return true;
+}
+
+Line classify(const char* p, const char* end)
+{
+    Line line;
+
+    p = skip_space(p, end);
+    if (p < end && *p == '[')
+    {
+        // formatted_output.txt frame header, else a WindTerm timestamp
+        const char* q = match(p + 1, end, "Frame");
+        if (q != nullptr && q < end && is_space(*q) && parse_number(skip_space(q, end), end, line.number) != nullptr)
+        {
+            line.kind = LineKind::frame;
+            return line;
+        }
+
+        p = static_cast<const char*>(std::memchr(p, ']', static_cast<size_t>(end - p)));
+        if (p == nullptr)
+            return line;
+        p = skip_space(p + 1, end);
+    }
+
+    if (p == end)
+        return line;
+
+    const char* q;
+
+    if (*p == '=')
+    {
+        while (p < end && *p == '=')
+            p++;
+        parse_frame_title(p, end, line);
+    }
+    else if ((q = match(p, end, "---")) != nullptr)
+    {
+        q = match(skip_space(q, end), end, "RX Antenna");
+        if (q != nullptr && parse_number(skip_space(q, end), end, line.number) != nullptr)
+            line.kind = LineKind::rx;
+    }
+    else if ((q = match(p, end, "RX")) != nullptr)
+    {
+        q = parse_number(q, end, line.number);
+        if (q != nullptr && q < end && *q == ':')
+            line.kind = LineKind::rx;
+    }
+    else if ((q = match(p, end, "Chirp")) != nullptr)
+    {
+        q = parse_number(skip_space(q, end), end, line.number);
+        if (q != nullptr && q < end && *q == ':')
+        {
+            line.kind = LineKind::chirp;
+            line.rest = q + 1;
+        }
+    }
+    else if ((q = match(p, end, "Sample")) != nullptr)
+    {
+        q = parse_number(skip_space(q, end), end, line.number);
+        if (q != nullptr && q < end && *q == ':')
+        {
+            q = skip_space(q + 1, end);
+            if (q < end && *q == '[')
+            {
+                line.kind = LineKind::sample;
+                line.rest = q + 1;
+            }
+        }
+    }
+    else if (is_digit(*p))
+    {
+        line.kind = LineKind::values;
+        line.rest = p;
+    }
+
+    return line;
+}
+
+/* Appends the numbers separated by blanks or commas; stops at anything else.
+   Returns false for a value beyond 16 bits. */
+bool parse_values(const char* p, const char* end, std::vector<uint16_t>& out)
+{
+    for (;;)
+    {
+        while (p < end && (is_space(*p) || *p == ','))
+            p++;
+
+        uint32_t value;
+        const char* next = (p < end) ? parse_number(p, end, value) : nullptr;
+
+        if (next == nullptr)
+            return true;
+        if (value > 0xFFFFu)
+            return false;
+        out.push_back(static_cast<uint16_t>(value));
+        p = next;
+    }
+}
+
+/*******************************************************************************
+* Frame assembly
+*******************************************************************************/
+struct chunk_t
+{
+    const char* begin;
+    const char* end;
+    std::vector<uint8_t> records;   // encoded header + payload records
+    uint64_t frames = 0;
+    uint64_t skipped = 0;           // frames without a complete sample set
+    bool done = false;
+};
+
+class FrameBuilder
+{
+public:
+    explicit FrameBuilder(chunk_t& chunk) : m_chunk(chunk) {}
+
+    void begin(uint32_t index)
+    {
+        finish();
+        m_open = true;
+        m_bad = false;
+        m_index = index;
+        m_rx = 0;
+        m_chirp = nullptr;
+        m_have_chirp = false;
+        for (auto& chirps : m_chirps)
+            chirps.clear();
+    }
+
+    void select_rx(uint32_t rx)
+    {
+        m_rx = (rx >= 1 && rx <= max_rx) ? rx : 0;
+        m_chirp = nullptr;
+        m_bad |= (m_rx == 0);
+    }
+
+    /* Old and formatted layouts: values of one antenna's chirp. */
+    void select_chirp(uint32_t chirp)
+    {
+        if (!m_open)
+            return;
+
+        m_chirp_number = chirp;
+        m_have_chirp = true;
+        m_chirp = (m_rx != 0) ? &m_chirps[m_rx - 1][chirp] : nullptr;
+        if (m_chirp != nullptr)
+            m_chirp->clear();
+    }
+
+    void add_values(const char* p, const char* end)
+    {
+        if (m_open && m_chirp != nullptr && !parse_values(p, end, *m_chirp))
+            m_bad = true;
+    }
+
+    /* New layout: one sample of every antenna of the current chirp. */
+    void add_sample(const char* p, const char* end)
+    {
+        if (!m_open || !m_have_chirp)
+            return;
+
+        m_sample.clear();
+        if (!parse_values(p, end, m_sample) || m_sample.empty() || m_sample.size() > max_rx)
+        {
+            m_bad = true;
+            return;
+        }
+
+        for (size_t rx = 0; rx < m_sample.size(); rx++)
+            m_chirps[rx][m_chirp_number].push_back(m_sample[rx]);
+    }
+
+    /* Encodes the open frame if every antenna has the same chirps of the same
+       length. */
+    void finish()
+    {
+        if (!m_open)
+            return;
+        m_open = false;
+
+        uint16_t rx_mask = 0;
+        const std::map<uint32_t, std::vector<uint16_t>>* first = nullptr;
+        size_t samples = 0;
+        uint32_t num_rx = 0;
+
+        for (uint32_t rx = 0; rx < max_rx && !m_bad; rx++)
+        {
+            const auto& chirps = m_chirps[rx];
+
+            if (chirps.empty())
+                continue;
+
+            if (first == nullptr)
+            {
+                first = &chirps;
+                samples = chirps.begin()->second.size();
+            }
+            else if (chirps.size() != first->size())
+            {
+                m_bad = true;
+                break;
+            }
+
+            auto other = first->begin();
+            for (const auto& chirp : chirps)
+            {
+                if (chirp.first != other->first || chirp.second.size() != samples)
+                    m_bad = true;
+                ++other;
+            }
+
+            rx_mask |= static_cast<uint16_t>(1u << rx);
+            num_rx++;
+        }
+
+        const size_t chirps = (first != nullptr) ? first->size() : 0;
+        const size_t sample_count = chirps * samples * num_rx;
+
+        if (m_bad || sample_count == 0 || chirps > 0xFFFF || samples > 0xFFFF || sample_count > 0x7FFFFFFF)
+        {
+            m_chunk.skipped++;
+            return;
+        }
+
+        const size_t payload_size = sample_count * sizeof(uint16_t);
+        const size_t offset = m_chunk.records.size();
+
+        m_chunk.records.resize(offset + header_v4_size + payload_size);
+        uint8_t* header = m_chunk.records.data() + offset;
+        uint8_t* payload = header + header_v4_size;
+
+        // gather the antennas' chirps into [chirp][sample][rx]
+        size_t n = 0;
+        for (const auto& chirp : *first)
+        {
+            for (size_t s = 0; s < samples; s++)
+            {
+                for (uint32_t rx = 0; rx < max_rx; rx++)
+                {
+                    if (rx_mask & (1u << rx))
+                        put_u16(payload + 2 * n++, m_chirps[rx].at(chirp.first)[s]);
+                }
+            }
+        }
+
+        std::memcpy(header, "RADR", 4);
+        put_u16(header + 4, header_version);
+        put_u16(header + 6, sizeof(uint16_t));
+        put_u32(header + 8, m_index);
+        put_u32(header + 12, static_cast<uint32_t>(sample_count));
+        put_u16(header + 16, sample_format_u16le);
+        put_u16(header + 18, 0);
+        put_u32(header + 20, static_cast<uint32_t>(payload_size));
+        put_u32(header + 24, 0);    // the dumps carry no frame timestamp
+        put_u32(header + 28, radr_crc32(0, payload, payload_size));
+        put_u16(header + 32, rx_mask);
+        put_u16(header + 34, 0);
+        put_u16(header + 36, static_cast<uint16_t>(chirps));
+        put_u16(header + 38, 0);
+        put_u16(header + 40, static_cast<uint16_t>(samples));
+        m_chunk.frames++;
+    }
+
+    bool open() const { return m_open; }
+
+private:
+    chunk_t& m_chunk;
+    bool m_open = false;
+    bool m_bad = false;
+    uint32_t m_index = 0;
+    uint32_t m_rx = 0;
+    uint32_t m_chirp_number = 0;
+    bool m_have_chirp = false;
+    std::vector<uint16_t>* m_chirp = nullptr;
+    std::map<uint32_t, std::vector<uint16_t>> m_chirps[max_rx];
+    std::vector<uint16_t> m_sample;
+};
+
+void convert_chunk(chunk_t& chunk)
+{
+    FrameBuilder frame(chunk);
+    const char* p = chunk.begin;
+
+    while (p < chunk.end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(chunk.end - p)));
+        if (eol == nullptr)
+            eol = chunk.end;
+
+        const Line line = classify(p, eol);
+
+        switch (line.kind)
+        {
+            case LineKind::frame:
+                frame.begin(line.number);
+                break;
+            case LineKind::rx:
+                if (frame.open())
+                    frame.select_rx(line.number);
+                break;
+            case LineKind::chirp:
+                frame.select_chirp(line.number);
+                frame.add_values(line.rest, eol);
+                break;
+            case LineKind::sample:
+                frame.add_sample(line.rest, eol);
+                break;
+            case LineKind::values:
+                frame.add_values(line.rest, eol);
+                break;
+            case LineKind::other:
+                break;
+        }
+
+        p = eol + 1;
+    }
+
+    frame.finish();
+}
+
+/* Start of the first frame header line at or after p. */
+const char* next_frame(const char* p, const char* end)
+{
+    while (p < end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (eol == nullptr)
+            eol = end;
+        if (classify(p, eol).kind == LineKind::frame)
+            return p;
+        p = eol + 1;
+    }
+    return end;
+}
+
+/* Cuts the text into chunks of about chunk_bytes that start at a frame
+   header, so no frame spans two workers. */
+std::vector<chunk_t> split(const char* data, size_t size, size_t chunk_bytes)
+{
+    std::vector<chunk_t> chunks;
+    const char* end = data + size;
+    const char* begin = data;
+
+    while (begin < end)
+    {
+        const char* cut = end;
+
+        if (static_cast<size_t>(end - begin) > chunk_bytes)
+        {
+            const char* eol = static_cast<const char*>(
+                std::memchr(begin + chunk_bytes, '\n', static_cast<size_t>(end - begin - chunk_bytes)));
+            cut = (eol != nullptr) ? next_frame(eol + 1, end) : end;
+        }
+
+        chunk_t chunk;
+        chunk.begin = begin;
+        chunk.end = cut;
+        chunks.push_back(std::move(chunk));
+        begin = cut;
+    }
+
+    return chunks;
+}
+
+/*******************************************************************************
+* Main
+*******************************************************************************/
+struct options_t
+{
+    std::string input;
+    std::string output;
+    unsigned threads = 0;
+    size_t chunk_mib = default_chunk_mib;
+    std::vector<const char*> metadata;
+};
+
+void usage(const char* name)
+{
+    std::fprintf(stderr,
+                 "Usage: %s <capture.log> <output.rcap> [options]\n"
+                 "  --threads <n>       worker threads (default: one per core)\n"
+                 "  --chunk-mib <n>     text per work item in MiB (default %zu)\n"
+                 "  --meta <key=value>  add or replace a container metadata line\n",
+                 name, default_chunk_mib);
+}
+
+bool parse_options(int argc, char* argv[], options_t& options)
+{
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+
+        if (arg == "--threads" && has_value)
+            options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--chunk-mib" && has_value)
+            options.chunk_mib = std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--meta" && has_value && std::strchr(argv[i + 1], '=') != nullptr)
+            options.metadata.push_back(argv[++i]);
+        else if (arg.compare(0, 2, "--") != 0)
+            files.push_back(arg);
+        else
+            return false;
+    }
+
+    if (files.size() != 2 || options.chunk_mib == 0)
+        return false;
+
+    options.input = files[0];
+    options.output = files[1];
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    options_t options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    MappedFile input;
+
+    if (!input.open(options.input.c_str()))
+    {
+        std::fprintf(stderr, "Cannot read %s\n", options.input.c_str());
+        return 1;
+    }
+
+    // the board's configuration is the best guess for a legacy dump; --meta
+    // corrects it
+    static char metadata[metadata_max_bytes];
+    std::vector<const char*> extra = {"source=windterm"};
+    extra.insert(extra.end(), options.metadata.begin(), options.metadata.end());
+    const size_t metadata_size = radr_build_metadata(metadata, sizeof(metadata), extra.data(), extra.size());
+
+    radr_file_writer_t* writer = (metadata_size > 0)
+        ? radr_file_writer_open_buffered(options.output.c_str(), metadata, metadata_size, write_buffer_bytes)
+        : nullptr;
+
+    if (writer == nullptr)
+    {
+        std::fprintf(stderr, "Cannot create %s\n", options.output.c_str());
+        return 1;
+    }
+
+    std::vector<chunk_t> chunks = split(input.data(), input.size(), options.chunk_mib * 1024 * 1024);
+    const unsigned threads = std::max(1u, options.threads ? options.threads : std::thread::hardware_concurrency());
+
+    // Workers take chunks in file order but may finish out of order; at most
+    // two chunks per worker are held in memory ahead of the writer.
+    const size_t max_ahead = 2 * static_cast<size_t>(threads);
+    std::mutex lock;
+    std::condition_variable changed;
+    size_t next_chunk = 0;
+    size_t written = 0;
+    std::vector<std::thread> workers;
+
+    for (unsigned t = 0; t < std::min<size_t>(threads, chunks.size()); t++)
+    {
+        workers.emplace_back([&]() {
+            for (;;)
+            {
+                size_t n;
+                {
+                    std::unique_lock<std::mutex> guard(lock);
+                    changed.wait(guard, [&]() { return next_chunk >= chunks.size() || next_chunk < written + max_ahead; });
+                    if (next_chunk >= chunks.size())
+                        return;
+                    n = next_chunk++;
+                }
+
+                convert_chunk(chunks[n]);
+
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    chunks[n].done = true;
+                }
+                changed.notify_all();
+            }
+        });
+    }
+
+    uint64_t frames = 0;
+    uint64_t skipped = 0;
+    bool ok = true;
+
+    for (chunk_t& chunk : chunks)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&]() { return chunk.done; });
+        }
+
+        const uint8_t* record = chunk.records.data();
+        const uint8_t* end = record + chunk.records.size();
+
+        while (ok && record < end)
+        {
+            const size_t payload_size = get_u32(record + 20);
+
+            ok = radr_file_writer_add(writer, record, header_v4_size, record + header_v4_size, payload_size, nullptr, 0);
+            record += header_v4_size + payload_size;
+        }
+
+        frames += chunk.frames;
+        skipped += chunk.skipped;
+        std::vector<uint8_t>().swap(chunk.records);
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            written++;
+        }
+        changed.notify_all();
+    }
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    ok = radr_file_writer_close(writer) && ok;
+
+    if (!ok)
+    {
+        std::fprintf(stderr, "Write to %s failed\n", options.output.c_str());
+        return 1;
+    }
+
+    std::fprintf(stderr, "%llu frames written to %s from %zu chunks on %u threads",
+                 static_cast<unsigned long long>(frames), options.output.c_str(), chunks.size(), threads);
+    if (skipped > 0)
+        std::fprintf(stderr, ", %llu incomplete frames skipped", static_cast<unsigned long long>(skipped));
+    std::fprintf(stderr, "\n");
+
+    return (frames > 0) ? 0 : 1;
+}
@@ -5,6 +5,7 @@ import argparse
 import struct
 import sys
 import time
+import zlib
 from contextlib import nullcontext
 from typing import Optional, Sequence
 
@@ -14,14 +15,140 @@ import serial
 HEADER_STRUCT = struct.Struct("<4sHHII")
 HEADER_MAGIC = b"RADR"
 HEADER_SIZE = HEADER_STRUCT.size
-SUPPORTED_HEADER_VERSION = 1
-
-
-def _build_start_command(frames: Optional[int]) -> bytes:
-    if frames is None:
-        return b"start\r\n"
-
-    return f"start {frames}\r\n".encode("ascii")
+# Version 2 appends sample_format, flags and payload_size to the v1 header.
+HEADER_V2_EXT_STRUCT = struct.Struct("<HHI")
+# Version 3 appends the frame timestamp (us, wraps at 2**32) and the payload CRC-32.
+HEADER_V3_EXT_STRUCT = struct.Struct("<II")
+# Version 4 appends the region of interest: rx_mask, first_chirp, num_chirps,
+# first_sample, num_samples (rx_mask 0 for frames that are not sensor frames).
+HEADER_V4_EXT_STRUCT = struct.Struct("<HHHHH")
+SUPPORTED_HEADER_VERSIONS = (1, 2, 3, 4)
+
+SAMPLE_FORMAT_U16LE = 0
+SAMPLE_FORMAT_PACKED12 = 1
+SAMPLE_FORMAT_RANGE_CINT16 = 2
+SAMPLE_FORMAT_RANGE_MAG_U16 = 3
+SAMPLE_FORMAT_PRESENCE = 4
+SAMPLE_FORMAT_CONTROL = 5
+SAMPLE_FORMAT_NAMES = {
+    "u16": SAMPLE_FORMAT_U16LE,
+    "packed12": SAMPLE_FORMAT_PACKED12,
+    "fft": SAMPLE_FORMAT_RANGE_CINT16,
+    "fft-mag": SAMPLE_FORMAT_RANGE_MAG_U16,
+    "presence": SAMPLE_FORMAT_PRESENCE,
+}
+# Firmware start tokens for each --format choice.
+SAMPLE_FORMAT_TOKENS = {"fft-mag": "fft mag"}
+RANGE_FORMATS = (SAMPLE_FORMAT_RANGE_CINT16, SAMPLE_FORMAT_RANGE_MAG_U16)
+RANGE_FFT_FRAC_BITS = 4
+# present, changed, range_bin, distance_mm, level (src/main.c presence_event_t)
+PRESENCE_EVENT_STRUCT = struct.Struct("<BBHHH")
+
+FLAG_DELTA_RICE = 0x0001
+FLAG_FIFO_OVERFLOW = 0x0002
+FLAG_TRIGGER = 0x0004
+# log2 of the fast-time decimation of a frame (header flags bits 12-15)
+FLAG_SAMPLE_SHIFT_POS = 12
+FLAG_SHIFT_MASK = 0x0F
+
+# Binary control requests (src/control.h): sync, opcode, request_id, length,
+# payload, CRC-16/CCITT-FALSE over everything before it.
+CONTROL_SYNC = 0xA5
+CONTROL_REQUEST_STRUCT = struct.Struct("<BBHH")
+CONTROL_RESPONSE_STRUCT = struct.Struct("<HBB")
+CONTROL_START_STRUCT = struct.Struct("<IHBB")
+# control_start_roi_t: control_start_t plus rx_mask, first_chirp, num_chirps,
+# first_sample, num_samples
+CONTROL_START_ROI_STRUCT = struct.Struct("<IHBBHHHHH")
+CONTROL_OP_START = 0x01
+CONTROL_OP_STOP = 0x02
+
+# Run-time baud negotiation ('baud' command, src/uart_baud.h): rates tried by
+# --negotiate-baud without a list, fastest first, the verify line and the
+# firmware's timeout per step.
+BAUD_CANDIDATES = (4000000, 3000000, 2000000, 1500000, 1000000, 921600, 460800)
+BAUD_VERIFY_PATTERN = "UUUU****~~~~@@@@0000!!!!U*~@0!pz"
+BAUD_STEP_TIMEOUT = 2.0
+
+
+def _build_start_command(
+    frames: Optional[int],
+    sample_format: Optional[str] = None,
+    compress: bool = False,
+    chirp_average: int = 1,
+    decimation: int = 1,
+    rx_mask: int = 0,
+    chirps: Optional[tuple[int, int]] = None,
+    samples: Optional[tuple[int, int]] = None,
+) -> bytes:
+    args = ["start"]
+    if frames is not None:
+        args.append(str(frames))
+    if sample_format is not None:
+        args.append(SAMPLE_FORMAT_TOKENS.get(sample_format, sample_format))
+    if compress:
+        args.append("rice")
+    if chirp_average > 1:
+        args.extend(("avg", str(chirp_average)))
+    if decimation > 1:
+        args.extend(("decim", str(decimation)))
+    if rx_mask:
+        args.extend(("rx", str(rx_mask)))
+    if chirps is not None:
+        args.extend(("chirps", f"{chirps[0]}:{chirps[1]}"))
+    if samples is not None:
+        args.extend(("samples", f"{samples[0]}:{samples[1]}"))
+
+    return (" ".join(args) + "\r\n").encode("ascii")
+
+
+def _crc16_ccitt(data: bytes) -> int:
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def _build_request(opcode: int, request_id: int, payload: bytes = b"") -> bytes:
+    packet = CONTROL_REQUEST_STRUCT.pack(CONTROL_SYNC, opcode, request_id & 0xFFFF, len(payload)) + payload
+    return packet + struct.pack("<H", _crc16_ccitt(packet))
+
+
+def _build_binary_start(
+    frames: Optional[int],
+    sample_format: Optional[str] = None,
+    compress: bool = False,
+    chirp_average: int = 1,
+    decimation: int = 1,
+    rx_mask: int = 0,
+    chirps: Optional[tuple[int, int]] = None,
+    samples: Optional[tuple[int, int]] = None,
+) -> bytes:
+    format_code = SAMPLE_FORMAT_NAMES.get(sample_format, SAMPLE_FORMAT_U16LE) if sample_format else SAMPLE_FORMAT_U16LE
+    # log2 of both factors, chirps in the low nibble.
+    reduction = (chirp_average.bit_length() - 1) | ((decimation.bit_length() - 1) << 4)
+    if rx_mask or chirps is not None or samples is not None:
+        payload = CONTROL_START_ROI_STRUCT.pack(
+            frames or 0, format_code, 1 if compress else 0, reduction, rx_mask, *(chirps or (0, 0)), *(samples or (0, 0))
+        )
+    else:
+        payload = CONTROL_START_STRUCT.pack(frames or 0, format_code, 1 if compress else 0, reduction)
+    return _build_request(CONTROL_OP_START, 1, payload)
+
+
+def _parse_window(value: str) -> tuple[int, int]:
+    """argparse type for "COUNT" or "FIRST:COUNT"."""
+    first, _, count = value.rpartition(":")
+    try:
+        window = (int(first or 0), int(count))
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected COUNT or FIRST:COUNT, got {value!r}") from None
+    if window[0] < 0 or window[1] <= 0:
+        raise argparse.ArgumentTypeError(f"expected COUNT or FIRST:COUNT, got {value!r}")
+    return window
 
 
 def _align_stream(port: serial.Serial) -> tuple[str, bytearray]:
@@ -63,7 +190,118 @@ def _fill_buffer(port: serial.Serial, buffer: bytearray, target_size: int) -> No
         time.sleep(0.005)
 
 
-def _unpack_samples(payload: bytes, sample_count: int, sample_size: int) -> Sequence[int]:
+def _read_line(port: serial.Serial, deadline: float) -> Optional[str]:
+    """Read one non-empty text line, or None once the deadline passed."""
+
+    line = bytearray()
+    while time.monotonic() < deadline:
+        byte = port.read(1)
+        if not byte:
+            continue
+        if byte in b"\r\n":
+            if line:
+                return line.decode("ascii", errors="replace")
+            continue
+        line.extend(byte)
+    return None
+
+
+def _expect_line(port: serial.Serial, prefix: str, timeout: float) -> Optional[str]:
+    """Skip lines until one starts with prefix; None after timeout."""
+
+    deadline = time.monotonic() + timeout
+    while (line := _read_line(port, deadline)) is not None:
+        if line.startswith(prefix):
+            return line
+    return None
+
+
+def _negotiate_baud(port: serial.Serial, rates: Sequence[int]) -> int:
+    """Move the firmware and the port to the first rate of rates that passes
+    the firmware's verify exchange; returns the rate in use afterwards. A
+    rate that fails leaves both sides at the previous one."""
+
+    for rate in rates:
+        if rate == port.baudrate:
+            return rate
+
+        previous = port.baudrate
+        port.reset_input_buffer()
+        port.write(f"baud {rate}\r\n".encode("ascii"))
+        port.flush()
+        reply = _read_line(port, time.monotonic() + BAUD_STEP_TIMEOUT)
+        if reply is None or not reply.startswith("Baud: switching"):
+            sys.stderr.write(f"Baud {rate} refused: {reply or 'no answer'}\n")
+            continue
+
+        port.baudrate = rate
+        time.sleep(0.05)
+        port.reset_input_buffer()
+        verify = f"baud verify {BAUD_VERIFY_PATTERN}"
+        port.write((verify + "\r\n").encode("ascii"))
+        port.flush()
+
+        if _expect_line(port, verify, BAUD_STEP_TIMEOUT) == verify:
+            port.write(b"baud commit\r\n")
+            port.flush()
+            if _expect_line(port, "Baud rate now", BAUD_STEP_TIMEOUT) == f"Baud rate now {rate}.":
+                sys.stderr.write(f"Negotiated {rate} baud.\n")
+                return rate
+
+        # The firmware falls back after its step timeout.
+        port.baudrate = previous
+        port.reset_input_buffer()
+        _expect_line(port, "Baud negotiation failed", 2 * BAUD_STEP_TIMEOUT + 1.0)
+        sys.stderr.write(f"Baud {rate}: verification failed, staying at {previous}.\n")
+
+    return port.baudrate
+
+
+def _parse_rates(value: str) -> tuple[int, ...]:
+    """argparse type for a comma-separated list of baud rates."""
+    try:
+        rates = tuple(int(rate) for rate in value.split(","))
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected RATE[,RATE...], got {value!r}") from None
+    if not rates or min(rates) <= 0:
+        raise argparse.ArgumentTypeError(f"expected RATE[,RATE...], got {value!r}")
+    return rates
+
+
+def _unpack_packed12(payload: bytes, sample_count: int) -> Sequence[int]:
+    """Decode two 12-bit samples per three bytes (strata Packed12 layout)."""
+
+    if len(payload) != (sample_count + 1) // 2 * 3:
+        raise RuntimeError("Packed12 payload size does not match header metadata.")
+
+    b0 = payload[0::3]
+    b1 = payload[1::3]
+    b2 = payload[2::3]
+    samples = [0] * (len(b0) * 2)
+    samples[0::2] = [(x << 4) | (y >> 4) for x, y in zip(b0, b1)]
+    samples[1::2] = [((y & 0x0F) << 8) | z for y, z in zip(b1, b2)]
+    return samples[:sample_count]
+
+
+def _unpack_samples(
+    payload: bytes, sample_count: int, sample_size: int, sample_format: int = SAMPLE_FORMAT_U16LE
+) -> Sequence[int]:
+    if sample_format == SAMPLE_FORMAT_PACKED12:
+        return _unpack_packed12(payload, sample_count)
+
+    if sample_format in RANGE_FORMATS:
+        if len(payload) != sample_count * sample_size:
+            raise RuntimeError("Payload size does not match header metadata.")
+
+        scale = 1.0 / (1 << RANGE_FFT_FRAC_BITS)
+        if sample_format == SAMPLE_FORMAT_RANGE_CINT16:
+            values = struct.unpack(f"<{sample_count * 2}h", payload)
+            return [complex(re * scale, im * scale) for re, im in zip(values[0::2], values[1::2])]
+        return [value * scale for value in struct.unpack(f"<{sample_count}H", payload)]
+
+    if sample_format != SAMPLE_FORMAT_U16LE:
+        raise RuntimeError(f"Unsupported sample format: {sample_format}")
+
     if len(payload) != sample_count * sample_size:
         raise RuntimeError("Payload size does not match header metadata.")
 
@@ -141,7 +379,16 @@ def main() -> int:
         "--baud",
         type=int,
         default=115200,
-        help="UART baud rate. Must match CY_RETARGET_IO_BAUDRATE (default: 115200).",
+        help="UART baud rate the firmware runs at now: STREAM_UART_BAUDRATE after reset (default: 115200).",
+    )
+    parser.add_argument(
+        "--negotiate-baud",
+        nargs="?",
+        const=BAUD_CANDIDATES,
+        type=_parse_rates,
+        metavar="RATE[,RATE...]",
+        help="Before starting, switch the board and the port to the first of these rates that passes the "
+        f"firmware's verify exchange (default list: {','.join(map(str, BAUD_CANDIDATES))}).",
     )
     parser.add_argument(
         "--output",
@@ -175,6 +422,50 @@ def main() -> int:
         default=128,
         help="Number of ADC samples per chirp (default: 128).",
     )
+    parser.add_argument(
+        "--format",
+        choices=sorted(SAMPLE_FORMAT_NAMES),
+        help="Payload encoding to request from the firmware (default: firmware default).",
+    )
+    parser.add_argument(
+        "--compress",
+        action="store_true",
+        help="Request lossless delta/Rice compressed payloads (decode with format_binary_frames.py).",
+    )
+    parser.add_argument(
+        "--chirp-average",
+        type=int,
+        default=1,
+        help="Average this many consecutive chirps on the board (power of two, default: 1).",
+    )
+    parser.add_argument(
+        "--decimation",
+        type=int,
+        default=1,
+        help="Decimate each chirp's samples by this factor on the board (power of two, default: 1).",
+    )
+    parser.add_argument(
+        "--rx-mask",
+        type=lambda value: int(value, 0),
+        default=0,
+        help="Send only these antennas, bit n = RX n (e.g. 0x1; default: all).",
+    )
+    parser.add_argument(
+        "--chirps",
+        type=_parse_window,
+        help="Send only COUNT chirps of each frame, from chirp FIRST (FIRST:COUNT or COUNT; default: all).",
+    )
+    parser.add_argument(
+        "--samples",
+        type=_parse_window,
+        help="Send only COUNT samples of each chirp, from sample FIRST (FIRST:COUNT or COUNT, "
+        "COUNT a power of two; default: all).",
+    )
+    parser.add_argument(
+        "--binary-control",
+        action="store_true",
+        help="Send start/stop as binary control requests instead of text commands.",
+    )
     parser.add_argument(
         "--stop-on-exit",
         action="store_true",
@@ -185,9 +476,24 @@ def main() -> int:
     if args.frames is not None and args.frames < 0:
         parser.error("--frames must be >= 0")
 
+    for name in ("chirp_average", "decimation"):
+        factor = getattr(args, name)
+        if factor < 1 or factor & (factor - 1):
+            parser.error(f"--{name.replace('_', '-')} must be a power of two")
+
     frames_arg = None if args.frames in (None, 0) else args.frames
-    start_command = _build_start_command(frames_arg)
-    stop_command = b"stop\r\n"
+    if args.binary_control:
+        start_command = _build_binary_start(
+            frames_arg, args.format, args.compress, args.chirp_average, args.decimation,
+            args.rx_mask, args.chirps, args.samples,
+        )
+        stop_command = _build_request(CONTROL_OP_STOP, 2)
+    else:
+        start_command = _build_start_command(
+            frames_arg, args.format, args.compress, args.chirp_average, args.decimation,
+            args.rx_mask, args.chirps, args.samples,
+        )
+        stop_command = b"stop\r\n"
 
     try:
         with serial.Serial(args.port, baudrate=args.baud, timeout=args.timeout) as ser, \
@@ -197,13 +503,17 @@ def main() -> int:
             ser.reset_input_buffer()
             ser.reset_output_buffer()
 
+            if args.negotiate_baud:
+                _negotiate_baud(ser, args.negotiate_baud)
+                ser.reset_input_buffer()
+
             ser.write(start_command)
             ser.flush()
 
             status_text, buffer = _align_stream(ser)
 
             sys.stderr.write(
-                f"Started capture -> port={args.port}, baud={args.baud}, "
+                f"Started capture -> port={args.port}, baud={ser.baudrate}, "
                 f"frames={'continuous' if frames_arg is None else frames_arg}, "
                 f"output='{args.output}'\n"
             )
@@ -243,16 +553,61 @@ def main() -> int:
                     if magic != HEADER_MAGIC:
                         raise RuntimeError("Stream out of sync: header magic mismatch.")
 
-                    if version != SUPPORTED_HEADER_VERSION:
+                    if version not in SUPPORTED_HEADER_VERSIONS:
                         raise RuntimeError(
-                            f"Unsupported header version {version}; expected {SUPPORTED_HEADER_VERSION}."
+                            f"Unsupported header version {version}; expected one of {SUPPORTED_HEADER_VERSIONS}."
                         )
 
+                    sample_format = SAMPLE_FORMAT_U16LE
+                    flags = 0
                     payload_size = sample_count * sample_size
+
+                    if version >= 2:
+                        _fill_buffer(ser, buffer, HEADER_V2_EXT_STRUCT.size)
+                        ext_bytes = bytes(buffer[:HEADER_V2_EXT_STRUCT.size])
+                        del buffer[:HEADER_V2_EXT_STRUCT.size]
+                        header_bytes += ext_bytes
+                        sample_format, flags, payload_size = HEADER_V2_EXT_STRUCT.unpack(ext_bytes)
+
+                    payload_crc = None
+
+                    if version >= 3:
+                        _fill_buffer(ser, buffer, HEADER_V3_EXT_STRUCT.size)
+                        ext_bytes = bytes(buffer[:HEADER_V3_EXT_STRUCT.size])
+                        del buffer[:HEADER_V3_EXT_STRUCT.size]
+                        header_bytes += ext_bytes
+                        _, payload_crc = HEADER_V3_EXT_STRUCT.unpack(ext_bytes)
+
+                    roi = None
+
+                    if version >= 4:
+                        _fill_buffer(ser, buffer, HEADER_V4_EXT_STRUCT.size)
+                        ext_bytes = bytes(buffer[:HEADER_V4_EXT_STRUCT.size])
+                        del buffer[:HEADER_V4_EXT_STRUCT.size]
+                        header_bytes += ext_bytes
+                        roi = HEADER_V4_EXT_STRUCT.unpack(ext_bytes)
+                        if roi[0] == 0:
+                            roi = None
+
                     _fill_buffer(ser, buffer, payload_size)
                     payload = bytes(buffer[:payload_size])
                     del buffer[:payload_size]
 
+                    crc_ok = payload_crc is None or zlib.crc32(payload) == payload_crc
+
+                    if sample_format == SAMPLE_FORMAT_CONTROL:
+                        # Answer to a binary request; not a sensor frame.
+                        outfile.write(header_bytes)
+                        outfile.write(payload)
+                        if crc_ok and len(payload) >= CONTROL_RESPONSE_STRUCT.size:
+                            request_id, opcode, status = CONTROL_RESPONSE_STRUCT.unpack_from(payload)
+                            sys.stderr.write(
+                                f"Control response: request {request_id}, opcode 0x{opcode:02x}, status {status}.\n"
+                            )
+                            if opcode == CONTROL_OP_START and status != 0:
+                                raise RuntimeError(f"Firmware rejected the start request (status {status}).")
+                        continue
+
                     outfile.write(header_bytes)
                     outfile.write(payload)
                     outfile.flush()
@@ -261,19 +616,54 @@ def main() -> int:
                     if pending_frames is not None:
                         pending_frames -= 1
 
+                    notes = ""
+                    if flags & FLAG_FIFO_OVERFLOW:
+                        notes += ", frames lost before it"
+                    if flags & FLAG_TRIGGER:
+                        notes += ", motion trigger"
+                    if not crc_ok:
+                        notes += ", payload CRC mismatch"
+
                     sys.stderr.write(
-                        f"Captured frame {frame_index} (#{frames_captured} in session, {sample_count} samples).\n"
+                        f"Captured frame {frame_index} (#{frames_captured} in session, {sample_count} samples{notes}).\n"
                     )
                     sys.stderr.flush()
 
-                    if formatted:
-                        samples = _unpack_samples(payload, sample_count, sample_size)
+                    if formatted and not crc_ok:
+                        formatted.write(f"Frame {frame_index}: payload CRC mismatch, skipped\n\n")
+                        formatted.flush()
+                    elif formatted and sample_format == SAMPLE_FORMAT_PRESENCE:
+                        present, changed, range_bin, distance_mm, level = PRESENCE_EVENT_STRUCT.unpack(payload)
+                        formatted.write(
+                            f"Frame {frame_index}: {'present' if present else 'absent'}"
+                            f"{' (changed)' if changed else ''}, bin {range_bin}, "
+                            f"{distance_mm / 1000:.3f} m, level {level / (1 << RANGE_FFT_FRAC_BITS):.2f}\n"
+                        )
+                        formatted.flush()
+                    elif formatted and flags & FLAG_DELTA_RICE:
+                        formatted.write(
+                            f"Frame {frame_index} ({sample_count} samples, compressed; "
+                            "decode the capture with format_binary_frames.py)\n\n"
+                        )
+                        formatted.flush()
+                    elif formatted:
+                        samples = _unpack_samples(payload, sample_count, sample_size, sample_format)
+                        # The region of interest in the header overrides the
+                        # geometry given on the command line.
+                        rx_antennas = bin(roi[0]).count("1") if roi else args.rx_antennas
+                        samples_per_chirp = (roi[4] if roi else args.samples_per_chirp) >> (
+                            (flags >> FLAG_SAMPLE_SHIFT_POS) & FLAG_SHIFT_MASK
+                        )
                         _write_formatted_frame(
                             formatted,
                             frame_index=frame_index,
                             samples=samples,
-                            rx_antennas=args.rx_antennas,
-                            samples_per_chirp=args.samples_per_chirp,
+                            rx_antennas=rx_antennas,
+                            samples_per_chirp=(
+                                samples_per_chirp // 2
+                                if sample_format in RANGE_FORMATS
+                                else samples_per_chirp
+                            ),
                         )
                         formatted.flush()
 
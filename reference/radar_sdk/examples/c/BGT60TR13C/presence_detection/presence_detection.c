@@ -48,6 +48,7 @@
 #include <string.h>
 
 #include "ifxAvian/Avian.h"
+#include "ifxRadar/PresenceGate.h"
 #include "ifxRadarPresenceSensing/PresenceSensing.h"
 
 #include "common.h"
@@ -60,6 +61,11 @@
 */
 #define RX_ANTENNA_ID 0  // This implementation uses only 1 Rx Antenna
 
+// presence sensing is skipped for frames of an empty room that do not change
+#define GATE_THRESHOLD      2e-3f  // relative change of the range bins that opens the gate
+#define GATE_HOLD_FRAMES    5      // frames processed after the last change
+#define GATE_REFRESH_FRAMES 20     // frames processed at least once every 20 frames
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -90,6 +96,8 @@ typedef struct
 {
     ifx_Presence_Sensing_t* handle;
     ifx_Presence_Sensing_Result_t result;
+    ifx_Presence_Gate_t* gate;
+    bool has_result;
 } presence_t;
 
 /**
@@ -101,6 +109,10 @@ typedef struct
  */
 ifx_Error_t presence_init(presence_t* ctx)
 {
+    ctx->handle = NULL;
+    ctx->gate = NULL;
+    ctx->has_result = false;
+
     return IFX_OK;
 }
 
@@ -109,6 +121,7 @@ ifx_Error_t presence_init(presence_t* ctx)
  *
  * Configures the presence sensing with specified in json or default configuration.
  * Defines a state change callback and creates an instance of presence sensing algorithm.
+ * Creates a presence gate limited to the detection range of the presence sensing.
  *
  * @param ctx           context of the application
  * @param device        connected device handle
@@ -130,8 +143,26 @@ ifx_Error_t presence_config(presence_t* ctx, ifx_Avian_Device_t* device, ifx_jso
         ifx_presence_sensing_get_config_defaults(ifx_avian_get_sensor_type(device), &sensor_config, &presence_config);
     }
 
-    ctx->handle = ifx_presence_sensing_create(dev_config, &presence_config);    
-    
+    ctx->handle = ifx_presence_sensing_create(dev_config, &presence_config);
+    if (ctx->handle == NULL)
+        return ifx_error_get();
+
+    uint32_t num_antennas = 0;
+    for (uint32_t mask = dev_config->rx_mask; mask; mask >>= 1)
+        num_antennas += mask & 1;
+
+    ifx_Presence_Gate_Config_t gate_config = {0};
+    gate_config.num_antennas = num_antennas;
+    gate_config.num_samples = dev_config->num_samples_per_chirp;
+    gate_config.bandwidth_Hz = (ifx_Float_t)fabs((double)dev_config->end_frequency_Hz - (double)dev_config->start_frequency_Hz);
+    gate_config.min_range_m = presence_config.min_detection_range_m;
+    gate_config.max_range_m = presence_config.max_detection_range_m;
+    gate_config.threshold = GATE_THRESHOLD;
+    gate_config.hold_frames = GATE_HOLD_FRAMES;
+    gate_config.refresh_frames = GATE_REFRESH_FRAMES;
+
+    ctx->gate = ifx_presence_gate_create(&gate_config);
+
     return ifx_error_get();
 }
 
@@ -144,6 +175,7 @@ ifx_Error_t presence_config(presence_t* ctx, ifx_Avian_Device_t* device, ifx_jso
  */
 ifx_Error_t presence_cleanup(presence_t* ctx)
 {
+    ifx_presence_gate_destroy(ctx->gate);
     ifx_presence_sensing_destroy(ctx->handle);
 
     return ifx_error_get();
@@ -153,6 +185,8 @@ ifx_Error_t presence_cleanup(presence_t* ctx)
  * @brief Application specific processing function
  *
  * Runs a presence sensing algorithm on fetched data and informs about the results.
+ * While nobody is present and the frames do not change within the detection
+ * range the previous result is reported without running the algorithm.
  *
  * @param ctx           context of the application
  * @param frame         collected frame
@@ -160,7 +194,14 @@ ifx_Error_t presence_cleanup(presence_t* ctx)
 ifx_Error_t presence_process(presence_t* ctx, ifx_Cube_R_t* frame)
 {
     ifx_Error_t err;
-    ifx_presence_sensing_run(ctx->handle, frame, &ctx->result);
+    const bool changed = ifx_presence_gate_run(ctx->gate, frame, NULL);
+
+    // micro presence needs every frame, so frames are only skipped in absence state
+    if (changed || !ctx->has_result || ctx->result.target_state)
+    {
+        ifx_presence_sensing_run(ctx->handle, frame, &ctx->result);
+        ctx->has_result = true;
+    }
 
     err = ifx_error_get();
 
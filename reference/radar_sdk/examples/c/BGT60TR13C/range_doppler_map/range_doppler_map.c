@@ -36,8 +36,29 @@
  * from an Avian radar sensor using Range-Doppler Map (RDM) algorithm
  * and 2D MTI for filtering of the Radar SDK.
  *
+ * Frames from a device are processed in a pipeline, so that the device is
+ * read while earlier frames are still transformed:
+ *
+ *   acquisition thread -> ready queue -> RDM workers -> done queue -> output stage
+ *
+ * The acquisition thread fetches frames into a fixed pool of preallocated
+ * frames. Each worker computes range Doppler maps with its own RDM handle.
+ * The output stage (the main thread) puts the maps back into frame order,
+ * since the MTI filter depends on the previous frames, and prints the peak.
+ * When all frames of the pool are busy, the next frame is still read from
+ * the device but dropped, so the device FIFO never overflows. At the end
+ * the time spent in each stage, the achieved frame rate and the latency
+ * from frame arrival to output are reported.
+ *
+ * Recorded data (--data) and recordings (--record) use the serial loop of
+ * the common framework with rdm_process.
  */
 
+// for clock_gettime
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 
 /*
 ==============================================================================
@@ -45,8 +66,17 @@
 ==============================================================================
 */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
 #include "common.h"
 #include "ifxAlgo/Algo.h"
 #include "ifxAvian/Avian.h"
@@ -59,12 +89,36 @@
 ==============================================================================
 */
 
+#if defined(_WIN32)
+#define LOCK(m)    AcquireSRWLockExclusive(m)
+#define UNLOCK(m)  ReleaseSRWLockExclusive(m)
+#define WAIT(c, m) SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define SIGNAL(c)  WakeConditionVariable(c)
+#define BROADCAST(c) WakeAllConditionVariable(c)
+#else
+#define LOCK(m)    pthread_mutex_lock(m)
+#define UNLOCK(m)  pthread_mutex_unlock(m)
+#define WAIT(c, m) pthread_cond_wait((c), (m))
+#define SIGNAL(c)  pthread_cond_signal(c)
+#define BROADCAST(c) pthread_cond_broadcast(c)
+#endif
+
 /*
 ==============================================================================
 3. LOCAL TYPES
 ==============================================================================
 */
 
+#if defined(_WIN32)
+typedef SRWLOCK mutex_t;
+typedef CONDITION_VARIABLE cond_t;
+typedef HANDLE thread_t;
+#else
+typedef pthread_mutex_t mutex_t;
+typedef pthread_cond_t cond_t;
+typedef pthread_t thread_t;
+#endif
+
 typedef struct
 {
     ifx_Avian_Device_t* device_handle;
@@ -73,8 +127,73 @@ typedef struct
     ifx_2DMTI_R_t* mti_handle;
     ifx_Math_Axis_Spec_t range_spec;
     ifx_Math_Axis_Spec_t speed_spec;
+    ifx_RDM_Config_t rdm_config;  // for the RDM handles of the pipeline workers
+    ifx_Avian_Config_t dev_config;
 } rdm_t;
 
+/**
+ * @brief A frame of the pipeline together with its range Doppler map.
+ */
+typedef struct
+{
+    ifx_Cube_R_t* frame;
+    ifx_Matrix_R_t* rdm;
+    uint32_t number;        /**< Position in the output order.*/
+    int64_t acquired_us;    /**< Time the frame was received from the device.*/
+    int64_t processing_us;  /**< Time spent computing the range Doppler map.*/
+    ifx_Error_t error;
+} slot_t;
+
+/**
+ * @brief Bounded FIFO of slot indices between two pipeline stages.
+ *
+ * Its capacity is the number of slots, so push never blocks.
+ */
+typedef struct
+{
+    mutex_t lock;
+    cond_t not_empty;
+    uint32_t* items;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+    uint32_t producers;  /**< Stages still pushing; the queue is closed at 0.*/
+} slot_queue_t;
+
+typedef struct
+{
+    int64_t sum_us;
+    int64_t max_us;
+    uint32_t count;
+} timing_t;
+
+typedef struct
+{
+    rdm_t* rdm_context;
+    ifx_Avian_Device_t* device_handle;
+    uint32_t frame_limit;
+    volatile bool stop;
+
+    slot_t slots[IFX_PIPELINE_NUM_FRAMES];
+    ifx_Cube_R_t* scratch;  /**< Receives frames that are dropped.*/
+    slot_queue_t free_slots;
+    slot_queue_t ready;
+    slot_queue_t done;
+
+    // written by the acquisition thread only
+    uint32_t acquired;
+    uint32_t dropped;
+    uint32_t overflows;
+    timing_t fetch;
+    ifx_Error_t acquisition_error;
+} pipeline_t;
+
+typedef struct
+{
+    pipeline_t* pipeline;
+    ifx_RDM_t* rdm_handle;
+} worker_t;
+
 /*
 ==============================================================================
 4. DATA
@@ -130,6 +249,7 @@ ifx_Error_t rdm_init(rdm_t* rdm_context)
 ifx_Error_t rdm_config(rdm_t* rdm_context, ifx_Avian_Device_t* device, ifx_json_t* json, ifx_Avian_Config_t* dev_config)
 {
     ifx_Error_t ret = 0;
+    rdm_context->dev_config = *dev_config;
 
     const uint32_t range_fft_size = dev_config->num_samples_per_chirp * 4;   // Zero padding of 4 gives good range resolution in Range spectrum
     const uint32_t doppler_fft_size = dev_config->num_chirps_per_frame * 4;  // Zero padding of 4 gives good range resolution in Doppler spectrum
@@ -154,6 +274,7 @@ ifx_Error_t rdm_config(rdm_t* rdm_context, ifx_Avian_Device_t* device, ifx_json_
         .range_fft_config = range_fft_config,
         .doppler_fft_config = doppler_fft_config};
 
+    rdm_context->rdm_config = rdm_config;
     rdm_context->rdm_handle = ifx_rdm_create(&rdm_config);
     if ((ret = ifx_error_get()))
     {
@@ -233,6 +354,39 @@ void rdm_peak_search(const ifx_Matrix_R_t* matrix, uint32_t* rmax, uint32_t* cma
     }
 }
 
+/**
+ * @brief Filters a range Doppler map and prints its peak
+ *
+ * The 2D MTI filter keeps state between frames, so the maps have to be passed
+ * in frame order.
+ *
+ * @param rdm_context       context of the application
+ * @param rdm               range Doppler map of the frame, filtered in place
+ */
+static ifx_Error_t rdm_output(rdm_t* rdm_context, ifx_Matrix_R_t* rdm)
+{
+    ifx_Error_t ret = 0;
+
+    ifx_2dmti_run_r(rdm_context->mti_handle, rdm, rdm);
+    if ((ret = ifx_error_get()))
+    {
+        return ret;
+    }
+
+    // do peak search
+    uint32_t rmax;
+    uint32_t cmax;
+    rdm_peak_search(rdm, &rmax, &cmax);
+    // range
+    const ifx_Float_t range = rmax * rdm_context->range_spec.value_bin_per_step;
+    // speed
+    const ifx_Float_t speed = (((ifx_Float_t)IFX_MAT_COLS(rdm) / 2) - (ifx_Float_t)cmax) * rdm_context->speed_spec.value_bin_per_step;
+
+    app_print(", range_m:%g, speed_m_s:%g", range, speed);
+
+    return (ifx_error_get());
+}
+
 /**
  * @brief Application specific processing function
  *
@@ -253,24 +407,398 @@ ifx_Error_t rdm_process(rdm_t* rdm_context, ifx_Cube_R_t* frame)
         return ret;
     }
 
-    ifx_2dmti_run_r(rdm_context->mti_handle, rdm_context->rdm, rdm_context->rdm);
-    if ((ret = ifx_error_get()))
+    return rdm_output(rdm_context, rdm_context->rdm);
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Monotonic time in microseconds */
+static int64_t now_us(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (counter.QuadPart / frequency.QuadPart) * 1000000
+           + ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+static void timing_add(timing_t* timing, int64_t us)
+{
+    timing->sum_us += us;
+    timing->count++;
+    if (us > timing->max_us)
+        timing->max_us = us;
+}
+
+static void timing_print(const char* name, const timing_t* timing)
+{
+    const double avg_ms = timing->count ? (double)timing->sum_us / timing->count / 1000.0 : 0.0;
+    fprintf(stderr, "  %-22s avg %8.3f ms   max %8.3f ms\n", name, avg_ms, (double)timing->max_us / 1000.0);
+}
+
+//----------------------------------------------------------------------------
+
+static bool slot_queue_init(slot_queue_t* queue, uint32_t capacity, uint32_t producers)
+{
+    memset(queue, 0, sizeof(*queue));
+    queue->items = calloc(capacity, sizeof(uint32_t));
+    queue->capacity = capacity;
+    queue->producers = producers;
+#if defined(_WIN32)
+    InitializeSRWLock(&queue->lock);
+    InitializeConditionVariable(&queue->not_empty);
+#else
+    pthread_mutex_init(&queue->lock, NULL);
+    pthread_cond_init(&queue->not_empty, NULL);
+#endif
+    return queue->items != NULL;
+}
+
+static void slot_queue_destroy(slot_queue_t* queue)
+{
+#if !defined(_WIN32)
+    pthread_mutex_destroy(&queue->lock);
+    pthread_cond_destroy(&queue->not_empty);
+#endif
+    free(queue->items);
+}
+
+static void slot_queue_push(slot_queue_t* queue, uint32_t slot)
+{
+    LOCK(&queue->lock);
+    queue->items[(queue->head + queue->count) % queue->capacity] = slot;
+    queue->count++;
+    SIGNAL(&queue->not_empty);
+    UNLOCK(&queue->lock);
+}
+
+/** @brief Takes the oldest slot; waits for one if block is set and the queue is not closed */
+static bool slot_queue_pop(slot_queue_t* queue, uint32_t* slot, bool block)
+{
+    LOCK(&queue->lock);
+    while (block && (queue->count == 0) && (queue->producers > 0))
+        WAIT(&queue->not_empty, &queue->lock);
+
+    const bool found = (queue->count > 0);
+    if (found)
     {
-        return ret;
+        *slot = queue->items[queue->head];
+        queue->head = (queue->head + 1) % queue->capacity;
+        queue->count--;
     }
+    UNLOCK(&queue->lock);
+    return found;
+}
 
-    // do peak search
-    uint32_t rmax;
-    uint32_t cmax;
-    rdm_peak_search(rdm_context->rdm, &rmax, &cmax);
-    // range
-    const ifx_Float_t range = rmax * rdm_context->range_spec.value_bin_per_step;
-    // speed
-    const ifx_Float_t speed = (((ifx_Float_t)IFX_MAT_COLS(rdm_context->rdm) / 2) - (ifx_Float_t)cmax) * rdm_context->speed_spec.value_bin_per_step;
+/** @brief Called by each producer when it stops; wakes the consumers once all have stopped */
+static void slot_queue_close(slot_queue_t* queue)
+{
+    LOCK(&queue->lock);
+    if (--queue->producers == 0)
+        BROADCAST(&queue->not_empty);
+    UNLOCK(&queue->lock);
+}
 
-    app_print(", range_m:%g, speed_m_s:%g", range, speed);
+//----------------------------------------------------------------------------
 
-    return (ifx_error_get());
+/**
+ * @brief Acquisition stage
+ *
+ * Only fetches frames, so the device is read again right after a frame
+ * arrived.
+ */
+static void acquisition_main(pipeline_t* pipeline)
+{
+    uint32_t number = 0;
+
+    while (!pipeline->stop && app_is_running()
+           && ((pipeline->frame_limit == 0) || (pipeline->acquired < pipeline->frame_limit)))
+    {
+        uint32_t index;
+        const bool have_slot = slot_queue_pop(&pipeline->free_slots, &index, false);
+        ifx_Cube_R_t* frame = have_slot ? pipeline->slots[index].frame : pipeline->scratch;
+
+        const int64_t start_us = now_us();
+        ifx_avian_get_next_frame_timeout(pipeline->device_handle, frame, IFX_PIPELINE_TIMEOUT_MS);
+        const int64_t acquired_us = now_us();
+        const ifx_Error_t ret = ifx_error_get_and_clear();
+
+        if (ret != IFX_OK)
+        {
+            if (have_slot)
+                slot_queue_push(&pipeline->free_slots, index);
+
+            if (ret == IFX_ERROR_TIMEOUT)
+                continue;
+            if (ret == IFX_ERROR_FIFO_OVERFLOW)
+            {
+                pipeline->overflows++;
+                continue;
+            }
+
+            fprintf(stderr, "Error getting next frame: %s (%d)\n", ifx_error_to_string(ret), ret);
+            pipeline->acquisition_error = ret;
+            break;
+        }
+
+        timing_add(&pipeline->fetch, acquired_us - start_us);
+        pipeline->acquired++;
+
+        if (!have_slot)
+        {
+            // all frames are still being processed
+            pipeline->dropped++;
+            continue;
+        }
+
+        slot_t* slot = &pipeline->slots[index];
+        slot->number = number++;
+        slot->acquired_us = acquired_us;
+        slot_queue_push(&pipeline->ready, index);
+    }
+
+    slot_queue_close(&pipeline->ready);
+}
+
+/**
+ * @brief Processing stage
+ *
+ * Several workers compute range Doppler maps of different frames at the
+ * same time.
+ */
+static void worker_main(worker_t* worker)
+{
+    pipeline_t* pipeline = worker->pipeline;
+    uint32_t index;
+
+    while (slot_queue_pop(&pipeline->ready, &index, true))
+    {
+        slot_t* slot = &pipeline->slots[index];
+        const int64_t start_us = now_us();
+
+        ifx_Matrix_R_t antenna_data;
+        ifx_cube_get_row_r(slot->frame, 0, &antenna_data);
+        ifx_rdm_run_r(worker->rdm_handle, &antenna_data, slot->rdm);
+
+        slot->error = ifx_error_get_and_clear();
+        slot->processing_us = now_us() - start_us;
+        slot_queue_push(&pipeline->done, index);
+    }
+
+    slot_queue_close(&pipeline->done);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI acquisition_thread(LPVOID arg)
+{
+    acquisition_main(arg);
+    return 0;
+}
+
+static DWORD WINAPI worker_thread(LPVOID arg)
+{
+    worker_main(arg);
+    return 0;
+}
+#else
+static void* acquisition_thread(void* arg)
+{
+    acquisition_main(arg);
+    return NULL;
+}
+
+static void* worker_thread(void* arg)
+{
+    worker_main(arg);
+    return NULL;
+}
+#endif
+
+static bool thread_start(thread_t* thread, void* (*function)(void*), void* arg)
+{
+#if defined(_WIN32)
+    *thread = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)function, arg, 0, NULL);
+    return *thread != NULL;
+#else
+    return pthread_create(thread, NULL, function, arg) == 0;
+#endif
+}
+
+static void thread_join(thread_t thread)
+{
+#if defined(_WIN32)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+/**
+ * @brief Pipelined frame loop for live devices
+ *
+ * Runs the acquisition and the workers on their own threads and the output
+ * stage on the calling thread.
+ *
+ * @param rdm_context       context of the application
+ * @param device_handle     configured device
+ * @param frame_limit       number of frames to acquire, 0 for no limit
+ */
+ifx_Error_t rdm_run(rdm_t* rdm_context, ifx_Avian_Device_t* device_handle, uint32_t frame_limit)
+{
+    const uint32_t num_slots = IFX_PIPELINE_NUM_FRAMES;
+    const uint32_t num_workers = IFX_PIPELINE_NUM_WORKERS;
+    const uint8_t num_rx = ifx_devconf_count_rx_antennas(&rdm_context->dev_config);
+
+    pipeline_t* pipeline = calloc(1, sizeof(pipeline_t));
+    worker_t workers[IFX_PIPELINE_NUM_WORKERS] = {0};
+    thread_t worker_threads[IFX_PIPELINE_NUM_WORKERS];
+    thread_t acquisition;
+    uint32_t num_started = 0;
+    ifx_Error_t ret = IFX_OK;
+
+    if (pipeline == NULL)
+        return IFX_ERROR_MEMORY_ALLOCATION_FAILED;
+
+    pipeline->rdm_context = rdm_context;
+    pipeline->device_handle = device_handle;
+    pipeline->frame_limit = frame_limit;
+
+    // allocate everything up front, nothing is allocated per frame
+    bool ok = slot_queue_init(&pipeline->free_slots, num_slots, 1)
+              && slot_queue_init(&pipeline->ready, num_slots, 1)
+              && slot_queue_init(&pipeline->done, num_slots, num_workers);
+    for (uint32_t i = 0; ok && (i < num_slots); i++)
+    {
+        pipeline->slots[i].frame = ifx_cube_create_r(num_rx, rdm_context->dev_config.num_chirps_per_frame,
+                                                     rdm_context->dev_config.num_samples_per_chirp);
+        pipeline->slots[i].rdm = ifx_mat_create_r(IFX_MAT_ROWS(rdm_context->rdm), IFX_MAT_COLS(rdm_context->rdm));
+        slot_queue_push(&pipeline->free_slots, i);
+    }
+    pipeline->scratch = ifx_cube_create_r(num_rx, rdm_context->dev_config.num_chirps_per_frame,
+                                          rdm_context->dev_config.num_samples_per_chirp);
+    for (uint32_t i = 0; ok && (i < num_workers); i++)
+    {
+        workers[i].pipeline = pipeline;
+        workers[i].rdm_handle = ifx_rdm_create(&rdm_context->rdm_config);
+    }
+    if (!ok || ((ret = ifx_error_get()) != IFX_OK))
+    {
+        fprintf(stderr, "Failed to set up the processing pipeline\n");
+        if (ret == IFX_OK)
+            ret = IFX_ERROR_MEMORY_ALLOCATION_FAILED;
+        goto cleanup;
+    }
+
+    // the output stage is started before the producers, so it is ready for the first frame
+    timing_t processing = {0}, output = {0}, latency = {0};
+    slot_t* pending[IFX_PIPELINE_NUM_FRAMES] = {0};
+    uint32_t next = 0;
+    int64_t first_us = 0, last_us = 0;
+
+    for (uint32_t i = 0; i < num_workers; i++)
+    {
+        if (!thread_start(&worker_threads[i], worker_thread, &workers[i]))
+            break;
+        num_started++;
+    }
+    // workers that could not be started close the done queue on their behalf
+    for (uint32_t i = num_started; i < num_workers; i++)
+        slot_queue_close(&pipeline->done);
+
+    if ((num_started == 0) || !thread_start(&acquisition, acquisition_thread, pipeline))
+    {
+        fprintf(stderr, "Failed to start the pipeline threads\n");
+        slot_queue_close(&pipeline->ready);
+        for (uint32_t i = 0; i < num_started; i++)
+            thread_join(worker_threads[i]);
+        ret = IFX_ERROR_INTERNAL;
+        goto cleanup;
+    }
+
+    uint32_t index;
+    while (slot_queue_pop(&pipeline->done, &index, true))
+    {
+        slot_t* slot = &pipeline->slots[index];
+        pending[slot->number % num_slots] = slot;
+
+        // output the maps in frame order
+        while ((slot = pending[next % num_slots]) != NULL && (slot->number == next))
+        {
+            pending[next % num_slots] = NULL;
+            next++;
+
+            const int64_t start_us = now_us();
+            if ((ret == IFX_OK) && (slot->error == IFX_OK))
+            {
+                app_print("{ \"elapsed_time\":\"%s\", \"frame_number\":%u", app_elapsed_time(), next);
+                const ifx_Error_t output_error = rdm_output(rdm_context, slot->rdm);
+                const int64_t end_us = now_us();
+                app_print(", latency_ms:%.2f }\n", (double)(end_us - slot->acquired_us) / 1000.0);
+
+                timing_add(&processing, slot->processing_us);
+                timing_add(&output, end_us - start_us);
+                timing_add(&latency, end_us - slot->acquired_us);
+                if (first_us == 0)
+                    first_us = end_us;
+                last_us = end_us;
+
+                if (output_error != IFX_OK)
+                    ret = output_error;
+            }
+            else if (ret == IFX_OK)
+            {
+                ret = slot->error;
+            }
+
+            // stop on the first error, but keep draining so every thread finishes
+            if (ret != IFX_OK)
+                pipeline->stop = true;
+
+            slot_queue_push(&pipeline->free_slots, (uint32_t)(slot - pipeline->slots));
+        }
+    }
+
+    thread_join(acquisition);
+    for (uint32_t i = 0; i < num_started; i++)
+        thread_join(worker_threads[i]);
+
+    if (ret == IFX_OK)
+        ret = pipeline->acquisition_error;
+
+    fprintf(stderr, "\nPipeline with %u workers and %u frames:\n", num_started, num_slots);
+    timing_print("fetch (device)", &pipeline->fetch);
+    timing_print("range Doppler map", &processing);
+    timing_print("MTI, peak and print", &output);
+    timing_print("end-to-end latency", &latency);
+    fprintf(stderr, "  %u frames acquired, %u output, %u dropped, %u FIFO overflows\n",
+            pipeline->acquired, latency.count, pipeline->dropped, pipeline->overflows);
+    if (latency.count > 1)
+    {
+        fprintf(stderr, "  %.2f frames per second\n", (latency.count - 1) * 1e6 / (double)(last_us - first_us));
+    }
+
+cleanup:
+    for (uint32_t i = 0; i < num_workers; i++)
+        ifx_rdm_destroy(workers[i].rdm_handle);
+    for (uint32_t i = 0; i < num_slots; i++)
+    {
+        ifx_cube_destroy_r(pipeline->slots[i].frame);
+        ifx_mat_destroy_r(pipeline->slots[i].rdm);
+    }
+    ifx_cube_destroy_r(pipeline->scratch);
+    slot_queue_destroy(&pipeline->free_slots);
+    slot_queue_destroy(&pipeline->ready);
+    slot_queue_destroy(&pipeline->done);
+    free(pipeline);
+
+    return ret;
 }
 
 /*
@@ -295,6 +823,7 @@ int main(int argc, char** argv)
     s_rdm.app_config = (void*)&rdm_config;
     s_rdm.app_process = (void*)&rdm_process;
     s_rdm.app_cleanup = (void*)&rdm_cleanup;
+    s_rdm.app_run = (void*)&rdm_run;
 
     s_rdm.default_metrics = &default_metrics;
 
@@ -69,4 +69,9 @@
 
 #define IFX_SPECT_THRESHOLD (1e-6f)
 
+// Pipelined processing of live devices (see rdm_run)
+#define IFX_PIPELINE_NUM_WORKERS (2)     // threads computing range Doppler maps
+#define IFX_PIPELINE_NUM_FRAMES (8)      // preallocated frames in flight between the stages
+#define IFX_PIPELINE_TIMEOUT_MS (1000)   // timeout for fetching a frame from the device
+
 #endif /* RDM_DEFAULTS_H */
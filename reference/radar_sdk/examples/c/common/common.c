@@ -243,6 +243,16 @@ void app_printtime(void)
     }
 }
 
+bool app_is_running(void)
+{
+    return app_common.is_running;
+}
+
+const char* app_elapsed_time(void)
+{
+    return app_common.time_handle ? ifx_time_get_cstr(app_common.time_handle) : "";
+}
+
 void signal_handler(int sig)
 {
     if (sig == SIGINT)
@@ -672,6 +682,24 @@ int app_start(int argc, char** argv, app_t* application, void* app_context)
     frame_count = 0;
     uint32_t num_virtual_antennas = (uint32_t)rx_antenna_count;
 
+    // apps with their own frame loop run it for live devices
+    if (application->app_run && (file_data == NULL) && (file_record == NULL))
+    {
+        uint32_t limit = frame_limit;
+        if (time_limit > 0)
+        {
+            const uint32_t time_frames = (uint32_t)(time_limit / device_config.frame_repetition_time_s);
+            if ((limit == 0) || (time_frames < limit))
+                limit = time_frames;
+        }
+
+        if (application->app_run(app_context, device_handle, limit) != IFX_OK)
+            goto cleanup;
+
+        exitcode = EXIT_SUCCESS;
+        goto cleanup;
+    }
+
     while (app_common.is_running)
     {
         ifx_Error_t ret;
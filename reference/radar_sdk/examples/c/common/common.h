@@ -77,6 +77,12 @@ typedef struct
     ifx_Error_t (*app_config)(void* app_context, ifx_Avian_Device_t* device_handle, ifx_json_t* json, ifx_Avian_Config_t* device_config);
     ifx_Error_t (*app_process)(void* segmentation_context, ifx_Cube_R_t* frame);
     ifx_Error_t (*app_cleanup)(void* app_context);
+
+    /** Optional frame loop used instead of the serial fetch and app_process loop
+     *  when frames come from a device and are not recorded. It is called with the
+     *  configured device and fetches frames itself until app_is_running() returns
+     *  false or frame_limit frames (0: no limit) were processed. */
+    ifx_Error_t (*app_run)(void* app_context, ifx_Avian_Device_t* device_handle, uint32_t frame_limit);
 } app_t;
 
 
@@ -137,6 +143,24 @@ void app_printtime(void);
  */
 void app_print(const char* fmt, ...);
 
+/**
+ * @brief This function tells an app_run loop whether to continue.
+ *
+ * @param [in]     none
+ *
+ * @return false once the user interrupted the app (Ctrl-C), true otherwise.
+ */
+bool app_is_running(void);
+
+/**
+ * @brief This function returns the time elapsed since the app started.
+ *
+ * @param [in]     none
+ *
+ * @return elapsed time as printed in the "elapsed_time" field of each frame.
+ */
+const char* app_elapsed_time(void);
+
 /**
  * @brief This function checks the console for new keystrokes.
 
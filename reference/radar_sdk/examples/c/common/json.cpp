@@ -34,7 +34,13 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -55,6 +61,67 @@ using json = nlohmann::ordered_json;
 
 #define IFX_AVIAN_DEFAULT_SAMPLE_RATE_HZ 2e6f
 
+/**
+ * @brief Cache of parsed configuration files
+ *
+ * Applications managing many sensors often load the same configuration
+ * several times. Documents are cached by the hash and size of the file
+ * content, so an unchanged file is parsed only once per process even if it
+ * was renamed, and a modified file is parsed again.
+ */
+class ParsedJsonCache
+{
+public:
+    std::shared_ptr<const json> get(const string& content)
+    {
+        const Key key = make_key(content);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_documents.find(key);
+        if (it == m_documents.end())
+            return nullptr;
+        return it->second;
+    }
+
+    void put(const string& content, std::shared_ptr<const json> document)
+    {
+        const Key key = make_key(content);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_documents.size() >= max_entries)
+            m_documents.clear();
+        m_documents[key] = std::move(document);
+    }
+
+private:
+    using Key = std::pair<uint64_t, size_t>;
+
+    // configurations are small; this only bounds memory if an application
+    // keeps loading generated files
+    static constexpr size_t max_entries = 64;
+
+    static Key make_key(const string& content)
+    {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const char c : content)
+        {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001b3ull;
+        }
+        return {hash, content.size()};
+    }
+
+    std::mutex m_mutex;
+    std::map<Key, std::shared_ptr<const json>> m_documents;
+};
+
+static ParsedJsonCache& parsed_json_cache()
+{
+    static ParsedJsonCache cache;
+    return cache;
+}
+
 /**
  * @brief Convert antenna mask to a C++ vector of uint32
  *
@@ -559,18 +626,35 @@ void ifxJsonConfiguration::load_from_file(const string& filename, int type, cons
 {
     std::ifstream file;
 
-    file.open(filename);
+    file.open(filename, std::ios::binary);
     if (!file.is_open())
         throw string("Cannot open file for reading");
 
+    // read the file in one go and parse from memory; this is much faster
+    // than extracting the document from the stream character by character
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    const string content = buffer.str();
+
+    auto cached = parsed_json_cache().get(content);
+    if (cached)
+    {
+        m_json = *cached;
+        m_active = nullptr;
+        return;
+    }
+
     try
     {
-        file >> m_json;
+        m_json = json::parse(content.begin(), content.end());
     }
     catch (...)
     {
         throw string("Error parsing JSON file");
     }
+    m_active = nullptr;
+
+    parsed_json_cache().put(content, std::make_shared<const json>(m_json));
 }
 
 /**
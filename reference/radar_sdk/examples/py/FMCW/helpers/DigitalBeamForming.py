@@ -26,9 +26,21 @@
 # POSSIBILITY OF SUCH DAMAGE.
 # ===========================================================================
 
+from functools import lru_cache
+
 import numpy as np
 
 
+@lru_cache(maxsize=16)
+def _beam_weights(num_antennas: int, num_beams: int, max_angle_degrees: float, d_by_lambda: float) -> np.ndarray:
+    """Return the steering weights (num_antennas x num_beams), shared by all instances with the same geometry"""
+    angle_vector = np.radians(np.linspace(-max_angle_degrees, max_angle_degrees, num_beams))
+    antennas = np.arange(num_antennas)[:, np.newaxis]
+    weights = np.exp(1j * 2 * np.pi * antennas * d_by_lambda * np.sin(angle_vector)[np.newaxis, :])  # /sqrt(num_antennas)
+    weights.setflags(write=False)
+    return weights
+
+
 class DigitalBeamForming:
     def __init__(self, num_antennas: int, num_beams: int = 27, max_angle_degrees: float = 45, d_by_lambda: float = 0.5):
         """Create a Digital Beam Forming object
@@ -40,45 +52,31 @@ class DigitalBeamForming:
                                     from -max_angle_degrees .. +max_angle_degrees
             - d_by_lambda:          separation of RX antennas divided by the wavelength
         """
-        angle_vector = np.radians(np.linspace(-max_angle_degrees, max_angle_degrees, num_beams))
+        self.weights = _beam_weights(num_antennas, num_beams, max_angle_degrees, d_by_lambda)
 
-        weights = np.zeros((num_antennas, num_beams), dtype=complex)
-
-        for iBeam in range(num_beams):
-            angle = angle_vector[iBeam]
-            for iAntenna in range(num_antennas):
-                weights[iAntenna, iBeam] = np.exp(
-                    1j * 2 * np.pi * iAntenna * d_by_lambda * np.sin(angle))  # /sqrt(num_antennas)
-
-        self.weights = weights
+        # the antennas are applied in reverse order
+        self._weights_reversed = np.ascontiguousarray(self.weights[::-1, :])
 
     def run(self, range_doppler):
         """Compute virtual beams
 
+        All beams are computed with a single matrix product. Leading
+        dimensions are kept, so several frames can be processed at once.
+
         Parameters:
             - range_doppler: Range Doppler spectrum for all RX antennas
               (dimension: num_samples_per_chirp x num_chirps_per_frame x
-              num_antennas)
+              num_antennas, optionally preceded by a frame dimension)
         
         Returns:
             - Range Doppler Beams (dimension: num_samples_per_chirp x
-              num_chirps_per_frame x num_beams)
+              num_chirps_per_frame x num_beams, optionally preceded by a
+              frame dimension)
         """
-
-        num_samples, num_chirps, num_antennas = range_doppler.shape
+        num_antennas = range_doppler.shape[-1]
 
         num_antennas_internal, num_beams = self.weights.shape
 
         assert num_antennas == num_antennas_internal
 
-        rd_beam_formed = np.zeros((num_samples, num_chirps, num_beams), dtype=complex);
-
-        for iBeam in range(num_beams):
-            acc = np.zeros((num_samples, num_chirps), dtype=complex)
-
-            for iAntenna in range(num_antennas):
-                acc += range_doppler[:, :, iAntenna] * self.weights[num_antennas - iAntenna - 1, iBeam]
-
-            rd_beam_formed[:, :, iBeam] = acc
-
-        return rd_beam_formed
+        return np.matmul(range_doppler, self._weights_reversed)
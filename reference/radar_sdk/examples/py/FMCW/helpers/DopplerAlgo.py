@@ -64,6 +64,15 @@ class DopplerAlgo:
         # initialize MTI filter
         self.mti_history = np.zeros((self.num_chirps_per_frame, num_samples, num_ant))
 
+        # windows of compute_doppler_maps with the FFT scaling folded in; the
+        # alternating sign of the Doppler window shifts the spectrum by half
+        # its length, which replaces fftshift (the FFT length 2 * num_chirps
+        # is always even)
+        self._range_window_scaled = self.range_window[0] * (2 / num_samples)
+        self._doppler_window_shifted = self.doppler_window[0] * (-1.0) ** np.arange(num_chirps_per_frame) / num_chirps_per_frame
+
+        self._work = None  # work buffers of compute_doppler_maps, reallocated if the number of frames changes
+
     def compute_doppler_map(self, data: np.ndarray, i_ant: int):
         """Compute Range-Doppler map for i-th antennas
 
@@ -96,3 +105,55 @@ class DopplerAlgo:
 
         # re-arrange fft result for zero speed at centre
         return np.fft.fftshift(fft2d, (1,))
+
+    def compute_doppler_maps(self, data: np.ndarray) -> np.ndarray:
+        """Compute Range-Doppler maps of all antennas of one or more frames
+
+        Gives the same result as calling compute_doppler_map for each frame
+        and antenna in turn, including the update of the MTI filter, but
+        processes all antennas (and frames) with a few array operations:
+        the range FFT is a real FFT, the windows include the FFT scaling and
+        fftshift is folded into the Doppler window. Work buffers are kept
+        between calls.
+
+        For the native range Doppler map of the SDK (different window and
+        scaling, no MTI) see ifxradarsdk.algo.RangeDopplerMap.
+
+        Parameter:
+            - data:     Raw-data of all antennas (dimension: num_ant x
+                        num_chirps_per_frame x num_samples, optionally
+                        preceded by a frame dimension)
+
+        Returns:
+            - Range-Doppler maps (dimension: num_ant x num_samples x
+              2 * num_chirps_per_frame, optionally preceded by the frame
+              dimension)
+        """
+        frames = data if data.ndim == 4 else data[np.newaxis]
+        num_samples = frames.shape[-1]
+
+        if self._work is None or self._work.shape != frames.shape:
+            self._work = np.empty(frames.shape)
+        work = self._work
+
+        # Step 1 - Remove average from signal (mean removal) of each antenna
+        np.subtract(frames, np.mean(frames, axis=(-2, -1), keepdims=True), out=work)
+
+        # Step 2 - MTI processing to remove static objects, frame by frame
+        history = self.mti_history.transpose(2, 0, 1)  # view as num_ant x num_chirps x num_samples
+        for frame in work:
+            mti = frame - history
+            history *= 1 - self.mti_alpha
+            history += frame * self.mti_alpha
+            frame[...] = mti
+
+        # Step 3 - range FFT: remove the average of each chirp, window and zero pad
+        work -= np.mean(work, axis=-1, keepdims=True)
+        work *= self._range_window_scaled
+        range_fft = np.fft.rfft(work, n=2 * num_samples, axis=-1)[..., :num_samples]
+
+        # Step 4 - Doppler FFT over the chirps of each range bin, zero padded
+        range_fft = np.swapaxes(range_fft, -1, -2) * self._doppler_window_shifted
+        doppler = np.fft.fft(range_fft, n=2 * self.num_chirps_per_frame, axis=-1)
+
+        return doppler if data.ndim == 4 else doppler[0]
@@ -207,11 +207,8 @@ if __name__ == '__main__':
                 break
             frame_contents = device.get_next_frame()
             frame_data = frame_contents[0]
-            data_all_antennas = []
-            for i_ant in range(0, num_rx_antennas):  # for each antenna
-                mat = frame_data[i_ant, :, :]
-                dfft_dbfs = linear_to_dB(doppler.compute_doppler_map(mat, i_ant))
-                data_all_antennas.append(dfft_dbfs)
+            # all antennas at once
+            data_all_antennas = list(linear_to_dB(doppler.compute_doppler_maps(frame_data)))
             draw.draw(data_all_antennas)
 
         draw.close()
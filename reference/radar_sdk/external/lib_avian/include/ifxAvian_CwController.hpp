@@ -40,6 +40,7 @@
 #include <array>
 #include <bitset>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <utility>
@@ -354,6 +355,44 @@ public:
      */
     std::map<unsigned, std::vector<float>> capture_rx_signals();
 
+    /*!
+     * The callback type used by \ref start_rx_stream. The callback is called
+     * with a block of raw ADC samples of 0...4095, interleaved over the
+     * enabled RX antennas, so the block contains number of samples times
+     * number of enabled RX antennas values. If acquisition fails, the
+     * callback is called once with a null pointer and the stream ends.
+     */
+    using Rx_Stream_Callback_t = std::function<void(const uint16_t* raw_data, size_t num_samples)>;
+
+    /*!
+     * This method starts capturing RX signals in a background thread until
+     * \ref stop_rx_stream is called.
+     *
+     * Each block has the size of a capture through \ref capture_rx_signals.
+     * Unlike repeated calls of capture_rx_signals the data reader stays
+     * running, and the acquisition of the next block is triggered before the
+     * callback is called with the previous one, so the gap between two
+     * blocks is only the time the state machine needs to accept the next
+     * trigger. While the stream is active, no other method must be called
+     * except \ref is_rx_stream_active and \ref stop_rx_stream.
+     *
+     * This method throws an exception in the same cases as
+     * \ref capture_rx_signals and if a stream is already active.
+     *
+     * \param[in] callback  Called from the stream thread for each block.
+     */
+    void start_rx_stream(Rx_Stream_Callback_t callback);
+
+    /*!
+     * This method stops a stream started by \ref start_rx_stream and waits
+     * for the stream thread to finish. If the stream ended because of a
+     * hardware failure, the device is reset and continuous wave is disabled.
+     */
+    void stop_rx_stream();
+
+    //! This method returns true if a stream is active.
+    bool is_rx_stream_active() const;
+
     /*!
      * This method sets the gain of the Avian device's baseband high pass
      * filter.
@@ -532,6 +571,26 @@ private:
      */
     bool go_to_active_state();
 
+    /*!
+     * This method returns the SPI sequence that triggers an acquisition,
+     * including the toggle commands emulating certain test generator modes.
+     */
+    std::vector<HW::Spi_Command_t> get_trigger_sequence();
+
+    /*!
+     * This method selects the RX channel as MADC input on devices without
+     * SADC, where the MADC input may be set to a sensor channel.
+     */
+    void select_rx_adc_input();
+
+    /*!
+     * This is the loop of the stream thread started by
+     * \ref start_rx_stream.
+     */
+    void run_rx_stream();
+
+    struct Rx_Stream;
+
     HW::IControlPort& m_port;
     std::unique_ptr<Driver> m_driver;
     double m_continuous_wave_frequency;
@@ -543,6 +602,7 @@ private:
     std::bitset<4> m_rx_mask;
     uint16_t m_num_samples;
     std::array<HW::Spi_Command_t, 2> m_toggle_commands;
+    std::unique_ptr<Rx_Stream> m_rx_stream;
 };
 
 /* ------------------------------------------------------------------------ */
@@ -39,6 +39,16 @@
 // ---------------------------------------------------------------------------- includes
 #include "ifxAvian_IPort.hpp"
 
+#include <type_traits>
+
+/*
+ * If lib_avian is built together with Strata, the vectorized unpacking
+ * functions of Strata are used (see AVIAN_INCLUDE_STRATA_PORT).
+ */
+#ifdef AVIAN_USE_STRATA_PACKED12
+#include <common/Packed12.hpp>
+#endif
+
 // ---------------------------------------------------------------------------- namespaces
 namespace Infineon {
 namespace Avian {
@@ -59,6 +69,9 @@ namespace Avian {
  * Due to this in-place processing, it is not allowed to use a target data
  * format of a smaller size than the packed data.
  *
+ * For a floating point target format the samples can be scaled during the
+ * conversion, see \ref set_scaling.
+ *
  * \param DATA_TYPE  The target data format, packed raw data is converted to.
  */
 template <typename DATA_TYPE>
@@ -103,7 +116,35 @@ public:
     // Implementation of \ref Infineon::Avian::HW::IReadPort::set_buffer
     void set_buffer(DATA_TYPE* buffer) override;
 
+    /**
+     * \brief This method sets the scaling applied to each sample.
+     *
+     * Each sample is converted to (sample * scale + offset), e.g. with scale
+     * set to 1/4095 the samples are normalized to the ADC range. This is only
+     * available for floating point target formats. The setting becomes
+     * effective with the next call of \ref start_reader.
+     *
+     * \param [in] scale   The factor each sample is multiplied with.
+     * \param [in] offset  The value added to each scaled sample.
+     */
+    void set_scaling(DATA_TYPE scale, DATA_TYPE offset);
+
 private:
+    /*
+     * With Strata's functions, uint16_t samples are unpacked from the end to
+     * the beginning of the buffer, so the packed data is placed at the
+     * beginning. All other conversions process the buffer from the beginning
+     * to the end, with the packed data placed at the end.
+     */
+#ifdef AVIAN_USE_STRATA_PACKED12
+    static constexpr bool s_back_to_front = std::is_same<DATA_TYPE, uint16_t>::value;
+#else
+    static constexpr bool s_back_to_front = false;
+#endif
+
+    static void convert(const HW::Packed_Raw_Data_t* raw, size_t burst_size,
+                        DATA_TYPE* target, DATA_TYPE scale, DATA_TYPE offset);
+
     /** Packed raw data to be converted is read from this IReadPort instance. */
     RawReader_t& m_source;
 
@@ -112,6 +153,10 @@ private:
 
     /** Raw data is temporarily stored in the application's buffer at this offset. */
     size_t m_raw_offset;
+
+    /** Scaling applied to each sample, see \ref set_scaling. */
+    DATA_TYPE m_scale;
+    DATA_TYPE m_offset;
 };
 
 // ---------------------------------------------------------------------------- DataConverter::DataConverter
@@ -119,7 +164,9 @@ template <typename DATA_TYPE>
 DataConverter<DATA_TYPE>::DataConverter(RawReader_t& source) :
     m_source(source),
     m_buffer(nullptr),
-    m_raw_offset(0)
+    m_raw_offset(0),
+    m_scale(1),
+    m_offset(0)
 {}
 
 // ---------------------------------------------------------------------------- DataConverter::~DataConverter
@@ -149,34 +196,89 @@ void DataConverter<DATA_TYPE>::start_reader(HW::Spi_Command_t burst_command,
      * size, so it can be calculated upfront here.
      * The offset is different of target data size and packed data size.
      * (See documentation of HW::Packed_Raw_Data_t about packed data format.)
+     * When converting from the end to the beginning, the packed raw data is
+     * placed at the beginning of the buffer instead.
      */
-    m_raw_offset = burst_size * sizeof(DATA_TYPE)
-                   - burst_size * 3 / 2;
+    m_raw_offset = s_back_to_front ? 0
+                                   : burst_size * sizeof(DATA_TYPE)
+                                         - burst_size * 3 / 2;
 
     /*
      * The core work of this class is done in the data ready callback that is
      * invoked by the source reader instance. It converts the packed raw data
      * that has just been read and afterwards calls the data ready callback
      * that has been set by the application.
-     * By using data type uint16_t unpacking is done in integer domain, even
-     * if target format is floating point.
      */
-    auto wrapper_callback = [this, burst_size, callback](HW::Spi_Response_t burst_cmd_response) {
+    const DATA_TYPE scale = m_scale;
+    const DATA_TYPE offset = m_offset;
+    auto wrapper_callback = [this, burst_size, scale, offset, callback](HW::Spi_Response_t burst_cmd_response) {
         auto read_ptr = reinterpret_cast<HW::Packed_Raw_Data_t*>(m_buffer) + m_raw_offset;
-        DATA_TYPE* write_ptr = m_buffer;
-
-        for (size_t i = 0; i < burst_size; i += 2)
-        {
-            *write_ptr++ = DATA_TYPE((uint16_t(read_ptr[0]) << 4) | (uint16_t(read_ptr[1]) >> 4));
-            *write_ptr++ = DATA_TYPE((uint16_t(read_ptr[1] & 0x0F) << 8) | uint16_t(read_ptr[2]));
-            read_ptr += 3;
-        }
+        convert(read_ptr, burst_size, m_buffer, scale, offset);
 
         callback(burst_cmd_response);
     };
     m_source.start_reader(burst_command, burst_size, wrapper_callback);
 }
 
+// ---------------------------------------------------------------------------- DataConverter::convert
+template <typename DATA_TYPE>
+void DataConverter<DATA_TYPE>::convert(const HW::Packed_Raw_Data_t* raw,
+                                       size_t burst_size, DATA_TYPE* target,
+                                       DATA_TYPE scale, DATA_TYPE offset)
+{
+#ifdef AVIAN_USE_STRATA_PACKED12
+    /*
+     * Strata's functions use SIMD instructions if the CPU supports them.
+     * The uint16_t version works in place when converting from the end to
+     * the beginning. The float version converts from the beginning to the
+     * end, so it's safe as long as the packed data is placed at the end.
+     */
+    const auto* raw_end = raw + burst_size * 3 / 2;
+    if (std::is_same<DATA_TYPE, uint16_t>::value)
+    {
+        ::unpackPacked12(raw, raw_end, reinterpret_cast<uint16_t*>(target));
+        return;
+    }
+    if (std::is_same<DATA_TYPE, float>::value)
+    {
+        ::unpackPacked12(raw, raw_end, reinterpret_cast<float*>(target),
+                       float(scale), float(offset));
+        return;
+    }
+#endif
+
+    /*
+     * By using data type uint16_t unpacking is done in integer domain, even
+     * if target format is floating point.
+     */
+    for (size_t i = 0; i < burst_size; i += 2)
+    {
+        const auto first = uint16_t((uint16_t(raw[0]) << 4) | (uint16_t(raw[1]) >> 4));
+        const auto second = uint16_t((uint16_t(raw[1] & 0x0F) << 8) | uint16_t(raw[2]));
+        if (std::is_floating_point<DATA_TYPE>::value)
+        {
+            *target++ = DATA_TYPE(first) * scale + offset;
+            *target++ = DATA_TYPE(second) * scale + offset;
+        }
+        else
+        {
+            *target++ = DATA_TYPE(first);
+            *target++ = DATA_TYPE(second);
+        }
+        raw += 3;
+    }
+}
+
+// ---------------------------------------------------------------------------- DataConverter::set_scaling
+template <typename DATA_TYPE>
+void DataConverter<DATA_TYPE>::set_scaling(DATA_TYPE scale, DATA_TYPE offset)
+{
+    static_assert(std::is_floating_point<DATA_TYPE>::value,
+                  "Scaling is only supported for floating point DATA_TYPE.");
+    m_scale = scale;
+    m_offset = offset;
+}
+
 // ---------------------------------------------------------------------------- DataConverter::stop_reader
 template <typename DATA_TYPE>
 void DataConverter<DATA_TYPE>::stop_reader()
@@ -39,6 +39,11 @@
 
 // ---------------------------------------------------------------------------- includes
 #include "ifxAvian_IPort.hpp"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // ---------------------------------------------------------------------------- namespaces
 namespace Infineon {
@@ -94,6 +99,95 @@ bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
 bool test_fifo_memory(HW::IControlPort& port,
                       HW::Spi_Command_t clock_config_command = 0);
 
+// ---------------------------------------------------------------------------- Profile
+/**
+ * \brief Selects the extent of the checks done by \ref run_self_test.
+ */
+enum class Profile
+{
+    Full,  /**< All checks with their full extent, the verdict cache is not
+                consulted (but updated). */
+    Fast   /**< The SPI connection is tested with a few chirps instead of the
+                whole FIFO, and checks that passed before according to the
+                verdict cache are skipped. The test stops at the first failed
+                check. */
+};
+
+// ---------------------------------------------------------------------------- Check_Result
+/**
+ * \brief The outcome of a single check of \ref run_self_test.
+ */
+struct Check_Result
+{
+    const char* name;                   /**< "spi_connection" or "fifo_memory" */
+    bool passed;                        /**< True if the check passed. */
+    bool cached;                        /**< True if the check was skipped,
+                                             because it passed before. */
+    std::chrono::microseconds duration; /**< Time spent for the check. */
+};
+
+// ---------------------------------------------------------------------------- Verdict_Cache
+/**
+ * \brief This class remembers which checks passed on which board.
+ *
+ * The checks of \ref run_self_test test properties of the hardware that don't
+ * change from one boot to the next, so a check that passed once may be
+ * skipped later. Boards are identified by a string chosen by the caller. It
+ * should contain everything that may affect the result, e.g. the board UUID
+ * and the firmware version.
+ *
+ * If a file name is given, the cache is loaded from that file and the file is
+ * rewritten on each change, so verdicts survive the process. Failed checks
+ * are never remembered.
+ *
+ * All member functions are thread safe.
+ */
+class Verdict_Cache
+{
+public:
+    explicit Verdict_Cache(std::string filename = {});
+
+    bool has_passed(const std::string& board_id, const char* check) const;
+    void set_result(const std::string& board_id, const char* check, bool passed);
+
+private:
+    void save() const;
+
+    const std::string m_filename;
+    mutable std::mutex m_guard;
+    std::map<std::string, bool> m_passed;
+};
+
+// ---------------------------------------------------------------------------- run_self_test
+/**
+ * \brief This function runs all hardware checks of an Avian device.
+ *
+ * The SPI connection is tested first, because the FIFO memory test relies on
+ * it to read the test result. Each check reports whether it passed and how
+ * long it took. A check that does not finish stops waiting when its data has
+ * not arrived in time, rather than after a fixed time.
+ *
+ * The checks of one device run one after the other, because all of them reset
+ * the device. Devices connected through different ports can be tested from
+ * different threads concurrently, also sharing one verdict cache.
+ *
+ * \param port                  The software representation of the interface
+ *                              the Avian device to be tested is connected to.
+ * \param profile               Selects the extent of the checks.
+ * \param clock_config_command  An optional command word that configures the
+ *                              reference clock.
+ * \param cache                 An optional cache of previous verdicts. It is
+ *                              updated with the results of all checks run.
+ * \param board_id              The identity of the board in the cache.
+ *
+ * \return The results of the checks in the order they were run.
+ */
+std::vector<Check_Result> run_self_test(HW::IPort<HW::Packed_Raw_Data_t>& port,
+                                        Profile profile,
+                                        HW::Spi_Command_t clock_config_command = 0,
+                                        Verdict_Cache* cache = nullptr,
+                                        const std::string& board_id = {});
+
 /* ------------------------------------------------------------------------ */
 }  // namespace HwTest
 }  // namespace Avian
@@ -35,8 +35,12 @@
 // ---------------------------------------------------------------------------- includes
 #include "ifxAvian_Types.hpp"
 #include "value_conversion/ifxAvian_TimingConversion.hpp"
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <utility>
 #include <stdexcept>
 #include <vector>
 
@@ -62,6 +66,9 @@ public:
                         Device_Type device_type = Device_Type::Unknown);
     Parameter_Extractor(std::map<uint8_t, uint32_t> registers,
                         Device_Type device_type = Device_Type::Unknown);
+    Parameter_Extractor(const std::pair<uint8_t, uint32_t>* registers,
+                        size_t num_registers,
+                        Device_Type device_type = Device_Type::Unknown);
 
     // Global parameters
     Device_Type get_device_type() const;
@@ -115,7 +122,10 @@ private:
     bool is_second_chirp(uint8_t shape, bool down) const;
     uint32_t get_num_samples(uint8_t shape, bool down) const;
 
-    std::map<uint8_t, uint32_t> m_registers;
+    // register values indexed by address, m_defined marks the addresses
+    // that were provided
+    std::array<uint32_t, 256> m_registers {};
+    std::bitset<256> m_defined;
     Device_Type m_device_type;
     Reference_Clock_Frequency m_reference_clock;
 };
@@ -35,8 +35,11 @@
 
 // ---------------------------------------------------------------------------- includes
 #include "ifxAvian_IPort.hpp"
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
-#include <map>
+#include <stdexcept>
 #include <vector>
 
 // ---------------------------------------------------------------------------- namespaces
@@ -52,10 +55,17 @@ namespace HW {
  * at all. It's possible to extract the difference between two register sets
  * and a register set can be converted into a set of SPI write commands that
  * programs a register set into an Avian device.
+ *
+ * The register values are stored in a fixed size array indexed by address
+ * together with a bitmap of defined registers, so copying, comparing and
+ * programming register sets does not allocate memory.
  */
 class RegisterSet
 {
 public:
+    /// The number of register addresses a register set can hold.
+    static constexpr size_t max_registers = 256;
+
     /**
      * This operator returns the value of the specified register. If the
      * specified register is not defined in this register set, an exception
@@ -121,6 +131,34 @@ public:
      */
     RegisterSet extract_update(const RegisterSet& base) const;
 
+    /**
+     * This operator checks if two register sets define the same registers
+     * with the same values.
+     *
+     * \param[in] other  The register set to compare to.
+     *
+     * \return True if both register sets are equal, false otherwise.
+     */
+    inline bool operator==(const RegisterSet& other) const;
+
+    /**
+     * This method returns the number of registers defined in the register
+     * set.
+     *
+     * \return The number of defined registers.
+     */
+    inline size_t size() const;
+
+    /**
+     * This method calls the provided function for each defined register in
+     * ascending address order.
+     *
+     * \param[in] func  A callable with the signature
+     *                  void(uint8_t address, uint32_t value).
+     */
+    template <typename Func>
+    inline void for_each(Func&& func) const;
+
     /**
      * This method overwrites all registers that are defined in the provided
      * register set "update". This method can also be seen as a merge of two
@@ -164,38 +202,82 @@ public:
     std::vector<Spi_Command_t>
     get_configuration_sequence(bool set_trigger_bit) const;
 
+    /**
+     * This method is the same as \ref get_configuration_sequence, but writes
+     * the SPI command sequence into a buffer provided by the caller instead
+     * of allocating a vector.
+     *
+     * \param[in]  set_trigger_bit  See \ref get_configuration_sequence.
+     * \param[out] sequence         The buffer the command words are written
+     *                              to. It must provide space for \ref size
+     *                              command words.
+     *
+     * \return The number of command words written to sequence.
+     */
+    size_t get_configuration_sequence(bool set_trigger_bit,
+                                      Spi_Command_t* sequence) const;
+
 private:
-    std::map<uint8_t, uint32_t> m_registers;
+    std::array<uint32_t, max_registers> m_values = {};
+    std::bitset<max_registers> m_defined;
 };
 
 // ---------------------------------------------------------------------------- RegisterSet::operator[]
 inline uint32_t RegisterSet::operator[](uint8_t address) const
 {
-    return m_registers.at(address);
+    if (!m_defined.test(address))
+        throw std::out_of_range("Register is not defined in register set");
+    return m_values[address];
 }
 
 // ---------------------------------------------------------------------------- RegisterSet::set
 inline void RegisterSet::set(uint8_t address, uint32_t value)
 {
-    m_registers[address] = value & 0x00FFFFFF;
+    m_values[address] = value & 0x00FFFFFF;
+    m_defined.set(address);
 }
 
 // ---------------------------------------------------------------------------- RegisterSet::set
 inline void RegisterSet::set(Spi_Command_t word)
 {
-    m_registers[word >> 25] = word & 0x00FFFFFF;
+    set(static_cast<uint8_t>(word >> 25), word);
 }
 
 // ---------------------------------------------------------------------------- RegisterSet::is_defined
 inline bool RegisterSet::is_defined(uint8_t address) const
 {
-    return m_registers.find(address) != m_registers.end();
+    return m_defined.test(address);
 }
 
 // ---------------------------------------------------------------------------- RegisterSet::remove
 inline void RegisterSet::remove(uint8_t address)
 {
-    m_registers.erase(address);
+    m_defined.reset(address);
+    m_values[address] = 0;
+}
+
+// ---------------------------------------------------------------------------- RegisterSet::operator==
+inline bool RegisterSet::operator==(const RegisterSet& other) const
+{
+    // undefined registers are always zero, see remove
+    return (m_defined == other.m_defined) && (m_values == other.m_values);
+}
+
+// ---------------------------------------------------------------------------- RegisterSet::size
+inline size_t RegisterSet::size() const
+{
+    return m_defined.count();
+}
+
+// ---------------------------------------------------------------------------- RegisterSet::for_each
+template <typename Func>
+inline void RegisterSet::for_each(Func&& func) const
+{
+    for (size_t address = 0; address < max_registers; ++address)
+    {
+        if (m_defined.test(address))
+            func(static_cast<uint8_t>(address), m_values[address]);
+    }
 }
 
 /* ------------------------------------------------------------------------ */
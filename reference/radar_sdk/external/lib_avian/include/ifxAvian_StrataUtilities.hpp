@@ -62,10 +62,14 @@ namespace Avian {
  *
  * If something goes wrong during frequency detection, an exception is thrown.
  *
+ * The Avian device is reset before the measurement, unless reset_device is
+ * false because the caller has just reset it, e.g. through
+ * \ref Driver::create_driver.
+ *
  * \return If firmware does not support frequency measurement, false is
  *         returned, otherwise true is returned.
  */
-bool detect_reference_clock(BoardInstance& board, Driver& driver);
+bool detect_reference_clock(BoardInstance& board, Driver& driver, bool reset_device = true);
 /**
  * \brief Return the register map for the given device.
  *
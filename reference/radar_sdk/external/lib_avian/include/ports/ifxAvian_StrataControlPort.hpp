@@ -107,6 +107,34 @@ public:
         return m_pins->getIrqPin();
     }
 
+    /**
+     * \brief Reads a FIFO burst of arbitrary length through the SPI bridge.
+     *
+     * The burst command (see \ref Driver::get_burst_prefix) is sent and the
+     * requested number of samples is read in one SPI burst, independent of
+     * the maximum transfer size of the bridge. This is meant for host driven
+     * acquisition, so the Strata data path must not be active meanwhile.
+     *
+     * \param [in]  burst_command  The SPI command that starts the burst.
+     * \param [in]  num_samples    The number of samples to read, must be even.
+     * \param [out] buffer         The buffer for the packed data, which must
+     *                             hold num_samples * 3 / 2 bytes.
+     */
+    void read_burst(HW::Spi_Command_t burst_command, size_t num_samples,
+                    HW::Packed_Raw_Data_t* buffer)
+    {
+        constexpr uint8_t dev_id = 0;
+        const uint8_t prefix[] = {
+            uint8_t(burst_command >> 24),
+            uint8_t(burst_command >> 16),
+            uint8_t(burst_command >> 8),
+            uint8_t(burst_command),
+        };
+        m_board->getISpi()->readBurst(dev_id, sizeof(prefix), prefix,
+                                      narrow_cast<uint32_t>(num_samples * 3 / 2),
+                                      buffer);
+    }
+
     BoardInstance& getBoardInstance()
     {
         return *m_board;
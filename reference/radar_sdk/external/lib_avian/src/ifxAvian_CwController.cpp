@@ -46,6 +46,7 @@
 #include <condition_variable>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
 
 
 // Define template for clamp because std::clamp is only available with C++17.
@@ -64,6 +65,32 @@ constexpr const T& clamp(const T& value, const T& low, const T& high)
 namespace Infineon {
 namespace Avian {
 
+// ---------------------------------------------------------------------------- Rx_Stream
+/*
+ * State of a stream started by start_rx_stream. The data converter stays
+ * running for the whole stream and fills two raw buffers alternately, so the
+ * next block can be acquired while the callback processes the previous one.
+ */
+struct Continuous_Wave_Controller::Rx_Stream
+{
+    explicit Rx_Stream(HW::IReadPort<HW::Packed_Raw_Data_t>& read_port) :
+        converter(read_port)
+    {}
+
+    DataConverter<uint16_t> converter;
+    std::array<std::vector<uint16_t>, 2> raw_data;
+    Rx_Stream_Callback_t callback;
+    std::vector<HW::Spi_Command_t> trigger;
+
+    std::mutex wait_guard;
+    std::condition_variable receive_notifier;
+    bool data_received = false;
+    bool stop_requested = false;
+    bool failed = false;
+
+    std::thread thread;
+};
+
 // ---------------------------------------------------------------------------- Continuous_Wave_Controller
 Continuous_Wave_Controller::Continuous_Wave_Controller(HW::IControlPort& port) :
     Continuous_Wave_Controller(port, Driver::create_driver(port))
@@ -137,6 +164,9 @@ Device_Type Continuous_Wave_Controller::get_device_type() const
 // ---------------------------------------------------------------------------- enable_continuous_wave
 void Continuous_Wave_Controller::enable_continuous_wave(bool enable)
 {
+    // Reprogramming the device ends a running stream.
+    stop_rx_stream();
+
     m_continuous_wave_enabled = enable;
     if (enable)
     {
@@ -584,9 +614,9 @@ float Continuous_Wave_Controller::get_sampling_rate() const
 // ---------------------------------------------------------------------------- capture_rx_signals
 std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_signals()
 {
-    auto& device_traits = Device_Traits::get(m_driver->get_device_type());
-
     // First it's checked if data can be acquired.
+    if (m_rx_stream)
+        throw std::runtime_error("A stream is active.");
     if (!m_continuous_wave_enabled)
         throw std::runtime_error("continuous wave is not active.");
     if (m_rx_mask == 0)
@@ -626,6 +656,69 @@ std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_si
                            });
     converter.set_buffer(raw_data.data());
 
+    select_rx_adc_input();
+    auto spi_commands = get_trigger_sequence();
+
+    /*
+     * After starting the ADC the execution blocks and waits for data. The
+     * receive callback handler above will unblock this thread.
+     *
+     * After data has been received calling get_frame_info brings the Avian
+     * state machine back to the point it was before the acquisition. The
+     * frame info structure can be ignored.
+     */
+    std::unique_lock<std::mutex> lock(wait_guard);
+
+    m_port.send_commands(spi_commands.data(), spi_commands.size());
+
+    receive_notifier.wait_for(lock, std::chrono::seconds(1),
+                              [&]() { return data_received; });
+
+    if (!data_received || !go_to_active_state())
+    {
+        m_port.generate_reset_sequence();
+        m_continuous_wave_enabled = false;
+        throw std::runtime_error("A hardware failure occurred.");
+    }
+
+    /*
+     * Finally raw data is de-interleaved and converted to floating point
+     * numbers in the range -1...1.
+     */
+    std::map<unsigned, std::vector<float>> rx_signals;
+    unsigned start_index = 0;
+    for (unsigned i = 0; i < get_number_of_rx_antennas(); ++i)
+    {
+        if (!is_rx_antenna_enabled(i))
+            continue;
+
+        /*
+         * A read pointer is initialized to point at the first sample of the
+         * current RX antenna signal.
+         */
+        auto raw_pointer = raw_data.data() + start_index;
+        ++start_index;
+
+        /*
+         * A output vector created and filled with the current RX antenna's
+         * signal. Maximum 12 bit ADC Range 0...4095 is scaled to -1...1.
+         */
+        auto& signal = rx_signals.emplace(i, m_num_samples).first->second;
+        for (auto& sample : signal)
+        {
+            sample = *raw_pointer * (2.f / 4095.f) - 1.f;
+            raw_pointer += num_rx_antennas;
+        }
+    }
+
+    return rx_signals;
+}
+
+// ---------------------------------------------------------------------------- select_rx_adc_input
+void Continuous_Wave_Controller::select_rx_adc_input()
+{
+    auto& device_traits = Device_Traits::get(m_driver->get_device_type());
+
     /*
      * For Avian devices without SADC the MADC input may be set to temperature
      * or power sensor channel, so the input must be set to RX channel.
@@ -637,7 +730,11 @@ std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_si
                           & ~BGT60TR11D_ADC1_SENSOR_SEL_msk);
         m_port.send_commands(&command, 1);
     }
+}
 
+// ---------------------------------------------------------------------------- get_trigger_sequence
+std::vector<HW::Spi_Command_t> Continuous_Wave_Controller::get_trigger_sequence()
+{
     /*
      * The SPI sequence to trigger acquisition is prepared here.
      * Usually this sequence contains only a single write command to set the
@@ -683,59 +780,123 @@ std::map<unsigned, std::vector<float>> Continuous_Wave_Controller::capture_rx_si
         }
     }
 
-    /*
-     * After starting the ADC the execution blocks and waits for data. The
-     * receive callback handler above will unblock this thread.
-     *
-     * After data has been received calling get_frame_info brings the Avian
-     * state machine back to the point it was before the acquisition. The
-     * frame info structure can be ignored.
-     */
-    std::unique_lock<std::mutex> lock(wait_guard);
+    return spi_commands;
+}
 
-    m_port.send_commands(spi_commands.data(), spi_commands.size());
+// ---------------------------------------------------------------------------- start_rx_stream
+void Continuous_Wave_Controller::start_rx_stream(Rx_Stream_Callback_t callback)
+{
+    if (m_rx_stream)
+        throw std::runtime_error("A stream is already active.");
+    if (!m_continuous_wave_enabled)
+        throw std::runtime_error("continuous wave is not active.");
+    if (m_rx_mask == 0)
+        throw std::runtime_error("No RX antenna selected.");
 
-    receive_notifier.wait_for(lock, std::chrono::seconds(1),
-                              [&]() { return data_received; });
+    auto read_port = dynamic_cast<HW::IReadPort<HW::Packed_Raw_Data_t>*>(&m_port);
+    if (read_port == nullptr)
+        throw std::runtime_error("The provided port does not support data acquisition.");
 
-    if (!data_received || !go_to_active_state())
-    {
-        m_port.generate_reset_sequence();
-        m_continuous_wave_enabled = false;
-        throw std::runtime_error("A hardware failure occurred.");
-    }
+    auto stream = std::make_unique<Rx_Stream>(*read_port);
+    size_t raw_block_size = m_num_samples * m_rx_mask.count();
+    for (auto& buffer : stream->raw_data)
+        buffer.resize(raw_block_size);
+    stream->callback = std::move(callback);
+
+    select_rx_adc_input();
+    stream->trigger = get_trigger_sequence();
+
+    auto* state = stream.get();
+    stream->converter.start_reader(m_driver->get_burst_prefix(), raw_block_size,
+                                   [state](uint32_t) -> void {
+                                       {
+                                           std::unique_lock<std::mutex> lock(state->wait_guard);
+                                           state->data_received = true;
+                                       }
+                                       state->receive_notifier.notify_one();
+                                   });
+
+    m_rx_stream = std::move(stream);
+    m_rx_stream->thread = std::thread(&Continuous_Wave_Controller::run_rx_stream, this);
+}
 
-    /*
-     * Finally raw data is de-interleaved and converted to floating point
-     * numbers in the range -1...1.
-     */
-    std::map<unsigned, std::vector<float>> rx_signals;
-    unsigned start_index = 0;
-    for (unsigned i = 0; i < get_number_of_rx_antennas(); ++i)
+// ---------------------------------------------------------------------------- run_rx_stream
+void Continuous_Wave_Controller::run_rx_stream()
+{
+    auto& stream = *m_rx_stream;
+    unsigned current = 0;
+
+    // The first block is triggered here, all others after the previous block.
+    stream.converter.set_buffer(stream.raw_data[current].data());
+    m_port.send_commands(stream.trigger.data(), stream.trigger.size());
+
+    std::unique_lock<std::mutex> lock(stream.wait_guard);
+    while (true)
     {
-        if (!is_rx_antenna_enabled(i))
-            continue;
+        stream.receive_notifier.wait_for(lock, std::chrono::seconds(1),
+                                         [&]() { return stream.data_received || stream.stop_requested; });
+        if (stream.stop_requested)
+            break;
 
-        /*
-         * A read pointer is initialized to point at the first sample of the
-         * current RX antenna signal.
-         */
-        auto raw_pointer = raw_data.data() + start_index;
-        ++start_index;
+        const bool data_received = stream.data_received;
+        stream.data_received = false;
+        lock.unlock();
 
         /*
-         * A output vector created and filled with the current RX antenna's
-         * signal. Maximum 12 bit ADC Range 0...4095 is scaled to -1...1.
+         * The state machine is brought back to the point before the
+         * acquisition and the next block is triggered into the other buffer
+         * before the received block is handed to the callback.
          */
-        auto& signal = rx_signals.emplace(i, m_num_samples).first->second;
-        for (auto& sample : signal)
+        if (!data_received || !go_to_active_state())
         {
-            sample = *raw_pointer * (2.f / 4095.f) - 1.f;
-            raw_pointer += num_rx_antennas;
+            stream.failed = true;
+            stream.callback(nullptr, 0);
+            return;
         }
+
+        const auto& block = stream.raw_data[current];
+        current ^= 1;
+        stream.converter.set_buffer(stream.raw_data[current].data());
+        m_port.send_commands(stream.trigger.data(), stream.trigger.size());
+
+        stream.callback(block.data(), block.size());
+        lock.lock();
     }
+}
 
-    return rx_signals;
+// ---------------------------------------------------------------------------- stop_rx_stream
+void Continuous_Wave_Controller::stop_rx_stream()
+{
+    if (!m_rx_stream)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_rx_stream->wait_guard);
+        m_rx_stream->stop_requested = true;
+    }
+    m_rx_stream->receive_notifier.notify_one();
+    m_rx_stream->thread.join();
+    m_rx_stream->converter.stop_reader();
+
+    const bool failed = m_rx_stream->failed;
+    m_rx_stream.reset();
+
+    /*
+     * After a failure or when stopped during an acquisition the state machine
+     * is in an unknown state, so it is brought back to active state as after
+     * each capture.
+     */
+    if (failed || !go_to_active_state())
+    {
+        m_port.generate_reset_sequence();
+        m_continuous_wave_enabled = false;
+    }
+}
+
+// ---------------------------------------------------------------------------- is_rx_stream_active
+bool Continuous_Wave_Controller::is_rx_stream_active() const
+{
+    return m_rx_stream != nullptr;
 }
 
 // ---------------------------------------------------------------------------- set_hp_gain
@@ -40,8 +40,10 @@
 #include "ifxAvian_DeviceTraits.hpp"
 #include "ifxAvian_Driver.hpp"
 #include "ifxAvian_Utilities.hpp"
+#include <algorithm>
 #include <array>
 #include <condition_variable>
+#include <fstream>
 #include <mutex>
 
 // ---------------------------------------------------------------------------- namespaces
@@ -49,9 +51,29 @@ namespace Infineon {
 namespace Avian {
 namespace HwTest {
 
-// ---------------------------------------------------------------------------- test_spi_connection
-bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
-                         HW::Spi_Command_t clock_config_command)
+namespace {
+
+// ---------------------------------------------------------------------------- Check names
+constexpr const char* spi_connection_check = "spi_connection";
+constexpr const char* fifo_memory_check = "fifo_memory";
+
+// ---------------------------------------------------------------------------- Fast profile
+/*
+ * A few chirps are enough to detect a broken SPI connection. The FIFO memory
+ * itself is covered by the memory test.
+ */
+constexpr uint16_t fast_max_chirps = 4;
+constexpr auto fast_data_timeout = std::chrono::milliseconds(200);
+constexpr auto full_data_timeout = std::chrono::milliseconds(1000);
+
+// The memory test of the device completes within milliseconds.
+constexpr auto memory_test_timeout = std::chrono::milliseconds(1000);
+
+// ---------------------------------------------------------------------------- run_spi_connection_test
+bool run_spi_connection_test(HW::IPort<HW::Packed_Raw_Data_t>& port,
+                             HW::Spi_Command_t clock_config_command,
+                             uint16_t max_chirps,
+                             std::chrono::milliseconds data_timeout)
 {
     constexpr uint16_t cfg_num_samples_per_chirp = 256;
 
@@ -69,7 +91,8 @@ bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
     Driver driver(port, device_type);
 
     const uint16_t fifo_size = Device_Traits::get(device_type).fifo_size * 2;
-    const uint16_t num_chirps = fifo_size / cfg_num_samples_per_chirp;
+    const uint16_t num_chirps = std::min<uint16_t>(fifo_size / cfg_num_samples_per_chirp,
+                                                   max_chirps);
     Frame_Definition frame_definition =
         {
             {/*             num_reps,   following_power_mode,   delay */
@@ -234,7 +257,7 @@ bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
      */
     {
         std::unique_lock<std::mutex> lock(state_guard);
-        synchronizer.wait_for(lock, std::chrono::seconds(1), is_finished);
+        synchronizer.wait_for(lock, data_timeout, is_finished);
     }
 
     /*
@@ -247,6 +270,27 @@ bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
     return has_succeeded();
 }
 
+// ---------------------------------------------------------------------------- timed_check
+template <typename Check>
+Check_Result timed_check(const char* name, Check&& check)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const bool passed = check();
+    const auto duration = std::chrono::steady_clock::now() - start;
+    return {name, passed, false,
+            std::chrono::duration_cast<std::chrono::microseconds>(duration)};
+}
+
+}  // namespace
+
+// ---------------------------------------------------------------------------- test_spi_connection
+bool test_spi_connection(HW::IPort<HW::Packed_Raw_Data_t>& port,
+                         HW::Spi_Command_t clock_config_command)
+{
+    return run_spi_connection_test(port, clock_config_command, UINT16_MAX,
+                                   full_data_timeout);
+}
+
 // ---------------------------------------------------------------------------- test_fifo_memory
 bool test_fifo_memory(HW::IControlPort& port,
                       HW::Spi_Command_t clock_config_command)
@@ -282,11 +326,18 @@ bool test_fifo_memory(HW::IControlPort& port,
          */
         HW::Spi_Command_t readback_command = BGT60TRxxC_REGISTER_READ_CMD(DFT1);
         HW::Spi_Command_t test_status = 0;
+        const auto expiry = std::chrono::steady_clock::now() + memory_test_timeout;
         while (BGT60TRxxC_EXTRACT(DFT1, DONE, test_status) == 0)
+        {
+            // A device that never reports the end of the test has failed it.
+            if (std::chrono::steady_clock::now() > expiry)
+                break;
             port.send_commands(&readback_command, 1, &test_status);
+        }
 
         // The DFT1 register also contains a bit that indicates the test result.
-        if (BGT60TRxxC_EXTRACT(DFT1, FAIL, test_status) != 0)
+        if ((BGT60TRxxC_EXTRACT(DFT1, DONE, test_status) == 0)
+            || (BGT60TRxxC_EXTRACT(DFT1, FAIL, test_status) != 0))
         {
             test_result = false;
             break;
@@ -299,6 +350,93 @@ bool test_fifo_memory(HW::IControlPort& port,
     return test_result;
 }
 
+// ---------------------------------------------------------------------------- Verdict_Cache
+Verdict_Cache::Verdict_Cache(std::string filename) :
+    m_filename(std::move(filename))
+{
+    if (m_filename.empty())
+        return;
+
+    // Each line of the file names a board and a check that passed on it.
+    std::ifstream file(m_filename);
+    std::string board_id;
+    std::string check;
+    while (file >> board_id >> check)
+        m_passed[board_id + ' ' + check] = true;
+}
+
+bool Verdict_Cache::has_passed(const std::string& board_id,
+                               const char* check) const
+{
+    std::lock_guard<std::mutex> lock(m_guard);
+    return m_passed.count(board_id + ' ' + check) != 0;
+}
+
+void Verdict_Cache::set_result(const std::string& board_id, const char* check,
+                               bool passed)
+{
+    std::lock_guard<std::mutex> lock(m_guard);
+    const auto key = board_id + ' ' + check;
+    const bool changed = passed ? m_passed.emplace(key, true).second
+                                : (m_passed.erase(key) != 0);
+    if (changed)
+        save();
+}
+
+void Verdict_Cache::save() const
+{
+    if (m_filename.empty())
+        return;
+
+    std::ofstream file(m_filename, std::ios::trunc);
+    for (const auto& entry : m_passed)
+        file << entry.first << '\n';
+}
+
+// ---------------------------------------------------------------------------- run_self_test
+std::vector<Check_Result> run_self_test(HW::IPort<HW::Packed_Raw_Data_t>& port,
+                                        Profile profile,
+                                        HW::Spi_Command_t clock_config_command,
+                                        Verdict_Cache* cache,
+                                        const std::string& board_id)
+{
+    const bool fast = (profile == Profile::Fast);
+    std::vector<Check_Result> results;
+
+    /*
+     * Each check is run unless the fast profile finds it passed before. The
+     * return value tells if the test shall continue.
+     */
+    auto run_check = [&](const char* name, auto&& check) -> bool {
+        if (fast && cache && cache->has_passed(board_id, name))
+        {
+            results.push_back({name, true, true, std::chrono::microseconds(0)});
+            return true;
+        }
+
+        results.push_back(timed_check(name, check));
+        if (cache)
+            cache->set_result(board_id, name, results.back().passed);
+        return results.back().passed || !fast;
+    };
+
+    const bool go_on = run_check(spi_connection_check, [&] {
+        return fast ? run_spi_connection_test(port, clock_config_command,
+                                              fast_max_chirps,
+                                              fast_data_timeout)
+                    : test_spi_connection(port, clock_config_command);
+    });
+
+    if (go_on)
+    {
+        run_check(fifo_memory_check, [&] {
+            return test_fifo_memory(port, clock_config_command);
+        });
+    }
+
+    return results;
+}
+
 /* ------------------------------------------------------------------------ */
 }  // namespace HwTest
 }  // namespace Avian
@@ -69,9 +69,14 @@ Parameter_Extractor::Parameter_Extractor(const std::vector<uint32_t>& registers,
      * The internal register list is initialized from the provided register
      * list. For each register value the according address is added.
      */
-    uint8_t address = 0;
+    size_t address = 0;
     for (auto uValue : registers)
-        m_registers.emplace(address++, uValue);
+    {
+        if (address >= m_registers.size())
+            break;
+        m_registers[address] = uValue;
+        m_defined.set(address++);
+    }
 
     detect_type_and_clock();
 }
@@ -79,31 +84,49 @@ Parameter_Extractor::Parameter_Extractor(const std::vector<uint32_t>& registers,
 // ---------------------------------------------------------------------------- Parameter_Extractor
 Parameter_Extractor::Parameter_Extractor(std::map<uint8_t, uint32_t> registers,
                                          Device_Type device_type) :
-    m_registers(std::move(registers)),
     m_device_type(device_type),
     m_reference_clock(Reference_Clock_Frequency::_80MHz)
 {
+    for (const auto& entry : registers)
+    {
+        m_registers[entry.first] = entry.second;
+        m_defined.set(entry.first);
+    }
+
+    detect_type_and_clock();
+}
+
+// ---------------------------------------------------------------------------- Parameter_Extractor
+Parameter_Extractor::Parameter_Extractor(const std::pair<uint8_t, uint32_t>* registers,
+                                         size_t num_registers,
+                                         Device_Type device_type) :
+    m_device_type(device_type),
+    m_reference_clock(Reference_Clock_Frequency::_80MHz)
+{
+    for (size_t i = 0; i < num_registers; i++)
+    {
+        m_registers[registers[i].first] = registers[i].second;
+        m_defined.set(registers[i].first);
+    }
+
     detect_type_and_clock();
 }
 
 // ---------------------------------------------------------------------------- get_register
 /**
  * Other functions should use this function instead of looking up registers
- * directly from m_registers, because this function translates the generic
- * out_of_range exception into an exception with a more meaningful description.
+ * directly from m_registers, because this function checks that the register
+ * is defined and throws an exception with a meaningful description otherwise.
  */
 uint32_t Parameter_Extractor::get_register(uint8_t address,
                                            const char* function_name) const
 {
-    try
-    {
-        return m_registers.at(address);
-    }
-    catch (std::out_of_range&)
+    if (!m_defined.test(address))
     {
         throw Error("Register " + std::to_string(address) + " required by"
                     + " \"" + function_name + "\" is not defined.");
     }
+    return m_registers[address];
 }
 
 /*
@@ -1205,13 +1228,15 @@ bool Parameter_Extractor::is_second_chirp(uint8_t shape, bool down) const
 // ---------------------------------------------------------------------------- has_register
 bool Parameter_Extractor::has_register(uint8_t address) const
 {
-    return m_registers.count(address) > 0;
+    return m_defined.test(address);
 }
 
 // ---------------------------------------------------------------------------- get_register_value
 uint32_t Parameter_Extractor::get_register_value(uint8_t address) const
 {
-    return m_registers.at(address);
+    if (!m_defined.test(address))
+        throw std::out_of_range("register not defined");
+    return m_registers[address];
 }
 
 /* ------------------------------------------------------------------------ */
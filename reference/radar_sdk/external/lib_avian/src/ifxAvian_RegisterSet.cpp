@@ -47,10 +47,14 @@ RegisterSet RegisterSet::extract_update(const RegisterSet& base) const
      * have a different value are copied to the update register set.
      */
     RegisterSet update;
-    for (const auto& reg : m_registers)
+    for (size_t address = 0; address < max_registers; ++address)
     {
-        if (!base.is_defined(reg.first) || (base[reg.first] != reg.second))
-            update.m_registers[reg.first] = reg.second;
+        if (m_defined.test(address)
+            && (!base.m_defined.test(address) || (base.m_values[address] != m_values[address])))
+        {
+            update.m_values[address] = m_values[address];
+            update.m_defined.set(address);
+        }
     }
     return update;
 }
@@ -58,51 +62,62 @@ RegisterSet RegisterSet::extract_update(const RegisterSet& base) const
 // ----------------------------------------------------------------------------- apply_update
 void RegisterSet::apply_update(const RegisterSet& update)
 {
-    for (const auto& reg : update.m_registers)
-        m_registers[reg.first] = reg.second;
+    update.for_each([this](uint8_t address, uint32_t value) {
+        m_values[address] = value;
+    });
+    m_defined |= update.m_defined;
 }
 
 // ----------------------------------------------------------------------------- send_to_device
 void RegisterSet::send_to_device(IControlPort& port, bool set_trigger_bit) const
 {
-    auto sequence = get_configuration_sequence(set_trigger_bit);
-    port.send_commands(sequence.data(), sequence.size());
+    std::array<Spi_Command_t, max_registers> sequence;
+    const auto num_words = get_configuration_sequence(set_trigger_bit, sequence.data());
+    port.send_commands(sequence.data(), num_words);
 }
 
 // ----------------------------------------------------------------------------- get_configuration_sequence
 std::vector<Spi_Command_t>
 RegisterSet::get_configuration_sequence(bool set_trigger_bit) const
+{
+    std::vector<Spi_Command_t> sequence(size());
+    get_configuration_sequence(set_trigger_bit, sequence.data());
+    return sequence;
+}
+
+// ----------------------------------------------------------------------------- get_configuration_sequence
+size_t RegisterSet::get_configuration_sequence(bool set_trigger_bit,
+                                               Spi_Command_t* sequence) const
 {
     Spi_Command_t trigger_command = 0;
+    size_t num_words = 0;
 
-    std::vector<Spi_Command_t> sequence;
-    for (const auto& reg : m_registers)
-    {
+    for_each([&](uint8_t address, uint32_t value) {
         /*
          * The register address, the write bit and the value are combined into
          * a word that can be sent to an Avian device.
          */
-        auto seq_word = (Spi_Command_t(reg.first) << 25)
-                        | 0x01000000 | reg.second;
+        auto seq_word = (Spi_Command_t(address) << 25)
+                        | 0x01000000 | value;
 
         /*
          * When a frame is triggered, the main register must be sent at
          * the end, because it contains the trigger bit.
          */
-        if ((reg.first == BGT60TRxxC_REG_MAIN) && set_trigger_bit)
+        if ((address == BGT60TRxxC_REG_MAIN) && set_trigger_bit)
         {
             trigger_command = seq_word | BGT60TRxxC_SET(MAIN, FRAME_START, 1);
-            continue;
+            return;
         }
 
-        sequence.push_back(seq_word);
-    }
+        sequence[num_words++] = seq_word;
+    });
 
     // If there a trigger word is defined add it at the end.
     if (trigger_command)
-        sequence.push_back(trigger_command);
+        sequence[num_words++] = trigger_command;
 
-    return sequence;
+    return num_words;
 }
 
 /* ------------------------------------------------------------------------ */
@@ -193,7 +193,7 @@ void generate_oscillator_measurement_signal(HW::IControlPort& port,
 }
 
 // ---------------------------------------------------------------------------- detect_reference_clock
-bool detect_reference_clock(BoardInstance& board, Driver& driver)
+bool detect_reference_clock(BoardInstance& board, Driver& driver, bool reset_device)
 {
     /*
      * Avian C devices work only with external 80Mhz oscillator. There is no
@@ -209,14 +209,15 @@ bool detect_reference_clock(BoardInstance& board, Driver& driver)
 
     /*
      * Before starting the measurement the Avian device is put into a defined
-     * state.
+     * state, which it is already in if the caller has just reset it.
      *
      * Note: After a reset it is usually required to configure the high-speed,
      *       but here this is not required, because there is no register read
      *       back.
      */
     StrataControlPort avian_port(&board);
-    avian_port.generate_reset_sequence();
+    if (reset_device)
+        avian_port.generate_reset_sequence();
 
     /*
      * For oscillator frequency measurement, a special firmware feature is
@@ -9,8 +9,13 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <type_traits>
 #include <typeindex>
@@ -167,6 +172,157 @@ public:
     }
 };
 
+///
+/// \brief The SlotHandleManager class manages instances in a fixed number of slots.
+/// \details A handle combines the slot index with a generation counter of the slot,
+///          which is incremented whenever the slot is filled or emptied.
+///          So a handle of a deleted instance is never valid again, even if its slot is reused.
+///          Looking up a handle is lock-free and just compares the slot's generation,
+///          only adding and deleting instances take a lock.
+///          Like with the other handle managers, it is the callers responsibility to not
+///          delete an instance while it is still used by another thread.
+///
+template <typename ClassType, std::size_t Capacity = 256>
+class SlotHandleManager
+{
+public:
+    using HandleType = uint64_t;
+
+    static constexpr HandleType m_invalidHandle = 0;
+
+    SlotHandleManager()
+    {
+        for (std::size_t i = 0; i < Capacity; i++)
+        {
+            m_freeSlots[i] = static_cast<uint32_t>(Capacity - 1 - i);
+        }
+        m_numFreeSlots = Capacity;
+    }
+
+    ~SlotHandleManager()
+    {
+        for (auto &slot : m_slots)
+        {
+            delete slot.instance.load(std::memory_order_relaxed);
+        }
+    }
+
+    SlotHandleManager(const SlotHandleManager &) = delete;
+    SlotHandleManager &operator=(const SlotHandleManager &) = delete;
+
+    /**
+     * Add an instance and return its handle
+     * @param instance The instance to be managed
+     *
+     * @return The handle for the instance, m_invalidHandle if instance is empty or all slots are in use
+     */
+    inline HandleType addInstance(std::unique_ptr<ClassType> &&instance)
+    {
+        if (!instance)
+        {
+            return m_invalidHandle;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_numFreeSlots == 0)
+        {
+            return m_invalidHandle;
+        }
+
+        const uint32_t index = m_freeSlots[--m_numFreeSlots];
+        auto &slot           = m_slots[index];
+
+        // publish the instance before the generation that makes the handle valid
+        slot.instance.store(instance.release(), std::memory_order_relaxed);
+        const uint32_t generation = slot.generation.load(std::memory_order_relaxed) + 1;
+        slot.generation.store(generation, std::memory_order_release);
+
+        return makeHandle(index, generation);
+    }
+
+    /**
+     * Get the pointer to an instance
+     * @param handle The obtained handle
+     *
+     * @return Pointer to instance, nullptr if the handle is not valid (anymore)
+     */
+    inline ClassType *getInstance(HandleType handle) const
+    {
+        const auto index = static_cast<uint32_t>(handle) - 1;
+        if (index >= Capacity)
+        {
+            return nullptr;
+        }
+
+        const auto &slot          = m_slots[index];
+        const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+        if (slot.generation.load(std::memory_order_acquire) != generation)
+        {
+            return nullptr;
+        }
+
+        auto *instance = slot.instance.load(std::memory_order_acquire);
+
+        // check again, in case the slot was emptied in the meantime
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.generation.load(std::memory_order_relaxed) != generation)
+        {
+            return nullptr;
+        }
+        return instance;
+    }
+
+    /**
+     * Destroy an instance and invalidate its handle
+     * @param handle The obtained handle
+     *
+     * @return true on success, false if the handle is not valid
+     */
+    inline bool deleteInstance(HandleType handle)
+    {
+        std::unique_ptr<ClassType> instance;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!getInstance(handle))
+            {
+                return false;
+            }
+
+            const auto index = static_cast<uint32_t>(handle) - 1;
+            auto &slot       = m_slots[index];
+
+            // invalidate the handle before the instance is removed
+            slot.generation.store(slot.generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            instance.reset(slot.instance.exchange(nullptr, std::memory_order_acq_rel));
+
+            m_freeSlots[m_numFreeSlots++] = index;
+        }
+        return true;
+    }
+
+private:
+    /*
+     * Odd generations mark used slots, even generations free ones.
+     * The index is stored with an offset of 1, so a handle is never m_invalidHandle.
+     */
+    static inline HandleType makeHandle(uint32_t index, uint32_t generation)
+    {
+        return (static_cast<HandleType>(generation) << 32) | (index + 1);
+    }
+
+    struct Slot
+    {
+        std::atomic<uint32_t> generation {0};
+        std::atomic<ClassType *> instance {nullptr};
+    };
+
+    std::array<Slot, Capacity> m_slots;
+
+    std::mutex m_mutex;
+    std::array<uint32_t, Capacity> m_freeSlots;
+    std::size_t m_numFreeSlots;
+};
+
 ///
 /// \brief The AssociatedHandleTracker class tracks the lifetime of handles.
 /// \details When the owner of a handle is removed then all its descendants become invalidated.
@@ -10,6 +10,12 @@
 #include "Logger.hpp"
 #include "Time.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <streambuf>
+
 
 //#define WIN_FORCE_CONSOLE
 
@@ -25,6 +31,149 @@ Logger LoggerInstance(LoggerLevelDefault, LoggerFileName);
 namespace
 {
     std::chrono::steady_clock::time_point log_tic;
+
+    constexpr std::size_t MaxLine         = 1024;  // longer lines are truncated
+    constexpr std::size_t RecordAlignment = 8;
+    constexpr uint32_t PaddingRecord      = UINT32_MAX;
+    constexpr auto IdleSleep              = std::chrono::milliseconds(2);
+
+    /**
+     * @brief Header of a line in a ring buffer, followed by the characters
+     */
+    struct Record
+    {
+        uint32_t size;    // size of the record including header and alignment
+        uint32_t length;  // number of characters, PaddingRecord for padding
+        int64_t time;
+        uint8_t level;
+        bool flush;
+    };
+
+    /**
+     * @brief Stream buffer writing into a fixed array, excess characters are dropped
+     */
+    class LineBuffer : public std::streambuf
+    {
+    public:
+        LineBuffer()
+        {
+            reset();
+        }
+
+        void reset()
+        {
+            setp(m_data, m_data + sizeof(m_data));
+        }
+
+        const char *data() const
+        {
+            return m_data;
+        }
+
+        std::size_t length() const
+        {
+            return static_cast<std::size_t>(pptr() - pbase());
+        }
+
+    protected:
+        int_type overflow(int_type ch) override
+        {
+            return traits_type::not_eof(ch);
+        }
+
+    private:
+        char m_data[MaxLine];
+    };
+
+    // set when lineStream of the thread is destroyed, lines logged afterwards
+    // (e.g. from static destructors) are dropped
+    thread_local bool lineStreamDestroyed = false;
+
+    struct LineStream
+    {
+        LineStream() :
+            stream {&buffer}
+        {}
+
+        ~LineStream()
+        {
+            lineStreamDestroyed = true;
+        }
+
+        LineBuffer buffer;
+        std::ostream stream;
+    };
+
+    thread_local LineStream lineStream;
+
+    const char *levelTag(uint8_t level)
+    {
+        switch (level)
+        {
+            case Logger::LOG_INFO:
+                return "INFO: ";
+            case Logger::LOG_DEBUG:
+                return "DEBUG: ";
+            case Logger::LOG_WARN:
+                return "WARN: ";
+            case Logger::LOG_ERROR:
+                return "ERROR: ";
+            default:
+                return "";
+        }
+    }
+
+    std::size_t alignRecord(std::size_t size)
+    {
+        return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+    }
+}
+
+
+/**
+ * @brief Single producer, single consumer ring buffer of a thread
+ *
+ * head and tail count bytes and are never wrapped; the owning thread
+ * advances head, the writer thread advances tail.
+ */
+struct Logger::Ring
+{
+    explicit Ring(std::size_t size) :
+        data {new char[size]},
+        size {size}
+    {}
+
+    std::unique_ptr<char[]> data;
+    const std::size_t size;
+    std::atomic<std::size_t> head {0};
+    std::atomic<std::size_t> tail {0};
+    std::atomic<bool> owned {true};
+    Ring *next = nullptr;
+};
+
+
+namespace
+{
+    /**
+     * @brief Ring of the calling thread, released when the thread exits
+     */
+    struct ThreadRing
+    {
+        ~ThreadRing()
+        {
+            if (owned && epoch == owner->load())
+            {
+                owned->store(false, std::memory_order_release);
+            }
+        }
+
+        void *ring                         = nullptr;
+        std::atomic<bool> *owned           = nullptr;
+        uint32_t epoch                     = 0;
+        const std::atomic<uint32_t> *owner = nullptr;
+    };
+
+    thread_local ThreadRing currentRing;
 }
 
 
@@ -40,7 +189,15 @@ void toc()
     LOG(DEBUG) << "*** toc: duration = " << std::dec << log_toc << "us";
 }
 
-Logger::Logger(Logger::LogLevel level, const char *filename)
+Logger::Logger(Logger::LogLevel level, const char *filename) :
+    m_rateLimit {0},
+    m_async {false},
+    m_epoch {0},
+    m_ringSize {0},
+    m_rings {nullptr},
+    m_writerStop {false},
+    m_dropped {0},
+    m_droppedReported {0}
 {
     setLevel(level);
 #if defined(_WIN32) && defined(WIN_FORCE_CONSOLE)
@@ -61,7 +218,10 @@ Logger::~Logger()
 {
     try
     {
-        Logger::Line(this) << std::endl;
+        setAsync(false);
+
+        std::lock_guard<std::mutex> lock(m_lineLock);
+        output(LOG_NONE, 0, "\n", 1, true);
         if (m_outFile.is_open())
         {
             m_outFile.close();
@@ -79,6 +239,8 @@ void Logger::setLevel(Logger::LogLevel level)
 
 void Logger::setFile(const char *filename)
 {
+    std::lock_guard<std::mutex> lock(m_lineLock);
+
     if (m_outFile.is_open())
     {
         m_outFile.close();
@@ -93,67 +255,334 @@ void Logger::setFile(const char *filename)
     }
 }
 
-Logger::Line Logger::log(Logger::LogLevel level)
+void Logger::setRateLimit(uint32_t linesPerSecond)
+{
+    m_rateLimit = linesPerSecond;
+}
+
+void Logger::setAsync(bool enable, std::size_t ringSize)
+{
+    if (enable == m_async)
+    {
+        return;
+    }
+
+    if (enable)
+    {
+        // a power of two that holds at least one line and its padding
+        const auto minimum = std::max(ringSize, 2 * alignRecord(sizeof(Record) + MaxLine));
+        m_ringSize         = 1;
+        while (m_ringSize < minimum)
+        {
+            m_ringSize *= 2;
+        }
+
+        m_writerStop = false;
+        m_epoch++;
+        m_async = true;
+        m_writer = std::thread(&Logger::writerMain, this);
+    }
+    else
+    {
+        m_async      = false;
+        m_writerStop = true;
+        m_writer.join();
+        m_epoch++;
+
+        auto *ring = m_rings.exchange(nullptr);
+        while (ring)
+        {
+            auto *next = ring->next;
+            delete ring;
+            ring = next;
+        }
+    }
+}
+
+void Logger::flush()
+{
+    if (!m_async)
+    {
+        return;
+    }
+
+    for (auto *ring = m_rings.load(std::memory_order_acquire); ring; ring = ring->next)
+    {
+        const auto head = ring->head.load(std::memory_order_acquire);
+        while (ring->tail.load(std::memory_order_acquire) < head)
+        {
+            std::this_thread::sleep_for(IdleSleep);
+        }
+    }
+}
+
+uint64_t Logger::getDropped() const
+{
+    return m_dropped;
+}
+
+std::ostream &Logger::lineStream()
+{
+    return ::lineStream.stream;
+}
+
+Logger::Line Logger::log(Logger::LogLevel level, Site *site)
 {
     if (level > m_logLevel)
     {
         return Logger::Line(nullptr);
     }
 
-    std::time_t logtime = std::time(nullptr);
+    uint32_t suppressed = 0;
+    const auto limit    = m_rateLimit.load(std::memory_order_relaxed);
+    if (site && limit)
+    {
+        // the first line of a new second resets the counter and reports
+        // what was suppressed in the previous one
+        const auto now = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        auto window    = site->window.load(std::memory_order_relaxed);
+        if (window != now && site->window.compare_exchange_strong(window, now))
+        {
+            suppressed = site->suppressed.exchange(0);
+            site->count.store(0);
+        }
+
+        if (site->count.fetch_add(1) >= limit)
+        {
+            site->suppressed.fetch_add(1);
+            return Logger::Line(nullptr);
+        }
+    }
+
+    return Logger::Line(this, level, suppressed);
+}
+
+void Logger::commit(uint8_t level, std::time_t time, const char *text, std::size_t length, bool flush)
+{
+    if (!m_async)
+    {
+        std::lock_guard<std::mutex> lock(m_lineLock);
+        output(level, time, text, length, flush);
+        return;
+    }
+
+    auto *ring = threadRing();
+    if (!ring)
+    {
+        m_dropped++;
+        return;
+    }
+
+    const auto size    = alignRecord(sizeof(Record) + length);
+    const auto head    = ring->head.load(std::memory_order_relaxed);
+    const auto tail    = ring->tail.load(std::memory_order_acquire);
+    const auto offset  = head & (ring->size - 1);
+    const auto padding = (offset + size > ring->size) ? ring->size - offset : 0;
+    if (padding + size > ring->size - (head - tail))
+    {
+        m_dropped++;
+        return;
+    }
+
+    if (padding)
+    {
+        // the padding may be shorter than a record, only size and length are written
+        const uint32_t pad[2] = {static_cast<uint32_t>(padding), PaddingRecord};
+        std::memcpy(&ring->data[offset], pad, sizeof(pad));
+    }
+
+    Record record;
+    record.size   = static_cast<uint32_t>(size);
+    record.length = static_cast<uint32_t>(length);
+    record.time   = static_cast<int64_t>(time);
+    record.level  = level;
+    record.flush  = flush;
+
+    char *target = &ring->data[(head + padding) & (ring->size - 1)];
+    std::memcpy(target, &record, sizeof(record));
+    std::memcpy(target + sizeof(record), text, length);
+    ring->head.store(head + padding + size, std::memory_order_release);
+}
+
+void Logger::output(uint8_t level, std::time_t time, const char *text, std::size_t length, bool flush)
+{
+    char timestamp[32];
     std::tm tm;
 #ifdef _WIN32
-    localtime_s(&tm, &logtime);
+    localtime_s(&tm, &time);
 #else
-    localtime_r(&logtime, &tm);
+    localtime_r(&time, &tm);
 #endif
-
-    char timestamp[32];
     const auto s = std::strftime(timestamp, sizeof(timestamp), LoggerDateTimeFormat, &tm);
 
-    Logger::Line line(this);
     try
     {
-        if (s)
+        if (level != LOG_NONE)
         {
-            line << timestamp;
+            if (s)
+            {
+                std::cout << timestamp;
+            }
+            std::cout << levelTag(level);
         }
-        switch (level)
+        std::cout.write(text, length);
+        if (flush)
         {
-            case LOG_INFO:
-                line << "INFO: ";
-                break;
-            case LOG_DEBUG:
-                line << "DEBUG: ";
-                break;
-            case LOG_WARN:
-                line << "WARN: ";
-                break;
-            case LOG_ERROR:
-                line << "ERROR: ";
-                break;
-            default:
-                break;
+            std::cout.flush();
+        }
+
+        if (m_outFile.is_open())
+        {
+            if (level != LOG_NONE)
+            {
+                if (s)
+                {
+                    m_outFile << timestamp;
+                }
+                m_outFile << levelTag(level);
+            }
+            m_outFile.write(text, length);
+            if (flush)
+            {
+                m_outFile.flush();
+            }
         }
     }
     catch (...)
     {
     }
+}
+
+Logger::Ring *Logger::threadRing()
+{
+    if (currentRing.ring && currentRing.owner == &m_epoch && currentRing.epoch == m_epoch)
+    {
+        return static_cast<Ring *>(currentRing.ring);
+    }
+
+    // take over the ring of a thread that exited or add a new one
+    Ring *ring = m_rings.load(std::memory_order_acquire);
+    for (; ring; ring = ring->next)
+    {
+        bool owned = false;
+        if (ring->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+        {
+            break;
+        }
+    }
 
-    return line;
+    if (!ring)
+    {
+        try
+        {
+            ring = new Ring(m_ringSize);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+
+        ring->next = m_rings.load(std::memory_order_acquire);
+        while (!m_rings.compare_exchange_weak(ring->next, ring, std::memory_order_release, std::memory_order_acquire))
+        {
+        }
+    }
+
+    currentRing.ring  = ring;
+    currentRing.owned = &ring->owned;
+    currentRing.epoch = m_epoch;
+    currentRing.owner = &m_epoch;
+    return ring;
 }
 
-Logger::Line::Line(Logger *logger) :
-    m_logger {logger}
+bool Logger::drain(Ring *ring)
 {
+    auto tail       = ring->tail.load(std::memory_order_relaxed);
+    const auto head = ring->head.load(std::memory_order_acquire);
+    if (tail == head)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lineLock);
+    while (tail != head)
+    {
+        const char *data = &ring->data[tail & (ring->size - 1)];
+        uint32_t prefix[2];
+        std::memcpy(prefix, data, sizeof(prefix));
+        if (prefix[1] != PaddingRecord)
+        {
+            Record record;
+            std::memcpy(&record, data, sizeof(record));
+            output(record.level, static_cast<std::time_t>(record.time), data + sizeof(record), record.length, record.flush);
+        }
+        tail += prefix[0];
+    }
+    std::cout.flush();
+    if (m_outFile.is_open())
+    {
+        m_outFile.flush();
+    }
+
+    ring->tail.store(tail, std::memory_order_release);
+    return true;
+}
+
+void Logger::writerMain()
+{
+    for (;;)
+    {
+        const bool stop = m_writerStop;
+
+        bool written = false;
+        for (auto *ring = m_rings.load(std::memory_order_acquire); ring; ring = ring->next)
+        {
+            written = drain(ring) || written;
+        }
+
+        const uint64_t dropped = m_dropped;
+        if (dropped != m_droppedReported)
+        {
+            std::lock_guard<std::mutex> lock(m_lineLock);
+            std::cout << levelTag(LOG_WARN) << (dropped - m_droppedReported) << " log lines dropped" << std::endl;
+            m_droppedReported = dropped;
+        }
+
+        if (!written)
+        {
+            if (stop)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(IdleSleep);
+        }
+    }
+}
+
+Logger::Line::Line(Logger *logger, uint8_t level, uint32_t suppressed) :
+    m_logger {logger},
+    m_level {level},
+    m_flush {false}
+{
+    if (m_logger && lineStreamDestroyed)
+    {
+        m_logger = nullptr;
+    }
     if (m_logger)
     {
-        m_logger->m_lineLock.lock();
+        ::lineStream.buffer.reset();
+        ::lineStream.stream.clear();
+        if (suppressed)
+        {
+            ::lineStream.stream << "(" << suppressed << " similar lines suppressed) ";
+        }
     }
 }
 
 Logger::Line::Line(Line &&ref) :
-    m_logger {ref.m_logger}
+    m_logger {ref.m_logger},
+    m_level {ref.m_level},
+    m_flush {ref.m_flush}
 {
     ref.m_logger = nullptr;
 }
@@ -165,11 +594,11 @@ Logger::Line::~Line()
         try
         {
             *this << "\n";
+            m_logger->commit(m_level, std::time(nullptr), ::lineStream.buffer.data(), ::lineStream.buffer.length(), m_flush);
         }
         catch (...)
         {
         }
-        m_logger->m_lineLock.unlock();
     }
 }
 
@@ -177,11 +606,8 @@ Logger::Line &Logger::Line::operator<<(EndLine)
 {
     if (m_logger)
     {
-        std::cout << std::endl;
-        if (m_logger->m_outFile.is_open())
-        {
-            m_logger->m_outFile << std::endl;
-        }
+        ::lineStream.stream << '\n';
+        m_flush = true;
     }
     return *this;
 }
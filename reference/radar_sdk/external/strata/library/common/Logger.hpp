@@ -9,20 +9,38 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <thread>
 
 const char LoggerDateTimeFormat[] = "[%Y-%m-%d %H:%M:%S] ";
 const char LoggerFileName[]       = "";
 
 
-#define LOG(X)           LoggerInstance.log(Logger::LOG_##X)
-#define LOG_LEVEL(X)     LoggerInstance.setLevel(Logger::LOG_##X)
-#define LOG_FILE_OPEN(F) LoggerInstance.setFile(F)
-#define LOG_FILE_CLOSE() LoggerInstance.setFile(nullptr)
+// Messages above this level are removed at compile time (4 = LOG_DEBUG)
+#ifndef LOG_LEVEL_COMPILED
+#define LOG_LEVEL_COMPILED 4
+#endif
+
+// State of the rate limit of the call site of a LOG() statement
+#define LOG_SITE() ([]() -> Logger::Site & { static Logger::Site site; return site; }())
+
+// The operands of << are not evaluated if the level is removed at compile time
+#define LOG(X)                                                    \
+    (Logger::LOG_##X > LOG_LEVEL_COMPILED) ? static_cast<void>(0) \
+                                           : Logger::Voidify() & LoggerInstance.log(Logger::LOG_##X, &LOG_SITE())
+#define LOG_LEVEL(X)      LoggerInstance.setLevel(Logger::LOG_##X)
+#define LOG_FILE_OPEN(F)  LoggerInstance.setFile(F)
+#define LOG_FILE_CLOSE()  LoggerInstance.setFile(nullptr)
+#define LOG_ASYNC(enable) LoggerInstance.setAsync(enable)
+#define LOG_RATE_LIMIT(n) LoggerInstance.setRateLimit(n)
 #define LOG_BUFFER(X, buf, count)                                                                    \
+    if (Logger::LOG_##X <= LOG_LEVEL_COMPILED)                                                       \
     {                                                                                                \
         auto L = LoggerInstance.log(Logger::LOG_##X);                                                \
         L << "buffer \"" << #buf << "\"";                                                            \
@@ -48,12 +66,24 @@ void tic();
 void toc();
 
 
+/**
+ * @brief Logger writing to std::cout and optionally to a file
+ *
+ * A line is collected in a buffer of the calling thread and written when
+ * the statement ends. In asynchronous mode (setAsync) the line is only
+ * copied into a lock-free ring buffer of the calling thread; the time stamp
+ * is formatted and the line is written by a background thread. If a ring is
+ * full, the line is dropped and counted, so a data thread never waits for
+ * the output.
+ */
 class Logger
 {
+    struct Ring;
+
     class Line
     {
     public:
-        Line(Logger *logger);
+        Line(Logger *logger, uint8_t level = 0, uint32_t suppressed = 0);
         Line(Line &&ref);
         ~Line();
 
@@ -76,6 +106,8 @@ class Logger
 
     private:
         Logger *m_logger;
+        uint8_t m_level;
+        bool m_flush;
     };
 
 public:
@@ -88,6 +120,25 @@ public:
         LOG_DEBUG = 4
     };
 
+    /**
+     * @brief Rate limit state of a call site, see setRateLimit
+     */
+    struct Site
+    {
+        std::atomic<uint32_t> window {0};
+        std::atomic<uint32_t> count {0};
+        std::atomic<uint32_t> suppressed {0};
+    };
+
+    /**
+     * @brief Turns the line of LOG() into void, so both branches of its ?: match
+     */
+    struct Voidify
+    {
+        void operator&(const Line &)
+        {}
+    };
+
     Logger(LogLevel level, const char *filename = nullptr);
     ~Logger();
 
@@ -100,14 +151,59 @@ public:
     void setLevel(LogLevel level);
     void setFile(const char *filename);
 
-    Line log(LogLevel level);
+    /**
+     * @brief Limits the lines per second and call site, 0 for no limit (default)
+     *
+     * Suppressed lines are counted and reported with the next line of the site.
+     */
+    void setRateLimit(uint32_t linesPerSecond);
+
+    /**
+     * @brief Switches between asynchronous and synchronous output
+     *
+     * Call it while no other thread logs. Disabling writes all pending lines.
+     *
+     * @param ringSize size of the ring buffer per thread in bytes
+     */
+    void setAsync(bool enable, std::size_t ringSize = 64 * 1024);
+
+    /**
+     * @brief Waits until the lines logged so far are written
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of lines dropped because a ring buffer was full
+     */
+    uint64_t getDropped() const;
+
+    Line log(LogLevel level, Site *site = nullptr);
+
+    // stream of the line being built on the calling thread
+    static std::ostream &lineStream();
 
 protected:
     std::mutex m_lineLock;
 
 private:
+    void commit(uint8_t level, std::time_t time, const char *text, std::size_t length, bool flush);
+    void output(uint8_t level, std::time_t time, const char *text, std::size_t length, bool flush);
+    Ring *threadRing();
+    bool drain(Ring *ring);
+    void writerMain();
+
     LogLevel m_logLevel;
     std::ofstream m_outFile;
+    std::atomic<uint32_t> m_rateLimit;
+
+    std::atomic<bool> m_async;
+    std::atomic<uint32_t> m_epoch;
+    std::size_t m_ringSize;
+    std::atomic<Ring *> m_rings;
+    std::thread m_writer;
+    std::atomic<bool> m_writerStop;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_droppedReported;
 };
 
 #ifdef NDEBUG
@@ -126,11 +222,7 @@ Logger::Line &Logger::Line::operator<<(const T &t)
     {
         try
         {
-            std::cout << t;
-            if (m_logger->m_outFile.is_open())
-            {
-                m_logger->m_outFile << t;
-            }
+            Logger::lineStream() << t;
         }
         catch (...)
         {
@@ -144,11 +236,7 @@ Logger::Line &Logger::Line::write(const T *t, std::size_t count)
 {
     if (m_logger)
     {
-        std::cout.write(t, count);
-        if (m_logger->m_outFile.is_open())
-        {
-            m_logger->m_outFile.write(t, count);
-        }
+        Logger::lineStream().write(t, count);
     }
     return *this;
 }
@@ -0,0 +1,278 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "Packed12.hpp"
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PACKED12_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+    #if defined(__GNUC__) || defined(__clang__)
+        // the kernels are compiled for their instruction set independent of the compiler flags
+        #define PACKED12_TARGET(isa) __attribute__((target(isa)))
+    #else
+        #define PACKED12_TARGET(isa)
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define PACKED12_NEON
+    #include <arm_neon.h>
+#endif
+
+
+namespace
+{
+    using Unpack16Function    = void (*)(const uint8_t *, size_t, uint16_t *);
+    using UnpackFloatFunction = void (*)(const uint8_t *, size_t, float *, float, float);
+
+    struct Implementation
+    {
+        const char *name;
+        Unpack16Function unpack16;
+        UnpackFloatFunction unpackFloat;
+    };
+
+    // All uint16_t kernels process the data from the end to the beginning,
+    // so that they also work in place, when dest is the beginning of the packed data.
+
+    void unpackScalar(const uint8_t *src, size_t pairs, uint16_t *dest)
+    {
+        unpackPacked12<const uint8_t *, uint16_t *>(src, src + 3 * pairs, dest);
+    }
+
+    void unpackScalar(const uint8_t *src, size_t pairs, float *dest, float scale, float offset)
+    {
+        for (size_t i = 0; i < pairs; i++)
+        {
+            const uint8_t b0 = src[3 * i + 0];
+            const uint8_t b1 = src[3 * i + 1];
+            const uint8_t b2 = src[3 * i + 2];
+            *dest++          = static_cast<float>((b0 << 4) | (b1 >> 4)) * scale + offset;
+            *dest++          = static_cast<float>(((b1 & 0x0F) << 8) | b2) * scale + offset;
+        }
+    }
+
+#ifdef PACKED12_X86
+    // Number of blocks of (blockPairs) pairs which can be read with (loadSize) byte loads
+    // without reading beyond the end of the data.
+    size_t vectorBlocks(size_t pairs, size_t blockPairs, size_t loadSize)
+    {
+        const auto bytes      = 3 * pairs;
+        const auto blockBytes = 3 * blockPairs;
+        return (bytes < loadSize) ? 0 : (bytes - loadSize) / blockBytes + 1;
+    }
+
+    // Moves the 3 bytes of each pair into two 16 bit lanes, the first sample is in the upper 12 bits
+    // of the even lanes, the second sample in the lower 12 bits of the odd lanes.
+    PACKED12_TARGET("ssse3")
+    __m128i unpackBlockSsse3(const uint8_t *src)
+    {
+        const auto shuffle  = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const auto maskEven = _mm_setr_epi16(-1, 0, -1, 0, -1, 0, -1, 0);
+        const auto maskOdd  = _mm_setr_epi16(0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF);
+
+        const auto words = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), shuffle);
+        return _mm_or_si128(_mm_and_si128(_mm_srli_epi16(words, 4), maskEven), _mm_and_si128(words, maskOdd));
+    }
+
+    PACKED12_TARGET("ssse3")
+    void unpackSsse3(const uint8_t *src, size_t pairs, uint16_t *dest)
+    {
+        const auto blocks = vectorBlocks(pairs, 4, 16);
+        unpackScalar(src + 12 * blocks, pairs - 4 * blocks, dest + 8 * blocks);
+
+        for (auto i = blocks; i-- > 0;)
+        {
+            const auto samples = unpackBlockSsse3(src + 12 * i);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + 8 * i), samples);
+        }
+    }
+
+    PACKED12_TARGET("ssse3")
+    void unpackSsse3(const uint8_t *src, size_t pairs, float *dest, float scale, float offset)
+    {
+        const auto blocks  = vectorBlocks(pairs, 4, 16);
+        const auto zero    = _mm_setzero_si128();
+        const auto vScale  = _mm_set1_ps(scale);
+        const auto vOffset = _mm_set1_ps(offset);
+
+        for (size_t i = 0; i < blocks; i++)
+        {
+            const auto samples = unpackBlockSsse3(src + 12 * i);
+            const auto low     = _mm_cvtepi32_ps(_mm_unpacklo_epi16(samples, zero));
+            const auto high    = _mm_cvtepi32_ps(_mm_unpackhi_epi16(samples, zero));
+            _mm_storeu_ps(dest + 8 * i, _mm_add_ps(_mm_mul_ps(low, vScale), vOffset));
+            _mm_storeu_ps(dest + 8 * i + 4, _mm_add_ps(_mm_mul_ps(high, vScale), vOffset));
+        }
+
+        unpackScalar(src + 12 * blocks, pairs - 4 * blocks, dest + 8 * blocks, scale, offset);
+    }
+
+    // Same as unpackBlockSsse3(), with the second half of the samples from the following 12 bytes
+    PACKED12_TARGET("avx2")
+    __m256i unpackBlockAvx2(const uint8_t *src)
+    {
+        const auto shuffle  = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                               1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        const auto maskEven = _mm256_setr_epi16(-1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0, -1, 0);
+        const auto maskOdd  = _mm256_setr_epi16(0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF, 0, 0x0FFF);
+
+        // one load, the upper lane then starts at byte 12
+        const auto spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+        const auto bytes  = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src)), spread);
+        const auto words  = _mm256_shuffle_epi8(bytes, shuffle);
+        return _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(words, 4), maskEven), _mm256_and_si256(words, maskOdd));
+    }
+
+    PACKED12_TARGET("avx2")
+    void unpackAvx2(const uint8_t *src, size_t pairs, uint16_t *dest)
+    {
+        const auto blocks = vectorBlocks(pairs, 8, 32);
+        unpackScalar(src + 24 * blocks, pairs - 8 * blocks, dest + 16 * blocks);
+
+        for (auto i = blocks; i-- > 0;)
+        {
+            const auto samples = unpackBlockAvx2(src + 24 * i);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + 16 * i), samples);
+        }
+    }
+
+    PACKED12_TARGET("avx2")
+    void unpackAvx2(const uint8_t *src, size_t pairs, float *dest, float scale, float offset)
+    {
+        const auto blocks  = vectorBlocks(pairs, 8, 32);
+        const auto vScale  = _mm256_set1_ps(scale);
+        const auto vOffset = _mm256_set1_ps(offset);
+
+        for (size_t i = 0; i < blocks; i++)
+        {
+            const auto samples = unpackBlockAvx2(src + 24 * i);
+            const auto low     = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(samples)));
+            const auto high    = _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(samples, 1)));
+            _mm256_storeu_ps(dest + 16 * i, _mm256_add_ps(_mm256_mul_ps(low, vScale), vOffset));
+            _mm256_storeu_ps(dest + 16 * i + 8, _mm256_add_ps(_mm256_mul_ps(high, vScale), vOffset));
+        }
+
+        unpackScalar(src + 24 * blocks, pairs - 8 * blocks, dest + 16 * blocks, scale, offset);
+    }
+
+    bool cpuSupports(bool &ssse3, bool &avx2)
+    {
+    #ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        const auto maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        ssse3            = (info[2] & (1 << 9)) != 0;
+        const bool avxOs = ((info[2] & (1 << 27)) != 0) && ((_xgetbv(0) & 0x6) == 0x6);
+
+        avx2 = false;
+        if (avxOs && (maxLeaf >= 7))
+        {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+    #else
+        __builtin_cpu_init();
+        ssse3 = __builtin_cpu_supports("ssse3");
+        avx2  = __builtin_cpu_supports("avx2");
+    #endif
+        return ssse3 || avx2;
+    }
+#endif
+
+#ifdef PACKED12_NEON
+    // Splits 8 pairs into the first and second samples
+    uint16x8x2_t unpackBlockNeon(const uint8_t *src)
+    {
+        const auto bytes = vld3_u8(src);
+        uint16x8x2_t samples;
+        samples.val[0] = vorrq_u16(vshll_n_u8(bytes.val[0], 4), vmovl_u8(vshr_n_u8(bytes.val[1], 4)));
+        samples.val[1] = vorrq_u16(vshll_n_u8(vand_u8(bytes.val[1], vdup_n_u8(0x0F)), 8), vmovl_u8(bytes.val[2]));
+        return samples;
+    }
+
+    void unpackNeon(const uint8_t *src, size_t pairs, uint16_t *dest)
+    {
+        const auto blocks = pairs / 8;
+        unpackScalar(src + 24 * blocks, pairs - 8 * blocks, dest + 16 * blocks);
+
+        for (auto i = blocks; i-- > 0;)
+        {
+            vst2q_u16(dest + 16 * i, unpackBlockNeon(src + 24 * i));
+        }
+    }
+
+    void unpackNeon(const uint8_t *src, size_t pairs, float *dest, float scale, float offset)
+    {
+        const auto blocks  = pairs / 8;
+        const auto vOffset = vdupq_n_f32(offset);
+
+        for (size_t i = 0; i < blocks; i++)
+        {
+            const auto samples = unpackBlockNeon(src + 24 * i);
+
+            // vst2q interleaves the first and second samples again
+            float32x4x2_t low, high;
+            low.val[0]  = vmlaq_n_f32(vOffset, vcvtq_f32_u32(vmovl_u16(vget_low_u16(samples.val[0]))), scale);
+            low.val[1]  = vmlaq_n_f32(vOffset, vcvtq_f32_u32(vmovl_u16(vget_low_u16(samples.val[1]))), scale);
+            high.val[0] = vmlaq_n_f32(vOffset, vcvtq_f32_u32(vmovl_u16(vget_high_u16(samples.val[0]))), scale);
+            high.val[1] = vmlaq_n_f32(vOffset, vcvtq_f32_u32(vmovl_u16(vget_high_u16(samples.val[1]))), scale);
+            vst2q_f32(dest + 16 * i, low);
+            vst2q_f32(dest + 16 * i + 8, high);
+        }
+
+        unpackScalar(src + 24 * blocks, pairs - 8 * blocks, dest + 16 * blocks, scale, offset);
+    }
+#endif
+
+    Implementation selectImplementation()
+    {
+#ifdef PACKED12_X86
+        bool ssse3, avx2;
+        if (cpuSupports(ssse3, avx2))
+        {
+            if (avx2)
+            {
+                return {"avx2", unpackAvx2, unpackAvx2};
+            }
+            return {"ssse3", unpackSsse3, unpackSsse3};
+        }
+#elif defined(PACKED12_NEON)
+        return {"neon", unpackNeon, unpackNeon};
+#endif
+        return {"scalar", unpackScalar, unpackScalar};
+    }
+
+    const Implementation &implementation()
+    {
+        static const Implementation selected = selectImplementation();
+        return selected;
+    }
+}
+
+
+void unpackPacked12(const uint8_t *first, const uint8_t *last, uint16_t *dest)
+{
+    implementation().unpack16(first, static_cast<size_t>(last - first) / 3, dest);
+}
+
+void unpackPacked12(const uint8_t *first, const uint8_t *last, float *dest, float scale, float offset)
+{
+    implementation().unpackFloat(first, static_cast<size_t>(last - first) / 3, dest, scale, offset);
+}
+
+const char *getPacked12Implementation()
+{
+    return implementation().name;
+}
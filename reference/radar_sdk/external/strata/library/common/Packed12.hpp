@@ -35,6 +35,37 @@ inline void unpackPacked12(InputIt first, InputIt last, OutputIt dest)
 }
 
 
+/**
+ * Unpack Packed12 data from a uint8_t buffer to a uint16_t buffer.
+ * This uses the fastest implementation the CPU supports (AVX2, SSSE3, NEON or scalar), selected at runtime.
+ * The destination buffer has to be allocated for ((last - first) / 3 * 2) elements,
+ * it may start at the same address as the packed data to unpack it in place.
+ *
+ * @param first beginning of the packed data
+ * @param last end of the packed data
+ * @param dest beginning of unpacked data
+ */
+void unpackPacked12(const uint8_t *first, const uint8_t *last, uint16_t *dest);
+
+/**
+ * Unpack Packed12 data from a uint8_t buffer and convert each sample to (sample * scale + offset).
+ * The destination buffer has to be allocated for ((last - first) / 3 * 2) elements and may only overlap the packed data
+ * if the packed data is located at the end of the destination buffer (conversion runs from the beginning to the end).
+ *
+ * @param first beginning of the packed data
+ * @param last end of the packed data
+ * @param dest beginning of converted data
+ * @param scale factor applied to each sample
+ * @param offset value added to each scaled sample
+ */
+void unpackPacked12(const uint8_t *first, const uint8_t *last, float *dest, float scale, float offset);
+
+/**
+ * @return name of the implementation used by the unpackPacked12() functions above
+ */
+const char *getPacked12Implementation();
+
+
 /**
  * Unpack Packed12 data within a buffer.
  * The buffer has to be allocated for (last - first) elements!
@@ -10,6 +10,12 @@
 #include "Profiler.hpp"
 #include "Logger.hpp"
 
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 
 StrataProfiler::StrataProfiler() :
     m_toc {}
@@ -42,3 +48,151 @@ void StrataProfiler::logElapsed()
     const auto toc = getElapsed();
     LOG(DEBUG) << "Profiled duration = " << std::dec << toc << "us";
 }
+
+
+namespace
+{
+    struct TraceEvent
+    {
+        const char *name;
+        StrataTrace::Clock::time_point begin;
+        StrataTrace::Clock::duration duration;  // negative for counters
+        int64_t value;
+        std::size_t thread;
+    };
+
+    struct TraceBuffer
+    {
+        std::mutex lock;
+        std::vector<TraceEvent> events;
+        std::size_t next  = 0;
+        bool wrapped      = false;
+        StrataTrace::Clock::time_point origin;
+
+        void add(const TraceEvent &event)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (events.empty())
+            {
+                return;
+            }
+            events[next] = event;
+            if (++next == events.size())
+            {
+                next    = 0;
+                wrapped = true;
+            }
+        }
+    };
+
+    TraceBuffer &traceBuffer()
+    {
+        static TraceBuffer buffer;
+        return buffer;
+    }
+
+    std::size_t currentThread()
+    {
+        // Chrome only needs a stable number per thread
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) & 0xFFFFFF;
+    }
+
+    void writeName(std::ostream &stream, const char *name)
+    {
+        stream << '"';
+        for (; *name; name++)
+        {
+            if ((*name == '"') || (*name == '\\'))
+            {
+                stream << '\\';
+            }
+            stream << *name;
+        }
+        stream << '"';
+    }
+}
+
+
+constexpr std::size_t StrataTrace::defaultCapacity;
+std::atomic<bool> StrataTrace::s_enabled {false};
+
+void StrataTrace::enable(std::size_t capacity)
+{
+    auto &buffer = traceBuffer();
+    {
+        std::lock_guard<std::mutex> guard(buffer.lock);
+        buffer.events.assign(capacity, TraceEvent {});
+        buffer.next    = 0;
+        buffer.wrapped = false;
+        buffer.origin  = Clock::now();
+    }
+    s_enabled = (capacity > 0);
+}
+
+void StrataTrace::disable()
+{
+    s_enabled = false;
+}
+
+void StrataTrace::clear()
+{
+    auto &buffer = traceBuffer();
+    std::lock_guard<std::mutex> guard(buffer.lock);
+    buffer.next    = 0;
+    buffer.wrapped = false;
+}
+
+void StrataTrace::addScope(const char *name, Clock::time_point begin, Clock::time_point end)
+{
+    traceBuffer().add({name, begin, end - begin, 0, currentThread()});
+}
+
+void StrataTrace::addCounter(const char *name, int64_t value)
+{
+    traceBuffer().add({name, Clock::now(), Clock::duration(-1), value, currentThread()});
+}
+
+void StrataTrace::exportChromeJson(std::ostream &stream)
+{
+    using Micro  = std::chrono::duration<double, std::micro>;
+    auto &buffer = traceBuffer();
+    std::lock_guard<std::mutex> guard(buffer.lock);
+
+    // oldest events first
+    const std::size_t first = buffer.wrapped ? buffer.next : 0;
+    const std::size_t count = buffer.wrapped ? buffer.events.size() : buffer.next;
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const auto &event = buffer.events[(first + i) % buffer.events.size()];
+        const auto ts     = Micro(event.begin - buffer.origin).count();
+
+        stream << (i ? ",\n" : "\n") << "{\"name\":";
+        writeName(stream, event.name);
+        if (event.duration.count() < 0)
+        {
+            stream << ",\"ph\":\"C\",\"ts\":" << ts << ",\"pid\":1,\"tid\":" << event.thread
+                   << ",\"args\":{\"value\":" << event.value << "}}";
+        }
+        else
+        {
+            stream << ",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << Micro(event.duration).count()
+                   << ",\"pid\":1,\"tid\":" << event.thread << "}";
+        }
+    }
+    stream << "\n]}\n";
+}
+
+bool StrataTrace::exportChromeJson(const char *filename)
+{
+    std::ofstream file(filename);
+    if (!file)
+    {
+        LOG(ERROR) << "StrataTrace - could not open " << filename;
+        return false;
+    }
+
+    exportChromeJson(file);
+    return static_cast<bool>(file);
+}
@@ -9,7 +9,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
 
 
 class StrataProfiler
@@ -44,3 +48,123 @@ public:
 private:
     std::chrono::steady_clock::time_point m_tic, m_toc;
 };
+
+
+/**
+ * @brief Process wide trace of named scopes and counters
+ *
+ * The trace is recorded into a ring buffer, so only the most recent events are kept.
+ * It can be exported in the Chrome trace event format, which can be opened with
+ * chrome://tracing or https://ui.perfetto.dev
+ *
+ * While tracing is disabled, a scope or counter costs a single relaxed atomic load.
+ * Defining STRATA_TRACE_DISABLE removes the instrumentation completely.
+ */
+class StrataTrace
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t defaultCapacity = 65536;
+
+    /**
+     * @brief Start recording, discarding previously recorded events
+     * @param capacity maximum number of events kept in the ring buffer
+     */
+    static void enable(std::size_t capacity = defaultCapacity);
+
+    /**
+     * @brief Stop recording, the recorded events are kept for export
+     */
+    static void disable();
+
+    static inline bool isEnabled()
+    {
+        return s_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Discard all recorded events
+     */
+    static void clear();
+
+    /**
+     * @brief Record a completed scope
+     * @param name has to be a string with static storage duration
+     */
+    static void addScope(const char *name, Clock::time_point begin, Clock::time_point end);
+
+    /**
+     * @brief Record the current value of a counter
+     * @param name has to be a string with static storage duration
+     */
+    static void addCounter(const char *name, int64_t value);
+
+    /**
+     * @brief Write the recorded events in the Chrome trace event format (JSON)
+     */
+    static void exportChromeJson(std::ostream &stream);
+
+    /**
+     * @brief Write the recorded events in the Chrome trace event format to a file
+     * @return false if the file could not be written
+     */
+    static bool exportChromeJson(const char *filename);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+
+/**
+ * @brief Records the lifetime of the object as a named scope, if tracing is enabled on construction
+ */
+class StrataTraceScope
+{
+public:
+    explicit StrataTraceScope(const char *name) :
+        m_name {StrataTrace::isEnabled() ? name : nullptr}
+    {
+        if (m_name)
+        {
+            m_begin = StrataTrace::Clock::now();
+        }
+    }
+
+    ~StrataTraceScope()
+    {
+        if (m_name)
+        {
+            StrataTrace::addScope(m_name, m_begin, StrataTrace::Clock::now());
+        }
+    }
+
+    StrataTraceScope(const StrataTraceScope &) = delete;
+    StrataTraceScope &operator=(const StrataTraceScope &) = delete;
+
+private:
+    const char *m_name;
+    StrataTrace::Clock::time_point m_begin;
+};
+
+
+#define STRATA_TRACE_CONCAT_IMPL(a, b) a##b
+#define STRATA_TRACE_CONCAT(a, b)      STRATA_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef STRATA_TRACE_DISABLE
+#define STRATA_TRACE_SCOPE(name) StrataTraceScope STRATA_TRACE_CONCAT(strataTraceScope, __LINE__)(name)
+#define STRATA_TRACE_COUNTER(name, value)                                \
+    do                                                                   \
+    {                                                                    \
+        if (StrataTrace::isEnabled())                                    \
+        {                                                                \
+            StrataTrace::addCounter(name, static_cast<int64_t>(value)); \
+        }                                                                \
+    } while (0)
+#else
+#define STRATA_TRACE_SCOPE(name)
+#define STRATA_TRACE_COUNTER(name, value) \
+    do                                    \
+    {                                     \
+    } while (0)
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "Threads.hpp"
+#include "Logger.hpp"
+
+#include <cerrno>
+#include <mutex>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/resource.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/syscall.h>
+    #endif
+#endif
+
+
+namespace
+{
+    std::mutex s_lock;
+    StrataThreads::Settings s_settings[StrataThreads::RoleCount];
+    std::string s_prefix {"strata"};
+
+    void setName(const std::string &name)
+    {
+#if defined(__linux__)
+        // names are limited to 16 bytes including the terminator
+        pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#elif defined(__APPLE__)
+        pthread_setname_np(name.c_str());
+#else
+        (void)name;
+#endif
+    }
+
+    void setAffinity(uint64_t affinity)
+    {
+#if defined(_WIN32)
+        if (!SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(affinity)))
+        {
+            LOG(WARN) << "StrataThreads::apply - SetThreadAffinityMask() failed: " << GetLastError();
+        }
+#elif defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (unsigned int cpu = 0; cpu < 64; cpu++)
+        {
+            if (affinity & (uint64_t(1) << cpu))
+            {
+                CPU_SET(cpu, &set);
+            }
+        }
+        const int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (ret != 0)
+        {
+            LOG(WARN) << "StrataThreads::apply - pthread_setaffinity_np() failed: " << ret;
+        }
+#else
+        (void)affinity;
+        LOG(DEBUG) << "StrataThreads::apply - CPU affinity is not supported on this platform";
+#endif
+    }
+
+    void setPriority(int priority, bool realtime)
+    {
+#if defined(_WIN32)
+        int value = THREAD_PRIORITY_NORMAL;
+        if (realtime)
+        {
+            value = THREAD_PRIORITY_TIME_CRITICAL;
+        }
+        else if (priority < 0)
+        {
+            value = (priority <= -10) ? THREAD_PRIORITY_HIGHEST : THREAD_PRIORITY_ABOVE_NORMAL;
+        }
+        else if (priority > 0)
+        {
+            value = (priority >= 10) ? THREAD_PRIORITY_LOWEST : THREAD_PRIORITY_BELOW_NORMAL;
+        }
+        if (!SetThreadPriority(GetCurrentThread(), value))
+        {
+            LOG(WARN) << "StrataThreads::apply - SetThreadPriority() failed: " << GetLastError();
+        }
+#else
+        if (realtime)
+        {
+            sched_param param {};
+            param.sched_priority = priority;
+            const int ret        = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (ret != 0)
+            {
+                // usually EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO
+                LOG(WARN) << "StrataThreads::apply - SCHED_FIFO priority " << priority << " failed: " << ret;
+            }
+        }
+        else if (priority != 0)
+        {
+    #ifdef __linux__
+            // on Linux the nice value is per thread
+            const auto id = static_cast<id_t>(::syscall(SYS_gettid));
+            if (::setpriority(PRIO_PROCESS, id, priority) != 0)
+            {
+                LOG(WARN) << "StrataThreads::apply - setpriority() failed: " << errno;
+            }
+    #else
+            LOG(DEBUG) << "StrataThreads::apply - thread nice values are not supported on this platform";
+    #endif
+        }
+#endif
+    }
+}
+
+
+void StrataThreads::setSettings(Role role, const Settings &settings)
+{
+    std::lock_guard<std::mutex> guard(s_lock);
+    s_settings[role] = settings;
+}
+
+StrataThreads::Settings StrataThreads::getSettings(Role role)
+{
+    std::lock_guard<std::mutex> guard(s_lock);
+    return s_settings[role];
+}
+
+void StrataThreads::setNamePrefix(const char *prefix)
+{
+    std::lock_guard<std::mutex> guard(s_lock);
+    s_prefix = prefix ? prefix : "";
+}
+
+std::string StrataThreads::getNamePrefix()
+{
+    std::lock_guard<std::mutex> guard(s_lock);
+    return s_prefix;
+}
+
+void StrataThreads::apply(Role role, const char *name)
+{
+    Settings settings;
+    std::string fullName;
+    {
+        std::lock_guard<std::mutex> guard(s_lock);
+        settings = s_settings[role];
+        fullName = s_prefix.empty() ? name : (s_prefix + "-" + name);
+    }
+
+    setName(fullName);
+    if (settings.affinity)
+    {
+        setAffinity(settings.affinity);
+    }
+    if (settings.realtime || settings.priority)
+    {
+        setPriority(settings.priority, settings.realtime);
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+
+/**
+ * @brief Process wide scheduling settings of the threads created by the library
+ *
+ * Every internal thread belongs to a role and calls StrataThreads::apply() when it starts,
+ * which sets its name, CPU affinity and priority from the settings of its role.
+ * Settings only affect threads started afterwards. The data threads of the bridges are
+ * started with each acquisition, so they pick up changes with the next start.
+ *
+ * Failing to apply a setting (e.g. missing permission for a real-time class) is logged
+ * and the thread continues with its previous scheduling.
+ */
+class StrataThreads
+{
+public:
+    enum Role : unsigned int
+    {
+        Data,         ///< threads reading from the bridges (USB, serial, Ethernet)
+        Forwarding,   ///< threads passing frames to listeners
+        Acquisition,  ///< threads reading frames from devices on behalf of the application
+        Processing,   ///< worker threads of processing pipelines
+        RoleCount
+    };
+
+    struct Settings
+    {
+        uint64_t affinity = 0;  ///< bit mask of the CPUs the thread may run on, 0 for all CPUs
+        int priority      = 0;  ///< real-time priority (Linux 1 to 99) if realtime is set, otherwise nice value (negative is higher)
+        bool realtime     = false;  ///< use a real-time scheduling class (SCHED_FIFO or TIME_CRITICAL on Windows)
+    };
+
+    static void setSettings(Role role, const Settings &settings);
+    static Settings getSettings(Role role);
+
+    /**
+     * @brief Set the prefix of the thread names, "strata" by default
+     *
+     * A thread is named "<prefix>-<name>", truncated to the 15 characters Linux allows.
+     */
+    static void setNamePrefix(const char *prefix);
+    static std::string getNamePrefix();
+
+    /**
+     * @brief Apply the settings of a role to the calling thread
+     * @param name short name of the thread, e.g. "usb"
+     */
+    static void apply(Role role, const char *name);
+};
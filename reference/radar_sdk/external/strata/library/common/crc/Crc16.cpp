@@ -45,11 +45,60 @@ static uint16_t crcTable[256] = {
     0xef1f, 0xff3e, 0xcf5d, 0xdf7c, 0xaf9b, 0xbfba, 0x8fd9, 0x9ff8,
     0x6e17, 0x7e36, 0x4e55, 0x5e74, 0x2e93, 0x3eb2, 0x0ed1, 0x1ef0  // clang-format
 };
+
+
+namespace
+{
+    /**
+     * Tables for slicing-by-8: crcSlices[k][x] is the CRC contribution of byte x
+     * followed by k zero bytes, with crcSlices[0] being crcTable.
+     * This way 8 bytes are processed with independent table lookups instead of
+     * a chain of 8 dependent ones.
+     */
+    struct SlicingTables
+    {
+        SlicingTables()
+        {
+            for (unsigned int x = 0; x < 256; x++)
+            {
+                crcSlices[0][x] = crcTable[x];
+            }
+            for (unsigned int k = 1; k < 8; k++)
+            {
+                for (unsigned int x = 0; x < 256; x++)
+                {
+                    const uint16_t prev = crcSlices[k - 1][x];
+                    crcSlices[k][x]     = static_cast<uint16_t>(prev << 8) ^ crcTable[prev >> 8];
+                }
+            }
+        }
+
+        uint16_t crcSlices[8][256];
+    };
+
+    // built on first use, so that it is also valid during static initialization of other units
+    const SlicingTables &getSlicingTables()
+    {
+        static const SlicingTables tables;
+        return tables;
+    }
+}
 #endif
 
 
 uint16_t Crc16CcittFalse(const uint8_t buf[], unsigned int len, uint16_t crc)
 {
+#ifdef CRC16_LUT
+    const auto &t = getSlicingTables().crcSlices;
+    while (len >= 8)
+    {
+        crc = t[7][buf[0] ^ (crc >> 8)] ^ t[6][buf[1] ^ (crc & 0xFF)] ^ t[5][buf[2]] ^ t[4][buf[3]] ^
+              t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+        buf += 8;
+        len -= 8;
+    }
+#endif
+
     while (len--)
     {
         const uint8_t x = (crc >> 8) ^ *buf++;
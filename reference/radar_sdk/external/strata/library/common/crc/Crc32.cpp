@@ -53,6 +53,39 @@ namespace
         0x4B8884B5, 0xBF247FA6, 0x567D8980, 0xA2D17293, 0x70629EDF, 0x84CE65CC, 0x6D9793EA, 0x993B68F9  // clang-format
     };
 
+    /**
+     * Tables for slicing-by-8 of Crc32Autosar: crcAutosarSlices[k][x] is the
+     * contribution of byte x followed by k zero bytes, with crcAutosarSlices[0]
+     * being crcAutosarTable.
+     */
+    struct AutosarSlicingTables
+    {
+        AutosarSlicingTables()
+        {
+            for (unsigned int x = 0; x < 256; x++)
+            {
+                crcAutosarSlices[0][x] = crcAutosarTable[x];
+            }
+            for (unsigned int k = 1; k < 8; k++)
+            {
+                for (unsigned int x = 0; x < 256; x++)
+                {
+                    const uint32_t prev    = crcAutosarSlices[k - 1][x];
+                    crcAutosarSlices[k][x] = (prev << 8) ^ crcAutosarTable[prev >> 24];
+                }
+            }
+        }
+
+        uint32_t crcAutosarSlices[8][256];
+    };
+
+    // built on first use, so that it is also valid during static initialization of other units
+    const AutosarSlicingTables &getAutosarSlicingTables()
+    {
+        static const AutosarSlicingTables tables;
+        return tables;
+    }
+
     template <typename ValueType>
     ValueType reflect(ValueType val)
     {
@@ -146,6 +179,15 @@ uint32_t Crc32Mpeg2(const uint16_t buf[], uint16_t len, unsigned int bits, uint3
 
 uint32_t Crc32Autosar(const uint8_t buf[], uint16_t len, uint32_t crc)
 {
+    const auto &t = getAutosarSlicingTables().crcAutosarSlices;
+    while (len >= 8)
+    {
+        crc = t[7][buf[0] ^ (crc >> 24)] ^ t[6][buf[1] ^ ((crc >> 16) & 0xFF)] ^ t[5][buf[2] ^ ((crc >> 8) & 0xFF)] ^ t[4][buf[3] ^ (crc & 0xFF)] ^
+              t[3][buf[4]] ^ t[2][buf[5]] ^ t[1][buf[6]] ^ t[0][buf[7]];
+        buf += 8;
+        len -= 8;
+    }
+
     while (len--)
     {
         uint8_t data = *buf++;
@@ -9,14 +9,16 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <type_traits>
 
 
 namespace endian
 {
     template <typename T>
-    inline typename std::enable_if<!std::is_integral<typename std::remove_reference<T>::type>::value || (sizeof(T) == 1), T>::type
+    inline typename std::enable_if<(!std::is_integral<typename std::remove_reference<T>::type>::value && !std::is_floating_point<typename std::remove_reference<T>::type>::value) || (sizeof(T) == 1), T>::type
     swap(T value)
     {
         return value;
@@ -26,30 +28,78 @@ namespace endian
     inline typename std::enable_if<std::is_integral<typename std::remove_reference<T>::type>::value && (sizeof(T) == 2), T>::type
     swap(T value)
     {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(value)));
+#else
         return static_cast<T>(
             (value << 8) |
             ((value >> 8) & 0xFF));
+#endif
     }
 
     template <typename T>
     inline typename std::enable_if<std::is_integral<typename std::remove_reference<T>::type>::value && (sizeof(T) == 4), T>::type
     swap(T value)
     {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(value)));
+#else
         return static_cast<T>(
             (value << 24) |
             ((value << 8) & 0x00FF0000) |
             ((value >> 8) & 0x0000FF00) |
             ((value >> 24) & 0x000000FF));
+#endif
+    }
+
+    template <typename T>
+    inline typename std::enable_if<std::is_integral<typename std::remove_reference<T>::type>::value && (sizeof(T) == 8), T>::type
+    swap(T value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(value)));
+#else
+        const auto low  = static_cast<uint32_t>(value);
+        const auto high = static_cast<uint32_t>(static_cast<uint64_t>(value) >> 32);
+        return static_cast<T>((static_cast<uint64_t>(swap(low)) << 32) | swap(high));
+#endif
     }
 
     template <typename T>
     inline typename std::enable_if<std::is_floating_point<typename std::remove_reference<T>::type>::value, T>::type
     swap(T value)
     {
-        // todo: add floating point endianness handling
+        // swap the object representation through an unsigned integer of the same size
+        using Raw = typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type;
+        static_assert(sizeof(Raw) == sizeof(T), "unsupported floating point size");
+
+        Raw raw;
+        std::memcpy(&raw, &value, sizeof(raw));
+        raw = swap(raw);
+        std::memcpy(&value, &raw, sizeof(value));
         return value;
     }
 
+    /**
+     * Contiguous arrays are swapped with an indexed loop, which compilers
+     * turn into vector byte shuffles (e.g. pshufb / vrev) for bulk data.
+     */
+    template <typename T>
+    inline void swap(const T *first, const T *last, T *dest)
+    {
+        const auto count = static_cast<std::size_t>(last - first);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            dest[i] = endian::swap(first[i]);
+        }
+    }
+
+    template <typename T>
+    inline void swap(T *first, T *last, T *dest)
+    {
+        endian::swap(const_cast<const T *>(first), const_cast<const T *>(last), dest);
+    }
+
     template <typename InputIt, typename OutputIt>
     inline void swap(InputIt first, InputIt last, OutputIt dest)
     {
@@ -0,0 +1,128 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include <components/exception/ENonvolatileMemory.hpp>
+#include <components/nonvolatileMemory/FlashProgrammer.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <future>
+
+
+FlashProgrammer::FlashProgrammer(NonvolatileMemory *memory, bool verify) :
+    m_memory {memory},
+    m_verify {verify}
+{
+}
+
+FlashProgrammer::Statistics FlashProgrammer::program(uint32_t address, uint32_t length, const uint8_t image[])
+{
+    const auto &config = m_memory->getConfig();
+    Statistics statistics;
+
+    if (!config.sectorSize)
+    {
+        // memories without sectors (e.g. EEPROMs) are written without erasing
+        programSector(address, length, image, false, statistics);
+        return statistics;
+    }
+
+    // sectors are aligned to physical addresses, which are shifted by the access offset
+    const uint32_t end = address + length;
+    while (address < end)
+    {
+        const uint32_t sectorOffset = (address + config.accessOffset) % config.sectorSize;
+        const uint32_t chunk        = std::min(config.sectorSize - sectorOffset, end - address);
+        programSector(address, chunk, image, (sectorOffset == 0) && (chunk == config.sectorSize), statistics);
+
+        address += chunk;
+        image += chunk;
+    }
+    return statistics;
+}
+
+FlashProgrammer::Statistics FlashProgrammer::program(const FlashImage &image)
+{
+    Statistics statistics;
+    for (const auto &segment : image)
+    {
+        const auto segmentStatistics = program(segment.address, static_cast<uint32_t>(segment.data.size()), segment.data.data());
+        statistics.sectorsUnchanged += segmentStatistics.sectorsUnchanged;
+        statistics.sectorsWritten += segmentStatistics.sectorsWritten;
+    }
+    return statistics;
+}
+
+void FlashProgrammer::programSector(uint32_t address, uint32_t length, const uint8_t image[], bool wholeSector, Statistics &statistics)
+{
+    m_buffer.resize(length);
+
+    m_memory->readRandom(address, length, m_buffer.data());
+    if (!std::memcmp(m_buffer.data(), image, length))
+    {
+        statistics.sectorsUnchanged++;
+        return;
+    }
+
+    if (wholeSector)
+    {
+        // a sector that is still erased from an earlier, interrupted run is only written
+        const bool erased = std::all_of(m_buffer.begin(), m_buffer.end(), [](uint8_t value) {
+            return value == 0xFF;
+        });
+        if (!erased)
+        {
+            m_memory->eraseAligned(address, length);
+        }
+        m_memory->writeErased(address, length, image);
+    }
+    else
+    {
+        // keeps the parts of the sector outside of the image
+        m_memory->writeRandom(address, length, image);
+    }
+    statistics.sectorsWritten++;
+
+    if (m_verify)
+    {
+        m_memory->readRandom(address, length, m_buffer.data());
+        if (std::memcmp(m_buffer.data(), image, length))
+        {
+            throw ENonvolatileMemory("FlashProgrammer - verification failed", address);
+        }
+    }
+}
+
+std::vector<std::exception_ptr> FlashProgrammer::programAll(const std::vector<Job> &jobs, bool verify)
+{
+    std::vector<std::future<void>> futures;
+    futures.reserve(jobs.size());
+    for (const auto &job : jobs)
+    {
+        futures.push_back(std::async(std::launch::async, [job, verify] {
+            FlashProgrammer(job.memory, verify).program(job.address, job.length, job.image);
+        }));
+    }
+
+    std::vector<std::exception_ptr> results;
+    results.reserve(futures.size());
+    for (auto &future : futures)
+    {
+        try
+        {
+            future.get();
+            results.emplace_back();
+        }
+        catch (...)
+        {
+            results.push_back(std::current_exception());
+        }
+    }
+    return results;
+}
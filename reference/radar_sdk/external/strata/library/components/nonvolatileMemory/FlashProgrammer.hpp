@@ -0,0 +1,75 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <Definitions.hpp>
+#include <components/FlashImage.hpp>
+#include <components/nonvolatileMemory/NonvolatileMemory.hpp>
+
+#include <exception>
+#include <vector>
+
+
+/**
+ * Programs images into non-volatile memories sector by sector
+ *
+ * Each sector is read first and only erased and written if its contents differ
+ * from the image, so updating a memory that already holds most of the image
+ * only costs the reads. Written sectors are read back and compared when
+ * verification is enabled. All reads use the largest transfers of the bridge.
+ *
+ * Memories of different boards are programmed concurrently by programAll(),
+ * since each board is accessed through its own bridge.
+ */
+class FlashProgrammer
+{
+public:
+    struct Statistics
+    {
+        uint32_t sectorsUnchanged = 0;  ///< sectors which already contained the image
+        uint32_t sectorsWritten   = 0;  ///< sectors which were erased (if needed) and written
+    };
+
+    struct Job
+    {
+        NonvolatileMemory *memory;
+        uint32_t address;
+        uint32_t length;
+        const uint8_t *image;
+    };
+
+    STRATA_API FlashProgrammer(NonvolatileMemory *memory, bool verify = true);
+
+    ///
+    /// Program an image at the given address
+    /// \details Parts of sectors outside of the image keep their contents.
+    ///          Throws ENonvolatileMemory if a written sector does not read back correctly.
+    ///
+    STRATA_API Statistics program(uint32_t address, uint32_t length, const uint8_t image[]);
+
+    ///
+    /// Program all segments of an image, e.g. read from a hex file
+    ///
+    STRATA_API Statistics program(const FlashImage &image);
+
+    ///
+    /// Program a list of jobs, each on its own thread
+    /// \details Jobs must not share a memory. The returned list holds the exception of each
+    ///          failed job and an empty pointer for each successful one, in the order of the jobs.
+    ///
+    STRATA_API static std::vector<std::exception_ptr> programAll(const std::vector<Job> &jobs, bool verify = true);
+
+private:
+    void programSector(uint32_t address, uint32_t length, const uint8_t image[], bool wholeSector, Statistics &statistics);
+
+    NonvolatileMemory *m_memory;
+    const bool m_verify;
+    std::vector<uint8_t> m_buffer;
+};
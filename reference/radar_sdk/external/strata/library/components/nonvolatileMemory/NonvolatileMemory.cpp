@@ -11,13 +11,62 @@
 #include <components/nonvolatileMemory/NonvolatileMemory.hpp>
 
 #include <common/Buffer.hpp>
+#include <common/crc/Crc32.hpp>
+#include <algorithm>
 #include <cstring>
+#include <fstream>
+
+
+namespace
+{
+    const char cacheFileMagic[8] = {'S', 'N', 'V', 'M', 'C', 'A', 'C', '1'};
+
+    uint32_t calculateCrc(const uint8_t *data, uint32_t length)
+    {
+        // Crc32Autosar takes 16 bit lengths, but can be continued
+        constexpr uint32_t maxChunk = 0x8000;
+
+        uint32_t crc = CRC32_AUTOSAR_SEED;
+        while (length)
+        {
+            const auto chunk = static_cast<uint16_t>(std::min(length, maxChunk));
+            crc              = Crc32Autosar(data, chunk, crc);
+            data += chunk;
+            length -= chunk;
+        }
+        return crc;
+    }
+
+    void writeWord(std::ostream &stream, uint32_t value)
+    {
+        const uint8_t bytes[4] = {
+            static_cast<uint8_t>(value),
+            static_cast<uint8_t>(value >> 8),
+            static_cast<uint8_t>(value >> 16),
+            static_cast<uint8_t>(value >> 24),
+        };
+        stream.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+    }
+
+    bool readWord(std::istream &stream, uint32_t &value)
+    {
+        uint8_t bytes[4];
+        if (!stream.read(reinterpret_cast<char *>(bytes), sizeof(bytes)))
+        {
+            return false;
+        }
+        value = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+        return true;
+    }
+}
 
 
 NonvolatileMemory::NonvolatileMemory(const NonvolatileMemoryConfig_t &config, uint32_t maxTransfer) :
     Memory<uint32_t, uint8_t>(1),
     m_config(config),
-    m_maxTransfer {maxTransfer}
+    m_maxTransfer {maxTransfer},
+    m_readAheadAddress {0},
+    m_readAheadLength {0}
 {
     if (m_config.pageSize == 0)
     {
@@ -48,6 +97,11 @@ IMemory<uint32_t, uint8_t> *NonvolatileMemory::getIMemory()
     return this;
 }
 
+const NonvolatileMemoryConfig_t &NonvolatileMemory::getConfig() const
+{
+    return m_config;
+}
+
 uint8_t NonvolatileMemory::read(uint32_t address)
 {
     uint8_t value;
@@ -156,16 +210,81 @@ void NonvolatileMemory::eraseMemoryHelper(uint32_t address, uint32_t length)
     }
 }
 
+void NonvolatileMemory::readAheadHelper(uint32_t address, uint32_t length, uint8_t *buffer)
+{
+    if (m_readAheadLength && (address >= m_readAheadAddress) && (address + length <= m_readAheadAddress + m_readAheadLength))
+    {
+        std::memcpy(buffer, &m_readAhead[address - m_readAheadAddress], length);
+        return;
+    }
+
+    /*
+     * Callers like calibration parsers read many small pieces one after the other.
+     * Each access costs a round trip to the bridge, so a whole window starting at
+     * the page of the requested data is read at once and following reads are served
+     * from it. Reads that don't fit into the window are passed through.
+     */
+    const uint32_t windowSize  = std::max(m_maxTransfer - m_maxTransfer % m_config.pageSize, m_config.pageSize);
+    const uint32_t windowStart = address - address % m_config.pageSize;
+    const uint32_t windowEnd   = std::min(windowStart + windowSize, m_config.totalSize);
+    if (address + length > windowEnd)
+    {
+        readMemoryHelper(address, length, buffer);
+        return;
+    }
+
+    m_readAhead.resize(windowSize);
+    m_readAheadLength = 0;
+    readMemoryHelper(windowStart, windowEnd - windowStart, m_readAhead.data());
+    m_readAheadAddress = windowStart;
+    m_readAheadLength  = windowEnd - windowStart;
+
+    std::memcpy(buffer, &m_readAhead[address - m_readAheadAddress], length);
+}
+
+void NonvolatileMemory::discardReadAhead()
+{
+    m_readAheadLength = 0;
+}
+
 void NonvolatileMemory::readRandom(uint32_t address, uint32_t length, uint8_t buffer[])
 {
     applyAccessOffset(address);
     checkMemoryBoundaries(address, length);
 
-    readMemoryHelper(address, length, buffer);
+    readAheadHelper(address, length, buffer);
+}
+
+void NonvolatileMemory::readCached(uint32_t address, uint32_t length, uint8_t buffer[], const char cacheFile[])
+{
+    // Cache file layout (little endian): magic, address, length, CRC of data, data
+    {
+        std::ifstream file(cacheFile, std::ios::binary);
+        char magic[sizeof(cacheFileMagic)];
+        uint32_t fileAddress, fileLength, fileCrc;
+        if (file.read(magic, sizeof(magic)) && !std::memcmp(magic, cacheFileMagic, sizeof(magic)) &&
+            readWord(file, fileAddress) && readWord(file, fileLength) && readWord(file, fileCrc) &&
+            (fileAddress == address) && (fileLength == length) &&
+            file.read(reinterpret_cast<char *>(buffer), length) &&
+            (calculateCrc(buffer, length) == fileCrc))
+        {
+            return;
+        }
+    }
+
+    readRandom(address, length, buffer);
+
+    std::ofstream file(cacheFile, std::ios::binary | std::ios::trunc);
+    file.write(cacheFileMagic, sizeof(cacheFileMagic));
+    writeWord(file, address);
+    writeWord(file, length);
+    writeWord(file, calculateCrc(buffer, length));
+    file.write(reinterpret_cast<const char *>(buffer), length);
 }
 
 void NonvolatileMemory::eraseAligned(uint32_t address, uint32_t length)
 {
+    discardReadAhead();
     applyAccessOffset(address);
     checkMemoryBoundaries(address, length);
 
@@ -179,6 +298,7 @@ void NonvolatileMemory::eraseAligned(uint32_t address, uint32_t length)
 
 void NonvolatileMemory::writeErased(uint32_t address, uint32_t length, const uint8_t buffer[])
 {
+    discardReadAhead();
     applyAccessOffset(address);
     checkMemoryBoundaries(address, length);
 
@@ -214,6 +334,7 @@ void NonvolatileMemory::writeErased(uint32_t address, uint32_t length, const uin
 
 void NonvolatileMemory::writeRandom(uint32_t address, uint32_t length, const uint8_t buffer[])
 {
+    discardReadAhead();
     if (!m_config.sectorSize)
     {
         writeErased(address, length, buffer);
@@ -13,6 +13,8 @@
 #include <components/interfaces/INonvolatileMemory.hpp>
 #include <platform/Memory.hpp>
 
+#include <vector>
+
 
 typedef struct
 {
@@ -33,11 +35,31 @@ public:
 
     STRATA_API IMemory<uint32_t, uint8_t> *getIMemory() override;
 
+    STRATA_API const NonvolatileMemoryConfig_t &getConfig() const;
+
     STRATA_API void readRandom(uint32_t address, uint32_t length, uint8_t buffer[]) override;
     STRATA_API void eraseAligned(uint32_t address, uint32_t length) override;
     STRATA_API void writeErased(uint32_t address, uint32_t length, const uint8_t buffer[]) override;
     STRATA_API void writeRandom(uint32_t address, uint32_t length, const uint8_t buffer[]) override;
 
+    ///
+    /// Read data through a persistent cache file on the host
+    /// \details If cacheFile contains the requested range with a valid CRC, the data is taken
+    ///          from the file and the memory is not accessed at all. Otherwise the data is read
+    ///          from the memory and the file is (re)written. Problems with the cache file are
+    ///          not reported, the memory is read instead.
+    ///          The file is not updated when the memory is written, so the caller has to use a
+    ///          file name unique to the board (e.g. containing its serial number) and must
+    ///          delete the file after changing the memory contents.
+    ///
+    STRATA_API void readCached(uint32_t address, uint32_t length, uint8_t buffer[], const char cacheFile[]);
+
+    ///
+    /// Discard data read ahead from the memory
+    /// \details This is only needed if the memory is modified bypassing this object.
+    ///
+    STRATA_API void discardReadAhead();
+
 private:
     // IMemory
     uint8_t read(uint32_t address) override;
@@ -52,6 +74,7 @@ private:
     void readMemoryHelper(uint32_t address, uint32_t length, uint8_t *buffer);
     void readMemoryInterfaceHelper(uint32_t address, uint32_t length, uint8_t *buffer);
     void eraseMemoryHelper(uint32_t address, uint32_t length);
+    void readAheadHelper(uint32_t address, uint32_t length, uint8_t *buffer);
 
     virtual void readMemoryInterface(uint32_t address, uint32_t length, uint8_t *buffer)        = 0;
     virtual void writeMemoryInterface(uint32_t address, uint32_t length, const uint8_t *buffer) = 0;
@@ -60,4 +83,10 @@ private:
 protected:
     const NonvolatileMemoryConfig_t m_config;
     uint32_t m_maxTransfer;
+
+private:
+    // page aligned window of memory contents read ahead, valid if m_readAheadLength > 0
+    std::vector<uint8_t> m_readAhead;
+    uint32_t m_readAheadAddress;
+    uint32_t m_readAheadLength;
 };
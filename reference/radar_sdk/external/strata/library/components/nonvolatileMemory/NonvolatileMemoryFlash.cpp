@@ -28,10 +28,18 @@ NonvolatileMemoryFlash::~NonvolatileMemoryFlash()
 {
 }
 
-void NonvolatileMemoryFlash::waitUntilIdle()
+namespace
+{
+    // A page is programmed in about a millisecond, while reading the status already takes
+    // a round trip to the bridge, so writes are polled without sleeping in between.
+    // Erasing a sector takes tens of milliseconds.
+    constexpr std::chrono::milliseconds writeStep {0};
+    constexpr std::chrono::milliseconds eraseStep {10};
+}
+
+void NonvolatileMemoryFlash::waitUntilIdle(std::chrono::milliseconds step)
 {
     const auto timeout = std::chrono::milliseconds(1000);
-    const auto step    = std::chrono::milliseconds(10);
 
     auto idle = [&] {
         return (m_access->getStatus(m_devId) & 0x01) == 0;
@@ -51,7 +59,7 @@ void NonvolatileMemoryFlash::checkReady()
         return;
     }
 
-    waitUntilIdle();
+    waitUntilIdle(eraseStep);
     m_isReady = true;
 }
 
@@ -65,12 +73,12 @@ void NonvolatileMemoryFlash::writeMemoryInterface(uint32_t address, uint32_t len
 {
     checkReady();
     m_access->write(m_devId, address, length, buffer);
-    waitUntilIdle();
+    waitUntilIdle(writeStep);
 }
 
 void NonvolatileMemoryFlash::eraseMemoryInterface(uint32_t address)
 {
     checkReady();
     m_access->erase(m_devId, address);
-    waitUntilIdle();
+    waitUntilIdle(eraseStep);
 }
@@ -12,6 +12,8 @@
 #include <components/nonvolatileMemory/NonvolatileMemory.hpp>
 #include <platform/interfaces/access/IFlash.hpp>
 
+#include <chrono>
+
 class NonvolatileMemoryFlash :
     public NonvolatileMemory
 {
@@ -26,7 +28,7 @@ protected:
 
 private:
     void checkReady();
-    void waitUntilIdle();
+    void waitUntilIdle(std::chrono::milliseconds step);
 
 private:
     IFlash *m_access;
@@ -9,44 +9,1166 @@
 
 #include "ProcessingRadar.hpp"
 
-void ProcessingRadar::configure(uint8_t /*dataSource*/, const IDataProperties_t * /*dataProperties*/, const IProcessingRadarInput_t * /*radarInfo*/,
-                                const IfxRsp_Stages * /*stages*/, const IfxRsp_AntennaCalibration * /*antennaConfig*/)
+#include <common/Threads.hpp>
+#include <common/exception/EConfig.hpp>
+#include <common/exception/EUninitialized.hpp>
+#include <platform/exception/EMemory.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+
+constexpr uint32_t ProcessingRadar::defaultMemorySize;
+constexpr uint8_t ProcessingRadar::customWindow;
+constexpr uint8_t ProcessingRadar::customWindowSlots;
+
+
+namespace
 {
+    using Complex = std::complex<float>;
+
+    const double pi = 3.14159265358979323846;
+
+    template <typename T>
+    inline T load(const uint8_t *p)
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    inline void store(uint8_t *p, T value)
+    {
+        std::memcpy(p, &value, sizeof(T));
+    }
+
+    uint32_t formatBytes(uint8_t format)
+    {
+        switch (format)
+        {
+            case DataFormat_U8:
+            case DataFormat_S8:
+                return 1;
+            case DataFormat_U16:
+            case DataFormat_S16:
+            case DataFormat_Q15:
+            case DataFormat_Half:
+                return 2;
+            case DataFormat_U32:
+            case DataFormat_S32:
+            case DataFormat_Q31:
+            case DataFormat_ComplexQ15:
+            case DataFormat_ComplexHalf:
+                return 4;
+            case DataFormat_ComplexQ31:
+                return 8;
+            default:
+                return 0;
+        }
+    }
+
+    bool isComplex(uint8_t format)
+    {
+        return (format == DataFormat_ComplexQ15) || (format == DataFormat_ComplexQ31) || (format == DataFormat_ComplexHalf);
+    }
+
+    uint32_t nextPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    uint32_t align64(uint64_t address)
+    {
+        return static_cast<uint32_t>((address + 63) & ~static_cast<uint64_t>(63));
+    }
+
+    uint64_t signalExtent(const IfxRsp_Signal &signal)
+    {
+        return static_cast<uint64_t>(signal.pages) * signal.rows * signal.stride;
+    }
+
+    float halfToFloat(uint16_t half)
+    {
+        const uint32_t sign     = static_cast<uint32_t>(half & 0x8000) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1F;
+        const uint32_t mantissa = half & 0x03FF;
+
+        if (exponent == 0)
+        {
+            const float value = std::ldexp(static_cast<float>(mantissa), -24);
+            return sign ? -value : value;
+        }
+
+        const uint32_t bits = (exponent == 0x1F) ? (sign | 0x7F800000 | (mantissa << 13))
+                                                 : (sign | ((exponent + 112) << 23) | (mantissa << 13));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    uint16_t floatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const int32_t exponent  = static_cast<int32_t>((bits >> 23) & 0xFF) - 127 + 15;
+        uint32_t mantissa       = bits & 0x007FFFFF;
+
+        if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        {
+            return sign | 0x7E00;
+        }
+        if (exponent >= 31)
+        {
+            return sign | 0x7C00;
+        }
+        if (exponent <= 0)
+        {
+            if (exponent < -10)
+            {
+                return sign;
+            }
+            mantissa |= 0x00800000;
+            const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+            uint32_t half        = mantissa >> shift;
+            if ((mantissa >> (shift - 1)) & 1)
+            {
+                half++;
+            }
+            return sign | static_cast<uint16_t>(half);
+        }
+
+        // a carry of the rounding correctly moves on to the exponent
+        uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if (mantissa & 0x1000)
+        {
+            half++;
+        }
+        return sign | static_cast<uint16_t>(half);
+    }
+
+    template <typename T>
+    T saturate(double value)
+    {
+        const double minimum = static_cast<double>(std::numeric_limits<T>::min());
+        const double maximum = static_cast<double>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::round(std::min(std::max(value, minimum), maximum)));
+    }
+
+    ///
+    /// Reads a sample as a fraction of the full scale of its format
+    ///
+    Complex readSample(const uint8_t *p, uint8_t format)
+    {
+        switch (format)
+        {
+            case DataFormat_U8:
+                return Complex(p[0] / 256.0f);
+            case DataFormat_U16:
+                return Complex(load<uint16_t>(p) / 65536.0f);
+            case DataFormat_U32:
+                return Complex(static_cast<float>(load<uint32_t>(p) / 4294967296.0));
+            case DataFormat_S8:
+                return Complex(static_cast<int8_t>(p[0]) / 128.0f);
+            case DataFormat_S16:
+            case DataFormat_Q15:
+                return Complex(load<int16_t>(p) / 32768.0f);
+            case DataFormat_S32:
+            case DataFormat_Q31:
+                return Complex(static_cast<float>(load<int32_t>(p) / 2147483648.0));
+            case DataFormat_Half:
+                return Complex(halfToFloat(load<uint16_t>(p)));
+            case DataFormat_ComplexQ15:
+                return Complex(load<int16_t>(p) / 32768.0f, load<int16_t>(p + 2) / 32768.0f);
+            case DataFormat_ComplexQ31:
+                return Complex(static_cast<float>(load<int32_t>(p) / 2147483648.0), static_cast<float>(load<int32_t>(p + 4) / 2147483648.0));
+            case DataFormat_ComplexHalf:
+                return Complex(halfToFloat(load<uint16_t>(p)), halfToFloat(load<uint16_t>(p + 2)));
+            default:
+                return Complex();
+        }
+    }
+
+    ///
+    /// Reads the raw value of a real sample, as the thresholding compares it
+    ///
+    double readRaw(const uint8_t *p, uint8_t format)
+    {
+        switch (format)
+        {
+            case DataFormat_U8:
+                return p[0];
+            case DataFormat_U16:
+                return load<uint16_t>(p);
+            case DataFormat_U32:
+                return load<uint32_t>(p);
+            case DataFormat_S8:
+                return static_cast<int8_t>(p[0]);
+            case DataFormat_S16:
+            case DataFormat_Q15:
+                return load<int16_t>(p);
+            case DataFormat_S32:
+            case DataFormat_Q31:
+                return load<int32_t>(p);
+            case DataFormat_Half:
+                return halfToFloat(load<uint16_t>(p));
+            default:
+                return 0.0;
+        }
+    }
+
+    void writeReal(uint8_t *p, uint8_t format, double value)
+    {
+        switch (format)
+        {
+            case DataFormat_Q15:
+                store(p, saturate<int16_t>(value * 32768.0));
+                break;
+            case DataFormat_Q31:
+                store(p, saturate<int32_t>(value * 2147483648.0));
+                break;
+            default:
+                break;
+        }
+    }
+
+    void writeComplex(uint8_t *p, uint8_t format, Complex value)
+    {
+        switch (format)
+        {
+            case DataFormat_ComplexQ15:
+                store(p, saturate<int16_t>(value.real() * 32768.0));
+                store(p + 2, saturate<int16_t>(value.imag() * 32768.0));
+                break;
+            case DataFormat_ComplexQ31:
+                store(p, saturate<int32_t>(value.real() * 2147483648.0));
+                store(p + 4, saturate<int32_t>(value.imag() * 2147483648.0));
+                break;
+            case DataFormat_ComplexHalf:
+                store(p, floatToHalf(value.real()));
+                store(p + 2, floatToHalf(value.imag()));
+                break;
+            default:
+                break;
+        }
+    }
+
+    ///
+    /// Position of one line of a signal: the vector along the given dimension
+    ///
+    struct Line
+    {
+        uint8_t *first;
+        size_t step;
+    };
+
+    Line getLine(uint8_t *memory, const IfxRsp_Signal &signal, uint8_t dimension, uint32_t line, uint32_t offset)
+    {
+        const uint32_t bytes = formatBytes(signal.format);
+        if (dimension == 0)
+        {
+            // rows of consecutive pages follow each other
+            return {memory + signal.baseAddress + static_cast<size_t>(line) * signal.stride + static_cast<size_t>(offset) * bytes, bytes};
+        }
+
+        const uint32_t page = line / signal.cols;
+        const uint32_t col  = line % signal.cols;
+        return {memory + signal.baseAddress + (static_cast<size_t>(page) * signal.rows + offset) * signal.stride + static_cast<size_t>(col) * bytes, signal.stride};
+    }
+
+    uint32_t getLineCount(const IfxRsp_Signal &signal, uint8_t dimension)
+    {
+        return static_cast<uint32_t>(signal.pages) * ((dimension == 0) ? signal.rows : signal.cols);
+    }
+
+    uint32_t getLineLength(const IfxRsp_Signal &signal, uint8_t dimension)
+    {
+        return (dimension == 0) ? signal.cols : signal.rows;
+    }
+
+    ///
+    /// In-place radix-2 FFT (decimation in time) of a buffer in bit reversed order
+    ///
+    void transform(std::vector<Complex> &buffer, const std::vector<Complex> &twiddles)
+    {
+        const auto size = static_cast<uint32_t>(buffer.size());
+        for (uint32_t half = 1; half < size; half <<= 1)
+        {
+            const uint32_t twiddleStep = size / (2 * half);
+            for (uint32_t group = 0; group < size; group += 2 * half)
+            {
+                for (uint32_t k = 0; k < half; k++)
+                {
+                    const Complex odd        = buffer[group + k + half] * twiddles[k * twiddleStep];
+                    buffer[group + k + half] = buffer[group + k] - odd;
+                    buffer[group + k] += odd;
+                }
+            }
+        }
+    }
+
+    bool isEnabled(const IfxRsp_ThresholdingSetting &settings)
+    {
+        return (settings.localMax.mode != IfxRsp_LocalMaxMode_Disable) ||
+               (settings.cfarCa.algorithm != IfxRsp_CfarCaAlgorithm_Disable) ||
+               (settings.cfarGos.algorithm != IfxRsp_CfarGosAlgorithm_Disable);
+    }
+
+    ///
+    /// Collects the cells of the leading and lagging window of a cell under test
+    /// \details Without spectrum extension, the windows are cut at the edges of the vector.
+    ///
+    void getWindowCells(const std::vector<double> &values, uint32_t cell, uint32_t guard, uint32_t width, bool cyclic,
+                        std::vector<double> &lead, std::vector<double> &lag)
+    {
+        const int64_t n = static_cast<int64_t>(values.size());
+        lead.clear();
+        lag.clear();
+        for (uint32_t i = 0; i < width; i++)
+        {
+            const int64_t distance = static_cast<int64_t>(guard) + 1 + i;
+            int64_t before         = static_cast<int64_t>(cell) - distance;
+            int64_t after          = static_cast<int64_t>(cell) + distance;
+            if (cyclic)
+            {
+                before = ((before % n) + n) % n;
+                after  = after % n;
+            }
+            if (before >= 0)
+            {
+                lead.push_back(values[static_cast<size_t>(before)]);
+            }
+            if (after < n)
+            {
+                lag.push_back(values[static_cast<size_t>(after)]);
+            }
+        }
+    }
+
+    double mean(const std::vector<double> &cells)
+    {
+        double sum = 0.0;
+        for (auto value : cells)
+        {
+            sum += value;
+        }
+        return sum / static_cast<double>(cells.size());
+    }
+
+    ///
+    /// Combines the statistics of both windows, using the one available at an edge
+    ///
+    bool combineWindows(bool hasLead, double lead, bool hasLag, double lag, bool greatest, bool smallest, double &noise)
+    {
+        if (!hasLead && !hasLag)
+        {
+            return false;
+        }
+        if (!hasLead || !hasLag)
+        {
+            noise = hasLead ? lead : lag;
+        }
+        else if (greatest)
+        {
+            noise = std::max(lead, lag);
+        }
+        else if (smallest)
+        {
+            noise = std::min(lead, lag);
+        }
+        else
+        {
+            noise = (lead + lag) / 2;
+        }
+        return true;
+    }
+
+    double orderStatistic(std::vector<double> &cells, uint32_t index)
+    {
+        const size_t k = std::min<size_t>(index, cells.size()) - 1;
+        std::nth_element(cells.begin(), cells.begin() + k, cells.end());
+        return cells[k];
+    }
+
+    void threshold(const std::vector<double> &values, const IfxRsp_ThresholdingSetting &settings, std::vector<uint8_t> &detections)
+    {
+        const auto n                = static_cast<uint32_t>(values.size());
+        const bool cyclic           = settings.spectrumExtension;
+        const auto &localMax        = settings.localMax;
+        const auto &cfarCa          = settings.cfarCa;
+        const auto &cfarGos         = settings.cfarGos;
+        const bool cfarEnabled      = (cfarCa.algorithm != IfxRsp_CfarCaAlgorithm_Disable) || (cfarGos.algorithm != IfxRsp_CfarGosAlgorithm_Disable);
+        const bool localMaxEnabled  = (localMax.mode != IfxRsp_LocalMaxMode_Disable);
+
+        std::vector<double> lead, lag;
+        lead.reserve(64);
+        lag.reserve(64);
+
+        detections.assign(n, 0);
+        for (uint32_t cell = 0; cell < n; cell++)
+        {
+            const double value = values[cell];
+            bool cfar          = true;
+
+            if (cfarCa.algorithm != IfxRsp_CfarCaAlgorithm_Disable)
+            {
+                const uint32_t width = 1u << cfarCa.windowCellsExponent;
+                const double beta    = cfarCa.betaThreshold / 256.0;
+                getWindowCells(values, cell, cfarCa.guardCells, width, cyclic, lead, lag);
+
+                double noise = 0.0;
+                bool valid;
+                if (cfarCa.algorithm == IfxRsp_CfarCaAlgorithm_Cash)
+                {
+                    // smallest mean of the sub-windows across both windows
+                    const size_t subWidth = static_cast<size_t>(1) << cfarCa.cashSubWindowExponent;
+                    lead.insert(lead.end(), lag.begin(), lag.end());
+                    valid = (lead.size() >= subWidth);
+                    for (size_t first = 0; first + subWidth <= lead.size(); first += subWidth)
+                    {
+                        double sum = 0.0;
+                        for (size_t i = first; i < first + subWidth; i++)
+                        {
+                            sum += lead[i];
+                        }
+                        const double subMean = sum / static_cast<double>(subWidth);
+                        noise                = (first == 0) ? subMean : std::min(noise, subMean);
+                    }
+                }
+                else if (cfarCa.algorithm == IfxRsp_CfarCaAlgorithm_Ca)
+                {
+                    lead.insert(lead.end(), lag.begin(), lag.end());
+                    valid = !lead.empty();
+                    if (valid)
+                    {
+                        noise = mean(lead);
+                    }
+                }
+                else
+                {
+                    valid = combineWindows(!lead.empty(), lead.empty() ? 0.0 : mean(lead),
+                                           !lag.empty(), lag.empty() ? 0.0 : mean(lag),
+                                           cfarCa.algorithm == IfxRsp_CfarCaAlgorithm_Cago,
+                                           cfarCa.algorithm == IfxRsp_CfarCaAlgorithm_Caso, noise);
+                }
+                cfar = cfar && valid && (value > beta * noise);
+            }
+
+            if (cfarGos.algorithm != IfxRsp_CfarGosAlgorithm_Disable)
+            {
+                const double beta = cfarGos.betaThreshold / 256.0;
+                getWindowCells(values, cell, cfarGos.guardCells, cfarGos.windowCells, cyclic, lead, lag);
+
+                const bool hasLead = !lead.empty();
+                const bool hasLag  = !lag.empty();
+                double noise       = 0.0;
+                const bool valid   = combineWindows(hasLead, hasLead ? orderStatistic(lead, cfarGos.indexLead) : 0.0,
+                                                    hasLag, hasLag ? orderStatistic(lag, cfarGos.indexLag) : 0.0,
+                                                    cfarGos.algorithm == IfxRsp_CfarGosAlgorithm_Gosgo,
+                                                    cfarGos.algorithm == IfxRsp_CfarGosAlgorithm_Gosso, noise);
+                cfar = cfar && valid && (value > beta * noise);
+            }
+
+            bool peak = true;
+            if ((localMax.mode == IfxRsp_LocalMaxMode_ThresholdOnly) || (localMax.mode == IfxRsp_LocalMaxMode_Both))
+            {
+                peak = (value > localMax.threshold);
+            }
+            if ((localMax.mode == IfxRsp_LocalMaxMode_LocalMaxOnly) || (localMax.mode == IfxRsp_LocalMaxMode_Both))
+            {
+                getWindowCells(values, cell, 0, localMax.windowWidth, cyclic, lead, lag);
+                for (auto neighbour : lead)
+                {
+                    peak = peak && (value >= neighbour);
+                }
+                for (auto neighbour : lag)
+                {
+                    peak = peak && (value >= neighbour);
+                }
+            }
+
+            bool detected;
+            if (!localMaxEnabled)
+            {
+                detected = cfar;
+            }
+            else if (!cfarEnabled)
+            {
+                detected = peak;
+            }
+            else
+            {
+                detected = localMax.combineAnd ? (cfar && peak) : (cfar || peak);
+            }
+            detections[cell] = detected;
+        }
+    }
+}
+
+
+ProcessingRadar::ProcessingRadar(uint32_t memorySize, unsigned int workers) :
+    m_memory(memorySize),
+    m_customWindows(customWindowSlots),
+    m_workerCount {workers ? workers : std::max(std::thread::hardware_concurrency(), 1u)},
+    m_outputEnd {0},
+    m_configured {false},
+    m_dataProperties {},
+    m_stages {},
+    m_stop {false}
+{
+    for (unsigned int i = 0; i < m_workerCount; i++)
+    {
+        m_workers.emplace_back(&ProcessingRadar::workerThread, this);
+    }
 }
 
-void ProcessingRadar::doFft(const IfxRsp_Signal * /*input*/, const IfxRsp_FftSetting * /*settings*/, IfxRsp_Signal * /*output*/, uint16_t /*samples*/, uint16_t /*offset*/, uint8_t /*dimension*/, uint8_t /*format*/)
+ProcessingRadar::~ProcessingRadar()
 {
+    reinitialize();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
 }
 
-void ProcessingRadar::doNci(const IfxRsp_Signal * /*input*/, uint8_t /*format*/, IfxRsp_Signal * /*output*/)
+void ProcessingRadar::configure(uint8_t /*dataSource*/, const IDataProperties_t *dataProperties, const IProcessingRadarInput_t * /*radarInfo*/,
+                                const IfxRsp_Stages *stages, const IfxRsp_AntennaCalibration * /*antennaConfig*/)
 {
+    if ((dataProperties == nullptr) || (stages == nullptr))
+    {
+        throw EConfig("ProcessingRadar::configure() - data properties and stages have to be specified");
+    }
+    if (stages->fftSteps > 2)
+    {
+        throw EConfig("ProcessingRadar::configure() - at most two FFT stages are supported");
+    }
+
+    m_dataProperties = *dataProperties;
+    m_stages         = *stages;
+    m_configured     = true;
 }
 
-void ProcessingRadar::doThresholding(const IfxRsp_Signal * /*input*/, uint8_t /*dimension*/, const IfxRsp_ThresholdingSetting * /*settings*/, IfxRsp_Signal * /*output*/)
+void ProcessingRadar::doFft(const IfxRsp_Signal *input, const IfxRsp_FftSetting *settings, IfxRsp_Signal *output, uint16_t samples, uint16_t offset, uint8_t dimension, uint8_t format)
 {
+    if ((input == nullptr) || (settings == nullptr) || (output == nullptr) || (dimension > 1))
+    {
+        throw EConfig("ProcessingRadar::doFft() - invalid arguments");
+    }
+    checkSignal(*input);
+
+    const uint32_t length = getLineLength(*input, dimension);
+    if (samples == 0)
+    {
+        samples = static_cast<uint16_t>(length - std::min<uint32_t>(offset, length));
+    }
+    if ((samples == 0) || (offset + samples > length))
+    {
+        throw EConfig("ProcessingRadar::doFft() - samples exceed the input signal");
+    }
+
+    const uint32_t fftSize = settings->size ? settings->size : nextPowerOfTwo(samples);
+    if ((fftSize & (fftSize - 1)) || (fftSize < samples) || (fftSize > 0x8000))
+    {
+        throw EConfig("ProcessingRadar::doFft() - FFT size has to be a power of 2 not smaller than the samples");
+    }
+
+    uint32_t bins = (settings->flags & FFT_FLAGS_DISCARD_HALF) ? fftSize / 2 : fftSize;
+    if (settings->acceptedBins)
+    {
+        if (settings->acceptedBins > bins)
+        {
+            throw EConfig("ProcessingRadar::doFft() - more accepted bins than FFT bins");
+        }
+        bins = settings->acceptedBins;
+    }
+
+    if ((format == DataFormat_Auto) || (format == DataFormat_Disabled))
+    {
+        format = DataFormat_ComplexQ31;
+    }
+    if (!isComplex(format))
+    {
+        throw EConfig("ProcessingRadar::doFft() - only complex output formats are supported");
+    }
+
+    IfxRsp_Signal result;
+    result.rows   = static_cast<uint16_t>((dimension == 0) ? input->rows : bins);
+    result.cols   = static_cast<uint16_t>((dimension == 0) ? bins : input->cols);
+    result.pages  = input->pages;
+    result.format = format;
+
+    if (settings->flags & FFT_FLAGS_INPLACE)
+    {
+        // lines running in parallel must not overwrite input of each other
+        const bool fits = (dimension == 0) ? (bins * formatBytes(format) <= input->stride)
+                                           : ((formatBytes(format) == formatBytes(input->format)) && (bins <= input->rows) && ((input->pages == 1) || (bins == input->rows)));
+        if (!fits)
+        {
+            throw EConfig("ProcessingRadar::doFft() - FFT result does not fit in place of the input");
+        }
+        result.baseAddress = input->baseAddress;
+        result.stride      = input->stride;
+        result.size        = static_cast<uint32_t>(signalExtent(result));
+        m_outputEnd        = 0;
+    }
+    else
+    {
+        placeOutput(*input, result);
+    }
+
+    const auto plan     = getFftPlan(fftSize);
+    const auto window   = getWindow(*settings, samples);
+    const float scale   = (format != DataFormat_ComplexQ31) ? std::ldexp(1.0f, settings->exponent) / fftSize : 1.0f / fftSize;
+    uint8_t *memory     = m_memory.data();
+    const auto source   = *input;
+
+    *output = result;
+    enqueue(getLineCount(source, dimension), [=](uint32_t begin, uint32_t end) {
+        std::vector<Complex> buffer(fftSize);
+        for (uint32_t line = begin; line < end; line++)
+        {
+            const Line in = getLine(memory, source, dimension, line, offset);
+            for (uint32_t i = 0; i < samples; i++)
+            {
+                buffer[plan->bitReversal[i]] = readSample(in.first + i * in.step, source.format) * (*window)[i];
+            }
+            for (uint32_t i = samples; i < fftSize; i++)
+            {
+                buffer[plan->bitReversal[i]] = Complex();
+            }
+
+            transform(buffer, plan->twiddles);
+
+            const Line out = getLine(memory, result, dimension, line, 0);
+            for (uint32_t i = 0; i < bins; i++)
+            {
+                writeComplex(out.first + i * out.step, result.format, buffer[i] * scale);
+            }
+        }
+    });
 }
 
-void ProcessingRadar::doPsd(const IfxRsp_Signal * /*input*/, uint16_t /*nFft*/, IfxRsp_Signal * /*output*/)
+void ProcessingRadar::doNci(const IfxRsp_Signal *input, uint8_t format, IfxRsp_Signal *output)
 {
+    if ((input == nullptr) || (output == nullptr))
+    {
+        throw EConfig("ProcessingRadar::doNci() - invalid arguments");
+    }
+    checkSignal(*input);
+
+    if ((format == DataFormat_Auto) || (format == DataFormat_Disabled))
+    {
+        format = DataFormat_Q31;
+    }
+    if ((format != DataFormat_Q15) && (format != DataFormat_Q31))
+    {
+        throw EConfig("ProcessingRadar::doNci() - only Q15 and Q31 output formats are supported");
+    }
+
+    IfxRsp_Signal result;
+    result.rows   = input->rows;
+    result.cols   = input->cols;
+    result.pages  = 1;
+    result.format = format;
+    placeOutput(*input, result);
+
+    uint8_t *memory   = m_memory.data();
+    const auto source = *input;
+
+    *output = result;
+    enqueue(source.rows, [=](uint32_t begin, uint32_t end) {
+        const uint32_t inBytes   = formatBytes(source.format);
+        const uint32_t outBytes  = formatBytes(result.format);
+        const size_t pageStride  = static_cast<size_t>(source.rows) * source.stride;
+
+        for (uint32_t row = begin; row < end; row++)
+        {
+            const uint8_t *in = memory + source.baseAddress + static_cast<size_t>(row) * source.stride;
+            uint8_t *out      = memory + result.baseAddress + static_cast<size_t>(row) * result.stride;
+            for (uint32_t col = 0; col < source.cols; col++)
+            {
+                double sum = 0.0;
+                for (uint32_t page = 0; page < source.pages; page++)
+                {
+                    sum += std::abs(readSample(in + page * pageStride + col * inBytes, source.format));
+                }
+                writeReal(out + col * outBytes, result.format, sum / source.pages);
+            }
+        }
+    });
+}
+
+void ProcessingRadar::doThresholding(const IfxRsp_Signal *input, uint8_t dimension, const IfxRsp_ThresholdingSetting *settings, IfxRsp_Signal *output)
+{
+    if ((input == nullptr) || (settings == nullptr) || (output == nullptr) || (dimension > 1))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - invalid arguments");
+    }
+    checkSignal(*input);
+
+    if (isComplex(input->format))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - input has to be real");
+    }
+    if (!isEnabled(*settings))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - no thresholding enabled");
+    }
+
+    const auto &cfarCa  = settings->cfarCa;
+    const auto &cfarGos = settings->cfarGos;
+    if ((cfarCa.algorithm > IfxRsp_CfarCaAlgorithm_Caso) || (cfarCa.guardCells > 32) || (cfarCa.windowCellsExponent > 5) ||
+        (cfarCa.cashSubWindowExponent > cfarCa.windowCellsExponent + 1))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - invalid CFAR CA settings");
+    }
+    if ((cfarGos.algorithm > IfxRsp_CfarGosAlgorithm_Gosso) ||
+        ((cfarGos.algorithm != IfxRsp_CfarGosAlgorithm_Disable) &&
+         ((cfarGos.guardCells > 32) || (cfarGos.windowCells < 1) || (cfarGos.windowCells > 32) ||
+          (cfarGos.indexLead < 1) || (cfarGos.indexLead > cfarGos.windowCells) ||
+          (cfarGos.indexLag < 1) || (cfarGos.indexLag > cfarGos.windowCells))))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - invalid CFAR GOS settings");
+    }
+    if ((settings->localMax.mode > IfxRsp_LocalMaxMode_Both) || (settings->localMax.windowWidth > 2))
+    {
+        throw EConfig("ProcessingRadar::doThresholding() - invalid local maximum settings");
+    }
+
+    IfxRsp_Signal result;
+    result.rows   = input->rows;
+    result.cols   = input->cols;
+    result.pages  = input->pages;
+    result.format = DataFormat_Bits;
+    placeOutput(*input, result);
+
+    uint8_t *memory     = m_memory.data();
+    const auto source   = *input;
+    const auto setting  = *settings;
+
+    // along columns, each line handles the eight columns sharing an output byte
+    const uint32_t groups = (source.cols + 7) / 8;
+    const uint32_t lines  = (dimension == 0) ? getLineCount(source, 0) : source.pages * groups;
+
+    *output = result;
+    enqueue(lines, [=](uint32_t begin, uint32_t end) {
+        const uint32_t length = getLineLength(source, dimension);
+        std::vector<double> values(length);
+        std::vector<uint8_t> detections;
+
+        for (uint32_t line = begin; line < end; line++)
+        {
+            if (dimension == 0)
+            {
+                const Line in = getLine(memory, source, 0, line, 0);
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    values[i] = readRaw(in.first + i * in.step, source.format);
+                }
+                threshold(values, setting, detections);
+
+                uint8_t *out = memory + result.baseAddress + static_cast<size_t>(line) * result.stride;
+                std::fill(out, out + result.stride, 0);
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    out[i / 8] |= static_cast<uint8_t>(detections[i] << (i % 8));
+                }
+                continue;
+            }
+
+            const uint32_t page  = line / groups;
+            const uint32_t group = line % groups;
+            const uint32_t first = group * 8;
+            const uint32_t last  = std::min<uint32_t>(first + 8, source.cols);
+            uint8_t *out         = memory + result.baseAddress + static_cast<size_t>(page) * source.rows * result.stride + group;
+            for (uint32_t row = 0; row < source.rows; row++)
+            {
+                out[row * result.stride] = 0;
+            }
+            for (uint32_t col = first; col < last; col++)
+            {
+                const Line in = getLine(memory, source, 1, page * source.cols + col, 0);
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    values[i] = readRaw(in.first + i * in.step, source.format);
+                }
+                threshold(values, setting, detections);
+
+                for (uint32_t row = 0; row < length; row++)
+                {
+                    out[row * result.stride] |= static_cast<uint8_t>(detections[row] << (col % 8));
+                }
+            }
+        }
+    });
+}
+
+void ProcessingRadar::doPsd(const IfxRsp_Signal *input, uint16_t nFft, IfxRsp_Signal *output)
+{
+    if ((input == nullptr) || (output == nullptr))
+    {
+        throw EConfig("ProcessingRadar::doPsd() - invalid arguments");
+    }
+    checkSignal(*input);
+
+    const uint32_t fftSize = nFft ? nFft : nextPowerOfTwo(input->cols);
+    if ((fftSize & (fftSize - 1)) || (fftSize < input->cols) || (fftSize > 0x8000))
+    {
+        throw EConfig("ProcessingRadar::doPsd() - FFT size has to be a power of 2 not smaller than the samples");
+    }
+
+    // the spectrum of a real signal is symmetric
+    const uint32_t bins = isComplex(input->format) ? fftSize : fftSize / 2;
+
+    IfxRsp_Signal result;
+    result.rows   = input->rows;
+    result.cols   = static_cast<uint16_t>(bins);
+    result.pages  = input->pages;
+    result.format = DataFormat_Q31;
+    placeOutput(*input, result);
+
+    const auto plan   = getFftPlan(fftSize);
+    uint8_t *memory   = m_memory.data();
+    const auto source = *input;
+
+    *output = result;
+    enqueue(getLineCount(source, 0), [=](uint32_t begin, uint32_t end) {
+        const uint32_t samples = source.cols;
+        std::vector<Complex> buffer(fftSize);
+
+        for (uint32_t line = begin; line < end; line++)
+        {
+            const Line in = getLine(memory, source, 0, line, 0);
+            for (uint32_t i = 0; i < fftSize; i++)
+            {
+                buffer[plan->bitReversal[i]] = (i < samples) ? readSample(in.first + i * in.step, source.format) : Complex();
+            }
+
+            transform(buffer, plan->twiddles);
+
+            const Line out = getLine(memory, result, 0, line, 0);
+            for (uint32_t i = 0; i < bins; i++)
+            {
+                writeReal(out.first + i * out.step, result.format, std::norm(buffer[i] / static_cast<float>(fftSize)));
+            }
+        }
+    });
 }
 
 void ProcessingRadar::start()
 {
+    if (!m_configured)
+    {
+        throw EUninitialized("ProcessingRadar::start() - configure() has to be called first");
+    }
+
+    IfxRsp_Signal frame;
+    frame.baseAddress = 0;
+    frame.rows        = m_dataProperties.ramps;
+    frame.cols        = m_dataProperties.samples;
+    frame.pages       = m_dataProperties.rxChannels;
+    frame.format      = m_dataProperties.format;
+    frame.stride      = frame.cols * formatBytes(frame.format);
+    frame.size        = static_cast<uint32_t>(signalExtent(frame));
+
+    m_results.clear();
+    m_outputEnd = 0;
+    if (m_stages.fftSteps == 0)
+    {
+        return;
+    }
+
+    IfxRsp_Signal rangeFft;
+    doFft(&frame, &m_stages.fftSettings[0], &rangeFft, 0, 0, 0, m_stages.fftFormat);
+    m_results.push_back(rangeFft);
+    if (m_stages.fftSteps == 1)
+    {
+        return;
+    }
+
+    IfxRsp_Signal dopplerFft;
+    doFft(&rangeFft, &m_stages.fftSettings[1], &dopplerFft, 0, 0, 1, m_stages.fftFormat);
+    m_results.push_back(dopplerFft);
+    if (m_stages.nciFormat == DataFormat_Disabled)
+    {
+        return;
+    }
+
+    IfxRsp_Signal nci;
+    doNci(&dopplerFft, m_stages.nciFormat, &nci);
+    m_results.push_back(nci);
+
+    const auto &detection = m_stages.detectionSettings;
+    if (detection.maxDetections == 0)
+    {
+        return;
+    }
+    for (uint8_t dimension = 0; dimension < 2; dimension++)
+    {
+        // range thresholding runs along the rows of the NCI map, velocity along its columns
+        const auto &thresholding = detection.thresholdingSettings[dimension];
+        if (isEnabled(thresholding))
+        {
+            IfxRsp_Signal detections;
+            doThresholding(&nci, dimension, &thresholding, &detections);
+            m_results.push_back(detections);
+        }
+    }
 }
 
 bool ProcessingRadar::isBusy()
 {
-    return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_operations.empty();
 }
 
-void ProcessingRadar::writeConfigRam(uint16_t /*offset*/, uint16_t /*count*/, const uint32_t /*ramContent*/[])
+void ProcessingRadar::writeConfigRam(uint16_t offset, uint16_t count, const uint32_t ramContent[])
 {
+    waitIdle();
+
+    const uint32_t size = count * static_cast<uint32_t>(sizeof(uint32_t));
+    std::memcpy(getMemory(offset * static_cast<uint32_t>(sizeof(uint32_t)), size), ramContent, size);
 }
 
-void ProcessingRadar::writeCustomWindowCoefficients(uint8_t /*slotNr*/, uint16_t /*offset*/, uint16_t /*count*/, const uint32_t /*coefficients*/[])
+void ProcessingRadar::writeCustomWindowCoefficients(uint8_t slotNr, uint16_t offset, uint16_t count, const uint32_t coefficients[])
 {
+    if (slotNr >= customWindowSlots)
+    {
+        throw EConfig("ProcessingRadar::writeCustomWindowCoefficients() - invalid slot");
+    }
+
+    auto &slot = m_customWindows[slotNr];
+    if (slot.size() < static_cast<size_t>(offset) + count)
+    {
+        slot.resize(static_cast<size_t>(offset) + count);
+    }
+    std::copy(coefficients, coefficients + count, slot.begin() + offset);
 }
 
 void ProcessingRadar::reinitialize()
 {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_operations.empty())
+    {
+        return;
+    }
+
+    // the running operation only finishes the chunks already handed out
+    m_operations.erase(m_operations.begin() + 1, m_operations.end());
+    auto &current = m_operations.front();
+    current.lines = current.next;
+    if (current.done == current.lines)
+    {
+        m_operations.pop_front();
+    }
+    m_idle.wait(lock, [this] { return m_operations.empty(); });
+}
+
+uint8_t *ProcessingRadar::getMemory(uint32_t address, uint32_t size)
+{
+    if (static_cast<uint64_t>(address) + size > m_memory.size())
+    {
+        throw EMemory("ProcessingRadar - access beyond the processing memory");
+    }
+    return m_memory.data() + address;
+}
+
+void ProcessingRadar::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_operations.empty(); });
+}
+
+const std::vector<IfxRsp_Signal> &ProcessingRadar::getResults() const
+{
+    return m_results;
+}
+
+void ProcessingRadar::enqueue(uint32_t lines, std::function<void(uint32_t, uint32_t)> run)
+{
+    if (lines == 0)
+    {
+        return;
+    }
+
+    // a few chunks per worker balance the load without much locking
+    const uint32_t chunk = std::max(lines / (m_workerCount * 4), 1u);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_operations.push_back({lines, chunk, 0, 0, std::move(run)});
+    }
+    m_wakeup.notify_all();
+}
+
+void ProcessingRadar::workerThread()
+{
+    StrataThreads::apply(StrataThreads::Processing, "proc");
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeup.wait(lock, [this] {
+            return m_stop || (!m_operations.empty() && (m_operations.front().next < m_operations.front().lines));
+        });
+        if (m_stop)
+        {
+            break;
+        }
+
+        // the front operation stays in place until all its chunks are done
+        auto &operation      = m_operations.front();
+        const uint32_t begin = operation.next;
+        const uint32_t end   = std::min(begin + operation.chunk, operation.lines);
+        operation.next       = end;
+
+        lock.unlock();
+        operation.run(begin, end);
+        lock.lock();
+
+        operation.done += end - begin;
+        if (operation.done == operation.lines)
+        {
+            m_operations.pop_front();
+            if (m_operations.empty())
+            {
+                m_idle.notify_all();
+            }
+            else
+            {
+                m_wakeup.notify_all();
+            }
+        }
+    }
+}
+
+void ProcessingRadar::checkSignal(const IfxRsp_Signal &signal) const
+{
+    const uint32_t bytes = formatBytes(signal.format);
+    if (!bytes)
+    {
+        throw EConfig("ProcessingRadar - unsupported signal format");
+    }
+    if (!signal.rows || !signal.cols || !signal.pages || (signal.stride < signal.cols * bytes))
+    {
+        throw EConfig("ProcessingRadar - invalid signal dimensions");
+    }
+    if (signal.baseAddress + signalExtent(signal) > m_memory.size())
+    {
+        throw EMemory("ProcessingRadar - signal exceeds the processing memory");
+    }
+}
+
+void ProcessingRadar::placeOutput(const IfxRsp_Signal &input, IfxRsp_Signal &output)
+{
+    output.stride = (output.format == DataFormat_Bits) ? (output.cols + 7u) / 8 : output.cols * formatBytes(output.format);
+    output.size   = static_cast<uint32_t>(signalExtent(output));
+
+    // keep the result of the previous operation, unless that leaves no room
+    const uint64_t behindInput = align64(static_cast<uint64_t>(input.baseAddress) + signalExtent(input));
+    const uint64_t address     = std::max<uint64_t>(behindInput, m_outputEnd);
+    output.baseAddress         = static_cast<uint32_t>((address + output.size <= m_memory.size()) ? address : behindInput);
+    getMemory(output.baseAddress, output.size);
+
+    m_outputEnd = align64(static_cast<uint64_t>(output.baseAddress) + output.size);
+}
+
+std::shared_ptr<const ProcessingRadar::FftPlan> ProcessingRadar::getFftPlan(uint32_t size)
+{
+    auto &plan = m_fftPlans[size];
+    if (!plan)
+    {
+        auto newPlan = std::make_shared<FftPlan>();
+        newPlan->twiddles.resize(size / 2);
+        for (uint32_t k = 0; k < size / 2; k++)
+        {
+            const double angle   = -2 * pi * k / size;
+            newPlan->twiddles[k] = Complex(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+        }
+
+        uint32_t bits = 0;
+        while ((1u << bits) < size)
+        {
+            bits++;
+        }
+        newPlan->bitReversal.resize(size);
+        for (uint32_t i = 0; i < size; i++)
+        {
+            uint32_t reversed = 0;
+            for (uint32_t b = 0; b < bits; b++)
+            {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            newPlan->bitReversal[i] = reversed;
+        }
+        plan = newPlan;
+    }
+    return plan;
+}
+
+std::shared_ptr<const std::vector<float>> ProcessingRadar::getWindow(const IfxRsp_FftSetting &settings, uint16_t samples) const
+{
+    auto window        = std::make_shared<std::vector<float>>(samples, 1.0f);
+    const double last  = std::max(samples - 1, 1);
+
+    switch (settings.window)
+    {
+        case 0:
+        case IfxRsp_FftWindow_NoWindow:
+            break;
+        case IfxRsp_FftWindow_Hann:
+            for (uint16_t n = 0; n < samples; n++)
+            {
+                (*window)[n] = static_cast<float>(0.5 - 0.5 * std::cos(2 * pi * n / last));
+            }
+            break;
+        case IfxRsp_FftWindow_Hamming:
+            for (uint16_t n = 0; n < samples; n++)
+            {
+                (*window)[n] = static_cast<float>(0.54 - 0.46 * std::cos(2 * pi * n / last));
+            }
+            break;
+        case IfxRsp_FftWindow_BlackmanHarris:
+            for (uint16_t n = 0; n < samples; n++)
+            {
+                const double x = 2 * pi * n / last;
+                (*window)[n]   = static_cast<float>(0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) - 0.01168 * std::cos(3 * x));
+            }
+            break;
+        default:
+        {
+            if ((settings.window < customWindow) || (settings.window >= customWindow + customWindowSlots))
+            {
+                throw EConfig("ProcessingRadar::doFft() - unsupported window");
+            }
+
+            const auto &slot = m_customWindows[settings.window - customWindow];
+            if (slot.size() < samples)
+            {
+                throw EConfig("ProcessingRadar::doFft() - custom window has less coefficients than samples");
+            }
+            for (uint16_t n = 0; n < samples; n++)
+            {
+                (*window)[n] = (settings.windowFormat == DataFormat_Q31) ? static_cast<float>(static_cast<int32_t>(slot[n]) / 2147483648.0)
+                                                                         : static_cast<int16_t>(slot[n] & 0xFFFF) / 32768.0f;
+            }
+            break;
+        }
+    }
+    return window;
 }
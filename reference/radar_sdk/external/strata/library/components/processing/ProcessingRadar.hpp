@@ -9,13 +9,66 @@
 
 #pragma once
 
+#include <Definitions.hpp>
 #include <components/interfaces/IProcessingRadar.hpp>
 
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+///
+/// Host side implementation of the radar processing interface
+/// \details The signals refer to an emulated processing memory: the baseAddress of a signal
+///          is a byte offset into it. The host places input data with getMemory() (or
+///          writeConfigRam()) and reads the results the same way once isBusy() returns false.
+///
+///          The do* operations check their arguments, fill in the output signal and return
+///          right away. They are executed in the order they were issued by a pool of worker
+///          threads, which split each operation by rows or columns. An operation may use the
+///          output of an earlier one as input.
+///
+///          Results are placed behind their input signal and behind the result of the previous
+///          operation (64 byte aligned), so the results of operations on one frame are laid out
+///          one after another. When the memory is exhausted, or after an FFT with
+///          FFT_FLAGS_INPLACE (which overwrites its input), the next result directly follows its
+///          input again. start() places the frame at address 0 and its results behind it.
+///
+///          Value conventions:
+///          - Q and signed integer formats are fractions of their full scale, unsigned integer
+///            formats fractions of 2^bits.
+///          - FFT results hold the DFT divided by the FFT size, which cannot overflow. For 16 bit
+///            outputs, the exponent of the setting multiplies the result by 2^exponent (with
+///            saturation) to recover small signals. doPsd() outputs the squared magnitude of
+///            such a result as Q31.
+///          - Window values from ProcessingRadar::customWindow on select the coefficients
+///            written with writeCustomWindowCoefficients() (one coefficient per word, Q15 or
+///            Q31 according to windowFormat).
+///          - Thresholding works on the raw integer values of a real input. CFAR thresholds
+///            are betaThreshold / 256 times the noise estimate; the result is a DataFormat_Bits
+///            signal with one bit per cell, least significant bit first.
+///
 class ProcessingRadar :
     public IProcessingRadar
 {
 public:
-    virtual ~ProcessingRadar() = default;
+    static constexpr uint32_t defaultMemorySize = 64 * 1024 * 1024;
+    static constexpr uint8_t customWindow       = 0x10;
+    static constexpr uint8_t customWindowSlots  = 4;
+
+    ///
+    /// \param memorySize size of the emulated processing memory in bytes
+    /// \param workers number of worker threads, 0 for one per hardware thread
+    ///
+    STRATA_API ProcessingRadar(uint32_t memorySize = defaultMemorySize, unsigned int workers = 0);
+    STRATA_API ~ProcessingRadar() override;
 
     void configure(uint8_t dataSource, const IDataProperties_t *dataProperties, const IProcessingRadarInput_t *radarInfo,
                    const IfxRsp_Stages *stages, const IfxRsp_AntennaCalibration *antennaConfig) override;
@@ -24,12 +77,89 @@ public:
     void doThresholding(const IfxRsp_Signal *input, uint8_t dimension, const IfxRsp_ThresholdingSetting *settings, IfxRsp_Signal *output) override;
     void doPsd(const IfxRsp_Signal *input, uint16_t nFft, IfxRsp_Signal *output) override;
 
+    ///
+    /// Process the frame at address 0 with the stages given to configure()
+    /// \details The frame holds rxChannels pages of ramps x samples values in the format of the
+    ///          data properties. The enabled FFT stages, the NCI and the range and velocity
+    ///          thresholding of the detection settings are issued as do* operations; their
+    ///          outputs are available with getResults(). Target lists and beamforming are not
+    ///          computed on the host.
+    ///
     void start() override;
 
     bool isBusy() override;
 
+    ///
+    /// \details The host has a single memory, so the words are written to the processing
+    ///          memory at byte address 4 * offset.
+    ///
     void writeConfigRam(uint16_t offset, uint16_t count, const uint32_t ramContent[]) override;
     void writeCustomWindowCoefficients(uint8_t slotNr, uint16_t offset, uint16_t count, const uint32_t coefficients[]) override;
 
+    ///
+    /// Cancel the operations not started yet and wait for the running one
+    ///
     void reinitialize() override;
+
+    ///
+    /// Access to the emulated processing memory
+    /// \details Throws EMemory if the range is outside the memory. The memory must not be
+    ///          accessed by the host while an operation using it is pending.
+    ///
+    STRATA_API uint8_t *getMemory(uint32_t address, uint32_t size);
+
+    ///
+    /// Block until all pending operations are done
+    ///
+    STRATA_API void waitIdle();
+
+    ///
+    /// Output signals of the operations issued by the last start()
+    ///
+    STRATA_API const std::vector<IfxRsp_Signal> &getResults() const;
+
+private:
+    using Complex = std::complex<float>;
+
+    struct Operation
+    {
+        uint32_t lines;
+        uint32_t chunk;
+        uint32_t next;
+        uint32_t done;
+        std::function<void(uint32_t, uint32_t)> run;
+    };
+
+    struct FftPlan
+    {
+        std::vector<Complex> twiddles;
+        std::vector<uint32_t> bitReversal;
+    };
+
+    void enqueue(uint32_t lines, std::function<void(uint32_t, uint32_t)> run);
+    void workerThread();
+
+    void checkSignal(const IfxRsp_Signal &signal) const;
+    void placeOutput(const IfxRsp_Signal &input, IfxRsp_Signal &output);
+    std::shared_ptr<const FftPlan> getFftPlan(uint32_t size);
+    std::shared_ptr<const std::vector<float>> getWindow(const IfxRsp_FftSetting &settings, uint16_t samples) const;
+
+    std::vector<uint8_t> m_memory;
+
+    std::vector<std::vector<uint32_t>> m_customWindows;
+    std::map<uint32_t, std::shared_ptr<const FftPlan>> m_fftPlans;
+    unsigned int m_workerCount;
+    uint32_t m_outputEnd;
+
+    bool m_configured;
+    IDataProperties_t m_dataProperties;
+    IfxRsp_Stages m_stages;
+    std::vector<IfxRsp_Signal> m_results;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::condition_variable m_idle;
+    std::deque<Operation> m_operations;
+    bool m_stop;
+    std::vector<std::thread> m_workers;
 };
@@ -80,7 +80,11 @@ public:
 
     inline const std::string &getUuidString()
     {
-        return getIBridge()->getIBridgeControl()->getUuidString();
+        if (m_uuidString.empty())
+        {
+            m_uuidString = getIBridge()->getIBridgeControl()->getUuidString();
+        }
+        return m_uuidString;
     }
 
     STRATA_API std::unique_ptr<BoardInstance> createBoardInstance();
@@ -94,6 +98,9 @@ protected:
 
     std::shared_ptr<IBridge> m_bridge;
 
+    /// UUID of the board, may be set by an enumerator that knows it without opening the bridge
+    std::string m_uuidString;
+
 private:
     void checkBridge();
 
@@ -10,15 +10,30 @@
 #include "BridgeData.hpp"
 #include <platform/exception/EBridgeData.hpp>
 
+#include <algorithm>
+
 BridgeData::BridgeData() :
     m_frameForwarder(&m_frameQueue),
-    m_dataStarted(false)
+    m_dataStarted(false),
+    m_lockFree(false),
+    m_frameQueueSize(0),
+    m_frameQueueLimit(0)
 {
 }
 
 BridgeData::~BridgeData()
 {
     m_frameQueue.stop();
+    m_frameQueueLockFree.stop();
+}
+
+IFrameQueue *BridgeData::activeFrameQueue()
+{
+    if (m_lockFree)
+    {
+        return &m_frameQueueLockFree;
+    }
+    return &m_frameQueue;
 }
 
 void BridgeData::registerListener(IFrameListener<> *listener)
@@ -32,23 +47,95 @@ void BridgeData::setFrameQueueSize(uint16_t count)
     {
         throw EBridgeData("The frame queue size 0 is not allowed");
     }
-    m_frameQueue.setMaxCount(count);
+    if (m_lockFree)
+    {
+        m_frameQueueLockFree.setMaxCount(count);
+    }
+    else
+    {
+        m_frameQueue.setMaxCount(count);
+    }
+    m_frameQueueSize = count;
     //The frame pool must contain one entry more than the queue.
     //When a new frame is received, it needs a frame buffer to be queued
     //before the oldest buffer is released.
-    setFramePoolCount(count + 1);
+    setFramePoolCount(std::max(count, m_frameQueueLimit) + 1);
+}
+
+void BridgeData::setFrameQueuePolicy(FrameQueuePolicy policy)
+{
+    m_frameQueue.setPolicy(policy);
+}
+
+void BridgeData::setFrameQueueAdaptive(uint16_t maxCount)
+{
+    if (maxCount && (maxCount < m_frameQueueSize))
+    {
+        throw EBridgeData("The adaptive frame queue must be able to hold at least the frame queue size");
+    }
+
+    m_frameQueue.setAdaptiveMaxCount(maxCount);
+    m_frameQueueLimit = maxCount;
+    //The pool buffers are handed out last-in first-out, so the ones
+    //only needed for a backlog are not touched as long as there is none.
+    setFramePoolCount(std::max(m_frameQueueSize, m_frameQueueLimit) + 1);
 }
 
 void BridgeData::clearFrameQueue()
 {
-    m_frameQueue.clear();
+    activeFrameQueue()->clear();
+}
+
+void BridgeData::setFrameQueueLockFree(bool lockFree)
+{
+    if (lockFree == m_lockFree)
+    {
+        return;
+    }
+    if (isBridgeDataStarted())
+    {
+        throw EBridgeData("The frame queue can only be changed while streaming is stopped");
+    }
+
+    activeFrameQueue()->clear();
+    m_lockFree = lockFree;
+    if (m_frameQueueSize != 0)
+    {
+        if (m_lockFree)
+        {
+            m_frameQueueLockFree.setMaxCount(m_frameQueueSize);
+        }
+        else
+        {
+            m_frameQueue.setMaxCount(m_frameQueueSize);
+        }
+    }
+    m_frameForwarder.setQueue(activeFrameQueue());
+}
+
+uint32_t BridgeData::getFrameQueueHighWaterMark() const
+{
+    return m_lockFree ? m_frameQueueLockFree.getHighWaterMark() : m_frameQueue.getHighWaterMark();
+}
+
+void BridgeData::resetFrameQueueHighWaterMark()
+{
+    m_frameQueue.resetHighWaterMark();
+    m_frameQueueLockFree.resetHighWaterMark();
 }
 
 void BridgeData::queueFrame(IFrame *frame)
 {
     if (isBridgeDataStarted())
     {
-        m_frameQueue.enqueue(frame);
+        if (m_lockFree)
+        {
+            m_frameQueueLockFree.enqueue(frame);
+        }
+        else
+        {
+            m_frameQueue.enqueue(frame);
+        }
     }
     else
     {
@@ -60,7 +147,7 @@ IFrame *BridgeData::getFrame(uint16_t timeoutMs)
 {
     if (m_dataStarted && !m_frameForwarder.hasListener())
     {
-        return m_frameQueue.blockingDequeue(timeoutMs);
+        return activeFrameQueue()->blockingDequeue(timeoutMs);
     }
     else
     {
@@ -70,7 +157,7 @@ IFrame *BridgeData::getFrame(uint16_t timeoutMs)
 
 void BridgeData::startBridgeData()
 {
-    m_frameQueue.start();
+    activeFrameQueue()->start();
     m_frameForwarder.start();
     m_dataStarted = true;
 }
@@ -78,9 +165,9 @@ void BridgeData::startBridgeData()
 void BridgeData::stopBridgeData()
 {
     m_dataStarted = false;
-    m_frameQueue.stop();
+    activeFrameQueue()->stop();
     m_frameForwarder.stop();
-    m_frameQueue.clear();
+    activeFrameQueue()->clear();
 }
 
 bool BridgeData::isBridgeDataStarted() const
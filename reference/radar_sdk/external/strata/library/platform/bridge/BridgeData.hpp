@@ -12,6 +12,7 @@
 #include <platform/frames/FrameForwarder.hpp>
 #include <platform/frames/FrameListenerCaller.hpp>
 #include <platform/frames/FrameQueue.hpp>
+#include <platform/frames/FrameQueueLockFree.hpp>
 #include <platform/interfaces/IBridgeData.hpp>
 
 class BridgeData :
@@ -24,6 +25,11 @@ public:
 
     void setFrameQueueSize(uint16_t count) override;
     void clearFrameQueue() override;
+    void setFrameQueueLockFree(bool lockFree) override;
+    void setFrameQueuePolicy(FrameQueuePolicy policy) override;
+    void setFrameQueueAdaptive(uint16_t maxCount) override;
+    uint32_t getFrameQueueHighWaterMark() const override;
+    void resetFrameQueueHighWaterMark() override;
 
     void registerListener(IFrameListener<> *listener) override;
 
@@ -43,10 +49,16 @@ protected:
     // In case a direct connection is needed in future, either a parameter can be added to this function
     // or the FrameForwarder is removed here and used outside of this call where necessary.
     FrameQueue m_frameQueue;
+    FrameQueueLockFree m_frameQueueLockFree;
     FrameForwarder m_frameForwarder;
 
 private:
+    IFrameQueue *activeFrameQueue();
+
     std::atomic_bool m_dataStarted;
+    bool m_lockFree;
+    uint16_t m_frameQueueSize;
+    uint16_t m_frameQueueLimit;  //upper limit of the adaptive frame queue, 0 if disabled
 
     /**
      * Set the size of the frame pool
@@ -9,19 +9,50 @@
 
 #include "BridgeEthernetData.hpp"
 
+#include <algorithm>
 #include <array>
 #include <common/Logger.hpp>
 #include <common/Serialization.hpp>
+#include <common/Threads.hpp>
 #include <common/Time.hpp>
 #include <platform/exception/EBridgeData.hpp>
 #include <platform/exception/EProtocol.hpp>
 #include <platform/frames/DebugFrame.hpp>
 #include <platform/frames/ErrorFrame.hpp>
 #include <universal/protocol/protocol_definitions.h>
+#include <vector>
 
 
 //#define BRIDGE_ETHERNET_DATA_DEBUG
 
+// number of datagrams received with one system call, 0 or 1 receives them one by one
+#ifndef STRATA_ETHERNET_DATA_BATCH
+    #define STRATA_ETHERNET_DATA_BATCH 16
+#endif
+
+// has to match the socket implementation
+#ifndef STRATA_ETHERNET_UDP_GRO
+    #define STRATA_ETHERNET_UDP_GRO 0
+#endif
+
+// size of the socket input buffer requested from the system
+#ifndef STRATA_ETHERNET_INPUT_BUFFER_SIZE
+    #define STRATA_ETHERNET_INPUT_BUFFER_SIZE (4 * 1024 * 1024)
+#endif
+
+// number of bytes read from a stream socket with one system call, smaller payloads are parsed from this buffer
+#ifndef STRATA_ETHERNET_STREAM_CHUNK
+    #define STRATA_ETHERNET_STREAM_CHUNK 0xFFFF
+#endif
+
+// options of the stream socket, see ISocket::setStreamOptions()
+#ifndef STRATA_ETHERNET_TCP_NODELAY
+    #define STRATA_ETHERNET_TCP_NODELAY 1
+#endif
+#ifndef STRATA_ETHERNET_TCP_QUICKACK
+    #define STRATA_ETHERNET_TCP_QUICKACK 1
+#endif
+
 
 namespace
 {
@@ -33,16 +64,26 @@ namespace
     constexpr const uint32_t bufferPrefixStart = bufferPrefixSize - frameHeaderSize;
 
     constexpr const uint16_t dataPort   = 55056;
-    constexpr const int inputBufferSize = 4 * 1024 * 1024;
+    constexpr const int inputBufferSize = STRATA_ETHERNET_INPUT_BUFFER_SIZE;
 
     constexpr const uint16_t defaultTimeout = 1000;
+
+    constexpr const uint16_t messageBatch     = STRATA_ETHERNET_DATA_BATCH;
+    constexpr const uint16_t maxCoalescedSize = 0xFFFF;
+
+    constexpr const uint16_t streamChunkSize = STRATA_ETHERNET_STREAM_CHUNK;
+    constexpr const bool streamNoDelay       = STRATA_ETHERNET_TCP_NODELAY;
+    constexpr const bool streamQuickAck      = STRATA_ETHERNET_TCP_QUICKACK;
 }
 
 
 BridgeEthernetData::BridgeEthernetData(ISocket &socket, ipAddress_t ipAddr) :
     m_socket(socket),
-    m_ipAddr {ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]}
+    m_ipAddr {ipAddr[0], ipAddr[1], ipAddr[2], ipAddr[3]},
+    m_streamBegin {0},
+    m_streamEnd {0}
 {
+    resetChannelStatistics();
     openConnection();
 }
 
@@ -56,6 +97,10 @@ void BridgeEthernetData::openConnection()
     m_packetCounter = 0;
     m_socket.open(0, dataPort, m_ipAddr, defaultTimeout);
     m_socket.setInputBufferSize(inputBufferSize);
+    if (m_socket.getMode() == ISocket::Mode::Stream)
+    {
+        m_socket.setStreamOptions(streamNoDelay, streamQuickAck);
+    }
     m_socket.send(nullptr, 0);  // let the board know where to send the data to (anyways, this pipecleaner is needed for receiving to work)
 }
 
@@ -76,6 +121,31 @@ void BridgeEthernetData::setFramePoolCount(uint16_t count)
     m_framePool.setFrameCount(count);
 }
 
+BridgeEthernetData::ChannelStatistics BridgeEthernetData::getChannelStatistics(uint8_t channel) const
+{
+    const auto &counters = m_statistics[channel];
+
+    ChannelStatistics statistics;
+    statistics.packets       = counters.packets.load(std::memory_order_relaxed);
+    statistics.bytes         = counters.bytes.load(std::memory_order_relaxed);
+    statistics.frames        = counters.frames.load(std::memory_order_relaxed);
+    statistics.lostPackets   = counters.lostPackets.load(std::memory_order_relaxed);
+    statistics.droppedFrames = counters.droppedFrames.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void BridgeEthernetData::resetChannelStatistics()
+{
+    for (auto &counters : m_statistics)
+    {
+        counters.packets       = 0;
+        counters.bytes         = 0;
+        counters.frames        = 0;
+        counters.lostPackets   = 0;
+        counters.droppedFrames = 0;
+    }
+}
+
 void BridgeEthernetData::startStreaming()
 {
     if (isBridgeDataStarted())
@@ -101,6 +171,9 @@ void BridgeEthernetData::startStreaming()
             m_dataThread = std::thread(&BridgeEthernetData::dataThreadFunctionDatagrams, this);
             break;
         case ISocket::Mode::Stream:
+            m_streamBuffer.resize(streamChunkSize);
+            m_streamBegin = 0;
+            m_streamEnd   = 0;
             m_dataThread = std::thread(&BridgeEthernetData::dataThreadFunctionStreaming, this);
             break;
     }
@@ -130,11 +203,12 @@ void BridgeEthernetData::cleanupStreaming()
     }
 }
 
-void BridgeEthernetData::dataThreadFunctionDatagrams()
+struct BridgeEthernetData::ReceiveState
 {
     IFrame *frame = nullptr;
-    uint8_t *bufBegin, *bufEnd;
-    uint8_t *buf;
+    uint8_t *bufBegin;
+    uint8_t *bufEnd;
+    uint8_t *buf;  // this will point to (frameHeaderSize) bytes before the end of the current data!
 
     bool firstFrame         = true;
     uint64_t epochTimestamp = 0;
@@ -143,209 +217,240 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
     // in our frame buffer, we overwrite the last bytes of the previous packet with the header of the new one.
     // so we have to restore them after reading a new packet, but we don't have to copy the whole payload every time.
     uint8_t backup[frameHeaderSize];
+};
 
-    while (isBridgeDataStarted())
+bool BridgeEthernetData::dequeueReceiveFrame(ReceiveState &state)
+{
+    // try to dequeue frame to read data into
+    state.frame = m_framePool.dequeueFrame();
+    if (!state.frame)
     {
-        if (!frame)
-        {
-            // try to dequeue frame to read data into
-            frame = m_framePool.dequeueFrame();
-            if (!frame)
-            {
-                queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
+        m_statistics[VIRTUAL_CHANNEL_UNDEFINED].droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
+        return false;
+    }
 
-                // try to discard one packet and try again
-                if (m_socket.dumpPacket())
-                {
-                    LOG(DEBUG) << "Data read thread - dumped packet";
-                    m_packetCounter++;
-                }
-                continue;
-            }
+    // prepare frame buffer variables
+    state.bufBegin = state.frame->getBuffer() + bufferPrefixStart;
+    state.bufEnd   = state.bufBegin + state.frame->getBufferSize();
+    state.buf      = state.bufBegin;
+    return true;
+}
 
-            // prepare frame buffer variables
-            bufBegin = frame->getBuffer() + bufferPrefixStart;
-            bufEnd   = bufBegin + frame->getBufferSize();
-            buf      = bufBegin;  // this will point to (frameHeaderSize) bytes before the end of the current data!
-        }
+bool BridgeEthernetData::processPacket(ReceiveState &state, uint16_t returnedSize, uint64_t receiveTime)
+{
+    const auto remainingSize = state.bufEnd - state.buf;
 
-        while (isBridgeDataStarted())
-        {
-            // fill buffer with frame from multiple packets
-            try
-            {
-                const auto remainingSize    = bufEnd - buf;
-                const uint16_t readSize     = (remainingSize > m_socket.maxPayload()) ? m_socket.maxPayload() : static_cast<uint16_t>(remainingSize);
-                const uint16_t returnedSize = m_socket.receive(buf, readSize);
-                if (returnedSize == 0)
-                {
-                    // no packet available, continue while loop
-                    continue;
-                }
+    if (returnedSize == 0)
+    {
+        // no packet available, continue while loop
+        return false;
+    }
 
-                if (returnedSize < frameHeaderSize)
-                {
-                    LOG(DEBUG) << "Data read thread - Packet header incomplete";
-                    continue;
-                }
+    if (returnedSize < frameHeaderSize)
+    {
+        LOG(DEBUG) << "Data read thread - Packet header incomplete";
+        return false;
+    }
 
-                const auto bmPktType = serialToHost<uint8_t>(buf);
-                if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
-                {
-                    LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
-                    continue;
-                }
+    const auto bmPktType = serialToHost<uint8_t>(state.buf);
+    if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
+    {
+        LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
+        return false;
+    }
 
-                const auto bChannel = serialToHost<uint8_t>(buf + 1);
-                if (bmPktType & DATA_FRAME_FLAG_FIRST)
-                {
-                    if (setLocalTimestamp)
-                    {
-                        epochTimestamp = getEpochTime();
-                    }
-                    virtualChannel = bChannel;
-                }
+    const auto bChannel = serialToHost<uint8_t>(state.buf + 1);
+    if (bmPktType & DATA_FRAME_FLAG_FIRST)
+    {
+        if (setLocalTimestamp)
+        {
+            // prefer the time the packet was received by the system over the time it is processed here
+            state.epochTimestamp = receiveTime ? receiveTime : getEpochTime();
+        }
+        state.virtualChannel = bChannel;
+    }
 
-                const auto wLength = serialToHost<uint16_t>(buf + 4);
-                if (returnedSize != frameHeaderSize + wLength)
-                {
-                    if (remainingSize < frameHeaderSize + wLength)
-                    {
-                        queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
-                        LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
-                    }
-                    else
-                    {
-                        LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
-                    }
-                    continue;
-                }
+    const auto wLength = serialToHost<uint16_t>(state.buf + 4);
+    if (returnedSize != frameHeaderSize + wLength)
+    {
+        if (remainingSize < frameHeaderSize + wLength)
+        {
+            queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
+            LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
+        }
+        else
+        {
+            LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
+        }
+        return false;
+    }
 
-                const auto wCounter = serialToHost<uint16_t>(buf + 2);
-                if (firstFrame)
-                {
+    const auto wCounter = serialToHost<uint16_t>(state.buf + 2);
+    if (state.firstFrame)
+    {
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                    if (wCounter != m_packetCounter)
-                    {
-                        LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
-                    }
+        if (wCounter != m_packetCounter)
+        {
+            LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+        }
 #endif
-                    firstFrame      = false;
-                    m_packetCounter = wCounter + 1;
-                }
-                else if (wCounter != m_packetCounter)
-                {
-                    LOG(INFO) << "Data read thread - Packet loss";
+        state.firstFrame = false;
+        m_packetCounter  = wCounter + 1;
+    }
+    else if (wCounter != m_packetCounter)
+    {
+        LOG(INFO) << "Data read thread - Packet loss";
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                    LOG(DEBUG) << "     counter mismatch: received = 0x" << std::hex << wCounter << " , expected = 0x" << m_packetCounter;
+        LOG(DEBUG) << "     counter mismatch: received = 0x" << std::hex << wCounter << " , expected = 0x" << m_packetCounter;
 #endif
-                    m_packetCounter = wCounter + 1;
+        auto &statistics = m_statistics[bChannel];
+        statistics.lostPackets.fetch_add(static_cast<uint16_t>(wCounter - m_packetCounter), std::memory_order_relaxed);
+        statistics.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        m_packetCounter = wCounter + 1;
 
-                    queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+        queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
 
-                    if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
-                    {
-                        // if this was a follow-up frame, discard the whole already received part
-                        buf = bufBegin;
+        if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
+        {
+            // if this was a follow-up frame, discard the whole already received part
+            state.buf = state.bufBegin;
 
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding current frame";
+            LOG(DEBUG) << "Data read thread - discarding current frame";
 #endif
-                        continue;
-                    }
-                }
-                else
-                {
-                    m_packetCounter++;
-                }
+            return false;
+        }
+    }
+    else
+    {
+        m_packetCounter++;
+    }
 
-                if (bmPktType & DATA_FRAME_FLAG_FIRST)
-                {
-                    if (buf != bufBegin)
-                    {
-                        // we already started receiving a frame, but now a new frame starts
-                        // copy received payload to the beginning of buffer, to try to continue with new frame
-                        std::copy(buf + frameHeaderSize, buf + frameHeaderSize + wLength, bufBegin);
-                        buf = bufBegin;  // continue normally for a single/first packet
+    if (bmPktType & DATA_FRAME_FLAG_FIRST)
+    {
+        if (state.buf != state.bufBegin)
+        {
+            // we already started receiving a frame, but now a new frame starts
+            // copy received payload to the beginning of buffer, to try to continue with new frame
+            std::copy(state.buf + frameHeaderSize, state.buf + frameHeaderSize + wLength, state.bufBegin);
+            state.buf = state.bufBegin;  // continue normally for a single/first packet
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
+            LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
 #endif
-                    }
-                }
-                else
-                {
-                    if (buf == bufBegin)
-                    {
-                        // we expected a new frame, but we received a follow-up packet
+        }
+    }
+    else
+    {
+        if (state.buf == state.bufBegin)
+        {
+            // we expected a new frame, but we received a follow-up packet
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
+            LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
 #endif
-                        continue;  // don't do anything with the received packet and start over
-                    }
+            return false;  // don't do anything with the received packet and start over
+        }
 
-                    if (virtualChannel != bChannel)
-                    {
+        if (state.virtualChannel != bChannel)
+        {
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(virtualChannel);
+            LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(state.virtualChannel);
 #endif
-                        continue;  // don't do anything with the received packet and start over
-                    }
+            return false;  // don't do anything with the received packet and start over
+        }
 
-                    // restore backup of previous packet, since we overwrote it with the beginning of the current packet
-                    std::copy(backup, backup + frameHeaderSize, buf);
-                }
+        // restore backup of previous packet, since we overwrote it with the beginning of the current packet
+        std::copy(state.backup, state.backup + frameHeaderSize, state.buf);
+    }
 
-                buf += wLength;
+    auto &statistics = m_statistics[bChannel];
+    statistics.packets.fetch_add(1, std::memory_order_relaxed);
+    statistics.bytes.fetch_add(wLength, std::memory_order_relaxed);
 
-                if (bmPktType & DATA_FRAME_FLAG_LAST)
-                {
-                    if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
-                    {
-                        buf -= sizeof(epochTimestamp);
-                        if (!setLocalTimestamp)
-                        {
-                            serialToHost(buf + frameHeaderSize, epochTimestamp);
-                        }
-                    }
-                    else if (!setLocalTimestamp)
-                    {
-                        epochTimestamp = 0;
-                    }
+    state.buf += wLength;
 
-                    if (bmPktType & DATA_FRAME_FLAG_ERROR)
-                    {
-                        uint32_t code;
-                        const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(epochTimestamp) : 0);
-                        if (wLength == errorFrameLength)
-                        {
-                            buf -= sizeof(code);
-                            serialToHost(buf + frameHeaderSize, code);
-                            queueFrame(ErrorFrame::create(code, bChannel, epochTimestamp));
-                        }
-                        else
-                        {
-                            buf -= wLength;
-                            DebugFrame::log(buf + frameHeaderSize, wLength, epochTimestamp);
-                        }
-                        buf = bufBegin;
-                    }
-                    else
-                    {
-                        frame->setDataOffset(bufferPrefixSize);
-                        frame->setDataSize(static_cast<uint32_t>(buf - bufBegin));
-                        frame->setVirtualChannel(virtualChannel);
-                        frame->setTimestamp(epochTimestamp);
+    if (bmPktType & DATA_FRAME_FLAG_LAST)
+    {
+        if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
+        {
+            state.buf -= sizeof(state.epochTimestamp);
+            if (!setLocalTimestamp)
+            {
+                serialToHost(state.buf + frameHeaderSize, state.epochTimestamp);
+            }
+        }
+        else if (!setLocalTimestamp)
+        {
+            state.epochTimestamp = 0;
+        }
 
-                        queueFrame(frame);
-                        frame = nullptr;
-                    }
+        if (bmPktType & DATA_FRAME_FLAG_ERROR)
+        {
+            uint32_t code;
+            const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(state.epochTimestamp) : 0);
+            if (wLength == errorFrameLength)
+            {
+                state.buf -= sizeof(code);
+                serialToHost(state.buf + frameHeaderSize, code);
+                queueFrame(ErrorFrame::create(code, bChannel, state.epochTimestamp));
+            }
+            else
+            {
+                state.buf -= wLength;
+                DebugFrame::log(state.buf + frameHeaderSize, wLength, state.epochTimestamp);
+            }
+            state.buf = state.bufBegin;
+        }
+        else
+        {
+            state.frame->setDataOffset(bufferPrefixSize);
+            state.frame->setDataSize(static_cast<uint32_t>(state.buf - state.bufBegin));
+            state.frame->setVirtualChannel(state.virtualChannel);
+            state.frame->setTimestamp(state.epochTimestamp);
+
+            statistics.frames.fetch_add(1, std::memory_order_relaxed);
+            queueFrame(state.frame);
+            state.frame = nullptr;
+        }
 
-                    break;
-                }
-                else
+        return true;
+    }
+    else
+    {
+        // save backup of current packet, since it will be overwritten by next packet
+        std::copy(state.buf, state.buf + frameHeaderSize, state.backup);
+    }
+
+    return false;
+}
+
+void BridgeEthernetData::readDatagrams(ReceiveState &state)
+{
+    while (isBridgeDataStarted())
+    {
+        if (!state.frame && !dequeueReceiveFrame(state))
+        {
+            // try to discard one packet and try again
+            if (m_socket.dumpPacket())
+            {
+                LOG(DEBUG) << "Data read thread - dumped packet";
+                m_packetCounter++;
+            }
+            continue;
+        }
+
+        while (isBridgeDataStarted())
+        {
+            // fill buffer with frame from multiple packets
+            try
+            {
+                const auto remainingSize    = state.bufEnd - state.buf;
+                const uint16_t readSize     = (remainingSize > m_socket.maxPayload()) ? m_socket.maxPayload() : static_cast<uint16_t>(remainingSize);
+                const uint16_t returnedSize = m_socket.receive(state.buf, readSize);
+
+                if (processPacket(state, returnedSize, 0))
                 {
-                    // save backup of current packet, since it will be overwritten by next packet
-                    std::copy(buf, buf + frameHeaderSize, backup);
+                    break;
                 }
             }
             catch (const std::exception &e)
@@ -355,16 +460,102 @@ void BridgeEthernetData::dataThreadFunctionDatagrams()
             }
         }
     }
+}
+
+void BridgeEthernetData::handleDatagram(ReceiveState &state, const uint8_t *datagram, uint16_t length, uint64_t receiveTime)
+{
+    if (!state.frame && !dequeueReceiveFrame(state))
+    {
+        // discard the packet, the next ones are already received
+        LOG(DEBUG) << "Data read thread - dumped packet";
+        m_packetCounter++;
+        return;
+    }
+
+    // the data starts where receive() would have put it,
+    // clipped like a read limited to the remaining buffer
+    const auto remainingSize = state.bufEnd - state.buf;
+    const auto returnedSize  = (length > remainingSize) ? static_cast<uint16_t>(remainingSize) : length;
+    std::copy(datagram, datagram + returnedSize, state.buf);
+
+    try
+    {
+        processPacket(state, returnedSize, receiveTime);
+    }
+    catch (const std::exception &e)
+    {
+        queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
+        LOG(DEBUG) << "Data read thread - " << e.what();
+    }
+}
+
+void BridgeEthernetData::readMessages(ReceiveState &state)
+{
+    // every message is received into its own buffer, since the position in the
+    // frame buffer depends on the length of the packets before
+    const uint16_t messageSize = STRATA_ETHERNET_UDP_GRO ? maxCoalescedSize : m_socket.maxPayload();
+    std::vector<uint8_t> buffers(messageBatch * messageSize);
+    std::vector<ISocket::Message> messages(messageBatch);
+
+    while (isBridgeDataStarted())
+    {
+        try
+        {
+            for (uint16_t i = 0; i < messageBatch; i++)
+            {
+                messages[i].buffer = &buffers[i * messageSize];
+                messages[i].size   = messageSize;
+            }
+
+            const auto count = m_socket.receiveMessages(messages.data(), messageBatch);
+            for (uint16_t i = 0; i < count; i++)
+            {
+                const auto &message    = messages[i];
+                const auto receiveTime = message.timestamp / 1000;  // in microseconds, like getEpochTime()
+
+                // split datagrams coalesced by the system
+                const auto segmentSize = message.segmentSize ? message.segmentSize : message.length;
+                for (uint16_t offset = 0; offset < message.length; offset += segmentSize)
+                {
+                    const uint16_t length = std::min<uint16_t>(segmentSize, message.length - offset);
+                    handleDatagram(state, message.buffer + offset, length, receiveTime);
+                }
+            }
+        }
+        catch (const std::exception &e)
+        {
+            queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
+            LOG(DEBUG) << "Data read thread - " << e.what();
+        }
+    }
+}
+
+void BridgeEthernetData::dataThreadFunctionDatagrams()
+{
+    StrataThreads::apply(StrataThreads::Data, "udp");
+
+    ReceiveState state;
+
+    if (messageBatch > 1)
+    {
+        readMessages(state);
+    }
+    else
+    {
+        readDatagrams(state);
+    }
 
     // if we own a dequeued frame buffer, make sure we return it
-    if (frame)
+    if (state.frame)
     {
-        m_framePool.queueFrame(frame);
+        m_framePool.queueFrame(state.frame);
     }
 }
 
 void BridgeEthernetData::dataThreadFunctionStreaming()
 {
+    StrataThreads::apply(StrataThreads::Data, "tcp");
+
     uint8_t header[frameHeaderSize];
     IFrame *frame   = nullptr;
     State state     = WaitForFrameStart;
@@ -474,6 +665,10 @@ bool BridgeEthernetData::checkCounter(bool &firstFrame, uint16_t actualCounter,
     }
     else if (actualCounter != expectedCounter)
     {
+        auto &statistics = m_statistics[channel];
+        statistics.lostPackets.fetch_add(static_cast<uint16_t>(actualCounter - expectedCounter), std::memory_order_relaxed);
+        statistics.droppedFrames.fetch_add(1, std::memory_order_relaxed);
+
         LOG(INFO) << "Data read thread - Packet loss";
 #ifdef BRIDGE_ETHERNET_DATA_DEBUG
         LOG(DEBUG) << "    Packet loss, counter mismatch: received = 0x" << std::hex << actualCounter << " , current = 0x" << expectedCounter;
@@ -496,6 +691,10 @@ BridgeEthernetData::State BridgeEthernetData::receivePayload(IFrame *&frame, uin
     if (!receive(frame->getData() + frame->getDataSize(), length))
         return WaitForFrameStart;
 
+    auto &statistics = m_statistics[frame->getVirtualChannel()];
+    statistics.packets.fetch_add(1, std::memory_order_relaxed);
+    statistics.bytes.fetch_add(length, std::memory_order_relaxed);
+
     const bool hasTimeStamp      = bmPktType & DATA_FRAME_FLAG_TIMESTAMP;
     constexpr auto timeStampSize = sizeof(frame->getTimestamp());
     frame->setDataSize(frame->getDataSize() + length - (hasTimeStamp ? timeStampSize : 0));
@@ -525,6 +724,7 @@ BridgeEthernetData::State BridgeEthernetData::receivePayload(IFrame *&frame, uin
         }
         else
         {
+            statistics.frames.fetch_add(1, std::memory_order_relaxed);
             queueFrame(frame);
             frame = nullptr;
         }
@@ -538,23 +738,53 @@ BridgeEthernetData::State BridgeEthernetData::receivePayload(IFrame *&frame, uin
 
 bool BridgeEthernetData::receive(uint8_t *buffer, uint16_t length)
 {
-    uint16_t bytesRetrieved = 0U;
+    uint16_t bytesRetrieved = takeBuffered(buffer, length);
     while (isBridgeDataStarted() && bytesRetrieved < length)
     {
-        bytesRetrieved += m_socket.receive(buffer + bytesRetrieved, length - bytesRetrieved);
+        const uint16_t remaining = length - bytesRetrieved;
+        if (remaining >= m_streamBuffer.size() / 2)
+        {
+            // large payloads are received directly into the frame to avoid copying them
+            bytesRetrieved += m_socket.receive(buffer + bytesRetrieved, remaining);
+        }
+        else if (fillBuffer())
+        {
+            // headers and small payloads are taken from one large read to save system calls
+            bytesRetrieved += takeBuffered(buffer + bytesRetrieved, remaining);
+        }
     }
 
     return bytesRetrieved == length;
 }
 
-void BridgeEthernetData::dropPayload(uint16_t length)
+uint16_t BridgeEthernetData::takeBuffered(uint8_t *buffer, uint16_t length)
 {
-    std::array<uint8_t, 512> dropBuffer;
+    const uint16_t count = std::min(static_cast<uint16_t>(m_streamEnd - m_streamBegin), length);
+    if (buffer != nullptr)
+    {
+        std::copy_n(m_streamBuffer.data() + m_streamBegin, count, buffer);
+    }
+    m_streamBegin += count;
+    return count;
+}
 
+bool BridgeEthernetData::fillBuffer()
+{
+    // only called when all buffered data has been taken
+    m_streamBegin = 0;
+    m_streamEnd   = m_socket.receive(m_streamBuffer.data(), static_cast<uint16_t>(m_streamBuffer.size()));
+    return m_streamEnd > 0;
+}
+
+void BridgeEthernetData::dropPayload(uint16_t length)
+{
+    length -= takeBuffered(nullptr, length);
     while (isBridgeDataStarted() && length > 0)
     {
-        const uint16_t bytesToRetrieve = std::min(static_cast<uint16_t>(dropBuffer.size()), length);
-        length -= m_socket.receive(dropBuffer.data(), bytesToRetrieve);
+        if (fillBuffer())
+        {
+            length -= takeBuffered(nullptr, length);
+        }
     }
 }
 
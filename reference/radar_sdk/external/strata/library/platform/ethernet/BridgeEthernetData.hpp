@@ -10,12 +10,14 @@
 #pragma once
 
 #include <platform/bridge/BridgeData.hpp>
-#include <platform/frames/FramePool.hpp>
+#include <platform/frames/FramePoolLockFree.hpp>
 #include <platform/interfaces/link/ISocket.hpp>
 #include <universal/data_definitions.h>
 
+#include <array>
 #include <atomic>
 #include <thread>
+#include <vector>
 
 
 class BridgeEthernetData :
@@ -34,15 +36,50 @@ public:
     void startStreaming() override;
     void stopStreaming() override;
 
+    /**
+     * Counters of the data received on one virtual channel, to monitor losses and throughput.
+     * Errors not related to a channel are counted on VIRTUAL_CHANNEL_UNDEFINED.
+     */
+    struct ChannelStatistics
+    {
+        uint64_t packets;        //packets received in sequence
+        uint64_t bytes;          //payload bytes of these packets
+        uint64_t frames;         //frames queued
+        uint64_t lostPackets;    //packets missing in the sequence of packet counters
+        uint64_t droppedFrames;  //frames not queued due to packet loss or a depleted frame pool
+    };
+
+    /**
+     * The counters are updated by the data thread while streaming, so they can be read at any time.
+     * The throughput results from the difference of two readings.
+     */
+    ChannelStatistics getChannelStatistics(uint8_t channel) const;
+    void resetChannelStatistics();
+
 private:
     void cleanupStreaming();
 
-    FramePool m_framePool;
+    FramePoolLockFree m_framePool;
     ISocket &m_socket;
     uint8_t m_ipAddr[4];
     std::thread m_dataThread;
     uint16_t m_packetCounter;
 
+    struct ChannelCounters
+    {
+        std::atomic<uint64_t> packets;
+        std::atomic<uint64_t> bytes;
+        std::atomic<uint64_t> frames;
+        std::atomic<uint64_t> lostPackets;
+        std::atomic<uint64_t> droppedFrames;
+    };
+    std::array<ChannelCounters, 256> m_statistics;
+
+    // stream receive buffer, holding data received in advance of the packet currently processed
+    std::vector<uint8_t> m_streamBuffer;
+    uint16_t m_streamBegin;
+    uint16_t m_streamEnd;
+
     // Variables used by frame streaming
 
     enum State
@@ -52,11 +89,21 @@ private:
         DropFrame,
     };
 
+    // datagram receiving
+    struct ReceiveState;
+    bool dequeueReceiveFrame(ReceiveState &state);
+    bool processPacket(ReceiveState &state, uint16_t returnedSize, uint64_t receiveTime);
+    void readDatagrams(ReceiveState &state);
+    void readMessages(ReceiveState &state);
+    void handleDatagram(ReceiveState &state, const uint8_t *datagram, uint16_t length, uint64_t receiveTime);
+
     void dataThreadFunctionDatagrams();
     void dataThreadFunctionStreaming();
     bool checkCounter(bool &firstFrame, uint16_t actualCounter, uint16_t expectedCounter, uint8_t channel);
     State receivePayload(IFrame *&frame, uint16_t length, uint8_t bmPktType);
     bool receive(uint8_t *buffer, uint16_t length);
+    uint16_t takeBuffered(uint8_t *buffer, uint16_t length);
+    bool fillBuffer();
     void dropPayload(uint16_t length);
     State handleFirstPacket(IFrame *&frame, uint8_t bmPktType, uint8_t bChannel, uint16_t wLength);
 };
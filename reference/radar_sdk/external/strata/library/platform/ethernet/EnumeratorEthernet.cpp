@@ -17,6 +17,12 @@
 #include <platform/templates/identifyBoardFunction.hpp>
 #include <universal/protocol/protocol_definitions.h>
 
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+
 
 namespace
 {
@@ -37,6 +43,27 @@ namespace
     constexpr const uint16_t wIndex           = 0;
     constexpr const uint16_t wLengthSend      = 0;
     constexpr const uint16_t maxLengthReceive = sizeof(IBridgeControl::BoardInfo_t);
+
+    // Boards which answered an enumeration within this time are reported from the cache
+    constexpr const uint16_t knownBoardLifetime = 2000;
+
+    struct KnownBoard
+    {
+        remoteInfo_t remote;
+        uint16_t vid;
+        uint16_t pid;
+        std::string name;
+        std::chrono::steady_clock::time_point seen;
+    };
+
+    // Boards found by any enumerator of this process, by IP address
+    std::mutex knownBoardsMutex;
+    std::map<uint32_t, KnownBoard> knownBoards;
+
+    inline uint32_t ipKey(const ipAddress_t &ip)
+    {
+        return (static_cast<uint32_t>(ip[0]) << 24) | (ip[1] << 16) | (ip[2] << 8) | ip[3];
+    }
 }
 
 EnumeratorEthernet::EnumeratorEthernet(bool useTcpConnection) :
@@ -60,18 +87,69 @@ void EnumeratorEthernet::enumerate(IEnumerationListener &listener, BoardData::co
     if (broadcastAddresses.empty())
     {
         LOG(DEBUG) << "Could not get broadcast addresses, using default";
-        sendBroadcast(defaultBroadcastAddresses);
+        broadcastAddresses = defaultBroadcastAddresses;
     }
-    else
+
+    // known boards are also asked directly, in case broadcasts do not reach them
     {
-        sendBroadcast(broadcastAddresses);
+        std::lock_guard<std::mutex> lock(knownBoardsMutex);
+        for (const auto &known : knownBoards)
+        {
+            broadcastAddresses.push_back(known.second.remote);
+        }
     }
 
-    getResponses(listener, begin, end);
+    // all requests are sent before waiting, so the boards on all interfaces answer concurrently
+    const auto start = std::chrono::steady_clock::now();
+    sendBroadcast(broadcastAddresses);
+
+    std::set<uint32_t> reported;
+    if (!reportKnownBoards(listener, begin, end, reported) && !getResponses(listener, begin, end, reported))
+    {
+        // the whole timeout passed, so boards which did not answer are gone
+        std::lock_guard<std::mutex> lock(knownBoardsMutex);
+        for (auto it = knownBoards.begin(); it != knownBoards.end();)
+        {
+            it = (it->second.seen < start) ? knownBoards.erase(it) : std::next(it);
+        }
+    }
 
     m_socket.close();
 }
 
+inline bool EnumeratorEthernet::reportKnownBoards(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end, std::set<uint32_t> &reported)
+{
+    std::vector<KnownBoard> boards;
+    {
+        const auto now = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> lock(knownBoardsMutex);
+        for (const auto &known : knownBoards)
+        {
+            if (now - known.second.seen < std::chrono::milliseconds(knownBoardLifetime))
+            {
+                boards.push_back(known.second);
+            }
+        }
+    }
+
+    for (auto &board : boards)
+    {
+        LOG(DEBUG) << "... known board at " << std::dec
+                   << static_cast<int>(board.remote.ip[0]) << "."
+                   << static_cast<int>(board.remote.ip[1]) << "."
+                   << static_cast<int>(board.remote.ip[2]) << "."
+                   << static_cast<int>(board.remote.ip[3]);
+
+        reported.insert(ipKey(board.remote.ip));
+        auto descriptor = identifyBoardFunction<BoardDescriptorEthernet>(begin, end, board.vid, board.pid, board.name.c_str(), board.remote.ip, m_useTcpConnection);
+        if (listener.onEnumerate(std::move(descriptor)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 inline void EnumeratorEthernet::sendBroadcast(const std::vector<remoteInfo_t> &broadcastAddresses)
 {
     const uint8_t packet[m_commandHeaderSize] = {
@@ -101,7 +179,7 @@ inline void EnumeratorEthernet::sendBroadcast(const std::vector<remoteInfo_t> &b
     }
 }
 
-inline void EnumeratorEthernet::getResponses(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end)
+inline bool EnumeratorEthernet::getResponses(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end, std::set<uint32_t> &reported)
 {
     const auto expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
 
@@ -155,10 +233,27 @@ inline void EnumeratorEthernet::getResponses(IEnumerationListener &listener, Boa
             const uint16_t &vid = ids[0], &pid = ids[1];
             LOG(DEBUG) << "... VID = " << std::hex << vid << " ; PID = " << pid << " ; name = \"" << cName << "\"";
 
+            const auto key = ipKey(remote.ip);
+            {
+                std::lock_guard<std::mutex> lock(knownBoardsMutex);
+                auto &known  = knownBoards[key];
+                known.remote = remote;
+                known.vid    = vid;
+                known.pid    = pid;
+                known.name   = cName;
+                known.seen   = std::chrono::steady_clock::now();
+            }
+
+            // a board answering both the broadcast and the direct request, or reported from the cache
+            if (!reported.insert(key).second)
+            {
+                continue;
+            }
+
             auto descriptor = identifyBoardFunction<BoardDescriptorEthernet>(begin, end, vid, pid, cName, remote.ip, m_useTcpConnection);
             if (listener.onEnumerate(std::move(descriptor)))
             {
-                break;
+                return true;
             }
         }
         catch (const EException &e)
@@ -166,4 +261,5 @@ inline void EnumeratorEthernet::getResponses(IEnumerationListener &listener, Boa
             LOG(DEBUG) << "... handled " << e.what();
         }
     }
+    return false;
 }
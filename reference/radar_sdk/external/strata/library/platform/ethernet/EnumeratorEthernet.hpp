@@ -12,6 +12,8 @@
 #include <platform/ethernet/SocketUdp.hpp>
 #include <platform/interfaces/IEnumerator.hpp>
 
+#include <set>
+
 
 class EnumeratorEthernet :
     public IEnumerator
@@ -21,6 +23,11 @@ public:
      * Enumeration is always done in UDP mode as broadcasting is not possible using TCP
      * But when a board is found, it can then be controlled via either UDP or TCP
      * The useTcpConnection parameter defines this.
+     *
+     * Boards are passed to the listener as their responses arrive. Boards which answered
+     * an enumeration of this process shortly before are passed immediately from a cache,
+     * before any response arrived, and are asked directly in addition to the broadcast.
+     * Enumeration ends as soon as the listener returns true, otherwise after the timeout.
      */
     EnumeratorEthernet(bool useTcpConnection);
 
@@ -34,7 +41,8 @@ protected:
 
 private:
     inline void sendBroadcast(const std::vector<remoteInfo_t> &broadcastAddresses);
-    inline void getResponses(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end);
+    inline bool reportKnownBoards(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end, std::set<uint32_t> &reported);
+    inline bool getResponses(IEnumerationListener &listener, BoardData::const_iterator begin, BoardData::const_iterator end, std::set<uint32_t> &reported);
 
     SocketUdp m_socket;
     bool m_useTcpConnection;
@@ -187,6 +187,11 @@ void BridgeFpgaIrpli::clearFrameQueue()
     m_bridgeData->clearFrameQueue();
 }
 
+void BridgeFpgaIrpli::setFrameQueueLockFree(bool lockFree)
+{
+    m_bridgeData->setFrameQueueLockFree(lockFree);
+}
+
 void BridgeFpgaIrpli::onNewFrame(IFrame *frame)
 {
     //    const bool crcWorkaround = false;
@@ -41,6 +41,7 @@ public:
     void setFrameBufferSize(uint32_t size) override;
     void setFrameQueueSize(uint16_t count) override;
     void clearFrameQueue() override;
+    void setFrameQueueLockFree(bool lockFree) override;
     void registerListener(IFrameListener<> *listener) override;
     IFrame *getFrame(uint16_t timeoutMs) override;
 
@@ -14,8 +14,11 @@
 
 void DebugFrame::log(uint8_t *payload, uint32_t length, uint64_t timestamp)
 {
-    auto message = reinterpret_cast<char *>(payload);
-    auto log     = LOG(DEBUG);
-    log << "[REMOTE] " << timestamp / 1000 << " : ";
-    log.write(message, length);
+    if (Logger::LOG_DEBUG <= LOG_LEVEL_COMPILED)
+    {
+        auto message = reinterpret_cast<char *>(payload);
+        auto log     = LoggerInstance.log(Logger::LOG_DEBUG);
+        log << "[REMOTE] " << timestamp / 1000 << " : ";
+        log.write(message, length);
+    }
 }
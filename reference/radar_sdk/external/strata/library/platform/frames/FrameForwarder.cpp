@@ -8,6 +8,7 @@
  */
 
 #include "FrameForwarder.hpp"
+#include <common/Threads.hpp>
 
 
 FrameForwarder::FrameForwarder(IFrameQueue *queue) :
@@ -77,6 +78,18 @@ void FrameForwarder::stop()
     }
 }
 
+void FrameForwarder::setQueue(IFrameQueue *queue)
+{
+    const bool wasRunning = m_isRunning;
+    stop();
+    waitForThreadReturn();
+    m_queue = queue;
+    if (wasRunning)
+    {
+        start();
+    }
+}
+
 void FrameForwarder::waitForThreadReturn()
 {
     /// to avoid a blocking call to join(), we detach() the thread.
@@ -91,6 +104,8 @@ void FrameForwarder::waitForThreadReturn()
 
 void FrameForwarder::forwardingThreadFunction()
 {
+    StrataThreads::apply(StrataThreads::Forwarding, "forward");
+
     do
     {
         auto *frame = m_queue->blockingDequeue();
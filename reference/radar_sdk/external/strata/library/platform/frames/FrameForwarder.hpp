@@ -34,6 +34,11 @@ public:
     void start();
     void stop();
 
+    /**
+     * Forward frames from another queue. The queue forwarded so far must be stopped.
+     */
+    void setQueue(IFrameQueue *queue);
+
 private:
     void startForwardingThread();
     void waitForThreadReturn();
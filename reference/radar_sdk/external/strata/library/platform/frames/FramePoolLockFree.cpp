@@ -0,0 +1,440 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "FramePoolLockFree.hpp"
+#include "FrameBase.hpp"
+
+#include <common/Logger.hpp>
+#include <common/exception/EGenericException.hpp>
+#include <stdexcept>
+#include <thread>
+
+#if defined(_WIN32)
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+
+namespace
+{
+    const uint32_t emptyIndex = 0xFFFFFFFF;
+
+    // buffers start on separate cache lines
+    const size_t bufferAlignment = 64;
+
+    enum Allocation
+    {
+        Allocation_None,
+        Allocation_Default,
+        Allocation_LargePages,
+    };
+
+    uint64_t makeTop(uint64_t top, uint32_t index)
+    {
+        return (((top >> 32) + 1) << 32) | index;
+    }
+
+    uint32_t topIndex(uint64_t top)
+    {
+        return static_cast<uint32_t>(top);
+    }
+
+    size_t roundUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // The memory is not touched here, so the first write of the receiving thread
+    // places the pages on its NUMA node.
+    uint8_t *allocateBuffers(size_t &size, int &allocation)
+    {
+#if defined(_WIN32)
+        const auto largePage = GetLargePageMinimum();
+        if (largePage && (size >= largePage))
+        {
+            // needs the "Lock pages in memory" privilege, fall back silently otherwise
+            const auto largeSize = roundUp(size, largePage);
+            auto buffers         = VirtualAlloc(nullptr, largeSize, MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE);
+            if (buffers)
+            {
+                size       = largeSize;
+                allocation = Allocation_LargePages;
+                return static_cast<uint8_t *>(buffers);
+            }
+        }
+
+        auto buffers = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        if (buffers == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        allocation = Allocation_Default;
+        return static_cast<uint8_t *>(buffers);
+#elif defined(__linux__)
+        const size_t hugePage = 2 * 1024 * 1024;
+        if (size >= hugePage)
+        {
+            // only succeeds with huge pages reserved in /proc/sys/vm/nr_hugepages
+            const auto largeSize = roundUp(size, hugePage);
+            auto buffers         = mmap(nullptr, largeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (buffers != MAP_FAILED)
+            {
+                size       = largeSize;
+                allocation = Allocation_LargePages;
+                return static_cast<uint8_t *>(buffers);
+            }
+        }
+
+        auto buffers = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buffers == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        if (size >= hugePage)
+        {
+            // transparent huge pages, if enabled for madvise
+            madvise(buffers, size, MADV_HUGEPAGE);
+        }
+        allocation = Allocation_Default;
+        return static_cast<uint8_t *>(buffers);
+#else
+        allocation = Allocation_Default;
+        return reinterpret_cast<uint8_t *>(new uint64_t[roundUp(size, sizeof(uint64_t)) / sizeof(uint64_t)]);
+#endif
+    }
+
+    void freeBuffers(uint8_t *buffers, size_t size, int allocation)
+    {
+        if (allocation == Allocation_None)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        (void)size;
+        VirtualFree(buffers, 0, MEM_RELEASE);
+#elif defined(__linux__)
+        munmap(buffers, size);
+#else
+        (void)size;
+        delete[] reinterpret_cast<uint64_t *>(buffers);
+#endif
+    }
+}
+
+
+/**
+ * A frame whose buffer is part of the pool's allocation
+ */
+class FramePoolLockFree::PoolFrame :
+    public FrameBase
+{
+public:
+    PoolFrame(FramePoolLockFree *owner, uint32_t index, uint8_t *buffer, uint32_t bufferSize) :
+        m_owner {owner},
+        m_index {index},
+        m_next {emptyIndex},
+        m_queued {true},
+        m_buffer {buffer},
+        m_offset {0},
+        m_dataSize {0},
+        m_bufferSize {bufferSize}
+    {
+    }
+
+    /* Release the frame from the pool */
+    void unpool()
+    {
+        m_owner = nullptr;
+    }
+
+    //IFrame
+    uint8_t *getData() const override
+    {
+        return m_buffer + m_offset;
+    }
+
+    uint32_t getDataSize() const override
+    {
+        return m_dataSize;
+    }
+
+    void setDataOffset(uint32_t offset) override
+    {
+        if (m_dataSize + offset > m_bufferSize)
+        {
+            throw std::out_of_range("Buffer too small");
+        }
+
+        m_offset = offset;
+    }
+
+    void setDataSize(uint32_t dataSize) override
+    {
+        if (dataSize + m_offset > m_bufferSize)
+        {
+            throw std::out_of_range("Buffer too small");
+        }
+
+        m_dataSize = dataSize;
+    }
+
+    void setDataOffsetAndSize(uint32_t offset, uint32_t dataSize) override
+    {
+        if (dataSize + offset > m_bufferSize)
+        {
+            throw std::out_of_range("Buffer too small");
+        }
+
+        m_offset   = offset;
+        m_dataSize = dataSize;
+    }
+
+    uint32_t getDataOffset() const override
+    {
+        return m_offset;
+    }
+
+    uint8_t *getBuffer() const override
+    {
+        return m_buffer;
+    }
+
+    uint32_t getBufferSize() const override
+    {
+        return m_bufferSize;
+    }
+
+    uint32_t getStatusCode() const override
+    {
+        return 0;
+    }
+
+    FramePoolLockFree *m_owner;
+    const uint32_t m_index;
+    std::atomic<uint32_t> m_next;  //index of the frame below on the stack
+    std::atomic<bool> m_queued;
+
+protected:
+    void queue() override
+    {
+        if (m_owner != nullptr)
+        {
+            m_owner->queueFrame(this);
+        }
+    }
+
+private:
+    uint8_t *m_buffer;
+
+    uint32_t m_offset;
+    uint32_t m_dataSize;
+    uint32_t m_bufferSize;
+};
+
+
+FramePoolLockFree::FramePoolLockFree() :
+    m_size {0},
+    m_count {0},
+    m_buffers {nullptr},
+    m_buffersSize {0},
+    m_allocation {Allocation_None},
+    m_top {emptyIndex},
+    m_users {0},
+    m_configuring {false}
+{
+}
+
+FramePoolLockFree::~FramePoolLockFree()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    releaseBuffers();
+}
+
+void FramePoolLockFree::releaseBuffers()
+{
+    // If any of the buffers aren't queued then something else is still claiming ownership, and may
+    // still access them.  This would indicate a bug, but we leave the still-accessible buffers
+    // still allocated to hopefully avoid memory corruption.
+    size_t dequeuedCount = 0;
+    for (auto &frame : m_pool)
+    {
+        if (!frame->m_queued)
+        {
+            dequeuedCount++;
+        }
+    }
+
+    if (dequeuedCount)
+    {
+        LOG(ERROR) << "Destroying FramePoolLockFree buffers with some still dequeued: " << std::dec << dequeuedCount << " of " << m_pool.size();
+        for (auto &frame : m_pool)
+        {
+            if (!frame->m_queued)
+            {
+                frame->unpool();
+                frame.release();  // NOLINT - we rather release the buffer, preferring a memory leak over memory corruption
+            }
+        }
+    }
+    else
+    {
+        freeBuffers(m_buffers, m_buffersSize, m_allocation);
+    }
+
+    m_pool.clear();
+    m_buffers     = nullptr;
+    m_buffersSize = 0;
+    m_allocation  = Allocation_None;
+    m_top         = emptyIndex;
+}
+
+void FramePoolLockFree::rebuild()
+{
+    // hold off dequeueFrame() and queueFrame() while the stack is replaced
+    m_configuring = true;
+    while (m_users)
+    {
+        std::this_thread::yield();
+    }
+
+    releaseBuffers();
+
+    if (m_size && m_count)
+    {
+        const auto stride = roundUp(m_size, bufferAlignment);
+        m_buffersSize     = stride * m_count;
+        m_buffers         = allocateBuffers(m_buffersSize, m_allocation);
+
+        m_pool.reserve(m_count);
+        for (uint32_t i = 0; i < m_count; i++)
+        {
+            m_pool.emplace_back(new PoolFrame(this, i, m_buffers + i * stride, m_size));
+            m_pool.back()->m_next = (i == 0) ? emptyIndex : i - 1;
+        }
+        m_top = m_count - 1;
+    }
+
+    m_configuring = false;
+}
+
+void FramePoolLockFree::setFrameBufferSize(uint32_t size)
+{
+    if (size == 0)
+    {
+        throw EGenericException("Frame buffer size 0 is not allowed");
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_size != size)
+    {
+        m_size = size;
+        rebuild();
+    }
+}
+
+void FramePoolLockFree::setFrameCount(uint16_t count)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_count != count)
+    {
+        m_count = count;
+        rebuild();
+    }
+}
+
+void FramePoolLockFree::enter()
+{
+    while (true)
+    {
+        m_users++;
+        if (!m_configuring)
+        {
+            return;
+        }
+
+        // wait for the rebuild to finish
+        m_users--;
+        std::lock_guard<std::mutex> lock(m_lock);
+    }
+}
+
+void FramePoolLockFree::leave()
+{
+    m_users--;
+}
+
+void FramePoolLockFree::push(PoolFrame *frame)
+{
+    auto top = m_top.load(std::memory_order_relaxed);
+    do
+    {
+        frame->m_next.store(topIndex(top), std::memory_order_relaxed);
+    } while (!m_top.compare_exchange_weak(top, makeTop(top, frame->m_index), std::memory_order_release, std::memory_order_relaxed));
+}
+
+FramePoolLockFree::PoolFrame *FramePoolLockFree::pop()
+{
+    auto top = m_top.load(std::memory_order_acquire);
+    while (topIndex(top) != emptyIndex)
+    {
+        // the modification count in the upper half makes the exchange fail
+        // if the frame was taken and put back meanwhile (ABA)
+        auto frame = m_pool[topIndex(top)].get();
+        if (m_top.compare_exchange_weak(top, makeTop(top, frame->m_next.load(std::memory_order_relaxed)), std::memory_order_acquire, std::memory_order_acquire))
+        {
+            return frame;
+        }
+    }
+    return nullptr;
+}
+
+void FramePoolLockFree::queueFrame(IFrame *frame)
+{
+    auto buffer = dynamic_cast<PoolFrame *>(frame);
+    if ((buffer == nullptr) || (buffer->m_owner != this))
+    {
+        throw EGenericException("Queueing a buffer that wasn't allocated by this class");
+    }
+
+    if (buffer->m_queued.exchange(true))
+    {
+        throw EGenericException("Queueing already-queued buffer");
+    }
+
+    enter();
+    push(buffer);
+    leave();
+}
+
+bool FramePoolLockFree::initialized() const
+{
+    return m_size && m_count;
+}
+
+bool FramePoolLockFree::largePages() const
+{
+    return m_allocation == Allocation_LargePages;
+}
+
+IFrame *FramePoolLockFree::dequeueFrame()
+{
+    enter();
+    auto frame = pop();
+    leave();
+
+    if (frame == nullptr)
+    {
+        return nullptr;
+    }
+    frame->m_queued = false;
+    return frame;
+}
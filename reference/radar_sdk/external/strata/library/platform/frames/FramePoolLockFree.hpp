@@ -0,0 +1,74 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <platform/interfaces/IFramePool.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/**
+ * Lock-free alternative to FramePool.
+ *
+ * The available frames are kept on a lock-free stack, so that receiving threads taking buffers and
+ * consumer threads releasing them do not serialize on a lock. Like FramePool, the buffer released last is
+ * handed out first while it is still in the cache.
+ *
+ * All buffers are carved out of one allocation, in large pages where the system provides them.
+ * Changing the size or the number of frames rebuilds the pool and must not be done while frames are in use.
+ */
+class FramePoolLockFree :
+    public IFramePool
+{
+public:
+    FramePoolLockFree();
+    ~FramePoolLockFree();
+
+    void setFrameBufferSize(uint32_t size) override;
+    void setFrameCount(uint16_t count) override;
+    IFrame *dequeueFrame() override;
+    void queueFrame(IFrame *frame) override;
+
+    bool initialized() const override;
+
+    /**
+     * @return whether the buffers are allocated in large pages
+     */
+    bool largePages() const;
+
+private:
+    class PoolFrame;
+
+    void rebuild();
+    void releaseBuffers();
+    void enter();
+    void leave();
+    void push(PoolFrame *frame);
+    PoolFrame *pop();
+
+    std::mutex m_lock;  //serializes configuration, not taken when exchanging frames
+
+    uint32_t m_size;
+    uint16_t m_count;
+
+    std::vector<std::unique_ptr<PoolFrame>> m_pool;
+    uint8_t *m_buffers;
+    size_t m_buffersSize;
+    int m_allocation;
+
+    // top of the stack: index of the frame in the lower, modification count in the upper half
+    std::atomic<uint64_t> m_top;
+
+    std::atomic<uint32_t> m_users;     //threads inside dequeueFrame() and queueFrame()
+    std::atomic<bool> m_configuring;  //a rebuild is waiting for or holding off the users
+};
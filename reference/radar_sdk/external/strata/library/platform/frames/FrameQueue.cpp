@@ -9,12 +9,21 @@
 
 #include "FrameQueue.hpp"
 #include "ErrorFrame.hpp"
+#include <common/Profiler.hpp>
 #include <universal/data_definitions.h>
 
+#include <algorithm>
+
 
 FrameQueue::FrameQueue() :
     m_queueing {false},
-    m_maxCount {0}
+    m_maxCount {0},
+    m_baseCount {0},
+    m_adaptiveCount {0},
+    m_keptUp {0},
+    m_policy {FrameQueuePolicy::DropOldest},
+    m_trimmed {false},
+    m_highWaterMark {0}
 {
 }
 
@@ -46,11 +55,72 @@ void FrameQueue::trimQueue()
     }
 }
 
+bool FrameQueue::hasRoom() const
+{
+    // with a pending error frame, there has to be room for two entries
+    return (m_maxCount == 0) || (m_queue.size() + (m_trimmed ? 2 : 1) <= m_maxCount);
+}
+
+bool FrameQueue::grow()
+{
+    if (m_maxCount >= m_adaptiveCount)
+    {
+        return false;
+    }
+
+    m_maxCount = std::min(m_adaptiveCount, std::max(m_maxCount * 2, 2u));
+    m_keptUp   = 0;
+    return true;
+}
+
+IFrame *FrameQueue::take()
+{
+    auto frame = m_queue.front();
+    m_queue.pop_front();
+    m_cvRoom.notify_one();
+
+    // the consumer keeps up, when the queue stayed nearly empty for as many frames as it can hold
+    if ((m_maxCount > m_baseCount) && (m_queue.size() < m_maxCount / 4))
+    {
+        if (++m_keptUp >= m_maxCount)
+        {
+            m_maxCount = std::max(m_baseCount, m_maxCount / 2);
+            m_keptUp   = 0;
+        }
+    }
+    else
+    {
+        m_keptUp = 0;
+    }
+
+    return frame;
+}
+
 void FrameQueue::setMaxCount(uint32_t count)
 {
     std::unique_lock<std::mutex> lock(m_lock);
-    m_maxCount = count;
+    m_maxCount  = count;
+    m_baseCount = count;
     trimQueue();
+    m_cvRoom.notify_all();
+}
+
+void FrameQueue::setPolicy(FrameQueuePolicy policy)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_policy = policy;
+    m_cvRoom.notify_all();
+}
+
+void FrameQueue::setAdaptiveMaxCount(uint32_t count)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_adaptiveCount = count;
+    if (m_maxCount > std::max(m_baseCount, m_adaptiveCount))
+    {
+        m_maxCount = m_baseCount;
+        trimQueue();
+    }
 }
 
 void FrameQueue::enqueue(IFrame *frame)
@@ -58,8 +128,47 @@ void FrameQueue::enqueue(IFrame *frame)
     if (m_queueing)
     {
         std::unique_lock<std::mutex> lock(m_lock);
+        while (!hasRoom() && grow())
+        {
+        }
+
+        if (!hasRoom())
+        {
+            switch (m_policy)
+            {
+                case FrameQueuePolicy::DropOldest:
+                    // trimQueue() makes room below
+                    break;
+                case FrameQueuePolicy::DropNewest:
+                    frame->release();
+                    m_trimmed = true;
+                    return;
+                case FrameQueuePolicy::BlockProducer:
+                    m_cvRoom.wait(lock, [&] {
+                        return !m_queueing || hasRoom() || (m_policy != FrameQueuePolicy::BlockProducer);
+                    });
+                    if (!m_queueing)
+                    {
+                        frame->release();
+                        return;
+                    }
+                    break;
+            }
+        }
+
+        if (m_trimmed)
+        {
+            m_queue.push_back(ErrorFrame::create(DataError_FrameQueueTrimmed, VIRTUAL_CHANNEL_UNDEFINED));
+            m_trimmed = false;
+        }
         m_queue.push_back(frame);
         trimQueue();
+        const auto count = static_cast<uint32_t>(m_queue.size());
+        STRATA_TRACE_COUNTER("queue.depth", count);
+        if (count > m_highWaterMark.load(std::memory_order_relaxed))
+        {
+            m_highWaterMark.store(count, std::memory_order_relaxed);
+        }
         m_cv.notify_one();
     }
     else
@@ -68,6 +177,16 @@ void FrameQueue::enqueue(IFrame *frame)
     }
 }
 
+uint32_t FrameQueue::getHighWaterMark() const
+{
+    return m_highWaterMark.load(std::memory_order_relaxed);
+}
+
+void FrameQueue::resetHighWaterMark()
+{
+    m_highWaterMark.store(0, std::memory_order_relaxed);
+}
+
 IFrame *FrameQueue::dequeue()
 {
     std::unique_lock<std::mutex> lock(m_lock);
@@ -76,13 +195,13 @@ IFrame *FrameQueue::dequeue()
         return nullptr;
     }
 
-    auto frame = m_queue.front();
-    m_queue.pop_front();
-    return frame;
+    return take();
 }
 
 IFrame *FrameQueue::blockingDequeue(uint16_t timeoutMs)
 {
+    STRATA_TRACE_SCOPE("queue.wait");
+
     //Predicate for the condition_variable to exit
     auto predicate = [&] {
         return (!m_queueing || !m_queue.empty());
@@ -105,9 +224,7 @@ IFrame *FrameQueue::blockingDequeue(uint16_t timeoutMs)
         return nullptr;
     }
 
-    auto frame = m_queue.front();
-    m_queue.pop_front();
-    return frame;
+    return take();
 }
 
 void FrameQueue::clear()
@@ -122,6 +239,8 @@ void FrameQueue::clear()
         }
         m_queue.clear();
     }
+    m_trimmed = false;
+    m_cvRoom.notify_all();
 }
 
 void FrameQueue::start()
@@ -132,6 +251,11 @@ void FrameQueue::start()
 bool FrameQueue::stop()
 {
     const bool wasQueueing = m_queueing.exchange(false);
+    {
+        // a blocked producer checks m_queueing under the lock
+        std::unique_lock<std::mutex> lock(m_lock);
+    }
     m_cv.notify_all();  //using notify_all in case multiple threads are waiting for frames
+    m_cvRoom.notify_all();
     return wasQueueing;
 }
@@ -32,6 +32,20 @@ public:
     /// @param count The maximum number, 0 means no limitation
     STRATA_API void setMaxCount(uint32_t count);
 
+    ///
+    /// Select what happens when a frame is enqueued while the queue is full.
+    /// @param policy The policy, FrameQueuePolicy::DropOldest by default
+    ///
+    STRATA_API void setPolicy(FrameQueuePolicy policy);
+
+    ///
+    /// Let the maximum number of entries adapt to the consumer. When the queue is full,
+    /// the maximum is doubled up to the given limit before the policy applies, and it is
+    /// halved again down to the count set with setMaxCount() while the consumer keeps up.
+    /// @param count The upper limit, 0 disables adapting
+    ///
+    STRATA_API void setAdaptiveMaxCount(uint32_t count);
+
     ///
     /// Clear the queue and free all frames
     ///
@@ -57,6 +71,16 @@ public:
     ///
     STRATA_API IFrame *blockingDequeue(uint16_t timeoutMs = 0) override;
 
+    ///
+    /// \return the maximum number of entries queued at the same time since the last reset
+    ///
+    STRATA_API uint32_t getHighWaterMark() const;
+
+    ///
+    /// Start over with the high water mark, see getHighWaterMark()
+    ///
+    STRATA_API void resetHighWaterMark();
+
     ///start
     /// Start functionality in case it was stopped before
     ///
@@ -69,11 +93,22 @@ public:
 
 private:
     void trimQueue();
+    bool hasRoom() const;
+    bool grow();
+    IFrame *take();
 
     std::mutex m_lock;
     std::deque<IFrame *> m_queue;
     std::condition_variable m_cv;
+    std::condition_variable m_cvRoom;  //wakes up a blocked producer
 
     std::atomic<bool> m_queueing;  //true as long as the queue works
     uint32_t m_maxCount;           //maximum number of elements in the queue
+    uint32_t m_baseCount;          //maximum set by setMaxCount(), m_maxCount differs while adapting
+    uint32_t m_adaptiveCount;      //upper limit of m_maxCount while adapting, 0 if disabled
+    uint32_t m_keptUp;             //frames taken in a row while the queue was nearly empty
+    FrameQueuePolicy m_policy;
+    bool m_trimmed;                //frames were dropped by FrameQueuePolicy::DropNewest, an error frame is pending
+
+    std::atomic<uint32_t> m_highWaterMark;  //maximum number of elements queued at once
 };
@@ -0,0 +1,290 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "FrameQueueLockFree.hpp"
+#include "ErrorFrame.hpp"
+#include <common/Profiler.hpp>
+#include <common/exception/EGenericException.hpp>
+#include <universal/data_definitions.h>
+
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+    const uint32_t defaultMaxCount = 64;
+
+    // number of polls before a consumer parks, about a few microseconds
+    const uint32_t defaultSpinCount = 2000;
+
+    uint32_t roundUpToPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    class ConsumerGuard
+    {
+    public:
+        ConsumerGuard(std::atomic<uint32_t> &consumers) :
+            m_consumers(consumers)
+        {
+            m_consumers.fetch_add(1);
+        }
+
+        ~ConsumerGuard()
+        {
+            m_consumers.fetch_sub(1);
+        }
+
+    private:
+        std::atomic<uint32_t> &m_consumers;
+    };
+}
+
+
+FrameQueueLockFree::FrameQueueLockFree() :
+    m_mask {0},
+    m_maxCount {defaultMaxCount},
+    m_tail {0},
+    m_trimmed {false},
+    m_highWaterMark {0},
+    m_head {0},
+    m_queueing {false},
+    m_consumers {0},
+    m_parked {0},
+    // on a single core spinning only delays the producer
+    m_spinCount {(std::thread::hardware_concurrency() > 1) ? defaultSpinCount : 0}
+{
+    allocate(defaultMaxCount);
+}
+
+FrameQueueLockFree::~FrameQueueLockFree()
+{
+    FrameQueueLockFree::stop();
+    waitForConsumers();
+    FrameQueueLockFree::clear();
+}
+
+void FrameQueueLockFree::allocate(uint32_t capacity)
+{
+    const auto size = roundUpToPowerOfTwo(capacity);
+
+    m_ring.reset(new std::atomic<IFrame *>[size]);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        m_ring[i].store(nullptr, std::memory_order_relaxed);
+    }
+    m_mask = size - 1;
+    m_head = 0;
+    m_tail = 0;
+    m_trimmed = false;
+}
+
+void FrameQueueLockFree::waitForConsumers()
+{
+    // consumers which passed the check for m_queueing before a stop() may still access the ring
+    while (m_consumers)
+    {
+        std::this_thread::yield();
+    }
+}
+
+void FrameQueueLockFree::setMaxCount(uint32_t count)
+{
+    if (count == 0)
+    {
+        count = defaultMaxCount;
+    }
+
+    // one frame plus the error frame for a gap must always fit
+    const auto capacity = (count < 2) ? 2 : count;
+    if (capacity > m_mask + 1)
+    {
+        if (m_queueing)
+        {
+            throw EGenericException("The lock-free frame queue can only grow while it is stopped");
+        }
+
+        waitForConsumers();
+        clear();
+        allocate(capacity);
+    }
+
+    m_maxCount = capacity;
+}
+
+void FrameQueueLockFree::push(IFrame *frame)
+{
+    auto tail       = m_tail.load(std::memory_order_relaxed);
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto size = tail - head;
+    const auto room = m_maxCount.load(std::memory_order_relaxed);
+
+    if (size + (m_trimmed ? 2 : 1) > room)
+    {
+        frame->release();
+        m_trimmed = true;
+        return;
+    }
+
+    if (m_trimmed)
+    {
+        m_ring[tail & m_mask].store(ErrorFrame::create(DataError_FrameQueueTrimmed, VIRTUAL_CHANNEL_UNDEFINED), std::memory_order_relaxed);
+        tail++;
+        m_trimmed = false;
+    }
+    m_ring[tail & m_mask].store(frame, std::memory_order_relaxed);
+    m_tail.store(tail + 1, std::memory_order_release);
+
+    const auto count = static_cast<uint32_t>(tail + 1 - head);
+    STRATA_TRACE_COUNTER("queue.depth", count);
+    if (count > m_highWaterMark.load(std::memory_order_relaxed))
+    {
+        m_highWaterMark.store(count, std::memory_order_relaxed);
+    }
+
+    // a consumer registers in m_parked before it checks the ring a last time,
+    // so either it sees the new frame or we see it parked
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_parked.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(m_parkLock);
+        m_cv.notify_one();
+    }
+}
+
+uint32_t FrameQueueLockFree::getHighWaterMark() const
+{
+    return m_highWaterMark.load(std::memory_order_relaxed);
+}
+
+void FrameQueueLockFree::resetHighWaterMark()
+{
+    m_highWaterMark.store(0, std::memory_order_relaxed);
+}
+
+IFrame *FrameQueueLockFree::pop()
+{
+    auto head = m_head.load(std::memory_order_acquire);
+    while (head != m_tail.load(std::memory_order_acquire))
+    {
+        // the slot is only reused by the producer after m_head has passed it,
+        // so the frame read here is valid if nobody else took it meanwhile
+        auto frame = m_ring[head & m_mask].load(std::memory_order_relaxed);
+        if (m_head.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            return frame;
+        }
+    }
+    return nullptr;
+}
+
+void FrameQueueLockFree::enqueue(IFrame *frame)
+{
+    if (m_queueing)
+    {
+        push(frame);
+    }
+    else
+    {
+        frame->release();
+    }
+}
+
+IFrame *FrameQueueLockFree::dequeue()
+{
+    ConsumerGuard guard(m_consumers);
+    if (!m_queueing)
+    {
+        return nullptr;
+    }
+
+    return pop();
+}
+
+IFrame *FrameQueueLockFree::blockingDequeue(uint16_t timeoutMs)
+{
+    STRATA_TRACE_SCOPE("queue.wait");
+    ConsumerGuard guard(m_consumers);
+
+    for (uint32_t i = 0; i < m_spinCount; i++)
+    {
+        if (!m_queueing)
+        {
+            return nullptr;
+        }
+
+        auto frame = pop();
+        if (frame)
+        {
+            return frame;
+        }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    IFrame *frame       = nullptr;
+
+    std::unique_lock<std::mutex> lock(m_parkLock);
+    m_parked.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    while (m_queueing)
+    {
+        frame = pop();
+        if (frame)
+        {
+            break;
+        }
+
+        if (timeoutMs != 0)
+        {
+            if (m_cv.wait_until(lock, deadline) == std::cv_status::timeout)
+            {
+                frame = pop();
+                break;
+            }
+        }
+        else
+        {
+            m_cv.wait(lock);
+        }
+    }
+
+    m_parked.fetch_sub(1);
+    return frame;
+}
+
+void FrameQueueLockFree::clear()
+{
+    // release buffers before clearing the queue, since this is expected by the consumer
+    while (auto frame = pop())
+    {
+        frame->release();
+    }
+}
+
+void FrameQueueLockFree::start()
+{
+    m_queueing = true;
+}
+
+bool FrameQueueLockFree::stop()
+{
+    const bool wasQueueing = m_queueing.exchange(false);
+
+    std::lock_guard<std::mutex> lock(m_parkLock);
+    m_cv.notify_all();  //using notify_all in case multiple threads are waiting for frames
+    return wasQueueing;
+}
@@ -0,0 +1,119 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <Definitions.hpp>
+#include <platform/interfaces/IFrameQueue.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+
+/**
+ * Bounded lock-free alternative to FrameQueue.
+ *
+ * Frames are kept in a ring which a single producer (the receiving thread of a bridge) fills
+ * without taking a lock. Consumers poll the ring for a short while before parking on a
+ * condition variable, which the producer only signals when a consumer is actually parked.
+ *
+ * Unlike FrameQueue, a full queue drops the newest frame instead of the oldest ones,
+ * since the producer cannot take frames out of the ring. An error frame with
+ * DataError_FrameQueueTrimmed is queued at the position of the gap, as soon as there is room again.
+ */
+class FrameQueueLockFree :
+    public IFrameQueue
+{
+public:
+    STRATA_API FrameQueueLockFree();
+    STRATA_API virtual ~FrameQueueLockFree();
+
+    ///
+    /// Set the maximum number of entries in the queue.
+    /// Other than for FrameQueue there is always a limit, 0 selects a default.
+    /// The ring can only grow while the queue is stopped.
+    /// @param count The maximum number
+    STRATA_API void setMaxCount(uint32_t count);
+
+    ///
+    /// Clear the queue and free all frames
+    ///
+    STRATA_API void clear() override;
+
+    ///
+    /// Enqueues a frame at the end of the queue. Must only be called from one thread at a time.
+    /// \param frame Pointer to the frame to enqueue. Ownership is taken by this function.
+    ///
+    STRATA_API void enqueue(IFrame *frame);
+
+    ///
+    /// \return the next frame in the queue
+    /// \retval nullptr if the queue is empty
+    ///
+    STRATA_API IFrame *dequeue();
+
+    ///
+    /// Blocks until there is a new frame available or the queue is stopped
+    /// \param timeoutMs Time to wait in milliseconds for a new frame, 0 means wait forever (or until stopped)
+    /// \return the next frame in the queue
+    /// \retval nullptr on exit
+    ///
+    STRATA_API IFrame *blockingDequeue(uint16_t timeoutMs = 0) override;
+
+    ///
+    /// \return the maximum number of entries queued at the same time since the last reset
+    ///
+    STRATA_API uint32_t getHighWaterMark() const;
+
+    ///
+    /// Start over with the high water mark, see getHighWaterMark()
+    ///
+    STRATA_API void resetHighWaterMark();
+
+    ///
+    /// Start functionality in case it was stopped before
+    ///
+    STRATA_API void start() override;
+
+    ///
+    /// Stop functionality and release all blocking calls in the blockingDequeue function
+    ///
+    STRATA_API bool stop() override;
+
+private:
+    void allocate(uint32_t capacity);
+    void push(IFrame *frame);
+    IFrame *pop();
+    void waitForConsumers();
+
+    // the ring, a power of two in size
+    std::unique_ptr<std::atomic<IFrame *>[]> m_ring;
+    uint32_t m_mask;
+    std::atomic<uint32_t> m_maxCount;
+
+    // positions only ever grow and are wrapped with m_mask,
+    // the padding keeps producer and consumer side in separate cache lines
+    char m_padding0[64];
+    std::atomic<uint64_t> m_tail;  //written by the producer
+    bool m_trimmed;                //frames were dropped, an error frame is pending
+    std::atomic<uint32_t> m_highWaterMark;  //maximum number of frames queued at once, updated by the producer
+    char m_padding1[64];
+    std::atomic<uint64_t> m_head;  //advanced by the consumers
+    char m_padding2[64];
+
+    std::atomic<bool> m_queueing;        //true as long as the queue works
+    std::atomic<uint32_t> m_consumers;   //threads inside dequeue() and blockingDequeue()
+    std::atomic<uint32_t> m_parked;      //threads waiting on m_cv
+    const uint32_t m_spinCount;          //polls before parking
+
+    std::mutex m_parkLock;
+    std::condition_variable m_cv;
+};
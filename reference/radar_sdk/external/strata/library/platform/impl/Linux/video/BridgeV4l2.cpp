@@ -33,6 +33,11 @@
 #include <sys/mman.h>
 
 
+#ifndef STRATA_V4L2_DMABUF
+    #define STRATA_V4L2_DMABUF 0
+#endif
+
+
 static int xioctl(int fd, int request, void *arg)
 {
     int r;
@@ -52,6 +57,7 @@ BridgeV4l2::BridgeV4l2(std::string &&devicePath) :
     m_dataStarted {false},
     m_devicePath {std::move(devicePath)}
 {
+    m_framePool.setMemory(STRATA_V4L2_DMABUF ? FramePoolV4l2::Memory::DmaBuf : FramePoolV4l2::Memory::Mmap);
     openConnection();
 }
 
@@ -288,6 +294,10 @@ void BridgeV4l2::setFrameBufferSize(uint32_t size)
     {
         throw EConnection("not opened");
     }
+    if (m_dataStarted)
+    {
+        throw EBridgeData("Changing the frame buffer size while streaming is not possible");
+    }
 
     m_framePool.setFrameBufferSize(size);
 }
@@ -298,7 +308,12 @@ void BridgeV4l2::setFrameQueueSize(uint16_t count)
     {
         throw EConnection("not opened");
     }
+    if (m_dataStarted)
+    {
+        throw EBridgeData("Changing the frame queue size while streaming is not possible");
+    }
 
+    // the frames are the buffers of the driver's queue, so this is the number of buffers requested from it
     m_framePool.setFrameCount(count);
 }
 
@@ -307,6 +322,15 @@ void BridgeV4l2::clearFrameQueue()
     m_framePool.clear();
 }
 
+void BridgeV4l2::setFrameQueueLockFree(bool lockFree)
+{
+    // the frames are queued by the V4L2 buffer pool itself
+    if (lockFree)
+    {
+        throw EBridgeData("The lock-free frame queue is not supported by this bridge");
+    }
+}
+
 void BridgeV4l2::registerListener(IFrameListener<> *listener)
 {
     m_frameForwarder.registerListener(listener);
@@ -9,23 +9,49 @@
 
 #include "FramePoolV4l2.hpp"
 
+#include <linux/dma-buf.h>
+#include <linux/dma-heap.h>
 #include <linux/videodev2.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <unistd.h>
 
 #include <common/Logger.hpp>
-#include <common/Timing.hpp>
 #include <common/cpp11/memory.hpp>
 #include <common/exception/EGenericException.hpp>
 #include <platform/exception/EConnection.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+    const char dmaHeapPath[] = "/dev/dma_heap/system";
+
+    // wait time while all buffers are dequeued, so the driver has none to fill
+    const auto depletedStep = std::chrono::milliseconds(1);
+
+    size_t roundUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
 
 FramePoolV4l2::FramePoolV4l2(int &fd) :
     m_fd {fd},
     m_size {0},
+    m_count {0},
+    m_memory {Memory::Mmap},
+    m_v4l2Memory {V4L2_MEMORY_MMAP},
     m_dequeuedCount {0},
     m_queueing {false},
-    m_discardFirst {false}  //true}
+    m_discardFirst {false},  //true}
+    m_discarding {false}
 {
 }
 
@@ -33,6 +59,16 @@ FramePoolV4l2::~FramePoolV4l2()
 {
 }
 
+void FramePoolV4l2::setMemory(Memory memory)
+{
+    m_memory = memory;
+}
+
+FramePoolV4l2::Memory FramePoolV4l2::getMemory() const
+{
+    return (m_v4l2Memory == V4L2_MEMORY_DMABUF) ? Memory::DmaBuf : Memory::Mmap;
+}
+
 void FramePoolV4l2::setFrameBufferSize(uint32_t size)
 {
     if (size == 0)
@@ -40,7 +76,17 @@ void FramePoolV4l2::setFrameBufferSize(uint32_t size)
         throw EGenericException("Frame buffer size 0 is not allowed");
     }
 
+    if (m_size == size)
+    {
+        return;
+    }
     m_size = size;
+
+    // the buffers are mapped with the previous size
+    if (!m_pool.empty())
+    {
+        allocate(m_count, m_size);
+    }
 }
 
 void FramePoolV4l2::setFrameCount(uint16_t count)
@@ -50,23 +96,26 @@ void FramePoolV4l2::setFrameCount(uint16_t count)
         throw EGenericException("Size has to be set first");
     }
 
-    if (m_pool.size() == count)
+    if (!m_pool.empty() && (m_count == count))
     {
         return;
     }
 
+    m_count = count;
     allocate(count, m_size);
 }
 
 void FramePoolV4l2::queueFrame(IFrame *frame)
 {
     std::lock_guard<std::mutex> lock(m_lock);
+
     auto buffer = dynamic_cast<FrameV4l2 *>(frame);
     if (buffer == nullptr)
     {
         throw EGenericException("Queueing a buffer that wasn't allocated by this class");
     }
 
+    syncBuffer(buffer, false);
     const int err = queue(buffer->m_index);
     if (!err)
     {
@@ -104,28 +153,58 @@ void FramePoolV4l2::clear()
 
 IFrame *FramePoolV4l2::blockingDequeue(uint16_t timeoutMs)
 {
-    IFrame *frame;
-
-    auto dequeueFunction = [&] {
-        if (!m_queueing)
-        {
-            return false;
-        }
-        frame = dequeueFrame();
-        return frame != nullptr;
-    };
+    if (!m_queueing)
+    {
+        return nullptr;
+    }
 
-    //Wait for new frames or timeout.
-    if (timeoutMs != 0)
+    IFrame *frame = dequeueFrame();
+    if ((frame != nullptr) || (timeoutMs == 0))
     {
-        waitFor(dequeueFunction, std::chrono::milliseconds(timeoutMs));
+        return frame;
     }
-    else
+
+    // Sleep in poll() until the driver has filled a buffer, instead of periodically trying to dequeue
+    const auto expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (m_queueing)
     {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(expiry - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0)
+        {
+            break;
+        }
+
+        struct pollfd pfd = {};
+        pfd.fd            = m_fd;
+        pfd.events        = POLLIN;
+        const int ret     = poll(&pfd, 1, static_cast<int>(remaining));
+        if (ret == 0)
+        {
+            break;
+        }
+        if (ret < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG(ERROR) << "Error polling for video buffers, errno: " << std::dec << errno;
+            break;
+        }
+        if (pfd.revents & (POLLERR | POLLNVAL))
+        {
+            // all buffers are dequeued or streaming was stopped
+            std::this_thread::sleep_for(depletedStep);
+        }
+
         frame = dequeueFrame();
+        if (frame != nullptr)
+        {
+            return frame;
+        }
     }
 
-    return frame;
+    return nullptr;
 }
 
 void FramePoolV4l2::start()
@@ -150,26 +229,96 @@ void FramePoolV4l2::allocate(uint16_t count, uint32_t size)
 {
     std::lock_guard<std::mutex> lock(m_lock);
 
-    struct v4l2_requestbuffers req;
-    req.reserved[0] = 0;
-    req.count       = count;
-    req.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory      = V4L2_MEMORY_MMAP;
-
     clearPool();
-    m_pool.reserve(count);
+
+    uint16_t granted;
+    if (m_memory == Memory::DmaBuf)
+    {
+        const int heap = open(dmaHeapPath, O_RDWR | O_CLOEXEC);
+        if (heap < 0)
+        {
+            LOG(WARN) << "No DMA heap available at " << dmaHeapPath << ", using mmap video buffers";
+        }
+        else if (!requestBuffers(V4L2_MEMORY_DMABUF, count, granted))
+        {
+            LOG(WARN) << "Driver does not support DMABUF video buffers, using mmap video buffers";
+            close(heap);
+        }
+        else
+        {
+            try
+            {
+                createDmaBufBuffers(heap, granted, size);
+            }
+            catch (...)
+            {
+                close(heap);
+                clearPool();
+                throw;
+            }
+            close(heap);
+            return;
+        }
+    }
+
+    if (!requestBuffers(V4L2_MEMORY_MMAP, count, granted))
+    {
+        throw EConnection("Driver does not support mmap video buffers", EINVAL);
+    }
+
+    try
+    {
+        createMmapBuffers(granted, size);
+    }
+    catch (...)
+    {
+        clearPool();
+        throw;
+    }
+}
+
+bool FramePoolV4l2::requestBuffers(__u32 memory, uint16_t count, uint16_t &granted)
+{
+    struct v4l2_requestbuffers req = {};
+    req.count                      = count;
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = memory;
 
     const int err = ioctl(m_fd, VIDIOC_REQBUFS, &req);
     if (err)
     {
-        LOG(ERROR) << "Failed to allocate video buffers, error " << errno;
-        if (errno == EBUSY)
+        const int errnum = errno;
+        if (errnum == EINVAL)
+        {
+            // memory type not supported
+            return false;
+        }
+
+        LOG(ERROR) << "Failed to allocate video buffers, error " << errnum;
+        if (errnum == EBUSY)
         {
             throw EConnection("Device busy");
         }
-        throw EConnection("TODO: Add error handling");
+        throw EConnection("Failed to allocate video buffers", errnum);
+    }
+
+    if ((req.count == 0) && (count != 0))
+    {
+        throw EConnection("Driver did not provide any video buffers");
+    }
+    if (req.count != count)
+    {
+        LOG(INFO) << "Requested " << std::dec << count << " video buffers, driver provides " << req.count;
     }
 
+    m_v4l2Memory = memory;
+    granted      = static_cast<uint16_t>(std::min<__u32>(req.count, UINT16_MAX));
+    m_pool.reserve(granted);
+    return true;
+}
+
+void FramePoolV4l2::createMmapBuffers(uint16_t count, uint32_t size)
+{
     struct v4l2_buffer buf = {};
     buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
     buf.memory             = V4L2_MEMORY_MMAP;
@@ -183,17 +332,16 @@ void FramePoolV4l2::allocate(uint16_t count, uint32_t size)
         if (err)
         {
             LOG(ERROR) << "Failed to allocate video buffer number " << i << ", error " << errno;
-            throw EConnection("TODO: Add error handling");
+            throw EConnection("Failed to query video buffer", errno);
         }
 
         // The buffer length is chosen by the driver, probably from a configuration provided with
         // the camera.  For V4L's UVC driver, it's based on the UVC dwMaxVideoFrameSize, which in
-        // Arctic fFrameV4l2irmware is larger than any expected superframe size.
-
+        // Arctic firmware is larger than any expected superframe size.
         if (buf.length < size)
         {
             LOG(ERROR) << "Buffer is too small to handle the expected image size";
-            throw EConnection("NotImplemented TODO: configure larger buffers in the driver");
+            throw EConnection("Video buffer of the driver is smaller than the frame buffer size");
         }
 
         // mmap only the size that's needed, assuming the driver does not use 24 bits per pixel.
@@ -206,7 +354,7 @@ void FramePoolV4l2::allocate(uint16_t count, uint32_t size)
         if (data == MAP_FAILED)
         {
             LOG(ERROR) << "Failed to mmap video buffer number " << i << ", error " << errno;
-            throw EConnection("NotImplemented TODO: Add error handling");
+            throw EConnection("Failed to mmap video buffer", errno);
         }
 
         // add buffer to pool
@@ -214,17 +362,62 @@ void FramePoolV4l2::allocate(uint16_t count, uint32_t size)
     }
 }
 
+void FramePoolV4l2::createDmaBufBuffers(int heap, uint16_t count, uint32_t size)
+{
+    const auto pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+    struct v4l2_buffer buf = {};
+    buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory             = V4L2_MEMORY_DMABUF;
+
+    for (__u32 i = 0; i < count; i++)
+    {
+        buf.index = i;
+
+        const int err = ioctl(m_fd, VIDIOC_QUERYBUF, &buf);
+        if (err)
+        {
+            LOG(ERROR) << "Failed to query video buffer number " << i << ", error " << errno;
+            throw EConnection("Failed to query video buffer", errno);
+        }
+
+        // the driver reports the length it needs for a frame, which the imported buffer must not be smaller than
+        const size_t length = roundUp(std::max<size_t>(buf.length, size), pageSize);
+
+        struct dma_heap_allocation_data allocation = {};
+        allocation.len                             = length;
+        allocation.fd_flags                        = O_RDWR | O_CLOEXEC;
+        if (ioctl(heap, DMA_HEAP_IOCTL_ALLOC, &allocation))
+        {
+            LOG(ERROR) << "Failed to allocate DMA buffer number " << i << ", error " << errno;
+            throw EConnection("Failed to allocate DMA buffer", errno);
+        }
+
+        const int dmabufFd = static_cast<int>(allocation.fd);
+        auto data          = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, dmabufFd, 0);
+        if (data == MAP_FAILED)
+        {
+            const int errnum = errno;
+            close(dmabufFd);
+            LOG(ERROR) << "Failed to mmap DMA buffer number " << i << ", error " << errnum;
+            throw EConnection("Failed to mmap DMA buffer", errnum);
+        }
+
+        // add buffer to pool, it takes ownership of the file descriptor
+        m_pool.emplace_back(std::make_unique<FrameV4l2>(this, i, static_cast<uint8_t *>(data), static_cast<uint32_t>(length), dmabufFd));
+    }
+}
+
 void FramePoolV4l2::deallocate()
 {
     std::lock_guard<std::mutex> lock(m_lock);
 
     clearPool();
 
-    struct v4l2_requestbuffers req;
-    req.reserved[0] = 0;
-    req.count       = 0;
-    req.type        = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    req.memory      = V4L2_MEMORY_MMAP;
+    struct v4l2_requestbuffers req = {};
+    req.count                      = 0;
+    req.type                       = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory                     = m_v4l2Memory;
 
     const int err = ioctl(m_fd, VIDIOC_REQBUFS, &req);
     if (err)
@@ -234,7 +427,7 @@ void FramePoolV4l2::deallocate()
         {
             throw EConnection("Device busy");
         }
-        throw EConnection("TODO: Add error handling");
+        throw EConnection("Failed to destroy video buffers", errno);
     }
 }
 
@@ -247,13 +440,18 @@ int FramePoolV4l2::queue(__u32 index)
     }
 
     struct v4l2_buffer buf = {};
-
-    buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buf.memory = V4L2_MEMORY_MMAP;
+    buf.type               = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory             = m_v4l2Memory;
     //buf.flags = V4L2_BUF_FLAG_TSTAMP_SRC_SOE;
     buf.index = index;
+    if (m_v4l2Memory == V4L2_MEMORY_DMABUF)
+    {
+        const auto &frame = m_pool[index];
+        buf.m.fd          = frame->m_dmabufFd;
+        buf.length        = frame->m_bufferSize;
+    }
 
-    const int err = ioctl(m_fd, VIDIOC_QBUF, &buf);
+    const int err = ioctl(m_fd, VIDIOC_QBUF, &buf) ? errno : 0;
     switch (err)
     {
         case 0:
@@ -262,10 +460,10 @@ int FramePoolV4l2::queue(__u32 index)
         case ENODEV:
         case ENXIO:
             // device disconnected
-            LOG(WARN) << "Failed to queue video buffer, device aleady disconnected. errno = " << std::dec << errno;
+            LOG(WARN) << "Failed to queue video buffer, device aleady disconnected. errno = " << std::dec << err;
             break;
         default:
-            LOG(ERROR) << "Failed to queue video buffer. errno = " << std::dec << errno;
+            LOG(ERROR) << "Failed to queue video buffer. errno = " << std::dec << err;
             break;
     }
     return err;
@@ -275,7 +473,7 @@ int FramePoolV4l2::dequeue(struct v4l2_buffer &buf)
 {
     buf        = {};
     buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-    buf.memory = V4L2_MEMORY_MMAP;
+    buf.memory = m_v4l2Memory;
 
     const int err = ioctl(m_fd, VIDIOC_DQBUF, &buf);
     if (err)
@@ -307,6 +505,22 @@ int FramePoolV4l2::dequeue(struct v4l2_buffer &buf)
     return err;
 }
 
+void FramePoolV4l2::syncBuffer(const FrameV4l2 *frame, bool start)
+{
+    // DMA heap buffers may be cached, so CPU access has to be bracketed
+    if (frame->m_dmabufFd < 0)
+    {
+        return;
+    }
+
+    struct dma_buf_sync sync = {};
+    sync.flags               = (start ? DMA_BUF_SYNC_START : DMA_BUF_SYNC_END) | DMA_BUF_SYNC_RW;
+    if (ioctl(frame->m_dmabufFd, DMA_BUF_IOCTL_SYNC, &sync))
+    {
+        LOG(WARN) << "Failed to synchronize DMA buffer, errno: " << std::dec << errno;
+    }
+}
+
 void FramePoolV4l2::clearPool()
 {
     if (m_dequeuedCount)
@@ -337,11 +551,11 @@ IFrame *FramePoolV4l2::dequeueFrame()
     if (buf.index < m_pool.size())
     {
         FrameV4l2 *frame = m_pool[buf.index].get();
+        syncBuffer(frame, true);
         frame->setDataOffset(0);
         frame->setDataSize(buf.bytesused);
         const uint64_t timestamp = (buf.timestamp.tv_sec * 1000000) + buf.timestamp.tv_usec;
         frame->setTimestamp(timestamp);
-
         m_dequeuedCount++;
         return frame;
     }
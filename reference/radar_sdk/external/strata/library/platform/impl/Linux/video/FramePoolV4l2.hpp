@@ -13,19 +13,43 @@
 #include <platform/interfaces/IFramePool.hpp>
 #include <platform/interfaces/IFrameQueue.hpp>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 
+/**
+ * Frame pool and queue backed by the V4L2 buffer queue of the driver.
+ *
+ * The driver fills the buffers directly, they are handed out as IFrame objects without a copy
+ * and given back to the driver when released. The frame count is requested from the driver,
+ * which may grant a different number of buffers.
+ *
+ * The buffers are either allocated by the driver and mmapped (default), or allocated from a
+ * DMA heap and imported as DMABUF, so they can be shared with other devices as well.
+ */
 class FramePoolV4l2 :
     public IFramePool,
     public IFrameQueue
 {
 public:
+    enum class Memory
+    {
+        Mmap,
+        DmaBuf,
+    };
+
     FramePoolV4l2(int &fd);
     ~FramePoolV4l2();
 
+    /**
+     * Select how the buffers are allocated, the next allocation uses it.
+     * DMABUF falls back to mmap if no DMA heap is available or the driver does not support it.
+     */
+    void setMemory(Memory memory);
+    Memory getMemory() const;
+
     void setFrameBufferSize(uint32_t size) override;
     void setFrameCount(uint16_t count) override;
     IFrame *dequeueFrame() override;
@@ -40,15 +64,22 @@ public:
 
 private:
     void allocate(uint16_t count, uint32_t size);
+    bool requestBuffers(__u32 memory, uint16_t count, uint16_t &granted);
+    void createMmapBuffers(uint16_t count, uint32_t size);
+    void createDmaBufBuffers(int heap, uint16_t count, uint32_t size);
     void deallocate();
     void clearPool();
     int queue(__u32 index);
     int dequeue(struct v4l2_buffer &buf);
+    void syncBuffer(const FrameV4l2 *frame, bool start);
 
     int &m_fd;
     std::mutex m_lock;
 
     uint32_t m_size;
+    uint16_t m_count;    //requested frame count, the driver may grant a different one
+    Memory m_memory;     //requested memory type
+    __u32 m_v4l2Memory;  //memory type the buffers are currently allocated with
     std::vector<std::unique_ptr<FrameV4l2>> m_pool;
     int m_dequeuedCount;
 
@@ -13,10 +13,12 @@
 
 #include <sys/mman.h>
 #include <stdexcept>
+#include <unistd.h>
 
 
-FrameV4l2::FrameV4l2(IFramePool *owner, __u32 index, uint8_t *buffer, uint32_t bufferSize) :
+FrameV4l2::FrameV4l2(IFramePool *owner, __u32 index, uint8_t *buffer, uint32_t bufferSize, int dmabufFd) :
     m_index {index},
+    m_dmabufFd {dmabufFd},
     m_buffer {buffer},
     m_owner {owner},
     m_offset {0},
@@ -32,6 +34,15 @@ FrameV4l2::~FrameV4l2()
     {
         LOG(ERROR) << "Error while munmapping buffer " << errno;
     }
+    if (m_dmabufFd >= 0)
+    {
+        close(m_dmabufFd);
+    }
+}
+
+int FrameV4l2::getDmabufFd() const
+{
+    return m_dmabufFd;
 }
 
 void FrameV4l2::resizeBuffer(uint32_t bufferSize)
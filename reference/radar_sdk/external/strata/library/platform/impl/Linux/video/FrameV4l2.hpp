@@ -23,11 +23,17 @@ class FrameV4l2 :
 public:
     using AlignmentType = uint8_t;
 
-    FrameV4l2(IFramePool *owner, __u32 index, uint8_t *buffer, uint32_t bufferSize);
+    FrameV4l2(IFramePool *owner, __u32 index, uint8_t *buffer, uint32_t bufferSize, int dmabufFd = -1);
     virtual ~FrameV4l2() override;
 
     void resizeBuffer(uint32_t bufferSize);
 
+    /**
+     * @return the DMABUF file descriptor of the buffer when streaming in DMABUF mode, -1 otherwise.
+     * It stays owned by the frame and can be imported by other devices to avoid a copy.
+     */
+    int getDmabufFd() const;
+
     //IFrame
     uint8_t *getData() const override;
     uint32_t getDataSize() const override;
@@ -43,6 +49,7 @@ protected:
     void queue() override;
 
     __u32 m_index;
+    int m_dmabufFd;
 
 private:
     AlignmentType *m_buffer;
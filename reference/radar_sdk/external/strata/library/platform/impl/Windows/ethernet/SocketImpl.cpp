@@ -134,6 +134,19 @@ void SocketImpl::setTimeout(uint16_t timeout)
     }
 }
 
+void SocketImpl::setStreamOptions(bool noDelay, bool quickAck)
+{
+    // delayed acknowledgements can not be turned off per socket on Windows
+    (void)quickAck;
+
+    BOOL param    = noDelay ? TRUE : FALSE;
+    const int ret = ::setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&param), sizeof(param));
+    if (ret == SOCKET_ERROR)
+    {
+        LOG(ERROR) << "SocketImpl::setStreamOptions - error setting TCP_NODELAY: " << WSAGetLastError();
+    }
+}
+
 void SocketImpl::send(const uint8_t buffer[], uint16_t length)
 {
     const int ret = ::send(m_socket, reinterpret_cast<const char *>(buffer), length, 0);
@@ -171,3 +184,18 @@ uint16_t SocketImpl::receive(uint8_t buffer[], uint16_t length)
 
     return static_cast<uint16_t>(ret);
 }
+
+uint16_t SocketImpl::receiveMessages(Message messages[], uint16_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    auto &message       = messages[0];
+    message.length      = receive(message.buffer, message.size);
+    message.segmentSize = message.length;
+    message.timestamp   = 0;
+
+    return (message.length > 0) ? 1 : 0;
+}
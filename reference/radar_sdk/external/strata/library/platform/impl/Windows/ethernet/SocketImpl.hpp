@@ -39,9 +39,11 @@ public:
     void open(uint16_t localPort, uint16_t remotePort, ipAddress_t remoteIpAddr, uint16_t timeout) override;
 
     void setTimeout(uint16_t timeout) override;
+    void setStreamOptions(bool noDelay, bool quickAck) override;
 
     void send(const uint8_t buffer[], uint16_t length) override;
     uint16_t receive(uint8_t buffer[], uint16_t length) override;
+    uint16_t receiveMessages(Message messages[], uint16_t count) override;
 
 protected:
     using SocketType = SOCKET;
@@ -15,6 +15,7 @@
 #include <platform/exception/EConnection.hpp>
 
 #include <iphlpapi.h>
+#include <ws2tcpip.h>
 #include <netioapi.h>
 
 
@@ -119,6 +120,29 @@ void SocketUdpImpl::getBroadcastAddresses(std::vector<remoteInfo_t> &broadcastAd
     }
 }
 
+void SocketUdpImpl::joinMulticastGroup(const ipAddress_t group)
+{
+    struct ip_mreq request;
+    std::copy(group, group + 4, reinterpret_cast<uint8_t *>(&request.imr_multiaddr));
+    request.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    const int ret = ::setsockopt(m_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char *>(&request), sizeof(request));
+    if (ret == SOCKET_ERROR)
+    {
+        throw EConnection("SocketUdpImpl::joinMulticastGroup - setsockopt() failed", WSAGetLastError());
+    }
+}
+
+void SocketUdpImpl::setMulticastTtl(uint8_t ttl)
+{
+    DWORD param   = ttl;
+    const int ret = ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char *>(&param), sizeof(param));
+    if (ret == SOCKET_ERROR)
+    {
+        LOG(ERROR) << "SocketUdpImpl::setMulticastTtl - error setting IP_MULTICAST_TTL: " << WSAGetLastError();
+    }
+}
+
 void SocketUdpImpl::sendTo(const uint8_t buffer[], uint16_t length, const remoteInfo_t *remote)
 {
     m_addr.sin_family = AF_INET;
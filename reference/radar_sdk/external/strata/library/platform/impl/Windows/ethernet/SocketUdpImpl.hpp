@@ -23,6 +23,16 @@ public:
     void setBroadcast(bool enable);
     void getBroadcastAddresses(std::vector<remoteInfo_t> &broadcastAddresses);
 
+    ///
+    /// \brief Receive the datagrams sent to a multicast group, on the interface chosen by the system
+    ///
+    void joinMulticastGroup(const ipAddress_t group);
+
+    ///
+    /// \brief Set the number of routers the multicast datagrams sent by the socket may pass
+    ///
+    void setMulticastTtl(uint8_t ttl);
+
     void sendTo(const uint8_t buffer[], uint16_t length, const remoteInfo_t *remote);
     uint16_t receiveFrom(uint8_t buffer[], uint16_t length, remoteInfo_t *remote = nullptr);
 
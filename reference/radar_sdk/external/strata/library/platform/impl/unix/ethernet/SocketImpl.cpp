@@ -13,6 +13,7 @@
 #include <platform/exception/EConnection.hpp>
 
 #include <errno.h>
+#include <netinet/tcp.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -22,7 +23,8 @@
 
 
 SocketImpl::SocketImpl() :
-    m_socket {INVALID_SOCKET}
+    m_socket {INVALID_SOCKET},
+    m_quickAck {false}
 {
 }
 
@@ -39,6 +41,29 @@ void SocketImpl::setInputBufferSize(uint32_t size)
     {
         LOG(ERROR) << "SocketImpl::setInputBufferSize - error setting SO_RCVBUF: " << errno;
     }
+
+    // the system silently limits the size (to net.core.rmem_max on Linux), so read it back
+    int actual          = 0;
+    socklen_t paramSize = sizeof(actual);
+    ::getsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char *>(&actual), &paramSize);
+#ifdef __linux__
+    // Linux reports twice the size to account for its bookkeeping overhead
+    actual /= 2;
+    if (actual < param)
+    {
+        // only succeeds with CAP_NET_ADMIN
+        if (::setsockopt(m_socket, SOL_SOCKET, SO_RCVBUFFORCE, reinterpret_cast<char *>(&param), sizeof(param)) == 0)
+        {
+            paramSize = sizeof(actual);
+            ::getsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char *>(&actual), &paramSize);
+            actual /= 2;
+        }
+    }
+#endif
+    if (actual < param)
+    {
+        LOG(INFO) << "SocketImpl::setInputBufferSize - input buffer limited to " << actual << " of " << param << " bytes by the system";
+    }
 }
 
 bool SocketImpl::isOpened()
@@ -125,6 +150,27 @@ void SocketImpl::setTimeout(uint16_t timeout)
     }
 }
 
+void SocketImpl::setStreamOptions(bool noDelay, bool quickAck)
+{
+    int param = noDelay ? 1 : 0;
+    if (::setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<char *>(&param), sizeof(param)) < 0)
+    {
+        LOG(ERROR) << "SocketImpl::setStreamOptions - error setting TCP_NODELAY: " << errno;
+    }
+
+#ifdef TCP_QUICKACK
+    // the system falls back to delayed acknowledgements by itself, so this is renewed after each receive
+    m_quickAck = quickAck;
+    param      = quickAck ? 1 : 0;
+    if (::setsockopt(m_socket, IPPROTO_TCP, TCP_QUICKACK, reinterpret_cast<char *>(&param), sizeof(param)) < 0)
+    {
+        LOG(ERROR) << "SocketImpl::setStreamOptions - error setting TCP_QUICKACK: " << errno;
+    }
+#else
+    (void)quickAck;
+#endif
+}
+
 void SocketImpl::close()
 {
     if (!isOpened())
@@ -135,7 +181,8 @@ void SocketImpl::close()
     LOG(DEBUG) << "Closing SocketImpl with protocol ...";
 
     ::close(m_socket);
-    m_socket = INVALID_SOCKET;
+    m_socket   = INVALID_SOCKET;
+    m_quickAck = false;
 }
 
 void SocketImpl::send(const uint8_t buffer[], uint16_t length)
@@ -172,5 +219,28 @@ uint16_t SocketImpl::receive(uint8_t buffer[], uint16_t length)
         }
     }
 
+#ifdef TCP_QUICKACK
+    if (m_quickAck)
+    {
+        int param = 1;
+        ::setsockopt(m_socket, IPPROTO_TCP, TCP_QUICKACK, reinterpret_cast<char *>(&param), sizeof(param));
+    }
+#endif
+
     return static_cast<uint16_t>(ret);
 }
+
+uint16_t SocketImpl::receiveMessages(Message messages[], uint16_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    auto &message       = messages[0];
+    message.length      = receive(message.buffer, message.size);
+    message.segmentSize = message.length;
+    message.timestamp   = 0;
+
+    return (message.length > 0) ? 1 : 0;
+}
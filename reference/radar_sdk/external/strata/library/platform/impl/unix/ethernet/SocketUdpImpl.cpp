@@ -12,9 +12,33 @@
 #include <common/Logger.hpp>
 #include <platform/exception/EConnection.hpp>
 
+#include <algorithm>
 #include <ifaddrs.h>
 #include <net/if.h>
 
+#ifdef __linux__
+    #include <netinet/udp.h>
+    #include <time.h>
+
+    #ifndef UDP_GRO
+        #define UDP_GRO 104  // from linux/udp.h, older C libraries don't define it
+    #endif
+#endif
+
+// coalesce consecutive datagrams into one message with UDP_GRO, needs large enough message buffers
+#ifndef STRATA_ETHERNET_UDP_GRO
+    #define STRATA_ETHERNET_UDP_GRO 0
+#endif
+
+
+#ifdef __linux__
+namespace
+{
+    constexpr const size_t controlSize  = CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(int));
+    constexpr const size_t controlWords = (controlSize + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+}
+#endif
+
 
 ISocket::Mode SocketUdpImpl::getMode() const
 {
@@ -88,6 +112,29 @@ void SocketUdpImpl::getBroadcastAddresses(std::vector<remoteInfo_t> &broadcastLi
     freeifaddrs(ifaddrs);
 }
 
+void SocketUdpImpl::joinMulticastGroup(const ipAddress_t group)
+{
+    struct ip_mreq request;
+    std::copy(group, group + 4, reinterpret_cast<uint8_t *>(&request.imr_multiaddr));
+    request.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    const int ret = ::setsockopt(m_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, reinterpret_cast<const char *>(&request), sizeof(request));
+    if (ret < 0)
+    {
+        throw EConnection("SocketUdpImpl::joinMulticastGroup - setsockopt() failed", errno);
+    }
+}
+
+void SocketUdpImpl::setMulticastTtl(uint8_t ttl)
+{
+    int param     = ttl;
+    const int ret = ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_TTL, reinterpret_cast<const char *>(&param), sizeof(param));
+    if (ret < 0)
+    {
+        LOG(ERROR) << "SocketUdpImpl::setMulticastTtl - error setting IP_MULTICAST_TTL: " << errno;
+    }
+}
+
 void SocketUdpImpl::sendTo(const uint8_t buffer[], uint16_t length, const remoteInfo_t *remote)
 {
     m_addr.sin_family = AF_INET;
@@ -135,3 +182,105 @@ uint16_t SocketUdpImpl::receiveFrom(uint8_t buffer[], uint16_t length, remoteInf
 
     return static_cast<uint16_t>(ret);
 }
+
+void SocketUdpImpl::open(uint16_t localPort, uint16_t remotePort, ipAddress_t remoteIpAddr, uint16_t timeout)
+{
+    if (!isOpened())
+    {
+        m_messageOptions = false;
+    }
+    SocketImpl::open(localPort, remotePort, remoteIpAddr, timeout);
+}
+
+void SocketUdpImpl::enableMessageOptions()
+{
+    m_messageOptions = true;
+
+#ifdef __linux__
+    // only enabled for sockets receiving messages, receive() and receiveFrom() ignore the ancillary data,
+    // but would truncate coalesced datagrams
+    int enable = 1;
+    if (::setsockopt(m_socket, SOL_SOCKET, SO_TIMESTAMPNS, reinterpret_cast<char *>(&enable), sizeof(enable)) < 0)
+    {
+        LOG(DEBUG) << "SocketUdpImpl::enableMessageOptions - error setting SO_TIMESTAMPNS: " << errno;
+    }
+
+    if (STRATA_ETHERNET_UDP_GRO)
+    {
+        // needs Linux 5.0 or later
+        if (::setsockopt(m_socket, SOL_UDP, UDP_GRO, reinterpret_cast<char *>(&enable), sizeof(enable)) < 0)
+        {
+            LOG(DEBUG) << "SocketUdpImpl::enableMessageOptions - error setting UDP_GRO: " << errno;
+        }
+    }
+#endif
+}
+
+uint16_t SocketUdpImpl::receiveMessages(Message messages[], uint16_t count)
+{
+    if (!m_messageOptions)
+    {
+        enableMessageOptions();
+    }
+
+#ifdef __linux__
+    if (m_headers.size() < count)
+    {
+        m_headers.resize(count);
+        m_vectors.resize(count);
+        m_controls.resize(count * controlWords);
+    }
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        m_vectors[i] = {messages[i].buffer, messages[i].size};
+
+        auto &header          = m_headers[i].msg_hdr;
+        header                = {};
+        header.msg_iov        = &m_vectors[i];
+        header.msg_iovlen     = 1;
+        header.msg_control    = &m_controls[i * controlWords];
+        header.msg_controllen = controlWords * sizeof(uint64_t);
+    }
+
+    // wait for the first message as long as the timeout, then only take the ones already queued
+    const int ret = ::recvmmsg(m_socket, m_headers.data(), count, MSG_WAITFORONE, nullptr);
+    if (ret < 0)
+    {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return 0;
+        }
+        throw EConnection("SocketUdpImpl::receiveMessages - recvmmsg() failed", errno);
+    }
+
+    for (int i = 0; i < ret; i++)
+    {
+        auto &message  = messages[i];
+        auto &header   = m_headers[i].msg_hdr;
+        message.length = static_cast<uint16_t>(std::min<unsigned int>(m_headers[i].msg_len, message.size));
+
+        message.segmentSize = message.length;
+        message.timestamp   = 0;
+        for (auto cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+        {
+            if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPNS))
+            {
+                struct timespec ts;
+                std::copy(CMSG_DATA(cmsg), CMSG_DATA(cmsg) + sizeof(ts), reinterpret_cast<uint8_t *>(&ts));
+                message.timestamp = static_cast<uint64_t>(ts.tv_sec) * 1000000000 + static_cast<uint64_t>(ts.tv_nsec);
+            }
+            else if ((cmsg->cmsg_level == SOL_UDP) && (cmsg->cmsg_type == UDP_GRO))
+            {
+                int segmentSize;
+                std::copy(CMSG_DATA(cmsg), CMSG_DATA(cmsg) + sizeof(segmentSize), reinterpret_cast<uint8_t *>(&segmentSize));
+                message.segmentSize = static_cast<uint16_t>(segmentSize);
+            }
+        }
+    }
+
+    return static_cast<uint16_t>(ret);
+#else
+    return SocketImpl::receiveMessages(messages, count);
+#endif
+}
@@ -11,6 +11,11 @@
 
 #include "SocketImpl.hpp"
 
+#ifdef __linux__
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+#endif
+
 #include <vector>
 
 
@@ -23,9 +28,33 @@ public:
     void setBroadcast(bool enable);
     void getBroadcastAddresses(std::vector<remoteInfo_t> &broadcastList);
 
+    ///
+    /// \brief Receive the datagrams sent to a multicast group, on the interface chosen by the system
+    ///
+    void joinMulticastGroup(const ipAddress_t group);
+
+    ///
+    /// \brief Set the number of routers the multicast datagrams sent by the socket may pass
+    ///
+    void setMulticastTtl(uint8_t ttl);
+
     void sendTo(const uint8_t buffer[], uint16_t length, const remoteInfo_t *remote);
     uint16_t receiveFrom(uint8_t buffer[], uint16_t length, remoteInfo_t *remote = nullptr);
 
+    void open(uint16_t localPort, uint16_t remotePort, ipAddress_t remoteIpAddr, uint16_t timeout) override;
+    uint16_t receiveMessages(Message messages[], uint16_t count) override;
+
 protected:
     SocketType socket() override;
+
+private:
+    void enableMessageOptions();
+
+    bool m_messageOptions = false;  //receive timestamps and offloading are enabled on the socket
+
+#ifdef __linux__
+    std::vector<struct mmsghdr> m_headers;
+    std::vector<struct iovec> m_vectors;
+    std::vector<uint64_t> m_controls;  //ancillary data of the messages, aligned for cmsghdr
+#endif
 };
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "IFrameListener.hpp"
+#include "IFrameQueue.hpp"
 
 
 class IBridgeData
@@ -36,6 +37,53 @@ public:
       */
     virtual void clearFrameQueue() = 0;
 
+    /**
+     * Select the lock-free frame queue instead of the default one.
+     * It avoids locking between the receiving thread and the consumer and drops the newest
+     * instead of the oldest frames when it is full. It can only be selected while streaming is stopped.
+     * @param lockFree true for the lock-free queue, false for the default one
+     */
+    virtual void setFrameQueueLockFree(bool lockFree) = 0;
+
+    /**
+     * Select what happens when a frame is received while the frame queue is full.
+     * The lock-free frame queue always drops the newest frames.
+     * @param policy The policy, FrameQueuePolicy::DropOldest by default
+     */
+    virtual void setFrameQueuePolicy(FrameQueuePolicy policy)
+    {
+        (void)policy;
+    }
+
+    /**
+     * Let the size of the frame queue adapt to the consumer.
+     * When the queue runs full, it grows up to the given number of frames instead of losing frames,
+     * and shrinks back to the size set with setFrameQueueSize() while the consumer keeps up.
+     * The frame pool is dimensioned for the maximum, but only the buffers actually used occupy memory.
+     * This does not apply to the lock-free frame queue.
+     * @param maxCount Maximum number of frames in the queue, 0 disables adapting
+     */
+    virtual void setFrameQueueAdaptive(uint16_t maxCount)
+    {
+        (void)maxCount;
+    }
+
+    /**
+     * Returns the maximum number of frames that were waiting in the frame queue at the same time,
+     * to help choosing the size for setFrameQueueSize(). Returns 0 if the bridge does not track it.
+     */
+    virtual uint32_t getFrameQueueHighWaterMark() const
+    {
+        return 0;
+    }
+
+    /**
+     * Start over with the maximum returned by getFrameQueueHighWaterMark()
+     */
+    virtual void resetFrameQueueHighWaterMark()
+    {
+    }
+
     /**
      * Starts the streaming pipeline while also handling all necessary implementation specific internals
      */
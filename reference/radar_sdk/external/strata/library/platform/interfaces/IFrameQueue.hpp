@@ -12,6 +12,16 @@
 #include "IFrame.hpp"
 
 
+/**
+ * What happens to a frame which is received while the frame queue is full
+ */
+enum class FrameQueuePolicy
+{
+    DropOldest,     ///< the oldest frames are dropped to make room (default)
+    DropNewest,     ///< the received frame is dropped, the queued ones are kept
+    BlockProducer,  ///< the receiving thread waits until there is room, leaving the backlog to the lower layers
+};
+
 class IFrameQueue
 {
 public:
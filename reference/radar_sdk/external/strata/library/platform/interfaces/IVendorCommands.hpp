@@ -39,6 +39,20 @@ public:
     virtual void vendorTransfer(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLengthSend, const uint8_t bufferSend[], uint16_t &wLengthReceive, uint8_t bufferReceive[]) = 0;
 
 
+    // Writes count requests with the same bRequest, wValue and wIndex. The payloads are stored
+    // back to back in buffer, wLengths holds the length of each. Bridges that can keep several
+    // requests outstanding send them before collecting the responses, so the link latency is not
+    // paid for every request. The default implementation writes one request after the other.
+    virtual void vendorWritePipelined(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t count, const uint16_t wLengths[], const uint8_t buffer[])
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            vendorWrite(bRequest, wValue, wIndex, wLengths[i], buffer);
+            buffer += wLengths[i];
+        }
+    }
+
+
     void vendorWrite(uint8_t bRequest, uint16_t wValue, uint16_t wIndex)
     {
         vendorWrite(bRequest, wValue, wIndex, 0, static_cast<const uint8_t *>(nullptr));
@@ -76,4 +76,32 @@ public:
     virtual void transfer(uint8_t devId, uint32_t count, const uint8_t bufWrite[], uint8_t bufRead[], bool keepSel = false)   = 0;
     virtual void transfer(uint8_t devId, uint32_t count, const uint16_t bufWrite[], uint16_t bufRead[], bool keepSel = false) = 0;
     virtual void transfer(uint8_t devId, uint32_t count, const uint32_t bufWrite[], uint32_t bufRead[], bool keepSel = false) = 0;
+
+    /**
+    * Read a burst of arbitrary length from an SPI device in half-duplex mode.
+    * The prefix (e.g. a FIFO burst command) is written first, then the data is read
+    * while the slave select line stays active for the whole burst, so the length
+    * is not limited by getMaxTransfer().
+    *
+    * The default implementation splits the burst into transactions of getMaxTransfer() bytes.
+    * An implementation may override this if it can stream the burst more efficiently.
+    *
+    * @param devId the device ID that identifies the slave select signal to be used
+    * @param prefixCount number of bytes of the prefix
+    * @param prefix a buffer of the specified length with the data to write before reading
+    * @param count number of bytes to be read
+    * @param buffer a buffer of the specified length
+    */
+    virtual void readBurst(uint8_t devId, uint32_t prefixCount, const uint8_t prefix[], uint32_t count, uint8_t buffer[])
+    {
+        const uint32_t maxTransfer = getMaxTransfer();
+        write(devId, prefixCount, prefix, count > 0);
+        while (count > 0)
+        {
+            const uint32_t chunk = (count < maxTransfer) ? count : maxTransfer;
+            count -= chunk;
+            read(devId, chunk, buffer, count > 0);
+            buffer += chunk;
+        }
+    }
 };
@@ -70,6 +70,19 @@ public:
     virtual bool checkInputBuffer()                = 0;
     virtual void setTimeout(uint16_t timeout)      = 0;
 
+    /**
+    * Tune the transmission behavior of a stream socket.
+    * Options not supported by the platform or the transport protocol are ignored.
+    *
+    * @param noDelay send small packets immediately instead of coalescing them (disables Nagle's algorithm)
+    * @param quickAck acknowledge received data immediately instead of delaying the acknowledgement
+    */
+    virtual void setStreamOptions(bool noDelay, bool quickAck)
+    {
+        (void)noDelay;
+        (void)quickAck;
+    }
+
     /**
     * @brief open the socket and create a connection when a remoteIpAddr is provided.
     * @note You need to provide remoteIpAddr for the Tcp protocol
@@ -100,5 +113,29 @@ public:
     */
     virtual uint16_t receive(uint8_t buffer[], uint16_t length) = 0;
 
+    /**
+    * One datagram of receiveMessages()
+    */
+    struct Message
+    {
+        uint8_t *buffer;       //provided by the caller
+        uint16_t size;         //provided by the caller: size of buffer
+        uint16_t length;       //number of bytes received
+        uint16_t segmentSize;  //size of the datagrams coalesced into buffer, equal to length if there is only one
+        uint64_t timestamp;    //receive time by the system in nanoseconds since the epoch, 0 if not available
+    };
+
+    /**
+    * Receive several datagrams at once where the platform supports it, otherwise receive one.
+    * If there is no data to read, the function returns 0 after the timeout.
+    * If offloading is supported and enabled, a message can hold several coalesced datagrams of segmentSize,
+    * the last one possibly shorter.
+    *
+    * @param messages array of count messages with buffer and size set
+    * @param count maximum number of messages to be received
+    * @return the number of messages received
+    */
+    virtual uint16_t receiveMessages(Message messages[], uint16_t count) = 0;
+
     virtual bool dumpPacket() = 0;
 };
@@ -11,7 +11,9 @@
 #include "LibUsbHelper.hpp"
 #include <common/Buffer.hpp>
 #include <common/Logger.hpp>
+#include <common/Profiler.hpp>
 #include <common/Serialization.hpp>
+#include <common/Threads.hpp>
 #include <common/Time.hpp>
 #include <platform/exception/EBridgeData.hpp>
 #include <platform/exception/EConnection.hpp>
@@ -21,11 +23,18 @@
 #include <platform/frames/ErrorFrame.hpp>
 #include <universal/protocol/protocol_definitions.h>
 
+#include <chrono>
 #include <cstring>
+#include <vector>
 
 
 //#define BRIDGE_LIBUSB_DATA_DEBUG
 
+// Number of asynchronous transfers the data thread keeps in flight, 0 reads synchronously
+#ifndef STRATA_LIBUSB_DATA_TRANSFERS
+    #define STRATA_LIBUSB_DATA_TRANSFERS 0
+#endif
+
 
 namespace
 {
@@ -42,6 +51,11 @@ namespace
 
     constexpr const int defaultInterface       = 0;
     constexpr const unsigned char dataEndpoint = LIBUSB_DATA_ENDPOINT;
+
+    void LIBUSB_CALL onTransferCompleted(libusb_transfer *transfer)
+    {
+        *static_cast<int *>(transfer->user_data) = 1;
+    }
 }
 
 
@@ -50,7 +64,8 @@ BridgeLibUsb::BridgeLibUsb(libusb_device *device, int fd) :
     m_context {LibUsbHelper::defaultContext},
     m_device {device},
     m_fd {fd},
-    m_deviceHandle {nullptr}
+    m_deviceHandle {nullptr},
+    m_transferCount {STRATA_LIBUSB_DATA_TRANSFERS}
 {
     if (m_fd && m_device)
     {
@@ -278,11 +293,12 @@ bool BridgeLibUsb::dumpPacket()
     }
 }
 
-void BridgeLibUsb::dataThreadFunction()
+struct BridgeLibUsb::ReceiveState
 {
     IFrame *frame = nullptr;
-    uint8_t *bufBegin, *bufEnd;
-    uint8_t *buf;
+    uint8_t *bufBegin;
+    uint8_t *bufEnd;
+    uint8_t *buf;  // this will point to (frameHeaderSize) bytes before the end of the current data!
 
     bool firstFrame         = true;
     uint64_t epochTimestamp = 0;
@@ -291,210 +307,235 @@ void BridgeLibUsb::dataThreadFunction()
     // in our frame buffer, we overwrite the last bytes of the previous packet with the header of the new one.
     // so we have to restore them after reading a new packet, but we don't have to copy the whole payload every time.
     uint8_t backup[frameHeaderSize];
+};
 
-    while (isBridgeDataStarted())
+bool BridgeLibUsb::dequeueReceiveFrame(ReceiveState &state)
+{
+    // try to dequeue frame to read data into
+    state.frame = m_framePool.dequeueFrame();
+    if (!state.frame)
     {
-        if (!frame)
-        {
-            // try to dequeue frame to read data into
-            frame = m_framePool.dequeueFrame();
-            if (!frame)
-            {
-                queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
-
-                // try to discard one packet and try again
-                if (dumpPacket())
-                {
-                    LOG(DEBUG) << "Data read thread - dumped packet";
-                    m_packetCounter++;
-                }
-                continue;
-            }
+        queueFrame(ErrorFrame::create(DataError_FramePoolDepleted, VIRTUAL_CHANNEL_UNDEFINED));
+        return false;
+    }
 
-            // prepare frame buffer variables
-            bufBegin = frame->getBuffer() + bufferPrefixStart;
-            bufEnd   = bufBegin + frame->getBufferSize();
-            buf      = bufBegin;  // this will point to (frameHeaderSize) bytes before the end of the current data!
-        }
+    // prepare frame buffer variables
+    state.bufBegin = state.frame->getBuffer() + bufferPrefixStart;
+    state.bufEnd   = state.bufBegin + state.frame->getBufferSize();
+    state.buf      = state.bufBegin;
+    return true;
+}
 
-        while (isBridgeDataStarted())
-        {
-            // fill buffer with frame from multiple packets
-            try
-            {
-                const auto remainingSize = static_cast<int>(bufEnd - buf);
-                const auto readSize      = (remainingSize > m_maxPacketSize) ? m_maxPacketSize : remainingSize;
-                const auto returnedSize  = LibUsbHelper::readBulk(m_deviceHandle, (LIBUSB_ENDPOINT_IN | dataEndpoint), buf, readSize, dataTimeout);
+bool BridgeLibUsb::processPacket(ReceiveState &state, int returnedSize)
+{
+    STRATA_TRACE_SCOPE("bridge.assemble");
+    const auto remainingSize = static_cast<int>(state.bufEnd - state.buf);
 
-                if (returnedSize == 0)
-                {
-                    // no packet available, continue while loop
-                    continue;
-                }
+    if (returnedSize == 0)
+    {
+        // no packet available, continue while loop
+        return false;
+    }
 
-                if (returnedSize < frameHeaderSize)
-                {
-                    LOG(DEBUG) << "Data read thread - Packet header incomplete";
-                    continue;
-                }
+    if (returnedSize < frameHeaderSize)
+    {
+        LOG(DEBUG) << "Data read thread - Packet header incomplete";
+        return false;
+    }
 
-                const auto bmPktType = serialToHost<uint8_t>(buf);
-                if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
-                {
-                    LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
-                    continue;
-                }
+    const auto bmPktType = serialToHost<uint8_t>(state.buf);
+    if ((bmPktType & 0xF0) != DATA_FRAME_PACKET)
+    {
+        LOG(DEBUG) << "Data read thread - Packet type error: 0x" << std::hex << static_cast<int>(bmPktType);
+        return false;
+    }
 
-                const auto bChannel = serialToHost<uint8_t>(buf + 1);
-                if (bmPktType & DATA_FRAME_FLAG_FIRST)
-                {
-                    if (setLocalTimestamp)
-                    {
-                        epochTimestamp = getEpochTime();
-                    }
-                    virtualChannel = bChannel;
-                }
+    const auto bChannel = serialToHost<uint8_t>(state.buf + 1);
+    if (bmPktType & DATA_FRAME_FLAG_FIRST)
+    {
+        if (setLocalTimestamp)
+        {
+            state.epochTimestamp = getEpochTime();
+        }
+        state.virtualChannel = bChannel;
+    }
 
-                const auto wLength = serialToHost<uint16_t>(buf + 4);
-                if (returnedSize != frameHeaderSize + wLength)
-                {
-                    if (remainingSize < frameHeaderSize + wLength)
-                    {
-                        queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
-                        LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
-                    }
-                    else
-                    {
-                        LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
-                    }
-                    continue;
-                }
+    const auto wLength = serialToHost<uint16_t>(state.buf + 4);
+    if (returnedSize != frameHeaderSize + wLength)
+    {
+        if (remainingSize < frameHeaderSize + wLength)
+        {
+            queueFrame(ErrorFrame::create(DataError_FrameSizeExceeded, bChannel));
+            LOG(DEBUG) << "Data read thread - Frame buffer insufficient - " << wLength + frameHeaderSize - remainingSize << " bytes discarded";
+        }
+        else
+        {
+            LOG(DEBUG) << "Data read thread - Packet length wrong: " << returnedSize << "; expected: " << (frameHeaderSize + wLength);
+        }
+        return false;
+    }
 
-                const auto wCounter = serialToHost<uint16_t>(buf + 2);
-                if (firstFrame)
-                {
+    const auto wCounter = serialToHost<uint16_t>(state.buf + 2);
+    if (state.firstFrame)
+    {
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                    if (wCounter != m_packetCounter)
-                    {
-                        LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
-                    }
+        if (wCounter != m_packetCounter)
+        {
+            LOG(DEBUG) << "Data read thread - First frame packet counter reset: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+        }
 #endif
-                    firstFrame      = false;
-                    m_packetCounter = wCounter + 1;
-                }
-                else if (wCounter != m_packetCounter)
-                {
-                    LOG(INFO) << "Data read thread - Packet loss";
+        state.firstFrame = false;
+        m_packetCounter  = wCounter + 1;
+    }
+    else if (wCounter != m_packetCounter)
+    {
+        LOG(INFO) << "Data read thread - Packet loss";
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                    LOG(DEBUG) << "    counter mismatch: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
+        LOG(DEBUG) << "    counter mismatch: received = 0x" << std::hex << wCounter << " , current = 0x" << m_packetCounter;
 #endif
-                    m_packetCounter = wCounter + 1;
+        m_packetCounter = wCounter + 1;
 
-                    queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
+        queueFrame(ErrorFrame::create(DataError_FrameDropped, bChannel));
 
-                    if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
-                    {
-                        // if this was a follow-up frame, discard the whole already received part
-                        buf = bufBegin;
+        if (!(bmPktType & DATA_FRAME_FLAG_FIRST))
+        {
+            // if this was a follow-up frame, discard the whole already received part
+            state.buf = state.bufBegin;
 
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding current frame";
+            LOG(DEBUG) << "Data read thread - discarding current frame";
 #endif
-                        continue;
-                    }
-                }
-                else
-                {
-                    m_packetCounter++;
-                }
+            return false;
+        }
+    }
+    else
+    {
+        m_packetCounter++;
+    }
 
-                if (bmPktType & DATA_FRAME_FLAG_FIRST)
-                {
-                    if (buf != bufBegin)
-                    {
-                        // we already started receiving a frame, but now a new frame starts
-                        // copy received payload to the beginning of buffer, to try to continue with new frame
-                        std::copy(buf + frameHeaderSize, buf + frameHeaderSize + wLength, bufBegin);
-                        buf = bufBegin;  // continue normally for a single/first packet
+    if (bmPktType & DATA_FRAME_FLAG_FIRST)
+    {
+        if (state.buf != state.bufBegin)
+        {
+            // we already started receiving a frame, but now a new frame starts
+            // copy received payload to the beginning of buffer, to try to continue with new frame
+            std::copy(state.buf + frameHeaderSize, state.buf + frameHeaderSize + wLength, state.bufBegin);
+            state.buf = state.bufBegin;  // continue normally for a single/first packet
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
+            LOG(DEBUG) << "Data read thread - previous frame incomplete: wCounter = 0x" << std::hex << wCounter;
 #endif
-                    }
-                }
-                else
-                {
-                    if (buf == bufBegin)
-                    {
-                        // we expected a new frame, but we received a follow-up packet
+        }
+    }
+    else
+    {
+        if (state.buf == state.bufBegin)
+        {
+            // we expected a new frame, but we received a follow-up packet
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
+            LOG(DEBUG) << "Data read thread - discarding unexpected follow-up packet";
 #endif
-                        continue;  // don't do anything with the received packet and start over
-                    }
+            return false;  // don't do anything with the received packet and start over
+        }
 
-                    if (virtualChannel != bChannel)
-                    {
+        if (state.virtualChannel != bChannel)
+        {
 #ifdef BRIDGE_LIBUSB_DATA_DEBUG
-                        LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(virtualChannel);
+            LOG(DEBUG) << "Data read thread - Channel mismatch: received = 0x" << std::hex << static_cast<int>(bChannel) << " , expected = 0x" << static_cast<int>(state.virtualChannel);
 #endif
-                        continue;  // don't do anything with the received packet and start over
-                    }
+            return false;  // don't do anything with the received packet and start over
+        }
 
-                    // restore backup of previous packet, since we overwrote it with the beginning of the current packet
-                    std::copy(backup, backup + frameHeaderSize, buf);
-                }
+        // restore backup of previous packet, since we overwrote it with the beginning of the current packet
+        std::copy(state.backup, state.backup + frameHeaderSize, state.buf);
+    }
 
-                buf += wLength;
+    state.buf += wLength;
 
-                if (bmPktType & DATA_FRAME_FLAG_LAST)
-                {
-                    if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
-                    {
-                        buf -= sizeof(epochTimestamp);
-                        if (!setLocalTimestamp)
-                        {
-                            serialToHost(buf + frameHeaderSize, epochTimestamp);
-                        }
-                    }
-                    else if (!setLocalTimestamp)
-                    {
-                        epochTimestamp = 0;
-                    }
-
-                    if (bmPktType & DATA_FRAME_FLAG_ERROR)
-                    {
-                        uint32_t code;
-                        const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(epochTimestamp) : 0);
-                        if (wLength == errorFrameLength)
-                        {
-                            buf -= sizeof(code);
-                            serialToHost(buf + frameHeaderSize, code);
-                            queueFrame(ErrorFrame::create(code, bChannel, epochTimestamp));
-                        }
-                        else
-                        {
-                            buf -= wLength;
-                            DebugFrame::log(buf + frameHeaderSize, wLength, epochTimestamp);
-                        }
-                        buf = bufBegin;
-                    }
-                    else
-                    {
-                        frame->setDataOffset(bufferPrefixSize);
-                        frame->setDataSize(static_cast<uint32_t>(buf - bufBegin));
-                        frame->setVirtualChannel(virtualChannel);
-                        frame->setTimestamp(epochTimestamp);
-
-                        queueFrame(frame);
-                        frame = nullptr;
-                    }
+    if (bmPktType & DATA_FRAME_FLAG_LAST)
+    {
+        if (bmPktType & DATA_FRAME_FLAG_TIMESTAMP)
+        {
+            state.buf -= sizeof(state.epochTimestamp);
+            if (!setLocalTimestamp)
+            {
+                serialToHost(state.buf + frameHeaderSize, state.epochTimestamp);
+            }
+        }
+        else if (!setLocalTimestamp)
+        {
+            state.epochTimestamp = 0;
+        }
 
-                    break;
+        if (bmPktType & DATA_FRAME_FLAG_ERROR)
+        {
+            uint32_t code;
+            const auto errorFrameLength = sizeof(code) + ((bmPktType & DATA_FRAME_FLAG_TIMESTAMP) ? sizeof(state.epochTimestamp) : 0);
+            if (wLength == errorFrameLength)
+            {
+                state.buf -= sizeof(code);
+                serialToHost(state.buf + frameHeaderSize, code);
+                queueFrame(ErrorFrame::create(code, bChannel, state.epochTimestamp));
+            }
+            else
+            {
+                state.buf -= wLength;
+                DebugFrame::log(state.buf + frameHeaderSize, wLength, state.epochTimestamp);
+            }
+            state.buf = state.bufBegin;
+        }
+        else
+        {
+            state.frame->setDataOffset(bufferPrefixSize);
+            state.frame->setDataSize(static_cast<uint32_t>(state.buf - state.bufBegin));
+            state.frame->setVirtualChannel(state.virtualChannel);
+            state.frame->setTimestamp(state.epochTimestamp);
+
+            queueFrame(state.frame);
+            state.frame = nullptr;
+        }
+
+        return true;
+    }
+    else
+    {
+        // save backup of current packet, since it will be overwritten by next packet
+        std::copy(state.buf, state.buf + frameHeaderSize, state.backup);
+    }
+
+    return false;
+}
+
+void BridgeLibUsb::readDataSynchronous(ReceiveState &state)
+{
+    while (isBridgeDataStarted())
+    {
+        if (!state.frame && !dequeueReceiveFrame(state))
+        {
+            // try to discard one packet and try again
+            if (dumpPacket())
+            {
+                LOG(DEBUG) << "Data read thread - dumped packet";
+                m_packetCounter++;
+            }
+            continue;
+        }
+
+        while (isBridgeDataStarted())
+        {
+            // fill buffer with frame from multiple packets
+            try
+            {
+                const auto remainingSize = static_cast<int>(state.bufEnd - state.buf);
+                const auto readSize      = (remainingSize > m_maxPacketSize) ? m_maxPacketSize : remainingSize;
+                int returnedSize;
+                {
+                    STRATA_TRACE_SCOPE("usb.read");
+                    returnedSize = LibUsbHelper::readBulk(m_deviceHandle, (LIBUSB_ENDPOINT_IN | dataEndpoint), state.buf, readSize, dataTimeout);
                 }
-                else
+
+                if (processPacket(state, returnedSize))
                 {
-                    // save backup of current packet, since it will be overwritten by next packet
-                    std::copy(buf, buf + frameHeaderSize, backup);
+                    break;
                 }
             }
             catch (const std::exception &e)
@@ -504,10 +545,155 @@ void BridgeLibUsb::dataThreadFunction()
             }
         }
     }
+}
+
+void BridgeLibUsb::handleTransfer(ReceiveState &state, const libusb_transfer &transfer)
+{
+    switch (transfer.status)
+    {
+        case LIBUSB_TRANSFER_COMPLETED:
+            break;
+        case LIBUSB_TRANSFER_CANCELLED:
+            return;
+        default:
+            queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
+            LOG(DEBUG) << "Data read thread - transfer failed: " << libusb_error_name(transfer.status);
+            return;
+    }
+
+    if (!state.frame && !dequeueReceiveFrame(state))
+    {
+        // discard the packet, the next transfer is already waiting
+        LOG(DEBUG) << "Data read thread - dumped packet";
+        m_packetCounter++;
+        return;
+    }
+
+    // the data starts where a synchronous read would have put it,
+    // clipped like a read limited to the remaining buffer
+    const auto remainingSize = static_cast<int>(state.bufEnd - state.buf);
+    const auto returnedSize  = (transfer.actual_length > remainingSize) ? remainingSize : transfer.actual_length;
+    std::copy(transfer.buffer, transfer.buffer + returnedSize, state.buf);
+
+    try
+    {
+        processPacket(state, returnedSize);
+    }
+    catch (const std::exception &e)
+    {
+        queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
+        LOG(DEBUG) << "Data read thread - " << e.what();
+    }
+}
+
+bool BridgeLibUsb::readDataAsynchronous(ReceiveState &state)
+{
+    struct Transfer
+    {
+        libusb_transfer *transfer = nullptr;
+        int completed             = 0;
+        bool submitted            = false;
+    };
+
+    // every transfer receives one packet into its own buffer, since the position in the
+    // frame buffer depends on the length of the packets before
+    std::vector<Transfer> transfers(m_transferCount);
+    stdext::buffer<uint8_t> buffers(m_transferCount * m_maxPacketSize);
+
+    auto submit = [](Transfer &t) {
+        t.completed   = 0;
+        const int ret = libusb_submit_transfer(t.transfer);
+        t.submitted   = (ret == LIBUSB_SUCCESS);
+        if (!t.submitted)
+        {
+            LOG(DEBUG) << "Data read thread - libusb_submit_transfer() failed: " << libusb_error_name(ret);
+        }
+        return t.submitted;
+    };
+
+    for (size_t i = 0; i < transfers.size(); i++)
+    {
+        auto &t    = transfers[i];
+        t.transfer = libusb_alloc_transfer(0);
+        if (!t.transfer)
+        {
+            LOG(ERROR) << "Data read thread - libusb_alloc_transfer() failed, reading synchronously";
+            for (auto &allocated : transfers)
+            {
+                libusb_free_transfer(allocated.transfer);
+            }
+            return false;
+        }
+        libusb_fill_bulk_transfer(t.transfer, m_deviceHandle, (LIBUSB_ENDPOINT_IN | dataEndpoint), buffers.data() + i * m_maxPacketSize, m_maxPacketSize,
+                                  onTransferCompleted, &t.completed, 0);
+    }
+
+    for (auto &t : transfers)
+    {
+        submit(t);
+    }
+
+    // bulk transfers of one endpoint complete in the order they were submitted
+    size_t next = 0;
+    while (isBridgeDataStarted())
+    {
+        auto &t = transfers[next];
+        if (!t.submitted && !submit(t))
+        {
+            queueFrame(ErrorFrame::create(DataError_LowLevelError, VIRTUAL_CHANNEL_UNDEFINED));
+            std::this_thread::sleep_for(std::chrono::milliseconds(dataTimeout));
+            continue;
+        }
+
+        // the completion callbacks run from here, or from another thread handling events of the context
+        timeval timeout = {0, dataTimeout * 1000};
+        {
+            STRATA_TRACE_SCOPE("usb.read");
+            libusb_handle_events_timeout_completed(m_context, &timeout, &t.completed);
+        }
+        if (!t.completed)
+        {
+            continue;
+        }
+
+        t.submitted = false;
+        handleTransfer(state, *t.transfer);
+        submit(t);
+        next = (next + 1) % transfers.size();
+    }
+
+    for (auto &t : transfers)
+    {
+        if (t.submitted && !t.completed)
+        {
+            libusb_cancel_transfer(t.transfer);
+        }
+    }
+    for (auto &t : transfers)
+    {
+        while (t.submitted && !t.completed)
+        {
+            libusb_handle_events_completed(m_context, &t.completed);
+        }
+        libusb_free_transfer(t.transfer);
+    }
+    return true;
+}
+
+void BridgeLibUsb::dataThreadFunction()
+{
+    StrataThreads::apply(StrataThreads::Data, "usb");
+
+    ReceiveState state;
+
+    if (!m_transferCount || !readDataAsynchronous(state))
+    {
+        readDataSynchronous(state);
+    }
 
     // if we own a dequeued frame buffer, make sure we return it
-    if (frame)
+    if (state.frame)
     {
-        m_framePool.queueFrame(frame);
+        m_framePool.queueFrame(state.frame);
     }
 }
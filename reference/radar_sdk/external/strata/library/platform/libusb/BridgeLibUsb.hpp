@@ -12,7 +12,7 @@
 #include <platform/bridge/BridgeData.hpp>
 #include <platform/bridge/BridgeProtocol.hpp>
 #include <platform/bridge/VendorCommandsImpl.hpp>
-#include <platform/frames/FramePool.hpp>
+#include <platform/frames/FramePoolLockFree.hpp>
 #include <platform/interfaces/IBridge.hpp>
 #include <universal/link_definitions.h>
 
@@ -66,7 +66,7 @@ private:
     bool dumpPacket();
 
     BridgeProtocol m_protocol;
-    FramePool m_framePool;
+    FramePoolLockFree m_framePool;
     std::mutex m_lock;
     uint16_t m_packetCounter;
 
@@ -75,6 +75,16 @@ private:
     int m_fd;
     libusb_device_handle *m_deviceHandle;
 
+    // data thread
+    struct ReceiveState;
+    bool dequeueReceiveFrame(ReceiveState &state);
+    bool processPacket(ReceiveState &state, int returnedSize);
+    void readDataSynchronous(ReceiveState &state);
+    bool readDataAsynchronous(ReceiveState &state);
+    void handleTransfer(ReceiveState &state, const libusb_transfer &transfer);
+
+    const uint8_t m_transferCount;
+
     void dataThreadFunction();
     std::thread m_dataThread;
 };
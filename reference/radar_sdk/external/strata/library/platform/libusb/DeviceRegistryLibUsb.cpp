@@ -0,0 +1,288 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#include "DeviceRegistryLibUsb.hpp"
+#include "LibUsbHelper.hpp"
+
+#include <common/Logger.hpp>
+#include <common/Threads.hpp>
+
+#include <algorithm>
+#include <set>
+
+
+namespace
+{
+    constexpr long eventTimeout = 100;  // ms, how long stopping the event thread may take
+}
+
+
+DeviceRegistryLibUsb &DeviceRegistryLibUsb::instance()
+{
+    static DeviceRegistryLibUsb registry;
+    return registry;
+}
+
+DeviceRegistryLibUsb::DeviceRegistryLibUsb() :
+    m_running {false}
+{
+    LibUsbHelper::init(NULL);
+
+    if (!libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG))
+    {
+        LOG(DEBUG) << "DeviceRegistryLibUsb - hotplug not supported, devices are scanned on each enumeration";
+        return;
+    }
+
+    // the callback is called for all present devices before this returns
+    const auto ret = libusb_hotplug_register_callback(LibUsbHelper::defaultContext,
+                                                      static_cast<libusb_hotplug_event>(LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT),
+                                                      LIBUSB_HOTPLUG_ENUMERATE,
+                                                      LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+                                                      &DeviceRegistryLibUsb::hotplugCallback, this, &m_callbackHandle);
+    if (ret != LIBUSB_SUCCESS)
+    {
+        LOG(WARN) << "DeviceRegistryLibUsb - libusb_hotplug_register_callback() failed (" << ret << "), devices are scanned on each enumeration";
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        return;
+    }
+
+    m_hotplug = true;
+    m_running = true;
+    m_eventThread = std::thread(&DeviceRegistryLibUsb::eventThreadFunction, this);
+}
+
+DeviceRegistryLibUsb::~DeviceRegistryLibUsb()
+{
+    if (m_hotplug)
+    {
+        m_running = false;
+        libusb_hotplug_deregister_callback(LibUsbHelper::defaultContext, m_callbackHandle);
+        m_eventThread.join();
+    }
+
+    m_entries.clear();
+    libusb_exit(LibUsbHelper::defaultContext);
+}
+
+int LIBUSB_CALL DeviceRegistryLibUsb::hotplugCallback(libusb_context * /*context*/, libusb_device *device, libusb_hotplug_event event, void *user_data)
+{
+    auto self = static_cast<DeviceRegistryLibUsb *>(user_data);
+    if (event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED)
+    {
+        self->add(device);
+    }
+    else
+    {
+        self->remove(device);
+    }
+    return 0;  // keep the callback registered
+}
+
+void DeviceRegistryLibUsb::eventThreadFunction()
+{
+    StrataThreads::apply(StrataThreads::Data, "hotplug");
+
+    // this also runs completions of data transfers if no bridge thread is waiting for events
+    while (m_running)
+    {
+        timeval timeout = {0, eventTimeout * 1000};
+        libusb_handle_events_timeout_completed(LibUsbHelper::defaultContext, &timeout, nullptr);
+    }
+}
+
+void DeviceRegistryLibUsb::add(libusb_device *device)
+{
+    struct libusb_device_descriptor descriptor;
+    if (libusb_get_device_descriptor(device, &descriptor) < 0)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_entries.count(device))
+        {
+            return;
+        }
+
+        Entry entry;
+        entry.device   = {std::shared_ptr<libusb_device>(libusb_ref_device(device), libusb_unref_device), descriptor.idVendor, descriptor.idProduct, descriptor.bDeviceClass};
+        entry.sequence = m_sequence++;
+        m_entries.emplace(device, std::move(entry));
+    }
+
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    for (auto listener : m_listeners)
+    {
+        listener->onArrival(device, descriptor.idVendor, descriptor.idProduct);
+    }
+}
+
+void DeviceRegistryLibUsb::remove(libusb_device *device)
+{
+    uint16_t vid, pid;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(device);
+        if (it == m_entries.end())
+        {
+            return;
+        }
+
+        vid = it->second.device.vid;
+        pid = it->second.device.pid;
+        m_entries.erase(it);
+    }
+
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    for (auto listener : m_listeners)
+    {
+        listener->onRemoval(device, vid, pid);
+    }
+}
+
+void DeviceRegistryLibUsb::scan()
+{
+    // getting the device list does not open the devices
+    libusb_device **devices;
+    const ssize_t count = libusb_get_device_list(LibUsbHelper::defaultContext, &devices);
+    if (count < 0)
+    {
+        LOG(WARN) << "DeviceRegistryLibUsb - libusb_get_device_list() failed (" << count << ")";
+        return;
+    }
+
+    const std::set<libusb_device *> present(devices, devices + count);
+
+    std::vector<libusb_device *> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto &entry : m_entries)
+        {
+            if (!present.count(entry.first))
+            {
+                removed.push_back(entry.first);
+            }
+        }
+    }
+    for (auto device : removed)
+    {
+        remove(device);
+    }
+    for (ssize_t i = 0; i < count; i++)
+    {
+        add(devices[i]);
+    }
+
+    libusb_free_device_list(devices, 1);
+}
+
+std::vector<DeviceRegistryLibUsb::Device> DeviceRegistryLibUsb::getDevices()
+{
+    if (!m_hotplug)
+    {
+        scan();
+    }
+
+    std::vector<const Entry *> entries;
+    std::vector<Device> result;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    entries.reserve(m_entries.size());
+    for (const auto &entry : m_entries)
+    {
+        entries.push_back(&entry.second);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry *a, const Entry *b) {
+        return a->sequence < b->sequence;
+    });
+
+    result.reserve(entries.size());
+    for (auto entry : entries)
+    {
+        result.push_back(entry->device);
+    }
+    return result;
+}
+
+bool DeviceRegistryLibUsb::getName(libusb_device *device, std::string &name)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(device);
+        if ((it != m_entries.end()) && !it->second.name.empty())
+        {
+            name = it->second.name;
+            return true;
+        }
+    }
+
+    // the device is opened outside of the lock, since this may take a while
+    struct libusb_device_descriptor descriptor;
+    if (libusb_get_device_descriptor(device, &descriptor) < 0)
+    {
+        return false;
+    }
+    libusb_device_handle *handle;
+    if (libusb_open(device, &handle) != LIBUSB_SUCCESS)
+    {
+        return false;
+    }
+    unsigned char buf[64];
+    const auto ret = libusb_get_string_descriptor_ascii(handle, descriptor.iProduct, buf, sizeof(buf));
+    libusb_close(handle);
+    if (ret < LIBUSB_SUCCESS)
+    {
+        return false;
+    }
+
+    name.assign(reinterpret_cast<const char *>(buf), ret);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(device);
+    if (it != m_entries.end())
+    {
+        it->second.name = name;
+    }
+    return true;
+}
+
+void DeviceRegistryLibUsb::setUuidString(libusb_device *device, const std::string &uuid)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(device);
+    if (it != m_entries.end())
+    {
+        it->second.uuid = uuid;
+    }
+}
+
+std::string DeviceRegistryLibUsb::getUuidString(libusb_device *device)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(device);
+    return (it != m_entries.end()) ? it->second.uuid : std::string();
+}
+
+void DeviceRegistryLibUsb::registerListener(IUsbDeviceListener *listener)
+{
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    if (std::find(m_listeners.begin(), m_listeners.end(), listener) == m_listeners.end())
+    {
+        m_listeners.push_back(listener);
+    }
+}
+
+void DeviceRegistryLibUsb::unregisterListener(IUsbDeviceListener *listener)
+{
+    std::lock_guard<std::mutex> lock(m_listenerMutex);
+    m_listeners.erase(std::remove(m_listeners.begin(), m_listeners.end(), listener), m_listeners.end());
+}
@@ -0,0 +1,115 @@
+/**
+ * @copyright 2018 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+#pragma once
+
+#include <libusb-1.0/libusb.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class IUsbDeviceListener
+{
+public:
+    virtual ~IUsbDeviceListener() = default;
+
+    virtual void onArrival(libusb_device *device, uint16_t vid, uint16_t pid) = 0;
+    virtual void onRemoval(libusb_device *device, uint16_t vid, uint16_t pid) = 0;
+};
+
+
+/**
+ * @brief Process wide list of the connected USB devices
+ *
+ * Where libusb supports hotplug events (Linux via udev or netlink, macOS), the list is
+ * kept up to date by a hotplug callback, which is handled by an internal thread.
+ * Otherwise (Windows) every call of getDevices() compares the current device list
+ * of libusb with the known devices. In both cases the product name and UUID of a device
+ * are only read once, so repeated enumerations do not open devices that are already known.
+ *
+ * Listeners are called with arrivals and removals from the hotplug thread, or
+ * from the thread calling getDevices() if hotplug is not supported. They must not
+ * register or unregister listeners from within the notification.
+ */
+class DeviceRegistryLibUsb
+{
+public:
+    struct Device
+    {
+        std::shared_ptr<libusb_device> device;  // holds a reference while the entry is used
+        uint16_t vid;
+        uint16_t pid;
+        uint8_t deviceClass;
+    };
+
+    static DeviceRegistryLibUsb &instance();
+
+    ~DeviceRegistryLibUsb();
+
+    bool hasHotplug() const
+    {
+        return m_hotplug;
+    }
+
+    /**
+     * @brief Get the currently connected devices in the order of their arrival
+     */
+    std::vector<Device> getDevices();
+
+    /**
+     * @brief Get the product name of a device, reading it when it is requested the first time
+     * @return false if the name could not be read, it is tried again with the next call
+     */
+    bool getName(libusb_device *device, std::string &name);
+
+    /**
+     * @brief Remember the UUID of a device read by a bridge, so it does not need to be opened again
+     */
+    void setUuidString(libusb_device *device, const std::string &uuid);
+    std::string getUuidString(libusb_device *device);
+
+    void registerListener(IUsbDeviceListener *listener);
+    void unregisterListener(IUsbDeviceListener *listener);
+
+private:
+    DeviceRegistryLibUsb();
+
+    struct Entry
+    {
+        Device device;
+        uint64_t sequence;
+        std::string name;
+        std::string uuid;
+    };
+
+    static int LIBUSB_CALL hotplugCallback(libusb_context *context, libusb_device *device, libusb_hotplug_event event, void *user_data);
+    void eventThreadFunction();
+
+    void add(libusb_device *device);
+    void remove(libusb_device *device);
+    void scan();
+
+    std::mutex m_mutex;
+    std::map<libusb_device *, Entry> m_entries;
+    uint64_t m_sequence = 0;
+
+    std::mutex m_listenerMutex;
+    std::vector<IUsbDeviceListener *> m_listeners;
+
+    bool m_hotplug = false;
+    libusb_hotplug_callback_handle m_callbackHandle;
+    std::atomic<bool> m_running;
+    std::thread m_eventThread;
+};
@@ -15,24 +15,6 @@
 #include <libusb-1.0/libusb.h>
 
 
-namespace
-{
-    int getDeviceName(libusb_device *dev, struct libusb_device_descriptor *descriptor, char *buf, int size)
-    {
-        libusb_device_handle *handle;
-        const auto ret_open = libusb_open(dev, &handle);
-        if (ret_open != LIBUSB_SUCCESS)
-        {
-            return ret_open;
-        }
-
-        const auto ret = libusb_get_string_descriptor_ascii(handle, descriptor->iProduct, reinterpret_cast<unsigned char *>(buf), size);
-        libusb_close(handle);
-        return ret;
-    }
-}
-
-
 std::shared_ptr<IBridge> BoardDescriptorLibUsb::createBridge()
 {
     return std::make_shared<BridgeLibUsb>(m_device, m_fd);
@@ -53,27 +35,20 @@ void EnumeratorLibUsbImpl::enumerate(IEnumerationListener &listener, BoardData::
 {
     LOG(DEBUG) << "Looking for USB boards with class code 0x" << std::hex << std::setw(2) << std::setfill('0') << +m_classCode << " (or 0x00) ...";
 
-    libusb_device **devices;
-    const ssize_t count = libusb_get_device_list(defaultContext, &devices);
-    char cName[64];
+    auto &registry = DeviceRegistryLibUsb::instance();
+    std::string name;
 
-    for (ssize_t i = 0; i < count; i++)
+    for (const auto &device : registry.getDevices())
     {
-        libusb_device *dev = devices[i];
-        struct libusb_device_descriptor descriptor;
-        const auto ret = libusb_get_device_descriptor(dev, &descriptor);
-        if (ret < 0)
-        {
-            throw EConnection("EnumeratorLibUsbImpl::enumerate - libusb_get_device_descriptor() failed", ret);
-        }
+        libusb_device *dev = device.device.get();
 
-        if (descriptor.bDeviceClass && (descriptor.bDeviceClass != m_classCode))
+        if (device.deviceClass && (device.deviceClass != m_classCode))
         {
             continue;
         }
 
-        const uint16_t &vid = descriptor.idVendor;
-        const uint16_t &pid = descriptor.idProduct;
+        const uint16_t &vid = device.vid;
+        const uint16_t &pid = device.pid;
 
         auto it = findBoardData(begin, end, vid, pid);
         if (it == end)
@@ -85,20 +60,19 @@ void EnumeratorLibUsbImpl::enumerate(IEnumerationListener &listener, BoardData::
         const auto bus  = libusb_get_bus_number(dev);
         const auto port = libusb_get_port_number(dev);
 
-        if (getDeviceName(dev, &descriptor, cName, sizeof(cName)) < LIBUSB_SUCCESS)
+        // the name is only read from the device the first time it is enumerated
+        if (!registry.getName(dev, name))
         {
             LOG(DEBUG) << "... error getting device name: VID = " << std::hex << vid << " ; PID = " << pid << " ; bus = " << +bus << " ; port = " << +port;
             continue;
         }
 
-        LOG(DEBUG) << "... device found: VID = " << std::hex << vid << " ; PID = " << pid << " ; bus = " << +bus << " ; port = " << +port << " \" ; name = \"" << cName << "\"";
+        LOG(DEBUG) << "... device found: VID = " << std::hex << vid << " ; PID = " << pid << " ; bus = " << +bus << " ; port = " << +port << " \" ; name = \"" << name << "\"";
 
-        const bool stop = listener.onEnumerate(identifyBoardFunction<BoardDescriptorLibUsb>(begin, end, vid, pid, cName, dev));
+        const bool stop = listener.onEnumerate(identifyBoardFunction<BoardDescriptorLibUsb>(begin, end, vid, pid, name.c_str(), dev));
         if (stop)
         {
             break;
         }
     }
-
-    libusb_free_device_list(devices, 1);
 }
@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include "DeviceRegistryLibUsb.hpp"
+
 #include <platform/BoardDescriptor.hpp>
 #include <platform/exception/EConnection.hpp>
 #include <platform/interfaces/IEnumerator.hpp>
@@ -44,12 +46,24 @@ public:
         m_fd {fd}
     {
         initialiseLibUsb();
-        libusb_ref_device(m_device);
+        if (m_device)
+        {
+            libusb_ref_device(m_device);
+            m_uuidString = DeviceRegistryLibUsb::instance().getUuidString(m_device);
+        }
     }
 
     ~BoardDescriptorLibUsb()
     {
-        libusb_unref_device(m_device);
+        if (m_device)
+        {
+            // a later enumeration finds the UUID without opening the device again
+            if (!m_uuidString.empty())
+            {
+                DeviceRegistryLibUsb::instance().setUuidString(m_device, m_uuidString);
+            }
+            libusb_unref_device(m_device);
+        }
         libusb_exit(defaultContext);
     }
 
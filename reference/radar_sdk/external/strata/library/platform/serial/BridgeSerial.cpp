@@ -13,6 +13,7 @@
 #include <common/Finally.hpp>
 #include <common/Logger.hpp>
 #include <common/Serialization.hpp>
+#include <common/Threads.hpp>
 #include <common/Time.hpp>
 #include <common/crc/Crc16.hpp>
 #include <platform/exception/EBridgeData.hpp>
@@ -62,10 +63,12 @@ bool BridgeSerial::isConnected()
 void BridgeSerial::openConnection()
 {
     m_packetCounter = 0;
-    m_commandActive = false;
-    m_resynchronize = false;
+    m_commandActive    = false;
+    m_resynchronize    = false;
+    m_pendingResponses = 0;
 
     m_cachedPacket = None;
+    m_controlResponses.clear();
 
     m_port.open(m_portName.c_str(), m_baudrate, portTimeout);
     m_port.clearInputBuffer();  // if the previous connection was not closed gracefully, there might be stale data left
@@ -250,6 +253,37 @@ bool BridgeSerial::readPacketStart(uint8_t buffer[], PacketType type, bool disca
     return false;
 }
 
+void BridgeSerial::queueControlResponse()
+{
+    // the caller holds m_lock and m_cachedPacket == Control
+    const uint16_t wLength       = serialToHost<uint16_t>(m_packetStartCache + 2);
+    const uint16_t remainingSize = wLength + packetCrcSize;
+
+    std::vector<uint8_t> response(packetStartSize + remainingSize);
+    std::copy(std::begin(m_packetStartCache), std::end(m_packetStartCache), response.begin());
+    m_cachedPacket = None;
+
+    const uint16_t returnedSize = m_port.receive(response.data() + packetStartSize, remainingSize);
+    if (returnedSize != remainingSize)
+    {
+        // the incomplete response is reported by receiveResponse()
+        response.resize(packetStartSize + returnedSize);
+    }
+
+    if (m_commandActive)
+    {
+        m_controlResponses.push_back(std::move(response));
+    }
+#ifdef BRIDGE_SERIAL_DATA_DEBUG
+    else
+    {
+        LOG(DEBUG) << "BridgeSerial::queueControlResponse() - discarding control packet, no command active";
+    }
+#endif
+
+    m_cv.notify_all();
+}
+
 void BridgeSerial::dumpRemainder(uint16_t wLength)
 {
     strata::buffer<uint8_t> dump(wLength + packetCrcSize);
@@ -299,6 +333,9 @@ void BridgeSerial::sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wVa
     {
         m_commandActive = true;  // block access to port already here
         m_port.clearInputBuffer();
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_controlResponses.clear();
     }
 
     if (wLength)
@@ -321,17 +358,29 @@ void BridgeSerial::receiveResponse(uint8_t bmReqType, uint8_t bRequest, uint16_t
     {
         std::unique_lock<std::mutex> lock(m_lock);
         auto endCommand = strata::finally([this] {
-            m_commandActive = false;
+            // while further pipelined responses are pending, the data thread must not discard them
+            m_commandActive = (m_pendingResponses != 0);
             m_cv.notify_one();
         });
 
         m_resynchronize       = true;  // if we exit this block with an error, this has to be set
         uint16_t returnedSize = 0;
-        const auto expiry     = std::chrono::steady_clock::now() + m_timeout;
+        std::vector<uint8_t> response;
+        const auto expiry = std::chrono::steady_clock::now() + m_timeout;
         do
         {
-            m_cv.wait(lock, [this] { return (m_cachedPacket == Control) || !isBridgeDataStarted(); });
-            if (readPacketStart(packet, Control, !isBridgeDataStarted()))
+            // While data is streamed, the data thread is the only one reading from the port.
+            // It queues control responses, so that it never has to wait for this thread.
+            m_cv.wait_until(lock, expiry, [this] { return !m_controlResponses.empty() || !isBridgeDataStarted(); });
+            if (!m_controlResponses.empty())
+            {
+                response = std::move(m_controlResponses.front());
+                m_controlResponses.pop_front();
+                std::copy(response.begin(), response.begin() + m_responseHeaderSize, packet);
+                returnedSize = m_responseHeaderSize;
+                break;
+            }
+            if (!isBridgeDataStarted() && readPacketStart(packet, Control, true))
             {
                 returnedSize = packetStartSize;  // no further read necessary, since (m_responseHeaderSize == packetStartSize)
                 break;
@@ -347,16 +396,29 @@ void BridgeSerial::receiveResponse(uint8_t bmReqType, uint8_t bRequest, uint16_t
         {
             throw EProtocol("Request response too long for buffer", (wLength << 16) | (bmReqType << 8) | bRequest);
         }
-        if (wLength != 0)
+        if (!response.empty())
         {
-            if (m_port.receive(buffer, wLength) != wLength)
+            if (response.size() != static_cast<size_t>(m_responseHeaderSize + wLength + packetCrcSize))
             {
-                throw EProtocol("Request response payload not completely received");
+                throw EProtocol("Request response not completely received");
             }
+            const auto payload = response.begin() + m_responseHeaderSize;
+            std::copy(payload, payload + wLength, buffer);
+            std::copy(payload + wLength, response.end(), &packet[m_responseHeaderSize]);
         }
-        if (m_port.receive(&packet[m_responseHeaderSize], packetCrcSize) != packetCrcSize)
+        else
         {
-            throw EProtocol("Request response CRC not completely received");
+            if (wLength != 0)
+            {
+                if (m_port.receive(buffer, wLength) != wLength)
+                {
+                    throw EProtocol("Request response payload not completely received");
+                }
+            }
+            if (m_port.receive(&packet[m_responseHeaderSize], packetCrcSize) != packetCrcSize)
+            {
+                throw EProtocol("Request response CRC not completely received");
+            }
         }
         m_resynchronize = false;  // if we make it here, we are synchronous
     }
@@ -422,8 +484,77 @@ void BridgeSerial::vendorTransfer(uint8_t bRequest, uint16_t wValue, uint16_t wI
     receiveResponse(VENDOR_REQ_TRANSFER, bRequest, wLengthReceive, bufferReceive);
 }
 
+void BridgeSerial::vendorWritePipelined(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t count, const uint16_t wLengths[], const uint8_t buffer[])
+{
+    /*
+     * The protocol has no tags to match responses to requests, but the
+     * firmware processes requests in order, so the responses are received in
+     * the order the requests were sent. Only a few requests are kept
+     * outstanding, to not depend on how many responses can be buffered.
+     */
+    constexpr uint16_t maxPendingResponses = 4;
+
+    std::lock_guard<std::mutex> lock(m_commandLock);
+
+    uint16_t sent     = 0;
+    uint16_t received = 0;
+    uint8_t status    = 0;
+
+    while (received < sent || (sent < count && !status))
+    {
+        // no further requests are sent after an error
+        while ((sent < count) && (sent - received < maxPendingResponses) && !status)
+        {
+            {
+                std::lock_guard<std::mutex> cvLock(m_lock);
+                m_pendingResponses++;
+            }
+            sendRequest(VENDOR_REQ_WRITE, bRequest, wValue, wIndex, wLengths[sent], buffer);
+            buffer += wLengths[sent];
+            sent++;
+        }
+
+        {
+            std::lock_guard<std::mutex> cvLock(m_lock);
+            m_pendingResponses--;
+        }
+        try
+        {
+            uint16_t wLength = 0;
+            receiveResponse(VENDOR_REQ_WRITE, bRequest, wLength, nullptr);
+        }
+        catch (const EProtocolFunction &e)
+        {
+            // the link is still synchronous, so the remaining responses are received before reporting the error
+            if (!status)
+            {
+                status = static_cast<uint8_t>(e.code());
+            }
+        }
+        catch (...)
+        {
+            // synchronization is lost, the remaining responses are discarded on resynchronization
+            {
+                std::lock_guard<std::mutex> cvLock(m_lock);
+                m_pendingResponses = 0;
+                m_commandActive    = false;
+            }
+            m_cv.notify_one();
+            throw;
+        }
+        received++;
+    }
+
+    if (status)
+    {
+        throw EProtocolFunction(status);
+    }
+}
+
 void BridgeSerial::dataThreadFunction()
 {
+    StrataThreads::apply(StrataThreads::Data, "serial");
+
     bool firstFrame = true;
     IFrame *frame   = nullptr;
     uint64_t epochTimestamp;
@@ -439,13 +570,19 @@ void BridgeSerial::dataThreadFunction()
     {
         // read one data packet
         std::unique_lock<std::mutex> lock(m_lock);
-        m_cv.wait(lock, [this] { return ((m_cachedPacket != Control) || !m_commandActive); });
 
         try
         {
+            if (m_cachedPacket == Control)
+            {
+                // hand the response over to receiveResponse() and continue with the data
+                queueControlResponse();
+                continue;
+            }
+
             uint8_t packetHeader[frameHeaderSize];
             uint16_t returnedSize = 0;
-            if (readPacketStart(packetHeader, Data, !m_commandActive))
+            if (readPacketStart(packetHeader, Data, false))
             {
                 returnedSize = packetStartSize + m_port.receive(packetHeader + packetStartSize, frameHeaderSize - packetStartSize);
             }
@@ -18,9 +18,11 @@
 #include <universal/link_definitions.h>
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 
 class BridgeSerial :
@@ -55,6 +57,7 @@ public:
     void vendorWrite(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLength, const uint8_t buffer[]) override;
     void vendorRead(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLength, uint8_t buffer[]) override;
     void vendorTransfer(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLengthSend, const uint8_t bufferSend[], uint16_t &wLengthReceive, uint8_t bufferReceive[]) override;
+    void vendorWritePipelined(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t count, const uint16_t wLengths[], const uint8_t buffer[]) override;
 
 private:
     void sendRequest(uint8_t bmReqType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wHeaderLength, const uint8_t buffer[]);
@@ -74,6 +77,7 @@ private:
     // flags used in CV do not need to be atomic: setting is not critical, and clearing needs to happen with the CV mutex anyways
     bool m_commandActive;
     bool m_resynchronize;
+    uint16_t m_pendingResponses;  // responses of requests sent pipelined that are not yet received
     uint16_t m_packetCounter;
 
     enum PacketType
@@ -85,6 +89,10 @@ private:
     uint8_t m_packetStartCache[4];
 
     bool readPacketStart(uint8_t buffer[], PacketType type, bool discardOther);
+    void queueControlResponse();
+
+    // complete control response packets read by the data thread, see receiveResponse()
+    std::deque<std::vector<uint8_t>> m_controlResponses;
     void dumpRemainder(uint16_t wLength);
 
     std::thread m_dataThread;
@@ -66,6 +66,7 @@ void RemoteRegisters<AddressType, ValueType>::read(AddressType address, AddressT
             it                           = hostToSerial(it, wCount);
 
             m_commands.vendorTransferChecked(FN_REGISTERS_READ_BURST, argSize, payload, wLength, reinterpret_cast<uint8_t *>(values));
+            littleToHost(values, values + wCount);
 
             address += (wCount * increment);
             values += wCount;
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <platform/interfaces/IVendorCommands.hpp>
 #include <universal/protocol/protocol_definitions.h>
+#include <vector>
 
 
 class RemoteVendorCommands
@@ -98,12 +99,30 @@ public:
     {
         decltype(count) wCount;
         auto payload = make_payloadBuffer(buffer, count, m_commands->getMaxTransfer(), std::forward<Args>(args)...);
-        while ((wCount = payload.update()))
+        if (!(wCount = payload.update()))
+        {
+            return;
+        }
+        if (wCount == count)
         {
+            // everything fits into a single request
             m_commands->vendorWrite(m_bRequest, CMD_W_VALUE(m_wType), CMD_W_INDEX(m_bId, m_bSubInterface, bFunction), payload.size(), payload.data());
             updateFunction(wCount);
-            payload.fill(std::forward<Args>(args)...);
+            return;
         }
+
+        // collect the chunks, so that they can be sent pipelined
+        std::vector<uint8_t> payloads;
+        std::vector<uint16_t> wLengths;
+        do
+        {
+            payloads.insert(payloads.end(), payload.data(), payload.data() + payload.size());
+            wLengths.push_back(static_cast<uint16_t>(payload.size()));
+            updateFunction(wCount);
+            payload.fill(std::forward<Args>(args)...);
+        } while ((wCount = payload.update()));
+
+        m_commands->vendorWritePipelined(m_bRequest, CMD_W_VALUE(m_wType), CMD_W_INDEX(m_bId, m_bSubInterface, bFunction), static_cast<uint16_t>(wLengths.size()), wLengths.data(), payloads.data());
     }
 
     /*
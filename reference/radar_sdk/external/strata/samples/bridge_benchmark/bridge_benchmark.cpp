@@ -0,0 +1,566 @@
+/**
+ * @copyright 2021 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+// Measures what the data path of a bridge sustains: throughput, slice rate, per-slice latency,
+// the DataError_* codes of error frames and the CPU time spent per MB received.
+//
+// usage: bridge_benchmark <source> [seconds] [slice size] [slices per second]
+//
+// The sources loopback-udp and loopback-tcp feed BridgeEthernetData from a producer thread which sends
+// data frame packets over the loopback interface like a board does. Each slice carries its send time,
+// so the latency covers the whole receive path. A rate of 0 sends as fast as possible.
+//
+// The sources libusb, uvc, udp, tcp and serial connect to the first board found on that connection and
+// stream the sensor configuration of the bgt_example, which then determines the slice size and rate.
+// Latencies are only reported if the bridge time stamps the slices with the host time.
+//
+// The loopback sources and the CPU time measurement use POSIX interfaces.
+
+#include <common/Time.hpp>
+#include <common/cpp11/memory.hpp>
+#include <components/interfaces/IRadarAvian.hpp>
+#include <platform/BoardManager.hpp>
+#include <platform/ethernet/BridgeEthernetData.hpp>
+#include <platform/ethernet/SocketTcp.hpp>
+#include <platform/ethernet/SocketUdp.hpp>
+#include <platform/interfaces/IFrame.hpp>
+#include <universal/data_definitions.h>
+#include <universal/link_definitions.h>
+#include <universal/protocol/protocol_definitions.h>
+#include <universal/types/DataSettingsBgtRadar.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+#include "config.hpp"
+
+
+using namespace std;
+
+const uint16_t dataPort         = 55056;  // where BridgeEthernetData expects the board to send from
+const uint16_t packetHeaderSize = 6;
+const uint16_t timestampSize    = sizeof(uint64_t);
+const uint16_t maxPacketPayload = ETH_UDP_MAX_PAYLOAD - packetHeaderSize - timestampSize;
+
+const uint16_t frameQueueSize = 64;
+const uint16_t receiveTimeout = 500;  // ms, ends the run once a loopback producer has finished
+
+// slice timestamps further away from the host time are not taken as latency
+const uint64_t maxLatency = 60 * 1000000;
+
+
+static double cpuSeconds(clockid_t clock)
+{
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+/**
+ * Drives the data path of one bridge
+ */
+class Source
+{
+public:
+    virtual ~Source() = default;
+
+    virtual IBridgeData *getBridgeData() = 0;
+    virtual void start()                 = 0;
+    virtual void stop()                  = 0;
+
+    /**
+     * @return CPU time in seconds which was spent outside of the receive path, to be excluded
+     */
+    virtual double getProducerCpuSeconds() const
+    {
+        return 0.0;
+    }
+
+    virtual void printStatistics() const
+    {
+    }
+};
+
+
+/**
+ * Emulates an Ethernet board sending data frames to BridgeEthernetData over the loopback interface
+ */
+class LoopbackSource :
+    public Source
+{
+public:
+    LoopbackSource(TransportProtocol protocol, uint32_t sliceSize, uint32_t rate, double seconds) :
+        m_protocol {protocol},
+        m_sliceSize {sliceSize},
+        m_rate {rate},
+        m_seconds {seconds},
+        m_fd {-1},
+        m_peerLength {sizeof(m_peer)},
+        m_running {false},
+        m_producerCpu {0.0}
+    {
+        const bool udp = (protocol == TransportProtocol::Udp);
+
+        // the producer has to listen before the bridge connects, which happens on construction
+        m_serverFd = socket(AF_INET, udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+        const int reuse = 1;
+        setsockopt(m_serverFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address     = {};
+        address.sin_family      = AF_INET;
+        address.sin_port        = htons(dataPort);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(m_serverFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) || (!udp && listen(m_serverFd, 1)))
+        {
+            close(m_serverFd);
+            throw runtime_error("Could not bind the loopback producer to the data port");
+        }
+
+        uint8_t ip[4] = {127, 0, 0, 1};
+        if (udp)
+        {
+            m_socket = make_unique<SocketUdp>();
+        }
+        else
+        {
+            m_socket = make_unique<SocketTcp>();
+        }
+        m_bridge = make_unique<BridgeEthernetData>(*m_socket, ip);
+
+        // the pipecleaner of the bridge tells the producer where to send to
+        if (udp)
+        {
+            uint8_t pipecleaner;
+            recvfrom(m_serverFd, &pipecleaner, sizeof(pipecleaner), 0, reinterpret_cast<sockaddr *>(&m_peer), &m_peerLength);
+            m_fd = m_serverFd;
+        }
+        else
+        {
+            m_fd = accept(m_serverFd, nullptr, nullptr);
+        }
+
+        m_bridge->setFramePoolCount(frameQueueSize + 1);
+    }
+
+    ~LoopbackSource()
+    {
+        stop();
+        if (m_fd != m_serverFd)
+        {
+            close(m_fd);
+        }
+        close(m_serverFd);
+    }
+
+    IBridgeData *getBridgeData() override
+    {
+        return m_bridge.get();
+    }
+
+    void start() override
+    {
+        m_bridge->startStreaming();
+        m_running  = true;
+        m_producer = thread(&LoopbackSource::produce, this);
+    }
+
+    void stop() override
+    {
+        m_running = false;
+        if (m_producer.joinable())
+        {
+            m_producer.join();
+        }
+        m_bridge->stopStreaming();
+    }
+
+    double getProducerCpuSeconds() const override
+    {
+        return m_producerCpu;
+    }
+
+    void printStatistics() const override
+    {
+        const auto statistics = m_bridge->getChannelStatistics(0);
+        cout << "bridge counters:   " << statistics.packets << " packets, " << statistics.lostPackets << " lost packets, "
+             << statistics.droppedFrames << " dropped frames" << endl;
+    }
+
+private:
+    void send(const vector<uint8_t> &packet)
+    {
+        if (m_protocol == TransportProtocol::Udp)
+        {
+            sendto(m_fd, packet.data(), packet.size(), 0, reinterpret_cast<const sockaddr *>(&m_peer), m_peerLength);
+        }
+        else
+        {
+            const uint8_t *data = packet.data();
+            size_t remaining    = packet.size();
+            while (remaining && m_running)
+            {
+                const auto sent = ::send(m_fd, data, remaining, MSG_NOSIGNAL);
+                if (sent <= 0)
+                {
+                    m_running = false;
+                    return;
+                }
+                data += sent;
+                remaining -= sent;
+            }
+        }
+    }
+
+    void produce()
+    {
+        vector<uint8_t> packet(packetHeaderSize + maxPacketPayload + timestampSize);
+        uint16_t counter = 0;
+
+        const auto start  = chrono::steady_clock::now();
+        const auto expiry = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(m_seconds));
+        for (uint64_t i = 0; m_running; i++)
+        {
+            if (m_rate)
+            {
+                this_thread::sleep_until(start + chrono::microseconds(i * 1000000 / m_rate));
+            }
+            if (chrono::steady_clock::now() >= expiry)
+            {
+                break;
+            }
+
+            const uint64_t timestamp = getEpochTime();
+            uint32_t remaining       = m_sliceSize;
+            bool first               = true;
+            do
+            {
+                const uint16_t chunk = static_cast<uint16_t>(min<uint32_t>(remaining, maxPacketPayload));
+                remaining -= chunk;
+
+                uint8_t type    = DATA_FRAME_PACKET;
+                uint16_t length = chunk;
+                if (first)
+                {
+                    type |= DATA_FRAME_FLAG_FIRST;
+                    first = false;
+                }
+                if (remaining == 0)
+                {
+                    type |= DATA_FRAME_FLAG_LAST | DATA_FRAME_FLAG_TIMESTAMP;
+                    for (uint16_t b = 0; b < timestampSize; b++)
+                    {
+                        packet[packetHeaderSize + chunk + b] = static_cast<uint8_t>(timestamp >> (8 * b));
+                    }
+                    length += timestampSize;
+                }
+
+                packet[0] = type;
+                packet[1] = 0;  // channel
+                packet[2] = static_cast<uint8_t>(counter);
+                packet[3] = static_cast<uint8_t>(counter >> 8);
+                packet[4] = static_cast<uint8_t>(length);
+                packet[5] = static_cast<uint8_t>(length >> 8);
+                counter++;
+
+                packet.resize(packetHeaderSize + length);
+                send(packet);
+                packet.resize(packetHeaderSize + maxPacketPayload + timestampSize);
+            } while (remaining);
+        }
+
+        m_producerCpu = cpuSeconds(CLOCK_THREAD_CPUTIME_ID);
+    }
+
+    const TransportProtocol m_protocol;
+    const uint32_t m_sliceSize;
+    const uint32_t m_rate;
+    const double m_seconds;
+
+    int m_serverFd;
+    int m_fd;
+    sockaddr_in m_peer;
+    socklen_t m_peerLength;
+
+    unique_ptr<ISocket> m_socket;
+    unique_ptr<BridgeEthernetData> m_bridge;
+
+    thread m_producer;
+    atomic<bool> m_running;
+    double m_producerCpu;
+};
+
+
+/**
+ * Streams from the first board found on a connection with the configuration of the bgt_example
+ */
+class BoardSource :
+    public Source
+{
+public:
+    BoardSource(const char connection[]) :
+        m_boardManager(connection),
+        m_started {false}
+    {
+        if (!m_boardManager.enumerate())
+        {
+            throw runtime_error("No board found");
+        }
+        m_board = m_boardManager.createBoardInstance();
+
+        m_avian     = m_board->getComponent<IRadarAvian>(0);
+        m_data      = m_board->getIData();
+        m_dataIndex = m_avian->getDataIndex();
+
+        IDataProperties_t properties;
+        properties.format            = DataFormat_Auto;
+        const uint16_t readouts[][2] = {
+            static_cast<uint16_t>(meta_data.burstAddress & 0xFF),
+            static_cast<uint16_t>(meta_data.burstSize & 0xFFFF),
+        };
+        DataSettingsBgtRadar_t settings(&readouts);
+        m_data->configure(m_dataIndex, &properties, &settings);
+
+        m_bridgeData = m_board->getIBridge()->getIBridgeData();
+        m_bridgeData->setFrameBufferSize(meta_data.burstSize * sizeof(uint16_t));
+        m_bridgeData->setFrameQueueSize(frameQueueSize);
+    }
+
+    ~BoardSource()
+    {
+        stop();
+    }
+
+    IBridgeData *getBridgeData() override
+    {
+        return m_bridgeData;
+    }
+
+    void start() override
+    {
+        m_started = true;
+        m_bridgeData->startStreaming();
+        m_data->start(m_dataIndex);
+        m_avian->getIProtocolAvian()->execute(default_doppler);
+    }
+
+    void stop() override
+    {
+        if (!m_started)
+        {
+            return;
+        }
+        m_started = false;
+
+        // stopping the data readout lets the sensor FIFO overflow, which stops it
+        m_bridgeData->stopStreaming();
+        m_data->stop(m_dataIndex);
+    }
+
+private:
+    BoardManager m_boardManager;
+    unique_ptr<BoardInstance> m_board;
+    IRadarAvian *m_avian;
+    IData *m_data;
+    uint8_t m_dataIndex;
+    IBridgeData *m_bridgeData;
+    bool m_started;
+};
+
+
+struct Result
+{
+    double seconds;
+    double cpuSeconds;
+    uint64_t bytes;
+    uint64_t slices;
+    map<uint32_t, uint64_t> errors;
+    vector<uint64_t> latencies;
+};
+
+static Result run(Source &source, double seconds, bool drain)
+{
+    auto bridgeData = source.getBridgeData();
+
+    Result result       = {};
+    const auto start    = chrono::steady_clock::now();
+    const auto expiry   = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+    const auto cpuStart = cpuSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    auto last           = start;
+
+    source.start();
+    while (drain || (chrono::steady_clock::now() < expiry))
+    {
+        auto frame = bridgeData->getFrame(receiveTimeout);
+        if (frame == nullptr)
+        {
+            if (drain && (chrono::steady_clock::now() >= expiry))
+            {
+                break;
+            }
+            continue;
+        }
+
+        last = chrono::steady_clock::now();
+        const uint64_t received = getEpochTime();
+        if (const auto code = frame->getStatusCode())
+        {
+            result.errors[code]++;
+        }
+        else
+        {
+            result.slices++;
+            result.bytes += frame->getDataSize();
+            const auto timestamp = frame->getTimestamp();
+            if ((received >= timestamp) && (received - timestamp < maxLatency))
+            {
+                result.latencies.push_back(received - timestamp);
+            }
+        }
+        frame->release();
+    }
+    source.stop();
+
+    result.seconds    = chrono::duration<double>(last - start).count();
+    result.cpuSeconds = cpuSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart - source.getProducerCpuSeconds();
+    return result;
+}
+
+static const char *errorName(uint32_t code)
+{
+    switch (code)
+    {
+        case DataError_LowLevelError:
+            return "DataError_LowLevelError";
+        case DataError_FrameDropped:
+            return "DataError_FrameDropped";
+        case DataError_FramePoolDepleted:
+            return "DataError_FramePoolDepleted";
+        case DataError_FrameSizeExceeded:
+            return "DataError_FrameSizeExceeded";
+        case DataError_FrameQueueTrimmed:
+            return "DataError_FrameQueueTrimmed";
+        default:
+            return "other";
+    }
+}
+
+static void print(Result &result)
+{
+    const double megabytes = result.bytes / 1e6;
+    const double seconds   = max(result.seconds, 1e-9);
+
+    cout << fixed << setprecision(1);
+    cout << "throughput:        " << megabytes / seconds << " MB/s, " << result.slices / seconds << " slices/s ("
+         << result.slices << " slices in " << setprecision(2) << result.seconds << " s)" << endl;
+
+    auto &l = result.latencies;
+    if (l.empty())
+    {
+        cout << "latency:           n/a" << endl;
+    }
+    else
+    {
+        sort(l.begin(), l.end());
+        auto percentile = [&](double p) {
+            return l[static_cast<size_t>(p * (l.size() - 1))];
+        };
+        cout << "latency:           p50 " << percentile(0.5) << " us, p99 " << percentile(0.99) << " us, p99.9 " << percentile(0.999)
+             << " us, max " << l.back() << " us" << endl;
+    }
+
+    cout << "errors:           ";
+    if (result.errors.empty())
+    {
+        cout << " none";
+    }
+    for (auto &error : result.errors)
+    {
+        cout << " " << errorName(error.first) << " (0x" << hex << error.first << dec << "): " << error.second;
+    }
+    cout << endl;
+
+    cout << setprecision(2) << "CPU:               " << result.cpuSeconds * 1000 / max(megabytes, 1e-9) << " ms/MB ("
+         << result.cpuSeconds / seconds * 100 << " % of a core)" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        cout << "usage: " << argv[0] << " <loopback-udp|loopback-tcp|libusb|uvc|udp|tcp|serial> [seconds] [slice size] [slices per second]" << endl;
+        return EXIT_FAILURE;
+    }
+
+    const string name    = argv[1];
+    const double seconds = (argc > 2) ? atof(argv[2]) : 10.0;
+    const uint32_t size  = (argc > 3) ? static_cast<uint32_t>(atoi(argv[3])) : meta_data.burstSize * 3 / 2;  // Packed12
+    const uint32_t rate  = (argc > 4) ? static_cast<uint32_t>(atoi(argv[4])) : 0;
+    const bool loopback  = (name.compare(0, 9, "loopback-") == 0);
+
+    try
+    {
+        unique_ptr<Source> source;
+        if (name == "loopback-udp")
+        {
+            source = make_unique<LoopbackSource>(TransportProtocol::Udp, size, rate, seconds);
+        }
+        else if (name == "loopback-tcp")
+        {
+            source = make_unique<LoopbackSource>(TransportProtocol::Tcp, size, rate, seconds);
+        }
+        else
+        {
+            source = make_unique<BoardSource>(name.c_str());
+        }
+
+        auto bridgeData = source->getBridgeData();
+        if (loopback)
+        {
+            bridgeData->setFrameBufferSize(size);
+            bridgeData->setFrameQueueSize(frameQueueSize);
+        }
+
+        cout << "source:            " << name;
+        if (loopback)
+        {
+            cout << ", " << size << " bytes per slice, " << (rate ? to_string(rate) + " slices/s" : string("unpaced"));
+        }
+        cout << endl;
+
+        auto result = run(*source, seconds, loopback);
+        print(result);
+        source->printStatistics();
+    }
+    catch (const exception &e)
+    {
+        cout << "Benchmark failed: " << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,157 @@
+/**
+ * @copyright 2021 Infineon Technologies
+ *
+ * THIS CODE AND INFORMATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A
+ * PARTICULAR PURPOSE.
+ */
+
+// Compares FrameQueue and FramePool with their lock-free variants the way a bridge uses them:
+// a receiving thread takes buffers from the pool and queues them,
+// a consumer thread dequeues and releases them.
+
+#include <platform/frames/FramePool.hpp>
+#include <platform/frames/FramePoolLockFree.hpp>
+#include <platform/frames/FrameQueue.hpp>
+#include <platform/frames/FrameQueueLockFree.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+using namespace std;
+
+const uint16_t queueSize   = 256;
+const uint32_t sliceSize   = 4096;
+const uint32_t sliceCount  = 1000000;
+const uint32_t pacedRate   = 100000;  // slices per second
+const uint32_t pacedCount  = 200000;
+
+
+static uint64_t now()
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Result
+{
+    double seconds;
+    uint32_t received;
+    uint32_t errors;
+    vector<uint64_t> latencies;
+};
+
+template <typename Pool, typename Queue>
+static Result run(uint32_t count, uint32_t rate)
+{
+    Pool pool;
+    Queue queue;
+    pool.setFrameCount(queueSize + 1);
+    pool.setFrameBufferSize(sliceSize);
+    queue.setMaxCount(queueSize);
+    queue.start();
+
+    Result result = {};
+    result.latencies.reserve(count);
+    atomic<uint64_t> lastReceived {0};
+
+    thread consumer([&] {
+        while (IFrame *frame = queue.blockingDequeue(1000))
+        {
+            const auto received = now();
+            if (frame->getStatusCode())
+            {
+                result.errors++;
+            }
+            else
+            {
+                result.latencies.push_back(received - frame->getTimestamp());
+                result.received++;
+            }
+            frame->release();
+            lastReceived = received;
+        }
+    });
+
+    const auto start = now();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (rate)
+        {
+            const auto due = start + static_cast<uint64_t>(i) * 1000000000 / rate;
+            while (now() < due)
+            {
+                this_thread::yield();
+            }
+        }
+
+        IFrame *frame;
+        while ((frame = pool.dequeueFrame()) == nullptr)
+        {
+            // the consumer is behind, like DataError_FramePoolDepleted on a bridge
+            this_thread::yield();
+        }
+        frame->setTimestamp(now());
+        queue.enqueue(frame);
+    }
+
+    // let the consumer drain the queue
+    uint64_t last;
+    do
+    {
+        last = lastReceived;
+        this_thread::sleep_for(chrono::milliseconds(20));
+    } while (lastReceived != last);
+
+    queue.stop();
+    consumer.join();
+    result.seconds = static_cast<double>(lastReceived - start) * 1e-9;
+    queue.clear();
+    return result;
+}
+
+static void print(const char *name, Result &result)
+{
+    auto &l = result.latencies;
+    sort(l.begin(), l.end());
+    auto percentile = [&](double p) {
+        return l.empty() ? 0.0 : static_cast<double>(l[static_cast<size_t>(p * (l.size() - 1))]) * 1e-3;
+    };
+
+    cout << setw(40) << left << name << right << fixed << setprecision(1)
+         << setw(12) << result.received / result.seconds / 1000 << " k/s"
+         << setw(10) << percentile(0.5) << setw(10) << percentile(0.99) << setw(10) << percentile(0.999) << " us"
+         << setw(8) << result.errors << endl;
+}
+
+int main()
+{
+    cout << setw(40) << left << "pool + queue" << right << setw(16) << "throughput" << setw(10) << "p50" << setw(10) << "p99" << setw(13) << "p99.9"
+         << setw(8) << "trims" << endl;
+
+    for (auto rate : {0u, pacedRate})
+    {
+        const auto count = rate ? pacedCount : sliceCount;
+        if (rate)
+        {
+            cout << endl
+                 << "paced at " << rate << " slices/s:" << endl;
+        }
+
+        auto result = run<FramePool, FrameQueue>(count, rate);
+        print("FramePool + FrameQueue", result);
+        result = run<FramePool, FrameQueueLockFree>(count, rate);
+        print("FramePool + FrameQueueLockFree", result);
+        result = run<FramePoolLockFree, FrameQueueLockFree>(count, rate);
+        print("FramePoolLockFree + FrameQueueLockFree", result);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -35,8 +35,9 @@
 
 #include "ifxAlgo/2DMTI.h"
 
-#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
@@ -59,9 +60,10 @@
  */
 struct ifx_2DMTI_R_s
 {
-    ifx_Float_t alpha_MTI_filter;     /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
-    ifx_Matrix_R_t* filter_history_r; /**< A real matrix container that stores the historical
-                                           data to be subtracted from the next incoming matrix data.*/
+    ifx_Float_t alpha_MTI_filter;   /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
+    ifx_Cube_R_t* filter_history_r; /**< A real cube container that stores the historical
+                                         data to be subtracted from the next incoming data,
+                                         a single slice for matrices.*/
 };
 
 /**
@@ -70,9 +72,10 @@ struct ifx_2DMTI_R_s
  */
 struct ifx_2DMTI_C_s
 {
-    ifx_Float_t alpha_MTI_filter;     /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
-    ifx_Matrix_C_t* filter_history_c; /**< A complex matrix container that stores the historical
-                                           data to be subtracted from the next incoming matrix data.*/
+    ifx_Float_t alpha_MTI_filter;   /**< Decides the weight \f$ alpha \f$ of the 2D MTI filter.*/
+    ifx_Cube_C_t* filter_history_c; /**< A complex cube container that stores the historical
+                                         data to be subtracted from the next incoming data,
+                                         a single slice for matrices.*/
 };
 
 /*
@@ -87,12 +90,88 @@ struct ifx_2DMTI_C_s
 ==============================================================================
 */
 
+/**
+ * @brief Runs the MTI filter on an array of up to 3 dimensions
+ *
+ * The history is contiguous with the given shape. Input and output may be
+ * views with arbitrary strides, and may be the same array. Strides are given
+ * in elements, an element consists of floats_per_element floats (1 for real,
+ * 2 for complex data).
+ *
+ * @param [in]     alpha               filter coefficient
+ * @param [in]     shape               shape of input, output and history
+ * @param [in]     floats_per_element  1 for real, 2 for complex data
+ * @param [in]     input               input data
+ * @param [in]     input_stride        strides of input
+ * @param [in,out] history             history of the filter
+ * @param [out]    output              output data
+ * @param [in]     output_stride       strides of output
+ */
+static void mti_run(ifx_Float_t alpha, const uint32_t shape[3], uint32_t floats_per_element,
+                    const ifx_Float_t* input, const size_t input_stride[3],
+                    ifx_Float_t* history,
+                    ifx_Float_t* output, const size_t output_stride[3]);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static void mti_run(ifx_Float_t alpha, const uint32_t shape[3], uint32_t floats_per_element,
+                    const ifx_Float_t* input, const size_t input_stride[3],
+                    ifx_Float_t* history,
+                    ifx_Float_t* output, const size_t output_stride[3])
+{
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    const size_t inner_size = (size_t)shape[2] * floats_per_element;
+    const size_t slice_size = (size_t)shape[1] * shape[2];
+
+    const bool inner_contiguous = (input_stride[2] == 1) && (output_stride[2] == 1);
+    const bool contiguous = inner_contiguous
+                            && (shape[1] == 1 || (input_stride[1] == shape[2] && output_stride[1] == shape[2]))
+                            && (shape[0] == 1 || (input_stride[0] == slice_size && output_stride[0] == slice_size));
+
+    if (contiguous)
+    {
+        // a single pass over all elements
+        kernels->mti_r(input, history, output, alpha, shape[0] * slice_size * floats_per_element);
+        return;
+    }
+
+    const ifx_Float_t beta = 1 - alpha;
+
+    for (uint32_t i = 0; i < shape[0]; i++)
+    {
+        for (uint32_t j = 0; j < shape[1]; j++)
+        {
+            const ifx_Float_t* in = input + (i * input_stride[0] + j * input_stride[1]) * floats_per_element;
+            ifx_Float_t* out = output + (i * output_stride[0] + j * output_stride[1]) * floats_per_element;
+
+            if (inner_contiguous)
+            {
+                kernels->mti_r(in, history, out, alpha, inner_size);
+                history += inner_size;
+                continue;
+            }
+
+            for (uint32_t k = 0; k < shape[2]; k++)
+            {
+                const size_t in_offset = k * input_stride[2] * floats_per_element;
+                const size_t out_offset = k * output_stride[2] * floats_per_element;
+
+                for (uint32_t f = 0; f < floats_per_element; f++)
+                {
+                    const ifx_Float_t input_k = in[in_offset + f];
+                    const ifx_Float_t history_k = *history;
+                    out[out_offset + f] = input_k - history_k;
+                    *history++ = alpha * input_k + beta * history_k;
+                }
+            }
+        }
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -102,15 +181,35 @@ struct ifx_2DMTI_C_s
 ifx_2DMTI_R_t* ifx_2dmti_create_r(ifx_Float_t alpha_mti_filter,
                                   uint32_t rows,
                                   uint32_t columns)
+{
+    return ifx_2dmti_create_cube_r(alpha_mti_filter, rows, columns, 1);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_2DMTI_C_t* ifx_2dmti_create_c(ifx_Float_t alpha_mti_filter,
+                                  uint32_t rows,
+                                  uint32_t columns)
+{
+    return ifx_2dmti_create_cube_c(alpha_mti_filter, rows, columns, 1);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_2DMTI_R_t* ifx_2dmti_create_cube_r(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices)
 {
     IFX_ERR_BRN_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
     IFX_ERR_BRN_ARGUMENT(rows == 0);
     IFX_ERR_BRN_ARGUMENT(columns == 0);
+    IFX_ERR_BRN_ARGUMENT(slices == 0);
 
-    ifx_2DMTI_R_t* h = ifx_mem_alloc(sizeof(struct ifx_2DMTI_R_s));
+    ifx_2DMTI_R_t* h = ifx_mem_calloc(1, sizeof(struct ifx_2DMTI_R_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
-    IFX_ERR_HANDLE_N(h->filter_history_r = ifx_mat_create_r(rows, columns),
+    IFX_ERR_HANDLE_N(h->filter_history_r = ifx_cube_create_r(rows, columns, slices),
                      ifx_2dmti_destroy_r(h));
 
     h->alpha_MTI_filter = alpha_mti_filter;
@@ -120,18 +219,20 @@ ifx_2DMTI_R_t* ifx_2dmti_create_r(ifx_Float_t alpha_mti_filter,
 
 //----------------------------------------------------------------------------
 
-ifx_2DMTI_C_t* ifx_2dmti_create_c(ifx_Float_t alpha_mti_filter,
-                                  uint32_t rows,
-                                  uint32_t columns)
+ifx_2DMTI_C_t* ifx_2dmti_create_cube_c(ifx_Float_t alpha_mti_filter,
+                                       uint32_t rows,
+                                       uint32_t columns,
+                                       uint32_t slices)
 {
     IFX_ERR_BRN_ARGUMENT(alpha_mti_filter < 0 || alpha_mti_filter > 1);
     IFX_ERR_BRN_ARGUMENT(rows == 0);
     IFX_ERR_BRN_ARGUMENT(columns == 0);
+    IFX_ERR_BRN_ARGUMENT(slices == 0);
 
-    ifx_2DMTI_C_t* h = ifx_mem_alloc(sizeof(struct ifx_2DMTI_C_s));
+    ifx_2DMTI_C_t* h = ifx_mem_calloc(1, sizeof(struct ifx_2DMTI_C_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
-    IFX_ERR_HANDLE_N(h->filter_history_c = ifx_mat_create_c(rows, columns),
+    IFX_ERR_HANDLE_N(h->filter_history_c = ifx_cube_create_c(rows, columns, slices),
                      ifx_2dmti_destroy_c(h));
 
     h->alpha_MTI_filter = alpha_mti_filter;
@@ -148,7 +249,7 @@ void ifx_2dmti_destroy_r(ifx_2DMTI_R_t* handle)
         return;
     }
 
-    ifx_mat_destroy_r(handle->filter_history_r);
+    ifx_cube_destroy_r(handle->filter_history_r);
 
     ifx_mem_free(handle);
 }
@@ -162,7 +263,7 @@ void ifx_2dmti_destroy_c(ifx_2DMTI_C_t* handle)
         return;
     }
 
-    ifx_mat_destroy_c(handle->filter_history_c);
+    ifx_cube_destroy_c(handle->filter_history_c);
 
     ifx_mem_free(handle);
 }
@@ -176,27 +277,20 @@ void ifx_2dmti_run_r(ifx_2DMTI_R_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_MAT_BRK_VALID(input);
     IFX_MAT_BRK_VALID(output);
-    IFX_MAT_BRK_DIM(handle->filter_history_r, input);
     IFX_MAT_BRK_DIM(input, output);
 
-    // for shorter names
-    const uint32_t rows = mRows(input);
-    const uint32_t cols = mCols(input);
-    const ifx_Float_t alpha = handle->alpha_MTI_filter;
-    ifx_Matrix_R_t* history = handle->filter_history_r;
+    const ifx_Cube_R_t* history = handle->filter_history_r;
+    IFX_ERR_BRK_COND(cSlices(history) != 1 || cRows(history) != mRows(input) || cCols(history) != mCols(input),
+                     IFX_ERROR_DIMENSION_MISMATCH);
 
     // output_n := input_n - history_n
     // history_n := alpha*input_n + (1-alpha)*history_{n-1}
-    for (uint32_t r = 0; r < rows; r++)
-    {
-        for (uint32_t c = 0; c < cols; c++)
-        {
-            const ifx_Float_t input_rc = mAt(input, r, c);
-            const ifx_Float_t history_rc = mAt(history, r, c);
-            mAt(output, r, c) = input_rc - history_rc;
-            mAt(history, r, c) = alpha * input_rc + (1 - alpha) * history_rc;
-        }
-    }
+    const uint32_t shape[3] = {1, mRows(input), mCols(input)};
+    const size_t input_stride[3] = {0, mStride(input, 0), mStride(input, 1)};
+    const size_t output_stride[3] = {0, mStride(output, 0), mStride(output, 1)};
+
+    mti_run(handle->alpha_MTI_filter, shape, 1,
+            mDat(input), input_stride, cDat(history), mDat(output), output_stride);
 }
 
 //----------------------------------------------------------------------------
@@ -208,29 +302,65 @@ void ifx_2dmti_run_c(ifx_2DMTI_C_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_MAT_BRK_VALID(input);
     IFX_MAT_BRK_VALID(output);
-    IFX_MAT_BRK_DIM(handle->filter_history_c, input);
     IFX_MAT_BRK_DIM(input, output);
 
-    // for shorter names
-    const uint32_t rows = mRows(input);
-    const uint32_t cols = mCols(input);
-    const ifx_Float_t alpha = handle->alpha_MTI_filter;
-    ifx_Matrix_C_t* history = handle->filter_history_c;
+    const ifx_Cube_C_t* history = handle->filter_history_c;
+    IFX_ERR_BRK_COND(cSlices(history) != 1 || cRows(history) != mRows(input) || cCols(history) != mCols(input),
+                     IFX_ERROR_DIMENSION_MISMATCH);
 
     // output_n := input_n - history_n
     // history_n := alpha*input_n + (1-alpha)*history_{n-1}
-    for (uint32_t r = 0; r < rows; r++)
-    {
-        for (uint32_t c = 0; c < cols; c++)
-        {
-            const ifx_Complex_t input_rc = mAt(input, r, c);
-            const ifx_Complex_t history_rc = mAt(history, r, c);
-            mAt(output, r, c) = ifx_complex_sub(input_rc, history_rc);
-            mAt(history, r, c) = ifx_complex_add(
-                ifx_complex_mul_real(input_rc, alpha),
-                ifx_complex_mul_real(history_rc, (1 - alpha)));
-        }
-    }
+    // applied to real and imaginary parts separately
+    const uint32_t shape[3] = {1, mRows(input), mCols(input)};
+    const size_t input_stride[3] = {0, mStride(input, 0), mStride(input, 1)};
+    const size_t output_stride[3] = {0, mStride(output, 0), mStride(output, 1)};
+
+    mti_run(handle->alpha_MTI_filter, shape, 2,
+            (const ifx_Float_t*)mDat(input), input_stride,
+            (ifx_Float_t*)cDat(history),
+            (ifx_Float_t*)mDat(output), output_stride);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_run_cube_r(ifx_2DMTI_R_t* handle,
+                          const ifx_Cube_R_t* input,
+                          ifx_Cube_R_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
+    IFX_CUBE_BRK_DIM(handle->filter_history_r, input);
+    IFX_CUBE_BRK_DIM(input, output);
+
+    const uint32_t shape[3] = {cRows(input), cCols(input), cSlices(input)};
+    const size_t input_stride[3] = {cStride(input, 0), cStride(input, 1), cStride(input, 2)};
+    const size_t output_stride[3] = {cStride(output, 0), cStride(output, 1), cStride(output, 2)};
+
+    mti_run(handle->alpha_MTI_filter, shape, 1,
+            cDat(input), input_stride, cDat(handle->filter_history_r), cDat(output), output_stride);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_2dmti_run_cube_c(ifx_2DMTI_C_t* handle,
+                          const ifx_Cube_C_t* input,
+                          ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
+    IFX_CUBE_BRK_DIM(handle->filter_history_c, input);
+    IFX_CUBE_BRK_DIM(input, output);
+
+    const uint32_t shape[3] = {cRows(input), cCols(input), cSlices(input)};
+    const size_t input_stride[3] = {cStride(input, 0), cStride(input, 1), cStride(input, 2)};
+    const size_t output_stride[3] = {cStride(output, 0), cStride(output, 1), cStride(output, 2)};
+
+    mti_run(handle->alpha_MTI_filter, shape, 2,
+            (const ifx_Float_t*)cDat(input), input_stride,
+            (ifx_Float_t*)cDat(handle->filter_history_c),
+            (ifx_Float_t*)cDat(output), output_stride);
 }
 
 //----------------------------------------------------------------------------
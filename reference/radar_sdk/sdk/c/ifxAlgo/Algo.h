@@ -49,10 +49,12 @@
 #include <ifxAlgo/2DMTI.h>
 #include <ifxAlgo/DBSCAN.h>
 #include <ifxAlgo/FFT.h>
+#include <ifxAlgo/FixedPoint.h>
 #include <ifxAlgo/MTI.h>
 #include <ifxAlgo/OSCFAR.h>
 #include <ifxAlgo/PreprocessedFFT.h>
 #include <ifxAlgo/Signal.h>
+#include <ifxAlgo/SlowTimeBuffer.h>
 #include <ifxAlgo/Window.h>
 
 
@@ -33,6 +33,7 @@
 ==============================================================================
 */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "ifxAlgo/DBSCAN.h"
@@ -51,26 +52,56 @@
 ==============================================================================
 */
 
+/* A grid cell is identified by its column in the upper and its row in the
+ * lower 16 bits. Detections are sorted by cell and, within a cell, by index.
+ */
+#define CELL_KEY(cx, cy) (((uint32_t)(cx) << 16) | (uint32_t)(cy))
+#define CELL_ENTRY(key, idx) (((uint64_t)(key) << 16) | (uint64_t)(idx))
+#define ENTRY_KEY(entry) ((uint32_t)((entry) >> 16))
+#define ENTRY_INDEX(entry) ((uint16_t)((entry)&0xFFFF))
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+/**
+ * @brief Detections sorted by the grid cell they fall into.
+ *
+ * Cells are min_dist wide, so all neighbors of a detection are in the
+ * 3x3 cells around its own cell.
+ */
+typedef struct
+{
+    uint64_t* entries; /**< Cell key and detection index, sorted.*/
+    uint16_t count;    /**< Number of detections.*/
+    uint16_t cell;     /**< Width and height of a cell.*/
+} grid_t;
+
 /**
  * @brief Defines the structure for DBSCAN module related settings.
  *        Use type ifx_DBSCAN_t for this struct.
  */
 struct ifx_DBSCAN_s
 {
-    uint16_t min_points;             /**< Minimum number of neighbor points to be recognized as a cluster.*/
-    ifx_Float_t min_dist;            /**< Minimum distance at which a point is recognized as a neighbor.*/
-    uint16_t max_num_detections;     /**< Maximum number of detections (points) which can appear.*/
-    uint8_t* visited;                /**< ... */
-    uint8_t* is_noise;               /**< ... */
-    uint16_t* neighbors;             /**< ... */
-    uint16_t* new_neighbors;         /**< ... */
-    ifx_Matrix_R_t* distance_matrix; /**< ... */
+    uint16_t min_points;         /**< Minimum number of neighbor points to be recognized as a cluster.*/
+    ifx_Float_t min_dist;        /**< Minimum distance at which a point is recognized as a neighbor.*/
+    uint16_t max_num_detections; /**< Maximum number of detections (points) which can appear.*/
+    uint8_t* visited;            /**< Detections whose neighbors have been searched.*/
+    uint8_t* is_noise;           /**< Detections with less than min_points neighbors.*/
+    uint16_t* neighbors;         /**< Detections of the cluster being expanded.*/
+    uint16_t* new_neighbors;     /**< Neighbors of one detection.*/
+    uint16_t* queued;            /**< Cluster a detection was last added to neighbors for.*/
+    grid_t grid;                 /**< Spatial index of the current detections.*/
+
+    // incremental mode
+    grid_t prev_grid;          /**< Spatial index of the previous frame.*/
+    uint16_t* prev_detections; /**< Detections of the previous frame.*/
+    uint16_t* prev_clusters;   /**< Cluster IDs of the previous frame.*/
+    uint16_t* cluster_ids;     /**< Cluster ID assigned to each cluster of the current frame.*/
+    uint64_t* votes;           /**< Scratch buffer to match the clusters with the previous frame.*/
+    uint16_t next_cluster_id;  /**< ID of the next new cluster.*/
 };
 
 /*
@@ -85,112 +116,191 @@ struct ifx_DBSCAN_s
 ==============================================================================
 */
 
-static uint8_t exists(uint16_t element,
-                      const uint16_t* array,
-                      uint16_t num_elements);
+static int compare_entries(const void* a,
+                           const void* b);
+
+static void grid_build(grid_t* grid,
+                       const uint16_t* detections,
+                       uint16_t num_detections,
+                       ifx_Float_t min_dist);
+
+static uint32_t grid_lower_bound(const grid_t* grid,
+                                 uint32_t key);
 
-static void merge_neighbors(uint16_t* from,
+static uint16_t grid_neighbors(const grid_t* grid,
+                               const uint16_t* grid_detections,
+                               uint16_t x,
+                               uint16_t y,
+                               ifx_Float_t min_dist,
+                               uint16_t* neighbors);
+
+static void merge_neighbors(ifx_DBSCAN_t* h,
+                            uint16_t cluster,
+                            const uint16_t* from,
                             uint16_t num_from,
                             uint16_t* to,
                             uint16_t* num_to);
 
 static int check_neighbors(ifx_DBSCAN_t* h,
-                           int num_detections,
+                           const uint16_t* detections,
                            int i,
                            uint16_t* neighbors);
 
-static void dist(const uint16_t* a,
-                 uint16_t rows,
-                 ifx_Matrix_R_t* distance_matrix);
-
 static void expand_cluster(ifx_DBSCAN_t* h,
-                           int num_detections,
+                           const uint16_t* detections,
                            int detection_idx,
                            uint16_t num_neighbors,
                            uint16_t num_clusters,
                            uint16_t* cluster_vector);
 
+static uint16_t cluster(ifx_DBSCAN_t* h,
+                        const uint16_t* detections,
+                        uint16_t num_detections,
+                        uint16_t* cluster_vector);
+
+static void match_clusters(ifx_DBSCAN_t* h,
+                           const uint16_t* detections,
+                           uint16_t num_detections,
+                           uint16_t num_clusters,
+                           uint16_t* cluster_vector);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
-static uint8_t exists(uint16_t element,
-                      const uint16_t* array,
-                      uint16_t num_elements)
+static int compare_entries(const void* a,
+                           const void* b)
+{
+    const uint64_t ea = *(const uint64_t*)a;
+    const uint64_t eb = *(const uint64_t*)b;
+
+    return (ea > eb) - (ea < eb);
+}
+
+//----------------------------------------------------------------------------
+
+static void grid_build(grid_t* grid,
+                       const uint16_t* detections,
+                       uint16_t num_detections,
+                       ifx_Float_t min_dist)
 {
-    for (int i = 0; i < num_elements; i++)
+    /* Coordinates are integers, so a neighbor is at most floor(min_dist)
+     * away in each direction.
+     */
+    grid->cell = (min_dist < 1) ? 1 : (min_dist >= 0xFFFF) ? 0xFFFF : (uint16_t)min_dist;
+    grid->count = num_detections;
+
+    for (uint16_t i = 0; i < num_detections; i++)
     {
-        if (array[i] == element)
-        {
-            return 1;
-        }
+        const uint32_t key = CELL_KEY(detections[2 * i] / grid->cell, detections[2 * i + 1] / grid->cell);
+        grid->entries[i] = CELL_ENTRY(key, i);
     }
 
-    return 0;
+    qsort(grid->entries, num_detections, sizeof(uint64_t), compare_entries);
 }
 
 //----------------------------------------------------------------------------
 
-static void merge_neighbors(uint16_t* from,
-                            uint16_t num_from,
-                            uint16_t* to,
-                            uint16_t* num_to)
+static uint32_t grid_lower_bound(const grid_t* grid,
+                                 uint32_t key)
 {
-    for (uint16_t i = 0; i < num_from; i++)
+    uint32_t first = 0;
+    uint32_t count = grid->count;
+
+    while (count > 0)
     {
-        if (!exists(from[i], to, *num_to))
+        const uint32_t half = count / 2;
+        if (ENTRY_KEY(grid->entries[first + half]) < key)
         {
-            to[*num_to] = from[i];
-            (*num_to)++;
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
         }
     }
+
+    return first;
 }
 
 //----------------------------------------------------------------------------
 
-static int check_neighbors(ifx_DBSCAN_t* h,
-                           int num_detections,
-                           int i,
-                           uint16_t* neighbors)
+static uint16_t grid_neighbors(const grid_t* grid,
+                               const uint16_t* grid_detections,
+                               uint16_t x,
+                               uint16_t y,
+                               ifx_Float_t min_dist,
+                               uint16_t* neighbors)
 {
-    int n = 0;
+    if (grid->count == 0)
+    {
+        return 0;
+    }
+
+    const int32_t cx = x / grid->cell;
+    const int32_t cy = y / grid->cell;
+    uint16_t n = 0;
+
+    for (int32_t col = MAX(cx - 1, 0); col <= MIN(cx + 1, 0xFFFF); col++)
+    {
+        // the rows cy-1 to cy+1 of a column are adjacent in the sorted entries
+        const uint32_t last_key = CELL_KEY(col, MIN(cy + 1, 0xFFFF));
 
-    for (int j = 0; j < num_detections; j++)
-        if (mAt(h->distance_matrix, i, j) <= h->min_dist)
+        for (uint32_t e = grid_lower_bound(grid, CELL_KEY(col, MAX(cy - 1, 0)));
+             e < grid->count && ENTRY_KEY(grid->entries[e]) <= last_key;
+             e++)
         {
-            neighbors[n++] = j;
+            const uint16_t j = ENTRY_INDEX(grid->entries[e]);
+            const ifx_Float_t x2 = grid_detections[j * 2];
+            const ifx_Float_t y2 = grid_detections[j * 2 + 1];
+
+            if (HYPOT(x2 - x, y2 - y) <= min_dist)
+            {
+                neighbors[n++] = j;
+            }
         }
+    }
 
     return n;
 }
 
 //----------------------------------------------------------------------------
 
-static void dist(const uint16_t* a,
-                 uint16_t rows,
-                 ifx_Matrix_R_t* distance_matrix)
+static void merge_neighbors(ifx_DBSCAN_t* h,
+                            uint16_t cluster,
+                            const uint16_t* from,
+                            uint16_t num_from,
+                            uint16_t* to,
+                            uint16_t* num_to)
 {
-    for (int i = 0; i < rows; i++)
+    for (uint16_t i = 0; i < num_from; i++)
     {
-        ifx_Float_t x1 = a[i * 2];
-        ifx_Float_t y1 = a[i * 2 + 1];
-
-        for (int j = 0; j < rows; j++)
+        if (h->queued[from[i]] != cluster)
         {
-            ifx_Float_t x2 = a[j * 2];
-            ifx_Float_t y2 = a[j * 2 + 1];
-
-            mAt(distance_matrix, i, j) = HYPOT(x2 - x1, y2 - y1);
+            h->queued[from[i]] = cluster;
+            to[*num_to] = from[i];
+            (*num_to)++;
         }
     }
 }
 
 //----------------------------------------------------------------------------
 
+static int check_neighbors(ifx_DBSCAN_t* h,
+                           const uint16_t* detections,
+                           int i,
+                           uint16_t* neighbors)
+{
+    return grid_neighbors(&h->grid, detections, detections[i * 2], detections[i * 2 + 1], h->min_dist, neighbors);
+}
+
+//----------------------------------------------------------------------------
+
 static void expand_cluster(ifx_DBSCAN_t* h,
-                           int num_detections,
+                           const uint16_t* detections,
                            int detection_idx,
                            uint16_t num_neighbors,
                            uint16_t num_clusters,
@@ -198,6 +308,11 @@ static void expand_cluster(ifx_DBSCAN_t* h,
 {
     cluster_vector[detection_idx] = num_clusters;
 
+    for (int n_i = 0; n_i < num_neighbors; n_i++)
+    {
+        h->queued[h->neighbors[n_i]] = num_clusters;
+    }
+
     for (int n_i = 0; n_i < num_neighbors; n_i++)
     {
         int cur_det_i = h->neighbors[n_i];
@@ -205,11 +320,11 @@ static void expand_cluster(ifx_DBSCAN_t* h,
         if (!h->visited[cur_det_i])
         {
             h->visited[cur_det_i] = 1;
-            int num_new_neighbors = check_neighbors(h, num_detections, cur_det_i, h->new_neighbors);
+            int num_new_neighbors = check_neighbors(h, detections, cur_det_i, h->new_neighbors);
 
             if (num_new_neighbors >= h->min_points)
             {
-                merge_neighbors(h->new_neighbors, num_new_neighbors, h->neighbors, &num_neighbors);
+                merge_neighbors(h, num_clusters, h->new_neighbors, num_new_neighbors, h->neighbors, &num_neighbors);
             }
         }
 
@@ -220,6 +335,136 @@ static void expand_cluster(ifx_DBSCAN_t* h,
     }
 }
 
+//----------------------------------------------------------------------------
+
+static uint16_t cluster(ifx_DBSCAN_t* h,
+                        const uint16_t* detections,
+                        uint16_t num_detections,
+                        uint16_t* cluster_vector)
+{
+    uint16_t num_clusters = 0;
+
+    memset(cluster_vector, 0, num_detections * sizeof(uint16_t));
+    memset(h->is_noise, 0, h->max_num_detections);
+    memset(h->visited, 0, h->max_num_detections);
+    memset(h->queued, 0, h->max_num_detections * sizeof(uint16_t));
+
+    grid_build(&h->grid, detections, num_detections, h->min_dist);
+
+    for (int i = 0; i < num_detections; i++)
+    {
+        if (!h->visited[i])
+        {
+            h->visited[i] = 1;
+            int num_neighbors = check_neighbors(h, detections, i, h->neighbors);
+
+            if (num_neighbors < h->min_points)
+            {
+                h->is_noise[i] = 1;
+            }
+            else
+            {
+                num_clusters++;
+                expand_cluster(h, detections, i, num_neighbors, num_clusters, cluster_vector);
+            }
+        }
+    }
+
+    return num_clusters;
+}
+
+//----------------------------------------------------------------------------
+
+static void match_clusters(ifx_DBSCAN_t* h,
+                           const uint16_t* detections,
+                           uint16_t num_detections,
+                           uint16_t num_clusters,
+                           uint16_t* cluster_vector)
+{
+    uint32_t num_votes = 0;
+
+    /* Every clustered detection votes for the cluster of a clustered
+     * detection of the previous frame within min_dist.
+     */
+    for (uint16_t i = 0; i < num_detections; i++)
+    {
+        if (cluster_vector[i] == 0)
+        {
+            continue;
+        }
+
+        uint16_t num = grid_neighbors(&h->prev_grid, h->prev_detections, detections[2 * i], detections[2 * i + 1],
+                                      h->min_dist, h->new_neighbors);
+        for (uint16_t n = 0; n < num; n++)
+        {
+            const uint16_t prev_id = h->prev_clusters[h->new_neighbors[n]];
+            if (prev_id != 0)
+            {
+                h->votes[num_votes++] = ((uint64_t)cluster_vector[i] << 16) | prev_id;
+                break;
+            }
+        }
+    }
+
+    qsort(h->votes, num_votes, sizeof(uint64_t), compare_entries);
+
+    /* Each cluster nominates the previous cluster with the most votes,
+     * stored as (previous ID, inverted count, cluster). Sorted, the first
+     * nomination of each previous ID has the most votes and keeps it.
+     */
+    uint32_t num_nominations = 0;
+    for (uint32_t v = 0; v < num_votes;)
+    {
+        const uint16_t c = (uint16_t)(h->votes[v] >> 16);
+        uint16_t best_id = 0;
+        uint32_t best_count = 0;
+
+        while (v < num_votes && (uint16_t)(h->votes[v] >> 16) == c)
+        {
+            const uint16_t prev_id = (uint16_t)(h->votes[v] & 0xFFFF);
+            uint32_t count = 0;
+            for (; v < num_votes && h->votes[v] == (((uint64_t)c << 16) | prev_id); v++)
+            {
+                count++;
+            }
+            if (count > best_count)
+            {
+                best_count = count;
+                best_id = prev_id;
+            }
+        }
+
+        // votes are consumed, so the nominations can reuse the buffer
+        h->votes[num_nominations++] = ((uint64_t)best_id << 32) | ((uint64_t)(0xFFFF - best_count) << 16) | c;
+    }
+
+    qsort(h->votes, num_nominations, sizeof(uint64_t), compare_entries);
+
+    memset(h->cluster_ids, 0, (num_clusters + 1) * sizeof(uint16_t));
+    for (uint32_t n = 0; n < num_nominations; n++)
+    {
+        const uint16_t prev_id = (uint16_t)(h->votes[n] >> 32);
+        if (n == 0 || prev_id != (uint16_t)(h->votes[n - 1] >> 32))
+        {
+            h->cluster_ids[h->votes[n] & 0xFFFF] = prev_id;
+        }
+    }
+
+    for (uint16_t c = 1; c <= num_clusters; c++)
+    {
+        if (h->cluster_ids[c] == 0)
+        {
+            h->cluster_ids[c] = h->next_cluster_id;
+            h->next_cluster_id = (h->next_cluster_id == 0xFFFF) ? 1 : h->next_cluster_id + 1;
+        }
+    }
+
+    for (uint16_t i = 0; i < num_detections; i++)
+    {
+        cluster_vector[i] = h->cluster_ids[cluster_vector[i]];
+    }
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -234,6 +479,7 @@ ifx_DBSCAN_t* ifx_dbscan_create(const ifx_DBSCAN_Config_t* config)
     IFX_ERR_BRN_ARGUMENT(config->min_points < 1);
     IFX_ERR_BRN_ARGUMENT(config->min_dist <= 0);
     IFX_ERR_BRN_ARGUMENT(config->max_num_detections <= config->min_points);
+    IFX_ERR_BRN_ARGUMENT(config->max_num_detections > 0xFFFF);
 
     h = ifx_mem_calloc(1, sizeof(struct ifx_DBSCAN_s));
     IFX_ERR_BRN_MEMALLOC(h);
@@ -241,18 +487,32 @@ ifx_DBSCAN_t* ifx_dbscan_create(const ifx_DBSCAN_Config_t* config)
     h->max_num_detections = config->max_num_detections;
     h->min_dist = config->min_dist;
     h->min_points = config->min_points;
-
-    h->distance_matrix = ifx_mat_create_r(config->max_num_detections, config->max_num_detections);
-    h->is_noise = ifx_mem_calloc(config->max_num_detections, sizeof(uint8_t));
-    h->visited = ifx_mem_calloc(config->max_num_detections, sizeof(uint8_t));
-    h->neighbors = ifx_mem_calloc(config->max_num_detections, sizeof(uint16_t));
-    h->new_neighbors = ifx_mem_calloc(config->max_num_detections, sizeof(uint16_t));
-
-    if (h->distance_matrix == NULL
-        || h->is_noise == NULL
+    h->next_cluster_id = 1;
+
+    const size_t n = config->max_num_detections;
+    h->is_noise = ifx_mem_calloc(n, sizeof(uint8_t));
+    h->visited = ifx_mem_calloc(n, sizeof(uint8_t));
+    h->neighbors = ifx_mem_calloc(n, sizeof(uint16_t));
+    h->new_neighbors = ifx_mem_calloc(n, sizeof(uint16_t));
+    h->queued = ifx_mem_calloc(n, sizeof(uint16_t));
+    h->grid.entries = ifx_mem_calloc(n, sizeof(uint64_t));
+    h->prev_grid.entries = ifx_mem_calloc(n, sizeof(uint64_t));
+    h->prev_detections = ifx_mem_calloc(2 * n, sizeof(uint16_t));
+    h->prev_clusters = ifx_mem_calloc(n, sizeof(uint16_t));
+    h->cluster_ids = ifx_mem_calloc(n + 1, sizeof(uint16_t));
+    h->votes = ifx_mem_calloc(n, sizeof(uint64_t));
+
+    if (h->is_noise == NULL
         || h->visited == NULL
         || h->neighbors == NULL
-        || h->new_neighbors == NULL)
+        || h->new_neighbors == NULL
+        || h->queued == NULL
+        || h->grid.entries == NULL
+        || h->prev_grid.entries == NULL
+        || h->prev_detections == NULL
+        || h->prev_clusters == NULL
+        || h->cluster_ids == NULL
+        || h->votes == NULL)
     {
         ifx_dbscan_destroy(h);
         IFX_ERR_BRN_MEMALLOC(NULL);
@@ -270,11 +530,17 @@ void ifx_dbscan_destroy(ifx_DBSCAN_t* handle)
         return;
     }
 
-    ifx_mat_destroy_r(handle->distance_matrix);
     ifx_mem_free(handle->is_noise);
     ifx_mem_free(handle->visited);
     ifx_mem_free(handle->neighbors);
     ifx_mem_free(handle->new_neighbors);
+    ifx_mem_free(handle->queued);
+    ifx_mem_free(handle->grid.entries);
+    ifx_mem_free(handle->prev_grid.entries);
+    ifx_mem_free(handle->prev_detections);
+    ifx_mem_free(handle->prev_clusters);
+    ifx_mem_free(handle->cluster_ids);
+    ifx_mem_free(handle->votes);
 
     ifx_mem_free(handle);
 }
@@ -286,38 +552,47 @@ void ifx_dbscan_run(ifx_DBSCAN_t* handle,
                     uint16_t num_detections,
                     uint16_t* cluster_vector)
 {
-    int num_clusters = 0;
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(detections);
+    IFX_ERR_BRK_NULL(cluster_vector);
 
+    IFX_ERR_BRK_ARGUMENT(num_detections > handle->max_num_detections);
+
+    cluster(handle, detections, num_detections, cluster_vector);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_dbscan_run_incremental(ifx_DBSCAN_t* handle,
+                                const uint16_t* detections,
+                                uint16_t num_detections,
+                                uint16_t* cluster_vector)
+{
     IFX_ERR_BRK_NULL(handle);
     IFX_ERR_BRK_NULL(detections);
     IFX_ERR_BRK_NULL(cluster_vector);
 
     IFX_ERR_BRK_ARGUMENT(num_detections > handle->max_num_detections);
 
-    memset(cluster_vector, 0, num_detections * sizeof(uint16_t));
-    memset(handle->is_noise, 0, handle->max_num_detections);
-    memset(handle->visited, 0, handle->max_num_detections);
+    const uint16_t num_clusters = cluster(handle, detections, num_detections, cluster_vector);
+    match_clusters(handle, detections, num_detections, num_clusters, cluster_vector);
 
-    dist(detections, num_detections, handle->distance_matrix);
+    // the index of this frame is the previous one of the next frame
+    uint64_t* entries = handle->prev_grid.entries;
+    handle->prev_grid = handle->grid;
+    handle->grid.entries = entries;
+    memcpy(handle->prev_detections, detections, 2 * num_detections * sizeof(uint16_t));
+    memcpy(handle->prev_clusters, cluster_vector, num_detections * sizeof(uint16_t));
+}
 
-    for (int i = 0; i < num_detections; i++)
-    {
-        if (!handle->visited[i])
-        {
-            handle->visited[i] = 1;
-            int num_neighbors = check_neighbors(handle, num_detections, i, handle->neighbors);
+//----------------------------------------------------------------------------
 
-            if (num_neighbors < handle->min_points)
-            {
-                handle->is_noise[i] = 1;
-            }
-            else
-            {
-                num_clusters++;
-                expand_cluster(handle, num_detections, i, num_neighbors, num_clusters, cluster_vector);
-            }
-        }
-    }
+void ifx_dbscan_reset(ifx_DBSCAN_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->prev_grid.count = 0;
+    handle->next_cluster_id = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -128,6 +128,9 @@ void ifx_dbscan_destroy(ifx_DBSCAN_t* handle);
  * @brief Performs the DBSCAN (Density-based spatial clustering of applications with noise)
  * algorithm on given detections.
  *
+ * Neighbors are found with a grid of min_dist wide cells, so the memory of
+ * the handle grows linearly with max_num_detections.
+ *
  * @param [in]     handle              A handle to the DBSCAN object.
  * @param [in]     detections          The detection points to search for clusters in. Note that detections
  *                                     must store the coordinates interleaved (x1, y1, x2, y2,..., xn, yn).
@@ -143,6 +146,39 @@ void ifx_dbscan_run(ifx_DBSCAN_t* handle,
                     uint16_t num_detections,
                     uint16_t* cluster_vector);
 
+/**
+ * @brief Performs DBSCAN on the detections of a frame and keeps the cluster IDs
+ * of the previous frame.
+ *
+ * Same as \ref ifx_dbscan_run, but a cluster that overlaps a cluster of the
+ * previous call (has detections within min_dist of it) gets the ID of that
+ * cluster. If several clusters overlap the same previous cluster, the one
+ * with the most overlapping detections keeps its ID. All other clusters get
+ * new IDs, which increase from call to call and wrap around after 65535.
+ * 0 still marks noise. Use \ref ifx_dbscan_reset to start over, e.g. when
+ * the scene changes.
+ *
+ * @param [in]     handle              A handle to the DBSCAN object.
+ * @param [in]     detections          The detection points, see \ref ifx_dbscan_run.
+ * @param [in]     num_detections      Number of detection points.
+ * @param [out]    cluster_vector      The cluster ID of each detection.
+ *                                     This vector must point to valid memory of minimum num_detection elements.
+ */
+IFX_DLL_PUBLIC
+void ifx_dbscan_run_incremental(ifx_DBSCAN_t* handle,
+                                const uint16_t* detections,
+                                uint16_t num_detections,
+                                uint16_t* cluster_vector);
+
+/**
+ * @brief Forgets the clusters of the previous frame used by \ref ifx_dbscan_run_incremental.
+ *
+ * @param [in]     handle              A handle to the DBSCAN object.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_dbscan_reset(ifx_DBSCAN_t* handle);
+
 /**
  * @brief Sets the min points attribute see \ref ifx_DBSCAN_Config_t.
  *
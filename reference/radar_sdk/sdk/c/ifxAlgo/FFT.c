@@ -23,18 +23,28 @@
 ==============================================================================
 */
 
+#include <math.h>
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <mufft.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
 
 #include "ifxAlgo/FFT.h"
+#include "ifxAlgo/internal/FFTBackend.h"
+#include "ifxAlgo/internal/Unchecked.h"
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/ComplexInline.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Math.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
@@ -47,8 +57,19 @@
 // Maximum supported FFT size
 #define FFT_MAX_SIZE (65536U)
 
-// For muFFT the data must be aligned to 32bytes boundary
-#define MUFFT_REQUIRED_ALIGNMENT (32U)
+#define TWO_PI (6.28318530717958647692)
+
+// Minimum zero padding factor for which complex FFTs are pruned, see ifx_fft_set_input_length
+#define PRUNE_MIN_FACTOR (4U)
+
+// Lock protecting the plan cache and the backend selection
+#if defined(_WIN32)
+#define CACHE_LOCK()   AcquireSRWLockExclusive(&cache_lock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&cache_lock)
+#else
+#define CACHE_LOCK()   pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#endif
 
 /*
 ==============================================================================
@@ -56,6 +77,23 @@
 ==============================================================================
 */
 
+/**
+ * @brief Plan of a backend in the plan cache.
+ *
+ * Plans of backends with shared plans are used by all FFT handles of the
+ * same type and size, other plans by one handle at a time. Plans stay in the
+ * cache after the last handle using them is destroyed.
+ */
+typedef struct ifx_FFT_Plan_s
+{
+    const ifx_FFT_Backend_Ops_t* backend; /**< Backend the plan belongs to.*/
+    ifx_FFT_Type_t fft_type;              /**< FFT type of the plan.*/
+    uint32_t fft_size;                    /**< FFT size of the plan.*/
+    void* plan;                           /**< Plan of the backend.*/
+    uint32_t users;                       /**< Number of FFT handles using the plan.*/
+    struct ifx_FFT_Plan_s* next;          /**< Next plan in the cache.*/
+} ifx_FFT_Plan_t;
+
 /**
  * @brief Defines the structure for FFT module.
  *        Use type ifx_FFT_t for this struct.
@@ -67,16 +105,129 @@ struct ifx_FFT_s
     ifx_Complex_t* zero_pad_fft_input_c; /**< Container to store complex zero padded FFT input
                                             in case fft_type is \ref IFX_FFT_TYPE_C2C. Otherwise ignored.*/
     ifx_Complex_t* fft_output_c;         /**< Container to store complex input FFT with half output use case.*/
-    mufft_plan_1d* plan_r2c;             /**< muFFT plan .*/
-    mufft_plan_1d* plan_c2c;             /**< muFFT plan .*/
+    const ifx_FFT_Backend_Ops_t* backend; /**< FFT library computing the FFT.*/
+    ifx_FFT_Plan_t* plan;                /**< Plan from the plan cache.*/
+    uint32_t prune_size;                 /**< Size of the FFTs of the pruned FFT, 0 if not pruned.*/
+    ifx_FFT_Plan_t* prune_plan;          /**< Plan of the FFTs of size prune_size.*/
+    ifx_Complex_t* prune_twiddles;       /**< exp(-2*pi*i*k/fft_size) for k < fft_size.*/
+    ifx_Complex_t* prune_buffer;         /**< Input and output of one FFT of size prune_size.*/
 };
 
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+#if defined(_WIN32)
+static SRWLOCK cache_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static ifx_FFT_Plan_t* plan_cache = NULL;
+
+// IFX_FFT_BACKEND_DEFAULT until the first FFT handle is created or a backend is selected
+static ifx_FFT_Backend_t selected_backend = IFX_FFT_BACKEND_DEFAULT;
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+/** @brief Get operations of backend or NULL if not available */
+static const ifx_FFT_Backend_Ops_t* get_backend_ops(ifx_FFT_Backend_t backend)
+{
+    switch (backend)
+    {
+        case IFX_FFT_BACKEND_MUFFT:
+            return &ifx_fft_backend_mufft;
+#ifdef IFX_FFT_FFTW
+        case IFX_FFT_BACKEND_FFTW:
+            return &ifx_fft_backend_fftw;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+static ifx_FFT_Backend_t resolve_backend(ifx_FFT_Backend_t backend)
+{
+    if (backend != IFX_FFT_BACKEND_DEFAULT)
+        return backend;
+
+#ifdef IFX_FFT_FFTW
+    return IFX_FFT_BACKEND_FFTW;
+#else
+    return IFX_FFT_BACKEND_MUFFT;
+#endif
+}
+
+/** @brief Get backend for new FFT handles
+ *
+ * On the first call the environment variable IFX_FFT_BACKEND is evaluated
+ * unless a backend was selected with ifx_fft_set_backend before.
+ * Must be called with the cache lock held.
+ */
+static ifx_FFT_Backend_t current_backend(void)
+{
+    if (selected_backend == IFX_FFT_BACKEND_DEFAULT)
+    {
+        const char* name = getenv("IFX_FFT_BACKEND");
+        ifx_FFT_Backend_t backend = IFX_FFT_BACKEND_DEFAULT;
+        if (name && !strcmp(name, "mufft"))
+            backend = IFX_FFT_BACKEND_MUFFT;
+        else if (name && !strcmp(name, "fftw"))
+            backend = IFX_FFT_BACKEND_FFTW;
+
+        // silently ignore unknown or unavailable backends
+        if (get_backend_ops(backend) == NULL)
+            backend = resolve_backend(IFX_FFT_BACKEND_DEFAULT);
+
+        selected_backend = backend;
+    }
+
+    return selected_backend;
+}
+
+/** @brief Get plan from the cache or create a new one
+ *
+ * Must be called with the cache lock held.
+ */
+static ifx_FFT_Plan_t* acquire_plan(const ifx_FFT_Backend_Ops_t* backend, ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    for (ifx_FFT_Plan_t* entry = plan_cache; entry != NULL; entry = entry->next)
+    {
+        if (entry->backend == backend && entry->fft_type == fft_type && entry->fft_size == fft_size
+            && (backend->shared || entry->users == 0))
+        {
+            entry->users++;
+            return entry;
+        }
+    }
+
+    ifx_FFT_Plan_t* entry = ifx_mem_calloc(1, sizeof(ifx_FFT_Plan_t));
+    if (entry == NULL)
+        return NULL;
+
+    entry->plan = backend->create_plan(fft_type, fft_size);
+    if (entry->plan == NULL)
+    {
+        ifx_mem_free(entry);
+        return NULL;
+    }
+
+    entry->backend = backend;
+    entry->fft_type = fft_type;
+    entry->fft_size = fft_size;
+    entry->users = 1;
+    entry->next = plan_cache;
+    plan_cache = entry;
+
+    return entry;
+}
+
 /** @brief Copy vector to zero padded buffer
  *
  * Copy at most fft_size elements of the vector input to buffer. If the length
@@ -88,9 +239,14 @@ static void copy_to_buffer_zeropadded_c(const ifx_Vector_C_t* input, ifx_Complex
     // length of FFT input
     const uint32_t len = MIN(fft_size, vLen(input));
 
-    // Do not use memcpy because of potential stride != 1
-    for (uint32_t i = 0; i < len; i++)
-        buffer[i] = vAt(input, i);
+    // memcpy is only possible for stride == 1 (views may be strided)
+    if (vStride(input) == 1)
+        memcpy(buffer, vDat(input), len * sizeof(ifx_Complex_t));
+    else
+    {
+        for (uint32_t i = 0; i < len; i++)
+            buffer[i] = vAt(input, i);
+    }
 
     // zero padding
     const ifx_Complex_t complex_zero = IFX_COMPLEX_DEF(0, 0);
@@ -103,9 +259,14 @@ static void copy_to_buffer_zeropadded_r(const ifx_Vector_R_t* input, ifx_Float_t
     // length of FFT input
     const uint32_t len = MIN(fft_size, vLen(input));
 
-    // Do not use memcpy because of potential stride != 1
-    for (uint32_t i = 0; i < len; i++)
-        buffer[i] = vAt(input, i);
+    // memcpy is only possible for stride == 1 (views may be strided)
+    if (vStride(input) == 1)
+        memcpy(buffer, vDat(input), len * sizeof(ifx_Float_t));
+    else
+    {
+        for (uint32_t i = 0; i < len; i++)
+            buffer[i] = vAt(input, i);
+    }
 
     // zero padding
     for (uint32_t i = len; i < fft_size; i++)
@@ -119,11 +280,225 @@ static void fill_negative_half(ifx_Complex_t* output, uint32_t output_size, uint
         for (uint32_t i = (fft_size / 2 + 1); i < fft_size; i++)
         {
             uint32_t i_pos = fft_size - i;
-            output[i] = ifx_complex_conj(output[i_pos]);
+            output[i] = ifx_cconj(output[i_pos]);
         }
     }
 }
 
+/** @brief Pre-process vector into zero padded buffer
+ *
+ * Copy at most len elements of the vector input to buffer while removing
+ * their mean (if mean_removal is true) and multiplying them with the window
+ * (if not NULL). The rest of the fft_size elements of buffer is zero padded.
+ */
+static void preprocess_to_buffer_r(const ifx_Vector_R_t* input, const ifx_Vector_R_t* window, bool mean_removal, ifx_Float_t* buffer, uint32_t len, uint32_t fft_size)
+{
+    const ifx_Float_t* in = vDat(input);
+    const size_t stride = vStride(input);
+
+    ifx_Float_t mean = 0;
+    if (mean_removal && len)
+    {
+        for (uint32_t i = 0; i < len; i++)
+            mean += in[i * stride];
+        mean /= len;
+    }
+
+    if (window)
+    {
+        const ifx_Float_t* w = vDat(window);
+        const size_t w_stride = vStride(window);
+        for (uint32_t i = 0; i < len; i++)
+            buffer[i] = (in[i * stride] - mean) * w[i * w_stride];
+    }
+    else
+    {
+        for (uint32_t i = 0; i < len; i++)
+            buffer[i] = in[i * stride] - mean;
+    }
+
+    // zero padding
+    for (uint32_t i = len; i < fft_size; i++)
+        buffer[i] = 0;
+}
+
+static void preprocess_to_buffer_c(const ifx_Vector_C_t* input, const ifx_Vector_R_t* window, bool mean_removal, ifx_Complex_t* buffer, uint32_t len, uint32_t fft_size)
+{
+    const ifx_Complex_t* in = vDat(input);
+    const size_t stride = vStride(input);
+
+    ifx_Float_t mean_real = 0;
+    ifx_Float_t mean_imag = 0;
+    if (mean_removal && len)
+    {
+        for (uint32_t i = 0; i < len; i++)
+        {
+            mean_real += IFX_COMPLEX_REAL(in[i * stride]);
+            mean_imag += IFX_COMPLEX_IMAG(in[i * stride]);
+        }
+        mean_real /= len;
+        mean_imag /= len;
+    }
+
+    const ifx_Float_t* w = window ? vDat(window) : NULL;
+    const size_t w_stride = window ? vStride(window) : 0;
+    for (uint32_t i = 0; i < len; i++)
+    {
+        const ifx_Float_t scale = w ? w[i * w_stride] : 1;
+        IFX_COMPLEX_SET(buffer[i],
+                        (IFX_COMPLEX_REAL(in[i * stride]) - mean_real) * scale,
+                        (IFX_COMPLEX_IMAG(in[i * stride]) - mean_imag) * scale);
+    }
+
+    // zero padding
+    const ifx_Complex_t complex_zero = IFX_COMPLEX_DEF(0, 0);
+    for (uint32_t i = len; i < fft_size; i++)
+        buffer[i] = complex_zero;
+}
+
+/** @brief Execute real FFT on aligned and zero padded input
+ *
+ * The FFT is computed directly into output if possible, otherwise into an
+ * internal buffer that is copied to output afterwards.
+ */
+static void execute_rc(ifx_FFT_t* handle, const ifx_Float_t* in, ifx_Vector_C_t* output)
+{
+    // FFT size
+    const uint32_t N = handle->fft_size;
+
+    /* The output vector has to be copied into an internal buffer if
+     *   - length of output vector is smaller than fft_size/2 + 1 because muFFT
+     *     needs at least an output vector of fft_size/2
+     *   - the output vector is not aligned (muFFT requires aligned input and due
+     *     views a the data of a ifx_Vector_C_t vector is not necessarily
+     *     aligned),
+     *   - the stride is not 1 (might happen due to views).
+     */
+    bool copy_output = vLen(output) < (N / 2 + 1) || !IFX_IS_ALIGNED(vDat(output), handle->backend->alignment) || vStride(output) != 1;
+
+    ifx_Complex_t* out = copy_output
+                             ? handle->fft_output_c
+                             : vDat(output);
+
+    // compute FFT
+    handle->backend->execute_rc(handle->plan->plan, in, out);
+
+    // fill negative half if required
+    fill_negative_half(out, vLen(output), N);
+
+    if (copy_output)
+    {
+        // See documentation of ifx_fft_run_rc why len is chosen like this
+        uint32_t len;
+        if (vLen(output) >= N)
+            len = handle->fft_size;
+        else if (vLen(output) >= (N / 2 + 1))
+            len = N / 2 + 1;
+        else
+            len = N / 2;
+
+        // memcpy is only possible for stride == 1 (views may be strided)
+        ifx_Complex_t* dst = vDat(output);
+        const size_t stride = vStride(output);
+        if (stride == 1)
+            memcpy(dst, out, len * sizeof(ifx_Complex_t));
+        else
+        {
+            for (uint32_t i = 0; i < len; i++)
+                dst[i * stride] = out[i];
+        }
+    }
+}
+
+/** @brief Execute complex FFT on aligned and zero padded input
+ */
+static void execute_c(ifx_FFT_t* handle, const ifx_Complex_t* in, ifx_Vector_C_t* output)
+{
+    // FFT size
+    const uint32_t N = handle->fft_size;
+
+    /* We need to use an internal buffer for the output if
+     *   - the output vector is not aligned (might happen due to views),
+     *   - the stride of the output vector is not 1 (might happen due to views).
+     */
+    bool copy_output = !IFX_IS_ALIGNED(vDat(output), handle->backend->alignment) || vStride(output) != 1;
+
+    if (copy_output)
+    {
+        handle->backend->execute_c(handle->plan->plan, in, handle->fft_output_c);
+
+        // memcpy is only possible for stride == 1 (the output is merely unaligned)
+        ifx_Complex_t* out = vDat(output);
+        const size_t stride = vStride(output);
+        if (stride == 1)
+            memcpy(out, handle->fft_output_c, N * sizeof(ifx_Complex_t));
+        else
+        {
+            for (uint32_t i = 0; i < N; i++)
+                out[i * stride] = handle->fft_output_c[i];
+        }
+    }
+    else
+        handle->backend->execute_c(handle->plan->plan, in, vDat(output));
+}
+
+/** @brief Complex FFT of an input of at most prune_size elements
+ *
+ * With P = fft_size/prune_size and M = prune_size, the output bins with
+ * index q*P+p are
+ *      X[q*P+p] = sum_{n<M} (x[n] * W_N^(n*p)) * W_M^(n*q)
+ * as all input elements from M on are zero, i.e. the FFT of the input
+ * multiplied with twiddle factors. So the zero padded FFT is computed as P
+ * FFTs of size M, which skips the first log2(P) stages of butterflies whose
+ * inputs are mostly zeros.
+ */
+static void execute_c_pruned(ifx_FFT_t* handle, const ifx_Complex_t* in, size_t in_stride, uint32_t len, ifx_Vector_C_t* output)
+{
+    const uint32_t N = handle->fft_size;
+    const uint32_t M = handle->prune_size;
+    const uint32_t P = N / M;
+    const ifx_Complex_t complex_zero = IFX_COMPLEX_DEF(0, 0);
+    ifx_Complex_t* buffer = handle->prune_buffer;
+    ifx_Complex_t* out = vDat(output);
+    const size_t out_stride = vStride(output);
+
+    for (uint32_t p = 0; p < P; p++)
+    {
+        // (n * p) mod N indexes the twiddle factor of element n
+        for (uint32_t n = 0, k = 0; n < len; n++, k = (k + p) & (N - 1))
+            buffer[n] = ifx_cmul(in[n * in_stride], handle->prune_twiddles[k]);
+        for (uint32_t n = len; n < M; n++)
+            buffer[n] = complex_zero;
+
+        // the output goes into the second half of the buffer, M >= 4 keeps it aligned
+        handle->backend->execute_c(handle->prune_plan->plan, buffer, buffer + M);
+
+        for (uint32_t q = 0; q < M; q++)
+            out[(q * P + p) * out_stride] = buffer[M + q];
+    }
+}
+
+/** @brief Get view of vector index of a batch matrix */
+static void get_batch_view_r(const ifx_Matrix_R_t* matrix, ifx_FFT_Batch_Axis_t axis, uint32_t index, ifx_Vector_R_t* view)
+{
+    if (axis == IFX_FFT_BATCH_ROWS)
+        ifx_mat_get_rowview_r(matrix, index, view);
+    else
+        ifx_mat_get_colview_r(matrix, index, view);
+}
+
+static void get_batch_view_c(const ifx_Matrix_C_t* matrix, ifx_FFT_Batch_Axis_t axis, uint32_t index, ifx_Vector_C_t* view)
+{
+    if (axis == IFX_FFT_BATCH_ROWS)
+        ifx_mat_get_rowview_c(matrix, index, view);
+    else
+        ifx_mat_get_colview_c(matrix, index, view);
+}
+
+/** @brief Number of vectors and their length in a batch matrix */
+#define BATCH_COUNT(m, axis)  (((axis) == IFX_FFT_BATCH_ROWS) ? mRows(m) : mCols(m))
+#define BATCH_LENGTH(m, axis) (((axis) == IFX_FFT_BATCH_ROWS) ? mCols(m) : mRows(m))
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -148,20 +523,18 @@ ifx_FFT_t* ifx_fft_create(ifx_FFT_Type_t fft_type,
 
     //--------------------------- plan creation -------------------------
 
-    h->fft_output_c = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), MUFFT_REQUIRED_ALIGNMENT);
+    CACHE_LOCK();
+    h->backend = get_backend_ops(current_backend());
+    h->plan = acquire_plan(h->backend, fft_type, fft_size);
+    CACHE_UNLOCK();
+    IFX_ERR_BRF_MEMALLOC(h->plan);
+
+    h->fft_output_c = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), h->backend->alignment);
     IFX_ERR_BRF_MEMALLOC(h->fft_output_c);
 
-    h->zero_pad_fft_input_c = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), MUFFT_REQUIRED_ALIGNMENT);
+    h->zero_pad_fft_input_c = ifx_mem_aligned_alloc(fft_size * sizeof(ifx_Complex_t), h->backend->alignment);
     IFX_ERR_BRF_MEMALLOC(h->zero_pad_fft_input_c);
 
-    // TODO: Info: "NO_AVX seems to be faster for small transforms, maybe even NO_SSE3" - to be aligned with smart-tv
-    const unsigned int flags = MUFFT_FLAG_CPU_NO_AVX;
-    h->plan_c2c = mufft_create_plan_1d_c2c(fft_size, MUFFT_FORWARD, flags);
-    IFX_ERR_BRF_MEMALLOC(h->plan_c2c);
-
-    h->plan_r2c = mufft_create_plan_1d_r2c(fft_size, flags);
-    IFX_ERR_BRF_MEMALLOC(h->plan_r2c);
-
     return h;
 
 fail:
@@ -178,9 +551,18 @@ void ifx_fft_destroy(ifx_FFT_t* handle)
 
     ifx_mem_aligned_free(handle->fft_output_c);
     ifx_mem_aligned_free(handle->zero_pad_fft_input_c);
+    ifx_mem_free(handle->prune_twiddles);
+    ifx_mem_aligned_free(handle->prune_buffer);
 
-    mufft_free_plan_1d(handle->plan_c2c);
-    mufft_free_plan_1d(handle->plan_r2c);
+    if (handle->plan || handle->prune_plan)
+    {
+        CACHE_LOCK();
+        if (handle->plan)
+            handle->plan->users--;
+        if (handle->prune_plan)
+            handle->prune_plan->users--;
+        CACHE_UNLOCK();
+    }
 
     ifx_mem_free(handle);
 }
@@ -199,9 +581,36 @@ void ifx_fft_raw_c(ifx_FFT_t* handle, const ifx_Complex_t* in, ifx_Complex_t* ou
 
 //----------------------------------------------------------------------------
 
+void ifx_fft_raw_hc(ifx_FFT_t* handle, const ifx_Complex16_t* in, uint32_t len, ifx_Complex_t* out)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(in);
+    IFX_ERR_BRK_NULL(out);
+    IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_COMPLEX);
+
+    const uint32_t N = handle->fft_size;
+    len = MIN(len, N);
+
+    ifx_kernels_get()->from_f16((const ifx_Float16_t*)in, (ifx_Float_t*)handle->zero_pad_fft_input_c, 2 * (size_t)len);
+
+    ifx_Vector_C_t output = {0};
+    ifx_vec_rawview_c(&output, out, N, 1);
+
+    if (len <= handle->prune_size)
+    {
+        execute_c_pruned(handle, handle->zero_pad_fft_input_c, 1, len, &output);
+        return;
+    }
+
+    memset(handle->zero_pad_fft_input_c + len, 0, (N - len) * sizeof(ifx_Complex_t));
+    execute_c(handle, handle->zero_pad_fft_input_c, &output);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fft_raw_rc(ifx_FFT_t* handle, const ifx_Float_t* in, ifx_Complex_t* out)
 {
-    mufft_execute_plan_1d(handle->plan_r2c, out, in);
+    handle->backend->execute_rc(handle->plan->plan, in, out);
 }
 
 //----------------------------------------------------------------------------
@@ -214,21 +623,18 @@ void ifx_fft_run_rc(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C
     IFX_VEC_BRK_MINSIZE(output, handle->fft_size / 2);  // Half spectrum output supported
     IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
 
+    ifx_fft_run_rc_unchecked(handle, input, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_rc_unchecked(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C_t* output)
+{
     // FFT size
     const uint32_t N = handle->fft_size;
 
-    // see comment in ifx_fft_run_c
-    bool copy_input = vLen(input) < N || !IFX_IS_ALIGNED(vDat(input), MUFFT_REQUIRED_ALIGNMENT) || vStride(input) != 1;
-
-    /* The output vector has to be copied into an internal buffer if
-     *   - length of output vector is smaller than fft_size/2 + 1 because muFFT
-     *     needs at least an output vector of fft_size/2
-     *   - the output vector is not aligned (muFFT requires aligned input and due
-     *     views a the data of a ifx_Vector_C_t vector is not necessarily
-     *     aligned),
-     *   - the stride is not 1 (might happen due to views).
-     */
-    bool copy_output = vLen(output) < (N / 2 + 1) || !IFX_IS_ALIGNED(vDat(output), MUFFT_REQUIRED_ALIGNMENT) || vStride(output) != 1;
+    // see comment in ifx_fft_run_c_unchecked
+    bool copy_input = vLen(input) < N || !IFX_IS_ALIGNED(vDat(input), handle->backend->alignment) || vStride(input) != 1;
 
     const ifx_Float_t* in = vDat(input);
     if (copy_input)
@@ -237,31 +643,7 @@ void ifx_fft_run_rc(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C
         in = (ifx_Float_t*)handle->zero_pad_fft_input_c;
     }
 
-    ifx_Complex_t* out = copy_output
-                             ? handle->fft_output_c
-                             : vDat(output);
-
-    // compute FFT
-    mufft_execute_plan_1d(handle->plan_r2c, out, in);
-
-    // fill negative half if required
-    fill_negative_half(out, vLen(output), N);
-
-    if (copy_output)
-    {
-        // See documentation of this function why len is chosen like this
-        uint32_t len;
-        if (vLen(output) >= N)
-            len = handle->fft_size;
-        else if (vLen(output) >= (N / 2 + 1))
-            len = N / 2 + 1;
-        else
-            len = N / 2;
-
-        // Do not use memcpy here because of a potential stride != 1
-        for (uint32_t i = 0; i < len; i++)
-            vAt(output, i) = out[i];
-    }
+    execute_rc(handle, in, output);
 }
 
 //----------------------------------------------------------------------------
@@ -274,6 +656,13 @@ void ifx_fft_run_c(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_
     IFX_VEC_BRK_MINSIZE(output, handle->fft_size);
     IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
 
+    ifx_fft_run_c_unchecked(handle, input, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_c_unchecked(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_t* output)
+{
     // FFT size
     const uint32_t N = handle->fft_size;
 
@@ -285,13 +674,13 @@ void ifx_fft_run_c(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_
      *     aligned),
      *   - the stride is not 1 (might happen due to views).
      */
-    bool copy_input = vLen(input) < N || !IFX_IS_ALIGNED(vDat(input), MUFFT_REQUIRED_ALIGNMENT) || vStride(input) != 1;
+    if (vLen(input) <= handle->prune_size)
+    {
+        execute_c_pruned(handle, vDat(input), vStride(input), vLen(input), output);
+        return;
+    }
 
-    /* We need to use an internal buffer for the output if
-     *   - the output vector is not aligned (might happen due to views),
-     *   - the stride of the output vector is not 1 (might happen due to views).
-     */
-    bool copy_output = !IFX_IS_ALIGNED(vDat(output), MUFFT_REQUIRED_ALIGNMENT) || vStride(output) != 1;
+    bool copy_input = vLen(input) < N || !IFX_IS_ALIGNED(vDat(input), handle->backend->alignment) || vStride(input) != 1;
 
     const ifx_Complex_t* in = vDat(input);
     if (copy_input)
@@ -300,16 +689,152 @@ void ifx_fft_run_c(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_
         in = handle->zero_pad_fft_input_c;
     }
 
-    if (copy_output)
+    execute_c(handle, in, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_batch_rc(ifx_FFT_t* handle,
+                          const ifx_Matrix_R_t* input,
+                          ifx_FFT_Batch_Axis_t input_axis,
+                          const ifx_Vector_R_t* window,
+                          bool mean_removal,
+                          ifx_Matrix_C_t* output,
+                          ifx_FFT_Batch_Axis_t output_axis)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
+
+    // FFT size
+    const uint32_t N = handle->fft_size;
+
+    const uint32_t count = BATCH_COUNT(input, input_axis);
+    uint32_t len = MIN(N, BATCH_LENGTH(input, input_axis));
+    if (window)
     {
-        mufft_execute_plan_1d(handle->plan_c2c, handle->fft_output_c, in);
+        IFX_VEC_BRK_VALID(window);
+        len = MIN(len, vLen(window));
+    }
 
-        // Do not use memcpy here because of a potential stride != 1
-        for (uint32_t i = 0; i < N; i++)
-            vAt(output, i) = handle->fft_output_c[i];
+    IFX_ERR_BRK_COND(BATCH_COUNT(output, output_axis) < count, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(BATCH_LENGTH(output, output_axis) < N / 2, IFX_ERROR_DIMENSION_MISMATCH);  // Half spectrum output supported
+
+    // the pre-processing always goes into the aligned buffer, which also does the zero padding
+    ifx_Float_t* buffer = (ifx_Float_t*)handle->zero_pad_fft_input_c;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ifx_Vector_R_t input_view;
+        ifx_Vector_C_t output_view;
+        get_batch_view_r(input, input_axis, i, &input_view);
+        get_batch_view_c(output, output_axis, i, &output_view);
+
+        preprocess_to_buffer_r(&input_view, window, mean_removal, buffer, len, N);
+        execute_rc(handle, buffer, &output_view);
     }
-    else
-        mufft_execute_plan_1d(handle->plan_c2c, vDat(output), in);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_run_batch_c(ifx_FFT_t* handle,
+                         const ifx_Matrix_C_t* input,
+                         ifx_FFT_Batch_Axis_t input_axis,
+                         const ifx_Vector_R_t* window,
+                         bool mean_removal,
+                         ifx_Matrix_C_t* output,
+                         ifx_FFT_Batch_Axis_t output_axis)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_ERR_BRK_COND(handle->fft_type != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_COMPLEX);
+
+    // FFT size
+    const uint32_t N = handle->fft_size;
+
+    const uint32_t count = BATCH_COUNT(input, input_axis);
+    uint32_t len = MIN(N, BATCH_LENGTH(input, input_axis));
+    if (window)
+    {
+        IFX_VEC_BRK_VALID(window);
+        len = MIN(len, vLen(window));
+    }
+
+    IFX_ERR_BRK_COND(BATCH_COUNT(output, output_axis) < count, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(BATCH_LENGTH(output, output_axis) < N, IFX_ERROR_DIMENSION_MISMATCH);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        ifx_Vector_C_t input_view;
+        ifx_Vector_C_t output_view;
+        get_batch_view_c(input, input_axis, i, &input_view);
+        get_batch_view_c(output, output_axis, i, &output_view);
+
+        if (len <= handle->prune_size)
+        {
+            // only the first len elements of the buffer are used
+            preprocess_to_buffer_c(&input_view, window, mean_removal, handle->zero_pad_fft_input_c, len, len);
+            execute_c_pruned(handle, handle->zero_pad_fft_input_c, 1, len, &output_view);
+            continue;
+        }
+
+        preprocess_to_buffer_c(&input_view, window, mean_removal, handle->zero_pad_fft_input_c, len, N);
+        execute_c(handle, handle->zero_pad_fft_input_c, &output_view);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_set_input_length(ifx_FFT_t* handle, uint32_t len)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    const uint32_t N = handle->fft_size;
+
+    // smallest power of 2 holding the input, at least the minimum FFT size
+    uint32_t M = 4;
+    while (M < len)
+        M <<= 1;
+
+    if (len == 0 || handle->fft_type != IFX_FFT_TYPE_C2C || M > N / PRUNE_MIN_FACTOR)
+        M = 0;
+
+    if (M == handle->prune_size)
+        return;
+
+    ifx_mem_free(handle->prune_twiddles);
+    ifx_mem_aligned_free(handle->prune_buffer);
+    handle->prune_twiddles = NULL;
+    handle->prune_buffer = NULL;
+    handle->prune_size = 0;
+
+    CACHE_LOCK();
+    if (handle->prune_plan)
+        handle->prune_plan->users--;
+    handle->prune_plan = M ? acquire_plan(handle->backend, IFX_FFT_TYPE_C2C, M) : NULL;
+    CACHE_UNLOCK();
+
+    if (M == 0)
+        return;
+
+    handle->prune_twiddles = ifx_mem_alloc(N * sizeof(ifx_Complex_t));
+    handle->prune_buffer = ifx_mem_aligned_alloc(2 * M * sizeof(ifx_Complex_t), handle->backend->alignment);
+    if (!handle->prune_plan || !handle->prune_twiddles || !handle->prune_buffer)
+    {
+        // the FFT stays unpruned
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return;
+    }
+
+    for (uint32_t k = 0; k < N; k++)
+    {
+        const double phi = -TWO_PI * k / N;
+        IFX_COMPLEX_SET(handle->prune_twiddles[k], (ifx_Float_t)cos(phi), (ifx_Float_t)sin(phi));
+    }
+
+    handle->prune_size = M;
 }
 
 //----------------------------------------------------------------------------
@@ -332,6 +857,65 @@ ifx_FFT_Type_t ifx_fft_get_fft_type(const ifx_FFT_t* handle)
 
 //----------------------------------------------------------------------------
 
+bool ifx_fft_backend_available(ifx_FFT_Backend_t backend)
+{
+    return backend == IFX_FFT_BACKEND_DEFAULT || get_backend_ops(backend) != NULL;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_set_backend(ifx_FFT_Backend_t backend)
+{
+    IFX_ERR_BRK_COND(!ifx_fft_backend_available(backend), IFX_ERROR_NOT_SUPPORTED);
+
+    CACHE_LOCK();
+    selected_backend = resolve_backend(backend);
+    CACHE_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
+ifx_FFT_Backend_t ifx_fft_get_backend(void)
+{
+    CACHE_LOCK();
+    ifx_FFT_Backend_t backend = current_backend();
+    CACHE_UNLOCK();
+
+    return backend;
+}
+
+//----------------------------------------------------------------------------
+
+const char* ifx_fft_get_backend_name(const ifx_FFT_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, NULL);
+
+    return handle->backend->name;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_clear_plan_cache(void)
+{
+    CACHE_LOCK();
+    ifx_FFT_Plan_t** link = &plan_cache;
+    while (*link != NULL)
+    {
+        ifx_FFT_Plan_t* entry = *link;
+        if (entry->users == 0)
+        {
+            *link = entry->next;
+            entry->backend->destroy_plan(entry->plan);
+            ifx_mem_free(entry);
+        }
+        else
+            link = &entry->next;
+    }
+    CACHE_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fft_shift_r(const ifx_Vector_R_t* input,
                      ifx_Vector_R_t* output)
 {
@@ -44,6 +44,7 @@
 ==============================================================================
 */
 
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
 
@@ -80,6 +81,25 @@ typedef enum
     IFX_FFT_TYPE_C2C = 2U  /**< Input is complex and FFT output is complex.*/
 } ifx_FFT_Type_t;
 
+/**
+ * @brief Defines how the vectors of a batch are arranged in a matrix.
+ */
+typedef enum
+{
+    IFX_FFT_BATCH_ROWS = 0U, /**< Each row of the matrix is one vector.*/
+    IFX_FFT_BATCH_COLS = 1U  /**< Each column of the matrix is one vector.*/
+} ifx_FFT_Batch_Axis_t;
+
+/**
+ * @brief Defines the FFT libraries the FFT module can use.
+ */
+typedef enum
+{
+    IFX_FFT_BACKEND_DEFAULT = 0U, /**< Fastest backend available in this build.*/
+    IFX_FFT_BACKEND_MUFFT = 1U,   /**< muFFT, always available.*/
+    IFX_FFT_BACKEND_FFTW = 2U     /**< FFTW (single precision), available if the SDK is built with SDK_FFT_FFTW.*/
+} ifx_FFT_Backend_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -140,6 +160,10 @@ typedef enum
  *
  * fft_size must be a power of 2, and 4 <= fft_size <= 65536.
  *
+ * The FFT is computed by the backend selected with \ref ifx_fft_set_backend.
+ * Plans are cached per backend, type and size, so creating FFT objects
+ * repeatedly (e.g. when the device configuration changes) is cheap.
+ *
  * @param [in]     fft_type  FFT type, see \ref ifx_FFT_Type_t.
  * @param [in]     fft_size  FFT size \f$N\f$
  *
@@ -217,6 +241,68 @@ void ifx_fft_run_c(ifx_FFT_t* handle,
                    const ifx_Vector_C_t* input,
                    ifx_Vector_C_t* output);
 
+/**
+ * @brief Performs FFT transforms on a batch of real input vectors
+ *
+ * Transforms all rows or all columns of the input matrix, as selected by
+ * input_axis, and writes the spectrum of vector \f$i\f$ to row or column
+ * \f$i\f$ of the output matrix, as selected by output_axis. The result is
+ * the same as calling \ref ifx_fft_run_rc for each vector after the optional
+ * pre-processing, but the arguments are checked only once and the
+ * pre-processing is done while the samples are copied to the aligned and
+ * zero padded FFT buffer, so no intermediate vectors are needed.
+ *
+ * At most \f$N\f$ samples of each input vector are used, and if a window is
+ * given at most as many samples as the window has. If mean_removal is true,
+ * the mean of these samples is subtracted before they are multiplied with
+ * the window.
+ *
+ * The output vectors must have at least \f$N/2\f$ elements, and as for
+ * \ref ifx_fft_run_rc their length determines how many frequency samples
+ * are written. The output matrix must provide at least as many vectors as
+ * the input matrix.
+ *
+ * @param [in]     handle        FFT object
+ * @param [in]     input         Real input matrix
+ * @param [in]     input_axis    Arrangement of the input vectors
+ * @param [in]     window        Window applied to the input vectors, or NULL for none
+ * @param [in]     mean_removal  If true, the mean is removed from the input vectors
+ * @param [out]    output        Complex output matrix
+ * @param [in]     output_axis   Arrangement of the output vectors
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_batch_rc(ifx_FFT_t* handle,
+                          const ifx_Matrix_R_t* input,
+                          ifx_FFT_Batch_Axis_t input_axis,
+                          const ifx_Vector_R_t* window,
+                          bool mean_removal,
+                          ifx_Matrix_C_t* output,
+                          ifx_FFT_Batch_Axis_t output_axis);
+
+/**
+ * @brief Performs FFT transforms on a batch of complex input vectors
+ *
+ * Complex counterpart of \ref ifx_fft_run_batch_rc, each vector is
+ * transformed like with \ref ifx_fft_run_c. The output vectors must have
+ * at least \f$N\f$ elements.
+ *
+ * @param [in]     handle        FFT object
+ * @param [in]     input         Complex input matrix
+ * @param [in]     input_axis    Arrangement of the input vectors
+ * @param [in]     window        Window applied to the input vectors, or NULL for none
+ * @param [in]     mean_removal  If true, the mean is removed from the input vectors
+ * @param [out]    output        Complex output matrix
+ * @param [in]     output_axis   Arrangement of the output vectors
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_run_batch_c(ifx_FFT_t* handle,
+                         const ifx_Matrix_C_t* input,
+                         ifx_FFT_Batch_Axis_t input_axis,
+                         const ifx_Vector_R_t* window,
+                         bool mean_removal,
+                         ifx_Matrix_C_t* output,
+                         ifx_FFT_Batch_Axis_t output_axis);
+
 /**
  * @brief Performs shift on a FFT amplitude spectrum (real values) to bring DC bin in
  *        the center of spectrum, positive bins on right side and negative bins on left side.
@@ -253,6 +339,24 @@ void ifx_fft_shift_c(const ifx_Vector_C_t* input,
 IFX_DLL_PUBLIC
 uint32_t ifx_fft_get_fft_size(const ifx_FFT_t* handle);
 
+/**
+ * @brief Sets the expected length of the input vectors.
+ *
+ * Input vectors shorter than the FFT size are zero padded. For complex FFTs
+ * with zero padding of at least a factor of 4, e.g. 64 chirps into a Doppler
+ * FFT of 256, the FFT is then pruned: the butterflies of the first stages
+ * that would only process zeros are skipped. This is selected per call, so
+ * longer input vectors are still transformed correctly, just without
+ * pruning. \ref ifx_ppfft_create sets the window size as input length.
+ *
+ * The results are the same as without pruning up to rounding.
+ *
+ * @param [in]     handle    A handle to the FFT object
+ * @param [in]     len       Expected number of input elements, 0 to disable pruning.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_set_input_length(ifx_FFT_t* handle, uint32_t len);
+
 /**
  * @brief Returns the FFT type within current FFT handle.
  *
@@ -282,6 +386,76 @@ void ifx_fft_raw_rc(ifx_FFT_t* handle, const ifx_Float_t* in, ifx_Complex_t* out
 IFX_DLL_PUBLIC
 void ifx_fft_raw_c(ifx_FFT_t* handle, const ifx_Complex_t* in, ifx_Complex_t* out);
 
+/**
+ * @brief Perform FFT on complex half precision input
+ *
+ * The input is converted to \ref ifx_Float_t while it is copied to the
+ * zero padded FFT buffer, so half precision buffers (e.g. a slow-time
+ * history stored as \ref ifx_Cube_HC_t) are transformed without a float
+ * copy of the whole buffer.
+ *
+ * @param [in]     handle    A handle to the FFT object
+ * @param [in]     in        Pointer to len complex half precision values.
+ * @param [in]     len       Number of input values; at most the FFT size are used, missing values are zero.
+ * @param [out]    out       Pointer to output array of complex floats, size must be the configured FFT size.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_raw_hc(ifx_FFT_t* handle, const ifx_Complex16_t* in, uint32_t len, ifx_Complex_t* out);
+
+/**
+ * @brief Checks if an FFT backend is available
+ *
+ * @param [in]     backend   FFT backend, see \ref ifx_FFT_Backend_t.
+ *
+ * @return true if the backend was compiled into the SDK, false otherwise.
+ */
+IFX_DLL_PUBLIC
+bool ifx_fft_backend_available(ifx_FFT_Backend_t backend);
+
+/**
+ * @brief Selects the FFT backend for FFT objects created afterwards
+ *
+ * FFT objects that already exist keep their backend. \ref IFX_FFT_BACKEND_DEFAULT
+ * selects FFTW if available and muFFT otherwise. If the environment variable
+ * IFX_FFT_BACKEND is set to "mufft" or "fftw" when the first FFT object is
+ * created, it overrides the default.
+ *
+ * If the backend is not available the error \ref IFX_ERROR_NOT_SUPPORTED is
+ * set and the selection is not changed.
+ *
+ * @param [in]     backend   FFT backend, see \ref ifx_FFT_Backend_t.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_set_backend(ifx_FFT_Backend_t backend);
+
+/**
+ * @brief Returns the FFT backend used for new FFT objects
+ *
+ * @return Selected FFT backend, never \ref IFX_FFT_BACKEND_DEFAULT.
+ */
+IFX_DLL_PUBLIC
+ifx_FFT_Backend_t ifx_fft_get_backend(void);
+
+/**
+ * @brief Returns the name of the FFT backend of an FFT object
+ *
+ * @param [in]     handle    A handle to the FFT object
+ *
+ * @return Name of the backend, e.g. "muFFT".
+ */
+IFX_DLL_PUBLIC
+const char* ifx_fft_get_backend_name(const ifx_FFT_t* handle);
+
+/**
+ * @brief Frees all cached FFT plans not used by an FFT object
+ *
+ * Destroying an FFT object keeps its plan in a cache so that creating an FFT
+ * object of the same type, size and backend again does not need to plan the
+ * FFT again. This function releases the memory of these plans.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_clear_plan_cache(void);
+
 /**
  * @}
  */
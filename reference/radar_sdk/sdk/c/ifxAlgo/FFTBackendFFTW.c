@@ -0,0 +1,106 @@
+/* ===========================================================================
+** Copyright (C) 2019-2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <fftw3.h>
+
+#include "ifxAlgo/internal/FFTBackend.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Arrays are allocated with the muFFT alignment, which also covers AVX in FFTW
+#define FFTW_REQUIRED_ALIGNMENT (32U)
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* Plans are created with FFTW_MEASURE on scratch arrays. This takes a few
+ * milliseconds per size, but the plan cache of the FFT module does it only
+ * once per type and size. The planner is not thread-safe; the FFT module
+ * calls create_plan and destroy_plan only with the cache lock held.
+ */
+static void* create_plan(ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    fftwf_complex* out = fftwf_alloc_complex(fft_size);
+    if (out == NULL)
+        return NULL;
+
+    fftwf_plan plan;
+    if (fft_type == IFX_FFT_TYPE_R2C)
+    {
+        float* in = fftwf_alloc_real(fft_size);
+        plan = in ? fftwf_plan_dft_r2c_1d((int)fft_size, in, out, FFTW_MEASURE) : NULL;
+        fftwf_free(in);
+    }
+    else
+    {
+        fftwf_complex* in = fftwf_alloc_complex(fft_size);
+        plan = in ? fftwf_plan_dft_1d((int)fft_size, in, out, FFTW_FORWARD, FFTW_MEASURE) : NULL;
+        fftwf_free(in);
+    }
+
+    fftwf_free(out);
+    return plan;
+}
+
+static void destroy_plan(void* plan)
+{
+    if (plan)
+        fftwf_destroy_plan(plan);
+}
+
+// ifx_Complex_t has the same layout as fftwf_complex (two floats)
+static void execute_rc(void* plan, const ifx_Float_t* in, ifx_Complex_t* out)
+{
+    fftwf_execute_dft_r2c(plan, (float*)in, (fftwf_complex*)out);
+}
+
+static void execute_c(void* plan, const ifx_Complex_t* in, ifx_Complex_t* out)
+{
+    fftwf_execute_dft(plan, (fftwf_complex*)in, (fftwf_complex*)out);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+// the new-array execute functions of FFTW are thread-safe
+const ifx_FFT_Backend_Ops_t ifx_fft_backend_fftw = {
+    "FFTW",
+    FFTW_REQUIRED_ALIGNMENT,
+    true,
+    create_plan,
+    destroy_plan,
+    execute_rc,
+    execute_c,
+};
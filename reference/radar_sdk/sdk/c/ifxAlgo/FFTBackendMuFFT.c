@@ -0,0 +1,86 @@
+/* ===========================================================================
+** Copyright (C) 2019-2021 Infineon Technologies AG. All rights reserved.
+** ===========================================================================
+**
+** ===========================================================================
+** Infineon Technologies AG (INFINEON) is supplying this file for use
+** exclusively with Infineon's sensor products. This file can be freely
+** distributed within development tools and software supporting such
+** products.
+**
+** THIS SOFTWARE IS PROVIDED "AS IS".  NO WARRANTIES, WHETHER EXPRESS, IMPLIED
+** OR STATUTORY, INCLUDING, BUT NOT LIMITED TO, IMPLIED WARRANTIES OF
+** MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE APPLY TO THIS SOFTWARE.
+** INFINEON SHALL NOT, IN ANY CIRCUMSTANCES, BE LIABLE FOR DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES, FOR ANY REASON
+** WHATSOEVER.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <mufft.h>
+
+#include "ifxAlgo/internal/FFTBackend.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// For muFFT the data must be aligned to 32bytes boundary
+#define MUFFT_REQUIRED_ALIGNMENT (32U)
+
+// TODO: Info: "NO_AVX seems to be faster for small transforms, maybe even NO_SSE3" - to be aligned with smart-tv
+#define MUFFT_FLAGS (MUFFT_FLAG_CPU_NO_AVX)
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void* create_plan(ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    if (fft_type == IFX_FFT_TYPE_R2C)
+        return mufft_create_plan_1d_r2c(fft_size, MUFFT_FLAGS);
+    else
+        return mufft_create_plan_1d_c2c(fft_size, MUFFT_FORWARD, MUFFT_FLAGS);
+}
+
+static void destroy_plan(void* plan)
+{
+    mufft_free_plan_1d(plan);
+}
+
+static void execute_rc(void* plan, const ifx_Float_t* in, ifx_Complex_t* out)
+{
+    mufft_execute_plan_1d(plan, out, in);
+}
+
+static void execute_c(void* plan, const ifx_Complex_t* in, ifx_Complex_t* out)
+{
+    mufft_execute_plan_1d(plan, out, in);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+// muFFT plans contain a scratch buffer, so they must not be shared
+const ifx_FFT_Backend_Ops_t ifx_fft_backend_mufft = {
+    "muFFT",
+    MUFFT_REQUIRED_ALIGNMENT,
+    false,
+    create_plan,
+    destroy_plan,
+    execute_rc,
+    execute_c,
+};
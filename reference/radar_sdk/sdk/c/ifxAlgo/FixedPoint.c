@@ -0,0 +1,509 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+
+#include "ifxAlgo/FixedPoint.h"
+
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/Vector.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Twiddle factors have 30 fractional bits
+#define TWIDDLE_FRAC_BITS (30)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines the structure for the fixed point FFT.
+ *        Use type ifx_FFT_Q15_t for this struct.
+ *
+ * The FFT is a radix-2 decimation in time FFT on 32 bit integers. The Q15
+ * input is shifted left by headroom bits, which leaves enough headroom that
+ * the values never overflow (each stage at most doubles the magnitude).
+ */
+struct ifx_FFT_Q15_s
+{
+    uint32_t fft_size;     /**< FFT size N, power of 2.*/
+    uint32_t headroom;     /**< Additional fractional bits of the work buffer, 15-log2(N).*/
+    int32_t* twiddle;      /**< W_N^k = cos(2 pi k/N) - j sin(2 pi k/N) for k < N/2 as re, im pairs.*/
+    uint16_t* bit_reverse; /**< Bit-reversal permutation of N points.*/
+    int32_t* work;         /**< N complex values as re, im pairs.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Saturates a value to the Q15 range.
+ *
+ * @param [in]     value     value
+ * @retval value clipped to [-2^15, 2^15-1]
+ */
+static inline ifx_Q15_t saturate(int64_t value);
+
+/**
+ * @brief Divides by 2^shift with rounding to the nearest integer.
+ *
+ * @param [in]     value     value
+ * @param [in]     shift     number of bits
+ * @retval round(value / 2^shift)
+ */
+static inline int64_t round_shift(int64_t value, uint32_t shift);
+
+/**
+ * @brief Computes an n-point FFT in place on the work buffer.
+ *
+ * The values must already be in bit-reversed order. n is the FFT size of
+ * the handle or half of it; the twiddle factors of the handle are used in
+ * both cases.
+ *
+ * @param [in,out] handle    fixed point FFT
+ * @param [in]     n         number of points
+ */
+static void fft_q15_core(ifx_FFT_Q15_t* handle, uint32_t n);
+
+/**
+ * @brief Computes floor(sqrt(x)).
+ *
+ * @param [in]     x         argument
+ * @retval integer square root
+ */
+static uint32_t isqrt(uint32_t x);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static inline ifx_Q15_t saturate(int64_t value)
+{
+    if (value > INT16_MAX)
+        return INT16_MAX;
+    if (value < INT16_MIN)
+        return INT16_MIN;
+    return (ifx_Q15_t)value;
+}
+
+//----------------------------------------------------------------------------
+
+static inline int64_t round_shift(int64_t value, uint32_t shift)
+{
+    if (shift == 0)
+        return value;
+
+    return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+//----------------------------------------------------------------------------
+
+static void fft_q15_core(ifx_FFT_Q15_t* handle, uint32_t n)
+{
+    int32_t* work = handle->work;
+    const int32_t* twiddle = handle->twiddle;
+
+    for (uint32_t len = 2; len <= n; len <<= 1)
+    {
+        // W_len^j = W_N^(j * N / len)
+        const uint32_t step = handle->fft_size / len;
+        const uint32_t half = len / 2;
+
+        for (uint32_t start = 0; start < n; start += len)
+        {
+            for (uint32_t j = 0; j < half; j++)
+            {
+                const int64_t wr = twiddle[2 * j * step];
+                const int64_t wi = twiddle[2 * j * step + 1];
+                int32_t* a = &work[2 * (start + j)];
+                int32_t* b = &work[2 * (start + j + half)];
+                const int32_t tr = (int32_t)round_shift(b[0] * wr - b[1] * wi, TWIDDLE_FRAC_BITS);
+                const int32_t ti = (int32_t)round_shift(b[0] * wi + b[1] * wr, TWIDDLE_FRAC_BITS);
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t isqrt(uint32_t x)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (x >= result + bit)
+        {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return result;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Q15_t ifx_q15_from_float(ifx_Float_t value)
+{
+    const ifx_Float_t scaled = value * 32768;
+
+    if (scaled >= INT16_MAX)
+        return INT16_MAX;
+    if (scaled <= INT16_MIN)
+        return INT16_MIN;
+
+    return (ifx_Q15_t)lrintf(scaled);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_q15_window_init(const ifx_Window_Config_t* config,
+                         ifx_Q15_t* window)
+{
+    IFX_ERR_BRK_NULL(config);
+    IFX_ERR_BRK_NULL(window);
+
+    ifx_Window_Config_t window_config = *config;
+    window_config.scale = 1;
+
+    const ifx_Vector_R_t* coefficients = ifx_window_acquire(&window_config, false);
+    if (coefficients == NULL)
+        return;
+
+    for (uint32_t i = 0; i < vLen(coefficients); i++)
+        window[i] = ifx_q15_from_float(vAt(coefficients, i));
+
+    ifx_window_release(coefficients);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_q15_from_raw(const uint16_t* samples,
+                      uint32_t stride,
+                      uint32_t len,
+                      uint32_t adc_bits,
+                      bool mean_removal,
+                      const ifx_Q15_t* window,
+                      ifx_Q15_t* output)
+{
+    IFX_ERR_BRK_NULL(samples);
+    IFX_ERR_BRK_NULL(output);
+    IFX_ERR_BRK_ARGUMENT(stride == 0 || adc_bits == 0 || adc_bits > 16);
+
+    const uint32_t up = 16 - adc_bits;
+
+    // s*2^up - offset with offset 2^15 (no mean removal) or the mean of s*2^up
+    int64_t offset = 32768;
+    if (mean_removal && len > 0)
+    {
+        int64_t sum = 0;
+        for (uint32_t i = 0; i < len; i++)
+            sum += samples[i * stride];
+
+        offset = ((sum << up) + len / 2) / len;
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        int64_t value = ((int64_t)samples[i * stride] << up) - offset;
+        if (window)
+            value = round_shift(value * window[i], 15);
+
+        output[i] = saturate(value);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+ifx_FFT_Q15_t* ifx_fft_q15_create(uint32_t fft_size)
+{
+    IFX_ERR_BRN_ARGUMENT(fft_size < 4 || fft_size > IFX_FFT_Q15_MAX_SIZE || (fft_size & (fft_size - 1)) != 0);
+
+    ifx_FFT_Q15_t* h = ifx_mem_calloc(1, sizeof(struct ifx_FFT_Q15_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->twiddle = ifx_mem_alloc(fft_size * sizeof(int32_t));
+    h->bit_reverse = ifx_mem_alloc(fft_size * sizeof(uint16_t));
+    h->work = ifx_mem_alloc(2 * fft_size * sizeof(int32_t));
+    if (h->twiddle == NULL || h->bit_reverse == NULL || h->work == NULL)
+    {
+        ifx_fft_q15_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    uint32_t bits = 0;
+    while ((1UL << bits) < fft_size)
+        bits++;
+
+    h->fft_size = fft_size;
+    h->headroom = 15 - bits;
+
+    for (uint32_t k = 0; k < fft_size / 2; k++)
+    {
+        const double phi = 2 * 3.14159265358979323846 * k / fft_size;
+        const double one = (double)(1L << TWIDDLE_FRAC_BITS);
+
+        h->twiddle[2 * k] = (int32_t)lrint(cos(phi) * one);
+        h->twiddle[2 * k + 1] = (int32_t)lrint(-sin(phi) * one);
+    }
+
+    for (uint32_t n = 0; n < fft_size; n++)
+    {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < bits; b++)
+            r |= ((n >> b) & 1U) << (bits - 1 - b);
+
+        h->bit_reverse[n] = (uint16_t)r;
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_q15_destroy(ifx_FFT_Q15_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    ifx_mem_free(handle->twiddle);
+    ifx_mem_free(handle->bit_reverse);
+    ifx_mem_free(handle->work);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fft_q15_get_fft_size(const ifx_FFT_Q15_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+
+    return handle->fft_size;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_q15_run_c(ifx_FFT_Q15_t* handle,
+                       const ifx_Complex_Q15_t* input,
+                       ifx_Complex_Q15_t* output,
+                       uint32_t shift)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+
+    const uint32_t n = handle->fft_size;
+    const int32_t scale = 1 << handle->headroom;
+    int32_t* work = handle->work;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        const uint32_t j = handle->bit_reverse[i];
+        work[2 * j] = input[i].re * scale;
+        work[2 * j + 1] = input[i].im * scale;
+    }
+
+    fft_q15_core(handle, n);
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        output[i].re = saturate(round_shift(work[2 * i], handle->headroom + shift));
+        output[i].im = saturate(round_shift(work[2 * i + 1], handle->headroom + shift));
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fft_q15_run_rc(ifx_FFT_Q15_t* handle,
+                        const ifx_Q15_t* input,
+                        ifx_Complex_Q15_t* output,
+                        uint32_t shift)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+
+    const uint32_t half = handle->fft_size / 2;
+    const int32_t scale = 1 << handle->headroom;
+    int32_t* work = handle->work;
+
+    // z[n] = x[2n] + j x[2n+1] in bit-reversed order of N/2 points
+    for (uint32_t i = 0; i < half; i++)
+    {
+        const uint32_t j = handle->bit_reverse[i] >> 1;
+        work[2 * j] = input[2 * i] * scale;
+        work[2 * j + 1] = input[2 * i + 1] * scale;
+    }
+
+    fft_q15_core(handle, half);
+
+    // X[k] = E[k] + W_N^k O[k] with E[k] = (Z[k] + conj(Z[M-k])) / 2 and
+    // O[k] = -j (Z[k] - conj(Z[M-k])) / 2; the factor 1/2 is part of the
+    // final shift.
+    for (uint32_t k = 0; k < half; k++)
+    {
+        const uint32_t m = (half - k) % half;
+        const int64_t zr = work[2 * k];
+        const int64_t zi = work[2 * k + 1];
+        const int64_t cr = work[2 * m];
+        const int64_t ci = -(int64_t)work[2 * m + 1];
+        const int64_t odd_r = zi - ci;
+        const int64_t odd_i = cr - zr;
+        const int64_t wr = handle->twiddle[2 * k];
+        const int64_t wi = handle->twiddle[2 * k + 1];
+
+        const int64_t xr = zr + cr + round_shift(wr * odd_r - wi * odd_i, TWIDDLE_FRAC_BITS);
+        const int64_t xi = zi + ci + round_shift(wr * odd_i + wi * odd_r, TWIDDLE_FRAC_BITS);
+
+        output[k].re = saturate(round_shift(xr, handle->headroom + shift + 1));
+        output[k].im = saturate(round_shift(xi, handle->headroom + shift + 1));
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_q15_abs_c(const ifx_Complex_Q15_t* input,
+                   uint16_t* output,
+                   uint32_t len)
+{
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(output);
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        const int32_t re = input[i].re;
+        const int32_t im = input[i].im;
+
+        output[i] = (uint16_t)isqrt((uint32_t)(re * re) + (uint32_t)(im * im));
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_q15_mti_c(const ifx_Complex_Q15_t* input,
+                   int32_t* history,
+                   ifx_Complex_Q15_t* output,
+                   ifx_Q15_t alpha,
+                   uint32_t len)
+{
+    IFX_ERR_BRK_NULL(input);
+    IFX_ERR_BRK_NULL(history);
+    IFX_ERR_BRK_NULL(output);
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        const int64_t x[2] = {input[i].re, input[i].im};
+        ifx_Q15_t y[2];
+
+        for (uint32_t c = 0; c < 2; c++)
+        {
+            // history has 30 fractional bits
+            const int64_t h = history[2 * i + c];
+
+            y[c] = saturate(x[c] - round_shift(h, 15));
+            history[2 * i + c] = (int32_t)(h + round_shift((x[c] * 32768 - h) * alpha, 15));
+        }
+
+        output[i].re = y[0];
+        output[i].im = y[1];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_q15_find_peaks(const uint16_t* input,
+                            uint32_t len,
+                            uint16_t threshold,
+                            uint32_t* indices,
+                            uint32_t max_peaks)
+{
+    IFX_ERR_BRV_NULL(input, 0);
+    IFX_ERR_BRV_NULL(indices, 0);
+
+    uint32_t num_peaks = 0;
+    for (uint32_t i = 0; i < len && num_peaks < max_peaks; i++)
+    {
+        const uint16_t value = input[i];
+        if (value < threshold)
+            continue;
+        if (i > 0 && value <= input[i - 1])
+            continue;
+        if (i + 1 < len && value < input[i + 1])
+            continue;
+
+        indices[num_peaks++] = i;
+    }
+
+    return num_peaks;
+}
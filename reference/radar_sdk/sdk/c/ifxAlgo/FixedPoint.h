@@ -0,0 +1,307 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file FixedPoint.h
+ *
+ * \brief \copybrief gr_fixedpoint
+ *
+ * For details refer to \ref gr_fixedpoint
+ */
+
+#ifndef IFX_ALGO_FIXED_POINT_H
+#define IFX_ALGO_FIXED_POINT_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/Window.h"
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/** Largest FFT size supported by \ref ifx_fft_q15_create */
+#define IFX_FFT_Q15_MAX_SIZE (16384U)
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Q15 fixed point number, the value is the integer divided by 2^15
+ */
+typedef int16_t ifx_Q15_t;
+
+/**
+ * @brief Complex Q15 fixed point number
+ */
+typedef struct
+{
+    ifx_Q15_t re; /**< Real part */
+    ifx_Q15_t im; /**< Imaginary part */
+} ifx_Complex_Q15_t;
+
+/**
+ * @brief A handle for a fixed point FFT, see FixedPoint.h
+ */
+typedef struct ifx_FFT_Q15_s ifx_FFT_Q15_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Algorithms
+ * @{
+ */
+
+/** @defgroup gr_fixedpoint Fixed Point
+ * @brief API for fixed point signal processing
+ *
+ * Fixed point versions of the core processing steps (window, FFT, magnitude,
+ * MTI and peak search) for targets without fast floating point or with
+ * little memory. Signals are stored as Q15 numbers, which takes half the
+ * memory of \ref ifx_Float_t. Intermediate results are computed with 32 bit
+ * (FFT, MTI history) or 64 bit (products) integers, so the results only lose
+ * precision when they are stored as Q15.
+ *
+ * The raw ADC samples of a frame (see \ref ifx_q15_from_raw) are converted
+ * with the same scaling as the floating point frames: a Q15 value of x/2^15
+ * corresponds to the floating point sample x/2^15.
+ *
+ * Results that do not fit into a Q15 number are saturated.
+ *
+ * @{
+ */
+
+/**
+ * @brief Converts a floating point number to Q15
+ *
+ * @param [in]     value     Value to convert.
+ *
+ * @return round(value * 2^15), saturated to the Q15 range.
+ */
+IFX_DLL_PUBLIC
+ifx_Q15_t ifx_q15_from_float(ifx_Float_t value);
+
+/**
+ * @brief Generates the coefficients of a window as Q15 numbers.
+ *
+ * Same coefficients as \ref ifx_window_init. The scale of the configuration
+ * is ignored, so the largest coefficient is close to 1.
+ *
+ * @param [in]     config    Window configuration.
+ * @param [out]    window    config->size coefficients.
+ */
+IFX_DLL_PUBLIC
+void ifx_q15_window_init(const ifx_Window_Config_t* config,
+                         ifx_Q15_t* window);
+
+/**
+ * @brief Converts raw ADC samples to Q15 with mean removal and window
+ *
+ * Sample i is samples[i*stride]; with stride set to the number of antennas,
+ * one chirp of one antenna of an interleaved raw frame (see
+ * ifx_Fmcw_Raw_Frame_t) is read directly. A sample s of an ADC with adc_bits
+ * bits is converted to the Q15 value s*2^(16-adc_bits) - 2^15, i.e. the range
+ * of the ADC is mapped to [-1,1). Optionally the mean is removed. Then each
+ * value is multiplied with the window coefficient.
+ *
+ * @param [in]     samples       Raw ADC samples.
+ * @param [in]     stride        Distance between consecutive samples.
+ * @param [in]     len           Number of samples.
+ * @param [in]     adc_bits      Resolution of the ADC in bits (1..16), e.g. 12.
+ * @param [in]     mean_removal  Remove the mean of the samples if true.
+ * @param [in]     window        len Q15 window coefficients or NULL for none.
+ * @param [out]    output        len Q15 values.
+ */
+IFX_DLL_PUBLIC
+void ifx_q15_from_raw(const uint16_t* samples,
+                      uint32_t stride,
+                      uint32_t len,
+                      uint32_t adc_bits,
+                      bool mean_removal,
+                      const ifx_Q15_t* window,
+                      ifx_Q15_t* output);
+
+/**
+ * @brief Creates a fixed point FFT of the given size.
+ *
+ * @param [in]     fft_size  FFT size, a power of 2 from 4 to \ref IFX_FFT_Q15_MAX_SIZE.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_FFT_Q15_t* ifx_fft_q15_create(uint32_t fft_size);
+
+/**
+ * @brief Destroys a fixed point FFT.
+ *
+ * @param [in]     handle    A handle to the fixed point FFT.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_q15_destroy(ifx_FFT_Q15_t* handle);
+
+/**
+ * @brief Returns the FFT size of a fixed point FFT.
+ *
+ * @param [in]     handle    A handle to the fixed point FFT.
+ *
+ * @return FFT size.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fft_q15_get_fft_size(const ifx_FFT_Q15_t* handle);
+
+/**
+ * @brief Computes the FFT of complex Q15 input.
+ *
+ * The FFT is computed with 32 bit integers and enough headroom to never
+ * overflow. The output is the DFT of the input divided by 2^shift: shift
+ * equal to log2(fft_size) gives the DFT divided by fft_size, which never
+ * saturates; smaller values keep weak signals above the quantization but
+ * saturate strong ones.
+ *
+ * @param [in]     handle    A handle to the fixed point FFT.
+ * @param [in]     input     fft_size complex Q15 values.
+ * @param [out]    output    fft_size complex Q15 values, may be identical to input.
+ * @param [in]     shift     Output scaling, see above.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_q15_run_c(ifx_FFT_Q15_t* handle,
+                       const ifx_Complex_Q15_t* input,
+                       ifx_Complex_Q15_t* output,
+                       uint32_t shift);
+
+/**
+ * @brief Computes the FFT of real Q15 input.
+ *
+ * Same as \ref ifx_fft_q15_run_c for real input, which is computed with a
+ * complex FFT of half the size. Only the fft_size/2 bins of positive
+ * frequencies starting with DC are written.
+ *
+ * @param [in]     handle    A handle to the fixed point FFT.
+ * @param [in]     input     fft_size real Q15 values.
+ * @param [out]    output    fft_size/2 complex Q15 values.
+ * @param [in]     shift     Output scaling, see \ref ifx_fft_q15_run_c.
+ */
+IFX_DLL_PUBLIC
+void ifx_fft_q15_run_rc(ifx_FFT_Q15_t* handle,
+                        const ifx_Q15_t* input,
+                        ifx_Complex_Q15_t* output,
+                        uint32_t shift);
+
+/**
+ * @brief Computes the magnitude of complex Q15 values.
+ *
+ * The magnitude is rounded down to an integer; it may exceed the Q15 range
+ * by up to a factor of sqrt(2), so it is returned as unsigned 16 bit number
+ * with the same scaling as Q15.
+ *
+ * @param [in]     input     len complex Q15 values.
+ * @param [out]    output    len magnitudes.
+ * @param [in]     len       Number of values.
+ */
+IFX_DLL_PUBLIC
+void ifx_q15_abs_c(const ifx_Complex_Q15_t* input,
+                   uint16_t* output,
+                   uint32_t len);
+
+/**
+ * @brief Runs a fixed point MTI filter on complex Q15 values.
+ *
+ * Same filter as the 2D MTI (see \ref ifx_2dmti_run_c): output = input -
+ * history, history = alpha*input + (1-alpha)*history. The history is
+ * kept with 15 additional fractional bits, so small values of alpha still
+ * update it.
+ *
+ * @param [in]     input     len complex Q15 values.
+ * @param [in,out] history   2*len values, all 0 before the first call.
+ * @param [out]    output    len complex Q15 values, may be identical to input.
+ * @param [in]     alpha     Filter coefficient in Q15, see \ref ifx_q15_from_float.
+ * @param [in]     len       Number of values.
+ */
+IFX_DLL_PUBLIC
+void ifx_q15_mti_c(const ifx_Complex_Q15_t* input,
+                   int32_t* history,
+                   ifx_Complex_Q15_t* output,
+                   ifx_Q15_t alpha,
+                   uint32_t len);
+
+/**
+ * @brief Finds local maxima above a threshold.
+ *
+ * An element is a peak if it is at least threshold, larger than its left
+ * neighbor and not smaller than its right neighbor (the first and last
+ * elements have only one neighbor). The peaks are returned in index order.
+ *
+ * @param [in]     input      len values, e.g. magnitudes from \ref ifx_q15_abs_c.
+ * @param [in]     len        Number of values.
+ * @param [in]     threshold  Smallest value of a peak.
+ * @param [out]    indices    Indices of the peaks.
+ * @param [in]     max_peaks  Maximum number of peaks, size of indices.
+ *
+ * @return Number of peaks written to indices.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_q15_find_peaks(const uint16_t* input,
+                            uint32_t len,
+                            uint16_t threshold,
+                            uint32_t* indices,
+                            uint32_t max_peaks);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_ALGO_FIXED_POINT_H */
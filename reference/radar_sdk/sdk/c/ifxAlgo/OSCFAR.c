@@ -41,6 +41,7 @@
 
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/HandleCache.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
@@ -66,11 +67,14 @@
 struct ifx_OSCFAR_s
 {
     uint8_t ref_win_len;         /**< Reference window length.*/
+    uint8_t guard_band;          /**< Guard band around the cell under test.*/
+    uint16_t num_ref_cells;      /**< Number of reference cells in the window.*/
     uint16_t os_index;           /**< Ordered statistic metric (index).*/
     ifx_Float_t coarse_scalar;   /**< Used for coarse thresholding 2D feature map.*/
     ifx_Float_t alpha;           /**< Threshold factor.*/
     ifx_Matrix_R_t* sliding_win; /**< Sliding Window. */
-    ifx_Vector_R_t* tmp_ref_vec; /**< ... */
+    ifx_Vector_R_t* tmp_ref_vec; /**< Values of the sliding window around the cell under test.*/
+    ifx_OSCFAR_Config_t config;  /**< Configuration the handle was created from, key in the handle cache.*/
 };
 
 /*
@@ -86,9 +90,13 @@ struct ifx_OSCFAR_s
 */
 
 /**
- * @brief Local compare function for qsort
+ * @brief Returns the value that would be at index k if the values were sorted,
+ *        reordering them.
  */
-static int cmpfunc(const void* a, const void* b);
+static ifx_Float_t select_value(ifx_Float_t* values, uint32_t count, uint32_t k);
+
+static bool config_equal(const void* lhs, const void* rhs);
+static void destroy_handle(void* handle);
 
 /*
 ==============================================================================
@@ -96,22 +104,78 @@ static int cmpfunc(const void* a, const void* b);
 ==============================================================================
 */
 
-static int cmpfunc(const void* a, const void* b)
+/* Only one ordered statistic is needed per cell, so instead of sorting the
+ * window a quickselect finds it in linear time.
+ */
+static ifx_Float_t select_value(ifx_Float_t* values, uint32_t count, uint32_t k)
 {
-    if (*(ifx_Float_t*)a > *(ifx_Float_t*)b)
-    {
-        return 1;
-    }
-    else if (*(ifx_Float_t*)a < *(ifx_Float_t*)b)
-    {
-        return -1;
-    }
-    else  // if( *(ifx_Float_t*)a == *(ifx_Float_t*)b )
+    int32_t first = 0;
+    int32_t last = (int32_t)count - 1;
+
+    while (first < last)
     {
-        return 0;
+        // Hoare partition around the middle value
+        const ifx_Float_t pivot = values[first + (last - first) / 2];
+        int32_t i = first;
+        int32_t j = last;
+        while (i <= j)
+        {
+            while (values[i] < pivot)
+            {
+                i++;
+            }
+            while (values[j] > pivot)
+            {
+                j--;
+            }
+            if (i <= j)
+            {
+                const ifx_Float_t tmp = values[i];
+                values[i++] = values[j];
+                values[j--] = tmp;
+            }
+        }
+
+        if ((int32_t)k <= j)
+        {
+            last = j;
+        }
+        else if ((int32_t)k >= i)
+        {
+            first = i;
+        }
+        else
+        {
+            break;
+        }
     }
+
+    return values[k];
 }
 
+//----------------------------------------------------------------------------
+
+static bool config_equal(const void* lhs, const void* rhs)
+{
+    const ifx_OSCFAR_Config_t* a = lhs;
+    const ifx_OSCFAR_Config_t* b = rhs;
+
+    return a->win_rank == b->win_rank && a->guard_band == b->guard_band && a->sample == b->sample
+           && a->pfa == b->pfa && a->coarse_scalar == b->coarse_scalar;
+}
+
+//----------------------------------------------------------------------------
+
+static void destroy_handle(void* handle)
+{
+    ifx_oscfar_destroy(handle);
+}
+
+//----------------------------------------------------------------------------
+
+// released handles for ifx_oscfar_acquire, defined after the callbacks it uses
+static ifx_Handle_Cache_t handle_cache = IFX_HANDLE_CACHE_INIT(ifx_OSCFAR_Config_t, config_equal, destroy_handle);
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -122,7 +186,7 @@ ifx_OSCFAR_t* ifx_oscfar_create(const ifx_OSCFAR_Config_t* config)
 {
     IFX_ERR_BRN_NULL(config);
 
-    ifx_OSCFAR_t* h = ifx_mem_alloc(sizeof(struct ifx_OSCFAR_s));
+    ifx_OSCFAR_t* h = ifx_mem_calloc(1, sizeof(struct ifx_OSCFAR_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
     uint16_t ref_mat_size = 2 * config->win_rank - 1;
@@ -130,6 +194,8 @@ ifx_OSCFAR_t* ifx_oscfar_create(const ifx_OSCFAR_Config_t* config)
                             - (config->guard_band * 2 + 1) * (config->guard_band * 2 + 1);
 
     h->ref_win_len = config->win_rank - 1;
+    h->guard_band = config->guard_band;
+    h->num_ref_cells = osarray_size;
     h->os_index = (uint16_t)FLOOR(osarray_size * config->sample + (ifx_Float_t)0.5) - 1;
     h->coarse_scalar = config->coarse_scalar;
     h->alpha = osarray_size * (POW(config->pfa, -(ifx_Float_t)1 / osarray_size) - 1);
@@ -156,11 +222,58 @@ ifx_OSCFAR_t* ifx_oscfar_create(const ifx_OSCFAR_Config_t* config)
     IFX_ERR_HANDLE_N(h->tmp_ref_vec = ifx_vec_create_r(ref_mat_size * ref_mat_size),
                      ifx_oscfar_destroy(h));
 
+    h->config = *config;
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_OSCFAR_t* ifx_oscfar_acquire(const ifx_OSCFAR_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+
+    const uint64_t start = ifx_handle_cache_now_ns();
+
+    ifx_OSCFAR_t* h = ifx_handle_cache_take(&handle_cache, config);
+    if (h == NULL)
+        h = ifx_oscfar_create(config);
+
+    if (h != NULL)
+        ifx_handle_cache_record(&handle_cache, start);
+
     return h;
 }
 
 //----------------------------------------------------------------------------
 
+void ifx_oscfar_release(ifx_OSCFAR_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    // the handle has no state besides its configuration
+    ifx_handle_cache_put(&handle_cache, &handle->config, handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_oscfar_clear_cache(void)
+{
+    ifx_handle_cache_clear(&handle_cache);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_oscfar_get_cache_stats(ifx_Handle_Cache_Stats_t* stats)
+{
+    IFX_ERR_BRK_NULL(stats);
+
+    ifx_handle_cache_get_stats(&handle_cache, stats);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
                     ifx_Matrix_R_t* feature2D,
                     ifx_Matrix_R_t* detector_output)
@@ -174,6 +287,11 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
     ifx_Float_t input_mean = ifx_mat_mean_r(feature2D);
     ifx_Float_t coarse_threshold = handle->coarse_scalar * input_mean;
 
+    const ifx_Matrix_R_t* win = handle->sliding_win;
+    const size_t row_stride = mStride(feature2D, 0);
+    const size_t col_stride = mStride(feature2D, 1);
+    ifx_Float_t* ref_values = vDat(handle->tmp_ref_vec);
+
     for (uint32_t col = handle->ref_win_len + 1; col < mCols(feature2D) - handle->ref_win_len - 1; ++col)
     {
         for (uint32_t row = handle->ref_win_len + 1; row < mRows(feature2D) - handle->ref_win_len - 1; ++row)
@@ -181,21 +299,20 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
             if (IFX_MAT_AT(feature2D, row, col) > coarse_threshold)
             {
                 // calculate handle->tmp_ref_vec
-                uint32_t ref_row_idx = row - handle->ref_win_len;
-                uint32_t ref_col_idx = col - handle->ref_win_len;
+                const ifx_Float_t* ref = &IFX_MAT_AT(feature2D, row - handle->ref_win_len, col - handle->ref_win_len);
+                const ifx_Float_t* mask = mDat(win);
 
-                for (uint32_t sliding_row = 0; sliding_row < mRows(handle->sliding_win); ++sliding_row)
+                for (uint32_t sliding_row = 0; sliding_row < mRows(win); ++sliding_row)
                 {
-                    for (uint32_t sliding_col = 0; sliding_col < mCols(handle->sliding_win); ++sliding_col)
+                    for (uint32_t sliding_col = 0; sliding_col < mCols(win); ++sliding_col)
                     {
-                        ifx_Float_t tmp_value = IFX_MAT_AT(handle->sliding_win, sliding_row, sliding_col)
-                                                * IFX_MAT_AT(feature2D, (size_t)ref_row_idx + sliding_row, (size_t)ref_col_idx + sliding_col);
-                        ifx_vec_setat_r(handle->tmp_ref_vec, sliding_row * mCols(handle->sliding_win) + sliding_col, tmp_value);
+                        ref_values[sliding_row * mCols(win) + sliding_col] = mask[sliding_row * mCols(win) + sliding_col]
+                                                                             * ref[sliding_row * row_stride + sliding_col * col_stride];
                     }
                 }
 
-                qsort(vDat(handle->tmp_ref_vec), vLen(handle->tmp_ref_vec), sizeof(ifx_Float_t), cmpfunc);
-                ifx_Float_t os_threshold = handle->alpha * IFX_VEC_AT(handle->tmp_ref_vec, handle->os_index);
+                ifx_Float_t os_value = select_value(ref_values, vLen(handle->tmp_ref_vec), handle->os_index);
+                ifx_Float_t os_threshold = handle->alpha * os_value;
 
                 if (IFX_MAT_AT(feature2D, row, col) < os_threshold)
                 {
@@ -212,6 +329,128 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
 
 //----------------------------------------------------------------------------
 
+void ifx_oscfar_run_ca(const ifx_OSCFAR_t* handle,
+                       const ifx_Matrix_R_t* feature2D,
+                       ifx_Matrix_R_t* detector_output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(feature2D);
+    IFX_MAT_BRK_VALID(detector_output);
+    IFX_MAT_BRK_DIM(feature2D, detector_output);
+
+    ifx_mat_clear_r(detector_output);
+
+    const uint32_t rows = mRows(feature2D);
+    const uint32_t cols = mCols(feature2D);
+
+    /* Summed area table: sat[r][c] is the sum of all cells above and left
+     * of (r, c), so the sum of any rectangle takes four lookups. double
+     * avoids losing the small values next to large ones.
+     */
+    const size_t sat_cols = (size_t)cols + 1;
+    double* sat = ifx_mem_calloc(((size_t)rows + 1) * sat_cols, sizeof(double));
+    IFX_ERR_BRK_MEMALLOC(sat);
+
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        double row_sum = 0;
+        for (uint32_t c = 0; c < cols; c++)
+        {
+            row_sum += IFX_MAT_AT(feature2D, r, c);
+            sat[(r + 1) * sat_cols + c + 1] = sat[r * sat_cols + c + 1] + row_sum;
+        }
+    }
+
+#define RECT_SUM(r0, c0, r1, c1) \
+    (sat[(size_t)(r1) * sat_cols + (c1)] - sat[(size_t)(r0) * sat_cols + (c1)] - sat[(size_t)(r1) * sat_cols + (c0)] + sat[(size_t)(r0) * sat_cols + (c0)])
+
+    const ifx_Float_t coarse_threshold = handle->coarse_scalar * ifx_mat_mean_r(feature2D);
+    const uint32_t len = handle->ref_win_len;
+    const uint32_t guard = handle->guard_band;
+    const double scale = handle->alpha / handle->num_ref_cells;
+
+    for (uint32_t col = len + 1; col < cols - len - 1; ++col)
+    {
+        for (uint32_t row = len + 1; row < rows - len - 1; ++row)
+        {
+            const ifx_Float_t value = IFX_MAT_AT(feature2D, row, col);
+            if (value > coarse_threshold)
+            {
+                const double window = RECT_SUM(row - len, col - len, row + len + 1, col + len + 1);
+                const double guard_cells = RECT_SUM(row - guard, col - guard, row + guard + 1, col + guard + 1);
+                const ifx_Float_t ca_threshold = (ifx_Float_t)(scale * (window - guard_cells));
+
+                if (value >= ca_threshold)
+                {
+                    IFX_MAT_AT(detector_output, row, col) = value;
+                }
+            }
+        }
+    }
+
+#undef RECT_SUM
+
+    ifx_mem_free(sat);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_oscfar_run_hits(const ifx_OSCFAR_t* handle,
+                             const ifx_Matrix_R_t* feature2D,
+                             ifx_OSCFAR_Hit_t* hits,
+                             uint32_t max_hits)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_ERR_BRV_NULL(hits, 0);
+    IFX_MAT_BRV_VALID(feature2D, 0);
+
+    const ifx_Float_t coarse_threshold = handle->coarse_scalar * ifx_mat_mean_r(feature2D);
+
+    const ifx_Matrix_R_t* win = handle->sliding_win;
+    const size_t row_stride = mStride(feature2D, 0);
+    const size_t col_stride = mStride(feature2D, 1);
+    const uint32_t len = handle->ref_win_len;
+    ifx_Float_t* ref_values = vDat(handle->tmp_ref_vec);
+    uint32_t num_hits = 0;
+
+    for (uint32_t row = len + 1; row < mRows(feature2D) - len - 1; ++row)
+    {
+        for (uint32_t col = len + 1; col < mCols(feature2D) - len - 1; ++col)
+        {
+            const ifx_Float_t value = IFX_MAT_AT(feature2D, row, col);
+            if (value <= coarse_threshold)
+                continue;
+
+            const ifx_Float_t* ref = &IFX_MAT_AT(feature2D, row - len, col - len);
+            const ifx_Float_t* mask = mDat(win);
+
+            for (uint32_t sliding_row = 0; sliding_row < mRows(win); ++sliding_row)
+            {
+                for (uint32_t sliding_col = 0; sliding_col < mCols(win); ++sliding_col)
+                {
+                    ref_values[sliding_row * mCols(win) + sliding_col] = mask[sliding_row * mCols(win) + sliding_col]
+                                                                         * ref[sliding_row * row_stride + sliding_col * col_stride];
+                }
+            }
+
+            const ifx_Float_t os_value = select_value(ref_values, vLen(handle->tmp_ref_vec), handle->os_index);
+            if (value < handle->alpha * os_value)
+                continue;
+
+            hits[num_hits].row = row;
+            hits[num_hits].col = col;
+            hits[num_hits].value = value;
+            hits[num_hits].noise = os_value;
+            if (++num_hits == max_hits)
+                return num_hits;
+        }
+    }
+
+    return num_hits;
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_oscfar_destroy(ifx_OSCFAR_t* handle)
 {
     if (handle == NULL)
@@ -83,6 +83,18 @@ typedef struct
     ifx_Float_t coarse_scalar; /**< Used for coarse thresholding 2D feature map.*/
 } ifx_OSCFAR_Config_t;
 
+/**
+ * @brief A cell detected by \ref ifx_oscfar_run_hits.
+ */
+typedef struct
+{
+    uint32_t row;      /**< Row of the cell.*/
+    uint32_t col;      /**< Column of the cell.*/
+    ifx_Float_t value; /**< Value of the cell.*/
+    ifx_Float_t noise; /**< Ordered statistic of the reference cells, i.e. the threshold divided by the
+                            threshold factor. value / noise is an estimate of the SNR.*/
+} ifx_OSCFAR_Hit_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -132,6 +144,50 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
                     ifx_Matrix_R_t* feature2D,
                     ifx_Matrix_R_t* detector_output);
 
+/**
+ * @brief Runs a 2D cell averaging CFAR (CA-CFAR) with the window of the handle.
+ *
+ * Same as \ref ifx_oscfar_run, but the threshold of a cell is derived from
+ * the mean of its reference cells instead of an ordered statistic. The mean
+ * is computed from a summed area table, so the cost per cell is constant.
+ * CA-CFAR is cheaper, but masks weak targets next to strong ones. Unlike
+ * \ref ifx_oscfar_run feature2D is not modified.
+ *
+ * @param [in]     handle              A handle to the OSCFAR object
+ * @param [in]     feature2D           rangeAngle/rangeDoppler 2D feature map, see \ref ifx_oscfar_run.
+ * @param [out] detector_output        Appropriate 2D feature map with updated target indices.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_oscfar_run_ca(const ifx_OSCFAR_t* handle,
+                       const ifx_Matrix_R_t* feature2D,
+                       ifx_Matrix_R_t* detector_output);
+
+/**
+ * @brief Runs OS-CFAR and returns the detected cells as a list.
+ *
+ * Same detector as \ref ifx_oscfar_run, but instead of a matrix of the
+ * size of feature2D, which has to be cleared and scanned again by the
+ * consumer, only the detected cells are written. Like
+ * \ref ifx_oscfar_run_ca feature2D is not modified, so cells below the
+ * threshold stay in the reference windows of their neighbors.
+ *
+ * The cells are visited row by row. If more than max_hits cells are
+ * detected, the first max_hits are returned.
+ *
+ * @param [in]     handle              A handle to the OSCFAR object
+ * @param [in]     feature2D           rangeAngle/rangeDoppler 2D feature map, see \ref ifx_oscfar_run.
+ * @param [out]    hits                Array of max_hits elements receiving the detected cells.
+ * @param [in]     max_hits            Capacity of hits.
+ *
+ * @return Number of detected cells written to hits.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_oscfar_run_hits(const ifx_OSCFAR_t* handle,
+                             const ifx_Matrix_R_t* feature2D,
+                             ifx_OSCFAR_Hit_t* hits,
+                             uint32_t max_hits);
+
 /**
  * @brief Destroys OSCFAR handle (object) to clear internal states and memories.
  *
@@ -141,6 +197,43 @@ void ifx_oscfar_run(const ifx_OSCFAR_t* handle,
 IFX_DLL_PUBLIC
 void ifx_oscfar_destroy(ifx_OSCFAR_t* handle);
 
+/**
+ * @brief Returns an OSCFAR object from the handle cache or creates one.
+ *
+ * Objects released with \ref ifx_oscfar_release are kept in a cache and
+ * handed out again for an equal configuration.
+ *
+ * @param [in]     config    OSCFAR configurations defined by \ref ifx_OSCFAR_Config_t.
+ *
+ * @return Handle or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_OSCFAR_t* ifx_oscfar_acquire(const ifx_OSCFAR_Config_t* config);
+
+/**
+ * @brief Returns an OSCFAR object to the handle cache.
+ *
+ * The object may come from \ref ifx_oscfar_create or \ref ifx_oscfar_acquire.
+ *
+ * @param [in]     handle    A handle to the OSCFAR object
+ */
+IFX_DLL_PUBLIC
+void ifx_oscfar_release(ifx_OSCFAR_t* handle);
+
+/**
+ * @brief Destroys all OSCFAR objects in the handle cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_oscfar_clear_cache(void);
+
+/**
+ * @brief Returns hits, misses and acquire latency of the handle cache.
+ *
+ * @param [out]    stats     Statistics of the cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_oscfar_get_cache_stats(ifx_Handle_Cache_Stats_t* stats);
+
 /**
  * @}
  */
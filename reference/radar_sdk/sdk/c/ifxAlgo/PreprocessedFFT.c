@@ -38,9 +38,13 @@
 #include <string.h>
 
 #include "ifxAlgo/FFT.h"
+#include "ifxAlgo/internal/Config.h"
+#include "ifxAlgo/internal/Unchecked.h"
 #include "ifxAlgo/PreprocessedFFT.h"
 
+#include "ifxBase/Complex.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/HandleCache.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -64,11 +68,13 @@
 struct ifx_PPFFT_s
 {
     bool mean_removal_enabled;         /**< If false, mean removal step is ignored during range spectrum calculation.*/
-    ifx_Vector_R_t* fft_window;        /**< Vector specifying the window function to be used before FFT in range spectrum calculation.*/
+    const ifx_Vector_R_t* fft_window;  /**< Shared window from the window cache specifying the window function to be used before FFT in range spectrum calculation.*/
     ifx_Window_Config_t window_config; /**< Window type, length and attenuation used for range FFT.*/
     ifx_FFT_t* fft_handle;             /**< Handle to an ifx_FFT_t object.*/
     ifx_Vector_R_t* pp_result_r;       /**< Container to store real pre-processing result in case fft_type is \ref IFX_FFT_TYPE_R2C. Otherwise ignored.*/
     ifx_Vector_C_t* pp_result_c;       /**< Container to store complex pre-processing result in case fft_type is \ref IFX_FFT_TYPE_C2C. Otherwise ignored.*/
+    ifx_PPFFT_Config_t config;         /**< Configuration the handle was created from, key in the handle cache.*/
+    bool window_changed;               /**< True after ifx_ppfft_set_window, such handles are not cached.*/
 };
 
 /*
@@ -83,12 +89,65 @@ struct ifx_PPFFT_s
 ==============================================================================
 */
 
+static bool config_equal(const void* lhs, const void* rhs);
+static void destroy_handle(void* handle);
+
+/* output = (input - mean) * window in one pass; output and window are
+ * contiguous, output may be the same as input
+ */
+static void remove_mean_window_r(const ifx_Vector_R_t* input, ifx_Float_t mean, const ifx_Vector_R_t* window, ifx_Vector_R_t* output);
+static void remove_mean_window_c(const ifx_Vector_C_t* input, ifx_Complex_t mean, const ifx_Vector_R_t* window, ifx_Vector_C_t* output);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static bool config_equal(const void* lhs, const void* rhs)
+{
+    return ifx_ppfft_config_equal(lhs, rhs);
+}
+
+//----------------------------------------------------------------------------
+
+static void destroy_handle(void* handle)
+{
+    ifx_ppfft_destroy(handle);
+}
+
+//----------------------------------------------------------------------------
+
+static void remove_mean_window_r(const ifx_Vector_R_t* input, ifx_Float_t mean, const ifx_Vector_R_t* window, ifx_Vector_R_t* output)
+{
+    const ifx_Float_t* w = vDat(window);
+    ifx_Float_t* out = vDat(output);
+
+    for (uint32_t i = 0; i < vLen(output); i++)
+        out[i] = (vAt(input, i) - mean) * w[i];
+}
+
+//----------------------------------------------------------------------------
+
+static void remove_mean_window_c(const ifx_Vector_C_t* input, ifx_Complex_t mean, const ifx_Vector_R_t* window, ifx_Vector_C_t* output)
+{
+    const ifx_Float_t mean_re = IFX_COMPLEX_REAL(mean);
+    const ifx_Float_t mean_im = IFX_COMPLEX_IMAG(mean);
+    const ifx_Float_t* w = vDat(window);
+    ifx_Complex_t* out = vDat(output);
+
+    for (uint32_t i = 0; i < vLen(output); i++)
+    {
+        const ifx_Complex_t x = vAt(input, i);
+        IFX_COMPLEX_SET(out[i], (IFX_COMPLEX_REAL(x) - mean_re) * w[i], (IFX_COMPLEX_IMAG(x) - mean_im) * w[i]);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+// released handles for ifx_ppfft_acquire, defined after the callbacks it uses
+static ifx_Handle_Cache_t handle_cache = IFX_HANDLE_CACHE_INIT(ifx_PPFFT_Config_t, config_equal, destroy_handle);
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -116,29 +175,73 @@ ifx_PPFFT_t* ifx_ppfft_create(const ifx_PPFFT_Config_t* config)
     IFX_ERR_HANDLE_N(h->fft_handle = ifx_fft_create(config->fft_type, config->fft_size),
                      ifx_ppfft_destroy(h));
 
-    IFX_ERR_HANDLE_N(h->fft_window = ifx_vec_create_r(config->window_config.size),
+    // zero padded complex FFTs are pruned to the window size
+    IFX_ERR_HANDLE_N(ifx_fft_set_input_length(h->fft_handle, config->window_config.size),
                      ifx_ppfft_destroy(h));
 
-    ifx_window_init(&config->window_config, h->fft_window);
+    // The window is normalized before scaling, as scaling would get cancelled otherwise.
+    IFX_ERR_HANDLE_N(h->fft_window = ifx_window_acquire(&config->window_config, config->is_normalized_window),
+                     ifx_ppfft_destroy(h));
 
     h->window_config = config->window_config;
     h->mean_removal_enabled = config->mean_removal_enabled;
+    h->config = *config;
 
-    if (config->is_normalized_window)
-    {
-        const ifx_Float_t sum = ifx_vec_sum_r(h->fft_window);
+    return h;
+}
 
-        ifx_vec_scale_r(h->fft_window, 1.0f / sum, h->fft_window);
-    }
+//----------------------------------------------------------------------------
 
-    // Moved out of window_init() as scaling got cancelled if window normalization is performed afterwards.
+ifx_PPFFT_t* ifx_ppfft_acquire(const ifx_PPFFT_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+
+    const uint64_t start = ifx_handle_cache_now_ns();
+
+    ifx_PPFFT_t* h = ifx_handle_cache_take(&handle_cache, config);
+    if (h == NULL)
+        h = ifx_ppfft_create(config);
 
-    if (config->window_config.scale != 0 && config->window_config.scale != 1)
+    if (h != NULL)
+        ifx_handle_cache_record(&handle_cache, start);
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_release(ifx_PPFFT_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    // a changed window cannot be restored to the state after creation
+    if (handle->window_changed)
     {
-        ifx_vec_scale_r(h->fft_window, config->window_config.scale, h->fft_window);
+        ifx_ppfft_destroy(handle);
+        return;
     }
 
-    return h;
+    handle->window_config = handle->config.window_config;
+    handle->mean_removal_enabled = handle->config.mean_removal_enabled;
+
+    ifx_handle_cache_put(&handle_cache, &handle->config, handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_clear_cache(void)
+{
+    ifx_handle_cache_clear(&handle_cache);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_get_cache_stats(ifx_Handle_Cache_Stats_t* stats)
+{
+    IFX_ERR_BRK_NULL(stats);
+
+    ifx_handle_cache_get_stats(&handle_cache, stats);
 }
 
 //----------------------------------------------------------------------------
@@ -152,7 +255,7 @@ void ifx_ppfft_destroy(ifx_PPFFT_t* handle)
 
     ifx_fft_destroy(handle->fft_handle);
 
-    ifx_vec_destroy_r(handle->fft_window);
+    ifx_window_release(handle->fft_window);
     ifx_vec_destroy_r(handle->pp_result_r);
     ifx_vec_destroy_c(handle->pp_result_c);
 
@@ -168,30 +271,40 @@ void ifx_ppfft_run_rc(ifx_PPFFT_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_VEC_BRK_VALID(input);
     IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM_GT(handle->pp_result_r, input);
+    IFX_VEC_BRK_MINSIZE(output, ifx_fft_get_fft_size(handle->fft_handle) / 2);
+    IFX_ERR_BRK_COND(ifx_fft_get_fft_type(handle->fft_handle) != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
 
-    ifx_Vector_R_t* fft_in = (ifx_Vector_R_t*)input;
+    ifx_ppfft_run_rc_unchecked(handle, input, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_run_rc_unchecked(ifx_PPFFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C_t* output)
+{
+    const ifx_Vector_R_t* fft_in = input;
+    ifx_Vector_R_t input_view;
 
     if (vLen(input) > vLen(handle->pp_result_r))  //  case: Input data is larger than FFT size
     {
-        ifx_vec_blit_r(input, 0, vLen(handle->pp_result_r), 0, handle->pp_result_r);
+        IFX_MDA_VIEW_R(&input_view, input, IFX_MDA_SLICE(0, vLen(handle->pp_result_r), 1));
 
-        fft_in = handle->pp_result_r;
+        fft_in = &input_view;
     }
 
     if (handle->mean_removal_enabled != 0)
     {
-        ifx_Float_t mean = ifx_vec_mean_r(fft_in);
+        ifx_Stats_R_t stats;
+        ifx_vec_stats_r(fft_in, &stats);
 
-        ifx_vec_sub_rs(fft_in, mean, handle->pp_result_r);
-
-        ifx_vec_mul_r(handle->pp_result_r, handle->fft_window, handle->pp_result_r);
+        remove_mean_window_r(fft_in, stats.mean, handle->fft_window, handle->pp_result_r);
     }
     else
     {
         ifx_vec_mul_r(fft_in, handle->fft_window, handle->pp_result_r);
     }
 
-    ifx_fft_run_rc(handle->fft_handle, handle->pp_result_r, output);
+    ifx_fft_run_rc_unchecked(handle->fft_handle, handle->pp_result_r, output);
 }
 
 //----------------------------------------------------------------------------
@@ -203,30 +316,65 @@ void ifx_ppfft_run_c(ifx_PPFFT_t* handle,
     IFX_ERR_BRK_NULL(handle);
     IFX_VEC_BRK_VALID(input);
     IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM_GT(handle->pp_result_c, input);
+    IFX_VEC_BRK_MINSIZE(output, ifx_fft_get_fft_size(handle->fft_handle));
+    IFX_ERR_BRK_COND(ifx_fft_get_fft_type(handle->fft_handle) != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_COMPLEX);
 
-    ifx_Vector_C_t* fft_in = (ifx_Vector_C_t*)input;
+    ifx_ppfft_run_c_unchecked(handle, input, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_run_c_unchecked(ifx_PPFFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_t* output)
+{
+    const ifx_Vector_C_t* fft_in = input;
+    ifx_Vector_C_t input_view;
 
     if (vLen(input) > vLen(handle->pp_result_c))  //  case: Input data is larger than FFT size
     {
-        ifx_vec_blit_c(input, 0, vLen(handle->pp_result_c), 0, handle->pp_result_c);
+        IFX_MDA_VIEW_C(&input_view, input, IFX_MDA_SLICE(0, vLen(handle->pp_result_c), 1));
 
-        fft_in = handle->pp_result_c;
+        fft_in = &input_view;
     }
 
     if (handle->mean_removal_enabled != 0)
     {
         ifx_Complex_t mean = ifx_vec_mean_c(fft_in);
 
-        ifx_vec_sub_cs(fft_in, mean, handle->pp_result_c);
-
-        ifx_vec_mul_cr(handle->pp_result_c, handle->fft_window, handle->pp_result_c);
+        remove_mean_window_c(fft_in, mean, handle->fft_window, handle->pp_result_c);
     }
     else
     {
         ifx_vec_mul_cr(fft_in, handle->fft_window, handle->pp_result_c);
     }
 
-    ifx_fft_run_c(handle->fft_handle, handle->pp_result_c, output);
+    ifx_fft_run_c_unchecked(handle->fft_handle, handle->pp_result_c, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_run_batch_rc(ifx_PPFFT_t* handle,
+                            const ifx_Matrix_R_t* input,
+                            ifx_FFT_Batch_Axis_t input_axis,
+                            ifx_Matrix_C_t* output,
+                            ifx_FFT_Batch_Axis_t output_axis)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    ifx_fft_run_batch_rc(handle->fft_handle, input, input_axis, handle->fft_window, handle->mean_removal_enabled, output, output_axis);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_ppfft_run_batch_c(ifx_PPFFT_t* handle,
+                           const ifx_Matrix_C_t* input,
+                           ifx_FFT_Batch_Axis_t input_axis,
+                           ifx_Matrix_C_t* output,
+                           ifx_FFT_Batch_Axis_t output_axis)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    ifx_fft_run_batch_c(handle->fft_handle, input, input_axis, handle->fft_window, handle->mean_removal_enabled, output, output_axis);
 }
 
 //----------------------------------------------------------------------------
@@ -272,20 +420,23 @@ void ifx_ppfft_set_window(ifx_PPFFT_t* handle, const ifx_Window_Config_t* config
     IFX_ERR_BRK_NULL(handle);
     IFX_ERR_BRK_NULL(config);
 
-    if (config->size != handle->window_config.size)
-    {
-        ifx_vec_destroy_r(handle->fft_window);
-        handle->fft_window = ifx_vec_create_r(config->size);
-    }
+    // the window is neither normalized nor scaled here
+    ifx_Window_Config_t window_config = *config;
+    window_config.scale = 1;
 
-    ifx_window_init(config, handle->fft_window);
+    const ifx_Vector_R_t* window = ifx_window_acquire(&window_config, false);
+    if (window == NULL)
+        return;
 
+    ifx_window_release(handle->fft_window);
+    handle->fft_window = window;
     handle->window_config = *config;
+    handle->window_changed = true;
 }
 
 //----------------------------------------------------------------------------
 
-ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle)
+const ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle)
 {
     IFX_ERR_BRV_NULL(handle, NULL);
 
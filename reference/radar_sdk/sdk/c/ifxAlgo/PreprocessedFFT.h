@@ -153,6 +153,46 @@ void ifx_ppfft_run_c(ifx_PPFFT_t* handle,
                      const ifx_Vector_C_t* input,
                      ifx_Vector_C_t* output);
 
+/**
+ * @brief Calculates 1D FFTs with pre-processing for a batch of real input vectors.
+ *
+ * Each row or column of the input matrix is processed like with \ref ifx_ppfft_run_rc,
+ * see \ref ifx_fft_run_batch_rc for the arrangement of the vectors.
+ *
+ * @param [in]     handle        A handle to the 1D pre-processed FFT object
+ * @param [in]     input         Real input matrix (e.g. one chirp per row)
+ * @param [in]     input_axis    Arrangement of the input vectors
+ * @param [out]    output        Complex output matrix
+ * @param [in]     output_axis   Arrangement of the output vectors
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_ppfft_run_batch_rc(ifx_PPFFT_t* handle,
+                            const ifx_Matrix_R_t* input,
+                            ifx_FFT_Batch_Axis_t input_axis,
+                            ifx_Matrix_C_t* output,
+                            ifx_FFT_Batch_Axis_t output_axis);
+
+/**
+ * @brief Calculates 1D FFTs with pre-processing for a batch of complex input vectors.
+ *
+ * Each row or column of the input matrix is processed like with \ref ifx_ppfft_run_c,
+ * see \ref ifx_fft_run_batch_c for the arrangement of the vectors.
+ *
+ * @param [in]     handle        A handle to the 1D pre-processed FFT object
+ * @param [in]     input         Complex input matrix
+ * @param [in]     input_axis    Arrangement of the input vectors
+ * @param [out]    output        Complex output matrix
+ * @param [in]     output_axis   Arrangement of the output vectors
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_ppfft_run_batch_c(ifx_PPFFT_t* handle,
+                           const ifx_Matrix_C_t* input,
+                           ifx_FFT_Batch_Axis_t input_axis,
+                           ifx_Matrix_C_t* output,
+                           ifx_FFT_Batch_Axis_t output_axis);
+
 /**
  * @brief Destroys handle (object) for 1D FFT chain along with internal memories.
  *
@@ -162,6 +202,48 @@ void ifx_ppfft_run_c(ifx_PPFFT_t* handle,
 IFX_DLL_PUBLIC
 void ifx_ppfft_destroy(ifx_PPFFT_t* handle);
 
+/**
+ * @brief Returns a pre-processed FFT object from the handle cache or creates one.
+ *
+ * Objects released with \ref ifx_ppfft_release are kept in a cache and
+ * handed out again for an equal configuration, so switching between a few
+ * configurations does not allocate buffers, plan FFTs or compute windows.
+ * The object is in the same state as after \ref ifx_ppfft_create. Objects
+ * in the cache keep their FFT backend, see \ref ifx_fft_set_backend.
+ *
+ * @param [in]     config    Mean removal flag and FFT settings e.g. FFT type and FFT size
+ *
+ * @return Handle or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_PPFFT_t* ifx_ppfft_acquire(const ifx_PPFFT_Config_t* config);
+
+/**
+ * @brief Returns a pre-processed FFT object to the handle cache.
+ *
+ * The mean removal flag is reset to the configuration. Objects whose window
+ * was changed with \ref ifx_ppfft_set_window are destroyed instead. The
+ * object may come from \ref ifx_ppfft_create or \ref ifx_ppfft_acquire.
+ *
+ * @param [in]     handle    A handle to the 1D pre-processed FFT object
+ */
+IFX_DLL_PUBLIC
+void ifx_ppfft_release(ifx_PPFFT_t* handle);
+
+/**
+ * @brief Destroys all pre-processed FFT objects in the handle cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_ppfft_clear_cache(void);
+
+/**
+ * @brief Returns hits, misses and acquire latency of the handle cache.
+ *
+ * @param [out]    stats     Statistics of the cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_ppfft_get_cache_stats(ifx_Handle_Cache_Stats_t* stats);
+
 /**
  * @brief Sets the mean removal flag to true or false.
  *
@@ -222,13 +304,16 @@ void ifx_ppfft_set_window(ifx_PPFFT_t* handle,
 /**
  * @brief Returns pointer to the window used in preprocessed FFT.
  *
+ * The window comes from the window cache (see \ref ifx_window_acquire) and
+ * may be shared with other objects, so it must not be modified.
+ *
  * @param [in]     handle    A handle to the 1D pre-processed FFT object
  *
  * @return Pointer to the real vector containing window values
  *
  */
 IFX_DLL_PUBLIC
-ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle);
+const ifx_Vector_R_t* ifx_ppfft_get_window(ifx_PPFFT_t* handle);
 
 /**
  * @brief Returns type of window used in preprocessed FFT.
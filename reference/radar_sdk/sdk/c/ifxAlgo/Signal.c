@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <string.h>  // for memmove
 
+#include "ifxAlgo/FFT.h"
 #include "ifxAlgo/Signal.h"
 #include "ifxAlgo/Window.h"
 
@@ -45,6 +46,8 @@
 
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/ComplexInline.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Mem.h"
 
@@ -58,6 +61,9 @@
 // Reference Fractional Bandwidth for Gaussian Pulse fixed at -6dB
 #define GAUSSPULSE_REF_FRAC_BW (-6)
 
+// Poles with an imaginary part up to this value are treated as real poles
+#define SOS_REAL_POLE_TOLERANCE (1e-5f)
+
 // Modulo which ensures modified length of hilbert filter is in accordance with the implementation.
 #define HILBERT_FIR_MODULO (3)
 
@@ -70,9 +76,32 @@
 // Maximum Order for Hilbert Transformation
 #define HILBERT_ORDER_MAX (50)
 
+// Maximum order of the streaming hilbert transform with FFTs, the filter
+// (4*order-1 taps) must fit into half of the largest FFT
+#define HILBERT_STREAM_FFT_ORDER_MAX (8192)
+
 // Invalid Mean Absolute Error
 #define MAE_INVALID (-1.)
 
+// Heaps of a median window (index into heap and size of Median_Window_t)
+#define MEDIAN_LOWER (0)
+#define MEDIAN_UPPER (1)
+
+// Median windows up to this size keep a sorted array instead of heaps, which
+// is faster for the small windows typically used for smoothing
+#define MEDIAN_SORTED_MAX_SIZE (32)
+
+// Correlations are computed with FFTs (overlap-save) if the shorter input has
+// at least CORRELATE_FFT_MIN_LENGTH samples and the direct computation takes at
+// least CORRELATE_FFT_MIN_WORK multiply-adds. Below, the SIMD dot products of
+// the direct computation are faster.
+#define CORRELATE_FFT_MIN_LENGTH (64U)
+#define CORRELATE_FFT_MIN_WORK (1U << 16)
+
+// Largest FFT supported by ifx_fft_create, the filter must fit into half of it
+#define CORRELATE_FFT_MAX_SIZE (65536U)
+#define CORRELATE_FFT_MAX_FILTER (CORRELATE_FFT_MAX_SIZE / 2)
+
 
 /*
 ==============================================================================
@@ -110,6 +139,102 @@ struct ifx_Hilbert_R_s
     ifx_Vector_R_t* flush_out_vector;
 };
 
+/**
+ * @brief Running median over a window of up to capacity values
+ *
+ * Each value of the window occupies a slot. The slots are kept in two heaps,
+ * a max-heap with the lower half of the values and a min-heap with the upper
+ * half, so the median is at the tops of the heaps. Inserting or removing a
+ * value costs O(log capacity).
+ *
+ * Up to MEDIAN_SORTED_MAX_SIZE slots the values are kept in a sorted array
+ * instead, and the heaps are not used.
+ */
+typedef struct
+{
+    ifx_Float_t* values; /**< Value of each slot */
+    ifx_Float_t* sorted; /**< Sorted values for small windows, NULL if the heaps are used */
+    uint32_t* heap[2];   /**< Slots in the lower (max) heap and the upper (min) heap */
+    uint32_t* position;  /**< Position of each slot in its heap times 2, plus 1 for the upper heap */
+    uint32_t size[2];    /**< Number of slots in the lower and upper heap */
+    uint32_t count;      /**< Number of values in the window */
+    uint32_t capacity;   /**< Number of slots */
+} Median_Window_t;
+
+/**
+ * @brief Defines the structure for the streaming median filter.
+ *        Use type ifx_Median_R_t for this struct.
+ */
+struct ifx_Median_R_s
+{
+    Median_Window_t window; /**< Last win_size samples */
+    uint32_t next_slot;     /**< Slot of the next sample, oldest sample if the window is full */
+};
+
+/**
+ * @brief Defines the structure for the multi-channel second-order sections filter.
+ *        Use type ifx_SOS_R_t for this struct.
+ */
+struct ifx_SOS_R_s
+{
+    ifx_Matrix_R_t* coeffs;         /**< Coefficients b0, b1, b2, a1, a2 of each section (one row per section), normalized to a0=1 */
+    ifx_Matrix_R_t* state;          /**< States z1 (row 2*s) and z2 (row 2*s+1) of section s, one column per channel */
+    ifx_Vector_R_t* buffer;         /**< One sample per channel for inputs or outputs with gaps between the elements */
+    const ifx_Kernels_t* kernels;   /**< Kernels computing the sections */
+};
+
+/**
+ * @brief Defines the structure for the FFT based correlation.
+ *        Use type ifx_Correlator_R_t for this struct.
+ *
+ * The correlation with a template is computed as convolution with the
+ * reversed template (the filter) using overlap-save: each block of fft_size
+ * input samples overlaps the previous one by filter_length-1 samples and
+ * yields fft_size-filter_length+1 output samples. Two real blocks are
+ * transformed at once as real and imaginary part of one complex FFT.
+ */
+struct ifx_Correlator_R_s
+{
+    ifx_FFT_t* fft;            /**< Complex FFT of fft_size points */
+    ifx_Complex_t* filter;     /**< Spectrum of the filter, scaled by 1/fft_size */
+    ifx_Complex_t* block;      /**< FFT input */
+    ifx_Complex_t* spectrum;   /**< FFT output */
+    ifx_Float_t* signal;       /**< Two buffers with the input of a channel, preceded by filter_length-1 samples */
+    uint32_t signal_size;      /**< Size of each buffer in signal */
+    ifx_Matrix_R_t* history;   /**< Last filter_length-1 input samples, one row per channel (streaming only) */
+    uint32_t filter_length;
+    uint32_t fft_size;
+};
+
+/**
+ * @brief Defines the structure for the streaming hilbert transform.
+ *        Use type ifx_Hilbert_Stream_R_t for this struct.
+ *
+ * signal holds the last 2*delay input samples followed by the current
+ * block, the output of the current block is centered at signal[delay+n].
+ */
+struct ifx_Hilbert_Stream_R_s
+{
+    ifx_Float_t* taps;               /**< Taps at the odd offsets 1, 3, ..., delay right of the center */
+    uint32_t order;                  /**< Number of taps */
+    uint32_t delay;                  /**< Center of the filter, 2*order-1 */
+    ifx_Float_t* signal;             /**< Last 2*delay samples followed by the current block */
+    ifx_Float_t* quad;               /**< Imaginary part of the current block (direct computation only) */
+    uint32_t capacity;               /**< Number of block samples signal and quad have space for */
+    ifx_Correlator_R_t* correlator;  /**< Overlap-save convolution with the filter, NULL for the direct computation */
+};
+
+/**
+ * @brief Input block of the overlap-save correlation and where its output goes
+ */
+typedef struct
+{
+    const ifx_Float_t* input; /**< length samples, the rest of the block is zero */
+    uint32_t length;          /**< At most fft_size, and at least filter_length */
+    ifx_Float_t* output;      /**< Receives length-filter_length+1 samples */
+    uint32_t stride;          /**< Stride of output */
+} Correlate_Block_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -181,6 +306,163 @@ static void calc_poly_c(const ifx_Vector_C_t* c, ifx_Vector_C_t* result_c);
  */
 static void calc_binom_vec(uint32_t n, ifx_Float_t a, ifx_Vector_R_t* result);
 
+/**
+ * @brief Allocates an empty median window with capacity slots
+ *
+ * @param [out] window      median window
+ * @param [in]  capacity    number of slots
+ * @retval true if successful, false if the memory allocation failed
+ */
+static bool median_window_init(Median_Window_t* window, uint32_t capacity);
+
+/**
+ * @brief Releases the memory of a median window
+ *
+ * @param [in,out] window      median window
+ */
+static void median_window_deinit(Median_Window_t* window);
+
+/**
+ * @brief Adds value to the median window in the given (unused) slot
+ *
+ * @param [in,out] window      median window
+ * @param [in]     slot        slot for value
+ * @param [in]     value       value to add
+ */
+static void median_window_insert(Median_Window_t* window, uint32_t slot, ifx_Float_t value);
+
+/**
+ * @brief Removes the value in the given slot from the median window
+ *
+ * @param [in,out] window      median window
+ * @param [in]     slot        slot to free
+ */
+static void median_window_remove(Median_Window_t* window, uint32_t slot);
+
+/**
+ * @brief Returns the median of the values in the (non-empty) median window
+ *
+ * For an even number of values the mean of the two middle values is returned.
+ *
+ * @param [in]     window      median window
+ * @retval median
+ */
+static ifx_Float_t median_window_median(const Median_Window_t* window);
+
+/**
+ * @brief Median filter of one vector, see \ref ifx_signal_filter_median
+ *
+ * @param [in,out] window      empty median window with win_size slots, empty again on return
+ * @param [in]     input       data before filtration
+ * @param [out]    output      data after filtration
+ * @param [in]     win_size    window size
+ */
+static void filter_median(Median_Window_t* window, const ifx_Vector_R_t* input, ifx_Vector_R_t* output, uint32_t win_size);
+
+/**
+ * @brief Computes the poles of a digital Butterworth low-pass or high-pass filter
+ *
+ * @param [in]  order                   order of the filter
+ * @param [in]  sampling_frequency_Hz   sampling frequency in Hz
+ * @param [in]  cutoff_frequency_Hz     cutoff frequency in Hz
+ * @param [in]  is_highpass             true for a high-pass, false for a low-pass filter
+ * @retval vector with order poles in the z-plane, NULL in case of failure
+ */
+static ifx_Vector_C_t* butterworth_lowhighpass_poles(uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency_Hz, bool is_highpass);
+
+/**
+ * @brief Computes the poles of a digital Butterworth band-pass filter
+ *
+ * @param [in]  order                   order of the filter
+ * @param [in]  sampling_frequency_Hz   sampling frequency in Hz
+ * @param [in]  frequency_low_Hz        lower cutoff frequency in Hz
+ * @param [in]  frequency_high_Hz       upper cutoff frequency in Hz
+ * @retval vector with 2*order poles in the z-plane, NULL in case of failure
+ */
+static ifx_Vector_C_t* butterworth_bandpass_poles(uint32_t order,
+                                                  ifx_Float_t sampling_frequency_Hz,
+                                                  ifx_Float_t frequency_low_Hz,
+                                                  ifx_Float_t frequency_high_Hz);
+
+/**
+ * @brief Computes one sample of each channel with the second-order sections
+ *
+ * @param [in,out] sos         filter object
+ * @param [in]     input       one sample per channel
+ * @param [out]    output      one filtered sample per channel, may be identical to input
+ */
+static void sos_run_sample(ifx_SOS_R_t* sos, const ifx_Vector_R_t* input, ifx_Vector_R_t* output);
+
+/**
+ * @brief Creates an FFT based correlator for a filter
+ *
+ * @param [in]  filter          filter (reversed template) or template if reversed is true
+ * @param [in]  reversed        use the reversed vector as filter
+ * @param [in]  fft_size        FFT size, power of 2 and at least twice the filter length
+ * @retval correlator, NULL in case of failure
+ */
+static ifx_Correlator_R_t* correlator_create(const ifx_Vector_R_t* filter, bool reversed, uint32_t fft_size);
+
+/**
+ * @brief Adds a block to the overlap-save correlation
+ *
+ * Blocks are computed in pairs, so the block is kept in pending if pending
+ * is empty. Call correlator_flush once all blocks were added.
+ *
+ * @param [in]     correlator  correlator
+ * @param [in,out] pending     block waiting for a second one, input is NULL if there is none
+ * @param [in]     block       block to add
+ */
+static void correlator_add(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending, const Correlate_Block_t* block);
+
+/**
+ * @brief Computes the pending block of the overlap-save correlation, if any
+ */
+static void correlator_flush(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending);
+
+/**
+ * @brief Splits a signal into blocks and adds them to the correlation
+ *
+ * signal holds count+filter_length-1 samples, output receives count samples
+ * of the convolution of the signal with the filter.
+ */
+static void correlator_add_signal(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending,
+                                  const ifx_Float_t* signal, uint32_t count, ifx_Float_t* output, uint32_t stride);
+
+/**
+ * @brief Computes the imaginary part of count samples of the streaming hilbert transform
+ *
+ * signal holds count+2*delay samples, the result is written to quad.
+ */
+static void hilbert_stream_direct(ifx_Hilbert_Stream_R_t* stream, uint32_t count);
+
+/**
+ * @brief Makes sure each signal buffer of the correlator holds size samples
+ *
+ * @retval true on success, false if memory allocation failed
+ */
+static bool correlator_reserve(ifx_Correlator_R_t* correlator, uint32_t size);
+
+/**
+ * @brief Returns the FFT size for a filter and the number of output samples
+ *
+ * Blocks of four times the filter length keep the overlap at a quarter of
+ * the block. Shorter signals are computed in a single block.
+ */
+static uint32_t correlate_fft_size(uint32_t filter_length, uint32_t count);
+
+/**
+ * @brief Decides if the correlation of vectors of the given lengths is computed with FFTs
+ */
+static bool correlate_use_fft(uint32_t len_x, uint32_t len_y);
+
+/**
+ * @brief Computes the correlation z of x and y with FFTs
+ *
+ * z receives vLen(z) samples of the full correlation starting at index first.
+ */
+static void correlate_fft(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, ifx_Vector_R_t* z, uint32_t first);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -224,11 +506,11 @@ static void calc_poly_c(const ifx_Vector_C_t* c, ifx_Vector_C_t* result_c)
         {
             ifx_vec_setat_c(result_c,
                             vLen(c) - j,
-                            ifx_complex_sub(vAt(result_c, vLen(c) - j + 1),
-                                            ifx_complex_mul(vAt(c, i), vAt(result_c, vLen(c) - j))));
+                            ifx_csub(vAt(result_c, vLen(c) - j + 1),
+                                     ifx_cmul(vAt(c, i), vAt(result_c, vLen(c) - j))));
         }
 
-        ifx_vec_setat_c(result_c, vLen(c), ifx_complex_mul_real(ifx_complex_mul(vAt(c, i), vAt(result_c, vLen(c))), -1));
+        ifx_vec_setat_c(result_c, vLen(c), ifx_cscale(ifx_cmul(vAt(c, i), vAt(result_c, vLen(c))), -1));
     }
 
     ifx_vec_setat_c(result_c, 0, complex_one);
@@ -280,6 +562,203 @@ void correlate_full(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, ifx_Vector
     }
 }
 
+//----------------------------------------------------------------------------
+
+static ifx_Correlator_R_t* correlator_create(const ifx_Vector_R_t* filter, bool reversed, uint32_t fft_size)
+{
+    const uint32_t filter_length = vLen(filter);
+
+    ifx_Correlator_R_t* correlator = ifx_mem_calloc(1, sizeof(ifx_Correlator_R_t));
+    IFX_ERR_BRN_MEMALLOC(correlator);
+
+    correlator->filter_length = filter_length;
+    correlator->fft_size = fft_size;
+
+    correlator->fft = ifx_fft_create(IFX_FFT_TYPE_C2C, fft_size);
+    IFX_ERR_BRF_MEMALLOC(correlator->fft);
+
+    correlator->filter = ifx_mem_alloc(fft_size * sizeof(ifx_Complex_t));
+    correlator->block = ifx_mem_alloc(fft_size * sizeof(ifx_Complex_t));
+    correlator->spectrum = ifx_mem_alloc(fft_size * sizeof(ifx_Complex_t));
+    IFX_ERR_BRF_MEMALLOC(correlator->filter && correlator->block && correlator->spectrum);
+
+    for (uint32_t i = 0; i < fft_size; i++)
+    {
+        const ifx_Float_t value = (i >= filter_length) ? 0
+                                  : reversed         ? vAt(filter, filter_length - 1 - i)
+                                                     : vAt(filter, i);
+        IFX_COMPLEX_SET(correlator->block[i], value, 0);
+    }
+    ifx_fft_raw_c(correlator->fft, correlator->block, correlator->spectrum);
+
+    // the inverse FFT is computed as forward FFT, see correlator_run_pair
+    const ifx_Complex_t scale = IFX_COMPLEX_DEF(1 / (ifx_Float_t)fft_size, 0);
+    ifx_kernels_get()->scale_c(correlator->spectrum, scale, correlator->filter, fft_size);
+
+    return correlator;
+
+fail:
+    ifx_signal_correlator_destroy_r(correlator);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static void correlator_run_pair(ifx_Correlator_R_t* correlator, const Correlate_Block_t* first, const Correlate_Block_t* second)
+{
+    const uint32_t N = correlator->fft_size;
+    const uint32_t overlap = correlator->filter_length - 1;
+    ifx_Complex_t* block = correlator->block;
+    ifx_Complex_t* spectrum = correlator->spectrum;
+
+    // the blocks are real, so the convolution of first + i*second with the
+    // real filter is the convolution of first plus i times the one of second
+    const uint32_t second_length = second ? second->length : 0;
+    for (uint32_t i = 0; i < N; i++)
+    {
+        const ifx_Float_t re = (i < first->length) ? first->input[i] : 0;
+        const ifx_Float_t im = (i < second_length) ? second->input[i] : 0;
+        IFX_COMPLEX_SET(block[i], re, im);
+    }
+
+    ifx_fft_raw_c(correlator->fft, block, spectrum);
+    ifx_kernels_get()->mul_c(spectrum, correlator->filter, block, N);
+
+    // the inverse FFT of X is the forward FFT of X at index N-i (modulo N),
+    // divided by N which is already part of the filter
+    ifx_fft_raw_c(correlator->fft, block, spectrum);
+
+    for (uint32_t i = overlap; i < first->length; i++)
+        first->output[(i - overlap) * first->stride] = IFX_COMPLEX_REAL(spectrum[(N - i) & (N - 1)]);
+
+    for (uint32_t i = overlap; i < second_length; i++)
+        second->output[(i - overlap) * second->stride] = IFX_COMPLEX_IMAG(spectrum[(N - i) & (N - 1)]);
+}
+
+//----------------------------------------------------------------------------
+
+static void correlator_add(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending, const Correlate_Block_t* block)
+{
+    if (pending->input == NULL)
+    {
+        *pending = *block;
+        return;
+    }
+
+    correlator_run_pair(correlator, pending, block);
+    pending->input = NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static void correlator_flush(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending)
+{
+    if (pending->input == NULL)
+        return;
+
+    correlator_run_pair(correlator, pending, NULL);
+    pending->input = NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static void correlator_add_signal(ifx_Correlator_R_t* correlator, Correlate_Block_t* pending,
+                                  const ifx_Float_t* signal, uint32_t count, ifx_Float_t* output, uint32_t stride)
+{
+    const uint32_t overlap = correlator->filter_length - 1;
+    const uint32_t step = correlator->fft_size - overlap;
+
+    for (uint32_t position = 0; position < count; position += step)
+    {
+        const uint32_t samples = MIN(step, count - position);
+        const Correlate_Block_t block = {signal + position, samples + overlap, output + (size_t)position * stride, stride};
+        correlator_add(correlator, pending, &block);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static bool correlator_reserve(ifx_Correlator_R_t* correlator, uint32_t size)
+{
+    if (correlator->signal_size >= size)
+        return true;
+
+    ifx_mem_free(correlator->signal);
+    correlator->signal = ifx_mem_alloc(2 * (size_t)size * sizeof(ifx_Float_t));
+    correlator->signal_size = correlator->signal ? size : 0;
+    return correlator->signal != NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t correlate_fft_size(uint32_t filter_length, uint32_t count)
+{
+    const uint64_t target = MIN(4 * (uint64_t)filter_length, (uint64_t)count + filter_length - 1);
+
+    uint32_t fft_size = 4;
+    while (fft_size < target && fft_size < CORRELATE_FFT_MAX_SIZE)
+        fft_size *= 2;
+
+    // the blocks must yield at least as many samples as they overlap
+    while (fft_size < 2 * filter_length)
+        fft_size *= 2;
+
+    return fft_size;
+}
+
+//----------------------------------------------------------------------------
+
+static bool correlate_use_fft(uint32_t len_x, uint32_t len_y)
+{
+    const uint32_t shorter = MIN(len_x, len_y);
+    return (shorter >= CORRELATE_FFT_MIN_LENGTH)
+           && (shorter <= CORRELATE_FFT_MAX_FILTER)
+           && ((uint64_t)len_x * len_y >= CORRELATE_FFT_MIN_WORK);
+}
+
+//----------------------------------------------------------------------------
+
+static void correlate_fft(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, ifx_Vector_R_t* z, uint32_t first)
+{
+    // The full correlation is the convolution of x with the reversed y. As the
+    // convolution is commutative, the shorter vector is used as filter.
+    const bool swap = vLen(y) > vLen(x);
+    const ifx_Vector_R_t* filter = swap ? x : y;
+    const ifx_Vector_R_t* signal = swap ? y : x;
+    const uint32_t filter_length = vLen(filter);
+    const uint32_t signal_length = vLen(signal);
+    const uint32_t count = vLen(z);
+
+    ifx_Correlator_R_t* correlator = correlator_create(filter, !swap, correlate_fft_size(filter_length, count));
+    if (correlator == NULL)
+        return;
+
+    const uint32_t size = count + filter_length - 1;
+    if (!correlator_reserve(correlator, size))
+    {
+        ifx_signal_correlator_destroy_r(correlator);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return;
+    }
+
+    // sample i of the buffer is sample first-(filter_length-1)+i of the signal
+    ifx_Float_t* buffer = correlator->signal;
+    for (uint32_t i = 0; i < size; i++)
+    {
+        const int64_t index = (int64_t)first - (filter_length - 1) + i;
+        if (index < 0 || index >= signal_length)
+            buffer[i] = 0;
+        else
+            buffer[i] = swap ? vAt(signal, signal_length - 1 - (uint32_t)index) : vAt(signal, (uint32_t)index);
+    }
+
+    Correlate_Block_t pending = {0};
+    correlator_add_signal(correlator, &pending, buffer, count, vDat(z), vStride(z));
+    correlator_flush(correlator, &pending);
+
+    ifx_signal_correlator_destroy_r(correlator);
+}
+
 //----------------------------------------------------------------------------
 #if 0
 static void calc_poly_r(const ifx_Vector_R_t* c, ifx_Vector_R_t* result_r)
@@ -399,72 +878,411 @@ void filter_r(const ifx_Vector_R_t* input, ifx_Vector_R_t* output, ifx_Float_t s
     }
 }
 
-/*
-==============================================================================
-   7. EXPORTED FUNCTIONS
-==============================================================================
-*/
-
-void ifx_signal_filt_run_r(ifx_Filter_R_t* filter,
-                           const ifx_Vector_R_t* input,
-                           ifx_Vector_R_t* output)
-{
-    IFX_ERR_BRK_NULL(filter);
-    ifx_Vector_R_t state_a;
-    ifx_Vector_R_t state_b;
-    ifx_mat_get_rowview_r(filter->state_a, 0, &state_a);
-    ifx_mat_get_rowview_r(filter->state_b, 0, &state_b);
-    filter_r(input, output, filter->scale, filter->a, filter->b, &state_a, &state_b);
-}
-
 //----------------------------------------------------------------------------
 
-void ifx_signal_filt_run_mat_r(ifx_Filter_R_t* filter, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output)
+static bool median_window_init(Median_Window_t* window, uint32_t capacity)
 {
-    IFX_ERR_BRK_NULL(filter);
-    IFX_MAT_BRK_VALID(input);
-    IFX_MAT_BRK_VALID(output);
+    const bool use_sorted = (capacity <= MEDIAN_SORTED_MAX_SIZE);
 
-    // dimensions of output must be equal to dimensions of input
-    IFX_MAT_BRK_DIM(input, output);
+    // a single allocation for values and either the sorted values or both heaps and positions
+    const size_t index_size = use_sorted ? capacity * sizeof(ifx_Float_t) : 3 * capacity * sizeof(uint32_t);
+    uint8_t* memory = ifx_mem_alloc(capacity * sizeof(ifx_Float_t) + index_size);
+    if (!memory)
+    {
+        return false;
+    }
 
-    IFX_ERR_BRK_COND(mRows(input) > mRows(filter->state_a), IFX_ERROR_ARGUMENT_INVALID);
+    window->values = (ifx_Float_t*)memory;
+    window->sorted = NULL;
+    window->heap[MEDIAN_LOWER] = NULL;
+    window->heap[MEDIAN_UPPER] = NULL;
+    window->position = NULL;
 
-    const uint32_t rows = mRows(input);
-    for (uint32_t row = 0; row < rows; row++)
+    if (use_sorted)
     {
-        ifx_Vector_R_t state_a = {0};
-        ifx_Vector_R_t state_b = {0};
-        ifx_Vector_R_t row_input = {0};
-        ifx_Vector_R_t row_output = {0};
+        window->sorted = window->values + capacity;
+    }
+    else
+    {
+        window->heap[MEDIAN_LOWER] = (uint32_t*)(window->values + capacity);
+        window->heap[MEDIAN_UPPER] = window->heap[MEDIAN_LOWER] + capacity;
+        window->position = window->heap[MEDIAN_UPPER] + capacity;
+    }
 
-        ifx_mat_get_rowview_r(filter->state_a, row, &state_a);
-        ifx_mat_get_rowview_r(filter->state_b, row, &state_b);
-        ifx_mat_get_rowview_r(input, row, &row_input);
-        ifx_mat_get_rowview_r(output, row, &row_output);
+    window->size[MEDIAN_LOWER] = 0;
+    window->size[MEDIAN_UPPER] = 0;
+    window->count = 0;
+    window->capacity = capacity;
+    return true;
+}
 
-        filter_r(&row_input, &row_output, filter->scale, filter->a, filter->b, &state_a, &state_b);
-    }
+//----------------------------------------------------------------------------
+
+static void median_window_deinit(Median_Window_t* window)
+{
+    // values is the start of the allocation
+    ifx_mem_free(window->values);
+    window->values = NULL;
 }
 
 //----------------------------------------------------------------------------
 
+static inline bool heap_before(const Median_Window_t* window, uint32_t heap, uint32_t slot_a, uint32_t slot_b)
+{
+    const ifx_Float_t a = window->values[slot_a];
+    const ifx_Float_t b = window->values[slot_b];
+    return (heap == MEDIAN_UPPER) ? (a < b) : (a > b);
+}
 
-void ifx_signal_filt_reset_r(ifx_Filter_R_t* filter)
+//----------------------------------------------------------------------------
+
+static inline void heap_set(Median_Window_t* window, uint32_t heap, uint32_t index, uint32_t slot)
 {
-    ifx_mat_clear_r(filter->state_a);
-    ifx_mat_clear_r(filter->state_b);
+    window->heap[heap][index] = slot;
+    window->position[slot] = (index << 1) | heap;
 }
 
 //----------------------------------------------------------------------------
 
-void ifx_signal_filt_resize_r(ifx_Filter_R_t* filter, uint32_t size)
+static void heap_sift_up(Median_Window_t* window, uint32_t heap, uint32_t index)
 {
-    IFX_ERR_BRK_ARGUMENT(size == 0);
+    const uint32_t slot = window->heap[heap][index];
 
-    ifx_Matrix_R_t* state_a = ifx_mat_create_r(size, mCols(filter->state_a));
-    ifx_Matrix_R_t* state_b = ifx_mat_create_r(size, mCols(filter->state_b));
-    if (state_a == NULL || state_b == NULL)
+    while (index > 0)
+    {
+        const uint32_t parent = (index - 1) / 2;
+        const uint32_t parent_slot = window->heap[heap][parent];
+        if (!heap_before(window, heap, slot, parent_slot))
+        {
+            break;
+        }
+
+        heap_set(window, heap, index, parent_slot);
+        index = parent;
+    }
+
+    heap_set(window, heap, index, slot);
+}
+
+//----------------------------------------------------------------------------
+
+static void heap_sift_down(Median_Window_t* window, uint32_t heap, uint32_t index)
+{
+    const uint32_t* slots = window->heap[heap];
+    const uint32_t size = window->size[heap];
+    const uint32_t slot = slots[index];
+
+    for (;;)
+    {
+        uint32_t child = 2 * index + 1;
+        if (child >= size)
+        {
+            break;
+        }
+
+        if (child + 1 < size && heap_before(window, heap, slots[child + 1], slots[child]))
+        {
+            child++;
+        }
+
+        if (!heap_before(window, heap, slots[child], slot))
+        {
+            break;
+        }
+
+        heap_set(window, heap, index, slots[child]);
+        index = child;
+    }
+
+    heap_set(window, heap, index, slot);
+}
+
+//----------------------------------------------------------------------------
+
+static void heap_push(Median_Window_t* window, uint32_t heap, uint32_t slot)
+{
+    const uint32_t index = window->size[heap]++;
+    heap_set(window, heap, index, slot);
+    heap_sift_up(window, heap, index);
+}
+
+//----------------------------------------------------------------------------
+
+static void heap_remove(Median_Window_t* window, uint32_t heap, uint32_t index)
+{
+    const uint32_t last = window->heap[heap][--window->size[heap]];
+    if (index < window->size[heap])
+    {
+        // move the last slot into the gap and restore the heap property
+        heap_set(window, heap, index, last);
+        heap_sift_up(window, heap, index);
+        heap_sift_down(window, heap, window->position[last] >> 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void median_window_balance(Median_Window_t* window)
+{
+    // the lower heap holds the middle value if the number of values is odd
+    if (window->size[MEDIAN_LOWER] > window->size[MEDIAN_UPPER] + 1)
+    {
+        const uint32_t slot = window->heap[MEDIAN_LOWER][0];
+        heap_remove(window, MEDIAN_LOWER, 0);
+        heap_push(window, MEDIAN_UPPER, slot);
+    }
+    else if (window->size[MEDIAN_UPPER] > window->size[MEDIAN_LOWER])
+    {
+        const uint32_t slot = window->heap[MEDIAN_UPPER][0];
+        heap_remove(window, MEDIAN_UPPER, 0);
+        heap_push(window, MEDIAN_LOWER, slot);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void median_window_insert(Median_Window_t* window, uint32_t slot, ifx_Float_t value)
+{
+    window->values[slot] = value;
+    window->count++;
+
+    if (window->sorted)
+    {
+        // insertion sort step
+        uint32_t i = window->count - 1;
+        for (; i > 0 && window->sorted[i - 1] > value; i--)
+        {
+            window->sorted[i] = window->sorted[i - 1];
+        }
+        window->sorted[i] = value;
+        return;
+    }
+
+    if (window->size[MEDIAN_LOWER] == 0 || value <= window->values[window->heap[MEDIAN_LOWER][0]])
+    {
+        heap_push(window, MEDIAN_LOWER, slot);
+    }
+    else
+    {
+        heap_push(window, MEDIAN_UPPER, slot);
+    }
+
+    median_window_balance(window);
+}
+
+//----------------------------------------------------------------------------
+
+static void median_window_remove(Median_Window_t* window, uint32_t slot)
+{
+    window->count--;
+
+    if (window->sorted)
+    {
+        // equal values are interchangeable, so any copy of the value may go
+        const ifx_Float_t value = window->values[slot];
+        uint32_t i = 0;
+        while (window->sorted[i] != value)
+        {
+            i++;
+        }
+        for (; i < window->count; i++)
+        {
+            window->sorted[i] = window->sorted[i + 1];
+        }
+        return;
+    }
+
+    const uint32_t position = window->position[slot];
+    heap_remove(window, position & 1, position >> 1);
+    median_window_balance(window);
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Float_t median_window_median(const Median_Window_t* window)
+{
+    if (window->sorted)
+    {
+        const uint32_t middle = window->count / 2;
+        if (window->count % 2)
+        {
+            return window->sorted[middle];
+        }
+
+        return (window->sorted[middle] + window->sorted[middle - 1]) / 2;
+    }
+
+    const ifx_Float_t lower = window->values[window->heap[MEDIAN_LOWER][0]];
+    if (window->size[MEDIAN_LOWER] > window->size[MEDIAN_UPPER])
+    {
+        return lower;
+    }
+
+    const ifx_Float_t upper = window->values[window->heap[MEDIAN_UPPER][0]];
+    return (upper + lower) / 2;
+}
+
+//----------------------------------------------------------------------------
+
+static void filter_median(Median_Window_t* window, const ifx_Vector_R_t* input, ifx_Vector_R_t* output, uint32_t win_size)
+{
+    const uint32_t len = vLen(input);
+    const uint32_t win_len_left = win_size / 2;
+    const uint32_t win_len_right = win_size - win_len_left;
+
+    // The window of output i is [i-win_len_left, i+win_len_right) clipped to
+    // the input. Element j uses slot j % win_size, which is unique within a
+    // window. As all inputs of a window are read before output i is written,
+    // input and output may be the same vector.
+    for (uint32_t j = 0; j < MIN(win_len_right, len); j++)
+    {
+        median_window_insert(window, j % win_size, vAt(input, j));
+    }
+
+    for (uint32_t i = 0; i < len; i++)
+    {
+        vAt(output, i) = median_window_median(window);
+
+        // slide the window: the outgoing slot is freed before it is reused
+        if (i >= win_len_left)
+        {
+            median_window_remove(window, (i - win_len_left) % win_size);
+        }
+        if (i + win_len_right < len)
+        {
+            const uint32_t j = i + win_len_right;
+            median_window_insert(window, j % win_size, vAt(input, j));
+        }
+    }
+
+    // the window still holds the last elements
+    for (uint32_t j = (len > win_len_left) ? len - win_len_left : 0; j < len; j++)
+    {
+        median_window_remove(window, j % win_size);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void sos_run_sample(ifx_SOS_R_t* sos, const ifx_Vector_R_t* input, ifx_Vector_R_t* output)
+{
+    const uint32_t num_channels = vLen(input);
+    const ifx_Float_t* x = vDat(input);
+    ifx_Float_t* y = vDat(output);
+
+    // the kernels need the channels without gaps
+    if (vStride(input) != 1)
+    {
+        for (uint32_t i = 0; i < num_channels; i++)
+            vAt(sos->buffer, i) = vAt(input, i);
+        x = vDat(sos->buffer);
+    }
+    if (vStride(output) != 1)
+    {
+        y = vDat(sos->buffer);
+    }
+
+    // the first section reads the input, all others filter the output in place
+    for (uint32_t s = 0; s < mRows(sos->coeffs); s++)
+    {
+        sos->kernels->biquad_r(s ? y : x, y, &mAt(sos->state, 2 * s, 0), &mAt(sos->state, 2 * s + 1, 0),
+                               &mAt(sos->coeffs, s, 0), num_channels);
+    }
+
+    if (y == vDat(sos->buffer))
+    {
+        for (uint32_t i = 0; i < num_channels; i++)
+            vAt(output, i) = vAt(sos->buffer, i);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void hilbert_stream_direct(ifx_Hilbert_Stream_R_t* stream, uint32_t count)
+{
+    ifx_Float_t* quad = stream->quad;
+
+    // h[-m] = -h[m], so each tap multiplies the difference of two samples
+    for (uint32_t n = 0; n < count; n++)
+        quad[n] = 0;
+
+    for (uint32_t k = 0; k < stream->order; k++)
+    {
+        const uint32_t m = 2 * k + 1;
+        const ifx_Float_t* left = stream->signal + stream->delay - m;
+        const ifx_Float_t* right = stream->signal + stream->delay + m;
+        const ifx_Float_t tap = stream->taps[k];
+        for (uint32_t n = 0; n < count; n++)
+            quad[n] += tap * (left[n] - right[n]);
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_signal_filt_run_r(ifx_Filter_R_t* filter,
+                           const ifx_Vector_R_t* input,
+                           ifx_Vector_R_t* output)
+{
+    IFX_ERR_BRK_NULL(filter);
+    ifx_Vector_R_t state_a;
+    ifx_Vector_R_t state_b;
+    ifx_mat_get_rowview_r(filter->state_a, 0, &state_a);
+    ifx_mat_get_rowview_r(filter->state_b, 0, &state_b);
+    filter_r(input, output, filter->scale, filter->a, filter->b, &state_a, &state_b);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_filt_run_mat_r(ifx_Filter_R_t* filter, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output)
+{
+    IFX_ERR_BRK_NULL(filter);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+
+    // dimensions of output must be equal to dimensions of input
+    IFX_MAT_BRK_DIM(input, output);
+
+    IFX_ERR_BRK_COND(mRows(input) > mRows(filter->state_a), IFX_ERROR_ARGUMENT_INVALID);
+
+    const uint32_t rows = mRows(input);
+    for (uint32_t row = 0; row < rows; row++)
+    {
+        ifx_Vector_R_t state_a = {0};
+        ifx_Vector_R_t state_b = {0};
+        ifx_Vector_R_t row_input = {0};
+        ifx_Vector_R_t row_output = {0};
+
+        ifx_mat_get_rowview_r(filter->state_a, row, &state_a);
+        ifx_mat_get_rowview_r(filter->state_b, row, &state_b);
+        ifx_mat_get_rowview_r(input, row, &row_input);
+        ifx_mat_get_rowview_r(output, row, &row_output);
+
+        filter_r(&row_input, &row_output, filter->scale, filter->a, filter->b, &state_a, &state_b);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+
+void ifx_signal_filt_reset_r(ifx_Filter_R_t* filter)
+{
+    ifx_mat_clear_r(filter->state_a);
+    ifx_mat_clear_r(filter->state_b);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_filt_resize_r(ifx_Filter_R_t* filter, uint32_t size)
+{
+    IFX_ERR_BRK_ARGUMENT(size == 0);
+
+    ifx_Matrix_R_t* state_a = ifx_mat_create_r(size, mCols(filter->state_a));
+    ifx_Matrix_R_t* state_b = ifx_mat_create_r(size, mCols(filter->state_b));
+    if (state_a == NULL || state_b == NULL)
     {
         ifx_mat_destroy_r(state_a);
         ifx_mat_destroy_r(state_b);
@@ -582,14 +1400,33 @@ void ifx_signal_filt_destroy_r(ifx_Filter_R_t* filter)
 
 void ifx_signal_correlate_r(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, ifx_Vector_R_t* z, ifx_Correlate_Type_t mode)
 {
+    IFX_VEC_BRK_VALID(x);
+    IFX_VEC_BRK_VALID(y);
+    IFX_VEC_BRK_VALID(z);
+
+    const bool use_fft = correlate_use_fft(vLen(x), vLen(y));
+
     switch (mode)
     {
         case IFX_CORRELATE_SAME:
-            correlate_same(x, y, z);
+            if (use_fft)
+            {
+                IFX_VEC_BRK_DIM(x, z);
+                // the centered part of the full correlation
+                correlate_fft(x, y, z, vLen(y) - 1 - vLen(y) / 2);
+            }
+            else
+                correlate_same(x, y, z);
             break;
 
         case IFX_CORRELATE_FULL:
-            correlate_full(x, y, z);
+            if (use_fft)
+            {
+                IFX_ERR_BRK_COND(vLen(z) != vLen(x) + vLen(y) - 1, IFX_ERROR_DIMENSION_MISMATCH);
+                correlate_fft(x, y, z, 0);
+            }
+            else
+                correlate_full(x, y, z);
             break;
 
         default:
@@ -599,6 +1436,148 @@ void ifx_signal_correlate_r(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, if
 
 //----------------------------------------------------------------------------
 
+void ifx_signal_correlate_mat_r(const ifx_Matrix_R_t* x, const ifx_Vector_R_t* y, ifx_Matrix_R_t* z, ifx_Correlate_Type_t mode)
+{
+    IFX_MAT_BRK_VALID(x);
+    IFX_VEC_BRK_VALID(y);
+    IFX_MAT_BRK_VALID(z);
+    IFX_ERR_BRK_COND(mRows(x) != mRows(z), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_ARGUMENT(mode != IFX_CORRELATE_SAME && mode != IFX_CORRELATE_FULL);
+
+    const uint32_t len_x = mCols(x);
+    const uint32_t len_y = vLen(y);
+    const uint32_t count = (mode == IFX_CORRELATE_SAME) ? len_x : len_x + len_y - 1;
+    IFX_ERR_BRK_COND(mCols(z) != count, IFX_ERROR_DIMENSION_MISMATCH);
+
+    if (!correlate_use_fft(len_x, len_y) || len_y > CORRELATE_FFT_MAX_FILTER)
+    {
+        for (uint32_t row = 0; row < mRows(x); row++)
+        {
+            ifx_Vector_R_t row_x = {0};
+            ifx_Vector_R_t row_z = {0};
+            ifx_mat_get_rowview_r(x, row, &row_x);
+            ifx_mat_get_rowview_r(z, row, &row_z);
+            ifx_signal_correlate_r(&row_x, y, &row_z, mode);
+        }
+        return;
+    }
+
+    // y is the template of all rows, its spectrum is computed once
+    ifx_Correlator_R_t* correlator = correlator_create(y, true, correlate_fft_size(len_y, count));
+    if (correlator == NULL)
+        return;
+
+    const uint32_t overlap = len_y - 1;
+    const uint32_t first = (mode == IFX_CORRELATE_SAME) ? len_y - 1 - len_y / 2 : 0;
+    const uint32_t size = count + overlap;
+    if (!correlator_reserve(correlator, size))
+    {
+        ifx_signal_correlator_destroy_r(correlator);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return;
+    }
+
+    // Rows alternate between the two signal buffers, so the last block of a
+    // row can be paired with the first block of the next row.
+    Correlate_Block_t pending = {0};
+    for (uint32_t row = 0; row < mRows(x); row++)
+    {
+        ifx_Float_t* buffer = correlator->signal + (size_t)(row % 2) * correlator->signal_size;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            const int64_t index = (int64_t)first - overlap + i;
+            buffer[i] = (index < 0 || index >= len_x) ? 0 : mAt(x, row, (uint32_t)index);
+        }
+        correlator_add_signal(correlator, &pending, buffer, count, &mAt(z, row, 0), mStride(z, 1));
+    }
+    correlator_flush(correlator, &pending);
+
+    ifx_signal_correlator_destroy_r(correlator);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Correlator_R_t* ifx_signal_correlator_create_r(const ifx_Vector_R_t* y, uint32_t num_channels)
+{
+    IFX_VEC_BRV_VALID(y, NULL);
+    IFX_ERR_BRN_ARGUMENT(num_channels == 0);
+    IFX_ERR_BRN_ARGUMENT(vLen(y) > CORRELATE_FFT_MAX_FILTER);
+
+    ifx_Correlator_R_t* correlator = correlator_create(y, true, correlate_fft_size(vLen(y), UINT32_MAX));
+    if (correlator == NULL)
+        return NULL;
+
+    IFX_ERR_HANDLE_N(correlator->history = ifx_mat_create_r(num_channels, MAX(vLen(y) - 1, 1)),
+                     ifx_signal_correlator_destroy_r(correlator));
+
+    return correlator;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_correlator_run_r(ifx_Correlator_R_t* correlator, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output)
+{
+    IFX_ERR_BRK_NULL(correlator);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_MAT_BRK_DIM(input, output);
+    IFX_ERR_BRK_COND(mRows(input) != mRows(correlator->history), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t count = mCols(input);
+    const uint32_t overlap = correlator->filter_length - 1;
+    const uint32_t size = count + overlap;
+    if (!correlator_reserve(correlator, size))
+    {
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return;
+    }
+
+    // Each channel is copied to a buffer before any of its output is written,
+    // so input and output may be the same matrix. Channels alternate between
+    // the two buffers, see ifx_signal_correlate_mat_r.
+    Correlate_Block_t pending = {0};
+    for (uint32_t channel = 0; channel < mRows(input); channel++)
+    {
+        ifx_Float_t* buffer = correlator->signal + (size_t)(channel % 2) * correlator->signal_size;
+        for (uint32_t i = 0; i < overlap; i++)
+            buffer[i] = mAt(correlator->history, channel, i);
+        for (uint32_t i = 0; i < count; i++)
+            buffer[overlap + i] = mAt(input, channel, i);
+        for (uint32_t i = 0; i < overlap; i++)
+            mAt(correlator->history, channel, i) = buffer[count + i];
+
+        correlator_add_signal(correlator, &pending, buffer, count, &mAt(output, channel, 0), mStride(output, 1));
+    }
+    correlator_flush(correlator, &pending);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_correlator_reset_r(ifx_Correlator_R_t* correlator)
+{
+    IFX_ERR_BRK_NULL(correlator);
+
+    ifx_mat_clear_r(correlator->history);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_correlator_destroy_r(ifx_Correlator_R_t* correlator)
+{
+    if (correlator == NULL)
+        return;
+
+    ifx_fft_destroy(correlator->fft);
+    ifx_mem_free(correlator->filter);
+    ifx_mem_free(correlator->block);
+    ifx_mem_free(correlator->spectrum);
+    ifx_mem_free(correlator->signal);
+    ifx_mat_destroy_r(correlator->history);
+    ifx_mem_free(correlator);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_signal_gaussianpulse_r(const ifx_Vector_R_t* input,
                                 ifx_Float_t centerfreq,
                                 ifx_Float_t pulse_bw,
@@ -797,6 +1776,141 @@ fail:
 
 //----------------------------------------------------------------------------
 
+ifx_Hilbert_Stream_R_t* ifx_signal_hilbert_stream_create_r(uint32_t hilbert_order, bool use_fft)
+{
+    ifx_Vector_R_t* coeffs = NULL;
+
+    IFX_ERR_BRN_ARGUMENT(hilbert_order == 0);
+    IFX_ERR_BRN_ARGUMENT(hilbert_order > (use_fft ? HILBERT_STREAM_FFT_ORDER_MAX : HILBERT_ORDER_MAX));
+
+    ifx_Hilbert_Stream_R_t* stream = ifx_mem_calloc(1, sizeof(ifx_Hilbert_Stream_R_t));
+    IFX_ERR_BRN_MEMALLOC(stream);
+
+    stream->order = hilbert_order;
+    stream->delay = 2 * hilbert_order - 1;
+
+    coeffs = ifx_vec_create_r(4 * hilbert_order - 1);
+    stream->taps = ifx_mem_alloc(hilbert_order * sizeof(ifx_Float_t));
+    IFX_ERR_BRF_MEMALLOC(coeffs && stream->taps);
+
+    ifx_signal_hilbert_filter_calc_r(coeffs);
+    for (uint32_t k = 0; k < hilbert_order; k++)
+        stream->taps[k] = vAt(coeffs, stream->delay + 2 * k + 1);
+
+    if (use_fft)
+    {
+        stream->correlator = correlator_create(coeffs, false, correlate_fft_size(vLen(coeffs), UINT32_MAX));
+        IFX_ERR_BRF_MEMALLOC(stream->correlator);
+    }
+
+    ifx_vec_destroy_r(coeffs);
+    return stream;
+
+fail:
+    ifx_vec_destroy_r(coeffs);
+    ifx_signal_hilbert_stream_destroy_r(stream);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_hilbert_stream_run_c(ifx_Hilbert_Stream_R_t* stream,
+                                     const ifx_Vector_R_t* input,
+                                     ifx_Vector_C_t* output)
+{
+    IFX_ERR_BRK_NULL(stream);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM(input, output);
+
+    const uint32_t count = vLen(input);
+    const uint32_t history = 2 * stream->delay;
+
+    if (count == 0)
+        return;
+
+    if (count > stream->capacity)
+    {
+        // keep the history when growing the buffer
+        ifx_Float_t* signal = ifx_mem_alloc(((size_t)history + count) * sizeof(ifx_Float_t));
+        ifx_Float_t* quad = ifx_mem_alloc((size_t)count * sizeof(ifx_Float_t));
+        if (signal == NULL || quad == NULL)
+        {
+            ifx_mem_free(signal);
+            ifx_mem_free(quad);
+            ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+            return;
+        }
+
+        if (stream->signal)
+            memcpy(signal, stream->signal, history * sizeof(ifx_Float_t));
+        else
+            memset(signal, 0, history * sizeof(ifx_Float_t));
+
+        ifx_mem_free(stream->signal);
+        ifx_mem_free(stream->quad);
+        stream->signal = signal;
+        stream->quad = quad;
+        stream->capacity = count;
+    }
+
+    for (uint32_t n = 0; n < count; n++)
+        stream->signal[history + n] = vAt(input, n);
+
+    if (stream->correlator)
+    {
+        // the convolution of the buffer with the filter is the imaginary part
+        Correlate_Block_t pending = {0};
+        correlator_add_signal(stream->correlator, &pending, stream->signal, count,
+                              stream->quad, 1);
+        correlator_flush(stream->correlator, &pending);
+    }
+    else
+    {
+        hilbert_stream_direct(stream, count);
+    }
+
+    for (uint32_t n = 0; n < count; n++)
+        IFX_COMPLEX_SET(vAt(output, n), stream->signal[stream->delay + n], stream->quad[n]);
+
+    memmove(stream->signal, stream->signal + count, history * sizeof(ifx_Float_t));
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_signal_hilbert_stream_get_delay(const ifx_Hilbert_Stream_R_t* stream)
+{
+    IFX_ERR_BRV_NULL(stream, 0);
+
+    return stream->delay;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_hilbert_stream_reset_r(ifx_Hilbert_Stream_R_t* stream)
+{
+    IFX_ERR_BRK_NULL(stream);
+
+    if (stream->signal)
+        memset(stream->signal, 0, 2 * stream->delay * sizeof(ifx_Float_t));
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_hilbert_stream_destroy_r(ifx_Hilbert_Stream_R_t* stream)
+{
+    if (stream == NULL)
+        return;
+
+    ifx_mem_free(stream->taps);
+    ifx_mem_free(stream->signal);
+    ifx_mem_free(stream->quad);
+    ifx_signal_correlator_destroy_r(stream->correlator);
+    ifx_mem_free(stream);
+}
+
+//----------------------------------------------------------------------------
+
 ifx_Float_t ifx_signal_mean_abs_error_c(const ifx_Vector_C_t* reference,
                                         const ifx_Vector_C_t* vector)
 {
@@ -811,38 +1925,22 @@ ifx_Float_t ifx_signal_mean_abs_error_c(const ifx_Vector_C_t* reference,
     ifx_Float_t sum_abs_error = 0;
     for (uint32_t i = 0; i < vLen(vector); i++)
     {
-        sum_abs_error += ifx_complex_abs((ifx_complex_sub(vAt(reference, i), vAt(vector, i))));
+        sum_abs_error += ifx_complex_abs((ifx_csub(vAt(reference, i), vAt(vector, i))));
     }
     mean_abs_error = sum_abs_error / vLen(vector);
 fail:
     return mean_abs_error;
-}
-
-//----------------------------------------------------------------------------
-
-/* See https://docs.scipy.org/doc/scipy/reference/generated/scipy.signal.butter.html
- * and https://www.dsprelated.com/showarticle/1128.php.
- * Also, see https://en.wikipedia.org/wiki/Bilinear_transform on how to transform the
- * analogue filter to a digital one.
- */
-void ifx_signal_butterworth_bandpass(uint32_t order,
-                                     ifx_Float_t sampling_frequency_Hz,
-                                     ifx_Float_t frequency_low_Hz,
-                                     ifx_Float_t frequency_high_Hz,
-                                     ifx_Vector_R_t* b_r,
-                                     ifx_Vector_R_t* a_r)
-{
-    /* check input parameters */
-    IFX_VEC_BRK_VALID(a_r);
-    IFX_VEC_BRK_VALID(b_r);
-    IFX_ERR_BRK_ARGUMENT(order == 0);
-    IFX_ERR_BRK_COND(vLen(a_r) != (2 * order + 1), IFX_ERROR_DIMENSION_MISMATCH);
-    IFX_ERR_BRK_COND(vLen(b_r) != (2 * order + 1), IFX_ERROR_DIMENSION_MISMATCH);
-    IFX_ERR_BRK_ARGUMENT(frequency_low_Hz <= 0 || frequency_low_Hz >= frequency_high_Hz || (2 * frequency_high_Hz) >= sampling_frequency_Hz);
+}
+
+//----------------------------------------------------------------------------
 
+static ifx_Vector_C_t* butterworth_bandpass_poles(uint32_t order,
+                                                  ifx_Float_t sampling_frequency_Hz,
+                                                  ifx_Float_t frequency_low_Hz,
+                                                  ifx_Float_t frequency_high_Hz)
+{
     ifx_Vector_C_t* pa_c = NULL;
     ifx_Vector_C_t* p_c = NULL;
-    ifx_Vector_C_t* a_c = NULL;
     ifx_Vector_C_t* p_prime_c = NULL;
 
     /* step 1:
@@ -869,12 +1967,12 @@ void ifx_signal_butterworth_bandpass(uint32_t order,
         const ifx_Complex_t neg_one_i_c = IFX_COMPLEX_DEF(0, -1);  // -1j
 
         ifx_Complex_t pk_prime_c = vAt(p_prime_c, k);
-        ifx_Complex_t x_c = ifx_complex_mul_real(pk_prime_c, alpha);
-        ifx_Complex_t x2_c = ifx_complex_mul(x_c, x_c);
-        ifx_Complex_t root = ifx_complex_sqrt(ifx_complex_sub(complex_one, x2_c));
+        ifx_Complex_t x_c = ifx_cscale(pk_prime_c, alpha);
+        ifx_Complex_t x2_c = ifx_cmul(x_c, x_c);
+        ifx_Complex_t root = ifx_complex_sqrt(ifx_csub(complex_one, x2_c));
 
-        vAt(pa_c, 2 * k + 0) = ifx_complex_add(x_c, ifx_complex_mul(one_i_c, root));
-        vAt(pa_c, 2 * k + 1) = ifx_complex_add(x_c, ifx_complex_mul(neg_one_i_c, root));
+        vAt(pa_c, 2 * k + 0) = ifx_cadd(x_c, ifx_cmul(one_i_c, root));
+        vAt(pa_c, 2 * k + 1) = ifx_cadd(x_c, ifx_cmul(neg_one_i_c, root));
     }
     ifx_vec_scale_cr(pa_c, 2 * IFX_PI * F0, pa_c);
 
@@ -885,9 +1983,49 @@ void ifx_signal_butterworth_bandpass(uint32_t order,
     for (uint32_t j = 0; j < 2 * order; j++)
     {
         ifx_Complex_t x = ifx_complex_div_real(vAt(pa_c, j), 2 * sampling_frequency_Hz);
-        vAt(p_c, j) = ifx_complex_div(ifx_complex_add(complex_one, x), ifx_complex_sub(complex_one, x));
+        vAt(p_c, j) = ifx_complex_div(ifx_cadd(complex_one, x), ifx_csub(complex_one, x));
     }
 
+    ifx_vec_destroy_c(p_prime_c);
+    ifx_vec_destroy_c(pa_c);
+    return p_c;
+
+fail:
+    ifx_vec_destroy_c(p_prime_c);
+    ifx_vec_destroy_c(pa_c);
+    ifx_vec_destroy_c(p_c);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+/* See https://docs.scipy.org/doc/scipy/reference/generated/scipy.signal.butter.html
+ * and https://www.dsprelated.com/showarticle/1128.php.
+ * Also, see https://en.wikipedia.org/wiki/Bilinear_transform on how to transform the
+ * analogue filter to a digital one.
+ */
+void ifx_signal_butterworth_bandpass(uint32_t order,
+                                     ifx_Float_t sampling_frequency_Hz,
+                                     ifx_Float_t frequency_low_Hz,
+                                     ifx_Float_t frequency_high_Hz,
+                                     ifx_Vector_R_t* b_r,
+                                     ifx_Vector_R_t* a_r)
+{
+    /* check input parameters */
+    IFX_VEC_BRK_VALID(a_r);
+    IFX_VEC_BRK_VALID(b_r);
+    IFX_ERR_BRK_ARGUMENT(order == 0);
+    IFX_ERR_BRK_COND(vLen(a_r) != (2 * order + 1), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(vLen(b_r) != (2 * order + 1), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_ARGUMENT(frequency_low_Hz <= 0 || frequency_low_Hz >= frequency_high_Hz || (2 * frequency_high_Hz) >= sampling_frequency_Hz);
+
+    ifx_Vector_C_t* a_c = NULL;
+
+    // Steps 1 to 4: poles of the digital filter
+    ifx_Vector_C_t* p_c = butterworth_bandpass_poles(order, sampling_frequency_Hz, frequency_low_Hz, frequency_high_Hz);
+    if (p_c == NULL)
+        goto fail;
+
     // Step 5
     // b_r are the coefficients of the polynomial
     // (1-z)^order * (1+z)^order = (1-z*z)^order
@@ -916,14 +2054,14 @@ void ifx_signal_butterworth_bandpass(uint32_t order,
         const ifx_Complex_t z = IFX_COMPLEX_DEF(COS(theta), -SIN(theta));
 
         // numerator: (1+z)^order * (1-z)^order = ((1+z)*(1-z))^order
-        const ifx_Complex_t opz = ifx_complex_add(complex_one, z);  // 1+z ("one minus z")
-        const ifx_Complex_t omz = ifx_complex_sub(complex_one, z);  // 1-z ("one plus z")
-        const ifx_Complex_t numerator_c = ifx_complex_pow(ifx_complex_mul(omz, opz), order);
+        const ifx_Complex_t opz = ifx_cadd(complex_one, z);  // 1+z ("one minus z")
+        const ifx_Complex_t omz = ifx_csub(complex_one, z);  // 1-z ("one plus z")
+        const ifx_Complex_t numerator_c = ifx_complex_pow(ifx_cmul(omz, opz), order);
 
         // denominator = (z-p_0)*(z-p_1)*...*(z-p_2N)
         ifx_Complex_t denominator_c = complex_one;
         for (uint32_t i = 0; i < vLen(p_c); i++)
-            denominator_c = ifx_complex_mul(denominator_c, ifx_complex_sub(z, vAt(p_c, i)));
+            denominator_c = ifx_cmul(denominator_c, ifx_csub(z, vAt(p_c, i)));
 
         const ifx_Float_t K = ifx_complex_abs(ifx_complex_div(numerator_c, denominator_c));
         IFX_ERR_BRF_COND(K == 0.0, IFX_ERROR_INTERNAL);
@@ -932,29 +2070,12 @@ void ifx_signal_butterworth_bandpass(uint32_t order,
     }
 
 fail:
-    ifx_vec_destroy_c(p_prime_c);
-    ifx_vec_destroy_c(pa_c);
     ifx_vec_destroy_c(p_c);
     ifx_vec_destroy_c(a_c);
 }
 
-static void butterworth_lowhighpass(uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency_Hz, bool is_highpass, ifx_Vector_R_t* b, ifx_Vector_R_t* a)
+static ifx_Vector_C_t* butterworth_lowhighpass_poles(uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency_Hz, bool is_highpass)
 {
-    /* See https://docs.scipy.org/doc/scipy/reference/generated/scipy.signal.butter.html,
-     * https://www.dsprelated.com/showarticle/1135.php (high-pass) and https://www.dsprelated.com/showarticle/1119.php (low-pass).
-     * Also, see https://en.wikipedia.org/wiki/Bilinear_transform on how to transform the
-     * analogue filter to a digital one.
-     */
-
-    /* check input parameters */
-    IFX_VEC_BRK_VALID(a);
-    IFX_VEC_BRK_VALID(b);
-    IFX_ERR_BRK_ARGUMENT(order == 0);
-    IFX_ERR_BRK_COND(vLen(a) != (order + 1), IFX_ERROR_DIMENSION_MISMATCH);
-    IFX_ERR_BRK_COND(vLen(b) != (order + 1), IFX_ERROR_DIMENSION_MISMATCH);
-    IFX_ERR_BRK_ARGUMENT(sampling_frequency_Hz <= 0 || cutoff_frequency_Hz <= 0 || (2 * cutoff_frequency_Hz) >= sampling_frequency_Hz);
-
-    ifx_Vector_C_t* ac = NULL;
     ifx_Vector_C_t* poles = NULL;
     ifx_Vector_C_t* p = NULL;
 
@@ -1005,12 +2126,48 @@ static void butterworth_lowhighpass(uint32_t order, ifx_Float_t sampling_frequen
         const ifx_Complex_t numerator = ifx_complex_add_real(z, 1);
 
         /* 1-z */
-        const ifx_Complex_t denominator = ifx_complex_add_real(ifx_complex_mul_real(z, -1), 1);
+        const ifx_Complex_t denominator = ifx_complex_add_real(ifx_cscale(z, -1), 1);
 
         /* p = (1 + poles / (2 * sampling_frequency_Hz)) / (1 - poles / (2 * sampling_frequency_Hz)) */
         vAt(p, j) = ifx_complex_div(numerator, denominator);
     }
 
+    ifx_vec_destroy_c(poles);
+    return p;
+
+fail:
+    ifx_vec_destroy_c(poles);
+    ifx_vec_destroy_c(p);
+    return NULL;
+}
+
+//----------------------------------------------------------------------------
+
+static void butterworth_lowhighpass(uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency_Hz, bool is_highpass, ifx_Vector_R_t* b, ifx_Vector_R_t* a)
+{
+    /* See https://docs.scipy.org/doc/scipy/reference/generated/scipy.signal.butter.html,
+     * https://www.dsprelated.com/showarticle/1135.php (high-pass) and https://www.dsprelated.com/showarticle/1119.php (low-pass).
+     * Also, see https://en.wikipedia.org/wiki/Bilinear_transform on how to transform the
+     * analogue filter to a digital one.
+     */
+
+    /* check input parameters */
+    IFX_VEC_BRK_VALID(a);
+    IFX_VEC_BRK_VALID(b);
+    IFX_ERR_BRK_ARGUMENT(order == 0);
+    IFX_ERR_BRK_COND(vLen(a) != (order + 1), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(vLen(b) != (order + 1), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_ARGUMENT(sampling_frequency_Hz <= 0 || cutoff_frequency_Hz <= 0 || (2 * cutoff_frequency_Hz) >= sampling_frequency_Hz);
+
+    ifx_Vector_C_t* ac = NULL;
+
+    /* steps 1 to 4:
+     * Compute the poles of the digital filter
+     */
+    ifx_Vector_C_t* p = butterworth_lowhighpass_poles(order, sampling_frequency_Hz, cutoff_frequency_Hz, is_highpass);
+    if (p == NULL)
+        goto fail;
+
     /* step 5:
      * Add order of zeros at z=-1 (low-pass) or z=1 (high-pass).
      * The transfer function H(z) then looks like:
@@ -1062,7 +2219,7 @@ static void butterworth_lowhighpass(uint32_t order, ifx_Float_t sampling_frequen
 
         ifx_Complex_t product = complex_one;
         for (uint32_t j = 0; j < vLen(p); j++)
-            product = ifx_complex_mul(product, ifx_complex_sub(z, vAt(p, j)));
+            product = ifx_cmul(product, ifx_csub(z, vAt(p, j)));
 
         ifx_Float_t K = IFX_COMPLEX_REAL(product) / POW(2, (ifx_Float_t)order);
         if (is_highpass && order % 2)
@@ -1074,7 +2231,6 @@ static void butterworth_lowhighpass(uint32_t order, ifx_Float_t sampling_frequen
 
 fail:
     ifx_vec_destroy_c(p);
-    ifx_vec_destroy_c(poles);
     ifx_vec_destroy_c(ac);
 }
 
@@ -1090,6 +2246,236 @@ void ifx_signal_butterworth_highpass(uint32_t order, ifx_Float_t sampling_freque
 
 //----------------------------------------------------------------------------
 
+ifx_SOS_R_t* ifx_signal_sos_create_r(const ifx_Matrix_R_t* sos, uint32_t num_channels)
+{
+    IFX_MAT_BRV_VALID(sos, NULL);
+    IFX_ERR_BRN_COND(mCols(sos) != 6, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRN_ARGUMENT(num_channels == 0);
+
+    for (uint32_t s = 0; s < mRows(sos); s++)
+        IFX_ERR_BRN_ARGUMENT(mAt(sos, s, 3) == 0);
+
+    ifx_SOS_R_t* filter = ifx_mem_calloc(1, sizeof(ifx_SOS_R_t));
+    IFX_ERR_BRN_MEMALLOC(filter);
+
+    IFX_ERR_HANDLE_N(filter->coeffs = ifx_mat_create_r(mRows(sos), 5),
+                     ifx_signal_sos_destroy_r(filter));
+    IFX_ERR_HANDLE_N(filter->state = ifx_mat_create_r(2 * mRows(sos), num_channels),
+                     ifx_signal_sos_destroy_r(filter));
+    IFX_ERR_HANDLE_N(filter->buffer = ifx_vec_create_r(num_channels),
+                     ifx_signal_sos_destroy_r(filter));
+
+    for (uint32_t s = 0; s < mRows(sos); s++)
+    {
+        const ifx_Float_t scale = 1 / mAt(sos, s, 3);
+        mAt(filter->coeffs, s, 0) = mAt(sos, s, 0) * scale;
+        mAt(filter->coeffs, s, 1) = mAt(sos, s, 1) * scale;
+        mAt(filter->coeffs, s, 2) = mAt(sos, s, 2) * scale;
+        mAt(filter->coeffs, s, 3) = mAt(sos, s, 4) * scale;
+        mAt(filter->coeffs, s, 4) = mAt(sos, s, 5) * scale;
+    }
+
+    filter->kernels = ifx_kernels_get();
+
+    return filter;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_SOS_R_t* ifx_signal_sos_butterworth_create_r(ifx_Butterworth_Type_t type, uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency1_Hz, ifx_Float_t cutoff_frequency2_Hz, uint32_t num_channels)
+{
+    IFX_ERR_BRN_ARGUMENT(order == 0);
+    IFX_ERR_BRN_ARGUMENT(sampling_frequency_Hz <= 0 || cutoff_frequency1_Hz <= 0);
+
+    ifx_Vector_C_t* poles = NULL;
+    ifx_Matrix_R_t* sos = NULL;
+    ifx_SOS_R_t* filter = NULL;
+
+    // Zeros are at z=-1 (low-pass), z=1 (high-pass) or one at each (band-pass)
+    // per section. Each section gets unity gain at z0, which is z=1 (low-pass),
+    // z=-1 (high-pass), or the center frequency (band-pass).
+    ifx_Float_t b1;
+    ifx_Float_t b2;
+    ifx_Float_t theta0;
+    switch (type)
+    {
+        case IFX_BUTTERWORTH_LOWPASS:
+        case IFX_BUTTERWORTH_HIGHPASS:
+            IFX_ERR_BRN_ARGUMENT((2 * cutoff_frequency1_Hz) >= sampling_frequency_Hz);
+            poles = butterworth_lowhighpass_poles(order, sampling_frequency_Hz, cutoff_frequency1_Hz, type == IFX_BUTTERWORTH_HIGHPASS);
+            b1 = (type == IFX_BUTTERWORTH_HIGHPASS) ? -2 : 2;
+            b2 = 1;
+            theta0 = (type == IFX_BUTTERWORTH_HIGHPASS) ? IFX_PI : 0;
+            break;
+
+        case IFX_BUTTERWORTH_BANDPASS:
+            IFX_ERR_BRN_ARGUMENT(cutoff_frequency1_Hz >= cutoff_frequency2_Hz || (2 * cutoff_frequency2_Hz) >= sampling_frequency_Hz);
+            poles = butterworth_bandpass_poles(order, sampling_frequency_Hz, cutoff_frequency1_Hz, cutoff_frequency2_Hz);
+            b1 = 0;
+            b2 = -1;
+            theta0 = 2 * IFX_PI * SQRT(cutoff_frequency1_Hz * cutoff_frequency2_Hz) / sampling_frequency_Hz;
+            break;
+
+        default:
+            IFX_ERR_BRN_ARGUMENT(1);
+    }
+    if (poles == NULL)
+        return NULL;
+
+    // Complex poles come in conjugate pairs, each pair and each pair of real
+    // poles forms one section. A remaining real pole forms a first-order section.
+    uint32_t num_complex = 0;
+    uint32_t num_real = 0;
+    for (uint32_t j = 0; j < vLen(poles); j++)
+    {
+        const ifx_Float_t imag = IFX_COMPLEX_IMAG(vAt(poles, j));
+        if (FABS(imag) <= SOS_REAL_POLE_TOLERANCE)
+            num_real++;
+        else if (imag > 0)
+            num_complex++;
+    }
+
+    sos = ifx_mat_create_r(num_complex + (num_real + 1) / 2, 6);
+    IFX_ERR_BRF_MEMALLOC(sos);
+
+    // z0^-1 and z0^-2 to evaluate the transfer function of a section at z0
+    const ifx_Complex_t w1 = IFX_COMPLEX_DEF(COS(theta0), -SIN(theta0));
+    const ifx_Complex_t w2 = ifx_cmul(w1, w1);
+
+    uint32_t section = 0;
+    bool has_real = false;
+    ifx_Float_t real_pole = 0;
+    for (uint32_t j = 0; j <= vLen(poles); j++)
+    {
+        ifx_Float_t a1;
+        ifx_Float_t a2;
+        bool first_order = false;
+
+        if (j < vLen(poles))
+        {
+            const ifx_Complex_t p = vAt(poles, j);
+            if (FABS(IFX_COMPLEX_IMAG(p)) <= SOS_REAL_POLE_TOLERANCE)
+            {
+                if (!has_real)
+                {
+                    has_real = true;
+                    real_pole = IFX_COMPLEX_REAL(p);
+                    continue;
+                }
+
+                // (1 - p1*z^-1) * (1 - p2*z^-1)
+                a1 = -(real_pole + IFX_COMPLEX_REAL(p));
+                a2 = real_pole * IFX_COMPLEX_REAL(p);
+                has_real = false;
+            }
+            else if (IFX_COMPLEX_IMAG(p) > 0)
+            {
+                // (1 - p*z^-1) * (1 - conj(p)*z^-1)
+                a1 = -2 * IFX_COMPLEX_REAL(p);
+                a2 = ifx_cabs2(p);
+            }
+            else
+            {
+                continue;
+            }
+        }
+        else if (has_real)
+        {
+            // (1 - p*z^-1)
+            a1 = -real_pole;
+            a2 = 0;
+            first_order = true;
+        }
+        else
+        {
+            break;
+        }
+
+        const ifx_Float_t sb1 = first_order ? b1 / 2 : b1;
+        const ifx_Float_t sb2 = first_order ? 0 : b2;
+
+        // gain K = |A(z0)| / |B(z0)|
+        const ifx_Complex_t A = ifx_complex_add_real(ifx_cadd(ifx_cscale(w1, a1), ifx_cscale(w2, a2)), 1);
+        const ifx_Complex_t B = ifx_complex_add_real(ifx_cadd(ifx_cscale(w1, sb1), ifx_cscale(w2, sb2)), 1);
+        const ifx_Float_t K = ifx_complex_abs(A) / ifx_complex_abs(B);
+
+        mAt(sos, section, 0) = K;
+        mAt(sos, section, 1) = K * sb1;
+        mAt(sos, section, 2) = K * sb2;
+        mAt(sos, section, 3) = 1;
+        mAt(sos, section, 4) = a1;
+        mAt(sos, section, 5) = a2;
+        section++;
+    }
+
+    filter = ifx_signal_sos_create_r(sos, num_channels);
+
+fail:
+    ifx_vec_destroy_c(poles);
+    ifx_mat_destroy_r(sos);
+
+    return filter;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_sos_run_r(ifx_SOS_R_t* sos, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output)
+{
+    IFX_ERR_BRK_NULL(sos);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_MAT_BRK_DIM(input, output);
+    IFX_ERR_BRK_COND(mCols(input) != mCols(sos->state), IFX_ERROR_DIMENSION_MISMATCH);
+
+    for (uint32_t row = 0; row < mRows(input); row++)
+    {
+        ifx_Vector_R_t row_input = {0};
+        ifx_Vector_R_t row_output = {0};
+
+        ifx_mat_get_rowview_r(input, row, &row_input);
+        ifx_mat_get_rowview_r(output, row, &row_output);
+
+        sos_run_sample(sos, &row_input, &row_output);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_sos_run_sample_r(ifx_SOS_R_t* sos, const ifx_Vector_R_t* input, ifx_Vector_R_t* output)
+{
+    IFX_ERR_BRK_NULL(sos);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_VEC_BRK_DIM(input, output);
+    IFX_ERR_BRK_COND(vLen(input) != mCols(sos->state), IFX_ERROR_DIMENSION_MISMATCH);
+
+    sos_run_sample(sos, input, output);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_sos_reset_r(ifx_SOS_R_t* sos)
+{
+    IFX_ERR_BRK_NULL(sos);
+
+    ifx_mat_clear_r(sos->state);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_sos_destroy_r(ifx_SOS_R_t* sos)
+{
+    if (sos == NULL)
+        return;
+
+    ifx_mat_destroy_r(sos->coeffs);
+    ifx_mat_destroy_r(sos->state);
+    ifx_vec_destroy_r(sos->buffer);
+    ifx_mem_free(sos);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_signal_filter_median(const ifx_Vector_R_t* input, ifx_Vector_R_t* output, uint32_t win_size)
 {
     IFX_VEC_BRK_VALID(input);
@@ -1098,16 +2484,112 @@ void ifx_signal_filter_median(const ifx_Vector_R_t* input, ifx_Vector_R_t* outpu
     IFX_ERR_BRK_COND(vLen(input) != vLen(output), IFX_ERROR_DIMENSION_MISMATCH);
 
     win_size = MIN(win_size, vLen(input) * 2);  // 2x len there is max for median
-    const uint32_t len = vLen(input);
-    const uint32_t win_len_left = win_size / 2;
-    const uint32_t win_len_right = win_size - win_len_left;
 
-    for (uint32_t i = 0; i < len; i++)
+    Median_Window_t window;
+    IFX_ERR_BRK_COND(!median_window_init(&window, win_size), IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+
+    filter_median(&window, input, output, win_size);
+
+    median_window_deinit(&window);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_filter_median_mat(const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output, uint32_t win_size)
+{
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_ERR_BRK_ARGUMENT(win_size == 0);
+    IFX_MAT_BRK_DIM(input, output);
+
+    win_size = MIN(win_size, mCols(input) * 2);  // 2x len there is max for median
+
+    // the window is empty again after each row, so all rows share it
+    Median_Window_t window;
+    IFX_ERR_BRK_COND(!median_window_init(&window, win_size), IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+
+    for (uint32_t row = 0; row < mRows(input); row++)
+    {
+        ifx_Vector_R_t row_input = {0};
+        ifx_Vector_R_t row_output = {0};
+
+        ifx_mat_get_rowview_r(input, row, &row_input);
+        ifx_mat_get_rowview_r(output, row, &row_output);
+
+        filter_median(&window, &row_input, &row_output, win_size);
+    }
+
+    median_window_deinit(&window);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Median_R_t* ifx_signal_median_create_r(uint32_t win_size)
+{
+    IFX_ERR_BRN_ARGUMENT(win_size == 0);
+
+    ifx_Median_R_t* median = ifx_mem_alloc(sizeof(ifx_Median_R_t));
+    IFX_ERR_BRN_MEMALLOC(median);
+
+    if (!median_window_init(&median->window, win_size))
+    {
+        ifx_mem_free(median);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    median->next_slot = 0;
+    return median;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_median_run_r(ifx_Median_R_t* median, const ifx_Vector_R_t* input, ifx_Vector_R_t* output)
+{
+    IFX_ERR_BRK_NULL(median);
+    IFX_VEC_BRK_VALID(input);
+    IFX_VEC_BRK_VALID(output);
+    IFX_ERR_BRK_COND(vLen(input) != vLen(output), IFX_ERROR_DIMENSION_MISMATCH);
+
+    Median_Window_t* window = &median->window;
+
+    for (uint32_t i = 0; i < vLen(input); i++)
+    {
+        const uint32_t slot = median->next_slot;
+        if (window->count == window->capacity)
+        {
+            // drop the oldest sample
+            median_window_remove(window, slot);
+        }
+
+        median_window_insert(window, slot, vAt(input, i));
+        vAt(output, i) = median_window_median(window);
+
+        median->next_slot = (slot + 1 == window->capacity) ? 0 : slot + 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_median_reset_r(ifx_Median_R_t* median)
+{
+    IFX_ERR_BRK_NULL(median);
+
+    median->window.size[MEDIAN_LOWER] = 0;
+    median->window.size[MEDIAN_UPPER] = 0;
+    median->window.count = 0;
+    median->next_slot = 0;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_signal_median_destroy_r(ifx_Median_R_t* median)
+{
+    if (!median)
     {
-        const uint32_t start = (uint32_t)(MAX(0, (int32_t)i - (int32_t)win_len_left));
-        const uint32_t end = MIN(i + win_len_right, len);
-        // Range in math notation: [start, end)
-        const uint32_t median_size = end - start;
-        vAt(output, i) = ifx_vec_median_range_r(input, start, median_size);
+        return;
     }
+
+    median_window_deinit(&median->window);
+    ifx_mem_free(median);
 }
@@ -91,6 +91,26 @@ typedef struct ifx_Filter_R_s ifx_Filter_R_t;
  */
 typedef struct ifx_Hilbert_R_s ifx_Hilbert_R_t;
 
+/**
+ * @brief Forward declaration structure for streaming hilbert transform
+ */
+typedef struct ifx_Hilbert_Stream_R_s ifx_Hilbert_Stream_R_t;
+
+/**
+ * @brief Forward declaration structure for streaming median filter
+ */
+typedef struct ifx_Median_R_s ifx_Median_R_t;
+
+/**
+ * @brief Forward declaration structure for multi-channel second-order sections filter
+ */
+typedef struct ifx_SOS_R_s ifx_SOS_R_t;
+
+/**
+ * @brief Forward declaration structure for streaming multi-channel correlation
+ */
+typedef struct ifx_Correlator_R_s ifx_Correlator_R_t;
+
 /**
  * @brief Defines supported Window options.
  */
@@ -247,6 +267,95 @@ void ifx_signal_filt_reset_r(ifx_Filter_R_t* filter);
 IFX_DLL_PUBLIC
 void ifx_signal_filt_destroy_r(ifx_Filter_R_t* filter);
 
+/**
+ * @brief Creates a filter of cascaded second-order sections for many channels
+ *
+ * The filter applies the same IIR filter to num_channels independent
+ * channels, e.g. to the slow-time signals of many range bins. Each section
+ * is computed as a transposed direct form II biquad on all channels at once
+ * using SIMD instructions. Compared to \ref ifx_signal_filt_create_r with
+ * the expanded polynomials, cascaded sections stay numerically stable at
+ * high orders.
+ *
+ * The filter states are kept across calls of \ref ifx_signal_sos_run_r and
+ * \ref ifx_signal_sos_run_sample_r, so a continuous signal may be filtered in
+ * blocks, e.g. one sample per frame.
+ *
+ * @param [in]  sos             matrix with one section per row, the columns are
+ *                              b0, b1, b2, a0, a1, a2 (same layout as the sos
+ *                              output of scipy.signal.butter). a0 must not be 0.
+ * @param [in]  num_channels    number of channels
+ * @return Handle to the newly created filter or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_SOS_R_t* ifx_signal_sos_create_r(const ifx_Matrix_R_t* sos, uint32_t num_channels);
+
+/**
+ * @brief Creates a Butterworth filter of cascaded second-order sections
+ *
+ * The filter has the same transfer function as the one created by
+ * \ref ifx_signal_filter_butterworth_create_r, but is computed as cascaded
+ * second-order sections on num_channels channels, see
+ * \ref ifx_signal_sos_create_r. The poles of a section are a complex
+ * conjugate pair or two real poles; an odd order low-pass or high-pass
+ * filter has an additional first-order section. Each section has unity gain
+ * at 0 Hz (low-pass), at the Nyquist frequency (high-pass) or at the center
+ * frequency sqrt(cutoff_frequency1_Hz*cutoff_frequency2_Hz) (band-pass).
+ *
+ * @param [in]   type                    type of Butterworth filter.
+ * @param [in]   order                   order of Butterworth filter (must be positive).
+ * @param [in]   sampling_frequency_Hz   sampling frequency in Hz.
+ * @param [in]   cutoff_frequency1_Hz    cutoff frequency in Hz (lower cutoff frequency for band-pass filter).
+ * @param [in]   cutoff_frequency2_Hz    upper cutoff frequency in Hz (only used for band-pass filter).
+ * @param [in]   num_channels            number of channels
+ * @return Handle to the newly created filter or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_SOS_R_t* ifx_signal_sos_butterworth_create_r(ifx_Butterworth_Type_t type, uint32_t order, ifx_Float_t sampling_frequency_Hz, ifx_Float_t cutoff_frequency1_Hz, ifx_Float_t cutoff_frequency2_Hz, uint32_t num_channels);
+
+/**
+ * @brief Filters a block of samples of all channels
+ *
+ * Each row of input holds one sample of every channel (num_channels
+ * columns), consecutive rows are consecutive samples. input and output may
+ * point to the same matrix.
+ *
+ * @param [in,out] sos       filter object
+ * @param [in]     input     input samples, one row per sample and one column per channel
+ * @param [out]    output    filtered samples, same dimensions as input
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_sos_run_r(ifx_SOS_R_t* sos, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output);
+
+/**
+ * @brief Filters one sample of all channels
+ *
+ * Same as \ref ifx_signal_sos_run_r with a single row, e.g. for the range
+ * bins of one frame. input and output may point to the same vector.
+ *
+ * @param [in,out] sos       filter object
+ * @param [in]     input     one sample per channel
+ * @param [out]    output    one filtered sample per channel
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_sos_run_sample_r(ifx_SOS_R_t* sos, const ifx_Vector_R_t* input, ifx_Vector_R_t* output);
+
+/**
+ * @brief Resets the filter states of all channels maintaining the coefficients
+ *
+ * @param [in,out] sos       filter object
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_sos_reset_r(ifx_SOS_R_t* sos);
+
+/**
+ * @brief Destroys a second-order sections filter
+ *
+ * @param [in]     sos       filter object
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_sos_destroy_r(ifx_SOS_R_t* sos);
+
 /**
  * @brief Cross-correlate two 1-dimensional arrays.
  *
@@ -265,6 +374,12 @@ void ifx_signal_filt_destroy_r(ifx_Filter_R_t* filter);
  * If mode is \ref IFX_CORRELATE_SAME the output is a centered version of
  * mode \ref IFX_CORRELATE_FULL with dimension \f$\mathrm{len}(x)\f$.
  *
+ * Long inputs (both at least 64 samples and more than 65536 products) are
+ * correlated with FFTs using overlap-save, which costs
+ * \f$O((\mathrm{len}(x)+\mathrm{len}(y))\log\mathrm{len}(y))\f$ instead of
+ * \f$O(\mathrm{len}(x)\cdot\mathrm{len}(y))\f$. The results differ from
+ * the direct computation by rounding errors.
+ *
  * @param [in]     x        First input vector
  * @param [in]     y        Second input vector
  * @param [out]    z        Vector of discrete linear cross-correlation of input1 and input2
@@ -274,6 +389,81 @@ void ifx_signal_filt_destroy_r(ifx_Filter_R_t* filter);
 IFX_DLL_PUBLIC
 void ifx_signal_correlate_r(const ifx_Vector_R_t* x, const ifx_Vector_R_t* y, ifx_Vector_R_t* z, ifx_Correlate_Type_t mode);
 
+/**
+ * @brief Cross-correlates each row of a matrix with a vector
+ *
+ * Row r of z is the correlation of row r of x with y as computed by
+ * \ref ifx_signal_correlate_r, e.g. for the slow-time signals of many range
+ * bins against the same template. With the FFT based computation the
+ * spectrum of y is computed only once for all rows.
+ *
+ * z has the same number of rows as x, and \f$\mathrm{len}(x)\f$ columns
+ * for \ref IFX_CORRELATE_SAME or \f$\mathrm{len}(x)+\mathrm{len}(y)-1\f$
+ * columns for \ref IFX_CORRELATE_FULL, where \f$\mathrm{len}(x)\f$ is the
+ * number of columns of x. x and z must not overlap.
+ *
+ * @param [in]     x        Input signals, one per row
+ * @param [in]     y        Template
+ * @param [out]    z        Correlation of each row of x with y
+ * @param [in]     mode     Mode indicating size of output
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_correlate_mat_r(const ifx_Matrix_R_t* x, const ifx_Vector_R_t* y, ifx_Matrix_R_t* z, ifx_Correlate_Type_t mode);
+
+/**
+ * @brief Creates a streaming correlation of many channels with a template
+ *
+ * The correlator computes the correlation of continuous signals with the
+ * template y, fed in blocks of samples by \ref ifx_signal_correlator_run_r.
+ * Output sample n of a channel is
+ * \f[
+ * z_n = \sum_{m=0}^{\mathrm{len}(y)-1} y_m \cdot x_{n - \mathrm{len}(y) + 1 + m},
+ * \f]
+ * i.e. the template is aligned with the last \f$\mathrm{len}(y)\f$ input
+ * samples (a matched filter), where samples before the first one are 0.
+ * Concatenated over all blocks, the output equals the first samples of the
+ * full correlation (\ref IFX_CORRELATE_FULL) of the whole signal with y.
+ *
+ * The correlation is computed with FFTs using overlap-save, which pays off
+ * for blocks of at least a few times the template length.
+ *
+ * @param [in]  y               template, at most 32768 samples
+ * @param [in]  num_channels    number of channels
+ * @return Handle to the newly created correlator or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Correlator_R_t* ifx_signal_correlator_create_r(const ifx_Vector_R_t* y, uint32_t num_channels);
+
+/**
+ * @brief Correlates the next block of samples of all channels
+ *
+ * Each row of input holds the next samples of one channel, the number of
+ * columns may change between calls. input and output may point to the same
+ * matrix.
+ *
+ * @param [in,out] correlator    correlator object
+ * @param [in]     input         input samples, one row per channel
+ * @param [out]    output        correlation, same dimensions as input
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_correlator_run_r(ifx_Correlator_R_t* correlator, const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output);
+
+/**
+ * @brief Clears the samples of all channels kept from previous blocks
+ *
+ * @param [in,out] correlator    correlator object
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_correlator_reset_r(ifx_Correlator_R_t* correlator);
+
+/**
+ * @brief Destroys a streaming correlation
+ *
+ * @param [in]     correlator    correlator object
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_correlator_destroy_r(ifx_Correlator_R_t* correlator);
+
 /**
  * @brief Generates a gaussian pulse vector.
  * Uses pulse configuration parameters \f$b_w\f$ (pulse bandwidth) and \f$f_c\f$(center frequency)
@@ -376,6 +566,73 @@ ifx_Hilbert_R_t* ifx_signal_hilbert_create_r(uint32_t hilbert_order, uint32_t si
 IFX_DLL_PUBLIC
 void ifx_signal_hilbert_destroy_r(ifx_Hilbert_R_t* hilbert_object);
 
+/**
+ * @brief Creates a streaming hilbert transform
+ *
+ * Unlike \ref ifx_signal_hilbert_run_c, which transforms each vector on
+ * its own and pads it with zeros, the stream treats consecutive calls of
+ * \ref ifx_signal_hilbert_stream_run_c as one continuous signal, e.g. the
+ * slow-time samples of successive frames. The filter is the one of
+ * \ref ifx_signal_hilbert_create_r for the same order (length
+ * 4*hilbert_order-1). As the filter is not causal, the output is delayed by
+ * \ref ifx_signal_hilbert_stream_get_delay samples.
+ *
+ * The direct computation uses that every second tap is zero and the others
+ * are antisymmetric, i.e. hilbert_order multiply-adds per sample. With
+ * use_fft the filter is applied with FFTs (overlap-save) instead, which is
+ * faster for large orders if the blocks are at least a few times the
+ * filter length.
+ *
+ * @param [in]     hilbert_order    order of the filter, 1 to 50 for the direct computation,
+ *                                  up to 8192 with use_fft
+ * @param [in]     use_fft          apply the filter with FFTs
+ *
+ * @return Handle to the newly created stream or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Hilbert_Stream_R_t* ifx_signal_hilbert_stream_create_r(uint32_t hilbert_order, bool use_fft);
+
+/**
+ * @brief Computes the analytical signal of the next block of samples
+ *
+ * Output sample n is the analytical signal at input sample n-delay, where
+ * samples before the first block (or the last reset) are 0. The blocks may
+ * have any length.
+ *
+ * @param [in,out] stream    streaming hilbert transform
+ * @param [in]     input     next samples of the signal
+ * @param [out]    output    analytical signal, same length as input
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_hilbert_stream_run_c(ifx_Hilbert_Stream_R_t* stream,
+                                     const ifx_Vector_R_t* input,
+                                     ifx_Vector_C_t* output);
+
+/**
+ * @brief Returns the delay of the output of a streaming hilbert transform
+ *
+ * @param [in]     stream    streaming hilbert transform
+ * @return delay in samples (2*hilbert_order-1)
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_signal_hilbert_stream_get_delay(const ifx_Hilbert_Stream_R_t* stream);
+
+/**
+ * @brief Clears the samples kept from previous blocks
+ *
+ * @param [in,out] stream    streaming hilbert transform
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_hilbert_stream_reset_r(ifx_Hilbert_Stream_R_t* stream);
+
+/**
+ * @brief Destroys a streaming hilbert transform
+ *
+ * @param [in]     stream    streaming hilbert transform
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_hilbert_stream_destroy_r(ifx_Hilbert_Stream_R_t* stream);
+
 /**
  * @brief computes Mean Absolute Error for complex vectors.
  * mean absolute error (MAE) is a measure of errors between paired observations expressing
@@ -505,7 +762,11 @@ void ifx_signal_butterworth_highpass(uint32_t order, ifx_Float_t sampling_freque
  *
  * On cornels of input vector median windows is decreased to median_size/2.
  *
- * Number of input vector must be same as output.
+ * The window slides over the input with a running median, so the filter costs
+ * O(len * log(win_size)).
+ *
+ * Number of input vector must be same as output. input and output may point
+ * to the same vector.
  * @param [in]  input        data before filtration
  * @param [out] output       data after filtration
  * @param [in]  win_size  the window size of computed median (from how many elements one element is computed from)
@@ -513,6 +774,64 @@ void ifx_signal_butterworth_highpass(uint32_t order, ifx_Float_t sampling_freque
 IFX_DLL_PUBLIC
 void ifx_signal_filter_median(const ifx_Vector_R_t* input, ifx_Vector_R_t* output, uint32_t win_size);
 
+/**
+ * @brief Computes median filter on each row of input matrix and stores on output matrix
+ *
+ * Each row is filtered independently as in \ref ifx_signal_filter_median,
+ * e.g. all range profiles of a frame.
+ *
+ * Dimensions of input matrix must be same as output. input and output may
+ * point to the same matrix.
+ * @param [in]  input        data before filtration
+ * @param [out] output       data after filtration
+ * @param [in]  win_size     the window size of computed median
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_filter_median_mat(const ifx_Matrix_R_t* input, ifx_Matrix_R_t* output, uint32_t win_size);
+
+/**
+ * @brief Creates a streaming median filter
+ *
+ * Unlike \ref ifx_signal_filter_median the streaming filter is causal and
+ * keeps its window across calls of \ref ifx_signal_median_run_r: each output
+ * sample is the median of the last win_size input samples, including samples
+ * of previous calls. Until win_size samples have been seen, the median of all
+ * samples seen is returned.
+ *
+ * @param [in]  win_size     number of samples in the window
+ * @return Handle to the newly created median filter or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Median_R_t* ifx_signal_median_create_r(uint32_t win_size);
+
+/**
+ * @brief Runs the streaming median filter on the next block of samples
+ *
+ * input and output may point to the same vector.
+ *
+ * @param [in,out] median     streaming median filter
+ * @param [in]     input      next input samples
+ * @param [out]    output     output samples (same length as input)
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_median_run_r(ifx_Median_R_t* median, const ifx_Vector_R_t* input, ifx_Vector_R_t* output);
+
+/**
+ * @brief Empties the window of the streaming median filter
+ *
+ * @param [in,out] median     streaming median filter
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_median_reset_r(ifx_Median_R_t* median);
+
+/**
+ * @brief Destroys the streaming median filter
+ *
+ * @param [in] median     streaming median filter
+ */
+IFX_DLL_PUBLIC
+void ifx_signal_median_destroy_r(ifx_Median_R_t* median);
+
 /**
  * @}
  */
@@ -0,0 +1,286 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/SlowTimeBuffer.h"
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+
+#include <string.h>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines the structure for the slow time buffer.
+ *        Use type ifx_Slow_Time_Buffer_t for this struct.
+ */
+struct ifx_Slow_Time_Buffer_s
+{
+    bool is_complex;     /**< Elements are ifx_Complex_t instead of ifx_Float_t. */
+    size_t element_size; /**< Size of an element in bytes. */
+    uint32_t frame_size; /**< Number of elements of a frame. */
+    uint32_t depth;      /**< Number of frames kept. */
+    uint32_t head;       /**< Row the next frame is written to, less than depth. */
+    uint32_t num_frames; /**< Number of frames pushed, at most depth. */
+    uint8_t* data;       /**< 2*depth rows, row r and r+depth hold the same frame. */
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static ifx_Slow_Time_Buffer_t* slow_time_buffer_create(uint32_t frame_size, uint32_t depth, bool is_complex);
+
+static uint8_t* slow_time_buffer_row(const ifx_Slow_Time_Buffer_t* buffer, uint32_t row);
+
+static void slow_time_buffer_contiguous_stride(uint32_t dimensions, const uint32_t* shape, size_t* stride);
+
+static void slow_time_buffer_advance(ifx_Slow_Time_Buffer_t* buffer);
+
+static uint32_t slow_time_buffer_window_start(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static ifx_Slow_Time_Buffer_t* slow_time_buffer_create(uint32_t frame_size, uint32_t depth, bool is_complex)
+{
+    IFX_ERR_BRN_ARGUMENT(frame_size == 0 || depth == 0)
+
+    ifx_Slow_Time_Buffer_t* buffer = ifx_mem_alloc(sizeof(struct ifx_Slow_Time_Buffer_s));
+    IFX_ERR_BRN_MEMALLOC(buffer);
+
+    buffer->is_complex = is_complex;
+    buffer->element_size = is_complex ? sizeof(ifx_Complex_t) : sizeof(ifx_Float_t);
+    buffer->frame_size = frame_size;
+    buffer->depth = depth;
+    buffer->head = 0;
+    buffer->num_frames = 0;
+    buffer->data = ifx_mem_calloc((size_t)2 * depth * frame_size, buffer->element_size);
+
+    if (buffer->data == NULL)
+    {
+        ifx_slow_time_buffer_destroy(buffer);
+        return NULL;
+    }
+
+    return buffer;
+}
+
+//----------------------------------------------------------------------------
+
+static uint8_t* slow_time_buffer_row(const ifx_Slow_Time_Buffer_t* buffer, uint32_t row)
+{
+    return buffer->data + (size_t)row * buffer->frame_size * buffer->element_size;
+}
+
+//----------------------------------------------------------------------------
+
+static void slow_time_buffer_contiguous_stride(uint32_t dimensions, const uint32_t* shape, size_t* stride)
+{
+    size_t elements = 1;
+    for (uint32_t d = dimensions; d-- > 0;)
+    {
+        stride[d] = elements;
+        elements *= shape[d];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void slow_time_buffer_advance(ifx_Slow_Time_Buffer_t* buffer)
+{
+    // the mirror keeps every window contiguous
+    const size_t row_size = (size_t)buffer->frame_size * buffer->element_size;
+    memcpy(slow_time_buffer_row(buffer, buffer->head + buffer->depth), slow_time_buffer_row(buffer, buffer->head), row_size);
+
+    buffer->head = (buffer->head + 1 == buffer->depth) ? 0 : buffer->head + 1;
+    if (buffer->num_frames < buffer->depth)
+    {
+        buffer->num_frames++;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t slow_time_buffer_window_start(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip)
+{
+    // The newest frame is in row head - 1 and head - 1 + depth, the window
+    // ends with it or skip frames before it. Its rows are all in [head, head + depth).
+    return buffer->head + buffer->depth - skip - num_frames;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Slow_Time_Buffer_t* ifx_slow_time_buffer_create_r(uint32_t frame_size, uint32_t depth)
+{
+    return slow_time_buffer_create(frame_size, depth, false);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Slow_Time_Buffer_t* ifx_slow_time_buffer_create_c(uint32_t frame_size, uint32_t depth)
+{
+    return slow_time_buffer_create(frame_size, depth, true);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_destroy(ifx_Slow_Time_Buffer_t* buffer)
+{
+    if (buffer == NULL)
+    {
+        return;
+    }
+
+    ifx_mem_free(buffer->data);
+    ifx_mem_free(buffer);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_clear(ifx_Slow_Time_Buffer_t* buffer)
+{
+    IFX_ERR_BRK_NULL(buffer);
+
+    memset(buffer->data, 0, (size_t)2 * buffer->depth * buffer->frame_size * buffer->element_size);
+    buffer->head = 0;
+    buffer->num_frames = 0;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_push_r(ifx_Slow_Time_Buffer_t* buffer, const ifx_Mda_R_t* frame)
+{
+    IFX_ERR_BRK_NULL(buffer);
+    IFX_ERR_BRK_NULL(frame);
+    IFX_ERR_BRK_ARGUMENT(buffer->is_complex);
+    IFX_ERR_BRK_COND(ifx_mda_elements_r(frame) != buffer->frame_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    // the frame is copied in row-major order into the row, whatever its strides
+    size_t stride[IFX_MDA_MAX_DIM];
+    slow_time_buffer_contiguous_stride(IFX_MDA_DIMENSIONS(frame), IFX_MDA_SHAPE(frame), stride);
+
+    ifx_Mda_R_t row;
+    ifx_mda_rawview_r(&row, (ifx_Float_t*)slow_time_buffer_row(buffer, buffer->head), IFX_MDA_DIMENSIONS(frame),
+                      IFX_MDA_SHAPE(frame), stride, 0);
+    ifx_mda_copy_r(frame, &row);
+
+    slow_time_buffer_advance(buffer);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_push_c(ifx_Slow_Time_Buffer_t* buffer, const ifx_Mda_C_t* frame)
+{
+    IFX_ERR_BRK_NULL(buffer);
+    IFX_ERR_BRK_NULL(frame);
+    IFX_ERR_BRK_ARGUMENT(!buffer->is_complex);
+    IFX_ERR_BRK_COND(ifx_mda_elements_c(frame) != buffer->frame_size, IFX_ERROR_DIMENSION_MISMATCH);
+
+    size_t stride[IFX_MDA_MAX_DIM];
+    slow_time_buffer_contiguous_stride(IFX_MDA_DIMENSIONS(frame), IFX_MDA_SHAPE(frame), stride);
+
+    ifx_Mda_C_t row;
+    ifx_mda_rawview_c(&row, (ifx_Complex_t*)slow_time_buffer_row(buffer, buffer->head), IFX_MDA_DIMENSIONS(frame),
+                      IFX_MDA_SHAPE(frame), stride, 0);
+    ifx_mda_copy_c(frame, &row);
+
+    slow_time_buffer_advance(buffer);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_slow_time_buffer_get_num_frames(const ifx_Slow_Time_Buffer_t* buffer)
+{
+    IFX_ERR_BRV_NULL(buffer, 0);
+
+    return buffer->num_frames;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_get_window_r(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip,
+                                       ifx_Matrix_R_t* window)
+{
+    IFX_ERR_BRK_NULL(buffer);
+    IFX_ERR_BRK_NULL(window);
+    IFX_ERR_BRK_ARGUMENT(buffer->is_complex);
+    IFX_ERR_BRK_COND(num_frames == 0 || (uint64_t)num_frames + skip > buffer->depth, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    const uint32_t start = slow_time_buffer_window_start(buffer, num_frames, skip);
+    ifx_mat_rawview_r(window, (ifx_Float_t*)slow_time_buffer_row(buffer, start), num_frames, buffer->frame_size,
+                      buffer->frame_size);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_slow_time_buffer_get_window_c(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip,
+                                       ifx_Matrix_C_t* window)
+{
+    IFX_ERR_BRK_NULL(buffer);
+    IFX_ERR_BRK_NULL(window);
+    IFX_ERR_BRK_ARGUMENT(!buffer->is_complex);
+    IFX_ERR_BRK_COND(num_frames == 0 || (uint64_t)num_frames + skip > buffer->depth, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    const uint32_t start = slow_time_buffer_window_start(buffer, num_frames, skip);
+    ifx_mat_rawview_c(window, (ifx_Complex_t*)slow_time_buffer_row(buffer, start), num_frames, buffer->frame_size,
+                      buffer->frame_size);
+}
@@ -0,0 +1,234 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file SlowTimeBuffer.h
+ *
+ * \brief \copybrief gr_slowtimebuffer
+ *
+ * For details refer to \ref gr_slowtimebuffer
+ */
+
+#ifndef IFX_ALGO_SLOW_TIME_BUFFER_H
+#define IFX_ALGO_SLOW_TIME_BUFFER_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mda.h"
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for a slow time buffer, see SlowTimeBuffer.h.
+ */
+typedef struct ifx_Slow_Time_Buffer_s ifx_Slow_Time_Buffer_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Algorithms
+ * @{
+ */
+
+/** @defgroup gr_slowtimebuffer Slow Time Buffer
+ * @brief API for the history of the last frames along slow time.
+ *
+ * Vital sign, gesture and micro-Doppler processing work on the last frames
+ * of selected range bins. A slow time buffer keeps the last depth frames of
+ * frame_size values each, e.g. the range spectrum of selected range bins or
+ * a whole cube, and returns any window of consecutive frames as a matrix view
+ * with one row per frame, oldest first. The view refers to the memory of the
+ * buffer, no data is copied.
+ *
+ * Every frame is stored twice, depth rows apart, in memory for 2*depth
+ * frames. This keeps every window contiguous: pushing a frame copies it
+ * twice, independent of depth, and nothing is shifted.
+ *
+ * A frame is pushed as a multi-dimensional array of frame_size elements in
+ * any shape; views are supported, so selected range bins are pushed as a
+ * view of the range spectrum. The elements are stored in row-major order.
+ *
+ * Here is an example keeping 10 seconds of range bins 4 to 11 at 20 frames
+ * per second:
+ * @code
+ *      ifx_Slow_Time_Buffer_t* history = ifx_slow_time_buffer_create_c(8, 200);
+ *      // per frame, with the range spectrum range_fft of one chirp
+ *      ifx_Matrix_C_t bins;
+ *      ifx_mat_view_c(&bins, range_fft, 0, 4, 1, 8);
+ *      ifx_slow_time_buffer_push_c(history, &bins);
+ *
+ *      ifx_Matrix_C_t window;  // the last 64 frames as 64 x 8 matrix
+ *      ifx_slow_time_buffer_get_window_c(history, 64, 0, &window);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a slow time buffer of real values.
+ *
+ * @param [in]     frame_size    Number of values of each frame.
+ * @param [in]     depth         Number of frames kept.
+ *
+ * @return Pointer to the buffer or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Slow_Time_Buffer_t* ifx_slow_time_buffer_create_r(uint32_t frame_size, uint32_t depth);
+
+/**
+ * @brief Creates a slow time buffer of complex values.
+ *
+ * @param [in]     frame_size    Number of values of each frame.
+ * @param [in]     depth         Number of frames kept.
+ *
+ * @return Pointer to the buffer or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Slow_Time_Buffer_t* ifx_slow_time_buffer_create_c(uint32_t frame_size, uint32_t depth);
+
+/**
+ * @brief Destroys the slow time buffer.
+ *
+ * Views returned by the buffer must not be used afterwards.
+ *
+ * @param [in,out] buffer        Pointer to the buffer.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_destroy(ifx_Slow_Time_Buffer_t* buffer);
+
+/**
+ * @brief Removes all frames from the buffer.
+ *
+ * @param [in,out] buffer        Pointer to the buffer.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_clear(ifx_Slow_Time_Buffer_t* buffer);
+
+/**
+ * @brief Appends a frame to a real buffer, dropping the oldest one if the
+ *        buffer is full.
+ *
+ * @param [in,out] buffer        Pointer to the buffer.
+ * @param [in]     frame         Array of frame_size elements, may be a view.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_push_r(ifx_Slow_Time_Buffer_t* buffer, const ifx_Mda_R_t* frame);
+
+/**
+ * @brief Appends a frame to a complex buffer, dropping the oldest one if the
+ *        buffer is full.
+ *
+ * @param [in,out] buffer        Pointer to the buffer.
+ * @param [in]     frame         Array of frame_size elements, may be a view.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_push_c(ifx_Slow_Time_Buffer_t* buffer, const ifx_Mda_C_t* frame);
+
+/**
+ * @brief Returns the number of frames in the buffer, at most depth.
+ *
+ * @param [in]     buffer        Pointer to the buffer.
+ *
+ * @return Number of frames.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_slow_time_buffer_get_num_frames(const ifx_Slow_Time_Buffer_t* buffer);
+
+/**
+ * @brief Returns a window of consecutive frames of a real buffer.
+ *
+ * The view has num_frames rows of frame_size values, the oldest frame first.
+ * The view refers to the memory of the buffer: its rows keep their frames
+ * until depth - num_frames - skip further frames are pushed, then the oldest
+ * rows are overwritten. Rows of frames not pushed yet are zero.
+ *
+ * @param [in]     buffer        Pointer to the buffer.
+ * @param [in]     num_frames    Number of frames of the window.
+ * @param [in]     skip          Number of newest frames excluded from the
+ *                               window, 0 for a window ending with the newest
+ *                               frame.
+ * @param [out]    window        View of the window.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_get_window_r(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip,
+                                       ifx_Matrix_R_t* window);
+
+/**
+ * @brief Returns a window of consecutive frames of a complex buffer.
+ *
+ * See \ref ifx_slow_time_buffer_get_window_r.
+ *
+ * @param [in]     buffer        Pointer to the buffer.
+ * @param [in]     num_frames    Number of frames of the window.
+ * @param [in]     skip          Number of newest frames excluded from the window.
+ * @param [out]    window        View of the window.
+ */
+IFX_DLL_PUBLIC
+void ifx_slow_time_buffer_get_window_c(const ifx_Slow_Time_Buffer_t* buffer, uint32_t num_frames, uint32_t skip,
+                                       ifx_Matrix_C_t* window);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_ALGO_SLOW_TIME_BUFFER_H */
@@ -33,11 +33,18 @@
 ==============================================================================
 */
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "ifxAlgo/Window.h"
 
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
 /*
@@ -46,18 +53,53 @@
 ==============================================================================
 */
 
+// Lock protecting the window cache
+#if defined(_WIN32)
+#define CACHE_LOCK()   AcquireSRWLockExclusive(&cache_lock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&cache_lock)
+#else
+#define CACHE_LOCK()   pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#endif
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+/**
+ * @brief Window in the window cache.
+ *
+ * The coefficients are shared by all users of the same configuration and
+ * stay in the cache after the last user released them.
+ */
+typedef struct ifx_Window_Entry_s
+{
+    ifx_Window_Type_t type;           /**< Type of the window.*/
+    uint32_t size;                    /**< Number of coefficients.*/
+    ifx_Float_t at_dB;                /**< Attenuation, only used by Chebyshev windows.*/
+    ifx_Float_t scale;                /**< Scale factor applied to the coefficients.*/
+    bool normalized;                  /**< True if the coefficients are normalized to a sum of 1 before scaling.*/
+    ifx_Vector_R_t* window;           /**< Window coefficients.*/
+    uint32_t users;                   /**< Number of users of the coefficients.*/
+    struct ifx_Window_Entry_s* next;  /**< Next window in the cache.*/
+} ifx_Window_Entry_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
 ==============================================================================
 */
 
+#if defined(_WIN32)
+static SRWLOCK cache_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static ifx_Window_Entry_t* window_cache = NULL;
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
@@ -122,6 +164,22 @@ static void init_chebyshev(ifx_Vector_R_t* win,
  */
 static void init_blackman(ifx_Vector_R_t* win);
 
+/**
+ * @brief Creates the coefficients of a window.
+ *
+ * Same as \ref ifx_window_init, but the coefficients are normalized to a sum
+ * of 1 if normalized is true and multiplied by scale afterwards.
+ *
+ * @param [in]     config    Window configuration.
+ * @param [in]     scale     Scale factor, 1 for none.
+ * @param [in]     normalized  Normalize the coefficients before scaling.
+ *
+ * @return Vector with the coefficients or NULL in case of failure.
+ */
+static ifx_Vector_R_t* create_window(const ifx_Window_Config_t* config,
+                                     ifx_Float_t scale,
+                                     bool normalized);
+
 /**
  * @brief Computes acos(1-x) for 0<=x<=2
  *
@@ -400,6 +458,33 @@ static void init_chebyshev(ifx_Vector_R_t* win,
     ifx_vec_scale_r(win, 1 / max_val, win);
 }
 
+//----------------------------------------------------------------------------
+
+static ifx_Vector_R_t* create_window(const ifx_Window_Config_t* config,
+                                     ifx_Float_t scale,
+                                     bool normalized)
+{
+    ifx_Vector_R_t* win = ifx_vec_create_r(config->size);
+    if (win == NULL)
+        return NULL;
+
+    ifx_window_init(config, win);
+
+    if (normalized)
+    {
+        const ifx_Float_t sum = ifx_vec_sum_r(win);
+
+        ifx_vec_scale_r(win, 1.0f / sum, win);
+    }
+
+    if (scale != 1)
+    {
+        ifx_vec_scale_r(win, scale, win);
+    }
+
+    return win;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -439,3 +524,98 @@ void ifx_window_init(const ifx_Window_Config_t* config,
             break;
     }
 }
+
+//----------------------------------------------------------------------------
+
+const ifx_Vector_R_t* ifx_window_acquire(const ifx_Window_Config_t* config,
+                                         bool normalized)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->size == 0);
+    IFX_ERR_BRN_ARGUMENT(config->type > IFX_WINDOW_BLACKMAN);
+
+    // a scale of 0 means no scaling, like in ifx_ppfft_create
+    const ifx_Float_t scale = (config->scale == 0) ? 1 : config->scale;
+    const ifx_Float_t at_dB = (config->type == IFX_WINDOW_CHEBYSHEV) ? config->at_dB : 0;
+
+    CACHE_LOCK();
+    for (ifx_Window_Entry_t* entry = window_cache; entry != NULL; entry = entry->next)
+    {
+        if (entry->type == config->type && entry->size == config->size && entry->at_dB == at_dB
+            && entry->scale == scale && entry->normalized == normalized)
+        {
+            entry->users++;
+            CACHE_UNLOCK();
+            return entry->window;
+        }
+    }
+
+    ifx_Window_Entry_t* entry = ifx_mem_calloc(1, sizeof(ifx_Window_Entry_t));
+    if (entry != NULL)
+    {
+        entry->window = create_window(config, scale, normalized);
+        if (entry->window == NULL)
+        {
+            ifx_mem_free(entry);
+            entry = NULL;
+        }
+    }
+
+    if (entry != NULL)
+    {
+        entry->type = config->type;
+        entry->size = config->size;
+        entry->at_dB = at_dB;
+        entry->scale = scale;
+        entry->normalized = normalized;
+        entry->users = 1;
+        entry->next = window_cache;
+        window_cache = entry;
+    }
+    CACHE_UNLOCK();
+
+    IFX_ERR_BRN_MEMALLOC(entry);
+
+    return entry->window;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_window_release(const ifx_Vector_R_t* window)
+{
+    if (window == NULL)
+        return;
+
+    CACHE_LOCK();
+    for (ifx_Window_Entry_t* entry = window_cache; entry != NULL; entry = entry->next)
+    {
+        if (entry->window == window)
+        {
+            if (entry->users > 0)
+                entry->users--;
+            break;
+        }
+    }
+    CACHE_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_window_clear_cache(void)
+{
+    CACHE_LOCK();
+    ifx_Window_Entry_t** link = &window_cache;
+    while (*link != NULL)
+    {
+        ifx_Window_Entry_t* entry = *link;
+        if (entry->users == 0)
+        {
+            *link = entry->next;
+            ifx_vec_destroy_r(entry->window);
+            ifx_mem_free(entry);
+        }
+        else
+            link = &entry->next;
+    }
+    CACHE_UNLOCK();
+}
@@ -131,6 +131,45 @@ IFX_DLL_PUBLIC
 void ifx_window_init(const ifx_Window_Config_t* config,
                      ifx_Vector_R_t* win);
 
+/**
+ * @brief Returns shared window coefficients from the window cache.
+ *
+ * The coefficients are computed as by \ref ifx_window_init, normalized to a
+ * sum of 1 if normalized is true, and then multiplied by the scale of the
+ * configuration (a scale of 0 means no scaling). All users of the same
+ * configuration share one vector, so the coefficients are computed only once
+ * and must not be modified. Release the vector with \ref ifx_window_release.
+ *
+ * This function is thread-safe.
+ *
+ * @param [in]     config    \ref ifx_Window_Config_t "Window configuration structure".
+ * @param [in]     normalized  Normalize the coefficients to a sum of 1 before scaling.
+ *
+ * @return Shared window coefficients or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+const ifx_Vector_R_t* ifx_window_acquire(const ifx_Window_Config_t* config,
+                                         bool normalized);
+
+/**
+ * @brief Releases window coefficients returned by \ref ifx_window_acquire.
+ *
+ * @param [in]     window    Window coefficients, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_window_release(const ifx_Vector_R_t* window);
+
+/**
+ * @brief Frees all cached windows no longer acquired
+ *
+ * Released windows stay in a cache so that acquiring the same configuration
+ * again, e.g. when switching back to a previous device configuration, does
+ * not compute the coefficients again. This function releases the memory of
+ * these windows.
+ */
+IFX_DLL_PUBLIC
+void ifx_window_clear_cache(void);
+
 /**
  * @}
  */
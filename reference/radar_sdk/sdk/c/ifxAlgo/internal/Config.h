@@ -0,0 +1,82 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_ALGO_CONFIG_INTERNAL_H
+#define IFX_ALGO_CONFIG_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdbool.h>
+
+#include "ifxAlgo/PreprocessedFFT.h"
+#include "ifxAlgo/Window.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Returns true if two window configurations give the same coefficients.
+ *
+ * Compares field by field as configurations may contain uninitialized padding.
+ */
+static inline bool ifx_window_config_equal(const ifx_Window_Config_t* lhs, const ifx_Window_Config_t* rhs)
+{
+    return lhs->type == rhs->type && lhs->size == rhs->size && lhs->at_dB == rhs->at_dB && lhs->scale == rhs->scale;
+}
+
+/**
+ * @brief Returns true if two pre-processed FFT configurations are equal.
+ */
+static inline bool ifx_ppfft_config_equal(const ifx_PPFFT_Config_t* lhs, const ifx_PPFFT_Config_t* rhs)
+{
+    return lhs->fft_type == rhs->fft_type && lhs->fft_size == rhs->fft_size
+           && !lhs->mean_removal_enabled == !rhs->mean_removal_enabled
+           && !lhs->is_normalized_window == !rhs->is_normalized_window
+           && ifx_window_config_equal(&lhs->window_config, &rhs->window_config);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IFX_ALGO_CONFIG_INTERNAL_H
@@ -0,0 +1,72 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_ALGO_FFT_BACKEND_H
+#define IFX_ALGO_FFT_BACKEND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "ifxAlgo/FFT.h"
+
+#include "ifxBase/Types.h"
+
+/**
+ * @brief Operations of an FFT library used by the FFT module.
+ *
+ * A plan computes forward FFTs of one type and size. Input and output arrays
+ * passed to execute_rc and execute_c are aligned to the alignment of the
+ * backend and have unit stride. For execute_rc the output has room for
+ * fft_size/2+1 elements and the backend writes exactly these; for execute_c
+ * the output has fft_size elements.
+ *
+ * If shared is true, a plan may be executed from several threads at the same
+ * time and the plan cache hands it to every handle of the same type and size.
+ * Otherwise every handle gets a plan of its own (for example muFFT plans
+ * contain a scratch buffer).
+ */
+typedef struct
+{
+    const char* name;  /**< Name of the backend as returned by ifx_fft_get_backend_name.*/
+    size_t alignment;  /**< Required alignment of input and output arrays in bytes.*/
+    bool shared;       /**< True if plans can be executed concurrently.*/
+
+    void* (*create_plan)(ifx_FFT_Type_t fft_type, uint32_t fft_size);
+    void (*destroy_plan)(void* plan);
+    void (*execute_rc)(void* plan, const ifx_Float_t* in, ifx_Complex_t* out);
+    void (*execute_c)(void* plan, const ifx_Complex_t* in, ifx_Complex_t* out);
+} ifx_FFT_Backend_Ops_t;
+
+extern const ifx_FFT_Backend_Ops_t ifx_fft_backend_mufft;
+
+#ifdef IFX_FFT_FFTW
+extern const ifx_FFT_Backend_Ops_t ifx_fft_backend_fftw;
+#endif
+
+#endif  // IFX_ALGO_FFT_BACKEND_H
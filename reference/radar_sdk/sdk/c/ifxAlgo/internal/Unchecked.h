@@ -0,0 +1,89 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Unchecked.h
+ *
+ * @brief Variants of FFT entry points without argument validation.
+ *
+ * Composite modules that call an FFT once per row validate their arguments
+ * once at the top and then use these functions in the loop. The caller
+ * guarantees everything the checked function would verify: the handle is
+ * not NULL and has the matching FFT type, input and output are valid
+ * vectors and output has at least fft_size/2 (R2C) or fft_size (C2C)
+ * elements. For the pre-processed FFT the input in addition has at least as
+ * many elements as the window.
+ */
+
+#ifndef IFX_ALGO_UNCHECKED_INTERNAL_H
+#define IFX_ALGO_UNCHECKED_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/FFT.h"
+#include "ifxAlgo/PreprocessedFFT.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @brief \ref ifx_fft_run_rc without argument checks. */
+IFX_DLL_PUBLIC
+void ifx_fft_run_rc_unchecked(ifx_FFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C_t* output);
+
+/** @brief \ref ifx_fft_run_c without argument checks. */
+IFX_DLL_PUBLIC
+void ifx_fft_run_c_unchecked(ifx_FFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_t* output);
+
+/** @brief \ref ifx_ppfft_run_rc without argument checks. */
+IFX_DLL_PUBLIC
+void ifx_ppfft_run_rc_unchecked(ifx_PPFFT_t* handle, const ifx_Vector_R_t* input, ifx_Vector_C_t* output);
+
+/** @brief \ref ifx_ppfft_run_c without argument checks. */
+IFX_DLL_PUBLIC
+void ifx_ppfft_run_c_unchecked(ifx_PPFFT_t* handle, const ifx_Vector_C_t* input, ifx_Vector_C_t* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IFX_ALGO_UNCHECKED_INTERNAL_H
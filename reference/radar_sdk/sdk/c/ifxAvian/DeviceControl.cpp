@@ -106,6 +106,13 @@ ifx_List_t* ifx_avian_get_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type)
 
 //----------------------------------------------------------------------------
 
+size_t ifx_avian_get_sensor_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type, ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    return ifx_fmcw_get_sensor_list_by_sensor_type(sensor_type, entries, count);
+}
+
+//----------------------------------------------------------------------------
+
 ifx_List_t* ifx_avian_get_list()
 {
     return ifx_fmcw_get_list();
@@ -113,6 +120,13 @@ ifx_List_t* ifx_avian_get_list()
 
 //----------------------------------------------------------------------------
 
+size_t ifx_avian_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    return ifx_fmcw_get_sensor_list(entries, count);
+}
+
+//----------------------------------------------------------------------------
+
 ifx_Avian_Device_t* ifx_avian_create_by_port(const char* port)
 {
     return ifx_fmcw_create_by_port(port);
@@ -506,26 +520,37 @@ ifx_Cube_R_t* ifx_avian_get_next_frame_timeout(ifx_Avian_Device_t* handle, ifx_C
 
     if (fmcwFrame->num_cubes == 1)
     {
-        // transfer ownership of pointer to caller
+        // the fmcw frame is a single block, so its cube cannot be handed to
+        // the caller; the data is copied instead
+        const auto* cube = fmcwFrame->cubes[0];
         if (!frame)
         {
-            // there was no frame given, we simply extract the pointer from fmcwFrame
-            frame = fmcwFrame->cubes[0];
-            fmcwFrame->cubes[0] = nullptr;
+            frame = ifx_cube_create_r(cube->shape[0], cube->shape[1], cube->shape[2]);
+            IFX_ERR_RETV(frame);
         }
-        else
+        else if (!IFX_MDA_DATA(frame) || ifx_mda_elements_r(frame) != ifx_mda_elements_r(cube))
         {
-            // there was a frame given, so if it contains data, free the memory
-            // then we can copy the mda structure to the given frame (which includes the pointer)
-            // (The pointer in the copied-from structure needs to be reset then)
+            // the given frame does not fit, so replace its data
+            auto* data = static_cast<ifx_Float_t*>(ifx_mem_aligned_alloc(ifx_mda_elements_r(cube) * sizeof(ifx_Float_t), IFX_MEMORY_ALIGNMENT));
+            IFX_ERR_BRV_MEMALLOC(data, frame);
             if (IFX_MDA_OWNS_DATA(frame))
             {
                 ifx_mem_aligned_free(IFX_MDA_DATA(frame));
             }
+            frame->data = data;
             IFX_MDA_FLAGS(frame) |= IFX_MDA_FLAG_OWNS_DATA;
-            *frame = *fmcwFrame->cubes[0];
-            fmcwFrame->cubes[0]->data = nullptr;
         }
+
+        frame->dimensions = 3;
+        for (uint32_t d = 0; d < 3; d++)
+        {
+            frame->shape[d] = cube->shape[d];
+        }
+        frame->stride[2] = 1;
+        frame->stride[1] = cube->shape[2];
+        frame->stride[0] = cube->shape[1] * cube->shape[2];
+
+        std::copy(cube->data, cube->data + ifx_mda_elements_r(cube), frame->data);
     }
     else
     {
@@ -109,6 +109,32 @@ typedef ifx_Device_Fmcw_t ifx_Avian_Device_t;
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_avian_get_list(void);
 
+/**
+ * \brief Fills a caller-provided array with the available Avian radar devices.
+ *
+ * The function is similar to \ref ifx_avian_get_list but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * \code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_avian_get_sensor_list(entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * \endcode
+ *
+ * \param [out] entries     array of at least count entries
+ * \param [in]  count       number of entries the array can hold
+ * \return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_avian_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * \brief This function returns a list of available specified devices.
  *
@@ -136,6 +162,33 @@ ifx_List_t* ifx_avian_get_list(void);
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_avian_get_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type);
 
+/**
+ * \brief Fills a caller-provided array with the available devices of a sensor type.
+ *
+ * The function is similar to \ref ifx_avian_get_list_by_sensor_type but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * \code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_avian_get_sensor_list_by_sensor_type(IFX_AVIAN_BGT60TR13C, entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * \endcode
+ *
+ * \param [in]  sensor_type The device type to search for.
+ * \param [out] entries     array of at least count entries
+ * \param [in]  count       number of entries the array can hold
+ * \return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_avian_get_sensor_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type, ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * @brief Creates a dummy device handle.
  *
@@ -50,6 +50,7 @@
 #include <ifxBase/Cube.h>
 #include <ifxBase/Defines.h>
 #include <ifxBase/Error.h>
+#include <ifxBase/Executor.h>
 #include <ifxBase/LA.h>
 #include <ifxBase/List.h>
 #include <ifxBase/Log.h>
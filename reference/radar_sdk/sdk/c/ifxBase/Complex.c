@@ -35,6 +35,7 @@
 
 #include "Complex.h"
 #include "Defines.h"
+#include "internal/ComplexInline.h"
 
 /*
 ==============================================================================
@@ -84,9 +85,7 @@ ifx_Float_t ifx_complex_abs(ifx_Complex_t z)
 
 ifx_Complex_t ifx_complex_conj(ifx_Complex_t z)
 {
-    ifx_Complex_t conj;
-    IFX_COMPLEX_SET(conj, IFX_COMPLEX_REAL(z), -IFX_COMPLEX_IMAG(z));
-    return conj;
+    return ifx_cconj(z);
 }
 
 //----------------------------------------------------------------------------
@@ -94,13 +93,7 @@ ifx_Complex_t ifx_complex_conj(ifx_Complex_t z)
 ifx_Complex_t ifx_complex_add(ifx_Complex_t a,
                               ifx_Complex_t b)
 {
-    ifx_Complex_t result = IFX_COMPLEX_DEF(1, -1);
-
-    IFX_COMPLEX_SET(result,
-                    IFX_COMPLEX_REAL(a) + IFX_COMPLEX_REAL(b),
-                    IFX_COMPLEX_IMAG(a) + IFX_COMPLEX_IMAG(b));
-
-    return result;
+    return ifx_cadd(a, b);
 }
 
 //----------------------------------------------------------------------------
@@ -108,12 +101,7 @@ ifx_Complex_t ifx_complex_add(ifx_Complex_t a,
 ifx_Complex_t ifx_complex_sub(ifx_Complex_t a,
                               ifx_Complex_t b)
 {
-    ifx_Complex_t result;
-    IFX_COMPLEX_SET(result,
-                    IFX_COMPLEX_REAL(a) - IFX_COMPLEX_REAL(b),
-                    IFX_COMPLEX_IMAG(a) - IFX_COMPLEX_IMAG(b));
-
-    return result;
+    return ifx_csub(a, b);
 }
 
 //----------------------------------------------------------------------------
@@ -121,17 +109,7 @@ ifx_Complex_t ifx_complex_sub(ifx_Complex_t a,
 ifx_Complex_t ifx_complex_mul(ifx_Complex_t a,
                               ifx_Complex_t b)
 {
-    ifx_Complex_t result;
-    ifx_Float_t ar = IFX_COMPLEX_REAL(a);
-    ifx_Float_t ai = IFX_COMPLEX_IMAG(a);
-    ifx_Float_t br = IFX_COMPLEX_REAL(b);
-    ifx_Float_t bi = IFX_COMPLEX_IMAG(b);
-
-    IFX_COMPLEX_SET(result,
-                    ar * br - ai * bi,
-                    ar * bi + ai * br);
-
-    return result;
+    return ifx_cmul(a, b);
 }
 
 //----------------------------------------------------------------------------
@@ -139,14 +117,14 @@ ifx_Complex_t ifx_complex_mul(ifx_Complex_t a,
 ifx_Complex_t ifx_complex_div(ifx_Complex_t a,
                               ifx_Complex_t b)
 {
-    const ifx_Complex_t conjb = ifx_complex_conj(b);
+    const ifx_Complex_t conjb = ifx_cconj(b);
 
     const ifx_Float_t r = IFX_COMPLEX_REAL(b);
     const ifx_Float_t i = IFX_COMPLEX_IMAG(b);
     const ifx_Float_t b_abs2 = r * r + i * i;  // |b|^2
 
     // a/b = (ab*) / (bb*) = (ab*)/(|b|^2)
-    return ifx_complex_div_real(ifx_complex_mul(a, conjb), b_abs2);
+    return ifx_complex_div_real(ifx_cmul(a, conjb), b_abs2);
 }
 
 //----------------------------------------------------------------------------
@@ -174,9 +152,7 @@ ifx_Complex_t ifx_complex_sub_real(ifx_Complex_t a,
 ifx_Complex_t ifx_complex_mul_real(ifx_Complex_t a,
                                    ifx_Float_t b)
 {
-    ifx_Complex_t result;
-    IFX_COMPLEX_SET(result, IFX_COMPLEX_REAL(a) * b, IFX_COMPLEX_IMAG(a) * b);
-    return result;
+    return ifx_cscale(a, b);
 }
 
 //----------------------------------------------------------------------------
@@ -261,10 +237,7 @@ ifx_Complex_t ifx_complex_square(ifx_Complex_t z)
 
 ifx_Float_t ifx_complex_sqnorm(ifx_Complex_t z)
 {
-    ifx_Float_t r = IFX_COMPLEX_REAL(z);
-    ifx_Float_t i = IFX_COMPLEX_IMAG(z);
-
-    return (r * r + i * i);
+    return ifx_cabs2(z);
 }
 
 //----------------------------------------------------------------------------
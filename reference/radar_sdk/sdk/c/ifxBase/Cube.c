@@ -40,10 +40,84 @@
 #include "Complex.h"
 #include "Cube.h"
 #include "Error.h"
+#include "internal/Kernels.h"
 #include "internal/Macros.h"
 #include "Matrix.h"
 #include "Mem.h"
 
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/* logical axes of a frame cube */
+enum
+{
+    AXIS_ANTENNA = 0,
+    AXIS_CHIRP = 1,
+    AXIS_SAMPLE = 2
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/* for each layout: the memory axis holding logical antenna, chirp and sample */
+static const uint32_t layout_permutation[][3] = {
+    [IFX_CUBE_LAYOUT_ANTENNA_MAJOR] = {0, 1, 2},
+    [IFX_CUBE_LAYOUT_CHIRP_MAJOR] = {1, 0, 2},
+    [IFX_CUBE_LAYOUT_SAMPLE_INTERLEAVED] = {2, 0, 1},
+};
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static const uint32_t* layout_axes(ifx_Cube_Layout_t layout);
+static bool stored_outside(const uint32_t* shape, const size_t* stride, uint32_t outer, uint32_t inner);
+static ifx_Cube_Layout_t layout_from_strides(const uint32_t* shape, const size_t* stride);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static const uint32_t* layout_axes(ifx_Cube_Layout_t layout)
+{
+    if ((unsigned)layout >= sizeof(layout_permutation) / sizeof(layout_permutation[0]))
+        return NULL;
+
+    return layout_permutation[layout];
+}
+
+//----------------------------------------------------------------------------
+
+static bool stored_outside(const uint32_t* shape, const size_t* stride, uint32_t outer, uint32_t inner)
+{
+    // an axis of length 1 can be placed anywhere
+    return shape[outer] <= 1 || shape[inner] <= 1 || stride[outer] >= stride[inner];
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Cube_Layout_t layout_from_strides(const uint32_t* shape, const size_t* stride)
+{
+    if (stored_outside(shape, stride, AXIS_ANTENNA, AXIS_CHIRP) && stored_outside(shape, stride, AXIS_CHIRP, AXIS_SAMPLE))
+        return IFX_CUBE_LAYOUT_ANTENNA_MAJOR;
+    if (stored_outside(shape, stride, AXIS_CHIRP, AXIS_ANTENNA) && stored_outside(shape, stride, AXIS_ANTENNA, AXIS_SAMPLE))
+        return IFX_CUBE_LAYOUT_CHIRP_MAJOR;
+    if (stored_outside(shape, stride, AXIS_CHIRP, AXIS_SAMPLE) && stored_outside(shape, stride, AXIS_SAMPLE, AXIS_ANTENNA))
+        return IFX_CUBE_LAYOUT_SAMPLE_INTERLEAVED;
+
+    return IFX_CUBE_LAYOUT_OTHER;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -182,6 +256,17 @@ void ifx_cube_col_abs_r(const ifx_Cube_C_t* cube,
     IFX_MAT_BRK_VALID(matrix);
     IFX_ERR_BRK_ARGUMENT(column_index >= cCols(cube));
 
+    // the slices of a column and the rows of the matrix are usually contiguous
+    if (cStride(cube, 2) == 1 && mStride(matrix, 1) == 1)
+    {
+        const ifx_Kernels_t* kernels = ifx_kernels_get();
+        for (uint32_t r = 0; r < cRows(cube); r++)
+        {
+            kernels->abs_c(&cAt(cube, r, column_index, 0), &mAt(matrix, r, 0), cSlices(cube));
+        }
+        return;
+    }
+
     for (uint32_t r = 0; r < cRows(cube); r++)
     {
         for (uint32_t c = 0; c < cSlices(cube); c++)
@@ -206,3 +291,49 @@ void ifx_cube_clear_c(ifx_Cube_C_t* cube)
     IFX_CUBE_BRK_VALID(cube);
     ifx_mda_clear_c(cube);
 }
+
+//----------------------------------------------------------------------------
+
+void ifx_cube_layout_view_r(const ifx_Cube_R_t* data, ifx_Cube_Layout_t layout, ifx_Cube_R_t* view)
+{
+    IFX_CUBE_BRK_VALID(data);
+    IFX_ERR_BRK_NULL(view);
+
+    const uint32_t* axes = layout_axes(layout);
+    IFX_ERR_BRK_ARGUMENT(axes == NULL);
+
+    ifx_mda_permute_r(view, data, 3, axes);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_cube_layout_view_c(const ifx_Cube_C_t* data, ifx_Cube_Layout_t layout, ifx_Cube_C_t* view)
+{
+    IFX_CUBE_BRK_VALID(data);
+    IFX_ERR_BRK_NULL(view);
+
+    const uint32_t* axes = layout_axes(layout);
+    IFX_ERR_BRK_ARGUMENT(axes == NULL);
+
+    ifx_mda_permute_c(view, data, 3, axes);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Cube_Layout_t ifx_cube_get_layout_r(const ifx_Cube_R_t* cube)
+{
+    IFX_ERR_BRV_NULL(cube, IFX_CUBE_LAYOUT_OTHER);
+    IFX_ERR_BRV_COND(IFX_MDA_DIMENSIONS(cube) != 3, IFX_ERROR_DIMENSION_MISMATCH, IFX_CUBE_LAYOUT_OTHER);
+
+    return layout_from_strides(IFX_MDA_SHAPE(cube), IFX_MDA_STRIDE(cube));
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Cube_Layout_t ifx_cube_get_layout_c(const ifx_Cube_C_t* cube)
+{
+    IFX_ERR_BRV_NULL(cube, IFX_CUBE_LAYOUT_OTHER);
+    IFX_ERR_BRV_COND(IFX_MDA_DIMENSIONS(cube) != 3, IFX_ERROR_DIMENSION_MISMATCH, IFX_CUBE_LAYOUT_OTHER);
+
+    return layout_from_strides(IFX_MDA_SHAPE(cube), IFX_MDA_STRIDE(cube));
+}
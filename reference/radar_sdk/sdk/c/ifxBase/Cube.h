@@ -70,20 +70,20 @@ extern "C"
 #define IFX_CUBE_SIZE(c)              (IFX_CUBE_SLICE_SIZE(c) * (size_t)IFX_CUBE_SLICES(c))
 #define IFX_CUBE_OFFSET(cub, r, c, s) IFX_MDA_OFFSET(cub, r, c, s)
 
-#define IFX_CUBE_BRK_VALID(c)                                                       \
-    do                                                                              \
-    {                                                                               \
-        IFX_ERR_BRK_NULL(c);                                                        \
-        IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(c) != 3, IFX_ERROR_DIMENSION_MISMATCH); \
-        IFX_ERR_BRK_ARGUMENT(IFX_MDA_DATA(c) == NULL);                              \
+#define IFX_CUBE_BRK_VALID(c)                                                           \
+    do                                                                                  \
+    {                                                                                   \
+        IFX_ERR_ARG_BRK_COND(!(c), IFX_ERROR_ARGUMENT_NULL);                            \
+        IFX_ERR_ARG_BRK_COND(IFX_MDA_DIMENSIONS(c) != 3, IFX_ERROR_DIMENSION_MISMATCH); \
+        IFX_ERR_ARG_BRK_COND(IFX_MDA_DATA(c) == NULL, IFX_ERROR_ARGUMENT_INVALID);      \
     } while (0)
 
-#define IFX_CUBE_BRV_VALID(c, r)                                                       \
-    do                                                                                 \
-    {                                                                                  \
-        IFX_ERR_BRV_NULL(c, r);                                                        \
-        IFX_ERR_BRV_COND(IFX_MDA_DIMENSIONS(c) != 3, IFX_ERROR_DIMENSION_MISMATCH, r); \
-        IFX_ERR_BRV_ARGUMENT(IFX_MDA_DATA(c) == NULL, r);                              \
+#define IFX_CUBE_BRV_VALID(c, r)                                                           \
+    do                                                                                     \
+    {                                                                                      \
+        IFX_ERR_ARG_BRV_COND(!(c), IFX_ERROR_ARGUMENT_NULL, r);                            \
+        IFX_ERR_ARG_BRV_COND(IFX_MDA_DIMENSIONS(c) != 3, IFX_ERROR_DIMENSION_MISMATCH, r); \
+        IFX_ERR_ARG_BRV_COND(IFX_MDA_DATA(c) == NULL, IFX_ERROR_ARGUMENT_INVALID, r);      \
     } while (0)
 
 /** @brief Access cube element
@@ -98,8 +98,8 @@ extern "C"
  */
 #define IFX_CUBE_AT(cub, r, c, s) IFX_MDA_AT(cub, r, c, s)
 
-#define IFX_CUBE_BRK_DIM(c1, c2)    IFX_ERR_BRK_COND((IFX_CUBE_ROWS(c1) != IFX_CUBE_ROWS(c2)) || (IFX_CUBE_COLS(c1) != IFX_CUBE_COLS(c2)) || (IFX_CUBE_SLICES(c1) != IFX_CUBE_SLICES(c2)), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_CUBE_BRV_DIM(c1, c2, a) IFX_ERR_BRV_COND((IFX_CUBE_ROWS(c1) != IFX_CUBE_ROWS(c2)) || (IFX_CUBE_COLS(c1) != IFX_CUBE_COLS(c2)) || (IFX_CUBE_SLICES(c1) != IFX_CUBE_SLICES(c2)), IFX_ERROR_DIMENSION_MISMATCH, a)
+#define IFX_CUBE_BRK_DIM(c1, c2)    IFX_ERR_ARG_BRK_COND((IFX_CUBE_ROWS(c1) != IFX_CUBE_ROWS(c2)) || (IFX_CUBE_COLS(c1) != IFX_CUBE_COLS(c2)) || (IFX_CUBE_SLICES(c1) != IFX_CUBE_SLICES(c2)), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_CUBE_BRV_DIM(c1, c2, a) IFX_ERR_ARG_BRV_COND((IFX_CUBE_ROWS(c1) != IFX_CUBE_ROWS(c2)) || (IFX_CUBE_COLS(c1) != IFX_CUBE_COLS(c2)) || (IFX_CUBE_SLICES(c1) != IFX_CUBE_SLICES(c2)), IFX_ERROR_DIMENSION_MISMATCH, a)
 
 
 /*
@@ -118,6 +118,32 @@ typedef ifx_Mda_R_t ifx_Cube_R_t;
  */
 typedef ifx_Mda_C_t ifx_Cube_C_t;
 
+/**
+ * @brief Real cube in half precision, created with \ref ifx_mda_create_h.
+ */
+typedef ifx_Mda_H_t ifx_Cube_H_t;
+
+/**
+ * @brief Complex cube in half precision, created with \ref ifx_mda_create_hc.
+ */
+typedef ifx_Mda_HC_t ifx_Cube_HC_t;
+
+/**
+ * @brief Memory layout of a radar data cube.
+ *
+ * Algorithms address frame cubes logically as [antenna][chirp][sample]. The
+ * layout describes the order in which these axes are stored in memory; a
+ * cube stored in any layout is presented in logical order by
+ * \ref ifx_cube_layout_view_r without copying.
+ */
+typedef enum
+{
+    IFX_CUBE_LAYOUT_ANTENNA_MAJOR = 0,      /**< [antenna][chirp][sample], as delivered by the devices */
+    IFX_CUBE_LAYOUT_CHIRP_MAJOR = 1,        /**< [chirp][antenna][sample], all antennas of one chirp together */
+    IFX_CUBE_LAYOUT_SAMPLE_INTERLEAVED = 2, /**< [chirp][sample][antenna], all antennas of one sample together */
+    IFX_CUBE_LAYOUT_OTHER = 3               /**< None of the above (only returned by \ref ifx_cube_get_layout_r) */
+} ifx_Cube_Layout_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -357,6 +383,62 @@ void ifx_cube_clear_r(ifx_Cube_R_t* cube);
 IFX_DLL_PUBLIC
 void ifx_cube_clear_c(ifx_Cube_C_t* cube);
 
+/**
+ * @brief Presents a real cube stored in the given layout in logical order.
+ *
+ * data has the shape of its layout in memory, e.g. [chirp][sample][antenna]
+ * for \ref IFX_CUBE_LAYOUT_SAMPLE_INTERLEAVED. On return view addresses the
+ * same memory as [antenna][chirp][sample] by reordering the strides; no data
+ * is copied. The view can be passed to the range-Doppler, MTI and beamforming
+ * functions, which all accept strided cubes.
+ *
+ * @param [in]     data      Cube in the given layout.
+ * @param [in]     layout    Memory layout of data.
+ * @param [out]    view      Logical view of data.
+ */
+IFX_DLL_PUBLIC
+void ifx_cube_layout_view_r(const ifx_Cube_R_t* data,
+                            ifx_Cube_Layout_t layout,
+                            ifx_Cube_R_t* view);
+
+/**
+ * @brief Presents a complex cube stored in the given layout in logical order.
+ *
+ * See \ref ifx_cube_layout_view_r.
+ *
+ * @param [in]     data      Cube in the given layout.
+ * @param [in]     layout    Memory layout of data.
+ * @param [out]    view      Logical view of data.
+ */
+IFX_DLL_PUBLIC
+void ifx_cube_layout_view_c(const ifx_Cube_C_t* data,
+                            ifx_Cube_Layout_t layout,
+                            ifx_Cube_C_t* view);
+
+/**
+ * @brief Returns the memory layout of a real cube in logical order.
+ *
+ * The layout is derived from the strides of cube, which is expected to be
+ * indexed as [antenna][chirp][sample]. Axes of length 1 are ignored.
+ *
+ * @param [in]     cube      Cube or view in logical order.
+ * @return Layout of cube, \ref IFX_CUBE_LAYOUT_OTHER if the strides match
+ *         none of the layouts.
+ */
+IFX_DLL_PUBLIC
+ifx_Cube_Layout_t ifx_cube_get_layout_r(const ifx_Cube_R_t* cube);
+
+/**
+ * @brief Returns the memory layout of a complex cube in logical order.
+ *
+ * See \ref ifx_cube_get_layout_r.
+ *
+ * @param [in]     cube      Cube or view in logical order.
+ * @return Layout of cube.
+ */
+IFX_DLL_PUBLIC
+ifx_Cube_Layout_t ifx_cube_get_layout_c(const ifx_Cube_C_t* cube);
+
 /**
  * @}
  */
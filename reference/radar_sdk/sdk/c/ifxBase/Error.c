@@ -134,6 +134,8 @@ const char* ifx_error_to_string(ifx_Error_t error)
             return "internal logic error (IFX_ERROR_INTERNAL)";
         case IFX_ERROR_NOT_POSSIBLE:
             return "not possible (IFX_ERROR_NOT_POSSIBLE)";
+        case IFX_ERROR_ABORTED:
+            return "request cancelled (IFX_ERROR_ABORTED)";
         case IFX_ERROR_NO_DEVICE:
             return "no compatible device found (IFX_ERROR_NO_DEVICE)";
         case IFX_ERROR_DEVICE_BUSY:
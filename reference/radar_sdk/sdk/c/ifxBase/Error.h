@@ -46,6 +46,10 @@
 
 #include "Log.h"
 
+#ifdef IFX_ERR_ASSERT_ARGUMENTS
+#include <assert.h>
+#endif
+
 
 #ifdef __cplusplus
 extern "C"
@@ -88,6 +92,7 @@ typedef enum ifx_Error_e
                                                                                    action is not possible*/
     IFX_ERROR_MISSING_INTERFACE = IFX_ERROR_API_BASE + 0x0F,                  /**< Interface is missing or nullptr */
     IFX_ERROR_NOT_IMPLEMENTED = IFX_ERROR_API_BASE + 0x10,                    /**< Generic Error for non-implemented feature*/
+    IFX_ERROR_ABORTED = IFX_ERROR_API_BASE + 0x11,                            /**< An asynchronous request was cancelled before it completed */
 
     // Device related errors:
     // Any new Device related errors should only be defined at the end of this block, using the next available
@@ -334,6 +339,25 @@ extern void (*ifx_error_callback_pointer)(const char*, const char*, int, ifx_Err
 #define IFX_ERR_BRN_COND(cond, error_code) \
     IFX_ERR_BRV_COND(cond, error_code, NULL)
 
+//----------------------------------------------------------------------------
+// Argument checks of the vector, matrix and cube modules (IFX_VEC_BRK_VALID,
+// IFX_MAT_BRK_DIM, ...). They catch programming errors rather than runtime
+// conditions, so with IFX_ERR_ASSERT_ARGUMENTS (CMake option
+// SDK_ASSERT_ARGUMENTS) they are compiled to assertions, which vanish with
+// NDEBUG, instead of setting the error code.
+#ifdef IFX_ERR_ASSERT_ARGUMENTS
+#define IFX_ERR_ARG_BRK_COND(cond, error_code) assert(!(cond))
+#define IFX_ERR_ARG_BRV_COND(cond, error_code, v) \
+    do                                            \
+    {                                             \
+        assert(!(cond));                          \
+        (void)(v);                                \
+    } while (0)
+#else
+#define IFX_ERR_ARG_BRK_COND(cond, error_code)    IFX_ERR_BRK_COND(cond, error_code)
+#define IFX_ERR_ARG_BRV_COND(cond, error_code, v) IFX_ERR_BRV_COND(cond, error_code, v)
+#endif
+
 //----------------------------------------------------------------------------
 // Common applications of the Condition check macros
 
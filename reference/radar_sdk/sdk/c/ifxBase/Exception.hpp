@@ -158,6 +158,8 @@ class missing_interface : public ExceptionBase<IFX_ERROR_MISSING_INTERFACE>
 {};
 class not_implemented : public ExceptionBase<IFX_ERROR_NOT_IMPLEMENTED>
 {};
+class aborted : public ExceptionBase<IFX_ERROR_ABORTED>
+{};
 
 }  // namespace exception
 }  // namespace rdk
@@ -0,0 +1,488 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+// for pthread_setaffinity_np
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "Defines.h"
+#include "Error.h"
+#include "Executor.h"
+#include "Mem.h"
+#include "internal/Util.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#if defined(_WIN32)
+#define LOCK(m)                  AcquireSRWLockExclusive(m)
+#define UNLOCK(m)                ReleaseSRWLockExclusive(m)
+#define WAIT(c, m)               SleepConditionVariableSRW((c), (m), INFINITE, 0)
+#define SIGNAL(c)                WakeConditionVariable(c)
+#define BROADCAST(c)             WakeAllConditionVariable(c)
+#define FETCH_INCREMENT(counter) ((uint32_t)InterlockedIncrement((volatile LONG*)(counter)) - 1)
+#else
+#define LOCK(m)                  pthread_mutex_lock(m)
+#define UNLOCK(m)                pthread_mutex_unlock(m)
+#define WAIT(c, m)               pthread_cond_wait((c), (m))
+#define SIGNAL(c)                pthread_cond_signal(c)
+#define BROADCAST(c)             pthread_cond_broadcast(c)
+#define FETCH_INCREMENT(counter) __atomic_fetch_add((counter), 1, __ATOMIC_RELAXED)
+#endif
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+#if defined(_WIN32)
+typedef SRWLOCK mutex_t;
+typedef CONDITION_VARIABLE cond_t;
+typedef HANDLE thread_t;
+#else
+typedef pthread_mutex_t mutex_t;
+typedef pthread_cond_t cond_t;
+typedef pthread_t thread_t;
+#endif
+
+/**
+ * @brief Argument of a worker thread.
+ */
+typedef struct
+{
+    ifx_Executor_t* executor; /**< Thread pool of the worker.*/
+    uint32_t index;           /**< Thread index passed to tasks, 1 to number of workers.*/
+} worker_t;
+
+/**
+ * @brief A job queued with ifx_executor_post.
+ */
+typedef struct job_s
+{
+    ifx_Executor_Job_t job; /**< Function to run.*/
+    void* context;          /**< Argument of job.*/
+    struct job_s* next;     /**< Next queued job.*/
+} job_t;
+
+/**
+ * @brief Defines the structure for the thread pool.
+ *        Use type ifx_Executor_t for this struct.
+ *
+ * A loop is published by incrementing generation. Every worker then takes
+ * chunks until none is left and decrements busy; the last one signals
+ * done. The chunks are claimed with an atomic increment of next_chunk, so
+ * taking a chunk needs no lock. Workers without a loop to work on take
+ * posted jobs from the queue jobs_head to jobs_tail.
+ */
+struct ifx_Executor_s
+{
+    uint32_t num_workers;        /**< Number of worker threads, number of threads - 1.*/
+    thread_t* threads;           /**< Worker threads.*/
+    worker_t* workers;           /**< Arguments of the worker threads.*/
+    mutex_t run_lock;            /**< Serializes loops started from different threads.*/
+    mutex_t lock;                /**< Protects the members below except next_chunk.*/
+    cond_t wake;                 /**< Signaled when a loop is published or the pool stops.*/
+    cond_t done;                 /**< Signaled when the last worker finished a loop.*/
+    uint32_t generation;         /**< Incremented for every loop.*/
+    bool stop;                   /**< True if the workers shall exit.*/
+    uint32_t busy;               /**< Number of workers still processing the current loop.*/
+    ifx_Error_t error;           /**< First error of a worker in the current loop.*/
+    ifx_Executor_Task_t task;    /**< Task of the current loop.*/
+    void* context;               /**< Context of the current loop.*/
+    uint32_t count;              /**< Number of elements of the current loop.*/
+    uint32_t grain;              /**< Number of elements per chunk.*/
+    uint32_t num_chunks;         /**< Number of chunks of the current loop.*/
+    volatile uint32_t next_chunk; /**< Next chunk to be processed.*/
+    job_t* jobs_head;            /**< Oldest posted job, NULL if none is queued.*/
+    job_t* jobs_tail;            /**< Newest posted job.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+// true on worker threads and while the calling thread processes chunks
+static IFX_THREAD_LOCAL bool in_task = false;
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Processes chunks of the current loop until none is left.
+ *
+ * @param [in]     executor  thread pool
+ * @param [in]     thread    thread index passed to the task
+ */
+static void run_chunks(ifx_Executor_t* executor, uint32_t thread);
+
+/**
+ * @brief Main function of the worker threads.
+ *
+ * @param [in]     worker    worker argument
+ */
+static void worker_main(worker_t* worker);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void run_chunks(ifx_Executor_t* executor, uint32_t thread)
+{
+    for (;;)
+    {
+        const uint32_t chunk = FETCH_INCREMENT(&executor->next_chunk);
+        if (chunk >= executor->num_chunks)
+            break;
+
+        const uint32_t begin = chunk * executor->grain;
+        const uint32_t end = MIN(begin + executor->grain, executor->count);
+        executor->task(executor->context, begin, end, thread);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void worker_main(worker_t* worker)
+{
+    ifx_Executor_t* executor = worker->executor;
+    uint32_t seen = 0;
+
+    ifx_util_configure_worker_thread("executor");
+    in_task = true;
+
+    LOCK(&executor->lock);
+    for (;;)
+    {
+        while (!executor->stop && executor->generation == seen && executor->jobs_head == NULL)
+            WAIT(&executor->wake, &executor->lock);
+
+        if (executor->generation == seen)
+        {
+            // no loop: run a queued job, exit once the queue is drained
+            job_t* job = executor->jobs_head;
+            if (job == NULL)
+                break;
+
+            executor->jobs_head = job->next;
+            if (executor->jobs_head == NULL)
+                executor->jobs_tail = NULL;
+            UNLOCK(&executor->lock);
+
+            job->job(job->context);
+            ifx_error_clear();
+            ifx_mem_free(job);
+
+            LOCK(&executor->lock);
+            continue;
+        }
+
+        seen = executor->generation;
+        UNLOCK(&executor->lock);
+
+        ifx_error_clear();
+        run_chunks(executor, worker->index);
+        const ifx_Error_t error = ifx_error_get_and_clear();
+
+        LOCK(&executor->lock);
+        if (error != IFX_OK && executor->error == IFX_OK)
+            executor->error = error;
+        if (--executor->busy == 0)
+            SIGNAL(&executor->done);
+    }
+    UNLOCK(&executor->lock);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI thread_main(LPVOID arg)
+{
+    worker_main(arg);
+    return 0;
+}
+#else
+static void* thread_main(void* arg)
+{
+    worker_main(arg);
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------
+
+static uint32_t get_num_cores(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores > 0) ? (uint32_t)cores : 1;
+#endif
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Executor_t* ifx_executor_create(uint32_t num_threads)
+{
+    if (num_threads == 0)
+        num_threads = get_num_cores();
+
+    ifx_Executor_t* e = ifx_mem_calloc(1, sizeof(struct ifx_Executor_s));
+    IFX_ERR_BRN_MEMALLOC(e);
+
+#if defined(_WIN32)
+    InitializeSRWLock(&e->run_lock);
+    InitializeSRWLock(&e->lock);
+    InitializeConditionVariable(&e->wake);
+    InitializeConditionVariable(&e->done);
+#else
+    pthread_mutex_init(&e->run_lock, NULL);
+    pthread_mutex_init(&e->lock, NULL);
+    pthread_cond_init(&e->wake, NULL);
+    pthread_cond_init(&e->done, NULL);
+#endif
+
+    const uint32_t num_workers = num_threads - 1;
+    if (num_workers == 0)
+        return e;
+
+    e->threads = ifx_mem_calloc(num_workers, sizeof(thread_t));
+    e->workers = ifx_mem_calloc(num_workers, sizeof(worker_t));
+    if (e->threads == NULL || e->workers == NULL)
+    {
+        ifx_executor_destroy(e);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    for (uint32_t i = 0; i < num_workers; i++)
+    {
+        e->workers[i].executor = e;
+        e->workers[i].index = i + 1;
+
+#if defined(_WIN32)
+        e->threads[i] = CreateThread(NULL, 0, thread_main, &e->workers[i], 0, NULL);
+        const bool created = (e->threads[i] != NULL);
+#else
+        const bool created = (pthread_create(&e->threads[i], NULL, thread_main, &e->workers[i]) == 0);
+#endif
+        if (!created)
+        {
+            ifx_executor_destroy(e);
+            IFX_ERR_BRN_COND(true, IFX_ERROR_INTERNAL);
+        }
+
+        e->num_workers++;
+    }
+
+    return e;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_executor_destroy(ifx_Executor_t* executor)
+{
+    if (executor == NULL)
+        return;
+
+    LOCK(&executor->lock);
+    executor->stop = true;
+    BROADCAST(&executor->wake);
+    UNLOCK(&executor->lock);
+
+    for (uint32_t i = 0; i < executor->num_workers; i++)
+    {
+#if defined(_WIN32)
+        WaitForSingleObject(executor->threads[i], INFINITE);
+        CloseHandle(executor->threads[i]);
+#else
+        pthread_join(executor->threads[i], NULL);
+#endif
+    }
+
+#if !defined(_WIN32)
+    pthread_mutex_destroy(&executor->run_lock);
+    pthread_mutex_destroy(&executor->lock);
+    pthread_cond_destroy(&executor->wake);
+    pthread_cond_destroy(&executor->done);
+#endif
+
+    ifx_mem_free(executor->threads);
+    ifx_mem_free(executor->workers);
+    ifx_mem_free(executor);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_executor_post(ifx_Executor_t* executor, ifx_Executor_Job_t job, void* context)
+{
+    IFX_ERR_BRK_NULL(job);
+
+    if (executor == NULL || executor->num_workers == 0)
+    {
+        job(context);
+        return;
+    }
+
+    job_t* node = ifx_mem_alloc(sizeof(job_t));
+    IFX_ERR_BRK_MEMALLOC(node);
+    node->job = job;
+    node->context = context;
+    node->next = NULL;
+
+    LOCK(&executor->lock);
+    if (executor->jobs_tail != NULL)
+        executor->jobs_tail->next = node;
+    else
+        executor->jobs_head = node;
+    executor->jobs_tail = node;
+    SIGNAL(&executor->wake);
+    UNLOCK(&executor->lock);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_executor_get_num_threads(const ifx_Executor_t* executor)
+{
+    return (executor == NULL) ? 1 : executor->num_workers + 1;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_executor_set_affinity(ifx_Executor_t* executor, const uint32_t* cores, uint32_t num_cores)
+{
+    IFX_ERR_BRK_NULL(executor);
+    IFX_ERR_BRK_NULL(cores);
+    IFX_ERR_BRK_ARGUMENT(num_cores == 0);
+
+    for (uint32_t i = 0; i < executor->num_workers; i++)
+    {
+        const uint32_t core = cores[i % num_cores];
+
+#if defined(_WIN32)
+        IFX_ERR_BRK_COND(core >= 8 * sizeof(DWORD_PTR), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+        IFX_ERR_BRK_COND(SetThreadAffinityMask(executor->threads[i], (DWORD_PTR)1 << core) == 0, IFX_ERROR_ARGUMENT_INVALID);
+#elif defined(__linux__)
+        IFX_ERR_BRK_COND(core >= CPU_SETSIZE, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(core, &set);
+        IFX_ERR_BRK_COND(pthread_setaffinity_np(executor->threads[i], sizeof(set), &set) != 0, IFX_ERROR_ARGUMENT_INVALID);
+#else
+        (void)core;
+        IFX_ERR_BRK_COND(true, IFX_ERROR_NOT_SUPPORTED);
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_executor_parallel_for(ifx_Executor_t* executor,
+                               uint32_t count,
+                               uint32_t grain,
+                               ifx_Executor_Task_t task,
+                               void* context)
+{
+    IFX_ERR_BRK_NULL(task);
+
+    if (grain == 0)
+        grain = 1;
+
+    if (count == 0)
+        return;
+
+    // nested loops and loops of a single chunk run on the calling thread
+    if (executor == NULL || executor->num_workers == 0 || in_task || count <= grain)
+    {
+        task(context, 0, count, 0);
+        return;
+    }
+
+    LOCK(&executor->run_lock);
+
+    LOCK(&executor->lock);
+    executor->task = task;
+    executor->context = context;
+    executor->count = count;
+    executor->grain = grain;
+    executor->num_chunks = count / grain + ((count % grain) ? 1 : 0);
+    executor->next_chunk = 0;
+    executor->busy = executor->num_workers;
+    executor->error = IFX_OK;
+    executor->generation++;
+    BROADCAST(&executor->wake);
+    UNLOCK(&executor->lock);
+
+    in_task = true;
+    run_chunks(executor, 0);
+    in_task = false;
+
+    LOCK(&executor->lock);
+    while (executor->busy > 0)
+        WAIT(&executor->done, &executor->lock);
+    const ifx_Error_t error = executor->error;
+    UNLOCK(&executor->lock);
+
+    UNLOCK(&executor->run_lock);
+
+    if (error != IFX_OK && ifx_error_get() == IFX_OK)
+        ifx_error_set_no_callback(error);
+}
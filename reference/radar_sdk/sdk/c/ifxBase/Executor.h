@@ -0,0 +1,219 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Executor.h
+ *
+ * \brief \copybrief gr_executor
+ *
+ * For details refer to \ref gr_executor
+ */
+
+#ifndef IFX_BASE_EXECUTOR_H
+#define IFX_BASE_EXECUTOR_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for a thread pool, see Executor.h.
+ */
+typedef struct ifx_Executor_s ifx_Executor_t;
+
+/**
+ * @brief Function processing the elements begin to end-1 of a parallel loop.
+ *
+ * thread is the index of the thread running the function (0 to number of
+ * threads - 1). No two calls with the same thread index run at the same
+ * time, so it can select per-thread scratch memory.
+ */
+typedef void (*ifx_Executor_Task_t)(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+/**
+ * @brief Function run once by a thread of the pool, see \ref ifx_executor_post.
+ */
+typedef void (*ifx_Executor_Job_t)(void* context);
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_SDK_base
+ * @{
+ */
+
+/** @defgroup gr_executor Executor
+ * @brief API for running processing steps on several threads
+ *
+ * An executor is a pool of threads that processing handles can be bound to
+ * (e.g. \ref ifx_rdm_set_executor). Handles bound to an executor split
+ * their loops over antennas, beams or range bins into chunks that are
+ * processed by all threads of the pool and the calling thread. Threads
+ * that finish a chunk take the next unprocessed one, so the load is
+ * balanced even if chunks take different times. Handles without executor
+ * process everything on the calling thread.
+ *
+ * An executor can be shared by several handles. Loops started at the same
+ * time from different threads run one after the other on the pool; a loop
+ * started from a task of another loop runs on the calling thread.
+ *
+ * Single jobs can be queued as well (\ref ifx_executor_post), e.g. the
+ * processing of frames delivered by the asynchronous device APIs, so the
+ * threads receiving the data hand the work over to the pool.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a thread pool.
+ *
+ * @param [in]     num_threads   Number of threads processing a loop including the
+ *                               calling thread, 0 for the number of CPU cores.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Executor_t* ifx_executor_create(uint32_t num_threads);
+
+/**
+ * @brief Destroys a thread pool.
+ *
+ * Handles bound to the executor must not be used afterwards.
+ *
+ * @param [in]     executor  A handle to the thread pool.
+ */
+IFX_DLL_PUBLIC
+void ifx_executor_destroy(ifx_Executor_t* executor);
+
+/**
+ * @brief Returns the number of threads processing a loop.
+ *
+ * @param [in]     executor  A handle to the thread pool, may be NULL.
+ *
+ * @return Number of threads including the calling thread, 1 if executor is NULL.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_executor_get_num_threads(const ifx_Executor_t* executor);
+
+/**
+ * @brief Pins the threads of a pool to CPU cores.
+ *
+ * Thread i of the pool (the calling thread is not pinned) runs on core
+ * cores[i % num_cores]. Pinning is supported on Linux and Windows, otherwise
+ * IFX_ERROR_NOT_SUPPORTED is set.
+ *
+ * @param [in]     executor  A handle to the thread pool.
+ * @param [in]     cores     Indices of the CPU cores.
+ * @param [in]     num_cores Number of elements of cores.
+ */
+IFX_DLL_PUBLIC
+void ifx_executor_set_affinity(ifx_Executor_t* executor, const uint32_t* cores, uint32_t num_cores);
+
+/**
+ * @brief Runs a parallel loop.
+ *
+ * The elements 0 to count-1 are split into chunks of grain elements (the
+ * last chunk may be smaller) and task is called once per chunk. The
+ * function returns when all chunks are processed. If executor is NULL,
+ * task is called once for all elements on the calling thread.
+ *
+ * Errors set by the task on other threads are set on the calling thread,
+ * if there are several the first one is kept.
+ *
+ * @param [in]     executor  A handle to the thread pool, may be NULL.
+ * @param [in]     count     Number of elements.
+ * @param [in]     grain     Number of elements per chunk, 0 for 1.
+ * @param [in]     task      Function processing a chunk.
+ * @param [in]     context   First argument of task.
+ */
+IFX_DLL_PUBLIC
+void ifx_executor_parallel_for(ifx_Executor_t* executor,
+                               uint32_t count,
+                               uint32_t grain,
+                               ifx_Executor_Task_t task,
+                               void* context);
+
+/**
+ * @brief Queues a job to run once on a thread of the pool.
+ *
+ * Jobs run in the order they are queued, each on the next thread that has
+ * no loop to work on; loops are taken before queued jobs, and a loop waits
+ * for jobs running on the pool threads to return. Errors a job sets are
+ * discarded, so a job reports its errors itself. Jobs queued before
+ * \ref ifx_executor_destroy still run before it returns.
+ *
+ * If executor is NULL or has no thread besides the calling one, job runs
+ * on the calling thread before the function returns.
+ *
+ * @param [in]     executor  A handle to the thread pool, may be NULL.
+ * @param [in]     job       Function to run.
+ * @param [in]     context   Argument of job.
+ */
+IFX_DLL_PUBLIC
+void ifx_executor_post(ifx_Executor_t* executor, ifx_Executor_Job_t job, void* context);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_EXECUTOR_H */
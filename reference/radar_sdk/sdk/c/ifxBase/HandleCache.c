@@ -0,0 +1,240 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+// for clock_gettime
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+#include "internal/HandleCache.h"
+#include "Mem.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#if defined(_WIN32)
+#define LOCK(c)   AcquireSRWLockExclusive(&(c)->lock)
+#define UNLOCK(c) ReleaseSRWLockExclusive(&(c)->lock)
+#else
+#define LOCK(c)   pthread_mutex_lock(&(c)->lock)
+#define UNLOCK(c) pthread_mutex_unlock(&(c)->lock)
+#endif
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Released handle in a handle cache.
+ *
+ * The configuration the handle was created from follows the structure in
+ * the same allocation.
+ */
+struct ifx_Handle_Cache_Entry_s
+{
+    void* handle;                          /**< Released handle.*/
+    struct ifx_Handle_Cache_Entry_s* next; /**< Next (older) entry.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void* entry_config(ifx_Handle_Cache_Entry_t* entry);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void* entry_config(ifx_Handle_Cache_Entry_t* entry)
+{
+    return entry + 1;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+uint64_t ifx_handle_cache_now_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_handle_cache_take(ifx_Handle_Cache_t* cache, const void* config)
+{
+    void* handle = NULL;
+
+    LOCK(cache);
+    for (ifx_Handle_Cache_Entry_t** link = &cache->entries; *link != NULL; link = &(*link)->next)
+    {
+        ifx_Handle_Cache_Entry_t* entry = *link;
+        if (cache->equal(entry_config(entry), config))
+        {
+            *link = entry->next;
+            handle = entry->handle;
+            ifx_mem_free(entry);
+            break;
+        }
+    }
+
+    if (handle != NULL)
+    {
+        cache->stats.hits++;
+        cache->stats.cached--;
+    }
+    else
+        cache->stats.misses++;
+    UNLOCK(cache);
+
+    return handle;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_handle_cache_put(ifx_Handle_Cache_t* cache, const void* config, void* handle)
+{
+    ifx_Handle_Cache_Entry_t* entry = ifx_mem_alloc(sizeof(ifx_Handle_Cache_Entry_t) + cache->config_size);
+    if (entry == NULL)
+    {
+        cache->destroy(handle);
+        return;
+    }
+
+    entry->handle = handle;
+    memcpy(entry_config(entry), config, cache->config_size);
+
+    ifx_Handle_Cache_Entry_t* evicted = NULL;
+
+    LOCK(cache);
+    entry->next = cache->entries;
+    cache->entries = entry;
+
+    if (cache->stats.cached < IFX_HANDLE_CACHE_CAPACITY)
+        cache->stats.cached++;
+    else
+    {
+        // drop the oldest handle
+        ifx_Handle_Cache_Entry_t** link = &cache->entries;
+        while ((*link)->next != NULL)
+            link = &(*link)->next;
+        evicted = *link;
+        *link = NULL;
+    }
+    UNLOCK(cache);
+
+    if (evicted != NULL)
+    {
+        cache->destroy(evicted->handle);
+        ifx_mem_free(evicted);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_handle_cache_record(ifx_Handle_Cache_t* cache, uint64_t start_ns)
+{
+    const uint64_t duration = ifx_handle_cache_now_ns() - start_ns;
+
+    LOCK(cache);
+    cache->stats.last_acquire_ns = duration;
+    if (duration > cache->stats.max_acquire_ns)
+        cache->stats.max_acquire_ns = duration;
+    UNLOCK(cache);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_handle_cache_clear(ifx_Handle_Cache_t* cache)
+{
+    LOCK(cache);
+    ifx_Handle_Cache_Entry_t* entries = cache->entries;
+    cache->entries = NULL;
+    cache->stats.cached = 0;
+    UNLOCK(cache);
+
+    // destroy outside of the lock, destroying may release handles of other caches
+    while (entries != NULL)
+    {
+        ifx_Handle_Cache_Entry_t* next = entries->next;
+        cache->destroy(entries->handle);
+        ifx_mem_free(entries);
+        entries = next;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_handle_cache_get_stats(ifx_Handle_Cache_t* cache, ifx_Handle_Cache_Stats_t* stats)
+{
+    LOCK(cache);
+    *stats = cache->stats;
+    UNLOCK(cache);
+}
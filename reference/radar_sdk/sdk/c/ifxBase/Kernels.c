@@ -0,0 +1,2067 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Complex.h"
+#include "Defines.h"
+#include "internal/ComplexInline.h"
+#include "internal/Kernels.h"
+#include "internal/Simd.h"
+
+#if defined(IFX_X86_DISPATCH) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/*
+==============================================================================
+   3. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// complex arrays as arrays of interleaved real and imaginary parts
+#define FLOATS(z) ((float*)(z))
+#define CFLOATS(z) ((const float*)(z))
+
+/* Polynomials in ascending powers: atan(t) = t*P(t^2) for t in [0, 1] and
+ * asin(s) = s + s*z*Q(z) with z = s^2 for s in [0, 0.5]. Larger arguments
+ * of asin use asin(a) = pi/2 - 2*asin(sqrt((1-a)/2)).
+ */
+#define ATAN_ORDER 6
+#define ASIN_ORDER 5
+static const float atan_coeffs[ATAN_ORDER] = {0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f};
+static const float asin_coeffs[ASIN_ORDER] = {1.6666752422e-1f, 7.4953002686e-2f, 4.5470025998e-2f, 2.4181311049e-2f, 4.2163199048e-2f};
+
+#define HALF_PI ((float)(IFX_PI / 2))
+#define RAD2DEG ((float)(180 / IFX_PI))
+
+/* log2(m) = x*P(x) with x = m-1 for the mantissa m in [sqrt(0.5), sqrt(2)),
+ * minimax fits of the relative error in ascending powers. The maximum error
+ * of log2 is 5.6e-3 for order 2, 8.5e-4, 1.0e-4, 1.5e-5, 2.2e-6 and 3.7e-7
+ * for order 7.
+ */
+#if IFX_KERNELS_LOG2_ORDER == 2
+static const float log2_coeffs[] = {1.483108282e+00f, -6.991437674e-01f};
+#elif IFX_KERNELS_LOG2_ORDER == 3
+static const float log2_coeffs[] = {1.445151567e+00f, -7.540743947e-01f, 4.450670183e-01f};
+#elif IFX_KERNELS_LOG2_ORDER == 4
+static const float log2_coeffs[] = {1.441760898e+00f, -7.249037623e-01f, 5.175036788e-01f, -3.296260834e-01f};
+#elif IFX_KERNELS_LOG2_ORDER == 5
+static const float log2_coeffs[] = {1.442578077e+00f, -7.202420831e-01f, 4.866856635e-01f, -3.945710361e-01f, 2.526572645e-01f};
+#elif IFX_KERNELS_LOG2_ORDER == 6
+static const float log2_coeffs[] = {1.442713499e+00f, -7.211319208e-01f, 4.793483913e-01f, -3.674894869e-01f, 3.221505880e-01f, -2.065886557e-01f};
+#elif IFX_KERNELS_LOG2_ORDER == 7
+static const float log2_coeffs[] = {1.442699671e+00f, -7.213758826e-01f, 4.804651141e-01f, -3.589622676e-01f, 2.972619832e-01f, -2.726939023e-01f, 1.706314534e-01f};
+#else
+#error "IFX_KERNELS_LOG2_ORDER must be between 2 and 7"
+#endif
+#define LOG2_ORDER ((int)(sizeof(log2_coeffs) / sizeof(log2_coeffs[0])))
+
+/* The bits of sqrt(0.5): subtracting them from the bits of a positive float
+ * leaves the exponent k of x = m*2^k with m in [sqrt(0.5), sqrt(2)) in the
+ * upper 9 bits, see log2_scalar.
+ */
+#define LOG2_SQRT_HALF_BITS 0x3f3504f3u
+#define LOG2_EXPONENT_MASK  0xff800000u
+#define LOG10_2             0.30102999566f
+
+/* The statistics kernels keep their sums in float for blocks of
+ * STATS_BLOCK elements (a multiple of all vector lengths) and add them up
+ * in double. Lanes that found no minimum or maximum have the index
+ * STATS_NONE.
+ */
+#define STATS_BLOCK 1024
+#define STATS_NONE  UINT32_MAX
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* The scalar kernels are also used for the remaining elements of the SIMD
+ * kernels, if len is not a multiple of the vector length.
+ */
+static void mul_r_scalar(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = x[i] * y[i];
+}
+
+static void mul_c_scalar(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = ifx_cmul(x[i], y[i]);
+}
+
+static void scale_c_scalar(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = ifx_cmul(x[i], scale);
+}
+
+static void mac_c_scalar(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = ifx_cadd(x[i], ifx_cmul(y[i], scale));
+}
+
+static void abs_c_scalar(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = ifx_complex_abs(x[i]);
+}
+
+static void abs2_c_scalar(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        const ifx_Float_t re = IFX_COMPLEX_REAL(x[i]);
+        const ifx_Float_t im = IFX_COMPLEX_IMAG(x[i]);
+        out[i] = re * re + im * im;
+    }
+}
+
+static void gemm_c_scalar(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                          ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+    for (size_t i = 0; i < m; i++)
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
+            for (size_t p = 0; p < k; p++)
+                sum = ifx_cadd(sum, ifx_cmul(a[i * lda + p], b[p * ldb + j]));
+            c[i * ldc + j] = sum;
+        }
+    }
+}
+
+/* The SIMD variants compute alpha*x + beta*history with separate
+ * multiplications and additions (no FMA), so all variants give the same
+ * results as the scalar code of the MTI filters.
+ */
+static void mti_r_scalar(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len)
+{
+    const ifx_Float_t beta = 1 - alpha;
+    for (size_t i = 0; i < len; i++)
+    {
+        const ifx_Float_t x_i = x[i];
+        const ifx_Float_t history_i = history[i];
+        out[i] = x_i - history_i;
+        history[i] = alpha * x_i + beta * history_i;
+    }
+}
+
+/* Like the MTI kernels, the SIMD variants of the biquad round like the
+ * scalar code.
+ */
+static void biquad_r_scalar(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len)
+{
+    const ifx_Float_t b0 = coeffs[0];
+    const ifx_Float_t b1 = coeffs[1];
+    const ifx_Float_t b2 = coeffs[2];
+    const ifx_Float_t a1 = coeffs[3];
+    const ifx_Float_t a2 = coeffs[4];
+    for (size_t i = 0; i < len; i++)
+    {
+        const ifx_Float_t x_i = x[i];
+        const ifx_Float_t y_i = b0 * x_i + z1[i];
+        z1[i] = b1 * x_i - a1 * y_i + z2[i];
+        z2[i] = b2 * x_i - a2 * y_i;
+        out[i] = y_i;
+    }
+}
+
+/* Conversion with integer operations, see F. Giesen, "half <-> float
+ * conversions". Numbers below the smallest normal half precision number
+ * are rounded by a float addition that aligns the mantissa.
+ */
+static inline ifx_Float16_t float_to_f16(ifx_Float_t value)
+{
+    const uint32_t f16_max = (uint32_t)(127 + 16) << 23;  // 65536, rounds to infinity
+    const uint32_t f16_min_normal = (uint32_t)(127 - 14) << 23;
+    const uint32_t denorm_magic = (uint32_t)((127 - 15) + (23 - 10) + 1) << 23;
+
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+    const uint32_t sign = x & 0x80000000u;
+    x ^= sign;
+
+    uint32_t h;
+    if (x >= f16_max)
+        h = (x > 0x7f800000u) ? 0x7e00 : 0x7c00;  // NaN or infinity
+    else if (x < f16_min_normal)
+    {
+        float f, magic;
+        memcpy(&f, &x, sizeof(f));
+        memcpy(&magic, &denorm_magic, sizeof(magic));
+        f += magic;
+        memcpy(&h, &f, sizeof(h));
+        h -= denorm_magic;
+    }
+    else
+    {
+        const uint32_t mant_odd = (x >> 13) & 1;
+        x += ((uint32_t)(15 - 127) << 23) + 0xfff + mant_odd;
+        h = x >> 13;
+    }
+
+    return (ifx_Float16_t)(h | (sign >> 16));
+}
+
+static inline ifx_Float_t f16_to_float(ifx_Float16_t value)
+{
+    const uint32_t exp_mask = 0x7c00u << 13;
+    const uint32_t magic = (uint32_t)113 << 23;
+
+    uint32_t x = (uint32_t)(value & 0x7fff) << 13;
+    const uint32_t exp = x & exp_mask;
+    x += (uint32_t)(127 - 15) << 23;
+
+    if (exp == exp_mask)
+        x += (uint32_t)(128 - 16) << 23;  // infinity or NaN
+    else if (exp == 0)
+    {
+        // subnormal, renormalized by a float subtraction
+        float f, m;
+        x += 1u << 23;
+        memcpy(&f, &x, sizeof(f));
+        memcpy(&m, &magic, sizeof(m));
+        f -= m;
+        memcpy(&x, &f, sizeof(x));
+    }
+
+    x |= (uint32_t)(value & 0x8000) << 16;
+
+    ifx_Float_t result;
+    memcpy(&result, &x, sizeof(result));
+    return result;
+}
+
+static void to_f16_scalar(const ifx_Float_t* x, ifx_Float16_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = float_to_f16(x[i]);
+}
+
+static void from_f16_scalar(const ifx_Float16_t* x, ifx_Float_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        out[i] = f16_to_float(x[i]);
+}
+
+/* Candidate bits of the centers first ... end-1 of the 32 centers starting
+ * at x+2, used for the remaining elements of the SIMD peak kernels.
+ */
+static uint32_t peak_bits_scalar(const ifx_Float_t* x, ifx_Float_t threshold, size_t first, size_t end)
+{
+    uint32_t bits = 0;
+    for (size_t j = first; j < end; j++)
+    {
+        const ifx_Float_t c = x[j + 2];
+        const uint32_t peak = (c >= threshold) & (c >= x[j]) & (c >= x[j + 1]) & (c > x[j + 3]) & (c > x[j + 4]);
+        bits |= peak << j;
+    }
+    return bits;
+}
+
+/* The SIMD variants of the monopulse kernel follow the same steps with
+ * selects instead of branches.
+ */
+static void monopulse_c_scalar(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        // x*conj(y)
+        const float re = IFX_COMPLEX_REAL(x[i]) * IFX_COMPLEX_REAL(y[i]) + IFX_COMPLEX_IMAG(x[i]) * IFX_COMPLEX_IMAG(y[i]);
+        const float im = IFX_COMPLEX_IMAG(x[i]) * IFX_COMPLEX_REAL(y[i]) - IFX_COMPLEX_REAL(x[i]) * IFX_COMPLEX_IMAG(y[i]);
+
+        // atan2(im, re), FLT_MIN avoids 0/0
+        const float are = fabsf(re);
+        const float aim = fabsf(im);
+        const float t = fminf(are, aim) / fmaxf(fmaxf(are, aim), FLT_MIN);
+        const float t2 = t * t;
+        float p = atan_coeffs[ATAN_ORDER - 1];
+        for (int k = ATAN_ORDER - 2; k >= 0; k--)
+            p = p * t2 + atan_coeffs[k];
+        float phi = p * t;
+        if (aim > are)
+            phi = HALF_PI - phi;
+        if (re < 0)
+            phi = (float)IFX_PI - phi;
+        if (im < 0)
+            phi = -phi;
+
+        // asin(v), NaN from sqrt for |v| > 1
+        const float v = gain * phi;
+        const float a = fabsf(v);
+        const bool big = a > 0.5f;
+        const float z = big ? 0.5f * (1 - a) : a * a;
+        const float s = big ? sqrtf(z) : a;
+        float q = asin_coeffs[ASIN_ORDER - 1];
+        for (int k = ASIN_ORDER - 2; k >= 0; k--)
+            q = q * z + asin_coeffs[k];
+        float r = s + s * z * q;
+        if (big)
+            r = HALF_PI - 2 * r;
+
+        out[i] = ((v < 0) ? -r : r) * RAD2DEG;
+    }
+}
+
+static void peaks_r_scalar(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len)
+{
+    for (size_t i = 0; i < len; i += 32)
+        mask[i / 32] = peak_bits_scalar(x + i, threshold, 0, (len - i < 32) ? len - i : 32);
+}
+
+/* log2 of a positive finite float from its exponent and a polynomial of the
+ * mantissa. The mantissa is folded into [sqrt(0.5), sqrt(2)) by the integer
+ * subtraction, which keeps x = m-1 small on both sides of 1. The SIMD
+ * variants use the same steps.
+ */
+static inline float log2_scalar(float v)
+{
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+
+    const uint32_t t = bits - LOG2_SQRT_HALF_BITS;
+    const int32_t k = (int32_t)((t >> 23) ^ 0x100) - 0x100;  // sign extension of the 9 bits
+    bits -= t & LOG2_EXPONENT_MASK;
+
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+    const float x = m - 1;
+
+    float p = log2_coeffs[LOG2_ORDER - 1];
+    for (int j = LOG2_ORDER - 2; j >= 0; j--)
+        p = p * x + log2_coeffs[j];
+    return (float)k + p * x;
+}
+
+static void spectrum_r_scalar(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const float factor = scale * LOG10_2;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        const float v = (scale == 0) ? sqrtf(abs2[i]) : factor * log2_scalar(abs2[i]);
+        out[i] = (abs2[i] < threshold2) ? clip : v;
+    }
+}
+
+static void spectrum_c_scalar(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    abs2_c_scalar(x, out, len);
+    spectrum_r_scalar(out, threshold2, clip, scale, out, len);
+}
+
+/* Statistics of the elements begin to end, used by the scalar kernel and
+ * for the remaining elements of the SIMD kernels.
+ */
+static void stats_r_part(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t begin, size_t end)
+{
+    double sum = 0;
+    double sumsq = 0;
+    for (size_t j = begin; j < end; j++)
+    {
+        const double d = (double)x[j] - shift;
+        sum += d;
+        sumsq += d * d;
+        if (x[j] < range[0])
+        {
+            range[0] = x[j];
+            idx[0] = first + (uint32_t)j;
+        }
+        if (x[j] > range[1])
+        {
+            range[1] = x[j];
+            idx[1] = first + (uint32_t)j;
+        }
+    }
+    sums[0] += sum;
+    sums[1] += sumsq;
+}
+
+static void stats_r_scalar(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len)
+{
+    stats_r_part(x, shift, first, sums, range, idx, 0, len);
+}
+
+/* Merges the minima and maxima of the lanes of a SIMD kernel into range and
+ * idx. A lane only has an index if its value beats the initial range, so
+ * the first lane with an index wins against range, later lanes only with a
+ * better value or an equal value at a smaller index.
+ */
+static void stats_r_merge(const float* lo, const uint32_t* lo_idx, const float* hi, const uint32_t* hi_idx, size_t lanes,
+                          ifx_Float_t* range, uint32_t* idx)
+{
+    bool found_lo = false;
+    bool found_hi = false;
+    for (size_t j = 0; j < lanes; j++)
+    {
+        if ((lo_idx[j] != STATS_NONE) && (!found_lo || (lo[j] < range[0]) || ((lo[j] == range[0]) && (lo_idx[j] < idx[0]))))
+        {
+            range[0] = lo[j];
+            idx[0] = lo_idx[j];
+            found_lo = true;
+        }
+        if ((hi_idx[j] != STATS_NONE) && (!found_hi || (hi[j] > range[1]) || ((hi[j] == range[1]) && (hi_idx[j] < idx[1]))))
+        {
+            range[1] = hi[j];
+            idx[1] = hi_idx[j];
+            found_hi = true;
+        }
+    }
+}
+
+static double sum_lanes(const float* lanes, size_t len)
+{
+    double sum = 0;
+    for (size_t j = 0; j < len; j++)
+        sum += lanes[j];
+    return sum;
+}
+
+static const ifx_Kernels_t kernels_scalar = {
+    "scalar",
+    mul_r_scalar,
+    mul_c_scalar,
+    scale_c_scalar,
+    mac_c_scalar,
+    abs_c_scalar,
+    abs2_c_scalar,
+    gemm_c_scalar,
+    mti_r_scalar,
+    biquad_r_scalar,
+    to_f16_scalar,
+    from_f16_scalar,
+    peaks_r_scalar,
+    monopulse_c_scalar,
+    spectrum_r_scalar,
+    spectrum_c_scalar,
+    stats_r_scalar,
+};
+
+#ifdef IFX_SSE2
+//----------------------------------------------------------------------------
+
+/* With interleaved complex numbers a = [ar0, ai0, ar1, ai1] and
+ * b = [br0, bi0, br1, bi1] the product is
+ *      a * [br0, br0, br1, br1] + [-ai0, ar0, -ai1, ar1] * [bi0, bi0, bi1, bi1]
+ */
+static inline __m128 cmul_sse2(__m128 a, __m128 b_re, __m128 b_im)
+{
+    const __m128 sign = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const __m128 a_swap = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_add_ps(_mm_mul_ps(a, b_re), _mm_xor_ps(_mm_mul_ps(a_swap, b_im), sign));
+}
+
+// squared norm of the 4 complex numbers in a and b
+static inline __m128 cabs2_sse2(__m128 a, __m128 b)
+{
+    const __m128 a2 = _mm_mul_ps(a, a);
+    const __m128 b2 = _mm_mul_ps(b, b);
+    return _mm_add_ps(_mm_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+static void mul_r_sse2(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(&out[i], _mm_mul_ps(_mm_loadu_ps(&x[i]), _mm_loadu_ps(&y[i])));
+    mul_r_scalar(x + i, y + i, out + i, len - i);
+}
+
+static void mul_c_sse2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 2 <= len; i += 2)
+    {
+        const __m128 a = _mm_loadu_ps(CFLOATS(x + i));
+        const __m128 b = _mm_loadu_ps(CFLOATS(y + i));
+        const __m128 b_re = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 b_im = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1));
+        _mm_storeu_ps(FLOATS(out + i), cmul_sse2(a, b_re, b_im));
+    }
+    mul_c_scalar(x + i, y + i, out + i, len - i);
+}
+
+static void scale_c_sse2(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m128 s_re = _mm_set1_ps(IFX_COMPLEX_REAL(scale));
+    const __m128 s_im = _mm_set1_ps(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 2 <= len; i += 2)
+        _mm_storeu_ps(FLOATS(out + i), cmul_sse2(_mm_loadu_ps(CFLOATS(x + i)), s_re, s_im));
+    scale_c_scalar(x + i, scale, out + i, len - i);
+}
+
+static void mac_c_sse2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m128 s_re = _mm_set1_ps(IFX_COMPLEX_REAL(scale));
+    const __m128 s_im = _mm_set1_ps(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 2 <= len; i += 2)
+    {
+        const __m128 p = cmul_sse2(_mm_loadu_ps(CFLOATS(y + i)), s_re, s_im);
+        _mm_storeu_ps(FLOATS(out + i), _mm_add_ps(_mm_loadu_ps(CFLOATS(x + i)), p));
+    }
+    mac_c_scalar(x + i, y + i, scale, out + i, len - i);
+}
+
+static void abs_c_sse2(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(&out[i], _mm_sqrt_ps(cabs2_sse2(_mm_loadu_ps(CFLOATS(x + i)), _mm_loadu_ps(CFLOATS(x + i + 2)))));
+    abs_c_scalar(x + i, out + i, len - i);
+}
+
+static void abs2_c_sse2(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(&out[i], cabs2_sse2(_mm_loadu_ps(CFLOATS(x + i)), _mm_loadu_ps(CFLOATS(x + i + 2))));
+    abs2_c_scalar(x + i, out + i, len - i);
+}
+
+/* Each row of c is computed in blocks of 4 complex numbers, which are kept
+ * in registers while summing over k. The products with the real and the
+ * imaginary part of a are summed separately and combined at the end, see
+ * cmul_sse2.
+ */
+static void gemm_c_sse2(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                        ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+    const __m128 sign = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+    const size_t n4 = n & ~(size_t)3;
+
+    for (size_t i = 0; i < m; i++)
+    {
+        const ifx_Complex_t* a_row = a + i * lda;
+        for (size_t j = 0; j < n4; j += 4)
+        {
+            __m128 re0 = _mm_setzero_ps(), re1 = _mm_setzero_ps();
+            __m128 im0 = _mm_setzero_ps(), im1 = _mm_setzero_ps();
+            for (size_t p = 0; p < k; p++)
+            {
+                const __m128 a_re = _mm_set1_ps(IFX_COMPLEX_REAL(a_row[p]));
+                const __m128 a_im = _mm_set1_ps(IFX_COMPLEX_IMAG(a_row[p]));
+                const __m128 b0 = _mm_loadu_ps(CFLOATS(b + p * ldb + j));
+                const __m128 b1 = _mm_loadu_ps(CFLOATS(b + p * ldb + j + 2));
+                re0 = _mm_add_ps(re0, _mm_mul_ps(b0, a_re));
+                re1 = _mm_add_ps(re1, _mm_mul_ps(b1, a_re));
+                im0 = _mm_add_ps(im0, _mm_mul_ps(_mm_shuffle_ps(b0, b0, _MM_SHUFFLE(2, 3, 0, 1)), a_im));
+                im1 = _mm_add_ps(im1, _mm_mul_ps(_mm_shuffle_ps(b1, b1, _MM_SHUFFLE(2, 3, 0, 1)), a_im));
+            }
+            _mm_storeu_ps(FLOATS(c + i * ldc + j), _mm_add_ps(re0, _mm_xor_ps(im0, sign)));
+            _mm_storeu_ps(FLOATS(c + i * ldc + j + 2), _mm_add_ps(re1, _mm_xor_ps(im1, sign)));
+        }
+    }
+    gemm_c_scalar(a, lda, b + n4, ldb, c + n4, ldc, m, n - n4, k);
+}
+
+static void mti_r_sse2(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len)
+{
+    const __m128 a = vf32x4_set1(alpha);
+    const __m128 b = vf32x4_set1(1 - alpha);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m128 x_i = vf32x4_loadu(&x[i]);
+        const __m128 history_i = vf32x4_loadu(&history[i]);
+        _mm_storeu_ps(&out[i], vf32x4_sub(x_i, history_i));
+        _mm_storeu_ps(&history[i], vf32x4_add(vf32x4_mul(a, x_i), vf32x4_mul(b, history_i)));
+    }
+    mti_r_scalar(x + i, history + i, out + i, alpha, len - i);
+}
+
+static void biquad_r_sse2(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len)
+{
+    const __m128 b0 = vf32x4_set1(coeffs[0]);
+    const __m128 b1 = vf32x4_set1(coeffs[1]);
+    const __m128 b2 = vf32x4_set1(coeffs[2]);
+    const __m128 a1 = vf32x4_set1(coeffs[3]);
+    const __m128 a2 = vf32x4_set1(coeffs[4]);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m128 x_i = vf32x4_loadu(&x[i]);
+        const __m128 y_i = vf32x4_add(vf32x4_mul(b0, x_i), vf32x4_loadu(&z1[i]));
+        _mm_storeu_ps(&z1[i], vf32x4_add(vf32x4_sub(vf32x4_mul(b1, x_i), vf32x4_mul(a1, y_i)), vf32x4_loadu(&z2[i])));
+        _mm_storeu_ps(&z2[i], vf32x4_sub(vf32x4_mul(b2, x_i), vf32x4_mul(a2, y_i)));
+        _mm_storeu_ps(&out[i], y_i);
+    }
+    biquad_r_scalar(x + i, out + i, z1 + i, z2 + i, coeffs, len - i);
+}
+
+static void peaks_r_sse2(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len)
+{
+    const __m128 t = _mm_set1_ps(threshold);
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        const ifx_Float_t* w = x + i;
+        const size_t n = (len - i < 32) ? len - i : 32;
+        uint32_t bits = 0;
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const __m128 c = _mm_loadu_ps(&w[j + 2]);
+            __m128 peak = _mm_and_ps(_mm_cmpge_ps(c, t), _mm_cmpge_ps(c, _mm_loadu_ps(&w[j])));
+            peak = _mm_and_ps(peak, _mm_cmpge_ps(c, _mm_loadu_ps(&w[j + 1])));
+            peak = _mm_and_ps(peak, _mm_cmpgt_ps(c, _mm_loadu_ps(&w[j + 3])));
+            peak = _mm_and_ps(peak, _mm_cmpgt_ps(c, _mm_loadu_ps(&w[j + 4])));
+            bits |= (uint32_t)_mm_movemask_ps(peak) << j;
+        }
+        mask[i / 32] = bits | peak_bits_scalar(w, threshold, j, n);
+    }
+}
+
+static inline __m128 select_sse2(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// see monopulse_c_scalar
+static inline __m128 monopulse_sse2(__m128 re, __m128 im, __m128 gain)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 are = _mm_andnot_ps(sign, re);
+    const __m128 aim = _mm_andnot_ps(sign, im);
+    const __m128 t = _mm_div_ps(_mm_min_ps(are, aim), _mm_max_ps(_mm_max_ps(are, aim), _mm_set1_ps(FLT_MIN)));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 p = _mm_set1_ps(atan_coeffs[ATAN_ORDER - 1]);
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+        p = _mm_add_ps(_mm_mul_ps(p, t2), _mm_set1_ps(atan_coeffs[k]));
+    __m128 phi = _mm_mul_ps(p, t);
+    phi = select_sse2(_mm_cmpgt_ps(aim, are), _mm_sub_ps(_mm_set1_ps(HALF_PI), phi), phi);
+    phi = select_sse2(_mm_cmplt_ps(re, zero), _mm_sub_ps(_mm_set1_ps((float)IFX_PI), phi), phi);
+    phi = _mm_xor_ps(phi, _mm_and_ps(_mm_cmplt_ps(im, zero), sign));
+
+    const __m128 v = _mm_mul_ps(gain, phi);
+    const __m128 a = _mm_andnot_ps(sign, v);
+    const __m128 big = _mm_cmpgt_ps(a, _mm_set1_ps(0.5f));
+    const __m128 z = select_sse2(big, _mm_mul_ps(_mm_set1_ps(0.5f), _mm_sub_ps(_mm_set1_ps(1.0f), a)), _mm_mul_ps(a, a));
+    const __m128 s = select_sse2(big, _mm_sqrt_ps(z), a);
+    __m128 q = _mm_set1_ps(asin_coeffs[ASIN_ORDER - 1]);
+    for (int k = ASIN_ORDER - 2; k >= 0; k--)
+        q = _mm_add_ps(_mm_mul_ps(q, z), _mm_set1_ps(asin_coeffs[k]));
+    __m128 r = _mm_add_ps(s, _mm_mul_ps(_mm_mul_ps(s, z), q));
+    r = select_sse2(big, _mm_sub_ps(_mm_set1_ps(HALF_PI), _mm_add_ps(r, r)), r);
+    r = _mm_xor_ps(r, _mm_and_ps(_mm_cmplt_ps(v, zero), sign));
+
+    return _mm_mul_ps(r, _mm_set1_ps(RAD2DEG));
+}
+
+static void monopulse_c_sse2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len)
+{
+    const __m128 g = _mm_set1_ps(gain);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m128 x0 = _mm_loadu_ps(CFLOATS(x + i));
+        const __m128 x1 = _mm_loadu_ps(CFLOATS(x + i + 2));
+        const __m128 y0 = _mm_loadu_ps(CFLOATS(y + i));
+        const __m128 y1 = _mm_loadu_ps(CFLOATS(y + i + 2));
+        const __m128 x_re = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 x_im = _mm_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 y_re = _mm_shuffle_ps(y0, y1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 y_im = _mm_shuffle_ps(y0, y1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        const __m128 re = _mm_add_ps(_mm_mul_ps(x_re, y_re), _mm_mul_ps(x_im, y_im));
+        const __m128 im = _mm_sub_ps(_mm_mul_ps(x_im, y_re), _mm_mul_ps(x_re, y_im));
+        _mm_storeu_ps(&out[i], monopulse_sse2(re, im, g));
+    }
+    monopulse_c_scalar(x + i, y + i, gain, out + i, len - i);
+}
+
+// see log2_scalar
+static inline __m128 log2_sse2(__m128 v)
+{
+    const __m128i bits = _mm_castps_si128(v);
+    const __m128i t = _mm_sub_epi32(bits, _mm_set1_epi32((int)LOG2_SQRT_HALF_BITS));
+    const __m128 k = _mm_cvtepi32_ps(_mm_srai_epi32(t, 23));
+    const __m128 m = _mm_castsi128_ps(_mm_sub_epi32(bits, _mm_and_si128(t, _mm_set1_epi32((int)LOG2_EXPONENT_MASK))));
+    const __m128 x = _mm_sub_ps(m, _mm_set1_ps(1.0f));
+
+    __m128 p = _mm_set1_ps(log2_coeffs[LOG2_ORDER - 1]);
+    for (int j = LOG2_ORDER - 2; j >= 0; j--)
+        p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(log2_coeffs[j]));
+    return _mm_add_ps(k, _mm_mul_ps(p, x));
+}
+
+static inline __m128 spectrum_sse2(__m128 abs2, __m128 threshold2, __m128 clip, __m128 factor, bool linear)
+{
+    const __m128 v = linear ? _mm_sqrt_ps(abs2) : _mm_mul_ps(factor, log2_sse2(abs2));
+    return select_sse2(_mm_cmplt_ps(abs2, threshold2), clip, v);
+}
+
+static void spectrum_r_sse2(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m128 t = _mm_set1_ps(threshold2);
+    const __m128 c = _mm_set1_ps(clip);
+    const __m128 f = _mm_set1_ps(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        _mm_storeu_ps(&out[i], spectrum_sse2(_mm_loadu_ps(&abs2[i]), t, c, f, linear));
+    spectrum_r_scalar(abs2 + i, threshold2, clip, scale, out + i, len - i);
+}
+
+static void spectrum_c_sse2(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m128 t = _mm_set1_ps(threshold2);
+    const __m128 c = _mm_set1_ps(clip);
+    const __m128 f = _mm_set1_ps(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m128 abs2 = cabs2_sse2(_mm_loadu_ps(CFLOATS(x + i)), _mm_loadu_ps(CFLOATS(x + i + 2)));
+        _mm_storeu_ps(&out[i], spectrum_sse2(abs2, t, c, f, linear));
+    }
+    spectrum_c_scalar(x + i, threshold2, clip, scale, out + i, len - i);
+}
+
+static void stats_r_sse2(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len)
+{
+    const __m128 s = _mm_set1_ps(shift);
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i index = _mm_add_epi32(_mm_set1_epi32((int)first), _mm_set_epi32(3, 2, 1, 0));
+    __m128 lo = _mm_set1_ps(range[0]);
+    __m128 hi = _mm_set1_ps(range[1]);
+    __m128 lo_idx = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 hi_idx = lo_idx;
+
+    size_t i = 0;
+    while (i + 4 <= len)
+    {
+        const size_t end = (len - i > STATS_BLOCK) ? i + STATS_BLOCK : len;
+        __m128 sum = _mm_setzero_ps();
+        __m128 sumsq = _mm_setzero_ps();
+        for (; i + 4 <= end; i += 4)
+        {
+            const __m128 v = _mm_loadu_ps(&x[i]);
+            const __m128 d = _mm_sub_ps(v, s);
+            const __m128 lt = _mm_cmplt_ps(v, lo);
+            const __m128 gt = _mm_cmpgt_ps(v, hi);
+            sum = _mm_add_ps(sum, d);
+            sumsq = _mm_add_ps(sumsq, _mm_mul_ps(d, d));
+            lo = select_sse2(lt, v, lo);
+            hi = select_sse2(gt, v, hi);
+            lo_idx = select_sse2(lt, _mm_castsi128_ps(index), lo_idx);
+            hi_idx = select_sse2(gt, _mm_castsi128_ps(index), hi_idx);
+            index = _mm_add_epi32(index, step);
+        }
+
+        float lanes[4];
+        _mm_storeu_ps(lanes, sum);
+        sums[0] += sum_lanes(lanes, 4);
+        _mm_storeu_ps(lanes, sumsq);
+        sums[1] += sum_lanes(lanes, 4);
+    }
+
+    float lo_lanes[4], hi_lanes[4];
+    uint32_t lo_idx_lanes[4], hi_idx_lanes[4];
+    _mm_storeu_ps(lo_lanes, lo);
+    _mm_storeu_ps(hi_lanes, hi);
+    _mm_storeu_si128((__m128i*)lo_idx_lanes, _mm_castps_si128(lo_idx));
+    _mm_storeu_si128((__m128i*)hi_idx_lanes, _mm_castps_si128(hi_idx));
+    stats_r_merge(lo_lanes, lo_idx_lanes, hi_lanes, hi_idx_lanes, 4, range, idx);
+
+    stats_r_part(x, shift, first, sums, range, idx, i, len);
+}
+
+static const ifx_Kernels_t kernels_sse2 = {
+    "sse2",
+    mul_r_sse2,
+    mul_c_sse2,
+    scale_c_sse2,
+    mac_c_sse2,
+    abs_c_sse2,
+    abs2_c_sse2,
+    gemm_c_sse2,
+    mti_r_sse2,
+    biquad_r_sse2,
+    to_f16_scalar,  // SSE2 has no half precision conversion
+    from_f16_scalar,
+    peaks_r_sse2,
+    monopulse_c_sse2,
+    spectrum_r_sse2,
+    spectrum_c_sse2,
+    stats_r_sse2,
+};
+#endif
+
+#ifdef IFX_X86_DISPATCH
+//----------------------------------------------------------------------------
+
+/* fmaddsub subtracts in the even (real) and adds in the odd (imaginary)
+ * elements, see cmul_sse2.
+ */
+IFX_TARGET_AVX2 static inline __m256 cmul_avx2(__m256 a, __m256 b_re, __m256 b_im)
+{
+    const __m256 a_swap = _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm256_fmaddsub_ps(a, b_re, _mm256_mul_ps(a_swap, b_im));
+}
+
+/* The shuffles work within 128 bit lanes, so the squared norms end up in
+ * the order 0 1 4 5 2 3 6 7, which the permutation fixes.
+ */
+IFX_TARGET_AVX2 static inline __m256 cabs2_avx2(__m256 a, __m256 b)
+{
+    const __m256 a2 = _mm256_mul_ps(a, a);
+    const __m256 b2 = _mm256_mul_ps(b, b);
+    const __m256 sum = _mm256_add_ps(_mm256_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0)), _mm256_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1)));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sum), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+IFX_TARGET_AVX2 static void mul_r_avx2(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x8_storu(&out[i], vf32x8_mul(vf32x8_loadu(&x[i]), vf32x8_loadu(&y[i])));
+    mul_r_scalar(x + i, y + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void mul_c_avx2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m256 b = vf32x8_loadu(CFLOATS(y + i));
+        vf32x8_storu(FLOATS(out + i), cmul_avx2(vf32x8_loadu(CFLOATS(x + i)), _mm256_moveldup_ps(b), _mm256_movehdup_ps(b)));
+    }
+    mul_c_scalar(x + i, y + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void scale_c_avx2(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m256 s_re = vf32x8_set1(IFX_COMPLEX_REAL(scale));
+    const __m256 s_im = vf32x8_set1(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vf32x8_storu(FLOATS(out + i), cmul_avx2(vf32x8_loadu(CFLOATS(x + i)), s_re, s_im));
+    scale_c_scalar(x + i, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void mac_c_avx2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m256 s_re = vf32x8_set1(IFX_COMPLEX_REAL(scale));
+    const __m256 s_im = vf32x8_set1(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const __m256 p = cmul_avx2(vf32x8_loadu(CFLOATS(y + i)), s_re, s_im);
+        vf32x8_storu(FLOATS(out + i), vf32x8_add(vf32x8_loadu(CFLOATS(x + i)), p));
+    }
+    mac_c_scalar(x + i, y + i, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void abs_c_avx2(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x8_storu(&out[i], vf32x8_sqrt(cabs2_avx2(vf32x8_loadu(CFLOATS(x + i)), vf32x8_loadu(CFLOATS(x + i + 4)))));
+    abs_c_scalar(x + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void abs2_c_avx2(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x8_storu(&out[i], cabs2_avx2(vf32x8_loadu(CFLOATS(x + i)), vf32x8_loadu(CFLOATS(x + i + 4))));
+    abs2_c_scalar(x + i, out + i, len - i);
+}
+
+// see gemm_c_sse2, blocks of 8 complex numbers
+IFX_TARGET_AVX2 static void gemm_c_avx2(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                                        ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+    const size_t n8 = n & ~(size_t)7;
+
+    for (size_t i = 0; i < m; i++)
+    {
+        const ifx_Complex_t* a_row = a + i * lda;
+        for (size_t j = 0; j < n8; j += 8)
+        {
+            __m256 re0 = vf32x8_setzero(), re1 = vf32x8_setzero();
+            __m256 im0 = vf32x8_setzero(), im1 = vf32x8_setzero();
+            for (size_t p = 0; p < k; p++)
+            {
+                const __m256 a_re = vf32x8_set1(IFX_COMPLEX_REAL(a_row[p]));
+                const __m256 a_im = vf32x8_set1(IFX_COMPLEX_IMAG(a_row[p]));
+                const __m256 b0 = vf32x8_loadu(CFLOATS(b + p * ldb + j));
+                const __m256 b1 = vf32x8_loadu(CFLOATS(b + p * ldb + j + 4));
+                re0 = vf32x8_mla(re0, b0, a_re);
+                re1 = vf32x8_mla(re1, b1, a_re);
+                im0 = vf32x8_mla(im0, _mm256_permute_ps(b0, _MM_SHUFFLE(2, 3, 0, 1)), a_im);
+                im1 = vf32x8_mla(im1, _mm256_permute_ps(b1, _MM_SHUFFLE(2, 3, 0, 1)), a_im);
+            }
+            vf32x8_storu(FLOATS(c + i * ldc + j), _mm256_addsub_ps(re0, im0));
+            vf32x8_storu(FLOATS(c + i * ldc + j + 4), _mm256_addsub_ps(re1, im1));
+        }
+    }
+    gemm_c_sse2(a, lda, b + n8, ldb, c + n8, ldc, m, n - n8, k);
+}
+
+IFX_TARGET_AVX2 static void mti_r_avx2(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len)
+{
+    const __m256 a = vf32x8_set1(alpha);
+    const __m256 b = vf32x8_set1(1 - alpha);
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m256 x_i = vf32x8_loadu(&x[i]);
+        const __m256 history_i = vf32x8_loadu(&history[i]);
+        vf32x8_storu(&out[i], vf32x8_sub(x_i, history_i));
+        vf32x8_storu(&history[i], vf32x8_add(vf32x8_mul(a, x_i), vf32x8_mul(b, history_i)));
+    }
+    mti_r_scalar(x + i, history + i, out + i, alpha, len - i);
+}
+
+IFX_TARGET_AVX2 static void biquad_r_avx2(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len)
+{
+    const __m256 b0 = vf32x8_set1(coeffs[0]);
+    const __m256 b1 = vf32x8_set1(coeffs[1]);
+    const __m256 b2 = vf32x8_set1(coeffs[2]);
+    const __m256 a1 = vf32x8_set1(coeffs[3]);
+    const __m256 a2 = vf32x8_set1(coeffs[4]);
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m256 x_i = vf32x8_loadu(&x[i]);
+        const __m256 y_i = vf32x8_add(vf32x8_mul(b0, x_i), vf32x8_loadu(&z1[i]));
+        vf32x8_storu(&z1[i], vf32x8_add(vf32x8_sub(vf32x8_mul(b1, x_i), vf32x8_mul(a1, y_i)), vf32x8_loadu(&z2[i])));
+        vf32x8_storu(&z2[i], vf32x8_sub(vf32x8_mul(b2, x_i), vf32x8_mul(a2, y_i)));
+        vf32x8_storu(&out[i], y_i);
+    }
+    biquad_r_scalar(x + i, out + i, z1 + i, z2 + i, coeffs, len - i);
+}
+
+IFX_TARGET_AVX2 static void to_f16_avx2(const ifx_Float_t* x, ifx_Float16_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        _mm_storeu_si128((__m128i*)&out[i], _mm256_cvtps_ph(vf32x8_loadu(&x[i]), _MM_FROUND_TO_NEAREST_INT));
+    to_f16_scalar(x + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void from_f16_avx2(const ifx_Float16_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x8_storu(&out[i], _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)&x[i])));
+    from_f16_scalar(x + i, out + i, len - i);
+}
+
+// the ordered comparisons (_OQ) are false for NaN like the scalar ones
+IFX_TARGET_AVX2 static void peaks_r_avx2(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len)
+{
+    const __m256 t = vf32x8_set1(threshold);
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        const ifx_Float_t* w = x + i;
+        const size_t n = (len - i < 32) ? len - i : 32;
+        uint32_t bits = 0;
+        size_t j = 0;
+        for (; j + 8 <= n; j += 8)
+        {
+            const __m256 c = vf32x8_loadu(&w[j + 2]);
+            __m256 peak = _mm256_and_ps(_mm256_cmp_ps(c, t, _CMP_GE_OQ), _mm256_cmp_ps(c, vf32x8_loadu(&w[j]), _CMP_GE_OQ));
+            peak = _mm256_and_ps(peak, _mm256_cmp_ps(c, vf32x8_loadu(&w[j + 1]), _CMP_GE_OQ));
+            peak = _mm256_and_ps(peak, _mm256_cmp_ps(c, vf32x8_loadu(&w[j + 3]), _CMP_GT_OQ));
+            peak = _mm256_and_ps(peak, _mm256_cmp_ps(c, vf32x8_loadu(&w[j + 4]), _CMP_GT_OQ));
+            bits |= (uint32_t)_mm256_movemask_ps(peak) << j;
+        }
+        mask[i / 32] = bits | peak_bits_scalar(w, threshold, j, n);
+    }
+}
+
+// see monopulse_c_scalar
+IFX_TARGET_AVX2 static inline __m256 monopulse_avx2(__m256 re, __m256 im, __m256 gain)
+{
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    const __m256 are = _mm256_andnot_ps(sign, re);
+    const __m256 aim = _mm256_andnot_ps(sign, im);
+    const __m256 t = _mm256_div_ps(_mm256_min_ps(are, aim), _mm256_max_ps(_mm256_max_ps(are, aim), vf32x8_set1(FLT_MIN)));
+    const __m256 t2 = vf32x8_mul(t, t);
+    __m256 p = vf32x8_set1(atan_coeffs[ATAN_ORDER - 1]);
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+        p = _mm256_fmadd_ps(p, t2, vf32x8_set1(atan_coeffs[k]));
+    __m256 phi = vf32x8_mul(p, t);
+    phi = _mm256_blendv_ps(phi, vf32x8_sub(vf32x8_set1(HALF_PI), phi), _mm256_cmp_ps(aim, are, _CMP_GT_OQ));
+    phi = _mm256_blendv_ps(phi, vf32x8_sub(vf32x8_set1((float)IFX_PI), phi), _mm256_cmp_ps(re, zero, _CMP_LT_OQ));
+    phi = _mm256_xor_ps(phi, _mm256_and_ps(_mm256_cmp_ps(im, zero, _CMP_LT_OQ), sign));
+
+    const __m256 v = vf32x8_mul(gain, phi);
+    const __m256 a = _mm256_andnot_ps(sign, v);
+    const __m256 big = _mm256_cmp_ps(a, vf32x8_set1(0.5f), _CMP_GT_OQ);
+    const __m256 z = _mm256_blendv_ps(vf32x8_mul(a, a), vf32x8_mul(vf32x8_set1(0.5f), vf32x8_sub(vf32x8_set1(1.0f), a)), big);
+    const __m256 s = _mm256_blendv_ps(a, vf32x8_sqrt(z), big);
+    __m256 q = vf32x8_set1(asin_coeffs[ASIN_ORDER - 1]);
+    for (int k = ASIN_ORDER - 2; k >= 0; k--)
+        q = _mm256_fmadd_ps(q, z, vf32x8_set1(asin_coeffs[k]));
+    __m256 r = _mm256_fmadd_ps(vf32x8_mul(s, z), q, s);
+    r = _mm256_blendv_ps(r, vf32x8_sub(vf32x8_set1(HALF_PI), vf32x8_add(r, r)), big);
+    r = _mm256_xor_ps(r, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_LT_OQ), sign));
+
+    return vf32x8_mul(r, vf32x8_set1(RAD2DEG));
+}
+
+/* The shuffles leave the elements in the order 0 1 4 5 2 3 6 7 (see
+ * cabs2_avx2), which is fixed for the angles only.
+ */
+IFX_TARGET_AVX2 static void monopulse_c_avx2(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len)
+{
+    const __m256 g = vf32x8_set1(gain);
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m256 x0 = vf32x8_loadu(CFLOATS(x + i));
+        const __m256 x1 = vf32x8_loadu(CFLOATS(x + i + 4));
+        const __m256 y0 = vf32x8_loadu(CFLOATS(y + i));
+        const __m256 y1 = vf32x8_loadu(CFLOATS(y + i + 4));
+        const __m256 x_re = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 x_im = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m256 y_re = _mm256_shuffle_ps(y0, y1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m256 y_im = _mm256_shuffle_ps(y0, y1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        const __m256 re = _mm256_fmadd_ps(x_re, y_re, vf32x8_mul(x_im, y_im));
+        const __m256 im = _mm256_fmsub_ps(x_im, y_re, vf32x8_mul(x_re, y_im));
+        const __m256 angle = monopulse_avx2(re, im, g);
+        vf32x8_storu(&out[i], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(angle), _MM_SHUFFLE(3, 1, 2, 0))));
+    }
+    monopulse_c_scalar(x + i, y + i, gain, out + i, len - i);
+}
+
+// see log2_scalar
+IFX_TARGET_AVX2 static inline __m256 log2_avx2(__m256 v)
+{
+    const __m256i bits = _mm256_castps_si256(v);
+    const __m256i t = _mm256_sub_epi32(bits, _mm256_set1_epi32((int)LOG2_SQRT_HALF_BITS));
+    const __m256 k = _mm256_cvtepi32_ps(_mm256_srai_epi32(t, 23));
+    const __m256 m = _mm256_castsi256_ps(_mm256_sub_epi32(bits, _mm256_and_si256(t, _mm256_set1_epi32((int)LOG2_EXPONENT_MASK))));
+    const __m256 x = vf32x8_sub(m, vf32x8_set1(1.0f));
+
+    __m256 p = vf32x8_set1(log2_coeffs[LOG2_ORDER - 1]);
+    for (int j = LOG2_ORDER - 2; j >= 0; j--)
+        p = _mm256_fmadd_ps(p, x, vf32x8_set1(log2_coeffs[j]));
+    return _mm256_fmadd_ps(p, x, k);
+}
+
+IFX_TARGET_AVX2 static inline __m256 spectrum_avx2(__m256 abs2, __m256 threshold2, __m256 clip, __m256 factor, bool linear)
+{
+    const __m256 v = linear ? vf32x8_sqrt(abs2) : vf32x8_mul(factor, log2_avx2(abs2));
+    return _mm256_blendv_ps(v, clip, _mm256_cmp_ps(abs2, threshold2, _CMP_LT_OQ));
+}
+
+IFX_TARGET_AVX2 static void spectrum_r_avx2(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m256 t = vf32x8_set1(threshold2);
+    const __m256 c = vf32x8_set1(clip);
+    const __m256 f = vf32x8_set1(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x8_storu(&out[i], spectrum_avx2(vf32x8_loadu(&abs2[i]), t, c, f, linear));
+    spectrum_r_scalar(abs2 + i, threshold2, clip, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void spectrum_c_avx2(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m256 t = vf32x8_set1(threshold2);
+    const __m256 c = vf32x8_set1(clip);
+    const __m256 f = vf32x8_set1(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m256 abs2 = cabs2_avx2(vf32x8_loadu(CFLOATS(x + i)), vf32x8_loadu(CFLOATS(x + i + 4)));
+        vf32x8_storu(&out[i], spectrum_avx2(abs2, t, c, f, linear));
+    }
+    spectrum_c_scalar(x + i, threshold2, clip, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX2 static void stats_r_avx2(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len)
+{
+    const __m256 s = vf32x8_set1(shift);
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i index = _mm256_add_epi32(_mm256_set1_epi32((int)first), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 lo = vf32x8_set1(range[0]);
+    __m256 hi = vf32x8_set1(range[1]);
+    __m256 lo_idx = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    __m256 hi_idx = lo_idx;
+
+    size_t i = 0;
+    while (i + 8 <= len)
+    {
+        const size_t end = (len - i > STATS_BLOCK) ? i + STATS_BLOCK : len;
+        __m256 sum = vf32x8_setzero();
+        __m256 sumsq = vf32x8_setzero();
+        for (; i + 8 <= end; i += 8)
+        {
+            const __m256 v = vf32x8_loadu(&x[i]);
+            const __m256 d = vf32x8_sub(v, s);
+            const __m256 lt = _mm256_cmp_ps(v, lo, _CMP_LT_OQ);
+            const __m256 gt = _mm256_cmp_ps(v, hi, _CMP_GT_OQ);
+            sum = vf32x8_add(sum, d);
+            sumsq = vf32x8_mla(sumsq, d, d);
+            lo = _mm256_blendv_ps(lo, v, lt);
+            hi = _mm256_blendv_ps(hi, v, gt);
+            lo_idx = _mm256_blendv_ps(lo_idx, _mm256_castsi256_ps(index), lt);
+            hi_idx = _mm256_blendv_ps(hi_idx, _mm256_castsi256_ps(index), gt);
+            index = _mm256_add_epi32(index, step);
+        }
+
+        float lanes[8];
+        vf32x8_storu(lanes, sum);
+        sums[0] += sum_lanes(lanes, 8);
+        vf32x8_storu(lanes, sumsq);
+        sums[1] += sum_lanes(lanes, 8);
+    }
+
+    float lo_lanes[8], hi_lanes[8];
+    uint32_t lo_idx_lanes[8], hi_idx_lanes[8];
+    vf32x8_storu(lo_lanes, lo);
+    vf32x8_storu(hi_lanes, hi);
+    vf32x8_storu((float*)lo_idx_lanes, lo_idx);
+    vf32x8_storu((float*)hi_idx_lanes, hi_idx);
+    stats_r_merge(lo_lanes, lo_idx_lanes, hi_lanes, hi_idx_lanes, 8, range, idx);
+
+    stats_r_part(x, shift, first, sums, range, idx, i, len);
+}
+
+static const ifx_Kernels_t kernels_avx2 = {
+    "avx2",
+    mul_r_avx2,
+    mul_c_avx2,
+    scale_c_avx2,
+    mac_c_avx2,
+    abs_c_avx2,
+    abs2_c_avx2,
+    gemm_c_avx2,
+    mti_r_avx2,
+    biquad_r_avx2,
+    to_f16_avx2,
+    from_f16_avx2,
+    peaks_r_avx2,
+    monopulse_c_avx2,
+    spectrum_r_avx2,
+    spectrum_c_avx2,
+    stats_r_avx2,
+};
+
+//----------------------------------------------------------------------------
+
+IFX_TARGET_AVX512 static inline __m512 cmul_avx512(__m512 a, __m512 b_re, __m512 b_im)
+{
+    const __m512 a_swap = _mm512_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm512_fmaddsub_ps(a, b_re, _mm512_mul_ps(a_swap, b_im));
+}
+
+// see cabs2_avx2, here the order after the shuffles is 0 1 8 9 2 3 10 11 ...
+IFX_TARGET_AVX512 static inline __m512 cabs2_avx512(__m512 a, __m512 b)
+{
+    const __m512i order = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+    const __m512 a2 = _mm512_mul_ps(a, a);
+    const __m512 b2 = _mm512_mul_ps(b, b);
+    const __m512 sum = _mm512_add_ps(_mm512_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0)), _mm512_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1)));
+    return _mm512_castpd_ps(_mm512_permutexvar_pd(order, _mm512_castps_pd(sum)));
+}
+
+IFX_TARGET_AVX512 static void mul_r_avx512(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        vf32x16_storu(&out[i], vf32x16_mul(vf32x16_loadu(&x[i]), vf32x16_loadu(&y[i])));
+    mul_r_scalar(x + i, y + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void mul_c_avx512(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m512 b = vf32x16_loadu(CFLOATS(y + i));
+        vf32x16_storu(FLOATS(out + i), cmul_avx512(vf32x16_loadu(CFLOATS(x + i)), _mm512_moveldup_ps(b), _mm512_movehdup_ps(b)));
+    }
+    mul_c_scalar(x + i, y + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void scale_c_avx512(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m512 s_re = vf32x16_set1(IFX_COMPLEX_REAL(scale));
+    const __m512 s_im = vf32x16_set1(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+        vf32x16_storu(FLOATS(out + i), cmul_avx512(vf32x16_loadu(CFLOATS(x + i)), s_re, s_im));
+    scale_c_scalar(x + i, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void mac_c_avx512(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const __m512 s_re = vf32x16_set1(IFX_COMPLEX_REAL(scale));
+    const __m512 s_im = vf32x16_set1(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        const __m512 p = cmul_avx512(vf32x16_loadu(CFLOATS(y + i)), s_re, s_im);
+        vf32x16_storu(FLOATS(out + i), vf32x16_add(vf32x16_loadu(CFLOATS(x + i)), p));
+    }
+    mac_c_scalar(x + i, y + i, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void abs_c_avx512(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        vf32x16_storu(&out[i], vf32x16_sqrt(cabs2_avx512(vf32x16_loadu(CFLOATS(x + i)), vf32x16_loadu(CFLOATS(x + i + 8)))));
+    abs_c_scalar(x + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void abs2_c_avx512(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        vf32x16_storu(&out[i], cabs2_avx512(vf32x16_loadu(CFLOATS(x + i)), vf32x16_loadu(CFLOATS(x + i + 8))));
+    abs2_c_scalar(x + i, out + i, len - i);
+}
+
+/* see gemm_c_sse2, blocks of 16 complex numbers; AVX-512F has no addsub, so
+ * the sums are combined with fmaddsub
+ */
+IFX_TARGET_AVX512 static void gemm_c_avx512(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                                            ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = vf32x16_set1(1.0f);
+    const size_t n16 = n & ~(size_t)15;
+
+    for (size_t i = 0; i < m; i++)
+    {
+        const ifx_Complex_t* a_row = a + i * lda;
+        for (size_t j = 0; j < n16; j += 16)
+        {
+            __m512 re0 = zero, re1 = zero;
+            __m512 im0 = zero, im1 = zero;
+            for (size_t p = 0; p < k; p++)
+            {
+                const __m512 a_re = vf32x16_set1(IFX_COMPLEX_REAL(a_row[p]));
+                const __m512 a_im = vf32x16_set1(IFX_COMPLEX_IMAG(a_row[p]));
+                const __m512 b0 = vf32x16_loadu(CFLOATS(b + p * ldb + j));
+                const __m512 b1 = vf32x16_loadu(CFLOATS(b + p * ldb + j + 8));
+                re0 = vf32x16_mla(re0, b0, a_re);
+                re1 = vf32x16_mla(re1, b1, a_re);
+                im0 = vf32x16_mla(im0, _mm512_permute_ps(b0, _MM_SHUFFLE(2, 3, 0, 1)), a_im);
+                im1 = vf32x16_mla(im1, _mm512_permute_ps(b1, _MM_SHUFFLE(2, 3, 0, 1)), a_im);
+            }
+            // 1 * re -/+ im
+            vf32x16_storu(FLOATS(c + i * ldc + j), _mm512_fmaddsub_ps(one, re0, im0));
+            vf32x16_storu(FLOATS(c + i * ldc + j + 8), _mm512_fmaddsub_ps(one, re1, im1));
+        }
+    }
+    gemm_c_avx2(a, lda, b + n16, ldb, c + n16, ldc, m, n - n16, k);
+}
+
+IFX_TARGET_AVX512 static void mti_r_avx512(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len)
+{
+    const __m512 a = vf32x16_set1(alpha);
+    const __m512 b = vf32x16_set1(1 - alpha);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        const __m512 x_i = vf32x16_loadu(&x[i]);
+        const __m512 history_i = vf32x16_loadu(&history[i]);
+        vf32x16_storu(&out[i], vf32x16_sub(x_i, history_i));
+        vf32x16_storu(&history[i], vf32x16_add(vf32x16_mul(a, x_i), vf32x16_mul(b, history_i)));
+    }
+    mti_r_avx2(x + i, history + i, out + i, alpha, len - i);
+}
+
+IFX_TARGET_AVX512 static void biquad_r_avx512(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len)
+{
+    const __m512 b0 = vf32x16_set1(coeffs[0]);
+    const __m512 b1 = vf32x16_set1(coeffs[1]);
+    const __m512 b2 = vf32x16_set1(coeffs[2]);
+    const __m512 a1 = vf32x16_set1(coeffs[3]);
+    const __m512 a2 = vf32x16_set1(coeffs[4]);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        const __m512 x_i = vf32x16_loadu(&x[i]);
+        const __m512 y_i = vf32x16_add(vf32x16_mul(b0, x_i), vf32x16_loadu(&z1[i]));
+        vf32x16_storu(&z1[i], vf32x16_add(vf32x16_sub(vf32x16_mul(b1, x_i), vf32x16_mul(a1, y_i)), vf32x16_loadu(&z2[i])));
+        vf32x16_storu(&z2[i], vf32x16_sub(vf32x16_mul(b2, x_i), vf32x16_mul(a2, y_i)));
+        vf32x16_storu(&out[i], y_i);
+    }
+    biquad_r_avx2(x + i, out + i, z1 + i, z2 + i, coeffs, len - i);
+}
+
+IFX_TARGET_AVX512 static void to_f16_avx512(const ifx_Float_t* x, ifx_Float16_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        _mm256_storeu_si256((__m256i*)&out[i], _mm512_cvtps_ph(vf32x16_loadu(&x[i]), _MM_FROUND_TO_NEAREST_INT));
+    to_f16_avx2(x + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void from_f16_avx512(const ifx_Float16_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        vf32x16_storu(&out[i], _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)&x[i])));
+    from_f16_avx2(x + i, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void peaks_r_avx512(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len)
+{
+    const __m512 t = vf32x16_set1(threshold);
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        const ifx_Float_t* w = x + i;
+        const size_t n = (len - i < 32) ? len - i : 32;
+        uint32_t bits = 0;
+        size_t j = 0;
+        for (; j + 16 <= n; j += 16)
+        {
+            const __m512 c = vf32x16_loadu(&w[j + 2]);
+            __mmask16 peak = _mm512_cmp_ps_mask(c, t, _CMP_GE_OQ);
+            peak = _mm512_mask_cmp_ps_mask(peak, c, vf32x16_loadu(&w[j]), _CMP_GE_OQ);
+            peak = _mm512_mask_cmp_ps_mask(peak, c, vf32x16_loadu(&w[j + 1]), _CMP_GE_OQ);
+            peak = _mm512_mask_cmp_ps_mask(peak, c, vf32x16_loadu(&w[j + 3]), _CMP_GT_OQ);
+            peak = _mm512_mask_cmp_ps_mask(peak, c, vf32x16_loadu(&w[j + 4]), _CMP_GT_OQ);
+            bits |= (uint32_t)peak << j;
+        }
+        mask[i / 32] = bits | peak_bits_scalar(w, threshold, j, n);
+    }
+}
+
+/* see monopulse_c_scalar, AVX-512F has no floating point and/xor, so
+ * the signs are flipped with masked subtractions
+ */
+IFX_TARGET_AVX512 static inline __m512 monopulse_avx512(__m512 re, __m512 im, __m512 gain)
+{
+    const __m512 zero = _mm512_setzero_ps();
+
+    const __m512 are = _mm512_abs_ps(re);
+    const __m512 aim = _mm512_abs_ps(im);
+    const __m512 t = _mm512_div_ps(_mm512_min_ps(are, aim), _mm512_max_ps(_mm512_max_ps(are, aim), vf32x16_set1(FLT_MIN)));
+    const __m512 t2 = vf32x16_mul(t, t);
+    __m512 p = vf32x16_set1(atan_coeffs[ATAN_ORDER - 1]);
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+        p = _mm512_fmadd_ps(p, t2, vf32x16_set1(atan_coeffs[k]));
+    __m512 phi = vf32x16_mul(p, t);
+    phi = _mm512_mask_sub_ps(phi, _mm512_cmp_ps_mask(aim, are, _CMP_GT_OQ), vf32x16_set1(HALF_PI), phi);
+    phi = _mm512_mask_sub_ps(phi, _mm512_cmp_ps_mask(re, zero, _CMP_LT_OQ), vf32x16_set1((float)IFX_PI), phi);
+    phi = _mm512_mask_sub_ps(phi, _mm512_cmp_ps_mask(im, zero, _CMP_LT_OQ), zero, phi);
+
+    const __m512 v = vf32x16_mul(gain, phi);
+    const __m512 a = _mm512_abs_ps(v);
+    const __mmask16 big = _mm512_cmp_ps_mask(a, vf32x16_set1(0.5f), _CMP_GT_OQ);
+    const __m512 z = _mm512_mask_mul_ps(vf32x16_mul(a, a), big, vf32x16_set1(0.5f), vf32x16_sub(vf32x16_set1(1.0f), a));
+    const __m512 s = _mm512_mask_sqrt_ps(a, big, z);
+    __m512 q = vf32x16_set1(asin_coeffs[ASIN_ORDER - 1]);
+    for (int k = ASIN_ORDER - 2; k >= 0; k--)
+        q = _mm512_fmadd_ps(q, z, vf32x16_set1(asin_coeffs[k]));
+    __m512 r = _mm512_fmadd_ps(vf32x16_mul(s, z), q, s);
+    r = _mm512_mask_sub_ps(r, big, vf32x16_set1(HALF_PI), vf32x16_add(r, r));
+    r = _mm512_mask_sub_ps(r, _mm512_cmp_ps_mask(v, zero, _CMP_LT_OQ), zero, r);
+
+    return vf32x16_mul(r, vf32x16_set1(RAD2DEG));
+}
+
+// see monopulse_c_avx2 and cabs2_avx512 for the order of the elements
+IFX_TARGET_AVX512 static void monopulse_c_avx512(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len)
+{
+    const __m512i order = _mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0);
+    const __m512 g = vf32x16_set1(gain);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        const __m512 x0 = vf32x16_loadu(CFLOATS(x + i));
+        const __m512 x1 = vf32x16_loadu(CFLOATS(x + i + 8));
+        const __m512 y0 = vf32x16_loadu(CFLOATS(y + i));
+        const __m512 y1 = vf32x16_loadu(CFLOATS(y + i + 8));
+        const __m512 x_re = _mm512_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m512 x_im = _mm512_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m512 y_re = _mm512_shuffle_ps(y0, y1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m512 y_im = _mm512_shuffle_ps(y0, y1, _MM_SHUFFLE(3, 1, 3, 1));
+
+        const __m512 re = _mm512_fmadd_ps(x_re, y_re, vf32x16_mul(x_im, y_im));
+        const __m512 im = _mm512_fmsub_ps(x_im, y_re, vf32x16_mul(x_re, y_im));
+        const __m512 angle = monopulse_avx512(re, im, g);
+        vf32x16_storu(&out[i], _mm512_castpd_ps(_mm512_permutexvar_pd(order, _mm512_castps_pd(angle))));
+    }
+    monopulse_c_avx2(x + i, y + i, gain, out + i, len - i);
+}
+
+// see log2_scalar
+IFX_TARGET_AVX512 static inline __m512 log2_avx512(__m512 v)
+{
+    const __m512i bits = _mm512_castps_si512(v);
+    const __m512i t = _mm512_sub_epi32(bits, _mm512_set1_epi32((int)LOG2_SQRT_HALF_BITS));
+    const __m512 k = _mm512_cvtepi32_ps(_mm512_srai_epi32(t, 23));
+    const __m512 m = _mm512_castsi512_ps(_mm512_sub_epi32(bits, _mm512_and_si512(t, _mm512_set1_epi32((int)LOG2_EXPONENT_MASK))));
+    const __m512 x = vf32x16_sub(m, vf32x16_set1(1.0f));
+
+    __m512 p = vf32x16_set1(log2_coeffs[LOG2_ORDER - 1]);
+    for (int j = LOG2_ORDER - 2; j >= 0; j--)
+        p = _mm512_fmadd_ps(p, x, vf32x16_set1(log2_coeffs[j]));
+    return _mm512_fmadd_ps(p, x, k);
+}
+
+IFX_TARGET_AVX512 static inline __m512 spectrum_avx512(__m512 abs2, __m512 threshold2, __m512 clip, __m512 factor, bool linear)
+{
+    const __m512 v = linear ? vf32x16_sqrt(abs2) : vf32x16_mul(factor, log2_avx512(abs2));
+    return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(abs2, threshold2, _CMP_LT_OQ), v, clip);
+}
+
+IFX_TARGET_AVX512 static void spectrum_r_avx512(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m512 t = vf32x16_set1(threshold2);
+    const __m512 c = vf32x16_set1(clip);
+    const __m512 f = vf32x16_set1(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+        vf32x16_storu(&out[i], spectrum_avx512(vf32x16_loadu(&abs2[i]), t, c, f, linear));
+    spectrum_r_avx2(abs2 + i, threshold2, clip, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void spectrum_c_avx512(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const __m512 t = vf32x16_set1(threshold2);
+    const __m512 c = vf32x16_set1(clip);
+    const __m512 f = vf32x16_set1(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        const __m512 abs2 = cabs2_avx512(vf32x16_loadu(CFLOATS(x + i)), vf32x16_loadu(CFLOATS(x + i + 8)));
+        vf32x16_storu(&out[i], spectrum_avx512(abs2, t, c, f, linear));
+    }
+    spectrum_c_avx2(x + i, threshold2, clip, scale, out + i, len - i);
+}
+
+IFX_TARGET_AVX512 static void stats_r_avx512(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len)
+{
+    const __m512 s = vf32x16_set1(shift);
+    const __m512i step = _mm512_set1_epi32(16);
+    __m512i index = _mm512_add_epi32(_mm512_set1_epi32((int)first), _mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+    __m512 lo = vf32x16_set1(range[0]);
+    __m512 hi = vf32x16_set1(range[1]);
+    __m512i lo_idx = _mm512_set1_epi32(-1);
+    __m512i hi_idx = lo_idx;
+
+    size_t i = 0;
+    while (i + 16 <= len)
+    {
+        const size_t end = (len - i > STATS_BLOCK) ? i + STATS_BLOCK : len;
+        __m512 sum = _mm512_setzero_ps();
+        __m512 sumsq = _mm512_setzero_ps();
+        for (; i + 16 <= end; i += 16)
+        {
+            const __m512 v = vf32x16_loadu(&x[i]);
+            const __m512 d = vf32x16_sub(v, s);
+            const __mmask16 lt = _mm512_cmp_ps_mask(v, lo, _CMP_LT_OQ);
+            const __mmask16 gt = _mm512_cmp_ps_mask(v, hi, _CMP_GT_OQ);
+            sum = vf32x16_add(sum, d);
+            sumsq = vf32x16_mla(sumsq, d, d);
+            lo = _mm512_mask_mov_ps(lo, lt, v);
+            hi = _mm512_mask_mov_ps(hi, gt, v);
+            lo_idx = _mm512_mask_mov_epi32(lo_idx, lt, index);
+            hi_idx = _mm512_mask_mov_epi32(hi_idx, gt, index);
+            index = _mm512_add_epi32(index, step);
+        }
+
+        float lanes[16];
+        vf32x16_storu(lanes, sum);
+        sums[0] += sum_lanes(lanes, 16);
+        vf32x16_storu(lanes, sumsq);
+        sums[1] += sum_lanes(lanes, 16);
+    }
+
+    float lo_lanes[16], hi_lanes[16];
+    uint32_t lo_idx_lanes[16], hi_idx_lanes[16];
+    vf32x16_storu(lo_lanes, lo);
+    vf32x16_storu(hi_lanes, hi);
+    _mm512_storeu_si512(lo_idx_lanes, lo_idx);
+    _mm512_storeu_si512(hi_idx_lanes, hi_idx);
+    stats_r_merge(lo_lanes, lo_idx_lanes, hi_lanes, hi_idx_lanes, 16, range, idx);
+
+    stats_r_avx2(x + i, shift, first + (uint32_t)i, sums, range, idx, len - i);
+}
+
+static const ifx_Kernels_t kernels_avx512 = {
+    "avx512",
+    mul_r_avx512,
+    mul_c_avx512,
+    scale_c_avx512,
+    mac_c_avx512,
+    abs_c_avx512,
+    abs2_c_avx512,
+    gemm_c_avx512,
+    mti_r_avx512,
+    biquad_r_avx512,
+    to_f16_avx512,
+    from_f16_avx512,
+    peaks_r_avx512,
+    monopulse_c_avx512,
+    spectrum_r_avx512,
+    spectrum_c_avx512,
+    stats_r_avx512,
+};
+
+//----------------------------------------------------------------------------
+
+/* AVX needs support by the operating system (saving the registers on context
+ * switches), which is checked with xgetbv.
+ */
+static bool cpu_has(const char* isa)
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool f16c = (info[2] & (1 << 29)) != 0;
+    if (!osxsave)
+        return false;
+
+    const unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (!strcmp(isa, "avx2"))
+        return fma && f16c && ((xcr0 & 0x6) == 0x6) && (info[1] & (1 << 5));
+    else if (!strcmp(isa, "avx512"))
+        return ((xcr0 & 0xe6) == 0xe6) && (info[1] & (1 << 16));
+    return false;
+#else
+    __builtin_cpu_init();
+    if (!strcmp(isa, "avx2"))
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && __builtin_cpu_supports("f16c");
+    else if (!strcmp(isa, "avx512"))
+        return __builtin_cpu_supports("avx512f");
+    return false;
+#endif
+}
+#endif
+
+#ifdef IFX_NEON
+//----------------------------------------------------------------------------
+
+/* vld2q/vst2q split interleaved complex numbers into real and imaginary
+ * parts, so no shuffling is needed.
+ */
+static void mul_r_neon(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1q_f32(&out[i], vmulq_f32(vld1q_f32(&x[i]), vld1q_f32(&y[i])));
+    mul_r_scalar(x + i, y + i, out + i, len - i);
+}
+
+static inline float32x4x2_t cmul_neon(float32x4x2_t a, float32x4_t b_re, float32x4_t b_im)
+{
+    float32x4x2_t p;
+    p.val[0] = vmlsq_f32(vmulq_f32(a.val[0], b_re), a.val[1], b_im);
+    p.val[1] = vmlaq_f32(vmulq_f32(a.val[0], b_im), a.val[1], b_re);
+    return p;
+}
+
+static void mul_c_neon(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4x2_t b = vld2q_f32(CFLOATS(y + i));
+        vst2q_f32(FLOATS(out + i), cmul_neon(vld2q_f32(CFLOATS(x + i)), b.val[0], b.val[1]));
+    }
+    mul_c_scalar(x + i, y + i, out + i, len - i);
+}
+
+static void scale_c_neon(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const float32x4_t s_re = vdupq_n_f32(IFX_COMPLEX_REAL(scale));
+    const float32x4_t s_im = vdupq_n_f32(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst2q_f32(FLOATS(out + i), cmul_neon(vld2q_f32(CFLOATS(x + i)), s_re, s_im));
+    scale_c_scalar(x + i, scale, out + i, len - i);
+}
+
+static void mac_c_neon(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len)
+{
+    const float32x4_t s_re = vdupq_n_f32(IFX_COMPLEX_REAL(scale));
+    const float32x4_t s_im = vdupq_n_f32(IFX_COMPLEX_IMAG(scale));
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        float32x4x2_t a = vld2q_f32(CFLOATS(x + i));
+        const float32x4x2_t p = cmul_neon(vld2q_f32(CFLOATS(y + i)), s_re, s_im);
+        a.val[0] = vaddq_f32(a.val[0], p.val[0]);
+        a.val[1] = vaddq_f32(a.val[1], p.val[1]);
+        vst2q_f32(FLOATS(out + i), a);
+    }
+    mac_c_scalar(x + i, y + i, scale, out + i, len - i);
+}
+
+static void abs2_c_neon(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(CFLOATS(x + i));
+        vst1q_f32(&out[i], vmlaq_f32(vmulq_f32(a.val[0], a.val[0]), a.val[1], a.val[1]));
+    }
+    abs2_c_scalar(x + i, out + i, len - i);
+}
+
+// 32 bit ARM has no vector square root
+#if defined(__aarch64__) || defined(_M_ARM64)
+static void abs_c_neon(const ifx_Complex_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(CFLOATS(x + i));
+        vst1q_f32(&out[i], vsqrtq_f32(vmlaq_f32(vmulq_f32(a.val[0], a.val[0]), a.val[1], a.val[1])));
+    }
+    abs_c_scalar(x + i, out + i, len - i);
+}
+#else
+#define abs_c_neon abs_c_scalar
+#endif
+
+// blocks of 4 complex numbers, split into real and imaginary parts
+static void gemm_c_neon(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                        ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k)
+{
+    const size_t n4 = n & ~(size_t)3;
+
+    for (size_t i = 0; i < m; i++)
+    {
+        const ifx_Complex_t* a_row = a + i * lda;
+        for (size_t j = 0; j < n4; j += 4)
+        {
+            float32x4x2_t sum;
+            sum.val[0] = vdupq_n_f32(0.0f);
+            sum.val[1] = vdupq_n_f32(0.0f);
+            for (size_t p = 0; p < k; p++)
+            {
+                const float32x4_t a_re = vdupq_n_f32(IFX_COMPLEX_REAL(a_row[p]));
+                const float32x4_t a_im = vdupq_n_f32(IFX_COMPLEX_IMAG(a_row[p]));
+                const float32x4x2_t bv = vld2q_f32(CFLOATS(b + p * ldb + j));
+                sum.val[0] = vmlsq_f32(vmlaq_f32(sum.val[0], bv.val[0], a_re), bv.val[1], a_im);
+                sum.val[1] = vmlaq_f32(vmlaq_f32(sum.val[1], bv.val[0], a_im), bv.val[1], a_re);
+            }
+            vst2q_f32(FLOATS(c + i * ldc + j), sum);
+        }
+    }
+    gemm_c_scalar(a, lda, b + n4, ldb, c + n4, ldc, m, n - n4, k);
+}
+
+static void mti_r_neon(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len)
+{
+    const float32x4_t a = vdupq_n_f32(alpha);
+    const float32x4_t b = vdupq_n_f32(1 - alpha);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4_t x_i = vld1q_f32(&x[i]);
+        const float32x4_t history_i = vld1q_f32(&history[i]);
+        vst1q_f32(&out[i], vsubq_f32(x_i, history_i));
+        vst1q_f32(&history[i], vaddq_f32(vmulq_f32(a, x_i), vmulq_f32(b, history_i)));
+    }
+    mti_r_scalar(x + i, history + i, out + i, alpha, len - i);
+}
+
+static void biquad_r_neon(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len)
+{
+    const float32x4_t b0 = vdupq_n_f32(coeffs[0]);
+    const float32x4_t b1 = vdupq_n_f32(coeffs[1]);
+    const float32x4_t b2 = vdupq_n_f32(coeffs[2]);
+    const float32x4_t a1 = vdupq_n_f32(coeffs[3]);
+    const float32x4_t a2 = vdupq_n_f32(coeffs[4]);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4_t x_i = vld1q_f32(&x[i]);
+        const float32x4_t y_i = vaddq_f32(vmulq_f32(b0, x_i), vld1q_f32(&z1[i]));
+        vst1q_f32(&z1[i], vaddq_f32(vsubq_f32(vmulq_f32(b1, x_i), vmulq_f32(a1, y_i)), vld1q_f32(&z2[i])));
+        vst1q_f32(&z2[i], vsubq_f32(vmulq_f32(b2, x_i), vmulq_f32(a2, y_i)));
+        vst1q_f32(&out[i], y_i);
+    }
+    biquad_r_scalar(x + i, out + i, z1 + i, z2 + i, coeffs, len - i);
+}
+
+// half precision conversions are part of AArch64, on 32 bit ARM they are optional
+#if defined(__aarch64__) || defined(_M_ARM64)
+static void to_f16_neon(const ifx_Float_t* x, ifx_Float16_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1_u16(&out[i], vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(&x[i]))));
+    to_f16_scalar(x + i, out + i, len - i);
+}
+
+static void from_f16_neon(const ifx_Float16_t* x, ifx_Float_t* out, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1q_f32(&out[i], vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(&x[i]))));
+    from_f16_scalar(x + i, out + i, len - i);
+}
+#else
+#define to_f16_neon   to_f16_scalar
+#define from_f16_neon from_f16_scalar
+#endif
+
+// division and square root of vectors are part of AArch64 only
+#if defined(__aarch64__) || defined(_M_ARM64)
+// see monopulse_c_scalar
+static inline float32x4_t monopulse_neon(float32x4_t re, float32x4_t im, float32x4_t gain)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    const float32x4_t are = vabsq_f32(re);
+    const float32x4_t aim = vabsq_f32(im);
+    const float32x4_t t = vdivq_f32(vminq_f32(are, aim), vmaxq_f32(vmaxq_f32(are, aim), vdupq_n_f32(FLT_MIN)));
+    const float32x4_t t2 = vmulq_f32(t, t);
+    float32x4_t p = vdupq_n_f32(atan_coeffs[ATAN_ORDER - 1]);
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+        p = vaddq_f32(vmulq_f32(p, t2), vdupq_n_f32(atan_coeffs[k]));
+    float32x4_t phi = vmulq_f32(p, t);
+    phi = vbslq_f32(vcgtq_f32(aim, are), vsubq_f32(vdupq_n_f32(HALF_PI), phi), phi);
+    phi = vbslq_f32(vcltq_f32(re, zero), vsubq_f32(vdupq_n_f32((float)IFX_PI), phi), phi);
+    phi = vbslq_f32(vcltq_f32(im, zero), vnegq_f32(phi), phi);
+
+    const float32x4_t v = vmulq_f32(gain, phi);
+    const float32x4_t a = vabsq_f32(v);
+    const uint32x4_t big = vcgtq_f32(a, vdupq_n_f32(0.5f));
+    const float32x4_t z = vbslq_f32(big, vmulq_f32(vdupq_n_f32(0.5f), vsubq_f32(vdupq_n_f32(1.0f), a)), vmulq_f32(a, a));
+    const float32x4_t s = vbslq_f32(big, vsqrtq_f32(z), a);
+    float32x4_t q = vdupq_n_f32(asin_coeffs[ASIN_ORDER - 1]);
+    for (int k = ASIN_ORDER - 2; k >= 0; k--)
+        q = vaddq_f32(vmulq_f32(q, z), vdupq_n_f32(asin_coeffs[k]));
+    float32x4_t r = vaddq_f32(s, vmulq_f32(vmulq_f32(s, z), q));
+    r = vbslq_f32(big, vsubq_f32(vdupq_n_f32(HALF_PI), vaddq_f32(r, r)), r);
+    r = vbslq_f32(vcltq_f32(v, zero), vnegq_f32(r), r);
+
+    return vmulq_f32(r, vdupq_n_f32(RAD2DEG));
+}
+
+static void monopulse_c_neon(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len)
+{
+    const float32x4_t g = vdupq_n_f32(gain);
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(CFLOATS(x + i));
+        const float32x4x2_t b = vld2q_f32(CFLOATS(y + i));
+
+        const float32x4_t re = vaddq_f32(vmulq_f32(a.val[0], b.val[0]), vmulq_f32(a.val[1], b.val[1]));
+        const float32x4_t im = vsubq_f32(vmulq_f32(a.val[1], b.val[0]), vmulq_f32(a.val[0], b.val[1]));
+        vst1q_f32(&out[i], monopulse_neon(re, im, g));
+    }
+    monopulse_c_scalar(x + i, y + i, gain, out + i, len - i);
+}
+#else
+#define monopulse_c_neon monopulse_c_scalar
+#endif
+
+// NEON has no movemask, the lanes are weighted with their bits and summed up
+static inline uint32_t movemask_neon(uint32x4_t m)
+{
+    const uint32_t weights[4] = {1, 2, 4, 8};
+    const uint32x4_t b = vandq_u32(m, vld1q_u32(weights));
+    const uint32x2_t s = vpadd_u32(vget_low_u32(b), vget_high_u32(b));
+    return vget_lane_u32(vpadd_u32(s, s), 0);
+}
+
+static void peaks_r_neon(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len)
+{
+    const float32x4_t t = vdupq_n_f32(threshold);
+
+    for (size_t i = 0; i < len; i += 32)
+    {
+        const ifx_Float_t* w = x + i;
+        const size_t n = (len - i < 32) ? len - i : 32;
+        uint32_t bits = 0;
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4)
+        {
+            const float32x4_t c = vld1q_f32(&w[j + 2]);
+            uint32x4_t peak = vandq_u32(vcgeq_f32(c, t), vcgeq_f32(c, vld1q_f32(&w[j])));
+            peak = vandq_u32(peak, vcgeq_f32(c, vld1q_f32(&w[j + 1])));
+            peak = vandq_u32(peak, vcgtq_f32(c, vld1q_f32(&w[j + 3])));
+            peak = vandq_u32(peak, vcgtq_f32(c, vld1q_f32(&w[j + 4])));
+            bits |= movemask_neon(peak) << j;
+        }
+        mask[i / 32] = bits | peak_bits_scalar(w, threshold, j, n);
+    }
+}
+
+// see log2_scalar
+static inline float32x4_t log2_neon(float32x4_t v)
+{
+    const uint32x4_t bits = vreinterpretq_u32_f32(v);
+    const uint32x4_t t = vsubq_u32(bits, vdupq_n_u32(LOG2_SQRT_HALF_BITS));
+    const float32x4_t k = vcvtq_f32_s32(vshrq_n_s32(vreinterpretq_s32_u32(t), 23));
+    const float32x4_t m = vreinterpretq_f32_u32(vsubq_u32(bits, vandq_u32(t, vdupq_n_u32(LOG2_EXPONENT_MASK))));
+    const float32x4_t x = vsubq_f32(m, vdupq_n_f32(1.0f));
+
+    float32x4_t p = vdupq_n_f32(log2_coeffs[LOG2_ORDER - 1]);
+    for (int j = LOG2_ORDER - 2; j >= 0; j--)
+        p = vmlaq_f32(vdupq_n_f32(log2_coeffs[j]), p, x);
+    return vmlaq_f32(k, p, x);
+}
+
+// 32 bit ARM has no vector square root, the linear spectrum is computed by the scalar kernels there
+static inline float32x4_t spectrum_neon(float32x4_t abs2, float32x4_t threshold2, float32x4_t clip, float32x4_t factor, bool linear)
+{
+#if defined(__aarch64__) || defined(_M_ARM64)
+    const float32x4_t v = linear ? vsqrtq_f32(abs2) : vmulq_f32(factor, log2_neon(abs2));
+#else
+    (void)linear;
+    const float32x4_t v = vmulq_f32(factor, log2_neon(abs2));
+#endif
+    return vbslq_f32(vcltq_f32(abs2, threshold2), clip, v);
+}
+
+static void spectrum_r_neon(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const float32x4_t t = vdupq_n_f32(threshold2);
+    const float32x4_t c = vdupq_n_f32(clip);
+    const float32x4_t f = vdupq_n_f32(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+#if !defined(__aarch64__) && !defined(_M_ARM64)
+    if (linear)
+    {
+        spectrum_r_scalar(abs2, threshold2, clip, scale, out, len);
+        return;
+    }
+#endif
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+        vst1q_f32(&out[i], spectrum_neon(vld1q_f32(&abs2[i]), t, c, f, linear));
+    spectrum_r_scalar(abs2 + i, threshold2, clip, scale, out + i, len - i);
+}
+
+static void spectrum_c_neon(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len)
+{
+    const float32x4_t t = vdupq_n_f32(threshold2);
+    const float32x4_t c = vdupq_n_f32(clip);
+    const float32x4_t f = vdupq_n_f32(scale * LOG10_2);
+    const bool linear = (scale == 0);
+
+#if !defined(__aarch64__) && !defined(_M_ARM64)
+    if (linear)
+    {
+        spectrum_c_scalar(x, threshold2, clip, scale, out, len);
+        return;
+    }
+#endif
+
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        const float32x4x2_t a = vld2q_f32(CFLOATS(x + i));
+        const float32x4_t abs2 = vmlaq_f32(vmulq_f32(a.val[0], a.val[0]), a.val[1], a.val[1]);
+        vst1q_f32(&out[i], spectrum_neon(abs2, t, c, f, linear));
+    }
+    spectrum_c_scalar(x + i, threshold2, clip, scale, out + i, len - i);
+}
+
+static void stats_r_neon(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len)
+{
+    static const uint32_t lane[4] = {0, 1, 2, 3};
+    const float32x4_t s = vdupq_n_f32(shift);
+    const uint32x4_t step = vdupq_n_u32(4);
+    uint32x4_t index = vaddq_u32(vdupq_n_u32(first), vld1q_u32(lane));
+    float32x4_t lo = vdupq_n_f32(range[0]);
+    float32x4_t hi = vdupq_n_f32(range[1]);
+    uint32x4_t lo_idx = vdupq_n_u32(STATS_NONE);
+    uint32x4_t hi_idx = lo_idx;
+
+    size_t i = 0;
+    while (i + 4 <= len)
+    {
+        const size_t end = (len - i > STATS_BLOCK) ? i + STATS_BLOCK : len;
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        float32x4_t sumsq = vdupq_n_f32(0.0f);
+        for (; i + 4 <= end; i += 4)
+        {
+            const float32x4_t v = vld1q_f32(&x[i]);
+            const float32x4_t d = vsubq_f32(v, s);
+            const uint32x4_t lt = vcltq_f32(v, lo);
+            const uint32x4_t gt = vcgtq_f32(v, hi);
+            sum = vaddq_f32(sum, d);
+            sumsq = vmlaq_f32(sumsq, d, d);
+            lo = vbslq_f32(lt, v, lo);
+            hi = vbslq_f32(gt, v, hi);
+            lo_idx = vbslq_u32(lt, index, lo_idx);
+            hi_idx = vbslq_u32(gt, index, hi_idx);
+            index = vaddq_u32(index, step);
+        }
+
+        float lanes[4];
+        vst1q_f32(lanes, sum);
+        sums[0] += sum_lanes(lanes, 4);
+        vst1q_f32(lanes, sumsq);
+        sums[1] += sum_lanes(lanes, 4);
+    }
+
+    float lo_lanes[4], hi_lanes[4];
+    uint32_t lo_idx_lanes[4], hi_idx_lanes[4];
+    vst1q_f32(lo_lanes, lo);
+    vst1q_f32(hi_lanes, hi);
+    vst1q_u32(lo_idx_lanes, lo_idx);
+    vst1q_u32(hi_idx_lanes, hi_idx);
+    stats_r_merge(lo_lanes, lo_idx_lanes, hi_lanes, hi_idx_lanes, 4, range, idx);
+
+    stats_r_part(x, shift, first, sums, range, idx, i, len);
+}
+
+static const ifx_Kernels_t kernels_neon = {
+    "neon",
+    mul_r_neon,
+    mul_c_neon,
+    scale_c_neon,
+    mac_c_neon,
+    abs_c_neon,
+    abs2_c_neon,
+    gemm_c_neon,
+    mti_r_neon,
+    biquad_r_neon,
+    to_f16_neon,
+    from_f16_neon,
+    peaks_r_neon,
+    monopulse_c_neon,
+    spectrum_r_neon,
+    spectrum_c_neon,
+    stats_r_neon,
+};
+#endif
+
+//----------------------------------------------------------------------------
+
+static const ifx_Kernels_t* detect_kernels(void)
+{
+    const ifx_Kernels_t* available[4];
+    size_t count = 0;
+
+    // fastest first
+#ifdef IFX_X86_DISPATCH
+    if (cpu_has("avx512"))
+        available[count++] = &kernels_avx512;
+    if (cpu_has("avx2"))
+        available[count++] = &kernels_avx2;
+#endif
+#ifdef IFX_SSE2
+    available[count++] = &kernels_sse2;
+#endif
+#ifdef IFX_NEON
+    available[count++] = &kernels_neon;
+#endif
+    available[count++] = &kernels_scalar;
+
+    const char* name = getenv("IFX_SIMD");
+    for (size_t i = 0; name && i < count; i++)
+    {
+        if (!strcmp(name, available[i]->name))
+            return available[i];
+    }
+
+    return available[0];
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const ifx_Kernels_t* ifx_kernels_get(void)
+{
+    /* Concurrent first calls detect the same kernels, so the race on the
+     * assignment is harmless.
+     */
+    static const ifx_Kernels_t* volatile kernels = NULL;
+
+    if (kernels == NULL)
+        kernels = detect_kernels();
+
+    return kernels;
+}
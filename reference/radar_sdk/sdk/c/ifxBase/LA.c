@@ -38,7 +38,9 @@
 #include "Complex.h"
 #include "Defines.h"
 #include "Error.h"
+#include "internal/ComplexInline.h"
 #include "internal/Macros.h"
+#include "internal/SmallLA.h"
 #include "Math.h"
 #include "Matrix.h"
 #include "Mem.h"
@@ -328,7 +330,7 @@ static void lu_c_inplace(ifx_Matrix_C_t* A,
             for (uint32_t k = i + 1; k < N; k++)
             {
                 // IFX_MAT_AT(A, P[j], k) -= IFX_MAT_AT(A, P[j], i) * IFX_MAT_AT(A, P[i], k);
-                IFX_MAT_AT(A, P[j], k) = ifx_complex_sub(IFX_MAT_AT(A, P[j], k), ifx_complex_mul(IFX_MAT_AT(A, P[j], i), IFX_MAT_AT(A, P[i], k)));
+                IFX_MAT_AT(A, P[j], k) = ifx_csub(IFX_MAT_AT(A, P[j], k), ifx_cmul(IFX_MAT_AT(A, P[j], i), IFX_MAT_AT(A, P[i], k)));
             }
         }
     }
@@ -498,7 +500,7 @@ static void lu_invert_c(const ifx_Matrix_C_t* LU,
             for (uint32_t k = 0; k < i; k++)
             {
                 // IFX_MAT_AT(inverse, i, j) -= IFX_MAT_AT(LU, P[i], k) * IFX_MAT_AT(inverse, k, j);
-                IFX_MAT_AT(inverse, i, j) = ifx_complex_sub(IFX_MAT_AT(inverse, i, j), ifx_complex_mul(IFX_MAT_AT(LU, P[i], k), IFX_MAT_AT(inverse, k, j)));
+                IFX_MAT_AT(inverse, i, j) = ifx_csub(IFX_MAT_AT(inverse, i, j), ifx_cmul(IFX_MAT_AT(LU, P[i], k), IFX_MAT_AT(inverse, k, j)));
             }
         }
 
@@ -509,7 +511,7 @@ static void lu_invert_c(const ifx_Matrix_C_t* LU,
             for (uint32_t k = i + 1; k < N; k++)
             {
                 // IFX_MAT_AT(inverse, i, j) -= IFX_MAT_AT(LU, P[i], k) * IFX_MAT_AT(inverse, k, j);
-                IFX_MAT_AT(inverse, i, j) = ifx_complex_sub(IFX_MAT_AT(inverse, i, j), ifx_complex_mul(IFX_MAT_AT(LU, P[i], k), IFX_MAT_AT(inverse, k, j)));
+                IFX_MAT_AT(inverse, i, j) = ifx_csub(IFX_MAT_AT(inverse, i, j), ifx_cmul(IFX_MAT_AT(LU, P[i], k), IFX_MAT_AT(inverse, k, j)));
             }
 
             // IFX_MAT_AT(inverse, i, j) = IFX_MAT_AT(inverse, i, j) / IFX_MAT_AT(LU, P[i], i);
@@ -615,7 +617,7 @@ static void cholesky_c_inplace(ifx_Matrix_C_t* A)
                 // sum -= IFX_MAT_AT(A, i, k) * IFX_MAT_AT(A, j, k);
                 const ifx_Complex_t Aik = IFX_MAT_AT(A, i, k);
                 const ifx_Complex_t Ajk = IFX_MAT_AT(A, j, k);
-                sum_c = ifx_complex_sub(sum_c, ifx_complex_mul(ifx_complex_conj(Aik), Ajk));
+                sum_c = ifx_csub(sum_c, ifx_cmul(ifx_cconj(Aik), Ajk));
             }
 
             if (i == j)
@@ -773,12 +775,12 @@ static void determinant_c_inplace(ifx_Matrix_C_t* A,
 
     for (uint32_t j = 0; j < N; j++)
     {
-        *determinant = ifx_complex_mul(*determinant, IFX_MAT_AT(A, P[j], j));
+        *determinant = ifx_cmul(*determinant, IFX_MAT_AT(A, P[j], j));
     }
 
     if (S % 2)
     {
-        *determinant = ifx_complex_mul_real(*determinant, -1);
+        *determinant = ifx_cscale(*determinant, -1);
     }
 
 fail:
@@ -804,6 +806,11 @@ void ifx_la_invert_r(const ifx_Matrix_R_t* A,
     IFX_MAT_BRK_SQUARE(Ainv);
     IFX_MAT_BRK_DIM_COL(A, Ainv);
 
+    if (ifx_la_small_invert_r(A, Ainv))
+    {
+        return;
+    }
+
     // Dimension
     uint32_t N = mCols(A);
 
@@ -847,6 +854,11 @@ void ifx_la_invert_c(const ifx_Matrix_C_t* A,
     IFX_MAT_BRK_SQUARE(Ainv);
     IFX_MAT_BRK_DIM_COL(A, Ainv);
 
+    if (ifx_la_small_invert_c(A, Ainv))
+    {
+        return;
+    }
+
     // Dimension
     uint32_t N = mCols(A);
 
@@ -890,6 +902,11 @@ void ifx_la_cholesky_r(const ifx_Matrix_R_t* A,
     IFX_MAT_BRK_SQUARE(L);
     IFX_MAT_BRK_DIM_COL(A, L);
 
+    if (ifx_la_small_cholesky_r(A, L))
+    {
+        return;
+    }
+
     // Dimension
     const uint32_t N = mRows(A);
 
@@ -920,6 +937,11 @@ void ifx_la_cholesky_c(const ifx_Matrix_C_t* A, ifx_Matrix_C_t* L)
     IFX_MAT_BRK_SQUARE(L);
     IFX_MAT_BRK_DIM_COL(A, L);
 
+    if (ifx_la_small_cholesky_c(A, L))
+    {
+        return;
+    }
+
     // Dimension
     const uint32_t N = mRows(A);
 
@@ -951,6 +973,11 @@ void ifx_la_determinant_r(const ifx_Matrix_R_t* A,
     IFX_MAT_BRK_SQUARE(A);
     IFX_ERR_BRK_NULL(determinant);
 
+    if (ifx_la_small_determinant_r(A, determinant))
+    {
+        return;
+    }
+
     // Dimension
     uint32_t N = mCols(A);
 
@@ -973,6 +1000,11 @@ void ifx_la_determinant_c(const ifx_Matrix_C_t* A,
     IFX_MAT_BRK_SQUARE(A);
     IFX_ERR_BRK_NULL(determinant);
 
+    if (ifx_la_small_determinant_c(A, determinant))
+    {
+        return;
+    }
+
     // Dimension
     uint32_t N = mCols(A);
 
@@ -35,8 +35,10 @@
 
 #include "List.h"
 #include "Error.h"
+#include "Mem.h"
 #include "internal/NonCopyable.hpp"
 
+#include <cstring>
 #include <vector>
 
 /*
@@ -50,6 +52,7 @@ struct ifxList
 private:
     void (*m_destructor)(void*) = nullptr;
     std::vector<void*> m_vector;
+    void* m_storage = nullptr;  // single block holding inline elements
 
 public:
     NONCOPYABLE(ifxList);
@@ -65,6 +68,24 @@ public:
             for (void* p : m_vector)
                 m_destructor(p);
         }
+        ifx_mem_free(m_storage);
+    }
+
+    bool assign(const void* elems, size_t num_elems, size_t elem_size)
+    {
+        if (num_elems == 0)
+            return true;
+
+        m_storage = ifx_mem_alloc(num_elems * elem_size);
+        if (!m_storage)
+            return false;
+        std::memcpy(m_storage, elems, num_elems * elem_size);
+
+        auto* p = static_cast<char*>(m_storage);
+        m_vector.reserve(num_elems);
+        for (size_t i = 0; i < num_elems; i++)
+            m_vector.push_back(p + i * elem_size);
+        return true;
     }
 
     size_t size() const
@@ -102,6 +123,28 @@ ifx_List_t* ifx_list_create(void destructor(void*))
     return list;
 }
 
+ifx_List_t* ifx_list_create_from_array(const void* elems, size_t num_elems, size_t elem_size)
+{
+    IFX_ERR_BRV_ARGUMENT(elem_size == 0, nullptr);
+    IFX_ERR_BRV_COND(num_elems && !elems, IFX_ERROR_ARGUMENT_NULL, nullptr);
+
+    auto* list = new (std::nothrow) ifxList(nullptr);
+    IFX_ERR_BRV_MEMALLOC(list, nullptr);
+
+    try
+    {
+        if (list->assign(elems, num_elems, elem_size))
+            return list;
+    }
+    catch (const std::bad_alloc&)
+    {
+    }
+
+    delete list;
+    ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+    return nullptr;
+}
+
 void ifx_list_destroy(ifx_List_t* list)
 {
     delete list;
@@ -68,6 +68,25 @@ typedef struct ifxList ifx_List_t;
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_list_create(void destructor(void*));
 
+/**
+ * @brief Creates new list from an array.
+ *
+ * Create a new list holding a copy of the num_elems elements of size
+ * elem_size at elems. All elements are stored in a single contiguous
+ * block owned by the list, so the list needs only one allocation for the
+ * elements regardless of their number. The pointers returned by
+ * \ref ifx_list_get point into this block and are valid until the list is
+ * destroyed.
+ *
+ * @param   [in]    elems       pointer to first element (may be NULL if num_elems is 0)
+ * @param   [in]    num_elems   number of elements
+ * @param   [in]    elem_size   size of one element in bytes
+ * @return list if successful
+ * @return NULL if an error occurred
+ */
+IFX_DLL_PUBLIC
+ifx_List_t* ifx_list_create_from_array(const void* elems, size_t num_elems, size_t elem_size);
+
 /**
  * @brief Destroy list.
  *
@@ -33,9 +33,26 @@
 ==============================================================================
 */
 
+// for clock_gettime and nanosleep
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// NOLINTNEXTLINE(bugprone-reserved-identifier)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
 
+#include "Defines.h"
 #include "Log.h"
+#include "Mem.h"  // for IFX_ALIGN
 
 /*
 ==============================================================================
@@ -48,18 +65,121 @@
 #define IFX_LOG_TAG_DEBUG "DEBUG"
 #define IFX_LOG_TAG_INFO  "INFO"
 
+#define DEFAULT_RING_SIZE (64U * 1024U)
+#define RECORD_ALIGNMENT  8U     // alignment of records and arguments in the ring
+#define MAX_RECORD        1024U  // maximum size of an encoded message
+#define MAX_STRING        255U   // maximum length of a copied %s argument
+#define MAX_SPEC          32U    // maximum length of a conversion specification
+#define MAX_LINE          2048U  // maximum length of a formatted message
+#define IDLE_SLEEP_MS     2U     // sleep of the writer thread if all rings are empty
+
+#define RECORD_MESSAGE 1U
+#define RECORD_PADDING 2U
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+#if defined(_WIN32)
+typedef HANDLE thread_t;
+#else
+typedef pthread_t thread_t;
+#endif
+
+/**
+ * @brief Types of the arguments of a message.
+ */
+typedef enum
+{
+    ARG_INT,
+    ARG_LONG,
+    ARG_LLONG,
+    ARG_SIZE,
+    ARG_INTMAX,
+    ARG_PTRDIFF,
+    ARG_DOUBLE,
+    ARG_LDOUBLE,
+    ARG_POINTER,
+    ARG_STRING,
+    ARG_UNSUPPORTED_INT,     // %lc, consumed but not printed
+    ARG_UNSUPPORTED_POINTER  // %ls and %n, consumed but not printed
+} arg_type_t;
+
+/**
+ * @brief Parsed conversion specification of a format string.
+ */
+typedef struct
+{
+    const char* begin;   /**< Position of the %.*/
+    const char* end;     /**< Position after the conversion character.*/
+    bool width_star;     /**< Width is passed as argument.*/
+    bool precision_star; /**< Precision is passed as argument.*/
+    int precision;       /**< Literal precision, -1 if none.*/
+    arg_type_t type;     /**< Type of the argument.*/
+} spec_t;
+
+/**
+ * @brief Header of a record in a ring buffer.
+ *
+ * A message record is followed by its arguments in the order of the format
+ * string, each aligned to RECORD_ALIGNMENT. Integers are stored as
+ * int64_t, strings as uint32_t length followed by the characters. A padding
+ * record fills the end of the ring if the next record does not fit.
+ */
+typedef struct
+{
+    uint32_t size;       /**< Size of the record including the header.*/
+    uint32_t kind;       /**< RECORD_MESSAGE or RECORD_PADDING.*/
+    uint32_t severity;   /**< Severity of the message.*/
+    uint32_t num_args;   /**< Number of stored arguments, less than in msg if truncated.*/
+    FILE* f;             /**< Stream to write to.*/
+    const char* msg;     /**< Format string.*/
+} record_t;
+
+/**
+ * @brief Single producer, single consumer ring buffer of a thread.
+ *
+ * head and tail count bytes and are never wrapped; the owning thread
+ * advances head, the writer thread advances tail.
+ */
+typedef struct ring_s
+{
+    struct ring_s* next;     /**< Next ring in the list of all rings.*/
+    uint8_t* data;           /**< Memory of the ring.*/
+    size_t size;             /**< Size of data, a power of two.*/
+    volatile size_t head;    /**< Bytes written.*/
+    volatile size_t tail;    /**< Bytes consumed.*/
+    volatile uint32_t owned; /**< 1 while a thread logs into this ring.*/
+} ring_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
 ==============================================================================
 */
 
+static volatile uint32_t rate_limit = 0;
+
+static volatile bool async_running = false;
+static volatile uint32_t async_epoch = 0;
+static size_t async_ring_size = DEFAULT_RING_SIZE;
+static ring_t* volatile rings = NULL;
+static thread_t writer;
+static volatile bool writer_stop = false;
+static volatile uint64_t dropped = 0;
+static uint64_t dropped_reported = 0;
+
+static IFX_THREAD_LOCAL ring_t* thread_ring = NULL;
+static IFX_THREAD_LOCAL uint32_t thread_epoch = 0;
+
+#if defined(_WIN32)
+static DWORD ring_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t ring_key;
+#endif
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
@@ -95,6 +215,776 @@ static char* get_severity_tag(ifx_Log_Severity_t severity)
     }
 }
 
+//----------------------------------------------------------------------------
+
+static size_t load_acquire(const volatile size_t* value)
+{
+#if defined(_MSC_VER)
+    const size_t v = *value;
+    MemoryBarrier();
+    return v;
+#else
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static void store_release(volatile size_t* value, size_t v)
+{
+#if defined(_MSC_VER)
+    MemoryBarrier();
+    *value = v;
+#else
+    __atomic_store_n(value, v, __ATOMIC_RELEASE);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t fetch_add(volatile uint32_t* value, uint32_t delta)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)InterlockedExchangeAdd((volatile LONG*)value, (LONG)delta);
+#else
+    return __atomic_fetch_add(value, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t exchange(volatile uint32_t* value, uint32_t v)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)InterlockedExchange((volatile LONG*)value, (LONG)v);
+#else
+    return __atomic_exchange_n(value, v, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static bool compare_exchange(volatile uint32_t* value, uint32_t expected, uint32_t desired)
+{
+#if defined(_MSC_VER)
+    return (uint32_t)InterlockedCompareExchange((volatile LONG*)value, (LONG)desired, (LONG)expected) == expected;
+#else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static bool compare_exchange_ring(ring_t* volatile* value, ring_t* expected, ring_t* desired)
+{
+#if defined(_MSC_VER)
+    return InterlockedCompareExchangePointer((PVOID volatile*)value, desired, expected) == expected;
+#else
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static ring_t* load_rings(void)
+{
+#if defined(_MSC_VER)
+    ring_t* first = rings;
+    MemoryBarrier();
+    return first;
+#else
+    return __atomic_load_n(&rings, __ATOMIC_ACQUIRE);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static uint64_t add_dropped(uint64_t delta)
+{
+#if defined(_MSC_VER)
+    return (uint64_t)InterlockedExchangeAdd64((volatile LONG64*)&dropped, (LONG64)delta) + delta;
+#else
+    return __atomic_add_fetch(&dropped, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t current_second(void)
+{
+#if defined(_WIN32)
+    return (uint32_t)(GetTickCount64() / 1000);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)now.tv_sec;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static void sleep_ms(uint32_t ms)
+{
+#if defined(_WIN32)
+    Sleep(ms);
+#else
+    const struct timespec duration = {0, (long)ms * 1000000L};
+    nanosleep(&duration, NULL);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Parses the conversion specification starting at the % in p.
+ *
+ * The encoder and the writer thread use the same parser, so both agree on
+ * the arguments. Returns false at the end of the format string.
+ */
+static bool parse_spec(const char* p, spec_t* spec)
+{
+    for (;;)
+    {
+        p = strchr(p, '%');
+        if (p == NULL)
+            return false;
+        if (p[1] != '%')
+            break;
+        p += 2;
+    }
+
+    spec->begin = p++;
+    spec->width_star = false;
+    spec->precision_star = false;
+    spec->precision = -1;
+
+    while (*p && strchr("-+ #0'", *p))
+        p++;
+
+    if (*p == '*')
+    {
+        spec->width_star = true;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec->precision_star = true;
+            p++;
+        }
+        else
+        {
+            spec->precision = 0;
+            while (*p >= '0' && *p <= '9')
+                spec->precision = spec->precision * 10 + (*p++ - '0');
+        }
+    }
+
+    arg_type_t integer = ARG_INT;
+    bool long_double = false;
+    bool wide = false;
+    switch (*p)
+    {
+        case 'h':
+            p += (p[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (p[1] == 'l')
+            {
+                integer = ARG_LLONG;
+                p += 2;
+            }
+            else
+            {
+                integer = ARG_LONG;
+                wide = true;
+                p++;
+            }
+            break;
+        case 'L':
+            long_double = true;
+            p++;
+            break;
+        case 'z':
+            integer = ARG_SIZE;
+            p++;
+            break;
+        case 'j':
+            integer = ARG_INTMAX;
+            p++;
+            break;
+        case 't':
+            integer = ARG_PTRDIFF;
+            p++;
+            break;
+        default:
+            break;
+    }
+
+    switch (*p)
+    {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            spec->type = integer;
+            break;
+        case 'c':
+            spec->type = wide ? ARG_UNSUPPORTED_INT : ARG_INT;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            spec->type = long_double ? ARG_LDOUBLE : ARG_DOUBLE;
+            break;
+        case 's':
+            spec->type = wide ? ARG_UNSUPPORTED_POINTER : ARG_STRING;
+            break;
+        case 'p':
+            spec->type = ARG_POINTER;
+            break;
+        case 'n':
+            spec->type = ARG_UNSUPPORTED_POINTER;
+            break;
+        default:
+            // incomplete or unknown specification, stop here like printf would misbehave
+            return false;
+    }
+
+    spec->end = p + 1;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static bool put_bytes(uint8_t* record, size_t* pos, const void* bytes, size_t size)
+{
+    const size_t aligned = IFX_ALIGN(size, RECORD_ALIGNMENT);
+    if (*pos + aligned > MAX_RECORD)
+        return false;
+
+    memcpy(record + *pos, bytes, size);
+    *pos += aligned;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static bool put_integer(uint8_t* record, size_t* pos, int64_t value)
+{
+    return put_bytes(record, pos, &value, sizeof(value));
+}
+
+//----------------------------------------------------------------------------
+
+static bool put_string(uint8_t* record, size_t* pos, const char* s, int precision)
+{
+    if (s == NULL)
+        s = "(null)";
+
+    const uint32_t limit = (precision >= 0 && (uint32_t)precision < MAX_STRING) ? (uint32_t)precision : MAX_STRING;
+    uint32_t length = 0;
+    while (length < limit && s[length])
+        length++;
+
+    const size_t aligned = IFX_ALIGN(sizeof(uint32_t) + length, RECORD_ALIGNMENT);
+    if (*pos + aligned > MAX_RECORD)
+        return false;
+
+    memcpy(record + *pos, &length, sizeof(length));
+    memcpy(record + *pos + sizeof(length), s, length);
+    *pos += aligned;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Copies the arguments of a message into a record without formatting.
+ *
+ * If the arguments do not fit into MAX_RECORD bytes, the message is
+ * truncated after the last argument that fits.
+ *
+ * @return Size of the record.
+ */
+static size_t encode(uint8_t* record, FILE* f, ifx_Log_Severity_t severity, const char* msg, va_list args)
+{
+    record_t* header = (record_t*)record;
+    size_t pos = IFX_ALIGN(sizeof(record_t), RECORD_ALIGNMENT);
+    uint32_t num_args = 0;
+    bool full = false;
+
+    spec_t spec;
+    for (const char* p = msg; !full && parse_spec(p, &spec); p = spec.end)
+    {
+        if (spec.width_star)
+        {
+            full = !put_integer(record, &pos, va_arg(args, int));
+            num_args += full ? 0 : 1;
+        }
+        if (spec.precision_star)
+        {
+            spec.precision = va_arg(args, int);
+            full = full || !put_integer(record, &pos, spec.precision);
+            num_args += full ? 0 : 1;
+        }
+
+        bool stored = true;
+        switch (spec.type)
+        {
+            case ARG_INT:
+                stored = put_integer(record, &pos, va_arg(args, int));
+                break;
+            case ARG_LONG:
+                stored = put_integer(record, &pos, va_arg(args, long));
+                break;
+            case ARG_LLONG:
+                stored = put_integer(record, &pos, va_arg(args, long long));
+                break;
+            case ARG_SIZE:
+                stored = put_integer(record, &pos, (int64_t)va_arg(args, size_t));
+                break;
+            case ARG_INTMAX:
+                stored = put_integer(record, &pos, va_arg(args, intmax_t));
+                break;
+            case ARG_PTRDIFF:
+                stored = put_integer(record, &pos, va_arg(args, ptrdiff_t));
+                break;
+            case ARG_DOUBLE:
+            {
+                const double value = va_arg(args, double);
+                stored = put_bytes(record, &pos, &value, sizeof(value));
+                break;
+            }
+            case ARG_LDOUBLE:
+            {
+                const long double value = va_arg(args, long double);
+                stored = put_bytes(record, &pos, &value, sizeof(value));
+                break;
+            }
+            case ARG_POINTER:
+            {
+                const void* value = va_arg(args, void*);
+                stored = put_bytes(record, &pos, &value, sizeof(value));
+                break;
+            }
+            case ARG_STRING:
+                stored = put_string(record, &pos, va_arg(args, const char*), spec.precision);
+                break;
+            case ARG_UNSUPPORTED_INT:
+                (void)va_arg(args, int);
+                break;
+            case ARG_UNSUPPORTED_POINTER:
+                (void)va_arg(args, void*);
+                break;
+        }
+        full = full || !stored;
+        num_args += full ? 0 : 1;
+    }
+
+    header->size = (uint32_t)pos;
+    header->kind = RECORD_MESSAGE;
+    header->severity = (uint32_t)severity;
+    header->num_args = num_args;
+    header->f = f;
+    header->msg = msg;
+    return pos;
+}
+
+//----------------------------------------------------------------------------
+
+static int64_t get_integer(const uint8_t* record, size_t* pos)
+{
+    int64_t value;
+    memcpy(&value, record + *pos, sizeof(value));
+    *pos += sizeof(value);
+    return value;
+}
+
+//----------------------------------------------------------------------------
+
+static void advance(size_t* length, int n, size_t size)
+{
+    if (n > 0)
+        *length += MIN((size_t)n, size - 1 - *length);
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Appends literal text of a format string, %% is printed as %.
+ */
+static void append_text(char* line, size_t* length, size_t size, const char* begin, const char* end)
+{
+    for (const char* p = begin; (end == NULL || p < end) && *p && *length < size - 1; p++)
+    {
+        line[(*length)++] = *p;
+        if (p[0] == '%' && p[1] == '%')
+            p++;
+    }
+    line[*length] = '\0';
+}
+
+//----------------------------------------------------------------------------
+
+// formats one argument with the optional width and precision arguments
+#define FORMAT_ARG(out, size, spec, stars, star, value)                                        \
+    ((stars) == 0   ? snprintf((out), (size), (spec), (value))                                 \
+     : (stars) == 1 ? snprintf((out), (size), (spec), (star)[0], (value))                      \
+                    : snprintf((out), (size), (spec), (star)[0], (star)[1], (value)))
+
+/**
+ * @brief Formats a message record into line, the counterpart of encode.
+ *
+ * @return Length of the line.
+ */
+static size_t decode(const uint8_t* record, char* line, size_t size)
+{
+    const record_t* header = (const record_t*)record;
+    size_t pos = IFX_ALIGN(sizeof(record_t), RECORD_ALIGNMENT);
+    uint32_t num_args = header->num_args;
+    size_t length = 0;
+
+#define APPEND(n) advance(&length, (n), size)
+
+    APPEND(snprintf(line, size, "%s: ", get_severity_tag((ifx_Log_Severity_t)header->severity)));
+
+    const char* p = header->msg;
+    spec_t spec;
+    while (parse_spec(p, &spec))
+    {
+        append_text(line, &length, size, p, spec.begin);
+        p = spec.end;
+
+        const uint32_t stars = (spec.width_star ? 1U : 0U) + (spec.precision_star ? 1U : 0U);
+        if (num_args < stars + 1)
+        {
+            APPEND(snprintf(line + length, size - length, "..."));
+            num_args = 0;
+            p = "";
+            break;
+        }
+
+        int star[2] = {0, 0};
+        for (uint32_t i = 0; i < stars; i++)
+            star[i] = (int)get_integer(record, &pos);
+        num_args -= stars + 1;
+
+        char format[MAX_SPEC];
+        const size_t format_length = MIN((size_t)(spec.end - spec.begin), sizeof(format) - 1);
+        memcpy(format, spec.begin, format_length);
+        format[format_length] = '\0';
+
+        char* out = line + length;
+        const size_t remaining = size - length;
+        switch (spec.type)
+        {
+            case ARG_INT:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (int)get_integer(record, &pos)));
+                break;
+            case ARG_LONG:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (long)get_integer(record, &pos)));
+                break;
+            case ARG_LLONG:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (long long)get_integer(record, &pos)));
+                break;
+            case ARG_SIZE:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (size_t)get_integer(record, &pos)));
+                break;
+            case ARG_INTMAX:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (intmax_t)get_integer(record, &pos)));
+                break;
+            case ARG_PTRDIFF:
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, (ptrdiff_t)get_integer(record, &pos)));
+                break;
+            case ARG_DOUBLE:
+            {
+                double value;
+                memcpy(&value, record + pos, sizeof(value));
+                pos += IFX_ALIGN(sizeof(value), RECORD_ALIGNMENT);
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, value));
+                break;
+            }
+            case ARG_LDOUBLE:
+            {
+                long double value;
+                memcpy(&value, record + pos, sizeof(value));
+                pos += IFX_ALIGN(sizeof(value), RECORD_ALIGNMENT);
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, value));
+                break;
+            }
+            case ARG_POINTER:
+            {
+                void* value;
+                memcpy(&value, record + pos, sizeof(value));
+                pos += IFX_ALIGN(sizeof(value), RECORD_ALIGNMENT);
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, value));
+                break;
+            }
+            case ARG_STRING:
+            {
+                uint32_t string_length;
+                memcpy(&string_length, record + pos, sizeof(string_length));
+                char value[MAX_STRING + 1];
+                memcpy(value, record + pos + sizeof(string_length), string_length);
+                value[string_length] = '\0';
+                pos += IFX_ALIGN(sizeof(string_length) + string_length, RECORD_ALIGNMENT);
+                APPEND(FORMAT_ARG(out, remaining, format, stars, star, value));
+                break;
+            }
+            case ARG_UNSUPPORTED_INT:
+            case ARG_UNSUPPORTED_POINTER:
+                if (format[format_length - 1] != 'n')
+                    APPEND(snprintf(out, remaining, "?"));
+                break;
+        }
+    }
+
+    // text after the last specification
+    append_text(line, &length, size, p, NULL);
+    append_text(line, &length, size, "\n", NULL);
+    if (line[length - 1] != '\n')
+        line[length - 1] = '\n';  // truncated
+
+#undef APPEND
+
+    return length;
+}
+
+//----------------------------------------------------------------------------
+
+static void release_ring(void* ring)
+{
+    if (ring)
+    {
+#if defined(_MSC_VER)
+        MemoryBarrier();
+        ((ring_t*)ring)->owned = 0;
+#else
+        __atomic_store_n(&((ring_t*)ring)->owned, 0, __ATOMIC_RELEASE);
+#endif
+    }
+}
+
+#if defined(_WIN32)
+static void WINAPI release_ring_callback(void* ring)
+{
+    release_ring(ring);
+}
+#endif
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Returns the ring of the calling thread.
+ *
+ * A thread takes over the ring of a thread that exited or allocates a new
+ * one. The rings are not allocated with ifx_mem_alloc, since a thread
+ * allocator (e.g. an arena) must not own them.
+ */
+static ring_t* get_thread_ring(void)
+{
+    if (thread_ring && thread_epoch == async_epoch)
+        return thread_ring;
+
+    ring_t* ring;
+    for (ring = load_rings(); ring; ring = ring->next)
+    {
+        if (compare_exchange(&ring->owned, 0, 1))
+            break;
+    }
+
+    if (ring == NULL)
+    {
+        ring = malloc(sizeof(ring_t));
+        if (ring == NULL)
+            return NULL;
+
+        ring->data = malloc(async_ring_size);
+        if (ring->data == NULL)
+        {
+            free(ring);
+            return NULL;
+        }
+        ring->size = async_ring_size;
+        ring->head = 0;
+        ring->tail = 0;
+        ring->owned = 1;
+
+        do
+        {
+            ring->next = load_rings();
+        } while (!compare_exchange_ring(&rings, ring->next, ring));
+    }
+
+#if defined(_WIN32)
+    FlsSetValue(ring_key, ring);
+#else
+    pthread_setspecific(ring_key, ring);
+#endif
+    thread_ring = ring;
+    thread_epoch = async_epoch;
+    return ring;
+}
+
+//----------------------------------------------------------------------------
+
+static void push(const uint8_t* record, size_t size)
+{
+    ring_t* ring = get_thread_ring();
+    if (ring == NULL)
+    {
+        add_dropped(1);
+        return;
+    }
+
+    const size_t head = ring->head;
+    const size_t tail = load_acquire(&ring->tail);
+    const size_t offset = head & (ring->size - 1);
+    const size_t padding = (offset + size > ring->size) ? ring->size - offset : 0;
+
+    if (padding + size > ring->size - (head - tail))
+    {
+        add_dropped(1);
+        return;
+    }
+
+    if (padding)
+    {
+        record_t* pad = (record_t*)(ring->data + offset);
+        pad->size = (uint32_t)padding;
+        pad->kind = RECORD_PADDING;
+    }
+
+    memcpy(ring->data + ((head + padding) & (ring->size - 1)), record, size);
+    store_release(&ring->head, head + padding + size);
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Writes all messages of a ring.
+ *
+ * @return true if any message was written.
+ */
+static bool drain(ring_t* ring)
+{
+    size_t tail = ring->tail;
+    const size_t head = load_acquire(&ring->head);
+    if (tail == head)
+        return false;
+
+    FILE* last = NULL;
+    while (tail != head)
+    {
+        const uint8_t* record = ring->data + (tail & (ring->size - 1));
+        const record_t* header = (const record_t*)record;
+        if (header->kind == RECORD_MESSAGE)
+        {
+            char line[MAX_LINE];
+            const size_t length = decode(record, line, sizeof(line));
+            if (last && last != header->f)
+                fflush(last);
+            fwrite(line, 1, length, header->f);
+            last = header->f;
+        }
+        tail += header->size;
+    }
+    if (last)
+        fflush(last);
+
+    store_release(&ring->tail, tail);
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+static void writer_main(void)
+{
+    for (;;)
+    {
+#if defined(_MSC_VER)
+        const bool stop = writer_stop;
+        MemoryBarrier();
+#else
+        const bool stop = __atomic_load_n(&writer_stop, __ATOMIC_ACQUIRE);
+#endif
+
+        bool written = false;
+        for (ring_t* ring = load_rings(); ring; ring = ring->next)
+            written = drain(ring) || written;
+
+        const uint64_t total = add_dropped(0);
+        if (total != dropped_reported)
+        {
+            fprintf(IFX_STDOUT, "%s: %llu log messages dropped\n", IFX_LOG_TAG_WARN, (unsigned long long)(total - dropped_reported));
+            dropped_reported = total;
+        }
+
+        if (!written)
+        {
+            if (stop)
+                break;
+            sleep_ms(IDLE_SLEEP_MS);
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI writer_thread(LPVOID arg)
+{
+    (void)arg;
+    writer_main();
+    return 0;
+}
+#else
+static void* writer_thread(void* arg)
+{
+    (void)arg;
+    writer_main();
+    return NULL;
+}
+#endif
+
+//----------------------------------------------------------------------------
+
+static void vlog(FILE* f, ifx_Log_Severity_t severity, const char* msg, va_list args)
+{
+    if (async_running)
+    {
+        uint8_t record[MAX_RECORD];
+        const size_t size = encode(record, f, severity, msg, args);
+        push(record, size);
+        return;
+    }
+
+    fprintf(f, "%s: ", get_severity_tag(severity));
+    vfprintf(f, msg, args);
+    fprintf(f, "\n");
+}
+
+//----------------------------------------------------------------------------
+
+static void log_message(FILE* f, ifx_Log_Severity_t severity, const char* msg, ...)
+{
+    va_list args;
+    va_start(args, msg);
+    vlog(f, severity, msg, args);
+    va_end(args);
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -103,10 +993,151 @@ static char* get_severity_tag(ifx_Log_Severity_t severity)
 
 void ifx_log(FILE* f, ifx_Log_Severity_t severity, const char* msg, ...)
 {
-    va_list argl;
-    fprintf(f, "%s: ", get_severity_tag(severity));
-    va_start(argl, msg);
-    vfprintf(f, msg, argl);
-    va_end(argl);
-    fprintf(f, "\n");
+    va_list args;
+    va_start(args, msg);
+    vlog(f, severity, msg, args);
+    va_end(args);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_site(ifx_Log_Site_t* site, FILE* f, ifx_Log_Severity_t severity, const char* msg, ...)
+{
+    const uint32_t limit = rate_limit;
+    if (limit)
+    {
+        // the first message of a new second resets the counter and reports
+        // what was suppressed in the previous one
+        const uint32_t now = current_second();
+        const uint32_t window = site->window;
+        if (window != now && compare_exchange(&site->window, window, now))
+        {
+            const uint32_t suppressed = exchange(&site->suppressed, 0);
+            exchange(&site->count, 0);
+            if (suppressed)
+                log_message(f, severity, "%u messages suppressed by the rate limit", suppressed);
+        }
+
+        if (fetch_add(&site->count, 1) >= limit)
+        {
+            fetch_add(&site->suppressed, 1);
+            return;
+        }
+    }
+
+    va_list args;
+    va_start(args, msg);
+    vlog(f, severity, msg, args);
+    va_end(args);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_set_rate_limit(uint32_t messages_per_second)
+{
+    rate_limit = messages_per_second;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_log_async_start(size_t ring_size)
+{
+    if (async_running)
+        return true;
+
+    if (ring_size == 0)
+        ring_size = DEFAULT_RING_SIZE;
+
+    // a power of two that holds at least one record and its padding
+    async_ring_size = 2 * MAX_RECORD;
+    while (async_ring_size < ring_size)
+        async_ring_size *= 2;
+
+#if defined(_WIN32)
+    ring_key = FlsAlloc(release_ring_callback);
+    if (ring_key == FLS_OUT_OF_INDEXES)
+        return false;
+#else
+    if (pthread_key_create(&ring_key, release_ring) != 0)
+        return false;
+#endif
+
+    writer_stop = false;
+    async_epoch++;
+    async_running = true;
+
+#if defined(_WIN32)
+    writer = CreateThread(NULL, 0, writer_thread, NULL, 0, NULL);
+    const bool started = (writer != NULL);
+#else
+    const bool started = (pthread_create(&writer, NULL, writer_thread, NULL) == 0);
+#endif
+
+    if (!started)
+    {
+        async_running = false;
+#if defined(_WIN32)
+        FlsFree(ring_key);
+#else
+        pthread_key_delete(ring_key);
+#endif
+    }
+    return started;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_async_stop(void)
+{
+    if (!async_running)
+        return;
+
+    async_running = false;
+#if defined(_MSC_VER)
+    MemoryBarrier();
+    writer_stop = true;
+#else
+    __atomic_store_n(&writer_stop, true, __ATOMIC_RELEASE);
+#endif
+
+#if defined(_WIN32)
+    WaitForSingleObject(writer, INFINITE);
+    CloseHandle(writer);
+    FlsFree(ring_key);
+#else
+    pthread_join(writer, NULL);
+    pthread_key_delete(ring_key);
+#endif
+
+    ring_t* ring = rings;
+    rings = NULL;
+    while (ring)
+    {
+        ring_t* next = ring->next;
+        free(ring->data);
+        free(ring);
+        ring = next;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_log_flush(void)
+{
+    if (!async_running)
+        return;
+
+    for (ring_t* ring = load_rings(); ring; ring = ring->next)
+    {
+        const size_t head = load_acquire(&ring->head);
+        while ((ptrdiff_t)(load_acquire(&ring->tail) - head) < 0)
+            sleep_ms(1);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+uint64_t ifx_log_get_dropped(void)
+{
+    return add_dropped(0);
 }
@@ -64,15 +64,25 @@ extern "C"
 ==============================================================================
 */
 
+// Messages below the severity selected with IFX_LOG_SEVERITY_* are removed
+// at compile time. Every use of the macros below is a call site with its own
+// rate limit, see ifx_log_set_rate_limit.
+#define IFX_LOG_SITE(f, s, ...)                              \
+    do                                                       \
+    {                                                        \
+        static ifx_Log_Site_t ifx_log_site_;                 \
+        ifx_log_site(&ifx_log_site_, (f), (s), __VA_ARGS__); \
+    } while (0)
+
 #if defined(IFX_LOG_SEVERITY_DEBUG)
-#define IFX_LOG_DEBUG(...) ifx_log(IFX_STDOUT, IFX_LOG_DEBUG, __VA_ARGS__)
+#define IFX_LOG_DEBUG(...) IFX_LOG_SITE(IFX_STDOUT, IFX_LOG_DEBUG, __VA_ARGS__)
 #else
 #define IFX_LOG_DEBUG(...)
 #endif
 
 #if defined(IFX_LOG_SEVERITY_INFO) \
     || defined(IFX_LOG_SEVERITY_DEBUG)
-#define IFX_LOG_INFO(...) ifx_log(IFX_STDOUT, IFX_LOG_INFO, __VA_ARGS__)
+#define IFX_LOG_INFO(...) IFX_LOG_SITE(IFX_STDOUT, IFX_LOG_INFO, __VA_ARGS__)
 #else
 #define IFX_LOG_INFO(...)
 #endif
@@ -80,7 +90,7 @@ extern "C"
 #if defined(IFX_LOG_SEVERITY_INFO)       \
     || defined(IFX_LOG_SEVERITY_WARNING) \
     || defined(IFX_LOG_SEVERITY_DEBUG)
-#define IFX_LOG_WARNING(...) ifx_log(IFX_STDOUT, IFX_LOG_WARNING, __VA_ARGS__)
+#define IFX_LOG_WARNING(...) IFX_LOG_SITE(IFX_STDOUT, IFX_LOG_WARNING, __VA_ARGS__)
 #else
 #define IFX_LOG_WARNING(...)
 #endif
@@ -89,7 +99,7 @@ extern "C"
     || defined(IFX_LOG_SEVERITY_WARNING) \
     || defined(IFX_LOG_SEVERITY_ERROR)   \
     || defined(IFX_LOG_SEVERITY_DEBUG)
-#define IFX_LOG_ERROR(...) ifx_log(IFX_STDOUT, IFX_LOG_ERROR, __VA_ARGS__)
+#define IFX_LOG_ERROR(...) IFX_LOG_SITE(IFX_STDOUT, IFX_LOG_ERROR, __VA_ARGS__)
 #else
 #define IFX_LOG_ERROR(...)
 #endif
@@ -111,6 +121,18 @@ typedef enum
     IFX_LOG_DEBUG
 } ifx_Log_Severity_t;
 
+/**
+ * @brief State of the rate limit of a call site, see \ref ifx_log_site.
+ *
+ * Must be zero initialized, e.g. a static variable.
+ */
+typedef struct
+{
+    volatile uint32_t window;     /**< Second the counter refers to.*/
+    volatile uint32_t count;      /**< Messages logged in the window.*/
+    volatile uint32_t suppressed; /**< Messages dropped by the rate limit.*/
+} ifx_Log_Site_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -123,12 +145,88 @@ typedef enum
 
 /** @defgroup gr_log Log
  * @brief API for logging
+ *
+ * By default messages are formatted and written on the calling thread.
+ * After \ref ifx_log_async_start the calling thread only copies the format
+ * string pointer and the arguments into a lock-free ring buffer of its own;
+ * a background thread formats and writes the messages. If a ring is full,
+ * the message is dropped and counted instead of blocking the caller.
+ *
+ * In asynchronous mode the format string must be a string literal (or
+ * otherwise outlive the message). Strings passed as %s arguments are
+ * copied, up to 255 characters. %n and wide characters are not supported.
+ *
  * @{
  */
 
+/**
+ * @brief Logs a message.
+ *
+ * @param [in]     f         Stream to write to.
+ * @param [in]     s         Severity of the message.
+ * @param [in]     msg       printf-like format string.
+ */
 IFX_DLL_PUBLIC
 void ifx_log(FILE* f, ifx_Log_Severity_t s, const char* msg, ...);
 
+/**
+ * @brief Logs a message subject to the rate limit of a call site.
+ *
+ * Used by the IFX_LOG_* macros. If more than the limit set with
+ * \ref ifx_log_set_rate_limit are logged from the same site within one
+ * second, the remaining messages are dropped; their number is logged with
+ * the first message of the next second.
+ *
+ * @param [in,out] site      State of the call site.
+ * @param [in]     f         Stream to write to.
+ * @param [in]     s         Severity of the message.
+ * @param [in]     msg       printf-like format string.
+ */
+IFX_DLL_PUBLIC
+void ifx_log_site(ifx_Log_Site_t* site, FILE* f, ifx_Log_Severity_t s, const char* msg, ...);
+
+/**
+ * @brief Sets the number of messages per second and call site.
+ *
+ * @param [in]     messages_per_second  Limit, 0 for no limit (default).
+ */
+IFX_DLL_PUBLIC
+void ifx_log_set_rate_limit(uint32_t messages_per_second);
+
+/**
+ * @brief Starts asynchronous logging.
+ *
+ * Every thread that logs gets a ring buffer of the given size. Call it
+ * while no other thread logs.
+ *
+ * @param [in]     ring_size Size of the ring buffer per thread in bytes,
+ *                           rounded up to a power of two, 0 for 64 KiB.
+ *
+ * @return true on success, false if the background thread could not be started.
+ */
+IFX_DLL_PUBLIC
+bool ifx_log_async_start(size_t ring_size);
+
+/**
+ * @brief Writes all pending messages and returns to synchronous logging.
+ *
+ * Call it while no other thread logs.
+ */
+IFX_DLL_PUBLIC
+void ifx_log_async_stop(void);
+
+/**
+ * @brief Waits until the messages logged so far are written.
+ */
+IFX_DLL_PUBLIC
+void ifx_log_flush(void);
+
+/**
+ * @brief Returns the number of messages dropped because a ring buffer was full.
+ */
+IFX_DLL_PUBLIC
+uint64_t ifx_log_get_dropped(void);
+
 /**
  * @}
  */
@@ -37,6 +37,8 @@
 #include "Complex.h"
 #include "Defines.h"
 #include "Error.h"
+#include "internal/ComplexInline.h"
+#include "internal/Kernels.h"
 #include "internal/Macros.h"
 #include "internal/Util.h"
 #include "Mda.h"
@@ -52,59 +54,130 @@
 ==============================================================================
 */
 
-#define MAT_BLIT(from, to, from_row, num_rows, from_col, num_cols)        \
-    for (uint32_t i = (from_row); i < ((from_row) + (num_rows)); i++)     \
-    {                                                                     \
-        for (uint32_t j = (from_col); j < ((from_col) + (num_cols)); j++) \
-        {                                                                 \
-            mAt(to, i, j) = mAt(from, i, j);                              \
-        }                                                                 \
+#define MAT_ROWS_CONTIGUOUS(m) (mStride(m, 1) == 1)
+#define MAT_CONTIGUOUS(m)      (MAT_ROWS_CONTIGUOUS(m) && (mStride(m, 0) == mCols(m)))
+
+/* rows without gaps are copied with one memmove per row */
+#define MAT_BLIT(from, to, from_row, num_rows, from_col, num_cols)                                     \
+    for (uint32_t i = (from_row); i < ((from_row) + (num_rows)); i++)                                  \
+    {                                                                                                  \
+        if (MAT_ROWS_CONTIGUOUS(from) && MAT_ROWS_CONTIGUOUS(to))                                      \
+        {                                                                                              \
+            if (num_cols)                                                                              \
+                memmove(&mAt(to, i, from_col), &mAt(from, i, from_col), (num_cols) * sizeof(*mDat(to))); \
+            continue;                                                                                  \
+        }                                                                                              \
+        for (uint32_t j = (from_col); j < ((from_col) + (num_cols)); j++)                              \
+        {                                                                                              \
+            mAt(to, i, j) = mAt(from, i, j);                                                           \
+        }                                                                                              \
     }
 
 #define MAT_CLONE(from, to) \
     MAT_COPY(from, to, 0, mRows(from), 0, mCols(from))
 
-#define MAT_TRANSPOSE(m, t)                     \
-    for (uint32_t i = 0; i < mRows(m); i++)     \
-    {                                           \
-        for (uint32_t j = 0; j < mCols(m); j++) \
-        {                                       \
-            mAt(t, j, i) = mAt(m, i, j);        \
-        }                                       \
+/* The transpose is done in square tiles, so reading the rows and writing the
+ * columns of a tile stays within the cache also for large matrices.
+ */
+#define MAT_TRANSPOSE_TILE (16U)
+
+#define MAT_TRANSPOSE(m, t)                                                    \
+    for (uint32_t ti = 0; ti < mRows(m); ti += MAT_TRANSPOSE_TILE)             \
+    {                                                                          \
+        const uint32_t ti_end = MIN(ti + MAT_TRANSPOSE_TILE, mRows(m));        \
+        for (uint32_t tj = 0; tj < mCols(m); tj += MAT_TRANSPOSE_TILE)         \
+        {                                                                      \
+            const uint32_t tj_end = MIN(tj + MAT_TRANSPOSE_TILE, mCols(m));    \
+            for (uint32_t i = ti; i < ti_end; i++)                             \
+            {                                                                  \
+                for (uint32_t j = tj; j < tj_end; j++)                         \
+                {                                                              \
+                    mAt(t, j, i) = mAt(m, i, j);                               \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
     }
 
-/* apply unary operator to all elements from mat and store in result */
-#define MAT_APPLY_UNOP(mat, op, result)                 \
-    do                                                  \
-    {                                                   \
-        IFX_MAT_BRK_VALID(mat);                         \
-        IFX_MAT_BRK_VALID(result);                      \
-        IFX_MAT_BRK_DIM(mat, result);                   \
-        for (uint32_t r = 0; r < mRows(mat); r++)       \
-        {                                               \
-            for (uint32_t c = 0; c < mCols(mat); c++)   \
-            {                                           \
-                mAt(result, r, c) = op(mAt(mat, r, c)); \
-            }                                           \
-        }                                               \
+/* apply a kernel from internal/Kernels.h to matrices with contiguous rows;
+ * the kernel arguments are given for row r, if all matrices are contiguous
+ * the kernel is called only once for all elements
+ */
+#define MAT_APPLY_KERNEL(kernel, contiguous, m, ...)           \
+    do                                                         \
+    {                                                          \
+        const ifx_Kernels_t* kernels = ifx_kernels_get();      \
+        const uint32_t rows = (contiguous) ? 1 : mRows(m);     \
+        const size_t len = (contiguous) ? mSize(m) : mCols(m); \
+        for (uint32_t r = 0; r < rows; r++)                    \
+        {                                                      \
+            kernels->kernel(__VA_ARGS__, len);                 \
+        }                                                      \
     } while (0)
 
-/* apply binary operator to all pairs of elements from lhs and rhs and store in result */
-#define MAT_APPLY_BINOP(lhs, op, rhs, result)                           \
-    do                                                                  \
-    {                                                                   \
-        IFX_MAT_BRK_VALID(lhs);                                         \
-        IFX_MAT_BRK_VALID(rhs);                                         \
-        IFX_MAT_BRK_VALID(result);                                      \
-        IFX_MAT_BRK_DIM(lhs, result);                                   \
-        IFX_MAT_BRK_DIM(lhs, rhs);                                      \
-        for (uint32_t r = 0; r < mRows(lhs); r++)                       \
-        {                                                               \
-            for (uint32_t c = 0; c < mCols(lhs); c++)                   \
-            {                                                           \
-                mAt(result, r, c) = op(mAt(lhs, r, c), mAt(rhs, r, c)); \
-            }                                                           \
-        }                                                               \
+/* apply unary operator to all elements from mat and store in result;
+ * contiguous matrices are processed as one flat array so the compiler can
+ * vectorize the loop, otherwise the strides are loaded once instead of
+ * computing the offset with mAt for each element
+ */
+#define MAT_APPLY_UNOP(mat, op, result)                                                    \
+    do                                                                                     \
+    {                                                                                      \
+        IFX_MAT_BRK_VALID(mat);                                                            \
+        IFX_MAT_BRK_VALID(result);                                                         \
+        IFX_MAT_BRK_DIM(mat, result);                                                      \
+        if (MAT_CONTIGUOUS(mat) && MAT_CONTIGUOUS(result))                                 \
+        {                                                                                  \
+            const size_t size_ = mSize(mat);                                               \
+            for (size_t i = 0; i < size_; i++)                                             \
+                mDat(result)[i] = op(mDat(mat)[i]);                                        \
+        }                                                                                  \
+        else                                                                               \
+        {                                                                                  \
+            const size_t in_row_ = mStride(mat, 0), in_col_ = mStride(mat, 1);             \
+            const size_t out_row_ = mStride(result, 0), out_col_ = mStride(result, 1);     \
+            for (uint32_t r = 0; r < mRows(mat); r++)                                      \
+            {                                                                              \
+                for (uint32_t c = 0; c < mCols(mat); c++)                                  \
+                {                                                                          \
+                    mDat(result)[r * out_row_ + c * out_col_] =                            \
+                        op(mDat(mat)[r * in_row_ + c * in_col_]);                          \
+                }                                                                          \
+            }                                                                              \
+        }                                                                                  \
+    } while (0)
+
+/* apply binary operator to all pairs of elements from lhs and rhs and store
+ * in result; see MAT_APPLY_UNOP
+ */
+#define MAT_APPLY_BINOP(lhs, op, rhs, result)                                              \
+    do                                                                                     \
+    {                                                                                      \
+        IFX_MAT_BRK_VALID(lhs);                                                            \
+        IFX_MAT_BRK_VALID(rhs);                                                            \
+        IFX_MAT_BRK_VALID(result);                                                         \
+        IFX_MAT_BRK_DIM(lhs, result);                                                      \
+        IFX_MAT_BRK_DIM(lhs, rhs);                                                         \
+        if (MAT_CONTIGUOUS(lhs) && MAT_CONTIGUOUS(rhs) && MAT_CONTIGUOUS(result))          \
+        {                                                                                  \
+            const size_t size_ = mSize(lhs);                                               \
+            for (size_t i = 0; i < size_; i++)                                             \
+                mDat(result)[i] = op(mDat(lhs)[i], mDat(rhs)[i]);                          \
+        }                                                                                  \
+        else                                                                               \
+        {                                                                                  \
+            const size_t lhs_row_ = mStride(lhs, 0), lhs_col_ = mStride(lhs, 1);           \
+            const size_t rhs_row_ = mStride(rhs, 0), rhs_col_ = mStride(rhs, 1);           \
+            const size_t out_row_ = mStride(result, 0), out_col_ = mStride(result, 1);     \
+            for (uint32_t r = 0; r < mRows(lhs); r++)                                      \
+            {                                                                              \
+                for (uint32_t c = 0; c < mCols(lhs); c++)                                  \
+                {                                                                          \
+                    mDat(result)[r * out_row_ + c * out_col_] =                            \
+                        op(mDat(lhs)[r * lhs_row_ + c * lhs_col_],                         \
+                           mDat(rhs)[r * rhs_row_ + c * rhs_col_]);                        \
+                }                                                                          \
+            }                                                                              \
+        }                                                                                  \
     } while (0)
 
 
@@ -466,7 +539,7 @@ void ifx_mat_add_c(const ifx_Matrix_C_t* matrix_l,
                    const ifx_Matrix_C_t* matrix_r,
                    ifx_Matrix_C_t* result)
 {
-#define OP(a, b) ifx_complex_add((a), (b))
+#define OP(a, b) ifx_cadd((a), (b))
     MAT_APPLY_BINOP(matrix_l, OP, matrix_r, result);
 #undef OP
 }
@@ -477,7 +550,7 @@ void ifx_mat_add_cs(const ifx_Matrix_C_t* input,
                     ifx_Complex_t scalar,
                     ifx_Matrix_C_t* output)
 {
-#define OP(elem) ifx_complex_add(elem, scalar)
+#define OP(elem) ifx_cadd(elem, scalar)
     MAT_APPLY_UNOP(input, OP, output);
 #undef OP
 }
@@ -510,7 +583,7 @@ void ifx_mat_sub_c(const ifx_Matrix_C_t* matrix_l,
                    const ifx_Matrix_C_t* matrix_r,
                    ifx_Matrix_C_t* result)
 {
-#define OP(a, b) ifx_complex_sub((a), (b))
+#define OP(a, b) ifx_csub((a), (b))
     MAT_APPLY_BINOP(matrix_l, OP, matrix_r, result);
 #undef OP
 }
@@ -521,7 +594,7 @@ void ifx_mat_sub_cs(const ifx_Matrix_C_t* input,
                     ifx_Complex_t scalar,
                     ifx_Matrix_C_t* output)
 {
-#define OP(elem) ifx_complex_sub(elem, scalar)
+#define OP(elem) ifx_csub(elem, scalar)
     MAT_APPLY_UNOP(input, OP, output);
 #undef OP
 }
@@ -552,7 +625,7 @@ void ifx_mat_scale_rc(const ifx_Matrix_R_t* input,
         for (uint32_t c = 0; c < mCols(input); c++)
         {
             ifx_Complex_t tmp_r2c = IFX_COMPLEX_DEF(mAt(input, r, c), 0);
-            mAt(output, r, c) = ifx_complex_mul(tmp_r2c, scale);
+            mAt(output, r, c) = ifx_cmul(tmp_r2c, scale);
         }
     }
 }
@@ -563,7 +636,18 @@ void ifx_mat_scale_c(const ifx_Matrix_C_t* input,
                      ifx_Complex_t scale,
                      ifx_Matrix_C_t* output)
 {
-#define OP(elem) ifx_complex_mul(elem, scale)
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_MAT_BRK_DIM(input, output);
+
+    if (MAT_ROWS_CONTIGUOUS(input) && MAT_ROWS_CONTIGUOUS(output))
+    {
+        MAT_APPLY_KERNEL(scale_c, MAT_CONTIGUOUS(input) && MAT_CONTIGUOUS(output), input,
+                         &mAt(input, r, 0), scale, &mAt(output, r, 0));
+        return;
+    }
+
+#define OP(elem) ifx_cmul(elem, scale)
     MAT_APPLY_UNOP(input, OP, output);
 #undef OP
 }
@@ -574,7 +658,7 @@ void ifx_mat_scale_cr(const ifx_Matrix_C_t* input,
                       ifx_Float_t scale,
                       ifx_Matrix_C_t* output)
 {
-#define OP(elem) ifx_complex_mul_real(elem, scale)
+#define OP(elem) ifx_cscale(elem, scale)
     MAT_APPLY_UNOP(input, OP, output);
 #undef OP
 }
@@ -598,7 +682,20 @@ void ifx_mat_mac_c(const ifx_Matrix_C_t* m1,
                    ifx_Complex_t scale,
                    ifx_Matrix_C_t* output)
 {
-#define OP(m1, m2) ifx_complex_add((m1), ifx_complex_mul((m2), scale))
+    IFX_MAT_BRK_VALID(m1);
+    IFX_MAT_BRK_VALID(m2);
+    IFX_MAT_BRK_VALID(output);
+    IFX_MAT_BRK_DIM(m1, output);
+    IFX_MAT_BRK_DIM(m1, m2);
+
+    if (MAT_ROWS_CONTIGUOUS(m1) && MAT_ROWS_CONTIGUOUS(m2) && MAT_ROWS_CONTIGUOUS(output))
+    {
+        MAT_APPLY_KERNEL(mac_c, MAT_CONTIGUOUS(m1) && MAT_CONTIGUOUS(m2) && MAT_CONTIGUOUS(output), m1,
+                         &mAt(m1, r, 0), &mAt(m2, r, 0), scale, &mAt(output, r, 0));
+        return;
+    }
+
+#define OP(m1, m2) ifx_cadd((m1), ifx_cmul((m2), scale))
     MAT_APPLY_BINOP(m1, OP, m2, output);
 #undef OP
 }
@@ -618,6 +715,17 @@ void ifx_mat_abs_r(const ifx_Matrix_R_t* input,
 void ifx_mat_abs_c(const ifx_Matrix_C_t* input,
                    ifx_Matrix_R_t* output)
 {
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
+    IFX_MAT_BRK_DIM(input, output);
+
+    if (MAT_ROWS_CONTIGUOUS(input) && MAT_ROWS_CONTIGUOUS(output))
+    {
+        MAT_APPLY_KERNEL(abs_c, MAT_CONTIGUOUS(input) && MAT_CONTIGUOUS(output), input,
+                         &mAt(input, r, 0), &mAt(output, r, 0));
+        return;
+    }
+
 #define OP(elem) ifx_complex_abs(elem);
     MAT_APPLY_UNOP(input, OP, output);
 #undef OP
@@ -699,7 +807,7 @@ ifx_Float_t ifx_mat_sqsum_c(const ifx_Matrix_C_t* matrix)
     {
         for (uint32_t c = 0; c < mCols(matrix); c++)
         {
-            result += ifx_complex_sqnorm(mAt(matrix, r, c));
+            result += ifx_cabs2(mAt(matrix, r, c));
         }
     }
 
@@ -743,7 +851,7 @@ ifx_Float_t ifx_mat_maxabs_c(const ifx_Matrix_C_t* matrix)
     {
         for (uint32_t c = 0; c < mCols(matrix); c++)
         {
-            const ifx_Float_t val = ifx_complex_sqnorm(mAt(matrix, r, c));
+            const ifx_Float_t val = ifx_cabs2(mAt(matrix, r, c));
 
             if (val > max)
             {
@@ -831,6 +939,70 @@ ifx_Float_t ifx_mat_var_r(const ifx_Matrix_R_t* matrix)
 
 //----------------------------------------------------------------------------
 
+void ifx_mat_stats_rows_r(const ifx_Matrix_R_t* matrix, ifx_Stats_R_t* stats)
+{
+    IFX_MAT_BRK_VALID(matrix);
+    IFX_ERR_BRK_NULL(stats);
+
+    for (uint32_t r = 0; r < mRows(matrix); r++)
+    {
+        ifx_Vector_R_t row = {0};
+        ifx_mat_get_rowview_r(matrix, r, &row);
+        ifx_vec_stats_r(&row, &stats[r]);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mat_stats_cols_r(const ifx_Matrix_R_t* matrix, ifx_Stats_R_t* stats)
+{
+    IFX_MAT_BRK_VALID(matrix);
+    IFX_ERR_BRK_NULL(stats);
+    IFX_ERR_BRK_ARGUMENT(mRows(matrix) == 0);
+
+    const uint32_t cols = mCols(matrix);
+
+    for (uint32_t c = 0; c < cols; c++)
+    {
+        const ifx_Float_t x = mAt(matrix, 0, c);
+        stats[c].mean = x;
+        stats[c].variance = 0;
+        stats[c].min = x;
+        stats[c].max = x;
+        stats[c].min_idx = 0;
+        stats[c].max_idx = 0;
+    }
+
+    // variance holds the sum of squared deviations until all rows are read
+    for (uint32_t r = 1; r < mRows(matrix); r++)
+    {
+        const ifx_Float_t inv_n = 1.0f / (ifx_Float_t)(r + 1);
+        for (uint32_t c = 0; c < cols; c++)
+        {
+            ifx_Stats_R_t* s = &stats[c];
+            const ifx_Float_t x = mAt(matrix, r, c);
+            const ifx_Float_t delta = x - s->mean;
+            s->mean += delta * inv_n;
+            s->variance += delta * (x - s->mean);
+            if (x < s->min)
+            {
+                s->min = x;
+                s->min_idx = r;
+            }
+            if (x > s->max)
+            {
+                s->max = x;
+                s->max_idx = r;
+            }
+        }
+    }
+
+    for (uint32_t c = 0; c < cols; c++)
+        stats[c].variance /= (ifx_Float_t)mRows(matrix);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_mat_abt_r(const ifx_Matrix_R_t* inputA,
                    const ifx_Matrix_R_t* inputB,
                    ifx_Matrix_R_t* output)
@@ -884,7 +1056,7 @@ void ifx_mat_abct_c(const ifx_Matrix_C_t* inputA,
                 ifx_Float_t rb = IFX_COMPLEX_REAL(mAt(inputB, j_row, col));
                 ifx_Float_t ib = IFX_COMPLEX_IMAG(mAt(inputB, j_row, col));
                 ifx_Complex_t tmp = IFX_COMPLEX_DEF(ra * rb + ia * ib, -ra * ib + rb * ia);
-                sum = ifx_complex_add(sum, tmp);
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_row, j_row) = sum;
         }
@@ -913,8 +1085,8 @@ void ifx_mat_abt_c(const ifx_Matrix_C_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t col = 0; col < mCols(inputA); ++col)
             {
-                ifx_Complex_t tmp = ifx_complex_mul(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cmul(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_row, j_row) = sum;
         }
@@ -943,8 +1115,8 @@ void ifx_mat_abt_rc(const ifx_Matrix_R_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t col = 0; col < mCols(inputA); ++col)
             {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputB, j_row, col), mAt(inputA, i_row, col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cscale(mAt(inputB, j_row, col), mAt(inputA, i_row, col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_row, j_row) = sum;
         }
@@ -973,8 +1145,8 @@ void ifx_mat_abt_cr(const ifx_Matrix_C_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t col = 0; col < mCols(inputA); ++col)
             {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cscale(mAt(inputA, i_row, col), mAt(inputB, j_row, col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_row, j_row) = sum;
         }
@@ -1031,8 +1203,8 @@ void ifx_mat_atb_c(const ifx_Matrix_C_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t row = 0; row < mRows(inputA); ++row)
             {
-                ifx_Complex_t tmp = ifx_complex_mul(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cmul(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_col, j_col) = sum;
         }
@@ -1061,8 +1233,8 @@ void ifx_mat_atb_rc(const ifx_Matrix_R_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t row = 0; row < mRows(inputA); ++row)
             {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputB, row, j_col), mAt(inputA, row, i_col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cscale(mAt(inputB, row, j_col), mAt(inputA, row, i_col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_col, j_col) = sum;
         }
@@ -1091,8 +1263,8 @@ void ifx_mat_atb_cr(const ifx_Matrix_C_t* inputA,
             ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
             for (uint32_t row = 0; row < mRows(inputA); ++row)
             {
-                ifx_Complex_t tmp = ifx_complex_mul_real(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
-                sum = ifx_complex_add(sum, tmp);
+                ifx_Complex_t tmp = ifx_cscale(mAt(inputA, row, i_col), mAt(inputB, row, j_col));
+                sum = ifx_cadd(sum, tmp);
             }
             mAt(output, i_col, j_col) = sum;
         }
@@ -1182,7 +1354,7 @@ void ifx_mat_mul_cv(const ifx_Matrix_C_t* matrix,
 
         for (uint32_t k = 0; k < mCols(matrix); k++)
         {
-            s = ifx_complex_add(s, ifx_complex_mul(IFX_MAT_AT(matrix, j, k), IFX_VEC_AT(vector, k)));
+            s = ifx_cadd(s, ifx_cmul(IFX_MAT_AT(matrix, j, k), IFX_VEC_AT(vector, k)));
         }
 
         IFX_VEC_AT(result, j) = s;
@@ -1212,7 +1384,7 @@ void ifx_mat_trans_mul_cv(const ifx_Matrix_C_t* matrix,
 
         for (uint32_t k = 0; k < mCols(matrix); k++)
         {
-            s = ifx_complex_add(s, ifx_complex_mul(IFX_MAT_AT(matrix, k, j), IFX_VEC_AT(vector, k)));
+            s = ifx_cadd(s, ifx_cmul(IFX_MAT_AT(matrix, k, j), IFX_VEC_AT(vector, k)));
         }
 
         IFX_VEC_AT(result, j) = s;
@@ -1275,7 +1447,7 @@ void ifx_mat_mul_rc(const ifx_Matrix_R_t* matrix_l,
             {
                 ifx_Float_t a = IFX_MAT_AT(matrix_l, j, l);
                 ifx_Complex_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul_real(b, a));
+                sum = ifx_cadd(sum, ifx_cscale(b, a));
             }
 
             IFX_MAT_AT(result, j, k) = sum;
@@ -1308,7 +1480,7 @@ void ifx_mat_mul_c(const ifx_Matrix_C_t* matrix_l,
             {
                 ifx_Complex_t a = IFX_MAT_AT(matrix_l, j, l);
                 ifx_Complex_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul(a, b));
+                sum = ifx_cadd(sum, ifx_cmul(a, b));
             }
 
             IFX_MAT_AT(result, j, k) = sum;
@@ -1341,7 +1513,7 @@ void ifx_mat_mul_cr(const ifx_Matrix_C_t* matrix_l,
             {
                 ifx_Complex_t a = IFX_MAT_AT(matrix_l, j, l);
                 ifx_Float_t b = IFX_MAT_AT(matrix_r, l, k);
-                sum = ifx_complex_add(sum, ifx_complex_mul_real(a, b));
+                sum = ifx_cadd(sum, ifx_cscale(a, b));
             }
 
             IFX_MAT_AT(result, j, k) = sum;
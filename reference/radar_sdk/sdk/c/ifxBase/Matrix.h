@@ -82,46 +82,46 @@ extern "C"
 #define IFX_MAT_AT(m, r, c) IFX_MDA_AT(m, r, c)
 
 // Condition check macro adaptations for Matrix module -----------------------
-#define IFX_MAT_BRK_DIM(m1, m2)    IFX_ERR_BRK_COND((mCols(m1) != mCols(m2)) || (mRows(m1) != mRows(m2)), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_DIM(m1, m2, v) IFX_ERR_BRV_COND((mCols(m1) != mCols(m2)) || (mRows(m1) != mRows(m2)), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_DIM(m1, m2)    IFX_ERR_ARG_BRK_COND((mCols(m1) != mCols(m2)) || (mRows(m1) != mRows(m2)), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_DIM(m1, m2, v) IFX_ERR_ARG_BRV_COND((mCols(m1) != mCols(m2)) || (mRows(m1) != mRows(m2)), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_SIZE(m1, m2)    IFX_ERR_BRK_COND(mSize(m1) != mSize(m2), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_SIZE(m1, m2, v) IFX_ERR_BRV_COND(mSize(m1) != mSize(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_SIZE(m1, m2)    IFX_ERR_ARG_BRK_COND(mSize(m1) != mSize(m2), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_SIZE(m1, m2, v) IFX_ERR_ARG_BRV_COND(mSize(m1) != mSize(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_SQUARE(m)    IFX_ERR_BRK_COND(mRows(m) != mCols(m), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_SQUARE(m, v) IFX_ERR_BRV_COND(mRows(m) != mCols(m), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_SQUARE(m)    IFX_ERR_ARG_BRK_COND(mRows(m) != mCols(m), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_SQUARE(m, v) IFX_ERR_ARG_BRV_COND(mRows(m) != mCols(m), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_DIM_COL_ROW(m1, m2)    IFX_ERR_BRK_COND(mCols(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_DIM_COL_ROW(m1, m2, v) IFX_ERR_BRV_COND(mCols(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_DIM_COL_ROW(m1, m2)    IFX_ERR_ARG_BRK_COND(mCols(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_DIM_COL_ROW(m1, m2, v) IFX_ERR_ARG_BRV_COND(mCols(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_DIM_COL(m1, m2)    IFX_ERR_BRK_COND(mCols(m1) != mCols(m2), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_DIM_COL(m1, m2, v) IFX_ERR_BRV_COND(mCols(m1) != mCols(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_DIM_COL(m1, m2)    IFX_ERR_ARG_BRK_COND(mCols(m1) != mCols(m2), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_DIM_COL(m1, m2, v) IFX_ERR_ARG_BRV_COND(mCols(m1) != mCols(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_DIM_ROW(m1, m2)    IFX_ERR_BRK_COND(mRows(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_MAT_BRV_DIM_ROW(m1, m2, v) IFX_ERR_BRV_COND(mRows(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
+#define IFX_MAT_BRK_DIM_ROW(m1, m2)    IFX_ERR_ARG_BRK_COND(mRows(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_MAT_BRV_DIM_ROW(m1, m2, v) IFX_ERR_ARG_BRV_COND(mRows(m1) != mRows(m2), IFX_ERROR_DIMENSION_MISMATCH, v)
 
-#define IFX_MAT_BRK_IDX(m, r, c)    IFX_ERR_BRK_COND(((r) >= mRows(m)) || ((c) >= mCols(m)), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
-#define IFX_MAT_BRV_IDX(m, r, c, v) IFX_ERR_BRV_COND(((r) >= mRows(m)) || ((c) >= mCols(m)), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
+#define IFX_MAT_BRK_IDX(m, r, c)    IFX_ERR_ARG_BRK_COND(((r) >= mRows(m)) || ((c) >= mCols(m)), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
+#define IFX_MAT_BRV_IDX(m, r, c, v) IFX_ERR_ARG_BRV_COND(((r) >= mRows(m)) || ((c) >= mCols(m)), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
 
-#define IFX_MAT_BRK_ROWS(m, r)    IFX_ERR_BRK_COND((r) > mRows(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
-#define IFX_MAT_BRV_ROWS(m, r, v) IFX_ERR_BRK_COND((r) > mRows(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
+#define IFX_MAT_BRK_ROWS(m, r)    IFX_ERR_ARG_BRK_COND((r) > mRows(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
+#define IFX_MAT_BRV_ROWS(m, r, v) IFX_ERR_ARG_BRV_COND((r) > mRows(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
 
-#define IFX_MAT_BRK_COLS(m, c)    IFX_ERR_BRK_COND((c) > mCols(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
-#define IFX_MAT_BRV_COLS(m, c, v) IFX_ERR_BRK_COND((c) > mCols(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
+#define IFX_MAT_BRK_COLS(m, c)    IFX_ERR_ARG_BRK_COND((c) > mCols(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS)
+#define IFX_MAT_BRV_COLS(m, c, v) IFX_ERR_ARG_BRV_COND((c) > mCols(m), IFX_ERROR_INDEX_OUT_OF_BOUNDS, v)
 
-#define IFX_MAT_BRK_VALID(m)                                                        \
-    do                                                                              \
-    {                                                                               \
-        IFX_ERR_BRK_NULL(m);                                                        \
-        IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(m) != 2, IFX_ERROR_DIMENSION_MISMATCH); \
-        IFX_ERR_BRK_ARGUMENT(IFX_MDA_DATA(m) == NULL)                               \
+#define IFX_MAT_BRK_VALID(m)                                                            \
+    do                                                                                  \
+    {                                                                                   \
+        IFX_ERR_ARG_BRK_COND(!(m), IFX_ERROR_ARGUMENT_NULL);                            \
+        IFX_ERR_ARG_BRK_COND(IFX_MDA_DIMENSIONS(m) != 2, IFX_ERROR_DIMENSION_MISMATCH); \
+        IFX_ERR_ARG_BRK_COND(IFX_MDA_DATA(m) == NULL, IFX_ERROR_ARGUMENT_INVALID);      \
     } while (0)
-#define IFX_MAT_BRV_VALID(m, r)                                                        \
-    do                                                                                 \
-    {                                                                                  \
-        IFX_ERR_BRV_NULL(m, r);                                                        \
-        IFX_ERR_BRV_COND(IFX_MDA_DIMENSIONS(m) != 2, IFX_ERROR_DIMENSION_MISMATCH, r); \
-        IFX_ERR_BRV_ARGUMENT(IFX_MDA_DATA(m) == NULL, r)                               \
+#define IFX_MAT_BRV_VALID(m, r)                                                            \
+    do                                                                                     \
+    {                                                                                      \
+        IFX_ERR_ARG_BRV_COND(!(m), IFX_ERROR_ARGUMENT_NULL, r);                            \
+        IFX_ERR_ARG_BRV_COND(IFX_MDA_DIMENSIONS(m) != 2, IFX_ERROR_DIMENSION_MISMATCH, r); \
+        IFX_ERR_ARG_BRV_COND(IFX_MDA_DATA(m) == NULL, IFX_ERROR_ARGUMENT_INVALID, r);      \
     } while (0)
 
 /*
@@ -972,6 +972,32 @@ ifx_Float_t ifx_mat_max_r(const ifx_Matrix_R_t* matrix);
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_mat_var_r(const ifx_Matrix_R_t* matrix);
 
+/**
+ * @brief Computes the statistics of each row of a real-valued matrix in one pass.
+ *
+ * See \ref ifx_vec_stats_r, the indices of minimum and maximum are column indices.
+ *
+ * @param [in]     matrix    Pointer to a data memory defined by \ref ifx_Matrix_R_t.
+ * @param [out]    stats     Array of statistics, one for each row of the matrix.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_mat_stats_rows_r(const ifx_Matrix_R_t* matrix, ifx_Stats_R_t* stats);
+
+/**
+ * @brief Computes the statistics of each column of a real-valued matrix in one pass.
+ *
+ * The matrix is read row by row, the mean and variance of all columns are
+ * updated together with Welford's algorithm. The indices of minimum and
+ * maximum are row indices.
+ *
+ * @param [in]     matrix    Pointer to a data memory defined by \ref ifx_Matrix_R_t.
+ * @param [out]    stats     Array of statistics, one for each column of the matrix.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_mat_stats_cols_r(const ifx_Matrix_R_t* matrix, ifx_Stats_R_t* stats);
+
 /**
  * @brief Computes matrix multiplication for:
  *          output = inputA * inputB-Transpose
@@ -27,11 +27,13 @@
 ** ===========================================================================
 */
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 
 #include "Complex.h"
 #include "Error.h"
+#include "internal/Kernels.h"
 #include "internal/Mda.hpp"
 #include "Mda.h"
 #include "Mem.h"
@@ -77,37 +79,40 @@ static inline size_t compute_data_size(const uint32_t dimensions, const uint32_t
     return mul_ovf(size, size_element, overflow);
 }
 
+/**
+ * @brief Create an array with structure and data in one block
+ *
+ * The data follows the structure, padded to alignment. The array does not
+ * have IFX_MDA_FLAG_OWNS_DATA set, as the data is released together with
+ * the structure.
+ */
 template <class MDA_TYPE>
-static inline MDA_TYPE* mda_create(const uint32_t dimensions, const uint32_t shape[])
+static inline MDA_TYPE* mda_create(const uint32_t dimensions, const uint32_t shape[], size_t alignment = IFX_MEMORY_ALIGNMENT)
 {
     IFX_ERR_BRV_NULL(shape, nullptr);
     IFX_ERR_BRV_COND(dimensions > IFX_MDA_MAX_DIM, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS, nullptr);
+    IFX_ERR_BRV_ARGUMENT(alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > IFX_MDA_MAX_ALIGNMENT, nullptr);
 
-    // Allocate memory for structure; it is important that the memory is initialized with zeros
-    auto* mda = static_cast<MDA_TYPE*>(ifx_mem_calloc(sizeof(MDA_TYPE), 1));
-    IFX_ERR_BRV_MEMALLOC(mda, nullptr);
+    using dtype = decltype(MDA_TYPE::data[0]);  // type of element, i.e. ifx_Float_t or ifx_Complex_t
+    using dtype_p = decltype(MDA_TYPE::data);   // pointer type of element, i.e. ifx_Float_t* or ifx_Complex_t*
 
-    using dtype = decltype(IFX_MDA_DATA(mda)[0]);  // type of element, i.e. ifx_Float_t or ifx_Complex_t
-    using dtype_p = decltype(mda->data);           // pointer type of element, i.e. ifx_Float_t* or ifx_Complex_t*
+    if (alignment < alignof(MDA_TYPE))
+        alignment = alignof(MDA_TYPE);
 
-    // Compute requireed size for data
+    // Compute required size for data and structure
     bool overflow = false;
     const size_t data_size = compute_data_size(dimensions, shape, sizeof(dtype), &overflow);
-    if (overflow)
-    {
-        ifx_mem_free(mda);
-        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
-        return nullptr;
-    }
+    const size_t header_size = IFX_ALIGN(sizeof(MDA_TYPE), alignment);
+    IFX_ERR_BRV_MEMALLOC(!overflow && data_size <= SIZE_MAX - header_size, nullptr);
 
-    // Allocate memory for data
-    IFX_MDA_DATA(mda) = static_cast<dtype_p>(ifx_mem_aligned_alloc(data_size, IFX_MEMORY_ALIGNMENT));
-    if (!mda->data)
-    {
-        ifx_mem_free(mda);
-        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
-        return nullptr;
-    }
+    auto* block = static_cast<uint8_t*>(ifx_mem_aligned_alloc(header_size + data_size, alignment));
+    IFX_ERR_BRV_MEMALLOC(block, nullptr);
+
+    // it is important that the structure is initialized with zeros
+    auto* mda = reinterpret_cast<MDA_TYPE*>(block);
+    std::memset(mda, 0, sizeof(MDA_TYPE));
+
+    IFX_MDA_DATA(mda) = reinterpret_cast<dtype_p>(block + header_size);
 
     // Initialize dimensions
     IFX_MDA_DIMENSIONS(mda) = dimensions;
@@ -115,9 +120,6 @@ static inline MDA_TYPE* mda_create(const uint32_t dimensions, const uint32_t sha
     // Copy shape
     std::memcpy(IFX_MDA_SHAPE(mda), shape, sizeof(uint32_t) * dimensions);
 
-    // The object owns the memory of data
-    IFX_MDA_FLAGS(mda) |= IFX_MDA_FLAG_OWNS_DATA;
-
     // Initialize stride
     {
         size_t offset = 1;
@@ -142,16 +144,37 @@ ifx_Mda_C_t* ifx_mda_create_c(const uint32_t dimensions, const uint32_t shape[])
     return mda_create<ifx_Mda_C_t>(dimensions, shape);
 }
 
+ifx_Mda_R_t* ifx_mda_create_aligned_r(const uint32_t dimensions, const uint32_t shape[], size_t alignment)
+{
+    return mda_create<ifx_Mda_R_t>(dimensions, shape, alignment);
+}
+
+ifx_Mda_C_t* ifx_mda_create_aligned_c(const uint32_t dimensions, const uint32_t shape[], size_t alignment)
+{
+    return mda_create<ifx_Mda_C_t>(dimensions, shape, alignment);
+}
+
+ifx_Mda_H_t* ifx_mda_create_h(const uint32_t dimensions, const uint32_t shape[])
+{
+    return mda_create<ifx_Mda_H_t>(dimensions, shape);
+}
+
+ifx_Mda_HC_t* ifx_mda_create_hc(const uint32_t dimensions, const uint32_t shape[])
+{
+    return mda_create<ifx_Mda_HC_t>(dimensions, shape);
+}
+
 template <class MDA_TYPE>
 static inline void ifx_mda_destroy(MDA_TYPE mda)
 {
     if (!mda)
         return;
 
+    // data allocated separately, e.g. by ifx_avian_get_next_frame
     if (IFX_MDA_OWNS_DATA(mda))
         ifx_mem_aligned_free(IFX_MDA_DATA(mda));
 
-    ifx_mem_free(mda);
+    ifx_mem_aligned_free(mda);
 }
 
 void ifx_mda_destroy_r(ifx_Mda_R_t* mda)
@@ -164,6 +187,16 @@ void ifx_mda_destroy_c(ifx_Mda_C_t* mda)
     ifx_mda_destroy(mda);
 }
 
+void ifx_mda_destroy_h(ifx_Mda_H_t* mda)
+{
+    ifx_mda_destroy(mda);
+}
+
+void ifx_mda_destroy_hc(ifx_Mda_HC_t* mda)
+{
+    ifx_mda_destroy(mda);
+}
+
 template <class MDA_TYPE>
 static inline void mda_view(MDA_TYPE* view, const MDA_TYPE* orig, const size_t num_slices, const ifx_mda_slice_t slices[])
 {
@@ -256,6 +289,246 @@ void ifx_mda_view_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, const size_t num
     mda_view(view, orig, num_slices, slices);
 }
 
+template <class MDA_TYPE>
+static inline void mda_permute(MDA_TYPE* view, const MDA_TYPE* orig, const size_t num_axes, const uint32_t axes[])
+{
+    IFX_ERR_BRK_NULL(view);
+    IFX_ERR_BRK_NULL(orig);
+    IFX_ERR_BRK_NULL(axes);
+
+    const uint32_t dimensions = IFX_MDA_DIMENSIONS(orig);
+    IFX_ERR_BRK_COND(num_axes != dimensions, IFX_ERROR_DIMENSION_MISMATCH);
+
+    // every axis of orig must appear exactly once
+    uint32_t seen = 0;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        IFX_ERR_BRK_COND(axes[dim] >= dimensions, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+        IFX_ERR_BRK_COND(seen & (1u << axes[dim]), IFX_ERROR_ARGUMENT_INVALID);
+        seen |= 1u << axes[dim];
+    }
+
+    // orig and view may alias, so take copies before writing
+    uint32_t shape[IFX_MDA_MAX_DIM];
+    size_t stride[IFX_MDA_MAX_DIM];
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        shape[dim] = IFX_MDA_SHAPE(orig)[axes[dim]];
+        stride[dim] = IFX_MDA_STRIDE(orig)[axes[dim]];
+    }
+    auto* data = IFX_MDA_DATA(orig);
+
+    std::memset(view, 0, sizeof(MDA_TYPE));
+    IFX_MDA_DIMENSIONS(view) = dimensions;
+    IFX_MDA_DATA(view) = data;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        IFX_MDA_SHAPE(view)[dim] = shape[dim];
+        IFX_MDA_STRIDE(view)[dim] = stride[dim];
+    }
+}
+
+void ifx_mda_permute_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig, const size_t num_axes, const uint32_t axes[])
+{
+    mda_permute(view, orig, num_axes, axes);
+}
+
+void ifx_mda_permute_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, const size_t num_axes, const uint32_t axes[])
+{
+    mda_permute(view, orig, num_axes, axes);
+}
+
+template <class MDA_TYPE>
+static inline void mda_reshape(MDA_TYPE* view, const MDA_TYPE* orig, const uint32_t dimensions, const uint32_t shape[])
+{
+    IFX_ERR_BRK_NULL(view);
+    IFX_ERR_BRK_NULL(orig);
+    IFX_ERR_BRK_NULL(shape);
+    IFX_ERR_BRK_COND(dimensions == 0 || dimensions > IFX_MDA_MAX_DIM, IFX_ERROR_DIMENSION_MISMATCH);
+
+    // shape may point into view
+    uint32_t new_shape[IFX_MDA_MAX_DIM] = {0};
+    size_t elements = 1;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        new_shape[dim] = shape[dim];
+        elements *= shape[dim];
+    }
+    IFX_ERR_BRK_COND(elements == 0 || elements != mda_elements(orig), IFX_ERROR_DIMENSION_MISMATCH);
+
+    // axes of length 1 do not constrain the strides
+    uint32_t old_shape[IFX_MDA_MAX_DIM];
+    size_t old_stride[IFX_MDA_MAX_DIM];
+    uint32_t old_dimensions = 0;
+    for (uint32_t dim = 0; dim < IFX_MDA_DIMENSIONS(orig); dim++)
+    {
+        if (IFX_MDA_SHAPE(orig)[dim] != 1)
+        {
+            old_shape[old_dimensions] = IFX_MDA_SHAPE(orig)[dim];
+            old_stride[old_dimensions] = IFX_MDA_STRIDE(orig)[dim];
+            old_dimensions++;
+        }
+    }
+
+    /* Same as numpy: the axes of both shapes are split into the shortest
+     * groups with the same number of elements. The old axes of a group must
+     * be contiguous among themselves, then the new axes of the group get
+     * strides that step through them in the same order.
+     */
+    size_t stride[IFX_MDA_MAX_DIM];
+    uint32_t oi = 0, oj = 1, ni = 0, nj = 1;
+    while (ni < dimensions && oi < old_dimensions)
+    {
+        size_t np = new_shape[ni];
+        size_t op = old_shape[oi];
+        while (np != op)
+        {
+            if (np < op)
+                np *= new_shape[nj++];
+            else
+                op *= old_shape[oj++];
+        }
+
+        for (uint32_t ok = oi; ok + 1 < oj; ok++)
+        {
+            IFX_ERR_BRK_COND(old_stride[ok] != old_shape[ok + 1] * old_stride[ok + 1], IFX_ERROR_ARGUMENT_INVALID);
+        }
+
+        stride[nj - 1] = old_stride[oj - 1];
+        for (uint32_t nk = nj - 1; nk > ni; nk--)
+            stride[nk - 1] = stride[nk] * new_shape[nk];
+
+        ni = nj++;
+        oi = oj++;
+    }
+
+    // the remaining axes have length 1
+    for (; ni < dimensions; ni++)
+        stride[ni] = 1;
+
+    auto* data = IFX_MDA_DATA(orig);
+
+    std::memset(view, 0, sizeof(MDA_TYPE));
+    IFX_MDA_DIMENSIONS(view) = dimensions;
+    IFX_MDA_DATA(view) = data;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        IFX_MDA_SHAPE(view)[dim] = new_shape[dim];
+        IFX_MDA_STRIDE(view)[dim] = stride[dim];
+    }
+}
+
+void ifx_mda_reshape_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig, const uint32_t dimensions, const uint32_t shape[])
+{
+    mda_reshape(view, orig, dimensions, shape);
+}
+
+void ifx_mda_reshape_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, const uint32_t dimensions, const uint32_t shape[])
+{
+    mda_reshape(view, orig, dimensions, shape);
+}
+
+template <class MDA_TYPE>
+static inline void mda_squeeze(MDA_TYPE* view, const MDA_TYPE* orig)
+{
+    IFX_ERR_BRK_NULL(view);
+    IFX_ERR_BRK_NULL(orig);
+    IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(orig) == 0, IFX_ERROR_DIMENSION_MISMATCH);
+
+    uint32_t shape[IFX_MDA_MAX_DIM];
+    size_t stride[IFX_MDA_MAX_DIM];
+    uint32_t dimensions = 0;
+    for (uint32_t dim = 0; dim < IFX_MDA_DIMENSIONS(orig); dim++)
+    {
+        if (IFX_MDA_SHAPE(orig)[dim] != 1)
+        {
+            shape[dimensions] = IFX_MDA_SHAPE(orig)[dim];
+            stride[dimensions] = IFX_MDA_STRIDE(orig)[dim];
+            dimensions++;
+        }
+    }
+
+    if (dimensions == 0)
+    {
+        shape[0] = 1;
+        stride[0] = IFX_MDA_STRIDE(orig)[0];
+        dimensions = 1;
+    }
+
+    auto* data = IFX_MDA_DATA(orig);
+
+    std::memset(view, 0, sizeof(MDA_TYPE));
+    IFX_MDA_DIMENSIONS(view) = dimensions;
+    IFX_MDA_DATA(view) = data;
+    for (uint32_t dim = 0; dim < dimensions; dim++)
+    {
+        IFX_MDA_SHAPE(view)[dim] = shape[dim];
+        IFX_MDA_STRIDE(view)[dim] = stride[dim];
+    }
+}
+
+void ifx_mda_squeeze_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig)
+{
+    mda_squeeze(view, orig);
+}
+
+void ifx_mda_squeeze_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig)
+{
+    mda_squeeze(view, orig);
+}
+
+template <class MDA_TYPE>
+static inline void mda_as_vector(MDA_TYPE* view, const MDA_TYPE* orig)
+{
+    IFX_ERR_BRK_NULL(orig);
+
+    const uint32_t shape[1] = {static_cast<uint32_t>(mda_elements(orig))};
+    mda_reshape(view, orig, 1, shape);
+}
+
+void ifx_mda_as_vector_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig)
+{
+    mda_as_vector(view, orig);
+}
+
+void ifx_mda_as_vector_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig)
+{
+    mda_as_vector(view, orig);
+}
+
+template <class MDA_TYPE>
+static inline void mda_as_matrix(MDA_TYPE* view, const MDA_TYPE* orig)
+{
+    IFX_ERR_BRK_NULL(orig);
+    IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(orig) == 0, IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t cols = IFX_MDA_SHAPE(orig)[IFX_MDA_DIMENSIONS(orig) - 1];
+    IFX_ERR_BRK_COND(cols == 0, IFX_ERROR_DIMENSION_MISMATCH);
+
+    const uint32_t shape[2] = {static_cast<uint32_t>(mda_elements(orig) / cols), cols};
+    mda_reshape(view, orig, 2, shape);
+}
+
+void ifx_mda_as_matrix_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig)
+{
+    mda_as_matrix(view, orig);
+}
+
+void ifx_mda_as_matrix_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig)
+{
+    mda_as_matrix(view, orig);
+}
+
+void ifx_mda_view_h(ifx_Mda_H_t* view, const ifx_Mda_H_t* orig, const size_t num_slices, const ifx_mda_slice_t slices[])
+{
+    mda_view(view, orig, num_slices, slices);
+}
+
+void ifx_mda_view_hc(ifx_Mda_HC_t* view, const ifx_Mda_HC_t* orig, const size_t num_slices, const ifx_mda_slice_t slices[])
+{
+    mda_view(view, orig, num_slices, slices);
+}
+
 template <class MDA_TYPE>
 static inline bool mda_is_contiguous(const MDA_TYPE* mda)
 {
@@ -301,6 +574,12 @@ static inline void mda_setall(MDA_TYPE* mda, const DTYPE value)
 {
     IFX_ERR_BRK_NULL(mda);
 
+    if (mda_is_contiguous(mda))
+    {
+        std::fill_n(IFX_MDA_DATA(mda), mda_elements(mda), value);
+        return;
+    }
+
     const auto f = [mda, value](size_t offset, const uint32_t* /* indices */) {
         IFX_MDA_DATA(mda)
         [offset] = value;
@@ -327,8 +606,16 @@ static inline void mda_copy(const MDA_TYPE* src, MDA_TYPE* dest)
     IFX_ERR_BRK_NULL(dest);
     IFX_ERR_BRK_COND(!IFX_MDA_SAME_SHAPE(src, dest), IFX_ERROR_DIMENSION_MISMATCH);
 
-    const IterFunc f = [src, dest](size_t offset, const uint32_t* /* indices */) {
-        IFX_MDA_DATA(dest)[offset] = IFX_MDA_DATA(src)[offset];
+    if (mda_is_contiguous(src) && mda_is_contiguous(dest))
+    {
+        std::memmove(IFX_MDA_DATA(dest), IFX_MDA_DATA(src), mda_elements(src) * sizeof(IFX_MDA_DATA(src)[0]));
+        return;
+    }
+
+    // src and dest may be views with different strides
+    const IterFunc f = [src, dest](size_t offset, const uint32_t* indices) {
+        const size_t dest_offset = ifx_mda_offset(IFX_MDA_DIMENSIONS(dest), IFX_MDA_STRIDE(dest), indices);
+        IFX_MDA_DATA(dest)[dest_offset] = IFX_MDA_DATA(src)[offset];
         return true;
     };
 
@@ -369,6 +656,46 @@ ifx_Mda_C_t* ifx_mda_clone_c(const ifx_Mda_C_t* mda)
     return mda_clone(mda);
 }
 
+template <class MDA_TYPE>
+static const MDA_TYPE* mda_materialize(const MDA_TYPE* mda, MDA_TYPE** storage)
+{
+    IFX_ERR_BRV_NULL(mda, nullptr);
+    IFX_ERR_BRV_NULL(storage, nullptr);
+
+    if (mda_is_contiguous(mda))
+        return mda;
+
+    // reuse the storage of a previous call if the shape did not change
+    MDA_TYPE* copy = *storage;
+    if (copy && !IFX_MDA_SAME_SHAPE(copy, mda))
+    {
+        ifx_mda_destroy(copy);
+        copy = nullptr;
+    }
+
+    if (!copy)
+    {
+        copy = mda_create<MDA_TYPE>(IFX_MDA_DIMENSIONS(mda), IFX_MDA_SHAPE(mda));
+        *storage = copy;
+        if (!copy)
+            return nullptr;
+    }
+
+    mda_copy(mda, copy);
+
+    return copy;
+}
+
+const ifx_Mda_R_t* ifx_mda_materialize_r(const ifx_Mda_R_t* mda, ifx_Mda_R_t** storage)
+{
+    return mda_materialize(mda, storage);
+}
+
+const ifx_Mda_C_t* ifx_mda_materialize_c(const ifx_Mda_C_t* mda, ifx_Mda_C_t** storage)
+{
+    return mda_materialize(mda, storage);
+}
+
 template <class MDA_TYPE, class DTYPE>
 void mda_rawview(MDA_TYPE* mda, DTYPE* data, uint32_t dimensions, const uint32_t* shape, const size_t* stride, uint32_t flags)
 {
@@ -433,3 +760,60 @@ void ifx_mda_clear_c(ifx_Mda_C_t* mda)
     const ifx_Complex_t zero = IFX_COMPLEX_DEF(0, 0);
     mda_clear(mda, zero);
 }
+
+/* Contiguous arrays are converted in one kernel call, otherwise each element
+ * is converted on its own. Complex numbers are converted as pairs of real
+ * numbers.
+ */
+template <class SRC_TYPE, class DEST_TYPE, class CONVERT>
+static inline void mda_convert(const SRC_TYPE* src, DEST_TYPE* dest, size_t components, CONVERT convert)
+{
+    IFX_ERR_BRK_NULL(src);
+    IFX_ERR_BRK_NULL(dest);
+    IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(src) != IFX_MDA_DIMENSIONS(dest) || !IFX_MDA_SAME_SHAPE(src, dest), IFX_ERROR_DIMENSION_MISMATCH);
+
+    const auto* in = IFX_MDA_DATA(src);
+    auto* out = IFX_MDA_DATA(dest);
+
+    if (mda_is_contiguous(src) && mda_is_contiguous(dest))
+    {
+        convert(in, out, mda_elements(src) * components);
+        return;
+    }
+
+    const IterFunc f = [src, dest, in, out, components, convert](size_t offset, const uint32_t* indices) {
+        const size_t dest_offset = ifx_mda_offset(IFX_MDA_DIMENSIONS(dest), IFX_MDA_STRIDE(dest), indices);
+        convert(&in[offset], &out[dest_offset], components);
+        return true;
+    };
+
+    iterate(src, f);
+}
+
+void ifx_mda_to_half_r(const ifx_Mda_R_t* src, ifx_Mda_H_t* dest)
+{
+    const auto to_f16 = ifx_kernels_get()->to_f16;
+    mda_convert(src, dest, 1, [to_f16](const ifx_Float_t* in, ifx_Float16_t* out, size_t len) { to_f16(in, out, len); });
+}
+
+void ifx_mda_to_half_c(const ifx_Mda_C_t* src, ifx_Mda_HC_t* dest)
+{
+    const auto to_f16 = ifx_kernels_get()->to_f16;
+    mda_convert(src, dest, 2, [to_f16](const ifx_Complex_t* in, ifx_Complex16_t* out, size_t len) {
+        to_f16(reinterpret_cast<const ifx_Float_t*>(in), reinterpret_cast<ifx_Float16_t*>(out), len);
+    });
+}
+
+void ifx_mda_from_half_r(const ifx_Mda_H_t* src, ifx_Mda_R_t* dest)
+{
+    const auto from_f16 = ifx_kernels_get()->from_f16;
+    mda_convert(src, dest, 1, [from_f16](const ifx_Float16_t* in, ifx_Float_t* out, size_t len) { from_f16(in, out, len); });
+}
+
+void ifx_mda_from_half_c(const ifx_Mda_HC_t* src, ifx_Mda_C_t* dest)
+{
+    const auto from_f16 = ifx_kernels_get()->from_f16;
+    mda_convert(src, dest, 2, [from_f16](const ifx_Complex16_t* in, ifx_Complex_t* out, size_t len) {
+        from_f16(reinterpret_cast<const ifx_Float16_t*>(in), reinterpret_cast<ifx_Float_t*>(out), len);
+    });
+}
@@ -142,6 +142,22 @@ extern "C"
  * ifx_mda_destroy_r(arr);
  * @endcode
  *
+ * Further views are created with \ref ifx_mda_permute_r (reorder the axes),
+ * \ref ifx_mda_reshape_r (change the shape, numpy's reshape without copy) and
+ * \ref ifx_mda_squeeze_r (drop axes of length 1). A view with one or two
+ * dimensions can be passed to every function taking a vector or matrix,
+ * \ref ifx_mda_as_vector_r and \ref ifx_mda_as_matrix_r flatten views with
+ * more dimensions:
+ * @code {.C}
+ * // chirps 4 to 11 of antenna 2 of a cube (antennas, chirps, samples) as matrix
+ * ifx_Mda_R_t chirps;
+ * IFX_MDA_VIEW_R(&chirps, cube, IFX_MDA_INDEX(2), IFX_MDA_SLICE(4,12,1), IFX_MDA_SLICE_FULL());
+ *
+ * // all samples of the cube as one vector
+ * ifx_Vector_R_t samples;
+ * ifx_mda_as_vector_r(&samples, cube);
+ * @endcode
+ *
  * As long as a view is still in use the original array must not be destroyed.
  *
  * @section sect_mda_memory_layout Internal memory layout
@@ -176,6 +192,11 @@ extern "C"
  */
 #define IFX_MDA_MAX_DIM 8
 
+/**
+ * @brief Maximum alignment of the data of arrays, see \ref ifx_mda_create_aligned_r.
+ */
+#define IFX_MDA_MAX_ALIGNMENT 64U
+
 /**
  * @brief Internal macro to get the number of elements in a variadic macro
  */
@@ -242,6 +263,54 @@ typedef struct
     uint32_t flags;
 } ifx_Mda_C_t;
 
+/**
+ * @brief Real multi-dimensional array in half precision.
+ *
+ * Same as \ref ifx_Mda_R_t, but the elements are stored as
+ * \ref ifx_Float16_t. This halves the memory of buffers that are only
+ * stored and read, e.g. frame histories. The values are converted with
+ * \ref ifx_mda_to_half_r and \ref ifx_mda_from_half_r, or by functions
+ * that accept half precision input directly.
+ */
+typedef struct
+{
+    /** Number of dimensions */
+    uint32_t dimensions;
+
+    /** Pointer to memory containing data values */
+    ifx_Float16_t* data;
+
+    /** Shape of array */
+    uint32_t shape[IFX_MDA_MAX_DIM];
+
+    /** Strides */
+    size_t stride[IFX_MDA_MAX_DIM];
+
+    /** Flags */
+    uint32_t flags;
+} ifx_Mda_H_t;
+
+/**
+ * @brief Complex multi-dimensional array in half precision, see \ref ifx_Mda_H_t.
+ */
+typedef struct
+{
+    /** Number of dimensions */
+    uint32_t dimensions;
+
+    /** Pointer to memory containing data values */
+    ifx_Complex16_t* data;
+
+    /** Shape of array */
+    uint32_t shape[IFX_MDA_MAX_DIM];
+
+    /** Strides */
+    size_t stride[IFX_MDA_MAX_DIM];
+
+    /** Flags */
+    uint32_t flags;
+} ifx_Mda_HC_t;
+
 /**
  * @brief Define a slice
  *
@@ -430,6 +499,24 @@ static inline size_t ifx_mda_offset(const uint32_t dimensions, const size_t* str
         ifx_mda_view_c((view), (orig), num_slices_, slices_);            \
     } while (0)
 
+/**
+ * @brief Create real view with a different shape.
+ *
+ * The arguments after orig specify the shape, e.g.
+ * IFX_MDA_RESHAPE_R(&view, arr, 4, 6) for a shape of (4,6). See
+ * \ref ifx_mda_reshape_r.
+ */
+#define IFX_MDA_RESHAPE_R(view, orig, ...) \
+    ifx_mda_reshape_r((view), (orig), IFX_MDA_NUMARGS(__VA_ARGS__), IFX_MDA_TO_ARRAY(uint32_t, __VA_ARGS__))
+
+/**
+ * @brief Create complex view with a different shape.
+ *
+ * See \ref IFX_MDA_RESHAPE_R.
+ */
+#define IFX_MDA_RESHAPE_C(view, orig, ...) \
+    ifx_mda_reshape_c((view), (orig), IFX_MDA_NUMARGS(__VA_ARGS__), IFX_MDA_TO_ARRAY(uint32_t, __VA_ARGS__))
+
 /**
  * @brief Create real multi-dimensional array.
  *
@@ -452,6 +539,33 @@ IFX_DLL_PUBLIC ifx_Mda_R_t* ifx_mda_create_r(uint32_t dimensions, const uint32_t
  */
 IFX_DLL_PUBLIC ifx_Mda_C_t* ifx_mda_create_c(uint32_t dimensions, const uint32_t shape[]);
 
+/**
+ * @brief Create real multi-dimensional array with the given data alignment.
+ *
+ * Arrays are allocated as one block holding the array structure followed by
+ * the data, so creating an array is a single allocation and the structure
+ * shares cache lines with the data. \ref ifx_mda_create_r aligns the data to
+ * IFX_MEMORY_ALIGNMENT, this function e.g. to 64 bytes for AVX-512.
+ *
+ * @param dimensions Number of dimensions.
+ * @param shape Array with shape; must have at least dimensions of elements.
+ * @param alignment Alignment of the data; a power of 2 of at most \ref IFX_MDA_MAX_ALIGNMENT.
+ * @return array    Newly created array.
+ */
+IFX_DLL_PUBLIC ifx_Mda_R_t* ifx_mda_create_aligned_r(uint32_t dimensions, const uint32_t shape[], size_t alignment);
+
+/**
+ * @brief Create complex multi-dimensional array with the given data alignment.
+ *
+ * See \ref ifx_mda_create_aligned_r.
+ *
+ * @param dimensions Number of dimensions.
+ * @param shape Array with shape; must have at least dimensions of elements.
+ * @param alignment Alignment of the data; a power of 2 of at most \ref IFX_MDA_MAX_ALIGNMENT.
+ * @return array    Newly created array.
+ */
+IFX_DLL_PUBLIC ifx_Mda_C_t* ifx_mda_create_aligned_c(uint32_t dimensions, const uint32_t shape[], size_t alignment);
+
 /**
  * @brief Destroy real array.
  *
@@ -494,6 +608,133 @@ IFX_DLL_PUBLIC void ifx_mda_view_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig, s
  */
 IFX_DLL_PUBLIC void ifx_mda_view_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, size_t num_slices, const ifx_mda_slice_t slices[]);
 
+/**
+ * @brief Create real view with permuted axes.
+ *
+ * Axis dim of view is axis axes[dim] of orig. No data is copied; only
+ * shape and stride are reordered, so the view can be passed to any function
+ * accepting strided arrays. For a matrix, axes = {1, 0} yields the transpose.
+ *
+ * view and orig may point to the same structure. The view never owns data.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ * @param num_axes Number of elements of axes; must match dimensions of orig.
+ * @param axes Permutation of 0, ..., num_axes-1.
+ */
+IFX_DLL_PUBLIC void ifx_mda_permute_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig, size_t num_axes, const uint32_t axes[]);
+
+/**
+ * @brief Create complex view with permuted axes.
+ *
+ * See \ref ifx_mda_permute_r.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ * @param num_axes Number of elements of axes; must match dimensions of orig.
+ * @param axes Permutation of 0, ..., num_axes-1.
+ */
+IFX_DLL_PUBLIC void ifx_mda_permute_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, size_t num_axes, const uint32_t axes[]);
+
+/**
+ * @brief Create real view with a different shape.
+ *
+ * Corresponds to numpy's reshape, but never copies: the elements of orig in
+ * row-major order are the elements of view in row-major order. This is
+ * possible for contiguous arrays and for every view whose axes merged or
+ * split by the new shape are contiguous among themselves, e.g. a range of
+ * rows of a matrix, but not a range of columns flattened into a vector.
+ * Otherwise IFX_ERROR_ARGUMENT_INVALID is set; \ref ifx_mda_materialize_r
+ * makes a contiguous copy that can be reshaped.
+ *
+ * view and orig may point to the same structure. The view never owns data.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ * @param dimensions Number of dimensions of the view (1 to \ref IFX_MDA_MAX_DIM).
+ * @param shape Shape of the view; the number of elements must be the same as of orig.
+ */
+IFX_DLL_PUBLIC void ifx_mda_reshape_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig, uint32_t dimensions, const uint32_t shape[]);
+
+/**
+ * @brief Create complex view with a different shape.
+ *
+ * See \ref ifx_mda_reshape_r.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ * @param dimensions Number of dimensions of the view (1 to \ref IFX_MDA_MAX_DIM).
+ * @param shape Shape of the view; the number of elements must be the same as of orig.
+ */
+IFX_DLL_PUBLIC void ifx_mda_reshape_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig, uint32_t dimensions, const uint32_t shape[]);
+
+/**
+ * @brief Create real view without the axes of length 1.
+ *
+ * Corresponds to numpy's squeeze, except that an array with only axes of
+ * length 1 keeps one of them. view and orig may point to the same
+ * structure. The view never owns data.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_squeeze_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig);
+
+/**
+ * @brief Create complex view without the axes of length 1.
+ *
+ * See \ref ifx_mda_squeeze_r.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_squeeze_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig);
+
+/**
+ * @brief Create a vector view of all elements of a real array.
+ *
+ * Same as \ref ifx_mda_reshape_r with the number of elements as only axis,
+ * so the elements must be reachable with a single stride. The view can be
+ * used as \ref ifx_Vector_R_t.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_as_vector_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig);
+
+/**
+ * @brief Create a vector view of all elements of a complex array.
+ *
+ * See \ref ifx_mda_as_vector_r, the view can be used as \ref ifx_Vector_C_t.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_as_vector_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig);
+
+/**
+ * @brief Create a matrix view of a real array.
+ *
+ * The last axis of orig becomes the columns, all other axes are merged into
+ * the rows (numpy's reshape(-1, n)); a vector becomes a matrix with one row.
+ * See \ref ifx_mda_reshape_r for the arrays that can be merged without
+ * copy. The view can be used as \ref ifx_Matrix_R_t.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_as_matrix_r(ifx_Mda_R_t* view, const ifx_Mda_R_t* orig);
+
+/**
+ * @brief Create a matrix view of a complex array.
+ *
+ * See \ref ifx_mda_as_matrix_r, the view can be used as \ref ifx_Matrix_C_t.
+ *
+ * @param view Pointer to view.
+ * @param orig Original multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_as_matrix_c(ifx_Mda_C_t* view, const ifx_Mda_C_t* orig);
+
 /**
  * @brief Return true if memory is contiguous.
  *
@@ -547,7 +788,7 @@ IFX_DLL_PUBLIC void ifx_mda_setall_c(ifx_Mda_C_t* mda, ifx_Complex_t value);
 /**
  * @brief Copy array src to dest.
  *
- * src and dest must have the same shapes.
+ * src and dest must have the same shapes, but may have different strides.
  *
  * @param src  source array
  * @param dest destination array
@@ -557,7 +798,7 @@ IFX_DLL_PUBLIC void ifx_mda_copy_r(const ifx_Mda_R_t* src, ifx_Mda_R_t* dest);
 /**
  * @brief Copy array src to dest.
  *
- * src and dest must have the same shapes.
+ * src and dest must have the same shapes, but may have different strides.
  *
  * @param src  source array
  * @param dest destination array
@@ -586,6 +827,40 @@ IFX_DLL_PUBLIC ifx_Mda_R_t* ifx_mda_clone_r(const ifx_Mda_R_t* mda);
  */
 IFX_DLL_PUBLIC ifx_Mda_C_t* ifx_mda_clone_c(const ifx_Mda_C_t* mda);
 
+/**
+ * @brief Return a contiguous version of an array.
+ *
+ * Most operations on vectors, matrices and cubes have fast paths for arrays
+ * without gaps between the elements. Views like the columns of a matrix or
+ * the slices of a cube are strided and take the slow path each time they
+ * are used. If such a view is consumed many times, it is faster to copy it
+ * once into contiguous memory.
+ *
+ * If mda is contiguous, mda itself is returned. Otherwise the elements are
+ * copied into *storage, which is returned. If *storage is NULL or has a
+ * different shape, a new array is allocated and stored in *storage, so the
+ * same storage can be reused across calls. The caller must free *storage
+ * with \ref ifx_mda_destroy_r once it is no longer used; *storage must be
+ * NULL or an array returned in *storage by an earlier call.
+ *
+ * @param [in]     mda      array or view
+ * @param [in,out] storage  storage for the contiguous copy
+ * @return contiguous array with the elements of mda, NULL on error
+ */
+IFX_DLL_PUBLIC const ifx_Mda_R_t* ifx_mda_materialize_r(const ifx_Mda_R_t* mda, ifx_Mda_R_t** storage);
+
+/**
+ * @brief Return a contiguous version of an array.
+ *
+ * See \ref ifx_mda_materialize_r. *storage must be freed with
+ * \ref ifx_mda_destroy_c.
+ *
+ * @param [in]     mda      array or view
+ * @param [in,out] storage  storage for the contiguous copy
+ * @return contiguous array with the elements of mda, NULL on error
+ */
+IFX_DLL_PUBLIC const ifx_Mda_C_t* ifx_mda_materialize_c(const ifx_Mda_C_t* mda, ifx_Mda_C_t** storage);
+
 /**
  * @brief Create a raw view of a real muti-dimensional array.
  *
@@ -632,6 +907,94 @@ IFX_DLL_PUBLIC void ifx_mda_clear_r(ifx_Mda_R_t* mda);
  */
 IFX_DLL_PUBLIC void ifx_mda_clear_c(ifx_Mda_C_t* mda);
 
+/**
+ * @brief Create real multi-dimensional array in half precision.
+ *
+ * See \ref ifx_mda_create_r.
+ *
+ * @param dimensions Number of dimensions.
+ * @param shape Array with shape; must have at least dimensions of elements.
+ * @return array    Newly created array.
+ */
+IFX_DLL_PUBLIC ifx_Mda_H_t* ifx_mda_create_h(uint32_t dimensions, const uint32_t shape[]);
+
+/**
+ * @brief Create complex multi-dimensional array in half precision.
+ *
+ * See \ref ifx_mda_create_c.
+ *
+ * @param dimensions Number of dimensions.
+ * @param shape Array with shape; must have at least dimensions of elements.
+ * @return array    Newly created array.
+ */
+IFX_DLL_PUBLIC ifx_Mda_HC_t* ifx_mda_create_hc(uint32_t dimensions, const uint32_t shape[]);
+
+/**
+ * @brief Destroy real multi-dimensional array in half precision.
+ *
+ * @param mda   Multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_destroy_h(ifx_Mda_H_t* mda);
+
+/**
+ * @brief Destroy complex multi-dimensional array in half precision.
+ *
+ * @param mda   Multi-dimensional array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_destroy_hc(ifx_Mda_HC_t* mda);
+
+/**
+ * @brief Create view of real multi-dimensional array in half precision.
+ *
+ * See \ref ifx_mda_view_r.
+ */
+IFX_DLL_PUBLIC void ifx_mda_view_h(ifx_Mda_H_t* view, const ifx_Mda_H_t* orig, size_t num_slices, const ifx_mda_slice_t slices[]);
+
+/**
+ * @brief Create view of complex multi-dimensional array in half precision.
+ *
+ * See \ref ifx_mda_view_c.
+ */
+IFX_DLL_PUBLIC void ifx_mda_view_hc(ifx_Mda_HC_t* view, const ifx_Mda_HC_t* orig, size_t num_slices, const ifx_mda_slice_t slices[]);
+
+/**
+ * @brief Converts a real array to half precision.
+ *
+ * Values are rounded to the nearest half precision number; values beyond
+ * the half precision range (about 65504) become infinity. Both arrays must
+ * have the same shape.
+ *
+ * @param [in]  src     Real array.
+ * @param [out] dest    Real array in half precision.
+ */
+IFX_DLL_PUBLIC void ifx_mda_to_half_r(const ifx_Mda_R_t* src, ifx_Mda_H_t* dest);
+
+/**
+ * @brief Converts a complex array to half precision, see \ref ifx_mda_to_half_r.
+ *
+ * @param [in]  src     Complex array.
+ * @param [out] dest    Complex array in half precision.
+ */
+IFX_DLL_PUBLIC void ifx_mda_to_half_c(const ifx_Mda_C_t* src, ifx_Mda_HC_t* dest);
+
+/**
+ * @brief Converts a real array from half precision.
+ *
+ * The conversion is exact. Both arrays must have the same shape.
+ *
+ * @param [in]  src     Real array in half precision.
+ * @param [out] dest    Real array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_from_half_r(const ifx_Mda_H_t* src, ifx_Mda_R_t* dest);
+
+/**
+ * @brief Converts a complex array from half precision, see \ref ifx_mda_from_half_r.
+ *
+ * @param [in]  src     Complex array in half precision.
+ * @param [out] dest    Complex array.
+ */
+IFX_DLL_PUBLIC void ifx_mda_from_half_c(const ifx_Mda_HC_t* src, ifx_Mda_C_t* dest);
+
 /**
  * @}
  */
@@ -75,9 +75,712 @@
     } while (0)
 #endif
 
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(IFX_MEM_TRACKING)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
 // include only here to avoid warning about posix_memalign
+#include "Defines.h"
 #include "Mem.h"
 
+// the exported functions are defined here, not the call site recording macros
+#undef ifx_mem_alloc
+#undef ifx_mem_calloc
+#undef ifx_mem_aligned_alloc
+
+// alignment of the memory returned by allocators
+#define BASE_ALIGNMENT 16U
+
+// size of block_header_t rounded up to BASE_ALIGNMENT
+#define HEADER_SIZE IFX_ALIGN(sizeof(block_header_t), BASE_ALIGNMENT)
+
+// TLSF: second level lists per power of two and the resulting size classes
+#define TLSF_SL_BITS    4U
+#define TLSF_SL_COUNT   (1U << TLSF_SL_BITS)
+#define TLSF_FL_SHIFT   (TLSF_SL_BITS + 4U)  // 4 = log2(BASE_ALIGNMENT)
+#define TLSF_SMALL      ((size_t)1 << TLSF_FL_SHIFT)
+#define TLSF_FL_COUNT   (sizeof(size_t) * 8 - TLSF_FL_SHIFT + 1)
+#define TLSF_HEADER     IFX_ALIGN(offsetof(tlsf_block_t, next_free), BASE_ALIGNMENT)
+#define TLSF_MIN_BLOCK  BASE_ALIGNMENT
+#define TLSF_FREE       ((size_t)1)
+#define TLSF_SIZE(b)    ((b)->size & ~(size_t)(BASE_ALIGNMENT - 1))
+
+#if defined(IFX_MEM_TRACKING)
+// call sites are kept in an open addressing hash table, MAX_SITES must be a power of two
+#define MAX_SITES   1024U
+#define MAX_MODULES 32U
+
+// used when the tables are full
+#define OTHER_SITE   MAX_SITES
+#define OTHER_MODULE (MAX_MODULES - 1)
+
+#if defined(_WIN32)
+#define TRACKING_LOCK()   AcquireSRWLockExclusive(&tracking_lock)
+#define TRACKING_UNLOCK() ReleaseSRWLockExclusive(&tracking_lock)
+#else
+#define TRACKING_LOCK()   pthread_mutex_lock(&tracking_lock)
+#define TRACKING_UNLOCK() pthread_mutex_unlock(&tracking_lock)
+#endif
+#endif
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Stored in front of every block returned by ifx_mem_alloc and friends.
+ */
+typedef struct
+{
+    const ifx_Allocator_t* allocator; /**< Allocator the block came from.*/
+    void* base;                       /**< Pointer returned by the allocator.*/
+    size_t size;                      /**< Size requested by the caller.*/
+    size_t total;                     /**< Size passed to the allocator.*/
+#if defined(IFX_MEM_TRACKING)
+    uint32_t site; /**< Index of the call site in sites.*/
+#endif
+} block_header_t;
+
+#if defined(IFX_MEM_TRACKING)
+/**
+ * @brief Statistics of a call site, an unused entry has file NULL.
+ */
+typedef struct
+{
+    ifx_Mem_Site_Stats_t stats; /**< Statistics.*/
+    uint32_t module;            /**< Index of the module in modules.*/
+} site_t;
+#endif
+
+/**
+ * @brief State of a bump arena.
+ */
+typedef struct
+{
+    ifx_Allocator_t allocator; /**< Must be the first member.*/
+    uint8_t* memory;           /**< Memory of the arena.*/
+    size_t capacity;           /**< Size of memory.*/
+    size_t used;               /**< Bytes in use.*/
+} arena_t;
+
+/**
+ * @brief State of a pool of fixed size blocks.
+ */
+typedef struct
+{
+    ifx_Allocator_t allocator; /**< Must be the first member.*/
+    uint8_t* memory;           /**< Memory of all blocks.*/
+    size_t block_size;         /**< Size of a block.*/
+    void* free_list;           /**< First free block, each free block points to the next one.*/
+} pool_t;
+
+/**
+ * @brief Header of a TLSF block.
+ *
+ * The payload of a block follows its header. next_free and prev_free are
+ * only valid for free blocks and overlap the payload.
+ */
+typedef struct tlsf_block_s
+{
+    struct tlsf_block_s* prev_phys; /**< Block in front of this one in memory, NULL for the first.*/
+    size_t size;                    /**< Size of the payload, TLSF_FREE is set for free blocks.*/
+    struct tlsf_block_s* next_free; /**< Next block in the free list.*/
+    struct tlsf_block_s* prev_free; /**< Previous block in the free list.*/
+} tlsf_block_t;
+
+/**
+ * @brief State of a TLSF allocator.
+ *
+ * Free blocks are kept in lists by size class. The first level splits
+ * sizes by powers of two, the second level each power of two in
+ * TLSF_SL_COUNT steps. The bitmaps mark the non-empty lists, so a suitable
+ * list is found with two bit scans.
+ */
+typedef struct
+{
+    ifx_Allocator_t allocator;                          /**< Must be the first member.*/
+    uint8_t* memory;                                    /**< Managed memory.*/
+    uint64_t fl_bitmap;                                 /**< Bit fl is set if any list of fl is not empty.*/
+    uint32_t sl_bitmap[TLSF_FL_COUNT];                  /**< Bit sl is set if list (fl, sl) is not empty.*/
+    tlsf_block_t* heads[TLSF_FL_COUNT][TLSF_SL_COUNT]; /**< Free lists.*/
+} tlsf_t;
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+static void* heap_alloc(void* state, size_t size);
+static void heap_free(void* state, void* mem, size_t size);
+
+static const ifx_Allocator_t heap_allocator = {heap_alloc, heap_free, NULL};
+
+static const ifx_Allocator_t* volatile global_allocator = &heap_allocator;
+static IFX_THREAD_LOCAL const ifx_Allocator_t* thread_allocator = NULL;
+static volatile bool heap_forbidden = false;
+
+static ifx_Mem_Stats_t stats;
+
+#if defined(IFX_MEM_TRACKING)
+#if defined(_WIN32)
+static SRWLOCK tracking_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t tracking_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static site_t sites[MAX_SITES + 1];
+static uint32_t num_sites = 0;
+static ifx_Mem_Module_Stats_t modules[MAX_MODULES];
+static uint32_t num_modules = 0;
+#endif
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void* arena_alloc(void* state, size_t size);
+static void arena_free(void* state, void* mem, size_t size);
+static void* pool_alloc(void* state, size_t size);
+static void pool_free(void* state, void* mem, size_t size);
+static void* tlsf_alloc(void* state, size_t size);
+static void tlsf_free(void* state, void* mem, size_t size);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static uint64_t atomic_add(volatile uint64_t* value, int64_t delta)
+{
+#if defined(_MSC_VER)
+    for (;;)
+    {
+        const uint64_t old = *value;
+        if ((uint64_t)_InterlockedCompareExchange64((volatile __int64*)value, (__int64)(old + delta), (__int64)old) == old)
+            return old + delta;
+    }
+#else
+    return __atomic_add_fetch(value, (uint64_t)delta, __ATOMIC_RELAXED);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static void atomic_max(volatile uint64_t* value, uint64_t candidate)
+{
+    uint64_t old = *value;
+    while (candidate > old)
+    {
+#if defined(_MSC_VER)
+        const uint64_t seen = (uint64_t)_InterlockedCompareExchange64((volatile __int64*)value, (__int64)candidate, (__int64)old);
+        if (seen == old)
+            return;
+        old = seen;
+#else
+        if (__atomic_compare_exchange_n(value, &old, candidate, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return;
+#endif
+    }
+}
+
+//----------------------------------------------------------------------------
+
+#if defined(IFX_MEM_TRACKING)
+/**
+ * @brief Returns the index of the module of a source file.
+ *
+ * The module is the directory containing the file. Must be called with the
+ * tracking lock held.
+ */
+static uint32_t find_module(const char* filename)
+{
+    const char* last = NULL;  // last path separator
+    const char* prev = NULL;  // separator in front of last
+    for (const char* p = filename; *p; p++)
+    {
+        if (*p == '/' || *p == '\\')
+        {
+            prev = last;
+            last = p;
+        }
+    }
+
+    // without directory the file name is used
+    const char* begin = last ? (prev ? prev + 1 : filename) : filename;
+    const char* end = last ? last : filename + strlen(filename);
+
+    char name[sizeof(modules[0].module)];
+    const size_t length = MIN((size_t)(end - begin), sizeof(name) - 1);
+    memcpy(name, begin, length);
+    name[length] = '\0';
+
+    for (uint32_t i = 0; i < num_modules; i++)
+    {
+        if (strcmp(modules[i].module, name) == 0)
+            return i;
+    }
+
+    if (num_modules == OTHER_MODULE)
+    {
+        strcpy(modules[OTHER_MODULE].module, "(other)");
+        return OTHER_MODULE;
+    }
+
+    memcpy(modules[num_modules].module, name, length + 1);
+    return num_modules++;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Returns the index of a call site, adds it if it is new.
+ *
+ * Must be called with the tracking lock held.
+ */
+static uint32_t find_site(const char* filename, const char* fname, int line)
+{
+    if (filename == NULL)
+    {
+        filename = "(unknown)";
+        fname = "";
+        line = 0;
+    }
+
+    uint32_t index = (uint32_t)(((uintptr_t)filename >> 4) * 31U + (uint32_t)line) & (MAX_SITES - 1);
+    for (uint32_t probe = 0; probe < MAX_SITES; probe++)
+    {
+        site_t* site = &sites[index];
+        if (site->stats.file == NULL)
+        {
+            if (num_sites == MAX_SITES / 2)
+                break;  // keep the table sparse
+
+            site->stats.file = filename;
+            site->stats.function = fname;
+            site->stats.line = line;
+            site->module = find_module(filename);
+            num_sites++;
+            return index;
+        }
+        if (site->stats.file == filename && site->stats.line == line)
+            return index;
+
+        index = (index + 1) & (MAX_SITES - 1);
+    }
+
+    site_t* other = &sites[OTHER_SITE];
+    if (other->stats.file == NULL)
+    {
+        other->stats.file = "(other)";
+        other->stats.function = "";
+        other->module = find_module("(other)/");
+    }
+    return OTHER_SITE;
+}
+
+//----------------------------------------------------------------------------
+
+static void track_alloc(block_header_t* header, const char* filename, const char* fname, int line)
+{
+    TRACKING_LOCK();
+
+    header->site = find_site(filename, fname, line);
+
+    ifx_Mem_Site_Stats_t* site = &sites[header->site].stats;
+    site->num_allocs++;
+    site->num_live++;
+    site->bytes += header->size;
+    site->peak_bytes = MAX(site->peak_bytes, site->bytes);
+
+    ifx_Mem_Module_Stats_t* module = &modules[sites[header->site].module];
+    module->num_allocs++;
+    module->num_live++;
+    module->bytes += header->size;
+    module->peak_bytes = MAX(module->peak_bytes, module->bytes);
+
+    TRACKING_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
+static void track_free(const block_header_t* header)
+{
+    TRACKING_LOCK();
+
+    ifx_Mem_Site_Stats_t* site = &sites[header->site].stats;
+    site->num_live--;
+    site->bytes -= header->size;
+
+    ifx_Mem_Module_Stats_t* module = &modules[sites[header->site].module];
+    module->num_live--;
+    module->bytes -= header->size;
+
+    TRACKING_UNLOCK();
+}
+#endif
+
+//----------------------------------------------------------------------------
+
+static const ifx_Allocator_t* current_allocator(void)
+{
+    return thread_allocator ? thread_allocator : global_allocator;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Allocates size bytes aligned to alignment from the current allocator.
+ *
+ * The allocator returns BASE_ALIGNMENT aligned memory. The block header and
+ * the padding for larger alignments are added to the request, the header is
+ * stored right in front of the returned pointer. The call site is only
+ * recorded with IFX_MEM_TRACKING, filename may be NULL.
+ */
+static void* allocate(size_t size, size_t alignment, const char* filename, const char* fname, int line)
+{
+    const ifx_Allocator_t* allocator = current_allocator();
+
+    if (alignment < BASE_ALIGNMENT)
+        alignment = BASE_ALIGNMENT;
+
+    const size_t extra = HEADER_SIZE + alignment - BASE_ALIGNMENT;
+    void* base = NULL;
+    if (size <= SIZE_MAX - extra)
+        base = allocator->alloc(allocator->state, size + extra);
+
+    if (base == NULL)
+    {
+        atomic_add(&stats.num_failed, 1);
+        return NULL;
+    }
+
+    uint8_t* mem = (uint8_t*)IFX_ALIGN((uintptr_t)base + HEADER_SIZE, alignment);
+    block_header_t* header = (block_header_t*)(mem - HEADER_SIZE);
+    header->allocator = allocator;
+    header->base = base;
+    header->size = size;
+    header->total = size + extra;
+
+#if defined(IFX_MEM_TRACKING)
+    track_alloc(header, filename, fname, line);
+#else
+    (void)filename;
+    (void)fname;
+    (void)line;
+#endif
+
+    atomic_add(&stats.num_allocs, 1);
+    atomic_max(&stats.peak_bytes, atomic_add(&stats.bytes, (int64_t)size));
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+static void deallocate(void* mem)
+{
+    if (mem == NULL)
+        return;
+
+    const block_header_t* header = (const block_header_t*)((uint8_t*)mem - HEADER_SIZE);
+
+    atomic_add(&stats.num_frees, 1);
+    atomic_add(&stats.bytes, -(int64_t)header->size);
+
+#if defined(IFX_MEM_TRACKING)
+    track_free(header);
+#endif
+
+    header->allocator->free(header->allocator->state, header->base, header->total);
+}
+
+//----------------------------------------------------------------------------
+
+static void* heap_alloc(void* state, size_t size)
+{
+    (void)state;
+
+    if (heap_forbidden)
+        return NULL;
+
+    const size_t alignment = BASE_ALIGNMENT;
+    void* mem = NULL;
+    ALIGNED_MALLOC(size, alignment, mem);
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+static void heap_free(void* state, void* mem, size_t size)
+{
+    (void)state;
+    (void)size;
+
+    ALIGNED_FREE(mem);
+}
+
+//----------------------------------------------------------------------------
+
+static void* arena_alloc(void* state, size_t size)
+{
+    arena_t* arena = state;
+
+    size = IFX_ALIGN(size, BASE_ALIGNMENT);
+    if (size > arena->capacity - arena->used)
+        return NULL;
+
+    void* mem = arena->memory + arena->used;
+    arena->used += size;
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+static void arena_free(void* state, void* mem, size_t size)
+{
+    (void)state;
+    (void)mem;
+    (void)size;
+}
+
+//----------------------------------------------------------------------------
+
+static void* pool_alloc(void* state, size_t size)
+{
+    pool_t* pool = state;
+
+    if (size > pool->block_size || pool->free_list == NULL)
+        return NULL;
+
+    void* mem = pool->free_list;
+    pool->free_list = *(void**)mem;
+    return mem;
+}
+
+//----------------------------------------------------------------------------
+
+static void pool_free(void* state, void* mem, size_t size)
+{
+    pool_t* pool = state;
+    (void)size;
+
+    *(void**)mem = pool->free_list;
+    pool->free_list = mem;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t highest_bit(size_t x)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, (unsigned long)x);
+    return index;
+#else
+    return (uint32_t)(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(x));
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t lowest_bit(uint64_t x)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)x))
+        return index;
+    _BitScanForward(&index, (unsigned long)(x >> 32));
+    return index + 32;
+#else
+    return (uint32_t)__builtin_ctzll(x);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Size class (fl, sl) of a block of size bytes */
+static void tlsf_mapping(size_t size, uint32_t* fl, uint32_t* sl)
+{
+    if (size < TLSF_SMALL)
+    {
+        *fl = 0;
+        *sl = (uint32_t)(size / (TLSF_SMALL / TLSF_SL_COUNT));
+    }
+    else
+    {
+        const uint32_t bit = highest_bit(size);
+        *sl = (uint32_t)(size >> (bit - TLSF_SL_BITS)) ^ TLSF_SL_COUNT;
+        *fl = bit - (TLSF_FL_SHIFT - 1);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static tlsf_block_t* tlsf_next_phys(const tlsf_block_t* block)
+{
+    return (tlsf_block_t*)((uint8_t*)block + TLSF_HEADER + TLSF_SIZE(block));
+}
+
+//----------------------------------------------------------------------------
+
+static void tlsf_insert(tlsf_t* tlsf, tlsf_block_t* block)
+{
+    uint32_t fl, sl;
+    tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+
+    tlsf_block_t* head = tlsf->heads[fl][sl];
+    block->next_free = head;
+    block->prev_free = NULL;
+    if (head)
+        head->prev_free = block;
+
+    tlsf->heads[fl][sl] = block;
+    tlsf->fl_bitmap |= (uint64_t)1 << fl;
+    tlsf->sl_bitmap[fl] |= 1U << sl;
+}
+
+//----------------------------------------------------------------------------
+
+static void tlsf_remove(tlsf_t* tlsf, tlsf_block_t* block)
+{
+    uint32_t fl, sl;
+    tlsf_mapping(TLSF_SIZE(block), &fl, &sl);
+
+    if (block->prev_free)
+        block->prev_free->next_free = block->next_free;
+    if (block->next_free)
+        block->next_free->prev_free = block->prev_free;
+
+    if (tlsf->heads[fl][sl] == block)
+    {
+        tlsf->heads[fl][sl] = block->next_free;
+        if (block->next_free == NULL)
+        {
+            tlsf->sl_bitmap[fl] &= ~(1U << sl);
+            if (tlsf->sl_bitmap[fl] == 0)
+                tlsf->fl_bitmap &= ~((uint64_t)1 << fl);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Allocates from the first non-empty list of a size class that fits
+ *        any block of size bytes, and returns the rest of the block.
+ */
+static void* tlsf_alloc(void* state, size_t size)
+{
+    tlsf_t* tlsf = state;
+
+    size = IFX_ALIGN(size, BASE_ALIGNMENT);
+    if (size < TLSF_MIN_BLOCK)
+        size = TLSF_MIN_BLOCK;
+
+    // round up to the next size class, so every block of the class fits
+    size_t search = size;
+    if (search >= TLSF_SMALL)
+    {
+        const size_t round = ((size_t)1 << (highest_bit(search) - TLSF_SL_BITS)) - 1;
+        if (search > SIZE_MAX - round)
+            return NULL;
+        search += round;
+    }
+
+    uint32_t fl, sl;
+    tlsf_mapping(search, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT)
+        return NULL;
+
+    uint32_t sl_map = tlsf->sl_bitmap[fl] & (~0U << sl);
+    if (sl_map == 0)
+    {
+        const uint64_t fl_map = (fl + 1 < 64) ? tlsf->fl_bitmap & (~(uint64_t)0 << (fl + 1)) : 0;
+        if (fl_map == 0)
+            return NULL;
+
+        fl = lowest_bit(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    sl = lowest_bit(sl_map);
+
+    tlsf_block_t* block = tlsf->heads[fl][sl];
+    tlsf_remove(tlsf, block);
+
+    const size_t block_size = TLSF_SIZE(block);
+    if (block_size - size >= TLSF_HEADER + TLSF_MIN_BLOCK)
+    {
+        tlsf_block_t* rest = (tlsf_block_t*)((uint8_t*)block + TLSF_HEADER + size);
+        rest->prev_phys = block;
+        rest->size = (block_size - size - TLSF_HEADER) | TLSF_FREE;
+        tlsf_next_phys(rest)->prev_phys = rest;
+        tlsf_insert(tlsf, rest);
+
+        block->size = size;
+    }
+    else
+    {
+        block->size = block_size;
+    }
+
+    return (uint8_t*)block + TLSF_HEADER;
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Releases a block and merges it with free neighbors */
+static void tlsf_free(void* state, void* mem, size_t size)
+{
+    tlsf_t* tlsf = state;
+    (void)size;
+
+    tlsf_block_t* block = (tlsf_block_t*)((uint8_t*)mem - TLSF_HEADER);
+
+    tlsf_block_t* next = tlsf_next_phys(block);
+    if (next->size & TLSF_FREE)
+    {
+        tlsf_remove(tlsf, next);
+        block->size = TLSF_SIZE(block) + TLSF_HEADER + TLSF_SIZE(next);
+        tlsf_next_phys(block)->prev_phys = block;
+    }
+
+    tlsf_block_t* prev = block->prev_phys;
+    if (prev && (prev->size & TLSF_FREE))
+    {
+        tlsf_remove(tlsf, prev);
+        prev->size = TLSF_SIZE(prev) + TLSF_HEADER + TLSF_SIZE(block);
+        tlsf_next_phys(prev)->prev_phys = prev;
+        block = prev;
+    }
+
+    block->size |= TLSF_FREE;
+    tlsf_insert(tlsf, block);
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -86,8 +789,7 @@
 
 void* ifx_mem_alloc(size_t size)
 {
-    void* mem = malloc(size);
-    return mem;
+    return allocate(size, BASE_ALIGNMENT, NULL, NULL, 0);
 }
 
 //----------------------------------------------------------------------------
@@ -95,8 +797,7 @@ void* ifx_mem_alloc(size_t size)
 void* ifx_mem_calloc(size_t count,
                      size_t element_size)
 {
-    void* mem = calloc(count, element_size);
-    return mem;
+    return ifx_mem_calloc_internal(NULL, NULL, 0, count, element_size);
 }
 
 //----------------------------------------------------------------------------
@@ -104,22 +805,341 @@ void* ifx_mem_calloc(size_t count,
 void* ifx_mem_aligned_alloc(size_t size,
                             size_t alignment)
 {
+    return allocate(size, alignment, NULL, NULL, 0);
+}
 
-    void* mem = 0;
-    ALIGNED_MALLOC(size, alignment, mem);
+//----------------------------------------------------------------------------
+
+void* ifx_mem_alloc_internal(const char* filename, const char* fname, int line,
+                             size_t size)
+{
+    return allocate(size, BASE_ALIGNMENT, filename, fname, line);
+}
+
+//----------------------------------------------------------------------------
+
+void* ifx_mem_calloc_internal(const char* filename, const char* fname, int line,
+                              size_t count, size_t element_size)
+{
+    if (element_size != 0 && count > SIZE_MAX / element_size)
+    {
+        atomic_add(&stats.num_failed, 1);
+        return NULL;
+    }
+
+    void* mem = allocate(count * element_size, BASE_ALIGNMENT, filename, fname, line);
+    if (mem)
+        memset(mem, 0, count * element_size);
     return mem;
 }
 
 //----------------------------------------------------------------------------
 
+void* ifx_mem_aligned_alloc_internal(const char* filename, const char* fname, int line,
+                                     size_t size, size_t alignment)
+{
+    return allocate(size, alignment, filename, fname, line);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_mem_free(void* mem)
 {
-    free(mem);
+    deallocate(mem);
 }
 
 //----------------------------------------------------------------------------
 
 void ifx_mem_aligned_free(void* mem)
 {
-    ALIGNED_FREE(mem);
+    deallocate(mem);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_set_allocator(const ifx_Allocator_t* allocator)
+{
+    global_allocator = allocator ? allocator : &heap_allocator;
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Allocator_t* ifx_mem_set_thread_allocator(const ifx_Allocator_t* allocator)
+{
+    const ifx_Allocator_t* previous = thread_allocator;
+    thread_allocator = allocator;
+    return previous;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_forbid_heap(bool forbid)
+{
+    heap_forbidden = forbid;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_get_stats(ifx_Mem_Stats_t* s)
+{
+    if (s == NULL)
+        return;
+
+    s->num_allocs = atomic_add(&stats.num_allocs, 0);
+    s->num_frees = atomic_add(&stats.num_frees, 0);
+    s->num_failed = atomic_add(&stats.num_failed, 0);
+    s->bytes = atomic_add(&stats.bytes, 0);
+    s->peak_bytes = atomic_add(&stats.peak_bytes, 0);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_reset_stats(void)
+{
+    const uint64_t bytes = atomic_add(&stats.bytes, 0);
+
+    atomic_add(&stats.num_allocs, -(int64_t)atomic_add(&stats.num_allocs, 0));
+    atomic_add(&stats.num_frees, -(int64_t)atomic_add(&stats.num_frees, 0));
+    atomic_add(&stats.num_failed, -(int64_t)atomic_add(&stats.num_failed, 0));
+    atomic_add(&stats.peak_bytes, (int64_t)bytes - (int64_t)atomic_add(&stats.peak_bytes, 0));
+
+#if defined(IFX_MEM_TRACKING)
+    TRACKING_LOCK();
+    for (uint32_t i = 0; i <= MAX_SITES; i++)
+    {
+        sites[i].stats.num_allocs = 0;
+        sites[i].stats.peak_bytes = sites[i].stats.bytes;
+    }
+    for (uint32_t i = 0; i < MAX_MODULES; i++)
+    {
+        modules[i].num_allocs = 0;
+        modules[i].peak_bytes = modules[i].bytes;
+    }
+    TRACKING_UNLOCK();
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_mem_get_module_stats(ifx_Mem_Module_Stats_t* s,
+                                  uint32_t count)
+{
+#if defined(IFX_MEM_TRACKING)
+    TRACKING_LOCK();
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < MAX_MODULES; i++)
+    {
+        if (modules[i].module[0] == '\0')
+            continue;
+        if (s && n < count)
+            s[n] = modules[i];
+        n++;
+    }
+    TRACKING_UNLOCK();
+    return n;
+#else
+    (void)s;
+    (void)count;
+    return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_mem_get_site_stats(ifx_Mem_Site_Stats_t* s,
+                                uint32_t count)
+{
+#if defined(IFX_MEM_TRACKING)
+    TRACKING_LOCK();
+    uint32_t n = 0;
+    for (uint32_t i = 0; i <= MAX_SITES; i++)
+    {
+        if (sites[i].stats.file == NULL)
+            continue;
+        if (s && n < count)
+            s[n] = sites[i].stats;
+        n++;
+    }
+    TRACKING_UNLOCK();
+    return n;
+#else
+    (void)s;
+    (void)count;
+    return 0;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_dump(FILE* f)
+{
+    if (f == NULL)
+        f = stderr;
+
+    ifx_Mem_Stats_t total;
+    ifx_mem_get_stats(&total);
+    fprintf(f, "memory: %llu bytes in use, peak %llu bytes, %llu allocations, %llu frees, %llu failed\n",
+            (unsigned long long)total.bytes, (unsigned long long)total.peak_bytes,
+            (unsigned long long)total.num_allocs, (unsigned long long)total.num_frees,
+            (unsigned long long)total.num_failed);
+
+#if defined(IFX_MEM_TRACKING)
+    TRACKING_LOCK();
+    for (uint32_t i = 0; i < MAX_MODULES; i++)
+    {
+        const ifx_Mem_Module_Stats_t* m = &modules[i];
+        if (m->module[0] == '\0')
+            continue;
+        fprintf(f, "  %-20s %12llu bytes in %llu blocks, peak %llu bytes\n", m->module,
+                (unsigned long long)m->bytes, (unsigned long long)m->num_live,
+                (unsigned long long)m->peak_bytes);
+    }
+
+    for (uint32_t i = 0; i <= MAX_SITES; i++)
+    {
+        const ifx_Mem_Site_Stats_t* site = &sites[i].stats;
+        if (site->file == NULL || site->num_live == 0)
+            continue;
+        fprintf(f, "  live: %s:%d (%s): %llu bytes in %llu blocks, peak %llu bytes\n",
+                site->file, site->line, site->function,
+                (unsigned long long)site->bytes, (unsigned long long)site->num_live,
+                (unsigned long long)site->peak_bytes);
+    }
+    TRACKING_UNLOCK();
+#else
+    fprintf(f, "  call sites are only recorded if built with SDK_MEMORY_TRACKING\n");
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Allocator_t* ifx_mem_arena_create(size_t capacity)
+{
+    capacity = IFX_ALIGN(capacity, BASE_ALIGNMENT);
+
+    arena_t* arena = heap_alloc(NULL, sizeof(arena_t));
+    if (arena == NULL)
+        return NULL;
+
+    arena->memory = heap_alloc(NULL, capacity);
+    if (arena->memory == NULL)
+    {
+        heap_free(NULL, arena, sizeof(arena_t));
+        return NULL;
+    }
+
+    arena->allocator.alloc = arena_alloc;
+    arena->allocator.free = arena_free;
+    arena->allocator.state = arena;
+    arena->capacity = capacity;
+    arena->used = 0;
+    return &arena->allocator;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_arena_reset(ifx_Allocator_t* arena)
+{
+    if (arena == NULL || arena->alloc != arena_alloc)
+        return;
+
+    ((arena_t*)arena->state)->used = 0;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Allocator_t* ifx_mem_pool_create(size_t block_size,
+                                     uint32_t num_blocks)
+{
+    // the block header and padding of an IFX_MEMORY_ALIGNMENT aligned request
+    const size_t extra = HEADER_SIZE + IFX_MEMORY_ALIGNMENT - BASE_ALIGNMENT;
+    if (num_blocks == 0 || block_size > SIZE_MAX / 2 - extra)
+        return NULL;
+
+    block_size = IFX_ALIGN(MAX(block_size + extra, sizeof(void*)), BASE_ALIGNMENT);
+    if (block_size > SIZE_MAX / num_blocks)
+        return NULL;
+
+    pool_t* pool = heap_alloc(NULL, sizeof(pool_t));
+    if (pool == NULL)
+        return NULL;
+
+    pool->memory = heap_alloc(NULL, block_size * num_blocks);
+    if (pool->memory == NULL)
+    {
+        heap_free(NULL, pool, sizeof(pool_t));
+        return NULL;
+    }
+
+    pool->allocator.alloc = pool_alloc;
+    pool->allocator.free = pool_free;
+    pool->allocator.state = pool;
+    pool->block_size = block_size;
+    pool->free_list = NULL;
+
+    for (uint32_t i = num_blocks; i > 0; i--)
+        pool_free(pool, pool->memory + (size_t)(i - 1) * block_size, block_size);
+
+    return &pool->allocator;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Allocator_t* ifx_mem_tlsf_create(size_t capacity)
+{
+    capacity &= ~(size_t)(BASE_ALIGNMENT - 1);
+    if (capacity < 2 * TLSF_HEADER + TLSF_MIN_BLOCK)
+        return NULL;
+
+    tlsf_t* tlsf = heap_alloc(NULL, sizeof(tlsf_t));
+    if (tlsf == NULL)
+        return NULL;
+
+    tlsf->memory = heap_alloc(NULL, capacity);
+    if (tlsf->memory == NULL)
+    {
+        heap_free(NULL, tlsf, sizeof(tlsf_t));
+        return NULL;
+    }
+
+    tlsf->allocator.alloc = tlsf_alloc;
+    tlsf->allocator.free = tlsf_free;
+    tlsf->allocator.state = tlsf;
+    tlsf->fl_bitmap = 0;
+    memset(tlsf->sl_bitmap, 0, sizeof(tlsf->sl_bitmap));
+    memset(tlsf->heads, 0, sizeof(tlsf->heads));
+
+    // one free block followed by a used block of size 0, which stops merging
+    tlsf_block_t* block = (tlsf_block_t*)tlsf->memory;
+    block->prev_phys = NULL;
+    block->size = capacity - 2 * TLSF_HEADER;
+
+    tlsf_block_t* sentinel = tlsf_next_phys(block);
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+
+    block->size |= TLSF_FREE;
+    tlsf_insert(tlsf, block);
+
+    return &tlsf->allocator;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_mem_allocator_destroy(ifx_Allocator_t* allocator)
+{
+    if (allocator == NULL)
+        return;
+
+    // all built-in allocators start with the allocator, followed by the memory
+    if (allocator->alloc == arena_alloc)
+        heap_free(NULL, ((arena_t*)allocator->state)->memory, 0);
+    else if (allocator->alloc == pool_alloc)
+        heap_free(NULL, ((pool_t*)allocator->state)->memory, 0);
+    else if (allocator->alloc == tlsf_alloc)
+        heap_free(NULL, ((tlsf_t*)allocator->state)->memory, 0);
+    else
+        return;
+
+    heap_free(NULL, allocator->state, 0);
 }
@@ -46,6 +46,8 @@
 
 #include "Types.h"
 
+#include <stdio.h>
+
 
 #ifdef __cplusplus
 extern "C"
@@ -59,8 +61,11 @@ extern "C"
 ==============================================================================
 */
 
-/// By default the data of vectors, matrices, and cubes is aligned to this boundary
+/// By default the data of vectors, matrices, and cubes is aligned to this boundary,
+/// set with the CMake option SDK_MEMORY_ALIGNMENT (at most 64)
+#ifndef IFX_MEMORY_ALIGNMENT
 #define IFX_MEMORY_ALIGNMENT 32U
+#endif
 
 #define IFX_ALIGN(x, SIZE_ALIGNMENT) (((x) + ((SIZE_ALIGNMENT)-1)) & ~((SIZE_ALIGNMENT)-1))
 
@@ -74,6 +79,61 @@ extern "C"
 ==============================================================================
 */
 
+/**
+ * @brief Defines an allocator, see \ref ifx_mem_set_allocator.
+ *
+ * alloc must return memory aligned to at least 16 bytes or NULL. Larger
+ * alignments requested by \ref ifx_mem_aligned_alloc are handled by the
+ * caller. free gets the pointer returned by alloc and the size passed to it.
+ */
+typedef struct ifx_Allocator_s
+{
+    void* (*alloc)(void* state, size_t size);           /**< Allocates size bytes.*/
+    void (*free)(void* state, void* mem, size_t size);  /**< Releases memory returned by alloc, may be a no-op.*/
+    void* state;                                        /**< Passed to alloc and free.*/
+} ifx_Allocator_t;
+
+/**
+ * @brief Allocation statistics, see \ref ifx_mem_get_stats.
+ */
+typedef struct
+{
+    uint64_t num_allocs;  /**< Number of successful allocations.*/
+    uint64_t num_frees;   /**< Number of deallocations.*/
+    uint64_t num_failed;  /**< Number of failed allocations.*/
+    uint64_t bytes;       /**< Bytes currently allocated, as requested by the callers.*/
+    uint64_t peak_bytes;  /**< Maximum of bytes since start or \ref ifx_mem_reset_stats.*/
+} ifx_Mem_Stats_t;
+
+/**
+ * @brief Allocation statistics of a module, see \ref ifx_mem_get_module_stats.
+ *
+ * The module is the directory of the source file that allocated the memory,
+ * e.g. ifxAlgo.
+ */
+typedef struct
+{
+    char module[32];      /**< Name of the module.*/
+    uint64_t num_allocs;  /**< Number of allocations.*/
+    uint64_t num_live;    /**< Number of allocations not yet freed.*/
+    uint64_t bytes;       /**< Bytes currently allocated.*/
+    uint64_t peak_bytes;  /**< Maximum of bytes since start or \ref ifx_mem_reset_stats.*/
+} ifx_Mem_Module_Stats_t;
+
+/**
+ * @brief Allocation statistics of a call site, see \ref ifx_mem_get_site_stats.
+ */
+typedef struct
+{
+    const char* file;     /**< Source file of the call.*/
+    const char* function; /**< Function of the call.*/
+    int line;             /**< Line of the call.*/
+    uint64_t num_allocs;  /**< Number of allocations.*/
+    uint64_t num_live;    /**< Number of allocations not yet freed.*/
+    uint64_t bytes;       /**< Bytes currently allocated.*/
+    uint64_t peak_bytes;  /**< Maximum of bytes since start or \ref ifx_mem_reset_stats.*/
+} ifx_Mem_Site_Stats_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -90,6 +150,32 @@ extern "C"
  * Supports memory allocation and deallocation
  * as well as aligned allocation and aligned deallocation.
  *
+ * All memory of the SDK (vectors, matrices, cubes and handles) is allocated
+ * through these functions. By default they use the heap. With
+ * \ref ifx_mem_set_allocator (process wide) or
+ * \ref ifx_mem_set_thread_allocator (calling thread only) the memory comes
+ * from another allocator, e.g. one of the built-in allocators:
+ * - a bump arena (\ref ifx_mem_arena_create) for per frame temporaries,
+ *   which is released at once with \ref ifx_mem_arena_reset,
+ * - a pool of fixed size blocks (\ref ifx_mem_pool_create),
+ * - a two-level segregated fit allocator (\ref ifx_mem_tlsf_create) with
+ *   bounded time for allocation and deallocation of any size.
+ *
+ * Every block remembers its allocator, so memory can be released after the
+ * allocator was switched. Real-time applications can forbid the heap after
+ * initialization with \ref ifx_mem_forbid_heap.
+ *
+ * The built-in allocators are not thread-safe; use one per thread or
+ * synchronize the threads.
+ *
+ * If the SDK is built with the CMake option SDK_MEMORY_TRACKING,
+ * IFX_MEM_TRACKING is defined and every allocation records its call site
+ * (file, function and line). Bytes in use and their peak are then available
+ * per module (\ref ifx_mem_get_module_stats) and per call site
+ * (\ref ifx_mem_get_site_stats). \ref ifx_mem_dump prints the call sites
+ * that still hold memory, which shows leaks and helps sizing arenas and
+ * pools. Without the option these functions report nothing.
+ *
  * @{
  */
 
@@ -152,6 +238,180 @@ void ifx_mem_free(void* mem);
 IFX_DLL_PUBLIC
 void ifx_mem_aligned_free(void* mem);
 
+/**
+ * @brief Sets the process wide allocator.
+ *
+ * Set it during initialization, before other threads allocate memory. The
+ * allocator must stay valid as long as memory allocated from it is in use.
+ *
+ * @param [in]     allocator Allocator to use, NULL for the heap.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_set_allocator(const ifx_Allocator_t* allocator);
+
+/**
+ * @brief Sets the allocator of the calling thread.
+ *
+ * It overrides the process wide allocator for this thread.
+ *
+ * @param [in]     allocator Allocator to use, NULL for the process wide allocator.
+ *
+ * @return Previous allocator of the thread, to restore it afterwards.
+ */
+IFX_DLL_PUBLIC
+const ifx_Allocator_t* ifx_mem_set_thread_allocator(const ifx_Allocator_t* allocator);
+
+/**
+ * @brief Forbids or allows heap allocations.
+ *
+ * While forbidden, every allocation that would use the heap fails (and is
+ * counted in ifx_Mem_Stats_t.num_failed). This includes creating the
+ * built-in allocators.
+ *
+ * @param [in]     forbid    true to forbid the heap.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_forbid_heap(bool forbid);
+
+/**
+ * @brief Returns the allocation statistics of all allocators.
+ *
+ * @param [out]    stats     Statistics.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_get_stats(ifx_Mem_Stats_t* stats);
+
+/**
+ * @brief Resets the counters of the allocation statistics.
+ *
+ * The peak is set to the bytes currently allocated.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_reset_stats(void);
+
+/**
+ * @brief Returns the allocation statistics per module.
+ *
+ * Only available if built with IFX_MEM_TRACKING.
+ *
+ * @param [out]    stats     Array receiving the statistics, may be NULL if count is 0.
+ * @param [in]     count     Number of elements of stats.
+ *
+ * @return Number of modules, which may be larger than count.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_mem_get_module_stats(ifx_Mem_Module_Stats_t* stats,
+                                  uint32_t count);
+
+/**
+ * @brief Returns the allocation statistics per call site.
+ *
+ * Only available if built with IFX_MEM_TRACKING.
+ *
+ * @param [out]    stats     Array receiving the statistics, may be NULL if count is 0.
+ * @param [in]     count     Number of elements of stats.
+ *
+ * @return Number of call sites, which may be larger than count.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_mem_get_site_stats(ifx_Mem_Site_Stats_t* stats,
+                                uint32_t count);
+
+/**
+ * @brief Prints the statistics of all modules and the call sites holding memory.
+ *
+ * @param [in]     f         Stream to print to, stderr if NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_dump(FILE* f);
+
+/**
+ * @brief Same as \ref ifx_mem_alloc, records the call site.
+ *
+ * Used by the ifx_mem_alloc macro if IFX_MEM_TRACKING is defined.
+ */
+IFX_DLL_PUBLIC
+void* ifx_mem_alloc_internal(const char* filename, const char* fname, int line,
+                             size_t size);
+
+/**
+ * @brief Same as \ref ifx_mem_calloc, records the call site.
+ *
+ * Used by the ifx_mem_calloc macro if IFX_MEM_TRACKING is defined.
+ */
+IFX_DLL_PUBLIC
+void* ifx_mem_calloc_internal(const char* filename, const char* fname, int line,
+                              size_t count, size_t element_size);
+
+/**
+ * @brief Same as \ref ifx_mem_aligned_alloc, records the call site.
+ *
+ * Used by the ifx_mem_aligned_alloc macro if IFX_MEM_TRACKING is defined.
+ */
+IFX_DLL_PUBLIC
+void* ifx_mem_aligned_alloc_internal(const char* filename, const char* fname, int line,
+                                     size_t size, size_t alignment);
+
+/**
+ * @brief Creates a bump arena allocator.
+ *
+ * Allocation advances a pointer; free is a no-op. All memory is released
+ * with \ref ifx_mem_arena_reset.
+ *
+ * @param [in]     capacity  Size of the arena in bytes.
+ *
+ * @return Allocator or NULL on failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Allocator_t* ifx_mem_arena_create(size_t capacity);
+
+/**
+ * @brief Releases all memory of an arena.
+ *
+ * Memory allocated from the arena must not be used afterwards.
+ *
+ * @param [in]     arena     Allocator created by \ref ifx_mem_arena_create.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_arena_reset(ifx_Allocator_t* arena);
+
+/**
+ * @brief Creates a pool allocator of fixed size blocks.
+ *
+ * Allocations larger than block_size fail.
+ *
+ * @param [in]     block_size  Largest size passed to \ref ifx_mem_alloc or \ref ifx_mem_aligned_alloc
+ *                             with IFX_MEMORY_ALIGNMENT.
+ * @param [in]     num_blocks  Number of blocks.
+ *
+ * @return Allocator or NULL on failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Allocator_t* ifx_mem_pool_create(size_t block_size,
+                                     uint32_t num_blocks);
+
+/**
+ * @brief Creates a two-level segregated fit (TLSF) allocator.
+ *
+ * Allocation and deallocation take constant time, adjacent free blocks are
+ * merged.
+ *
+ * @param [in]     capacity  Size of the memory managed by the allocator in bytes.
+ *
+ * @return Allocator or NULL on failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Allocator_t* ifx_mem_tlsf_create(size_t capacity);
+
+/**
+ * @brief Destroys an allocator created by \ref ifx_mem_arena_create,
+ *        \ref ifx_mem_pool_create or \ref ifx_mem_tlsf_create.
+ *
+ * @param [in]     allocator Allocator to destroy.
+ */
+IFX_DLL_PUBLIC
+void ifx_mem_allocator_destroy(ifx_Allocator_t* allocator);
+
 /**
  * @}
  */
@@ -160,6 +420,12 @@ void ifx_mem_aligned_free(void* mem);
  * @}
  */
 
+#ifdef IFX_MEM_TRACKING
+#define ifx_mem_alloc(size)                    ifx_mem_alloc_internal(__FILE__, __func__, __LINE__, (size))
+#define ifx_mem_calloc(count, element_size)    ifx_mem_calloc_internal(__FILE__, __func__, __LINE__, (count), (element_size))
+#define ifx_mem_aligned_alloc(size, alignment) ifx_mem_aligned_alloc_internal(__FILE__, __func__, __LINE__, (size), (alignment))
+#endif
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -0,0 +1,306 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Owned.hpp
+ *
+ * @brief Move-only owners and views of the C containers for C++ users.
+ *
+ * The owners are std::unique_ptr with a deleter calling the matching destroy
+ * function, so they cannot be copied and free the container exactly once.
+ * Passing an owner to the next stage of a pipeline with @ref rdk::transfer
+ * moves the container without copying its data. The stage giving it away is
+ * left with an empty owner.
+ *
+ * @code
+ *   rdk::CubeR cube(ifx_cube_create_r(rows, cols, slices));
+ *   queue.push(rdk::transfer(cube));  // cube is empty now
+ *
+ *   for(ifx_Float_t& value : rdk::fiber_view(cube.get(), 0, 0))
+ *       value = 0;
+ * @endcode
+ */
+
+#ifndef IFX_BASE_OWNED_HPP
+#define IFX_BASE_OWNED_HPP
+
+#include "Cube.h"
+#include "Matrix.h"
+#include "Vector.h"
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace rdk {
+
+/* Deleter calling the destroy function of a C handle. */
+template <typename T, void (*destroy)(T*)>
+struct HandleDeleter
+{
+    void operator()(T* handle) const noexcept
+    {
+        destroy(handle);
+    }
+};
+
+/* Owner of a handle created by the C API, destroyed with destroy. */
+template <typename T, void (*destroy)(T*)>
+using Owned = std::unique_ptr<T, HandleDeleter<T, destroy>>;
+
+using VectorR = Owned<ifx_Vector_R_t, ifx_vec_destroy_r>;
+using VectorC = Owned<ifx_Vector_C_t, ifx_vec_destroy_c>;
+using MatrixR = Owned<ifx_Matrix_R_t, ifx_mat_destroy_r>;
+using MatrixC = Owned<ifx_Matrix_C_t, ifx_mat_destroy_c>;
+using CubeR = Owned<ifx_Cube_R_t, ifx_cube_destroy_r>;
+using CubeC = Owned<ifx_Cube_C_t, ifx_cube_destroy_c>;
+
+/**
+ * @brief Hands the content of owner to the caller.
+ *
+ * Same as std::move, but owner is guaranteed to be empty afterwards and the
+ * hand over is visible at the call site.
+ */
+template <typename T, typename Deleter>
+std::unique_ptr<T, Deleter> transfer(std::unique_ptr<T, Deleter>& owner) noexcept
+{
+    return std::unique_ptr<T, Deleter>(std::move(owner));
+}
+
+/**
+ * @brief View of evenly spaced elements, e.g. a row or column of a matrix.
+ *
+ * Does not own the data. The stride is given in elements.
+ */
+template <typename T>
+class Span
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(T* element, std::ptrdiff_t stride) noexcept :
+            m_element(element),
+            m_stride(stride)
+        {}
+
+        reference operator*() const noexcept
+        {
+            return *m_element;
+        }
+        pointer operator->() const noexcept
+        {
+            return m_element;
+        }
+        reference operator[](difference_type n) const noexcept
+        {
+            return m_element[n * m_stride];
+        }
+
+        iterator& operator++() noexcept
+        {
+            m_element += m_stride;
+            return *this;
+        }
+        iterator operator++(int) noexcept
+        {
+            iterator previous = *this;
+            m_element += m_stride;
+            return previous;
+        }
+        iterator& operator--() noexcept
+        {
+            m_element -= m_stride;
+            return *this;
+        }
+        iterator operator--(int) noexcept
+        {
+            iterator previous = *this;
+            m_element -= m_stride;
+            return previous;
+        }
+        iterator& operator+=(difference_type n) noexcept
+        {
+            m_element += n * m_stride;
+            return *this;
+        }
+        iterator& operator-=(difference_type n) noexcept
+        {
+            m_element -= n * m_stride;
+            return *this;
+        }
+        friend iterator operator+(iterator it, difference_type n) noexcept
+        {
+            return it += n;
+        }
+        friend iterator operator+(difference_type n, iterator it) noexcept
+        {
+            return it += n;
+        }
+        friend iterator operator-(iterator it, difference_type n) noexcept
+        {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterator& a, const iterator& b) noexcept
+        {
+            return (a.m_element - b.m_element) / a.m_stride;
+        }
+
+        friend bool operator==(const iterator& a, const iterator& b) noexcept
+        {
+            return a.m_element == b.m_element;
+        }
+        friend bool operator!=(const iterator& a, const iterator& b) noexcept
+        {
+            return a.m_element != b.m_element;
+        }
+        friend bool operator<(const iterator& a, const iterator& b) noexcept
+        {
+            return (b - a) > 0;
+        }
+        friend bool operator>(const iterator& a, const iterator& b) noexcept
+        {
+            return b < a;
+        }
+        friend bool operator<=(const iterator& a, const iterator& b) noexcept
+        {
+            return !(b < a);
+        }
+        friend bool operator>=(const iterator& a, const iterator& b) noexcept
+        {
+            return !(a < b);
+        }
+
+    private:
+        T* m_element = nullptr;
+        std::ptrdiff_t m_stride = 1;
+    };
+
+    Span() = default;
+    Span(T* data, size_t size, size_t stride = 1) noexcept :
+        m_data(data),
+        m_size(size),
+        m_stride(stride)
+    {}
+
+    T* data() const noexcept
+    {
+        return m_data;
+    }
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+    size_t stride() const noexcept
+    {
+        return m_stride;
+    }
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+    /* True if the elements follow each other in memory, e.g. for memcpy. */
+    bool contiguous() const noexcept
+    {
+        return m_stride == 1 || m_size <= 1;
+    }
+
+    T& operator[](size_t index) const noexcept
+    {
+        return m_data[index * m_stride];
+    }
+
+    iterator begin() const noexcept
+    {
+        return iterator(m_data, static_cast<std::ptrdiff_t>(m_stride));
+    }
+    iterator end() const noexcept
+    {
+        return iterator(m_data + m_size * m_stride, static_cast<std::ptrdiff_t>(m_stride));
+    }
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_stride = 1;
+};
+
+namespace detail {
+
+/* Element type of a view of Mda: const if Mda is const. */
+template <typename Mda>
+using ElementOf = std::conditional_t<std::is_const<Mda>::value,
+                                     const std::remove_pointer_t<decltype(std::declval<Mda&>().data)>,
+                                     std::remove_pointer_t<decltype(std::declval<Mda&>().data)>>;
+
+}  // namespace detail
+
+/* View of the elements of a vector. */
+template <typename Mda>
+Span<detail::ElementOf<Mda>> vector_view(Mda* vector) noexcept
+{
+    return {IFX_MDA_DATA(vector), IFX_MDA_SHAPE(vector)[0], IFX_MDA_STRIDE(vector)[0]};
+}
+
+/* View of row r of a matrix. */
+template <typename Mda>
+Span<detail::ElementOf<Mda>> row_view(Mda* matrix, uint32_t r) noexcept
+{
+    return {IFX_MDA_DATA(matrix) + r * IFX_MDA_STRIDE(matrix)[0], IFX_MDA_SHAPE(matrix)[1], IFX_MDA_STRIDE(matrix)[1]};
+}
+
+/* View of column c of a matrix. */
+template <typename Mda>
+Span<detail::ElementOf<Mda>> column_view(Mda* matrix, uint32_t c) noexcept
+{
+    return {IFX_MDA_DATA(matrix) + c * IFX_MDA_STRIDE(matrix)[1], IFX_MDA_SHAPE(matrix)[0], IFX_MDA_STRIDE(matrix)[0]};
+}
+
+/* View of the slices at row r and column c of a cube, e.g. the samples of
+   one chirp of an antenna in an FMCW frame. */
+template <typename Mda>
+Span<detail::ElementOf<Mda>> fiber_view(Mda* cube, uint32_t r, uint32_t c) noexcept
+{
+    return {IFX_MDA_DATA(cube) + r * IFX_MDA_STRIDE(cube)[0] + c * IFX_MDA_STRIDE(cube)[1],
+            IFX_MDA_SHAPE(cube)[2], IFX_MDA_STRIDE(cube)[2]};
+}
+
+}  // namespace rdk
+
+#endif /* IFX_BASE_OWNED_HPP */
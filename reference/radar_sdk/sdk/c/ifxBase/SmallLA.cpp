@@ -0,0 +1,466 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include "Complex.h"
+#include "Defines.h"
+#include "Error.h"
+#include "internal/SmallLA.h"
+#include "Matrix.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+/*
+ * The arithmetic follows the ifx_complex_* functions used by LA.c, e.g. a
+ * division is a multiplication by the conjugate divided by |b|^2, so both
+ * paths give the same results up to rounding.
+ */
+struct Complex
+{
+    ifx_Float_t re;
+    ifx_Float_t im;
+};
+
+inline Complex operator*(Complex a, Complex b)
+{
+    return {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+
+inline Complex operator-(Complex a, Complex b)
+{
+    return {a.re - b.re, a.im - b.im};
+}
+
+inline Complex operator-(Complex a)
+{
+    return {-a.re, -a.im};
+}
+
+inline Complex operator/(Complex a, Complex b)
+{
+    const ifx_Float_t b_abs2 = b.re * b.re + b.im * b.im;
+    const Complex c = a * Complex {b.re, -b.im};
+    return {c.re / b_abs2, c.im / b_abs2};
+}
+
+inline ifx_Float_t magnitude(ifx_Float_t a)
+{
+    return FABS(a);
+}
+
+inline ifx_Float_t magnitude(Complex a)
+{
+    return HYPOT(a.re, a.im);
+}
+
+inline ifx_Float_t conjugate(ifx_Float_t a)
+{
+    return a;
+}
+
+inline Complex conjugate(Complex a)
+{
+    return {a.re, -a.im};
+}
+
+inline ifx_Float_t real_part(ifx_Float_t a)
+{
+    return a;
+}
+
+inline ifx_Float_t real_part(Complex a)
+{
+    return a.re;
+}
+
+template <typename T>
+constexpr T from_real(ifx_Float_t value)
+{
+    if constexpr (std::is_same<T, Complex>::value)
+        return {value, 0};
+    else
+        return value;
+}
+
+/* Maps the scalar of the kernels to the types of the SDK */
+template <typename T>
+struct Types;
+
+template <>
+struct Types<ifx_Float_t>
+{
+    using Matrix = ifx_Matrix_R_t;
+    using Value = ifx_Float_t;
+};
+
+template <>
+struct Types<Complex>
+{
+    using Matrix = ifx_Matrix_C_t;
+    using Value = ifx_Complex_t;
+};
+
+/**
+ * @brief NxN matrix stored by value
+ */
+template <typename T, uint32_t N>
+struct SmallMatrix
+{
+    T a[N][N];
+
+    void load(const typename Types<T>::Matrix* m)
+    {
+        const auto* data = reinterpret_cast<const T*>(IFX_MAT_DAT(m));
+        const size_t row_stride = IFX_MAT_STRIDE(m, 0);
+        const size_t col_stride = IFX_MAT_STRIDE(m, 1);
+
+        for (uint32_t i = 0; i < N; i++)
+            for (uint32_t j = 0; j < N; j++)
+                a[i][j] = data[i * row_stride + j * col_stride];
+    }
+
+    void store(typename Types<T>::Matrix* m) const
+    {
+        auto* data = reinterpret_cast<T*>(IFX_MAT_DAT(m));
+        const size_t row_stride = IFX_MAT_STRIDE(m, 0);
+        const size_t col_stride = IFX_MAT_STRIDE(m, 1);
+
+        for (uint32_t i = 0; i < N; i++)
+            for (uint32_t j = 0; j < N; j++)
+                data[i * row_stride + j * col_stride] = a[i][j];
+    }
+};
+
+static_assert(sizeof(Complex) == sizeof(ifx_Complex_t), "Complex must have the layout of ifx_Complex_t");
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/*
+ * The kernels below are the algorithms of lu_r_inplace, lu_invert_r,
+ * cholesky_r_inplace and determinant_r_inplace in LA.c (and their complex
+ * variants) with the dimension as template parameter.
+ */
+
+/* LU decomposition with partial pivoting, returns false if A is singular */
+template <typename T, uint32_t N>
+bool lu(SmallMatrix<T, N>& A, uint32_t P[N], uint32_t& permutations)
+{
+    permutations = 0;
+    for (uint32_t i = 0; i < N; i++)
+        P[i] = i;
+
+    for (uint32_t i = 0; i < N; i++)
+    {
+        ifx_Float_t maxA = 0;
+        uint32_t imax = i;
+
+        for (uint32_t k = i; k < N; k++)
+        {
+            const ifx_Float_t absA = magnitude(A.a[P[k]][i]);
+            if (absA > maxA)
+            {
+                maxA = absA;
+                imax = k;
+            }
+        }
+
+        if (maxA == 0)
+            return false;
+
+        if (imax != i)
+        {
+            const uint32_t temp = P[i];
+            P[i] = P[imax];
+            P[imax] = temp;
+            permutations++;
+        }
+
+        for (uint32_t j = i + 1; j < N; j++)
+        {
+            A.a[P[j]][i] = A.a[P[j]][i] / A.a[P[i]][i];
+
+            for (uint32_t k = i + 1; k < N; k++)
+                A.a[P[j]][k] = A.a[P[j]][k] - A.a[P[j]][i] * A.a[P[i]][k];
+        }
+    }
+
+    return true;
+}
+
+template <typename T, uint32_t N>
+void lu_invert(const SmallMatrix<T, N>& LU, const uint32_t P[N], SmallMatrix<T, N>& inverse)
+{
+    for (uint32_t j = 0; j < N; j++)
+    {
+        for (uint32_t i = 0; i < N; i++)
+        {
+            inverse.a[i][j] = from_real<T>((P[i] == j) ? 1 : 0);
+
+            for (uint32_t k = 0; k < i; k++)
+                inverse.a[i][j] = inverse.a[i][j] - LU.a[P[i]][k] * inverse.a[k][j];
+        }
+
+        for (uint32_t n = N; n > 0; n--)
+        {
+            const uint32_t i = n - 1;
+
+            for (uint32_t k = i + 1; k < N; k++)
+                inverse.a[i][j] = inverse.a[i][j] - LU.a[P[i]][k] * inverse.a[k][j];
+
+            inverse.a[i][j] = inverse.a[i][j] / LU.a[P[i]][i];
+        }
+    }
+}
+
+template <typename T, uint32_t N>
+bool invert(const typename Types<T>::Matrix* A, typename Types<T>::Matrix* Ainv)
+{
+    SmallMatrix<T, N> LU;
+    SmallMatrix<T, N> inverse;
+    uint32_t P[N];
+    uint32_t permutations;
+
+    LU.load(A);
+    if (!lu(LU, P, permutations))
+    {
+        // like lu_invert_r after a failed decomposition
+        ifx_error_set(IFX_ERROR_MATRIX_SINGULAR);
+    }
+    lu_invert(LU, P, inverse);
+    inverse.store(Ainv);
+    return true;
+}
+
+template <typename T, uint32_t N>
+bool cholesky(const typename Types<T>::Matrix* A, typename Types<T>::Matrix* L)
+{
+    SmallMatrix<T, N> M;
+    M.load(A);
+
+    // only the lower triangle is read, the upper one is zero in L
+    for (uint32_t i = 0; i < N; i++)
+        for (uint32_t j = i + 1; j < N; j++)
+            M.a[i][j] = from_real<T>(0);
+
+    for (uint32_t i = 0; i < N; i++)
+    {
+        for (uint32_t j = i; j < N; j++)
+        {
+            T sum = M.a[j][i];
+
+            for (uint32_t k = 0; k < i; k++)
+                sum = sum - conjugate(M.a[i][k]) * M.a[j][k];
+
+            if (i == j)
+            {
+                // sum is real if i=j
+                if (real_part(sum) < 0)
+                {
+                    ifx_error_set(IFX_ERROR_MATRIX_NOT_POSITIVE_DEFINITE);
+                    M.store(L);
+                    return true;
+                }
+
+                M.a[i][i] = from_real<T>(SQRT(real_part(sum)));
+            }
+            else
+            {
+                M.a[j][i] = sum / M.a[i][i];
+            }
+        }
+    }
+
+    M.store(L);
+    return true;
+}
+
+template <typename T, uint32_t N>
+bool determinant(const typename Types<T>::Matrix* A, typename Types<T>::Value* result)
+{
+    SmallMatrix<T, N> LU;
+    uint32_t P[N];
+    uint32_t permutations;
+    T det = from_real<T>(0);
+
+    LU.load(A);
+    if (lu(LU, P, permutations))
+    {
+        det = from_real<T>(1);
+        for (uint32_t j = 0; j < N; j++)
+            det = det * LU.a[P[j]][j];
+
+        if (permutations % 2)
+            det = -det;
+    }
+
+    *reinterpret_cast<T*>(result) = det;
+    return true;
+}
+
+/*
+ * Dispatches to the instance for the dimension of the matrix. Kernel is a
+ * class template with an operator() so it can be passed as a template
+ * template parameter.
+ */
+template <template <typename, uint32_t> class Kernel, typename T, typename... Args>
+bool dispatch(uint32_t N, Args... args)
+{
+    switch (N)
+    {
+        case 1: return Kernel<T, 1>()(args...);
+        case 2: return Kernel<T, 2>()(args...);
+        case 3: return Kernel<T, 3>()(args...);
+        case 4: return Kernel<T, 4>()(args...);
+        case 5: return Kernel<T, 5>()(args...);
+        case 6: return Kernel<T, 6>()(args...);
+        case 7: return Kernel<T, 7>()(args...);
+        case 8: return Kernel<T, 8>()(args...);
+        default: return false;
+    }
+}
+
+static_assert(IFX_LA_SMALL_MAX_DIM == 8, "dispatch must cover all dimensions up to IFX_LA_SMALL_MAX_DIM");
+
+template <typename T, uint32_t N>
+struct Invert
+{
+    bool operator()(const typename Types<T>::Matrix* A, typename Types<T>::Matrix* Ainv) const
+    {
+        return invert<T, N>(A, Ainv);
+    }
+};
+
+template <typename T, uint32_t N>
+struct Cholesky
+{
+    bool operator()(const typename Types<T>::Matrix* A, typename Types<T>::Matrix* L) const
+    {
+        return cholesky<T, N>(A, L);
+    }
+};
+
+template <typename T, uint32_t N>
+struct Determinant
+{
+    bool operator()(const typename Types<T>::Matrix* A, typename Types<T>::Value* result) const
+    {
+        return determinant<T, N>(A, result);
+    }
+};
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+bool ifx_la_small_invert_r(const ifx_Matrix_R_t* A,
+                           ifx_Matrix_R_t* Ainv)
+{
+    return dispatch<Invert, ifx_Float_t>(IFX_MAT_ROWS(A), A, Ainv);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_la_small_invert_c(const ifx_Matrix_C_t* A,
+                           ifx_Matrix_C_t* Ainv)
+{
+    return dispatch<Invert, Complex>(IFX_MAT_ROWS(A), A, Ainv);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_la_small_cholesky_r(const ifx_Matrix_R_t* A,
+                             ifx_Matrix_R_t* L)
+{
+    return dispatch<Cholesky, ifx_Float_t>(IFX_MAT_ROWS(A), A, L);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_la_small_cholesky_c(const ifx_Matrix_C_t* A,
+                             ifx_Matrix_C_t* L)
+{
+    return dispatch<Cholesky, Complex>(IFX_MAT_ROWS(A), A, L);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_la_small_determinant_r(const ifx_Matrix_R_t* A,
+                                ifx_Float_t* determinant)
+{
+    return dispatch<Determinant, ifx_Float_t>(IFX_MAT_ROWS(A), A, determinant);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_la_small_determinant_c(const ifx_Matrix_C_t* A,
+                                ifx_Complex_t* determinant)
+{
+    return dispatch<Determinant, Complex>(IFX_MAT_ROWS(A), A, determinant);
+}
@@ -178,6 +178,44 @@ typedef struct ifx_Polar_s ifx_Polar_t;
  */
 typedef struct ifx_Complex_s ifx_Complex_t;
 
+/**
+ * @brief Half precision floating point number (IEEE 754 binary16).
+ *
+ * The type only stores values, e.g. in \ref ifx_Mda_H_t. There is no
+ * arithmetic on it; values are converted to \ref ifx_Float_t for
+ * processing.
+ */
+typedef uint16_t ifx_Float16_t;
+
+/**
+ * @brief Defines the structure for half precision complex numbers.
+ *        Use type ifx_Complex16_t for this struct.
+ */
+struct ifx_Complex16_s
+{
+    ifx_Float16_t data[2];
+};
+
+/**
+ * @brief Half precision complex number, storage only (see \ref ifx_Float16_t).
+ */
+typedef struct ifx_Complex16_s ifx_Complex16_t;
+
+/**
+ * @brief Statistics of a handle cache, e.g. \ref ifx_rdm_get_cache_stats.
+ *
+ * An acquire is the time a reconfiguration stalls the caller: a hit returns
+ * a cached handle, a miss creates a new one.
+ */
+typedef struct
+{
+    uint32_t hits;            /**< Number of acquires served from the cache.*/
+    uint32_t misses;          /**< Number of acquires that created a new handle.*/
+    uint32_t cached;          /**< Number of released handles currently held by the cache.*/
+    uint64_t last_acquire_ns; /**< Duration of the last acquire in nanoseconds.*/
+    uint64_t max_acquire_ns;  /**< Duration of the slowest acquire in nanoseconds.*/
+} ifx_Handle_Cache_Stats_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
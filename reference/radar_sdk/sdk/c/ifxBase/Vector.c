@@ -39,6 +39,8 @@
 #include "Complex.h"
 #include "Defines.h"
 #include "Error.h"
+#include "internal/ComplexInline.h"
+#include "internal/Kernels.h"
 #include "internal/Macros.h"
 #include "internal/Simd.h"
 #include "internal/Util.h"
@@ -54,6 +56,58 @@
 
 const ifx_Float_t clipping_value_for_db = 1e-6f;
 
+/* vectors without gaps between the elements can use the kernels from
+ * internal/Kernels.h
+ */
+#define VEC_CONTIGUOUS(v) (vStride(v) == 1)
+
+// strided vectors are copied in blocks of this size for the statistics kernel
+#define STATS_COPY_BLOCK 256
+
+/* apply unary operator op to all elements of in and store them in out;
+ * contiguous vectors are indexed directly so the compiler can vectorize the
+ * loop, strided vectors use strides loaded once instead of vAt per element
+ */
+#define VEC_APPLY_UNOP(in, op, out)                                     \
+    do                                                                  \
+    {                                                                   \
+        const uint32_t len_ = vLen(in);                                 \
+        if (VEC_CONTIGUOUS(in) && VEC_CONTIGUOUS(out))                  \
+        {                                                               \
+            for (uint32_t i = 0; i < len_; i++)                         \
+                vDat(out)[i] = op(vDat(in)[i]);                         \
+        }                                                               \
+        else                                                            \
+        {                                                               \
+            const size_t in_stride_ = vStride(in);                      \
+            const size_t out_stride_ = vStride(out);                    \
+            for (uint32_t i = 0; i < len_; i++)                         \
+                vDat(out)[i * out_stride_] = op(vDat(in)[i * in_stride_]); \
+        }                                                               \
+    } while (0)
+
+/* apply binary operator op to all pairs of elements from lhs and rhs and
+ * store them in out; see VEC_APPLY_UNOP
+ */
+#define VEC_APPLY_BINOP(lhs, op, rhs, out)                                                         \
+    do                                                                                             \
+    {                                                                                              \
+        const uint32_t len_ = vLen(lhs);                                                           \
+        if (VEC_CONTIGUOUS(lhs) && VEC_CONTIGUOUS(rhs) && VEC_CONTIGUOUS(out))                     \
+        {                                                                                          \
+            for (uint32_t i = 0; i < len_; i++)                                                    \
+                vDat(out)[i] = op(vDat(lhs)[i], vDat(rhs)[i]);                                     \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            const size_t lhs_stride_ = vStride(lhs);                                               \
+            const size_t rhs_stride_ = vStride(rhs);                                               \
+            const size_t out_stride_ = vStride(out);                                               \
+            for (uint32_t i = 0; i < len_; i++)                                                    \
+                vDat(out)[i * out_stride_] = op(vDat(lhs)[i * lhs_stride_], vDat(rhs)[i * rhs_stride_]); \
+        }                                                                                          \
+    } while (0)
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
@@ -93,6 +147,22 @@ static int median_rank(
     const ifx_Vector_R_t* input, uint32_t offset,
     uint32_t number_of_el, uint32_t pick_pos_offsetted);
 
+/**
+ * @brief Restores the heap of \ref ifx_vec_topk_r below position index
+ *
+ * The root of the heap is the worst of the kept elements, i.e., the
+ * smallest one for sign=1 and the largest one for sign=-1.
+ *
+ * @param [in]     data             data of the vector
+ * @param [in]     stride           stride of the vector
+ * @param [in]     sign             1 to keep the largest values, -1 to keep the smallest ones
+ * @param [in,out] heap             indices into data
+ * @param [in]     size             number of elements in heap
+ * @param [in]     index            position of the element to move down
+ */
+static void topk_sift_down(const ifx_Float_t* data, size_t stride, ifx_Float_t sign,
+                           uint32_t* heap, uint32_t size, uint32_t index);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -335,6 +405,12 @@ void ifx_vec_blit_r(const ifx_Vector_R_t* vector,
     const ifx_Float_t* vdata = &IFX_MDA_AT(vector, offset);
     ifx_Float_t* tdata = &IFX_MDA_AT(target, target_offset);
 
+    if (vstride == 1 && tstride == 1)
+    {
+        memmove(tdata, vdata, length * sizeof(ifx_Float_t));
+        return;
+    }
+
     for (size_t i = 0; i < length; i++)
     {
         *tdata = *vdata;
@@ -361,6 +437,12 @@ void ifx_vec_blit_c(const ifx_Vector_C_t* vector,
     const ifx_Complex_t* vdata = IFX_MDA_DATA(vector) + IFX_MDA_OFFSET(vector, offset);
     ifx_Complex_t* tdata = IFX_MDA_DATA(target) + IFX_MDA_OFFSET(target, target_offset);
 
+    if (vstride == 1 && tstride == 1)
+    {
+        memmove(tdata, vdata, length * sizeof(ifx_Complex_t));
+        return;
+    }
+
     for (size_t i = 0; i < length; i++)
     {
         *tdata = *vdata;
@@ -642,7 +724,7 @@ ifx_Complex_t ifx_vec_sum_c(const ifx_Vector_C_t* vector)
 
     for (uint32_t i = 0; i < length; i++)
     {
-        sum = ifx_complex_add(sum, vAt(vector, i));
+        sum = ifx_cadd(sum, vAt(vector, i));
     }
 
     return sum;
@@ -677,7 +759,7 @@ ifx_Float_t ifx_vec_sqsum_c(const ifx_Vector_C_t* vector)
 
     for (uint32_t i = 0; i < length; i++)
     {
-        result = result + ifx_complex_sqnorm(vAt(vector, i));
+        result = result + ifx_cabs2(vAt(vector, i));
     }
 
     return result;
@@ -737,11 +819,11 @@ ifx_Float_t ifx_vec_maxabs_c(const ifx_Vector_C_t* vector)
     IFX_ERR_BRV_COND(vLen(vector) == 0, IFX_ERROR_ARGUMENT_INVALID, 0);
 
     const uint32_t length = vLen(vector);
-    ifx_Float_t max = ifx_complex_sqnorm(vAt(vector, 0));
+    ifx_Float_t max = ifx_cabs2(vAt(vector, 0));
 
     for (uint32_t i = 1; i < length; i++)
     {
-        const ifx_Float_t val = ifx_complex_sqnorm(vAt(vector, i));
+        const ifx_Float_t val = ifx_cabs2(vAt(vector, i));
 
         if (val > max)
         {
@@ -805,11 +887,11 @@ uint32_t ifx_vec_max_idx_c(const ifx_Vector_C_t* vector)
     IFX_VEC_BRV_VALID(vector, 0);
 
     uint32_t index = 0;
-    ifx_Float_t max = ifx_complex_sqnorm(vAt(vector, 0));
+    ifx_Float_t max = ifx_cabs2(vAt(vector, 0));
 
     for (uint32_t i = 1; i < vLen(vector); i++)
     {
-        const ifx_Float_t val = ifx_complex_sqnorm(vAt(vector, i));
+        const ifx_Float_t val = ifx_cabs2(vAt(vector, i));
 
         if (val > max)
         {
@@ -833,10 +915,9 @@ void ifx_vec_add_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = vAt(v1, i) + vAt(v2, i);
-    }
+#define OP(a, b) ((a) + (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -851,10 +932,9 @@ void ifx_vec_add_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = ifx_complex_add(vAt(v1, i), vAt(v2, i));
-    }
+#define OP(a, b) ifx_cadd((a), (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -869,10 +949,9 @@ void ifx_vec_sub_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = vAt(v1, i) - vAt(v2, i);
-    }
+#define OP(a, b) ((a) - (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -887,10 +966,9 @@ void ifx_vec_sub_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = ifx_complex_sub(vAt(v1, i), vAt(v2, i));
-    }
+#define OP(a, b) ifx_csub((a), (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -905,10 +983,15 @@ void ifx_vec_mul_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
     {
-        vAt(result, i) = vAt(v1, i) * vAt(v2, i);
+        ifx_kernels_get()->mul_r(vDat(v1), vDat(v2), vDat(result), vLen(v1));
+        return;
     }
+
+#define OP(a, b) ((a) * (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -923,10 +1006,15 @@ void ifx_vec_mul_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
     {
-        vAt(result, i) = ifx_complex_mul(vAt(v1, i), vAt(v2, i));
+        ifx_kernels_get()->mul_c(vDat(v1), vDat(v2), vDat(result), vLen(v1));
+        return;
     }
+
+#define OP(a, b) ifx_cmul((a), (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -941,10 +1029,9 @@ void ifx_vec_mul_cr(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = ifx_complex_mul_real(vAt(v1, i), vAt(v2, i));
-    }
+#define OP(a, b) ifx_cscale((a), (b))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -956,10 +1043,9 @@ void ifx_vec_abs_r(const ifx_Vector_R_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = FABS(vAt(input, i));
-    }
+#define OP(elem) FABS(elem)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -971,10 +1057,15 @@ void ifx_vec_abs_c(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
     {
-        vAt(output, i) = ifx_complex_abs(vAt(input, i));
+        ifx_kernels_get()->abs_c(vDat(input), vDat(output), vLen(input));
+        return;
     }
+
+#define OP(elem) ifx_complex_abs(elem)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1002,10 +1093,9 @@ void ifx_vec_sub_rs(const ifx_Vector_R_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = vAt(input, i) - scalar_value;
-    }
+#define OP(elem) ((elem)-scalar_value)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1018,10 +1108,9 @@ void ifx_vec_sub_cs(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = ifx_complex_sub(vAt(input, i), scalar_value);
-    }
+#define OP(elem) ifx_csub((elem), scalar_value)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1034,10 +1123,9 @@ void ifx_vec_scale_r(const ifx_Vector_R_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = vAt(input, i) * scale;
-    }
+#define OP(elem) ((elem)*scale)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1050,10 +1138,9 @@ void ifx_vec_scale_rc(const ifx_Vector_R_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = ifx_complex_mul_real(scale, vAt(input, i));
-    }
+#define OP(elem) ifx_cscale(scale, (elem))
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1066,10 +1153,15 @@ void ifx_vec_scale_c(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
     {
-        vAt(output, i) = ifx_complex_mul(vAt(input, i), scale);
+        ifx_kernels_get()->scale_c(vDat(input), scale, vDat(output), vLen(input));
+        return;
     }
+
+#define OP(elem) ifx_cmul((elem), scale)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1082,10 +1174,9 @@ void ifx_vec_scale_cr(const ifx_Vector_C_t* input,
     IFX_VEC_BRK_VALID(output);
     IFX_VEC_BRK_DIM(input, output);
 
-    for (uint32_t i = 0; i < vLen(input); ++i)
-    {
-        vAt(output, i) = ifx_complex_mul_real(vAt(input, i), scale);
-    }
+#define OP(elem) ifx_cscale((elem), scale)
+    VEC_APPLY_UNOP(input, OP, output);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1123,10 +1214,9 @@ void ifx_vec_mac_r(const ifx_Vector_R_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
-    {
-        vAt(result, i) = vAt(v1, i) + (scale * vAt(v2, i));
-    }
+#define OP(a, b) ((a) + (scale * (b)))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1142,10 +1232,15 @@ void ifx_vec_mac_c(const ifx_Vector_C_t* v1,
     IFX_VEC_BRK_DIM(v1, v2);
     IFX_VEC_BRK_DIM(v1, result);
 
-    for (uint32_t i = 0; i < vLen(v1); ++i)
+    if (VEC_CONTIGUOUS(v1) && VEC_CONTIGUOUS(v2) && VEC_CONTIGUOUS(result))
     {
-        vAt(result, i) = ifx_complex_add(vAt(v1, i), ifx_complex_mul(vAt(v2, i), scale));
+        ifx_kernels_get()->mac_c(vDat(v1), vDat(v2), scale, vDat(result), vLen(v1));
+        return;
     }
+
+#define OP(a, b) ifx_cadd((a), ifx_cmul((b), scale))
+    VEC_APPLY_BINOP(v1, OP, v2, result);
+#undef OP
 }
 
 //----------------------------------------------------------------------------
@@ -1212,6 +1307,48 @@ ifx_Float_t ifx_vec_var_r(const ifx_Vector_R_t* vector)
 
 //----------------------------------------------------------------------------
 
+void ifx_vec_stats_r(const ifx_Vector_R_t* vector, ifx_Stats_R_t* stats)
+{
+    IFX_VEC_BRK_VALID(vector);
+    IFX_ERR_BRK_NULL(stats);
+    IFX_ERR_BRK_ARGUMENT(vLen(vector) == 0);
+
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    const uint32_t len = vLen(vector);
+    const ifx_Float_t shift = vAt(vector, 0);
+    double sums[2] = {0, 0};
+    ifx_Float_t range[2] = {shift, shift};
+    uint32_t idx[2] = {0, 0};
+
+    if (VEC_CONTIGUOUS(vector))
+    {
+        kernels->stats_r(vDat(vector), shift, 0, sums, range, idx, len);
+    }
+    else
+    {
+        ifx_Float_t block[STATS_COPY_BLOCK];
+        for (uint32_t first = 0; first < len; first += STATS_COPY_BLOCK)
+        {
+            const uint32_t n = MIN(len - first, STATS_COPY_BLOCK);
+            for (uint32_t i = 0; i < n; i++)
+                block[i] = vAt(vector, first + i);
+            kernels->stats_r(block, shift, first, sums, range, idx, n);
+        }
+    }
+
+    const double mean = sums[0] / len;
+    const double variance = sums[1] / len - mean * mean;
+
+    stats->mean = (ifx_Float_t)(shift + mean);
+    stats->variance = (ifx_Float_t)MAX(variance, 0.0);
+    stats->min = range[0];
+    stats->max = range[1];
+    stats->min_idx = idx[0];
+    stats->max_idx = idx[1];
+}
+
+//----------------------------------------------------------------------------
+
 uint32_t ifx_vec_local_maxima(const ifx_Vector_R_t* vector,
                               ifx_Float_t threshold,
                               uint32_t num_maxima,
@@ -1241,6 +1378,62 @@ uint32_t ifx_vec_local_maxima(const ifx_Vector_R_t* vector,
     return count;
 }
 
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_vec_topk_r(const ifx_Vector_R_t* vector,
+                        uint32_t k,
+                        ifx_Vector_Sort_Order_t order,
+                        uint32_t* indices)
+{
+    IFX_VEC_BRV_VALID(vector, 0);
+    IFX_ERR_BRV_NULL(indices, 0);
+
+    const ifx_Float_t* data = vDat(vector);
+    const size_t stride = vStride(vector);
+    const uint32_t len = vLen(vector);
+
+    // flipping the sign turns the search for the smallest values into a search for the largest ones
+    const ifx_Float_t sign = (order == IFX_SORT_DESCENDING) ? 1 : -1;
+
+    k = MIN(k, len);
+    if (k == 0)
+    {
+        return 0;
+    }
+
+    // heap of the k best elements seen so far with the worst one at the root
+    for (uint32_t i = 0; i < k; i++)
+    {
+        indices[i] = i;
+    }
+    for (uint32_t i = k / 2; i > 0; i--)
+    {
+        topk_sift_down(data, stride, sign, indices, k, i - 1);
+    }
+
+    const ifx_Float_t* value = data + k * stride;
+    for (uint32_t i = k; i < len; i++, value += stride)
+    {
+        // later elements lose ties, so only strictly better values replace the root
+        if (sign * *value > sign * data[indices[0] * stride])
+        {
+            indices[0] = i;
+            topk_sift_down(data, stride, sign, indices, k, 0);
+        }
+    }
+
+    // heap sort: moving the root to the end leaves the best element in front
+    for (uint32_t size = k - 1; size > 0; size--)
+    {
+        const uint32_t worst = indices[0];
+        indices[0] = indices[size];
+        indices[size] = worst;
+        topk_sift_down(data, stride, sign, indices, size, 0);
+    }
+
+    return k;
+}
 //----------------------------------------------------------------------------
 
 void ifx_vec_clear_r(ifx_Vector_R_t* vector)
@@ -1280,6 +1473,44 @@ void ifx_vec_linspace_r(ifx_Float_t start,
 
 //----------------------------------------------------------------------------
 
+static void topk_sift_down(const ifx_Float_t* data, size_t stride, ifx_Float_t sign,
+                           uint32_t* heap, uint32_t size, uint32_t index)
+{
+    // a is worse than b if its value is smaller, or equal with a larger index
+#define TOPK_WORSE(a, b) (sign * data[(a)*stride] < sign * data[(b)*stride] \
+                          || (data[(a)*stride] == data[(b)*stride] && (a) > (b)))
+
+    const uint32_t element = heap[index];
+
+    for (;;)
+    {
+        uint32_t child = 2 * index + 1;
+        if (child >= size)
+        {
+            break;
+        }
+
+        if (child + 1 < size && TOPK_WORSE(heap[child + 1], heap[child]))
+        {
+            child++;
+        }
+
+        if (!TOPK_WORSE(heap[child], element))
+        {
+            break;
+        }
+
+        heap[index] = heap[child];
+        index = child;
+    }
+
+    heap[index] = element;
+
+#undef TOPK_WORSE
+}
+
+//----------------------------------------------------------------------------
+
 static int median_rank(
     const ifx_Vector_R_t* input, uint32_t offset,
     uint32_t number_of_el, uint32_t pick_pos_offsetted)
@@ -1533,6 +1764,12 @@ void ifx_vec_squared_norm_c(const ifx_Vector_C_t* input, ifx_Vector_R_t* output)
 {
     IFX_VEC_BRK_DIM(input, output);
 
+    if (VEC_CONTIGUOUS(input) && VEC_CONTIGUOUS(output))
+    {
+        ifx_kernels_get()->abs2_c(vDat(input), vDat(output), vLen(input));
+        return;
+    }
+
     for (uint32_t i = 0; i < vLen(input); i++)
     {
         const ifx_Complex_t z = vAt(input, i);
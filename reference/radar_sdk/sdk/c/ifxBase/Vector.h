@@ -79,29 +79,29 @@ extern "C"
 #define IFX_VEC_AT(v, idx) IFX_MDA_AT(v, idx)
 
 // Condition check macro adaptations for Vector module -----------------------
-#define IFX_VEC_BRK_DIM(v1, v2)    IFX_ERR_BRK_COND(IFX_VEC_LEN(v1) != IFX_VEC_LEN(v2), IFX_ERROR_DIMENSION_MISMATCH)
-#define IFX_VEC_BRV_DIM(v1, v2, a) IFX_ERR_BRV_COND(IFX_VEC_LEN(v1) != IFX_VEC_LEN(v2), IFX_ERROR_DIMENSION_MISMATCH, a)
+#define IFX_VEC_BRK_DIM(v1, v2)    IFX_ERR_ARG_BRK_COND(IFX_VEC_LEN(v1) != IFX_VEC_LEN(v2), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_VEC_BRV_DIM(v1, v2, a) IFX_ERR_ARG_BRV_COND(IFX_VEC_LEN(v1) != IFX_VEC_LEN(v2), IFX_ERROR_DIMENSION_MISMATCH, a)
 
-#define IFX_VEC_BRK_MINSIZE(v, minsize) IFX_ERR_BRK_COND(IFX_VEC_LEN(v) < (minsize), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_VEC_BRK_MINSIZE(v, minsize) IFX_ERR_ARG_BRK_COND(IFX_VEC_LEN(v) < (minsize), IFX_ERROR_DIMENSION_MISMATCH)
 
-#define IFX_VEC_BRK_DIM_GT(vsmall, v) IFX_ERR_BRK_COND(vLen(vsmall) > vLen(v), IFX_ERROR_DIMENSION_MISMATCH)
+#define IFX_VEC_BRK_DIM_GT(vsmall, v) IFX_ERR_ARG_BRK_COND(vLen(vsmall) > vLen(v), IFX_ERROR_DIMENSION_MISMATCH)
 
-#define IFX_VEC_BRK_VEC_BOUNDS(v, idx) IFX_ERR_BRK_COND((idx) >= IFX_VEC_LEN(v), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS)
+#define IFX_VEC_BRK_VEC_BOUNDS(v, idx) IFX_ERR_ARG_BRK_COND((idx) >= IFX_VEC_LEN(v), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS)
 #define IFX_VEC_BRF_VEC_BOUNDS(v, idx) IFX_ERR_BRF_COND((idx) >= IFX_VEC_LEN(v), IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS)
 
-#define IFX_VEC_BRK_VALID(m)                                                        \
-    do                                                                              \
-    {                                                                               \
-        IFX_ERR_BRK_NULL(m);                                                        \
-        IFX_ERR_BRK_COND(IFX_MDA_DIMENSIONS(m) != 1, IFX_ERROR_DIMENSION_MISMATCH); \
-        IFX_ERR_BRK_ARGUMENT(vDat(m) == NULL);                                      \
+#define IFX_VEC_BRK_VALID(m)                                                            \
+    do                                                                                  \
+    {                                                                                   \
+        IFX_ERR_ARG_BRK_COND(!(m), IFX_ERROR_ARGUMENT_NULL);                            \
+        IFX_ERR_ARG_BRK_COND(IFX_MDA_DIMENSIONS(m) != 1, IFX_ERROR_DIMENSION_MISMATCH); \
+        IFX_ERR_ARG_BRK_COND(vDat(m) == NULL, IFX_ERROR_ARGUMENT_INVALID);              \
     } while (0)
-#define IFX_VEC_BRV_VALID(m, r)                                                        \
-    do                                                                                 \
-    {                                                                                  \
-        IFX_ERR_BRV_NULL(m, r);                                                        \
-        IFX_ERR_BRV_COND(IFX_MDA_DIMENSIONS(m) != 1, IFX_ERROR_DIMENSION_MISMATCH, r); \
-        IFX_ERR_BRV_ARGUMENT(vDat(m) == NULL, r);                                      \
+#define IFX_VEC_BRV_VALID(m, r)                                                            \
+    do                                                                                     \
+    {                                                                                      \
+        IFX_ERR_ARG_BRV_COND(!(m), IFX_ERROR_ARGUMENT_NULL, r);                            \
+        IFX_ERR_ARG_BRV_COND(IFX_MDA_DIMENSIONS(m) != 1, IFX_ERROR_DIMENSION_MISMATCH, r); \
+        IFX_ERR_ARG_BRV_COND(vDat(m) == NULL, IFX_ERROR_ARGUMENT_INVALID, r);              \
     } while (0)
 
 /*
@@ -129,6 +129,19 @@ typedef enum
     IFX_SORT_DESCENDING     /**< Sorting in Descending order */
 } ifx_Vector_Sort_Order_t;
 
+/**
+ * @brief Statistics of real values computed in a single pass, see \ref ifx_vec_stats_r.
+ */
+typedef struct
+{
+    ifx_Float_t mean;     /**< Arithmetic mean.*/
+    ifx_Float_t variance; /**< Variance, normalized by the number of values as \ref ifx_vec_var_r.*/
+    ifx_Float_t min;      /**< Minimum value.*/
+    ifx_Float_t max;      /**< Maximum value.*/
+    uint32_t min_idx;     /**< Index of the first minimum.*/
+    uint32_t max_idx;     /**< Index of the first maximum.*/
+} ifx_Stats_R_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -1023,6 +1036,23 @@ ifx_Float_t ifx_vec_max_r(const ifx_Vector_R_t* vector);
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_vec_var_r(const ifx_Vector_R_t* vector);
 
+/**
+ * @brief Computes mean, variance, minimum and maximum of a real vector in one pass.
+ *
+ * The vector is read only once, which is faster than calling \ref ifx_vec_mean_r,
+ * \ref ifx_vec_var_r, \ref ifx_vec_min_idx_r and \ref ifx_vec_max_idx_r one after
+ * the other. The sums are accumulated relative to the first element, so a
+ * large offset does not cost precision in the variance. NaN values are never
+ * taken as minimum or maximum unless they are the first element.
+ *
+ * @param [in]     vector    Pointer to data memory defined by \ref ifx_Vector_R_t
+ *                           with at least one element.
+ * @param [out]    stats     Statistics of the vector.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_vec_stats_r(const ifx_Vector_R_t* vector, ifx_Stats_R_t* stats);
+
 /**
  * @brief Finds local maxima with at least threshold value,
  *        and returns the indices at which the peaks occur.
@@ -1043,6 +1073,30 @@ uint32_t ifx_vec_local_maxima(const ifx_Vector_R_t* vector,
                               uint32_t num_maxima,
                               uint32_t* maxima_idxs);
 
+/**
+ * @brief Finds the indices of the k largest (or smallest) elements.
+ *
+ * The indices are written to indices ordered from the largest to the
+ * smallest value for \ref IFX_SORT_DESCENDING, and from the smallest to the
+ * largest value for \ref IFX_SORT_ASCENDING. Equal values are ordered by
+ * their index. Only the k selected elements are sorted, so the function
+ * costs O(n log k) instead of O(n log n) for sorting the whole vector.
+ *
+ * @param [in]     vector              Pointer to data memory defined by \ref ifx_Vector_R_t.
+ * @param [in]     k                   Max number of indices to find.
+ * @param [in]     order               \ref IFX_SORT_DESCENDING for the largest values,
+ *                                     \ref IFX_SORT_ASCENDING for the smallest values.
+ * @param [out]    indices             Pointer to an array of at least k indices.
+ *
+ * @return Number of indices found, the minimum of k and the length of vector.
+ *
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_vec_topk_r(const ifx_Vector_R_t* vector,
+                        uint32_t k,
+                        ifx_Vector_Sort_Order_t order,
+                        uint32_t* indices);
+
 
 /**
  * @brief Clears all elements of real vector defined by \ref ifx_Vector_R_t.
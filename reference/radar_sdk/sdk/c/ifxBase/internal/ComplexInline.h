@@ -0,0 +1,131 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_COMPLEX_INLINE_INTERNAL_H
+#define IFX_BASE_COMPLEX_INLINE_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../Complex.h"
+#include "../Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+ * Inline versions of the elementary functions of Complex.h for the loops of
+ * the SDK. The exported functions live in another translation unit, so each
+ * call in a loop is a real call that keeps the compiler from vectorizing it.
+ * The exported functions are implemented with these, so both give identical
+ * results.
+ */
+
+/** @brief a + b, see \ref ifx_complex_add */
+static inline ifx_Complex_t ifx_cadd(ifx_Complex_t a, ifx_Complex_t b)
+{
+    ifx_Complex_t result;
+    IFX_COMPLEX_SET(result, IFX_COMPLEX_REAL(a) + IFX_COMPLEX_REAL(b), IFX_COMPLEX_IMAG(a) + IFX_COMPLEX_IMAG(b));
+    return result;
+}
+
+/** @brief a - b, see \ref ifx_complex_sub */
+static inline ifx_Complex_t ifx_csub(ifx_Complex_t a, ifx_Complex_t b)
+{
+    ifx_Complex_t result;
+    IFX_COMPLEX_SET(result, IFX_COMPLEX_REAL(a) - IFX_COMPLEX_REAL(b), IFX_COMPLEX_IMAG(a) - IFX_COMPLEX_IMAG(b));
+    return result;
+}
+
+/** @brief a * b, see \ref ifx_complex_mul */
+static inline ifx_Complex_t ifx_cmul(ifx_Complex_t a, ifx_Complex_t b)
+{
+    const ifx_Float_t ar = IFX_COMPLEX_REAL(a);
+    const ifx_Float_t ai = IFX_COMPLEX_IMAG(a);
+    const ifx_Float_t br = IFX_COMPLEX_REAL(b);
+    const ifx_Float_t bi = IFX_COMPLEX_IMAG(b);
+
+    ifx_Complex_t result;
+    IFX_COMPLEX_SET(result, ar * br - ai * bi, ar * bi + ai * br);
+    return result;
+}
+
+/** @brief Complex conjugate of z, see \ref ifx_complex_conj */
+static inline ifx_Complex_t ifx_cconj(ifx_Complex_t z)
+{
+    ifx_Complex_t result;
+    IFX_COMPLEX_SET(result, IFX_COMPLEX_REAL(z), -IFX_COMPLEX_IMAG(z));
+    return result;
+}
+
+/** @brief Squared norm |z|^2, see \ref ifx_complex_sqnorm */
+static inline ifx_Float_t ifx_cabs2(ifx_Complex_t z)
+{
+    return IFX_COMPLEX_REAL(z) * IFX_COMPLEX_REAL(z) + IFX_COMPLEX_IMAG(z) * IFX_COMPLEX_IMAG(z);
+}
+
+/** @brief z * s with a real s, see \ref ifx_complex_mul_real */
+static inline ifx_Complex_t ifx_cscale(ifx_Complex_t z, ifx_Float_t s)
+{
+    ifx_Complex_t result;
+    IFX_COMPLEX_SET(result, IFX_COMPLEX_REAL(z) * s, IFX_COMPLEX_IMAG(z) * s);
+    return result;
+}
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_COMPLEX_INLINE_INTERNAL_H */
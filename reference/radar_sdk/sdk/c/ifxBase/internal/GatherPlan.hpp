@@ -0,0 +1,298 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_GATHER_PLAN_HPP
+#define IFX_BASE_GATHER_PLAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ifxBase/Types.h"
+#include "ifxBase/internal/Simd.h"
+
+#if !defined(IFX_SSE2) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ifx {
+
+namespace detail {
+
+/* Copies length samples of num_rows interleaved rows (row r of sample i is
+ * src[i * num_rows + r]) into one contiguous destination per row.
+ */
+template <uint32_t num_rows>
+inline void deinterleave_rows(const ifx_Float_t* src, uint32_t length, ifx_Float_t* const* rows)
+{
+    uint32_t sample = 0;
+
+#if defined(IFX_SSE2)
+    // transpose blocks of 4 samples
+    for (; sample + 4 <= length; sample += 4, src += 4 * num_rows)
+    {
+        if constexpr (num_rows == 2)
+        {
+            const vf32x4 a = vf32x4_loadu(src);
+            const vf32x4 b = vf32x4_loadu(src + 4);
+            _mm_storeu_ps(rows[0] + sample, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(rows[1] + sample, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+        else if constexpr (num_rows == 3)
+        {
+            // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+            const vf32x4 a = vf32x4_loadu(src);
+            const vf32x4 b = vf32x4_loadu(src + 4);
+            const vf32x4 c = vf32x4_loadu(src + 8);
+            const vf32x4 x = _mm_shuffle_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+            const vf32x4 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            const vf32x4 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+            _mm_storeu_ps(rows[0] + sample, x);
+            _mm_storeu_ps(rows[1] + sample, y);
+            _mm_storeu_ps(rows[2] + sample, z);
+        }
+        else if constexpr (num_rows == 4)
+        {
+            vf32x4 a = vf32x4_loadu(src);
+            vf32x4 b = vf32x4_loadu(src + 4);
+            vf32x4 c = vf32x4_loadu(src + 8);
+            vf32x4 d = vf32x4_loadu(src + 12);
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_storeu_ps(rows[0] + sample, a);
+            _mm_storeu_ps(rows[1] + sample, b);
+            _mm_storeu_ps(rows[2] + sample, c);
+            _mm_storeu_ps(rows[3] + sample, d);
+        }
+        else
+        {
+            break;
+        }
+    }
+#elif defined(__ARM_NEON)
+    // the structure loads deinterleave blocks of 4 samples
+    for (; sample + 4 <= length; sample += 4, src += 4 * num_rows)
+    {
+        if constexpr (num_rows == 2)
+        {
+            const float32x4x2_t v = vld2q_f32(src);
+            vst1q_f32(rows[0] + sample, v.val[0]);
+            vst1q_f32(rows[1] + sample, v.val[1]);
+        }
+        else if constexpr (num_rows == 3)
+        {
+            const float32x4x3_t v = vld3q_f32(src);
+            vst1q_f32(rows[0] + sample, v.val[0]);
+            vst1q_f32(rows[1] + sample, v.val[1]);
+            vst1q_f32(rows[2] + sample, v.val[2]);
+        }
+        else if constexpr (num_rows == 4)
+        {
+            const float32x4x4_t v = vld4q_f32(src);
+            vst1q_f32(rows[0] + sample, v.val[0]);
+            vst1q_f32(rows[1] + sample, v.val[1]);
+            vst1q_f32(rows[2] + sample, v.val[2]);
+            vst1q_f32(rows[3] + sample, v.val[3]);
+        }
+        else
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; sample < length; sample++, src += num_rows)
+    {
+        for (uint32_t r = 0; r < num_rows; r++)
+        {
+            rows[r][sample] = src[r];
+        }
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Precomputed copy of interleaved sample blocks to their destinations
+ *
+ * Radar data arrives with the antennas of a chirp interleaved sample by
+ * sample, and frames are made of chirps with a layout that is fixed once the
+ * acquisition is configured. A gather plan stores this layout as a list of
+ * blocks: block b holds length samples of rows interleaved rows starting at
+ * src_offset, and row r is written contiguously to dst_offset(b, r).
+ *
+ * Blocks of up to 4 rows are transposed with SSE2 or NEON, single rows are
+ * copied with memcpy. optimize() merges single row blocks that continue each
+ * other in source and destination, so e.g. the chirps of a single antenna
+ * frame become one copy.
+ *
+ * Building a plan allocates; running it does not.
+ */
+class GatherPlan
+{
+public:
+    /// Removes all blocks.
+    void clear()
+    {
+        m_blocks.clear();
+        m_dst.clear();
+    }
+
+    bool empty() const
+    {
+        return m_blocks.empty();
+    }
+
+    size_t num_blocks() const
+    {
+        return m_blocks.size();
+    }
+
+    /// Appends a block, the destinations of its rows are 0 until set. Returns the index of the block.
+    size_t add_block(size_t src_offset, uint32_t rows, uint32_t length)
+    {
+        m_blocks.push_back({src_offset, m_dst.size(), rows, length});
+        m_dst.resize(m_dst.size() + rows, 0);
+        return m_blocks.size() - 1;
+    }
+
+    /// Sets the destination offset of a row of a block.
+    void set_destination(size_t block, uint32_t row, size_t dst_offset)
+    {
+        m_dst[m_blocks[block].first_dst + row] = dst_offset;
+    }
+
+    /// Merges consecutive single row blocks that continue each other in source and destination.
+    void optimize()
+    {
+        std::vector<Block> blocks;
+        std::vector<size_t> dst;
+        blocks.reserve(m_blocks.size());
+        dst.reserve(m_dst.size());
+
+        for (const auto& block : m_blocks)
+        {
+            if (block.rows == 1 && !blocks.empty())
+            {
+                auto& last = blocks.back();
+                if (last.rows == 1
+                    && last.src + last.length == block.src
+                    && dst[last.first_dst] + last.length == m_dst[block.first_dst]
+                    && uint64_t(last.length) + block.length <= UINT32_MAX)
+                {
+                    last.length += block.length;
+                    continue;
+                }
+            }
+
+            blocks.push_back({block.src, dst.size(), block.rows, block.length});
+            dst.insert(dst.end(), m_dst.begin() + block.first_dst, m_dst.begin() + block.first_dst + block.rows);
+        }
+
+        m_blocks.swap(blocks);
+        m_dst.swap(dst);
+    }
+
+    /**
+     * @brief Copies the blocks from src to dst.
+     *
+     * Destination samples at offsets of dst_length or more are not written.
+     */
+    void run(const ifx_Float_t* src, ifx_Float_t* dst, size_t dst_length = SIZE_MAX) const
+    {
+        constexpr uint32_t max_simd_rows = 4;
+        ifx_Float_t* rows[max_simd_rows];
+
+        for (const auto& block : m_blocks)
+        {
+            const ifx_Float_t* in = src + block.src;
+            const size_t* offsets = &m_dst[block.first_dst];
+
+            size_t end = 0;
+            for (uint32_t r = 0; r < block.rows; r++)
+                end = std::max(end, offsets[r] + block.length);
+
+            if (end > dst_length)
+            {
+                // only a part of the block fits into the destination
+                for (uint32_t r = 0; r < block.rows; r++)
+                    for (uint32_t i = 0; i < block.length && offsets[r] + i < dst_length; i++)
+                        dst[offsets[r] + i] = in[size_t(i) * block.rows + r];
+                continue;
+            }
+
+            if (block.rows <= max_simd_rows)
+            {
+                for (uint32_t r = 0; r < block.rows; r++)
+                    rows[r] = dst + offsets[r];
+            }
+
+            switch (block.rows)
+            {
+                case 1:
+                    std::memcpy(dst + offsets[0], in, block.length * sizeof(ifx_Float_t));
+                    break;
+                case 2:
+                    detail::deinterleave_rows<2>(in, block.length, rows);
+                    break;
+                case 3:
+                    detail::deinterleave_rows<3>(in, block.length, rows);
+                    break;
+                case 4:
+                    detail::deinterleave_rows<4>(in, block.length, rows);
+                    break;
+                default:
+                    for (uint32_t r = 0; r < block.rows; r++)
+                    {
+                        ifx_Float_t* out = dst + offsets[r];
+                        for (uint32_t i = 0; i < block.length; i++)
+                            out[i] = in[size_t(i) * block.rows + r];
+                    }
+                    break;
+            }
+        }
+    }
+
+private:
+    struct Block
+    {
+        size_t src;        // offset of the first sample in the source
+        size_t first_dst;  // index of the destination offset of row 0 in m_dst
+        uint32_t rows;     // number of interleaved rows
+        uint32_t length;   // samples per row
+    };
+
+    std::vector<Block> m_blocks;
+    std::vector<size_t> m_dst;
+};
+
+}  // namespace ifx
+
+#endif  // IFX_BASE_GATHER_PLAN_HPP
@@ -0,0 +1,178 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_HANDLE_CACHE_INTERNAL_H
+#define IFX_BASE_HANDLE_CACHE_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "../Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+// Maximum number of released handles a cache holds
+#define IFX_HANDLE_CACHE_CAPACITY 8
+
+#if defined(_WIN32)
+#define IFX_HANDLE_CACHE_LOCK_INIT SRWLOCK_INIT
+#else
+#define IFX_HANDLE_CACHE_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#endif
+
+/**
+ * @brief Static initializer of a handle cache.
+ *
+ * @param config_type   Type of the configuration the handles are created from.
+ * @param equal         Returns true if two configurations create equal handles.
+ * @param destroy       Destroys a handle.
+ */
+#define IFX_HANDLE_CACHE_INIT(config_type, equal, destroy) \
+    {sizeof(config_type), (equal), (destroy), NULL, {0, 0, 0, 0, 0}, IFX_HANDLE_CACHE_LOCK_INIT}
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct ifx_Handle_Cache_Entry_s ifx_Handle_Cache_Entry_t;
+
+/**
+ * @brief Pool of released handles keyed by the configuration they were
+ *        created from.
+ *
+ * Used by the acquire and release functions of modules whose handles are
+ * expensive to create, e.g. \ref ifx_rdm_acquire. The module resets a handle
+ * to the state after creation before releasing it to the cache.
+ */
+typedef struct
+{
+    size_t config_size;                              /**< Size of the configuration in bytes.*/
+    bool (*equal)(const void* lhs, const void* rhs); /**< Compares two configurations.*/
+    void (*destroy)(void* handle);                   /**< Destroys a handle.*/
+    ifx_Handle_Cache_Entry_t* entries;               /**< Released handles.*/
+    ifx_Handle_Cache_Stats_t stats;                  /**< Statistics of the cache.*/
+#if defined(_WIN32)
+    SRWLOCK lock; /**< Lock protecting entries and stats.*/
+#else
+    pthread_mutex_t lock; /**< Lock protecting entries and stats.*/
+#endif
+} ifx_Handle_Cache_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Returns a monotonic time stamp in nanoseconds.
+ */
+IFX_DLL_PUBLIC
+uint64_t ifx_handle_cache_now_ns(void);
+
+/**
+ * @brief Takes a released handle with an equal configuration from the cache.
+ *
+ * @param [in]  cache    Handle cache.
+ * @param [in]  config   Configuration of the requested handle.
+ * @retval      handle   Handle removed from the cache
+ * @retval      NULL     if no handle matches (counted as miss)
+ */
+IFX_DLL_PUBLIC
+void* ifx_handle_cache_take(ifx_Handle_Cache_t* cache, const void* config);
+
+/**
+ * @brief Puts a released handle into the cache.
+ *
+ * If the cache is full, the oldest handle in it is destroyed.
+ *
+ * @param [in]  cache    Handle cache.
+ * @param [in]  config   Configuration handle was created from.
+ * @param [in]  handle   Handle in the state after creation.
+ */
+IFX_DLL_PUBLIC
+void ifx_handle_cache_put(ifx_Handle_Cache_t* cache, const void* config, void* handle);
+
+/**
+ * @brief Records the duration of an acquire.
+ *
+ * @param [in]  cache    Handle cache.
+ * @param [in]  start_ns Time stamp of \ref ifx_handle_cache_now_ns taken at
+ *                       the beginning of the acquire.
+ */
+IFX_DLL_PUBLIC
+void ifx_handle_cache_record(ifx_Handle_Cache_t* cache, uint64_t start_ns);
+
+/**
+ * @brief Destroys all handles in the cache.
+ *
+ * @param [in]  cache    Handle cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_handle_cache_clear(ifx_Handle_Cache_t* cache);
+
+/**
+ * @brief Copies the statistics of the cache.
+ *
+ * @param [in]  cache    Handle cache.
+ * @param [out] stats    Statistics.
+ */
+IFX_DLL_PUBLIC
+void ifx_handle_cache_get_stats(ifx_Handle_Cache_t* cache, ifx_Handle_Cache_Stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IFX_BASE_HANDLE_CACHE_INTERNAL_H
@@ -0,0 +1,259 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_INLINE_LIST_HPP
+#define IFX_BASE_INLINE_LIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace ifx {
+
+/**
+ * @brief Contiguous list with inline storage
+ *
+ * The first N elements are stored inside the object itself, so small lists
+ * (like the boards found during enumeration) are built without any heap
+ * allocation. If more than N elements are pushed, all elements are moved to
+ * a single heap block that grows geometrically.
+ *
+ * Elements are always stored contiguously, so data() can be handed to C
+ * code as an array. Only trivially copyable types are supported.
+ *
+ * Like std::vector, push_back throws std::bad_alloc if memory allocation
+ * fails.
+ */
+template <class T, size_t N>
+class InlineList
+{
+    static_assert(std::is_trivially_copyable<T>::value, "InlineList requires a trivially copyable type");
+    static_assert(N > 0, "InlineList requires inline storage for at least one element");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InlineList() = default;
+
+    InlineList(const InlineList& other)
+    {
+        assign(other.data(), other.size());
+    }
+
+    InlineList(InlineList&& other) noexcept
+    {
+        steal(other);
+    }
+
+    InlineList& operator=(const InlineList& other)
+    {
+        if (this != &other)
+        {
+            m_size = 0;
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+
+    InlineList& operator=(InlineList&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~InlineList()
+    {
+        release();
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    size_t capacity() const
+    {
+        return m_capacity;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /// true if the elements are still stored inside the object
+    bool is_inline() const
+    {
+        return m_heap == nullptr;
+    }
+
+    T* data()
+    {
+        return m_heap ? m_heap : m_inline;
+    }
+
+    const T* data() const
+    {
+        return m_heap ? m_heap : m_inline;
+    }
+
+    T& operator[](size_t index)
+    {
+        return data()[index];
+    }
+
+    const T& operator[](size_t index) const
+    {
+        return data()[index];
+    }
+
+    iterator begin()
+    {
+        return data();
+    }
+
+    iterator end()
+    {
+        return data() + m_size;
+    }
+
+    const_iterator begin() const
+    {
+        return data();
+    }
+
+    const_iterator end() const
+    {
+        return data() + m_size;
+    }
+
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    void reserve(size_t capacity)
+    {
+        if (capacity <= m_capacity)
+            return;
+
+        T* block = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+        if (!block)
+            throw std::bad_alloc();
+
+        if (m_size)
+            std::memcpy(block, data(), m_size * sizeof(T));
+        std::free(m_heap);
+        m_heap = block;
+        m_capacity = capacity;
+    }
+
+    void push_back(const T& elem)
+    {
+        if (m_size == m_capacity)
+            reserve(2 * m_capacity);
+
+        data()[m_size++] = elem;
+    }
+
+    /**
+     * @brief Copy elements to a caller-provided array
+     *
+     * Copies at most count elements to dst and returns the total number of
+     * elements in the list. If the return value is larger than count, the
+     * array was too small and the result has been truncated. dst may be
+     * NULL if count is 0, which allows to query the required size.
+     *
+     * @param [out] dst     destination array
+     * @param [in]  count   number of elements dst can hold
+     * @retval  total number of elements in the list
+     */
+    size_t copy_to(T* dst, size_t count) const
+    {
+        const size_t n = std::min(count, m_size);
+        if (n)
+            std::memcpy(dst, data(), n * sizeof(T));
+        return m_size;
+    }
+
+private:
+    void assign(const T* elems, size_t count)
+    {
+        reserve(count);
+        if (count)
+            std::memcpy(data(), elems, count * sizeof(T));
+        m_size = count;
+    }
+
+    void steal(InlineList& other)
+    {
+        if (other.m_heap)
+        {
+            m_heap = other.m_heap;
+            m_capacity = other.m_capacity;
+            m_size = other.m_size;
+            other.m_heap = nullptr;
+            other.m_capacity = N;
+        }
+        else
+        {
+            m_heap = nullptr;
+            m_capacity = N;
+            m_size = other.m_size;
+            std::memcpy(m_inline, other.m_inline, m_size * sizeof(T));
+        }
+        other.m_size = 0;
+    }
+
+    void release()
+    {
+        std::free(m_heap);
+        m_heap = nullptr;
+        m_capacity = N;
+        m_size = 0;
+    }
+
+    T m_inline[N];
+    T* m_heap = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = N;
+};
+
+}  // namespace ifx
+
+#endif /* IFX_BASE_INLINE_LIST_HPP */
@@ -0,0 +1,178 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_KERNELS_INTERNAL_H
+#define IFX_BASE_KERNELS_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stddef.h>
+
+#include "../Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/** Order of the polynomial approximating log2 of the mantissa in the
+ * spectrum kernels (2 to 7). Each order more divides the error of
+ * 10*log10 by about 7, from 1.7e-2 dB for order 2 to 4.4e-5 dB for order 5.
+ * From order 6 on the rounding of the result (about 2e-5 dB at 150 dB)
+ * dominates.
+ */
+#ifndef IFX_KERNELS_LOG2_ORDER
+#define IFX_KERNELS_LOG2_ORDER 5
+#endif
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Element-wise kernels on contiguous arrays
+ *
+ * The kernels are the fast paths of the corresponding vector and matrix
+ * functions (e.g. mac_c for \ref ifx_vec_mac_c and \ref ifx_mat_mac_c). The
+ * arrays of the element-wise kernels hold len elements without gaps. The output may be identical to one
+ * of the inputs, but must not overlap them partially.
+ *
+ * abs_c computes sqrt(re^2+im^2) instead of hypot, so it may overflow for
+ * values above about 1e19.
+ */
+typedef struct
+{
+    const char* name; /**< Name of the instruction set, e.g. "avx2" */
+
+    void (*mul_r)(const ifx_Float_t* x, const ifx_Float_t* y, ifx_Float_t* out, size_t len);
+    void (*mul_c)(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t* out, size_t len);
+    void (*scale_c)(const ifx_Complex_t* x, ifx_Complex_t scale, ifx_Complex_t* out, size_t len);
+    void (*mac_c)(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Complex_t scale, ifx_Complex_t* out, size_t len); /**< out = x + y*scale */
+    void (*abs_c)(const ifx_Complex_t* x, ifx_Float_t* out, size_t len);
+    void (*abs2_c)(const ifx_Complex_t* x, ifx_Float_t* out, size_t len);
+
+    /** c = a * b with the m x k matrix a, the k x n matrix b and the m x n
+     * matrix c stored row by row with lda, ldb and ldc elements between the
+     * rows. The kernel is meant for small k and n, b should fit into the
+     * cache. c must not overlap a or b.
+     */
+    void (*gemm_c)(const ifx_Complex_t* a, size_t lda, const ifx_Complex_t* b, size_t ldb,
+                   ifx_Complex_t* c, size_t ldc, size_t m, size_t n, size_t k);
+
+    /** MTI filter step: out = x - history, history = alpha*x + (1-alpha)*history.
+     * Complex arrays are passed as 2*len floats. out may be identical to x.
+     */
+    void (*mti_r)(const ifx_Float_t* x, ifx_Float_t* history, ifx_Float_t* out, ifx_Float_t alpha, size_t len);
+
+    /** Second-order section step (transposed direct form II) on len channels:
+     * out = b0*x + z1, z1 = b1*x - a1*out + z2, z2 = b2*x - a2*out with
+     * coeffs = {b0, b1, b2, a1, a2}. out may be identical to x.
+     */
+    void (*biquad_r)(const ifx_Float_t* x, ifx_Float_t* out, ifx_Float_t* z1, ifx_Float_t* z2, const ifx_Float_t* coeffs, size_t len);
+
+    /** Conversion to half precision with rounding to nearest even. Values
+     * beyond the half precision range become infinity, NaN stays NaN.
+     */
+    void (*to_f16)(const ifx_Float_t* x, ifx_Float16_t* out, size_t len);
+    void (*from_f16)(const ifx_Float16_t* x, ifx_Float_t* out, size_t len); /**< Exact conversion from half precision */
+
+    /** Peak candidates with two neighbours on each side: bit j%32 of
+     * mask[j/32] is set if x[j+2] >= threshold, x[j+2] >= x[j], x[j+2] >= x[j+1],
+     * x[j+2] > x[j+3] and x[j+2] > x[j+4]. x holds len+4 elements, mask
+     * (len+31)/32 words. Comparisons with NaN are false.
+     */
+    void (*peaks_r)(const ifx_Float_t* x, ifx_Float_t threshold, uint32_t* mask, size_t len);
+
+    /** Phase monopulse: out = asin(gain * arg(x*conj(y))) in degrees with the
+     * phase difference in (-pi, pi]. atan2 and asin are approximated with
+     * polynomials, the phase difference has an error below 2e-6 rad, asin an
+     * error below 2e-7. out is NaN if the argument of asin is beyond [-1, 1].
+     */
+    void (*monopulse_c)(const ifx_Complex_t* x, const ifx_Complex_t* y, ifx_Float_t gain, ifx_Float_t* out, size_t len);
+
+    /** Amplitude spectrum from squared norms: out = clip if abs2 < threshold2,
+     * otherwise sqrt(abs2) for scale 0 and scale*log10(abs2) else (scale 10
+     * gives dB of the amplitude). log10 is approximated with a polynomial of
+     * the mantissa, see IFX_KERNELS_LOG2_ORDER; the default order has an
+     * error below 1e-4 dB. abs2 must be finite.
+     */
+    void (*spectrum_r)(const ifx_Float_t* abs2, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len);
+    void (*spectrum_c)(const ifx_Complex_t* x, ifx_Float_t threshold2, ifx_Float_t clip, ifx_Float_t scale, ifx_Float_t* out, size_t len); /**< spectrum_r of the squared norms of x */
+
+    /** Statistics in one pass, x[j] has the index first+j: sums[0] and
+     * sums[1] are incremented by the sums of x-shift and (x-shift)^2.
+     * range[0] and idx[0] are replaced by the smallest element below
+     * range[0] and its index, range[1] and idx[1] by the largest element
+     * above range[1]; of equal elements the first one is taken. Comparisons
+     * with NaN are false. The sums are kept in float for blocks of 1024
+     * elements and added up in double; a shift close to the mean avoids
+     * the cancellation in the variance.
+     */
+    void (*stats_r)(const ifx_Float_t* x, ifx_Float_t shift, uint32_t first, double* sums, ifx_Float_t* range, uint32_t* idx, size_t len);
+} ifx_Kernels_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Get the kernels for the CPU
+ *
+ * On the first call the instruction sets supported by the CPU are detected
+ * and the fastest kernels are selected (AVX-512, AVX2 and SSE2 on x86, NEON
+ * on ARM). The environment variable IFX_SIMD selects a specific instruction
+ * set instead ("scalar", "sse2", "avx2", "avx512", "neon"); unknown or
+ * unsupported values are ignored. The AVX2 kernels also need FMA and F16C.
+ *
+ * @retval  kernels     kernels for the CPU, never NULL
+ */
+IFX_DLL_PUBLIC
+const ifx_Kernels_t* ifx_kernels_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IFX_BASE_KERNELS_INTERNAL_H
@@ -33,14 +33,16 @@
 #include "../Error.h"
 #include "../List.h"
 #include "../Mem.h"
+#include "InlineList.hpp"
 
+#include <type_traits>
 #include <vector>
 
 /**
  * @brief This template allows to create an ifx_List_t from a std::vector
  *
  * This template allows to convert a C++ std::vector into a \ref ifx_List_t
- * list.
+ * list. The elements are copied into a single block owned by the list.
  *
  * If memory allocation fails, the template returns NULL and a \ref IFX_ERROR_MEMORY_ALLOCATION_FAILED
  * error is set.
@@ -52,31 +54,28 @@
  * @return		list	list of type \ref ifx_List_t
  */
 template <class T>
-ifx_List_t* ifx_list_from_vector(std::vector<T> vector)
+ifx_List_t* ifx_list_from_vector(const std::vector<T>& vector)
 {
-    ifx_List_t* list = ifx_list_create(ifx_mem_free);
-    IFX_ERR_BRV_MEMALLOC(list, nullptr);
-
-    for (const auto& elem : vector)
-    {
-        auto* p = static_cast<T*>(ifx_mem_alloc(sizeof(T)));
-        if (!p)
-        {
-            ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
-            ifx_list_destroy(list);
-            return nullptr;
-        }
-
-        *p = elem;
-
-        if (!ifx_list_push_back(list, p))
-        {
-            ifx_list_destroy(list);
-            return nullptr;
-        }
-    }
+    static_assert(std::is_trivially_copyable<T>::value, "list elements are copied bytewise");
+    return ifx_list_create_from_array(vector.data(), vector.size(), sizeof(T));
+}
 
-    return list;
+/**
+ * @brief This template allows to create an ifx_List_t from an InlineList
+ *
+ * All elements are copied into a single block owned by the returned list
+ * (see \ref ifx_list_create_from_array).
+ *
+ * The caller is responsible to free the memory of the returned list by calling
+ * \ref ifx_list_destroy.
+ *
+ * @param [in]  list	an ifx::InlineList
+ * @return		list	list of type \ref ifx_List_t
+ */
+template <class T, size_t N>
+ifx_List_t* ifx_list_from_vector(const ifx::InlineList<T, N>& list)
+{
+    return ifx_list_create_from_array(list.data(), list.size(), sizeof(T));
 }
 
 #endif /* IFX_BASE_LIST_HPP */
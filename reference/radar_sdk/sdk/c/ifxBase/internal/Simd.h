@@ -55,6 +55,73 @@
 #define vf32x4_max(v, u)      _mm_max_ps(v, u)
 #define vf32x4_rsqrt(v)       _mm_rsqrt_ps(v)
 
+// ARMv8 (AArch64) always has NEON. On 32 bit ARM it depends on the compiler flags.
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#include <arm_neon.h>
+
+#define IFX_NEON
+
+#define vf32x4                     float32x4_t
+#define vf32x4_set(e3, e2, e1, e0) ((float32x4_t) {(e0), (e1), (e2), (e3)})
+#define vf32x4_set1(e)             vdupq_n_f32(e)
+#define vf32x4_setzero()           vdupq_n_f32(0.0f)
+#define vf32x4_stor(addr, v)       vst1q_f32((addr), (v))
+#define vf32x4_load(addr)          vld1q_f32((addr))
+#define vf32x4_loadu(addr)         vld1q_f32((addr))
+
+#define vf32x4_load1(addr)    vld1q_dup_f32((addr))
+#define vf32x4_extract1(v, i) vgetq_lane_f32((v), (i))
+#define vf32x4_mul(v, u)      vmulq_f32(v, u)
+#define vf32x4_add(v, u)      vaddq_f32(v, u)
+#define vf32x4_sub(v, u)      vsubq_f32(v, u)
+#define vf32x4_mla(v, u, w)   vmlaq_f32(v, u, w)  // v + (u * w)
+#define vf32x4_mls(v, u, w)   vmlsq_f32(v, u, w)  // v - (u * w)
+#define vf32x4_max(v, u)      vmaxq_f32(v, u)
+#define vf32x4_rsqrt(v)       vrsqrteq_f32(v)
+
+#endif
+
+// AVX2 and AVX-512 are not part of the x86-64 baseline. Functions using them
+// are compiled for the instruction set with IFX_TARGET_AVX2 or
+// IFX_TARGET_AVX512 and must only be called after checking the CPU at
+// runtime (see internal/Kernels.h). MSVC accepts the intrinsics without any
+// target attribute.
+#if defined(IFX_SSE2) && (defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+#define IFX_X86_DISPATCH
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define IFX_TARGET_AVX2
+#define IFX_TARGET_AVX512
+#else
+#define IFX_TARGET_AVX2   __attribute__((target("avx2,fma,f16c")))
+#define IFX_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+#define vf32x8                 __m256
+#define vf32x8_set1(e)         _mm256_set1_ps(e)
+#define vf32x8_setzero()       _mm256_setzero_ps()
+#define vf32x8_loadu(addr)     _mm256_loadu_ps((addr))
+#define vf32x8_storu(addr, v)  _mm256_storeu_ps((addr), (v))
+#define vf32x8_mul(v, u)       _mm256_mul_ps(v, u)
+#define vf32x8_add(v, u)       _mm256_add_ps(v, u)
+#define vf32x8_sub(v, u)       _mm256_sub_ps(v, u)
+#define vf32x8_mla(v, u, w)    _mm256_fmadd_ps(u, w, v)   // v + (u * w)
+#define vf32x8_mls(v, u, w)    _mm256_fnmadd_ps(u, w, v)  // v - (u * w)
+#define vf32x8_sqrt(v)         _mm256_sqrt_ps(v)
+
+#define vf32x16                __m512
+#define vf32x16_set1(e)        _mm512_set1_ps(e)
+#define vf32x16_loadu(addr)    _mm512_loadu_ps((addr))
+#define vf32x16_storu(addr, v) _mm512_storeu_ps((addr), (v))
+#define vf32x16_mul(v, u)      _mm512_mul_ps(v, u)
+#define vf32x16_add(v, u)      _mm512_add_ps(v, u)
+#define vf32x16_sub(v, u)      _mm512_sub_ps(v, u)
+#define vf32x16_mla(v, u, w)   _mm512_fmadd_ps(u, w, v)   // v + (u * w)
+#define vf32x16_mls(v, u, w)   _mm512_fnmadd_ps(u, w, v)  // v - (u * w)
+#define vf32x16_sqrt(v)        _mm512_sqrt_ps(v)
+
 #endif
 
 #endif  // IFX_SIMD_H
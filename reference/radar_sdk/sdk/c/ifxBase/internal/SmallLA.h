@@ -0,0 +1,107 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_BASE_SMALL_LA_INTERNAL_H
+#define IFX_BASE_SMALL_LA_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../Matrix.h"
+#include "../Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/**
+ * @brief Largest dimension handled by the fixed size kernels
+ */
+#define IFX_LA_SMALL_MAX_DIM 8
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/*
+ * The functions below are the fixed size counterparts of ifx_la_invert_r,
+ * ifx_la_invert_c, ifx_la_cholesky_r, ifx_la_cholesky_c,
+ * ifx_la_determinant_r and ifx_la_determinant_c. They are instantiated for
+ * every dimension up to IFX_LA_SMALL_MAX_DIM, so the loops are unrolled and
+ * the matrix is kept in registers instead of being accessed with
+ * IFX_MAT_AT. The arguments must have been checked by the caller.
+ *
+ * Each function returns false without touching its outputs if the
+ * dimension is larger than IFX_LA_SMALL_MAX_DIM.
+ */
+
+bool ifx_la_small_invert_r(const ifx_Matrix_R_t* A,
+                           ifx_Matrix_R_t* Ainv);
+
+bool ifx_la_small_invert_c(const ifx_Matrix_C_t* A,
+                           ifx_Matrix_C_t* Ainv);
+
+bool ifx_la_small_cholesky_r(const ifx_Matrix_R_t* A,
+                             ifx_Matrix_R_t* L);
+
+bool ifx_la_small_cholesky_c(const ifx_Matrix_C_t* A,
+                             ifx_Matrix_C_t* L);
+
+bool ifx_la_small_determinant_r(const ifx_Matrix_R_t* A,
+                                ifx_Float_t* determinant);
+
+bool ifx_la_small_determinant_c(const ifx_Matrix_C_t* A,
+                                ifx_Complex_t* determinant);
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_BASE_SMALL_LA_INTERNAL_H */
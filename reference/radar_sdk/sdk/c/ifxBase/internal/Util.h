@@ -89,6 +89,17 @@ char* ifx_util_strdup(const char* orig);
 IFX_DLL_PUBLIC
 uint32_t ifx_util_popcount(uint32_t mask);
 
+/*
+ * @brief Configure the calling thread as a processing worker
+ *
+ * Names the thread and applies the process wide scheduling settings of
+ * processing threads, see ifx_fmcw_set_thread_config.
+ *
+ * @param [in]	name	short name of the thread
+ */
+IFX_DLL_PUBLIC
+void ifx_util_configure_worker_thread(const char* name);
+
 
 #ifdef __cplusplus
 }  // extern "C"
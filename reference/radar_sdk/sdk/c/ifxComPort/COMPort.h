@@ -68,8 +68,20 @@ extern "C"
 
 #define IFX_COMPORT_BAUDRATE_DEFAULT 115200
 
+/** Read size of \ref ifx_comport_start_reader if none is given. */
+#define IFX_COMPORT_READER_BUFFER_DEFAULT (64 * 1024)
+
 typedef struct com_s com_t;
 
+/**
+ * \brief Receives the data read by \ref ifx_comport_start_reader.
+ *
+ * Called on the reader thread. data is only valid during the call. A call
+ * with num_bytes equal to 0 reports that the port failed, e.g. because the
+ * device was unplugged; no further calls follow.
+ */
+typedef void (*ifx_comport_data_callback_t)(void* context, const uint8_t* data, size_t num_bytes);
+
 /** @addtogroup gr_cat_SDK_comport
  * @{
  */
@@ -150,9 +162,11 @@ size_t ifx_comport_send_data(com_t* com_port, const void* data, size_t num_bytes
  * \brief This function reads data from an open COM port.
  *
  * The function tries to read the specified number of bytes from an open COM
- * port and stores them in the provided buffer. The function waits for the
- * data, but returns after an internally defined timeout period and returns
- * the number of received bytes.
+ * port and stores them in the provided buffer. It sleeps until data arrives
+ * (poll() on Linux and macOS, an overlapped read on Windows) and reads
+ * whatever the driver has buffered in one call. It returns when all bytes
+ * have been read or when no byte arrived for the timeout period (see
+ * \ref ifx_comport_set_timeout), and returns the number of received bytes.
  *
  * The function expects a handle to an opened COM port that have been returned
  * by \ref ifx_comport_open.
@@ -183,6 +197,36 @@ size_t ifx_comport_get_data(com_t* com_port, void* data, size_t num_requested_by
  */
 void ifx_comport_set_timeout(com_t* com_port, uint32_t timeout_period_ms);
 
+/**
+ * \brief This function starts delivering received data through a callback.
+ *
+ * A reader thread sleeps until data arrives and passes each chunk, up to
+ * buffer_size bytes, to callback as soon as it has been read. This avoids a
+ * thread per port blocked in \ref ifx_comport_get_data. While the reader runs,
+ * \ref ifx_comport_get_data must not be called; \ref ifx_comport_send_data
+ * may be.
+ *
+ * \param[in] com_port     The open COM port.
+ * \param[in] callback     The function called with the received data.
+ * \param[in] context      Passed to callback unchanged.
+ * \param[in] buffer_size  Largest chunk per call in bytes, 0 for
+ *                         \ref IFX_COMPORT_READER_BUFFER_DEFAULT.
+ *
+ * \return true if the reader was started, false if it is already running
+ *         or could not be started.
+ */
+bool ifx_comport_start_reader(com_t* com_port, ifx_comport_data_callback_t callback, void* context, size_t buffer_size);
+
+/**
+ * \brief This function stops the reader started by \ref ifx_comport_start_reader.
+ *
+ * Returns after the last callback has returned. Must not be called from the
+ * callback. \ref ifx_comport_close stops the reader as well.
+ *
+ * \param[in] com_port  The open COM port.
+ */
+void ifx_comport_stop_reader(com_t* com_port);
+
 /* --- Close open blocks -------------------------------------------------- */
 
 /**
@@ -53,6 +53,8 @@
 #include <dirent.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -76,8 +78,88 @@ struct com_s
     int handle;                /**< The handle to the connection. */
     int32_t timeout_period_ms; /**< The period after that reading is stopped
                                     if no more data arrives. */
+
+    /* Reader thread of ifx_comport_start_reader */
+    bool reader_running;              /**< The reader thread exists. */
+    pthread_t reader_thread;          /**< The reader thread. */
+    int reader_wakeup[2];             /**< Pipe whose write end stops the reader. */
+    ifx_comport_data_callback_t reader_callback; /**< Receives the data. */
+    void* reader_context;             /**< Passed to reader_callback. */
+    uint8_t* reader_buffer;           /**< Buffer of the reader thread. */
+    size_t reader_buffer_size;        /**< Size of reader_buffer in bytes. */
 };
 
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static int64_t now_ms(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/* Sleeps until the port is readable, the timeout expires (returns 0) or the
+   port fails (returns -1). A negative timeout waits forever. */
+static int wait_readable(int handle, int timeout_ms)
+{
+    struct pollfd fd = {.fd = handle, .events = POLLIN, .revents = 0};
+
+    for (;;)
+    {
+        int ret = poll(&fd, 1, timeout_ms);
+        if (ret > 0)
+            return (fd.revents & POLLIN) ? 1 : -1;
+        if (ret == 0)
+            return 0;
+        if (errno != EINTR)
+            return -1;
+    }
+}
+
+static void* reader_main(void* arg)
+{
+    com_t* com_port = (com_t*)arg;
+    struct pollfd fds[2] = {
+        {.fd = com_port->handle, .events = POLLIN, .revents = 0},
+        {.fd = com_port->reader_wakeup[0], .events = POLLIN, .revents = 0},
+    };
+
+    for (;;)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        if (fds[1].revents != 0)
+            return NULL; /* stopped */
+
+        if (fds[0].revents == 0)
+            continue;
+
+        ssize_t num_bytes = read(com_port->handle, com_port->reader_buffer, com_port->reader_buffer_size);
+        if (num_bytes > 0)
+        {
+            com_port->reader_callback(com_port->reader_context, com_port->reader_buffer, (size_t)num_bytes);
+            continue;
+        }
+
+        /* Readable but nothing to read means hang-up. */
+        if ((num_bytes < 0) && ((errno == EINTR) || (errno == EAGAIN)))
+            continue;
+        break;
+    }
+
+    com_port->reader_callback(com_port->reader_context, NULL, 0);
+    return NULL;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -162,6 +244,7 @@ com_t* ifx_comport_open(const char* port_name, uint32_t baudrate)
      * don't wait for a connection. See open(2) ("man 2 open") for details.
      */
     com_port->handle = open(port_name, O_RDWR | O_NOCTTY);
+    com_port->reader_running = false;
 
     if (com_port->handle == -1)
         goto fail;
@@ -231,6 +314,8 @@ fail:
 
 void ifx_comport_close(com_t* com_port)
 {
+    ifx_comport_stop_reader(com_port);
+
     /* close COM port */
     close(com_port->handle);
 
@@ -249,33 +334,34 @@ size_t ifx_comport_get_data(com_t* com_port,
 {
     size_t num_received_bytes = 0;
     char* read_buffer = (char*)data;
-    struct timespec time_of_last_byte;
+    int64_t time_of_last_byte = now_ms();
 
-    /* read data */
-    clock_gettime(CLOCK_MONOTONIC, &time_of_last_byte);
+    /* The port is non-blocking (VMIN = VTIME = 0), so every read takes
+     * whatever the driver has buffered; in between the thread sleeps in
+     * poll() until more data arrives or the timeout expires.
+     */
     while (num_received_bytes < num_requested_bytes)
     {
         ssize_t num_bytes = read(com_port->handle,
                                  read_buffer + num_received_bytes,
                                  num_requested_bytes - num_received_bytes);
-        num_received_bytes += num_bytes;
-
-        /* check for timeout */
-        struct timespec current_time;
-        clock_gettime(CLOCK_MONOTONIC, &current_time);
-        if (num_bytes != 0)
-        {
-            time_of_last_byte = current_time;
-        }
-        else
+        if (num_bytes > 0)
         {
-            if ((current_time.tv_sec * 1000 + current_time.tv_nsec / 1000000) > (time_of_last_byte.tv_sec * 1000
-                                                                                 + time_of_last_byte.tv_nsec / 1000000
-                                                                                 + com_port->timeout_period_ms))
-            {
-                break;
-            }
+            num_received_bytes += (size_t)num_bytes;
+            time_of_last_byte = now_ms();
+            continue;
         }
+
+        if ((num_bytes < 0) && (errno != EINTR) && (errno != EAGAIN))
+            break;
+
+        /* check for timeout */
+        int64_t remaining_ms = time_of_last_byte + com_port->timeout_period_ms - now_ms();
+        if (remaining_ms <= 0)
+            break;
+
+        if (wait_readable(com_port->handle, (int)remaining_ms) <= 0)
+            break;
     }
     return num_received_bytes;
 }
@@ -285,6 +371,57 @@ void ifx_comport_set_timeout(com_t* com_port, uint32_t timeout_period_ms)
     com_port->timeout_period_ms = timeout_period_ms;
 }
 
+bool ifx_comport_start_reader(com_t* com_port, ifx_comport_data_callback_t callback, void* context, size_t buffer_size)
+{
+    if ((com_port == NULL) || (callback == NULL) || com_port->reader_running)
+        return false;
+
+    if (buffer_size == 0)
+        buffer_size = IFX_COMPORT_READER_BUFFER_DEFAULT;
+
+    com_port->reader_buffer = malloc(buffer_size);
+    if (com_port->reader_buffer == NULL)
+        return false;
+
+    if (pipe(com_port->reader_wakeup) != 0)
+    {
+        free(com_port->reader_buffer);
+        return false;
+    }
+
+    com_port->reader_buffer_size = buffer_size;
+    com_port->reader_callback = callback;
+    com_port->reader_context = context;
+
+    if (pthread_create(&com_port->reader_thread, NULL, reader_main, com_port) != 0)
+    {
+        close(com_port->reader_wakeup[0]);
+        close(com_port->reader_wakeup[1]);
+        free(com_port->reader_buffer);
+        return false;
+    }
+
+    com_port->reader_running = true;
+    return true;
+}
+
+void ifx_comport_stop_reader(com_t* com_port)
+{
+    if ((com_port == NULL) || !com_port->reader_running)
+        return;
+
+    const char stop = 0;
+    ssize_t ret = write(com_port->reader_wakeup[1], &stop, 1);
+    (void)ret; /* the pipe is empty, so the write cannot fail */
+    pthread_join(com_port->reader_thread, NULL);
+
+    close(com_port->reader_wakeup[0]);
+    close(com_port->reader_wakeup[1]);
+    free(com_port->reader_buffer);
+    com_port->reader_buffer = NULL;
+    com_port->reader_running = false;
+}
+
 /* --- Close open blocks -------------------------------------------------- */
 
 /* End of UNIX only code */
@@ -48,6 +48,7 @@
 #include <ctype.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <tchar.h>
 
 #include <windows.h>
@@ -64,6 +65,17 @@
 struct com_s
 {
     HANDLE handle;
+    OVERLAPPED read_overlapped;  /* event of ifx_comport_get_data reads */
+    OVERLAPPED write_overlapped; /* event of ifx_comport_send_data writes */
+
+    /* Reader thread of ifx_comport_start_reader */
+    HANDLE reader_thread;
+    HANDLE reader_stop; /* set to stop the reader */
+    OVERLAPPED reader_overlapped;
+    ifx_comport_data_callback_t reader_callback;
+    void* reader_context;
+    uint8_t* reader_buffer;
+    DWORD reader_buffer_size;
 };
 
 typedef struct
@@ -73,6 +85,90 @@ typedef struct
     size_t buffer_available;
 } Port_List_t;
 
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/*
+ * A read returns as soon as at least one byte is buffered, with everything
+ * buffered up to the requested size, and waits at most timeout_period_ms
+ * for the first byte.
+ */
+static void set_timeouts(HANDLE handle, uint32_t timeout_period_ms)
+{
+    COMMTIMEOUTS timeouts;
+    timeouts.ReadIntervalTimeout = MAXDWORD;
+    if (timeout_period_ms == 0)
+    {
+        /* return immediately with what is buffered */
+        timeouts.ReadTotalTimeoutMultiplier = 0;
+        timeouts.ReadTotalTimeoutConstant = 0;
+    }
+    else
+    {
+        timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+        timeouts.ReadTotalTimeoutConstant = (timeout_period_ms < MAXDWORD) ? timeout_period_ms : (MAXDWORD - 1);
+    }
+    timeouts.WriteTotalTimeoutConstant = 100;
+    timeouts.WriteTotalTimeoutMultiplier = 1;
+    (void)SetCommTimeouts(handle, &timeouts);
+}
+
+/*
+ * Issues an overlapped read and sleeps on its completion event. With
+ * stop_event, the wait also ends when that event is set; the read is
+ * cancelled then and the function fails.
+ */
+static BOOL read_overlapped(HANDLE handle, OVERLAPPED* overlapped, HANDLE stop_event,
+                            void* buffer, DWORD size, DWORD* num_bytes_read)
+{
+    *num_bytes_read = 0;
+    (void)ResetEvent(overlapped->hEvent);
+
+    if (ReadFile(handle, buffer, size, num_bytes_read, overlapped))
+        return TRUE;
+
+    if (GetLastError() != ERROR_IO_PENDING)
+        return FALSE;
+
+    if (stop_event != NULL)
+    {
+        HANDLE events[2] = {overlapped->hEvent, stop_event};
+        if (WaitForMultipleObjects(2, events, FALSE, INFINITE) != WAIT_OBJECT_0)
+        {
+            (void)CancelIoEx(handle, overlapped);
+            (void)GetOverlappedResult(handle, overlapped, num_bytes_read, TRUE);
+            return FALSE;
+        }
+    }
+
+    return GetOverlappedResult(handle, overlapped, num_bytes_read, TRUE);
+}
+
+static DWORD WINAPI reader_main(LPVOID arg)
+{
+    com_t* com_port = (com_t*)arg;
+
+    for (;;)
+    {
+        DWORD num_bytes_read = 0;
+        if (!read_overlapped(com_port->handle, &com_port->reader_overlapped, com_port->reader_stop,
+                             com_port->reader_buffer, com_port->reader_buffer_size, &num_bytes_read))
+            break;
+
+        /* zero bytes: the timeout expired, wait again */
+        if (num_bytes_read > 0)
+            com_port->reader_callback(com_port->reader_context, com_port->reader_buffer, num_bytes_read);
+    }
+
+    if (WaitForSingleObject(com_port->reader_stop, 0) != WAIT_OBJECT_0)
+        com_port->reader_callback(com_port->reader_context, NULL, 0);
+
+    return 0;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -81,10 +177,9 @@ typedef struct
 
 com_t* ifx_comport_open(const char* port_name, uint32_t baudrate)
 {
-    COMMTIMEOUTS timeouts;
     DCB com_configuration = {0};
 
-    com_t* com_port = malloc(sizeof(com_t));
+    com_t* com_port = calloc(1, sizeof(com_t));
     if (com_port == NULL)
         return NULL;
 
@@ -116,23 +211,28 @@ com_t* ifx_comport_open(const char* port_name, uint32_t baudrate)
                                       GENERIC_WRITE,
                                   0,             /* shared mode */
                                   NULL,          /* security attributes */
-                                  OPEN_EXISTING, /* creation disposition */
-                                  0,             /* flags and attributes */
-                                  0);            /* template file */
+                                  OPEN_EXISTING,        /* creation disposition */
+                                  FILE_FLAG_OVERLAPPED, /* flags and attributes */
+                                  0);                   /* template file */
 
     /* if COM port could not be opened, return negative Windows error code */
     if (com_port->handle == INVALID_HANDLE_VALUE)
     {
+        free(com_port);
+        return NULL;
+    }
+
+    /* completion events of the overlapped transfers (manual reset) */
+    com_port->read_overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    com_port->write_overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if ((com_port->read_overlapped.hEvent == NULL) || (com_port->write_overlapped.hEvent == NULL))
+    {
+        ifx_comport_close(com_port);
         return NULL;
     }
 
     /* set timeouts */
-    timeouts.ReadIntervalTimeout = 0;
-    timeouts.ReadTotalTimeoutMultiplier = 0;
-    timeouts.ReadTotalTimeoutConstant = 1000;
-    timeouts.WriteTotalTimeoutConstant = 100;
-    timeouts.WriteTotalTimeoutMultiplier = 1;
-    (void)SetCommTimeouts(com_port->handle, &timeouts);
+    set_timeouts(com_port->handle, 1000);
 
     /* configure COM Port (even though it's virtual) */
     com_configuration.DCBlength = sizeof(DCB);
@@ -150,11 +250,17 @@ void ifx_comport_close(com_t* com_port)
     if (com_port == NULL)
         return;
 
+    ifx_comport_stop_reader(com_port);
+
     /* stop all transfers are in progress */
     (void)CancelIo(com_port->handle);
 
     /* close COM port */
     (void)CloseHandle(com_port->handle);
+    if (com_port->read_overlapped.hEvent != NULL)
+        (void)CloseHandle(com_port->read_overlapped.hEvent);
+    if (com_port->write_overlapped.hEvent != NULL)
+        (void)CloseHandle(com_port->write_overlapped.hEvent);
 
     /* free memory for com_port */
     free(com_port);
@@ -163,32 +269,99 @@ void ifx_comport_close(com_t* com_port)
 size_t ifx_comport_send_data(com_t* com_port, const void* data, size_t num_bytes)
 {
     /* send data */
-    DWORD num_bytes_written;
-    WriteFile(com_port->handle, data, (DWORD)num_bytes, &num_bytes_written, NULL);
+    DWORD num_bytes_written = 0;
+    (void)ResetEvent(com_port->write_overlapped.hEvent);
+    if (!WriteFile(com_port->handle, data, (DWORD)num_bytes, &num_bytes_written, &com_port->write_overlapped))
+    {
+        if (GetLastError() == ERROR_IO_PENDING)
+            (void)GetOverlappedResult(com_port->handle, &com_port->write_overlapped, &num_bytes_written, TRUE);
+    }
     return num_bytes_written;
 }
 
 size_t ifx_comport_get_data(com_t* com_port,
                             void* data, size_t num_requested_bytes)
 {
-    /* read data */
-    DWORD num_bytes_read = 0;
+    /* read data: every read returns with what is buffered as soon as
+       anything is, so loop until the request is complete or a read timed
+       out without data */
+    size_t num_received_bytes = 0;
+    char* read_buffer = (char*)data;
 
-    (void)ReadFile(com_port->handle, data, (DWORD)num_requested_bytes, &num_bytes_read, NULL);
+    while (num_received_bytes < num_requested_bytes)
+    {
+        DWORD num_bytes_read = 0;
+        if (!read_overlapped(com_port->handle, &com_port->read_overlapped, NULL,
+                             read_buffer + num_received_bytes,
+                             (DWORD)(num_requested_bytes - num_received_bytes), &num_bytes_read)
+            || (num_bytes_read == 0))
+            break;
 
-    return num_bytes_read;
+        num_received_bytes += num_bytes_read;
+    }
+
+    return num_received_bytes;
 }
 
 void ifx_comport_set_timeout(com_t* com_port, uint32_t timeout_period_ms)
 {
     /* set timeouts */
-    COMMTIMEOUTS timeouts;
-    timeouts.ReadIntervalTimeout = 0;
-    timeouts.ReadTotalTimeoutMultiplier = 0;
-    timeouts.ReadTotalTimeoutConstant = timeout_period_ms;
-    timeouts.WriteTotalTimeoutConstant = 100;
-    timeouts.WriteTotalTimeoutMultiplier = 1;
-    (void)SetCommTimeouts(com_port->handle, &timeouts);
+    set_timeouts(com_port->handle, timeout_period_ms);
+}
+
+bool ifx_comport_start_reader(com_t* com_port, ifx_comport_data_callback_t callback, void* context, size_t buffer_size)
+{
+    if ((com_port == NULL) || (callback == NULL) || (com_port->reader_thread != NULL))
+        return false;
+
+    if (buffer_size == 0)
+        buffer_size = IFX_COMPORT_READER_BUFFER_DEFAULT;
+
+    com_port->reader_buffer = malloc(buffer_size);
+    com_port->reader_stop = CreateEvent(NULL, TRUE, FALSE, NULL);
+    com_port->reader_overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    com_port->reader_buffer_size = (DWORD)buffer_size;
+    com_port->reader_callback = callback;
+    com_port->reader_context = context;
+
+    if ((com_port->reader_buffer != NULL) && (com_port->reader_stop != NULL)
+        && (com_port->reader_overlapped.hEvent != NULL))
+    {
+        com_port->reader_thread = CreateThread(NULL, 0, reader_main, com_port, 0, NULL);
+    }
+
+    if (com_port->reader_thread == NULL)
+    {
+        if (com_port->reader_stop != NULL)
+            (void)CloseHandle(com_port->reader_stop);
+        if (com_port->reader_overlapped.hEvent != NULL)
+            (void)CloseHandle(com_port->reader_overlapped.hEvent);
+        free(com_port->reader_buffer);
+        com_port->reader_stop = NULL;
+        com_port->reader_overlapped.hEvent = NULL;
+        com_port->reader_buffer = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void ifx_comport_stop_reader(com_t* com_port)
+{
+    if ((com_port == NULL) || (com_port->reader_thread == NULL))
+        return;
+
+    (void)SetEvent(com_port->reader_stop);
+    (void)WaitForSingleObject(com_port->reader_thread, INFINITE);
+
+    (void)CloseHandle(com_port->reader_thread);
+    (void)CloseHandle(com_port->reader_stop);
+    (void)CloseHandle(com_port->reader_overlapped.hEvent);
+    free(com_port->reader_buffer);
+    com_port->reader_thread = NULL;
+    com_port->reader_stop = NULL;
+    com_port->reader_overlapped.hEvent = NULL;
+    com_port->reader_buffer = NULL;
 }
 
 /* --- Close open blocks -------------------------------------------------- */
@@ -0,0 +1,226 @@
+/* ===========================================================================
+** Copyright (C) 2021 - 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file CwStreamBuffer.cpp
+ *
+ * @brief Implements the ring buffer of a CW stream.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "CwStreamBuffer.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/internal/Macros.h"
+
+#include <algorithm>
+#include <chrono>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Scales the 12 bit ADC range 0...4095 to -1...1 as the CW controller does
+#define ADC_SCALE (2.f / 4095.f)
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+namespace {
+
+uint32_t round_up_to_power_of_2(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+CwStreamBuffer::CwStreamBuffer(uint32_t num_channels, uint32_t block_size, uint32_t capacity) :
+    m_num_channels {num_channels},
+    m_block_size {block_size},
+    m_capacity {round_up_to_power_of_2(std::max(capacity, 2 * block_size))},
+    m_data(size_t(m_num_channels) * m_capacity)
+{}
+
+//----------------------------------------------------------------------------
+
+void CwStreamBuffer::write(const uint16_t* raw_data, size_t num_values)
+{
+    const auto num_samples = uint32_t(num_values / m_num_channels);
+    const uint64_t write = m_write.load(std::memory_order_relaxed);
+    const uint64_t read = m_read.load(std::memory_order_acquire);
+
+    m_num_blocks.store(m_num_blocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (num_samples > m_capacity - (write - read))
+    {
+        // the gap must be visible before the overrun counter
+        m_gap.store(write, std::memory_order_relaxed);
+        m_samples_dropped.store(m_samples_dropped.load(std::memory_order_relaxed) + num_samples, std::memory_order_relaxed);
+        m_overruns.fetch_add(1, std::memory_order_release);
+        notify();
+        return;
+    }
+
+    const uint32_t mask = m_capacity - 1;
+    for (uint32_t channel = 0; channel < m_num_channels; channel++)
+    {
+        ifx_Float_t* row = m_data.data() + size_t(channel) * m_capacity;
+        const uint16_t* src = raw_data + channel;
+        for (uint32_t i = 0; i < num_samples; i++)
+        {
+            row[(write + i) & mask] = src[size_t(i) * m_num_channels] * ADC_SCALE - 1.f;
+        }
+    }
+
+    m_write.store(write + num_samples, std::memory_order_release);
+
+    const auto fill_level = uint32_t(write + num_samples - read);
+    if (fill_level > m_high_water.load(std::memory_order_relaxed))
+        m_high_water.store(fill_level, std::memory_order_relaxed);
+
+    notify();
+}
+
+//----------------------------------------------------------------------------
+
+void CwStreamBuffer::fail()
+{
+    m_failed.store(true, std::memory_order_release);
+    notify();
+}
+
+//----------------------------------------------------------------------------
+
+void CwStreamBuffer::read(ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms)
+{
+    if (!window)
+        throw rdk::exception::argument_null();
+    if (mRows(window) != m_num_channels)
+        throw rdk::exception::dimension_mismatch();
+
+    const uint32_t length = mCols(window);
+    if (hop == 0)
+        hop = length;
+    if (length == 0 || length > m_capacity || hop > m_capacity)
+        throw rdk::exception::argument_out_of_bounds();
+
+    const uint64_t needed = std::max(length, hop);
+
+    auto check_overrun = [this]() {
+        const uint64_t overruns = m_overruns.load(std::memory_order_acquire);
+        if (overruns != m_overruns_seen)
+        {
+            // discard everything before the last dropped block
+            m_overruns_seen = overruns;
+            const uint64_t gap = m_gap.load(std::memory_order_relaxed);
+            m_read.store(std::max(gap, m_read.load(std::memory_order_relaxed)), std::memory_order_release);
+            throw rdk::exception::fifo_overflow();
+        }
+    };
+    auto is_ready = [&]() {
+        return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_relaxed) >= needed
+               || m_overruns.load(std::memory_order_acquire) != m_overruns_seen
+               || m_failed.load(std::memory_order_acquire);
+    };
+
+    check_overrun();
+    if (!is_ready())
+    {
+        std::unique_lock<std::mutex> lock(m_wait_guard);
+        if (!m_data_available.wait_for(lock, std::chrono::milliseconds(timeout_ms), is_ready))
+            throw rdk::exception::timeout();
+    }
+    check_overrun();
+
+    const uint64_t read = m_read.load(std::memory_order_relaxed);
+    if (m_write.load(std::memory_order_acquire) - read < needed)
+        throw rdk::exception::frame_acquisition_failed();
+
+    // the window may wrap around the end of the ring
+    const uint32_t start = uint32_t(read & (m_capacity - 1));
+    const uint32_t first = std::min(length, m_capacity - start);
+    for (uint32_t channel = 0; channel < m_num_channels; channel++)
+    {
+        const ifx_Float_t* row = m_data.data() + size_t(channel) * m_capacity;
+        for (uint32_t i = 0; i < first; i++)
+            mAt(window, channel, i) = row[start + i];
+        for (uint32_t i = first; i < length; i++)
+            mAt(window, channel, i) = row[i - first];
+    }
+
+    m_read.store(read + hop, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------------
+
+void CwStreamBuffer::get_statistics(ifx_Cw_Stream_Statistics_t* statistics) const
+{
+    const uint64_t write = m_write.load(std::memory_order_acquire);
+    const uint64_t read = m_read.load(std::memory_order_acquire);
+
+    statistics->num_blocks = m_num_blocks.load(std::memory_order_relaxed);
+    statistics->num_samples = write;
+    statistics->overruns = m_overruns.load(std::memory_order_relaxed);
+    statistics->samples_dropped = m_samples_dropped.load(std::memory_order_relaxed);
+    statistics->capacity = m_capacity;
+    statistics->fill_level = uint32_t(write - std::min(read, write));
+    statistics->high_water = m_high_water.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------
+
+void CwStreamBuffer::notify()
+{
+    // taking the lock ensures a reader between checking and waiting is woken up
+    {
+        std::lock_guard<std::mutex> lock(m_wait_guard);
+    }
+    m_data_available.notify_one();
+}
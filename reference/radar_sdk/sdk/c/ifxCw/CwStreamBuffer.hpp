@@ -0,0 +1,137 @@
+/* ===========================================================================
+** Copyright (C) 2021 - 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file CwStreamBuffer.hpp
+ *
+ * @brief Defines the ring buffer of a CW stream.
+ */
+
+#pragma once
+
+#include "DeviceCwTypes.h"
+#include "ifxBase/Matrix.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+
+/**
+ * @brief Single producer, single consumer ring buffer of a CW stream.
+ *
+ * The acquisition thread writes blocks of raw ADC data, the application reads
+ * windows of consecutive samples. Writing and reading only synchronize
+ * through the atomic write and read positions, the mutex is only used to wake
+ * up a reader waiting for data.
+ *
+ * If a block does not fit into the free space, the block is dropped as a
+ * whole and the overrun is recorded. The next read discards all samples
+ * written before the dropped block and fails with a FIFO overflow, so every
+ * window returned by read() is free of gaps.
+ */
+class CwStreamBuffer
+{
+public:
+    /**
+     * @param [in] num_channels  Number of enabled RX antennas.
+     * @param [in] block_size    Number of samples per antenna of a block.
+     * @param [in] capacity      Minimum capacity in samples per antenna,
+     *                           rounded up to a power of 2 and at least two
+     *                           blocks.
+     */
+    CwStreamBuffer(uint32_t num_channels, uint32_t block_size, uint32_t capacity);
+
+    /**
+     * @brief Writes a block of raw samples interleaved over the antennas.
+     *
+     * Only called by the producer. Samples of 0...4095 are normalized to
+     * -1...1 as by ifx_cw_capture_frame.
+     */
+    void write(const uint16_t* raw_data, size_t num_values);
+
+    /**
+     * @brief Marks the end of the stream after an acquisition failure.
+     *
+     * Only called by the producer.
+     */
+    void fail();
+
+    /**
+     * @brief Copies the next window of samples and advances by hop samples.
+     *
+     * Only called by the consumer. Blocks until window columns and hop
+     * samples are available. Throws rdk::exception::fifo_overflow if blocks
+     * were dropped since the last read, rdk::exception::timeout if not
+     * enough samples arrived within timeout_ms, and
+     * rdk::exception::frame_acquisition_failed if the stream ended.
+     */
+    void read(ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms);
+
+    void get_statistics(ifx_Cw_Stream_Statistics_t* statistics) const;
+
+    uint32_t get_num_channels() const
+    {
+        return m_num_channels;
+    }
+
+    uint32_t get_block_size() const
+    {
+        return m_block_size;
+    }
+
+private:
+    void notify();
+
+    const uint32_t m_num_channels;
+    const uint32_t m_block_size;
+    const uint32_t m_capacity;
+    std::vector<ifx_Float_t> m_data;  // m_num_channels rows of m_capacity samples
+
+    // Positions count samples per channel since the start and never wrap.
+    std::atomic<uint64_t> m_write {0};
+    std::atomic<uint64_t> m_read {0};
+
+    // Written by the producer only.
+    std::atomic<uint64_t> m_num_blocks {0};
+    std::atomic<uint64_t> m_overruns {0};
+    std::atomic<uint64_t> m_samples_dropped {0};
+    std::atomic<uint64_t> m_gap {0};  // write position of the last dropped block
+    std::atomic<uint32_t> m_high_water {0};
+    std::atomic<bool> m_failed {false};
+
+    // Read by the consumer only.
+    uint64_t m_overruns_seen = 0;
+
+    std::mutex m_wait_guard;
+    std::condition_variable m_data_available;
+};
@@ -158,6 +158,17 @@ ifx_List_t* ifx_cw_get_list()
     return ifx_list_from_vector(list);
 }
 
+size_t ifx_cw_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    IFX_ERR_BRV_COND(count && !entries, IFX_ERROR_ARGUMENT_NULL, 0);
+
+    auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
+        return rdk::RadarDeviceCommon::sensor_is_avian(entry.sensor_type);
+    };
+
+    return rdk::RadarDeviceCommon::get_list(selector).copy_to(entries, count);
+}
+
 const ifx_Firmware_Info_t* ifx_cw_get_firmware_information(const ifx_Device_Cw_t* handle)
 {
     return rdk::call_func(handle, &ifx_Device_Cw_t::get_firmware_info);
@@ -228,6 +239,31 @@ ifx_Matrix_R_t* ifx_cw_capture_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* fr
     return rdk::call_func(handle, &ifx_Device_Cw_t::capture_frame, frame);
 }
 
+void ifx_cw_start_stream(ifx_Device_Cw_t* handle, uint32_t capacity)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::start_stream, capacity);
+}
+
+void ifx_cw_stop_stream(ifx_Device_Cw_t* handle)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::stop_stream);
+}
+
+bool ifx_cw_is_streaming(ifx_Device_Cw_t* handle)
+{
+    return rdk::call_func(handle, &ifx_Device_Cw_t::is_streaming);
+}
+
+ifx_Matrix_R_t* ifx_cw_read_stream(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms)
+{
+    return rdk::call_func(handle, &ifx_Device_Cw_t::read_stream, window, hop, timeout_ms);
+}
+
+void ifx_cw_get_stream_statistics(ifx_Device_Cw_t* handle, ifx_Cw_Stream_Statistics_t* statistics)
+{
+    rdk::call_func(handle, &ifx_Device_Cw_t::get_stream_statistics, statistics);
+}
+
 ifx_Radar_Sensor_t ifx_cw_get_sensor_type(const ifx_Device_Cw_t* handle)
 {
     return rdk::call_func(handle, &ifx_Device_Cw_t::get_sensor_type);
@@ -124,6 +124,32 @@ ifx_Device_Cw_t* ifx_cw_create();
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_cw_get_list(void);
 
+/**
+ * @brief Fills a caller-provided array with the available CW radar devices.
+ *
+ * The function is similar to @ref ifx_cw_get_list but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * @code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_cw_get_sensor_list(entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * @endcode
+ *
+ * @param [out] entries     array of at least count entries
+ * @param [in]  count       number of entries the array can hold
+ * @return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_cw_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * @brief Creates a device handle.
  *
@@ -391,6 +417,88 @@ float ifx_cw_measure_tx_power(ifx_Device_Cw_t* handle, uint32_t antenna);
 IFX_DLL_PUBLIC
 ifx_Matrix_R_t* ifx_cw_capture_frame(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* frame);
 
+/**
+ * @brief Starts streaming RX signals into a ring buffer.
+ *
+ * Blocks of the size of a frame of \ref ifx_cw_capture_frame are acquired
+ * continuously in a background thread and written into a ring buffer. The
+ * reader of the device stays running and the next block is triggered before
+ * the previous one is processed, so the only gap between two blocks is the
+ * time the sensor needs to accept the next trigger. The application reads
+ * sliding windows of consecutive samples with \ref ifx_cw_read_stream.
+ *
+ * The continuous wave must be started with \ref ifx_cw_start_signal before.
+ * While the stream is active, the configuration can't be changed and
+ * \ref ifx_cw_capture_frame, \ref ifx_cw_measure_temperature and
+ * \ref ifx_cw_measure_tx_power fail with IFX_ERROR_NOT_POSSIBLE.
+ * \ref ifx_cw_stop_signal also stops the stream.
+ *
+ * @param [in]     handle       A handle to the CW device
+ * @param [in]     capacity     Capacity of the ring buffer in samples per
+ *                              antenna. It is rounded up to a power of 2 and
+ *                              to at least two blocks.
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_start_stream(ifx_Device_Cw_t* handle, uint32_t capacity);
+
+/**
+ * @brief Stops a stream started by \ref ifx_cw_start_stream.
+ *
+ * Samples not read yet are discarded.
+ *
+ * @param [in]     handle       A handle to the CW device
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_stop_stream(ifx_Device_Cw_t* handle);
+
+/**
+ * @brief Returns true if a stream is active.
+ *
+ * @param [in]     handle       A handle to the CW device
+ */
+IFX_DLL_PUBLIC
+bool ifx_cw_is_streaming(ifx_Device_Cw_t* handle);
+
+/**
+ * @brief Reads the next window of samples from the stream.
+ *
+ * Copies the next mCols(window) samples of each enabled RX antenna into the
+ * rows of window and advances the read position by hop samples, so windows
+ * overlap for hop < window length and consecutive windows are contiguous for
+ * hop equal to the window length. The samples are normalized to -1...1 as
+ * by \ref ifx_cw_capture_frame. Blocks until enough samples are available.
+ *
+ * If the ring buffer was full when a block arrived, the block is dropped.
+ * The next read then discards all samples before the dropped block and fails
+ * with IFX_ERROR_FIFO_OVERFLOW, the read after it continues without gap from
+ * the blocks after the dropped one.
+ *
+ * @param [in]     handle       A handle to the CW device
+ * @param [in,out] window       Matrix with one row per enabled RX antenna and
+ *                              the window length as number of columns. If
+ *                              NULL, a matrix with the size of a frame of
+ *                              \ref ifx_cw_capture_frame is created and the
+ *                              caller must destroy it.
+ * @param [in]     hop          Number of samples to advance, 0 for the window
+ *                              length.
+ * @param [in]     timeout_ms   Maximum time to wait for samples. If it
+ *                              expires, IFX_ERROR_TIMEOUT is set.
+ *
+ * @return Pointer to window or to the created matrix, NULL in case of an error
+ *         if window was NULL.
+ */
+IFX_DLL_PUBLIC
+ifx_Matrix_R_t* ifx_cw_read_stream(ifx_Device_Cw_t* handle, ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms);
+
+/**
+ * @brief Gets the counters of the active stream.
+ *
+ * @param [in]     handle       A handle to the CW device
+ * @param [out]    statistics   Counters of the stream.
+ */
+IFX_DLL_PUBLIC
+void ifx_cw_get_stream_statistics(ifx_Device_Cw_t* handle, ifx_Cw_Stream_Statistics_t* statistics);
+
 /**
  * @brief Get information about the sensor on the connected device.
  *
@@ -73,6 +73,12 @@ struct DeviceCw
 
     virtual ifx_Matrix_R_t* capture_frame(ifx_Matrix_R_t* frame) = 0;
 
+    virtual void start_stream(uint32_t capacity) = 0;
+    virtual void stop_stream() = 0;
+    virtual bool is_streaming() const = 0;
+    virtual ifx_Matrix_R_t* read_stream(ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms) = 0;
+    virtual void get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics) const = 0;
+
     virtual std::map<uint16_t, uint32_t>& get_register_list() = 0;
     virtual void apply_register_list(const std::map<uint16_t, uint32_t>& register_list) = 0;
 
@@ -36,6 +36,7 @@
 
 
 #include "DeviceCwBase.hpp"
+#include "ifxBase/Exception.hpp"
 
 /*
 ==============================================================================
@@ -62,3 +63,52 @@ const ifx_Firmware_Info_t* DeviceCwBase::get_firmware_info() const
 {
     return &m_firmware_info;
 }
+
+bool DeviceCwBase::is_streaming() const
+{
+    return m_stream != nullptr;
+}
+
+ifx_Matrix_R_t* DeviceCwBase::read_stream(ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms)
+{
+    if (!m_stream)
+        throw rdk::exception::not_possible();
+
+    // without a window, a window of one block is returned like by capture_frame
+    ifx_Matrix_R_t* allocated = nullptr;
+    if (window == nullptr)
+    {
+        allocated = ifx_mat_create_r(m_stream->get_num_channels(), m_stream->get_block_size());
+        if (allocated == nullptr)
+            throw rdk::exception::memory_allocation_failed();
+        window = allocated;
+    }
+
+    try
+    {
+        m_stream->read(window, hop, timeout_ms);
+    }
+    catch (...)
+    {
+        ifx_mat_destroy_r(allocated);
+        throw;
+    }
+
+    return window;
+}
+
+void DeviceCwBase::get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics) const
+{
+    if (!statistics)
+        throw rdk::exception::argument_null();
+    if (!m_stream)
+        throw rdk::exception::not_possible();
+
+    m_stream->get_statistics(statistics);
+}
+
+void DeviceCwBase::check_not_streaming() const
+{
+    if (m_stream)
+        throw rdk::exception::not_possible();
+}
@@ -37,9 +37,11 @@
 #pragma once
 
 #include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxCw/CwStreamBuffer.hpp"
 #include "ifxCw/DeviceCw.hpp"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
 
+#include <memory>
 #include <string>
 
 
@@ -52,7 +54,14 @@ struct DeviceCwBase : public DeviceCw
     const ifx_Radar_Sensor_Info_t* get_sensor_info() const override;
     const ifx_Firmware_Info_t* get_firmware_info() const override;
 
+    bool is_streaming() const override;
+    ifx_Matrix_R_t* read_stream(ifx_Matrix_R_t* window, uint32_t hop, uint32_t timeout_ms) override;
+    void get_stream_statistics(ifx_Cw_Stream_Statistics_t* statistics) const override;
+
 protected:
+    // Throws rdk::exception::not_possible while a stream is active.
+    void check_not_streaming() const;
+
     ifx_Firmware_Info_t m_firmware_info;
     ifx_Radar_Sensor_Info_t m_sensor_info;
 
@@ -60,4 +69,8 @@ protected:
     IBridgeData* m_bridge_data;
     uint8_t m_data_index;
     IData* m_data;
+
+    // Ring buffer of the active stream, written by the acquisition thread of
+    // the derived class.
+    std::unique_ptr<CwStreamBuffer> m_stream;
 };
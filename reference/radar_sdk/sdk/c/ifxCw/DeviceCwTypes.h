@@ -136,6 +136,23 @@ typedef struct
     float frequency_Hz;
 } ifx_Cw_Test_Signal_Generator_Config_t;
 
+/**
+ * @brief Counters of a CW stream, see @ref ifx_cw_get_stream_statistics.
+ *
+ * The counters accumulate from the start of the stream. Sample counts are
+ * per RX antenna.
+ */
+typedef struct
+{
+    uint64_t num_blocks;      /**< Number of blocks received from the device. */
+    uint64_t num_samples;     /**< Number of samples written to the ring buffer. */
+    uint64_t overruns;        /**< Blocks dropped because the ring buffer was full. */
+    uint64_t samples_dropped; /**< Samples of these blocks. */
+    uint32_t capacity;        /**< Capacity of the ring buffer in samples. */
+    uint32_t fill_level;      /**< Samples in the ring buffer not consumed yet. */
+    uint32_t high_water;      /**< Maximum fill level since the start of the stream. */
+} ifx_Cw_Stream_Statistics_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -337,16 +337,48 @@ bool DeviceCwAvian::is_signal_active()
 
 void DeviceCwAvian::start_signal()
 {
+    check_not_streaming();
     m_cw_controller->enable_continuous_wave(true);
 }
 
 void DeviceCwAvian::stop_signal()
 {
+    stop_stream();
     m_cw_controller->enable_continuous_wave(false);
 }
 
+void DeviceCwAvian::start_stream(uint32_t capacity)
+{
+    check_not_streaming();
+    if (!is_signal_active())
+        throw rdk::exception::not_possible();
+
+    auto stream = std::make_unique<CwStreamBuffer>(get_rx_antenna_enabled_count(),
+                                                   m_cw_controller->get_number_of_samples(),
+                                                   capacity);
+
+    // called from the stream thread of the controller
+    auto* buffer = stream.get();
+    m_cw_controller->start_rx_stream([buffer](const uint16_t* raw_data, size_t num_values) {
+        if (raw_data)
+            buffer->write(raw_data, num_values);
+        else
+            buffer->fail();
+    });
+
+    m_stream = std::move(stream);
+}
+
+void DeviceCwAvian::stop_stream()
+{
+    // the controller joins its stream thread before the buffer is destroyed
+    m_cw_controller->stop_rx_stream();
+    m_stream.reset();
+}
+
 void DeviceCwAvian::set_baseband_config(const ifx_Cw_Baseband_Config_t* config)
 {
+    check_not_streaming();
     using namespace Infineon::Avian;
     const auto& if_gain_dB = config->if_gain_dB;
     const auto hp_cutoff_Hz = config->hp_cutoff_Hz;
@@ -434,6 +466,7 @@ const ifx_Cw_Baseband_Config_t* DeviceCwAvian::get_baseband_config()
 
 void DeviceCwAvian::set_adc_config(const ifx_Cw_Adc_Config_t* config)
 {
+    check_not_streaming();
     using namespace Infineon::Avian;
     auto sampling_time = ns_to_adc_sampling_time(config->sample_and_hold_time_ns);
     m_cw_controller->set_adc_sample_time(sampling_time);
@@ -470,6 +503,7 @@ const ifx_Cw_Adc_Config_t* DeviceCwAvian::get_adc_config()
 
 void DeviceCwAvian::set_test_signal_generator_config(const ifx_Cw_Test_Signal_Generator_Config_t* config)
 {
+    check_not_streaming();
     using namespace Infineon::Avian;
     m_cw_controller->set_test_signal_frequency(config->frequency_Hz);
     m_cw_controller->set_test_signal_generator_mode(static_cast<Continuous_Wave_Controller::Test_Signal_Generator_Mode>(config->mode));
@@ -485,16 +519,19 @@ const ifx_Cw_Test_Signal_Generator_Config_t* DeviceCwAvian::get_test_signal_gene
 
 float DeviceCwAvian::measure_temperature()
 {
+    check_not_streaming();
     return m_cw_controller->measure_temperature();
 }
 
 float DeviceCwAvian::measure_tx_power(const uint32_t antenna)
 {
+    check_not_streaming();
     return m_cw_controller->measure_tx_power(antenna);
 }
 
 ifx_Matrix_R_t* DeviceCwAvian::capture_frame(ifx_Matrix_R_t* frame)
 {
+    check_not_streaming();
     if (frame == nullptr)
     {
         frame = ifx_mat_create_r(get_tx_antenna_enabled_count() * get_rx_antenna_enabled_count(),
@@ -119,6 +119,9 @@ public:
 
     ifx_Matrix_R_t* capture_frame(ifx_Matrix_R_t* frame) override;
 
+    void start_stream(uint32_t capacity) override;
+    void stop_stream() override;
+
     ifx_Radar_Sensor_t get_sensor_type() const override;
 
     std::map<uint16_t, uint32_t>& get_register_list() override;
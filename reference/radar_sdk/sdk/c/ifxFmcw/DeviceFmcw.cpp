@@ -29,6 +29,7 @@
 
 #include "DeviceFmcw.hpp"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
+#include "ifxBase/Mem.h"
 
 
 namespace Fmcw {
@@ -39,12 +40,8 @@ void destroy_frame(ifx_Fmcw_Frame_t* frame)
     {
         return;
     }
-    for (size_t i = 0; i < frame->num_cubes; i++)
-    {
-        ifx_mda_destroy_r(frame->cubes[i]);
-    }
-    delete[] frame->cubes;
-    delete frame;
+    // the frame is a single block, see DeviceFmcwBase::allocate_frame
+    ifx_mem_aligned_free(frame);
 }
 
 void destroy_raw_frame(ifx_Fmcw_Raw_Frame_t* frame)
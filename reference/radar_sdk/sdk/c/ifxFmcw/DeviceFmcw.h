@@ -110,6 +110,32 @@ typedef struct DeviceFmcw ifx_Device_Fmcw_t;
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_fmcw_get_list(void);
 
+/**
+ * @brief Fills a caller-provided array with the available FMCW radar devices.
+ *
+ * The function is similar to @ref ifx_fmcw_get_list but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * @code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_fmcw_get_sensor_list(entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * @endcode
+ *
+ * @param [out] entries     array of at least count entries
+ * @param [in]  count       number of entries the array can hold
+ * @return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_fmcw_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * @brief This function returns a list of available specified devices.
  *
@@ -138,6 +164,33 @@ ifx_List_t* ifx_fmcw_get_list(void);
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_fmcw_get_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type);
 
+/**
+ * @brief Fills a caller-provided array with the available devices of a sensor type.
+ *
+ * The function is similar to @ref ifx_fmcw_get_list_by_sensor_type but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * @code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_fmcw_get_sensor_list_by_sensor_type(IFX_AVIAN_BGT60TR13C, entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * @endcode
+ *
+ * @param [in]  sensor_type The device type to search for.
+ * @param [out] entries     array of at least count entries
+ * @param [in]  count       number of entries the array can hold
+ * @return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_fmcw_get_sensor_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type, ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * @brief Creates a dummy device handle.
  *
@@ -180,6 +233,77 @@ ifx_Device_Fmcw_t* ifx_fmcw_create_dummy_with_reference_freq(ifx_Radar_Sensor_t
 IFX_DLL_PUBLIC
 ifx_Device_Fmcw_t* ifx_fmcw_create_dummy_from_device(const ifx_Device_Fmcw_t* handle);
 
+/**
+ * @brief Creates a device handle that plays back a recorded capture.
+ *
+ * The capture is a file written from the PSoC 6 firmware's binary frame
+ * stream (serial_logger.py or radr_capture, raw or indexed .rcap).
+ * Its time-domain frames (uint16 or Packed12 samples) are returned by
+ * @ref ifx_fmcw_get_next_frame and @ref ifx_fmcw_get_next_raw_frame; range,
+ * presence and control frames are skipped and compressed captures are not
+ * supported. Apart from data acquisition the handle behaves like a dummy
+ * device of the given sensor type, so the acquisition sequence has to be
+ * set to the one the capture was recorded with.
+ *
+ * In @ref IFX_FMCW_PLAYBACK_REAL_TIME mode frames are delivered at the
+ * intervals of their recorded timestamps (or the configured frame
+ * repetition time for captures without timestamps), in
+ * @ref IFX_FMCW_PLAYBACK_MAX_SPEED mode as fast as they are fetched. After
+ * the last frame fetching fails with IFX_ERROR_END_OF_FILE unless loop is
+ * true.
+ *
+ * @param[in] sensor_type  The sensor type the capture was recorded with.
+ * @param[in] filename     Path of the capture file.
+ * @param[in] mode         Pacing of the frames.
+ * @param[in] loop         Restart at the first frame after the last one.
+ *
+ * @return Handle to the newly created playback instance or NULL in case of
+ *         failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Device_Fmcw_t* ifx_fmcw_create_playback(ifx_Radar_Sensor_t sensor_type, const char* filename,
+                                            ifx_Fmcw_Playback_Mode_t mode, bool loop);
+
+/**
+ * @brief Creates a device handle that generates frames of a synthetic scene.
+ *
+ * The frames contain the IF signals of the point targets, the TX to RX
+ * leakage and the white noise of the scene, computed for every chirp of the
+ * acquisition sequence from its RF range, sampling rate and timing. Targets
+ * move with their velocity from chirp to chirp and frame to frame. Apart
+ * from data acquisition the handle behaves like a dummy device of the given
+ * sensor type.
+ *
+ * In @ref IFX_FMCW_PLAYBACK_REAL_TIME mode frames are delivered at the frame
+ * repetition time of the acquisition sequence, in
+ * @ref IFX_FMCW_PLAYBACK_MAX_SPEED mode as fast as they are fetched. Handles
+ * are independent of each other, so many synthetic sensors can be run from
+ * separate threads, e.g. to load test processing chains without hardware.
+ *
+ * @param[in] sensor_type  The sensor type to emulate.
+ * @param[in] scene        The scene seen by the sensor, copied by the device.
+ * @param[in] mode         Pacing of the frames.
+ *
+ * @return Handle to the newly created synthetic instance or NULL in case of
+ *         failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Device_Fmcw_t* ifx_fmcw_create_synthetic(ifx_Radar_Sensor_t sensor_type, const ifx_Fmcw_Synthetic_Scene_t* scene,
+                                             ifx_Fmcw_Playback_Mode_t mode);
+
+/**
+ * @brief Replaces the scene of a synthetic device.
+ *
+ * Target positions are restarted from the ranges of the new scene. Fails
+ * with IFX_ERROR_NOT_SUPPORTED if the handle was not created by
+ * @ref ifx_fmcw_create_synthetic.
+ *
+ * @param[in] handle  A handle to a synthetic device.
+ * @param[in] scene   The new scene, copied by the device.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_synthetic_scene(ifx_Device_Fmcw_t* handle, const ifx_Fmcw_Synthetic_Scene_t* scene);
+
 /**
  * @brief Creates a device handle.
  *
@@ -217,6 +341,10 @@ ifx_Device_Fmcw_t* ifx_fmcw_create_by_port(const char* port);
  * For converting the UUID from byte array to/from string see
  * @see ifx_uuid_from_string and @see ifx_uuid_to_string.
  *
+ * If a device server (see @ref gr_devicefmcwserver) publishes the frames of
+ * the sensor, the handle is attached to the server instead of opening the
+ * sensor itself.
+ *
  * On failure one of the following error codes are set:
  * - @ref IFX_ERROR_ARGUMENT_INVALID : The format of the UUID is wrong.
  * - @ref IFX_ERROR_NO_DEVICE : Sensor with given UUID not found.
@@ -274,6 +402,21 @@ ifx_Device_Fmcw_t* ifx_fmcw_create_by_uuid_with_reference_freq(const char* uuid,
 IFX_DLL_PUBLIC
 void ifx_fmcw_save_register_file(ifx_Device_Fmcw_t* handle, const char* filename);
 
+/**
+ * @brief Save register list to a binary profile
+ *
+ * This function writes the register list representing the current acquisition
+ * sequence to a compact binary file. Unlike text register files, a profile
+ * stores the device type it was made for and is protected by a checksum.
+ * Profiles are loaded with \ref ifx_fmcw_load_register_file without parsing
+ * text.
+ *
+ * @param[in] handle    A handle to the radar device object.
+ * @param[in] filename  The path to the file the profile shall be written to.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_save_register_profile(ifx_Device_Fmcw_t* handle, const char* filename);
+
 /**
  * @brief Load register list to a file
  *
@@ -284,6 +427,10 @@ void ifx_fmcw_save_register_file(ifx_Device_Fmcw_t* handle, const char* filename
  * set list may not work at all or load to unexpected behavior. Especially
  * register lists made for a different device type usually don't work.
  *
+ * The file can be a text register file or a binary profile written by
+ * \ref ifx_fmcw_save_register_profile. Loading a profile made for a different
+ * device type fails with IFX_ERROR_DEVICE_NOT_SUPPORTED.
+ *
  * @param[in] handle    A handle to the radar device object.
  * @param[in] filename  The path to the file the register list shall be loaded from.
  */
@@ -324,6 +471,33 @@ void ifx_fmcw_set_acquisition_sequence(ifx_Device_Fmcw_t* handle,
 IFX_DLL_PUBLIC
 ifx_Fmcw_Sequence_Element_t* ifx_fmcw_get_acquisition_sequence(ifx_Device_Fmcw_t* handle);
 
+/**
+ * @brief Checks if acquisition sequences can be applied to the radar device.
+ *
+ * For each sequence the error that \ref ifx_fmcw_set_acquisition_sequence
+ * would raise is returned, IFX_OK if the sequence is feasible. The
+ * configuration of the device is not changed.
+ *
+ * The translated sequences and their durations are cached, so checking a
+ * sequence again or applying a checked sequence with
+ * \ref ifx_fmcw_set_acquisition_sequence does not repeat the translation.
+ * The cache is cleared when the configuration of the device changes.
+ *
+ * @param[in]  handle         A handle to the radar device object.
+ * @param[in]  sequences      Array of num_sequences acquisition sequences.
+ * @param[in]  num_sequences  Number of sequences to check.
+ * @param[out] errors         Array of num_sequences error codes.
+ * @param[out] durations      Array of num_sequences durations in seconds as
+ *                            returned by \ref ifx_fmcw_get_sequence_duration,
+ *                            0 for sequences that are not feasible. May be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_check_acquisition_sequences(const ifx_Device_Fmcw_t* handle,
+                                          const ifx_Fmcw_Sequence_Element_t* const* sequences,
+                                          uint32_t num_sequences,
+                                          ifx_Error_t* errors,
+                                          float* durations);
+
 
 /**
  * @brief Get sensor type of connected device.
@@ -344,6 +518,10 @@ ifx_Radar_Sensor_t ifx_fmcw_get_sensor_type(const ifx_Device_Fmcw_t* handle);
  * If an error occurs, an undefined value is returned and the error code can be
  * retrieved using the function @ref ifx_error_get
  *
+ * While an acquisition is running, the temperature is sampled every 100ms by
+ * a background thread and this function returns the last sample without
+ * accessing the device, so it can be called from the data path.
+ *
  * It is currently not possible to read the temperature from a BGT60UTR11AIP.
  * For a BGT60UTR11AIP this function will return IFX_ERROR_NOT_SUPPORTED.
  *
@@ -398,6 +576,77 @@ void ifx_fmcw_start_acquisition(ifx_Device_Fmcw_t* handle);
 IFX_DLL_PUBLIC
 void ifx_fmcw_stop_acquisition(ifx_Device_Fmcw_t* handle);
 
+/**
+ * @brief Sets how time domain data is split into slices.
+ *
+ * The default @ref IFX_FMCW_ACQUISITION_MAX_THROUGHPUT packs several frames
+ * into one slice if frames are small, which keeps the USB load low but
+ * delays a frame until the slice is full. For applications that need each
+ * frame shortly after its end use @ref IFX_FMCW_ACQUISITION_MIN_LATENCY, or
+ * @ref IFX_FMCW_ACQUISITION_FRAME_ALIGNED to receive every frame in exactly
+ * one slice, so that @ref ifx_fmcw_get_next_raw_frame never has to combine
+ * or split slices.
+ *
+ * The slice size is programmed when the acquisition starts. A running
+ * acquisition is stopped and restarted by the next call fetching a frame.
+ * Errors of a policy that does not fit the acquisition sequence (e.g. a
+ * frame larger than half the FIFO with @ref IFX_FMCW_ACQUISITION_FRAME_ALIGNED)
+ * are reported when the acquisition starts, see also @ref ifx_fmcw_get_slice_size.
+ *
+ * @param[in] handle      A handle to the radar device object.
+ * @param[in] policy      Acquisition policy.
+ * @param[in] slice_size  Slice size in samples for @ref IFX_FMCW_ACQUISITION_SLICE_SIZE,
+ *                        ignored otherwise.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_acquisition_policy(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Acquisition_Policy_t policy, uint32_t slice_size);
+
+/**
+ * @brief Returns the acquisition policy, see @ref ifx_fmcw_set_acquisition_policy.
+ *
+ * @param[in] handle  A handle to the radar device object.
+ * @return The acquisition policy.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Acquisition_Policy_t ifx_fmcw_get_acquisition_policy(const ifx_Device_Fmcw_t* handle);
+
+/**
+ * @brief Enables the in-place recovery from FIFO overflows.
+ *
+ * By default a FIFO overflow stops the acquisition and the function fetching
+ * the frame fails with @ref IFX_ERROR_FIFO_OVERFLOW; restarting the
+ * acquisition then reprograms the device. With recovery enabled the device
+ * instead flushes the sensor FIFO, resets the sequencer and retriggers it
+ * with the registers already programmed. The frame being received is lost
+ * and the next one is delivered as usual, so the outage is about one frame.
+ * The overflow is only counted in fifo_overflows and overflow_recoveries of
+ * @ref ifx_fmcw_get_statistics. If the device cannot recover in place, the
+ * error is reported as without recovery.
+ *
+ * @param[in] handle   A handle to the radar device object.
+ * @param[in] enabled  True to recover from overflows, false to report them (default).
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_overflow_recovery(ifx_Device_Fmcw_t* handle, bool enabled);
+
+/**
+ * @brief Returns whether FIFO overflows are recovered in place, see @ref ifx_fmcw_set_overflow_recovery.
+ *
+ * @param[in] handle  A handle to the radar device object.
+ * @return True if overflow recovery is enabled.
+ */
+IFX_DLL_PUBLIC
+bool ifx_fmcw_get_overflow_recovery(const ifx_Device_Fmcw_t* handle);
+
+/**
+ * @brief Returns the slice size in samples for the current acquisition sequence and policy.
+ *
+ * @param[in] handle  A handle to the radar device object.
+ * @return Number of samples per slice.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fmcw_get_slice_size(ifx_Device_Fmcw_t* handle);
+
 /**
  * @brief Retrieves the next frame of time domain data from a radar device.
  * (non-blocking).
@@ -660,6 +909,372 @@ void ifx_fmcw_get_next_raw_frame_timeout(ifx_Device_Fmcw_t* handle,
                                          ifx_Fmcw_Raw_Frame_t* frame,
                                          uint16_t timeout_ms);
 
+/**
+ * @brief Retrieves the next num_frames frames of time domain data.
+ *
+ * This is equivalent to calling @ref ifx_fmcw_get_next_frame_timeout for
+ * each element of frames, but lets language bindings fetch a batch of frames
+ * with a single call (and release their interpreter lock only once). If an
+ * error occurs, the function returns immediately and the frames after the
+ * failed one are left unchanged.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[out] frames      Array of num_frames frame structures, e.g. views of
+ *                         one contiguous block of memory.
+ * @param[in]  num_frames  Number of frames to retrieve.
+ * @param[in]  timeout_ms  The maximum period of time in milliseconds to wait
+ *                         for each frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_next_frames(ifx_Device_Fmcw_t* handle,
+                              ifx_Fmcw_Frame_t* frames,
+                              uint32_t num_frames,
+                              uint16_t timeout_ms);
+
+/**
+ * @brief Retrieves the next num_frames frames of raw time domain data.
+ *
+ * Like @ref ifx_fmcw_get_next_frames, but for raw frames as returned by
+ * @ref ifx_fmcw_get_next_raw_frame_timeout.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[out] frames      Array of num_frames raw frame structures.
+ * @param[in]  num_frames  Number of frames to retrieve.
+ * @param[in]  timeout_ms  The maximum period of time in milliseconds to wait
+ *                         for each frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_next_raw_frames(ifx_Device_Fmcw_t* handle,
+                                  ifx_Fmcw_Raw_Frame_t* frames,
+                                  uint32_t num_frames,
+                                  uint16_t timeout_ms);
+
+/**
+ * @brief Retrieves the next frame if one is available within a timeout.
+ *
+ * Like @ref ifx_fmcw_get_next_frame_timeout, but meant for event loops
+ * polling the device: if no complete frame arrives within *timeout_ms*, the
+ * function returns @ref IFX_ERROR_TIMEOUT without setting the error state,
+ * and without the overhead of an internal exception. A timeout of 0 only
+ * takes data which has already been received and never waits. As with
+ * @ref ifx_fmcw_get_next_frame_timeout, a frame interrupted by the timeout
+ * is continued by the next call.
+ *
+ * Here is a typical usage of this function:
+ * @code
+ *   while(1)
+ *   {
+ *       ifx_Error_t ret = ifx_fmcw_try_get_next_frame(device_handle, frame, 0);
+ *       if(ret == IFX_ERROR_TIMEOUT)
+ *           continue; // no frame yet, do something else
+ *       else if(ret != IFX_OK)
+ *           // error handling
+ *           break;
+ *
+ *       // process data
+ *   }
+ * @endcode
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[out] frame       The frame structure where the time domain data shall
+ *                         be copied to.
+ * @param[in]  timeout_ms  The maximum period of time in milliseconds to wait
+ *                         for the next frame, 0 to not wait at all.
+ * @return @ref IFX_OK if a frame was copied, @ref IFX_ERROR_TIMEOUT if no
+ *         frame was available. Other errors are also set as error state.
+ */
+IFX_DLL_PUBLIC
+ifx_Error_t ifx_fmcw_try_get_next_frame(ifx_Device_Fmcw_t* handle,
+                                        ifx_Fmcw_Frame_t* frame,
+                                        uint16_t timeout_ms);
+
+/**
+ * @brief Retrieves the next raw frame if one is available within a timeout.
+ *
+ * Like @ref ifx_fmcw_try_get_next_frame, but for raw frames as returned by
+ * @ref ifx_fmcw_get_next_raw_frame_timeout.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[out] frame       The raw frame structure where the time domain data
+ *                         shall be copied to.
+ * @param[in]  timeout_ms  The maximum period of time in milliseconds to wait
+ *                         for the next frame, 0 to not wait at all.
+ * @return @ref IFX_OK if a frame was copied, @ref IFX_ERROR_TIMEOUT if no
+ *         frame was available. Other errors are also set as error state.
+ */
+IFX_DLL_PUBLIC
+ifx_Error_t ifx_fmcw_try_get_next_raw_frame(ifx_Device_Fmcw_t* handle,
+                                            ifx_Fmcw_Raw_Frame_t* frame,
+                                            uint16_t timeout_ms);
+
+/**
+ * @brief Delivers frames to a callback as soon as they are complete (push).
+ *
+ * Instead of fetching frames with @ref ifx_fmcw_get_next_frame, the
+ * application hands a ring of preallocated frames (see
+ * @ref ifx_fmcw_allocate_frame) to the device. Each completed frame is
+ * deinterleaved into the next frame of the ring and passed to *callback*. The
+ * callback runs on the thread receiving the data from the board, so it should
+ * return quickly and must not call other functions of the device.
+ *
+ * A frame passed to the callback belongs to the application until it is
+ * returned with @ref ifx_fmcw_release_frame. If the next frame of the ring is
+ * still held by the application, the new frame is dropped and the callback is
+ * called with a NULL frame and @ref IFX_ERROR_FRAME_ACQUISITION_FAILED. Errors
+ * of the data transfer, e.g. @ref IFX_ERROR_FIFO_OVERFLOW, are reported the
+ * same way.
+ *
+ * The acquisition is stopped by this function and started with
+ * @ref ifx_fmcw_start_acquisition. While a callback is set,
+ * @ref ifx_fmcw_get_next_frame and @ref ifx_fmcw_get_next_raw_frame fail with
+ * @ref IFX_ERROR_NOT_POSSIBLE. Passing NULL as *callback* removes the callback.
+ * The frames of the ring must stay valid until the callback is removed or the
+ * device is destroyed.
+ *
+ * Only supported for connected boards, other devices report
+ * @ref IFX_ERROR_NOT_SUPPORTED.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[in]  frames      Array of num_frames frames forming the ring.
+ * @param[in]  num_frames  Number of frames in the ring.
+ * @param[in]  callback    Function called for each frame, or NULL.
+ * @param[in]  user_data   Pointer passed to the callback.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_frame_callback(ifx_Device_Fmcw_t* handle,
+                                 ifx_Fmcw_Frame_t** frames,
+                                 uint32_t num_frames,
+                                 ifx_Fmcw_Frame_Callback_t callback,
+                                 void* user_data);
+
+/**
+ * @brief Returns a frame to the ring.
+ *
+ * See @ref ifx_fmcw_set_frame_callback and @ref ifx_fmcw_acquire_frame.
+ *
+ * @param[in]  handle  A handle to the radar device object.
+ * @param[in]  frame   A frame received by the callback or returned by
+ *                     @ref ifx_fmcw_acquire_frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_release_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t* frame);
+
+/**
+ * @brief Sets the number of frames in the ring of @ref ifx_fmcw_acquire_frame.
+ *
+ * The frames are allocated by the device for the current acquisition
+ * sequence. Frames of a previous ring become invalid, even if they were not
+ * released yet. Without calling this function, a ring of two frames is
+ * created by the first call of @ref ifx_fmcw_acquire_frame.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[in]  num_frames  Number of frames in the ring.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_frame_ring_size(ifx_Device_Fmcw_t* handle, uint32_t num_frames);
+
+/**
+ * @brief Retrieves the next frame into a frame owned by the device.
+ *
+ * Works like @ref ifx_fmcw_get_next_frame_timeout, but the frame is taken
+ * from a ring of frames owned by the device (see
+ * @ref ifx_fmcw_set_frame_ring_size), so no frame needs to be allocated by the
+ * application. The frame belongs to the application until it is returned with
+ * @ref ifx_fmcw_release_frame. If all frames of the ring are held by the
+ * application, @ref IFX_ERROR_NOT_POSSIBLE is reported.
+ *
+ * After the acquisition sequence has been changed, the frames are reallocated
+ * by the next call once all of them have been released; until then
+ * @ref IFX_ERROR_DIMENSION_MISMATCH is reported.
+ *
+ * @code
+ *   while(1)
+ *   {
+ *       ifx_Fmcw_Frame_t* frame = ifx_fmcw_acquire_frame(device_handle, 1000);
+ *       if(frame == NULL)
+ *           break; // error handling, see ifx_error_get
+ *
+ *       // process data
+ *       // ...
+ *       ifx_fmcw_release_frame(device_handle, frame);
+ *   }
+ * @endcode
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[in]  timeout_ms  Timeout in milliseconds.
+ *
+ * @return The frame or NULL in case of an error.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Frame_t* ifx_fmcw_acquire_frame(ifx_Device_Fmcw_t* handle, uint16_t timeout_ms);
+
+/**
+ * @brief Requests the next frame without waiting for it.
+ *
+ * The request is queued and the function returns at once. When the next
+ * frame is complete it is deinterleaved into *frame* and *callback* is
+ * called with @ref IFX_OK; a frame lost on the way (e.g.
+ * @ref IFX_ERROR_FIFO_OVERFLOW) completes the request with that error.
+ * Requests complete one per frame, in the order they were made, so a service
+ * driving many devices needs no thread per device: it keeps one or more
+ * requests pending per device and reacts to the callbacks. A frame arriving
+ * while no request is pending is dropped (see @ref ifx_fmcw_get_statistics),
+ * so keep a second request queued to receive every frame.
+ *
+ * The callback runs on the thread receiving the data from the board, so it
+ * should return quickly, e.g. by handing the frame to an executor with
+ * @ref ifx_executor_post. It may queue the next request, but must not call
+ * other functions of the device. The C++ header
+ * ifxRadarDeviceCommon/Async.hpp wraps requests into awaitables for C++20
+ * coroutines.
+ *
+ * The first request switches the device to asynchronous delivery and starts
+ * the acquisition, restarting a running one. Stopping the acquisition keeps
+ * the pending requests, @ref ifx_fmcw_start_acquisition continues serving
+ * them. Until @ref ifx_fmcw_cancel_async,
+ * @ref ifx_fmcw_get_next_frame and the other blocking functions fail with
+ * @ref IFX_ERROR_NOT_POSSIBLE, as does this function while
+ * @ref ifx_fmcw_set_frame_callback is active. Only supported for connected
+ * boards, other devices report @ref IFX_ERROR_NOT_SUPPORTED.
+ *
+ * @code
+ *   static void on_frame(ifx_Fmcw_Frame_t* frame, ifx_Error_t error, void* user_data)
+ *   {
+ *       ifx_Device_Fmcw_t* device = user_data;
+ *       if(error == IFX_ERROR_ABORTED)
+ *           return;
+ *       // process data, or post it to an executor
+ *       // ...
+ *       ifx_fmcw_get_next_frame_async(device, frame, on_frame, device);
+ *   }
+ *
+ *   ifx_fmcw_get_next_frame_async(device_handle, frame_a, on_frame, device_handle);
+ *   ifx_fmcw_get_next_frame_async(device_handle, frame_b, on_frame, device_handle);
+ * @endcode
+ *
+ * @param[in]  handle     A handle to the radar device object.
+ * @param[in]  frame      Frame to fill, see @ref ifx_fmcw_allocate_frame. It
+ *                        must stay valid until the request is completed.
+ * @param[in]  callback   Function completing the request.
+ * @param[in]  user_data  Pointer passed to the callback.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_next_frame_async(ifx_Device_Fmcw_t* handle,
+                                   ifx_Fmcw_Frame_t* frame,
+                                   ifx_Fmcw_Async_Callback_t callback,
+                                   void* user_data);
+
+/**
+ * @brief Cancels all pending requests of @ref ifx_fmcw_get_next_frame_async.
+ *
+ * Stops the acquisition and completes every pending request with
+ * @ref IFX_ERROR_ABORTED on the calling thread before returning. Afterwards
+ * the blocking functions can be used again. Destroying the device cancels
+ * the requests the same way.
+ *
+ * @param[in]  handle  A handle to the radar device object.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_cancel_async(ifx_Device_Fmcw_t* handle);
+
+/**
+ * @brief Reads the counters of the data received from the board.
+ *
+ * The counters help dimensioning the data path, e.g. a growing number of
+ * pool depletions or queue trims indicates that frames are not fetched fast
+ * enough. They are updated while frames are retrieved, so they can be read at
+ * any time. Devices which do not receive data from a board report zeros.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ * @param[out] statistics  The current counters.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_statistics(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Statistics_t* statistics);
+
+/**
+ * @brief Resets the counters of @ref ifx_fmcw_get_statistics to zero.
+ *
+ * @param[in]  handle      A handle to the radar device object.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_reset_statistics(ifx_Device_Fmcw_t* handle);
+
+/**
+ * @brief Reads the time spent in the steps of opening the device.
+ *
+ * Helps to find out where the time goes when devices are opened often, e.g.
+ * by services restarting. The detection of the reference clock usually
+ * dominates. It is skipped for boards found in the reference clock cache,
+ * see @ref ifx_fmcw_set_reference_clock_cache.
+ *
+ * @param[in]  handle  A handle to the radar device object.
+ * @param[out] timing  The time of each step.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_open_timing(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Open_Timing_t* timing);
+
+/**
+ * @brief Keeps the detected reference clocks of boards in a file.
+ *
+ * Opening a board with an Avian sensor measures the frequency of its
+ * reference clock, which resets the sensor several times. The result is
+ * remembered per board UUID for the lifetime of the process, so opening the
+ * same board again skips the measurement. With a cache file the results also
+ * survive the process: the entries of the file are loaded now, and every new
+ * measurement rewrites the file. An entry is only used if the sensor type and
+ * the firmware version of the board still match, otherwise the clock is
+ * measured again.
+ *
+ * Delete the file if the oscillator of a board is changed without changing
+ * the firmware.
+ *
+ * @param[in]  filename  Cache file, created if it does not exist. NULL stops
+ *                       writing a file, the results of this process are kept.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_reference_clock_cache(const char* filename);
+
+/**
+ * @brief Sets the scheduling of a group of internal threads.
+ *
+ * The settings are process wide and apply to the threads of the group
+ * started afterwards. The threads reading from the board are started with
+ * each acquisition, so set them before @ref ifx_fmcw_start_acquisition. If
+ * the CPU is saturated by the processing of the application, pinning the
+ * data threads to a reserved core or giving them a real-time priority
+ * avoids frames lost because the frame pool depleted.
+ *
+ * Settings that cannot be applied, e.g. a real-time class without the
+ * permission (CAP_SYS_NICE or RLIMIT_RTPRIO on Linux), are logged and the
+ * thread continues with the default scheduling.
+ *
+ * @param[in] role    The group of threads.
+ * @param[in] config  The scheduling settings.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_thread_config(ifx_Fmcw_Thread_Role_t role, const ifx_Fmcw_Thread_Config_t* config);
+
+/**
+ * @brief Reads the scheduling of a group of internal threads, see @ref ifx_fmcw_set_thread_config.
+ *
+ * @param[in]  role    The group of threads.
+ * @param[out] config  The scheduling settings.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_thread_config(ifx_Fmcw_Thread_Role_t role, ifx_Fmcw_Thread_Config_t* config);
+
+/**
+ * @brief Sets the prefix of the names of internal threads.
+ *
+ * Threads are named "<prefix>-<name>" (e.g. "strata-usb"), shortened to 15
+ * characters, as shown by top -H or a debugger. The default prefix is
+ * "strata".
+ *
+ * @param[in] prefix  The prefix, NULL or "" for no prefix.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_set_thread_name_prefix(const char* prefix);
+
 /**
  * @brief Allocates a frame structure.
  *
@@ -719,6 +1334,28 @@ void ifx_fmcw_destroy_raw_frame(ifx_Fmcw_Raw_Frame_t* frame);
 IFX_DLL_PUBLIC
 const char* ifx_fmcw_get_board_uuid(const ifx_Device_Fmcw_t* handle);
 
+/**
+ * @brief Reads from an I2C EEPROM of the board.
+ *
+ * Boards keep data like the RX calibration of the RF shield (see
+ * \ref ifx_rx_calibration_decode) in an EEPROM. The EEPROM is read through
+ * the bridge of the board, while an acquisition is running this competes
+ * with the data transfer.
+ *
+ * If the device has no board (e.g. playback or synthetic devices),
+ * IFX_ERROR_NOT_SUPPORTED is set. If the EEPROM cannot be accessed,
+ * IFX_ERROR_EEPROM is set.
+ *
+ * @param[in]  handle   A handle to the radar device object.
+ * @param[in]  eeprom   Description of the EEPROM.
+ * @param[in]  address  Address of the first byte to read.
+ * @param[in]  length   Number of bytes to read.
+ * @param[out] buffer   Buffer of at least length bytes.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_read_eeprom(ifx_Device_Fmcw_t* handle, const ifx_Fmcw_Eeprom_Config_t* eeprom,
+                          uint32_t address, uint32_t length, uint8_t* buffer);
+
 /**
  * @brief Get information about the sensor on the connected device.
  *
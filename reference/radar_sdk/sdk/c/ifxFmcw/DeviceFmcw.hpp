@@ -42,21 +42,59 @@
 #include <vector>
 
 
+/* Position of the cubes of ifx_Fmcw_Frame_t in a raw frame: sample s of
+ * antenna rx in chirp c of a cube is at offset + c * chirp_step + s * num_rx + rx
+ * and converts to raw * scale - 1 like convert_raw_data_to_float_array().
+ */
+struct FmcwRawFrameLayout
+{
+    struct Cube
+    {
+        uint32_t num_rx;
+        uint32_t num_chirps;
+        uint32_t num_samples;
+        size_t offset;
+        size_t chirp_step;
+    };
+
+    std::vector<Cube> cubes;
+    uint32_t num_samples;  // of the raw frame
+    ifx_Float_t scale;
+};
+
 struct DeviceFmcw
 {
     /* These abstract virtual member functions are implemented in the base class */
     virtual ~DeviceFmcw() = default;
     virtual const char* get_board_uuid() const = 0;
+    virtual void read_eeprom(const ifx_Fmcw_Eeprom_Config_t* eeprom, uint32_t address, uint32_t length, uint8_t* buffer) = 0;
     virtual const ifx_Firmware_Info_t* get_firmware_info() const = 0;
     virtual const ifx_Radar_Sensor_Info_t* get_sensor_info() const = 0;
     virtual ifx_Radar_Sensor_t get_sensor_type() const = 0;
     virtual void get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms) = 0;
     virtual void get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) = 0;
+    virtual void get_next_frames(ifx_Fmcw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms) = 0;
+    virtual void get_next_raw_frames(ifx_Fmcw_Raw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms) = 0;
+    /* Like get_next_frame() and get_next_raw_frame(), but return false instead
+     * of throwing a timeout if no frame arrived within timeout_ms (0 only polls).
+     */
+    virtual bool try_get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms) = 0;
+    virtual bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) = 0;
+    virtual void set_frame_callback(ifx_Fmcw_Frame_t** frames, uint32_t num_frames, ifx_Fmcw_Frame_Callback_t callback, void* user_data) = 0;
+    virtual void release_frame(ifx_Fmcw_Frame_t* frame) = 0;
+    virtual void set_frame_ring_size(uint32_t num_frames) = 0;
+    virtual ifx_Fmcw_Frame_t* acquire_frame(uint16_t timeout_ms) = 0;
+    virtual void get_next_frame_async(ifx_Fmcw_Frame_t* frame, ifx_Fmcw_Async_Callback_t callback, void* user_data) = 0;
+    virtual void cancel_async() = 0;
+    virtual void get_statistics(ifx_Fmcw_Statistics_t* statistics) const = 0;
+    virtual void reset_statistics() = 0;
+    virtual void get_open_timing(ifx_Fmcw_Open_Timing_t* timing) const = 0;
     virtual ifx_Fmcw_Frame_t* allocate_frame() = 0;
     virtual ifx_Fmcw_Raw_Frame_t* allocate_raw_frame() = 0;
     virtual void convert_raw_data_to_float_array(uint32_t num_samples, const uint16_t* raw_data, ifx_Float_t* converted_frame) = 0;
     virtual void deinterleave_raw_frame(const ifx_Fmcw_Raw_Frame_t* raw_frame, ifx_Fmcw_Raw_Frame_t* deinterleaved_frame) = 0;
     virtual void view_deinterleaved_frame(ifx_Float_t* converted_frame, ifx_Fmcw_Frame_t* deinterleaved_frame_view) = 0;
+    virtual void get_raw_frame_layout(FmcwRawFrameLayout& layout) = 0;
     virtual float get_element_duration(const ifx_Fmcw_Sequence_Element_t* element) const = 0;
     virtual float get_sequence_duration(const ifx_Fmcw_Sequence_Element_t* sequence) const = 0;
 
@@ -71,8 +109,17 @@ struct DeviceFmcw
     virtual void stop_acquisition() = 0;
     virtual void start_acquisition() = 0;
 
+    virtual void set_acquisition_policy(ifx_Fmcw_Acquisition_Policy_t policy, uint32_t slice_size) = 0;
+    virtual ifx_Fmcw_Acquisition_Policy_t get_acquisition_policy() const = 0;
+    virtual uint32_t get_slice_size() = 0;
+
+    virtual void set_overflow_recovery(bool enabled) = 0;
+    virtual bool get_overflow_recovery() const = 0;
+
     virtual void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) = 0;
     virtual ifx_Fmcw_Sequence_Element_t* get_acquisition_sequence() const = 0;
+    virtual void check_acquisition_sequences(const ifx_Fmcw_Sequence_Element_t* const* sequences, uint32_t num_sequences,
+                                             ifx_Error_t* errors, float* durations) const = 0;
 
     virtual std::map<uint16_t, uint32_t>& get_register_list() = 0;
     virtual void apply_register_list(const std::map<uint16_t, uint32_t>& register_list) = 0;
@@ -82,6 +129,7 @@ struct DeviceFmcw
 
     virtual void load_register_file(const char* filename) = 0;
     virtual void save_register_file(const char* filename) = 0;
+    virtual void save_register_profile(const char* filename) = 0;
 };
 
 
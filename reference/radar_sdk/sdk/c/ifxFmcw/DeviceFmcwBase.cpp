@@ -34,14 +34,23 @@
 */
 
 #include "DeviceFmcwBase.hpp"
+#include "ifxBase/internal/GatherPlan.hpp"
 #include "ifxBase/internal/Util.h"  // for ifx_util_popcount
+#include "ifxBase/Mem.h"
+
 
 // Universal
 #include <universal/error_definitions.h>
 #include <universal/types/DataSettingsBgtRadar.h>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <common/Buffer.hpp>
+#include <common/Packed12.hpp>
+#include <common/Profiler.hpp>
+#include <components/nonvolatileMemory/NonvolatileMemoryEepromI2c.hpp>
+#include <limits>
 #include <stack>
 
 
@@ -58,6 +67,27 @@ constexpr float slice_rate_threshold = 20.0f;  // 20 slices per second
 
 constexpr float seconds_to_buffer = 10.0f;
 
+// Number of frames of the ring created by the first call of acquire_frame
+constexpr uint32_t default_frame_ring_size = 2;
+
+// Maps the status of a slice from the bridge to the error reported for the frame
+ifx_Error_t slice_error_code(uint32_t status)
+{
+    switch (status)
+    {
+        case DataError_FrameDropped:
+        case DataError_FramePoolDepleted:
+        case DataError_FrameQueueTrimmed:
+            return IFX_ERROR_FRAME_ACQUISITION_FAILED;
+        case DataError_FrameSizeExceeded:
+            return IFX_ERROR_FRAME_SIZE_NOT_SUPPORTED;
+        case E_OVERFLOW:
+            return IFX_ERROR_FIFO_OVERFLOW;
+        default:
+            return IFX_ERROR;
+    }
+}
+
 }  // namespace
 
 /*
@@ -81,7 +111,10 @@ DeviceFmcwBase::DeviceFmcwBase(ifx_Float_t max_adc_value, std::unique_ptr<BoardI
         throw rdk::exception::no_device();
     }
 
+    const auto start = std::chrono::steady_clock::now();
     rdk::RadarDeviceCommon::get_firmware_info(m_board.get(), &m_firmware_info);
+    m_open_timing.firmware_s = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    m_open_timing.total_s = m_open_timing.firmware_s;
 
     /* Initialize data component related member variables */
     m_data_index = 0;
@@ -89,6 +122,16 @@ DeviceFmcwBase::DeviceFmcwBase(ifx_Float_t max_adc_value, std::unique_ptr<BoardI
     m_bridge_data = m_board->getIBridge()->getIBridgeData();
 }
 
+DeviceFmcwBase::~DeviceFmcwBase()
+{
+    // the derived class has stopped the acquisition already
+    if (m_frame_callback || m_async)
+    {
+        m_bridge_data->registerListener(nullptr);
+    }
+    abort_async_requests();
+}
+
 uint16_t DeviceFmcwBase::calculate_slice_size(uint32_t fifo_size) const
 {
     if (m_num_samples == 0)
@@ -96,6 +139,16 @@ uint16_t DeviceFmcwBase::calculate_slice_size(uint32_t fifo_size) const
         throw rdk::exception::num_samples_out_of_range();
     }
 
+    if (m_acquisition_policy == IFX_FMCW_ACQUISITION_SLICE_SIZE)
+    {
+        // the driver rejects slices larger than the FIFO
+        if (m_explicit_slice_size > fifo_size)
+        {
+            throw rdk::exception::frame_size_not_supported();
+        }
+        return static_cast<uint16_t>(m_explicit_slice_size);
+    }
+
     // Take half the FIFO size as a hard cap to have enough buffer to
     // prevent FIFO overflows in the Avian sensor.
     // The Avian sensor will trigger an interrupt if there are at least
@@ -106,7 +159,28 @@ uint16_t DeviceFmcwBase::calculate_slice_size(uint32_t fifo_size) const
     const uint32_t max_slice_size = fifo_size / 2;
 
     // Determine how many slices are needed for one frame
-    const auto num_slices_per_frame = (m_num_samples + (max_slice_size - 1)) / max_slice_size;
+    auto num_slices_per_frame = (m_num_samples + (max_slice_size - 1)) / max_slice_size;
+
+    if (m_acquisition_policy == IFX_FMCW_ACQUISITION_FRAME_ALIGNED)
+    {
+        if (num_slices_per_frame != 1)
+        {
+            throw rdk::exception::frame_size_not_supported();
+        }
+        return static_cast<uint16_t>(m_num_samples);
+    }
+
+    if (m_acquisition_policy == IFX_FMCW_ACQUISITION_MIN_LATENCY)
+    {
+        // The last slice of a frame must end with the frame, otherwise the
+        // frame waits for the samples of the next one. Use the fewest slices
+        // that split the frame evenly.
+        while (m_num_samples % num_slices_per_frame)
+        {
+            num_slices_per_frame++;
+        }
+        return static_cast<uint16_t>(m_num_samples / num_slices_per_frame);
+    }
 
     uint32_t slice_size = m_num_samples / num_slices_per_frame;
 
@@ -129,6 +203,47 @@ uint16_t DeviceFmcwBase::calculate_slice_size(uint32_t fifo_size) const
     return slice_size;
 }
 
+void DeviceFmcwBase::set_acquisition_policy(ifx_Fmcw_Acquisition_Policy_t policy, uint32_t slice_size)
+{
+    switch (policy)
+    {
+        case IFX_FMCW_ACQUISITION_MAX_THROUGHPUT:
+        case IFX_FMCW_ACQUISITION_MIN_LATENCY:
+        case IFX_FMCW_ACQUISITION_FRAME_ALIGNED:
+            break;
+        case IFX_FMCW_ACQUISITION_SLICE_SIZE:
+            if (slice_size == 0 || slice_size > std::numeric_limits<uint16_t>::max())
+            {
+                throw rdk::exception::argument_out_of_bounds();
+            }
+            break;
+        default:
+            throw rdk::exception::argument_invalid();
+    }
+
+    // the slice size is programmed when the acquisition starts, the next
+    // frame fetched restarts it
+    stop_acquisition();
+
+    m_acquisition_policy = policy;
+    m_explicit_slice_size = (policy == IFX_FMCW_ACQUISITION_SLICE_SIZE) ? slice_size : 0;
+}
+
+ifx_Fmcw_Acquisition_Policy_t DeviceFmcwBase::get_acquisition_policy() const
+{
+    return m_acquisition_policy;
+}
+
+void DeviceFmcwBase::set_overflow_recovery(bool enabled)
+{
+    m_overflow_recovery = enabled;
+}
+
+bool DeviceFmcwBase::get_overflow_recovery() const
+{
+    return m_overflow_recovery;
+}
+
 const ifx_Firmware_Info_t* DeviceFmcwBase::get_firmware_info() const
 {
     return &m_firmware_info;
@@ -150,27 +265,93 @@ const char* DeviceFmcwBase::get_board_uuid() const
     return m_board->getUuidString().c_str();
 }
 
+void DeviceFmcwBase::read_eeprom(const ifx_Fmcw_Eeprom_Config_t* eeprom, uint32_t address, uint32_t length, uint8_t* buffer)
+{
+    if ((eeprom == nullptr) || ((buffer == nullptr) && (length > 0)))
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    if (!m_board)
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    auto* i2c = m_board->getIBridge()->getIBridgeControl()->getII2c();
+    if (i2c == nullptr)
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    if ((uint64_t(address) + length) > eeprom->total_size)
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+
+    try
+    {
+        // only reads are done, so segments and sectors are not needed
+        const NonvolatileMemoryConfig_t config = {eeprom->total_size, 0, eeprom->page_size, 0, 0};
+        NonvolatileMemoryEepromI2c memory(i2c, eeprom->i2c_address, eeprom->address_bytes, config);
+        memory.readRandom(address, length, buffer);
+    }
+    catch (const EException&)
+    {
+        throw rdk::exception::error_eeprom();
+    }
+}
+
 ifx_Fmcw_Frame_t* DeviceFmcwBase::allocate_frame()
 {
     update_defaults_if_not_configured();
 
-    auto* frame = new ifx_Fmcw_Frame_t;
-    if (!frame)
+    // The frame, the cube pointers, and the structure and data of each cube
+    // are allocated as one block, see Fmcw::destroy_frame.
+    const auto num_cubes = static_cast<uint32_t>(m_frame_dimensions.size());
+    const size_t cube_header = IFX_ALIGN(sizeof(ifx_Mda_R_t), IFX_MEMORY_ALIGNMENT);
+
+    size_t size = IFX_ALIGN(sizeof(ifx_Fmcw_Frame_t) + num_cubes * sizeof(ifx_Mda_R_t*), IFX_MEMORY_ALIGNMENT);
+    for (const auto& dimensions : m_frame_dimensions)
     {
-        throw rdk::exception::memory_allocation_failed();
+        size_t elements = 1;
+        for (const auto d : dimensions)
+            elements *= d;
+        size += cube_header + IFX_ALIGN(elements * sizeof(ifx_Float_t), IFX_MEMORY_ALIGNMENT);
     }
 
-    frame->num_cubes = static_cast<uint32_t>(m_frame_dimensions.size());
-    frame->cubes = new ifx_Mda_R_t*[frame->num_cubes];
-    if (frame->cubes == nullptr)
+    auto* block = static_cast<uint8_t*>(ifx_mem_aligned_alloc(size, IFX_MEMORY_ALIGNMENT));
+    if (!block)
     {
-        delete frame;
         throw rdk::exception::memory_allocation_failed();
     }
 
-    for (size_t i = 0; i < frame->num_cubes; i++)
+    auto* frame = reinterpret_cast<ifx_Fmcw_Frame_t*>(block);
+    frame->num_cubes = num_cubes;
+    frame->cubes = reinterpret_cast<ifx_Mda_R_t**>(block + sizeof(ifx_Fmcw_Frame_t));
+    frame->timestamp_device_us = 0;
+    frame->timestamp_received_us = 0;
+    frame->timestamp_delivered_us = 0;
+
+    size_t offset = IFX_ALIGN(sizeof(ifx_Fmcw_Frame_t) + num_cubes * sizeof(ifx_Mda_R_t*), IFX_MEMORY_ALIGNMENT);
+    for (uint32_t i = 0; i < num_cubes; i++)
     {
-        frame->cubes[i] = ifx_mda_create_r(static_cast<uint32_t>(m_frame_dimensions[i].size()), m_frame_dimensions[i].data());
+        const auto& dimensions = m_frame_dimensions[i];
+        const auto num_dimensions = static_cast<uint32_t>(dimensions.size());
+
+        std::array<size_t, IFX_MDA_MAX_DIM> stride;
+        size_t elements = 1;
+        for (uint32_t k = num_dimensions; k > 0; k--)
+        {
+            stride[k - 1] = elements;
+            elements *= dimensions[k - 1];
+        }
+
+        auto* cube = reinterpret_cast<ifx_Mda_R_t*>(block + offset);
+        auto* data = reinterpret_cast<ifx_Float_t*>(block + offset + cube_header);
+        ifx_mda_rawview_r(cube, data, num_dimensions, dimensions.data(), stride.data(), 0);
+        frame->cubes[i] = cube;
+
+        offset += cube_header + IFX_ALIGN(elements * sizeof(ifx_Float_t), IFX_MEMORY_ALIGNMENT);
     }
 
     return frame;
@@ -180,7 +361,7 @@ ifx_Fmcw_Raw_Frame_t* DeviceFmcwBase::allocate_raw_frame()
 {
     update_defaults_if_not_configured();
 
-    auto* raw_frame = new ifx_Fmcw_Raw_Frame_t;
+    auto* raw_frame = new ifx_Fmcw_Raw_Frame_t();
     if (raw_frame == nullptr)
     {
         throw rdk::exception::memory_allocation_failed();
@@ -198,6 +379,12 @@ ifx_Fmcw_Raw_Frame_t* DeviceFmcwBase::allocate_raw_frame()
 
 void DeviceFmcwBase::start_data()
 {
+    if (m_frame_callback || m_async)
+    {
+        m_stream_samples.resize(m_num_samples);
+        m_stream_bytes = 0;
+        m_stream_count = 0;
+    }
     m_data->start(m_data_index);
     m_bridge_data->startStreaming();
 }
@@ -207,6 +394,8 @@ void DeviceFmcwBase::stop_data()
     m_data->stop(m_data_index);
     m_bridge_data->stopStreaming();
     m_slice.reset();
+    m_partial_bytes = 0;
+    m_partial_samples = 0;
 }
 
 void DeviceFmcwBase::configure_data(uint16_t slice_size, uint16_t readout_address, uint8_t data_format)
@@ -243,11 +432,7 @@ uint32_t DeviceFmcwBase::copy_slice_data(uint8_t data_format, const uint8_t* buf
         case DataFormat_Packed12:
             num_samples = buffer_length / 3 * 2;
             // unpack each 12-bit sample into a 16-bit word
-            for (size_t i = 0; i < num_samples / 2; i++)
-            {
-                *output++ = (buffer[3 * i + 0] << 4) | (buffer[3 * i + 1] >> 4);
-                *output++ = ((buffer[3 * i + 1] & 0x0f) << 8) | buffer[3 * i + 2];
-            }
+            unpackPacked12(buffer, buffer + num_samples / 2 * 3, output);
             break;
         case DataFormat_Raw16:
             num_samples = buffer_length / 2;
@@ -264,8 +449,49 @@ uint32_t DeviceFmcwBase::copy_slice_data(uint8_t data_format, const uint8_t* buf
     return num_samples;
 }
 
+uint32_t DeviceFmcwBase::copy_slice_data(uint8_t data_format, const uint8_t* buffer, uint32_t buffer_length, ifx_Float_t* output)
+{
+    STRATA_TRACE_SCOPE("fmcw.slice_conversion");
+
+    // same conversion as in convert_raw_data_to_float_array(), done while unpacking
+    const auto scale = 2.0f / m_max_adc_value;
+
+    uint32_t num_samples;
+    switch (data_format)
+    {
+        case DataFormat_Packed12:
+            num_samples = buffer_length / 3 * 2;
+            unpackPacked12(buffer, buffer + num_samples / 2 * 3, output, scale, -1.0f);
+            break;
+        case DataFormat_Raw16:
+            num_samples = buffer_length / 2;
+            {
+                const auto* source = reinterpret_cast<const uint16_t*>(buffer);
+                for (uint32_t i = 0; i < num_samples; i++)
+                {
+                    output[i] = static_cast<ifx_Float_t>(source[i]) * scale - 1.0f;
+                }
+            }
+            break;
+        default:
+            throw rdk::exception::argument_invalid();
+            break;
+    }
+    return num_samples;
+}
+
 void DeviceFmcwBase::get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms)
 {
+    if (!try_get_next_frame(frame, timeout_ms))
+    {
+        throw rdk::exception::timeout();
+    }
+}
+
+bool DeviceFmcwBase::try_get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms)
+{
+    STRATA_TRACE_SCOPE("fmcw.get_next_frame");
+
     if (frame == nullptr)
     {
         throw rdk::exception::argument_null();
@@ -278,18 +504,32 @@ void DeviceFmcwBase::get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms
 
     start_acquisition();
 
-    SmartFmcwRawFrame raw_frame(allocate_raw_frame());
-    get_next_raw_frame(raw_frame.get(), timeout_ms);
+    update_defaults_if_not_configured();
+    m_normalized_samples.resize(m_num_samples);
+    if (!get_next_normalized_frame(m_normalized_samples.data(), timeout_ms))
+    {
+        return false;
+    }
+
+    deinterleave_frame(m_normalized_samples.data(), frame);
+    stamp_frame(frame);
+    return true;
+}
+
+void DeviceFmcwBase::deinterleave_frame(const ifx_Float_t* samples, ifx_Fmcw_Frame_t* frame)
+{
+    STRATA_TRACE_SCOPE("fmcw.cube_conversion");
 
-    const auto* raw_data = raw_frame->samples;
-    auto** cubes = frame->cubes;
+    const auto* raw_data = samples;
     const auto cube_offset = frame->num_cubes - 1;
-    for (const auto& d : m_frame_dimensions)
+    m_cube_plans.resize(m_frame_dimensions.size());
+    for (size_t i = 0; i < m_frame_dimensions.size(); i++)
     {
+        const auto& d = m_frame_dimensions[i];
         const auto num_rx = d[0];
         const auto num_chirps = d[1];
         const auto num_samples_per_chirp = d[2];
-        const auto* cube = *cubes++;
+        auto* cube = frame->cubes[i];
         const auto* shape = IFX_MDA_SHAPE(cube);
         // check if dimensions of given and expected cube are the same
         if ((IFX_MDA_DIMENSIONS(cube) != 3)
@@ -300,38 +540,107 @@ void DeviceFmcwBase::get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms
             throw rdk::exception::dimension_mismatch();
         }
 
+        // the layout only changes with the configuration or the cube strides,
+        // so the plan is normally built once and reused for every frame
+        const auto* stride = IFX_MDA_STRIDE(cube);
+        auto& cube_plan = m_cube_plans[i];
+        const std::array<size_t, 3> cube_stride = {stride[0], stride[1], stride[2]};
+        if (cube_plan.plan.empty() || (cube_plan.dimensions != d) || (cube_plan.stride != cube_stride)
+            || (cube_plan.cube_offset != cube_offset) || (cube_plan.mimo != m_mimo))
+        {
+            cube_plan.dimensions = d;
+            cube_plan.stride = cube_stride;
+            cube_plan.cube_offset = cube_offset;
+            cube_plan.mimo = m_mimo;
+            build_cube_plan(cube_plan);
+        }
+        cube_plan.plan.run(raw_data, IFX_MDA_DATA(cube));
+
         // the outer loop assumes a flat (non-nested) chirp structure,
         // where all chirps have the same settings.
         // However, this is only guaranteed when using the legacy API
         const auto chirp_offset = num_rx * num_samples_per_chirp;
-        const auto* cube_data = raw_data;
-        for (uint32_t chirp = 0; chirp < num_chirps; chirp++)                    // slices
-        {
-            for (uint32_t sample = 0; sample < num_samples_per_chirp; sample++)  // rows
-            {
-                for (uint32_t rx = 0; rx < num_rx; rx++)                         // columns
-                {
-                    IFX_MDA_AT(cube, rx, chirp, sample) = static_cast<ifx_Float_t>(*cube_data++ * 2) / m_max_adc_value - 1.0f;
-                }
-            }
-            if (m_mimo)
-            {
-                cube_data += cube_offset * chirp_offset;
-            }
-        }
         if (m_mimo)
         {
             raw_data += chirp_offset;
         }
         else
         {
-            raw_data = cube_data;
+            raw_data += num_chirps * chirp_offset;
+        }
+    }
+}
+
+void DeviceFmcwBase::build_cube_plan(CubePlan& cube_plan)
+{
+    const auto num_rx = cube_plan.dimensions[0];
+    const auto num_chirps = cube_plan.dimensions[1];
+    const auto num_samples_per_chirp = cube_plan.dimensions[2];
+    const auto& stride = cube_plan.stride;
+
+    // the samples of a chirp are interleaved as num_samples x num_rx, with MIMO
+    // the chirps of the other cubes are in between
+    const size_t chirp_offset = size_t(num_rx) * num_samples_per_chirp;
+    const size_t chirp_step = cube_plan.mimo ? (cube_plan.cube_offset + 1) * chirp_offset : chirp_offset;
+
+    auto& plan = cube_plan.plan;
+    plan.clear();
+    for (uint32_t chirp = 0; chirp < num_chirps; chirp++)
+    {
+        const size_t src = chirp * chirp_step;
+        if (stride[2] == 1)
+        {
+            // write the chirp of each antenna as a whole row
+            const auto block = plan.add_block(src, num_rx, num_samples_per_chirp);
+            for (uint32_t rx = 0; rx < num_rx; rx++)
+                plan.set_destination(block, rx, rx * stride[0] + chirp * stride[1]);
+        }
+        else
+        {
+            // samples are not contiguous in the cube, one block per sample
+            for (uint32_t sample = 0; sample < num_samples_per_chirp; sample++)
+            {
+                const auto block = plan.add_block(src + size_t(sample) * num_rx, num_rx, 1);
+                for (uint32_t rx = 0; rx < num_rx; rx++)
+                    plan.set_destination(block, rx, rx * stride[0] + chirp * stride[1] + sample * stride[2]);
+            }
         }
     }
+    plan.optimize();
+}
+
+void DeviceFmcwBase::get_raw_frame_layout(FmcwRawFrameLayout& layout)
+{
+    update_defaults_if_not_configured();
+
+    layout.num_samples = m_num_samples;
+    layout.scale = 2.0f / m_max_adc_value;
+    layout.cubes.clear();
+
+    // the same layout deinterleave_frame() reads
+    const size_t num_cubes = m_frame_dimensions.size();
+    size_t offset = 0;
+    for (const auto& d : m_frame_dimensions)
+    {
+        const size_t chirp_offset = size_t(d[0]) * d[2];
+        const size_t chirp_step = m_mimo ? num_cubes * chirp_offset : chirp_offset;
+        layout.cubes.push_back({d[0], d[1], d[2], offset, chirp_step});
+        offset += m_mimo ? chirp_offset : d[1] * chirp_offset;
+    }
 }
 
 void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
 {
+    if (!try_get_next_raw_frame(frame, timeout_ms))
+    {
+        throw rdk::exception::timeout();
+    }
+}
+
+bool DeviceFmcwBase::try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    STRATA_TRACE_SCOPE("fmcw.get_next_raw_frame");
+
     if (frame == nullptr)
     {
         throw rdk::exception::argument_null();
@@ -344,56 +653,133 @@ void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t ti
 
     start_acquisition();
 
-    uint16_t* frame_ptr = frame->samples;
-    auto remaining_bytes = m_frame_length;
+    if (!read_frame_samples(frame->samples, timeout_ms))
+    {
+        return false;
+    }
+    stamp_frame(frame);
+    return true;
+}
+
+void DeviceFmcwBase::get_next_frames(ifx_Fmcw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms)
+{
+    if ((frames == nullptr) && (num_frames > 0))
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        get_next_frame(&frames[i], timeout_ms);
+    }
+}
+
+void DeviceFmcwBase::get_next_raw_frames(ifx_Fmcw_Raw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms)
+{
+    if ((frames == nullptr) && (num_frames > 0))
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        get_next_raw_frame(&frames[i], timeout_ms);
+    }
+}
+
+bool DeviceFmcwBase::get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms)
+{
+    return read_frame_samples(samples, timeout_ms);
+}
+
+template <typename T>
+bool DeviceFmcwBase::read_frame_samples(T* output, uint16_t timeout_ms)
+{
+    if (m_frame_callback || m_async)
+    {
+        // frames are pushed to the callback, see set_frame_callback() and
+        // get_next_frame_async()
+        throw rdk::exception::not_possible();
+    }
+
+    // A timeout in the middle of a frame keeps what has been read so far, and the next call continues
+    // the frame. If the next call reads into another buffer, the rest of the frame is still read to keep
+    // the frame boundaries, but the incomplete frame is reported as lost.
+    bool resumed_elsewhere = m_partial_bytes && (m_partial_output != output);
+    T* frame_ptr = output + m_partial_samples;
+    auto remaining_bytes = m_frame_length - m_partial_bytes;
+    m_partial_bytes = 0;
+    m_partial_samples = 0;
+
+    auto interrupt = [&]() {
+        if (remaining_bytes != m_frame_length)
+        {
+            m_partial_output = output;
+            m_partial_bytes = m_frame_length - remaining_bytes;
+            m_partial_samples = static_cast<uint32_t>(frame_ptr - output);
+        }
+        return false;
+    };
+    auto complete = [&]() {
+        if (resumed_elsewhere)
+        {
+            m_statistics.other_errors.fetch_add(1, std::memory_order_relaxed);
+            throw rdk::exception::frame_acquisition_failed();
+        }
+        // the last slice of the frame is the one closest to the end of the acquisition
+        m_frame_device_us = m_slice_device_us;
+        m_frame_received_us = m_slice_received_us;
+        count_frame();
+    };
+
     const auto expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
     while (remaining_bytes)
     {
         // get next slice if no previous slice has been saved
         if (!m_slice)
         {
+            // once the timeout has expired (or with a timeout of 0) slices
+            // which are already queued are still taken, only waiting stops
             const auto remaining_timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(expiry - std::chrono::steady_clock::now()).count();
-            if (remaining_timeout_ms <= 0)
-            {
-                throw rdk::exception::timeout();
-            }
-
-            m_slice.reset(m_bridge_data->getFrame(static_cast<uint16_t>(remaining_timeout_ms)));
+            m_slice.reset(m_bridge_data->getFrame(static_cast<uint16_t>(std::max<int64_t>(remaining_timeout_ms, 0))));
             if (!m_slice)
             {
-                throw rdk::exception::timeout();
+                return interrupt();
             }
+            m_slice_time = std::chrono::steady_clock::now();
+            m_slice_received_us = epoch_time_us();
+            m_slice_device_us = m_slice->getTimestamp();
 
             const auto status = m_slice->getStatusCode();
+            count_slice(status, m_slice->getDataSize());
             if (status != DataError_NoError)
             {
                 m_slice.reset();
-                switch (status)
+                if (recover_overflow(status))
                 {
-                    case DataError_FrameDropped:
-                    case DataError_FramePoolDepleted:
-                    case DataError_FrameQueueTrimmed:
-                        throw rdk::exception::frame_acquisition_failed();
-                        break;
-                    case DataError_FrameSizeExceeded:
-                        throw rdk::exception::frame_size_not_supported();
-                    case E_OVERFLOW:
-                        throw rdk::exception::fifo_overflow();
-                        break;
-                    default:
-                        throw rdk::exception::error();
-                        break;
+                    // the frame read so far is lost, the sequencer starts over with a new one
+                    resumed_elsewhere = false;
+                    frame_ptr = output;
+                    remaining_bytes = m_frame_length;
+                    continue;
                 }
+                throw rdk::exception::exception(slice_error_code(status));
             }
         }
 
+        if (remaining_bytes == m_frame_length)
+        {
+            m_frame_time = m_slice_time;
+        }
+
         const auto slice_size = m_slice->getDataSize();
         if (remaining_bytes < slice_size)
         {
             // frame is finished, and there is data from the next frame in the slice to keep for the next call
             copy_slice_data(m_data_format, m_slice->getData(), remaining_bytes, frame_ptr);
             m_slice->setDataOffsetAndSize(m_slice->getDataOffset() + remaining_bytes, slice_size - remaining_bytes);
-            return;
+            complete();
+            return true;
         }
         else
         {
@@ -404,6 +790,469 @@ void DeviceFmcwBase::get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t ti
             remaining_bytes -= slice_size;
         }
     }
+    complete();
+    return true;
+}
+
+void DeviceFmcwBase::set_frame_callback(ifx_Fmcw_Frame_t** frames, uint32_t num_frames, ifx_Fmcw_Frame_Callback_t callback, void* user_data)
+{
+    if (!m_board)
+    {
+        throw rdk::exception::not_supported();
+    }
+    if (m_async)
+    {
+        throw rdk::exception::not_possible();
+    }
+
+    stop_acquisition();
+
+    // stop_acquisition() leaves the bridge thread idle, registering a listener
+    // also waits for a call of onNewFrame to return
+    m_bridge_data->registerListener(nullptr);
+    m_frame_callback = nullptr;
+    m_frame_callback_data = nullptr;
+    m_ring.clear();
+    m_ring_frames.clear();
+    m_ring_busy.reset();
+    m_stream_samples = {};
+
+    if (callback == nullptr)
+    {
+        return;
+    }
+
+    if (frames == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+    if (num_frames == 0)
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    update_defaults_if_not_configured();
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        if (frames[i] == nullptr)
+        {
+            throw rdk::exception::argument_null();
+        }
+        if (frames[i]->num_cubes != m_frame_dimensions.size())
+        {
+            throw rdk::exception::dimension_mismatch();
+        }
+    }
+
+    m_ring.assign(frames, frames + num_frames);
+    m_ring_busy.reset(new std::atomic<bool>[num_frames]);
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        m_ring_busy[i] = false;
+    }
+    m_ring_next = 0;
+    m_frame_callback = callback;
+    m_frame_callback_data = user_data;
+
+    m_bridge_data->registerListener(this);
+}
+
+void DeviceFmcwBase::release_frame(ifx_Fmcw_Frame_t* frame)
+{
+    if (frame == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    const auto it = std::find(m_ring.begin(), m_ring.end(), frame);
+    if (it == m_ring.end())
+    {
+        throw rdk::exception::argument_invalid();
+    }
+    m_ring_busy[it - m_ring.begin()].store(false, std::memory_order_release);
+}
+
+void DeviceFmcwBase::set_frame_ring_size(uint32_t num_frames)
+{
+    if (m_frame_callback)
+    {
+        throw rdk::exception::not_possible();
+    }
+    if (num_frames == 0)
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    m_ring.clear();
+    m_ring_frames.clear();
+    m_ring_busy.reset();
+
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        m_ring_frames.emplace_back(allocate_frame());
+        m_ring.push_back(m_ring_frames.back().get());
+    }
+    m_ring_busy.reset(new std::atomic<bool>[num_frames]);
+    for (uint32_t i = 0; i < num_frames; i++)
+    {
+        m_ring_busy[i] = false;
+    }
+    m_ring_next = 0;
+    m_ring_dimensions = m_frame_dimensions;
+}
+
+void DeviceFmcwBase::get_next_frame_async(ifx_Fmcw_Frame_t* frame, ifx_Fmcw_Async_Callback_t callback, void* user_data)
+{
+    if (!m_board)
+    {
+        throw rdk::exception::not_supported();
+    }
+    if (frame == nullptr || callback == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+    if (m_frame_callback)
+    {
+        throw rdk::exception::not_possible();
+    }
+
+    if (!m_async)
+    {
+        update_defaults_if_not_configured();
+
+        // The restart discards the frames queued for the blocking functions.
+        // The listener is registered while the bridge thread is idle.
+        stop_acquisition();
+        m_async = true;
+        m_bridge_data->registerListener(this);
+        try
+        {
+            start_acquisition();
+        }
+        catch (...)
+        {
+            m_bridge_data->registerListener(nullptr);
+            m_async = false;
+            throw;
+        }
+    }
+
+    // called by the bridge thread when a callback queues the next request,
+    // so only the request queue is touched from here on
+    if (frame->num_cubes != m_frame_dimensions.size())
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+    m_async_requests.push({frame, callback, user_data});
+}
+
+void DeviceFmcwBase::cancel_async()
+{
+    if (!m_async)
+    {
+        return;
+    }
+
+    stop_acquisition();
+    // also waits for a call of onNewFrame to return
+    m_bridge_data->registerListener(nullptr);
+    m_async = false;
+    abort_async_requests();
+}
+
+void DeviceFmcwBase::abort_async_requests()
+{
+    for (const auto& request : m_async_requests.take_all())
+    {
+        request.callback(request.frame, IFX_ERROR_ABORTED, request.user_data);
+    }
+}
+
+ifx_Fmcw_Frame_t* DeviceFmcwBase::acquire_frame(uint16_t timeout_ms)
+{
+    if (m_frame_callback)
+    {
+        throw rdk::exception::not_possible();
+    }
+
+    update_defaults_if_not_configured();
+    if (m_ring_frames.empty())
+    {
+        set_frame_ring_size(default_frame_ring_size);
+    }
+    else if (m_ring_dimensions != m_frame_dimensions)
+    {
+        // the acquisition sequence has changed, the frames are reallocated
+        // once the application has returned all of them
+        const auto num_frames = static_cast<uint32_t>(m_ring.size());
+        for (uint32_t i = 0; i < num_frames; i++)
+        {
+            if (m_ring_busy[i])
+            {
+                throw rdk::exception::dimension_mismatch();
+            }
+        }
+        set_frame_ring_size(num_frames);
+    }
+
+    const auto num_frames = static_cast<uint32_t>(m_ring.size());
+    for (uint32_t n = 0; n < num_frames; n++)
+    {
+        const auto index = (m_ring_next + n) % num_frames;
+        if (m_ring_busy[index])
+        {
+            continue;
+        }
+
+        m_ring_busy[index] = true;
+        try
+        {
+            get_next_frame(m_ring[index], timeout_ms);
+        }
+        catch (...)
+        {
+            m_ring_busy[index] = false;
+            throw;
+        }
+        m_ring_next = (index + 1) % num_frames;
+        return m_ring[index];
+    }
+
+    // all frames are held by the application
+    throw rdk::exception::not_possible();
+}
+
+void DeviceFmcwBase::onNewFrame(IFrame* slice)
+{
+    SmartIFrame owner(slice);
+    const auto now = std::chrono::steady_clock::now();
+    const auto received_us = epoch_time_us();
+
+    const auto status = slice->getStatusCode();
+    count_slice(status, slice->getDataSize());
+    if (status != DataError_NoError)
+    {
+        // the partial frame is incomplete, start over with the next slice
+        m_stream_bytes = 0;
+        m_stream_count = 0;
+        if (!recover_overflow(status))
+        {
+            report_lost_frame(slice_error_code(status));
+        }
+        return;
+    }
+
+    const auto* data = slice->getData();
+    auto size = slice->getDataSize();
+    while (size)
+    {
+        if (m_stream_bytes == 0)
+        {
+            m_frame_time = now;
+        }
+
+        const auto chunk = std::min(size, m_frame_length - m_stream_bytes);
+        m_stream_count += copy_slice_data(m_data_format, data, chunk, m_stream_samples.data() + m_stream_count);
+        m_stream_bytes += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if (m_stream_bytes == m_frame_length)
+        {
+            m_frame_device_us = slice->getTimestamp();
+            m_frame_received_us = received_us;
+            deliver_frame();
+            m_stream_bytes = 0;
+            m_stream_count = 0;
+        }
+    }
+}
+
+void DeviceFmcwBase::report_lost_frame(ifx_Error_t error)
+{
+    if (!m_async)
+    {
+        m_frame_callback(nullptr, error, m_frame_callback_data);
+        return;
+    }
+
+    // the request waiting for the lost frame learns about the loss
+    AsyncRequest request;
+    if (m_async_requests.pop(request))
+    {
+        request.callback(request.frame, error, request.user_data);
+    }
+}
+
+void DeviceFmcwBase::deliver_async()
+{
+    AsyncRequest request;
+    if (!m_async_requests.pop(request))
+    {
+        // no request pending, drop the frame
+        m_statistics.other_errors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    try
+    {
+        deinterleave_frame(m_stream_samples.data(), request.frame);
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        m_statistics.other_errors.fetch_add(1, std::memory_order_relaxed);
+        request.callback(request.frame, e.error_code(), request.user_data);
+        return;
+    }
+    count_frame();
+    stamp_frame(request.frame);
+    request.callback(request.frame, IFX_OK, request.user_data);
+}
+
+void DeviceFmcwBase::deliver_frame()
+{
+    if (m_async)
+    {
+        deliver_async();
+        return;
+    }
+
+    const auto index = m_ring_next;
+    bool expected = false;
+    if (!m_ring_busy[index].compare_exchange_strong(expected, true, std::memory_order_acquire))
+    {
+        // the application still holds the next frame of the ring, drop this one
+        m_statistics.other_errors.fetch_add(1, std::memory_order_relaxed);
+        m_frame_callback(nullptr, IFX_ERROR_FRAME_ACQUISITION_FAILED, m_frame_callback_data);
+        return;
+    }
+    m_ring_next = (index + 1) % static_cast<uint32_t>(m_ring.size());
+
+    auto* frame = m_ring[index];
+    try
+    {
+        deinterleave_frame(m_stream_samples.data(), frame);
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        m_ring_busy[index] = false;
+        m_statistics.other_errors.fetch_add(1, std::memory_order_relaxed);
+        m_frame_callback(nullptr, e.error_code(), m_frame_callback_data);
+        return;
+    }
+    count_frame();
+    stamp_frame(frame);
+    m_frame_callback(frame, IFX_OK, m_frame_callback_data);
+}
+
+void DeviceFmcwBase::count_slice(uint32_t status, uint32_t size)
+{
+    auto& counter = [&]() -> std::atomic<uint64_t>& {
+        switch (status)
+        {
+            case DataError_NoError:
+                m_statistics.num_bytes.fetch_add(size, std::memory_order_relaxed);
+                return m_statistics.num_slices;
+            case DataError_FrameDropped:
+                return m_statistics.frames_dropped;
+            case DataError_FramePoolDepleted:
+                return m_statistics.pool_depleted;
+            case DataError_FrameQueueTrimmed:
+                return m_statistics.queue_trimmed;
+            case E_OVERFLOW:
+                return m_statistics.fifo_overflows;
+            default:
+                return m_statistics.other_errors;
+        }
+    }();
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool DeviceFmcwBase::recover_overflow(uint32_t status)
+{
+    if ((status != E_OVERFLOW) || !m_overflow_recovery || !recover_from_overflow())
+    {
+        return false;
+    }
+
+    m_statistics.overflow_recoveries.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t DeviceFmcwBase::epoch_time_us()
+{
+    const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(since_epoch).count());
+}
+
+void DeviceFmcwBase::count_frame()
+{
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_frame_time);
+    const auto latency_ns = static_cast<uint64_t>(latency.count());
+
+    m_statistics.num_frames.fetch_add(1, std::memory_order_relaxed);
+    m_statistics.latency_last.store(latency_ns, std::memory_order_relaxed);
+    m_statistics.latency_sum.fetch_add(latency_ns, std::memory_order_relaxed);
+    if (latency_ns > m_statistics.latency_max.load(std::memory_order_relaxed))
+    {
+        m_statistics.latency_max.store(latency_ns, std::memory_order_relaxed);
+    }
+}
+
+void DeviceFmcwBase::get_open_timing(ifx_Fmcw_Open_Timing_t* timing) const
+{
+    if (timing == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    *timing = m_open_timing;
+}
+
+void DeviceFmcwBase::get_statistics(ifx_Fmcw_Statistics_t* statistics) const
+{
+    if (statistics == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    constexpr auto relaxed = std::memory_order_relaxed;
+    statistics->num_slices = m_statistics.num_slices.load(relaxed);
+    statistics->num_bytes = m_statistics.num_bytes.load(relaxed);
+    statistics->num_frames = m_statistics.num_frames.load(relaxed);
+    statistics->frames_dropped = m_statistics.frames_dropped.load(relaxed);
+    statistics->pool_depleted = m_statistics.pool_depleted.load(relaxed);
+    statistics->queue_trimmed = m_statistics.queue_trimmed.load(relaxed);
+    statistics->fifo_overflows = m_statistics.fifo_overflows.load(relaxed);
+    statistics->overflow_recoveries = m_statistics.overflow_recoveries.load(relaxed);
+    statistics->other_errors = m_statistics.other_errors.load(relaxed);
+    statistics->queue_high_water = m_board ? m_bridge_data->getFrameQueueHighWaterMark() : 0;
+
+    const auto latency_sum = m_statistics.latency_sum.load(relaxed);
+    statistics->latency_last_s = static_cast<float>(m_statistics.latency_last.load(relaxed) * 1e-9);
+    statistics->latency_mean_s = statistics->num_frames ? static_cast<float>(latency_sum * 1e-9 / statistics->num_frames) : 0.0f;
+    statistics->latency_max_s = static_cast<float>(m_statistics.latency_max.load(relaxed) * 1e-9);
+}
+
+void DeviceFmcwBase::reset_statistics()
+{
+    m_statistics.num_slices = 0;
+    m_statistics.num_bytes = 0;
+    m_statistics.num_frames = 0;
+    m_statistics.frames_dropped = 0;
+    m_statistics.pool_depleted = 0;
+    m_statistics.queue_trimmed = 0;
+    m_statistics.fifo_overflows = 0;
+    m_statistics.overflow_recoveries = 0;
+    m_statistics.other_errors = 0;
+    m_statistics.latency_last = 0;
+    m_statistics.latency_sum = 0;
+    m_statistics.latency_max = 0;
+
+    if (m_board)
+    {
+        m_bridge_data->resetFrameQueueHighWaterMark();
+    }
 }
 
 void DeviceFmcwBase::update_frame_settings()
@@ -36,34 +36,61 @@
 
 #pragma once
 
+#include "ifxBase/internal/GatherPlan.hpp"
 #include "ifxBase/internal/NonCopyable.hpp"
 #include "ifxFmcw/DeviceFmcw.hpp"
+#include "ifxRadarDeviceCommon/internal/AsyncRequests.hpp"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 
 
-struct DeviceFmcwBase : public DeviceFmcw
+struct DeviceFmcwBase : public DeviceFmcw, private IFrameListener<>
 {
     NONCOPYABLE(DeviceFmcwBase);
-    ~DeviceFmcwBase() override = default;
+    ~DeviceFmcwBase() override;
 
     const ifx_Firmware_Info_t* get_firmware_info() const override;
     const char* get_board_uuid() const override;
+    void read_eeprom(const ifx_Fmcw_Eeprom_Config_t* eeprom, uint32_t address, uint32_t length, uint8_t* buffer) override;
     const ifx_Radar_Sensor_Info_t* get_sensor_info() const override;
     ifx_Fmcw_Frame_t* allocate_frame() override;
     ifx_Fmcw_Raw_Frame_t* allocate_raw_frame() override;
     void get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms) override;
     void get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+    void get_next_frames(ifx_Fmcw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms) override;
+    void get_next_raw_frames(ifx_Fmcw_Raw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms) override;
+    bool try_get_next_frame(ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms) override;
+    bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+    void set_frame_callback(ifx_Fmcw_Frame_t** frames, uint32_t num_frames, ifx_Fmcw_Frame_Callback_t callback, void* user_data) override;
+    void release_frame(ifx_Fmcw_Frame_t* frame) override;
+    void set_frame_ring_size(uint32_t num_frames) override;
+    ifx_Fmcw_Frame_t* acquire_frame(uint16_t timeout_ms) override;
+    void get_next_frame_async(ifx_Fmcw_Frame_t* frame, ifx_Fmcw_Async_Callback_t callback, void* user_data) override;
+    void cancel_async() override;
+    void get_statistics(ifx_Fmcw_Statistics_t* statistics) const override;
+    void reset_statistics() override;
+    void get_open_timing(ifx_Fmcw_Open_Timing_t* timing) const override;
 
     void convert_raw_data_to_float_array(uint32_t num_samples, const uint16_t* raw_data, ifx_Float_t* converted_frame) override;
     void deinterleave_raw_frame(const ifx_Fmcw_Raw_Frame_t* raw_frame, ifx_Fmcw_Raw_Frame_t* deinterleaved_frame) override;
     void view_deinterleaved_frame(ifx_Float_t* converted_frame, ifx_Fmcw_Frame_t* deinterleaved_frame_view) override;
+    void get_raw_frame_layout(FmcwRawFrameLayout& layout) override;
     float get_sequence_duration(const ifx_Fmcw_Sequence_Element_t* sequence) const override;
     IFX_DLL_TEST float get_element_duration(const ifx_Fmcw_Sequence_Element_t* element) const override;
 
     double get_chirp_sampling_center_frequency(const ifx_Fmcw_Sequence_Chirp_t* chirp) const override;
 
+    void set_acquisition_policy(ifx_Fmcw_Acquisition_Policy_t policy, uint32_t slice_size) override;
+    ifx_Fmcw_Acquisition_Policy_t get_acquisition_policy() const override;
+
+    void set_overflow_recovery(bool enabled) override;
+    bool get_overflow_recovery() const override;
+
 protected:
     DeviceFmcwBase(ifx_Float_t max_adc_value);
     DeviceFmcwBase(ifx_Float_t max_adc_value, std::unique_ptr<BoardInstance>&& board);
@@ -79,11 +106,28 @@ protected:
     void get_frame_dimensions();
     uint32_t get_buffer_length(uint32_t num_samples) const;
     uint32_t copy_slice_data(uint8_t data_format, const uint8_t* buffer, uint32_t buffer_length, uint16_t* output);
+    uint32_t copy_slice_data(uint8_t data_format, const uint8_t* buffer, uint32_t buffer_length, ifx_Float_t* output);
+
+    /* Reads the next frame converted like convert_raw_data_to_float_array(),
+     * returns false on a timeout. Devices which don't receive the frame in
+     * slices override this.
+     */
+    virtual bool get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms);
+
+    /* Restarts the sequencer of a running acquisition after a FIFO overflow
+     * without reprogramming the device, see set_overflow_recovery. Returns
+     * false if the device cannot recover in place.
+     */
+    virtual bool recover_from_overflow()
+    {
+        return false;
+    }
 
     double get_chirp_sampling_bandwidth(const ifx_Fmcw_Sequence_Chirp_t* chirp) const override;
 
     ifx_Float_t m_max_adc_value;
     ifx_Firmware_Info_t m_firmware_info;
+    ifx_Fmcw_Open_Timing_t m_open_timing = {};  // filled by the constructors, see get_open_timing
     ifx_Radar_Sensor_Info_t m_sensor_info;
     std::unique_ptr<BoardInstance> m_board;
 
@@ -94,6 +138,21 @@ protected:
 
     uint32_t m_num_samples = 0;
 
+    // Timestamps of the frame read last, see ifx_Fmcw_Frame_t. Devices not
+    // reading from the bridge set them when they produce a frame.
+    uint64_t m_frame_device_us = 0;
+    uint64_t m_frame_received_us = 0;
+
+    static uint64_t epoch_time_us();
+
+    template <typename Frame>
+    void stamp_frame(Frame* frame) const
+    {
+        frame->timestamp_device_us = m_frame_device_us;
+        frame->timestamp_received_us = m_frame_received_us;
+        frame->timestamp_delivered_us = epoch_time_us();
+    }
+
 private:
     float m_frame_repetition_time_s;
     std::vector<std::array<uint32_t, 3>> m_frame_dimensions;
@@ -101,5 +160,92 @@ private:
     uint32_t m_frame_length;
     SmartIFrame m_slice;
 
+    ifx_Fmcw_Acquisition_Policy_t m_acquisition_policy = IFX_FMCW_ACQUISITION_MAX_THROUGHPUT;
+    uint32_t m_explicit_slice_size = 0;  // used with IFX_FMCW_ACQUISITION_SLICE_SIZE
+    std::atomic<bool> m_overflow_recovery {false};
+    std::vector<ifx_Float_t> m_normalized_samples;  // reused by get_next_frame
+
+    // frame interrupted by a timeout, continued by the next read
+    const void* m_partial_output = nullptr;
+    uint32_t m_partial_bytes = 0;
+    uint32_t m_partial_samples = 0;
+
+    template <typename T>
+    bool read_frame_samples(T* output, uint16_t timeout_ms);
+
+    // Copy of the samples of a frame into one cube, see ifx::GatherPlan.
+    // Rebuilt if the frame configuration or the strides of the cube change.
+    struct CubePlan
+    {
+        std::array<uint32_t, 3> dimensions {};
+        std::array<size_t, 3> stride {};
+        uint32_t cube_offset = 0;
+        bool mimo = false;
+        ifx::GatherPlan plan;
+    };
+    std::vector<CubePlan> m_cube_plans;
+
+    void deinterleave_frame(const ifx_Float_t* samples, ifx_Fmcw_Frame_t* frame);
+    static void build_cube_plan(CubePlan& cube_plan);
+
+    // Counters of get_statistics, updated by the thread retrieving frames and
+    // read by any thread. Latencies are kept in nanoseconds.
+    struct Statistics
+    {
+        std::atomic<uint64_t> num_slices {0};
+        std::atomic<uint64_t> num_bytes {0};
+        std::atomic<uint64_t> num_frames {0};
+        std::atomic<uint64_t> frames_dropped {0};
+        std::atomic<uint64_t> pool_depleted {0};
+        std::atomic<uint64_t> queue_trimmed {0};
+        std::atomic<uint64_t> fifo_overflows {0};
+        std::atomic<uint64_t> overflow_recoveries {0};
+        std::atomic<uint64_t> other_errors {0};
+        std::atomic<uint64_t> latency_last {0};
+        std::atomic<uint64_t> latency_sum {0};
+        std::atomic<uint64_t> latency_max {0};
+    };
+    Statistics m_statistics;
+    std::chrono::steady_clock::time_point m_slice_time;  // when m_slice was received
+    std::chrono::steady_clock::time_point m_frame_time;  // when the first slice of the current frame was received
+    uint64_t m_slice_device_us = 0;    // device timestamp of m_slice
+    uint64_t m_slice_received_us = 0;  // epoch time when m_slice was received
+
+    void count_slice(uint32_t status, uint32_t size);
+    void count_frame();
+    bool recover_overflow(uint32_t status);
+
+    // Push delivery, see set_frame_callback. onNewFrame is called from the
+    // bridge thread and assembles the slices into m_stream_samples.
+    void onNewFrame(IFrame* slice) override;
+    void deliver_frame();
+    void report_lost_frame(ifx_Error_t error);
+
+    ifx_Fmcw_Frame_Callback_t m_frame_callback = nullptr;
+    void* m_frame_callback_data = nullptr;
+    std::vector<ifx_Fmcw_Frame_t*> m_ring;
+    std::vector<SmartFmcwFrame> m_ring_frames;  // frames owned by the device, see set_frame_ring_size
+    std::vector<std::array<uint32_t, 3>> m_ring_dimensions;
+    std::unique_ptr<std::atomic<bool>[]> m_ring_busy;  // set until the application releases the frame
+    uint32_t m_ring_next = 0;
+    std::vector<ifx_Float_t> m_stream_samples;
+    uint32_t m_stream_bytes = 0;
+    uint32_t m_stream_count = 0;  // samples in m_stream_samples
+
+    // Asynchronous delivery, see get_next_frame_async. Like the push delivery
+    // served by onNewFrame, but each frame goes into the buffer of the oldest
+    // pending request.
+    struct AsyncRequest
+    {
+        ifx_Fmcw_Frame_t* frame;
+        ifx_Fmcw_Async_Callback_t callback;
+        void* user_data;
+    };
+    rdk::AsyncRequests<AsyncRequest> m_async_requests;
+    std::atomic<bool> m_async {false};
+
+    void deliver_async();
+    void abort_async_requests();
+
     bool m_mimo;  // temporary helper to unblock simple use cases
 };
@@ -35,10 +35,14 @@
 
 #include "avian/DeviceFmcwAvian.hpp"
 #include "DeviceFmcw.h"
+#include "playback/DeviceFmcwPlayback.hpp"
+#include "shared/DeviceFmcwShared.hpp"
+#include "synthetic/DeviceFmcwSynthetic.hpp"
 
 #include "ifxBase/FunctionWrapper.hpp"
 #include "ifxBase/internal/List.hpp"
 
+#include <common/Threads.hpp>
 #include <platform/NamedMemory.hpp>
 
 #include <cinttypes>
@@ -69,6 +73,23 @@
 
 namespace {
 
+StrataThreads::Role to_thread_role(ifx_Fmcw_Thread_Role_t role)
+{
+    switch (role)
+    {
+        case IFX_FMCW_THREAD_DATA:
+            return StrataThreads::Data;
+        case IFX_FMCW_THREAD_FORWARDING:
+            return StrataThreads::Forwarding;
+        case IFX_FMCW_THREAD_ACQUISITION:
+            return StrataThreads::Acquisition;
+        case IFX_FMCW_THREAD_PROCESSING:
+            return StrataThreads::Processing;
+        default:
+            throw rdk::exception::argument_invalid();
+    }
+}
+
 void print_tabs(uint8_t numtabs)
 {
     for (uint8_t i = 0; i < numtabs; i++)
@@ -169,6 +190,19 @@ ifx_List_t* ifx_fmcw_get_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type)
 
 //----------------------------------------------------------------------------
 
+size_t ifx_fmcw_get_sensor_list_by_sensor_type(ifx_Radar_Sensor_t sensor_type, ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    IFX_ERR_BRV_COND(count && !entries, IFX_ERROR_ARGUMENT_NULL, 0);
+
+    auto selector = [&sensor_type](const ifx_Radar_Sensor_List_Entry_t& entry) {
+        return entry.sensor_type == sensor_type;
+    };
+
+    return rdk::RadarDeviceCommon::get_list(selector).copy_to(entries, count);
+}
+
+//----------------------------------------------------------------------------
+
 const ifx_Firmware_Info_t* ifx_fmcw_get_firmware_information(const ifx_Device_Fmcw_t* handle)
 {
     return rdk::call_func(handle, &ifx_Device_Fmcw_t::get_firmware_info);
@@ -196,6 +230,20 @@ ifx_List_t* ifx_fmcw_get_list()
 
 //----------------------------------------------------------------------------
 
+size_t ifx_fmcw_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    using namespace rdk::RadarDeviceCommon;
+    IFX_ERR_BRV_COND(count && !entries, IFX_ERROR_ARGUMENT_NULL, 0);
+
+    auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
+        return sensor_is_avian(entry.sensor_type);
+    };
+
+    return get_list(selector).copy_to(entries, count);
+}
+
+//----------------------------------------------------------------------------
+
 const char* ifx_fmcw_get_board_uuid(const ifx_Device_Fmcw_t* handle)
 {
     return rdk::call_func(handle, &ifx_Device_Fmcw_t::get_board_uuid);
@@ -203,6 +251,14 @@ const char* ifx_fmcw_get_board_uuid(const ifx_Device_Fmcw_t* handle)
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_read_eeprom(ifx_Device_Fmcw_t* handle, const ifx_Fmcw_Eeprom_Config_t* eeprom,
+                          uint32_t address, uint32_t length, uint8_t* buffer)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::read_eeprom, eeprom, address, length, buffer);
+}
+
+//----------------------------------------------------------------------------
+
 ifx_Device_Fmcw_t* ifx_fmcw_create_by_port(const char* port)
 {
     // if port is NULL, call ifx_fmcw_create. This ensures the previous behavior.
@@ -239,6 +295,56 @@ ifx_Device_Fmcw_t* ifx_fmcw_create_dummy_from_device(const ifx_Device_Fmcw_t* ha
     return nullptr;
 }
 
+//----------------------------------------------------------------------------
+
+ifx_Device_Fmcw_t* ifx_fmcw_create_playback(ifx_Radar_Sensor_t sensor_type, const char* filename,
+                                            ifx_Fmcw_Playback_Mode_t mode, bool loop)
+{
+    if (rdk::RadarDeviceCommon::sensor_is_avian(sensor_type))
+    {
+        return rdk::RadarDeviceCommon::open_device<DeviceFmcwPlayback>(sensor_type, filename, mode, loop);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Device_Fmcw_t* ifx_fmcw_create_synthetic(ifx_Radar_Sensor_t sensor_type, const ifx_Fmcw_Synthetic_Scene_t* scene,
+                                             ifx_Fmcw_Playback_Mode_t mode)
+{
+    if (rdk::RadarDeviceCommon::sensor_is_avian(sensor_type))
+    {
+        return rdk::RadarDeviceCommon::open_device<DeviceFmcwSynthetic>(sensor_type, scene, mode);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_synthetic_scene(ifx_Device_Fmcw_t* handle, const ifx_Fmcw_Synthetic_Scene_t* scene)
+{
+    if (!handle)
+    {
+        ifx_error_set(IFX_ERROR_ARGUMENT_NULL);
+        return;
+    }
+
+    auto* synthetic_instance = dynamic_cast<DeviceFmcwSynthetic*>(handle);
+    if (!synthetic_instance)
+    {
+        ifx_error_set(IFX_ERROR_NOT_SUPPORTED);
+        return;
+    }
+
+    rdk::call_func(synthetic_instance, &DeviceFmcwSynthetic::set_scene, scene);
+}
+
 ifx_Device_Fmcw_t* ifx_fmcw_create()
 {
     auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
@@ -260,6 +366,18 @@ ifx_Device_Fmcw_t* ifx_fmcw_create_by_uuid(const char* uuid)
         ifx_error_set(IFX_ERROR_ARGUMENT_NULL);
         return nullptr;
     }
+
+    // A board published by a device server in another process is not
+    // available over USB, attach to the frames of the server instead.
+    auto ring = SharedFrameRing::open(uuid);
+    if (ring)
+    {
+        auto caller = [&ring, uuid]() -> ifx_Device_Fmcw_t* {
+            return new DeviceFmcwShared(std::move(ring), uuid);
+        };
+        return rdk::call_func(caller, nullptr);
+    }
+
     auto board = open_by_uuid(uuid);
 
     ifx_Radar_Sensor_t sensor_type;
@@ -335,6 +453,41 @@ void ifx_fmcw_start_acquisition(ifx_Device_Fmcw_t* handle)
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_set_acquisition_policy(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Acquisition_Policy_t policy, uint32_t slice_size)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::set_acquisition_policy, policy, slice_size);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Fmcw_Acquisition_Policy_t ifx_fmcw_get_acquisition_policy(const ifx_Device_Fmcw_t* handle)
+{
+    return (rdk::call_func(handle, &ifx_Device_Fmcw_t::get_acquisition_policy));
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_overflow_recovery(ifx_Device_Fmcw_t* handle, bool enabled)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::set_overflow_recovery, enabled);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_fmcw_get_overflow_recovery(const ifx_Device_Fmcw_t* handle)
+{
+    return (rdk::call_func(handle, &ifx_Device_Fmcw_t::get_overflow_recovery));
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fmcw_get_slice_size(ifx_Device_Fmcw_t* handle)
+{
+    return (rdk::call_func(handle, &ifx_Device_Fmcw_t::get_slice_size));
+}
+
+//----------------------------------------------------------------------------
+
 ifx_Fmcw_Frame_t* ifx_fmcw_allocate_frame(ifx_Device_Fmcw_t* handle)
 {
     return (rdk::call_func(handle, &ifx_Device_Fmcw_t::allocate_frame));
@@ -377,6 +530,157 @@ void ifx_fmcw_get_next_raw_frame_timeout(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Raw
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_get_next_frames(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::get_next_frames, frames, num_frames, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_next_raw_frames(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Raw_Frame_t* frames, uint32_t num_frames, uint16_t timeout_ms)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::get_next_raw_frames, frames, num_frames, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Error_t ifx_fmcw_try_get_next_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t* frame, uint16_t timeout_ms)
+{
+    // a timeout is no error here, only exceptions set the error state
+    auto caller = [handle, frame, timeout_ms]() -> ifx_Error_t {
+        rdk::check_handle(handle);
+        return handle->try_get_next_frame(frame, timeout_ms) ? IFX_OK : IFX_ERROR_TIMEOUT;
+    };
+    return rdk::exception_handler(caller, ifx_error_get);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Error_t ifx_fmcw_try_get_next_raw_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    auto caller = [handle, frame, timeout_ms]() -> ifx_Error_t {
+        rdk::check_handle(handle);
+        return handle->try_get_next_raw_frame(frame, timeout_ms) ? IFX_OK : IFX_ERROR_TIMEOUT;
+    };
+    return rdk::exception_handler(caller, ifx_error_get);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_frame_callback(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t** frames, uint32_t num_frames, ifx_Fmcw_Frame_Callback_t callback, void* user_data)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::set_frame_callback, frames, num_frames, callback, user_data);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_release_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t* frame)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::release_frame, frame);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_frame_ring_size(ifx_Device_Fmcw_t* handle, uint32_t num_frames)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::set_frame_ring_size, num_frames);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Fmcw_Frame_t* ifx_fmcw_acquire_frame(ifx_Device_Fmcw_t* handle, uint16_t timeout_ms)
+{
+    return rdk::call_func(handle, &ifx_Device_Fmcw_t::acquire_frame, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_next_frame_async(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Frame_t* frame, ifx_Fmcw_Async_Callback_t callback, void* user_data)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::get_next_frame_async, frame, callback, user_data);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_cancel_async(ifx_Device_Fmcw_t* handle)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::cancel_async);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_statistics(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Statistics_t* statistics)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::get_statistics, statistics);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_open_timing(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Open_Timing_t* timing)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::get_open_timing, timing);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_reference_clock_cache(const char* filename)
+{
+    rdk::call_func(&DeviceFmcwAvian::set_reference_clock_cache, filename);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_reset_statistics(ifx_Device_Fmcw_t* handle)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::reset_statistics);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_thread_config(ifx_Fmcw_Thread_Role_t role, const ifx_Fmcw_Thread_Config_t* config)
+{
+    auto caller = [](ifx_Fmcw_Thread_Role_t role, const ifx_Fmcw_Thread_Config_t* config) {
+        if (!config)
+        {
+            throw rdk::exception::argument_null();
+        }
+
+        StrataThreads::Settings settings;
+        settings.affinity = config->affinity_mask;
+        settings.priority = config->priority;
+        settings.realtime = config->realtime;
+        StrataThreads::setSettings(to_thread_role(role), settings);
+    };
+    rdk::call_func(caller, role, config);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_thread_config(ifx_Fmcw_Thread_Role_t role, ifx_Fmcw_Thread_Config_t* config)
+{
+    auto caller = [](ifx_Fmcw_Thread_Role_t role, ifx_Fmcw_Thread_Config_t* config) {
+        if (!config)
+        {
+            throw rdk::exception::argument_null();
+        }
+
+        const auto settings = StrataThreads::getSettings(to_thread_role(role));
+        config->affinity_mask = settings.affinity;
+        config->priority = settings.priority;
+        config->realtime = settings.realtime;
+    };
+    rdk::call_func(caller, role, config);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_set_thread_name_prefix(const char* prefix)
+{
+    StrataThreads::setNamePrefix(prefix);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fmcw_destroy_frame(ifx_Fmcw_Frame_t* frame)
 {
     rdk::call_func(&Fmcw::destroy_frame, frame);
@@ -405,6 +709,17 @@ ifx_Fmcw_Sequence_Element_t* ifx_fmcw_get_acquisition_sequence(ifx_Device_Fmcw_t
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_check_acquisition_sequences(const ifx_Device_Fmcw_t* handle,
+                                          const ifx_Fmcw_Sequence_Element_t* const* sequences,
+                                          uint32_t num_sequences,
+                                          ifx_Error_t* errors,
+                                          float* durations)
+{
+    rdk::call_func(handle, &ifx_Device_Fmcw_t::check_acquisition_sequences, sequences, num_sequences, errors, durations);
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fmcw_save_register_file(ifx_Device_Fmcw_t* handle, const char* filename)
 {
     return (rdk::call_func(handle, &ifx_Device_Fmcw_t::save_register_file, filename));
@@ -412,6 +727,13 @@ void ifx_fmcw_save_register_file(ifx_Device_Fmcw_t* handle, const char* filename
 
 //----------------------------------------------------------------------------
 
+void ifx_fmcw_save_register_profile(ifx_Device_Fmcw_t* handle, const char* filename)
+{
+    return (rdk::call_func(handle, &ifx_Device_Fmcw_t::save_register_profile, filename));
+}
+
+//----------------------------------------------------------------------------
+
 void ifx_fmcw_load_register_file(ifx_Device_Fmcw_t* handle, const char* filename)
 {
     rdk::call_func(handle, &ifx_Device_Fmcw_t::load_register_file, filename);
@@ -0,0 +1,518 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwGroup.h"
+#include "DeviceFmcwGroup.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/FunctionWrapper.hpp"
+#include "ifxBase/Log.h"
+
+#include <algorithm>
+#include <common/Threads.hpp>
+#include <exception>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// Timeout for reading a frame when a worker serves several devices. A frame interrupted
+// by it is continued with the next read, so it only limits how long the other devices wait.
+constexpr uint16_t poll_timeout_ms = 2;
+
+// Timeout for reading a frame when a worker serves a single device, which can just wait.
+constexpr uint16_t wait_timeout_ms = 100;
+
+uint64_t get_epoch_time_us()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwGroup::DeviceFmcwGroup(std::vector<DeviceFmcw*> devices, uint32_t num_workers)
+{
+    if (devices.empty())
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    for (auto* device : devices)
+    {
+        if (!device)
+        {
+            throw rdk::exception::argument_null();
+        }
+        m_members.emplace_back(new Member);
+        m_members.back()->device = device;
+    }
+
+    const auto num_devices = static_cast<uint32_t>(devices.size());
+    m_num_workers = (num_workers == 0) ? num_devices : std::min(num_workers, num_devices);
+}
+
+DeviceFmcwGroup::~DeviceFmcwGroup()
+{
+    try
+    {
+        stop_acquisition();
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_DEBUG("DeviceFmcwGroup - stopping the acquisition failed, \"%s\"", e.what());
+    }
+    destroy_frames();
+}
+
+void DeviceFmcwGroup::set_max_latency(uint32_t latency_ms)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_max_latency = std::chrono::milliseconds(latency_ms);
+}
+
+void DeviceFmcwGroup::set_frame_count(uint32_t num_frames)
+{
+    if (num_frames == 0)
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+    if (m_running)
+    {
+        throw rdk::exception::not_possible();
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (const auto& member : m_members)
+    {
+        if (member->free_frames.size() != member->frames.size())
+        {
+            // frames are still handed out
+            throw rdk::exception::not_possible();
+        }
+    }
+    m_num_frames = num_frames;
+}
+
+void DeviceFmcwGroup::allocate_frames()
+{
+    // the frame dimensions depend on the configuration, so they are allocated on every start
+    destroy_frames();
+
+    for (uint32_t i = 0; i < m_members.size(); i++)
+    {
+        auto& member = *m_members[i];
+        for (uint32_t j = 0; j < m_num_frames; j++)
+        {
+            auto* frame = member.device->allocate_frame();
+            member.frames.push_back(frame);
+            member.free_frames.push_back(frame);
+            m_frame_owners[frame] = i;
+        }
+    }
+}
+
+void DeviceFmcwGroup::destroy_frames()
+{
+    for (auto& member : m_members)
+    {
+        for (auto* frame : member->frames)
+        {
+            Fmcw::destroy_frame(frame);
+        }
+        member->frames.clear();
+        member->free_frames.clear();
+        member->queued = 0;
+    }
+    m_frame_owners.clear();
+    m_queue = {};
+}
+
+void DeviceFmcwGroup::requeue_frames()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    while (!m_queue.empty())
+    {
+        const auto& next = m_queue.top();
+        auto& member = *m_members[next.device_index];
+        member.free_frames.push_back(next.frame);
+        member.queued--;
+        m_queue.pop();
+    }
+}
+
+void DeviceFmcwGroup::start_acquisition()
+{
+    if (m_running)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        for (const auto& member : m_members)
+        {
+            if (member->free_frames.size() != member->frames.size())
+            {
+                // frames of the previous acquisition are still handed out
+                throw rdk::exception::not_possible();
+            }
+        }
+        allocate_frames();
+    }
+
+    // start all devices at once, starting them one after the other would take a few milliseconds each
+    std::vector<std::exception_ptr> errors(m_members.size());
+    std::vector<std::thread> starters;
+    for (size_t i = 0; i < m_members.size(); i++)
+    {
+        starters.emplace_back([this, i, &errors]() {
+            try
+            {
+                m_members[i]->device->start_acquisition();
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& starter : starters)
+    {
+        starter.join();
+    }
+
+    for (const auto& error : errors)
+    {
+        if (error)
+        {
+            for (size_t i = 0; i < m_members.size(); i++)
+            {
+                if (!errors[i])
+                {
+                    m_members[i]->device->stop_acquisition();
+                }
+            }
+            std::rethrow_exception(error);
+        }
+    }
+
+    for (auto& member : m_members)
+    {
+        member->lost = 0;
+    }
+
+    m_running = true;
+    for (uint32_t worker = 0; worker < m_num_workers; worker++)
+    {
+        m_workers.emplace_back(&DeviceFmcwGroup::worker_function, this, worker);
+    }
+}
+
+void DeviceFmcwGroup::stop_acquisition()
+{
+    if (!m_running)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_running = false;
+    }
+    m_frame_released.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+
+    requeue_frames();
+
+    std::exception_ptr error;
+    for (auto& member : m_members)
+    {
+        try
+        {
+            member->device->stop_acquisition();
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+bool DeviceFmcwGroup::is_ready(const QueuedFrame& next, Clock::time_point now) const
+{
+    if (now >= next.received + m_max_latency)
+    {
+        return true;
+    }
+
+    // the next frame is the earliest one, so it can be returned once
+    // every device has queued a frame, which will be later
+    return std::all_of(m_members.begin(), m_members.end(), [](const std::unique_ptr<Member>& member) {
+        return member->queued > 0;
+    });
+}
+
+ifx_Fmcw_Frame_t* DeviceFmcwGroup::get_next_frame(uint32_t* device_index, uint64_t* timestamp_us, uint16_t timeout_ms)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+
+    const auto expiry = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true)
+    {
+        const auto now = Clock::now();
+        auto wakeup = expiry;
+        if (!m_queue.empty())
+        {
+            const auto next = m_queue.top();
+            if (is_ready(next, now))
+            {
+                m_queue.pop();
+                m_members[next.device_index]->queued--;
+
+                if (device_index)
+                {
+                    *device_index = next.device_index;
+                }
+                if (timestamp_us)
+                {
+                    *timestamp_us = next.timestamp_us;
+                }
+                return next.frame;
+            }
+            wakeup = std::min(wakeup, next.received + m_max_latency);
+        }
+
+        if (now >= expiry)
+        {
+            throw rdk::exception::timeout();
+        }
+        m_frame_queued.wait_until(lock, wakeup);
+    }
+}
+
+void DeviceFmcwGroup::release_frame(ifx_Fmcw_Frame_t* frame)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        const auto owner = m_frame_owners.find(frame);
+        if (owner == m_frame_owners.end())
+        {
+            throw rdk::exception::argument_invalid();
+        }
+        m_members[owner->second]->free_frames.push_back(frame);
+    }
+    m_frame_released.notify_all();
+}
+
+uint32_t DeviceFmcwGroup::get_lost_frames(uint32_t device_index) const
+{
+    if (device_index >= m_members.size())
+    {
+        throw rdk::exception::index_out_of_bounds();
+    }
+    return m_members[device_index]->lost;
+}
+
+void DeviceFmcwGroup::worker_function(uint32_t worker)
+{
+    StrataThreads::apply(StrataThreads::Acquisition, "group");
+
+    // the devices are distributed evenly and statically, so every device is only read by one worker
+    std::vector<uint32_t> indices;
+    for (auto i = worker; i < m_members.size(); i += m_num_workers)
+    {
+        indices.push_back(i);
+    }
+    const auto timeout_ms = (indices.size() > 1) ? poll_timeout_ms : wait_timeout_ms;
+
+    while (m_running)
+    {
+        bool waiting = true;
+        for (const auto index : indices)
+        {
+            auto& member = *m_members[index];
+
+            ifx_Fmcw_Frame_t* frame;
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (member.free_frames.empty())
+                {
+                    // all frames are in use, leave the data in the queue of the device
+                    continue;
+                }
+                frame = member.free_frames.back();
+                member.free_frames.pop_back();
+            }
+            waiting = false;
+
+            bool received = false;
+            try
+            {
+                received = member.device->try_get_next_frame(frame, timeout_ms);
+            }
+            catch (const std::exception& e)
+            {
+                // frame_acquisition_failed, fifo_overflow, or a lost connection
+                (void)e;
+                IFX_LOG_DEBUG("DeviceFmcwGroup - frame of device %u lost, \"%s\"", index, e.what());
+                member.lost++;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_lock);
+                if (received)
+                {
+                    m_queue.push({get_epoch_time_us(), Clock::now(), index, frame});
+                    member.queued++;
+                }
+                else
+                {
+                    member.free_frames.push_back(frame);
+                }
+            }
+            if (received)
+            {
+                m_frame_queued.notify_one();
+            }
+        }
+
+        if (waiting)
+        {
+            // no frame available for any device of this worker
+            std::unique_lock<std::mutex> lock(m_lock);
+            m_frame_released.wait_for(lock, std::chrono::milliseconds(wait_timeout_ms), [this, &indices]() {
+                return !m_running || std::any_of(indices.begin(), indices.end(), [this](uint32_t index) {
+                           return !m_members[index]->free_frames.empty();
+                       });
+            });
+        }
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Fmcw_Group_t* ifx_fmcw_group_create(ifx_Device_Fmcw_t** devices, uint32_t num_devices, uint32_t num_workers)
+{
+    auto caller = [](ifx_Device_Fmcw_t** devices, uint32_t num_devices, uint32_t num_workers) {
+        if (!devices)
+        {
+            throw rdk::exception::argument_null();
+        }
+        return new DeviceFmcwGroup(std::vector<DeviceFmcw*>(devices, devices + num_devices), num_workers);
+    };
+    return rdk::call_func(caller, nullptr, devices, num_devices, num_workers);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_destroy(ifx_Fmcw_Group_t* group)
+{
+    delete group;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_set_max_latency(ifx_Fmcw_Group_t* group, uint32_t latency_ms)
+{
+    rdk::call_func(group, &ifx_Fmcw_Group_t::set_max_latency, latency_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_set_frame_count(ifx_Fmcw_Group_t* group, uint32_t num_frames)
+{
+    rdk::call_func(group, &ifx_Fmcw_Group_t::set_frame_count, num_frames);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_start_acquisition(ifx_Fmcw_Group_t* group)
+{
+    rdk::call_func(group, &ifx_Fmcw_Group_t::start_acquisition);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_stop_acquisition(ifx_Fmcw_Group_t* group)
+{
+    rdk::call_func(group, &ifx_Fmcw_Group_t::stop_acquisition);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Fmcw_Frame_t* ifx_fmcw_group_get_next_frame(ifx_Fmcw_Group_t* group, uint32_t* device_index, uint64_t* timestamp_us, uint16_t timeout_ms)
+{
+    return rdk::call_func(group, &ifx_Fmcw_Group_t::get_next_frame, nullptr, device_index, timestamp_us, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_group_release_frame(ifx_Fmcw_Group_t* group, ifx_Fmcw_Frame_t* frame)
+{
+    rdk::call_func(group, &ifx_Fmcw_Group_t::release_frame, frame);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fmcw_group_get_lost_frames(ifx_Fmcw_Group_t* group, uint32_t device_index)
+{
+    return rdk::call_func(group, &ifx_Fmcw_Group_t::get_lost_frames, device_index);
+}
@@ -0,0 +1,248 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwGroup.h
+ *
+ * For details refer to @ref gr_devicefmcwgroup
+ */
+
+#ifndef IFX_DEVICE_FMCW_GROUP_H
+#define IFX_DEVICE_FMCW_GROUP_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+
+#include "DeviceFmcw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct DeviceFmcwGroup ifx_Fmcw_Group_t;
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @addtogroup gr_cat_Fmcw
+ * @{
+ */
+
+/**
+ * @defgroup gr_devicefmcwgroup FMCW Device Group
+ *
+ * @brief API for acquiring frames from several FMCW radar devices together
+ *
+ * A group starts and stops the acquisition of all its devices at once and
+ * reads their frames with a limited number of worker threads, so not every
+ * device needs a thread of its own. The frames of all devices are returned
+ * by a single queue, ordered by the time they were received.
+ *
+ * Here is an example how to use the group:
+ * @code
+ *      ifx_Device_Fmcw_t* devices[2] = {ifx_fmcw_create_by_uuid(uuid0), ifx_fmcw_create_by_uuid(uuid1)};
+ *      // configure the devices ...
+ *      ifx_Fmcw_Group_t* group = ifx_fmcw_group_create(devices, 2, 1);
+ *      ifx_fmcw_group_start_acquisition(group);
+ *      while (running)
+ *      {
+ *          uint32_t index;
+ *          uint64_t timestamp_us;
+ *          ifx_Fmcw_Frame_t* frame = ifx_fmcw_group_get_next_frame(group, &index, &timestamp_us, 1000);
+ *          if (frame)
+ *          {
+ *              // process the frame of devices[index] ...
+ *              ifx_fmcw_group_release_frame(group, frame);
+ *          }
+ *      }
+ *      ifx_fmcw_group_destroy(group);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a group of FMCW radar devices.
+ *
+ * The devices stay owned by the caller and must be destroyed after the group.
+ * While the acquisition of the group is running, frames must not be read from
+ * the devices directly.
+ *
+ * @param[in] devices      Array of handles to the radar devices.
+ * @param[in] num_devices  Number of devices in the array.
+ * @param[in] num_workers  Number of threads reading the frames of the devices.
+ *                         If 0, one thread per device is used. The number is
+ *                         limited to the number of devices.
+ *
+ * @return Handle to the newly created group or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Group_t* ifx_fmcw_group_create(ifx_Device_Fmcw_t** devices, uint32_t num_devices, uint32_t num_workers);
+
+/**
+ * @brief Destroys the group.
+ *
+ * The acquisition is stopped, frames obtained from the group must not be used
+ * anymore.
+ *
+ * @param[in] group  A handle to the group.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_destroy(ifx_Fmcw_Group_t* group);
+
+/**
+ * @brief Sets how long frames are held back to merge them in time order.
+ *
+ * A frame is returned when every device of the group has delivered a frame
+ * after it, or when it has been waiting for the given latency. A device which
+ * stopped delivering frames therefore delays the others by the latency at most.
+ * The default is 100 ms.
+ *
+ * @param[in] group       A handle to the group.
+ * @param[in] latency_ms  Maximum time in milliseconds a frame is held back.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_set_max_latency(ifx_Fmcw_Group_t* group, uint32_t latency_ms);
+
+/**
+ * @brief Sets how many frames are buffered per device.
+ *
+ * When all frames of a device are in use, reading the device pauses until a
+ * frame is released. The default is 4. It can only be changed while the
+ * acquisition is stopped.
+ *
+ * @param[in] group       A handle to the group.
+ * @param[in] num_frames  Number of frames per device, at least 1.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_set_frame_count(ifx_Fmcw_Group_t* group, uint32_t num_frames);
+
+/**
+ * @brief Starts the acquisition of all devices of the group.
+ *
+ * The devices are started concurrently, so their first frames are as close
+ * in time as the host allows. Without a common trigger, the frames of the
+ * devices are not synchronized sample accurate.
+ *
+ * @param[in] group  A handle to the group.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_start_acquisition(ifx_Fmcw_Group_t* group);
+
+/**
+ * @brief Stops the acquisition of all devices of the group.
+ *
+ * Frames still queued are discarded.
+ *
+ * @param[in] group  A handle to the group.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_stop_acquisition(ifx_Fmcw_Group_t* group);
+
+/**
+ * @brief Returns the next frame of any device of the group.
+ *
+ * The frames are returned in the order they were received. The frame belongs
+ * to the group and has to be given back with @ref ifx_fmcw_group_release_frame
+ * after use.
+ *
+ * @param[in]  group         A handle to the group.
+ * @param[out] device_index  Index of the device in the array passed to
+ *                           @ref ifx_fmcw_group_create. Can be NULL.
+ * @param[out] timestamp_us  Time the frame was received in microseconds since
+ *                           the epoch. Can be NULL.
+ * @param[in]  timeout_ms    Time in milliseconds to wait for a frame.
+ *
+ * @return The frame or NULL if no frame arrived within the timeout, in which
+ *         case the error is set to @ref IFX_ERROR_TIMEOUT.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Frame_t* ifx_fmcw_group_get_next_frame(ifx_Fmcw_Group_t* group, uint32_t* device_index, uint64_t* timestamp_us, uint16_t timeout_ms);
+
+/**
+ * @brief Gives a frame back to the group.
+ *
+ * @param[in] group  A handle to the group.
+ * @param[in] frame  Frame returned by @ref ifx_fmcw_group_get_next_frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_group_release_frame(ifx_Fmcw_Group_t* group, ifx_Fmcw_Frame_t* frame);
+
+/**
+ * @brief Returns the number of frames of a device lost since the start.
+ *
+ * Frames are lost when the device reports an acquisition error, for example
+ * because the host did not keep up with reading them.
+ *
+ * @param[in] group         A handle to the group.
+ * @param[in] device_index  Index of the device.
+ *
+ * @return Number of lost frames.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fmcw_group_get_lost_frames(ifx_Fmcw_Group_t* group, uint32_t device_index);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_DEVICE_FMCW_GROUP_H */
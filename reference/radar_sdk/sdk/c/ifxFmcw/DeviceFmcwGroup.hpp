@@ -0,0 +1,116 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwGroup.hpp
+ *
+ * @brief Acquisition of several FMCW devices with a shared pool of worker threads.
+ */
+
+#pragma once
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxFmcw/DeviceFmcw.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+struct DeviceFmcwGroup
+{
+    NONCOPYABLE(DeviceFmcwGroup);
+
+    DeviceFmcwGroup(std::vector<DeviceFmcw*> devices, uint32_t num_workers);
+    ~DeviceFmcwGroup();
+
+    void set_max_latency(uint32_t latency_ms);
+    void set_frame_count(uint32_t num_frames);
+
+    void start_acquisition();
+    void stop_acquisition();
+
+    ifx_Fmcw_Frame_t* get_next_frame(uint32_t* device_index, uint64_t* timestamp_us, uint16_t timeout_ms);
+    void release_frame(ifx_Fmcw_Frame_t* frame);
+
+    uint32_t get_lost_frames(uint32_t device_index) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Member
+    {
+        DeviceFmcw* device;
+        std::vector<ifx_Fmcw_Frame_t*> frames;       // all frames allocated for the device
+        std::vector<ifx_Fmcw_Frame_t*> free_frames;  // frames neither queued nor handed out, guarded by m_lock
+        uint32_t queued = 0;                         // frames of the device in m_queue, guarded by m_lock
+        std::atomic<uint32_t> lost {0};
+    };
+
+    struct QueuedFrame
+    {
+        uint64_t timestamp_us;
+        Clock::time_point received;
+        uint32_t device_index;
+        ifx_Fmcw_Frame_t* frame;
+
+        bool operator>(const QueuedFrame& other) const
+        {
+            return timestamp_us > other.timestamp_us;
+        }
+    };
+
+    void allocate_frames();
+    void destroy_frames();
+    void requeue_frames();
+    bool is_ready(const QueuedFrame& next, Clock::time_point now) const;
+    void worker_function(uint32_t worker);
+
+    std::vector<std::unique_ptr<Member>> m_members;
+    std::unordered_map<ifx_Fmcw_Frame_t*, uint32_t> m_frame_owners;
+
+    uint32_t m_num_workers;
+    uint32_t m_num_frames = 4;
+    Clock::duration m_max_latency = std::chrono::milliseconds(100);
+
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_running {false};
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_frame_queued;
+    std::condition_variable m_frame_released;
+    std::priority_queue<QueuedFrame, std::vector<QueuedFrame>, std::greater<QueuedFrame>> m_queue;  // earliest frame on top
+};
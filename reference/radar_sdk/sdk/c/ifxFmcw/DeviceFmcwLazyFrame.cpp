@@ -0,0 +1,298 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwLazyFrame.cpp
+ *
+ * @brief Implements the raw frame converted to float on demand.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwLazyFrame.h"
+#include "DeviceFmcwLazyFrame.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/FunctionWrapper.hpp"
+
+#include <algorithm>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// antenna of the key of a view holding a whole cube
+constexpr uint32_t all_antennas = 0xFFFFFFFF;
+
+bool same_cubes(const std::vector<FmcwRawFrameLayout::Cube>& a, const std::vector<FmcwRawFrameLayout::Cube>& b)
+{
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+        return (x.num_rx == y.num_rx) && (x.num_chirps == y.num_chirps) && (x.num_samples == y.num_samples)
+               && (x.offset == y.offset) && (x.chirp_step == y.chirp_step);
+    });
+}
+
+/* Converts num_chirps x num_samples samples of one antenna, starting at
+ * src, into rows of a matrix.
+ */
+void convert_chirps(const uint16_t* src, const FmcwRawFrameLayout::Cube& cube, ifx_Float_t scale,
+                    uint32_t num_chirps, uint32_t num_samples, ifx_Float_t* dst, size_t dst_row_stride)
+{
+    for (uint32_t chirp = 0; chirp < num_chirps; chirp++, src += cube.chirp_step, dst += dst_row_stride)
+    {
+        if (cube.num_rx == 1)
+        {
+            for (uint32_t sample = 0; sample < num_samples; sample++)
+            {
+                dst[sample] = static_cast<ifx_Float_t>(src[sample]) * scale - 1.0f;
+            }
+        }
+        else
+        {
+            for (uint32_t sample = 0; sample < num_samples; sample++)
+            {
+                dst[sample] = static_cast<ifx_Float_t>(src[size_t(sample) * cube.num_rx]) * scale - 1.0f;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwLazyFrame::DeviceFmcwLazyFrame(DeviceFmcw* device) :
+    m_device(device)
+{
+    if (!device)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    device->get_raw_frame_layout(m_layout);
+    m_raw.reset(device->allocate_raw_frame());
+}
+
+void DeviceFmcwLazyFrame::read(DeviceFmcw* device, uint16_t timeout_ms)
+{
+    if (device != m_device)
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    // the configuration may have changed since the last frame
+    FmcwRawFrameLayout layout;
+    layout.cubes.reserve(m_layout.cubes.size());
+    device->get_raw_frame_layout(layout);
+    if (!same_cubes(layout.cubes, m_layout.cubes))
+    {
+        m_views.clear();
+    }
+    if (layout.num_samples != m_raw->num_samples)
+    {
+        m_raw.reset(device->allocate_raw_frame());
+    }
+    m_layout = std::move(layout);
+
+    for (auto& view : m_views)
+    {
+        view->valid = false;
+    }
+
+    device->get_next_raw_frame(m_raw.get(), timeout_ms);
+}
+
+const FmcwRawFrameLayout::Cube& DeviceFmcwLazyFrame::get_layout(uint32_t cube) const
+{
+    if (cube >= m_layout.cubes.size())
+    {
+        throw rdk::exception::index_out_of_bounds();
+    }
+    return m_layout.cubes[cube];
+}
+
+DeviceFmcwLazyFrame::View& DeviceFmcwLazyFrame::find_view(const std::array<uint32_t, 6>& key)
+{
+    for (auto& view : m_views)
+    {
+        if (view->key == key)
+        {
+            return *view;
+        }
+    }
+
+    m_views.emplace_back(new View {key, {}, {}, false});
+    return *m_views.back();
+}
+
+const ifx_Fmcw_Raw_Frame_t* DeviceFmcwLazyFrame::get_raw() const
+{
+    return m_raw.get();
+}
+
+uint32_t DeviceFmcwLazyFrame::get_num_cubes() const
+{
+    return static_cast<uint32_t>(m_layout.cubes.size());
+}
+
+const ifx_Mda_R_t* DeviceFmcwLazyFrame::get_cube(uint32_t cube)
+{
+    const auto& layout = get_layout(cube);
+
+    auto& view = find_view({cube, all_antennas, 0, layout.num_chirps, 0, layout.num_samples});
+    if (view.valid)
+    {
+        return &view.mda;
+    }
+
+    const std::array<uint32_t, 3> shape = {layout.num_rx, layout.num_chirps, layout.num_samples};
+    const size_t antenna_size = size_t(layout.num_chirps) * layout.num_samples;
+    const std::array<size_t, 3> stride = {antenna_size, layout.num_samples, 1};
+    view.data.resize(layout.num_rx * antenna_size);
+    ifx_mda_rawview_r(&view.mda, view.data.data(), 3, shape.data(), stride.data(), 0);
+
+    for (uint32_t rx = 0; rx < layout.num_rx; rx++)
+    {
+        convert_chirps(m_raw->samples + layout.offset + rx, layout, m_layout.scale, layout.num_chirps, layout.num_samples,
+                       view.data.data() + rx * antenna_size, layout.num_samples);
+    }
+
+    view.valid = true;
+    return &view.mda;
+}
+
+const ifx_Mda_R_t* DeviceFmcwLazyFrame::get_antenna(uint32_t cube, uint32_t antenna, uint32_t first_chirp, uint32_t num_chirps,
+                                                    uint32_t first_sample, uint32_t num_samples)
+{
+    const auto& layout = get_layout(cube);
+    if ((antenna >= layout.num_rx) || (first_chirp >= layout.num_chirps) || (first_sample >= layout.num_samples))
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+
+    if (num_chirps == 0)
+    {
+        num_chirps = layout.num_chirps - first_chirp;
+    }
+    if (num_samples == 0)
+    {
+        num_samples = layout.num_samples - first_sample;
+    }
+    if ((num_chirps > layout.num_chirps - first_chirp) || (num_samples > layout.num_samples - first_sample))
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+
+    auto& view = find_view({cube, antenna, first_chirp, num_chirps, first_sample, num_samples});
+    if (view.valid)
+    {
+        return &view.mda;
+    }
+
+    view.data.resize(size_t(num_chirps) * num_samples);
+    ifx_mat_rawview_r(&view.mda, view.data.data(), num_chirps, num_samples, num_samples);
+
+    const auto* src = m_raw->samples + layout.offset + first_chirp * layout.chirp_step + size_t(first_sample) * layout.num_rx + antenna;
+    convert_chirps(src, layout, m_layout.scale, num_chirps, num_samples, view.data.data(), num_samples);
+
+    view.valid = true;
+    return &view.mda;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Fmcw_Lazy_Frame_t* ifx_fmcw_create_lazy_frame(ifx_Device_Fmcw_t* handle)
+{
+    auto caller = [](ifx_Device_Fmcw_t* handle) {
+        return new DeviceFmcwLazyFrame(handle);
+    };
+    return rdk::call_func(caller, nullptr, handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_destroy_lazy_frame(ifx_Fmcw_Lazy_Frame_t* frame)
+{
+    delete frame;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_get_next_lazy_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Lazy_Frame_t* frame, uint16_t timeout_ms)
+{
+    rdk::call_func(frame, &ifx_Fmcw_Lazy_Frame_t::read, handle, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Fmcw_Raw_Frame_t* ifx_fmcw_lazy_frame_get_raw(ifx_Fmcw_Lazy_Frame_t* frame)
+{
+    return rdk::call_func(frame, &ifx_Fmcw_Lazy_Frame_t::get_raw);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fmcw_lazy_frame_get_num_cubes(ifx_Fmcw_Lazy_Frame_t* frame)
+{
+    return rdk::call_func(frame, &ifx_Fmcw_Lazy_Frame_t::get_num_cubes);
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Mda_R_t* ifx_fmcw_lazy_frame_get_cube(ifx_Fmcw_Lazy_Frame_t* frame, uint32_t cube)
+{
+    return rdk::call_func(frame, &ifx_Fmcw_Lazy_Frame_t::get_cube, cube);
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Matrix_R_t* ifx_fmcw_lazy_frame_get_antenna(ifx_Fmcw_Lazy_Frame_t* frame, uint32_t cube, uint32_t antenna,
+                                                      uint32_t first_chirp, uint32_t num_chirps,
+                                                      uint32_t first_sample, uint32_t num_samples)
+{
+    return rdk::call_func(frame, &ifx_Fmcw_Lazy_Frame_t::get_antenna, cube, antenna, first_chirp, num_chirps,
+                          first_sample, num_samples);
+}
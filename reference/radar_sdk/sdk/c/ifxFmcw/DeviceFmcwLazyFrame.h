@@ -0,0 +1,217 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwLazyFrame.h
+ *
+ * For details refer to @ref gr_devicefmcwlazyframe
+ */
+
+#ifndef IFX_DEVICE_FMCW_LAZY_FRAME_H
+#define IFX_DEVICE_FMCW_LAZY_FRAME_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mda.h"
+
+#include "DeviceFmcw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct DeviceFmcwLazyFrame ifx_Fmcw_Lazy_Frame_t;
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @addtogroup gr_cat_Fmcw
+ * @{
+ */
+
+/**
+ * @defgroup gr_devicefmcwlazyframe FMCW Lazy Frame
+ *
+ * @brief API for frames converted to float only where they are used
+ *
+ * @ref ifx_fmcw_get_next_frame converts every sample of a frame into the
+ * float cubes of @ref ifx_Fmcw_Frame_t, even if only one antenna or a few
+ * chirps are processed. A lazy frame keeps the raw samples (2 bytes per
+ * sample) and converts the parts requested by the application: a whole cube,
+ * or the chirps of one antenna restricted to a range of chirps and samples.
+ * The converted parts are cached, requesting the same part again for the
+ * same frame returns it without conversion.
+ *
+ * The values of the views are those of the cubes of @ref ifx_Fmcw_Frame_t.
+ * Views stay valid until the next frame is read into the lazy frame.
+ *
+ * Here is an example processing a region of interest of antenna 0:
+ * @code
+ *      ifx_Fmcw_Lazy_Frame_t* frame = ifx_fmcw_create_lazy_frame(device_handle);
+ *      while (running)
+ *      {
+ *          ifx_fmcw_get_next_lazy_frame(device_handle, frame, 1000);
+ *          // chirps 0 to 15, samples 32 to 95 of antenna 0 of the first cube
+ *          const ifx_Matrix_R_t* roi = ifx_fmcw_lazy_frame_get_antenna(frame, 0, 0, 0, 16, 32, 64);
+ *          // process roi ...
+ *      }
+ *      ifx_fmcw_destroy_lazy_frame(frame);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a lazy frame for the frames of a device.
+ *
+ * @param[in] handle  A handle to the radar device.
+ *
+ * @return Handle to the newly created lazy frame or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Lazy_Frame_t* ifx_fmcw_create_lazy_frame(ifx_Device_Fmcw_t* handle);
+
+/**
+ * @brief Destroys the lazy frame and all its views.
+ *
+ * @param[in] frame  A handle to the lazy frame.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_destroy_lazy_frame(ifx_Fmcw_Lazy_Frame_t* frame);
+
+/**
+ * @brief Reads the next frame as raw samples.
+ *
+ * Like @ref ifx_fmcw_get_next_raw_frame_timeout, but no conversion is done
+ * until a view is requested. If the configuration of the device changed, the
+ * frame is resized accordingly.
+ *
+ * @param[in]     handle      A handle to the radar device.
+ * @param[in,out] frame       The lazy frame, created for this device.
+ * @param[in]     timeout_ms  Timeout in milliseconds.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_get_next_lazy_frame(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Lazy_Frame_t* frame, uint16_t timeout_ms);
+
+/**
+ * @brief Returns the raw samples of the frame.
+ *
+ * @param[in] frame  A handle to the lazy frame.
+ *
+ * @return The raw frame, including its timestamps.
+ */
+IFX_DLL_PUBLIC
+const ifx_Fmcw_Raw_Frame_t* ifx_fmcw_lazy_frame_get_raw(ifx_Fmcw_Lazy_Frame_t* frame);
+
+/**
+ * @brief Returns the number of cubes of the frame, see @ref ifx_Fmcw_Frame_t.
+ *
+ * @param[in] frame  A handle to the lazy frame.
+ *
+ * @return Number of cubes.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fmcw_lazy_frame_get_num_cubes(ifx_Fmcw_Lazy_Frame_t* frame);
+
+/**
+ * @brief Returns a whole cube of the frame converted to float.
+ *
+ * The cube has the dimensions antennas x chirps x samples like the cubes of
+ * @ref ifx_Fmcw_Frame_t.
+ *
+ * @param[in] frame  A handle to the lazy frame.
+ * @param[in] cube   Index of the cube.
+ *
+ * @return The converted cube, NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+const ifx_Mda_R_t* ifx_fmcw_lazy_frame_get_cube(ifx_Fmcw_Lazy_Frame_t* frame, uint32_t cube);
+
+/**
+ * @brief Returns chirps of one antenna converted to float.
+ *
+ * The matrix holds one row per chirp of the chirp range with the samples of
+ * the sample range. A count of 0 selects everything from the first index to
+ * the end.
+ *
+ * @param[in] frame         A handle to the lazy frame.
+ * @param[in] cube          Index of the cube.
+ * @param[in] antenna       Index of the antenna in the cube.
+ * @param[in] first_chirp   First chirp of the range.
+ * @param[in] num_chirps    Number of chirps, 0 for all following first_chirp.
+ * @param[in] first_sample  First sample of the range within each chirp.
+ * @param[in] num_samples   Number of samples, 0 for all following first_sample.
+ *
+ * @return The converted matrix, NULL in case of failure. Fails with
+ *         IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS if a range exceeds the cube.
+ */
+IFX_DLL_PUBLIC
+const ifx_Matrix_R_t* ifx_fmcw_lazy_frame_get_antenna(ifx_Fmcw_Lazy_Frame_t* frame, uint32_t cube, uint32_t antenna,
+                                                      uint32_t first_chirp, uint32_t num_chirps,
+                                                      uint32_t first_sample, uint32_t num_samples);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_DEVICE_FMCW_LAZY_FRAME_H */
@@ -0,0 +1,80 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwLazyFrame.hpp
+ *
+ * @brief Raw frame converted to float on demand.
+ */
+
+#pragma once
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxFmcw/DeviceFmcw.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+
+struct DeviceFmcwLazyFrame
+{
+    NONCOPYABLE(DeviceFmcwLazyFrame);
+
+    explicit DeviceFmcwLazyFrame(DeviceFmcw* device);
+    ~DeviceFmcwLazyFrame() = default;
+
+    void read(DeviceFmcw* device, uint16_t timeout_ms);
+
+    const ifx_Fmcw_Raw_Frame_t* get_raw() const;
+    uint32_t get_num_cubes() const;
+    const ifx_Mda_R_t* get_cube(uint32_t cube);
+    const ifx_Mda_R_t* get_antenna(uint32_t cube, uint32_t antenna, uint32_t first_chirp, uint32_t num_chirps,
+                                   uint32_t first_sample, uint32_t num_samples);
+
+private:
+    // A converted part of the frame. Views are kept across frames so their
+    // memory is reused, valid tells if it holds the current frame.
+    struct View
+    {
+        std::array<uint32_t, 6> key;  // cube, antenna (all_antennas for a cube), chirp and sample ranges
+        std::vector<ifx_Float_t> data;
+        ifx_Mda_R_t mda;
+        bool valid;
+    };
+
+    View& find_view(const std::array<uint32_t, 6>& key);
+    const FmcwRawFrameLayout::Cube& get_layout(uint32_t cube) const;
+
+    DeviceFmcw* m_device;
+    FmcwRawFrameLayout m_layout;
+    SmartFmcwRawFrame m_raw;
+    std::vector<std::unique_ptr<View>> m_views;
+};
@@ -0,0 +1,451 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwNetwork.cpp
+ *
+ * @brief Implements the network publisher and subscriber of FMCW frames.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwNetwork.h"
+#include "DeviceFmcwPublisher.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/FunctionWrapper.hpp"
+#include "ifxBase/Log.h"
+#include "ifxBase/internal/Util.h"  // for ifx_util_popcount
+
+#include "network/DeviceFmcwSubscriber.hpp"
+#include "network/FrameCodec.hpp"
+
+#include <algorithm>
+#include <common/Threads.hpp>
+#include <exception>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+constexpr uint32_t default_queue_size = 4;
+constexpr uint16_t default_max_datagram_size = 1472;
+constexpr uint8_t default_multicast_ttl = 1;
+
+// The configuration is repeated for subscribers joining later.
+constexpr auto configuration_interval = std::chrono::seconds(1);
+
+uint64_t epoch_time_us()
+{
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
+}
+
+const ifx_Fmcw_Sequence_Element_t* find_first_chirp(const ifx_Fmcw_Sequence_Element_t* element)
+{
+    for (; element != nullptr; element = element->next_element)
+    {
+        if (element->type == IFX_SEQ_CHIRP)
+        {
+            return element;
+        }
+        if (element->type == IFX_SEQ_LOOP)
+        {
+            const auto* chirp = find_first_chirp(element->loop.sub_sequence);
+            if (chirp)
+            {
+                return chirp;
+            }
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwPublisher::DeviceFmcwPublisher(DeviceFmcw* device, const ifx_Fmcw_Publisher_Config_t& config) :
+    m_device(device),
+    m_format(config.format),
+    m_remote {},
+    m_max_datagram_size(config.max_datagram_size ? config.max_datagram_size : default_max_datagram_size)
+{
+    if (!device)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    if (!FrameDatagram::parse_address(config.address, m_remote.ip) || (config.port == 0)
+        || (m_max_datagram_size <= FrameDatagram::header_size)
+        || ((m_format != IFX_FMCW_NETWORK_RAW) && (m_format != IFX_FMCW_NETWORK_PACKED12) && (m_format != IFX_FMCW_NETWORK_DELTA_RICE)))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+    m_remote.port = config.port;
+
+    try
+    {
+        m_socket.open(0, 0, nullptr, 1000);
+        if (FrameDatagram::is_multicast(m_remote.ip))
+        {
+            m_socket.setMulticastTtl(config.multicast_ttl ? config.multicast_ttl : default_multicast_ttl);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_ERROR("DeviceFmcwPublisher - opening the socket failed, \"%s\"", e.what());
+        throw rdk::exception::not_possible();
+    }
+
+    const auto queue_size = config.queue_size ? config.queue_size : default_queue_size;
+    for (uint32_t i = 0; i < queue_size; i++)
+    {
+        m_items.emplace_back(new Item());
+        m_free.push_back(m_items.back().get());
+    }
+    m_datagram.resize(m_max_datagram_size);
+
+    m_worker = std::thread(&DeviceFmcwPublisher::worker_thread, this);
+}
+
+DeviceFmcwPublisher::~DeviceFmcwPublisher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_worker.join();
+}
+
+void DeviceFmcwPublisher::update_configuration(uint32_t num_samples)
+{
+    const auto sensor_type = static_cast<uint32_t>(m_device->get_sensor_type());
+    const auto& registers = m_device->get_register_list();
+    const auto hash = FrameDatagram::configuration_hash(sensor_type, registers);
+    if (hash == m_config_hash)
+    {
+        return;
+    }
+
+    // The delta-Rice coding predicts a sample from the same sample of the
+    // previous chirp, so it needs the interleaving of the chirps.
+    m_chirp_stride = num_samples;
+    m_num_lanes = 1;
+
+    auto* sequence = m_device->get_acquisition_sequence();
+    const auto* chirp = find_first_chirp(sequence);
+    if (chirp)
+    {
+        const auto lanes = std::max(ifx_util_popcount(chirp->chirp.rx_mask), 1u);
+        const auto stride = chirp->chirp.num_samples * lanes;
+        if ((stride != 0) && (num_samples % stride == 0))
+        {
+            m_chirp_stride = stride;
+            m_num_lanes = static_cast<uint16_t>(lanes);
+        }
+    }
+    ifx_fmcw_destroy_sequence(sequence);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_configuration = {sensor_type, num_samples, registers};
+    m_configured = true;
+    m_configuration_changed = true;
+    m_config_hash = hash;
+}
+
+void DeviceFmcwPublisher::worker_thread()
+{
+    StrataThreads::apply(StrataThreads::Processing, "publish");
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        m_wakeup.wait_for(lock, configuration_interval, [this] {
+            return m_stop || m_configuration_changed || !m_queue.empty();
+        });
+
+        if (m_configured && (m_configuration_changed || (Clock::now() - m_configuration_sent >= configuration_interval)))
+        {
+            const auto hash = m_config_hash;
+            m_payload = FrameDatagram::encode_configuration(m_configuration);
+            m_configuration_changed = false;
+            lock.unlock();
+            send_configuration(hash);
+            lock.lock();
+        }
+
+        if (!m_queue.empty())
+        {
+            auto* item = m_queue.front();
+            m_queue.pop_front();
+            lock.unlock();
+            send_frame(*item);
+            lock.lock();
+            m_free.push_back(item);
+        }
+        else if (m_stop)
+        {
+            break;
+        }
+    }
+}
+
+void DeviceFmcwPublisher::send_configuration(uint32_t config_hash)
+{
+    FrameDatagram::Header header = {};
+    header.type = FrameDatagram::message_configuration;
+    header.config_hash = config_hash;
+    header.message_index = m_configuration_index++;
+
+    try
+    {
+        send_message(header, m_payload.data(), m_payload.size());
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_ERROR("DeviceFmcwPublisher - sending the configuration failed, \"%s\"", e.what());
+    }
+    m_configuration_sent = Clock::now();
+}
+
+void DeviceFmcwPublisher::send_frame(const Item& item)
+{
+    const auto num_samples = static_cast<uint32_t>(item.samples.size());
+
+    FrameDatagram::Header header = {};
+    header.type = FrameDatagram::message_frame;
+    header.config_hash = item.config_hash;
+    header.message_index = m_frame_index++;
+    header.sample_count = num_samples;
+    header.num_lanes = item.num_lanes;
+    header.chirp_stride = item.chirp_stride;
+    header.timestamp_device_us = item.timestamp_device_us;
+    header.timestamp_received_us = item.timestamp_received_us;
+
+    const auto packed_size = FrameCodec::packed12_size(num_samples);
+    m_payload.resize(std::max(packed_size, num_samples * sizeof(uint16_t)));
+
+    size_t size = 0;
+    if (m_format == IFX_FMCW_NETWORK_DELTA_RICE)
+    {
+        // only used if it is smaller than Packed12
+        size = FrameCodec::rice_encode(item.samples.data(), num_samples, item.chirp_stride, item.num_lanes,
+                                       m_payload.data(), packed_size - 1);
+        header.sample_format = FrameDatagram::sample_format_packed12;
+        header.flags = size ? FrameDatagram::flag_delta_rice : 0;
+    }
+
+    if (size == 0)
+    {
+        if (m_format == IFX_FMCW_NETWORK_RAW)
+        {
+            for (uint32_t i = 0; i < num_samples; i++)
+            {
+                m_payload[2 * i] = static_cast<uint8_t>(item.samples[i]);
+                m_payload[2 * i + 1] = static_cast<uint8_t>(item.samples[i] >> 8);
+            }
+            size = num_samples * sizeof(uint16_t);
+            header.sample_format = FrameDatagram::sample_format_u16le;
+        }
+        else
+        {
+            FrameCodec::pack12(item.samples.data(), num_samples, m_payload.data());
+            size = packed_size;
+            header.sample_format = FrameDatagram::sample_format_packed12;
+        }
+    }
+
+    try
+    {
+        send_message(header, m_payload.data(), size);
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_ERROR("DeviceFmcwPublisher - sending a frame failed, \"%s\"", e.what());
+        m_statistics.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - item.queued).count();
+    m_statistics.count_frame(num_samples, static_cast<uint64_t>(latency));
+}
+
+void DeviceFmcwPublisher::send_message(FrameDatagram::Header& header, const uint8_t* payload, size_t size)
+{
+    const auto fragment_size = static_cast<uint16_t>(m_max_datagram_size - FrameDatagram::header_size);
+
+    header.payload_size = static_cast<uint32_t>(size);
+    header.fragment_size = fragment_size;
+    header.timestamp_sent_us = epoch_time_us();
+
+    size_t offset = 0;
+    do
+    {
+        const auto length = std::min<size_t>(fragment_size, size - offset);
+        header.fragment_offset = static_cast<uint32_t>(offset);
+
+        FrameDatagram::write_header(header, m_datagram.data());
+        std::copy(payload + offset, payload + offset + length, m_datagram.data() + FrameDatagram::header_size);
+
+        const auto datagram_size = static_cast<uint16_t>(FrameDatagram::header_size + length);
+        m_socket.sendTo(m_datagram.data(), datagram_size, &m_remote);
+        m_statistics.count_datagram(datagram_size);
+
+        offset += length;
+    } while (offset < size);
+}
+
+bool DeviceFmcwPublisher::send(const ifx_Fmcw_Raw_Frame_t* frame)
+{
+    if (!frame || !frame->samples)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    update_configuration(frame->num_samples);
+
+    Item* item;
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_free.empty())
+        {
+            m_statistics.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        item = m_free.back();
+        m_free.pop_back();
+    }
+
+    // items taken from the free list are owned by this thread until queued
+    item->samples.assign(frame->samples, frame->samples + frame->num_samples);
+    item->timestamp_device_us = frame->timestamp_device_us;
+    item->timestamp_received_us = frame->timestamp_received_us;
+    item->config_hash = m_config_hash;
+    item->chirp_stride = m_chirp_stride;
+    item->num_lanes = m_num_lanes;
+    item->queued = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_queue.push_back(item);
+    }
+    m_wakeup.notify_one();
+    return true;
+}
+
+void DeviceFmcwPublisher::get_statistics(ifx_Fmcw_Network_Statistics_t* statistics) const
+{
+    if (!statistics)
+    {
+        throw rdk::exception::argument_null();
+    }
+    m_statistics.read(statistics);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Fmcw_Publisher_t* ifx_fmcw_publisher_create(ifx_Device_Fmcw_t* device, const ifx_Fmcw_Publisher_Config_t* config)
+{
+    auto caller = [](ifx_Device_Fmcw_t* device, const ifx_Fmcw_Publisher_Config_t* config) {
+        if (!config)
+        {
+            throw rdk::exception::argument_null();
+        }
+        return new DeviceFmcwPublisher(device, *config);
+    };
+    return rdk::call_func(caller, nullptr, device, config);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_publisher_destroy(ifx_Fmcw_Publisher_t* publisher)
+{
+    delete publisher;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_fmcw_publisher_send(ifx_Fmcw_Publisher_t* publisher, const ifx_Fmcw_Raw_Frame_t* frame)
+{
+    return rdk::call_func(publisher, &ifx_Fmcw_Publisher_t::send, frame);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_publisher_get_statistics(ifx_Fmcw_Publisher_t* publisher, ifx_Fmcw_Network_Statistics_t* statistics)
+{
+    rdk::call_func(publisher, &ifx_Fmcw_Publisher_t::get_statistics, statistics);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Device_Fmcw_t* ifx_fmcw_create_subscriber(const char* address, uint16_t port, uint16_t timeout_ms)
+{
+    auto caller = [](const char* address, uint16_t port, uint16_t timeout_ms) -> ifx_Device_Fmcw_t* {
+        return DeviceFmcwSubscriber::create(address, port, timeout_ms).release();
+    };
+    return rdk::call_func(caller, nullptr, address, port, timeout_ms);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_subscriber_get_statistics(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Network_Statistics_t* statistics)
+{
+    auto caller = [](ifx_Device_Fmcw_t* handle, ifx_Fmcw_Network_Statistics_t* statistics) {
+        auto* subscriber = dynamic_cast<DeviceFmcwSubscriber*>(handle);
+        if (!subscriber)
+        {
+            throw rdk::exception::not_supported();
+        }
+        subscriber->get_statistics(statistics);
+    };
+    rdk::call_func(caller, handle, statistics);
+}
@@ -0,0 +1,264 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwNetwork.h
+ *
+ * For details refer to @ref gr_devicefmcwnetwork
+ */
+
+#ifndef IFX_DEVICE_FMCW_NETWORK_H
+#define IFX_DEVICE_FMCW_NETWORK_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+
+#include "DeviceFmcw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct DeviceFmcwPublisher ifx_Fmcw_Publisher_t;
+
+/**
+ * @brief Encoding of the samples sent by a publisher.
+ */
+typedef enum
+{
+    IFX_FMCW_NETWORK_RAW = 0,        /**< Samples as uint16, 2 bytes per sample. */
+    IFX_FMCW_NETWORK_PACKED12 = 1,   /**< 12 bit samples packed, 1.5 bytes per sample. */
+    IFX_FMCW_NETWORK_DELTA_RICE = 2, /**< Lossless chirp-to-chirp delta and Rice coding of 12 bit
+                                          samples like the RADR stream of the firmware. Frames which
+                                          do not get smaller are sent as Packed12. */
+} ifx_Fmcw_Network_Format_t;
+
+/**
+ * @brief Settings of a publisher.
+ *
+ * Fields set to 0 take the defaults given in their description.
+ */
+typedef struct
+{
+    const char* address;              /**< IPv4 address the frames are sent to in dotted notation,
+                                           a multicast group (224.0.0.0 to 239.255.255.255) reaches
+                                           every subscriber joining it. */
+    uint16_t port;                    /**< UDP port the frames are sent to. */
+    ifx_Fmcw_Network_Format_t format; /**< Encoding of the samples. */
+    uint32_t queue_size;              /**< Frames waiting to be encoded and sent, default 4. */
+    uint16_t max_datagram_size;       /**< Largest UDP payload sent, default 1472 (fits an Ethernet
+                                           frame without IP fragmentation). */
+    uint8_t multicast_ttl;            /**< Number of routers multicast datagrams may pass, default 1. */
+} ifx_Fmcw_Publisher_Config_t;
+
+/**
+ * @brief Counters of a publisher or subscriber.
+ *
+ * The counters accumulate from the creation of the publisher or subscriber.
+ */
+typedef struct
+{
+    uint64_t num_frames;      /**< Frames sent or completely received. */
+    uint64_t frames_dropped;  /**< Publisher: frames dropped because the queue was full.
+                                   Subscriber: frames lost or incomplete on the network. */
+    uint64_t num_datagrams;   /**< Datagrams sent or received. */
+    uint64_t raw_bytes;       /**< Size of the frames as uint16 samples. */
+    uint64_t network_bytes;   /**< Size of the datagrams including their headers. */
+    float bandwidth_bytes_s;  /**< network_bytes per second since the first frame. */
+    float compression_ratio;  /**< raw_bytes / network_bytes, 0 before the first frame. */
+    float latency_mean_s;     /**< Publisher: mean time from @ref ifx_fmcw_publisher_send until the
+                                   last datagram of the frame is sent. Subscriber: mean time from
+                                   sending the frame until it is received completely, which needs
+                                   synchronized clocks of both hosts. */
+    float latency_max_s;      /**< Maximum of this time. */
+} ifx_Fmcw_Network_Statistics_t;
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @addtogroup gr_cat_Fmcw
+ * @{
+ */
+
+/**
+ * @defgroup gr_devicefmcwnetwork FMCW Network Publisher
+ *
+ * @brief API for sending raw frames to other hosts
+ *
+ * A publisher sends the raw frames handed to it as UDP datagrams, unicast or
+ * to a multicast group. The frames are copied into a queue and encoded and
+ * sent by a worker thread, so publishing never blocks the acquisition; if the
+ * queue is full the frame is dropped. Every frame carries a hash of the
+ * device configuration and its timestamps. The configuration itself (sensor
+ * type and register list) is sent when it changes and once a second.
+ *
+ * A subscriber created with @ref ifx_fmcw_create_subscriber is a device
+ * handle like the one of a connected sensor: it is configured like the
+ * device of the publisher and returns the received frames with
+ * @ref ifx_fmcw_get_next_raw_frame, @ref ifx_fmcw_get_next_frame and the
+ * other frame functions. Its configuration is owned by the publisher, setting
+ * a different sequence fails with IFX_ERROR_NOT_POSSIBLE.
+ *
+ * Here is an example of an edge device publishing its frames:
+ * @code
+ *      ifx_Fmcw_Publisher_Config_t config = {"239.0.0.1", 55100, IFX_FMCW_NETWORK_DELTA_RICE};
+ *      ifx_Fmcw_Publisher_t* publisher = ifx_fmcw_publisher_create(device, &config);
+ *      ifx_Fmcw_Raw_Frame_t* frame = ifx_fmcw_allocate_raw_frame(device);
+ *      ifx_fmcw_start_acquisition(device);
+ *      while (running)
+ *      {
+ *          ifx_fmcw_get_next_raw_frame(device, frame);
+ *          ifx_fmcw_publisher_send(publisher, frame);
+ *          // process the frame locally ...
+ *      }
+ *      ifx_fmcw_publisher_destroy(publisher);
+ * @endcode
+ * and of an analytics server receiving them:
+ * @code
+ *      ifx_Device_Fmcw_t* device = ifx_fmcw_create_subscriber("239.0.0.1", 55100, 5000);
+ *      ifx_Fmcw_Frame_t* frame = ifx_fmcw_allocate_frame(device);
+ *      while (running)
+ *          ifx_fmcw_get_next_frame(device, frame);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a publisher for the frames of a device.
+ *
+ * The device stays owned by the caller and must be destroyed after the
+ * publisher.
+ *
+ * @param[in] device  A handle to the radar device the frames are read from.
+ * @param[in] config  Settings of the publisher.
+ *
+ * @return Handle to the newly created publisher or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Publisher_t* ifx_fmcw_publisher_create(ifx_Device_Fmcw_t* device, const ifx_Fmcw_Publisher_Config_t* config);
+
+/**
+ * @brief Destroys the publisher.
+ *
+ * Frames still in the queue are sent first.
+ *
+ * @param[in] publisher  A handle to the publisher.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_publisher_destroy(ifx_Fmcw_Publisher_t* publisher);
+
+/**
+ * @brief Queues a raw frame of the device for sending.
+ *
+ * The frame is copied, the caller may reuse it right away. Call it from the
+ * thread reading the frames of the device, since the configuration of the
+ * device is checked for changes.
+ *
+ * @param[in] publisher  A handle to the publisher.
+ * @param[in] frame      The raw frame as returned by @ref ifx_fmcw_get_next_raw_frame.
+ *
+ * @return true if the frame was queued, false if it was dropped because the
+ *         queue is full.
+ */
+IFX_DLL_PUBLIC
+bool ifx_fmcw_publisher_send(ifx_Fmcw_Publisher_t* publisher, const ifx_Fmcw_Raw_Frame_t* frame);
+
+/**
+ * @brief Reads the counters of the publisher.
+ *
+ * @param[in]  publisher   A handle to the publisher.
+ * @param[out] statistics  The current counters.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_publisher_get_statistics(ifx_Fmcw_Publisher_t* publisher, ifx_Fmcw_Network_Statistics_t* statistics);
+
+/**
+ * @brief Creates a device receiving the frames of a publisher.
+ *
+ * The function waits until the configuration of the publisher is received.
+ *
+ * @param[in] address     The multicast group the publisher sends to, or NULL
+ *                        (or "0.0.0.0") for frames sent to this host.
+ * @param[in] port        UDP port the publisher sends to.
+ * @param[in] timeout_ms  Time to wait for the configuration in milliseconds.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ *         Fails with IFX_ERROR_TIMEOUT if no configuration was received.
+ */
+IFX_DLL_PUBLIC
+ifx_Device_Fmcw_t* ifx_fmcw_create_subscriber(const char* address, uint16_t port, uint16_t timeout_ms);
+
+/**
+ * @brief Reads the counters of a subscriber.
+ *
+ * @param[in]  handle      A handle to a device created by @ref ifx_fmcw_create_subscriber.
+ * @param[out] statistics  The current counters.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_subscriber_get_statistics(ifx_Device_Fmcw_t* handle, ifx_Fmcw_Network_Statistics_t* statistics);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_DEVICE_FMCW_NETWORK_H */
@@ -0,0 +1,96 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwOwned.hpp
+ *
+ * @brief Move-only owners of FMCW devices and frames for C++ users.
+ *
+ * See ifxBase/Owned.hpp. A frame taken from the ring of the device with
+ * @ref rdk::fmcw::acquire_frame is returned to the ring when its owner goes
+ * away, so it can be handed to a processing thread with @ref rdk::transfer
+ * instead of cloning its cubes.
+ *
+ * @code
+ *   rdk::fmcw::Device device(ifx_fmcw_create());
+ *   rdk::fmcw::Frame frame(ifx_fmcw_allocate_frame(device.get()));
+ *
+ *   rdk::fmcw::RingFrame ring_frame = rdk::fmcw::acquire_frame(device.get(), 1000);
+ *   if(ring_frame)
+ *       worker.push(rdk::transfer(ring_frame));
+ * @endcode
+ */
+
+#ifndef IFX_FMCW_DEVICE_FMCW_OWNED_HPP
+#define IFX_FMCW_DEVICE_FMCW_OWNED_HPP
+
+#include "DeviceFmcw.h"
+#include "ifxBase/Owned.hpp"
+
+#include <memory>
+
+
+namespace rdk {
+namespace fmcw {
+
+using Device = Owned<ifx_Device_Fmcw_t, ifx_fmcw_destroy>;
+using Frame = Owned<ifx_Fmcw_Frame_t, ifx_fmcw_destroy_frame>;
+using RawFrame = Owned<ifx_Fmcw_Raw_Frame_t, ifx_fmcw_destroy_raw_frame>;
+
+/* Deleter returning a frame to the ring of its device, see
+   ifx_fmcw_release_frame. The device must outlive the frame. */
+struct RingFrameDeleter
+{
+    ifx_Device_Fmcw_t* device = nullptr;
+
+    void operator()(ifx_Fmcw_Frame_t* frame) const noexcept
+    {
+        ifx_fmcw_release_frame(device, frame);
+    }
+};
+
+using RingFrame = std::unique_ptr<ifx_Fmcw_Frame_t, RingFrameDeleter>;
+
+/* Takes the next frame from the ring of device, see ifx_fmcw_acquire_frame.
+   The owner is empty if no frame was received. */
+inline RingFrame acquire_frame(ifx_Device_Fmcw_t* device, uint16_t timeout_ms)
+{
+    return RingFrame(ifx_fmcw_acquire_frame(device, timeout_ms), RingFrameDeleter {device});
+}
+
+/* View of the samples of chirp c of antenna rx in cube of frame. */
+inline Span<ifx_Float_t> chirp_view(const ifx_Fmcw_Frame_t* frame, uint32_t cube, uint32_t rx, uint32_t c) noexcept
+{
+    return fiber_view(frame->cubes[cube], rx, c);
+}
+
+}  // namespace fmcw
+}  // namespace rdk
+
+#endif /* IFX_FMCW_DEVICE_FMCW_OWNED_HPP */
@@ -0,0 +1,117 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwPublisher.hpp
+ *
+ * @brief Sending of the raw frames of an FMCW device over the network.
+ */
+
+#pragma once
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxFmcw/DeviceFmcw.hpp"
+#include "ifxFmcw/DeviceFmcwNetwork.h"
+#include "ifxFmcw/network/FrameDatagram.hpp"
+#include "ifxFmcw/network/NetworkStatistics.hpp"
+
+#include <platform/ethernet/SocketUdp.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+struct DeviceFmcwPublisher
+{
+    NONCOPYABLE(DeviceFmcwPublisher);
+
+    DeviceFmcwPublisher(DeviceFmcw* device, const ifx_Fmcw_Publisher_Config_t& config);
+    ~DeviceFmcwPublisher();
+
+    bool send(const ifx_Fmcw_Raw_Frame_t* frame);
+    void get_statistics(ifx_Fmcw_Network_Statistics_t* statistics) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // copy of a frame waiting for the worker, with the configuration it was acquired with
+    struct Item
+    {
+        std::vector<uint16_t> samples;
+        uint64_t timestamp_device_us;
+        uint64_t timestamp_received_us;
+        uint32_t config_hash;
+        uint32_t chirp_stride;
+        uint16_t num_lanes;
+        Clock::time_point queued;
+    };
+
+    void update_configuration(uint32_t num_samples);
+    void worker_thread();
+    void send_configuration(uint32_t config_hash);
+    void send_frame(const Item& item);
+    void send_message(FrameDatagram::Header& header, const uint8_t* payload, size_t size);
+
+    DeviceFmcw* m_device;
+    ifx_Fmcw_Network_Format_t m_format;
+    remoteInfo_t m_remote;
+    uint16_t m_max_datagram_size;
+    SocketUdp m_socket;
+
+    // configuration of the device, updated by send() when it changes
+    uint32_t m_config_hash = 0;  // written under m_lock
+    uint32_t m_chirp_stride = 0;
+    uint16_t m_num_lanes = 1;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_wakeup;
+    std::vector<std::unique_ptr<Item>> m_items;
+    std::vector<Item*> m_free;  // guarded by m_lock
+    std::deque<Item*> m_queue;  // guarded by m_lock
+    FrameDatagram::Configuration m_configuration;  // guarded by m_lock
+    bool m_configured = false;                     // guarded by m_lock
+    bool m_configuration_changed = false;          // guarded by m_lock
+    bool m_stop = false;                           // guarded by m_lock
+
+    // used by the worker only
+    uint32_t m_frame_index = 0;
+    uint32_t m_configuration_index = 0;
+    Clock::time_point m_configuration_sent;
+    std::vector<uint8_t> m_payload;
+    std::vector<uint8_t> m_datagram;
+
+    NetworkStatistics m_statistics;
+    std::thread m_worker;
+};
@@ -0,0 +1,255 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwRateControl.cpp
+ *
+ * @brief Implements the adaptive frame rate.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwRateControl.h"
+#include "DeviceFmcwRateControl.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/FunctionWrapper.hpp"
+#include "ifxBase/Log.h"
+
+#include <algorithm>
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwRateController::DeviceFmcwRateController(DeviceFmcw* device, const ifx_Fmcw_Rate_Control_Config_t* config) :
+    m_device(device)
+{
+    if (!device || !config)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    m_config = *config;
+    if (!(m_config.activity_threshold >= 0) || !(m_config.idle_hold_time_s >= 0))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    m_active_sequence.reset(device->get_acquisition_sequence());
+    m_idle_sequence.reset(device->get_acquisition_sequence());
+    if (!m_active_sequence || !m_idle_sequence || (m_active_sequence->type != IFX_SEQ_LOOP))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    m_frame_repetition_time_s = m_active_sequence->loop.repetition_time_s;
+    if (!(m_config.idle_frame_repetition_time_s > m_frame_repetition_time_s))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    /*
+     * The idle sequence only differs in the repetition time of the frame
+     * loop. When it is applied the Avian device chooses the power mode after
+     * the frame by the length of the frame end delay, so a long enough idle
+     * time uses deep sleep. The check also caches the translated sequence, so
+     * switching does not translate it again.
+     */
+    m_idle_sequence->loop.repetition_time_s = m_config.idle_frame_repetition_time_s;
+
+    const ifx_Fmcw_Sequence_Element_t* sequences[] = {m_idle_sequence.get(), m_active_sequence.get()};
+    ifx_Error_t errors[2];
+    device->check_acquisition_sequences(sequences, 2, errors, nullptr);
+    for (const auto error : errors)
+    {
+        if (error != IFX_OK)
+        {
+            throw rdk::exception::exception(error);
+        }
+    }
+}
+
+float DeviceFmcwRateController::mti_energy(uint32_t cube_index, const ifx_Mda_R_t* cube)
+{
+    if (!cube || (cube->dimensions != 3))
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    const uint32_t num_antennas = cube->shape[0];
+    const uint32_t num_chirps = cube->shape[1];
+    const uint32_t num_samples = cube->shape[2];
+    const auto* stride = cube->stride;
+
+    double sum = 0;
+    size_t count = 0;
+    if (num_chirps > 1)
+    {
+        for (uint32_t antenna = 0; antenna < num_antennas; antenna++)
+        {
+            const auto* chirp = cube->data + antenna * stride[0];
+            for (uint32_t c = 1; c < num_chirps; c++, chirp += stride[1])
+            {
+                for (uint32_t s = 0; s < num_samples; s++)
+                {
+                    const auto diff = chirp[stride[1] + s * stride[2]] - chirp[s * stride[2]];
+                    sum += diff * diff;
+                }
+            }
+        }
+        count = size_t(num_antennas) * (num_chirps - 1) * num_samples;
+    }
+    else
+    {
+        // a single chirp is compared with the chirp of the previous frame
+        if (m_previous_chirps.size() <= cube_index)
+        {
+            m_previous_chirps.resize(cube_index + 1);
+        }
+        auto& previous = m_previous_chirps[cube_index];
+        const bool valid = (previous.size() == size_t(num_antennas) * num_samples);
+        previous.resize(size_t(num_antennas) * num_samples);
+
+        auto* last = previous.data();
+        for (uint32_t antenna = 0; antenna < num_antennas; antenna++)
+        {
+            const auto* chirp = cube->data + antenna * stride[0];
+            for (uint32_t s = 0; s < num_samples; s++, last++)
+            {
+                const auto value = chirp[s * stride[2]];
+                const auto diff = value - *last;
+                sum += diff * diff;
+                *last = value;
+            }
+        }
+        count = valid ? previous.size() : 0;
+    }
+
+    return count ? static_cast<float>(sum / count) : 0.f;
+}
+
+float DeviceFmcwRateController::update(const ifx_Fmcw_Frame_t* frame)
+{
+    if (!frame)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    float activity = 0;
+    for (uint32_t cube = 0; cube < frame->num_cubes; cube++)
+    {
+        activity = std::max(activity, mti_energy(cube, frame->cubes[cube]));
+    }
+
+    update_activity(activity);
+    return activity;
+}
+
+void DeviceFmcwRateController::update_activity(float activity)
+{
+    if (activity >= m_config.activity_threshold)
+    {
+        m_idle_time_s = 0;
+        if (m_idle)
+        {
+            // Applying the sequence stops the acquisition, the next frame is started immediately.
+            IFX_LOG_DEBUG("DeviceFmcwRateController - activity %g, switching to full frame rate", activity);
+            m_device->set_acquisition_sequence(m_active_sequence.get());
+            m_idle = false;
+        }
+        return;
+    }
+
+    if (!m_idle)
+    {
+        m_idle_time_s += m_frame_repetition_time_s;
+        if (m_idle_time_s >= m_config.idle_hold_time_s)
+        {
+            IFX_LOG_DEBUG("DeviceFmcwRateController - idle for %g s, switching to idle frame rate", m_idle_time_s);
+            m_device->set_acquisition_sequence(m_idle_sequence.get());
+            m_idle = true;
+        }
+    }
+}
+
+bool DeviceFmcwRateController::is_idle() const
+{
+    return m_idle;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Fmcw_Rate_Controller_t* ifx_fmcw_create_rate_controller(ifx_Device_Fmcw_t* handle,
+                                                            const ifx_Fmcw_Rate_Control_Config_t* config)
+{
+    auto caller = [](ifx_Device_Fmcw_t* handle, const ifx_Fmcw_Rate_Control_Config_t* config) {
+        return new DeviceFmcwRateController(handle, config);
+    };
+    return rdk::call_func(caller, nullptr, handle, config);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_destroy_rate_controller(ifx_Fmcw_Rate_Controller_t* controller)
+{
+    delete controller;
+}
+
+//----------------------------------------------------------------------------
+
+float ifx_fmcw_rate_controller_update(ifx_Fmcw_Rate_Controller_t* controller, const ifx_Fmcw_Frame_t* frame)
+{
+    return rdk::call_func(controller, &ifx_Fmcw_Rate_Controller_t::update, frame);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_rate_controller_update_activity(ifx_Fmcw_Rate_Controller_t* controller, float activity)
+{
+    rdk::call_func(controller, &ifx_Fmcw_Rate_Controller_t::update_activity, activity);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_fmcw_rate_controller_is_idle(const ifx_Fmcw_Rate_Controller_t* controller)
+{
+    return rdk::call_func(controller, &ifx_Fmcw_Rate_Controller_t::is_idle);
+}
@@ -0,0 +1,211 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwRateControl.h
+ *
+ * For details refer to @ref gr_devicefmcwratecontrol
+ */
+
+#ifndef IFX_DEVICE_FMCW_RATE_CONTROL_H
+#define IFX_DEVICE_FMCW_RATE_CONTROL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+
+#include "DeviceFmcw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct DeviceFmcwRateController ifx_Fmcw_Rate_Controller_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Rate_Control_Config_t
+/**
+ * @brief Parameters of the adaptive frame rate.
+ */
+typedef struct
+{
+    float idle_frame_repetition_time_s; /**< Frame repetition time while the scene is idle, must be larger
+                                             than the frame repetition time of the acquisition sequence. */
+    float activity_threshold;           /**< Activity at or above which the scene is active. */
+    float idle_hold_time_s;             /**< Time the activity must stay below the threshold before the
+                                             frame rate is lowered. */
+} ifx_Fmcw_Rate_Control_Config_t;
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @addtogroup gr_cat_Fmcw
+ * @{
+ */
+
+/**
+ * @defgroup gr_devicefmcwratecontrol FMCW Adaptive Frame Rate
+ *
+ * @brief API lowering the frame rate while the scene is idle
+ *
+ * A rate controller switches the radar device between two acquisition
+ * sequences: the sequence set when the controller is created (full rate) and
+ * a copy of it whose frame loop repeats with the idle frame repetition time.
+ * The longer frame end delay of the idle sequence lets the sensor enter deep
+ * sleep between frames, and fewer frames are read and processed by the host.
+ *
+ * After each frame the application passes the frame or an activity value of
+ * its own processing (e.g. a presence score) to the controller. The activity
+ * of a frame is its MTI energy, the mean squared difference between
+ * consecutive chirps of every antenna; static targets cancel out. If the
+ * activity stays below the threshold for the idle hold time, the idle sequence
+ * is applied. The first frame at or above the threshold applies the full rate
+ * sequence again. Switching restarts the acquisition, so the next frame is
+ * acquired at full rate right away instead of after the idle frame end delay.
+ * Only the registers that differ between the sequences are written.
+ *
+ * The controller must be used from the thread reading the frames and must be
+ * destroyed before the device. The device keeps the sequence applied last.
+ *
+ * Here is an example:
+ * @code
+ *      ifx_Fmcw_Rate_Control_Config_t config = {1.0f, 1e-4f, 5.0f};
+ *      ifx_Fmcw_Rate_Controller_t* controller = ifx_fmcw_create_rate_controller(device_handle, &config);
+ *      ifx_Fmcw_Frame_t* frame = ifx_fmcw_allocate_frame(device_handle);
+ *      while (running)
+ *      {
+ *          ifx_fmcw_get_next_frame_timeout(device_handle, frame, 2000);
+ *          ifx_fmcw_rate_controller_update(controller, frame);
+ *          // process frame ...
+ *      }
+ *      ifx_fmcw_destroy_frame(frame);
+ *      ifx_fmcw_destroy_rate_controller(controller);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a rate controller for a device.
+ *
+ * The current acquisition sequence of the device is used at full rate. Its
+ * first element must be the frame loop.
+ *
+ * @param[in] handle  A handle to the radar device.
+ * @param[in] config  Parameters of the adaptive frame rate.
+ *
+ * @return Handle to the newly created controller or NULL in case of failure,
+ *         e.g. if the idle sequence is not feasible for the device.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Rate_Controller_t* ifx_fmcw_create_rate_controller(ifx_Device_Fmcw_t* handle,
+                                                            const ifx_Fmcw_Rate_Control_Config_t* config);
+
+/**
+ * @brief Destroys the rate controller.
+ *
+ * @param[in] controller  A handle to the rate controller.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_destroy_rate_controller(ifx_Fmcw_Rate_Controller_t* controller);
+
+/**
+ * @brief Updates the frame rate with the MTI energy of a frame.
+ *
+ * The activity of the frame is the largest MTI energy of its cubes. For cubes
+ * of a single chirp the chirp of the previous frame is used as reference.
+ *
+ * @param[in] controller  A handle to the rate controller.
+ * @param[in] frame       The frame read last from the device.
+ *
+ * @return The activity of the frame.
+ */
+IFX_DLL_PUBLIC
+float ifx_fmcw_rate_controller_update(ifx_Fmcw_Rate_Controller_t* controller, const ifx_Fmcw_Frame_t* frame);
+
+/**
+ * @brief Updates the frame rate with an activity value of the application.
+ *
+ * Use this function instead of @ref ifx_fmcw_rate_controller_update if the
+ * application already computes an activity, e.g. the result of presence
+ * detection. It must be called once per frame.
+ *
+ * @param[in] controller  A handle to the rate controller.
+ * @param[in] activity    Activity of the frame read last, compared with the
+ *                        activity threshold.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_rate_controller_update_activity(ifx_Fmcw_Rate_Controller_t* controller, float activity);
+
+/**
+ * @brief Tells if the idle sequence is applied.
+ *
+ * @param[in] controller  A handle to the rate controller.
+ *
+ * @return true while the device runs at the idle frame rate.
+ */
+IFX_DLL_PUBLIC
+bool ifx_fmcw_rate_controller_is_idle(const ifx_Fmcw_Rate_Controller_t* controller);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_DEVICE_FMCW_RATE_CONTROL_H */
@@ -0,0 +1,80 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwRateControl.hpp
+ *
+ * @brief Switches a device between full and idle frame rate.
+ */
+
+#pragma once
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxFmcw/DeviceFmcw.hpp"
+#include "ifxFmcw/DeviceFmcwRateControl.h"
+
+#include <memory>
+#include <vector>
+
+
+struct DeviceFmcwRateController
+{
+    NONCOPYABLE(DeviceFmcwRateController);
+
+    DeviceFmcwRateController(DeviceFmcw* device, const ifx_Fmcw_Rate_Control_Config_t* config);
+    ~DeviceFmcwRateController() = default;
+
+    float update(const ifx_Fmcw_Frame_t* frame);
+    void update_activity(float activity);
+    bool is_idle() const;
+
+private:
+    struct SequenceDeleter
+    {
+        void operator()(ifx_Fmcw_Sequence_Element_t* sequence)
+        {
+            ifx_fmcw_destroy_sequence(sequence);
+        }
+    };
+    using Sequence = std::unique_ptr<ifx_Fmcw_Sequence_Element_t, SequenceDeleter>;
+
+    float mti_energy(uint32_t cube_index, const ifx_Mda_R_t* cube);
+
+    DeviceFmcw* m_device;
+    ifx_Fmcw_Rate_Control_Config_t m_config;
+    Sequence m_active_sequence;
+    Sequence m_idle_sequence;
+    float m_frame_repetition_time_s;  // of the full rate sequence
+    float m_idle_time_s = 0;          // time the activity has been below the threshold
+    bool m_idle = false;
+
+    // last chirp of every cube of the previous frame, for cubes of a single chirp
+    std::vector<std::vector<ifx_Float_t>> m_previous_chirps;
+};
@@ -0,0 +1,197 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwServer.cpp
+ *
+ * @brief Implements the server publishing the frames of an FMCW device.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwServer.h"
+#include "DeviceFmcwServer.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/FunctionWrapper.hpp"
+#include "ifxBase/Log.h"
+
+#include <common/Threads.hpp>
+#include <exception>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// Timeout for reading a frame, it only limits how long stopping the server takes.
+constexpr uint16_t read_timeout_ms = 100;
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwServer::DeviceFmcwServer(DeviceFmcw* device, uint32_t num_slots) :
+    m_device(device)
+{
+    if (!device)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    SmartFmcwRawFrame frame(device->allocate_raw_frame());
+    if (!frame)
+    {
+        throw rdk::exception::memory_allocation_failed();
+    }
+    m_num_samples = frame->num_samples;
+
+    m_ring = SharedFrameRing::create(device->get_board_uuid(), device->get_sensor_type(), m_num_samples,
+                                     device->get_register_list(), num_slots);
+
+    device->start_acquisition();
+    m_thread = std::thread(&DeviceFmcwServer::acquisition_thread, this);
+}
+
+DeviceFmcwServer::~DeviceFmcwServer()
+{
+    m_stop = true;
+    m_thread.join();
+
+    try
+    {
+        m_device->stop_acquisition();
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_DEBUG("DeviceFmcwServer - stopping the acquisition failed, \"%s\"", e.what());
+    }
+}
+
+void DeviceFmcwServer::acquisition_thread()
+{
+    StrataThreads::apply(StrataThreads::Acquisition, "server");
+
+    while (!m_stop)
+    {
+        // The device writes the frame directly into the ring. A frame
+        // interrupted by the timeout is continued in the same slot.
+        ifx_Fmcw_Raw_Frame_t frame = {m_num_samples, m_ring->acquire_slot(), 0, 0, 0};
+
+        try
+        {
+            if (!m_device->try_get_next_raw_frame(&frame, read_timeout_ms))
+            {
+                continue;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            (void)e;
+            IFX_LOG_ERROR("DeviceFmcwServer - reading a frame failed, \"%s\"", e.what());
+            break;
+        }
+
+        m_ring->publish(frame.timestamp_device_us, frame.timestamp_received_us);
+        m_num_frames.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    m_ring->close();
+    m_running = false;
+}
+
+uint64_t DeviceFmcwServer::get_num_frames() const
+{
+    return m_num_frames.load(std::memory_order_relaxed);
+}
+
+uint32_t DeviceFmcwServer::get_num_consumers() const
+{
+    return m_ring->get_num_consumers();
+}
+
+bool DeviceFmcwServer::is_running() const
+{
+    return m_running;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Fmcw_Server_t* ifx_fmcw_server_create(ifx_Device_Fmcw_t* device, uint32_t num_slots)
+{
+    auto caller = [](ifx_Device_Fmcw_t* device, uint32_t num_slots) {
+        return new DeviceFmcwServer(device, num_slots);
+    };
+    return rdk::call_func(caller, nullptr, device, num_slots);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_fmcw_server_destroy(ifx_Fmcw_Server_t* server)
+{
+    delete server;
+}
+
+//----------------------------------------------------------------------------
+
+uint64_t ifx_fmcw_server_get_num_frames(ifx_Fmcw_Server_t* server)
+{
+    return rdk::call_func(server, &ifx_Fmcw_Server_t::get_num_frames);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_fmcw_server_get_num_consumers(ifx_Fmcw_Server_t* server)
+{
+    return rdk::call_func(server, &ifx_Fmcw_Server_t::get_num_consumers);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_fmcw_server_is_running(ifx_Fmcw_Server_t* server)
+{
+    return rdk::call_func(server, &ifx_Fmcw_Server_t::is_running);
+}
@@ -0,0 +1,194 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file DeviceFmcwServer.h
+ *
+ * For details refer to @ref gr_devicefmcwserver
+ */
+
+#ifndef IFX_DEVICE_FMCW_SERVER_H
+#define IFX_DEVICE_FMCW_SERVER_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+
+#include "DeviceFmcw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+typedef struct DeviceFmcwServer ifx_Fmcw_Server_t;
+
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @addtogroup gr_cat_Fmcw
+ * @{
+ */
+
+/**
+ * @defgroup gr_devicefmcwserver FMCW Device Server
+ *
+ * @brief API for sharing one FMCW radar device between several processes
+ *
+ * A board can only be opened by one process. A server takes over an opened
+ * device, runs its acquisition and publishes every frame into a POSIX shared
+ * memory ring named after the board uuid. While the server is running,
+ * @ref ifx_fmcw_create_by_uuid in any other process of the same user attaches
+ * to the ring instead of opening the board, so a recorder, a visualizer and
+ * a detector can use the same sensor. Each frame is transferred over USB once
+ * and written into the ring once, directly by the device.
+ *
+ * The devices returned to the consumers are configured like the device of
+ * the server. They behave like a device with fixed configuration: setting a
+ * different sequence fails with IFX_ERROR_NOT_POSSIBLE. Each consumer reads
+ * the frames at its own pace; one that falls behind by more than the ring
+ * size misses the oldest frames, the server never waits for a consumer. Once
+ * the server is destroyed or terminates, reading frames fails with
+ * IFX_ERROR_NO_DEVICE.
+ *
+ * Shared frame rings are not supported on Windows.
+ *
+ * Here is an example of a server:
+ * @code
+ *      ifx_Device_Fmcw_t* device = ifx_fmcw_create_by_uuid(uuid);
+ *      // configure the device ...
+ *      ifx_Fmcw_Server_t* server = ifx_fmcw_server_create(device, 16);
+ *      while (running)
+ *          sleep(1);
+ *      ifx_fmcw_server_destroy(server);
+ *      ifx_fmcw_destroy(device);
+ * @endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a server publishing the frames of a device.
+ *
+ * The acquisition of the device is started and runs until the server is
+ * destroyed. The device stays owned by the caller, it must not be used until
+ * the server is destroyed and must be destroyed after it.
+ *
+ * @param[in] device     A handle to the radar device.
+ * @param[in] num_slots  Number of frames in the ring, at least 2. The ring
+ *                       holds the last num_slots - 1 frames.
+ *
+ * @return Handle to the newly created server or NULL in case of failure.
+ *         Fails with IFX_ERROR_DEVICE_BUSY if another server is running for
+ *         the board.
+ */
+IFX_DLL_PUBLIC
+ifx_Fmcw_Server_t* ifx_fmcw_server_create(ifx_Device_Fmcw_t* device, uint32_t num_slots);
+
+/**
+ * @brief Destroys the server.
+ *
+ * The acquisition of the device is stopped and the ring is removed.
+ * Consumers read the frames still in their ring and then get
+ * IFX_ERROR_NO_DEVICE.
+ *
+ * @param[in] server  A handle to the server.
+ */
+IFX_DLL_PUBLIC
+void ifx_fmcw_server_destroy(ifx_Fmcw_Server_t* server);
+
+/**
+ * @brief Returns the number of frames published so far.
+ *
+ * @param[in] server  A handle to the server.
+ *
+ * @return Number of published frames.
+ */
+IFX_DLL_PUBLIC
+uint64_t ifx_fmcw_server_get_num_frames(ifx_Fmcw_Server_t* server);
+
+/**
+ * @brief Returns the number of processes attached to the server.
+ *
+ * @param[in] server  A handle to the server.
+ *
+ * @return Number of consumers.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_fmcw_server_get_num_consumers(ifx_Fmcw_Server_t* server);
+
+/**
+ * @brief Returns whether the server is still acquiring frames.
+ *
+ * The server stops if reading frames from the device fails with another
+ * error than a timeout, for example because the board was disconnected.
+ *
+ * @param[in] server  A handle to the server.
+ *
+ * @return true while frames are acquired.
+ */
+IFX_DLL_PUBLIC
+bool ifx_fmcw_server_is_running(ifx_Fmcw_Server_t* server);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_DEVICE_FMCW_SERVER_H */
@@ -0,0 +1,70 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwServer.hpp
+ *
+ * @brief Publishing of the frames of an FMCW device to other processes.
+ */
+
+#pragma once
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxFmcw/DeviceFmcw.hpp"
+#include "ifxFmcw/shared/SharedFrameRing.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+
+struct DeviceFmcwServer
+{
+    NONCOPYABLE(DeviceFmcwServer);
+
+    DeviceFmcwServer(DeviceFmcw* device, uint32_t num_slots);
+    ~DeviceFmcwServer();
+
+    uint64_t get_num_frames() const;
+    uint32_t get_num_consumers() const;
+    bool is_running() const;
+
+private:
+    void acquisition_thread();
+
+    DeviceFmcw* m_device;
+    uint32_t m_num_samples;
+    std::unique_ptr<SharedFrameRing> m_ring;
+
+    std::atomic<bool> m_stop {false};
+    std::atomic<bool> m_running {true};
+    std::atomic<uint64_t> m_num_frames {0};
+    std::thread m_thread;
+};
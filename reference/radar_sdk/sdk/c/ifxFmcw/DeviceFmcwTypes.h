@@ -80,6 +80,14 @@ typedef struct ifx_Fmcw_Raw_Frame_s
 {
     uint32_t num_samples;
     uint16_t* samples;
+
+    /* Timestamps of the frame, all in microseconds since the Unix epoch. They
+     * are filled by the functions returning frames and allow to measure the
+     * latency from the end of the acquisition to the application. */
+    uint64_t timestamp_device_us;    /**< Device time of the data slice completing the frame,
+                                          0 if the firmware does not provide timestamps */
+    uint64_t timestamp_received_us;  /**< Host time when that slice was taken from the receive queue */
+    uint64_t timestamp_delivered_us; /**< Host time when the frame was handed to the application */
 } ifx_Fmcw_Raw_Frame_t;
 
 // ---------------------------------------------------------------------------- ifx_Fmcw_Frame_t
@@ -105,8 +113,163 @@ typedef struct ifx_Fmcw_Frame_s
 {
     uint32_t num_cubes;
     ifx_Mda_R_t** cubes;
+
+    /* Timestamps of the frame, all in microseconds since the Unix epoch. They
+     * are filled by the functions returning frames and allow to measure the
+     * latency from the end of the acquisition to the application. */
+    uint64_t timestamp_device_us;    /**< Device time of the data slice completing the frame,
+                                          0 if the firmware does not provide timestamps */
+    uint64_t timestamp_received_us;  /**< Host time when that slice was taken from the receive queue */
+    uint64_t timestamp_delivered_us; /**< Host time when the frame was handed to the application */
 } ifx_Fmcw_Frame_t;
 
+// ---------------------------------------------------------------------------- ifx_Fmcw_Frame_Callback_t
+/**
+ * @brief Receives frames pushed by a device, see @ref ifx_fmcw_set_frame_callback.
+ *
+ * @param[in] frame      The completed frame from the ring, or NULL if a frame was lost.
+ * @param[in] error      IFX_OK or the reason why the frame was lost.
+ * @param[in] user_data  The pointer passed to @ref ifx_fmcw_set_frame_callback.
+ */
+typedef void (*ifx_Fmcw_Frame_Callback_t)(ifx_Fmcw_Frame_t* frame, ifx_Error_t error, void* user_data);
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Async_Callback_t
+/**
+ * @brief Completes a request of @ref ifx_fmcw_get_next_frame_async.
+ *
+ * @param[in] frame      The frame of the request, filled if error is IFX_OK.
+ * @param[in] error      IFX_OK, the reason why no frame was received, or
+ *                       IFX_ERROR_ABORTED if the request was cancelled.
+ * @param[in] user_data  The pointer passed with the request.
+ */
+typedef void (*ifx_Fmcw_Async_Callback_t)(ifx_Fmcw_Frame_t* frame, ifx_Error_t error, void* user_data);
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Statistics_t
+/**
+ * @brief Counters of the data received from a board, see @ref ifx_fmcw_get_statistics.
+ *
+ * The counters accumulate from the creation of the device or the last call of
+ * @ref ifx_fmcw_reset_statistics. A frame lost for one of the counted causes
+ * is reported as an error by the function retrieving the frame.
+ */
+typedef struct
+{
+    uint64_t num_slices;       /**< Number of data slices received. */
+    uint64_t num_bytes;        /**< Number of data bytes received in these slices. */
+    uint64_t num_frames;       /**< Number of complete frames delivered to the application. */
+    uint64_t frames_dropped;   /**< Frames lost due to packet loss on the link to the board. */
+    uint64_t pool_depleted;    /**< Frames lost because no buffer of the frame pool was available. */
+    uint64_t queue_trimmed;    /**< Frames lost because the frame queue was full. */
+    uint64_t fifo_overflows;   /**< Overflows of the sensor FIFO. */
+    uint64_t overflow_recoveries; /**< Overflows recovered in place, see @ref ifx_fmcw_set_overflow_recovery. */
+    uint64_t other_errors;     /**< Frames lost for any other reason, e.g. all frames of the ring held by the application or no asynchronous request pending. */
+    uint32_t queue_high_water; /**< Maximum number of slices waiting in the frame queue at the same time. */
+    float latency_last_s;      /**< Time from receiving the first slice of the last frame until its delivery in seconds. */
+    float latency_mean_s;      /**< Mean of this time over all delivered frames in seconds. */
+    float latency_max_s;       /**< Maximum of this time over all delivered frames in seconds. */
+} ifx_Fmcw_Statistics_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Open_Timing_t
+/**
+ * @brief Time spent in the steps of opening a device, see @ref ifx_fmcw_get_open_timing.
+ *
+ * All times are in seconds and start after the connection to the board was
+ * established. Steps a device does not have are zero.
+ */
+typedef struct
+{
+    float firmware_s;            /**< Reading and checking the firmware version. */
+    float driver_s;              /**< Resetting and identifying the sensor. */
+    float reference_clock_s;     /**< Detecting the reference clock or taking it from the cache. */
+    float sensor_info_s;         /**< Collecting the sensor information. */
+    float register_list_s;       /**< Generating the register list of the default configuration. */
+    float total_s;               /**< All steps together. */
+    bool reference_clock_cached; /**< True if the reference clock was taken from the cache, see @ref ifx_fmcw_set_reference_clock_cache. */
+} ifx_Fmcw_Open_Timing_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Thread_Role_t
+/**
+ * @brief Groups of internal threads sharing scheduling settings, see @ref ifx_fmcw_set_thread_config.
+ */
+typedef enum
+{
+    IFX_FMCW_THREAD_DATA = 0,        /**< Threads reading from the board (USB, serial, Ethernet). */
+    IFX_FMCW_THREAD_FORWARDING = 1,  /**< Threads passing the received data on to the devices. */
+    IFX_FMCW_THREAD_ACQUISITION = 2, /**< Threads reading frames on behalf of the application,
+                                          e.g. of device servers and device groups. */
+    IFX_FMCW_THREAD_PROCESSING = 3   /**< Worker threads of executors, processing and publishers. */
+} ifx_Fmcw_Thread_Role_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Thread_Config_t
+/**
+ * @brief Scheduling settings of a group of internal threads, see @ref ifx_fmcw_set_thread_config.
+ */
+typedef struct
+{
+    uint64_t affinity_mask; /**< Bit mask of the CPUs the threads may run on, 0 for all CPUs. */
+    int32_t priority;       /**< With realtime set the real-time priority (Linux: 1 to 99),
+                                 otherwise a nice value, negative values are higher priorities. 0 keeps the default. */
+    bool realtime;          /**< Use a real-time scheduling class (SCHED_FIFO on Linux,
+                                 THREAD_PRIORITY_TIME_CRITICAL on Windows). */
+} ifx_Fmcw_Thread_Config_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Playback_Mode_t
+/**
+ * @brief Pacing of a playback device, see @ref ifx_fmcw_create_playback.
+ */
+typedef enum
+{
+    IFX_FMCW_PLAYBACK_REAL_TIME = 0, /**< Frames are delivered at the rate they were recorded. */
+    IFX_FMCW_PLAYBACK_MAX_SPEED = 1  /**< Frames are delivered as fast as they are fetched. */
+} ifx_Fmcw_Playback_Mode_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Synthetic_Target_t
+/**
+ * @brief A point target of a synthetic scene, see @ref ifx_fmcw_create_synthetic.
+ */
+typedef struct
+{
+    float range_m;       /**< Distance to the sensor at the start of the acquisition in meters. */
+    float velocity_m_s;  /**< Radial velocity in m/s, positive when moving away. The range
+                              changes accordingly from chirp to chirp and frame to frame. */
+    float angle_deg;     /**< Angle of arrival in degrees, 0 is boresight. RX antennas are
+                              assumed to be in a line spaced half a wavelength apart. */
+    float amplitude;     /**< Amplitude of the IF signal relative to the ADC full scale. */
+} ifx_Fmcw_Synthetic_Target_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Synthetic_Scene_t
+/**
+ * @brief The scene seen by a synthetic device, see @ref ifx_fmcw_create_synthetic.
+ */
+typedef struct
+{
+    const ifx_Fmcw_Synthetic_Target_t* targets; /**< Point targets, copied by the device. */
+    uint32_t num_targets;                       /**< Number of targets. */
+    float noise_amplitude;                      /**< Standard deviation of white noise relative to the ADC full scale. */
+    float coupling_amplitude;                   /**< Amplitude of the TX to RX leakage, a static reflection at
+                                                     a few centimeters seen equally by all RX antennas. */
+    uint32_t seed;                              /**< Seed of the noise generator. */
+} ifx_Fmcw_Synthetic_Scene_t;
+
+// ---------------------------------------------------------------------------- ifx_Fmcw_Acquisition_Policy_t
+/**
+ * @brief How time domain data is split into slices, see @ref ifx_fmcw_set_acquisition_policy.
+ *
+ * The sensor sends its data in slices. A frame is only complete when the
+ * slice holding its last sample has arrived, so the slice size trades the
+ * number of transfers against the latency of a frame.
+ */
+typedef enum
+{
+    IFX_FMCW_ACQUISITION_MAX_THROUGHPUT = 0, /**< Several frames per slice to keep the slice rate at about 20 Hz
+                                                  (default). A frame may wait for the frames after it. */
+    IFX_FMCW_ACQUISITION_MIN_LATENCY = 1,    /**< The largest slices that end at frame boundaries, a frame is
+                                                  sent as soon as it is complete. */
+    IFX_FMCW_ACQUISITION_FRAME_ALIGNED = 2,  /**< Exactly one frame per slice, frames are never split. Fails if a
+                                                  frame does not fit into half the FIFO. */
+    IFX_FMCW_ACQUISITION_SLICE_SIZE = 3      /**< Slice size set explicitly in samples. */
+} ifx_Fmcw_Acquisition_Policy_t;
+
 // ---------------------------------------------------------------------------- ifx_Fmcw_Element_Type
 /**
  * @brief Lists all building blocks a frame sequence can be built from.
@@ -349,6 +512,19 @@ typedef struct ifx_Fmcw_Simple_Sequence_Config
 
 } ifx_Fmcw_Simple_Sequence_Config_t;
 
+// ---------------------------------------------------------------------------- ifx_Fmcw_Eeprom_Config_t
+/**
+ * @brief Describes an I2C EEPROM connected to the board, e.g. on the RF
+ *        shield, see \ref ifx_fmcw_read_eeprom.
+ */
+typedef struct ifx_Fmcw_Eeprom_Config
+{
+    uint16_t i2c_address;  /**< I2C device address of the EEPROM, including the bus ID in the upper bits.*/
+    uint8_t address_bytes; /**< Number of address bytes of a memory access (1 or 2), see the datasheet.*/
+    uint32_t total_size;   /**< Size of the EEPROM in bytes.*/
+    uint32_t page_size;    /**< Page size of the EEPROM in bytes.*/
+} ifx_Fmcw_Eeprom_Config_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -40,6 +40,7 @@
 // libAvian
 #include "ifxAvian_DeviceTraits.hpp"
 #include "ifxAvian_ParameterExtractor.hpp"
+#include "ifxAvian_SensorMeter.hpp"
 #include "ifxAvian_StrataUtilities.hpp"
 #include "ifxAvian_TimingModel.hpp"
 #include "ifxAvian_Types.hpp"
@@ -54,8 +55,16 @@
 #include <platform/NamedMemory.hpp>
 #include <universal/error_definitions.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>  // for std::round
+#include <cstdio>  // for std::rename
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <sstream>
 
 
 /*
@@ -79,8 +88,38 @@ constexpr float MAX_ADC_VALUE = 4095.0f;              // 2**12 - 1
 
 constexpr uint32_t MAX_NUM_SAMPLES_PER_CHIRP = 4095;  // 2**12 - 1
 
+// Interval in which the telemetry thread samples the temperature during an acquisition
+constexpr auto TELEMETRY_PERIOD = std::chrono::milliseconds(100);
+
 constexpr uint8_t data_format = DataFormat_Packed12;  // default data format
 
+// The MAIN register holds the trigger bit and has the same address for all Avian devices
+constexpr uint8_t REGISTER_MAIN = 0x00;
+
+// Channel set registers (CSP_I_0 to CS4) of devices without reordered register
+// layout. They are loaded by the sequencer for every chirp, so they can be
+// rewritten while an acquisition is running.
+constexpr uint8_t REGISTER_CHANNEL_SET_FIRST = 0x08;
+constexpr uint8_t REGISTER_CHANNEL_SET_LAST = 0x2b;
+
+// Maximum number of entries in the cache of compiled acquisition sequences
+constexpr size_t MAX_COMPILED_SEQUENCES = 1024;
+
+// Maximum number of entries in the cache of extracted register lists
+constexpr size_t MAX_EXTRACTED_REGISTER_LISTS = 64;
+
+// Maximum number of entries in the cache of timing model results
+constexpr size_t MAX_TIMINGS = 256;
+
+// Binary register profile, see save_register_profile. All fields are little endian:
+//   magic[8], version (u32), device type (u32), count (u32),
+//   count x (address (u16), reserved (u16), value (u32)), checksum (u32)
+// The checksum is the FNV-1a hash of all bytes before it.
+constexpr char REGISTER_PROFILE_MAGIC[8] = {'I', 'F', 'X', 'R', 'E', 'G', 'P', 0};
+constexpr uint32_t REGISTER_PROFILE_VERSION = 1;
+constexpr size_t REGISTER_PROFILE_HEADER_SIZE = sizeof(REGISTER_PROFILE_MAGIC) + 3 * sizeof(uint32_t);
+constexpr size_t REGISTER_PROFILE_ENTRY_SIZE = 2 * sizeof(uint16_t) + sizeof(uint32_t);
+
 }  // namespace
 
 /*
@@ -252,11 +291,246 @@ uint32_t tx_mode_to_tx_mask(const Avian::Tx_Mode tx_mode)
     }
 }
 
+template <typename T>
+void append_key_value(std::string& key, const T& value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/* Appends all parameters of a sequence to key, so that two sequences have the
+ * same key if and only if they are equal. Struct padding is not included.
+ */
+void append_sequence_key(std::string& key, const ifx_Fmcw_Sequence_Element_t* element)
+{
+    for (; element != nullptr; element = element->next_element)
+    {
+        append_key_value(key, element->type);
+        switch (element->type)
+        {
+            case IFX_SEQ_LOOP:
+                append_key_value(key, element->loop.num_repetitions);
+                append_key_value(key, element->loop.repetition_time_s);
+                key.push_back('(');
+                append_sequence_key(key, element->loop.sub_sequence);
+                key.push_back(')');
+                break;
+            case IFX_SEQ_CHIRP:
+                append_key_value(key, element->chirp.start_frequency_Hz);
+                append_key_value(key, element->chirp.end_frequency_Hz);
+                append_key_value(key, element->chirp.sample_rate_Hz);
+                append_key_value(key, element->chirp.num_samples);
+                append_key_value(key, element->chirp.rx_mask);
+                append_key_value(key, element->chirp.tx_mask);
+                append_key_value(key, element->chirp.tx_power_level);
+                append_key_value(key, element->chirp.lp_cutoff_Hz);
+                append_key_value(key, element->chirp.hp_cutoff_Hz);
+                append_key_value(key, element->chirp.if_gain_dB);
+                break;
+            case IFX_SEQ_DELAY:
+                append_key_value(key, element->delay.time_s);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+uint32_t fnv1a_32(const uint8_t* data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+uint64_t hash_register_set(const HW::RegisterSet& registers, double ref_frequency)
+{
+    uint64_t hash = std::hash<double>()(ref_frequency);
+    registers.for_each([&hash](uint8_t address, uint32_t value) {
+        const uint64_t word = (uint64_t(address) << 32) | value;
+        hash = (hash ^ word) * 1099511628211ull;
+    });
+    return hash;
+}
+
+double get_ref_frequency(const Avian::Driver& driver)
+{
+    // same as the timing model does when constructed from a driver
+    Avian::Reference_Clock_Frequency ref_frequency;
+    driver.get_reference_clock_frequency(&ref_frequency);
+    if ((ref_frequency == Avian::Reference_Clock_Frequency::_76_8MHz)
+        || (ref_frequency == Avian::Reference_Clock_Frequency::_38_4MHz))
+        return 76.8e6;
+    return 80.0e6;
+}
+
+uint64_t hash_register_list(const std::vector<std::pair<uint8_t, uint32_t>>& registers)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto& entry : registers)
+    {
+        const uint64_t word = (uint64_t(entry.first) << 32) | entry.second;
+        for (int shift = 0; shift < 40; shift += 8)
+            hash = (hash ^ ((word >> shift) & 0xff)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void put_u16(std::vector<uint8_t>& buffer, uint16_t value)
+{
+    buffer.push_back(uint8_t(value));
+    buffer.push_back(uint8_t(value >> 8));
+}
+
+void put_u32(std::vector<uint8_t>& buffer, uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+        buffer.push_back(uint8_t(value >> shift));
+}
+
+uint16_t get_u16(const uint8_t* data)
+{
+    return uint16_t(data[0] | (data[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* data)
+{
+    return uint32_t(data[0]) | (uint32_t(data[1]) << 8) | (uint32_t(data[2]) << 16) | (uint32_t(data[3]) << 24);
+}
+
+/* Reads a binary register profile. Returns false if the file is not a
+ * profile (e.g. a text register file), throws if it is a broken profile.
+ */
+bool read_register_profile(const char* filename, Avian::Device_Type device_type, std::vector<std::pair<uint16_t, uint32_t>>& registers)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+        throw rdk::exception::opening_file();
+
+    char magic[sizeof(REGISTER_PROFILE_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(std::begin(magic), std::end(magic), std::begin(REGISTER_PROFILE_MAGIC)))
+        return false;
+
+    std::vector<uint8_t> data(std::begin(magic), std::end(magic));
+    data.insert(data.end(), std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (data.size() < REGISTER_PROFILE_HEADER_SIZE + sizeof(uint32_t))
+        throw rdk::exception::file_invalid();
+
+    const uint8_t* header = data.data() + sizeof(REGISTER_PROFILE_MAGIC);
+    const uint32_t version = get_u32(header);
+    const uint32_t type = get_u32(header + 4);
+    const uint32_t count = get_u32(header + 8);
+    const size_t size = REGISTER_PROFILE_HEADER_SIZE + size_t(count) * REGISTER_PROFILE_ENTRY_SIZE;
+    if ((version != REGISTER_PROFILE_VERSION) || (data.size() != size + sizeof(uint32_t))
+        || (get_u32(data.data() + size) != fnv1a_32(data.data(), size)))
+    {
+        throw rdk::exception::file_invalid();
+    }
+
+    // unlike text files, profiles know the device they were made for
+    if (type != static_cast<uint32_t>(device_type))
+        throw rdk::exception::device_not_supported();
+
+    registers.clear();
+    registers.reserve(count);
+    for (const uint8_t* entry = header + 12; entry < data.data() + size; entry += REGISTER_PROFILE_ENTRY_SIZE)
+        registers.emplace_back(get_u16(entry), get_u32(entry + 4));
+
+    return true;
+}
+
+// Result of the reference clock detection for a board, see detect_reference_clock
+struct Reference_Clock_Entry
+{
+    uint32_t device_type;
+    std::array<uint16_t, 3> firmware;  // major, minor, build
+    Clock_Source clock_source;
+    Reference_Clock_Frequency frequency;
+};
+
+// Detected reference clocks by board UUID, optionally mirrored to a file, see
+// DeviceFmcwAvian::set_reference_clock_cache. The file has one line per board:
+//   uuid device_type major.minor.build clock_source frequency
+std::mutex reference_clock_cache_mutex;
+std::map<std::string, Reference_Clock_Entry> reference_clock_cache;
+std::string reference_clock_cache_file;
+
+// Merges the entries of the cache file, the caller holds reference_clock_cache_mutex
+void read_reference_clock_cache()
+{
+    std::ifstream file(reference_clock_cache_file);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string uuid;
+        Reference_Clock_Entry entry;
+        char dot1 = 0, dot2 = 0;
+        unsigned clock_source = 0, frequency = 0;
+        fields >> uuid >> entry.device_type >> entry.firmware[0] >> dot1 >> entry.firmware[1] >> dot2 >> entry.firmware[2]
+            >> clock_source >> frequency;
+
+        // damaged lines are skipped, the boards are measured again
+        if (!fields || (dot1 != '.') || (dot2 != '.') || (clock_source > 1)
+            || (frequency > static_cast<unsigned>(Reference_Clock_Frequency::_38_4MHz)))
+        {
+            continue;
+        }
+        entry.clock_source = static_cast<Clock_Source>(clock_source);
+        entry.frequency = static_cast<Reference_Clock_Frequency>(frequency);
+        reference_clock_cache[uuid] = entry;
+    }
+}
+
+// Rewrites the cache file, the caller holds reference_clock_cache_mutex
+void write_reference_clock_cache()
+{
+    if (reference_clock_cache_file.empty())
+        return;
+
+    // Other processes may read the file at any time, so it is replaced in one
+    // step by renaming a complete copy.
+    const auto temporary = reference_clock_cache_file + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        for (const auto& cached : reference_clock_cache)
+        {
+            const auto& entry = cached.second;
+            file << cached.first << ' ' << entry.device_type << ' '
+                 << entry.firmware[0] << '.' << entry.firmware[1] << '.' << entry.firmware[2] << ' '
+                 << static_cast<unsigned>(entry.clock_source) << ' ' << static_cast<unsigned>(entry.frequency) << '\n';
+        }
+        if (!file)
+        {
+            IFX_LOG_WARNING("Could not write reference clock cache %s", temporary.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), reference_clock_cache_file.c_str()) != 0)
+    {
+        // rename does not replace an existing file on Windows
+        std::remove(reference_clock_cache_file.c_str());
+        if (std::rename(temporary.c_str(), reference_clock_cache_file.c_str()) != 0)
+        {
+            IFX_LOG_WARNING("Could not write reference clock cache %s", reference_clock_cache_file.c_str());
+        }
+    }
+}
+
 }  // namespace
 
 DeviceFmcwAvian::DeviceFmcwAvian(std::unique_ptr<BoardInstance>&& board) :
     DeviceFmcwBase(MAX_ADC_VALUE, std::move(board))
 {
+    auto step_start = std::chrono::steady_clock::now();
+    auto step_seconds = [&step_start]() {
+        const auto now = std::chrono::steady_clock::now();
+        const float seconds = std::chrono::duration<float>(now - step_start).count();
+        step_start = now;
+        return seconds;
+    };
+
     // Checks internally that we are really connected to a board with an Avian sensor
     m_port = std::make_unique<StrataControlPort>(m_board.get());
 
@@ -265,8 +539,10 @@ DeviceFmcwAvian::DeviceFmcwAvian(std::unique_ptr<BoardInstance>&& board) :
     {
         throw rdk::exception::device_not_supported();
     }
+    m_open_timing.driver_s = step_seconds();
 
-    detect_reference_clock();
+    m_open_timing.reference_clock_cached = detect_reference_clock();
+    m_open_timing.reference_clock_s = step_seconds();
 
     /*
      * Temperature measurement during acquisition is not allowed for BGT60UTR11AIP.
@@ -280,7 +556,12 @@ DeviceFmcwAvian::DeviceFmcwAvian(std::unique_ptr<BoardInstance>&& board) :
     }
 
     DeviceFmcwAvian::initialize_sensor_info();
+    m_open_timing.sensor_info_s = step_seconds();
     DeviceFmcwAvian::generate_register_list();
+    m_open_timing.register_list_s = step_seconds();
+
+    m_open_timing.total_s += m_open_timing.driver_s + m_open_timing.reference_clock_s
+                             + m_open_timing.sensor_info_s + m_open_timing.register_list_s;
 }
 
 DeviceFmcwAvian::DeviceFmcwAvian(ifx_Radar_Sensor_t device_type, float reference_clock) :
@@ -338,12 +619,18 @@ DeviceFmcwAvian::~DeviceFmcwAvian()
 
 void DeviceFmcwAvian::stop_acquisition()
 {
-    if (!m_data_started)
     {
-        return;
-    }
+        // recover_from_overflow may run on the bridge thread; once it has
+        // seen the acquisition stopped it does not restart it anymore
+        std::lock_guard<std::mutex> lock(m_recovery_mutex);
+        if (!m_data_started)
+        {
+            return;
+        }
 
-    m_data_started = false;
+        m_data_started = false;
+    }
+    stop_telemetry();
 
     // check if dummy device
     if (!m_board)
@@ -424,6 +711,17 @@ float DeviceFmcwAvian::get_temperature()
         throw rdk::exception::not_supported();
     }
 
+    // While an acquisition runs the temperature is sampled in the
+    // background (see run_telemetry), so reading it does not block.
+    if (m_data_started)
+    {
+        const float temperature = m_telemetry_temperature;
+        if (!std::isnan(temperature))
+        {
+            return temperature;
+        }
+    }
+
     // Do not read the temperature from the radar sensor too often as it
     // decreases performance (negative impact on data rate), might cause
     // problems as fetching temperature takes some time, and it is not
@@ -442,6 +740,12 @@ float DeviceFmcwAvian::get_temperature()
     // temperature in units of 0.001 degree Celsius
     int32_t temp;
     const auto rc = m_driver->get_temperature(&temp);
+
+    // Outside of an acquisition the measurement may reset the device.
+    if (!m_data_started)
+    {
+        m_programmed_registers_valid = false;
+    }
     check_libavian_return(rc);
 
     // Save the current temperature value and get a new temperature value
@@ -470,15 +774,7 @@ void DeviceFmcwAvian::start_acquisition()
 
     update_defaults_if_not_configured();
 
-    /* get the device FIFO size in samples
-     * The unit used by Device_Traits corresponds to pairs of samples,
-     * therefore the number of samples is obtained by multiplying by two.
-     */
-    const auto device_type = m_driver->get_device_type();
-    const auto& device_traits = Avian::Device_Traits::get(device_type);
-    const uint32_t fifo_count = static_cast<uint32_t>(device_traits.fifo_size) * 2;
-
-    const auto slice_size = calculate_slice_size(fifo_count);
+    const auto slice_size = calculate_slice_size(get_fifo_count());
     const auto rc = m_driver->set_slice_size(slice_size);
     check_libavian_return(rc);
 
@@ -487,26 +783,331 @@ void DeviceFmcwAvian::start_acquisition()
     start_data();
 
     // Data reading is active now, but the Avian device must be triggered, too.
-    initialize_reference_clock(*m_port, m_driver->get_clock_config_command());
-    m_driver->get_device_configuration().send_to_device(*m_port, true);
+    program_registers(true);
     m_driver->notify_trigger();
 
     m_data_started = true;
+    start_telemetry();
 }
 
-void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+bool DeviceFmcwAvian::recover_from_overflow()
 {
-    using namespace Avian;
+    std::lock_guard<std::mutex> lock(m_recovery_mutex);
+    if (!m_data_started || !m_board)
+    {
+        return false;
+    }
+
+    /*
+     * The overflow stopped the sequencer, the slice size and the readout
+     * stay as configured. The soft reset of stop_and_reset_sequence flushes
+     * the FIFO and keeps the register values, so only the registers it
+     * changed and the trigger bit are written again; the bridge keeps
+     * streaming.
+     */
+    try
+    {
+        m_data->stop(m_data_index);
+        check_libavian_return(m_driver->stop_and_reset_sequence());
+        m_data->start(m_data_index);
+        program_registers(true);
+        m_driver->notify_trigger();
+    }
+    catch (...)
+    {
+        // e.g. the board is gone, the caller reports the overflow
+        return false;
+    }
+    return true;
+}
+
+void DeviceFmcwAvian::start_telemetry()
+{
+    // See get_temperature
+    if (m_driver->get_device_type() == Avian::Device_Type::BGT60UTR11AIP)
+    {
+        return;
+    }
+
+    m_telemetry_temperature = NAN;
+    m_telemetry_stop = false;
+    m_telemetry_thread = std::thread(&DeviceFmcwAvian::run_telemetry, this, m_driver->get_device_type());
+}
+
+void DeviceFmcwAvian::stop_telemetry()
+{
+    if (!m_telemetry_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_telemetry_mutex);
+        m_telemetry_stop = true;
+    }
+    m_telemetry_cv.notify_one();
+    m_telemetry_thread.join();
+}
+
+void DeviceFmcwAvian::run_telemetry(Avian::Device_Type device_type)
+{
+    /*
+     * While the sequencer runs, it measures the temperature in its idle
+     * phases between the frames and keeps the result in a register. Reading
+     * this register is a single SPI transfer that the bridge interleaves
+     * with the data transfers. The thread only uses the port, as m_driver
+     * may be replaced while the acquisition runs.
+     */
+    Avian::Sensor_Meter meter(*m_port, device_type);
+
+    std::unique_lock<std::mutex> lock(m_telemetry_mutex);
+    while (!m_telemetry_stop)
+    {
+        lock.unlock();
+        try
+        {
+            m_telemetry_temperature = meter.get_recently_measured_temperature();
+        }
+        catch (...)
+        {
+            // A lost device is reported by the data path, keep the last value.
+        }
+        lock.lock();
+
+        m_telemetry_cv.wait_for(lock, TELEMETRY_PERIOD, [this] { return m_telemetry_stop; });
+    }
+}
+
+void DeviceFmcwAvian::program_registers(bool set_trigger_bit)
+{
+    const auto configuration = m_driver->get_device_configuration();
+    const auto clock_config_command = m_driver->get_clock_config_command();
+
+    if (!m_programmed_registers_valid)
+    {
+        initialize_reference_clock(*m_port, clock_config_command);
+        configuration.send_to_device(*m_port, set_trigger_bit);
+    }
+    else
+    {
+        /*
+         * The registers keep their values across the soft reset done when an
+         * acquisition is stopped, so only registers that changed since they
+         * were last written are sent. The start up of the reference clock
+         * takes several hundred microseconds and is only repeated if its
+         * register changed.
+         */
+        auto update = configuration.extract_update(m_programmed_registers);
+
+        const auto clock_register = static_cast<uint8_t>(clock_config_command >> 25);
+        if (clock_config_command && update.is_defined(clock_register))
+        {
+            initialize_reference_clock(*m_port, clock_config_command);
+        }
+
+        // The trigger bit is carried by the MAIN register, which is therefore always sent.
+        if (set_trigger_bit)
+        {
+            update.set(REGISTER_MAIN, configuration[REGISTER_MAIN]);
+        }
+        update.send_to_device(*m_port, set_trigger_bit);
+    }
+
+    m_programmed_registers = configuration;
+    m_programmed_registers_valid = true;
+}
+
+bool DeviceFmcwAvian::update_running_acquisition(Avian::Driver& driver)
+{
+    if (!m_data_started || !m_board || !m_programmed_registers_valid)
+    {
+        return false;
+    }
+
+    const auto& device_traits = Avian::Device_Traits::get(driver.get_device_type());
+    if (device_traits.has_reordered_register_layout)
+    {
+        return false;
+    }
+
+    /*
+     * Only changes of channel set registers (e.g. TX power, IF gain and
+     * filter settings) are applied while the acquisition is running. Any
+     * other change requires to stop the acquisition.
+     */
+    const auto configuration = driver.get_device_configuration();
+    const auto update = configuration.extract_update(m_programmed_registers);
+    bool only_channel_sets = true;
+    update.for_each([&only_channel_sets](uint8_t address, uint32_t) {
+        if (address < REGISTER_CHANNEL_SET_FIRST || address > REGISTER_CHANNEL_SET_LAST)
+        {
+            only_channel_sets = false;
+        }
+    });
+    if (!only_channel_sets)
+    {
+        return false;
+    }
+
+    /*
+     * The channel sets also select the RX antennas. The data already
+     * configured for reading must still fit, so the frame format of all
+     * shapes must not change.
+     */
+    Avian::Driver current_driver(*m_driver);
+    Avian::Driver new_driver(driver);
+    for (const uint8_t shape : {0, 1, 2, 3})
+    {
+        for (const bool down : {false, true})
+        {
+            Avian::Frame_Format current_format;
+            Avian::Frame_Format new_format;
+            check_libavian_return(current_driver.select_shape_to_configure(shape, down));
+            check_libavian_return(current_driver.get_frame_format(&current_format));
+            check_libavian_return(new_driver.select_shape_to_configure(shape, down));
+            check_libavian_return(new_driver.get_frame_format(&new_format));
+
+            if (current_format.num_samples_per_chirp != new_format.num_samples_per_chirp
+                || current_format.num_chirps_per_frame != new_format.num_chirps_per_frame
+                || current_format.rx_mask != new_format.rx_mask)
+            {
+                return false;
+            }
+        }
+    }
 
+    update.send_to_device(*m_port, false);
+    m_programmed_registers = configuration;
+    return true;
+}
+
+uint32_t DeviceFmcwAvian::get_slice_size()
+{
+    update_defaults_if_not_configured();
+
+    return calculate_slice_size(get_fifo_count());
+}
+
+uint32_t DeviceFmcwAvian::get_fifo_count() const
+{
+    /* get the device FIFO size in samples
+     * The unit used by Device_Traits corresponds to pairs of samples,
+     * therefore the number of samples is obtained by multiplying by two.
+     */
+    const auto device_type = m_driver->get_device_type();
+    const auto& device_traits = Avian::Device_Traits::get(device_type);
+    return static_cast<uint32_t>(device_traits.fifo_size) * 2;
+}
+
+void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+{
     if (sequence == nullptr)
     {
         throw rdk::exception::argument_null();
     }
 
+    /*
+     * The sequence is translated into a local copy of the driver, or taken
+     * from the cache of compiled sequences if it was checked before. Only
+     * when no error occurs, the local driver with the new parameters is
+     * swapped with the old one.
+     */
+    const auto& compiled = compile_acquisition_sequence(sequence);
+    if (!compiled.driver)
+    {
+        throw rdk::exception::exception(compiled.error);
+    }
+    auto local_driver = std::make_unique<Avian::Driver>(*compiled.driver);
+
+    /*
+     * Finally the parameters of the new acquisition sequence are applied.
+     * Before the configuration of the local driver is made active, any ongoing
+     * acquisition has to be stopped, unless only registers changed that can
+     * be written while the acquisition is running.
+     */
+    if (!update_running_acquisition(*local_driver))
+    {
+        stop_acquisition();
+    }
+    std::swap(m_driver, local_driver);
+    m_compiled_sequences.clear();
+    generate_register_list();
+
+    /*
+     * The base class needs information about the frame structure for data
+     * fetching during acquisition.
+     */
+    update_frame_settings();
+}
+
+void DeviceFmcwAvian::check_acquisition_sequences(const ifx_Fmcw_Sequence_Element_t* const* sequences,
+                                                  uint32_t num_sequences, ifx_Error_t* errors, float* durations) const
+{
+    if (num_sequences && (sequences == nullptr || errors == nullptr))
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    for (uint32_t i = 0; i < num_sequences; i++)
+    {
+        if (sequences[i] == nullptr)
+        {
+            throw rdk::exception::argument_null();
+        }
+
+        const auto& compiled = compile_acquisition_sequence(sequences[i]);
+        errors[i] = compiled.error;
+        if (durations)
+        {
+            durations[i] = compiled.duration_s;
+        }
+    }
+}
+
+const DeviceFmcwAvian::Compiled_Sequence&
+DeviceFmcwAvian::compile_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) const
+{
+    std::string key;
+    append_sequence_key(key, sequence);
+
+    auto cached = m_compiled_sequences.find(key);
+    if (cached != m_compiled_sequences.end())
+    {
+        return cached->second;
+    }
+
+    /*
+     * The cache is only a shortcut for repeated checks of the same
+     * sequences, so it is simply dropped instead of growing without limit.
+     */
+    if (m_compiled_sequences.size() >= MAX_COMPILED_SEQUENCES)
+    {
+        m_compiled_sequences.clear();
+    }
+
+    Compiled_Sequence compiled = {nullptr, IFX_OK, 0};
+    try
+    {
+        compiled.driver = translate_acquisition_sequence(sequence);
+        compiled.duration_s = get_sequence_duration(sequence);
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        compiled.driver.reset();
+        compiled.error = e.error_code();
+    }
+
+    return m_compiled_sequences.emplace(std::move(key), std::move(compiled)).first->second;
+}
+
+std::unique_ptr<Avian::Driver>
+DeviceFmcwAvian::translate_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) const
+{
+    using namespace Avian;
+
     /*
      * A local copy of the driver allows to change parameters and drop them in
-     * case of an error. Only when no exception is thrown and no error occurs,
-     * the local driver with the new parameters is swapped with the old one.
+     * case of an error.
      */
     auto local_driver = std::make_unique<Driver>(*m_driver);
 
@@ -950,9 +1551,9 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
              */
             auto rc = local_driver->set_frame_definition(&frame_definition);
             check_libavian_return(rc);
-            TimingModel::StateSequence timing_model(*local_driver);
-            auto num_cycles = timing_model.getChirpToChirpTime(next_shape_index);
-            auto prelim_rep_time = timing_model.toSeconds(num_cycles);
+            const auto& timing = get_timing(*local_driver);
+            auto num_cycles = timing.chirp_to_chirp[next_shape_index];
+            auto prelim_rep_time = timing.to_seconds(num_cycles);
 
             /*
              * The additional delay to stretch the loop repetition time is
@@ -1018,9 +1619,9 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
     {
         auto rc = local_driver->set_frame_definition(&frame_definition);
         check_libavian_return(rc);
-        TimingModel::StateSequence timing_model(*local_driver);
-        auto num_cycles = timing_model.getSetToSetTime() - 1;
-        auto prelim_rep_time = timing_model.toSeconds(num_cycles);
+        const auto& timing = get_timing(*local_driver);
+        auto num_cycles = timing.set_to_set - 1;
+        auto prelim_rep_time = timing.to_seconds(num_cycles);
 
         auto additional_delay = shape_set_repetition_time - prelim_rep_time;
         if (additional_delay < 0.0f)
@@ -1047,9 +1648,9 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
      */
     auto rc = local_driver->set_frame_definition(&frame_definition);
     check_libavian_return(rc);
-    TimingModel::StateSequence timing_model(*local_driver);
-    auto num_cycles = timing_model.getFrameDuration() - 1;
-    auto prelim_rep_time = timing_model.toSeconds(num_cycles);
+    const auto& timing = get_timing(*local_driver);
+    auto num_cycles = timing.frame - 1;
+    auto prelim_rep_time = timing.to_seconds(num_cycles);
 
     auto additional_delay = frame_repetition_time - prelim_rep_time;
     if (additional_delay < 0.0f)
@@ -1065,30 +1666,17 @@ void DeviceFmcwAvian::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t
     rc = local_driver->set_frame_definition(&frame_definition);
     check_libavian_return(rc);
 
-    /*
-     * Finally the parameters of the new acquisition sequence are applied.
-     * Before the configuration of the local driver is made active, any ongoing
-     * acquisition has to be stopped.
-     */
-    stop_acquisition();
-    std::swap(m_driver, local_driver);
-    generate_register_list();
-
-    /*
-     * The base class needs information about the frame structure for data
-     * fetching during acquisition.
-     */
-    update_frame_settings();
+    return local_driver;
 }
 
 ifx_Fmcw_Sequence_Element_t* DeviceFmcwAvian::get_acquisition_sequence() const
 {
     /*
      * The timing model knows best about chirp, set and frame repetition rates,
-     * so a temporary instance is created, to provide the repetition times for
-     * the created loop elements.
+     * so its results provide the repetition times for the created loop
+     * elements.
      */
-    auto timing_model = create_timing_model();
+    const auto* timing_model = get_register_map_timing();
 
     /*
      * At some points the acquisition sequence may contain optional delays. At
@@ -1121,8 +1709,8 @@ ifx_Fmcw_Sequence_Element_t* DeviceFmcwAvian::get_acquisition_sequence() const
      */
     auto* frame_loop = ifx_fmcw_create_sequence_element(IFX_SEQ_LOOP);
     frame_loop->loop.num_repetitions = frame_definition.num_frames;
-    auto frame_ticks = timing_model->getFrameDuration();
-    auto frame_time = timing_model->toSeconds(frame_ticks);
+    auto frame_ticks = timing_model->frame;
+    auto frame_time = timing_model->to_seconds(frame_ticks);
     frame_loop->loop.repetition_time_s = static_cast<float>(frame_time);
 
     auto* shape_append_ptr = &frame_loop->loop.sub_sequence;
@@ -1138,8 +1726,8 @@ ifx_Fmcw_Sequence_Element_t* DeviceFmcwAvian::get_acquisition_sequence() const
     {
         auto* set_loop = ifx_fmcw_create_sequence_element(IFX_SEQ_LOOP);
         set_loop->loop.num_repetitions = frame_definition.shape_set.num_repetitions;
-        auto set_ticks = timing_model->getSetToSetTime();
-        auto set_time = timing_model->toSeconds(set_ticks);
+        auto set_ticks = timing_model->set_to_set;
+        auto set_time = timing_model->to_seconds(set_ticks);
         set_loop->loop.repetition_time_s = static_cast<float>(set_time);
 
         /*
@@ -1296,8 +1884,8 @@ ifx_Fmcw_Sequence_Element_t* DeviceFmcwAvian::get_acquisition_sequence() const
             auto* shape_loop = ifx_fmcw_create_sequence_element(IFX_SEQ_LOOP);
             shape_loop->loop.sub_sequence = first_chirp;
             shape_loop->loop.num_repetitions = shape.num_repetitions;
-            auto shape_ticks = timing_model->getChirpToChirpTime(shp);
-            auto shape_time = timing_model->toSeconds(shape_ticks);
+            auto shape_ticks = timing_model->chirp_to_chirp[shp];
+            auto shape_time = timing_model->to_seconds(shape_ticks);
             shape_loop->loop.repetition_time_s = static_cast<float>(shape_time);
 
             *shape_append_ptr = shape_loop;
@@ -1383,6 +1971,12 @@ std::map<uint16_t, uint32_t>& DeviceFmcwAvian::get_register_list()
 
 std::map<uint16_t, uint32_t> DeviceFmcwAvian::import_register_list(const char* filename)
 {
+    std::vector<std::pair<uint16_t, uint32_t>> profile;
+    if (read_register_profile(filename, m_driver->get_device_type(), profile))
+    {
+        return {profile.begin(), profile.end()};
+    }
+
     // Each entry in the retrieved  register map alwayas refers to layout index 0.
     // Therefore, provide one dummy layout with no bitfields in it (an empty map).
     auto device_type = m_driver->get_device_type();
@@ -1408,10 +2002,46 @@ void DeviceFmcwAvian::export_register_list(const char* filename, const std::map<
 
 void DeviceFmcwAvian::load_register_file(const char* filename)
 {
+    // binary profiles are applied without going through the text parser
+    std::vector<std::pair<uint16_t, uint32_t>> profile;
+    if (read_register_profile(filename, m_driver->get_device_type(), profile))
+    {
+        std::vector<Register_Entry> registers;
+        registers.reserve(profile.size());
+        for (const auto& entry : profile)
+            registers.emplace_back(static_cast<uint8_t>(entry.first), entry.second);
+        apply_registers(std::move(registers));
+        return;
+    }
+
     const auto register_list = import_register_list(filename);
     apply_register_list(register_list);
 }
 
+void DeviceFmcwAvian::save_register_profile(const char* filename)
+{
+    const auto& register_list = get_register_list();
+
+    std::vector<uint8_t> data(std::begin(REGISTER_PROFILE_MAGIC), std::end(REGISTER_PROFILE_MAGIC));
+    put_u32(data, REGISTER_PROFILE_VERSION);
+    put_u32(data, static_cast<uint32_t>(m_driver->get_device_type()));
+    put_u32(data, static_cast<uint32_t>(register_list.size()));
+    for (const auto& entry : register_list)
+    {
+        put_u16(data, entry.first);
+        put_u16(data, 0);
+        put_u32(data, entry.second);
+    }
+    put_u32(data, fnv1a_32(data.data(), data.size()));
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw rdk::exception::opening_file();
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file)
+        throw rdk::exception::opening_file();
+}
+
 void DeviceFmcwAvian::save_register_file(const char* filename)
 {
     auto& register_list = get_register_list();
@@ -1420,19 +2050,123 @@ void DeviceFmcwAvian::save_register_file(const char* filename)
 
 void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& register_list)
 {
-    // mapping from generic interface map with uint16_t address to Avian Driver specific map with uint8_t address
-    std::map<uint8_t, uint32_t> register_map;
+    // mapping from generic interface map with uint16_t address to Avian Driver specific list with uint8_t address
+    std::vector<Register_Entry> registers;
+    registers.reserve(register_list.size());
     for (const auto& entry : register_list)
     {
-        register_map.insert(std::make_pair(static_cast<uint8_t>(entry.first), entry.second));
+        registers.emplace_back(static_cast<uint8_t>(entry.first), entry.second);
     }
 
+    apply_registers(std::move(registers));
+}
+
+std::shared_ptr<const DeviceFmcwAvian::Extracted_Registers> DeviceFmcwAvian::extract_registers(std::vector<Register_Entry> registers)
+{
+    // Sort by address, for duplicate addresses the first entry wins like it
+    // does when inserting into a map.
+    std::stable_sort(registers.begin(), registers.end(), [](const Register_Entry& lhs, const Register_Entry& rhs) {
+        return lhs.first < rhs.first;
+    });
+    const auto last = std::unique(registers.begin(), registers.end(), [](const Register_Entry& lhs, const Register_Entry& rhs) {
+        return lhs.first == rhs.first;
+    });
+    registers.erase(last, registers.end());
+
+    const uint64_t hash = hash_register_list(registers);
+    const auto cached = m_extracted_registers.find(hash);
+    if (cached != m_extracted_registers.end() && cached->second.registers == registers)
+        return cached->second.result;
+
     // The subsequent code can be greatly simplified once lib_avian allows to
     // directly import register lists.
 
     const auto sensor_type = m_driver->get_device_type();
     const auto& device_traits = Avian::Device_Traits::get(sensor_type);
-    const auto extractor = Avian::Parameter_Extractor(register_map, sensor_type);
+    const auto extractor = Avian::Parameter_Extractor(registers.data(), registers.size(), sensor_type);
+
+    auto result = std::make_shared<Extracted_Registers>();
+
+    // Global parameters
+
+    result->reference_clock = extractor.get_reference_clock();
+    result->slice_size = extractor.get_slice_size();
+    result->frame_definition = extractor.get_frame_definition();
+    result->adc_configuration = extractor.get_adc_configuration();
+    result->chirp_timing = extractor.get_chirp_timing();
+    result->startup_timing = extractor.get_startup_timing();
+    result->idle_configuration = extractor.get_idle_configuration();
+    result->deep_sleep_configuration = extractor.get_deep_sleep_configuration();
+
+    // Global parameters introduced with 'generation D'
+
+    if (device_traits.has_extra_startup_delays)
+        result->startup_delays = extractor.get_startup_delays();
+    if (device_traits.has_ref_frequency_doubler)
+        result->duty_cycle_correction = extractor.get_duty_cycle_correction();
+    if (device_traits.has_programmable_fifo_power_mode)
+        result->fifo_power_mode = extractor.get_fifo_power_mode();
+    if (device_traits.has_programmable_pad_driver)
+        result->pad_driver_mode = extractor.get_pad_driver_mode();
+
+    // Global parameters introduced with 'generation E'
+
+    if (device_traits.has_programmable_pullup_resistors)
+        result->pullup_resistor_configuration = extractor.get_pullup_resistor_configuration();
+
+    // Global parameters introduced with BGT60UTR11AIP
+
+    if (!device_traits.has_sadc)  // only possible if SADC is *not* available
+    {
+        result->power_sens_delay = extractor.get_power_sens_delay();
+        result->power_sens_enabled = extractor.get_power_sens_enabled();
+        result->temperature_sens_enabled = extractor.get_temperature_sens_enabled();
+    }
+
+    // Chirp parameters
+
+    for (const uint8_t shape : {0, 1, 2, 3})  // for all 4 shapes
+    {
+        auto& extracted_shape = result->shapes[shape];
+        if (result->frame_definition.shapes[shape].num_repetitions == 0)
+            continue;
+
+        extracted_shape.fmcw_configuration = extractor.get_fmcw_configuration(shape);
+        for (const bool down : {true, false})  // and up- and down-chirps
+        {
+            // Chirps are used if and only if:
+            //  - imported shape type is Saw_Up and down is false (means: up-chirp)
+            //  - imported shape type is Saw_Down and down is true (means: down-chirp)
+            //  - imported shape type is Tri_Up or Tri_Down (has both up- and down chirps)
+            const auto shape_type = extracted_shape.fmcw_configuration.shape_type;
+            if ((shape_type == Avian::Shape_Type::Saw_Down && !down)
+                || (shape_type == Avian::Shape_Type::Saw_Up && down))
+                continue;
+
+            auto& chirp = extracted_shape.chirps[down ? 1 : 0];
+            chirp.used = true;
+            chirp.tx_mode = extractor.get_tx_mode(shape, down);
+            chirp.frame_format = extractor.get_frame_format(shape, down);
+            chirp.baseband_configuration = extractor.get_baseband_configuration(shape, down);
+            chirp.chirp_end_delay = extractor.get_chirp_end_delay(shape, down);
+            if (device_traits.cs_register_layout != Avian::Device_Traits::Channel_Set_Layout::Version1)
+                chirp.anti_alias_filter_settings = extractor.get_anti_alias_filter_settings(shape, down);
+        }
+    }
+
+    // Extraction depends only on the registers and the sensor type, so
+    // entries never become stale and the cache is just bounded in size.
+    if (m_extracted_registers.size() >= MAX_EXTRACTED_REGISTER_LISTS)
+        m_extracted_registers.clear();
+    m_extracted_registers[hash] = {std::move(registers), result};
+
+    return result;
+}
+
+void DeviceFmcwAvian::apply_registers(std::vector<Register_Entry> registers)
+{
+    const auto extracted = extract_registers(std::move(registers));
+    const auto& device_traits = Avian::Device_Traits::get(m_driver->get_device_type());
 
     // create a copy of the current state
     // we first set the driver and only after the importing was successful, we
@@ -1443,65 +2177,53 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
 
     // Global parameters
 
-    const auto reference_clock = extractor.get_reference_clock();
-    rc = driver->set_reference_clock_frequency(reference_clock);
+    rc = driver->set_reference_clock_frequency(extracted->reference_clock);
     check_libavian_return(rc);
 
-    const auto slice_size = extractor.get_slice_size();
-    rc = driver->set_slice_size(slice_size);
+    rc = driver->set_slice_size(extracted->slice_size);
     check_libavian_return(rc);
 
-    const auto frame_definition = extractor.get_frame_definition();
-    rc = driver->set_frame_definition(&frame_definition);
+    rc = driver->set_frame_definition(&extracted->frame_definition);
     check_libavian_return(rc);
 
-    const auto adc_configuration = extractor.get_adc_configuration();
-    rc = driver->set_adc_configuration(&adc_configuration);
+    rc = driver->set_adc_configuration(&extracted->adc_configuration);
     check_libavian_return(rc);
 
-    const auto chirp_timing = extractor.get_chirp_timing();
-    rc = driver->set_chirp_timing(&chirp_timing);
+    rc = driver->set_chirp_timing(&extracted->chirp_timing);
     check_libavian_return(rc);
 
-    const auto startup_timing = extractor.get_startup_timing();
-    rc = driver->set_startup_timing(&startup_timing);
+    rc = driver->set_startup_timing(&extracted->startup_timing);
     check_libavian_return(rc);
 
-    const auto idle_configuration = extractor.get_idle_configuration();
-    rc = driver->set_idle_configuration(&idle_configuration);
+    rc = driver->set_idle_configuration(&extracted->idle_configuration);
     check_libavian_return(rc);
 
-    const auto deep_sleep_configuration = extractor.get_deep_sleep_configuration();
-    rc = driver->set_deep_sleep_configuration(&deep_sleep_configuration);
+    rc = driver->set_deep_sleep_configuration(&extracted->deep_sleep_configuration);
     check_libavian_return(rc);
 
     // Global parameters introduced with 'generation D'
 
     if (device_traits.has_extra_startup_delays)
     {
-        const auto startup_delays = extractor.get_startup_delays();
-        rc = driver->set_startup_delays(&startup_delays);
+        rc = driver->set_startup_delays(&extracted->startup_delays);
         check_libavian_return(rc);
     }
 
     if (device_traits.has_ref_frequency_doubler)
     {
-        const auto duty_cycle_correction = extractor.get_duty_cycle_correction();
-        rc = driver->set_duty_cycle_correction(&duty_cycle_correction);
+        rc = driver->set_duty_cycle_correction(&extracted->duty_cycle_correction);
         check_libavian_return(rc);
     }
 
     if (device_traits.has_programmable_fifo_power_mode)
     {
-        const auto fifo_power_mode = extractor.get_fifo_power_mode();
-        rc = driver->set_fifo_power_mode(fifo_power_mode);
+        rc = driver->set_fifo_power_mode(extracted->fifo_power_mode);
         check_libavian_return(rc);
     }
 
     if (device_traits.has_programmable_pad_driver)
     {
-        const auto pad_driver_mode = extractor.get_pad_driver_mode();
-        rc = driver->set_pad_driver_mode(pad_driver_mode);
+        rc = driver->set_pad_driver_mode(extracted->pad_driver_mode);
         check_libavian_return(rc);
     }
 
@@ -1509,8 +2231,7 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
 
     if (device_traits.has_programmable_pullup_resistors)
     {
-        const auto pullup_resistor_configuration = extractor.get_pullup_resistor_configuration();
-        rc = driver->set_pullup_resistor_configuration(&pullup_resistor_configuration);
+        rc = driver->set_pullup_resistor_configuration(&extracted->pullup_resistor_configuration);
         check_libavian_return(rc);
     }
 
@@ -1518,16 +2239,13 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
 
     if (!device_traits.has_sadc)  // only possible if SADC is *not* available
     {
-        const auto power_sens_delay = extractor.get_power_sens_delay();
-        rc = driver->set_power_sens_delay(power_sens_delay);
+        rc = driver->set_power_sens_delay(extracted->power_sens_delay);
         check_libavian_return(rc);
 
-        const auto power_sens_enabled = extractor.get_power_sens_enabled();
-        rc = driver->set_power_sens_enabled(power_sens_enabled);
+        rc = driver->set_power_sens_enabled(extracted->power_sens_enabled);
         check_libavian_return(rc);
 
-        const auto temperature_sens_enabled = extractor.get_temperature_sens_enabled();
-        rc = driver->set_temperature_sens_enabled(temperature_sens_enabled);
+        rc = driver->set_temperature_sens_enabled(extracted->temperature_sens_enabled);
         check_libavian_return(rc);
     }
 
@@ -1535,12 +2253,13 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
 
     for (const uint8_t shape : {0, 1, 2, 3})   // for all 4 shapes
     {
+        const auto& extracted_shape = extracted->shapes[shape];
         for (const bool down : {true, false})  // and up- and down-chirps
         {
             rc = driver->select_shape_to_configure(shape, down);
             check_libavian_return(rc);
 
-            if (frame_definition.shapes[shape].num_repetitions == 0)
+            if (extracted->frame_definition.shapes[shape].num_repetitions == 0)
             {
                 // If this shape has no repetitions the shape is disabled.
                 // So, we also need to disable the current shape.
@@ -1549,38 +2268,28 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
                 break;
             }
 
-            const auto fmcw_configuration = extractor.get_fmcw_configuration(shape);
-            rc = driver->set_fmcw_configuration(&fmcw_configuration);
+            rc = driver->set_fmcw_configuration(&extracted_shape.fmcw_configuration);
             check_libavian_return(rc);
 
-            // Continue if and only if:
-            //  - imported shape type is Saw_Up and down is false (means: up-chirp)
-            //  - imported shape type is Saw_Down and down is true (means: down-chirp)
-            //  - imported shape type is Tri_Up or Tri_Down (has both up- and down chirps)
-            if ((fmcw_configuration.shape_type == Avian::Shape_Type::Saw_Down && !down)
-                || (fmcw_configuration.shape_type == Avian::Shape_Type::Saw_Up && down))
+            const auto& chirp = extracted_shape.chirps[down ? 1 : 0];
+            if (!chirp.used)
                 continue;
 
-            const auto tx_mode = extractor.get_tx_mode(shape, down);
-            rc = driver->set_tx_mode(tx_mode);
+            rc = driver->set_tx_mode(chirp.tx_mode);
             check_libavian_return(rc);
 
-            const auto frame_format = extractor.get_frame_format(shape, down);
-            rc = driver->set_frame_format(&frame_format);
+            rc = driver->set_frame_format(&chirp.frame_format);
             check_libavian_return(rc);
 
-            const auto baseband_configuration = extractor.get_baseband_configuration(shape, down);
-            rc = driver->set_baseband_configuration(&baseband_configuration);
+            rc = driver->set_baseband_configuration(&chirp.baseband_configuration);
             check_libavian_return(rc);
 
-            const auto chirp_end_delay = extractor.get_chirp_end_delay(shape, down);
-            rc = driver->set_chirp_end_delay(chirp_end_delay);
+            rc = driver->set_chirp_end_delay(chirp.chirp_end_delay);
             check_libavian_return(rc);
 
             if (device_traits.cs_register_layout != Avian::Device_Traits::Channel_Set_Layout::Version1)
             {
-                const auto anti_alias_filter_settings = extractor.get_anti_alias_filter_settings(shape, down);
-                rc = driver->set_anti_alias_filter_settings(&anti_alias_filter_settings);
+                rc = driver->set_anti_alias_filter_settings(&chirp.anti_alias_filter_settings);
                 check_libavian_return(rc);
             }
         }
@@ -1591,8 +2300,12 @@ void DeviceFmcwAvian::apply_register_list(const std::map<uint16_t, uint32_t>& re
      * As a first step of initialization the device configuration provided by the user is copied into
      * the handle. Some of the parameters are needed during fetching of time domain data.
      */
-    stop_acquisition();
+    if (!update_running_acquisition(*driver))
+    {
+        stop_acquisition();
+    }
     m_driver = std::move(driver);
+    m_compiled_sequences.clear();
 
     m_num_samples = 0;
     update_defaults_if_not_configured();
@@ -1628,6 +2341,62 @@ std::unique_ptr<TimingModel::StateSequence> DeviceFmcwAvian::create_timing_model
     return std::make_unique<StateSequence>(avian_registers, device_type);
 }
 
+// ---------------------------------------------------------------------------
+const DeviceFmcwAvian::Timing& DeviceFmcwAvian::get_timing(const HW::RegisterSet& registers, double ref_frequency) const
+{
+    /*
+     * Building the timing model walks through the sequencer states of a
+     * frame, which is by far the most expensive part of translating an
+     * acquisition sequence. Its results only depend on the register values,
+     * so they are cached by register contents. Register sets are compared
+     * on hits, so hash collisions don't matter.
+     */
+    const uint64_t hash = hash_register_set(registers, ref_frequency);
+    const auto cached = m_timings.find(hash);
+    if (cached != m_timings.end() && cached->second.ref_frequency == ref_frequency
+        && cached->second.registers == registers)
+    {
+        return cached->second.timing;
+    }
+
+    TimingModel::StateSequence timing_model(registers, m_driver->get_device_type(), ref_frequency);
+
+    Timing timing;
+    for (unsigned shape = 0; shape < 4; shape++)
+        timing.chirp_to_chirp[shape] = timing_model.getChirpToChirpTime(shape);
+    timing.set_to_set = timing_model.getSetToSetTime();
+    timing.frame = timing_model.getFrameDuration();
+    timing.ref_frequency = ref_frequency;
+
+    if (m_timings.size() >= MAX_TIMINGS)
+        m_timings.clear();
+    auto& entry = m_timings[hash];
+    entry = {registers, ref_frequency, timing};
+    return entry.timing;
+}
+
+// ---------------------------------------------------------------------------
+const DeviceFmcwAvian::Timing& DeviceFmcwAvian::get_timing(const Avian::Driver& driver) const
+{
+    return get_timing(driver.get_device_configuration(), get_ref_frequency(driver));
+}
+
+// ---------------------------------------------------------------------------
+const DeviceFmcwAvian::Timing* DeviceFmcwAvian::get_register_map_timing() const
+{
+    // same input as create_timing_model
+    if (m_driver->get_device_type() == Device_Type::Unknown)
+    {
+        return nullptr;
+    }
+
+    HW::RegisterSet avian_registers;
+    for (const auto& entry : m_register_map)
+        avian_registers.set(static_cast<uint8_t>(entry.first), entry.second);
+
+    return &get_timing(avian_registers, 80.0e6);
+}
+
 float DeviceFmcwAvian::get_chirp_duration(const ifx_Fmcw_Sequence_Chirp_t& chirp) const
 {
     /*
@@ -1686,22 +2455,75 @@ void DeviceFmcwAvian::set_reference_clock(float reference_clock)
 
     const auto rc = m_driver->set_reference_clock_frequency(parameter);
     check_libavian_return(rc);
+    m_compiled_sequences.clear();
 }
 
-void DeviceFmcwAvian::detect_reference_clock()
+bool DeviceFmcwAvian::detect_reference_clock()
 {
+    const auto& uuid = m_board->getUuidString();
+    const auto device_type = m_driver->get_device_type();
+    const auto& device_traits = Avian::Device_Traits::get(device_type);
+    const std::array<uint16_t, 3> firmware = {m_firmware_info.version_major, m_firmware_info.version_minor, m_firmware_info.version_build};
+
+    {
+        std::lock_guard<std::mutex> lock(reference_clock_cache_mutex);
+        const auto cached = reference_clock_cache.find(uuid);
+        if ((cached != reference_clock_cache.end())
+            && (cached->second.device_type == static_cast<uint32_t>(device_type))
+            && (cached->second.firmware == firmware))
+        {
+            // The sensor was reset by create_driver and receives the clock
+            // configuration with the first sequence, nothing to send here.
+            if (device_traits.has_internal_oscillator)
+            {
+                Oscillator_Configuration osc_config;
+                m_driver->get_oscillator_configuration(&osc_config);
+                osc_config.clock_source = cached->second.clock_source;
+                m_driver->set_oscillator_configuration(&osc_config);
+            }
+            m_driver->set_reference_clock_frequency(cached->second.frequency);
+            return true;
+        }
+    }
+
     try
     {
-        if (!Avian::detect_reference_clock(*m_board, *m_driver))
+        // create_driver has just reset the sensor
+        if (!Avian::detect_reference_clock(*m_board, *m_driver, false))
         {
             IFX_LOG_WARNING("FW does not support detection of reference clock, continuing with default setting");
-            return;
         }
     }
     catch (const EException& e)
     {
         (void)e;
         IFX_LOG_WARNING("Could not generate measurement signal for oscillator frequency: %s", e.what());
+        // not cached, the next open measures again
+        return false;
+    }
+
+    Reference_Clock_Entry entry;
+    entry.device_type = static_cast<uint32_t>(device_type);
+    entry.firmware = firmware;
+    Oscillator_Configuration osc_config;
+    entry.clock_source = (m_driver->get_oscillator_configuration(&osc_config) == Driver::Error::OK)
+                             ? osc_config.clock_source
+                             : Clock_Source::External;
+    m_driver->get_reference_clock_frequency(&entry.frequency);
+
+    std::lock_guard<std::mutex> lock(reference_clock_cache_mutex);
+    reference_clock_cache[uuid] = entry;
+    write_reference_clock_cache();
+    return false;
+}
+
+void DeviceFmcwAvian::set_reference_clock_cache(const char* filename)
+{
+    std::lock_guard<std::mutex> lock(reference_clock_cache_mutex);
+    reference_clock_cache_file = filename ? filename : "";
+    if (!reference_clock_cache_file.empty())
+    {
+        read_reference_clock_cache();
     }
 }
 
@@ -1759,8 +2581,8 @@ float DeviceFmcwAvian::get_minimum_chirp_repetition_time(uint32_t num_samples, f
      * Now, with all settings made, the timing model can tell the chirp
      * repetition time.
      */
-    Avian::TimingModel::StateSequence timing_model(local_driver);
-    return float(timing_model.toSeconds(timing_model.getChirpToChirpTime(0)));
+    const auto& timing = get_timing(local_driver);
+    return float(timing.to_seconds(timing.chirp_to_chirp[0]));
 }
 
 double DeviceFmcwAvian::get_chirp_sampling_range(const ifx_Fmcw_Sequence_Chirp_t* chirp) const
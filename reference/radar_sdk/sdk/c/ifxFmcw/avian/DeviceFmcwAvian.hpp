@@ -56,7 +56,15 @@
 
 #include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 /*
 ==============================================================================
@@ -107,9 +115,12 @@ struct DeviceFmcwAvian : public DeviceFmcwBase
 
     void stop_acquisition() override;
     void start_acquisition() override;
+    uint32_t get_slice_size() override;
 
     IFX_DLL_TEST void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) override;
     IFX_DLL_TEST ifx_Fmcw_Sequence_Element_t* get_acquisition_sequence() const override;
+    void check_acquisition_sequences(const ifx_Fmcw_Sequence_Element_t* const* sequences, uint32_t num_sequences,
+                                     ifx_Error_t* errors, float* durations) const override;
 
     float get_temperature() override;
 
@@ -121,27 +132,149 @@ struct DeviceFmcwAvian : public DeviceFmcwBase
 
     IFX_DLL_TEST void load_register_file(const char* filename) override;
     IFX_DLL_TEST void save_register_file(const char* filename) override;
+    IFX_DLL_TEST void save_register_profile(const char* filename) override;
 
 
     IFX_DLL_PUBLIC uint32_t export_register_list_legacy(bool set_trigger_bit, uint32_t* register_list);
 
     IFX_DLL_PUBLIC std::unique_ptr<Infineon::Avian::TimingModel::StateSequence> create_timing_model() const;
 
+    static void set_reference_clock_cache(const char* filename);
+
 protected:
     float get_chirp_duration(const ifx_Fmcw_Sequence_Chirp_t& chirp) const override;
+    bool recover_from_overflow() override;
 
 private:
     void set_reference_clock(float reference_clock);
-    void detect_reference_clock();
+    bool detect_reference_clock();
 
     void generate_register_list();
+    uint32_t get_fifo_count() const;
+
+    using Register_Entry = std::pair<uint8_t, uint32_t>;
+
+    // Driver settings read from a register list by the parameter extractor.
+    // Members only valid for some device types are left default initialized
+    // for others; chirps with used == false are not part of the shape type.
+    struct Extracted_Registers
+    {
+        struct Chirp
+        {
+            bool used = false;
+            Infineon::Avian::Tx_Mode tx_mode {};
+            Infineon::Avian::Frame_Format frame_format {};
+            Infineon::Avian::Baseband_Configuration baseband_configuration {};
+            uint32_t chirp_end_delay = 0;
+            Infineon::Avian::Anti_Alias_Filter_Settings anti_alias_filter_settings {};
+        };
+
+        struct Shape
+        {
+            Infineon::Avian::Fmcw_Configuration fmcw_configuration {};
+            Chirp chirps[2];  // up-chirp, down-chirp
+        };
+
+        Infineon::Avian::Reference_Clock_Frequency reference_clock {};
+        uint16_t slice_size = 0;
+        Infineon::Avian::Frame_Definition frame_definition {};
+        Infineon::Avian::Adc_Configuration adc_configuration {};
+        Infineon::Avian::Chirp_Timing chirp_timing {};
+        Infineon::Avian::Startup_Timing startup_timing {};
+        Infineon::Avian::Power_Down_Configuration idle_configuration {};
+        Infineon::Avian::Power_Down_Configuration deep_sleep_configuration {};
+        Infineon::Avian::Startup_Delays startup_delays {};
+        Infineon::Avian::Duty_Cycle_Correction_Settings duty_cycle_correction {};
+        Infineon::Avian::Fifo_Power_Mode fifo_power_mode {};
+        Infineon::Avian::Pad_Driver_Mode pad_driver_mode {};
+        Infineon::Avian::Pullup_Resistor_Configuration pullup_resistor_configuration {};
+        uint32_t power_sens_delay = 0;
+        bool power_sens_enabled = false;
+        bool temperature_sens_enabled = false;
+        Shape shapes[4];
+    };
+
+    struct Cached_Extraction
+    {
+        std::vector<Register_Entry> registers;  // sorted by address, to detect hash collisions
+        std::shared_ptr<const Extracted_Registers> result;
+    };
+
+    std::shared_ptr<const Extracted_Registers> extract_registers(std::vector<Register_Entry> registers);
+    void apply_registers(std::vector<Register_Entry> registers);
+
+    // An acquisition sequence translated into driver settings, or the error
+    // why it cannot be applied (driver is nullptr in that case).
+    struct Compiled_Sequence
+    {
+        std::unique_ptr<Infineon::Avian::Driver> driver;
+        ifx_Error_t error;
+        float duration_s;
+    };
+
+    // Durations in clock cycles computed by the timing model
+    struct Timing
+    {
+        Infineon::Avian::TimingModel::Ticks chirp_to_chirp[4];
+        Infineon::Avian::TimingModel::Ticks set_to_set;
+        Infineon::Avian::TimingModel::Ticks frame;
+        double ref_frequency;
+
+        double to_seconds(Infineon::Avian::TimingModel::Ticks ticks) const
+        {
+            return ticks / ref_frequency;
+        }
+    };
+
+    struct Cached_Timing
+    {
+        Infineon::Avian::HW::RegisterSet registers;
+        double ref_frequency;
+        Timing timing;
+    };
+
+    const Timing& get_timing(const Infineon::Avian::HW::RegisterSet& registers, double ref_frequency) const;
+    const Timing& get_timing(const Infineon::Avian::Driver& driver) const;
+    const Timing* get_register_map_timing() const;
+
+    const Compiled_Sequence& compile_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) const;
+    std::unique_ptr<Infineon::Avian::Driver> translate_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) const;
+
+    void start_telemetry();
+    void stop_telemetry();
+    void run_telemetry(Infineon::Avian::Device_Type device_type);
+
+    void program_registers(bool set_trigger_bit);
+    bool update_running_acquisition(Infineon::Avian::Driver& driver);
 
     std::unique_ptr<Infineon::Avian::HW::IControlPort> m_port;
     std::unique_ptr<Infineon::Avian::Driver> m_driver;
     std::atomic<bool> m_data_started = false;
+    std::mutex m_recovery_mutex;  // keeps stop_acquisition from overtaking recover_from_overflow
+
+    // Registers as last written to the device, only valid while the device
+    // has not been reset since then. Used to write only changed registers.
+    Infineon::Avian::HW::RegisterSet m_programmed_registers;
+    bool m_programmed_registers_valid = false;
     std::chrono::steady_clock::time_point m_temperature_expiration_time = {};  // timestamp until the cached temperature value is valid
     float m_temperature_value = 0;                                             // cached temperature value in degrees Celsius
 
+    // Telemetry sampled by a background thread while an acquisition runs, see start_telemetry
+    std::thread m_telemetry_thread;
+    std::mutex m_telemetry_mutex;
+    std::condition_variable m_telemetry_cv;
+    bool m_telemetry_stop = false;                     // guarded by m_telemetry_mutex
+    std::atomic<float> m_telemetry_temperature = NAN;  // last sampled temperature in degrees Celsius, NAN if none
+
     std::vector<int8_t> m_if_gain_list;
     std::map<uint16_t, uint32_t> m_register_map;
+
+    // Compiled sequences by their parameters, all derived from the current m_driver
+    mutable std::map<std::string, Compiled_Sequence> m_compiled_sequences;
+
+    // Extracted register lists by the hash of their sorted entries, see extract_registers
+    std::unordered_map<uint64_t, Cached_Extraction> m_extracted_registers;
+
+    // Timing model results by the hash of registers and reference frequency, see get_timing
+    mutable std::unordered_map<uint64_t, Cached_Timing> m_timings;
 };
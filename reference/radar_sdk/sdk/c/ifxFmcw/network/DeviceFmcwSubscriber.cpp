@@ -0,0 +1,349 @@
+/**
+ * @internal
+ * @file DeviceFmcwSubscriber.cpp
+ *
+ * @brief Implements the device receiving the frames of a network publisher.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwSubscriber.hpp"
+#include "FrameCodec.hpp"
+
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/Log.h"
+
+#include <algorithm>
+#include <exception>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// Largest UDP payload
+constexpr size_t max_datagram_size = 65535;
+
+// Room for bursts of datagrams while the application is busy
+constexpr uint32_t input_buffer_size = 8 * 1024 * 1024;
+
+/* Receives the next valid datagram until deadline, returns its size or 0 at
+ * the deadline.
+ */
+size_t receive_datagram(SocketUdp& socket, std::vector<uint8_t>& datagram, FrameDatagram::Header& header,
+                        DeviceFmcwSubscriber::Clock::time_point deadline)
+{
+    while (true)
+    {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - DeviceFmcwSubscriber::Clock::now()).count();
+        if (remaining <= 0)
+        {
+            return 0;
+        }
+
+        // a timeout of 0 would block forever
+        socket.setTimeout(static_cast<uint16_t>(std::min<decltype(remaining)>(remaining, 0xFFFF)));
+        const auto size = socket.receiveFrom(datagram.data(), static_cast<uint16_t>(datagram.size()));
+        if ((size > 0) && FrameDatagram::parse_header(datagram.data(), size, header))
+        {
+            return size;
+        }
+    }
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwSubscriber::DeviceFmcwSubscriber(std::unique_ptr<SocketUdp> socket, const FrameDatagram::Configuration& configuration) :
+    DeviceFmcwAvian(static_cast<ifx_Radar_Sensor_t>(configuration.sensor_type)),
+    m_socket(std::move(socket)),
+    m_datagram(max_datagram_size),
+    m_sensor_type(configuration.sensor_type),
+    m_config_hash(FrameDatagram::configuration_hash(configuration.sensor_type, configuration.registers)),
+    m_publisher_registers(configuration.registers)
+{
+    DeviceFmcwAvian::apply_register_list(m_publisher_registers);
+
+    update_defaults_if_not_configured();
+    if (m_num_samples != configuration.num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+}
+
+void DeviceFmcwSubscriber::check_publisher_registers()
+{
+    if (get_register_list() != m_publisher_registers)
+    {
+        DeviceFmcwAvian::apply_register_list(m_publisher_registers);
+        throw rdk::exception::not_possible();
+    }
+}
+
+void DeviceFmcwSubscriber::update_configuration(const std::vector<uint8_t>& payload)
+{
+    FrameDatagram::Configuration configuration;
+    if (!FrameDatagram::decode_configuration(payload, configuration))
+    {
+        return;
+    }
+
+    const auto hash = FrameDatagram::configuration_hash(configuration.sensor_type, configuration.registers);
+    if (hash == m_config_hash)
+    {
+        return;
+    }
+
+    if (configuration.sensor_type != m_sensor_type)
+    {
+        // frames of the publisher are skipped until it returns to this sensor
+        IFX_LOG_ERROR("DeviceFmcwSubscriber - publisher changed the sensor type to %u", configuration.sensor_type);
+        return;
+    }
+
+    DeviceFmcwAvian::apply_register_list(configuration.registers);
+    m_publisher_registers = configuration.registers;
+    m_config_hash = hash;
+    m_frame_index_valid = false;
+}
+
+bool DeviceFmcwSubscriber::decode_frame(const FrameDatagram::Header& header, const std::vector<uint8_t>& payload, uint16_t* samples) const
+{
+    const auto num_samples = header.sample_count;
+    if (num_samples != m_num_samples)
+    {
+        return false;
+    }
+
+    if (header.flags & FrameDatagram::flag_delta_rice)
+    {
+        if ((header.num_lanes == 0) || (header.chirp_stride < header.num_lanes) || (num_samples % header.chirp_stride != 0))
+        {
+            return false;
+        }
+        return FrameCodec::rice_decode(payload.data(), payload.size(), num_samples, header.chirp_stride, header.num_lanes, samples);
+    }
+
+    if (header.sample_format == FrameDatagram::sample_format_packed12)
+    {
+        if (payload.size() < FrameCodec::packed12_size(num_samples))
+        {
+            return false;
+        }
+        FrameCodec::unpack12(payload.data(), num_samples, samples);
+        return true;
+    }
+
+    if ((header.sample_format == FrameDatagram::sample_format_u16le) && (payload.size() >= num_samples * sizeof(uint16_t)))
+    {
+        for (uint32_t i = 0; i < num_samples; i++)
+        {
+            samples[i] = static_cast<uint16_t>(payload[2 * i] | (payload[2 * i + 1] << 8));
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+std::unique_ptr<DeviceFmcwSubscriber> DeviceFmcwSubscriber::create(const char* address, uint16_t port, uint16_t timeout_ms)
+{
+    ipAddress_t group = {0, 0, 0, 0};
+    if ((address && !FrameDatagram::parse_address(address, group)) || (port == 0))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    auto socket = std::make_unique<SocketUdp>();
+    try
+    {
+        socket->open(port, 0, nullptr, 1000);
+        socket->setInputBufferSize(input_buffer_size);
+        if (FrameDatagram::is_multicast(group))
+        {
+            socket->joinMulticastGroup(group);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        (void)e;
+        IFX_LOG_ERROR("DeviceFmcwSubscriber - opening the socket failed, \"%s\"", e.what());
+        throw rdk::exception::not_possible();
+    }
+
+    // the configuration is needed to set up the device
+    std::vector<uint8_t> datagram(max_datagram_size);
+    FrameDatagram::Reassembler configurations;
+    FrameDatagram::Header header;
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+
+    while (const auto size = receive_datagram(*socket, datagram, header, deadline))
+    {
+        if ((header.type != FrameDatagram::message_configuration)
+            || !configurations.add(header, datagram.data() + FrameDatagram::header_size, size - FrameDatagram::header_size))
+        {
+            continue;
+        }
+
+        FrameDatagram::Configuration configuration;
+        if (FrameDatagram::decode_configuration(configurations.payload(), configuration))
+        {
+            return std::make_unique<DeviceFmcwSubscriber>(std::move(socket), configuration);
+        }
+    }
+
+    throw rdk::exception::timeout();
+}
+
+void DeviceFmcwSubscriber::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+{
+    DeviceFmcwAvian::set_acquisition_sequence(sequence);
+    check_publisher_registers();
+}
+
+void DeviceFmcwSubscriber::apply_register_list(const std::map<uint16_t, uint32_t>& register_list)
+{
+    DeviceFmcwAvian::apply_register_list(register_list);
+    check_publisher_registers();
+}
+
+void DeviceFmcwSubscriber::start_acquisition()
+{
+    if (m_started)
+    {
+        return;
+    }
+
+    // like hardware, the first frame is one sent after the start
+    while (m_socket->dumpPacket())
+    {
+    }
+    m_frames = FrameDatagram::Reassembler();
+    m_frame_index_valid = false;
+    m_started = true;
+}
+
+void DeviceFmcwSubscriber::stop_acquisition()
+{
+    m_started = false;
+}
+
+uint32_t DeviceFmcwSubscriber::get_slice_size()
+{
+    // the publisher sends whole frames, regardless of the acquisition policy
+    update_defaults_if_not_configured();
+    return m_num_samples;
+}
+
+bool DeviceFmcwSubscriber::try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    if (frame == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    start_acquisition();
+
+    const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+    FrameDatagram::Header header;
+
+    while (const auto size = receive_datagram(*m_socket, m_datagram, header, deadline))
+    {
+        m_statistics.count_datagram(size);
+
+        const auto* fragment = m_datagram.data() + FrameDatagram::header_size;
+        const auto fragment_size = size - FrameDatagram::header_size;
+
+        if (header.type == FrameDatagram::message_configuration)
+        {
+            if (m_configurations.add(header, fragment, fragment_size))
+            {
+                update_configuration(m_configurations.payload());
+            }
+            continue;
+        }
+
+        if ((header.type != FrameDatagram::message_frame) || !m_frames.add(header, fragment, fragment_size))
+        {
+            continue;
+        }
+
+        const auto& message = m_frames.header();
+        if (message.config_hash != m_config_hash)
+        {
+            continue;
+        }
+
+        // frames lost on the network or incomplete leave a gap in the indices
+        if (m_frame_index_valid && (message.message_index != m_next_frame_index))
+        {
+            m_statistics.frames_dropped.fetch_add(message.message_index - m_next_frame_index, std::memory_order_relaxed);
+        }
+        m_next_frame_index = message.message_index + 1;
+        m_frame_index_valid = true;
+
+        // the configuration may have changed with this frame
+        update_defaults_if_not_configured();
+        if (frame->num_samples != m_num_samples)
+        {
+            throw rdk::exception::dimension_mismatch();
+        }
+
+        if (!decode_frame(message, m_frames.payload(), frame->samples))
+        {
+            m_statistics.frames_dropped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        const auto now_us = epoch_time_us();
+        const auto latency_us = (now_us > message.timestamp_sent_us) ? (now_us - message.timestamp_sent_us) : 0;
+        m_statistics.count_frame(m_num_samples, latency_us * 1000);
+
+        m_frame_device_us = message.timestamp_device_us;
+        m_frame_received_us = message.timestamp_received_us;
+        stamp_frame(frame);
+        return true;
+    }
+
+    return false;
+}
+
+void DeviceFmcwSubscriber::get_statistics(ifx_Fmcw_Network_Statistics_t* statistics) const
+{
+    if (!statistics)
+    {
+        throw rdk::exception::argument_null();
+    }
+    m_statistics.read(statistics);
+}
+
+bool DeviceFmcwSubscriber::get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms)
+{
+    update_defaults_if_not_configured();
+    m_samples.resize(m_num_samples);
+    ifx_Fmcw_Raw_Frame_t frame = {m_num_samples, m_samples.data(), 0, 0, 0};
+    if (!try_get_next_raw_frame(&frame, timeout_ms))
+    {
+        return false;
+    }
+    convert_raw_data_to_float_array(m_num_samples, m_samples.data(), samples);
+    return true;
+}
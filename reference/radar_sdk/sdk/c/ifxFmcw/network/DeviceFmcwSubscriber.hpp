@@ -0,0 +1,95 @@
+/**
+ * @internal
+ * @file DeviceFmcwSubscriber.hpp
+ *
+ * @brief Defines an FMCW device that receives the frames of a network
+ *        publisher.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../avian/DeviceFmcwAvian.hpp"
+#include "FrameDatagram.hpp"
+#include "NetworkStatistics.hpp"
+
+#include <platform/ethernet/SocketUdp.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Subscriber of the frames of a publisher (see DeviceFmcwNetwork.h).
+ *
+ * Like DeviceFmcwShared, configuration, sequence and metrics come from a
+ * dummy Avian device set up with the register list of the publisher, and
+ * the configuration is owned by the publisher: setting a sequence or
+ * register list is only accepted if it results in its registers. When the
+ * publisher changes its configuration, the new one is applied as soon as it
+ * is received; frames of another configuration are skipped.
+ *
+ * Starting the acquisition discards the datagrams received meanwhile, so
+ * the first frame is one sent after the start.
+ */
+struct DeviceFmcwSubscriber : public DeviceFmcwAvian
+{
+    using Clock = std::chrono::steady_clock;
+
+    /* Opens the socket and waits for the configuration of the publisher. */
+    static std::unique_ptr<DeviceFmcwSubscriber> create(const char* address, uint16_t port, uint16_t timeout_ms);
+
+    DeviceFmcwSubscriber(std::unique_ptr<SocketUdp> socket, const FrameDatagram::Configuration& configuration);
+
+    DeviceFmcwSubscriber(const DeviceFmcwSubscriber&) = delete;
+    DeviceFmcwSubscriber& operator=(const DeviceFmcwSubscriber&) = delete;
+
+    ~DeviceFmcwSubscriber() override = default;
+
+    void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) override;
+    void apply_register_list(const std::map<uint16_t, uint32_t>& register_list) override;
+
+    void stop_acquisition() override;
+    void start_acquisition() override;
+    uint32_t get_slice_size() override;
+
+    bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+
+    void get_statistics(ifx_Fmcw_Network_Statistics_t* statistics) const;
+
+protected:
+    bool get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms) override;
+
+private:
+    void check_publisher_registers();
+    void update_configuration(const std::vector<uint8_t>& payload);
+    bool decode_frame(const FrameDatagram::Header& header, const std::vector<uint8_t>& payload, uint16_t* samples) const;
+
+    std::unique_ptr<SocketUdp> m_socket;
+    std::vector<uint8_t> m_datagram;
+    FrameDatagram::Reassembler m_frames;
+    FrameDatagram::Reassembler m_configurations;
+
+    uint32_t m_sensor_type;
+    uint32_t m_config_hash;
+    std::map<uint16_t, uint32_t> m_publisher_registers;
+
+    bool m_frame_index_valid = false;
+    uint32_t m_next_frame_index = 0;
+
+    NetworkStatistics m_statistics;
+    std::vector<uint16_t> m_samples;  // raw frame read by get_next_normalized_frame
+
+    bool m_started = false;
+};
@@ -0,0 +1,297 @@
+/**
+ * @internal
+ * @file FrameCodec.cpp
+ *
+ * @brief Implements the encodings of raw frames sent over the network.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "FrameCodec.hpp"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// Parameters of the firmware's src/rice_codec.h bitstream
+constexpr uint32_t rice_k_bits = 4;
+constexpr uint32_t rice_escape = 24;
+constexpr uint32_t rice_raw_bits = 13;
+constexpr int32_t rice_midscale = 2048;
+
+class BitWriter
+{
+public:
+    BitWriter(uint8_t* out, size_t capacity) :
+        m_out(out),
+        m_capacity(capacity)
+    {}
+
+    // bits <= 24 keeps the accumulator within 32 bits (at most 7 bits are pending)
+    void put(uint32_t value, uint32_t bits)
+    {
+        m_acc = (m_acc << bits) | (value & ((1u << bits) - 1u));
+        m_acc_bits += bits;
+
+        while (m_acc_bits >= 8)
+        {
+            m_acc_bits -= 8;
+            if (m_pos >= m_capacity)
+            {
+                m_overflow = true;
+                return;
+            }
+            m_out[m_pos++] = static_cast<uint8_t>(m_acc >> m_acc_bits);
+        }
+    }
+
+    void put_ones(uint32_t count)
+    {
+        while (count > 16)
+        {
+            put(0xFFFF, 16);
+            count -= 16;
+        }
+        put((1u << count) - 1u, count);
+    }
+
+    size_t finish()
+    {
+        if (m_acc_bits > 0)
+        {
+            put(0, 8 - m_acc_bits);
+        }
+        return m_overflow ? 0 : m_pos;
+    }
+
+    bool overflow() const
+    {
+        return m_overflow;
+    }
+
+private:
+    uint8_t* m_out;
+    size_t m_capacity;
+    size_t m_pos = 0;
+    uint32_t m_acc = 0;
+    uint32_t m_acc_bits = 0;
+    bool m_overflow = false;
+};
+
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, size_t size) :
+        m_data(data),
+        m_bits(size * 8)
+    {}
+
+    bool get(uint32_t bits, uint32_t& value)
+    {
+        if (m_pos + bits > m_bits)
+        {
+            return false;
+        }
+
+        value = 0;
+        for (uint32_t i = 0; i < bits; i++, m_pos++)
+        {
+            value = (value << 1) | ((m_data[m_pos >> 3] >> (7 - (m_pos & 7))) & 1u);
+        }
+        return true;
+    }
+
+    // Counts the ones before the next zero, which is consumed, up to limit ones.
+    bool get_unary(uint32_t limit, uint32_t& count)
+    {
+        for (count = 0; count < limit; count++, m_pos++)
+        {
+            if (m_pos >= m_bits)
+            {
+                return false;
+            }
+            if (((m_data[m_pos >> 3] >> (7 - (m_pos & 7))) & 1u) == 0)
+            {
+                m_pos++;
+                return true;
+            }
+        }
+        return true;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_bits;
+    size_t m_pos = 0;
+};
+
+inline int32_t predict(const uint16_t* samples, uint32_t i, uint32_t chirp_stride, uint32_t num_lanes)
+{
+    if (i >= chirp_stride)
+    {
+        return samples[i - chirp_stride];
+    }
+    if (i >= num_lanes)
+    {
+        return samples[i - num_lanes];
+    }
+    return rice_midscale;
+}
+
+inline uint32_t zigzag(int32_t residual)
+{
+    return (residual >= 0) ? (static_cast<uint32_t>(residual) << 1) : ((static_cast<uint32_t>(-residual) << 1) - 1);
+}
+
+inline int32_t unzigzag(uint32_t value)
+{
+    return (value & 1) ? -static_cast<int32_t>((value + 1) >> 1) : static_cast<int32_t>(value >> 1);
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+size_t FrameCodec::packed12_size(uint32_t num_samples)
+{
+    return (static_cast<size_t>(num_samples) + 1) / 2 * 3;
+}
+
+//----------------------------------------------------------------------------
+
+void FrameCodec::pack12(const uint16_t* samples, uint32_t num_samples, uint8_t* out)
+{
+    for (uint32_t i = 0; i < num_samples; i += 2, out += 3)
+    {
+        const uint16_t first = samples[i] & 0x0FFF;
+        const uint16_t second = (i + 1 < num_samples) ? (samples[i + 1] & 0x0FFF) : 0;
+        out[0] = static_cast<uint8_t>(first >> 4);
+        out[1] = static_cast<uint8_t>(((first & 0x0F) << 4) | (second >> 8));
+        out[2] = static_cast<uint8_t>(second);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void FrameCodec::unpack12(const uint8_t* data, uint32_t num_samples, uint16_t* samples)
+{
+    for (uint32_t i = 0; i < num_samples; i += 2, data += 3)
+    {
+        samples[i] = static_cast<uint16_t>((data[0] << 4) | (data[1] >> 4));
+        if (i + 1 < num_samples)
+        {
+            samples[i + 1] = static_cast<uint16_t>(((data[1] & 0x0F) << 8) | data[2]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+size_t FrameCodec::rice_encode(const uint16_t* samples, uint32_t num_samples, uint32_t chirp_stride, uint32_t num_lanes,
+                               uint8_t* out, size_t capacity)
+{
+    BitWriter writer(out, capacity);
+
+    for (uint32_t first = 0; (first < num_samples) && !writer.overflow(); first += chirp_stride)
+    {
+        const uint32_t last = first + chirp_stride;
+
+        uint64_t sum = 0;
+        for (uint32_t i = first; i < last; i++)
+        {
+            sum += zigzag(samples[i] - predict(samples, i, chirp_stride, num_lanes));
+        }
+
+        // smallest k with 2^k * count >= sum, i.e. k ~ log2(mean)
+        uint32_t k = 0;
+        while ((k < (1u << rice_k_bits) - 1) && ((static_cast<uint64_t>(chirp_stride) << k) < sum))
+        {
+            k++;
+        }
+
+        writer.put(k, rice_k_bits);
+
+        for (uint32_t i = first; (i < last) && !writer.overflow(); i++)
+        {
+            const uint32_t value = zigzag(samples[i] - predict(samples, i, chirp_stride, num_lanes));
+            const uint32_t quotient = value >> k;
+
+            if (quotient < rice_escape)
+            {
+                writer.put_ones(quotient);
+                writer.put(0, 1);
+                writer.put(value, k);
+            }
+            else if (value < (1u << rice_raw_bits))
+            {
+                writer.put_ones(rice_escape);
+                writer.put(value, rice_raw_bits);
+            }
+            else
+            {
+                // more than 12 bit samples cannot be coded
+                return 0;
+            }
+        }
+    }
+
+    return writer.finish();
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameCodec::rice_decode(const uint8_t* data, size_t size, uint32_t num_samples, uint32_t chirp_stride, uint32_t num_lanes,
+                             uint16_t* samples)
+{
+    BitReader reader(data, size);
+
+    for (uint32_t first = 0; first < num_samples; first += chirp_stride)
+    {
+        uint32_t k;
+        if (!reader.get(rice_k_bits, k))
+        {
+            return false;
+        }
+
+        const uint32_t last = first + chirp_stride;
+        for (uint32_t i = first; i < last; i++)
+        {
+            uint32_t quotient;
+            uint32_t value;
+            if (!reader.get_unary(rice_escape, quotient))
+            {
+                return false;
+            }
+
+            if (quotient < rice_escape)
+            {
+                uint32_t remainder;
+                if (!reader.get(k, remainder))
+                {
+                    return false;
+                }
+                value = (quotient << k) | remainder;
+            }
+            else if (!reader.get(rice_raw_bits, value))
+            {
+                return false;
+            }
+
+            samples[i] = static_cast<uint16_t>(predict(samples, i, chirp_stride, num_lanes) + unzigzag(value));
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,55 @@
+/**
+ * @internal
+ * @file FrameCodec.hpp
+ *
+ * @brief Declares the encodings of raw frames sent over the network.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Sample encodings shared with the RADR frame stream of the PSoC 6 firmware:
+ * - Packed12: two 12-bit samples in three bytes (strata Packed12 layout).
+ * - Delta-Rice: the bitstream of the firmware's src/rice_codec.h. Every
+ *   sample is predicted by the same sample of the previous chirp (in the
+ *   first chirp by the previous sample of the same antenna), the residuals
+ *   are Rice coded with one parameter per chirp. It only applies to samples
+ *   of at most 12 bits.
+ */
+namespace FrameCodec {
+
+// Worst case size of the Packed12 encoding of num_samples samples
+size_t packed12_size(uint32_t num_samples);
+
+void pack12(const uint16_t* samples, uint32_t num_samples, uint8_t* out);
+
+void unpack12(const uint8_t* data, uint32_t num_samples, uint16_t* samples);
+
+/* Encodes num_samples samples made of chirps of chirp_stride interleaved
+ * values of num_lanes antennas, num_samples must be a multiple of
+ * chirp_stride. Returns the number of bytes written or 0 if they would not
+ * fit into capacity or a sample has more than 12 bits.
+ */
+size_t rice_encode(const uint16_t* samples, uint32_t num_samples, uint32_t chirp_stride, uint32_t num_lanes,
+                   uint8_t* out, size_t capacity);
+
+/* Decodes num_samples samples, returns false if size bytes do not hold them. */
+bool rice_decode(const uint8_t* data, size_t size, uint32_t num_samples, uint32_t chirp_stride, uint32_t num_lanes,
+                 uint16_t* samples);
+
+}  // namespace FrameCodec
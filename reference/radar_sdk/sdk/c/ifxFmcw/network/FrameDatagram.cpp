@@ -0,0 +1,256 @@
+/**
+ * @internal
+ * @file FrameDatagram.cpp
+ *
+ * @brief Implements the datagrams of frames and configurations.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "FrameDatagram.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+constexpr char magic[4] = {'R', 'N', 'E', 'T'};
+constexpr uint16_t version = 1;
+
+// Upper limit for the payload of a message, protects against corrupt headers
+constexpr uint32_t max_payload_size = 64 * 1024 * 1024;
+
+void put_u16(uint8_t* p, uint16_t value)
+{
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void put_u32(uint8_t* p, uint32_t value)
+{
+    put_u16(p, static_cast<uint16_t>(value));
+    put_u16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+void put_u64(uint8_t* p, uint64_t value)
+{
+    put_u32(p, static_cast<uint32_t>(value));
+    put_u32(p + 4, static_cast<uint32_t>(value >> 32));
+}
+
+uint16_t get_u16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(get_u16(p)) | (static_cast<uint32_t>(get_u16(p + 2)) << 16);
+}
+
+uint64_t get_u64(const uint8_t* p)
+{
+    return static_cast<uint64_t>(get_u32(p)) | (static_cast<uint64_t>(get_u32(p + 4)) << 32);
+}
+
+void fnv1a(uint32_t& hash, uint32_t value)
+{
+    for (int i = 0; i < 4; i++, value >>= 8)
+    {
+        hash = (hash ^ (value & 0xFF)) * 16777619u;
+    }
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+bool FrameDatagram::parse_address(const char* text, uint8_t address[4])
+{
+    unsigned int part[4];
+    char tail;
+    if ((text == nullptr) || (std::sscanf(text, "%u.%u.%u.%u%c", &part[0], &part[1], &part[2], &part[3], &tail) != 4))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (part[i] > 255)
+        {
+            return false;
+        }
+        address[i] = static_cast<uint8_t>(part[i]);
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameDatagram::is_multicast(const uint8_t address[4])
+{
+    return (address[0] >= 224) && (address[0] <= 239);
+}
+
+//----------------------------------------------------------------------------
+
+void FrameDatagram::write_header(const Header& header, uint8_t* out)
+{
+    std::memcpy(out, magic, sizeof(magic));
+    put_u16(out + 4, version);
+    put_u16(out + 6, header.type);
+    put_u32(out + 8, header.config_hash);
+    put_u32(out + 12, header.message_index);
+    put_u32(out + 16, header.sample_count);
+    put_u16(out + 20, header.sample_format);
+    put_u16(out + 22, header.flags);
+    put_u32(out + 24, header.payload_size);
+    put_u32(out + 28, header.fragment_offset);
+    put_u16(out + 32, header.fragment_size);
+    put_u16(out + 34, header.num_lanes);
+    put_u32(out + 36, header.chirp_stride);
+    put_u64(out + 40, header.timestamp_device_us);
+    put_u64(out + 48, header.timestamp_received_us);
+    put_u64(out + 56, header.timestamp_sent_us);
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameDatagram::parse_header(const uint8_t* data, size_t size, Header& header)
+{
+    if ((size < header_size) || (std::memcmp(data, magic, sizeof(magic)) != 0) || (get_u16(data + 4) != version))
+    {
+        return false;
+    }
+
+    header.type = get_u16(data + 6);
+    header.config_hash = get_u32(data + 8);
+    header.message_index = get_u32(data + 12);
+    header.sample_count = get_u32(data + 16);
+    header.sample_format = get_u16(data + 20);
+    header.flags = get_u16(data + 22);
+    header.payload_size = get_u32(data + 24);
+    header.fragment_offset = get_u32(data + 28);
+    header.fragment_size = get_u16(data + 32);
+    header.num_lanes = get_u16(data + 34);
+    header.chirp_stride = get_u32(data + 36);
+    header.timestamp_device_us = get_u64(data + 40);
+    header.timestamp_received_us = get_u64(data + 48);
+    header.timestamp_sent_us = get_u64(data + 56);
+
+    const auto fragment_length = size - header_size;
+    return (header.payload_size <= max_payload_size) && (header.fragment_size != 0)
+           && (header.fragment_offset % header.fragment_size == 0)
+           && (header.fragment_offset + fragment_length <= header.payload_size)
+           && (fragment_length == std::min<size_t>(header.fragment_size, header.payload_size - header.fragment_offset));
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t FrameDatagram::configuration_hash(uint32_t sensor_type, const std::map<uint16_t, uint32_t>& registers)
+{
+    uint32_t hash = 2166136261u;
+    fnv1a(hash, sensor_type);
+    for (const auto& entry : registers)
+    {
+        fnv1a(hash, entry.first);
+        fnv1a(hash, entry.second);
+    }
+    return hash;
+}
+
+//----------------------------------------------------------------------------
+
+std::vector<uint8_t> FrameDatagram::encode_configuration(const Configuration& configuration)
+{
+    std::vector<uint8_t> payload(12 + 8 * configuration.registers.size());
+    put_u32(&payload[0], configuration.sensor_type);
+    put_u32(&payload[4], configuration.num_samples);
+    put_u32(&payload[8], static_cast<uint32_t>(configuration.registers.size()));
+
+    auto* out = &payload[12];
+    for (const auto& entry : configuration.registers)
+    {
+        put_u32(out, entry.first);
+        put_u32(out + 4, entry.second);
+        out += 8;
+    }
+    return payload;
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameDatagram::decode_configuration(const std::vector<uint8_t>& payload, Configuration& configuration)
+{
+    if (payload.size() < 12)
+    {
+        return false;
+    }
+
+    const auto num_registers = get_u32(&payload[8]);
+    if (payload.size() != 12 + 8 * static_cast<size_t>(num_registers))
+    {
+        return false;
+    }
+
+    configuration.sensor_type = get_u32(&payload[0]);
+    configuration.num_samples = get_u32(&payload[4]);
+    configuration.registers.clear();
+    for (uint32_t i = 0; i < num_registers; i++)
+    {
+        const auto* entry = &payload[12 + 8 * i];
+        configuration.registers.emplace(static_cast<uint16_t>(get_u32(entry)), get_u32(entry + 4));
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+bool FrameDatagram::Reassembler::add(const Header& header, const uint8_t* data, size_t size)
+{
+    if (!m_active || (header.message_index != m_header.message_index) || (header.payload_size != m_header.payload_size)
+        || (header.fragment_size != m_header.fragment_size))
+    {
+        if (m_active)
+        {
+            m_incomplete++;
+        }
+
+        const uint32_t num_fragments = (header.payload_size + header.fragment_size - 1) / header.fragment_size;
+        m_header = header;
+        m_payload.resize(header.payload_size);
+        m_received.assign(num_fragments, false);
+        m_missing = num_fragments;
+        m_active = true;
+    }
+
+    const auto fragment = header.fragment_offset / header.fragment_size;
+    if ((m_missing > 0) && !m_received[fragment])
+    {
+        std::memcpy(m_payload.data() + header.fragment_offset, data, size);
+        m_received[fragment] = true;
+        m_missing--;
+    }
+
+    if (m_missing == 0)
+    {
+        m_active = false;
+        return true;
+    }
+    return false;
+}
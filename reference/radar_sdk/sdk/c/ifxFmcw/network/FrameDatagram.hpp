@@ -0,0 +1,142 @@
+/**
+ * @internal
+ * @file FrameDatagram.hpp
+ *
+ * @brief Declares the datagrams in which frames and configurations are sent
+ *        over the network.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * A frame (or configuration) is sent as a message split into fragments of
+ * equal size, one per UDP datagram. Every datagram starts with a header of
+ * header_size bytes, all fields little endian:
+ *
+ *   0  "RNET"        magic
+ *   4  u16 version   1
+ *   6  u16 type      message_frame or message_configuration
+ *   8  u32           hash of the configuration the frame was acquired with
+ *  12  u32           index of the message, counting frames and configurations separately
+ *  16  u32           number of samples of the frame
+ *  20  u16           sample format, as in the RADR stream: 0 uint16, 1 Packed12
+ *  22  u16           flags, flag_delta_rice as in the RADR stream
+ *  24  u32           size of the whole message payload
+ *  28  u32           offset of this fragment in the payload
+ *  32  u16           size of the fragments except the last one
+ *  34  u16           interleaved antennas of the delta-Rice coding
+ *  36  u32           values per chirp of the delta-Rice coding
+ *  40  u64           device timestamp of the frame in us since the epoch
+ *  48  u64           host timestamp when the frame was received from the device
+ *  56  u64           host timestamp when the message was sent
+ *
+ * A configuration holds the sensor type (u32), the number of samples per
+ * frame (u32), the number of registers (u32) and the registers as pairs of
+ * address (u32) and value (u32).
+ */
+namespace FrameDatagram {
+
+constexpr size_t header_size = 64;
+
+constexpr uint16_t message_frame = 0;
+constexpr uint16_t message_configuration = 1;
+
+constexpr uint16_t sample_format_u16le = 0;
+constexpr uint16_t sample_format_packed12 = 1;
+constexpr uint16_t flag_delta_rice = 0x0001;
+
+struct Header
+{
+    uint16_t type;
+    uint32_t config_hash;
+    uint32_t message_index;
+    uint32_t sample_count;
+    uint16_t sample_format;
+    uint16_t flags;
+    uint32_t payload_size;
+    uint32_t fragment_offset;
+    uint16_t fragment_size;
+    uint16_t num_lanes;
+    uint32_t chirp_stride;
+    uint64_t timestamp_device_us;
+    uint64_t timestamp_received_us;
+    uint64_t timestamp_sent_us;
+};
+
+// Parses an IPv4 address in dotted notation, returns false if it is none.
+bool parse_address(const char* text, uint8_t address[4]);
+
+bool is_multicast(const uint8_t address[4]);
+
+void write_header(const Header& header, uint8_t* out);
+
+// Returns false if the datagram is no valid fragment.
+bool parse_header(const uint8_t* data, size_t size, Header& header);
+
+struct Configuration
+{
+    uint32_t sensor_type;
+    uint32_t num_samples;
+    std::map<uint16_t, uint32_t> registers;
+};
+
+uint32_t configuration_hash(uint32_t sensor_type, const std::map<uint16_t, uint32_t>& registers);
+
+std::vector<uint8_t> encode_configuration(const Configuration& configuration);
+
+bool decode_configuration(const std::vector<uint8_t>& payload, Configuration& configuration);
+
+/**
+ * Collects the fragments of the message being received. A fragment of
+ * another message drops the incomplete one; datagrams of one message are
+ * expected in order, with UDP they rarely arrive otherwise.
+ */
+class Reassembler
+{
+public:
+    /* Adds a fragment, returns true when it completed its message. */
+    bool add(const Header& header, const uint8_t* data, size_t size);
+
+    const Header& header() const
+    {
+        return m_header;
+    }
+
+    const std::vector<uint8_t>& payload() const
+    {
+        return m_payload;
+    }
+
+    /* Messages dropped because fragments were missing */
+    uint64_t get_incomplete() const
+    {
+        return m_incomplete;
+    }
+
+private:
+    Header m_header = {};
+    bool m_active = false;
+    std::vector<uint8_t> m_payload;
+    std::vector<bool> m_received;
+    uint32_t m_missing = 0;
+    uint64_t m_incomplete = 0;
+};
+
+}  // namespace FrameDatagram
@@ -0,0 +1,83 @@
+/**
+ * @internal
+ * @file NetworkStatistics.hpp
+ *
+ * @brief Counters of network publishers and subscribers.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxFmcw/DeviceFmcwNetwork.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Counters of ifx_Fmcw_Network_Statistics_t, updated by the thread sending or
+ * receiving the frames and read by any thread. Latencies are kept in
+ * nanoseconds.
+ */
+struct NetworkStatistics
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<uint64_t> num_frames {0};
+    std::atomic<uint64_t> frames_dropped {0};
+    std::atomic<uint64_t> num_datagrams {0};
+    std::atomic<uint64_t> raw_bytes {0};
+    std::atomic<uint64_t> network_bytes {0};
+    std::atomic<uint64_t> latency_sum {0};
+    std::atomic<uint64_t> latency_max {0};
+    std::atomic<int64_t> first_frame {0};  // Clock time of the first frame in ns, 0 before it
+
+    void count_datagram(size_t size)
+    {
+        num_datagrams.fetch_add(1, std::memory_order_relaxed);
+        network_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void count_frame(uint32_t num_samples, uint64_t latency_ns)
+    {
+        int64_t expected = 0;
+        first_frame.compare_exchange_strong(expected, Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+
+        num_frames.fetch_add(1, std::memory_order_relaxed);
+        raw_bytes.fetch_add(num_samples * sizeof(uint16_t), std::memory_order_relaxed);
+        latency_sum.fetch_add(latency_ns, std::memory_order_relaxed);
+        if (latency_ns > latency_max.load(std::memory_order_relaxed))
+        {
+            latency_max.store(latency_ns, std::memory_order_relaxed);
+        }
+    }
+
+    void read(ifx_Fmcw_Network_Statistics_t* statistics) const
+    {
+        const auto frames = num_frames.load(std::memory_order_relaxed);
+        const auto network = network_bytes.load(std::memory_order_relaxed);
+        const auto first = first_frame.load(std::memory_order_relaxed);
+        const auto elapsed_ns = first ? (Clock::now().time_since_epoch().count() - first) : 0;
+
+        statistics->num_frames = frames;
+        statistics->frames_dropped = frames_dropped.load(std::memory_order_relaxed);
+        statistics->num_datagrams = num_datagrams.load(std::memory_order_relaxed);
+        statistics->raw_bytes = raw_bytes.load(std::memory_order_relaxed);
+        statistics->network_bytes = network;
+        statistics->bandwidth_bytes_s = (elapsed_ns > 0) ? static_cast<float>(network * 1e9 / elapsed_ns) : 0.f;
+        statistics->compression_ratio = network ? static_cast<float>(statistics->raw_bytes) / static_cast<float>(network) : 0.f;
+        statistics->latency_mean_s = frames ? static_cast<float>(latency_sum.load(std::memory_order_relaxed) * 1e-9 / frames) : 0.f;
+        statistics->latency_max_s = static_cast<float>(latency_max.load(std::memory_order_relaxed) * 1e-9);
+    }
+};
@@ -0,0 +1,404 @@
+/**
+ * @internal
+ * @file DeviceFmcwPlayback.cpp
+ *
+ * @brief Implements the playback of recorded RADR captures as FMCW device.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwPlayback.hpp"
+#include "ifxBase/Exception.hpp"
+
+#include <cstring>
+#include <thread>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+// Frame stream of the PSoC 6 firmware (binary_frame_header_t in src/main.c)
+constexpr char frame_magic[4] = {'R', 'A', 'D', 'R'};
+constexpr size_t frame_header_v1_size = 16;
+constexpr size_t frame_header_max_size = 42;
+constexpr uint16_t sample_format_u16le = 0;
+constexpr uint16_t sample_format_packed12 = 1;
+constexpr uint16_t flag_delta_rice = 0x0001;
+
+// Indexed container of data_test/radr_capture/radr_file.h
+constexpr char container_magic[4] = {'R', 'C', 'A', 'P'};
+constexpr size_t container_header_size = 64;
+constexpr size_t container_entry_size = 32;
+
+uint16_t get_u16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get_u32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+           | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t get_u64(const uint8_t* p)
+{
+    return static_cast<uint64_t>(get_u32(p)) | (static_cast<uint64_t>(get_u32(p + 4)) << 32);
+}
+
+size_t header_size(uint16_t version)
+{
+    switch (version)
+    {
+        case 1:
+            return 16;
+        case 2:
+            return 24;
+        case 3:
+            return 32;
+        case 4:
+            return 42;
+        default:
+            return 0;
+    }
+}
+
+uint64_t payload_size(const uint8_t* header)
+{
+    if (get_u16(header + 4) >= 2)
+    {
+        return get_u32(header + 20);
+    }
+    return static_cast<uint64_t>(get_u16(header + 6)) * get_u32(header + 12);
+}
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwPlayback::DeviceFmcwPlayback(ifx_Radar_Sensor_t device_type, const char* filename,
+                                       ifx_Fmcw_Playback_Mode_t mode, bool loop) :
+    DeviceFmcwAvian(device_type),
+    m_mode(mode),
+    m_loop(loop)
+{
+    if (filename == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    m_file.open(filename, std::ios::binary);
+    if (!m_file)
+    {
+        throw rdk::exception::opening_file();
+    }
+
+    char magic[4] = {};
+    m_file.read(magic, sizeof(magic));
+    m_file.clear();
+    m_file.seekg(0);
+
+    if (std::memcmp(magic, container_magic, sizeof(magic)) == 0)
+    {
+        index_container();
+    }
+    else
+    {
+        index_raw_stream();
+    }
+
+    if (m_records.empty())
+    {
+        throw rdk::exception::file_invalid();
+    }
+}
+
+size_t DeviceFmcwPlayback::read_header(uint64_t offset, uint8_t* header)
+{
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(offset));
+    if (!m_file.read(reinterpret_cast<char*>(header), frame_header_v1_size))
+    {
+        return 0;
+    }
+
+    const auto size = header_size(get_u16(header + 4));
+    if ((std::memcmp(header, frame_magic, sizeof(frame_magic)) != 0) || (size == 0))
+    {
+        throw rdk::exception::file_invalid();
+    }
+
+    if (!m_file.read(reinterpret_cast<char*>(header + frame_header_v1_size),
+                     static_cast<std::streamsize>(size - frame_header_v1_size)))
+    {
+        return 0;
+    }
+
+    return size;
+}
+
+void DeviceFmcwPlayback::add_record(const uint8_t* header, uint64_t payload_offset)
+{
+    const auto version = get_u16(header + 4);
+
+    Record record = {};
+    record.payload_offset = payload_offset;
+    record.sample_count = get_u32(header + 12);
+    record.payload_size = static_cast<uint32_t>(payload_size(header));
+    record.sample_format = (version >= 2) ? get_u16(header + 16) : sample_format_u16le;
+    record.has_timestamp = (version >= 3);
+    record.timestamp_us = (version >= 3) ? get_u32(header + 24) : 0;
+
+    // Only time-domain frames can be replayed; range profiles, presence
+    // events and control responses are skipped.
+    if ((record.sample_format != sample_format_u16le) && (record.sample_format != sample_format_packed12))
+    {
+        return;
+    }
+
+    // Compressed captures have to be decoded on the host first
+    // (data_test/format_binary_frames.py).
+    if ((version >= 2) && (get_u16(header + 18) & flag_delta_rice))
+    {
+        throw rdk::exception::not_supported();
+    }
+
+    m_records.push_back(record);
+}
+
+void DeviceFmcwPlayback::index_raw_stream()
+{
+    m_file.seekg(0, std::ios::end);
+    const auto file_size = static_cast<uint64_t>(m_file.tellg());
+    uint64_t offset = 0;
+
+    while (offset < file_size)
+    {
+        uint8_t header[frame_header_max_size];
+        const auto size = read_header(offset, header);
+        if (size == 0)
+        {
+            // The recording was cut off inside the last header.
+            break;
+        }
+
+        const auto end = offset + size + payload_size(header);
+        if (end > file_size)
+        {
+            // The recording was cut off inside the last payload.
+            break;
+        }
+
+        add_record(header, offset + size);
+        offset = end;
+    }
+}
+
+void DeviceFmcwPlayback::index_container()
+{
+    uint8_t header[container_header_size];
+    if (!m_file.read(reinterpret_cast<char*>(header), sizeof(header))
+        || (get_u16(header + 4) != 1))
+    {
+        throw rdk::exception::file_invalid();
+    }
+
+    const auto index_offset = get_u64(header + 24);
+    const auto frame_count = get_u64(header + 32);
+    if (index_offset == 0)
+    {
+        // The recording was not finalised, see radr_index recover.
+        throw rdk::exception::file_invalid();
+    }
+
+    std::vector<uint8_t> index(static_cast<size_t>(frame_count) * container_entry_size);
+    m_file.seekg(static_cast<std::streamoff>(index_offset));
+    if (!m_file.read(reinterpret_cast<char*>(index.data()), static_cast<std::streamsize>(index.size())))
+    {
+        throw rdk::exception::file_invalid();
+    }
+
+    for (size_t i = 0; i < frame_count; i++)
+    {
+        uint8_t frame_header[frame_header_max_size];
+        const auto header_offset = get_u64(&index[i * container_entry_size]);
+        const auto size = read_header(header_offset, frame_header);
+
+        if (size == 0)
+        {
+            throw rdk::exception::file_invalid();
+        }
+
+        add_record(frame_header, header_offset + size);
+    }
+}
+
+std::chrono::microseconds DeviceFmcwPlayback::frame_interval(size_t record) const
+{
+    const auto next = record + 1;
+
+    if ((next < m_records.size()) && m_records[record].has_timestamp && m_records[next].has_timestamp)
+    {
+        // The firmware timestamp wraps at 2^32 us.
+        return std::chrono::microseconds(static_cast<uint32_t>(m_records[next].timestamp_us - m_records[record].timestamp_us));
+    }
+
+    return m_frame_period;
+}
+
+void DeviceFmcwPlayback::read_samples(const Record& record, uint16_t* samples)
+{
+    m_payload.resize(record.payload_size);
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(record.payload_offset));
+    if (!m_file.read(reinterpret_cast<char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size())))
+    {
+        throw rdk::exception::end_of_file();
+    }
+
+    const auto* data = m_payload.data();
+
+    if (record.sample_format == sample_format_packed12)
+    {
+        // Two 12-bit samples in three bytes (strata Packed12 layout)
+        if (record.payload_size != (record.sample_count + 1) / 2 * 3)
+        {
+            throw rdk::exception::file_invalid();
+        }
+
+        for (uint32_t i = 0; i < record.sample_count; i += 2, data += 3)
+        {
+            samples[i] = static_cast<uint16_t>((data[0] << 4) | (data[1] >> 4));
+            if (i + 1 < record.sample_count)
+            {
+                samples[i + 1] = static_cast<uint16_t>(((data[1] & 0x0F) << 8) | data[2]);
+            }
+        }
+        return;
+    }
+
+    if (record.payload_size != record.sample_count * sizeof(uint16_t))
+    {
+        throw rdk::exception::file_invalid();
+    }
+
+    for (uint32_t i = 0; i < record.sample_count; i++, data += 2)
+    {
+        samples[i] = get_u16(data);
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void DeviceFmcwPlayback::start_acquisition()
+{
+    if (m_started)
+    {
+        return;
+    }
+
+    // Recordings without timestamps are paced by the configured frame
+    // repetition time.
+    auto* sequence = get_acquisition_sequence();
+    if (sequence && (sequence->type == IFX_SEQ_LOOP))
+    {
+        m_frame_period = std::chrono::microseconds(static_cast<int64_t>(sequence->loop.repetition_time_s * 1e6f));
+    }
+    ifx_fmcw_destroy_sequence(sequence);
+
+    m_started = true;
+    m_due = std::chrono::steady_clock::now();
+}
+
+void DeviceFmcwPlayback::stop_acquisition()
+{
+    m_started = false;
+}
+
+uint32_t DeviceFmcwPlayback::get_slice_size()
+{
+    // every record holds one frame, regardless of the acquisition policy
+    update_defaults_if_not_configured();
+    return m_num_samples;
+}
+
+bool DeviceFmcwPlayback::try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    if (frame == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    update_defaults_if_not_configured();
+    if (frame->num_samples != m_num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    start_acquisition();
+
+    if (m_next == m_records.size())
+    {
+        if (!m_loop)
+        {
+            throw rdk::exception::end_of_file();
+        }
+        m_next = 0;
+    }
+
+    const auto& record = m_records[m_next];
+    if (record.sample_count != m_num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    if (m_mode == IFX_FMCW_PLAYBACK_REAL_TIME)
+    {
+        // Like hardware, give up if the frame is not due within the timeout.
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        if (m_due > deadline)
+        {
+            std::this_thread::sleep_until(deadline);
+            return false;
+        }
+        std::this_thread::sleep_until(m_due);
+        m_due += frame_interval(m_next);
+    }
+
+    read_samples(record, frame->samples);
+    m_next++;
+
+    // the recorded firmware timestamps are not epoch based, the frame is received when it is read
+    m_frame_device_us = 0;
+    m_frame_received_us = epoch_time_us();
+    stamp_frame(frame);
+    return true;
+}
+
+bool DeviceFmcwPlayback::get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms)
+{
+    m_samples.resize(m_num_samples);
+    ifx_Fmcw_Raw_Frame_t frame = {m_num_samples, m_samples.data(), 0, 0, 0};
+    if (!try_get_next_raw_frame(&frame, timeout_ms))
+    {
+        return false;
+    }
+    convert_raw_data_to_float_array(m_num_samples, m_samples.data(), samples);
+    return true;
+}
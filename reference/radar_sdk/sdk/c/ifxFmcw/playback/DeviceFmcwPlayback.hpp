@@ -0,0 +1,90 @@
+/**
+ * @internal
+ * @file DeviceFmcwPlayback.hpp
+ *
+ * @brief Defines an FMCW device that replays a recorded RADR capture.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../avian/DeviceFmcwAvian.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Plays back the frames of a capture written by the PSoC 6 firmware's binary
+ * stream (serial_logger.py or radr_capture output, raw or .rcap container).
+ *
+ * Configuration, sequence and metrics come from a dummy Avian device of the
+ * given sensor type, so the acquisition sequence must be set to the one the
+ * capture was recorded with; frames whose sample count differs from it
+ * raise a dimension mismatch. Frames are served by get_next_raw_frame() and
+ * get_next_frame() like from hardware, either paced by the recorded frame
+ * timestamps or as fast as they are fetched, optionally looping at the end
+ * of the file.
+ */
+struct DeviceFmcwPlayback : public DeviceFmcwAvian
+{
+    DeviceFmcwPlayback(ifx_Radar_Sensor_t device_type, const char* filename,
+                       ifx_Fmcw_Playback_Mode_t mode, bool loop);
+
+    DeviceFmcwPlayback(const DeviceFmcwPlayback&) = delete;
+    DeviceFmcwPlayback& operator=(const DeviceFmcwPlayback&) = delete;
+
+    ~DeviceFmcwPlayback() override = default;
+
+    void stop_acquisition() override;
+    void start_acquisition() override;
+    uint32_t get_slice_size() override;
+
+    bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+
+protected:
+    bool get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms) override;
+
+private:
+    struct Record
+    {
+        uint64_t payload_offset;
+        uint32_t payload_size;
+        uint32_t sample_count;
+        uint16_t sample_format;
+        bool has_timestamp;
+        uint32_t timestamp_us;
+    };
+
+    size_t read_header(uint64_t offset, uint8_t* header);
+    void add_record(const uint8_t* header, uint64_t payload_offset);
+    void index_raw_stream();
+    void index_container();
+    std::chrono::microseconds frame_interval(size_t record) const;
+    void read_samples(const Record& record, uint16_t* samples);
+
+    std::ifstream m_file;
+    std::vector<Record> m_records;
+    std::vector<uint8_t> m_payload;
+    std::vector<uint16_t> m_samples;  // raw frame read by get_next_normalized_frame
+
+    ifx_Fmcw_Playback_Mode_t m_mode;
+    bool m_loop;
+
+    bool m_started = false;
+    size_t m_next = 0;
+    std::chrono::microseconds m_frame_period {0};
+    std::chrono::steady_clock::time_point m_due;  // when the next frame is delivered in real-time mode
+};
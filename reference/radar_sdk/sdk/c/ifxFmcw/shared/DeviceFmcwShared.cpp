@@ -0,0 +1,127 @@
+/**
+ * @internal
+ * @file DeviceFmcwShared.cpp
+ *
+ * @brief Implements the consumer of the frames published by a device server.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwShared.hpp"
+#include "ifxBase/Exception.hpp"
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwShared::DeviceFmcwShared(std::unique_ptr<SharedFrameRing> ring, const char* uuid) :
+    DeviceFmcwAvian(ring->get_sensor_type()),
+    m_ring(std::move(ring)),
+    m_server_registers(m_ring->get_registers()),
+    m_uuid(uuid)
+{
+    DeviceFmcwAvian::apply_register_list(m_server_registers);
+
+    update_defaults_if_not_configured();
+    if (m_num_samples != m_ring->get_num_samples())
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+}
+
+void DeviceFmcwShared::check_server_registers()
+{
+    if (get_register_list() != m_server_registers)
+    {
+        DeviceFmcwAvian::apply_register_list(m_server_registers);
+        throw rdk::exception::not_possible();
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+const char* DeviceFmcwShared::get_board_uuid() const
+{
+    return m_uuid.c_str();
+}
+
+void DeviceFmcwShared::set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence)
+{
+    DeviceFmcwAvian::set_acquisition_sequence(sequence);
+    check_server_registers();
+}
+
+void DeviceFmcwShared::apply_register_list(const std::map<uint16_t, uint32_t>& register_list)
+{
+    DeviceFmcwAvian::apply_register_list(register_list);
+    check_server_registers();
+}
+
+void DeviceFmcwShared::start_acquisition()
+{
+    if (m_started)
+    {
+        return;
+    }
+
+    // like hardware, the first frame is the one acquired after the start
+    m_ring->seek_to_head();
+    m_started = true;
+}
+
+void DeviceFmcwShared::stop_acquisition()
+{
+    m_started = false;
+}
+
+uint32_t DeviceFmcwShared::get_slice_size()
+{
+    // the server publishes whole frames, regardless of the acquisition policy
+    update_defaults_if_not_configured();
+    return m_num_samples;
+}
+
+bool DeviceFmcwShared::try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    if (frame == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    update_defaults_if_not_configured();
+    if (frame->num_samples != m_num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    start_acquisition();
+
+    if (!m_ring->read(frame->samples, m_frame_device_us, m_frame_received_us, timeout_ms))
+    {
+        return false;
+    }
+    stamp_frame(frame);
+    return true;
+}
+
+bool DeviceFmcwShared::get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms)
+{
+    m_samples.resize(m_num_samples);
+    ifx_Fmcw_Raw_Frame_t frame = {m_num_samples, m_samples.data(), 0, 0, 0};
+    if (!try_get_next_raw_frame(&frame, timeout_ms))
+    {
+        return false;
+    }
+    convert_raw_data_to_float_array(m_num_samples, m_samples.data(), samples);
+    return true;
+}
@@ -0,0 +1,76 @@
+/**
+ * @internal
+ * @file DeviceFmcwShared.hpp
+ *
+ * @brief Defines an FMCW device that consumes the frames a device server
+ *        publishes for a board owned by another process.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../avian/DeviceFmcwAvian.hpp"
+#include "SharedFrameRing.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Consumer of the shared frame ring of a device server (see
+ * DeviceFmcwServer.h).
+ *
+ * Configuration, sequence and metrics come from a dummy Avian device set up
+ * with the register list of the server, so they describe the frames the
+ * server acquires. The configuration is owned by the server: setting a
+ * sequence or register list is only accepted if it results in the registers
+ * the server uses, otherwise not_possible is raised.
+ *
+ * Starting the acquisition only positions the cursor at the newest frame;
+ * the board keeps running for the other consumers. Frames a consumer is too
+ * slow for are skipped, the server does not wait for any consumer.
+ */
+struct DeviceFmcwShared : public DeviceFmcwAvian
+{
+    DeviceFmcwShared(std::unique_ptr<SharedFrameRing> ring, const char* uuid);
+
+    DeviceFmcwShared(const DeviceFmcwShared&) = delete;
+    DeviceFmcwShared& operator=(const DeviceFmcwShared&) = delete;
+
+    ~DeviceFmcwShared() override = default;
+
+    const char* get_board_uuid() const override;
+
+    void set_acquisition_sequence(const ifx_Fmcw_Sequence_Element_t* sequence) override;
+    void apply_register_list(const std::map<uint16_t, uint32_t>& register_list) override;
+
+    void stop_acquisition() override;
+    void start_acquisition() override;
+    uint32_t get_slice_size() override;
+
+    bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+
+protected:
+    bool get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms) override;
+
+private:
+    void check_server_registers();
+
+    std::unique_ptr<SharedFrameRing> m_ring;
+    std::map<uint16_t, uint32_t> m_server_registers;
+    std::string m_uuid;
+    std::vector<uint16_t> m_samples;  // raw frame read by get_next_normalized_frame
+
+    bool m_started = false;
+};
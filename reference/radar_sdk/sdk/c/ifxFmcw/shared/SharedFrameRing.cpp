@@ -0,0 +1,529 @@
+/**
+ * @internal
+ * @file SharedFrameRing.cpp
+ *
+ * @brief Implements the shared memory frame ring of the device server.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "SharedFrameRing.hpp"
+#include "ifxBase/Exception.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+constexpr uint32_t ring_magic = 0x52464649;  // "IFFR"
+constexpr uint32_t ring_version = 1;
+
+constexpr uint32_t state_running = 1;
+constexpr uint32_t state_closed = 2;
+
+constexpr size_t alignment = 64;
+
+// Longest a reader sleeps before checking that the server is still alive
+constexpr uint16_t liveness_interval_ms = 100;
+
+constexpr size_t align(size_t size)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+bool process_alive(int32_t pid)
+{
+#if defined(_WIN32)
+    (void)pid;
+    return false;
+#else
+    return (kill(static_cast<pid_t>(pid), 0) == 0) || (errno == EPERM);
+#endif
+}
+
+int32_t current_pid()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    return static_cast<int32_t>(getpid());
+#endif
+}
+
+}  // namespace
+
+struct SharedFrameRing::Slot
+{
+    std::atomic<uint64_t> sequence;  // sequence of the frame in the slot, 0 while it is written
+    uint64_t timestamp_device_us;
+    uint64_t timestamp_received_us;
+    uint64_t reserved;
+
+    uint16_t* samples()
+    {
+        return reinterpret_cast<uint16_t*>(this + 1);
+    }
+};
+
+struct SharedFrameRing::Header
+{
+    // written once by the server before the state is set to running
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sensor_type;
+    uint32_t num_samples;
+    uint32_t num_slots;
+    uint32_t slot_stride;
+    uint32_t num_registers;
+    int32_t server_pid;
+    char uuid[64];
+    struct
+    {
+        uint32_t address;
+        uint32_t value;
+    } registers[max_registers];
+
+    std::atomic<uint32_t> state;
+    std::atomic<uint32_t> wakeup;  // incremented with every frame, futex word on Linux
+    std::atomic<uint64_t> head;    // sequence of the newest frame, 0 before the first one
+
+    struct
+    {
+        std::atomic<int32_t> pid;  // 0 if the entry is free
+        std::atomic<uint64_t> cursor;
+        std::atomic<uint64_t> dropped;
+    } consumers[max_consumers];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "the ring needs address free atomics");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "the futex word must be a plain integer");
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+SharedFrameRing::SharedFrameRing(std::string name, void* memory, size_t size, bool writer) :
+    m_name(std::move(name)),
+    m_memory(memory),
+    m_size(size),
+    m_header(static_cast<Header*>(memory)),
+    m_writer(writer)
+{}
+
+std::string SharedFrameRing::shm_name(const char* uuid)
+{
+    // Some systems limit names to 31 characters, too short for the uuid
+    // itself, so the name is derived from its FNV-1a hash.
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char* c = uuid; *c; c++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 0x100000001B3ull;
+    }
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "/ifx_fmcw_%016llx", static_cast<unsigned long long>(hash));
+    return name;
+}
+
+SharedFrameRing::Slot* SharedFrameRing::slot(uint64_t sequence) const
+{
+    const auto offset = align(sizeof(Header)) + (sequence % m_header->num_slots) * m_header->slot_stride;
+    return reinterpret_cast<Slot*>(static_cast<uint8_t*>(m_memory) + offset);
+}
+
+bool SharedFrameRing::server_alive() const
+{
+    return (m_header->state.load(std::memory_order_acquire) == state_running) && process_alive(m_header->server_pid);
+}
+
+void SharedFrameRing::wait(uint32_t wakeup, uint16_t timeout_ms) const
+{
+#if defined(__linux__)
+    // The word is shared between processes, so no FUTEX_PRIVATE_FLAG.
+    timespec timeout = {timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_header->wakeup), FUTEX_WAIT, wakeup, &timeout, nullptr, 0);
+#else
+    // Without a portable process shared wait, poll the word every millisecond.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while ((m_header->wakeup.load(std::memory_order_acquire) == wakeup) && (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+#endif
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::create(const char* uuid, ifx_Radar_Sensor_t sensor_type, uint32_t num_samples,
+                                                         const std::map<uint16_t, uint32_t>& registers, uint32_t num_slots)
+{
+#if defined(_WIN32)
+    (void)uuid;
+    (void)sensor_type;
+    (void)num_samples;
+    (void)registers;
+    (void)num_slots;
+    throw rdk::exception::not_supported();
+#else
+    if (uuid == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+    if ((num_slots < 2) || (num_samples == 0) || (registers.size() > max_registers)
+        || (std::strlen(uuid) >= sizeof(Header::uuid)))
+    {
+        throw rdk::exception::argument_invalid();
+    }
+
+    const auto name = shm_name(uuid);
+    const auto slot_stride = align(sizeof(Slot) + num_samples * sizeof(uint16_t));
+    const auto size = align(sizeof(Header)) + num_slots * slot_stride;
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if ((fd < 0) && (errno == EEXIST))
+    {
+        if (open(uuid))
+        {
+            throw rdk::exception::device_busy();
+        }
+
+        // left over by a server that terminated without cleaning up
+        shm_unlink(name.c_str());
+        fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+    if (fd < 0)
+    {
+        throw rdk::exception::device_busy();
+    }
+
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(name.c_str());
+        throw rdk::exception::memory_allocation_failed();
+    }
+
+    auto* header = new (memory) Header();
+    header->magic = ring_magic;
+    header->version = ring_version;
+    header->sensor_type = static_cast<uint32_t>(sensor_type);
+    header->num_samples = num_samples;
+    header->num_slots = num_slots;
+    header->slot_stride = static_cast<uint32_t>(slot_stride);
+    header->num_registers = static_cast<uint32_t>(registers.size());
+    header->server_pid = current_pid();
+    std::strncpy(header->uuid, uuid, sizeof(header->uuid) - 1);
+
+    uint32_t index = 0;
+    for (const auto& entry : registers)
+    {
+        header->registers[index].address = entry.first;
+        header->registers[index].value = entry.second;
+        index++;
+    }
+
+    std::unique_ptr<SharedFrameRing> ring(new SharedFrameRing(name, memory, size, true));
+    for (uint32_t i = 0; i < num_slots; i++)
+    {
+        new (ring->slot(i)) Slot();
+    }
+
+    header->state.store(state_running, std::memory_order_release);
+    return ring;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+std::unique_ptr<SharedFrameRing> SharedFrameRing::open(const char* uuid)
+{
+#if defined(_WIN32)
+    (void)uuid;
+    return nullptr;
+#else
+    if (uuid == nullptr)
+    {
+        return nullptr;
+    }
+
+    const auto name = shm_name(uuid);
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    // The server may still be setting the ring up, then the size is not
+    // final yet or the state is not running.
+    struct stat info;
+    void* memory = MAP_FAILED;
+    size_t size = 0;
+    if ((fstat(fd, &info) == 0) && (static_cast<size_t>(info.st_size) >= sizeof(Header)))
+    {
+        size = static_cast<size_t>(info.st_size);
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<SharedFrameRing> ring(new SharedFrameRing(name, memory, size, false));
+    const auto* header = ring->m_header;
+    if ((header->state.load(std::memory_order_acquire) != state_running) || (header->magic != ring_magic)
+        || (header->version != ring_version) || (std::strncmp(header->uuid, uuid, sizeof(header->uuid)) != 0)
+        || (size < align(sizeof(Header)) + static_cast<size_t>(header->num_slots) * header->slot_stride)
+        || !process_alive(header->server_pid))
+    {
+        return nullptr;
+    }
+
+    // Claim an entry for mirroring the cursor, also taking the ones of
+    // consumers which terminated without releasing them. Without a free
+    // entry the reader works all the same, just unlisted.
+    const auto pid = current_pid();
+    for (uint32_t i = 0; i < max_consumers; i++)
+    {
+        auto& consumer = ring->m_header->consumers[i];
+        auto owner = consumer.pid.load();
+        if (((owner == 0) || !process_alive(owner)) && consumer.pid.compare_exchange_strong(owner, pid))
+        {
+            ring->m_consumer = static_cast<int32_t>(i);
+            consumer.dropped.store(0);
+            break;
+        }
+    }
+
+    ring->seek_to_head();
+    return ring;
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+SharedFrameRing::~SharedFrameRing()
+{
+#if !defined(_WIN32)
+    if (m_writer)
+    {
+        close();
+        shm_unlink(m_name.c_str());
+    }
+    else if (m_consumer >= 0)
+    {
+        m_header->consumers[m_consumer].pid.store(0);
+    }
+    munmap(m_memory, m_size);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Radar_Sensor_t SharedFrameRing::get_sensor_type() const
+{
+    return static_cast<ifx_Radar_Sensor_t>(m_header->sensor_type);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t SharedFrameRing::get_num_samples() const
+{
+    return m_header->num_samples;
+}
+
+//----------------------------------------------------------------------------
+
+std::map<uint16_t, uint32_t> SharedFrameRing::get_registers() const
+{
+    std::map<uint16_t, uint32_t> registers;
+    const auto count = std::min(m_header->num_registers, max_registers);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        registers.emplace(static_cast<uint16_t>(m_header->registers[i].address), m_header->registers[i].value);
+    }
+    return registers;
+}
+
+//----------------------------------------------------------------------------
+
+uint16_t* SharedFrameRing::acquire_slot()
+{
+    auto* next = slot(m_header->head.load(std::memory_order_relaxed) + 1);
+    next->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return next->samples();
+}
+
+//----------------------------------------------------------------------------
+
+void SharedFrameRing::publish(uint64_t timestamp_device_us, uint64_t timestamp_received_us)
+{
+    const auto sequence = m_header->head.load(std::memory_order_relaxed) + 1;
+    auto* next = slot(sequence);
+    next->timestamp_device_us = timestamp_device_us;
+    next->timestamp_received_us = timestamp_received_us;
+    next->sequence.store(sequence, std::memory_order_release);
+    m_header->head.store(sequence, std::memory_order_release);
+
+    m_header->wakeup.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_header->wakeup), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+void SharedFrameRing::close()
+{
+    m_header->state.store(state_closed, std::memory_order_release);
+    m_header->wakeup.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_header->wakeup), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t SharedFrameRing::get_num_consumers() const
+{
+    uint32_t count = 0;
+    for (const auto& consumer : m_header->consumers)
+    {
+        const auto pid = consumer.pid.load();
+        if ((pid != 0) && process_alive(pid))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------------
+
+void SharedFrameRing::seek_to_head()
+{
+    m_cursor = m_header->head.load(std::memory_order_acquire) + 1;
+    if (m_consumer >= 0)
+    {
+        m_header->consumers[m_consumer].cursor.store(m_cursor, std::memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+bool SharedFrameRing::read(uint16_t* samples, uint64_t& timestamp_device_us, uint64_t& timestamp_received_us, uint16_t timeout_ms)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    const auto num_slots = m_header->num_slots;
+
+    while (true)
+    {
+        // The wakeup word is read before the head, so a frame published in
+        // between ends the wait right away.
+        const auto wakeup = m_header->wakeup.load(std::memory_order_acquire);
+        const auto head = m_header->head.load(std::memory_order_acquire);
+
+        if (head >= m_cursor)
+        {
+            // The slot after the head is being written, so the oldest frame
+            // still available is num_slots - 2 frames before the head.
+            const auto oldest = (head + 2 > num_slots) ? head + 2 - num_slots : 1;
+            if (m_cursor < oldest)
+            {
+                m_dropped += oldest - m_cursor;
+                m_cursor = oldest;
+            }
+
+            auto* current = slot(m_cursor);
+            if (current->sequence.load(std::memory_order_acquire) != m_cursor)
+            {
+                // overwritten since the head was read
+                continue;
+            }
+
+            std::memcpy(samples, current->samples(), m_header->num_samples * sizeof(uint16_t));
+            timestamp_device_us = current->timestamp_device_us;
+            timestamp_received_us = current->timestamp_received_us;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (current->sequence.load(std::memory_order_relaxed) != m_cursor)
+            {
+                // overwritten while it was copied
+                continue;
+            }
+
+            m_cursor++;
+            if (m_consumer >= 0)
+            {
+                auto& consumer = m_header->consumers[m_consumer];
+                consumer.cursor.store(m_cursor, std::memory_order_relaxed);
+                consumer.dropped.store(m_dropped, std::memory_order_relaxed);
+            }
+            return true;
+        }
+
+        if (!server_alive())
+        {
+            throw rdk::exception::no_device();
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count() + 1;
+        wait(wakeup, static_cast<uint16_t>(std::min<int64_t>(remaining, liveness_interval_ms)));
+    }
+}
+
+//----------------------------------------------------------------------------
+
+uint64_t SharedFrameRing::get_dropped_frames() const
+{
+    return m_dropped;
+}
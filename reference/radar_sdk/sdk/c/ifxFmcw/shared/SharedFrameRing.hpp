@@ -0,0 +1,130 @@
+/**
+ * @internal
+ * @file SharedFrameRing.hpp
+ *
+ * @brief Defines the shared memory ring through which a device server passes
+ *        the frames of one board to other processes.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxRadarDeviceCommon/RadarDeviceCommon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * A POSIX shared memory object named after the board uuid, holding the
+ * configuration of the board and a ring of raw frames.
+ *
+ * A single writer (the server owning the board) reads each frame from the
+ * device directly into the next slot and publishes it with an increasing
+ * sequence number. Readers (consumers in other processes) keep their own
+ * cursor, the sequence number of the next frame they want, and never hold up
+ * the writer: a reader falling more than the ring size behind skips to the
+ * oldest frame still available and counts the frames it lost. The cursors
+ * and loss counters are mirrored in the shared memory for diagnostics.
+ *
+ * A slot is invalidated (sequence 0) while it is written, so a reader
+ * validates a frame by reading the slot sequence before and after copying
+ * it, like a seqlock. One slot is always being written, so a ring of N slots
+ * holds the last N-1 frames.
+ *
+ * On Windows no rings exist: create() throws not_supported and open()
+ * returns no ring.
+ */
+class SharedFrameRing
+{
+public:
+    NONCOPYABLE(SharedFrameRing);
+
+    static constexpr uint32_t max_registers = 256;
+    static constexpr uint32_t max_consumers = 16;
+
+    /* Creates the ring of the board with the given uuid for writing. A ring
+     * left over by a server that was not shut down is replaced, a ring of a
+     * running server raises device_busy.
+     */
+    static std::unique_ptr<SharedFrameRing> create(const char* uuid, ifx_Radar_Sensor_t sensor_type, uint32_t num_samples,
+                                                   const std::map<uint16_t, uint32_t>& registers, uint32_t num_slots);
+
+    /* Opens the ring of a running server for reading, returns nullptr if
+     * there is none.
+     */
+    static std::unique_ptr<SharedFrameRing> open(const char* uuid);
+
+    ~SharedFrameRing();
+
+    ifx_Radar_Sensor_t get_sensor_type() const;
+    uint32_t get_num_samples() const;
+    std::map<uint16_t, uint32_t> get_registers() const;
+
+    /* Writer: returns the samples of the slot for the next frame, which is
+     * invalidated until publish(). Calling it again without publish() returns
+     * the same slot.
+     */
+    uint16_t* acquire_slot();
+
+    /* Writer: publishes the frame written into the slot of acquire_slot() and
+     * wakes up the waiting readers.
+     */
+    void publish(uint64_t timestamp_device_us, uint64_t timestamp_received_us);
+
+    /* Writer: marks the ring as closed, readers get no_device once they have
+     * read the remaining frames.
+     */
+    void close();
+
+    /* Writer: number of attached readers */
+    uint32_t get_num_consumers() const;
+
+    /* Reader: continues with the next frame published from now on. */
+    void seek_to_head();
+
+    /* Reader: copies the frame at the cursor into samples and advances the
+     * cursor. Returns false if no frame is published within timeout_ms and
+     * raises no_device if the server closed the ring or terminated.
+     */
+    bool read(uint16_t* samples, uint64_t& timestamp_device_us, uint64_t& timestamp_received_us, uint16_t timeout_ms);
+
+    /* Reader: number of frames skipped because the reader was too slow */
+    uint64_t get_dropped_frames() const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    SharedFrameRing(std::string name, void* memory, size_t size, bool writer);
+
+    static std::string shm_name(const char* uuid);
+
+    Slot* slot(uint64_t sequence) const;
+    bool server_alive() const;
+    void wait(uint32_t wakeup, uint16_t timeout_ms) const;
+
+    std::string m_name;
+    void* m_memory;
+    size_t m_size;
+    Header* m_header;
+    bool m_writer;
+
+    uint64_t m_cursor = 0;   // reader: sequence of the next frame
+    uint64_t m_dropped = 0;  // reader: skipped frames
+    int32_t m_consumer = -1; // reader: index of the entry mirroring the cursor
+};
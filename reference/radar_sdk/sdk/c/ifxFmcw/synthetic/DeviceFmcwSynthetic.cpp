@@ -0,0 +1,342 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwSynthetic.cpp
+ *
+ * @brief Implements an FMCW device generating frames of a synthetic scene.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "DeviceFmcwSynthetic.hpp"
+#include "ifxBase/Exception.hpp"
+#include "ifxBase/internal/Util.h"  // for ifx_util_popcount
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <thread>
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+constexpr double speed_of_light = 299792458.0;
+constexpr double pi = 3.14159265358979323846;
+
+// range of the reflection modelling the TX to RX leakage
+constexpr double coupling_range_m = 0.03;
+
+}  // namespace
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+DeviceFmcwSynthetic::DeviceFmcwSynthetic(ifx_Radar_Sensor_t device_type, const ifx_Fmcw_Synthetic_Scene_t* scene,
+                                         ifx_Fmcw_Playback_Mode_t mode) :
+    DeviceFmcwAvian(device_type),
+    m_mode(mode)
+{
+    set_scene(scene);
+}
+
+double DeviceFmcwSynthetic::add_chirps(const ifx_Fmcw_Sequence_Element_t* element, double start_time_s)
+{
+    auto time_s = start_time_s;
+
+    for (; element != nullptr; element = element->next_element)
+    {
+        switch (element->type)
+        {
+            case IFX_SEQ_LOOP:
+                {
+                    const auto& loop = element->loop;
+                    const double period_s = (loop.repetition_time_s > 0)
+                                                ? loop.repetition_time_s
+                                                : get_sequence_duration(loop.sub_sequence);
+                    for (uint32_t i = 0; i < loop.num_repetitions; i++)
+                    {
+                        add_chirps(loop.sub_sequence, time_s + i * period_s);
+                    }
+                    time_s += loop.num_repetitions * period_s;
+                    break;
+                }
+            case IFX_SEQ_CHIRP:
+                m_chirps.push_back({element->chirp, time_s});
+                time_s += get_chirp_duration(element->chirp);
+                break;
+            case IFX_SEQ_DELAY:
+                time_s += element->delay.time_s;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return time_s;
+}
+
+void DeviceFmcwSynthetic::generate_frame(uint16_t* samples)
+{
+    const double frame_time_s = m_frame_count * m_frame_period_s;
+
+    m_signal.resize(m_num_samples);
+    auto* signal = m_signal.data();
+
+    for (const auto& chirp : m_chirps)
+    {
+        const auto& parameters = chirp.parameters;
+        const uint32_t num_rx = ifx_util_popcount(parameters.rx_mask);
+        const uint32_t num_samples = parameters.num_samples;
+
+        // The RX antennas are indexed by their position in the mask.
+        uint32_t rx_position[32];
+        for (uint32_t bit = 0, rx = 0; bit < 32; bit++)
+        {
+            if (parameters.rx_mask & (1u << bit))
+            {
+                rx_position[rx++] = bit;
+            }
+        }
+
+        const double center_frequency_Hz = (parameters.start_frequency_Hz + parameters.end_frequency_Hz) / 2;
+        const double slope_Hz_s = (parameters.end_frequency_Hz - parameters.start_frequency_Hz)
+                                  * parameters.sample_rate_Hz / num_samples;
+
+        std::fill_n(signal, num_samples * num_rx, 0.0f);
+
+        /*
+         * A reflection at range R produces a beat tone of 2*R*slope/c with the
+         * phase 4*pi*R*fc/c. The tone is computed by rotating a phasor from
+         * sample to sample, the RX antennas only differ in a constant phase.
+         */
+        auto add_reflection = [&](double range_m, double angle_deg, float amplitude) {
+            const double beat_frequency_Hz = 2 * range_m * slope_Hz_s / speed_of_light;
+            const double phase = 4 * pi * range_m * center_frequency_Hz / speed_of_light;
+            const auto step = std::polar(1.0, 2 * pi * beat_frequency_Hz / parameters.sample_rate_Hz);
+            const double antenna_phase = pi * std::sin(angle_deg * pi / 180);
+
+            std::complex<double> rx_phasor[32];
+            for (uint32_t rx = 0; rx < num_rx; rx++)
+            {
+                rx_phasor[rx] = std::polar(static_cast<double>(amplitude), phase + antenna_phase * rx_position[rx]);
+            }
+
+            auto phasor = std::complex<double>(1.0, 0.0);
+            for (uint32_t sample = 0; sample < num_samples; sample++)
+            {
+                for (uint32_t rx = 0; rx < num_rx; rx++)
+                {
+                    signal[sample * num_rx + rx] += static_cast<float>((phasor * rx_phasor[rx]).real());
+                }
+                phasor *= step;
+            }
+        };
+
+        if (m_coupling_amplitude > 0)
+        {
+            add_reflection(coupling_range_m, 0, m_coupling_amplitude);
+        }
+
+        for (const auto& target : m_targets)
+        {
+            const double range_m = target.range_m + target.velocity_m_s * (frame_time_s + chirp.start_time_s);
+            add_reflection(range_m, target.angle_deg, target.amplitude);
+        }
+
+        if (m_noise_amplitude > 0)
+        {
+            for (uint32_t i = 0; i < num_samples * num_rx; i++)
+            {
+                signal[i] += m_noise_amplitude * m_noise(m_random);
+            }
+        }
+
+        signal += num_samples * num_rx;
+    }
+
+    // Like the ADC, map [-1, 1] to the full scale and clip.
+    for (uint32_t i = 0; i < m_num_samples; i++)
+    {
+        const ifx_Float_t value = std::round((m_signal[i] + 1) / 2 * m_max_adc_value);
+        samples[i] = static_cast<uint16_t>(std::min<ifx_Float_t>(std::max<ifx_Float_t>(value, 0), m_max_adc_value));
+    }
+
+    m_frame_count++;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void DeviceFmcwSynthetic::set_scene(const ifx_Fmcw_Synthetic_Scene_t* scene)
+{
+    if (scene == nullptr || (scene->num_targets && scene->targets == nullptr))
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    if (scene->noise_amplitude < 0 || scene->coupling_amplitude < 0)
+    {
+        throw rdk::exception::argument_out_of_bounds();
+    }
+
+    m_targets.assign(scene->targets, scene->targets + scene->num_targets);
+    m_noise_amplitude = scene->noise_amplitude;
+    m_coupling_amplitude = scene->coupling_amplitude;
+    m_random.seed(scene->seed);
+    m_noise.reset();
+    m_frame_count = 0;
+}
+
+void DeviceFmcwSynthetic::start_acquisition()
+{
+    if (m_started)
+    {
+        return;
+    }
+
+    update_defaults_if_not_configured();
+
+    // The outer frame loop is not part of a frame, see get_frame_dimensions.
+    auto* sequence = get_acquisition_sequence();
+    const ifx_Fmcw_Sequence_Element_t* frame = sequence;
+    m_frame_period_s = 0;
+    if (sequence && (sequence->type == IFX_SEQ_LOOP) && (sequence->next_element == nullptr))
+    {
+        m_frame_period_s = sequence->loop.repetition_time_s;
+        frame = sequence->loop.sub_sequence;
+    }
+
+    m_chirps.clear();
+    try
+    {
+        const auto frame_duration_s = add_chirps(frame, 0);
+        if (m_frame_period_s <= 0)
+        {
+            m_frame_period_s = frame_duration_s;
+        }
+    }
+    catch (...)
+    {
+        ifx_fmcw_destroy_sequence(sequence);
+        throw;
+    }
+    ifx_fmcw_destroy_sequence(sequence);
+
+    uint32_t num_samples = 0;
+    for (const auto& chirp : m_chirps)
+    {
+        num_samples += chirp.parameters.num_samples * ifx_util_popcount(chirp.parameters.rx_mask);
+    }
+    if (num_samples != m_num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    m_started = true;
+    m_frame_count = 0;
+    m_due = std::chrono::steady_clock::now();
+}
+
+void DeviceFmcwSynthetic::stop_acquisition()
+{
+    m_started = false;
+}
+
+uint32_t DeviceFmcwSynthetic::get_slice_size()
+{
+    // frames are generated as a whole, regardless of the acquisition policy
+    update_defaults_if_not_configured();
+    return m_num_samples;
+}
+
+bool DeviceFmcwSynthetic::try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms)
+{
+    if (frame == nullptr)
+    {
+        throw rdk::exception::argument_null();
+    }
+
+    update_defaults_if_not_configured();
+    if (frame->num_samples != m_num_samples)
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    start_acquisition();
+
+    if (m_mode == IFX_FMCW_PLAYBACK_REAL_TIME)
+    {
+        // Like hardware, give up if the frame is not due within the timeout.
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        if (m_due > deadline)
+        {
+            std::this_thread::sleep_until(deadline);
+            return false;
+        }
+        std::this_thread::sleep_until(m_due);
+        m_due += std::chrono::microseconds(static_cast<int64_t>(m_frame_period_s * 1e6));
+    }
+
+    generate_frame(frame->samples);
+
+    // there is no device clock, the frame is received when it is generated
+    m_frame_device_us = 0;
+    m_frame_received_us = epoch_time_us();
+    stamp_frame(frame);
+    return true;
+}
+
+bool DeviceFmcwSynthetic::get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms)
+{
+    m_samples.resize(m_num_samples);
+    ifx_Fmcw_Raw_Frame_t frame = {m_num_samples, m_samples.data(), 0, 0, 0};
+    if (!try_get_next_raw_frame(&frame, timeout_ms))
+    {
+        return false;
+    }
+    convert_raw_data_to_float_array(m_num_samples, m_samples.data(), samples);
+    return true;
+}
@@ -0,0 +1,117 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file DeviceFmcwSynthetic.hpp
+ *
+ * @brief Defines an FMCW device that generates frames of a synthetic scene.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "../avian/DeviceFmcwAvian.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * Generates the frames of a scene of point targets, TX to RX leakage and
+ * white noise instead of reading them from a sensor.
+ *
+ * Configuration, sequence and metrics come from a dummy Avian device of the
+ * given sensor type. The IF signal of every chirp of the acquisition
+ * sequence is computed from its RF range, sampling rate and timing, so
+ * processing chains see the same frame structure and beat frequencies as
+ * with hardware. Frames are paced by the frame repetition time or delivered
+ * as fast as they are fetched. Instances share no state and can run
+ * concurrently in separate threads.
+ */
+struct DeviceFmcwSynthetic : public DeviceFmcwAvian
+{
+    DeviceFmcwSynthetic(ifx_Radar_Sensor_t device_type, const ifx_Fmcw_Synthetic_Scene_t* scene,
+                        ifx_Fmcw_Playback_Mode_t mode);
+
+    DeviceFmcwSynthetic(const DeviceFmcwSynthetic&) = delete;
+    DeviceFmcwSynthetic& operator=(const DeviceFmcwSynthetic&) = delete;
+
+    ~DeviceFmcwSynthetic() override = default;
+
+    void set_scene(const ifx_Fmcw_Synthetic_Scene_t* scene);
+
+    void stop_acquisition() override;
+    void start_acquisition() override;
+    uint32_t get_slice_size() override;
+
+    bool try_get_next_raw_frame(ifx_Fmcw_Raw_Frame_t* frame, uint16_t timeout_ms) override;
+
+protected:
+    bool get_next_normalized_frame(ifx_Float_t* samples, uint16_t timeout_ms) override;
+
+private:
+    // a chirp of the acquisition sequence in the order its samples are read
+    struct Chirp
+    {
+        ifx_Fmcw_Sequence_Chirp_t parameters;
+        double start_time_s;  // relative to the start of the frame
+    };
+
+    double add_chirps(const ifx_Fmcw_Sequence_Element_t* element, double start_time_s);
+    void generate_frame(uint16_t* samples);
+
+    std::vector<ifx_Fmcw_Synthetic_Target_t> m_targets;
+    float m_noise_amplitude = 0;
+    float m_coupling_amplitude = 0;
+    std::mt19937 m_random;
+    std::normal_distribution<float> m_noise;
+
+    ifx_Fmcw_Playback_Mode_t m_mode;
+
+    std::vector<Chirp> m_chirps;
+    std::vector<float> m_signal;      // IF signal of a frame relative to full scale
+    std::vector<uint16_t> m_samples;  // raw frame read by get_next_normalized_frame
+
+    bool m_started = false;
+    uint64_t m_frame_count = 0;
+    double m_frame_period_s = 0;
+    std::chrono::steady_clock::time_point m_due;  // when the next frame is delivered in real-time mode
+};
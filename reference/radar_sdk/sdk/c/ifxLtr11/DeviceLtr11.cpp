@@ -55,6 +55,17 @@ ifx_List_t* ifx_ltr11_get_list(void)
     return ifx_list_from_vector(list);
 }
 
+size_t ifx_ltr11_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    IFX_ERR_BRV_COND(count && !entries, IFX_ERROR_ARGUMENT_NULL, 0);
+
+    auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
+        return rdk::RadarDeviceCommon::sensor_is_ltr11(entry.sensor_type);
+    };
+
+    return rdk::RadarDeviceCommon::get_list(selector).copy_to(entries, count);
+}
+
 ifx_Ltr11_Device_t* ifx_ltr11_create()
 {
     auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
@@ -118,6 +129,16 @@ ifx_Vector_C_t* ifx_ltr11_get_next_frame_timeout(ifx_Ltr11_Device_t* handle, ifx
     return rdk::call_func(handle, &ifx_Ltr11_Device_t::getNextFrame, nullptr, frame_data, metadata, timeout_ms);
 }
 
+void ifx_ltr11_get_next_frame_async(ifx_Ltr11_Device_t* handle, ifx_Vector_C_t* frame_data, ifx_Ltr11_Metadata_t* metadata, ifx_Ltr11_Async_Callback_t callback, void* user_data)
+{
+    rdk::call_func(handle, &ifx_Ltr11_Device_t::getNextFrameAsync, frame_data, metadata, callback, user_data);
+}
+
+void ifx_ltr11_cancel_async(ifx_Ltr11_Device_t* handle)
+{
+    rdk::call_func(handle, &ifx_Ltr11_Device_t::cancelAsync);
+}
+
 void ifx_ltr11_register_dump_to_file(ifx_Ltr11_Device_t* handle, const char* filename)
 {
     rdk::call_func(handle, &ifx_Ltr11_Device_t::dumpRegisters, filename);
@@ -120,6 +120,32 @@ const ifx_Firmware_Info_t* ifx_ltr11_get_firmware_information(ifx_Ltr11_Device_t
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_ltr11_get_list(void);
 
+/**
+ * \brief Fills a caller-provided array with the available BGT60LTR11 devices.
+ *
+ * The function is similar to \ref ifx_ltr11_get_list but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * \code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_ltr11_get_sensor_list(entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * \endcode
+ *
+ * \param [out] entries     array of at least count entries
+ * \param [in]  count       number of entries the array can hold
+ * \return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_ltr11_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * \brief Return sensor info.
  *
@@ -380,6 +406,51 @@ ifx_Vector_C_t* ifx_ltr11_get_next_frame(ifx_Ltr11_Device_t* handle, ifx_Vector_
 IFX_DLL_PUBLIC
 ifx_Vector_C_t* ifx_ltr11_get_next_frame_timeout(ifx_Ltr11_Device_t* handle, ifx_Vector_C_t* frame_data, ifx_Ltr11_Metadata_t* metadata, uint16_t timeout_ms);
 
+/**
+ * \brief Requests the next frame without waiting for it.
+ *
+ * The request is queued and the function returns at once. When the next frame
+ * is received it is written to *frame_data* and *metadata* and *callback* is
+ * called with \ref IFX_OK, a frame lost on the way completes the request with
+ * the error. Requests complete one per frame, in the order they were made. A
+ * frame arriving while no request is pending is dropped, so keep a second
+ * request queued to receive every frame.
+ *
+ * The callback runs on the thread receiving the data from the board and
+ * should return quickly. It may queue the next request, but must not call
+ * other functions of the device. See \ref ifx_fmcw_get_next_frame_async for
+ * an example.
+ *
+ * The first request starts the acquisition, restarting a running one.
+ * Stopping the acquisition keeps the pending requests. Until
+ * \ref ifx_ltr11_cancel_async, \ref ifx_ltr11_get_next_frame and
+ * \ref ifx_ltr11_get_next_frame_timeout fail with \ref IFX_ERROR_NOT_POSSIBLE.
+ * Only supported for connected boards, other devices report
+ * \ref IFX_ERROR_NOT_SUPPORTED.
+ *
+ * \param [in]   handle         Device handle for BGT60LTR11 device.
+ * \param [in]   frame_data     Vector of the configured number of samples. It
+ *                              must stay valid until the request is completed.
+ * \param [in]   metadata       Metadata structure of the request. It must stay
+ *                              valid until the request is completed.
+ * \param [in]   callback       Function completing the request.
+ * \param [in]   user_data      Pointer passed to the callback.
+ */
+IFX_DLL_PUBLIC
+void ifx_ltr11_get_next_frame_async(ifx_Ltr11_Device_t* handle, ifx_Vector_C_t* frame_data, ifx_Ltr11_Metadata_t* metadata, ifx_Ltr11_Async_Callback_t callback, void* user_data);
+
+/**
+ * \brief Cancels all pending requests of \ref ifx_ltr11_get_next_frame_async.
+ *
+ * Stops the acquisition and completes every pending request with
+ * \ref IFX_ERROR_ABORTED on the calling thread before returning. Destroying
+ * the device cancels the requests the same way.
+ *
+ * \param [in]   handle         Device handle for BGT60LTR11 device.
+ */
+IFX_DLL_PUBLIC
+void ifx_ltr11_cancel_async(ifx_Ltr11_Device_t* handle);
+
 /**
  * \brief Return the limiting values for the LTR11 configuration.
  *
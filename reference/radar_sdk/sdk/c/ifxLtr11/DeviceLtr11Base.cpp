@@ -210,6 +210,16 @@ const ifx_Firmware_Info_t* DeviceLtr11Base::get_firmware_info() const
     return &m_firmware_info;
 }
 
+void DeviceLtr11Base::getNextFrameAsync(ifx_Vector_C_t* /*frame*/, ifx_Ltr11_Metadata_t* /*metadata*/, ifx_Ltr11_Async_Callback_t /*callback*/, void* /*userData*/)
+{
+    throw rdk::exception::not_supported();
+}
+
+void DeviceLtr11Base::cancelAsync()
+{
+    // no request can be pending
+}
+
 float DeviceLtr11Base::getActiveModePower(const ifx_Ltr11_Config_t* config)
 {
     if (!config)
@@ -60,6 +60,8 @@ public:
     virtual void stopAcquisition() = 0;
 
     virtual ifx_Vector_C_t* getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) = 0;
+    virtual void getNextFrameAsync(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, ifx_Ltr11_Async_Callback_t callback, void* userData);
+    virtual void cancelAsync();
 
     const ifx_Radar_Sensor_Info_t* get_sensor_info();
     const ifx_Firmware_Info_t* get_firmware_info() const;
@@ -38,6 +38,7 @@
 #include "ifxBase/Complex.h"
 #include "ifxBase/Exception.hpp"
 #include "ifxBase/Vector.h"
+#include "ifxBase/internal/Simd.h"
 #include "ifxRadarDeviceCommon/internal/RadarDeviceCommon.hpp"
 
 
@@ -85,6 +86,63 @@ float normalize(uint16_t fvalue)
     return (1.0f * value) / 0xFF;
 }
 
+/* Converts num_samples readouts of stride words each, starting with the I
+ * and Q words, into complex samples. The vector paths divide like normalize(),
+ * so that the result does not depend on the instruction set.
+ */
+void convertIq(const uint16_t* data, uint32_t stride, uint32_t num_samples, ifx_Complex_t* output)
+{
+    auto* out = reinterpret_cast<ifx_Float_t*>(output);
+    uint32_t i = 0;
+
+#if defined(IFX_SSE2)
+    if (stride == 4)
+    {
+        const __m128i mask = _mm_set1_epi32(0x3FC);
+        const vf32x4 full_scale = vf32x4_set1(0xFF);
+        for (; i + 4 <= num_samples; i += 4)
+        {
+            // lanes 0 and 2 of a and b hold I | (Q << 16) of a readout
+            const vf32x4 a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4)));
+            const vf32x4 b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4 + 8)));
+            const __m128i iq = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            const __m128i ival = _mm_srli_epi32(_mm_and_si128(iq, mask), 2);
+            const __m128i qval = _mm_srli_epi32(_mm_and_si128(_mm_srli_epi32(iq, 16), mask), 2);
+            const vf32x4 re = _mm_div_ps(_mm_cvtepi32_ps(ival), full_scale);
+            const vf32x4 im = _mm_div_ps(_mm_cvtepi32_ps(qval), full_scale);
+            _mm_storeu_ps(out + 2 * i, _mm_unpacklo_ps(re, im));
+            _mm_storeu_ps(out + 2 * i + 4, _mm_unpackhi_ps(re, im));
+        }
+    }
+#elif defined(IFX_NEON) && defined(__aarch64__)
+    if (stride == 4)
+    {
+        const uint16x8_t mask = vdupq_n_u16(0x3FC);
+        const float32x4_t full_scale = vdupq_n_f32(0xFF);
+        for (; i + 8 <= num_samples; i += 8)
+        {
+            // the structure load separates the I, Q, amplitude and detector words
+            const uint16x8x4_t v = vld4q_u16(data + i * 4);
+            const uint16x8_t ival = vshrq_n_u16(vandq_u16(v.val[0], mask), 2);
+            const uint16x8_t qval = vshrq_n_u16(vandq_u16(v.val[1], mask), 2);
+            float32x4x2_t low, high;
+            low.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(ival))), full_scale);
+            low.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(qval))), full_scale);
+            high.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(ival))), full_scale);
+            high.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(qval))), full_scale);
+            vst2q_f32(out + 2 * i, low);
+            vst2q_f32(out + 2 * i + 8, high);
+        }
+    }
+#endif
+
+    for (; i < num_samples; i++)
+    {
+        out[2 * i] = normalize(data[i * stride]);
+        out[2 * i + 1] = normalize(data[i * stride + 1]);
+    }
+}
+
 }  // end of anonymous namespace
 
 
@@ -152,6 +210,11 @@ DeviceLtr11::~DeviceLtr11()
         // Anyhow, if the device is longer present, it is also not necessary to
         // stop the acquisition.
     }
+    if (m_async)
+    {
+        m_bridgeData->registerListener(nullptr);
+    }
+    abortAsyncRequests();
 }
 
 void DeviceLtr11::setConfig(const ifx_Ltr11_Config_t* config)
@@ -233,6 +296,11 @@ ifx_Vector_C_t* DeviceLtr11::getNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_M
     {
         throw ::rdk::exception::argument_invalid();
     }
+    if (m_async)
+    {
+        // frames are delivered to the pending requests, see getNextFrameAsync()
+        throw ::rdk::exception::not_possible();
+    }
 
     bool frameDataMemoryAllocated;  // Flag indicating when true: frame memory allocated in getNextFrame method
     if (!frameData)
@@ -270,6 +338,90 @@ ifx_Vector_C_t* DeviceLtr11::getNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_M
     return frameData;
 }
 
+void DeviceLtr11::getNextFrameAsync(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata, ifx_Ltr11_Async_Callback_t callback, void* userData)
+{
+    if (!m_frameConfigValid)
+    {
+        throw rdk::exception::not_configured();
+    }
+    if (!frameData || !metadata || !callback)
+    {
+        throw rdk::exception::argument_null();
+    }
+    if (IFX_MDA_DIMENSIONS(frameData) != 1 || IFX_VEC_LEN(frameData) != getNumberOfSamples())
+    {
+        throw rdk::exception::dimension_mismatch();
+    }
+
+    if (!m_async)
+    {
+        // The restart discards the frames queued for getNextFrame. The
+        // listener is registered while the bridge thread is idle.
+        stopAcquisition();
+        m_async = true;
+        m_bridgeData->registerListener(this);
+        try
+        {
+            startAcquisition();
+        }
+        catch (...)
+        {
+            m_bridgeData->registerListener(nullptr);
+            m_async = false;
+            throw;
+        }
+    }
+
+    // called by the bridge thread when a callback queues the next request,
+    // so only the request queue is touched from here on
+    m_asyncRequests.push({frameData, metadata, callback, userData});
+}
+
+void DeviceLtr11::cancelAsync()
+{
+    if (!m_async)
+    {
+        return;
+    }
+
+    stopAcquisition();
+    // also waits for a call of onNewFrame to return
+    m_bridgeData->registerListener(nullptr);
+    m_async = false;
+    abortAsyncRequests();
+}
+
+void DeviceLtr11::abortAsyncRequests()
+{
+    for (const auto& request : m_asyncRequests.take_all())
+    {
+        request.callback(request.frame, request.metadata, IFX_ERROR_ABORTED, request.userData);
+    }
+}
+
+void DeviceLtr11::onNewFrame(IFrame* frame)
+{
+    SmartIFrame owner(frame);
+
+    AsyncRequest request;
+    if (!m_asyncRequests.pop(request))
+    {
+        // no request pending, drop the frame
+        return;
+    }
+
+    try
+    {
+        decodeFrame(frame, request.frame, request.metadata);
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        request.callback(request.frame, request.metadata, e.error_code(), request.userData);
+        return;
+    }
+    request.callback(request.frame, request.metadata, IFX_OK, request.userData);
+}
+
 void DeviceLtr11::softReset()
 {
     m_radarLtr11->getIPinsLtr11()->reset();
@@ -322,8 +474,6 @@ uint16_t DeviceLtr11::getNumberOfSamples() const
 
 void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs)
 {
-    const auto frameBufferSize = determineBufferSize();
-
     auto* deviceFrame = m_board->getFrame(timeoutMs);
 
     if (deviceFrame == nullptr)
@@ -336,6 +486,13 @@ void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t*
             deviceFrame->release();
         });
 
+    decodeFrame(deviceFrame, frameData, metadata);
+}
+
+void DeviceLtr11::decodeFrame(IFrame* deviceFrame, ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata)
+{
+    const auto frameBufferSize = determineBufferSize();
+
     const auto statusCode = deviceFrame->getStatusCode();
     switch (statusCode)
     {
@@ -388,16 +545,22 @@ void DeviceLtr11::readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t*
     const auto* dataAsUint = reinterpret_cast<const uint16_t*>(deviceFrame->getData());
 
     const auto numberOfSamples = getNumberOfSamples();
-    for (uint32_t i = 0; i < numberOfSamples; ++i)
+    if (IFX_VEC_STRIDE(frameData) == 1)
     {
+        ::convertIq(dataAsUint, frameStepping, numberOfSamples, IFX_VEC_DAT(frameData));
+    }
+    else
+    {
+        for (uint32_t i = 0; i < numberOfSamples; ++i)
+        {
+            const auto ifiIdx = (i * frameStepping);
+            // ifqIdx  = ifiIdx + 1
 
-        const auto ifiIdx = (i * frameStepping);
-        // ifqIdx  = ifiIdx + 1
-
-        const ifx_Float_t I = ::normalize(dataAsUint[ifiIdx]);
-        const ifx_Float_t Q = ::normalize(dataAsUint[ifiIdx + 1]);
+            const ifx_Float_t I = ::normalize(dataAsUint[ifiIdx]);
+            const ifx_Float_t Q = ::normalize(dataAsUint[ifiIdx + 1]);
 
-        IFX_VEC_AT(frameData, i) = IFX_COMPLEX_DEF(I, Q);
+            IFX_VEC_AT(frameData, i) = IFX_COMPLEX_DEF(I, Q);
+        }
     }
 
     metadata->motion = (dataAsUint[(numberOfSamples - 1) * frameStepping + detectorOutputIndex] & IFX_LTR11_DETECTOR_OUTPUT_MOTION_MASK) == IFX_LTR11_DETECTOR_OUTPUT_MOTION_MASK;
@@ -40,10 +40,12 @@
 
 #include "DeviceLtr11Base.hpp"
 #include "DeviceLtr11RegisterConfigurator.hpp"
+#include "ifxRadarDeviceCommon/internal/AsyncRequests.hpp"
 
 // strata
 #include <components/interfaces/IRegisters.hpp>
 #include <platform/BoardInstance.hpp>
+#include <platform/interfaces/IFrameListener.hpp>
 #include <universal/types/DataSettingsBgtRadar.h>
 
 #include <atomic>
@@ -55,7 +57,7 @@ class IRadarLtr11;
 class IProtocolLtr11;
 
 
-struct DeviceLtr11 : public DeviceLtr11Base
+struct DeviceLtr11 : public DeviceLtr11Base, private IFrameListener<>
 {
 public:
     NONCOPYABLE(DeviceLtr11);
@@ -71,6 +73,8 @@ public:
     void dumpRegisters(const char* filename) override;
 
     ifx_Vector_C_t* getNextFrame(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs) override;
+    void getNextFrameAsync(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, ifx_Ltr11_Async_Callback_t callback, void* userData) override;
+    void cancelAsync() override;
 
 private:
     void softReset();
@@ -88,6 +92,13 @@ private:
     uint16_t getNumberOfSamples() const;
 
     void readNextFrame(ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata, uint16_t timeoutMs);
+    void decodeFrame(IFrame* deviceFrame, ifx_Vector_C_t* frameData, ifx_Ltr11_Metadata_t* metadata);
+
+    // Asynchronous requests, see getNextFrameAsync. Once the first request is
+    // made the frames are delivered to onNewFrame on the bridge thread, each
+    // one into the buffers of the oldest pending request.
+    void onNewFrame(IFrame* frame) override;
+    void abortAsyncRequests();
 
     std::unique_ptr<BoardInstance> m_board;
 
@@ -110,4 +121,14 @@ private:
 
     float m_frameCounter;
     float m_averagePower;
+
+    struct AsyncRequest
+    {
+        ifx_Vector_C_t* frame;
+        ifx_Ltr11_Metadata_t* metadata;
+        ifx_Ltr11_Async_Callback_t callback;
+        void* userData;
+    };
+    rdk::AsyncRequests<AsyncRequest> m_asyncRequests;
+    std::atomic<bool> m_async {false};
 };
@@ -36,7 +36,9 @@
 #ifndef IFX_DEVICE_LTR11_TYPES_H
 #define IFX_DEVICE_LTR11_TYPES_H
 
+#include "ifxBase/Error.h"
 #include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
 
 
 /*
@@ -160,6 +162,17 @@ typedef struct
     bool direction;  /**< Direction of motion given by the LTR11 digital detector. */
 } ifx_Ltr11_Metadata_t;
 
+/**
+ * @brief Completes a request of @ref ifx_ltr11_get_next_frame_async.
+ *
+ * @param[in] frame      The frame data vector of the request, filled if error is IFX_OK.
+ * @param[in] metadata   The metadata structure of the request, filled if error is IFX_OK.
+ * @param[in] error      IFX_OK, the reason why no frame was received, or
+ *                       IFX_ERROR_ABORTED if the request was cancelled.
+ * @param[in] user_data  The pointer passed with the request.
+ */
+typedef void (*ifx_Ltr11_Async_Callback_t)(ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, ifx_Error_t error, void* user_data);
+
 /**
  * @brief LTR11 Configuration structure including the parameters exposed through the Fusion GUI.
  */
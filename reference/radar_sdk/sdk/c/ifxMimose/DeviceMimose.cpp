@@ -120,6 +120,16 @@ ifx_Cube_C_t* ifx_mimose_get_next_frame_timeout(ifx_Mimose_Device_t* handle, ifx
     return rdk::call_func(handle, &ifx_Mimose_Device_t::getNextFrame, nullptr, frame, metadata, timeout_ms);
 }
 
+void ifx_mimose_get_next_frame_async(ifx_Mimose_Device_t* handle, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Mimose_Async_Callback_t callback, void* user_data)
+{
+    rdk::call_func(handle, &ifx_Mimose_Device_t::getNextFrameAsync, frame, metadata, callback, user_data);
+}
+
+void ifx_mimose_cancel_async(ifx_Mimose_Device_t* handle)
+{
+    rdk::call_func(handle, &ifx_Mimose_Device_t::cancelAsync);
+}
+
 size_t ifx_mimose_get_register_count(ifx_Mimose_Device_t* handle)
 {
     return rdk::call_func(handle, &ifx_Mimose_Device_t::getRegisterCount);
@@ -145,6 +155,16 @@ void ifx_mimose_update_rc_lut(ifx_Mimose_Device_t* handle)
     return rdk::call_func(handle, &ifx_Mimose_Device_t::update_rc_lut);
 }
 
+void ifx_mimose_get_rc_lut(ifx_Mimose_Device_t* handle, float* lut)
+{
+    rdk::call_func(handle, &ifx_Mimose_Device_t::get_rc_lut, lut);
+}
+
+void ifx_mimose_set_rc_lut(ifx_Mimose_Device_t* handle, const float* lut)
+{
+    rdk::call_func(handle, &ifx_Mimose_Device_t::set_rc_lut, lut);
+}
+
 void ifx_mimose_get_default_limits(const ifx_Mimose_Device_t* handle, ifx_Mimose_Config_Limits_t* limits)
 {
     rdk::call_func(handle, &ifx_Mimose_Device_t::getDefaultLimits, limits);
@@ -170,6 +190,17 @@ ifx_List_t* ifx_mimose_get_list(void)
     return ifx_list_from_vector(list);
 }
 
+size_t ifx_mimose_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count)
+{
+    IFX_ERR_BRV_COND(count && !entries, IFX_ERROR_ARGUMENT_NULL, 0);
+
+    auto selector = [](const ifx_Radar_Sensor_List_Entry_t& entry) {
+        return rdk::RadarDeviceCommon::sensor_is_mimose(entry.sensor_type);
+    };
+
+    return rdk::RadarDeviceCommon::get_list(selector).copy_to(entries, count);
+}
+
 const ifx_Firmware_Info_t* ifx_mimose_get_firmware_information(ifx_Mimose_Device_t* handle)
 {
     return rdk::call_func(handle, &ifx_Mimose_Device_t::getFirmwareInformation);
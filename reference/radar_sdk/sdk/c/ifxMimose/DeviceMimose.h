@@ -119,6 +119,32 @@ int ifx_mimose_api_version(void);
 IFX_DLL_PUBLIC
 ifx_List_t* ifx_mimose_get_list(void);
 
+/**
+ * \brief Fills a caller-provided array with the available MIMOSE devices.
+ *
+ * The function is similar to \ref ifx_mimose_get_list but does not
+ * allocate a list. At most count entries are written to entries, the
+ * function returns the total number of devices found. If the return value
+ * is larger than count, the array was too small. entries may be NULL if
+ * count is 0, which allows to query the number of devices.
+ *
+ * Here is an example how to use the function:
+ * \code
+ *      ifx_Radar_Sensor_List_Entry_t entries[8];
+ *      size_t n = ifx_mimose_get_sensor_list(entries, 8);
+ *      for (size_t i = 0; i < n && i < 8; i++)
+ *      {
+ *          // entries[i] ...
+ *      }
+ * \endcode
+ *
+ * \param [out] entries     array of at least count entries
+ * \param [in]  count       number of entries the array can hold
+ * \return The function returns the number of devices found.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_mimose_get_sensor_list(ifx_Radar_Sensor_List_Entry_t* entries, size_t count);
+
 /**
  * \brief Returns the sensor information defined by \ref ifx_Radar_Sensor_Info_t.
  *
@@ -262,6 +288,53 @@ ifx_Cube_C_t* ifx_mimose_get_next_frame(ifx_Mimose_Device_t* handle, ifx_Cube_C_
 IFX_DLL_PUBLIC
 ifx_Cube_C_t* ifx_mimose_get_next_frame_timeout(ifx_Mimose_Device_t* handle, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeout_ms);
 
+/**
+ * \brief Requests the next frame without waiting for it.
+ *
+ * The request is queued and the function returns at once. When the next frame
+ * of the active frame configuration is complete it is written to *frame* and
+ * *metadata* and *callback* is called with \ref IFX_OK, a frame lost on the
+ * way completes the request with the error. Requests complete one per frame,
+ * in the order they were made. A frame arriving while no request is pending
+ * is dropped, so keep a second request queued to receive every frame.
+ *
+ * The callback runs on the thread receiving the data from the board and
+ * should return quickly. It may queue the next request, but must not call
+ * other functions of the device. See \ref ifx_fmcw_get_next_frame_async for
+ * an example.
+ *
+ * The first request starts the acquisition, restarting a running one.
+ * Stopping the acquisition keeps the pending requests. Until
+ * \ref ifx_mimose_cancel_async, \ref ifx_mimose_get_next_frame and
+ * \ref ifx_mimose_get_next_frame_timeout fail with \ref IFX_ERROR_NOT_POSSIBLE.
+ * Only supported for connected boards, other devices report
+ * \ref IFX_ERROR_NOT_SUPPORTED.
+ *
+ * \param [in] handle     A handle to the Mimose device.
+ * \param [in] frame      Cube of 1 row, a column per selected pulse
+ *                        configuration and a slice per sample of the active
+ *                        frame configuration. It must stay valid until the
+ *                        request is completed.
+ * \param [in] metadata   Metadata structure of the request. It must stay
+ *                        valid until the request is completed.
+ * \param [in] callback   Function completing the request.
+ * \param [in] user_data  Pointer passed to the callback.
+ */
+IFX_DLL_PUBLIC
+void ifx_mimose_get_next_frame_async(ifx_Mimose_Device_t* handle, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Mimose_Async_Callback_t callback, void* user_data);
+
+/**
+ * \brief Cancels all pending requests of \ref ifx_mimose_get_next_frame_async.
+ *
+ * Stops the acquisition and completes every pending request with
+ * \ref IFX_ERROR_ABORTED on the calling thread before returning. Destroying
+ * the device cancels the requests the same way.
+ *
+ * \param [in] handle     A handle to the Mimose device.
+ */
+IFX_DLL_PUBLIC
+void ifx_mimose_cancel_async(ifx_Mimose_Device_t* handle);
+
 /**
  * \brief Dumps registers to a file specified in argument.
  * \param [in]  handle     A handle to the MIMOSE device object.
@@ -320,6 +393,28 @@ uint16_t ifx_mimose_get_register_value(ifx_Mimose_Device_t* handle, uint16_t reg
 IFX_DLL_PUBLIC
 void ifx_mimose_update_rc_lut(ifx_Mimose_Device_t* handle);
 
+/**
+ * \brief Reads the RC look up table.
+ * The table holds the RC oscillator clock of each trim value as a fraction of the reference clock.
+ * It is measured by \ref ifx_mimose_update_rc_lut, which takes several register transfers per entry.
+ * An application can store the table and restore it with \ref ifx_mimose_set_rc_lut instead of
+ * measuring it again after a restart. Within a process, a table measured for a board is also used
+ * by devices created later for the same board.
+ * \param [in]  handle         A handle to the MIMOSE device object.
+ * \param [out] lut            Array of \ref IFX_MIMOSE_RC_LUT_SIZE entries.
+ */
+IFX_DLL_PUBLIC
+void ifx_mimose_get_rc_lut(ifx_Mimose_Device_t* handle, float* lut);
+
+/**
+ * \brief Sets the RC look up table, e.g. one read by \ref ifx_mimose_get_rc_lut before.
+ * The table is used by the next configuration with the RC clock enabled.
+ * \param [in]  handle         A handle to the MIMOSE device object.
+ * \param [in]  lut            Array of \ref IFX_MIMOSE_RC_LUT_SIZE entries.
+ */
+IFX_DLL_PUBLIC
+void ifx_mimose_set_rc_lut(ifx_Mimose_Device_t* handle, const float* lut);
+
 /**
  * \brief Reads sensor values at a synchronous period (temperature and center frequency).
  * \param [in]  handle         A handle to the MIMOSE device object.
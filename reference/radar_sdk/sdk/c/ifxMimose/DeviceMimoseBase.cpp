@@ -232,6 +232,16 @@ void DeviceMimoseBase::destroy_routine()
     // override by DeviceMimoseImpl
 }
 
+void DeviceMimoseBase::getNextFrameAsync(ifx_Cube_C_t* /*frame*/, ifx_Mimose_Metadata_t* /*metadata*/, ifx_Mimose_Async_Callback_t /*callback*/, void* /*userData*/)
+{
+    throw rdk::exception::not_supported();
+}
+
+void DeviceMimoseBase::cancelAsync()
+{
+    // no request can be pending
+}
+
 const ifx_Radar_Sensor_Info_t* DeviceMimoseBase::getSensorInfo()
 {
     static const int8_t empty_list8[] = {-1};
@@ -60,12 +60,16 @@ struct DeviceMimoseBase
     virtual void startAcquisition() = 0;
     virtual void stopAcquisition() = 0;
     virtual ifx_Cube_C_t* getNextFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis) = 0;
+    virtual void getNextFrameAsync(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Mimose_Async_Callback_t callback, void* userData);
+    virtual void cancelAsync();
     virtual void getSensorValues(ifx_Mimose_Sensor_t* sensorValues) = 0;
     virtual size_t getRegisterCount() = 0;
     virtual void getRegisters(uint32_t* registers) = 0;
     virtual void setRegisters(uint32_t* registers, size_t count) = 0;
     virtual uint16_t getRegisterValue(uint16_t register_address) = 0;
     virtual void update_rc_lut() = 0;
+    virtual void get_rc_lut(float* lut) const = 0;
+    virtual void set_rc_lut(const float* lut) = 0;
     virtual void dumpRegisters(const char* filename) const;
     virtual const ifx_Firmware_Info_t* getFirmwareInformation() const;
     virtual bool checkConfiguration(const ifx_Mimose_Config_t* config, uint16_t frameConfigIndex);
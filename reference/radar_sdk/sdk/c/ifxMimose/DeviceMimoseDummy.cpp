@@ -31,7 +31,9 @@
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Defines.h"
+#include "ifxBase/Exception.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <limits>
@@ -168,6 +170,24 @@ void DeviceMimoseDummy::update_rc_lut()
     // null op
 }
 
+void DeviceMimoseDummy::get_rc_lut(float* lut) const
+{
+    if (!lut)
+    {
+        throw rdk::exception::argument_null();
+    }
+    std::copy(m_rcLut.begin(), m_rcLut.end(), lut);
+}
+
+void DeviceMimoseDummy::set_rc_lut(const float* lut)
+{
+    if (!lut)
+    {
+        throw rdk::exception::argument_null();
+    }
+    std::copy(lut, lut + m_rcLut.size(), m_rcLut.begin());
+}
+
 std::vector<ifx_Float_t> DeviceMimoseDummy::generateWave()
 {
     if (m_time >= std::numeric_limits<float>::max())
@@ -40,6 +40,7 @@
 
 #include "DeviceMimoseBase.hpp"
 
+#include <array>
 #include <vector>
 
 
@@ -59,6 +60,8 @@ struct DeviceMimoseDummy : public DeviceMimoseBase
     void setRegisters(uint32_t* registers, size_t count) override;
     uint16_t getRegisterValue(uint16_t register_address) override;
     void update_rc_lut() override;
+    void get_rc_lut(float* lut) const override;
+    void set_rc_lut(const float* lut) override;
 
 private:
     void prepareWaveGeneration(uint16_t numOfSamples,
@@ -68,6 +71,7 @@ private:
     std::vector<ifx_Float_t> generateWave();
 
     uint64_t m_delay;
+    std::array<float, IFX_MIMOSE_RC_LUT_SIZE> m_rcLut = {};
 
     // Wave generation attributes
     //
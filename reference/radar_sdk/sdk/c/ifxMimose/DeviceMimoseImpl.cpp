@@ -41,12 +41,16 @@
 #include <components/interfaces/IRadarAtr22.hpp>
 #include <platform/interfaces/IBridgeControl.hpp>
 #include <platform/interfaces/IBridgeData.hpp>
+#include <platform/interfaces/IFrame.hpp>
 
 #include <array>
 #include <cassert>
 #include <cstring>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <string>
 #include <vector>
 
 
@@ -56,6 +60,11 @@ const std::array<uint16_t, 3> minVersion {2, 5, 3};
 constexpr uint16_t RAW_DATA_MEMORY_ADDRESS = 0x3800;
 constexpr uint8_t TWO_READOUT_CONFIGS = 2;
 
+// RC look up tables measured or set for a board, by board UUID. A device created
+// later for the same board starts with the table instead of the default one.
+std::mutex rcLutCacheMutex;
+std::map<std::string, std::vector<float>> rcLutCache;
+
 const IDataProperties_t properties = {};
 
 void checkFrameDimensions(const ifx_Cube_C_t* frame, const ifx_Mimose_Frame_Config_t& currentConfig)
@@ -147,30 +156,25 @@ void fillMetaData(ifx_Mimose_Metadata_t* metadata,
     }
 }
 
-enum RawDataSubType
-{
-    FirstHalf,
-    SecondHalf
-};
-
-void fillBuffer(std::vector<uint16_t>& toFill, const uint16_t* rawData, const size_t numSamples, const size_t numPulses, RawDataSubType rawDataSubType)
+/* Converts num_words of the IQ memory of each pulse into the samples of frame.
+ * The words of a pulse start at word first_word of its IQ memory, so that the
+ * halves of a pulse read in equidistant sampling mode land at their samples.
+ */
+void convertPulseWords(ifx_Cube_C_t* frame, const uint16_t* words, uint16_t numPulses, uint32_t numWords, uint32_t firstWord, uint32_t numSamplesReturned)
 {
-    const auto* begin = rawData;
-    const auto* end = begin;
-
-    for (size_t i = 0; i < numPulses; ++i)
+    for (uint16_t pulseIdx = 0; pulseIdx < numPulses; ++pulseIdx)
     {
-
-        begin = end;
-        end += numSamples;
-
-        // the destination buffer offset is the offset at which position the half pulse need to be stored
-        size_t destBuffOffset = (rawDataSubType == RawDataSubType::FirstHalf) ? 0 : numSamples;
-        destBuffOffset += (i * (numSamples * 2));
-
-        auto* dest = (toFill.data() + destBuffOffset);
-
-        std::copy(begin, end, dest);
+        for (uint32_t w = 0; w < numWords; ++w)
+        {
+            const auto word = firstWord + w;
+            const auto sample = word / 2;  // words are pairs of I and Q
+            if (sample >= numSamplesReturned)
+            {
+                break;
+            }
+            IFX_CUBE_AT(frame, 0, pulseIdx, sample).data[word % 2] = ::toFloat(words[w]);
+        }
+        words += numWords;
     }
 }
 
@@ -255,6 +259,15 @@ DeviceMimose::DeviceMimose(std::unique_ptr<BoardInstance>&& board) :
     m_regConfig = std::make_unique<DeviceMimoseRegisterConfigurator>(m_regs);
 
     m_regConfig->reset();
+
+    {
+        std::lock_guard<std::mutex> lock(rcLutCacheMutex);
+        const auto cached = rcLutCache.find(m_board->getUuidString());
+        if (cached != rcLutCache.end())
+        {
+            m_regConfig->setTrimLutRC(cached->second.data());
+        }
+    }
 }
 
 /*virtual*/
@@ -274,6 +287,11 @@ DeviceMimose::~DeviceMimose()
         // Anyhow, if the device is longer present, it is also not necessary to
         // stop the acquisition.
     }
+    if (m_async)
+    {
+        m_bridgeData->registerListener(nullptr);
+    }
+    abortAsyncRequests();
 }
 
 void DeviceMimose::destroy_routine()
@@ -461,11 +479,6 @@ void DeviceMimose::startAcquisition()
     // reset the stored afc
     m_currentAfc = 0;
 
-    if (m_samplingMode == SamplingMode::EquidistantSampling)
-    {
-        const auto rawDataBufferSize = (m_frameBufferSize / IQ_SAMPLE_SIZE);
-        m_equidistantSamplingTraits.m_rawDataBuffer.resize(rawDataBufferSize);  // frame buffer size is expressed in bytes while the raw buffer in uint16's
-    }
     m_acquisitionStarted = true;
 }
 
@@ -512,6 +525,31 @@ uint16_t DeviceMimose::getRegisterValue(uint16_t register_address)
 void DeviceMimose::update_rc_lut()
 {
     m_regConfig->updateTrimLutRC(IFX_MIMOSE_REF_CLK_HZ_DEFAULT);
+
+    std::lock_guard<std::mutex> lock(rcLutCacheMutex);
+    rcLutCache[m_board->getUuidString()] = m_regConfig->getTrimLutRC();
+}
+
+void DeviceMimose::get_rc_lut(float* lut) const
+{
+    if (!lut)
+    {
+        throw rdk::exception::argument_null();
+    }
+    const auto& table = m_regConfig->getTrimLutRC();
+    std::copy(table.begin(), table.end(), lut);
+}
+
+void DeviceMimose::set_rc_lut(const float* lut)
+{
+    if (!lut)
+    {
+        throw rdk::exception::argument_null();
+    }
+    m_regConfig->setTrimLutRC(lut);
+
+    std::lock_guard<std::mutex> lock(rcLutCacheMutex);
+    rcLutCache[m_board->getUuidString()] = m_regConfig->getTrimLutRC();
 }
 
 ifx_Cube_C_t* DeviceMimose::getNextFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis)
@@ -520,6 +558,11 @@ ifx_Cube_C_t* DeviceMimose::getNextFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadat
     {
         throw rdk::exception::not_configured();
     }
+    if (m_async)
+    {
+        // frames are delivered to the pending requests, see getNextFrameAsync()
+        throw rdk::exception::not_possible();
+    }
 
     bool frameDataMemoryAllocated;
     if (!frame)
@@ -557,6 +600,94 @@ ifx_Cube_C_t* DeviceMimose::getNextFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadat
     return frame;
 }
 
+void DeviceMimose::getNextFrameAsync(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Mimose_Async_Callback_t callback, void* userData)
+{
+    if (!m_frameConfigValid)
+    {
+        throw rdk::exception::not_configured();
+    }
+    if (!frame || !metadata || !callback)
+    {
+        throw rdk::exception::argument_null();
+    }
+    checkFrameDimensions(frame, m_config.frame_config[m_activeFrameIndex]);
+
+    if (!m_async)
+    {
+        // The restart discards the frames queued for getNextFrame. The
+        // listener is registered while the bridge thread is idle.
+        stopAcquisition();
+        m_async = true;
+        m_bridgeData->registerListener(this);
+        try
+        {
+            startAcquisition();
+        }
+        catch (...)
+        {
+            m_bridgeData->registerListener(nullptr);
+            m_async = false;
+            throw;
+        }
+    }
+
+    // called by the bridge thread when a callback queues the next request,
+    // so only the request queue is touched from here on
+    m_asyncRequests.push({frame, metadata, callback, userData});
+}
+
+void DeviceMimose::cancelAsync()
+{
+    if (!m_async)
+    {
+        return;
+    }
+
+    stopAcquisition();
+    // also waits for a call of onNewFrame to return
+    m_bridgeData->registerListener(nullptr);
+    m_async = false;
+    abortAsyncRequests();
+}
+
+void DeviceMimose::abortAsyncRequests()
+{
+    for (const auto& request : m_asyncRequests.take_all())
+    {
+        request.callback(request.frame, request.metadata, IFX_ERROR_ABORTED, request.userData);
+    }
+}
+
+void DeviceMimose::onNewFrame(IFrame* deviceFrame)
+{
+    SmartIFrame owner(deviceFrame);
+
+    // the request stays at the front until the last device frame of its
+    // frame has been converted
+    AsyncRequest request;
+    if (!m_asyncRequests.front(request))
+    {
+        // no request pending, drop the device frame
+        return;
+    }
+
+    ifx_Error_t error = IFX_OK;
+    try
+    {
+        if (!decodeDeviceFrame(deviceFrame, request.frame, request.metadata))
+        {
+            return;
+        }
+    }
+    catch (const rdk::exception::exception& e)
+    {
+        error = e.error_code();
+    }
+
+    m_asyncRequests.pop(request);
+    request.callback(request.frame, request.metadata, error, request.userData);
+}
+
 void DeviceMimose::getSensorValues(ifx_Mimose_Sensor_t* sensorValues)
 {
     const auto currentAfcValue = m_currentAfc.load();
@@ -909,19 +1040,27 @@ uint32_t DeviceMimose::getFrameBufferSize(const ReadoutDataConfiguration& readou
     return (bufferSize * sizeof(uint16_t));
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
 void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis)
 {
-    IFrame* deviceFrame = m_board->getFrame(timeoutMillis);
-    if (!deviceFrame)
+    while (true)
     {
-        throw rdk::exception::timeout();
+        SmartIFrame deviceFrame(m_board->getFrame(timeoutMillis));
+        if (!deviceFrame)
+        {
+            throw rdk::exception::timeout();
+        }
+        if (decodeDeviceFrame(deviceFrame.get(), frame, metadata))
+        {
+            return;
+        }
     }
+}
 
+bool DeviceMimose::decodeDeviceFrame(IFrame* deviceFrame, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata)
+{
     const auto statusCode = deviceFrame->getStatusCode();
     if (statusCode != 0)
     {
-        deviceFrame->release();
         switch (statusCode)
         {
             case DataError_FramePoolDepleted:
@@ -964,7 +1103,6 @@ void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* meta
         }
         if (deviceFrame->getDataSize() != expectedFrameSize)
         {
-            deviceFrame->release();
             throw rdk::exception::frame_size_not_supported();
         }
     }
@@ -973,61 +1111,53 @@ void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* meta
         m_config.frame_config[m_activeFrameIndex].selected_pulse_configs);
     const auto* samples = reinterpret_cast<const uint16_t*>(deviceFrame->getData());
 
-    if (equidistantSampling)
-    {
-        if (frameChannel == m_dataIndex)
-        {
-            ::fillBuffer(m_equidistantSamplingTraits.m_rawDataBuffer, samples, m_numSamplesForNextPulseInMem, pulsesToRead, RawDataSubType::FirstHalf);
-            deviceFrame->release();
-            return readRawFrame(frame, metadata, timeoutMillis);
-        }
-        else if (frameChannel == m_dataIndex2)
-        {
-            ::fillBuffer(m_equidistantSamplingTraits.m_rawDataBuffer, samples, m_numSamplesForNextPulseInMem, pulsesToRead, RawDataSubType::SecondHalf);
+    const auto iqNumSamplesPerPulseMemSize = (m_numSamplesForNextPulseInMem * IQ_SAMPLE_SIZE);  // expressed in uint16_t's as pairs of IQ's (x2)
 
-            const auto rem = (deviceFrame->getDataSize() / sizeof(uint16_t)) - (static_cast<size_t>(m_numSamplesForNextPulseInMem) * pulsesToRead);
-            if (rem > 0)
-            {
-                const auto fromOffset = (m_numSamplesForNextPulseInMem * pulsesToRead);
-                const auto toOffset = (fromOffset + rem);
-                std::copy((samples + fromOffset), (samples + toOffset), (m_equidistantSamplingTraits.m_rawDataBuffer.data() + (static_cast<size_t>(m_numSamplesForNextPulseInMem) * pulsesToRead * IQ_SAMPLE_SIZE)));
-            }
-        }
+    // Offset of the readouts following the raw data in the device frame. In equidistant
+    // sampling mode each half of the pulses arrives in its own device frame and is
+    // converted into the user frame directly, the readouts follow the second half.
+    size_t rawDataWordsInFrame = static_cast<size_t>(iqNumSamplesPerPulseMemSize) * pulsesToRead;
+    if (equidistantSampling && (frameChannel == m_dataIndex))
+    {
+        ::convertPulseWords(frame, samples, pulsesToRead, m_numSamplesForNextPulseInMem, 0, m_numSamplesReturned);
+        return false;
     }
-
-    const auto totalSampleCount = (m_frameBufferSize / sizeof(uint16_t));
-
-    if (equidistantSampling)
+    else if (equidistantSampling && (frameChannel == m_dataIndex2))
     {
-        samples = m_equidistantSamplingTraits.m_rawDataBuffer.data();
-        if (totalSampleCount != m_equidistantSamplingTraits.m_rawDataBuffer.size())
-        {
-            deviceFrame->release();
-            throw rdk::exception::internal();
-        }
+        ::convertPulseWords(frame, samples, pulsesToRead, m_numSamplesForNextPulseInMem, m_numSamplesForNextPulseInMem, m_numSamplesReturned);
+        rawDataWordsInFrame = static_cast<size_t>(m_numSamplesForNextPulseInMem) * pulsesToRead;
+    }
+    else if (!equidistantSampling && (frameChannel == m_dataIndex))
+    {
+        ::convertPulseWords(frame, samples, pulsesToRead, iqNumSamplesPerPulseMemSize, 0, m_numSamplesReturned);
+    }
+    else
+    {
+        // status data does not belong to a frame
+        return false;
     }
 
-    const auto iqNumSamplesPerPulseMemSize = (m_numSamplesForNextPulseInMem * IQ_SAMPLE_SIZE);  // expressed in uint16_t's as pairs of IQ's (x2)
+    const auto totalSampleCount = (deviceFrame->getDataSize() / sizeof(uint16_t));
 
-    constexpr auto RAW_MEM_REGION_INDEX = 0;
-    // constexpr auto FRAME_COUNTER_REGION_INDEX = 1;
-    constexpr auto VCO_REGION_INDEX = 2;
-    constexpr auto AOC_REGION_INDEX = 3;
-    constexpr auto AGC_REGION_INDEX = 4;
+    // constexpr auto FRAME_COUNTER_REGION_INDEX = 0;
+    constexpr auto VCO_REGION_INDEX = 1;
+    constexpr auto AOC_REGION_INDEX = 2;
+    constexpr auto AGC_REGION_INDEX = 3;
 
-    // create MemoryRegions
+    // create MemoryRegions of the readouts following the raw data
     MemoryRegions dataMemoryRegions;
     try
     {
-        dataMemoryRegions.reserve(m_frameSpecificReadoutConfiguration.size());
+        dataMemoryRegions.reserve(m_frameSpecificReadoutConfiguration.size() - 1);
 
-        const uint16_t* memBegin = samples;
+        const uint16_t* memBegin = samples + rawDataWordsInFrame;
         const uint16_t* memEnd = memBegin;
 
-        uint32_t mapped = 0;
+        auto mapped = rawDataWordsInFrame;
 
-        for (const auto& readoutConf : m_frameSpecificReadoutConfiguration)
+        for (size_t i = 1; i < m_frameSpecificReadoutConfiguration.size(); ++i)
         {
+            const auto& readoutConf = m_frameSpecificReadoutConfiguration[i];
             memEnd += readoutConf.count;
             mapped += readoutConf.count;
 
@@ -1037,7 +1167,6 @@ void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* meta
             }
             else
             {
-                deviceFrame->release();
                 throw rdk::exception::insufficient_memory_allocated();
             }
             memBegin = memEnd;
@@ -1045,7 +1174,6 @@ void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* meta
     }
     catch (const std::out_of_range&)
     {
-        deviceFrame->release();
         throw rdk::exception::internal();
     }
 
@@ -1064,30 +1192,7 @@ void DeviceMimose::readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* meta
     const auto& agcMemory = dataMemoryRegions[AGC_REGION_INDEX];
     ::fillMetaData(metadata, aocMemory.first, agcMemory.first, pulsesToRead);
 
-    const auto* pulseMemory = dataMemoryRegions[RAW_MEM_REGION_INDEX].first;
-
-    // perform n reads according to the number of expected pulses
-    for (uint16_t pulseIdx = 0; pulseIdx < pulsesToRead; ++pulseIdx)
-    {
-        for (uint32_t i = 0; i < m_numSamplesReturned; ++i)
-        {
-
-            const auto ifiIdx = (i * 2);
-            // ifqIdx  = ifiIdx + 1
-
-            const ifx_Float_t I = ::toFloat(pulseMemory[ifiIdx]);
-            const ifx_Float_t Q = ::toFloat(pulseMemory[ifiIdx + 1]);
-
-            IFX_CUBE_AT(frame, 0, pulseIdx, i) = ifx_Complex_t {I, Q};
-        }
-        pulseMemory += iqNumSamplesPerPulseMemSize;
-    }
-    deviceFrame->release();
-
-    if (pulseMemory != dataMemoryRegions[RAW_MEM_REGION_INDEX].second)
-    {
-        throw rdk::exception::internal();
-    }
+    return true;
 }
 
 /* This function returns the time required to read a frame from the memory, including the initialization setup time for the i2c. */
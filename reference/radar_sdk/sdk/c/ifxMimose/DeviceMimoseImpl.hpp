@@ -41,10 +41,12 @@
 #include "DeviceMimoseBase.hpp"
 
 #include "ifxBase/internal/NonCopyable.hpp"
+#include "ifxRadarDeviceCommon/internal/AsyncRequests.hpp"
 
 // strata
 #include <components/interfaces/IRegisters.hpp>
 #include <platform/BoardInstance.hpp>
+#include <platform/interfaces/IFrameListener.hpp>
 #include <universal/types/DataSettingsBgtRadar.h>
 
 #include <atomic>
@@ -62,13 +64,12 @@ struct EquidistantSamplingTraits
     uint16_t m_triggerCount;
     uint32_t m_frameBufferFirstHalfSize;
     uint32_t m_frameBufferSecondHalfSize;
-    std::vector<uint16_t> m_rawDataBuffer;
 };
 
 
 class DeviceMimoseRegisterConfigurator;
 
-struct DeviceMimose : public DeviceMimoseBase
+struct DeviceMimose : public DeviceMimoseBase, private IFrameListener<>
 {
     NONCOPYABLE(DeviceMimose);
     DeviceMimose(std::unique_ptr<BoardInstance>&& board);
@@ -80,6 +81,8 @@ struct DeviceMimose : public DeviceMimoseBase
     void startAcquisition() override;
     void stopAcquisition() override;
     ifx_Cube_C_t* getNextFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis) override;
+    void getNextFrameAsync(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Mimose_Async_Callback_t callback, void* userData) override;
+    void cancelAsync() override;
     void getSensorValues(ifx_Mimose_Sensor_t* sensorValues) override;
     void dumpRegisters(const char* filename) const override;
     size_t getRegisterCount() override;
@@ -87,6 +90,8 @@ struct DeviceMimose : public DeviceMimoseBase
     void setRegisters(uint32_t* registers, size_t count) override;
     uint16_t getRegisterValue(uint16_t register_address) override;
     void update_rc_lut() override;
+    void get_rc_lut(float* lut) const override;
+    void set_rc_lut(const float* lut) override;
     void setAOCModeAndUpdateConfig(const ifx_Mimose_AOC_Mode_t aocMode[4]) override;
 
 private:
@@ -173,4 +178,25 @@ private:
     static uint32_t getFrameBufferSize(const ReadoutDataConfiguration& readoutConfiguration);
 
     void readRawFrame(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, uint16_t timeoutMillis);
+    // Converts one device frame into frame and metadata. Returns false if the
+    // device frame does not complete a frame: the first half in equidistant
+    // sampling mode, or status data.
+    bool decodeDeviceFrame(IFrame* deviceFrame, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata);
+
+    // Asynchronous requests, see getNextFrameAsync. Once the first request is
+    // made the device frames are delivered to onNewFrame on the bridge
+    // thread and converted into the buffers of the oldest pending request,
+    // which is completed with the last device frame of the frame.
+    void onNewFrame(IFrame* deviceFrame) override;
+    void abortAsyncRequests();
+
+    struct AsyncRequest
+    {
+        ifx_Cube_C_t* frame;
+        ifx_Mimose_Metadata_t* metadata;
+        ifx_Mimose_Async_Callback_t callback;
+        void* userData;
+    };
+    rdk::AsyncRequests<AsyncRequest> m_asyncRequests;
+    std::atomic<bool> m_async {false};
 };
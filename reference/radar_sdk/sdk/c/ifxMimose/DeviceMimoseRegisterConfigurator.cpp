@@ -844,6 +844,15 @@ uint32_t DeviceMimoseRegisterConfigurator::getSystemClockRC(uint32_t reference_c
     reg_clk_conf.TRIM_VAL = static_cast<uint16_t>(min_idx);
     reg_clk_conf.RC_COUNT = 1;
     addSetRegister({BGT24ATR22_RC_CLK_CONF_REG_ADDR, reg_clk_conf.value});
+
+    // the clock of a trim value is only measured once, the registers are written with the rest of the configuration
+    const auto key = std::make_pair(reference_clock_Hz, min_idx);
+    const auto cached = m_rcSystemClocks.find(key);
+    if (cached != m_rcSystemClocks.end())
+    {
+        return cached->second;
+    }
+
     flushEnqRegisters();
     uint16_t trim_count = readRegisterValue(BGT24ATR22_RC_TRIM_VAL_REG_ADDR);
     float_t system_clock_Hz = (static_cast<float_t>(reference_clock_Hz) / N_sys_clk) * static_cast<float_t>(trim_count);
@@ -851,6 +860,7 @@ uint32_t DeviceMimoseRegisterConfigurator::getSystemClockRC(uint32_t reference_c
     {
         throw rdk::exception::argument_out_of_bounds();
     }
+    m_rcSystemClocks[key] = static_cast<uint32_t>(system_clock_Hz);
     return static_cast<uint32_t>(system_clock_Hz);
 }
 
@@ -877,6 +887,18 @@ void DeviceMimoseRegisterConfigurator::updateTrimLutRC(uint32_t reference_clock_
         uint16_t trim_value = readRegisterValue(BGT24ATR22_RC_TRIM_VAL_REG_ADDR);
         m_rcTrimLut.at(trim_idx) = static_cast<float_t>(trim_value) / N_sys_clk;
     }
+    m_rcSystemClocks.clear();
+}
+
+const std::vector<float>& DeviceMimoseRegisterConfigurator::getTrimLutRC() const
+{
+    return m_rcTrimLut;
+}
+
+void DeviceMimoseRegisterConfigurator::setTrimLutRC(const float* lut)
+{
+    std::copy(lut, lut + m_rcTrimLut.size(), m_rcTrimLut.begin());
+    m_rcSystemClocks.clear();
 }
 
 uint32_t DeviceMimoseRegisterConfigurator::addClockConfigRegisters(uint32_t reference_clock_Hz,
@@ -40,6 +40,7 @@
 #include <components/interfaces/IRegisters.hpp>
 
 #include <array>
+#include <map>
 #include <vector>
 
 class DeviceMimoseRegisterConfigurator
@@ -88,6 +89,8 @@ public:
     void addOscilatorSourceRegister(ifx_Mimose_Clock_Config_t clock_config);
     uint32_t getSystemClockRC(uint32_t reference_clock_Hz, uint32_t desired_sys_clock_Hz);
     void updateTrimLutRC(uint32_t reference_clock_Hz);
+    const std::vector<float>& getTrimLutRC() const;
+    void setTrimLutRC(const float* lut);
     uint32_t addClockConfigRegisters(uint32_t reference_clock_Hz,
                                      uint32_t desired_sys_clock_Hz,
                                      bool rc_clock_enabled,
@@ -139,4 +142,6 @@ private:
     IRegisters<address_t, value_t>* m_registers;
     std::vector<BatchType> m_registerQueue;
     std::vector<float> m_rcTrimLut;
+    // system clock measured by getSystemClockRC, by reference clock and trim value
+    std::map<std::pair<uint32_t, size_t>, uint32_t> m_rcSystemClocks;
 };
@@ -38,6 +38,8 @@
 #ifndef IFX_DEVICE_MIMOSE_TYPES_H
 #define IFX_DEVICE_MIMOSE_TYPES_H
 
+#include "ifxBase/Cube.h"
+#include "ifxBase/Error.h"
 #include "ifxBase/Types.h"
 
 
@@ -59,6 +61,11 @@ extern "C"
  * @{
  */
 
+/**
+ * @brief Number of entries of the RC oscillator trim look-up table, see \ref ifx_mimose_get_rc_lut.
+ */
+#define IFX_MIMOSE_RC_LUT_SIZE 32
+
 /**
  * @brief Defines the channel type by the TX and RX configuration (expressed as a pair / combination of the two TX and RX).
  *
@@ -206,6 +213,17 @@ typedef struct
     int16_t aoc_offsets[4][2]; /**< Aoc offset data, one offset pair per each pulse */
 } ifx_Mimose_Metadata_t;
 
+/**
+ * @brief Completes a request of @ref ifx_mimose_get_next_frame_async.
+ *
+ * @param[in] frame      The frame cube of the request, filled if error is IFX_OK.
+ * @param[in] metadata   The metadata structure of the request, filled if error is IFX_OK.
+ * @param[in] error      IFX_OK, the reason why no frame was received, or
+ *                       IFX_ERROR_ABORTED if the request was cancelled.
+ * @param[in] user_data  The pointer passed with the request.
+ */
+typedef void (*ifx_Mimose_Async_Callback_t)(ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Error_t error, void* user_data);
+
 /* forward declarations */
 
 typedef struct DeviceMimoseBase ifx_Mimose_Device_t;
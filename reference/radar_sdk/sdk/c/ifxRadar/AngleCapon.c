@@ -42,6 +42,7 @@
 #include "ifxBase/Cube.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/ComplexInline.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/LA.h"
 #include "ifxBase/Matrix.h"
@@ -79,8 +80,15 @@ struct ifx_AngleCapon_s
     ifx_Vector_C_t* range_pulse_scalar;     /**< Range pulse scalar matrix.*/
     ifx_Matrix_C_t* range_pulse_covariance; /**< Range pulse covariance matrix.*/
     ifx_Vector_R_t* angle_vector;           /**< Angle vector covering the radar FoV.*/
-    ifx_Matrix_C_t* inverse;                /**< ... */
-    ifx_Vector_C_t* tmp_vec;                /**< ... */
+    ifx_Matrix_C_t* inverse;                /**< Inverse of the range pulse covariance matrix.*/
+    ifx_Float_t diagonal_loading;           /**< Diagonal loading relative to the mean antenna power.*/
+    ifx_Matrix_R_t* steering_power;         /**< |w_i|^2 for each beam (row) and antenna (column).*/
+    ifx_Matrix_C_t* steering_pairs;         /**< conj(w_i)*w_j for each beam (row) and antenna pair i < j (column).*/
+    ifx_Vector_R_t* inverse_diag;           /**< Diagonal of inverse.*/
+    ifx_Vector_C_t* inverse_pairs;          /**< Upper triangle of inverse, in the column order of steering_pairs.*/
+    uint32_t num_pairs;                     /**< Number of antenna pairs.*/
+    ifx_Vector_C_t* tmp_vec;                /**< inverse*w for more than 3 antennas.*/
+    ifx_Matrix_C_t* rx_slices;              /**< Views of the spectrum of each antenna.*/
 };
 
 /*
@@ -110,11 +118,29 @@ static void init_range_pulse_scalar(const ifx_AngleCapon_Config_t* config,
 static void init_weights(ifx_Matrix_C_t* weights,
                          const ifx_AngleCapon_Config_t* config);
 
+static void init_steering(const ifx_Matrix_C_t* weights,
+                          ifx_Matrix_R_t* steering_power,
+                          ifx_Matrix_C_t* steering_pairs);
+
 static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
                                  uint16_t range_idx,
                                  uint16_t num_chirps,
                                  uint16_t neighboring_bins);
 
+/**
+ * @brief Inverts a Hermitian matrix, in closed form up to 3x3 antennas and
+ *        with the LU decomposition of \ref ifx_la_invert_c otherwise.
+ */
+static void invert_hermitian(const ifx_Matrix_C_t* A,
+                             ifx_Matrix_C_t* Ainv);
+
+/**
+ * @brief Estimates the angle of the target in range_bin from the spectra in handle->rx_slices.
+ */
+static ifx_Float_t estimate_angle(const ifx_AngleCapon_t* handle,
+                                  uint32_t range_bin,
+                                  const ifx_Matrix_C_t* rx_channel);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -185,6 +211,34 @@ static void init_weights(ifx_Matrix_C_t* weights,
 
 //----------------------------------------------------------------------------
 
+static void init_steering(const ifx_Matrix_C_t* weights,
+                          ifx_Matrix_R_t* steering_power,
+                          ifx_Matrix_C_t* steering_pairs)
+{
+    /* With a Hermitian inverse R the Capon denominator w^H*R*w is
+     *   sum_i R_ii*|w_i|^2 + 2*Re(sum_{i<j} R_ij*conj(w_i)*w_j),
+     * so the products of the steering vector are computed once here.
+     */
+    const uint32_t num_antennas = mRows(weights);
+
+    for (uint32_t beam = 0; beam < mCols(weights); beam++)
+    {
+        uint32_t pair = 0;
+        for (uint32_t i = 0; i < num_antennas; i++)
+        {
+            const ifx_Complex_t wi = mAt(weights, i, beam);
+            mAt(steering_power, beam, i) = IFX_COMPLEX_REAL(wi) * IFX_COMPLEX_REAL(wi) + IFX_COMPLEX_IMAG(wi) * IFX_COMPLEX_IMAG(wi);
+
+            for (uint32_t j = i + 1; j < num_antennas; j++)
+            {
+                mAt(steering_pairs, beam, pair++) = ifx_cmul(ifx_cconj(wi), mAt(weights, j, beam));
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
 static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
                                  uint16_t range_idx,
                                  uint16_t num_chirps,
@@ -212,6 +266,192 @@ static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
     return doppler_idx;
 }
 
+//----------------------------------------------------------------------------
+
+static void invert_hermitian(const ifx_Matrix_C_t* A,
+                             ifx_Matrix_C_t* Ainv)
+{
+#define RE(m, r, c) IFX_COMPLEX_REAL(mAt(m, r, c))
+#define IM(m, r, c) IFX_COMPLEX_IMAG(mAt(m, r, c))
+#define SET(m, r, c, re, im)                 \
+    do                                       \
+    {                                        \
+        IFX_COMPLEX_SET(mAt(m, r, c), re, im); \
+        IFX_COMPLEX_SET(mAt(m, c, r), re, -(im)); \
+    } while (0)
+
+    switch (mRows(A))
+    {
+        case 1:
+            IFX_COMPLEX_SET(mAt(Ainv, 0, 0), 1 / RE(A, 0, 0), 0);
+            break;
+
+        case 2:
+        {
+            // [a b; b* d]^-1 = [d -b; -b* a] / (a*d - |b|^2)
+            const ifx_Float_t a = RE(A, 0, 0);
+            const ifx_Float_t d = RE(A, 1, 1);
+            const ifx_Float_t br = RE(A, 0, 1);
+            const ifx_Float_t bi = IM(A, 0, 1);
+            const ifx_Float_t inv_det = 1 / (a * d - (br * br + bi * bi));
+
+            IFX_COMPLEX_SET(mAt(Ainv, 0, 0), d * inv_det, 0);
+            IFX_COMPLEX_SET(mAt(Ainv, 1, 1), a * inv_det, 0);
+            SET(Ainv, 0, 1, -br * inv_det, -bi * inv_det);
+            break;
+        }
+
+        case 3:
+        {
+            // [a b c; b* d e; c* e* f]^-1 = adjugate / determinant
+            const ifx_Float_t a = RE(A, 0, 0);
+            const ifx_Float_t d = RE(A, 1, 1);
+            const ifx_Float_t f = RE(A, 2, 2);
+            const ifx_Float_t br = RE(A, 0, 1), bi = IM(A, 0, 1);
+            const ifx_Float_t cr = RE(A, 0, 2), ci = IM(A, 0, 2);
+            const ifx_Float_t er = RE(A, 1, 2), ei = IM(A, 1, 2);
+            const ifx_Float_t b2 = br * br + bi * bi;
+            const ifx_Float_t c2 = cr * cr + ci * ci;
+            const ifx_Float_t e2 = er * er + ei * ei;
+
+            // Re(b*e*c^*)
+            const ifx_Float_t bec = (br * er - bi * ei) * cr + (br * ei + bi * er) * ci;
+            const ifx_Float_t inv_det = 1 / (a * d * f + 2 * bec - a * e2 - d * c2 - f * b2);
+
+            IFX_COMPLEX_SET(mAt(Ainv, 0, 0), (d * f - e2) * inv_det, 0);
+            IFX_COMPLEX_SET(mAt(Ainv, 1, 1), (a * f - c2) * inv_det, 0);
+            IFX_COMPLEX_SET(mAt(Ainv, 2, 2), (a * d - b2) * inv_det, 0);
+            // (c*e^* - b*f), (b*e - c*d), (c*b^* - a*e)
+            SET(Ainv, 0, 1, (cr * er + ci * ei - br * f) * inv_det, (ci * er - cr * ei - bi * f) * inv_det);
+            SET(Ainv, 0, 2, (br * er - bi * ei - cr * d) * inv_det, (br * ei + bi * er - ci * d) * inv_det);
+            SET(Ainv, 1, 2, (cr * br + ci * bi - a * er) * inv_det, (ci * br - cr * bi - a * ei) * inv_det);
+            break;
+        }
+
+        default:
+            ifx_la_invert_c(A, Ainv);
+            break;
+    }
+
+#undef SET
+#undef IM
+#undef RE
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Float_t estimate_angle(const ifx_AngleCapon_t* handle,
+                                  uint32_t range_bin,
+                                  const ifx_Matrix_C_t* rx_channel)
+{
+    const uint32_t num_antennas = handle->num_virtual_antennas;
+    uint32_t doppler_idx = find_doppler_idx(rx_channel,
+                                            range_bin,
+                                            handle->num_chirps,
+                                            handle->neighbouring_bins);
+
+    for (uint8_t ant_idx = 0; ant_idx < num_antennas; ++ant_idx)
+    {
+        ifx_Matrix_C_t lens;
+        ifx_Matrix_C_t range_pulse_row;
+        ifx_mat_view_c(&lens, &handle->rx_slices[ant_idx], range_bin, doppler_idx - handle->neighbouring_bins, 1, handle->neighbouring_bins * 2 + 1);
+        ifx_mat_view_c(&range_pulse_row, handle->range_pulse_matrix, ant_idx, 0, 1, mCols(handle->range_pulse_matrix));
+        ifx_mat_scale_c(&lens, IFX_VEC_AT(handle->range_pulse_scalar, ant_idx), &range_pulse_row);
+    }
+
+    // Calculate covariance_matrix = range_pulse_matrix*(range_pulse_matrix Transpose)
+    ifx_Matrix_C_t* covariance = handle->range_pulse_covariance;
+    ifx_mat_abct_c(handle->range_pulse_matrix, handle->range_pulse_matrix, covariance);
+
+    if (handle->diagonal_loading > 0)
+    {
+        ifx_Float_t trace = 0;
+        for (uint32_t i = 0; i < num_antennas; i++)
+        {
+            trace += IFX_COMPLEX_REAL(mAt(covariance, i, i));
+        }
+
+        const ifx_Float_t loading = handle->diagonal_loading * trace / num_antennas;
+        for (uint32_t i = 0; i < num_antennas; i++)
+        {
+            IFX_COMPLEX_SET_REAL(mAt(covariance, i, i), IFX_COMPLEX_REAL(mAt(covariance, i, i)) + loading);
+        }
+    }
+
+    invert_hermitian(covariance, handle->inverse);
+
+    // Find out the minimum of w^H*R^-1*w over all beams, which maximizes the Capon spectrum
+    ifx_Float_t min_value = FLT_MAX;  // all elements from capon_result are not negative
+    ifx_Float_t angle = vAt(handle->angle_vector, 0);
+
+    if (num_antennas > 3)
+    {
+        // the LU inverse is not exactly Hermitian, use the full product
+        for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
+        {
+            ifx_Vector_C_t vec_weight;
+            ifx_mat_get_colview_c(handle->weights, idx, &vec_weight);
+            ifx_mat_mul_cv(handle->inverse, &vec_weight, handle->tmp_vec);
+
+            ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
+            for (uint32_t idxvec = 0; idxvec < vLen(handle->tmp_vec); ++idxvec)
+            {
+                ifx_Complex_t local_weight = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(vAt(&vec_weight, idxvec)), -IFX_COMPLEX_IMAG(vAt(&vec_weight, idxvec)));
+                sum = ifx_cadd(sum, ifx_cmul(local_weight, vAt(handle->tmp_vec, idxvec)));
+            }
+
+            ifx_Float_t value = ifx_complex_abs(sum);
+            if (min_value > value)
+            {
+                angle = vAt(handle->angle_vector, idx);
+                min_value = value;
+            }
+        }
+
+        return angle;
+    }
+
+    ifx_Float_t* inverse_diag = vDat(handle->inverse_diag);
+    ifx_Complex_t* inverse_pairs = vDat(handle->inverse_pairs);
+    const uint32_t num_pairs = handle->num_pairs;
+    for (uint32_t i = 0, pair = 0; i < num_antennas; i++)
+    {
+        inverse_diag[i] = IFX_COMPLEX_REAL(mAt(handle->inverse, i, i));
+        for (uint32_t j = i + 1; j < num_antennas; j++)
+        {
+            inverse_pairs[pair++] = mAt(handle->inverse, i, j);
+        }
+    }
+
+    for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
+    {
+        const ifx_Float_t* power = &mAt(handle->steering_power, idx, 0);
+        const ifx_Complex_t* pairs = &mAt(handle->steering_pairs, idx, 0);
+
+        ifx_Float_t value = 0;
+        for (uint32_t i = 0; i < num_antennas; i++)
+        {
+            value += inverse_diag[i] * power[i];
+        }
+
+        ifx_Float_t cross = 0;
+        for (uint32_t pair = 0; pair < num_pairs; pair++)
+        {
+            cross += IFX_COMPLEX_REAL(inverse_pairs[pair]) * IFX_COMPLEX_REAL(pairs[pair])
+                     - IFX_COMPLEX_IMAG(inverse_pairs[pair]) * IFX_COMPLEX_IMAG(pairs[pair]);
+        }
+
+        value = FABS(value + 2 * cross);
+        if (min_value > value)
+        {
+            angle = vAt(handle->angle_vector, idx);
+            min_value = value;
+        }
+    }
+
+    return angle;
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -221,21 +461,33 @@ static uint32_t find_doppler_idx(const ifx_Matrix_C_t* rx_channel,
 ifx_AngleCapon_t* ifx_anglecapon_create(const ifx_AngleCapon_Config_t* config)
 {
     IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->num_virtual_antennas < 1);
+    IFX_ERR_BRN_ARGUMENT(config->diagonal_loading < 0);
 
-    ifx_AngleCapon_t* h = ifx_mem_alloc(sizeof(struct ifx_AngleCapon_s));
+    ifx_AngleCapon_t* h = ifx_mem_calloc(1, sizeof(struct ifx_AngleCapon_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
+    const uint32_t num_pairs = config->num_virtual_antennas * (config->num_virtual_antennas - 1) / 2;
+
     h->num_virtual_antennas = config->num_virtual_antennas;
     h->num_beams = config->num_beams;
     h->selected_rx = config->selected_rx;
     h->phase_offset_degrees = config->phase_offset_degrees;
     h->neighbouring_bins = (config->range_win_size - 1) / 2;
     h->num_chirps = config->chirps_per_frame;
+    h->diagonal_loading = config->diagonal_loading;
 
     IFX_ERR_HANDLE_N(h->weights = ifx_mat_create_c(config->num_virtual_antennas, config->num_beams),
                      ifx_anglecapon_destroy(h));
     init_weights(h->weights, config);
 
+    IFX_ERR_HANDLE_N(h->steering_power = ifx_mat_create_r(config->num_beams, config->num_virtual_antennas),
+                     ifx_anglecapon_destroy(h));
+    // a single antenna has no pairs, keep one column to have a valid matrix
+    IFX_ERR_HANDLE_N(h->steering_pairs = ifx_mat_create_c(config->num_beams, MAX(num_pairs, 1)),
+                     ifx_anglecapon_destroy(h));
+    init_steering(h->weights, h->steering_power, h->steering_pairs);
+
     IFX_ERR_HANDLE_N(h->range_pulse_matrix = ifx_mat_create_c(config->num_virtual_antennas, config->range_win_size),
                      ifx_anglecapon_destroy(h));
 
@@ -256,6 +508,20 @@ ifx_AngleCapon_t* ifx_anglecapon_create(const ifx_AngleCapon_Config_t* config)
     IFX_ERR_HANDLE_N(h->tmp_vec = ifx_vec_create_c(config->num_virtual_antennas),
                      ifx_anglecapon_destroy(h));
 
+    IFX_ERR_HANDLE_N(h->inverse_diag = ifx_vec_create_r(config->num_virtual_antennas),
+                     ifx_anglecapon_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->inverse_pairs = ifx_vec_create_c(MAX(num_pairs, 1)),
+                     ifx_anglecapon_destroy(h));
+    h->num_pairs = num_pairs;
+
+    h->rx_slices = ifx_mem_calloc(config->num_virtual_antennas, sizeof(ifx_Matrix_C_t));
+    if (h->rx_slices == NULL)
+    {
+        ifx_anglecapon_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
     return h;
 }
 
@@ -270,51 +536,38 @@ ifx_Float_t ifx_anglecapon_run(const ifx_AngleCapon_t* handle,
 
     ifx_Matrix_C_t rx_channel;
     ifx_cube_get_slice_c(rx_spectrum, handle->selected_rx, &rx_channel);
-    uint32_t doppler_idx = find_doppler_idx(&rx_channel,
-                                            range_bin,
-                                            handle->num_chirps,
-                                            handle->neighbouring_bins);
-
     for (uint8_t ant_idx = 0; ant_idx < handle->num_virtual_antennas; ++ant_idx)
     {
-        ifx_Matrix_C_t tmp_matrix;
-        ifx_Matrix_C_t lens;
-        ifx_Matrix_C_t range_pulse_row;
-        ifx_cube_get_slice_c(rx_spectrum, ant_idx, &tmp_matrix);
-        ifx_mat_view_c(&lens, &tmp_matrix, range_bin, doppler_idx - handle->neighbouring_bins, 1, handle->neighbouring_bins * 2 + 1);
-        ifx_mat_view_c(&range_pulse_row, handle->range_pulse_matrix, ant_idx, 0, 1, mCols(handle->range_pulse_matrix));
-        ifx_mat_scale_c(&lens, IFX_VEC_AT(handle->range_pulse_scalar, ant_idx), &range_pulse_row);
+        ifx_cube_get_slice_c(rx_spectrum, ant_idx, &handle->rx_slices[ant_idx]);
     }
 
-    // Calculate covariance_matrix = range_pulse_matrix*(range_pulse_matrix Transpose)
-    ifx_mat_abct_c(handle->range_pulse_matrix, handle->range_pulse_matrix, handle->range_pulse_covariance);
+    return estimate_angle(handle, range_bin, &rx_channel);
+}
 
-    // Find out the maximum value inside vector capon_result and its index
-    ifx_Float_t min_value = FLT_MAX;  // all elements from capon_result are not negative
-    ifx_Float_t angle = vAt(handle->angle_vector, 0);
-    for (uint32_t idx = 0; idx < handle->num_beams; ++idx)
-    {
-        ifx_la_invert_c(handle->range_pulse_covariance, handle->inverse);
-        ifx_Vector_C_t vec_weight;
-        ifx_mat_get_colview_c(handle->weights, idx, &vec_weight);
-        ifx_mat_mul_cv(handle->inverse, &vec_weight, handle->tmp_vec);
+//----------------------------------------------------------------------------
 
-        ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
-        for (uint32_t idxvec = 0; idxvec < vLen(handle->tmp_vec); ++idxvec)
-        {
-            ifx_Complex_t local_weight = IFX_COMPLEX_DEF(IFX_COMPLEX_REAL(vAt(&vec_weight, idxvec)), -IFX_COMPLEX_IMAG(vAt(&vec_weight, idxvec)));
-            sum = ifx_complex_add(sum, ifx_complex_mul(local_weight, vAt(handle->tmp_vec, idxvec)));
-        }
+void ifx_anglecapon_run_batch(const ifx_AngleCapon_t* handle,
+                              const uint32_t* range_bins,
+                              uint32_t num_range_bins,
+                              const ifx_Cube_C_t* rx_spectrum,
+                              ifx_Float_t* angles)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(range_bins);
+    IFX_ERR_BRK_NULL(angles);
+    IFX_CUBE_BRK_VALID(rx_spectrum);
 
-        ifx_Float_t value = ifx_complex_abs(sum);
-        if (min_value > value)
-        {
-            angle = vAt(handle->angle_vector, idx);
-            min_value = value;
-        }
+    ifx_Matrix_C_t rx_channel;
+    ifx_cube_get_slice_c(rx_spectrum, handle->selected_rx, &rx_channel);
+    for (uint8_t ant_idx = 0; ant_idx < handle->num_virtual_antennas; ++ant_idx)
+    {
+        ifx_cube_get_slice_c(rx_spectrum, ant_idx, &handle->rx_slices[ant_idx]);
     }
 
-    return angle;
+    for (uint32_t i = 0; i < num_range_bins; i++)
+    {
+        angles[i] = estimate_angle(handle, range_bins[i], &rx_channel);
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -333,6 +586,11 @@ void ifx_anglecapon_destroy(ifx_AngleCapon_t* handle)
     ifx_mat_destroy_c(handle->range_pulse_covariance);
     ifx_mat_destroy_c(handle->inverse);
     ifx_vec_destroy_c(handle->tmp_vec);
+    ifx_mat_destroy_r(handle->steering_power);
+    ifx_mat_destroy_c(handle->steering_pairs);
+    ifx_vec_destroy_r(handle->inverse_diag);
+    ifx_vec_destroy_c(handle->inverse_pairs);
+    ifx_mem_free(handle->rx_slices);
     ifx_mem_free(handle);
 
     handle = NULL;
@@ -91,6 +91,9 @@ typedef struct
     ifx_Float_t max_angle_degrees;    /**< Maximum angle. The angle on right side of FoV in degrees.*/
     ifx_Float_t d_by_lambda;          /**< Ratio between antenna spacing 'd' and wavelength of the Radar's operating
                                            frequency. For BGT60 Devices this is `0.5` and the algorithm is optimized for this value*/
+    ifx_Float_t diagonal_loading;     /**< Diagonal loading. This value times the mean antenna power is added to the diagonal of the
+                                           covariance matrix before it is inverted, which keeps the inverse stable for a small
+                                           range_win_size or a single strong target. `0` disables it, a typical value is `0.01`*/
 } ifx_AngleCapon_Config_t;
 
 /*
@@ -165,6 +168,27 @@ ifx_Float_t ifx_anglecapon_run(const ifx_AngleCapon_t* handle,
                                uint32_t range_bin,
                                const ifx_Cube_C_t* rx_spectrum);
 
+/**
+ * @brief Runs angle capon algorithm for several range bins.
+ *
+ * Same as calling \ref ifx_anglecapon_run for each of the range bins, e.g.
+ * for all targets detected in a frame.
+ *
+ * @param [in]     handle              A handle to the AngleCapon object
+ * @param [in]     range_bins          Range bins of the targets, see \ref ifx_anglecapon_run.
+ * @param [in]     num_range_bins      Number of range bins.
+ * @param [in]     rx_spectrum         Range spectrum returned by \ref ifx_rai_get_rx_spectrum
+ * @param [out]    angles              Angle value in degrees for each range bin. Must point to
+ *                                     valid memory of num_range_bins elements.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_anglecapon_run_batch(const ifx_AngleCapon_t* handle,
+                              const uint32_t* range_bins,
+                              uint32_t num_range_bins,
+                              const ifx_Cube_C_t* rx_spectrum,
+                              ifx_Float_t* angles);
+
 /**
  * @brief Destroys AngleCapon handle (object) to clear internal states and memories.
  *
@@ -39,6 +39,7 @@
 #include "ifxBase/Complex.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Math.h"
 #include "ifxBase/Mem.h"
@@ -52,6 +53,9 @@
 ==============================================================================
 */
 
+// number of strided elements copied to contiguous buffers per call of the kernel
+#define MONOPULSE_BLOCK 64
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -151,10 +155,33 @@ void ifx_anglemonopulse_vector_run(const ifx_AngleMonopulse_t* handle,
     IFX_VEC_BRK_DIM(rx1, rx2);
     IFX_VEC_BRK_DIM_GT(rx1, target_angle_deg);
 
-    for (uint32_t i = 0; i < vLen(rx1); ++i)
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    const ifx_Float_t gain = handle->wavelength / (handle->antenna_spacing * 2 * IFX_PI);
+
+    if (vStride(rx1) == 1 && vStride(rx2) == 1 && vStride(target_angle_deg) == 1)
+    {
+        kernels->monopulse_c(vDat(rx1), vDat(rx2), gain, vDat(target_angle_deg), vLen(rx1));
+        return;
+    }
+
+    ifx_Complex_t x[MONOPULSE_BLOCK];
+    ifx_Complex_t y[MONOPULSE_BLOCK];
+    ifx_Float_t angle[MONOPULSE_BLOCK];
+
+    for (uint32_t start = 0; start < vLen(rx1); start += MONOPULSE_BLOCK)
     {
-        vAt(target_angle_deg, i) =
-            ifx_anglemonopulse_scalar_run(handle, vAt(rx1, i), vAt(rx2, i));
+        const uint32_t len = (vLen(rx1) - start < MONOPULSE_BLOCK) ? vLen(rx1) - start : MONOPULSE_BLOCK;
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            x[i] = vAt(rx1, start + i);
+            y[i] = vAt(rx2, start + i);
+        }
+
+        kernels->monopulse_c(x, y, gain, angle, len);
+
+        for (uint32_t i = 0; i < len; i++)
+            vAt(target_angle_deg, start + i) = angle[i];
     }
 }
 
@@ -142,6 +142,13 @@ ifx_Float_t ifx_anglemonopulse_scalar_run(const ifx_AngleMonopulse_t* handle,
  * @brief Based on complex input vector from two receiver antennas, a corresponding
  *        angle vector (in units of degrees) is calculated using phase monopulse algorithm.
  *
+ * All detections of a frame are processed at once with SIMD instructions.
+ * Instead of the math library the phase difference and the arcus sine are
+ * approximated with polynomials, so the angles may differ from
+ * \ref ifx_anglemonopulse_scalar_run by about 1e-4 degrees (more close to
+ * +-90 degrees, where the arcus sine is steep). The phase difference is
+ * taken from rx1*conj(rx2), so if one of the inputs is zero the angle is 0.
+ *
  * @param [in]     handle              A handle to the angle monopulse object
  * @param [in]     rx1                 First Rx antenna used as numerator argument in algorithm
  * @param [in]     rx2                 Second Rx antenna used as denominator argument in algorithm
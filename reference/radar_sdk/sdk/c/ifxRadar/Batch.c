@@ -0,0 +1,328 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <string.h>
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/Batch.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Arguments of run_items, the task processing the items of a batch.
+ */
+typedef struct
+{
+    ifx_Batch_Func_t func;    /**< Processing function.*/
+    ifx_Batch_Item_t* items;  /**< Items of the batch.*/
+} batch_task_t;
+
+/**
+ * @brief Defines the structure for the batch detector.
+ *        Use type ifx_Batch_Detector_t for this struct.
+ */
+struct ifx_Batch_Detector_s
+{
+    ifx_Pipeline_t** pipelines; /**< One pipeline per thread of the executor.*/
+    uint32_t num_pipelines;     /**< Number of pipelines.*/
+    ifx_Executor_t* executor;   /**< Thread pool distributing the sensors, may be NULL.*/
+    bool clustered;             /**< true if the last stage is IFX_PIPELINE_STAGE_DBSCAN.*/
+};
+
+/**
+ * @brief Arguments of run_detections, the task processing the items of a batch detector.
+ */
+typedef struct
+{
+    const ifx_Batch_Detector_t* detector; /**< Batch detector.*/
+    ifx_Batch_Detection_t* items;         /**< Items of the batch.*/
+} detector_task_t;
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void run_items(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+static void collect_detections(const ifx_Batch_Detector_t* detector,
+                               const ifx_Pipeline_t* pipeline,
+                               ifx_Batch_Detection_t* item);
+
+static void run_detections(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/**
+ * @brief Processes the items begin to end-1 of a batch.
+ *
+ * The error state is per thread, so the error of every item is stored in the
+ * item and cleared before the next one.
+ */
+static void run_items(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    const batch_task_t* task = context;
+    (void)thread;
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        ifx_Batch_Item_t* item = &task->items[i];
+
+        if (item->frame == NULL)
+        {
+            item->error = IFX_OK;
+            continue;
+        }
+
+        ifx_error_clear();
+        task->func(item->handle, item->frame, item->output);
+        item->error = ifx_error_get_and_clear();
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Copies the output of a pipeline to the detections of an item */
+static void collect_detections(const ifx_Batch_Detector_t* detector,
+                               const ifx_Pipeline_t* pipeline,
+                               ifx_Batch_Detection_t* item)
+{
+    uint32_t n = 0;
+
+    if (detector->clustered)
+    {
+        const uint16_t* detections;
+        const uint16_t* clusters;
+
+        n = MIN(ifx_pipeline_get_clusters(pipeline, &detections, &clusters), item->max_detections);
+        memcpy(item->detections, detections, 2 * (size_t)n * sizeof(uint16_t));
+        if (item->clusters != NULL)
+            memcpy(item->clusters, clusters, (size_t)n * sizeof(uint16_t));
+    }
+    else
+    {
+        // cells without detection are 0, see IFX_PIPELINE_STAGE_OSCFAR
+        const ifx_Matrix_R_t* cells = ifx_pipeline_get_matrix_r(pipeline);
+
+        for (uint32_t r = 0; r < mRows(cells) && n < item->max_detections; r++)
+        {
+            for (uint32_t c = 0; c < mCols(cells) && n < item->max_detections; c++)
+            {
+                if (IFX_MAT_AT(cells, r, c) != 0)
+                {
+                    item->detections[2 * n] = (uint16_t)r;
+                    item->detections[2 * n + 1] = (uint16_t)c;
+                    n++;
+                }
+            }
+        }
+    }
+
+    item->num_detections = n;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Processes the items begin to end-1 of a batch detector.
+ *
+ * Calls with the same thread index never overlap, so the thread index
+ * selects the pipeline.
+ */
+static void run_detections(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    const detector_task_t* task = context;
+    ifx_Pipeline_t* pipeline = task->detector->pipelines[thread];
+
+    for (uint32_t i = begin; i < end; i++)
+    {
+        ifx_Batch_Detection_t* item = &task->items[i];
+
+        item->num_detections = 0;
+        if (item->frame == NULL)
+        {
+            item->error = IFX_OK;
+            continue;
+        }
+        if (item->detections == NULL && item->max_detections > 0)
+        {
+            item->error = IFX_ERROR_ARGUMENT_NULL;
+            continue;
+        }
+
+        ifx_error_clear();
+        if (ifx_pipeline_run(pipeline, item->frame))
+            collect_detections(task->detector, pipeline, item);
+        item->error = ifx_error_get_and_clear();
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_batch_run(ifx_Executor_t* executor,
+                   ifx_Batch_Func_t func,
+                   ifx_Batch_Item_t* items,
+                   uint32_t count)
+{
+    IFX_ERR_BRK_NULL(func);
+    IFX_ERR_BRK_COND(count > 0 && items == NULL, IFX_ERROR_ARGUMENT_NULL);
+
+    batch_task_t task = {func, items};
+
+    // one sensor per chunk, sensors are coarse enough to balance the load
+    ifx_executor_parallel_for(executor, count, 1, run_items, &task);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (items[i].error != IFX_OK)
+        {
+            ifx_error_set(items[i].error);
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Batch_Detector_t* ifx_batch_detector_create(const ifx_Pipeline_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_NULL(config->stages);
+    IFX_ERR_BRN_ARGUMENT(config->num_stages == 0);
+    IFX_ERR_BRN_ARGUMENT(config->overlap_stage != 0);
+
+    // the pipelines are shared by all sensors, so no stage may keep state
+    for (uint32_t i = 0; i < config->num_stages; i++)
+        IFX_ERR_BRN_ARGUMENT(config->stages[i].type == IFX_PIPELINE_STAGE_MTI);
+
+    const ifx_Pipeline_Stage_Type_t last = config->stages[config->num_stages - 1].type;
+    IFX_ERR_BRN_ARGUMENT(last != IFX_PIPELINE_STAGE_OSCFAR && last != IFX_PIPELINE_STAGE_DBSCAN);
+
+    ifx_Batch_Detector_t* d = ifx_mem_calloc(1, sizeof(struct ifx_Batch_Detector_s));
+    IFX_ERR_BRN_MEMALLOC(d);
+
+    d->executor = config->executor;
+    d->clustered = (last == IFX_PIPELINE_STAGE_DBSCAN);
+    d->num_pipelines = ifx_executor_get_num_threads(config->executor);
+
+    d->pipelines = ifx_mem_calloc(d->num_pipelines, sizeof(ifx_Pipeline_t*));
+    if (d->pipelines == NULL)
+    {
+        ifx_batch_detector_destroy(d);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    // a sensor runs on one thread, parallelism comes from the sensors
+    ifx_Pipeline_Config_t pipeline_config = *config;
+    pipeline_config.executor = NULL;
+
+    for (uint32_t i = 0; i < d->num_pipelines; i++)
+    {
+        IFX_ERR_HANDLE_N(d->pipelines[i] = ifx_pipeline_create(&pipeline_config),
+                         ifx_batch_detector_destroy(d));
+    }
+
+    return d;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_batch_detector_destroy(ifx_Batch_Detector_t* detector)
+{
+    if (detector == NULL)
+        return;
+
+    if (detector->pipelines != NULL)
+    {
+        for (uint32_t i = 0; i < detector->num_pipelines; i++)
+            ifx_pipeline_destroy(detector->pipelines[i]);
+    }
+
+    ifx_mem_free(detector->pipelines);
+    ifx_mem_free(detector);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_batch_detector_run(ifx_Batch_Detector_t* detector,
+                            ifx_Batch_Detection_t* items,
+                            uint32_t count)
+{
+    IFX_ERR_BRK_NULL(detector);
+    IFX_ERR_BRK_COND(count > 0 && items == NULL, IFX_ERROR_ARGUMENT_NULL);
+
+    detector_task_t task = {detector, items};
+
+    ifx_executor_parallel_for(detector->executor, count, 1, run_detections, &task);
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (items[i].error != IFX_OK)
+        {
+            ifx_error_set(items[i].error);
+            return;
+        }
+    }
+}
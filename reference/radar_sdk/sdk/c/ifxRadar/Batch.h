@@ -0,0 +1,244 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Batch.h
+ *
+ * \brief \copybrief gr_batch
+ *
+ * For details refer to \ref gr_batch
+ */
+
+#ifndef IFX_RADAR_BATCH_H
+#define IFX_RADAR_BATCH_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/Types.h"
+
+#include "ifxRadar/Pipeline.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Processes the frame of one sensor with the handle of that sensor.
+ *
+ * Errors are reported with ifx_error_set as by all SDK functions, e.g. a
+ * wrapper around \ref ifx_segmentation_run or \ref ifx_motionangle_run.
+ */
+typedef void (*ifx_Batch_Func_t)(void* handle, const ifx_Cube_R_t* frame, void* output);
+
+/**
+ * @brief One sensor of a batch.
+ */
+typedef struct
+{
+    void* handle;               /**< Processing handle of the sensor, owned by the caller.*/
+    const ifx_Cube_R_t* frame;  /**< Frame of the sensor, may be NULL to skip the sensor in this batch.*/
+    void* output;               /**< Output of the sensor, passed to the processing function.*/
+    ifx_Error_t error;          /**< Set by \ref ifx_batch_run to the error of this sensor or IFX_OK.*/
+} ifx_Batch_Item_t;
+
+/**
+ * @brief A handle for a batch detector, see \ref ifx_batch_detector_create.
+ */
+typedef struct ifx_Batch_Detector_s ifx_Batch_Detector_t;
+
+/**
+ * @brief One sensor of a batch processed by a batch detector.
+ */
+typedef struct
+{
+    const ifx_Cube_R_t* frame;  /**< Frame of the sensor, may be NULL to skip the sensor in this batch.*/
+    uint16_t* detections;       /**< Detections as interleaved (row, column) pairs, room for max_detections pairs.*/
+    uint16_t* clusters;         /**< Cluster IDs of the detections if the last stage is IFX_PIPELINE_STAGE_DBSCAN,
+                                     room for max_detections IDs. May be NULL.*/
+    uint32_t max_detections;    /**< Capacity of detections and clusters, further detections are dropped.*/
+    uint32_t num_detections;    /**< Set to the number of detections stored.*/
+    ifx_Error_t error;          /**< Set to the error of this sensor or IFX_OK.*/
+} ifx_Batch_Detection_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_batch Batch
+ * @brief Runs one processing function over the frames of many sensors
+ *
+ * Applications serving several sensors usually process every sensor on its
+ * own thread. \ref ifx_batch_run instead processes the frames of all sensors
+ * of one frame period on a shared \ref gr_executor "executor": each sensor is
+ * one chunk of a parallel loop, so the threads of the pool (and the calling
+ * thread) take the next unprocessed sensor until all are done. The number of
+ * busy threads is bounded by the pool size rather than the number of sensors,
+ * which avoids oversubscription and keeps the throughput close to linear in
+ * the number of cores as long as there are at least as many sensors as
+ * threads.
+ *
+ * Processing handles are stateful (e.g. trackers), so every sensor needs its
+ * own handle and a handle must appear only once per batch. Handles are never
+ * processed by two threads at the same time.
+ *
+ * Example for segmentation:
+ * \code{.c}
+ * typedef struct { ifx_Vector_R_t* segments; ifx_Matrix_R_t* tracks; } seg_output_t;
+ *
+ * static void run_segmentation(void* handle, const ifx_Cube_R_t* frame, void* output)
+ * {
+ *     seg_output_t* out = output;
+ *     ifx_segmentation_run(handle, frame, out->segments, out->tracks);
+ * }
+ *
+ * // once per frame period, items[i] holds handle, frame and output of sensor i
+ * ifx_batch_run(executor, run_segmentation, items, num_sensors);
+ * \endcode
+ *
+ * @{
+ */
+
+/**
+ * @brief Processes the frames of a batch of sensors.
+ *
+ * Calls func(items[i].handle, items[i].frame, items[i].output) for every item
+ * with a frame and stores the resulting error in items[i].error. Items
+ * without frame are skipped and get IFX_OK. The function returns when all
+ * items are processed. If executor is NULL, the items are processed one
+ * after the other on the calling thread.
+ *
+ * If an item failed, the error of the first failed item is also set for the
+ * calling thread.
+ *
+ * @param [in]     executor  Thread pool, may be NULL.
+ * @param [in]     func      Processing function.
+ * @param [in,out] items     Sensors of the batch.
+ * @param [in]     count     Number of items.
+ */
+IFX_DLL_PUBLIC
+void ifx_batch_run(ifx_Executor_t* executor,
+                   ifx_Batch_Func_t func,
+                   ifx_Batch_Item_t* items,
+                   uint32_t count);
+
+/**
+ * @brief Creates a batch detector.
+ *
+ * A batch detector runs the same detection chain on the frames of many
+ * sensors of the same type, e.g. range Doppler map, beam forming,
+ * integration and OS-CFAR, and returns the detections only. It holds one
+ * \ref gr_pipeline "pipeline" per thread of the executor instead of one per
+ * sensor: every thread processes a sensor from frame to detections in its own
+ * arena, so the intermediate cubes stay in the cache of that core and the
+ * memory does not grow with the number of sensors.
+ *
+ * A pipeline is shared by all sensors, so the stages must not keep state
+ * between frames: IFX_PIPELINE_STAGE_MTI and overlap_stage are not supported.
+ * The last stage must be IFX_PIPELINE_STAGE_OSCFAR or IFX_PIPELINE_STAGE_DBSCAN.
+ *
+ * Frames may be passed in any frame_layout of the config, so frames from the
+ * strata frame pool are processed where they are without reordering.
+ *
+ * @param [in]     config    Pipeline settings. config->executor distributes the
+ *                           sensors and may be NULL; the stages of a sensor
+ *                           run on a single thread.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Batch_Detector_t* ifx_batch_detector_create(const ifx_Pipeline_Config_t* config);
+
+/**
+ * @brief Destroys a batch detector.
+ *
+ * @param [in]     detector  A handle to the batch detector.
+ */
+IFX_DLL_PUBLIC
+void ifx_batch_detector_destroy(ifx_Batch_Detector_t* detector);
+
+/**
+ * @brief Processes the frames of a batch of sensors.
+ *
+ * Stores the detections of every item with a frame in the item. Items
+ * without frame are skipped and get no detections and IFX_OK. The function
+ * returns when all items are processed and must neither be called from
+ * several threads at the same time nor from a task of the executor.
+ *
+ * If an item failed, the error of the first failed item is also set for the
+ * calling thread.
+ *
+ * @param [in]     detector  A handle to the batch detector.
+ * @param [in,out] items     Sensors of the batch.
+ * @param [in]     count     Number of items.
+ */
+IFX_DLL_PUBLIC
+void ifx_batch_detector_run(ifx_Batch_Detector_t* detector,
+                            ifx_Batch_Detection_t* items,
+                            uint32_t count);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_BATCH_H */
@@ -37,6 +37,9 @@
 #include "ifxBase/Cube.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/internal/ComplexInline.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
@@ -49,6 +52,9 @@
 ==============================================================================
 */
 
+// Number of complex values converted at once by ifx_dbf_run_hc
+#define HALF_BLOCK_SIZE (1024U)
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -61,9 +67,21 @@
  */
 struct ifx_DBF_s
 {
-    ifx_Matrix_C_t* weights; /**< Weights.*/
+    ifx_Matrix_C_t* weights; /**< Weights, one row per slice of the range Doppler spectrum cube and
+                                  one column per beam.*/
+    ifx_Executor_t* executor; /**< Thread pool to process the range bins, NULL if not set.*/
 };
 
+/**
+ * @brief Arguments of the executor tasks processing the range bins.
+ */
+typedef struct
+{
+    const ifx_Matrix_C_t* weights; /**< Weights of the handle.*/
+    const void* input;             /**< Range Doppler spectrum, ifx_Cube_C_t or ifx_Cube_HC_t.*/
+    ifx_Cube_C_t* output;          /**< Range Doppler beam image.*/
+} rows_task_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -79,6 +97,15 @@ struct ifx_DBF_s
 static void init_weights(ifx_DBF_t* handle,
                          const ifx_DBF_Config_t* config);
 
+static void beamform(const ifx_Matrix_C_t* weights,
+                     const ifx_Complex_t* spectrum,
+                     size_t spectrum_stride,
+                     ifx_Complex_t* beams);
+
+static void run_rows_c(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+static void run_rows_hc(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -118,6 +145,149 @@ static void init_weights(ifx_DBF_t* handle,
 
             IFX_MAT_AT(handle->weights, ant, beam) = weight;
         }
+
+        /* The beams have always been formed with the weight of the last
+         * antenna for the first slice of the cube and of antenna n-1 for
+         * slice n; the rows are rotated so that row n belongs to slice n.
+         */
+        const ifx_Complex_t last = IFX_MAT_AT(handle->weights, config->num_antennas - 1, beam);
+        for (int32_t ant = config->num_antennas - 1; ant > 0; ant--)
+        {
+            IFX_MAT_AT(handle->weights, ant, beam) = IFX_MAT_AT(handle->weights, ant - 1, beam);
+        }
+        IFX_MAT_AT(handle->weights, 0, beam) = last;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* Beams of one range Doppler cell for spectrum cubes whose slices are not
+ * contiguous.
+ */
+static void beamform(const ifx_Matrix_C_t* weights,
+                     const ifx_Complex_t* spectrum,
+                     size_t spectrum_stride,
+                     ifx_Complex_t* beams)
+{
+    for (uint32_t beam = 0; beam < IFX_MAT_COLS(weights); beam++)
+    {
+        ifx_Complex_t sum = IFX_COMPLEX_DEF(0, 0);
+        for (uint32_t ant = 0; ant < IFX_MAT_ROWS(weights); ant++)
+        {
+            sum = ifx_cadd(sum, ifx_cmul(spectrum[ant * spectrum_stride], IFX_MAT_AT(weights, ant, beam)));
+        }
+        beams[beam] = sum;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* With the antennas of each range Doppler cell next to each other the
+ * beams of a range bin are the product of the (Doppler x antennas)
+ * matrix of the spectrum with the (antennas x beams) weights. This
+ * reads the spectrum only once instead of once per beam.
+ */
+static void run_rows_c(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    (void)thread;
+
+    const rows_task_t* task = context;
+    const ifx_Matrix_C_t* weights = task->weights;
+    const ifx_Cube_C_t* rng_dopp_spectrum = task->input;
+    ifx_Cube_C_t* rng_dopp_image_beam = task->output;
+    const size_t* in_stride = IFX_MDA_STRIDE(rng_dopp_spectrum);
+    const size_t* out_stride = IFX_MDA_STRIDE(rng_dopp_image_beam);
+
+    if ((in_stride[2] == 1) && (out_stride[2] == 1))
+    {
+        const ifx_Kernels_t* kernels = ifx_kernels_get();
+        for (uint32_t r = begin; r < end; r++)
+        {
+            kernels->gemm_c(&IFX_CUBE_AT(rng_dopp_spectrum, r, 0, 0), in_stride[1],
+                            IFX_MAT_DAT(weights), IFX_MAT_STRIDE(weights, 0),
+                            &IFX_CUBE_AT(rng_dopp_image_beam, r, 0, 0), out_stride[1],
+                            IFX_CUBE_COLS(rng_dopp_spectrum), IFX_MAT_COLS(weights), IFX_MAT_ROWS(weights));
+        }
+        return;
+    }
+
+    for (uint32_t r = begin; r < end; r++)
+    {
+        for (uint32_t c = 0; c < IFX_CUBE_COLS(rng_dopp_spectrum); c++)
+        {
+            ifx_Complex_t beams[UINT8_MAX];
+            beamform(weights, &IFX_CUBE_AT(rng_dopp_spectrum, r, c, 0), in_stride[2], beams);
+
+            for (uint32_t beam = 0; beam < IFX_MAT_COLS(weights); beam++)
+            {
+                IFX_CUBE_AT(rng_dopp_image_beam, r, c, beam) = beams[beam];
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/* The antennas of up to HALF_BLOCK_SIZE / antennas Doppler cells are
+ * converted to a buffer on the stack, which then is multiplied with the
+ * weights like in run_rows_c.
+ */
+static void run_rows_hc(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    (void)thread;
+
+    const rows_task_t* task = context;
+    const ifx_Matrix_C_t* weights = task->weights;
+    const ifx_Cube_HC_t* rng_dopp_spectrum = task->input;
+    ifx_Cube_C_t* rng_dopp_image_beam = task->output;
+    const uint32_t antennas = IFX_MAT_ROWS(weights);
+    const uint32_t cols = IFX_CUBE_COLS(rng_dopp_spectrum);
+    const uint32_t block = HALF_BLOCK_SIZE / antennas;
+    const size_t* in_stride = IFX_MDA_STRIDE(rng_dopp_spectrum);
+    const size_t* out_stride = IFX_MDA_STRIDE(rng_dopp_image_beam);
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+
+    ifx_Complex_t buffer[HALF_BLOCK_SIZE];
+
+    for (uint32_t r = begin; r < end; r++)
+    {
+        for (uint32_t c0 = 0; c0 < cols; c0 += block)
+        {
+            const uint32_t n = MIN(block, cols - c0);
+
+            for (uint32_t c = 0; c < n; c++)
+            {
+                const ifx_Complex16_t* cell = &IFX_CUBE_AT(rng_dopp_spectrum, r, c0 + c, 0);
+                ifx_Complex_t* dest = &buffer[c * antennas];
+
+                if (in_stride[2] == 1)
+                    kernels->from_f16(cell[0].data, dest[0].data, 2 * (size_t)antennas);
+                else
+                {
+                    for (uint32_t ant = 0; ant < antennas; ant++)
+                        kernels->from_f16(cell[ant * in_stride[2]].data, dest[ant].data, 2);
+                }
+            }
+
+            if (out_stride[2] == 1)
+            {
+                kernels->gemm_c(buffer, antennas, IFX_MAT_DAT(weights), IFX_MAT_STRIDE(weights, 0),
+                                &IFX_CUBE_AT(rng_dopp_image_beam, r, c0, 0), out_stride[1],
+                                n, IFX_MAT_COLS(weights), antennas);
+                continue;
+            }
+
+            for (uint32_t c = 0; c < n; c++)
+            {
+                ifx_Complex_t beams[UINT8_MAX];
+                beamform(weights, &buffer[c * antennas], 1, beams);
+
+                for (uint32_t beam = 0; beam < IFX_MAT_COLS(weights); beam++)
+                {
+                    IFX_CUBE_AT(rng_dopp_image_beam, r, c0 + c, beam) = beams[beam];
+                }
+            }
+        }
     }
 }
 
@@ -136,6 +306,7 @@ ifx_DBF_t* ifx_dbf_create(const ifx_DBF_Config_t* config)
 
     h->weights = ifx_mat_create_c(config->num_antennas, config->num_beams);
     IFX_ERR_BRN_MEMALLOC(h->weights);
+    h->executor = NULL;
 
     init_weights(h, config);
 
@@ -155,26 +326,77 @@ void ifx_dbf_run_c(ifx_DBF_t* handle,
     IFX_ERR_BRK_ARGUMENT(IFX_CUBE_ROWS(rng_dopp_spectrum) != IFX_CUBE_ROWS(rng_dopp_image_beam));
     IFX_ERR_BRK_ARGUMENT(IFX_CUBE_COLS(rng_dopp_spectrum) != IFX_CUBE_COLS(rng_dopp_image_beam));
     IFX_ERR_BRK_ARGUMENT(IFX_MAT_COLS(handle->weights) != IFX_CUBE_SLICES(rng_dopp_image_beam));
+    IFX_ERR_BRK_ARGUMENT(IFX_MAT_ROWS(handle->weights) > IFX_CUBE_SLICES(rng_dopp_spectrum));
 
-    ifx_Matrix_C_t rd_spec_view;
-    ifx_Matrix_C_t rdi_beam_view;
+    rows_task_t task = {handle->weights, rng_dopp_spectrum, rng_dopp_image_beam};
+    ifx_executor_parallel_for(handle->executor, IFX_CUBE_ROWS(rng_dopp_spectrum), 1, run_rows_c, &task);
+}
 
-    int num_antennas = IFX_MAT_ROWS(handle->weights);
-    int num_beams = IFX_MAT_COLS(handle->weights);
+//----------------------------------------------------------------------------
 
-    for (int beam = 0; beam < num_beams; beam++)
+void ifx_dbf_run_hc(ifx_DBF_t* handle,
+                    const ifx_Cube_HC_t* rng_dopp_spectrum,
+                    ifx_Cube_C_t* rng_dopp_image_beam)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rng_dopp_spectrum);
+    IFX_ERR_BRK_NULL(rng_dopp_image_beam);
+
+    IFX_ERR_BRK_ARGUMENT(IFX_CUBE_ROWS(rng_dopp_spectrum) != IFX_CUBE_ROWS(rng_dopp_image_beam));
+    IFX_ERR_BRK_ARGUMENT(IFX_CUBE_COLS(rng_dopp_spectrum) != IFX_CUBE_COLS(rng_dopp_image_beam));
+    IFX_ERR_BRK_ARGUMENT(IFX_MAT_COLS(handle->weights) != IFX_CUBE_SLICES(rng_dopp_image_beam));
+    IFX_ERR_BRK_ARGUMENT(IFX_MAT_ROWS(handle->weights) > IFX_CUBE_SLICES(rng_dopp_spectrum));
+
+    rows_task_t task = {handle->weights, rng_dopp_spectrum, rng_dopp_image_beam};
+    ifx_executor_parallel_for(handle->executor, IFX_CUBE_ROWS(rng_dopp_spectrum), 1, run_rows_hc, &task);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_dbf_run_cells_c(ifx_DBF_t* handle,
+                         const ifx_Cube_C_t* rng_dopp_spectrum,
+                         const uint16_t* cells,
+                         uint32_t num_cells,
+                         ifx_Matrix_C_t* beams)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rng_dopp_spectrum);
+    IFX_MAT_BRK_VALID(beams);
+    IFX_ERR_BRK_COND((num_cells > 0) && (cells == NULL), IFX_ERROR_ARGUMENT_NULL);
+
+    IFX_ERR_BRK_COND(IFX_MAT_ROWS(beams) != num_cells, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(IFX_MAT_COLS(beams) != IFX_MAT_COLS(handle->weights), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_ARGUMENT(IFX_MAT_ROWS(handle->weights) > IFX_CUBE_SLICES(rng_dopp_spectrum));
+
+    for (uint32_t i = 0; i < num_cells; i++)
     {
-        ifx_cube_get_slice_c(rng_dopp_image_beam, beam, &rdi_beam_view);  // set view to the output
+        IFX_ERR_BRK_COND((cells[2 * i] >= IFX_CUBE_ROWS(rng_dopp_spectrum)) || (cells[2 * i + 1] >= IFX_CUBE_COLS(rng_dopp_spectrum)),
+                         IFX_ERROR_INDEX_OUT_OF_BOUNDS);
+    }
 
-        ifx_cube_get_slice_c(rng_dopp_spectrum, 0, &rd_spec_view);        // set view to the rx1 rng dopp spectrum
+    const ifx_Matrix_C_t* weights = handle->weights;
+    const size_t in_stride = IFX_MDA_STRIDE(rng_dopp_spectrum)[2];
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
 
-        ifx_mat_scale_c(&rd_spec_view, IFX_MAT_AT(handle->weights, (size_t)num_antennas - 1, beam), &rdi_beam_view);
+    for (uint32_t i = 0; i < num_cells; i++)
+    {
+        const ifx_Complex_t* spectrum = &IFX_CUBE_AT(rng_dopp_spectrum, cells[2 * i], cells[2 * i + 1], 0);
+        ifx_Vector_C_t beams_row;
+        ifx_mat_get_rowview_c(beams, i, &beams_row);
 
-        for (int ant = 1; ant < num_antennas; ant++)
+        if ((in_stride == 1) && (IFX_VEC_STRIDE(&beams_row) == 1))
         {
-            ifx_cube_get_slice_c(rng_dopp_spectrum, ant, &rd_spec_view);  // set view to the next rx antenna rng dopp spectrum
-
-            ifx_mat_mac_c(&rdi_beam_view, &rd_spec_view, IFX_MAT_AT(handle->weights, (size_t)ant - 1, beam), &rdi_beam_view);
+            kernels->gemm_c(spectrum, 0, IFX_MAT_DAT(weights), IFX_MAT_STRIDE(weights, 0),
+                            IFX_VEC_DAT(&beams_row), 0, 1, IFX_MAT_COLS(weights), IFX_MAT_ROWS(weights));
+        }
+        else
+        {
+            ifx_Complex_t row[UINT8_MAX];
+            beamform(weights, spectrum, in_stride, row);
+            for (uint32_t beam = 0; beam < IFX_MAT_COLS(weights); beam++)
+            {
+                IFX_VEC_AT(&beams_row, beam) = row[beam];
+            }
         }
     }
 }
@@ -200,3 +422,12 @@ uint32_t ifx_dbf_get_beam_count(ifx_DBF_t* handle)
 
     return IFX_MAT_COLS(handle->weights);
 }
+
+//----------------------------------------------------------------------------
+
+void ifx_dbf_set_executor(ifx_DBF_t* handle, ifx_Executor_t* executor)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->executor = executor;
+}
@@ -45,6 +45,8 @@
 */
 
 #include "ifxBase/Cube.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 
 
@@ -147,6 +149,49 @@ void ifx_dbf_run_c(ifx_DBF_t* handle,
                    const ifx_Cube_C_t* rng_dopp_spectrum,
                    ifx_Cube_C_t* rng_dopp_image_beam);
 
+/**
+ * @brief Computes beams for a range Doppler spectrum stored in half precision.
+ *
+ * Same as \ref ifx_dbf_run_c, but the spectrum is a half precision cube (see
+ * \ref ifx_Cube_HC_t). The spectrum is converted block by block while it is
+ * read, so no float copy of the cube is needed.
+ *
+ * @param [in]     handle              A handle to the DBF object
+ * @param [in]     rng_dopp_spectrum   A complex half precision Cube (3D) of range Doppler spectrum for all Rx
+ *                                     channels i.e. (Nsamples x NumChirps x Number of Antennas)
+ * @param [out]    rng_dopp_image_beam A complex Cube (3D) containing range Doppler image beams i.e.
+ *                                     (Nsamples x NumChirps x NumberofBeams)
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_dbf_run_hc(ifx_DBF_t* handle,
+                    const ifx_Cube_HC_t* rng_dopp_spectrum,
+                    ifx_Cube_C_t* rng_dopp_image_beam);
+
+/**
+ * @brief Computes beams only for selected cells of a range Doppler spectrum.
+ *
+ * Instead of the full range Doppler image of each beam only the beams of the
+ * given cells (e.g. detections of a CFAR) are computed. Row i of beams holds
+ * the same values as the cell of rng_dopp_image_beam computed by
+ * \ref ifx_dbf_run_c.
+ *
+ * @param [in]     handle              A handle to the DBF object
+ * @param [in]     rng_dopp_spectrum   A complex Cube (3D) of range Doppler spectrum for all Rx channels i.e.
+ *                                     (Nsamples x NumChirps x Number of Antennas)
+ * @param [in]     cells               Range and Doppler index of each cell, stored one after the other,
+ *                                     i.e. the array has 2 * num_cells elements.
+ * @param [in]     num_cells           Number of cells.
+ * @param [out]    beams               A complex matrix of dimension num_cells x NumberofBeams.
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_dbf_run_cells_c(ifx_DBF_t* handle,
+                         const ifx_Cube_C_t* rng_dopp_spectrum,
+                         const uint16_t* cells,
+                         uint32_t num_cells,
+                         ifx_Matrix_C_t* beams);
+
 /**
  * @brief Performs destruction of DBF handle (object) to clear internal states and memories.
  *
@@ -167,6 +212,20 @@ void ifx_dbf_destroy(ifx_DBF_t* handle);
 IFX_DLL_PUBLIC
 uint32_t ifx_dbf_get_beam_count(ifx_DBF_t* handle);
 
+/**
+ * @brief Sets the thread pool used by \ref ifx_dbf_run_c and \ref ifx_dbf_run_hc.
+ *
+ * The range bins are distributed over the threads of executor. If no
+ * executor is set (the default), they are processed on the calling thread.
+ * The executor is not owned by the handle and must outlive it or be reset
+ * with NULL.
+ *
+ * @param [in]     handle    A handle to the DBF object
+ * @param [in]     executor  Thread pool or NULL
+ */
+IFX_DLL_PUBLIC
+void ifx_dbf_set_executor(ifx_DBF_t* handle, ifx_Executor_t* executor);
+
 /**
  * @}
  */
@@ -61,8 +61,22 @@ static size_t get_samples_per_shape(const ifx_DeInterleaver_Frame_Definition_t::
 void DeInterleaver::set_frame_definition(const ifx_DeInterleaver_Frame_Definition_t& frame_definition)
 {
     m_frame_definition = frame_definition;
-    m_input.clear();
-    m_input.reserve(get_samples_per_frame() * 2);
+
+    const auto samples_per_frame = get_samples_per_frame();
+
+    // the order of the output samples only depends on the frame definition
+    m_plan.clear();
+    size_t position = 0;
+    add_direction_to_plan(position, false);
+    add_direction_to_plan(position, true);
+    m_plan.optimize();
+
+    m_samples_per_frame = samples_per_frame;
+    m_scratch.resize(samples_per_frame);
+
+    m_head = 0;
+    m_size = 0;
+    reserve(samples_per_frame * 2);
 }
 
 size_t DeInterleaver::get_samples_per_frame() const
@@ -81,14 +95,41 @@ size_t DeInterleaver::get_samples_per_frame() const
     return shape_set_size;
 }
 
+void DeInterleaver::reserve(size_t capacity)
+{
+    if (capacity <= m_input.size())
+        return;
+
+    // unwrap the stored samples to the start of the larger buffer
+    std::vector<ifx_Float_t> input(capacity);
+    const size_t tail = std::min(m_size, m_input.size() - m_head);
+    std::copy_n(m_input.begin() + m_head, tail, input.begin());
+    std::copy_n(m_input.begin(), m_size - tail, input.begin() + tail);
+
+    m_input.swap(input);
+    m_head = 0;
+}
+
 void DeInterleaver::add_input_data(const ifx_Float_t* first, const ifx_Float_t* last)
 {
-    m_input.insert(m_input.end(),
-                   first,
-                   last);
+    const auto count = static_cast<size_t>(last - first);
+
+    // grow geometrically, so the buffer stops growing once it holds the backlog
+    if (m_size + count > m_input.size())
+        reserve(std::max(m_size + count, m_input.size() * 2));
+
+    const size_t capacity = m_input.size();
+    size_t tail = m_head + m_size;
+    if (tail >= capacity)
+        tail -= capacity;
+
+    const size_t chunk = std::min(count, capacity - tail);
+    std::copy_n(first, chunk, m_input.begin() + tail);
+    std::copy_n(first + chunk, count - chunk, m_input.begin());
+    m_size += count;
 }
 
-void DeInterleaver::direction_to_antenna_set_shape_samples(std::vector<ifx_Float_t>::iterator& out, bool downwards)
+void DeInterleaver::add_direction_to_plan(size_t& position, bool downwards)
 {
     struct
     {
@@ -123,64 +164,86 @@ void DeInterleaver::direction_to_antenna_set_shape_samples(std::vector<ifx_Float
         size_shape_set += size_shape;
     }
 
+    // one block per chirp holding the interleaved samples of all its antennas,
+    // block_start[i_shape] is the index of the first block of the shape
+    size_t block_start[4];
+    for (size_t i_shape = 0; i_shape < 4; i_shape++)
+    {
+        const auto& shape = m_frame_definition.shape[i_shape];
+        const auto& chirp = downwards ? shape.down : shape.up;
+        const size_t antennas = indexing[i_shape].active_antennas;
+
+        block_start[i_shape] = m_plan.num_blocks();
+        if (antennas == 0)
+            continue;
+
+        for (size_t i_set = 0; i_set < m_frame_definition.shape_set_repeat; i_set++)
+        {
+            for (size_t i_chirp = 0; i_chirp < shape.repeat; i_chirp++)
+            {
+                const size_t base =
+                    size_shape_set * i_set
+                    + indexing[i_shape].shape_offset
+                    + indexing[i_shape].size_chirp * i_chirp;
+
+                m_plan.add_block(base, static_cast<uint32_t>(antennas), static_cast<uint32_t>(chirp.samples_per_chirp));
+            }
+        }
+    }
+
+    // the output is ordered by antenna, shape, shape set and chirp
     for (size_t i_ant = 0; i_ant < 32; i_ant++)
     {
         for (size_t i_shape = 0; i_shape < 4; i_shape++)
         {
-            for (size_t i_set = 0; i_set < m_frame_definition.shape_set_repeat; i_set++)
-            {
-                const auto& shape = m_frame_definition.shape[i_shape];
-                const auto& chirp = downwards ? shape.down : shape.up;
+            const auto& shape = m_frame_definition.shape[i_shape];
+            const auto& chirp = downwards ? shape.down : shape.up;
 
-                const size_t antennas = indexing[i_shape].active_antennas;
-                if (i_ant >= antennas)
-                    break;  // early escape if the antenna isn't active
+            if (i_ant >= indexing[i_shape].active_antennas)
+                continue;  // the antenna isn't active
 
+            for (size_t i_set = 0; i_set < m_frame_definition.shape_set_repeat; i_set++)
+            {
                 for (size_t i_chirp = 0; i_chirp < shape.repeat; i_chirp++)
                 {
-                    const size_t base =
-                        i_ant
-                        + size_shape_set * i_set
-                        + indexing[i_shape].shape_offset
-                        + indexing[i_shape].size_chirp * i_chirp;
-
-                    for (size_t i_sample = 0; i_sample < chirp.samples_per_chirp; i_sample++)
-                    {
-                        *out++ = m_input[base + i_sample * antennas];
-                    }
+                    const size_t block = block_start[i_shape] + i_set * shape.repeat + i_chirp;
+                    m_plan.set_destination(block, static_cast<uint32_t>(i_ant), position);
+                    position += chirp.samples_per_chirp;
                 }
             }
         }
     }
 }
 
-void DeInterleaver::to_direction_antenna_set_shape_samples(std::vector<ifx_Float_t>::iterator& out)
-{
-    direction_to_antenna_set_shape_samples(out, false);
-    direction_to_antenna_set_shape_samples(out, true);
-}
-
 bool DeInterleaver::is_frame_complete() const
 {
-    return m_input.size() >= get_samples_per_frame();
+    return m_size >= m_samples_per_frame && m_samples_per_frame > 0;
 }
 
-std::vector<ifx_Float_t> DeInterleaver::get_deinterleaved_frame()
+void DeInterleaver::get_deinterleaved_frame(ifx_Float_t* output, size_t length)
 {
     if (!is_frame_complete())
         throw rdk::exception::dimension_mismatch();
 
-    const auto samples_per_frame = get_samples_per_frame();
-
-    std::vector<ifx_Float_t> output;
-    output.resize(samples_per_frame);
+    const size_t samples_per_frame = m_samples_per_frame;
+    const size_t capacity = m_input.size();
+    const ifx_Float_t* frame = m_input.data() + m_head;
 
-    auto it_out = output.begin();
-    to_direction_antenna_set_shape_samples(it_out);
+    if (m_head + samples_per_frame > capacity)
+    {
+        // the frame wraps around the end of the ring buffer
+        const size_t tail = capacity - m_head;
+        std::copy_n(frame, tail, m_scratch.begin());
+        std::copy_n(m_input.begin(), samples_per_frame - tail, m_scratch.begin() + tail);
+        frame = m_scratch.data();
+    }
 
-    m_input.erase(m_input.begin(), m_input.begin() + samples_per_frame);
+    m_plan.run(frame, output, length);
 
-    return output;
+    m_head += samples_per_frame;
+    if (m_head >= capacity)
+        m_head -= capacity;
+    m_size -= samples_per_frame;
 }
 
 /* C-compatibility defines and implementation */
@@ -263,10 +326,7 @@ void ifx_di_get_frame(ifx_DeInterleaver_t* handle, ifx_Float_t* data, size_t len
 {
     try
     {
-        const auto frame = handle->get_deinterleaved_frame();
-        const auto sample_count = std::min(frame.size(), length);
-        std::copy(frame.begin(), frame.begin() + sample_count,
-                  data);
+        handle->get_deinterleaved_frame(data, length);
     }
     catch (const rdk::exception::exception& e)
     {
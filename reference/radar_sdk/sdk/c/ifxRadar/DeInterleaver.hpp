@@ -37,6 +37,7 @@
 #ifndef IFX_RADAR_DEINTERLEAVER_HPP
 #define IFX_RADAR_DEINTERLEAVER_HPP
 
+#include "ifxBase/internal/GatherPlan.hpp"
 #include "ifxRadar/internal/DeInterleaver.h"
 #include <vector>
 
@@ -48,7 +49,17 @@
 
 class DeInterleaver
 {
+    // ring buffer of the received samples, m_size samples starting at m_head
     std::vector<ifx_Float_t> m_input;
+    size_t m_head = 0;
+    size_t m_size = 0;
+
+    // copies the chirps of an input frame to their place in the deinterleaved frame
+    ifx::GatherPlan m_plan;
+    size_t m_samples_per_frame = 0;
+
+    // frames wrapping around the end of m_input are unwrapped here first
+    std::vector<ifx_Float_t> m_scratch;
     ifx_DeInterleaver_Frame_Definition_t m_frame_definition {};
 
 public:
@@ -56,11 +67,11 @@ public:
     size_t get_samples_per_frame() const;
     void add_input_data(const ifx_Float_t* first, const ifx_Float_t* last);
     bool is_frame_complete() const;
-    std::vector<ifx_Float_t> get_deinterleaved_frame();
+    void get_deinterleaved_frame(ifx_Float_t* output, size_t length);
 
 private:
-    void direction_to_antenna_set_shape_samples(std::vector<ifx_Float_t>::iterator& out, bool downwards);
-    void to_direction_antenna_set_shape_samples(std::vector<ifx_Float_t>::iterator& out);
+    void reserve(size_t capacity);
+    void add_direction_to_plan(size_t& position, bool downwards);
 };
 
 
@@ -36,6 +36,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ifxAlgo/internal/Unchecked.h"
+
 #include "ifxBase/Complex.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
@@ -76,6 +78,30 @@ struct ifx_DopplerSpectrogram_s
                                              calculation.*/
 };
 
+/**
+ * @brief Defines the structure for the streaming Doppler spectrogram.
+ *        Use type ifx_DopplerSpectrogram_Stream_t for this struct.
+ *
+ * Both ring buffers store each element twice (at i and i + length), so the
+ * last segment and the last rows are always contiguous.
+ */
+struct ifx_DopplerSpectrogram_Stream_s
+{
+    uint32_t rows;               /**< Number of spectrogram rows.*/
+    uint32_t hop;                /**< Number of new samples per row.*/
+    uint32_t segment;            /**< Length of a segment in samples.*/
+    uint32_t fft_size;           /**< Number of columns of a row.*/
+    ifx_Float_t spect_threshold; /**< Threshold in linear scale.*/
+    ifx_PPFFT_t* ppfft_handle;   /**< Doppler FFT with window and mean removal.*/
+    ifx_Vector_C_t* fft_result;  /**< Spectrum of the last segment.*/
+    ifx_Complex_t* samples;      /**< 2 * segment samples.*/
+    uint32_t sample_pos;         /**< Index of the oldest sample of the last segment.*/
+    uint32_t num_samples;        /**< Number of samples appended, at most segment.*/
+    uint32_t since_row;          /**< Number of samples appended since the last row.*/
+    ifx_Float_t* spectrogram;    /**< 2 * rows rows of fft_size values.*/
+    uint32_t row_pos;            /**< Index of the most recent row.*/
+};
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -109,6 +135,30 @@ static void shift_buffer(ifx_Matrix_R_t* output, uint32_t num_rows)
     }
 }
 
+//-----------------------------------------------------------------------------
+
+// Computes a row of the streaming spectrogram from the last segment
+static void stream_add_row(ifx_DopplerSpectrogram_Stream_t* handle)
+{
+    ifx_Vector_C_t segment;
+    ifx_vec_rawview_c(&segment, &handle->samples[handle->sample_pos], handle->segment, 1);
+
+    // segment and fft_result are sized by ifx_doppler_spectrogram_stream_create
+    ifx_ppfft_run_c_unchecked(handle->ppfft_handle, &segment, handle->fft_result);
+    ifx_fft_shift_c(handle->fft_result, handle->fft_result);
+
+    handle->row_pos = (handle->row_pos == 0) ? handle->rows - 1 : handle->row_pos - 1;
+
+    ifx_Float_t* row = &handle->spectrogram[(size_t)handle->row_pos * handle->fft_size];
+    ifx_Vector_R_t row_vec;
+    ifx_vec_rawview_r(&row_vec, row, handle->fft_size, 1);
+
+    ifx_vec_squared_norm_c(handle->fft_result, &row_vec);
+    ifx_vec_spectrum2_to_db(&row_vec, (ifx_Float_t)IFX_SCALE_TYPE_DECIBEL_20LOG, handle->spect_threshold);
+
+    memcpy(row + (size_t)handle->rows * handle->fft_size, row, handle->fft_size * sizeof(ifx_Float_t));
+}
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -133,7 +183,9 @@ ifx_DopplerSpectrogram_t* ifx_doppler_spectrogram_create(const ifx_DopplerSpectr
              /* .mean_removal_enabled = */ true,
              /* .window_config = */ {IFX_WINDOW_BLACKMANHARRIS, config->num_samples, 0, 1},
              /* .is_normalized_window = */ false},
-            config->doppler_fft_config};
+            config->doppler_fft_config,
+            /* .first_range_bin = */ 0,
+            /* .num_range_bins = */ 0};
 
         IFX_ERR_HANDLE_N(h->rdm_handle = ifx_rdm_create(&rdm_config),
                          ifx_doppler_spectrogram_destroy(h));
@@ -275,3 +327,126 @@ ifx_Float_t ifx_doppler_spectrogram_get_threshold(const ifx_DopplerSpectrogram_t
 
     return handle->spect_threshold;
 }
+
+//-----------------------------------------------------------------------------
+
+ifx_DopplerSpectrogram_Stream_t* ifx_doppler_spectrogram_stream_create(const ifx_DopplerSpectrogram_Stream_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->rows == 0);
+    IFX_ERR_BRN_ARGUMENT(config->fft_config.fft_type != IFX_FFT_TYPE_C2C);
+
+    const uint32_t segment = config->fft_config.window_config.size;
+    IFX_ERR_BRN_ARGUMENT(segment == 0 || segment > config->fft_config.fft_size);
+    IFX_ERR_BRN_ARGUMENT(config->hop == 0 || config->hop > segment);
+    IFX_ERR_BRN_COND(config->spect_threshold < 0, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_DopplerSpectrogram_Stream_t* h = ifx_mem_calloc(1, sizeof(struct ifx_DopplerSpectrogram_Stream_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->rows = config->rows;
+    h->hop = config->hop;
+    h->segment = segment;
+    h->fft_size = config->fft_config.fft_size;
+    h->spect_threshold = config->spect_threshold;
+
+    IFX_ERR_HANDLE_N(h->ppfft_handle = ifx_ppfft_create(&config->fft_config),
+                     ifx_doppler_spectrogram_stream_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->fft_result = ifx_vec_create_c(h->fft_size),
+                     ifx_doppler_spectrogram_stream_destroy(h));
+
+    h->samples = ifx_mem_alloc(2 * (size_t)segment * sizeof(ifx_Complex_t));
+    h->spectrogram = ifx_mem_alloc(2 * (size_t)h->rows * h->fft_size * sizeof(ifx_Float_t));
+    if (h->samples == NULL || h->spectrogram == NULL)
+    {
+        ifx_doppler_spectrogram_stream_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    ifx_doppler_spectrogram_stream_reset(h);
+
+    return h;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_doppler_spectrogram_stream_destroy(ifx_DopplerSpectrogram_Stream_t* handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    ifx_ppfft_destroy(handle->ppfft_handle);
+    ifx_vec_destroy_c(handle->fft_result);
+    ifx_mem_free(handle->samples);
+    ifx_mem_free(handle->spectrogram);
+    ifx_mem_free(handle);
+}
+
+//-----------------------------------------------------------------------------
+
+uint32_t ifx_doppler_spectrogram_stream_push_c(ifx_DopplerSpectrogram_Stream_t* handle, const ifx_Vector_C_t* samples)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_VEC_BRV_VALID(samples, 0);
+
+    const uint32_t segment = handle->segment;
+    uint32_t new_rows = 0;
+
+    for (uint32_t i = 0; i < vLen(samples); i++)
+    {
+        // once the segment is full, each sample replaces the oldest one at sample_pos
+        uint32_t pos;
+        if (handle->num_samples < segment)
+            pos = handle->num_samples++;
+        else
+        {
+            pos = handle->sample_pos;
+            handle->sample_pos = (pos + 1 == segment) ? 0 : pos + 1;
+        }
+
+        handle->samples[pos] = vAt(samples, i);
+        handle->samples[pos + segment] = vAt(samples, i);
+
+        handle->since_row++;
+        if ((handle->num_samples == segment) && (handle->since_row >= handle->hop))
+        {
+            stream_add_row(handle);
+            handle->since_row = 0;
+            new_rows++;
+        }
+    }
+
+    return new_rows;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_doppler_spectrogram_stream_get_view(const ifx_DopplerSpectrogram_Stream_t* handle, ifx_Matrix_R_t* view)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(view);
+
+    ifx_mat_rawview_r(view, &handle->spectrogram[(size_t)handle->row_pos * handle->fft_size],
+                      handle->rows, handle->fft_size, handle->fft_size);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_doppler_spectrogram_stream_reset(ifx_DopplerSpectrogram_Stream_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->sample_pos = 0;
+    handle->num_samples = 0;
+    handle->since_row = 0;
+    handle->row_pos = 0;
+
+    // empty rows are at the threshold like rows of a spectrum without signal
+    ifx_Vector_R_t all_rows;
+    ifx_vec_rawview_r(&all_rows, handle->spectrogram, 2 * handle->rows * handle->fft_size, 1);
+    ifx_vec_setall_r(&all_rows, 0);
+    ifx_vec_spectrum2_to_db(&all_rows, (ifx_Float_t)IFX_SCALE_TYPE_DECIBEL_20LOG, handle->spect_threshold);
+}
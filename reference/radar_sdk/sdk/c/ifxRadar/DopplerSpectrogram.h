@@ -85,6 +85,23 @@ typedef struct
     ifx_PPFFT_Config_t doppler_fft_config; /**< Preprocessed FFT settings for Doppler FFT e.g. mean removal, FFT settings.*/
 } ifx_DopplerSpectrogram_Config_t;
 
+/**
+ * @brief A handle for a streaming Doppler spectrogram, see \ref ifx_doppler_spectrogram_stream_create.
+ */
+typedef struct ifx_DopplerSpectrogram_Stream_s ifx_DopplerSpectrogram_Stream_t;
+
+/**
+ * @brief Defines the settings of a streaming Doppler spectrogram.
+ */
+typedef struct
+{
+    uint32_t rows;                 /**< Number of spectrogram rows kept, i.e. length of the history.*/
+    uint32_t hop;                  /**< Number of new slow-time samples per spectrogram row, at most the segment length.*/
+    ifx_Float_t spect_threshold;   /**< Threshold in linear scale, see \ref ifx_DopplerSpectrogram_Config_t.*/
+    ifx_PPFFT_Config_t fft_config; /**< Doppler FFT settings (complex FFT). The window size is the length
+                                        of one STFT segment in slow-time samples.*/
+} ifx_DopplerSpectrogram_Stream_Config_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -203,6 +220,73 @@ void ifx_doppler_spectrogram_set_threshold(ifx_DopplerSpectrogram_t* handle, ifx
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_doppler_spectrogram_get_threshold(const ifx_DopplerSpectrogram_t* handle);
 
+/**
+ * @brief Creates a streaming Doppler spectrogram.
+ *
+ * The streaming spectrogram is a short-time Fourier transform of a slow-time
+ * signal that is appended piece by piece, e.g. the samples of one range bin
+ * of each new frame or the samples of a Doppler radar. The last segment
+ * length samples are kept in a ring buffer. Every hop new samples, one row
+ * is computed from the last segment (consecutive segments overlap by
+ * segment length - hop samples) and stored in a ring buffer of rows. The
+ * cost of appending samples only depends on the number of new samples and
+ * rows, not on the length of the history.
+ *
+ * Each row holds the FFT shifted spectrum in dB like
+ * \ref ifx_doppler_spectrogram_run_cr.
+ *
+ * @param [in]     config    Settings of the streaming spectrogram.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_DopplerSpectrogram_Stream_t* ifx_doppler_spectrogram_stream_create(const ifx_DopplerSpectrogram_Stream_Config_t* config);
+
+/**
+ * @brief Destroys a streaming Doppler spectrogram.
+ *
+ * @param [in]     handle    A handle to the streaming Doppler spectrogram.
+ */
+IFX_DLL_PUBLIC
+void ifx_doppler_spectrogram_stream_destroy(ifx_DopplerSpectrogram_Stream_t* handle);
+
+/**
+ * @brief Appends slow-time samples to a streaming Doppler spectrogram.
+ *
+ * Rows are computed as soon as a full segment is available and hop samples
+ * were appended since the last row.
+ *
+ * @param [in]     handle    A handle to the streaming Doppler spectrogram.
+ * @param [in]     samples   New slow-time samples, oldest first.
+ *
+ * @return Number of new spectrogram rows.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_doppler_spectrogram_stream_push_c(ifx_DopplerSpectrogram_Stream_t* handle, const ifx_Vector_C_t* samples);
+
+/**
+ * @brief Returns a view of the spectrogram of a streaming Doppler spectrogram.
+ *
+ * The view has one row per spectrogram row (most recent row first, rows not
+ * computed yet are at the threshold) and one column per FFT bin. The rows
+ * are stored twice, so the view is always a contiguous part of the ring
+ * buffer and nothing is copied. The view is valid until the next call of
+ * \ref ifx_doppler_spectrogram_stream_push_c.
+ *
+ * @param [in]     handle    A handle to the streaming Doppler spectrogram.
+ * @param [out]    view      Matrix view of the spectrogram.
+ */
+IFX_DLL_PUBLIC
+void ifx_doppler_spectrogram_stream_get_view(const ifx_DopplerSpectrogram_Stream_t* handle, ifx_Matrix_R_t* view);
+
+/**
+ * @brief Clears the samples and rows of a streaming Doppler spectrogram.
+ *
+ * @param [in]     handle    A handle to the streaming Doppler spectrogram.
+ */
+IFX_DLL_PUBLIC
+void ifx_doppler_spectrogram_stream_reset(ifx_DopplerSpectrogram_Stream_t* handle);
+
 /**
  * @}
  */
@@ -0,0 +1,192 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file FixedRdm.cpp
+ *
+ * @brief Registry of compile-time frame geometries for the range Doppler map.
+ */
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/internal/FixedRdm.h"
+#include "ifxRadar/internal/FixedRdm.hpp"
+
+#include <new>
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Type erased ifx::FixedRdm, so one C handle type serves all specializations.
+ */
+struct ifx_RDM_Fixed_s
+{
+    virtual ~ifx_RDM_Fixed_s() = default;
+    virtual void range_fft(const ifx_Float_t* input, size_t chirp_stride, size_t sample_stride,
+                           const ifx_Float_t* window, bool mean_removal) = 0;
+    virtual const ifx_Complex_t* doppler_fft(uint32_t range_bin, const ifx_Float_t* window, bool mean_removal) = 0;
+    virtual const ifx_Float_t* doppler_abs2() = 0;
+};
+
+namespace {
+
+template <uint32_t NumChirps, uint32_t NumSamples>
+struct FixedRdmHandle final : ifx_RDM_Fixed_s
+{
+    void range_fft(const ifx_Float_t* input, size_t chirp_stride, size_t sample_stride,
+                   const ifx_Float_t* window, bool mean_removal) override
+    {
+        rdm.range_fft(input, chirp_stride, sample_stride, window, mean_removal);
+    }
+
+    const ifx_Complex_t* doppler_fft(uint32_t range_bin, const ifx_Float_t* window, bool mean_removal) override
+    {
+        return rdm.doppler_fft(range_bin, window, mean_removal);
+    }
+
+    const ifx_Float_t* doppler_abs2() override
+    {
+        return rdm.doppler_abs2();
+    }
+
+    ifx::FixedRdm<NumChirps, NumSamples> rdm;
+};
+
+struct Specialization
+{
+    uint32_t num_chirps;
+    uint32_t num_samples;
+    ifx_RDM_Fixed_t* (*create)();
+};
+
+template <uint32_t NumChirps, uint32_t NumSamples>
+ifx_RDM_Fixed_t* create_handle()
+{
+    using Handle = FixedRdmHandle<NumChirps, NumSamples>;
+
+    void* memory = ifx_mem_aligned_alloc(sizeof(Handle), alignof(Handle));
+    if (memory == nullptr)
+    {
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return nullptr;
+    }
+
+    auto* handle = new (memory) Handle();
+    if (!handle->rdm.init())
+    {
+        ifx_rdm_fixed_destroy(handle);
+        return nullptr;
+    }
+    return handle;
+}
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+// Geometries processed with ifx::FixedRdm, the first match is used.
+const Specialization specializations[] = {
+    // BGT60TR13C presence profile (presence_radar_settings.h): 64 chirps of 128 samples per RX antenna
+    {64, 128, &create_handle<64, 128>},
+};
+
+}  // namespace
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_RDM_Fixed_t* ifx_rdm_fixed_create(const ifx_RDM_Config_t* config)
+{
+    const ifx_PPFFT_Config_t* range = &config->range_fft_config;
+    const ifx_PPFFT_Config_t* doppler = &config->doppler_fft_config;
+
+    if (range->fft_type != IFX_FFT_TYPE_R2C || doppler->fft_type != IFX_FFT_TYPE_C2C)
+        return nullptr;
+    if (range->window_config.size != range->fft_size || doppler->window_config.size != doppler->fft_size)
+        return nullptr;
+
+    for (const auto& specialization : specializations)
+    {
+        if (specialization.num_chirps == doppler->fft_size && specialization.num_samples == range->fft_size)
+            return specialization.create();
+    }
+
+    return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_fixed_destroy(ifx_RDM_Fixed_t* handle)
+{
+    if (handle == nullptr)
+        return;
+
+    handle->~ifx_RDM_Fixed_s();
+    ifx_mem_aligned_free(handle);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_fixed_range_fft(ifx_RDM_Fixed_t* handle, const ifx_Matrix_R_t* input,
+                             const ifx_Vector_R_t* window, bool mean_removal)
+{
+    handle->range_fft(mDat(input), mStride(input, 0), mStride(input, 1), vDat(window), mean_removal);
+}
+
+//-----------------------------------------------------------------------------
+
+const ifx_Complex_t* ifx_rdm_fixed_doppler_fft(ifx_RDM_Fixed_t* handle, uint32_t range_bin,
+                                               const ifx_Vector_R_t* window, bool mean_removal)
+{
+    return handle->doppler_fft(range_bin, vDat(window), mean_removal);
+}
+
+//-----------------------------------------------------------------------------
+
+const ifx_Float_t* ifx_rdm_fixed_doppler_abs2(ifx_RDM_Fixed_t* handle)
+{
+    return handle->doppler_abs2();
+}
@@ -33,11 +33,14 @@
 ==============================================================================
 */
 
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
@@ -49,6 +52,9 @@
 ==============================================================================
 */
 
+// number of bins searched per call of the peak kernel (multiple of 32)
+#define PEAK_BLOCK 256
+
 /*
 ==============================================================================
    3. LOCAL TYPES
@@ -90,6 +96,13 @@ struct ifx_Peak_Search_s
                                         The size of this vector is equal to peak_count.*/
     ifx_Float_t* peak_val;         /**< This gives the values of the peaks identified in the input data set as a vector.
                                         The size of this vector is equal to peak_count.*/
+    ifx_Float_t* peak_pos;         /**< Interpolated positions of the peaks in bins, see \ref refine_peaks.*/
+    uint32_t candidate_capacity;   /**< Number of elements of candidate_idx and candidate_val.*/
+    uint32_t* candidate_idx;       /**< Indices of all peaks in the search zone, used by \ref ifx_peak_search_run_strongest.*/
+    ifx_Float_t* candidate_val;    /**< Values of all peaks in the search zone, used by \ref ifx_peak_search_run_strongest.*/
+    uint32_t row_capacity;         /**< Number of rows row_idx and row_pos have space for.*/
+    uint32_t* row_idx;             /**< Peak indices of all rows (max_num_peaks per row), used by \ref ifx_peak_search_run_mat.*/
+    ifx_Float_t* row_pos;          /**< Interpolated peak positions of all rows, used by \ref ifx_peak_search_run_mat.*/
 };
 
 /*
@@ -107,15 +120,19 @@ struct ifx_Peak_Search_s
 /**
  * @brief Returns the threshold object
  *
+ * Mean and maximum of the data set are taken in a single pass.
+ *
  * @param [in]     data_set  ...
  * @param [in]     factor    ...
  * @param [in]     offset    ...
+ * @param [out]    max       Maximum of the data set
  *
  * @return Threshold value
  */
 static ifx_Float_t get_threshold(const ifx_Vector_R_t* data_set,
                                  ifx_Float_t factor,
-                                 ifx_Float_t offset);
+                                 ifx_Float_t offset,
+                                 ifx_Float_t* max);
 
 /**
  * @brief Resets the peak search handle
@@ -124,6 +141,80 @@ static ifx_Float_t get_threshold(const ifx_Vector_R_t* data_set,
  */
 static void reset_handle(ifx_Peak_Search_t* handle);
 
+/**
+ * @brief Returns whether a bin lies in the search zone
+ *
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     n         Bin index
+ *
+ * @return true if n*value_per_bin is within the search zone
+ */
+static bool in_zone(const ifx_Peak_Search_t* handle, uint32_t n);
+
+/**
+ * @brief Computes the bins of the search zone that have two neighbours on each side
+ *
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     len       Length of the data set (at least 5)
+ * @param [out]    first     First bin of the search zone
+ * @param [out]    end       One past the last bin of the search zone
+ */
+static void get_zone_bins(const ifx_Peak_Search_t* handle,
+                          uint32_t len,
+                          uint32_t* first,
+                          uint32_t* end);
+
+/**
+ * @brief Finds peaks in the search zone in the order of their indices
+ *
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     data_set  The target data set to search for peaks (at least 5 elements)
+ * @param [in]     max_count Max number of peaks to find
+ * @param [out]    peak_idx  Indices of the peaks found (at least max_count elements)
+ * @param [out]    peak_val  Values of the peaks found (at least max_count elements)
+ *
+ * @return Number of peaks found
+ */
+static uint32_t find_peaks(const ifx_Peak_Search_t* handle,
+                           const ifx_Vector_R_t* data_set,
+                           uint32_t max_count,
+                           uint32_t* peak_idx,
+                           ifx_Float_t* peak_val);
+
+/**
+ * @brief Interpolates the positions of peaks
+ *
+ * A parabola is fitted through each peak and its direct neighbours. The
+ * position of its vertex, peak index plus an offset in [-0.5, 0.5], is the
+ * interpolated position of the peak.
+ *
+ * @param [in]     data_set  The data set the peaks were found in
+ * @param [in]     count     Number of peaks
+ * @param [in]     peak_idx  Indices of the peaks
+ * @param [out]    peak_pos  Interpolated positions of the peaks in bins
+ */
+static void refine_peaks(const ifx_Vector_R_t* data_set,
+                         uint32_t count,
+                         const uint32_t* peak_idx,
+                         ifx_Float_t* peak_pos);
+
+/**
+ * @brief Searches peaks and interpolates their positions
+ *
+ * @param [in]     handle    A handle to the peak search object
+ * @param [in]     data_set  The target data set to search for peaks (at least 5 elements)
+ * @param [in]     strongest If true the strongest peaks are searched, see \ref ifx_peak_search_run_strongest
+ * @param [out]    peak_idx  Indices of the peaks (max_num_peaks elements)
+ * @param [out]    peak_pos  Interpolated positions of the peaks (max_num_peaks elements)
+ *
+ * @return Number of peaks found
+ */
+static uint32_t search_peaks(ifx_Peak_Search_t* handle,
+                             const ifx_Vector_R_t* data_set,
+                             bool strongest,
+                             uint32_t* peak_idx,
+                             ifx_Float_t* peak_pos);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -132,14 +223,14 @@ static void reset_handle(ifx_Peak_Search_t* handle);
 
 static ifx_Float_t get_threshold(const ifx_Vector_R_t* data_set,
                                  ifx_Float_t factor,
-                                 ifx_Float_t offset)
+                                 ifx_Float_t offset,
+                                 ifx_Float_t* max)
 {
-    ifx_Float_t threshold = ifx_vec_sum_r(data_set);
+    ifx_Stats_R_t stats;
+    ifx_vec_stats_r(data_set, &stats);
 
-    threshold *= factor / (ifx_Float_t)vLen(data_set);
-    threshold += offset;
-
-    return threshold;
+    *max = stats.max;
+    return stats.mean * factor + offset;
 }
 
 //----------------------------------------------------------------------------
@@ -149,6 +240,201 @@ static void reset_handle(ifx_Peak_Search_t* handle)
     handle->peak_count = 0;
     memset(handle->peak_idx, 0, sizeof(uint32_t) * handle->max_num_peaks);
     memset(handle->peak_val, 0, sizeof(ifx_Float_t) * handle->max_num_peaks);
+    memset(handle->peak_pos, 0, sizeof(ifx_Float_t) * handle->max_num_peaks);
+}
+
+//----------------------------------------------------------------------------
+
+static bool in_zone(const ifx_Peak_Search_t* handle, uint32_t n)
+{
+    const ifx_Float_t cur_value = n * handle->value_per_bin;
+
+    return cur_value >= handle->search_zone_start && cur_value <= handle->search_zone_end;
+}
+
+//----------------------------------------------------------------------------
+
+static void get_zone_bins(const ifx_Peak_Search_t* handle,
+                          uint32_t len,
+                          uint32_t* first,
+                          uint32_t* end)
+{
+    uint32_t lo = 2;
+    uint32_t hi = len - 2;
+
+    const double start_bin = ceil(handle->search_zone_start / handle->value_per_bin);
+    const double end_bin = floor(handle->search_zone_end / handle->value_per_bin) + 1;
+
+    if (start_bin > lo)
+        lo = (start_bin < hi) ? (uint32_t)start_bin : hi;
+    if (end_bin < hi)
+        hi = (end_bin > lo) ? (uint32_t)end_bin : lo;
+
+    /* The quotients may be off by one bin due to rounding. As n*value_per_bin
+     * grows with n, moving the borders until in_zone changes gives exactly
+     * the bins of the search zone.
+     */
+    while (lo > 2 && in_zone(handle, lo - 1))
+        lo--;
+    while (lo < hi && !in_zone(handle, lo))
+        lo++;
+    while (hi < len - 2 && in_zone(handle, hi))
+        hi++;
+    while (hi > lo && !in_zone(handle, hi - 1))
+        hi--;
+
+    *first = lo;
+    *end = hi;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t find_peaks(const ifx_Peak_Search_t* handle,
+                           const ifx_Vector_R_t* data_set,
+                           uint32_t max_count,
+                           uint32_t* peak_idx,
+                           ifx_Float_t* peak_val)
+{
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    ifx_Float_t block[PEAK_BLOCK + 4];
+    uint32_t mask[PEAK_BLOCK / 32];
+    uint32_t count = 0;
+
+    ifx_Float_t max;
+    ifx_Float_t threshold = get_threshold(data_set,
+                                          handle->threshold_factor,
+                                          handle->threshold_offset,
+                                          &max);
+
+    // no bin reaches the threshold
+    if (max < threshold)
+    {
+        return 0;
+    }
+
+    uint32_t first, end;
+    get_zone_bins(handle, vLen(data_set), &first, &end);
+
+    /* The kernel marks the candidates of a block of bins in a bit mask, so
+     * only the words with set bits need to be looked at. Strided data is
+     * copied to a contiguous block first.
+     */
+    for (uint32_t start = first; start < end; start += PEAK_BLOCK)
+    {
+        const uint32_t len = (end - start < PEAK_BLOCK) ? end - start : PEAK_BLOCK;
+        const ifx_Float_t* x = &vAt(data_set, start - 2);
+
+        if (vStride(data_set) != 1)
+        {
+            for (uint32_t i = 0; i < len + 4; i++)
+                block[i] = vAt(data_set, start - 2 + i);
+            x = block;
+        }
+
+        kernels->peaks_r(x, threshold, mask, len);
+
+        for (uint32_t w = 0; w < (len + 31) / 32; w++)
+        {
+            uint32_t n = start + 32 * w;
+            for (uint32_t bits = mask[w]; bits; bits >>= 1, n++)
+            {
+                if (!(bits & 1))
+                    continue;
+
+                peak_idx[count] = n;
+                peak_val[count] = vAt(data_set, n);
+                ++count;
+
+                if (count >= max_count)
+                {
+                    return count;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------
+
+static void refine_peaks(const ifx_Vector_R_t* data_set,
+                         uint32_t count,
+                         const uint32_t* peak_idx,
+                         ifx_Float_t* peak_pos)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint32_t n = peak_idx[i];
+        const ifx_Float_t fl = vAt(data_set, n - 1);
+        const ifx_Float_t fp = vAt(data_set, n);
+        const ifx_Float_t fr = vAt(data_set, n + 1);
+
+        // negative as fp >= fl and fp > fr for all peaks
+        const ifx_Float_t curvature = fl - 2 * fp + fr;
+        ifx_Float_t delta = 0;
+        if (curvature < 0)
+        {
+            delta = 0.5f * (fl - fr) / curvature;
+            delta = (delta < -0.5f) ? -0.5f : (delta > 0.5f) ? 0.5f : delta;
+        }
+
+        peak_pos[i] = n + delta;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t search_peaks(ifx_Peak_Search_t* handle,
+                             const ifx_Vector_R_t* data_set,
+                             bool strongest,
+                             uint32_t* peak_idx,
+                             ifx_Float_t* peak_pos)
+{
+    uint32_t count = 0;
+
+    if (!strongest)
+    {
+        count = find_peaks(handle, data_set, handle->max_num_peaks,
+                           peak_idx, handle->peak_val);
+        refine_peaks(data_set, count, peak_idx, peak_pos);
+        return count;
+    }
+
+    // there cannot be more peaks than elements
+    if (vLen(data_set) > handle->candidate_capacity)
+    {
+        ifx_mem_free(handle->candidate_idx);
+        ifx_mem_free(handle->candidate_val);
+        handle->candidate_capacity = 0;
+
+        handle->candidate_idx = ifx_mem_alloc(sizeof(uint32_t) * vLen(data_set));
+        handle->candidate_val = ifx_mem_alloc(sizeof(ifx_Float_t) * vLen(data_set));
+        IFX_ERR_BRV_MEMALLOC(handle->candidate_idx && handle->candidate_val, 0);
+        handle->candidate_capacity = vLen(data_set);
+    }
+
+    const uint32_t num_candidates = find_peaks(handle, data_set, handle->candidate_capacity,
+                                               handle->candidate_idx, handle->candidate_val);
+
+    if (num_candidates > 0)
+    {
+        ifx_Vector_R_t candidates = {0};
+        ifx_vec_rawview_r(&candidates, handle->candidate_val, num_candidates, 1);
+
+        // positions within the candidates first, then mapped to indices of data_set
+        count = ifx_vec_topk_r(&candidates, handle->max_num_peaks, IFX_SORT_DESCENDING, peak_idx);
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint32_t candidate = peak_idx[i];
+        peak_idx[i] = handle->candidate_idx[candidate];
+        handle->peak_val[i] = handle->candidate_val[candidate];
+    }
+
+    refine_peaks(data_set, count, peak_idx, peak_pos);
+    return count;
 }
 
 /*
@@ -176,6 +462,15 @@ ifx_Peak_Search_t* ifx_peak_search_create(const ifx_Peak_Search_Config_t* config
 
     h->peak_idx = ifx_mem_alloc(sizeof(uint32_t) * config->max_num_peaks);
     h->peak_val = ifx_mem_alloc(sizeof(ifx_Float_t) * config->max_num_peaks);
+    h->peak_pos = ifx_mem_alloc(sizeof(ifx_Float_t) * config->max_num_peaks);
+
+    h->candidate_capacity = 0;
+    h->candidate_idx = NULL;
+    h->candidate_val = NULL;
+
+    h->row_capacity = 0;
+    h->row_idx = NULL;
+    h->row_pos = NULL;
 
     reset_handle(h);
     return h;
@@ -192,6 +487,11 @@ void ifx_peak_search_destroy(ifx_Peak_Search_t* handle)
 
     ifx_mem_free(handle->peak_idx);
     ifx_mem_free(handle->peak_val);
+    ifx_mem_free(handle->peak_pos);
+    ifx_mem_free(handle->candidate_idx);
+    ifx_mem_free(handle->candidate_val);
+    ifx_mem_free(handle->row_idx);
+    ifx_mem_free(handle->row_pos);
     ifx_mem_free(handle);
 }
 
@@ -213,37 +513,83 @@ void ifx_peak_search_run(ifx_Peak_Search_t* handle,
 
     reset_handle(handle);
 
-    ifx_Float_t threshold = get_threshold(data_set,
-                                          handle->threshold_factor,
-                                          handle->threshold_offset);
+    handle->peak_count = search_peaks(handle, data_set, false,
+                                      handle->peak_idx, handle->peak_pos);
 
-    for (uint32_t n = 2; n < vLen(data_set) - 2; n++)
-    {
-        const ifx_Float_t fp = vAt(data_set, n);
-        const ifx_Float_t fl = vAt(data_set, n - 1);
-        const ifx_Float_t fl2 = vAt(data_set, n - 2);
-        const ifx_Float_t fr = vAt(data_set, n + 1);
-        const ifx_Float_t fr2 = vAt(data_set, n + 2);
+    result->peak_count = handle->peak_count;
+    result->index = handle->peak_idx;
+    result->position = handle->peak_pos;
+}
 
-        if (fp >= threshold && fp >= fl2 && fp >= fl && fp > fr && fp > fr2)
-        {
-            ifx_Float_t cur_value = n * handle->value_per_bin;
+//----------------------------------------------------------------------------
 
-            if (cur_value >= handle->search_zone_start
-                && cur_value <= handle->search_zone_end)
-            {
-                handle->peak_idx[handle->peak_count] = n;
-                handle->peak_val[handle->peak_count] = fp;
-                ++handle->peak_count;
+void ifx_peak_search_run_strongest(ifx_Peak_Search_t* handle,
+                                   const ifx_Vector_R_t* data_set,
+                                   ifx_Peak_Search_Result_t* result)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_VEC_BRK_VALID(data_set);
+    IFX_ERR_BRK_NULL(result);
 
-                if (handle->peak_count >= handle->max_num_peaks)
-                {
-                    break;
-                }
-            }
-        }
+    // data_set length must be minimum 5 because -2/+2 neighbor checking
+    if (vLen(data_set) < 5)
+    {
+        return;
     }
 
+    reset_handle(handle);
+
+    handle->peak_count = search_peaks(handle, data_set, true,
+                                      handle->peak_idx, handle->peak_pos);
+
     result->peak_count = handle->peak_count;
     result->index = handle->peak_idx;
+    result->position = handle->peak_pos;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_peak_search_run_mat(ifx_Peak_Search_t* handle,
+                             const ifx_Matrix_R_t* data,
+                             bool strongest,
+                             ifx_Peak_Search_Result_t* results)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_MAT_BRK_VALID(data);
+    IFX_ERR_BRK_NULL(results);
+
+    const uint32_t rows = mRows(data);
+
+    if (rows > handle->row_capacity)
+    {
+        ifx_mem_free(handle->row_idx);
+        ifx_mem_free(handle->row_pos);
+        handle->row_capacity = 0;
+
+        handle->row_idx = ifx_mem_alloc(sizeof(uint32_t) * rows * handle->max_num_peaks);
+        handle->row_pos = ifx_mem_alloc(sizeof(ifx_Float_t) * rows * handle->max_num_peaks);
+        IFX_ERR_BRK_MEMALLOC(handle->row_idx && handle->row_pos);
+        handle->row_capacity = rows;
+    }
+
+    for (uint32_t r = 0; r < rows; r++)
+    {
+        uint32_t* peak_idx = &handle->row_idx[r * handle->max_num_peaks];
+        ifx_Float_t* peak_pos = &handle->row_pos[r * handle->max_num_peaks];
+
+        results[r].peak_count = 0;
+        results[r].index = peak_idx;
+        results[r].position = peak_pos;
+
+        // rows must have minimum 5 elements because -2/+2 neighbor checking
+        if (mCols(data) < 5)
+        {
+            continue;
+        }
+
+        ifx_Vector_R_t row = {0};
+        ifx_mat_get_rowview_r(data, r, &row);
+
+        results[r].peak_count = search_peaks(handle, &row, strongest, peak_idx, peak_pos);
+    }
 }
@@ -44,6 +44,7 @@
 ==============================================================================
 */
 
+#include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 #include "ifxBase/Vector.h"
 
@@ -98,8 +99,11 @@ typedef struct
  */
 typedef struct
 {
-    uint32_t peak_count; /**< Number of found peaks.*/
-    uint32_t* index;     /**< Array of indices of found peaks.*/
+    uint32_t peak_count;   /**< Number of found peaks.*/
+    uint32_t* index;       /**< Array of indices of found peaks.*/
+    ifx_Float_t* position; /**< Array of interpolated positions of found peaks in bins. A parabola is fitted
+                                through each peak and its direct neighbours, the position of its vertex
+                                differs by at most half a bin from the index.*/
 } ifx_Peak_Search_Result_t;
 
 /**
@@ -170,6 +174,46 @@ void ifx_peak_search_run(ifx_Peak_Search_t* handle,
                          const ifx_Vector_R_t* data_set,
                          ifx_Peak_Search_Result_t* result);
 
+/**
+ * @brief Searches the strongest peaks from input data_set.
+ *
+ * Same as \ref ifx_peak_search_run, but the whole search zone is parsed and
+ * the \ref ifx_Peak_Search_Config_t.max_num_peaks peaks with the largest
+ * values are returned, ordered from the strongest to the weakest peak.
+ *
+ * @param [in,out] handle    A handle to the peak search object
+ * @param [in]     data_set  The target data set to search for peaks
+ * @param [out]    result    Result of the peak search
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_peak_search_run_strongest(ifx_Peak_Search_t* handle,
+                                   const ifx_Vector_R_t* data_set,
+                                   ifx_Peak_Search_Result_t* result);
+
+/**
+ * @brief Searches peaks in each row of a matrix.
+ *
+ * Every row of data is an individual data set, e.g. the range spectra of
+ * several antennas, and is searched like \ref ifx_peak_search_run or, if
+ * strongest is true, like \ref ifx_peak_search_run_strongest. The threshold
+ * is computed from the mean of each row.
+ *
+ * The arrays of the results are owned by the handle and remain valid until
+ * the next call of ifx_peak_search_run_mat.
+ *
+ * @param [in,out] handle    A handle to the peak search object
+ * @param [in]     data      The data sets to search for peaks, one per row
+ * @param [in]     strongest If true the strongest peaks of each row are returned
+ * @param [out]    results   Results of the peak search, one per row of data
+ *
+ */
+IFX_DLL_PUBLIC
+void ifx_peak_search_run_mat(ifx_Peak_Search_t* handle,
+                             const ifx_Matrix_R_t* data,
+                             bool strongest,
+                             ifx_Peak_Search_Result_t* results);
+
 /**
  * @}
  */
@@ -0,0 +1,905 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <string.h>
+
+#include "ifxAlgo/2DMTI.h"
+#include "ifxAlgo/DBSCAN.h"
+#include "ifxAlgo/OSCFAR.h"
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/internal/HandleCache.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/DBF.h"
+#include "ifxRadar/Pipeline.h"
+#include "ifxRadar/RangeDopplerMap.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define TIME_ALPHA              0.125 /* weight of a new time in the moving averages */
+#define GOVERNOR_SETTLE_FRAMES  4     /* frames after a change before the next decision */
+#define GOVERNOR_RESTORE_FRAMES 16    /* frames with headroom before a step is undone */
+#define GOVERNOR_RESTORE_RATIO  0.7f  /* default of restore_ratio */
+#define MAX_OPTIONAL_STAGES     32    /* optional stages are kept in a bit mask */
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Kind of data passed between stages.
+ */
+typedef enum
+{
+    DATA_FRAME,    /**< Real cube (antennas x chirps x samples), only the pipeline input.*/
+    DATA_CUBE_C,   /**< Complex cube.*/
+    DATA_MATRIX_R, /**< Real matrix.*/
+    DATA_CLUSTERS  /**< Detections and their cluster IDs.*/
+} data_type_t;
+
+/**
+ * @brief A stage of a pipeline with its handle and its output.
+ *
+ * The output lives in the arena of the pipeline at offset[slot]. Only the
+ * last stage before overlap_stage has two slots, all other stages use slot 0.
+ */
+typedef struct
+{
+    ifx_Pipeline_Stage_Type_t type; /**< Type of the stage.*/
+    union
+    {
+        ifx_RDM_t* rdm;
+        ifx_2DMTI_C_t* mti;
+        ifx_DBF_t* dbf;
+        ifx_OSCFAR_t* oscfar;
+        ifx_DBSCAN_t* dbscan;
+    } handle;                       /**< Handle of the stage, depends on type.*/
+    data_type_t output_type;        /**< Kind of output.*/
+    uint32_t shape[3];              /**< Shape of the output, for DATA_CLUSTERS the maximum number of detections.*/
+    size_t size;                    /**< Size of the output in bytes, a multiple of IFX_MEMORY_ALIGNMENT.*/
+    uint32_t num_slots;             /**< Number of output buffers, 2 if double buffered.*/
+    size_t offset[2];               /**< Offset of the output buffers in the arena.*/
+    ifx_Cube_C_t cube[2];           /**< Output views for DATA_CUBE_C.*/
+    ifx_Matrix_R_t matrix[2];       /**< Output views for DATA_MATRIX_R.*/
+    uint16_t* detections[2];        /**< Output detections for DATA_CLUSTERS.*/
+    uint16_t* clusters[2];          /**< Output cluster IDs for DATA_CLUSTERS.*/
+    uint32_t num_detections[2];     /**< Number of detections for DATA_CLUSTERS.*/
+    bool optional;                  /**< Stage may be skipped by the governor.*/
+    double time_s;                  /**< Moving average of the processing time, 0 before the first frame.*/
+} stage_t;
+
+/**
+ * @brief Defines the structure for the pipeline.
+ *        Use type ifx_Pipeline_t for this struct.
+ */
+struct ifx_Pipeline_s
+{
+    stage_t* stages;                /**< Stages in processing order.*/
+    uint32_t num_stages;            /**< Number of stages.*/
+    uint32_t overlap_stage;         /**< First stage processing the previous frame, 0 if frames are not overlapped.*/
+    ifx_Executor_t* executor;       /**< Thread pool, may be NULL.*/
+    uint8_t* arena;                 /**< Memory of all stage outputs.*/
+    size_t arena_size;              /**< Size of arena in bytes.*/
+    uint32_t frame_count;           /**< Number of frames processed.*/
+    const ifx_Cube_R_t* frame;      /**< Frame of the current call of ifx_pipeline_run.*/
+    ifx_Cube_Layout_t frame_layout; /**< Memory layout of the frames.*/
+    ifx_Cube_R_t frame_view;        /**< Frame in logical order if frame_layout is not antenna major.*/
+    uint32_t output_stage;          /**< Stage holding the output, the last one not skipped.*/
+    uint32_t output_slot;           /**< Slot of output_stage holding the output.*/
+
+    uint32_t optional_mask;                  /**< Bit i is set if stage i is optional.*/
+    ifx_Pipeline_Governor_Config_t governor; /**< Governor settings, budget_s is 0 without governor.*/
+    ifx_Pipeline_Quality_Level_t level;      /**< Current quality level.*/
+    uint32_t decimation;                     /**< Only every decimation-th frame is processed.*/
+    uint32_t input_count;                    /**< Number of frames passed to ifx_pipeline_run.*/
+    uint32_t front_skipped;                  /**< Stages skipped by the front stages of the previous frame.*/
+    ifx_Float_t lag_s;                       /**< Lag reported by ifx_pipeline_set_input_lag.*/
+    double load_s;                           /**< Moving average of the processing time per processed frame.*/
+    uint32_t settle;                         /**< Frames left until the governor decides again.*/
+    uint32_t restore_count;                  /**< Consecutive frames with headroom for the next higher quality.*/
+    ifx_Pipeline_Quality_t quality;          /**< Quality of the current output.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void init_stage(stage_t* stage,
+                       const ifx_Pipeline_Stage_t* config,
+                       data_type_t input_type,
+                       const uint32_t input_shape[3],
+                       ifx_Executor_t* executor);
+
+static size_t plan_chain(stage_t* stages, uint32_t num_stages, size_t base);
+
+static void init_views(ifx_Pipeline_t* pipeline);
+
+static void run_stages(ifx_Pipeline_t* pipeline, uint32_t first, uint32_t last, uint32_t parity, uint32_t skipped);
+
+static void set_level(ifx_Pipeline_t* pipeline, ifx_Pipeline_Quality_Level_t level, uint32_t decimation);
+
+static void govern(ifx_Pipeline_t* pipeline, double elapsed_s);
+
+static void run_halves(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/**
+ * @brief Creates the handle of a stage and derives its output from its input.
+ *
+ * Sets IFX_ERROR_DIMENSION_MISMATCH if the input does not fit the stage.
+ */
+static void init_stage(stage_t* stage,
+                       const ifx_Pipeline_Stage_t* config,
+                       data_type_t input_type,
+                       const uint32_t input_shape[3],
+                       ifx_Executor_t* executor)
+{
+    const uint32_t rows = input_shape[0];
+    const uint32_t cols = input_shape[1];
+    const uint32_t slices = input_shape[2];
+
+    stage->type = config->type;
+
+    switch (config->type)
+    {
+        case IFX_PIPELINE_STAGE_RDM: {
+            const ifx_RDM_Config_t* rdm = &config->config.rdm;
+            IFX_ERR_BRK_COND(input_type != DATA_FRAME, IFX_ERROR_DIMENSION_MISMATCH);
+            IFX_ERR_BRK_ARGUMENT(rdm->range_fft_config.fft_type != IFX_FFT_TYPE_R2C);
+            IFX_ERR_BRK_COND(rdm->range_fft_config.window_config.size != slices, IFX_ERROR_DIMENSION_MISMATCH);
+            IFX_ERR_BRK_COND(rdm->doppler_fft_config.window_config.size != cols, IFX_ERROR_DIMENSION_MISMATCH);
+
+            stage->handle.rdm = ifx_rdm_acquire(rdm);
+            IFX_ERR_BRK_MEMALLOC(stage->handle.rdm);
+            ifx_rdm_set_executor(stage->handle.rdm, executor);
+
+            stage->output_type = DATA_CUBE_C;
+            stage->shape[0] = ifx_rdm_get_num_range_bins(stage->handle.rdm);
+            stage->shape[1] = rdm->doppler_fft_config.fft_size;
+            stage->shape[2] = rows;
+            break;
+        }
+        case IFX_PIPELINE_STAGE_MTI:
+            IFX_ERR_BRK_COND(input_type != DATA_CUBE_C, IFX_ERROR_DIMENSION_MISMATCH);
+
+            stage->handle.mti = ifx_2dmti_create_cube_c(config->config.mti_alpha, rows, cols, slices);
+            IFX_ERR_BRK_MEMALLOC(stage->handle.mti);
+
+            stage->output_type = DATA_CUBE_C;
+            memcpy(stage->shape, input_shape, sizeof(stage->shape));
+            break;
+
+        case IFX_PIPELINE_STAGE_DBF:
+            IFX_ERR_BRK_COND(input_type != DATA_CUBE_C, IFX_ERROR_DIMENSION_MISMATCH);
+            IFX_ERR_BRK_COND(config->config.dbf.num_antennas > slices, IFX_ERROR_DIMENSION_MISMATCH);
+
+            stage->handle.dbf = ifx_dbf_create(&config->config.dbf);
+            IFX_ERR_BRK_MEMALLOC(stage->handle.dbf);
+            ifx_dbf_set_executor(stage->handle.dbf, executor);
+
+            stage->output_type = DATA_CUBE_C;
+            stage->shape[0] = rows;
+            stage->shape[1] = cols;
+            stage->shape[2] = config->config.dbf.num_beams;
+            break;
+
+        case IFX_PIPELINE_STAGE_INTEGRATE:
+            IFX_ERR_BRK_COND(input_type != DATA_CUBE_C, IFX_ERROR_DIMENSION_MISMATCH);
+
+            stage->output_type = DATA_MATRIX_R;
+            stage->shape[0] = rows;
+            stage->shape[1] = cols;
+            stage->shape[2] = 1;
+            break;
+
+        case IFX_PIPELINE_STAGE_OSCFAR:
+            IFX_ERR_BRK_COND(input_type != DATA_MATRIX_R, IFX_ERROR_DIMENSION_MISMATCH);
+
+            stage->handle.oscfar = ifx_oscfar_acquire(&config->config.oscfar);
+            IFX_ERR_BRK_MEMALLOC(stage->handle.oscfar);
+
+            stage->output_type = DATA_MATRIX_R;
+            memcpy(stage->shape, input_shape, sizeof(stage->shape));
+            break;
+
+        case IFX_PIPELINE_STAGE_DBSCAN:
+            IFX_ERR_BRK_COND(input_type != DATA_MATRIX_R, IFX_ERROR_DIMENSION_MISMATCH);
+            // ifx_dbscan_run counts detections with uint16_t
+            IFX_ERR_BRK_ARGUMENT(config->config.dbscan.max_num_detections == 0 || config->config.dbscan.max_num_detections > UINT16_MAX);
+
+            stage->handle.dbscan = ifx_dbscan_create(&config->config.dbscan);
+            IFX_ERR_BRK_MEMALLOC(stage->handle.dbscan);
+
+            stage->output_type = DATA_CLUSTERS;
+            stage->shape[0] = config->config.dbscan.max_num_detections;
+            stage->shape[1] = 1;
+            stage->shape[2] = 1;
+            break;
+
+        default:
+            IFX_ERR_BRK_ARGUMENT(true);
+    }
+
+    size_t size;
+    if (stage->output_type == DATA_CUBE_C)
+        size = (size_t)stage->shape[0] * stage->shape[1] * stage->shape[2] * sizeof(ifx_Complex_t);
+    else if (stage->output_type == DATA_MATRIX_R)
+        size = (size_t)stage->shape[0] * stage->shape[1] * sizeof(ifx_Float_t);
+    else
+        size = 3 * (size_t)stage->shape[0] * sizeof(uint16_t);  // (row, column) and cluster ID
+
+    stage->size = IFX_ALIGN(size, IFX_MEMORY_ALIGNMENT);
+    stage->num_slots = 1;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Places the outputs of a chain of stages in a region of the arena.
+ *
+ * The input of a stage must not overlap its output, but is not needed
+ * afterwards. So even stages are placed at the start of the region and odd
+ * stages at its end, and the region only needs to hold the largest pair of
+ * consecutive outputs. Double buffered outputs are skipped, the caller
+ * places them. Returns the size of the region.
+ *
+ * When an optional stage is skipped, the stage after it reads the output of
+ * the stage before it. Optional stages therefore do not take part in the
+ * alternation and get buffers of their own behind it.
+ */
+static size_t plan_chain(stage_t* stages, uint32_t num_stages, size_t base)
+{
+    size_t region = 0;
+    size_t prev = 0;
+    for (uint32_t i = 0; i < num_stages; i++)
+    {
+        if (stages[i].optional)
+            continue;
+        region = MAX(region, prev + stages[i].size);
+        prev = stages[i].size;
+    }
+
+    size_t end = base + region;
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < num_stages; i++)
+    {
+        if (stages[i].optional)
+        {
+            stages[i].offset[0] = end;
+            end += stages[i].size;
+        }
+        else
+        {
+            stages[i].offset[0] = (n % 2 == 0) ? base : base + region - stages[i].size;
+            n++;
+        }
+    }
+
+    return end - base;
+}
+
+//----------------------------------------------------------------------------
+
+static void init_views(ifx_Pipeline_t* pipeline)
+{
+    for (uint32_t i = 0; i < pipeline->num_stages; i++)
+    {
+        stage_t* stage = &pipeline->stages[i];
+
+        for (uint32_t slot = 0; slot < stage->num_slots; slot++)
+        {
+            uint8_t* data = pipeline->arena + stage->offset[slot];
+
+            if (stage->output_type == DATA_CUBE_C)
+            {
+                const size_t stride[] = {(size_t)stage->shape[1] * stage->shape[2], stage->shape[2], 1};
+                ifx_mda_rawview_c(&stage->cube[slot], (ifx_Complex_t*)data, 3, stage->shape, stride, 0);
+            }
+            else if (stage->output_type == DATA_MATRIX_R)
+            {
+                ifx_mat_rawview_r(&stage->matrix[slot], (ifx_Float_t*)data, stage->shape[0], stage->shape[1], stage->shape[1]);
+            }
+            else
+            {
+                stage->detections[slot] = (uint16_t*)data;
+                stage->clusters[slot] = stage->detections[slot] + 2 * (size_t)stage->shape[0];
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Mean absolute value over the slices of a cube */
+static void integrate(const ifx_Cube_C_t* input, ifx_Matrix_R_t* output)
+{
+    const ifx_Float_t scale = 1.0f / (ifx_Float_t)cSlices(input);
+
+    for (uint32_t r = 0; r < cRows(input); r++)
+    {
+        for (uint32_t c = 0; c < cCols(input); c++)
+        {
+            const ifx_Complex_t* cell = &IFX_CUBE_AT(input, r, c, 0);
+            const size_t stride = IFX_MDA_STRIDE(input)[2];
+
+            ifx_Float_t sum = 0;
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                sum += ifx_complex_abs(cell[s * stride]);
+
+            IFX_MAT_AT(output, r, c) = sum * scale;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Collects the non-zero cells of a detector output and clusters them */
+static void cluster(stage_t* stage, const ifx_Matrix_R_t* input, uint32_t slot)
+{
+    uint16_t* detections = stage->detections[slot];
+    uint32_t n = 0;
+
+    for (uint32_t r = 0; r < mRows(input) && n < stage->shape[0]; r++)
+    {
+        for (uint32_t c = 0; c < mCols(input) && n < stage->shape[0]; c++)
+        {
+            if (IFX_MAT_AT(input, r, c) != 0)
+            {
+                detections[2 * n] = (uint16_t)r;
+                detections[2 * n + 1] = (uint16_t)c;
+                n++;
+            }
+        }
+    }
+
+    stage->num_detections[slot] = n;
+    ifx_dbscan_run(stage->handle.dbscan, detections, (uint16_t)n, stage->clusters[slot]);
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Runs the stages first to last-1 on the frame with the given parity.
+ *
+ * The parity selects the slot of double buffered outputs, so the front and
+ * the back stages of consecutive frames use different buffers. Stages whose
+ * bit is set in skipped pass their input on to the next stage.
+ */
+static void run_stages(ifx_Pipeline_t* pipeline, uint32_t first, uint32_t last, uint32_t parity, uint32_t skipped)
+{
+    const stage_t* prev = (first > 0) ? &pipeline->stages[first - 1] : NULL;
+
+    for (uint32_t i = first; i < last; i++)
+    {
+        if (i < MAX_OPTIONAL_STAGES && (skipped >> i) & 1)
+            continue;
+
+        stage_t* stage = &pipeline->stages[i];
+        const uint32_t out = (stage->num_slots > 1) ? parity : 0;
+        const uint32_t in = (prev && prev->num_slots > 1) ? parity : 0;
+        const uint64_t start_ns = ifx_handle_cache_now_ns();
+
+        switch (stage->type)
+        {
+            case IFX_PIPELINE_STAGE_RDM:
+                ifx_rdm_run_cube_rc(stage->handle.rdm, pipeline->frame, &stage->cube[out]);
+                break;
+            case IFX_PIPELINE_STAGE_MTI:
+                ifx_2dmti_run_cube_c(stage->handle.mti, &prev->cube[in], &stage->cube[out]);
+                break;
+            case IFX_PIPELINE_STAGE_DBF:
+                ifx_dbf_run_c(stage->handle.dbf, &prev->cube[in], &stage->cube[out]);
+                break;
+            case IFX_PIPELINE_STAGE_INTEGRATE:
+                integrate(&prev->cube[in], &stage->matrix[out]);
+                break;
+            case IFX_PIPELINE_STAGE_OSCFAR:
+                ifx_oscfar_run(stage->handle.oscfar, (ifx_Matrix_R_t*)&prev->matrix[in], &stage->matrix[out]);
+                break;
+            case IFX_PIPELINE_STAGE_DBSCAN:
+                cluster(stage, &prev->matrix[in], out);
+                break;
+        }
+
+        if (ifx_error_get() != IFX_OK)
+            return;
+
+        const double time_s = (double)(ifx_handle_cache_now_ns() - start_ns) * 1e-9;
+        stage->time_s = (stage->time_s == 0) ? time_s : stage->time_s + TIME_ALPHA * (time_s - stage->time_s);
+        prev = stage;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Executor task running the front stages (0) or the back stages (1) */
+static void run_halves(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    (void)thread;
+
+    ifx_Pipeline_t* pipeline = context;
+    const uint32_t parity = pipeline->frame_count % 2;
+    const uint32_t skipped = (pipeline->level != IFX_PIPELINE_QUALITY_FULL) ? pipeline->optional_mask : 0;
+
+    for (uint32_t half = begin; half < end; half++)
+    {
+        if (half == 0)
+            run_stages(pipeline, 0, pipeline->overlap_stage, parity, skipped);
+        else if (pipeline->frame_count > 0)
+            run_stages(pipeline, pipeline->overlap_stage, pipeline->num_stages, 1 - parity, skipped);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Changes the quality and restarts the measurement of the load */
+static void set_level(ifx_Pipeline_t* pipeline, ifx_Pipeline_Quality_Level_t level, uint32_t decimation)
+{
+    pipeline->level = level;
+    pipeline->decimation = decimation;
+    pipeline->load_s = 0;
+    pipeline->settle = GOVERNOR_SETTLE_FRAMES;
+    pipeline->restore_count = 0;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Updates the load after a processed frame and adapts the quality.
+ *
+ * The quality is lowered by one step as soon as the load exceeds the budget
+ * and raised by one step only after the estimated load of the higher quality
+ * has stayed below restore_ratio for GOVERNOR_RESTORE_FRAMES frames, so the
+ * quality does not oscillate around the budget.
+ */
+static void govern(ifx_Pipeline_t* pipeline, double elapsed_s)
+{
+    const ifx_Pipeline_Governor_Config_t* governor = &pipeline->governor;
+    const double budget_s = governor->budget_s;
+
+    pipeline->load_s = (pipeline->load_s == 0) ? elapsed_s : pipeline->load_s + TIME_ALPHA * (elapsed_s - pipeline->load_s);
+    pipeline->quality.load = (ifx_Float_t)(pipeline->load_s / (budget_s * pipeline->decimation));
+
+    if (pipeline->settle > 0)
+    {
+        pipeline->settle--;
+        return;
+    }
+
+    // quality.load is the time per incoming frame, dropped frames cost nothing
+    if (pipeline->quality.load > 1 || pipeline->lag_s > budget_s)
+    {
+        if (pipeline->level == IFX_PIPELINE_QUALITY_FULL && pipeline->optional_mask)
+            set_level(pipeline, IFX_PIPELINE_QUALITY_REDUCED, 1);
+        else if (pipeline->decimation < governor->max_decimation)
+            set_level(pipeline, IFX_PIPELINE_QUALITY_DECIMATED, pipeline->decimation + 1);
+        else
+            pipeline->restore_count = 0;
+        return;
+    }
+
+    double restored;
+    if (pipeline->decimation > 1)
+    {
+        restored = pipeline->load_s / (budget_s * (pipeline->decimation - 1));
+    }
+    else if (pipeline->level == IFX_PIPELINE_QUALITY_REDUCED)
+    {
+        // the skipped stages would cost what they took when they last ran
+        double optional_s = 0;
+        for (uint32_t i = 0; i < pipeline->num_stages; i++)
+        {
+            if (pipeline->stages[i].optional)
+                optional_s += pipeline->stages[i].time_s;
+        }
+        restored = (pipeline->load_s + optional_s) / budget_s;
+    }
+    else
+    {
+        return;
+    }
+
+    if (restored >= governor->restore_ratio)
+    {
+        pipeline->restore_count = 0;
+        return;
+    }
+
+    if (++pipeline->restore_count < GOVERNOR_RESTORE_FRAMES)
+        return;
+
+    if (pipeline->decimation > 2)
+        set_level(pipeline, IFX_PIPELINE_QUALITY_DECIMATED, pipeline->decimation - 1);
+    else if (pipeline->decimation == 2 && pipeline->optional_mask)
+        set_level(pipeline, IFX_PIPELINE_QUALITY_REDUCED, 1);
+    else
+        set_level(pipeline, IFX_PIPELINE_QUALITY_FULL, 1);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Pipeline_t* ifx_pipeline_create(const ifx_Pipeline_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_NULL(config->stages);
+    IFX_ERR_BRN_ARGUMENT(config->num_stages == 0);
+    IFX_ERR_BRN_ARGUMENT(config->num_antennas == 0 || config->num_chirps == 0 || config->num_samples == 0);
+    IFX_ERR_BRN_ARGUMENT(config->overlap_stage >= config->num_stages);
+    IFX_ERR_BRN_ARGUMENT(config->overlap_stage > 0 && config->executor == NULL);
+    IFX_ERR_BRN_ARGUMENT(config->frame_layout >= IFX_CUBE_LAYOUT_OTHER);
+
+    ifx_Pipeline_t* p = ifx_mem_calloc(1, sizeof(struct ifx_Pipeline_s));
+    IFX_ERR_BRN_MEMALLOC(p);
+
+    p->stages = ifx_mem_calloc(config->num_stages, sizeof(stage_t));
+    if (p->stages == NULL)
+    {
+        ifx_pipeline_destroy(p);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    p->overlap_stage = config->overlap_stage;
+    p->executor = config->executor;
+    p->frame_layout = config->frame_layout;
+    p->output_stage = config->num_stages - 1;
+    p->level = IFX_PIPELINE_QUALITY_FULL;
+    p->decimation = 1;
+    p->quality.level = IFX_PIPELINE_QUALITY_FULL;
+    p->quality.decimation = 1;
+
+    // check that the output of each stage fits the next one
+    data_type_t type = DATA_FRAME;
+    const uint32_t* shape = (const uint32_t[]) {config->num_antennas, config->num_chirps, config->num_samples};
+
+    for (uint32_t i = 0; i < config->num_stages; i++)
+    {
+        IFX_ERR_HANDLE_N(init_stage(&p->stages[i], &config->stages[i], type, shape, config->executor),
+                         ifx_pipeline_destroy(p));
+        p->num_stages++;
+
+        if (config->stages[i].optional)
+        {
+            // a skipped stage passes its input on, so it must keep the kind
+            // and shape of the data; the double buffered handoff cannot be skipped
+            const bool keeps_data = (p->stages[i].output_type == type) && !memcmp(p->stages[i].shape, shape, sizeof(p->stages[i].shape));
+            if (!keeps_data || i >= MAX_OPTIONAL_STAGES || (p->overlap_stage > 0 && i == p->overlap_stage - 1))
+            {
+                ifx_pipeline_destroy(p);
+                IFX_ERR_BRN_ARGUMENT(true);
+            }
+            p->stages[i].optional = true;
+            p->optional_mask |= 1u << i;
+        }
+
+        type = p->stages[i].output_type;
+        shape = p->stages[i].shape;
+
+        if (type == DATA_CLUSTERS && i + 1 < config->num_stages)
+        {
+            ifx_pipeline_destroy(p);
+            IFX_ERR_BRN_COND(true, IFX_ERROR_DIMENSION_MISMATCH);
+        }
+    }
+
+    // plan the arena: front chain | handoff slot 0 | handoff slot 1 | back chain
+    if (p->overlap_stage > 0)
+    {
+        stage_t* handoff = &p->stages[p->overlap_stage - 1];
+        const size_t front = plan_chain(p->stages, p->overlap_stage - 1, 0);
+
+        handoff->num_slots = 2;
+        handoff->offset[0] = front;
+        handoff->offset[1] = front + handoff->size;
+
+        const size_t back = plan_chain(&p->stages[p->overlap_stage], p->num_stages - p->overlap_stage, front + 2 * handoff->size);
+        p->arena_size = front + 2 * handoff->size + back;
+    }
+    else
+    {
+        p->arena_size = plan_chain(p->stages, p->num_stages, 0);
+    }
+
+    p->arena = ifx_mem_aligned_alloc(p->arena_size, IFX_MEMORY_ALIGNMENT);
+    if (p->arena == NULL)
+    {
+        ifx_pipeline_destroy(p);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    init_views(p);
+
+    // the range Doppler map creates its per antenna handles on first use, so
+    // run it once on zeros; it is stateless, unlike e.g. the MTI filter
+    if (p->stages[0].type == IFX_PIPELINE_STAGE_RDM)
+    {
+        ifx_Cube_R_t* zeros = ifx_cube_create_r(config->num_antennas, config->num_chirps, config->num_samples);
+        if (zeros == NULL)
+        {
+            ifx_pipeline_destroy(p);
+            IFX_ERR_BRN_MEMALLOC(NULL);
+        }
+        ifx_cube_clear_r(zeros);
+
+        IFX_ERR_HANDLE_N(ifx_rdm_run_cube_rc(p->stages[0].handle.rdm, zeros, &p->stages[0].cube[0]),
+                         ifx_cube_destroy_r(zeros);
+                         ifx_pipeline_destroy(p));
+        ifx_cube_destroy_r(zeros);
+    }
+
+    return p;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_pipeline_destroy(ifx_Pipeline_t* pipeline)
+{
+    if (pipeline == NULL)
+        return;
+
+    for (uint32_t i = 0; i < pipeline->num_stages; i++)
+    {
+        stage_t* stage = &pipeline->stages[i];
+
+        switch (stage->type)
+        {
+            case IFX_PIPELINE_STAGE_RDM:
+                ifx_rdm_release(stage->handle.rdm);
+                break;
+            case IFX_PIPELINE_STAGE_MTI:
+                ifx_2dmti_destroy_c(stage->handle.mti);
+                break;
+            case IFX_PIPELINE_STAGE_DBF:
+                ifx_dbf_destroy(stage->handle.dbf);
+                break;
+            case IFX_PIPELINE_STAGE_OSCFAR:
+                ifx_oscfar_release(stage->handle.oscfar);
+                break;
+            case IFX_PIPELINE_STAGE_DBSCAN:
+                ifx_dbscan_destroy(stage->handle.dbscan);
+                break;
+            default:
+                break;
+        }
+    }
+
+    ifx_mem_aligned_free(pipeline->arena);
+    ifx_mem_free(pipeline->stages);
+    ifx_mem_free(pipeline);
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_pipeline_run(ifx_Pipeline_t* pipeline, const ifx_Cube_R_t* frame)
+{
+    IFX_ERR_BRV_NULL(pipeline, false);
+    IFX_CUBE_BRV_VALID(frame, false);
+
+    if (pipeline->frame_layout != IFX_CUBE_LAYOUT_ANTENNA_MAJOR)
+    {
+        // the stages accept strided cubes, so the frame is never reordered
+        ifx_cube_layout_view_r(frame, pipeline->frame_layout, &pipeline->frame_view);
+        if (ifx_error_get() != IFX_OK)
+            return false;
+        frame = &pipeline->frame_view;
+    }
+
+    // dropped frames do not enter the pipeline, so overlapped halves stay paired
+    const uint32_t input = pipeline->input_count++;
+    if (input % pipeline->decimation != 0)
+        return false;
+
+    const uint64_t start_ns = ifx_handle_cache_now_ns();
+    const uint32_t skipped = (pipeline->level != IFX_PIPELINE_QUALITY_FULL) ? pipeline->optional_mask : 0;
+    const uint32_t parity = pipeline->frame_count % 2;
+
+    pipeline->frame = frame;
+
+    if (pipeline->overlap_stage > 0)
+        ifx_executor_parallel_for(pipeline->executor, 2, 1, run_halves, pipeline);
+    else
+        run_stages(pipeline, 0, pipeline->num_stages, 0, skipped);
+
+    pipeline->frame = NULL;
+    pipeline->frame_count++;
+
+    if (ifx_error_get() != IFX_OK)
+        return false;
+
+    const double elapsed_s = (double)(ifx_handle_cache_now_ns() - start_ns) * 1e-9;
+
+    // the output comes from the last stage that was not skipped; the handoff
+    // is never optional, so the search stays within the back stages
+    uint32_t output = pipeline->num_stages - 1;
+    while (output < MAX_OPTIONAL_STAGES && (skipped >> output) & 1)
+        output--;
+    pipeline->output_stage = output;
+    pipeline->output_slot = (pipeline->stages[output].num_slots > 1) ? 1 - parity : 0;
+
+    // with overlapped frames the front stages of the output ran in the previous call
+    uint32_t output_skipped = skipped;
+    if (pipeline->overlap_stage > 0)
+    {
+        const uint32_t front = (pipeline->overlap_stage < 32) ? (1u << pipeline->overlap_stage) - 1 : UINT32_MAX;
+        output_skipped = (pipeline->front_skipped & front) | (skipped & ~front);
+        pipeline->front_skipped = skipped;
+    }
+
+    const bool has_output = (pipeline->overlap_stage == 0) || (pipeline->frame_count > 1);
+    if (has_output)
+    {
+        pipeline->quality.level = pipeline->level;
+        pipeline->quality.skipped_stages = output_skipped;
+        pipeline->quality.decimation = pipeline->decimation;
+        pipeline->quality.processing_time_s = (ifx_Float_t)elapsed_s;
+    }
+
+    if (pipeline->governor.budget_s > 0)
+        govern(pipeline, elapsed_s);
+
+    return has_output;
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Cube_C_t* ifx_pipeline_get_cube_c(const ifx_Pipeline_t* pipeline)
+{
+    IFX_ERR_BRN_NULL(pipeline);
+
+    const stage_t* last = &pipeline->stages[pipeline->num_stages - 1];
+    IFX_ERR_BRN_COND(last->output_type != DATA_CUBE_C, IFX_ERROR_ARGUMENT_INVALID);
+
+    return &pipeline->stages[pipeline->output_stage].cube[pipeline->output_slot];
+}
+
+//----------------------------------------------------------------------------
+
+const ifx_Matrix_R_t* ifx_pipeline_get_matrix_r(const ifx_Pipeline_t* pipeline)
+{
+    IFX_ERR_BRN_NULL(pipeline);
+
+    const stage_t* last = &pipeline->stages[pipeline->num_stages - 1];
+    IFX_ERR_BRN_COND(last->output_type != DATA_MATRIX_R, IFX_ERROR_ARGUMENT_INVALID);
+
+    return &pipeline->stages[pipeline->output_stage].matrix[pipeline->output_slot];
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_pipeline_get_clusters(const ifx_Pipeline_t* pipeline,
+                                   const uint16_t** detections,
+                                   const uint16_t** clusters)
+{
+    IFX_ERR_BRV_NULL(pipeline, 0);
+    IFX_ERR_BRV_NULL(detections, 0);
+    IFX_ERR_BRV_NULL(clusters, 0);
+
+    const stage_t* last = &pipeline->stages[pipeline->num_stages - 1];
+    IFX_ERR_BRV_COND(last->output_type != DATA_CLUSTERS, IFX_ERROR_ARGUMENT_INVALID, 0);
+
+    // DBSCAN changes the kind of data, so it is never skipped
+    *detections = last->detections[0];
+    *clusters = last->clusters[0];
+    return last->num_detections[0];
+}
+
+//----------------------------------------------------------------------------
+
+size_t ifx_pipeline_get_arena_size(const ifx_Pipeline_t* pipeline)
+{
+    IFX_ERR_BRV_NULL(pipeline, 0);
+
+    return pipeline->arena_size;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_pipeline_set_governor(ifx_Pipeline_t* pipeline, const ifx_Pipeline_Governor_Config_t* config)
+{
+    IFX_ERR_BRK_NULL(pipeline);
+
+    ifx_Pipeline_Governor_Config_t governor = {0};
+    if (config)
+    {
+        IFX_ERR_BRK_ARGUMENT(config->budget_s < 0);
+        IFX_ERR_BRK_ARGUMENT(config->restore_ratio < 0 || config->restore_ratio >= 1);
+
+        governor = *config;
+        if (governor.restore_ratio == 0)
+            governor.restore_ratio = GOVERNOR_RESTORE_RATIO;
+    }
+
+    pipeline->governor = governor;
+    set_level(pipeline, IFX_PIPELINE_QUALITY_FULL, 1);
+    pipeline->quality.load = 0;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_pipeline_set_input_lag(ifx_Pipeline_t* pipeline, ifx_Float_t lag_s)
+{
+    IFX_ERR_BRK_NULL(pipeline);
+
+    pipeline->lag_s = lag_s;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_pipeline_get_quality(const ifx_Pipeline_t* pipeline, ifx_Pipeline_Quality_t* quality)
+{
+    IFX_ERR_BRK_NULL(pipeline);
+    IFX_ERR_BRK_NULL(quality);
+
+    *quality = pipeline->quality;
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Float_t ifx_pipeline_get_stage_time(const ifx_Pipeline_t* pipeline, uint32_t index)
+{
+    IFX_ERR_BRV_NULL(pipeline, 0);
+    IFX_ERR_BRV_ARGUMENT(index >= pipeline->num_stages, 0);
+
+    return (ifx_Float_t)pipeline->stages[index].time_s;
+}
@@ -0,0 +1,389 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Pipeline.h
+ *
+ * \brief \copybrief gr_pipeline
+ *
+ * For details refer to \ref gr_pipeline
+ */
+
+#ifndef IFX_RADAR_PIPELINE_H
+#define IFX_RADAR_PIPELINE_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/DBSCAN.h"
+#include "ifxAlgo/OSCFAR.h"
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+
+#include "ifxRadar/DBF.h"
+#include "ifxRadar/RangeDopplerMap.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of a processing pipeline, see Pipeline.h.
+ */
+typedef struct ifx_Pipeline_s ifx_Pipeline_t;
+
+/**
+ * @brief Processing stages of a pipeline.
+ *
+ * Each stage consumes the output of the stage before it; the first stage
+ * consumes the frame passed to \ref ifx_pipeline_run.
+ */
+typedef enum
+{
+    IFX_PIPELINE_STAGE_RDM = 0,       /**< Range Doppler spectra of all antennas, see \ref ifx_rdm_run_cube_rc.
+                                           Real frame (antennas x chirps x samples) to complex cube
+                                           (range x Doppler x antennas).*/
+    IFX_PIPELINE_STAGE_MTI = 1,       /**< 2D MTI filter on a complex cube, see \ref ifx_2dmti_run_cube_c.
+                                           The shape is kept.*/
+    IFX_PIPELINE_STAGE_DBF = 2,       /**< Digital beam forming, see \ref ifx_dbf_run_c. Complex cube
+                                           (range x Doppler x antennas) to complex cube (range x Doppler x beams).*/
+    IFX_PIPELINE_STAGE_INTEGRATE = 3, /**< Mean absolute value over the slices of a complex cube, i.e. non-coherent
+                                           integration over antennas or beams. Complex cube to real matrix.*/
+    IFX_PIPELINE_STAGE_OSCFAR = 4,    /**< OS-CFAR detector on a real matrix, see \ref ifx_oscfar_run.
+                                           The shape is kept, cells without detection are 0.*/
+    IFX_PIPELINE_STAGE_DBSCAN = 5     /**< Clustering of the non-zero cells of a real matrix, see \ref ifx_dbscan_run.
+                                           Must be the last stage, see \ref ifx_pipeline_get_clusters.*/
+} ifx_Pipeline_Stage_Type_t;
+
+/**
+ * @brief Defines a stage of a pipeline.
+ *
+ * Only the configuration matching type is used.
+ */
+typedef struct
+{
+    ifx_Pipeline_Stage_Type_t type; /**< Type of the stage.*/
+    union
+    {
+        ifx_RDM_Config_t rdm;       /**< Configuration of IFX_PIPELINE_STAGE_RDM.*/
+        ifx_Float_t mti_alpha;      /**< Filter coefficient of IFX_PIPELINE_STAGE_MTI.*/
+        ifx_DBF_Config_t dbf;       /**< Configuration of IFX_PIPELINE_STAGE_DBF.*/
+        ifx_OSCFAR_Config_t oscfar; /**< Configuration of IFX_PIPELINE_STAGE_OSCFAR.*/
+        ifx_DBSCAN_Config_t dbscan; /**< Configuration of IFX_PIPELINE_STAGE_DBSCAN. At most max_num_detections
+                                         cells are clustered, further detections are dropped.*/
+    } config;
+    bool optional; /**< If true the governor may skip the stage under load, see \ref ifx_pipeline_set_governor.
+                        Only stages whose output has the kind and shape of their input (e.g. MTI) can be
+                        optional, since a skipped stage passes its input on.*/
+} ifx_Pipeline_Stage_t;
+
+/**
+ * @brief Defines the settings of a pipeline.
+ */
+typedef struct
+{
+    uint32_t num_antennas;              /**< Number of RX antennas of a frame.*/
+    uint32_t num_chirps;                /**< Number of chirps per frame.*/
+    uint32_t num_samples;               /**< Number of samples per chirp.*/
+    const ifx_Pipeline_Stage_t* stages; /**< Stages in processing order.*/
+    uint32_t num_stages;                /**< Number of stages.*/
+    ifx_Executor_t* executor;           /**< Thread pool used by the stages and for overlapping frames, may be NULL.
+                                             It is not owned by the pipeline and must outlive it.*/
+    uint32_t overlap_stage;             /**< If not 0, the stages from this index on process the previous frame
+                                             while the stages before it process the current frame, see
+                                             \ref ifx_pipeline_run. Requires an executor.*/
+    ifx_Cube_Layout_t frame_layout;     /**< Memory layout of the frames passed to \ref ifx_pipeline_run. Frames in
+                                             other layouts than IFX_CUBE_LAYOUT_ANTENNA_MAJOR are processed through a
+                                             strided view without reordering.*/
+} ifx_Pipeline_Config_t;
+
+/**
+ * @brief Processing quality chosen by the governor of a pipeline.
+ */
+typedef enum
+{
+    IFX_PIPELINE_QUALITY_FULL = 0,     /**< All stages process every frame.*/
+    IFX_PIPELINE_QUALITY_REDUCED = 1,  /**< Optional stages are skipped.*/
+    IFX_PIPELINE_QUALITY_DECIMATED = 2 /**< Optional stages are skipped and only every decimation-th frame is processed.*/
+} ifx_Pipeline_Quality_Level_t;
+
+/**
+ * @brief Defines the settings of the governor of a pipeline.
+ */
+typedef struct
+{
+    ifx_Float_t budget_s;      /**< Processing time available per frame in seconds, e.g. the frame period divided by
+                                    the number of sensors sharing the CPU. 0 disables the governor.*/
+    ifx_Float_t restore_ratio; /**< A higher quality is restored once its estimated time stays below this fraction of
+                                    the budget, between 0 and 1. 0 selects 0.7.*/
+    uint32_t max_decimation;   /**< Largest frame decimation, 0 or 1 if frames must not be dropped.*/
+} ifx_Pipeline_Governor_Config_t;
+
+/**
+ * @brief Describes how the current output of a pipeline was produced.
+ */
+typedef struct
+{
+    ifx_Pipeline_Quality_Level_t level; /**< Quality level of the call of \ref ifx_pipeline_run producing the output.*/
+    uint32_t skipped_stages;            /**< Bit i is set if stage i was skipped for the output.*/
+    uint32_t decimation;                /**< Only every decimation-th frame is processed, 1 if all frames are.*/
+    ifx_Float_t processing_time_s;      /**< Duration of the call of \ref ifx_pipeline_run producing the output.*/
+    ifx_Float_t load;                   /**< Smoothed fraction of the budget used per frame, 0 without governor.*/
+} ifx_Pipeline_Quality_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_pipeline Pipeline
+ * @brief API for preallocated processing chains
+ *
+ * A pipeline runs a chain of stages, e.g. range Doppler map, MTI, beam
+ * forming, integration, OS-CFAR and DBSCAN, on every frame. All handles and
+ * intermediate results are created by \ref ifx_pipeline_create, which also
+ * checks that the output of each stage fits the next one. Processing a frame
+ * with \ref ifx_pipeline_run does not allocate memory.
+ *
+ * The intermediate results live in a single buffer (arena). The output of a
+ * stage is only needed by the next stage, so the outputs are placed
+ * alternately at the beginning and the end of the arena. The arena is as
+ * large as the largest pair of consecutive outputs instead of the sum of all
+ * outputs, see \ref ifx_pipeline_get_arena_size.
+ *
+ * With overlap_stage set, a frame is processed in two halves on two threads
+ * of the executor: the front stages process frame n while the back stages
+ * process frame n-1. The output of the last front stage is double buffered
+ * for this. The pipeline output then lags one frame behind.
+ *
+ * The time of each stage is measured on every frame, see
+ * \ref ifx_pipeline_get_stage_time. With a governor set by
+ * \ref ifx_pipeline_set_governor, a pipeline that exceeds its time budget
+ * first skips its optional stages and then drops frames, and returns to full
+ * quality once there is headroom again. Each output is described by
+ * \ref ifx_pipeline_get_quality.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a pipeline.
+ *
+ * Creates the handles of all stages and the arena. A range Doppler map
+ * stage is run once on zeros, so that its per antenna handles (see
+ * \ref ifx_rdm_run_cube_rc) exist before the first call of
+ * \ref ifx_pipeline_run.
+ *
+ * Range Doppler map and OS-CFAR handles are taken from the handle caches
+ * (see \ref ifx_rdm_acquire), so recreating a pipeline for a sensor profile
+ * used before is cheap.
+ *
+ * @param [in]     config    Pipeline settings. The stages are copied.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Pipeline_t* ifx_pipeline_create(const ifx_Pipeline_Config_t* config);
+
+/**
+ * @brief Destroys a pipeline and the handles of its stages.
+ *
+ * Range Doppler map and OS-CFAR handles are returned to the handle caches.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ */
+IFX_DLL_PUBLIC
+void ifx_pipeline_destroy(ifx_Pipeline_t* pipeline);
+
+/**
+ * @brief Processes a frame.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ * @param [in]     frame     Real time domain data cube with rows as RX antennas,
+ *                           columns as chirps and slices as samples per chirp,
+ *                           or the same data in the frame_layout of the config.
+ *
+ * @return true if the output holds the result of a frame. With overlap_stage
+ *         set the output is that of the previous frame, so false is returned
+ *         for the first frame. Frames dropped by the governor return false
+ *         and leave the output unchanged.
+ */
+IFX_DLL_PUBLIC
+bool ifx_pipeline_run(ifx_Pipeline_t* pipeline, const ifx_Cube_R_t* frame);
+
+/**
+ * @brief Returns the output of a pipeline whose last stage outputs a complex cube.
+ *
+ * The view stays valid until the pipeline is destroyed, the content is
+ * overwritten by the next call of \ref ifx_pipeline_run. If the last stage
+ * is optional, the output of the stage before it is returned while the last
+ * stage is skipped, so the view must be fetched again after each frame.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ *
+ * @return Output cube or NULL if the last stage does not output a complex cube.
+ */
+IFX_DLL_PUBLIC
+const ifx_Cube_C_t* ifx_pipeline_get_cube_c(const ifx_Pipeline_t* pipeline);
+
+/**
+ * @brief Returns the output of a pipeline whose last stage outputs a real matrix.
+ *
+ * See \ref ifx_pipeline_get_cube_c.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ *
+ * @return Output matrix or NULL if the last stage does not output a real matrix.
+ */
+IFX_DLL_PUBLIC
+const ifx_Matrix_R_t* ifx_pipeline_get_matrix_r(const ifx_Pipeline_t* pipeline);
+
+/**
+ * @brief Returns the output of a pipeline whose last stage is IFX_PIPELINE_STAGE_DBSCAN.
+ *
+ * See \ref ifx_pipeline_get_cube_c.
+ *
+ * @param [in]     pipeline    A handle to the pipeline.
+ * @param [out]    detections  Detections as interleaved (row, column) pairs.
+ * @param [out]    clusters    Cluster ID of each detection, see \ref ifx_dbscan_run.
+ *
+ * @return Number of detections.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_pipeline_get_clusters(const ifx_Pipeline_t* pipeline,
+                                   const uint16_t** detections,
+                                   const uint16_t** clusters);
+
+/**
+ * @brief Returns the size of the arena holding the intermediate results in bytes.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ *
+ * @return Size of the arena.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_pipeline_get_arena_size(const ifx_Pipeline_t* pipeline);
+
+/**
+ * @brief Sets the governor adapting the processing quality to a time budget.
+ *
+ * After each processed frame the governor compares a moving average of the
+ * processing time with the budget. If the budget is exceeded, or the
+ * application reports with \ref ifx_pipeline_set_input_lag that frames wait
+ * longer than the budget, the quality is lowered by one step: first the
+ * optional stages are skipped, then the decimation is increased up to
+ * max_decimation. A step is undone once the estimated time of the higher
+ * quality has stayed below restore_ratio times the budget for 16 frames.
+ *
+ * Skipped stages keep their state, e.g. the MTI filter continues with the
+ * history of its last processed frame.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ * @param [in]     config    Governor settings, NULL disables the governor. In
+ *                           both cases the pipeline restarts at full quality.
+ */
+IFX_DLL_PUBLIC
+void ifx_pipeline_set_governor(ifx_Pipeline_t* pipeline, const ifx_Pipeline_Governor_Config_t* config);
+
+/**
+ * @brief Reports how long the next frame has waited before processing.
+ *
+ * A lag above the budget means frames arrive faster than they are processed,
+ * e.g. because other sensors share the CPU, and lowers the quality even if
+ * the measured processing time fits the budget. The lag can be derived from
+ * the time stamps of ifx_Fmcw_Frame_t or the queue statistics of the device.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ * @param [in]     lag_s     Time in seconds the next frame has waited since it was received.
+ */
+IFX_DLL_PUBLIC
+void ifx_pipeline_set_input_lag(ifx_Pipeline_t* pipeline, ifx_Float_t lag_s);
+
+/**
+ * @brief Returns how the current output was produced.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ * @param [out]    quality   Quality of the output of the last call of \ref ifx_pipeline_run returning true.
+ */
+IFX_DLL_PUBLIC
+void ifx_pipeline_get_quality(const ifx_Pipeline_t* pipeline, ifx_Pipeline_Quality_t* quality);
+
+/**
+ * @brief Returns the moving average of the processing time of a stage.
+ *
+ * The time is measured on every frame the stage processes, with or without
+ * governor. Skipped stages keep the time of their last processed frame.
+ *
+ * @param [in]     pipeline  A handle to the pipeline.
+ * @param [in]     index     Index of the stage.
+ *
+ * @return Time in seconds, 0 if the stage has not processed a frame yet.
+ */
+IFX_DLL_PUBLIC
+ifx_Float_t ifx_pipeline_get_stage_time(const ifx_Pipeline_t* pipeline, uint32_t index);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_PIPELINE_H */
@@ -0,0 +1,263 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/AngleMonopulse.h"
+#include "ifxRadar/PointCloud.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// keeps the SNR finite if the reference cells are all zero
+#define NOISE_EPSILON ((ifx_Float_t)1e-12)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines the structure for the point detector.
+ *        Use type ifx_Point_Detector_t for this struct.
+ */
+struct ifx_Point_Detector_s
+{
+    ifx_Point_Detector_Config_t config; /**< Settings of the detector.*/
+    ifx_OSCFAR_t* oscfar;               /**< Detector on the integrated map.*/
+    ifx_DBSCAN_t* dbscan;               /**< Clustering, NULL if disabled.*/
+    ifx_AngleMonopulse_t* monopulse;    /**< Angle estimation, NULL if disabled.*/
+    ifx_Matrix_R_t* map;                /**< Magnitudes averaged over the antennas, created on the first frame.*/
+    ifx_OSCFAR_Hit_t* hits;             /**< Detected cells, max_points elements.*/
+    uint16_t* detections;               /**< Range and Doppler bins of the hits as expected by DBSCAN.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void integrate(const ifx_Cube_C_t* input, ifx_Matrix_R_t* output);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/** @brief Averages the magnitudes of all slices of the cube */
+static void integrate(const ifx_Cube_C_t* input, ifx_Matrix_R_t* output)
+{
+    const ifx_Float_t scale = 1.0f / (ifx_Float_t)cSlices(input);
+    const size_t stride = IFX_MDA_STRIDE(input)[2];
+
+    for (uint32_t r = 0; r < cRows(input); r++)
+    {
+        for (uint32_t c = 0; c < cCols(input); c++)
+        {
+            const ifx_Complex_t* cell = &IFX_CUBE_AT(input, r, c, 0);
+
+            ifx_Float_t sum = 0;
+            for (uint32_t s = 0; s < cSlices(input); s++)
+                sum += ifx_complex_abs(cell[s * stride]);
+
+            IFX_MAT_AT(output, r, c) = sum * scale;
+        }
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Point_Cloud_t* ifx_point_cloud_create(uint32_t capacity)
+{
+    IFX_ERR_BRN_ARGUMENT(capacity == 0);
+
+    // one allocation: the structure, four float arrays, the cluster ids
+    const size_t size = sizeof(ifx_Point_Cloud_t) + (size_t)capacity * (4 * sizeof(ifx_Float_t) + sizeof(uint16_t));
+    ifx_Point_Cloud_t* cloud = ifx_mem_calloc(1, size);
+    IFX_ERR_BRN_MEMALLOC(cloud);
+
+    ifx_Float_t* arrays = (ifx_Float_t*)(cloud + 1);
+    cloud->capacity = capacity;
+    cloud->range_m = arrays;
+    cloud->velocity_m_s = arrays + capacity;
+    cloud->angle_deg = arrays + 2 * (size_t)capacity;
+    cloud->snr_db = arrays + 3 * (size_t)capacity;
+    cloud->cluster_id = (uint16_t*)(arrays + 4 * (size_t)capacity);
+
+    return cloud;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_point_cloud_destroy(ifx_Point_Cloud_t* cloud)
+{
+    ifx_mem_free(cloud);
+}
+
+//----------------------------------------------------------------------------
+
+ifx_Point_Detector_t* ifx_point_detector_create(const ifx_Point_Detector_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    // ifx_dbscan_run counts detections with uint16_t
+    IFX_ERR_BRN_ARGUMENT(config->max_points == 0 || config->max_points > UINT16_MAX);
+    IFX_ERR_BRN_ARGUMENT(config->range_per_bin_m <= 0 || config->speed_per_bin_m_s <= 0);
+    IFX_ERR_BRN_ARGUMENT(config->wavelength_m < 0);
+
+    ifx_Point_Detector_t* h = ifx_mem_calloc(1, sizeof(struct ifx_Point_Detector_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->config = *config;
+    h->oscfar = ifx_oscfar_acquire(&config->oscfar);
+    h->hits = ifx_mem_alloc(config->max_points * sizeof(ifx_OSCFAR_Hit_t));
+    h->detections = ifx_mem_alloc(2 * config->max_points * sizeof(uint16_t));
+
+    if (config->dbscan.min_points > 0)
+    {
+        ifx_DBSCAN_Config_t dbscan_config = config->dbscan;
+        dbscan_config.max_num_detections = config->max_points;
+        h->dbscan = ifx_dbscan_create(&dbscan_config);
+    }
+
+    if (config->wavelength_m > 0)
+        h->monopulse = ifx_anglemonopulse_create(config->wavelength_m, config->antenna_spacing_m);
+
+    if (!h->oscfar || !h->hits || !h->detections || (config->dbscan.min_points > 0 && !h->dbscan)
+        || (config->wavelength_m > 0 && !h->monopulse))
+    {
+        // keep the error of a rejected configuration
+        if (ifx_error_get() == IFX_OK)
+            ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        ifx_point_detector_destroy(h);
+        return NULL;
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_point_detector_destroy(ifx_Point_Detector_t* handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    ifx_oscfar_release(handle->oscfar);
+    ifx_dbscan_destroy(handle->dbscan);
+    ifx_anglemonopulse_destroy(handle->monopulse);
+    ifx_mat_destroy_r(handle->map);
+    ifx_mem_free(handle->hits);
+    ifx_mem_free(handle->detections);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_point_detector_run(ifx_Point_Detector_t* handle,
+                            const ifx_Cube_C_t* rdm,
+                            ifx_Point_Cloud_t* cloud)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(rdm);
+    IFX_ERR_BRK_NULL(cloud);
+
+    const ifx_Point_Detector_Config_t* config = &handle->config;
+    IFX_ERR_BRK_COND(handle->monopulse && (config->rx1 >= cSlices(rdm) || config->rx2 >= cSlices(rdm)),
+                     IFX_ERROR_DIMENSION_MISMATCH);
+
+    cloud->num_points = 0;
+
+    if (!handle->map || mRows(handle->map) != cRows(rdm) || mCols(handle->map) != cCols(rdm))
+    {
+        ifx_mat_destroy_r(handle->map);
+        handle->map = ifx_mat_create_r(cRows(rdm), cCols(rdm));
+        IFX_ERR_BRK_MEMALLOC(handle->map);
+    }
+
+    integrate(rdm, handle->map);
+
+    const uint32_t max_hits = MIN(cloud->capacity, config->max_points);
+    const uint32_t num_hits = ifx_oscfar_run_hits(handle->oscfar, handle->map, handle->hits, max_hits);
+    const ifx_Float_t center = (ifx_Float_t)(cCols(rdm) / 2);
+
+    // everything below only touches the detected cells
+    for (uint32_t i = 0; i < num_hits; i++)
+    {
+        const ifx_OSCFAR_Hit_t* hit = &handle->hits[i];
+
+        cloud->range_m[i] = (ifx_Float_t)hit->row * config->range_per_bin_m;
+        cloud->velocity_m_s[i] = ((ifx_Float_t)hit->col - center) * config->speed_per_bin_m_s;
+        cloud->snr_db[i] = 20 * log10f(hit->value / MAX(hit->noise, NOISE_EPSILON));
+        cloud->angle_deg[i] = handle->monopulse
+                                  ? ifx_anglemonopulse_scalar_run(handle->monopulse,
+                                                                  IFX_CUBE_AT(rdm, hit->row, hit->col, config->rx1),
+                                                                  IFX_CUBE_AT(rdm, hit->row, hit->col, config->rx2))
+                                  : 0;
+        cloud->cluster_id[i] = 0;
+
+        handle->detections[2 * i] = (uint16_t)hit->row;
+        handle->detections[2 * i + 1] = (uint16_t)hit->col;
+    }
+
+    if (handle->dbscan && num_hits > 0)
+        ifx_dbscan_run(handle->dbscan, handle->detections, (uint16_t)num_hits, cloud->cluster_id);
+
+    cloud->num_points = num_hits;
+}
@@ -0,0 +1,199 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file PointCloud.h
+ *
+ * \brief \copybrief gr_point_cloud
+ *
+ * For details refer to \ref gr_point_cloud
+ */
+
+#ifndef IFX_RADAR_POINT_CLOUD_H
+#define IFX_RADAR_POINT_CLOUD_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Types.h"
+
+#include "ifxAlgo/DBSCAN.h"
+#include "ifxAlgo/OSCFAR.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Detected points in structure of arrays layout.
+ *
+ * Every array holds capacity elements, the first num_points are valid. All
+ * arrays live in the allocation of the structure, see \ref ifx_point_cloud_create.
+ */
+typedef struct
+{
+    uint32_t capacity;         /**< Maximum number of points.*/
+    uint32_t num_points;       /**< Number of valid points.*/
+    ifx_Float_t* range_m;      /**< Range of the points in m.*/
+    ifx_Float_t* velocity_m_s; /**< Radial velocity of the points in m/s.*/
+    ifx_Float_t* angle_deg;    /**< Angle of arrival of the points in degrees, 0 without angle estimation.*/
+    ifx_Float_t* snr_db;       /**< Cell value over the CFAR noise estimate in dB.*/
+    uint16_t* cluster_id;      /**< DBSCAN cluster of the points, 0 for noise or without clustering.*/
+} ifx_Point_Cloud_t;
+
+/**
+ * @brief A handle for an instance of the point detector, see PointCloud.h.
+ */
+typedef struct ifx_Point_Detector_s ifx_Point_Detector_t;
+
+/**
+ * @brief Defines the settings of the point detector.
+ */
+typedef struct
+{
+    ifx_OSCFAR_Config_t oscfar;    /**< Settings of the detector on the integrated range Doppler map.*/
+    ifx_DBSCAN_Config_t dbscan;    /**< Settings of the clustering in range and Doppler bins. min_points 0
+                                        disables clustering, max_num_detections is ignored.*/
+    uint32_t max_points;           /**< Maximum number of points per frame, at most 65535.*/
+    ifx_Float_t range_per_bin_m;   /**< Range resolution, see \ref ifx_spectrum_axis_calc_dist_per_bin.*/
+    ifx_Float_t speed_per_bin_m_s; /**< Velocity resolution, see \ref ifx_spectrum_axis_calc_speed_per_bin.*/
+    ifx_Float_t wavelength_m;      /**< Wavelength for the angle estimation, 0 disables it.*/
+    ifx_Float_t antenna_spacing_m; /**< Spacing of the antennas rx1 and rx2.*/
+    uint32_t rx1;                  /**< First antenna (slice of the range Doppler cube) of the angle estimation.*/
+    uint32_t rx2;                  /**< Second antenna (slice of the range Doppler cube) of the angle estimation.*/
+} ifx_Point_Detector_Config_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_point_cloud Point Cloud
+ * @brief Detected points of a range Doppler cube in structure of arrays layout
+ *
+ * The point detector turns the complex range Doppler cube of a frame (see
+ * \ref ifx_rdm_run_cube_rc) into a point cloud in one pass:
+ * - the magnitudes of all antennas are averaged into a range Doppler map,
+ * - OS-CFAR returns the detected cells as a list (\ref ifx_oscfar_run_hits),
+ * - range, velocity, angle and SNR are computed for the detected cells only,
+ * - DBSCAN assigns the points to clusters.
+ *
+ * Consumers like trackers usually process one attribute of all points at a
+ * time; the structure of arrays layout keeps each attribute contiguous. The
+ * number of points is bounded by the capacity of the cloud and by max_points,
+ * the cells are visited in order of increasing range.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a point cloud.
+ *
+ * @param [in]     capacity  Maximum number of points.
+ *
+ * @return Point cloud without points or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Point_Cloud_t* ifx_point_cloud_create(uint32_t capacity);
+
+/**
+ * @brief Destroys a point cloud.
+ *
+ * @param [in]     cloud     Point cloud, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_point_cloud_destroy(ifx_Point_Cloud_t* cloud);
+
+/**
+ * @brief Creates a point detector.
+ *
+ * @param [in]     config    Settings defined by \ref ifx_Point_Detector_Config_t.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Point_Detector_t* ifx_point_detector_create(const ifx_Point_Detector_Config_t* config);
+
+/**
+ * @brief Destroys a point detector.
+ *
+ * @param [in]     handle    Handle to the point detector, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_point_detector_destroy(ifx_Point_Detector_t* handle);
+
+/**
+ * @brief Detects the points of a frame.
+ *
+ * @param [in]     handle    Handle to the point detector.
+ * @param [in]     rdm       Complex range Doppler spectra with rows as range bins, columns as
+ *                           Doppler bins (zero velocity in the center) and slices as RX antennas.
+ * @param [out]    cloud     Point cloud receiving at most min(capacity, max_points) points.
+ */
+IFX_DLL_PUBLIC
+void ifx_point_detector_run(ifx_Point_Detector_t* handle,
+                            const ifx_Cube_C_t* rdm,
+                            ifx_Point_Cloud_t* cloud);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_POINT_CLOUD_H */
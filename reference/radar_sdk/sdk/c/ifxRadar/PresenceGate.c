@@ -0,0 +1,302 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxAlgo/FFT.h"
+#include "ifxAlgo/Window.h"
+
+#include "ifxRadar/PresenceGate.h"
+#include "ifxRadar/SpectrumAxis.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// keeps the activity finite for frames without any signal
+#define GATE_EPSILON ((ifx_Float_t)1e-12)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines the structure for the presence gate.
+ *        Use type ifx_Presence_Gate_t for this struct.
+ */
+struct ifx_Presence_Gate_s
+{
+    ifx_Presence_Gate_Config_t config; /**< Settings of the gate.*/
+    ifx_FFT_t* fft;                    /**< Range FFT of the mean chirp.*/
+    const ifx_Vector_R_t* window;      /**< Cached window applied to the mean chirp.*/
+    uint32_t first_bin;                /**< First range bin within the range limits.*/
+    uint32_t num_bins;                 /**< Number of range bins within the range limits.*/
+    ifx_Float_t* chirp;                /**< Windowed mean chirp, fft_size elements.*/
+    ifx_Complex_t* spectrum;           /**< Range spectrum of the mean chirp, fft_size/2+1 elements.*/
+    ifx_Complex_t* previous;           /**< Range bins of the previous frame, num_antennas x num_bins.*/
+    bool has_previous;                 /**< False until the first frame was seen.*/
+    uint32_t hold;                     /**< Remaining frames the gate stays open.*/
+    uint32_t since_open;               /**< Frames since the gate was open.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static uint32_t next_pow2(uint32_t n);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static uint32_t next_pow2(uint32_t n)
+{
+    uint32_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Presence_Gate_t* ifx_presence_gate_create(const ifx_Presence_Gate_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->num_antennas == 0 || config->num_samples < 2);
+    IFX_ERR_BRN_COND(config->bandwidth_Hz <= 0 || config->min_range_m < 0 || config->max_range_m < 0
+                         || config->threshold < 0,
+                     IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+
+    ifx_Presence_Gate_t* h = ifx_mem_calloc(1, sizeof(struct ifx_Presence_Gate_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->config = *config;
+
+    const uint32_t fft_size = next_pow2(config->num_samples);
+    const uint32_t half = fft_size / 2;
+
+    // map the range limits to range bins, bin 0 (DC) is never evaluated
+    const ifx_Float_t dist_per_bin = ifx_spectrum_axis_calc_dist_per_bin(fft_size, config->num_samples,
+                                                                         config->bandwidth_Hz);
+    uint32_t first = (uint32_t)ceilf(config->min_range_m / dist_per_bin);
+    uint32_t last = half - 1;
+    if (config->max_range_m > 0 && config->max_range_m / dist_per_bin < (ifx_Float_t)last)
+        last = (uint32_t)floorf(config->max_range_m / dist_per_bin);
+    if (first < 1)
+        first = 1;
+    if (first > last)
+    {
+        ifx_mem_free(h);
+        ifx_error_set(IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+        return NULL;
+    }
+    h->first_bin = first;
+    h->num_bins = last - first + 1;
+
+    const ifx_Window_Config_t window_config = {IFX_WINDOW_HANN, config->num_samples, 0, 1};
+    h->window = ifx_window_acquire(&window_config, false);
+    h->fft = ifx_fft_create(IFX_FFT_TYPE_R2C, fft_size);
+    h->chirp = ifx_mem_calloc(fft_size, sizeof(ifx_Float_t));
+    h->spectrum = ifx_mem_alloc((half + 1) * sizeof(ifx_Complex_t));  // backends write the Nyquist bin
+    h->previous = ifx_mem_alloc((size_t)config->num_antennas * h->num_bins * sizeof(ifx_Complex_t));
+
+    if (!h->window || !h->fft || !h->chirp || !h->spectrum || !h->previous)
+    {
+        ifx_presence_gate_destroy(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_presence_gate_destroy(ifx_Presence_Gate_t* handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    ifx_window_release(handle->window);
+    ifx_fft_destroy(handle->fft);
+    ifx_mem_free(handle->chirp);
+    ifx_mem_free(handle->spectrum);
+    ifx_mem_free(handle->previous);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_presence_gate_reset(ifx_Presence_Gate_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->has_previous = false;
+    handle->hold = 0;
+    handle->since_open = 0;
+}
+
+//----------------------------------------------------------------------------
+
+bool ifx_presence_gate_run(ifx_Presence_Gate_t* handle,
+                           const ifx_Cube_R_t* frame,
+                           ifx_Float_t* activity)
+{
+    IFX_ERR_BRV_NULL(handle, true);
+    IFX_ERR_BRV_NULL(frame, true);
+    IFX_ERR_BRV_COND(cRows(frame) != handle->config.num_antennas
+                         || cSlices(frame) != handle->config.num_samples
+                         || cCols(frame) == 0,
+                     IFX_ERROR_DIMENSION_MISMATCH, true);
+
+    const uint32_t num_chirps = cCols(frame);
+    const uint32_t num_samples = handle->config.num_samples;
+    const ifx_Float_t* window = vDat(handle->window);
+
+    ifx_Float_t e_change = 0;
+    ifx_Float_t e_signal = 0;
+
+    for (uint32_t rx = 0; rx < cRows(frame); rx++)
+    {
+        // mean chirp; averaging over the chirps suppresses noise before the FFT
+        for (uint32_t s = 0; s < num_samples; s++)
+            handle->chirp[s] = 0;
+        for (uint32_t c = 0; c < num_chirps; c++)
+            for (uint32_t s = 0; s < num_samples; s++)
+                handle->chirp[s] += cAt(frame, rx, c, s);
+
+        ifx_Float_t dc = 0;
+        for (uint32_t s = 0; s < num_samples; s++)
+            dc += handle->chirp[s];
+        dc /= (ifx_Float_t)num_samples;
+
+        const ifx_Float_t scale = 1 / (ifx_Float_t)num_chirps;
+        for (uint32_t s = 0; s < num_samples; s++)
+            handle->chirp[s] = (handle->chirp[s] - dc) * scale * window[s];
+
+        ifx_fft_raw_rc(handle->fft, handle->chirp, handle->spectrum);
+
+        // frame to frame difference of the range bins within the limits
+        ifx_Complex_t* prev = handle->previous + (size_t)rx * handle->num_bins;
+        const ifx_Complex_t* cur = handle->spectrum + handle->first_bin;
+        for (uint32_t b = 0; b < handle->num_bins; b++)
+        {
+            const ifx_Float_t re = IFX_COMPLEX_REAL(cur[b]);
+            const ifx_Float_t im = IFX_COMPLEX_IMAG(cur[b]);
+            const ifx_Float_t dre = re - IFX_COMPLEX_REAL(prev[b]);
+            const ifx_Float_t dim = im - IFX_COMPLEX_IMAG(prev[b]);
+
+            e_signal += re * re + im * im;
+            e_change += dre * dre + dim * dim;
+            prev[b] = cur[b];
+        }
+    }
+
+    ifx_Float_t value;
+    bool open;
+
+    if (!handle->has_previous)
+    {
+        value = (ifx_Float_t)INFINITY;
+        open = true;
+        handle->has_previous = true;
+    }
+    else
+    {
+        value = e_change / (e_signal + GATE_EPSILON);
+        open = value > handle->config.threshold;
+    }
+
+    if (open)
+    {
+        handle->hold = handle->config.hold_frames;
+    }
+    else if (handle->hold > 0)
+    {
+        handle->hold--;
+        open = true;
+    }
+    else if (handle->config.refresh_frames > 0 && handle->since_open + 1 >= handle->config.refresh_frames)
+    {
+        open = true;
+    }
+
+    handle->since_open = open ? 0 : handle->since_open + 1;
+
+    if (activity)
+        *activity = value;
+
+    return open;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_presence_gate_get_range_bins(const ifx_Presence_Gate_t* handle,
+                                      uint32_t* first,
+                                      uint32_t* count)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    if (first)
+        *first = handle->first_bin;
+    if (count)
+        *count = handle->num_bins;
+}
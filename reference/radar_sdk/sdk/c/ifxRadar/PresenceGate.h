@@ -0,0 +1,186 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file PresenceGate.h
+ *
+ * \brief \copybrief gr_presence_gate
+ *
+ * For details refer to \ref gr_presence_gate
+ */
+
+#ifndef IFX_RADAR_PRESENCE_GATE_H
+#define IFX_RADAR_PRESENCE_GATE_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the presence gate, see PresenceGate.h.
+ */
+typedef struct ifx_Presence_Gate_s ifx_Presence_Gate_t;
+
+/**
+ * @brief Defines the settings of the presence gate.
+ */
+typedef struct
+{
+    uint32_t num_antennas;     /**< Number of RX antennas, i.e. rows of the frame cube.*/
+    uint32_t num_samples;      /**< Samples per chirp, i.e. slices of the frame cube.*/
+    ifx_Float_t bandwidth_Hz;  /**< Chirp bandwidth in Hz, maps the range limits to range bins.*/
+    ifx_Float_t min_range_m;   /**< Changes below this range are ignored.*/
+    ifx_Float_t max_range_m;   /**< Changes above this range are ignored, 0 for no limit.*/
+    ifx_Float_t threshold;     /**< A frame is active if the energy of the change to the previous frame
+                                    exceeds threshold times the energy of the frame, both within the
+                                    range limits. Typical values are 1e-3 to 1e-2.*/
+    uint32_t hold_frames;      /**< Number of frames the gate stays open after the last active frame.*/
+    uint32_t refresh_frames;   /**< The gate opens at least once every refresh_frames frames, 0 to disable.*/
+} ifx_Presence_Gate_Config_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_presence_gate Presence Gate
+ * @brief Cheap activity gate to skip presence processing of unchanged frames
+ *
+ * The presence gate decides per frame whether an expensive presence chain,
+ * e.g. \ref ifx_presence_sensing_run, needs to see the frame. For each
+ * antenna the chirps of the frame are averaged, windowed and transformed by a
+ * single range FFT. Only the range bins between min_range_m and max_range_m
+ * are kept; the change of these bins to the previous frame (a frame to frame
+ * MTI filter) is compared to their energy. A frame is active if the relative
+ * change exceeds the threshold.
+ *
+ * The gate is open for the first frame, for active frames, for hold_frames
+ * frames after an active frame and at least once every refresh_frames
+ * frames. A typical incremental mode runs the presence algorithm only if the
+ * gate is open or presence was detected, so an empty room without movement
+ * costs one range FFT per antenna and frame.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a presence gate.
+ *
+ * @param [in]     config    Settings defined by \ref ifx_Presence_Gate_Config_t.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Presence_Gate_t* ifx_presence_gate_create(const ifx_Presence_Gate_Config_t* config);
+
+/**
+ * @brief Destroys a presence gate.
+ *
+ * @param [in]     handle    Handle to the presence gate, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_presence_gate_destroy(ifx_Presence_Gate_t* handle);
+
+/**
+ * @brief Decides whether a frame needs to be processed.
+ *
+ * @param [in]     handle    Handle to the presence gate.
+ * @param [in]     frame     Frame of num_antennas x chirps x num_samples samples.
+ * @param [out]    activity  Relative change of the frame within the range
+ *                           limits, may be NULL. It is infinite for the first
+ *                           frame.
+ *
+ * @return true if the gate is open and the frame must be processed.
+ */
+IFX_DLL_PUBLIC
+bool ifx_presence_gate_run(ifx_Presence_Gate_t* handle,
+                           const ifx_Cube_R_t* frame,
+                           ifx_Float_t* activity);
+
+/**
+ * @brief Forgets the previous frame, so the gate opens for the next frame.
+ *
+ * @param [in]     handle    Handle to the presence gate.
+ */
+IFX_DLL_PUBLIC
+void ifx_presence_gate_reset(ifx_Presence_Gate_t* handle);
+
+/**
+ * @brief Returns the range bins the gate evaluates.
+ *
+ * @param [in]     handle    Handle to the presence gate.
+ * @param [out]    first     First range bin within the range limits.
+ * @param [out]    count     Number of range bins within the range limits.
+ */
+IFX_DLL_PUBLIC
+void ifx_presence_gate_get_range_bins(const ifx_Presence_Gate_t* handle,
+                                      uint32_t* first,
+                                      uint32_t* count);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_PRESENCE_GATE_H */
@@ -48,12 +48,19 @@
 
 #include <ifxRadar/AngleCapon.h>
 #include <ifxRadar/AngleMonopulse.h>
+#include <ifxRadar/Batch.h>
 #include <ifxRadar/DBF.h>
 #include <ifxRadar/PeakSearch.h>
+#include <ifxRadar/PointCloud.h>
+#include <ifxRadar/Pipeline.h>
+#include <ifxRadar/PresenceGate.h>
 #include <ifxRadar/RangeAngleImage.h>
+#include <ifxRadar/RangeDopplerAngle.h>
 #include <ifxRadar/RangeDopplerMap.h>
 #include <ifxRadar/RangeSpectrum.h>
+#include <ifxRadar/RxCalibration.h>
 #include <ifxRadar/SpectrumAxis.h>
+#include <ifxRadar/Tracker.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -40,6 +40,7 @@
 #include "ifxBase/Cube.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
@@ -59,7 +60,9 @@
 
 #define MAX_NUM_ANTENNA_ARRAYS (16U)
 
-#define USE_TEMP_MATRIX 1
+// Beams of about this many bytes are computed at once, so that the magnitudes
+// and the SNR statistics are taken while they are still in the L2 cache
+#define TILE_BYTES (64U * 1024U)
 
 /*
 ==============================================================================
@@ -74,7 +77,7 @@
 struct ifx_RAI_s
 {
     ifx_RDM_t* rdm_handle;            /**< Range doppler map handle for all rx antennas.*/
-    ifx_2DMTI_C_t** mti_handle_array; /**< 2D MTI filter coefficient.*/
+    ifx_2DMTI_C_t* mti_handle;        /**< 2D MTI filter for the range doppler maps of all rx antennas.*/
     ifx_DBF_t* dbf_handle;            /**< Digital beamforming module handle.*/
     uint32_t num_of_images;           /**< Number of images (responses) for Range Angle Image.*/
     uint32_t num_antenna_array;       /**< Number of virtual antennas.*/
@@ -82,9 +85,16 @@ struct ifx_RAI_s
     ifx_Cube_C_t* rx_spectrum_cube;   /**< ... */
     ifx_Cube_C_t* dbf_cube;           /**< 2D complex DBF over rx antennas as a cube.*/
     ifx_Vector_R_t* snr_vec;          /**< SNR over doppler slices.*/
-#ifdef USE_TEMP_MATRIX
-    ifx_Matrix_R_t* temp_matrix;      /**< Scratch buffer to calculate SNR.*/
-#endif
+    ifx_Float_t energy_gate;          /**< Doppler columns with less energy than energy_gate times the mean are skipped, 0 to disable.*/
+    uint32_t tile_rows;               /**< Number of range bins beamformed at once.*/
+    ifx_Float_t* magnitude;           /**< Scratch buffer for the magnitudes of one range bin.*/
+    ifx_Float_t* col_max;             /**< Maximum magnitude of each Doppler column.*/
+    double* col_sum;                  /**< Sum of the magnitudes of each Doppler column.*/
+    double* col_sumsq;                /**< Sum of the squared magnitudes of each Doppler column.*/
+    double* col_energy;               /**< Energy of each Doppler column of the RX spectrum.*/
+    bool* col_active;                 /**< Doppler columns above the energy gate.*/
+    uint32_t* runs;                   /**< Begin and end of runs of active Doppler columns.*/
+    uint32_t num_runs;                /**< Number of runs.*/
 };
 
 /*
@@ -99,7 +109,22 @@ struct ifx_RAI_s
 ==============================================================================
 */
 
-static void calculate_snr(ifx_RAI_t* handle);
+/**
+ * @brief Selects the Doppler columns above the energy gate
+ *
+ * Fills col_active and the runs of consecutive active columns.
+ */
+static void select_columns(ifx_RAI_t* handle);
+
+/**
+ * @brief Beamforms the active Doppler columns and computes their SNR
+ *
+ * The SNR of a Doppler column is the squared maximum magnitude of its beams
+ * over all range bins divided by the variance of the magnitudes. The
+ * magnitudes and statistics are computed tile by tile right after the
+ * beamforming, instead of traversing the whole beam cube again.
+ */
+static void beamform_snr(ifx_RAI_t* handle);
 
 static int cmpfunc(const void* a, const void* b);
 
@@ -109,131 +134,135 @@ static int cmpfunc(const void* a, const void* b);
 ==============================================================================
 */
 
-int float_compare(void* h, uint32_t ia, uint32_t ib)
-{
-    ifx_Float_t a = ((ifx_Float_t*)h)[ia];
-    ifx_Float_t b = ((ifx_Float_t*)h)[ib];
-    if (a > b)
-        return 1;
-    if (a < b)
-        return -1;
-    return 0;
-}
-
-static void ssort(void* handle,
-                  uint32_t count,
-                  int (*compare)(void* handle, uint32_t ia, uint32_t ib),
-                  ifx_Vector_Sort_Order_t order,
-                  uint32_t* array)
+static void select_columns(ifx_RAI_t* handle)
 {
-    uint32_t gaps[] = {701, 301, 132, 57, 23, 10, 4, 1};  // tbd
-    uint32_t num_gaps = sizeof(gaps) / sizeof(gaps[0]);
-    int ord = order == IFX_SORT_DESCENDING ? -1 : 1;
+    const ifx_Cube_C_t* spectrum = handle->rx_spectrum_cube;
+    const uint32_t dopplers = cCols(spectrum);
+    const uint32_t antennas = cSlices(spectrum);
 
-    for (uint32_t i = 0; i < count; i++)
+    if (handle->energy_gate > 0)
     {
-        array[i] = i;
-    }
+        const ifx_Kernels_t* kernels = ifx_kernels_get();
+        double total = 0;
 
-    for (uint32_t g = 0; g < num_gaps; g++)
-    {
-        uint32_t gap = gaps[g];
+        for (uint32_t c = 0; c < dopplers; c++)
+            handle->col_energy[c] = 0;
 
-        if (gap > count)
+        // the antennas of all Doppler cells of a range bin are contiguous
+        for (uint32_t r = 0; r < cRows(spectrum); r++)
         {
-            continue;
-        }
-
-        for (uint32_t i = gap; i < count; i++)
-        {
-            uint32_t temp = array[i];
-            uint32_t j;
-
-            for (j = i; j >= gap && (compare(handle, array[j - gap], temp) == ord); j -= gap)
+            kernels->abs2_c(&cAt(spectrum, r, 0, 0), handle->magnitude, (size_t)dopplers * antennas);
+            for (uint32_t c = 0; c < dopplers; c++)
             {
-                array[j] = array[j - gap];
+                for (uint32_t ant = 0; ant < antennas; ant++)
+                    handle->col_energy[c] += handle->magnitude[c * antennas + ant];
             }
-
-            array[j] = temp;
         }
-    }
-}
 
-#ifdef USE_TEMP_MATRIX
-static void calculate_snr(ifx_RAI_t* handle)
-{
-    ifx_Float_t signal_power;
-    ifx_Float_t variance;
+        for (uint32_t c = 0; c < dopplers; c++)
+            total += handle->col_energy[c];
 
-    for (uint32_t idx_doppler = 0; idx_doppler < cCols(handle->dbf_cube); ++idx_doppler)
+        const double gate = handle->energy_gate * total / dopplers;
+        for (uint32_t c = 0; c < dopplers; c++)
+            handle->col_active[c] = handle->col_energy[c] >= gate;
+    }
+    else
     {
-        ifx_cube_col_abs_r(handle->dbf_cube, idx_doppler, handle->temp_matrix);
-
-        signal_power = ifx_mat_max_r(handle->temp_matrix);
+        for (uint32_t c = 0; c < dopplers; c++)
+            handle->col_active[c] = true;
+    }
 
-        signal_power *= signal_power;
+    handle->num_runs = 0;
+    for (uint32_t c = 0; c < dopplers;)
+    {
+        if (!handle->col_active[c])
+        {
+            c++;
+            continue;
+        }
 
-        variance = ifx_mat_var_r(handle->temp_matrix);
+        const uint32_t begin = c;
+        while (c < dopplers && handle->col_active[c])
+            c++;
 
-        IFX_VEC_AT(handle->snr_vec, idx_doppler) = signal_power / variance;
+        handle->runs[2 * handle->num_runs] = begin;
+        handle->runs[2 * handle->num_runs + 1] = c;
+        handle->num_runs++;
     }
 }
-#else
-static void calculate_snr(ifx_RAI_t* handle)
+
+//----------------------------------------------------------------------------
+
+static void beamform_snr(ifx_RAI_t* handle)
 {
-    // c corresponds to the doppler index
-    for (uint32_t c = 0; c < cCols(handle->dbf_cube); c++)
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    ifx_Cube_C_t* beam_cube = handle->dbf_cube;
+    const uint32_t ranges = cRows(beam_cube);
+    const uint32_t dopplers = cCols(beam_cube);
+    const uint32_t beams = cSlices(beam_cube);
+
+    for (uint32_t c = 0; c < dopplers; c++)
     {
-        // this is used to compute max_{r,s} |DBF_{r,c,s}|
-        ifx_Float_t max_abs_elem = 0;
+        handle->col_max[c] = 0;
+        handle->col_sum[c] = 0;
+        handle->col_sumsq[c] = 0;
+    }
 
-        // The variance is computed using Welford's online algorithm, see
-        // https://en.wikipedia.org/w/index.php?title=Algorithms_for_calculating_variance&oldid=928348206#Welford's_online_algorithm
-        // for more information.
+    for (uint32_t r0 = 0; r0 < ranges; r0 += handle->tile_rows)
+    {
+        const uint32_t r1 = MIN(r0 + handle->tile_rows, ranges);
 
-        // index for Welford's algorithm
-        uint32_t n = 0;
+        for (uint32_t run = 0; run < handle->num_runs; run++)
+        {
+            const uint32_t c0 = handle->runs[2 * run];
+            const uint32_t c1 = handle->runs[2 * run + 1];
 
-        // sample mean of the first n samples
-        ifx_Float_t mean_n = 0;
+            ifx_Cube_C_t spectrum_tile = {0};
+            ifx_Cube_C_t beam_tile = {0};
+            IFX_MDA_VIEW_C(&spectrum_tile, handle->rx_spectrum_cube, IFX_MDA_SLICE(r0, r1, 1), IFX_MDA_SLICE(c0, c1, 1), IFX_MDA_SLICE_FULL());
+            IFX_MDA_VIEW_C(&beam_tile, beam_cube, IFX_MDA_SLICE(r0, r1, 1), IFX_MDA_SLICE(c0, c1, 1), IFX_MDA_SLICE_FULL());
 
-        // sum of squares of differences from the current mean (see link above
-        // for more information)
-        ifx_Float_t M2_n = 0;
+            ifx_dbf_run_c(handle->dbf_handle, &spectrum_tile, &beam_tile);
 
-        // compute SNR value for current index doppler (fixed column)
-        for (uint32_t r = 0; r < cRows(handle->dbf_cube); r++)
-        {
-            for (uint32_t s = 0; s < cSlices(handle->dbf_cube); s++)
+            // the beams of consecutive Doppler cells of a range bin are contiguous
+            for (uint32_t r = r0; r < r1; r++)
             {
-                // xn = |DBF_{r,c,s}|
-                const ifx_Float_t xn = ifx_complex_abs(cAt(handle->dbf_cube, r, c, s));
-
-                // max_abs_elem = max_{r,s} |DBF_{r,c,s}|
-                if (xn > max_abs_elem)
-                    max_abs_elem = xn;
+                kernels->abs_c(&cAt(beam_cube, r, c0, 0), handle->magnitude, (size_t)(c1 - c0) * beams);
 
-                // compute average and mean using Welford's algorithm
-                n++;
+                // magnitudes are not negative, so a minimum of 0 is never replaced
+                for (uint32_t c = c0; c < c1; c++)
+                {
+                    double sums[2] = {0, 0};
+                    ifx_Float_t range[2] = {0, handle->col_max[c]};
+                    uint32_t idx[2] = {0, 0};
 
-                // save last values (mean_{n-1}, M2_{n-1})
-                ifx_Float_t mean_nm1 = mean_n;
-                ifx_Float_t M2_nm1 = M2_n;
+                    kernels->stats_r(&handle->magnitude[(c - c0) * beams], 0, 0, sums, range, idx, beams);
 
-                // update mean and M2n
-                mean_n = mean_nm1 + (xn - mean_nm1) / n;
-                M2_n = M2_nm1 + (xn - mean_nm1) * (xn - mean_n);
+                    handle->col_max[c] = range[1];
+                    handle->col_sum[c] += sums[0];
+                    handle->col_sumsq[c] += sums[1];
+                }
             }
         }
+    }
 
-        // compute variance
-        ifx_Float_t variance = M2_n / n;
+    // columns below the energy gate have an SNR of 0
+    const double n = (double)ranges * beams;
+    for (uint32_t c = 0; c < dopplers; c++)
+    {
+        if (!handle->col_active[c])
+        {
+            vAt(handle->snr_vec, c) = 0;
+            continue;
+        }
 
-        const ifx_Float_t signal_power = max_abs_elem * max_abs_elem;
-        IFX_VEC_AT(handle->snr_vec, c) = signal_power / variance;
+        const double mean = handle->col_sum[c] / n;
+        const ifx_Float_t variance = (ifx_Float_t)(handle->col_sumsq[c] / n - mean * mean);
+        const ifx_Float_t signal_power = handle->col_max[c] * handle->col_max[c];
+
+        vAt(handle->snr_vec, c) = signal_power / variance;
     }
 }
-#endif
 
 //----------------------------------------------------------------------------
 
@@ -259,36 +288,27 @@ ifx_RAI_t* ifx_rai_create(ifx_RAI_Config_t* config)
     IFX_ERR_BRV_ARGUMENT(config->num_of_images > MAX_NUM_OF_IMAGES, NULL);
     IFX_ERR_BRV_ARGUMENT(config->num_antenna_array > MAX_NUM_ANTENNA_ARRAYS || config->num_antenna_array == 0, NULL);
 
-    ifx_RAI_t* h = ifx_mem_alloc(sizeof(struct ifx_RAI_s));
+    ifx_RAI_t* h = ifx_mem_calloc(1, sizeof(struct ifx_RAI_s));
     IFX_ERR_BRN_MEMALLOC(h);
 
     //----------------------- Range Doppler Map Handle -----------------------
     IFX_ERR_HANDLE_N(h->rdm_handle = ifx_rdm_create(&config->rdm_config),
                      ifx_rai_destroy(h));
 
-    uint32_t range_fft_size = config->rdm_config.range_fft_config.fft_size;
+    // the range bins of the range Doppler map, see ifx_RDM_Config_t
+    uint32_t range_fft_size = ifx_rdm_get_num_range_bins(h->rdm_handle);
     uint32_t doppler_fft_size = config->rdm_config.doppler_fft_config.fft_size;
 
-    if (config->rdm_config.range_fft_config.fft_type == IFX_FFT_TYPE_R2C)
-    {
-        range_fft_size /= 2;
-    }
-
     IFX_ERR_HANDLE_N(h->rdm_cube = ifx_cube_create_c(range_fft_size, doppler_fft_size, config->num_antenna_array),
                      ifx_rai_destroy(h));
     IFX_ERR_HANDLE_N(h->rx_spectrum_cube = ifx_cube_create_c(range_fft_size, doppler_fft_size, config->num_antenna_array),
                      ifx_rai_destroy(h));
 
     //----------------------- 2D MTI Handle ----------------------------------
-    h->mti_handle_array = ifx_mem_alloc(sizeof(ifx_2DMTI_C_t*) * config->num_antenna_array);
-    IFX_ERR_BRN_MEMALLOC(h);
-
-    for (uint32_t i = 0; i < config->num_antenna_array; ++i)
-    {
-        IFX_ERR_HANDLE_N(h->mti_handle_array[i] = ifx_2dmti_create_c(config->alpha_mti_filter,
-                                                                     range_fft_size, doppler_fft_size),
-                         ifx_rai_destroy(h));
-    }
+    IFX_ERR_HANDLE_N(h->mti_handle = ifx_2dmti_create_cube_c(config->alpha_mti_filter,
+                                                             range_fft_size, doppler_fft_size,
+                                                             config->num_antenna_array),
+                     ifx_rai_destroy(h));
 
     //----------------------- DBF Handle -------------------------------------
     IFX_ERR_HANDLE_N(h->dbf_handle = ifx_dbf_create(&config->dbf_config),
@@ -301,10 +321,26 @@ ifx_RAI_t* ifx_rai_create(ifx_RAI_Config_t* config)
     IFX_ERR_HANDLE_N(h->snr_vec = ifx_vec_create_r(config->rdm_config.doppler_fft_config.fft_size),
                      ifx_rai_destroy(h));
 
-#ifdef USE_TEMP_MATRIX
-    IFX_ERR_HANDLE_N(h->temp_matrix = ifx_mat_create_r(range_fft_size, config->dbf_config.num_beams),
+    const uint32_t num_beams = config->dbf_config.num_beams;
+    const uint32_t cell_size = MAX(num_beams, config->num_antenna_array);
+
+    IFX_ERR_HANDLE_N(h->magnitude = ifx_mem_alloc((size_t)doppler_fft_size * cell_size * sizeof(ifx_Float_t)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->col_max = ifx_mem_alloc(doppler_fft_size * sizeof(ifx_Float_t)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->col_sum = ifx_mem_alloc(doppler_fft_size * sizeof(double)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->col_sumsq = ifx_mem_alloc(doppler_fft_size * sizeof(double)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->col_energy = ifx_mem_alloc(doppler_fft_size * sizeof(double)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->col_active = ifx_mem_alloc(doppler_fft_size * sizeof(bool)),
+                     ifx_rai_destroy(h));
+    IFX_ERR_HANDLE_N(h->runs = ifx_mem_alloc(2 * (size_t)doppler_fft_size * sizeof(uint32_t)),
                      ifx_rai_destroy(h));
-#endif
+
+    h->energy_gate = config->energy_gate;
+    h->tile_rows = MAX(1U, TILE_BYTES / (doppler_fft_size * num_beams * (uint32_t)sizeof(ifx_Complex_t)));
 
     h->num_of_images = config->num_of_images;
     h->num_antenna_array = config->num_antenna_array;
@@ -321,10 +357,14 @@ void ifx_rai_destroy(ifx_RAI_t* handle)
         return;
     }
 
-#ifdef USE_TEMP_MATRIX
-    ifx_mat_destroy_r(handle->temp_matrix);
-#endif
     ifx_vec_destroy_r(handle->snr_vec);
+    ifx_mem_free(handle->magnitude);
+    ifx_mem_free(handle->col_max);
+    ifx_mem_free(handle->col_sum);
+    ifx_mem_free(handle->col_sumsq);
+    ifx_mem_free(handle->col_energy);
+    ifx_mem_free(handle->col_active);
+    ifx_mem_free(handle->runs);
 
     ifx_cube_destroy_c(handle->dbf_cube);
     ifx_cube_destroy_c(handle->rdm_cube);
@@ -333,12 +373,7 @@ void ifx_rai_destroy(ifx_RAI_t* handle)
     ifx_dbf_destroy(handle->dbf_handle);
     ifx_rdm_destroy(handle->rdm_handle);
 
-    for (uint32_t i = 0; i < handle->num_antenna_array; ++i)
-    {
-        ifx_2dmti_destroy_c(handle->mti_handle_array[i]);
-    }
-
-    ifx_mem_free(handle->mti_handle_array);
+    ifx_2dmti_destroy_c(handle->mti_handle);
 
     ifx_mem_free(handle);
 }
@@ -353,39 +388,26 @@ void ifx_rai_run_r(ifx_RAI_t* handle,
     IFX_CUBE_BRK_VALID(input);
     IFX_CUBE_BRK_VALID(output);
 
-    // rdm_view: range_fft_size x doppler_fft_size
-    ifx_Matrix_C_t rdm_view = {0};
+    // range doppler maps of all rx antennas, computed in parallel if possible
+    ifx_Cube_R_t rawdata_view = {0};
+    IFX_MDA_VIEW_R(&rawdata_view, (ifx_Cube_R_t*)input, IFX_MDA_SLICE(0, handle->num_antenna_array, 1), IFX_MDA_SLICE_FULL(), IFX_MDA_SLICE_FULL());
 
-    for (uint32_t rx = 0; rx < handle->num_antenna_array; ++rx)
-    {
-        // rawdata_view: num_chirps_per_frame x num_samples_per_frame
-        ifx_Matrix_R_t rawdata_view = {0};
-
-        // rx_spectrum_view: range_fft_size x doppler_fft_size
-        ifx_Matrix_C_t rx_spectrum_view = {0};
-
-        ifx_cube_get_row_r(input, rx, &rawdata_view);           // set view to the rx antenna for raw data matrix
-
-        ifx_cube_get_slice_c(handle->rdm_cube, rx, &rdm_view);  // set view to the rx antenna for range doppler map
-
-        ifx_cube_get_slice_c(handle->rx_spectrum_cube, rx, &rx_spectrum_view);
-
-        ifx_rdm_run_rc(handle->rdm_handle, &rawdata_view, &rdm_view);
-
-        ifx_2dmti_run_c(handle->mti_handle_array[rx], &rdm_view, &rx_spectrum_view);
-    }
+    ifx_rdm_run_cube_rc(handle->rdm_handle, &rawdata_view, handle->rdm_cube);
 
-    ifx_dbf_run_c(handle->dbf_handle, handle->rx_spectrum_cube, handle->dbf_cube);
+    // 2D MTI of the range doppler maps of all rx antennas in one pass
+    ifx_2dmti_run_cube_c(handle->mti_handle, handle->rdm_cube, handle->rx_spectrum_cube);
 
-    calculate_snr(handle);
+    // beamforming, magnitudes and SNR in one pass over the active Doppler columns
+    select_columns(handle);
+    beamform_snr(handle);
 
-    // doppler FFT size
-    uint32_t* snr_sorted_idx = ifx_mem_alloc(mCols(&rdm_view) * sizeof(uint32_t));
+    // doppler indices of the images, strongest SNR first
+    uint32_t* snr_sorted_idx = ifx_mem_alloc(handle->num_of_images * sizeof(uint32_t));
     IFX_ERR_BRK_MEMALLOC(snr_sorted_idx);
 
-    ssort(vDat(handle->snr_vec), vLen(handle->snr_vec), float_compare, IFX_SORT_DESCENDING, snr_sorted_idx);
+    const uint32_t num_images = ifx_vec_topk_r(handle->snr_vec, handle->num_of_images, IFX_SORT_DESCENDING, snr_sorted_idx);
 
-    for (uint32_t image = 0; image < handle->num_of_images; ++image)
+    for (uint32_t image = 0; image < num_images; ++image)
     {
         uint32_t dopp_idx = snr_sorted_idx[image];
 
@@ -394,7 +416,11 @@ void ifx_rai_run_r(ifx_RAI_t* handle,
         ifx_Matrix_R_t rai_view = {0};
         ifx_cube_get_row_r(output, image, &rai_view);
 
-        ifx_cube_col_abs_r(handle->dbf_cube, dopp_idx, &rai_view);
+        // columns below the energy gate were not beamformed
+        if (handle->col_active[dopp_idx])
+            ifx_cube_col_abs_r(handle->dbf_cube, dopp_idx, &rai_view);
+        else
+            ifx_mat_clear_r(&rai_view);
     }
 
     ifx_mem_free(snr_sorted_idx);
@@ -84,6 +84,9 @@ typedef struct
     ifx_DBF_Config_t dbf_config;  /**< Digital beamforming module configurations.*/
     uint32_t num_of_images;       /**< Number of images (responses) for Range Angle Image.*/
     uint32_t num_antenna_array;   /**< Number of virtual antennas.*/
+    ifx_Float_t energy_gate;      /**< Doppler columns whose energy in the RX spectrum (summed over range bins and
+                                       antennas) is below energy_gate times the mean energy of all columns are not
+                                       beamformed and get an SNR of 0. 0 disables the gate.*/
 } ifx_RAI_Config_t;
 
 /*
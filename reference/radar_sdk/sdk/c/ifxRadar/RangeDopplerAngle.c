@@ -0,0 +1,449 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "ifxAlgo/FFT.h"
+#include "ifxAlgo/Window.h"
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/internal/Macros.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/Vector.h"
+
+#include "ifxRadar/RangeDopplerAngle.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// Size of the angle spectra of one block of Doppler bins, chosen to stay in the L1 cache
+#define BLOCK_BYTES (16384U)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Buffers of a thread computing angle FFTs.
+ */
+typedef struct
+{
+    ifx_FFT_t* fft;            /**< Angle FFT, FFT objects keep intermediate results.*/
+    ifx_Matrix_C_t* antennas;  /**< Virtual antennas of a block of Doppler bins, one row per Doppler bin.*/
+    ifx_Matrix_C_t* angles;    /**< Angle spectra of a block of Doppler bins, one row per Doppler bin.*/
+    ifx_Float_t* angle_max2;   /**< Maximum squared magnitude over the Doppler bins of every angle bin.*/
+} scratch_t;
+
+/**
+ * @brief Defines the structure for the range Doppler angle module.
+ *        Use type ifx_RDA_t for this struct.
+ */
+struct ifx_RDA_s
+{
+    ifx_RDA_Config_t config;      /**< Configuration of the handle.*/
+    ifx_RDM_t* rdm;               /**< Range Doppler FFT of the input cubes.*/
+    ifx_Cube_C_t** rd_spectra;    /**< Complex range Doppler spectra of every input cube, rows as range bins,
+                                       columns as Doppler bins and slices as RX antennas.*/
+    const ifx_Vector_R_t* window; /**< Window over the virtual antennas, shared with other handles.*/
+    uint32_t num_range_bins;      /**< Number of range bins.*/
+    uint32_t num_doppler_bins;    /**< Number of Doppler bins.*/
+    uint32_t block_size;          /**< Number of Doppler bins transformed in one batch.*/
+    ifx_Executor_t* executor;     /**< Thread pool, NULL if not set.*/
+    scratch_t* scratch;           /**< Buffers of every thread of the executor.*/
+    uint32_t num_scratch;         /**< Number of elements of scratch.*/
+};
+
+/**
+ * @brief Arguments of run_range_bins, the task computing the angle FFTs of range bins.
+ */
+typedef struct
+{
+    ifx_RDA_t* handle;              /**< Handle.*/
+    ifx_Cube_C_t* spectrum;         /**< Output cube or NULL.*/
+    ifx_Matrix_R_t* range_angle;    /**< Range angle image or NULL.*/
+    ifx_Matrix_R_t* range_doppler;  /**< Range Doppler image or NULL.*/
+} range_task_t;
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static void destroy_scratch(ifx_RDA_t* handle);
+
+static bool create_scratch(ifx_RDA_t* handle, uint32_t num_threads);
+
+static void gather_antennas(const ifx_RDA_t* handle, uint32_t range_bin, uint32_t first_doppler_bin,
+                            uint32_t num_doppler_bins, ifx_Matrix_C_t* antennas);
+
+static void run_range_bin(const range_task_t* task, scratch_t* scratch, uint32_t range_bin);
+
+static void run_range_bins(void* context, uint32_t begin, uint32_t end, uint32_t thread);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static void destroy_scratch(ifx_RDA_t* handle)
+{
+    for (uint32_t i = 0; i < handle->num_scratch; i++)
+    {
+        scratch_t* scratch = &handle->scratch[i];
+        ifx_fft_destroy(scratch->fft);
+        ifx_mat_destroy_c(scratch->antennas);
+        ifx_mat_destroy_c(scratch->angles);
+        ifx_mem_free(scratch->angle_max2);
+    }
+
+    ifx_mem_free(handle->scratch);
+    handle->scratch = NULL;
+    handle->num_scratch = 0;
+}
+
+//----------------------------------------------------------------------------
+
+static bool create_scratch(ifx_RDA_t* handle, uint32_t num_threads)
+{
+    destroy_scratch(handle);
+
+    handle->scratch = ifx_mem_calloc(num_threads, sizeof(scratch_t));
+    if (handle->scratch == NULL)
+        return false;
+    handle->num_scratch = num_threads;
+
+    const uint32_t fft_size = handle->config.angle_fft_size;
+    for (uint32_t i = 0; i < num_threads; i++)
+    {
+        scratch_t* scratch = &handle->scratch[i];
+        scratch->fft = ifx_fft_create(IFX_FFT_TYPE_C2C, fft_size);
+        scratch->antennas = ifx_mat_create_c(handle->block_size, handle->config.num_antennas);
+        scratch->angles = ifx_mat_create_c(handle->block_size, fft_size);
+        scratch->angle_max2 = ifx_mem_alloc(fft_size * sizeof(ifx_Float_t));
+
+        if (!scratch->fft || !scratch->antennas || !scratch->angles || !scratch->angle_max2)
+        {
+            destroy_scratch(handle);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Copies the virtual antennas of Doppler bins of a range bin into the rows of antennas
+ *
+ * In the range Doppler spectra the RX antennas of a cell are adjacent, so
+ * the values of a block are read from a few cache lines of every cube.
+ */
+static void gather_antennas(const ifx_RDA_t* handle, uint32_t range_bin, uint32_t first_doppler_bin,
+                            uint32_t num_doppler_bins, ifx_Matrix_C_t* antennas)
+{
+    const uint32_t num_rx = handle->config.num_rx_antennas;
+
+    for (uint32_t k = 0; k < handle->config.num_antennas; k++)
+    {
+        const uint32_t antenna = handle->config.antennas[k];
+        const ifx_Cube_C_t* cube = handle->rd_spectra[antenna / num_rx];
+        const size_t* stride = IFX_MDA_STRIDE(cube);
+
+        const ifx_Complex_t* src = IFX_MDA_DATA(cube) + range_bin * stride[0] + first_doppler_bin * stride[1]
+                                   + (antenna % num_rx) * stride[2];
+        ifx_Complex_t* dst = mDat(antennas) + k * mStride(antennas, 1);
+
+        for (uint32_t d = 0; d < num_doppler_bins; d++)
+            dst[d * mStride(antennas, 0)] = src[d * stride[1]];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Angle FFTs of all Doppler bins of a range bin
+ *
+ * The FFT shift is done while the spectra are copied into the output cube,
+ * the projections are computed from the spectra in the scratch buffers.
+ */
+static void run_range_bin(const range_task_t* task, scratch_t* scratch, uint32_t range_bin)
+{
+    const ifx_RDA_t* handle = task->handle;
+    const uint32_t fft_size = handle->config.angle_fft_size;
+    const uint32_t half = fft_size / 2;
+
+    if (task->range_angle)
+        memset(scratch->angle_max2, 0, fft_size * sizeof(ifx_Float_t));
+
+    for (uint32_t first = 0; first < handle->num_doppler_bins; first += handle->block_size)
+    {
+        const uint32_t count = MIN(handle->block_size, handle->num_doppler_bins - first);
+
+        ifx_Matrix_C_t antennas;
+        ifx_Matrix_C_t angles;
+        ifx_mat_view_c(&antennas, scratch->antennas, 0, 0, count, handle->config.num_antennas);
+        ifx_mat_view_c(&angles, scratch->angles, 0, 0, count, fft_size);
+
+        gather_antennas(handle, range_bin, first, count, &antennas);
+        ifx_fft_run_batch_c(scratch->fft, &antennas, IFX_FFT_BATCH_ROWS, handle->window, false, &angles,
+                            IFX_FFT_BATCH_ROWS);
+
+        for (uint32_t b = 0; b < count; b++)
+        {
+            const ifx_Complex_t* row = mDat(&angles) + b * mStride(&angles, 0);
+            const uint32_t doppler_bin = first + b;
+
+            if (task->spectrum)
+            {
+                ifx_Complex_t* dst = &IFX_MDA_DATA(task->spectrum)[range_bin * IFX_MDA_STRIDE(task->spectrum)[0]
+                                                                   + doppler_bin * IFX_MDA_STRIDE(task->spectrum)[1]];
+                const size_t dst_stride = IFX_MDA_STRIDE(task->spectrum)[2];
+                for (uint32_t j = 0; j < fft_size; j++)
+                    dst[((j + half) % fft_size) * dst_stride] = row[j];
+            }
+
+            if (task->range_angle || task->range_doppler)
+            {
+                ifx_Float_t doppler_max2 = 0;
+                for (uint32_t j = 0; j < fft_size; j++)
+                {
+                    const ifx_Float_t re = IFX_COMPLEX_REAL(row[j]);
+                    const ifx_Float_t im = IFX_COMPLEX_IMAG(row[j]);
+                    const ifx_Float_t abs2 = re * re + im * im;
+
+                    doppler_max2 = MAX(doppler_max2, abs2);
+                    scratch->angle_max2[j] = MAX(scratch->angle_max2[j], abs2);
+                }
+
+                if (task->range_doppler)
+                    mAt(task->range_doppler, range_bin, doppler_bin) = sqrtf(doppler_max2);
+            }
+        }
+    }
+
+    if (task->range_angle)
+    {
+        for (uint32_t j = 0; j < fft_size; j++)
+            mAt(task->range_angle, range_bin, (j + half) % fft_size) = sqrtf(scratch->angle_max2[j]);
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void run_range_bins(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    const range_task_t* task = context;
+    scratch_t* scratch = &task->handle->scratch[thread];
+
+    for (uint32_t range_bin = begin; range_bin < end; range_bin++)
+        run_range_bin(task, scratch, range_bin);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_RDA_t* ifx_rda_create(const ifx_RDA_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->num_rx_antennas == 0 || config->num_cubes == 0);
+    IFX_ERR_BRN_ARGUMENT(config->num_antennas == 0 || config->num_antennas > IFX_RDA_MAX_ANTENNAS);
+    IFX_ERR_BRN_ARGUMENT(config->angle_fft_size < config->num_antennas);
+    IFX_ERR_BRN_ARGUMENT(config->angle_window.size != config->num_antennas);
+    IFX_ERR_BRN_ARGUMENT(config->rdm_config.range_fft_config.fft_type != IFX_FFT_TYPE_R2C);
+
+    for (uint32_t k = 0; k < config->num_antennas; k++)
+        IFX_ERR_BRN_ARGUMENT(config->antennas[k] >= config->num_cubes * config->num_rx_antennas);
+
+    ifx_RDA_t* h = ifx_mem_calloc(1, sizeof(struct ifx_RDA_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->config = *config;
+    h->num_doppler_bins = config->rdm_config.doppler_fft_config.fft_size;
+
+    const uint32_t block_size = BLOCK_BYTES / (config->angle_fft_size * sizeof(ifx_Complex_t));
+    h->block_size = MIN(MAX(block_size, 1U), h->num_doppler_bins);
+
+    IFX_ERR_HANDLE_N(h->rdm = ifx_rdm_create(&config->rdm_config),
+                     ifx_rda_destroy(h));
+    h->num_range_bins = ifx_rdm_get_num_range_bins(h->rdm);
+
+    h->window = ifx_window_acquire(&config->angle_window, false);
+    h->rd_spectra = ifx_mem_calloc(config->num_cubes, sizeof(ifx_Cube_C_t*));
+    if (!h->window || !h->rd_spectra)
+    {
+        ifx_rda_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    for (uint32_t c = 0; c < config->num_cubes; c++)
+    {
+        h->rd_spectra[c] = ifx_cube_create_c(h->num_range_bins, h->num_doppler_bins, config->num_rx_antennas);
+        if (!h->rd_spectra[c])
+        {
+            ifx_rda_destroy(h);
+            return NULL;
+        }
+    }
+
+    if (!create_scratch(h, 1))
+    {
+        ifx_rda_destroy(h);
+        IFX_ERR_BRN_MEMALLOC(NULL);
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rda_destroy(ifx_RDA_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    destroy_scratch(handle);
+
+    if (handle->rd_spectra)
+    {
+        for (uint32_t c = 0; c < handle->config.num_cubes; c++)
+            ifx_cube_destroy_c(handle->rd_spectra[c]);
+        ifx_mem_free(handle->rd_spectra);
+    }
+
+    ifx_window_release(handle->window);
+    ifx_rdm_destroy(handle->rdm);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rda_run_rc(ifx_RDA_t* handle,
+                    const ifx_Cube_R_t* const* cubes,
+                    uint32_t num_cubes,
+                    ifx_Cube_C_t* spectrum,
+                    ifx_Matrix_R_t* range_angle,
+                    ifx_Matrix_R_t* range_doppler)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(cubes);
+    IFX_ERR_BRK_COND(num_cubes != handle->config.num_cubes, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_ARGUMENT(!spectrum && !range_angle && !range_doppler);
+
+    const uint32_t num_range_bins = handle->num_range_bins;
+    const uint32_t num_doppler_bins = handle->num_doppler_bins;
+    const uint32_t num_angle_bins = handle->config.angle_fft_size;
+
+    if (spectrum)
+    {
+        IFX_ERR_BRK_COND(IFX_CUBE_ROWS(spectrum) != num_range_bins || IFX_CUBE_COLS(spectrum) != num_doppler_bins
+                             || IFX_CUBE_SLICES(spectrum) != num_angle_bins,
+                         IFX_ERROR_DIMENSION_MISMATCH);
+    }
+    if (range_angle)
+    {
+        IFX_ERR_BRK_COND(mRows(range_angle) != num_range_bins || mCols(range_angle) != num_angle_bins,
+                         IFX_ERROR_DIMENSION_MISMATCH);
+    }
+    if (range_doppler)
+    {
+        IFX_ERR_BRK_COND(mRows(range_doppler) != num_range_bins || mCols(range_doppler) != num_doppler_bins,
+                         IFX_ERROR_DIMENSION_MISMATCH);
+    }
+
+    for (uint32_t c = 0; c < num_cubes; c++)
+    {
+        IFX_ERR_BRK_NULL(cubes[c]);
+        IFX_ERR_BRK_COND(IFX_CUBE_ROWS(cubes[c]) != handle->config.num_rx_antennas, IFX_ERROR_DIMENSION_MISMATCH);
+
+        ifx_rdm_run_cube_rc(handle->rdm, cubes[c], handle->rd_spectra[c]);
+        if (ifx_error_get() != IFX_OK)
+            return;
+    }
+
+    const range_task_t task = {handle, spectrum, range_angle, range_doppler};
+    ifx_executor_parallel_for(handle->executor, num_range_bins, 1, run_range_bins, (void*)&task);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_rda_get_num_range_bins(const ifx_RDA_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    return handle->num_range_bins;
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_rda_get_num_doppler_bins(const ifx_RDA_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    return handle->num_doppler_bins;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rda_set_executor(ifx_RDA_t* handle, ifx_Executor_t* executor)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    // every thread of the executor needs its own buffers
+    IFX_ERR_BRK_COND(!create_scratch(handle, ifx_executor_get_num_threads(executor)), IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+
+    handle->executor = executor;
+    ifx_rdm_set_executor(handle->rdm, executor);
+}
@@ -0,0 +1,236 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file RangeDopplerAngle.h
+ *
+ * \brief \copybrief gr_rda
+ *
+ * For details refer to \ref gr_rda
+ */
+
+#ifndef IFX_RADAR_RANGE_DOPPLER_ANGLE_H
+#define IFX_RADAR_RANGE_DOPPLER_ANGLE_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxAlgo/Window.h"
+
+#include "ifxBase/Cube.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+
+#include "ifxRadar/RangeDopplerMap.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/**
+ * @brief Maximum number of virtual antennas of the angle FFT.
+ */
+#define IFX_RDA_MAX_ANTENNAS (32U)
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the range Doppler angle module, see RangeDopplerAngle.h.
+ */
+typedef struct ifx_RDA_s ifx_RDA_t;
+
+/**
+ * @brief Defines the structure for range Doppler angle module related settings.
+ */
+typedef struct
+{
+    ifx_RDM_Config_t rdm_config;     /**< Range and Doppler FFT settings. The threshold and the scale type
+                                          are not used, the spectra are complex.*/
+    uint32_t num_rx_antennas;        /**< Number of RX antennas, i.e. rows of each input cube.*/
+    uint32_t num_cubes;              /**< Number of input cubes, i.e. TX antennas of a TDM MIMO sequence,
+                                          1 without MIMO.*/
+    uint32_t num_antennas;           /**< Number of virtual antennas of the angle FFT.*/
+    uint8_t antennas[IFX_RDA_MAX_ANTENNAS]; /**< Virtual antennas of the uniform linear array in order of
+                                                 their position. RX antenna r of cube c is virtual antenna
+                                                 c * num_rx_antennas + r.*/
+    uint32_t angle_fft_size;         /**< Size of the angle FFT, a power of 2 of at least num_antennas.
+                                          The virtual antennas are zero padded to this size.*/
+    ifx_Window_Config_t angle_window; /**< Window over the virtual antennas, its size must be num_antennas.*/
+} ifx_RDA_Config_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_rda Range Doppler Angle
+ * @brief API for the joint range Doppler angle FFT of MIMO virtual arrays
+ *
+ * The module computes a 3D FFT of a frame over samples (range), chirps
+ * (Doppler) and the virtual antennas of a uniform linear array (angle),
+ * instead of beamforming every range Doppler cell with one loop per beam
+ * (see \ref gr_dbf and \ref gr_anglecapon).
+ *
+ * The input is the frame of a device as returned by
+ * \ref ifx_fmcw_get_next_frame: one cube per TX antenna of a TDM MIMO
+ * sequence (e.g. BGT60ATR24C), each with RX antennas as rows, chirps as
+ * columns and samples as slices. The complex range Doppler spectra of all
+ * antennas are computed as by \ref ifx_rdm_run_cube_rc. Afterwards the
+ * virtual antennas selected by the configuration are windowed, zero padded
+ * to angle_fft_size and transformed for every range Doppler cell. The angle
+ * spectrum is FFT shifted, bin a corresponds to
+ * \f$\sin\theta = (a - N/2) / (N \cdot d/\lambda)\f$ with N = angle_fft_size
+ * and antenna spacing d.
+ *
+ * The angle FFTs are computed in blocks of Doppler bins of one range bin,
+ * which keep the gathered antennas and the spectra in the cache, and the
+ * range bins are distributed over the threads of the executor.
+ *
+ * Outputs (each is optional):
+ * - Complex cube with rows as range bins, columns as Doppler bins and slices
+ *   as angle bins.
+ * - Range angle image: the maximum magnitude over the Doppler bins, rows as
+ *   range bins and columns as angle bins.
+ * - Range Doppler image: the maximum magnitude over the angle bins, rows as
+ *   range bins and columns as Doppler bins.
+ *
+ * The magnitudes are linear. The projections are computed while the angle
+ * spectra are in the cache, the cube does not have to be written for them.
+ * @{
+ */
+
+/**
+ * @brief Creates a range Doppler angle handle (object).
+ *
+ * @param [in]     config    Configuration of the FFTs and the virtual array.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_RDA_t* ifx_rda_create(const ifx_RDA_Config_t* config);
+
+/**
+ * @brief Performs destruction of the range Doppler angle handle.
+ *
+ * @param [in]     handle    A handle to the range Doppler angle object.
+ */
+IFX_DLL_PUBLIC
+void ifx_rda_destroy(ifx_RDA_t* handle);
+
+/**
+ * @brief Computes the range Doppler angle spectrum of a real frame.
+ *
+ * The outputs that are NULL are not computed, at least one must be given.
+ *
+ * @param [in]     handle          A handle to the range Doppler angle object.
+ * @param [in]     cubes           Array of num_cubes real cubes with rows as RX antennas, columns as chirps and
+ *                                 slices as samples per chirp, e.g. the cubes of \ref ifx_Fmcw_Frame_t.
+ * @param [in]     num_cubes       Number of cubes, must be num_cubes of the configuration.
+ * @param [out]    spectrum        Complex cube with rows as range bins, columns as Doppler bins and slices as
+ *                                 angle bins, or NULL.
+ * @param [out]    range_angle     Matrix with rows as range bins and columns as angle bins, or NULL.
+ * @param [out]    range_doppler   Matrix with rows as range bins and columns as Doppler bins, or NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_rda_run_rc(ifx_RDA_t* handle,
+                    const ifx_Cube_R_t* const* cubes,
+                    uint32_t num_cubes,
+                    ifx_Cube_C_t* spectrum,
+                    ifx_Matrix_R_t* range_angle,
+                    ifx_Matrix_R_t* range_doppler);
+
+/**
+ * @brief Returns the number of range bins of the outputs.
+ *
+ * @param [in]     handle    A handle to the range Doppler angle object.
+ *
+ * @return Number of range bins.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_rda_get_num_range_bins(const ifx_RDA_t* handle);
+
+/**
+ * @brief Returns the number of Doppler bins of the outputs.
+ *
+ * @param [in]     handle    A handle to the range Doppler angle object.
+ *
+ * @return Number of Doppler bins.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_rda_get_num_doppler_bins(const ifx_RDA_t* handle);
+
+/**
+ * @brief Sets the thread pool used by \ref ifx_rda_run_rc.
+ *
+ * The antennas of the range Doppler FFTs and the range bins of the angle
+ * FFTs are distributed over the threads of executor. If no executor is set
+ * (the default), everything is processed on the calling thread. The executor
+ * is not owned by the handle and must outlive it or be reset with NULL.
+ *
+ * @param [in]     handle    A handle to the range Doppler angle object.
+ * @param [in]     executor  Thread pool or NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_rda_set_executor(ifx_RDA_t* handle, ifx_Executor_t* executor);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_RANGE_DOPPLER_ANGLE_H */
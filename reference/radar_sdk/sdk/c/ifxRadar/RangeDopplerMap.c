@@ -33,20 +33,28 @@
 ==============================================================================
 */
 
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "ifxAlgo/FFT.h"
+#include "ifxAlgo/internal/Config.h"
 #include "ifxAlgo/Window.h"
 
 #include "ifxBase/Complex.h"
+#include "ifxBase/Cube.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxBase/internal/ComplexInline.h"
+#include "ifxBase/internal/HandleCache.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Mem.h"
 #include "ifxBase/Vector.h"
 
+#include "ifxRadar/internal/FixedRdm.h"
 #include "ifxRadar/RangeDopplerMap.h"
 
 /*
@@ -76,11 +84,37 @@ struct ifx_RDM_s
                                                   e.g. Mean removal, window settings, FFT settings.*/
     ifx_PPFFT_t* doppler_ppfft_handle;       /**< Preprocessed FFT settings for Doppler FFT defined by \ref ifx_PPFFT_t
                                                   e.g. Mean removal, window settings, FFT settings.*/
-    ifx_Vector_C_t* doppler_fft_result;      /**< Container to store the result of Doppler FFT during range doppler spectrum
-                                                  calculation.*/
-    ifx_Matrix_C_t* rdm_matrix;              /**< Container to store the result of range and doppler FFT.*/
+    ifx_Matrix_C_t* range_matrix;            /**< Container to store the range FFT of each chirp in its rows. The rows are
+                                                  padded so that the FFT can write them directly.*/
+    ifx_Matrix_C_t* rdm_matrix;              /**< Container to store the transposed range FFT result, i.e. the chirps of
+                                                  each range bin in a row.*/
+    ifx_Vector_C_t* doppler_spectrum;        /**< Container to store the Doppler FFT of one range bin before the FFT shift.*/
+    ifx_Vector_R_t* doppler_abs2;            /**< Container to store the amplitude spectrum of doppler_spectrum before the FFT shift.*/
+    ifx_RDM_Config_t config;                 /**< Configuration of the handle, used to create workers.*/
+    ifx_RDM_t** workers;                     /**< Handles for the RX antennas except the first one when processing cubes in parallel.*/
+    uint32_t num_workers;                    /**< Number of handles in workers.*/
+    ifx_Executor_t* executor;                /**< Thread pool to process the antennas of a cube, NULL if not set.*/
+    bool windows_changed;                    /**< True after a window was set, such handles are not cached.*/
+    ifx_RDM_Fixed_t* fixed;                  /**< Specialization for the frame geometry of the configuration, replaces
+                                                  range_matrix and rdm_matrix for real input. NULL if there is none.*/
+    ifx_Complex_t rx_calibration[IFX_RX_CALIBRATION_MAX_ANTENNAS]; /**< Correction of the RX antennas of cubes.*/
+    uint32_t num_calibrated;                 /**< Number of antennas in rx_calibration, 0 if cubes are not calibrated.*/
+    const ifx_Complex_t* coefficient;        /**< Correction of the antenna processed by this handle as part of a cube,
+                                                  applied by doppler_fft_c. NULL if there is none.*/
+    uint32_t first_range_bin;                /**< First range bin of the output, rdm_matrix only holds the output bins.*/
 };
 
+/**
+ * @brief Arguments of run_antennas, the task processing the antennas of a cube.
+ */
+typedef struct
+{
+    ifx_RDM_t* handle;             /**< Handle owning the workers.*/
+    const ifx_Cube_R_t* input_r;   /**< Real input cube or NULL.*/
+    const ifx_Cube_C_t* input_c;   /**< Complex input cube or NULL.*/
+    ifx_Cube_C_t* output;          /**< Output cube.*/
+} cube_task_t;
+
 /*
 ==============================================================================
    4. LOCAL DATA
@@ -93,6 +127,9 @@ struct ifx_RDM_s
 ==============================================================================
 */
 
+static bool config_equal(const void* lhs, const void* rhs);
+static void destroy_handle(void* handle);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -100,91 +137,388 @@ struct ifx_RDM_s
 */
 
 /**
- * @brief Computes squared norm of complex vector.
+ * @brief Get the FFT shift of the Doppler spectrum
  *
- * For each element in the vector input compute the square of the absolute
- * value and save it in output: \f$\mathrm{output}_j = |\mathrm{input}_j|^2\f$
+ * The shift brings DC to the center of the spectrum. The first half of the
+ * output is taken from index begin[0] of the spectrum, the second half from
+ * index begin[1], both moving by step.
  *
- * @param [in]     input     Complex input vector.
- * @param [out]    output    Square of norm of vector input.
+ * If mirror is true (real input) the spectrum is additionally rotated around
+ * DC to bring approaching targets on the right side of the spectrum i.e.
+ * positive velocity for approaching target, which reverses both halves. For
+ * complex input data approaching targets fall on the positive side already,
+ * so only both halves are swapped.
  */
-static void ifx_vec_abs2_c(const ifx_Vector_C_t* input, ifx_Vector_R_t* output)
+static void get_doppler_shift(uint32_t fft_size, bool mirror, uint32_t begin[2], ptrdiff_t* step)
 {
-    IFX_VEC_BRK_DIM(input, output);
+    const uint32_t half = fft_size / 2;
 
-    for (uint32_t i = 0; i < vLen(input); i++)
+    if (mirror)
     {
-        const ifx_Complex_t z = vAt(input, i);
-        const ifx_Float_t real = IFX_COMPLEX_REAL(z);
-        const ifx_Float_t imag = IFX_COMPLEX_IMAG(z);
+        begin[0] = half - 1;
+        begin[1] = fft_size - 1;
+        *step = -1;
+    }
+    else
+    {
+        begin[0] = half;
+        begin[1] = 0;
+        *step = 1;
+    }
+}
 
-        vAt(output, i) = real * real + imag * imag;
+/**
+ * @brief Range FFT of all chirps
+ *
+ * The range FFT of each chirp is computed into the rows of range_matrix, which
+ * is then transposed into rdm_matrix using a cache-blocked transpose. Writing
+ * the FFT results directly into the columns of rdm_matrix instead would
+ * result in strided writes for every single element.
+ */
+static void range_fft_r(ifx_RDM_t* handle, const ifx_Matrix_R_t* input, uint32_t num_of_chirps)
+{
+    if (handle->fixed)
+    {
+        ifx_rdm_fixed_range_fft(handle->fixed, input,
+                                ifx_ppfft_get_window(handle->range_ppfft_handle),
+                                ifx_ppfft_get_mean_removal_flag(handle->range_ppfft_handle));
+        return;
     }
+
+    const uint32_t rng_fft_out_size = ifx_ppfft_get_fft_size(handle->range_ppfft_handle) / 2;
+    const uint32_t num_range_bins = mRows(handle->rdm_matrix);
+
+    ifx_Matrix_R_t chirps;
+    ifx_mat_view_r(&chirps, (ifx_Matrix_R_t*)input, 0, 0, num_of_chirps, mCols(input));
+
+    // one element more than used, so the half spectrum output of the FFT needs no copy
+    ifx_Matrix_C_t range_fft;
+    ifx_mat_view_c(&range_fft, handle->range_matrix, 0, 0, num_of_chirps, rng_fft_out_size + 1);
+
+    ifx_ppfft_run_batch_rc(handle->range_ppfft_handle, &chirps, IFX_FFT_BATCH_ROWS, &range_fft, IFX_FFT_BATCH_ROWS);
+
+    // only the range bins of the output are transposed
+    ifx_Matrix_C_t range_bins;
+    ifx_mat_view_c(&range_fft, handle->range_matrix, 0, handle->first_range_bin, num_of_chirps, num_range_bins);
+    ifx_mat_view_c(&range_bins, handle->rdm_matrix, 0, 0, num_range_bins, num_of_chirps);
+    ifx_mat_transpose_c(&range_fft, &range_bins);
+}
+
+static void range_fft_c(ifx_RDM_t* handle, const ifx_Matrix_C_t* input, uint32_t num_of_chirps)
+{
+    const uint32_t rng_fft_out_size = ifx_ppfft_get_fft_size(handle->range_ppfft_handle);
+    const uint32_t num_range_bins = mRows(handle->rdm_matrix);
+
+    ifx_Matrix_C_t chirps;
+    ifx_mat_view_c(&chirps, (ifx_Matrix_C_t*)input, 0, 0, num_of_chirps, mCols(input));
+
+    ifx_Matrix_C_t range_fft;
+    ifx_mat_view_c(&range_fft, handle->range_matrix, 0, 0, num_of_chirps, rng_fft_out_size);
+
+    ifx_ppfft_run_batch_c(handle->range_ppfft_handle, &chirps, IFX_FFT_BATCH_ROWS, &range_fft, IFX_FFT_BATCH_ROWS);
+
+    // only the range bins of the output are transposed
+    ifx_Matrix_C_t range_bins;
+    ifx_mat_view_c(&range_fft, handle->range_matrix, 0, handle->first_range_bin, num_of_chirps, num_range_bins);
+    ifx_mat_view_c(&range_bins, handle->rdm_matrix, 0, 0, num_range_bins, num_of_chirps);
+    ifx_mat_transpose_c(&range_fft, &range_bins);
 }
 
 /**
- * @brief Convert squared absolute of spectrum to dB
+ * @brief Doppler FFT of one range bin
  *
- * Given the squared norm of the spectrum, convert it to dB.
+ * Computes the Doppler FFT of the chirps of range bin into doppler_spectrum
+ * (not shifted yet) and returns its data. The range bin counts from
+ * first_range_bin, like the rows of rdm_matrix. With a specialization for
+ * real input the spectrum is computed by the specialization, which holds all
+ * range bins.
+ */
+static const ifx_Complex_t* doppler_fft(ifx_RDM_t* handle, uint32_t range_bin, uint32_t num_of_chirps, bool real_input)
+{
+    if (real_input && handle->fixed)
+    {
+        return ifx_rdm_fixed_doppler_fft(handle->fixed, handle->first_range_bin + range_bin,
+                                         ifx_ppfft_get_window(handle->doppler_ppfft_handle),
+                                         ifx_ppfft_get_mean_removal_flag(handle->doppler_ppfft_handle));
+    }
+
+    ifx_Matrix_C_t chirps;
+    ifx_mat_view_c(&chirps, handle->rdm_matrix, range_bin, 0, 1, num_of_chirps);
+
+    ifx_Matrix_C_t spectrum;
+    ifx_mat_rawview_c(&spectrum, vDat(handle->doppler_spectrum), 1, vLen(handle->doppler_spectrum), vLen(handle->doppler_spectrum));
+
+    ifx_ppfft_run_batch_c(handle->doppler_ppfft_handle, &chirps, IFX_FFT_BATCH_ROWS, &spectrum, IFX_FFT_BATCH_ROWS);
+
+    return vDat(handle->doppler_spectrum);
+}
+
+/**
+ * @brief Doppler FFT and FFT shift of all range bins into complex output
  *
- * The function is equivalent to:
- *   1. Taking the square root of all elements of vec.
- *   2. Clipping all values smaller than threshold to CLIPPING_VALUE.
- *   3. Converting all value to dB using scale.
+ * If the handle processes a calibrated antenna of a cube, the spectrum is
+ * multiplied with the correction while it is copied into the output, which
+ * needs no pass of its own.
+ */
+static void doppler_fft_c(ifx_RDM_t* handle, uint32_t num_of_chirps, bool mirror, ifx_Matrix_C_t* output)
+{
+    const uint32_t dopp_fft_out_size = mCols(output);
+    const uint32_t half = dopp_fft_out_size / 2;
+    const ifx_Complex_t* coefficient = handle->coefficient;
+
+    uint32_t begin[2];
+    ptrdiff_t step;
+    get_doppler_shift(dopp_fft_out_size, mirror, begin, &step);
+
+    for (uint32_t i = 0; i < mRows(output); ++i)
+    {
+        // only real input is mirrored, see get_doppler_shift
+        const ifx_Complex_t* spectrum = doppler_fft(handle, i, num_of_chirps, mirror);
+
+        ifx_Vector_C_t output_vec;
+        ifx_mat_get_rowview_c(output, i, &output_vec);
+        ifx_Complex_t* row = vDat(&output_vec);
+        const size_t stride = vStride(&output_vec);
+
+        for (uint32_t k = 0; k < 2; k++)
+        {
+            const ifx_Complex_t* src = spectrum + begin[k];
+            ifx_Complex_t* dst = row + k * half * stride;
+            if (coefficient)
+            {
+                for (uint32_t j = 0; j < half; ++j, src += step)
+                    dst[j * stride] = ifx_cmul(*src, *coefficient);
+            }
+            else
+            {
+                for (uint32_t j = 0; j < half; ++j, src += step)
+                    dst[j * stride] = *src;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Doppler FFT, FFT shift and amplitude spectrum of all range bins
  *
- * @param [in,out]  vec         squared norm of spectrum
- * @param [in]      scale       scale factor
- * @param [in]      threshold   threshold for clipping
+ * The squared norm, the thresholding and the scale conversion are fused into
+ * one SIMD kernel (see spectrum_c in Kernels.h), which avoids a square root
+ * by converting half the logarithm of the squared norm:
+ *      log(sqrt(a)) = 0.5*log(a)
+ * Without mirroring, both halves of the shifted spectrum are contiguous and
+ * the kernel writes them directly into a contiguous output row. Otherwise it
+ * writes into doppler_abs2, which is copied shifted into the row.
  */
-static void spectrum2_to_db(ifx_Vector_R_t* vec, ifx_Float_t scale, ifx_Float_t threshold)
-{
-    /* Computing square roots and logarithms is computational
-     * expensive, so we avoid computing the square root directly.
-     *
-     * Perform the clipping on the squared absolute (hence threshold2 is
-     * the square of threshold). If the value is not clipped compute the
-     * square root and convert to dB. The factor of 1/2 when converting to dB
-     * corresponds to taking the square root using the identity:
-     *      log(sqrt(a)) = log(a**0.5) = 0.5*log(a)
-     */
-    const ifx_Float_t threshold2 = threshold * threshold;
-    const ifx_Float_t clip_value = ifx_math_linear_to_db(CLIPPING_VALUE, scale);
-
-    for (uint32_t i = 0; i < vLen(vec); i++)
+static void doppler_fft_r(ifx_RDM_t* handle, uint32_t num_of_chirps, bool mirror, ifx_Matrix_R_t* output)
+{
+    const uint32_t dopp_fft_out_size = mCols(output);
+    const uint32_t half = dopp_fft_out_size / 2;
+    const ifx_Math_Scale_Type_t scale_type = handle->output_scale_type;
+    const ifx_Float_t scale = (scale_type == IFX_SCALE_TYPE_LINEAR) ? 0 : (ifx_Float_t)scale_type / 2;
+    const ifx_Float_t threshold2 = handle->spect_threshold * handle->spect_threshold;
+    const ifx_Float_t clip_value = (scale_type == IFX_SCALE_TYPE_LINEAR) ? CLIPPING_VALUE : ifx_math_linear_to_db(CLIPPING_VALUE, (ifx_Float_t)scale_type);
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+
+    uint32_t begin[2];
+    ptrdiff_t step;
+    get_doppler_shift(dopp_fft_out_size, mirror, begin, &step);
+
+    for (uint32_t i = 0; i < mRows(output); ++i)
     {
-        if (vAt(vec, i) < threshold2)
-            vAt(vec, i) = clip_value;
+        // only real input is mirrored, see get_doppler_shift
+        const ifx_Complex_t* spectrum = doppler_fft(handle, i, num_of_chirps, mirror);
+
+        ifx_Vector_R_t output_vec;
+        ifx_mat_get_rowview_r(output, i, &output_vec);
+        ifx_Float_t* row = vDat(&output_vec);
+        const size_t stride = vStride(&output_vec);
+
+        if (step == 1 && stride == 1)
+        {
+            for (uint32_t k = 0; k < 2; k++)
+                kernels->spectrum_c(spectrum + begin[k], threshold2, clip_value, scale, row + k * half, half);
+            continue;
+        }
+
+        ifx_Float_t* amplitude = vDat(handle->doppler_abs2);
+        if (mirror && handle->fixed)
+            kernels->spectrum_r(ifx_rdm_fixed_doppler_abs2(handle->fixed), threshold2, clip_value, scale, amplitude, dopp_fft_out_size);
         else
-            vAt(vec, i) = ifx_math_linear_to_db(vAt(vec, i), scale / 2);
+            kernels->spectrum_c(spectrum, threshold2, clip_value, scale, amplitude, dopp_fft_out_size);
+
+        for (uint32_t k = 0; k < 2; k++)
+        {
+            const ifx_Float_t* src = amplitude + begin[k];
+            ifx_Float_t* dst = row + k * half * stride;
+            for (uint32_t j = 0; j < half; ++j, src += step)
+                dst[j * stride] = *src;
+        }
     }
 }
 
 /**
- * @brief Convert squared absolute of spectrum to linear
+ * @brief Create handles to process the RX antennas of a cube
  *
- * Given the squared norm of the spectrum, convert it to linear.
+ * With an executor or OpenMP each antenna gets a handle of its own, as a
+ * handle keeps its intermediate results. The workers are created on first
+ * use. Returns false if creating the workers failed.
+ */
+static bool create_workers(ifx_RDM_t* handle, uint32_t num_antennas)
+{
+#ifndef _OPENMP
+    if (handle->executor == NULL)
+        return true;
+#endif
+
+    if (num_antennas <= handle->num_workers + 1)
+        return true;
+
+    ifx_RDM_t** workers = ifx_mem_calloc(num_antennas - 1, sizeof(ifx_RDM_t*));
+    if (workers == NULL)
+        return false;
+
+    for (uint32_t i = 0; i < num_antennas - 1; i++)
+    {
+        workers[i] = (i < handle->num_workers) ? handle->workers[i] : ifx_rdm_create(&handle->config);
+        if (workers[i] == NULL)
+        {
+            for (uint32_t j = handle->num_workers; j < i; j++)
+                ifx_rdm_destroy(workers[j]);
+            ifx_mem_free(workers);
+            return false;
+        }
+    }
+
+    ifx_mem_free(handle->workers);
+    handle->workers = workers;
+    handle->num_workers = num_antennas - 1;
+    return true;
+}
+
+/** @brief Get handle to process RX antenna rx of a cube */
+static ifx_RDM_t* get_worker(ifx_RDM_t* handle, uint32_t rx)
+{
+    if (rx > 0 && rx <= handle->num_workers)
+        return handle->workers[rx - 1];
+    return handle;
+}
+
+/**
+ * @brief Process RX antenna rx of a cube
  *
- * The function is equivalent to:
- *   1. Taking the square root of all elements of vec.
- *   2. Clipping all values smaller than threshold to CLIPPING_VALUE.
+ * Every handle processes one antenna at a time, so the calibration of the
+ * antenna is passed to doppler_fft_c through the handle.
+ */
+static void run_antenna(const cube_task_t* task, uint32_t rx)
+{
+    ifx_RDM_t* worker = get_worker(task->handle, rx);
+
+    ifx_Matrix_C_t rdm_slice;
+    ifx_cube_get_slice_c(task->output, rx, &rdm_slice);
+
+    if (task->handle->num_calibrated)
+        worker->coefficient = &task->handle->rx_calibration[rx];
+
+    if (task->input_r)
+    {
+        ifx_Matrix_R_t chirps;
+        ifx_cube_get_row_r(task->input_r, rx, &chirps);
+        ifx_rdm_run_rc(worker, &chirps, &rdm_slice);
+    }
+    else
+    {
+        ifx_Matrix_C_t chirps;
+        ifx_cube_get_row_c(task->input_c, rx, &chirps);
+        ifx_rdm_run_c(worker, &chirps, &rdm_slice);
+    }
+
+    worker->coefficient = NULL;
+}
+
+/** @brief Executor task processing the antennas begin to end-1 of a cube */
+static void run_antennas(void* context, uint32_t begin, uint32_t end, uint32_t thread)
+{
+    (void)thread;
+    for (uint32_t rx = begin; rx < end; rx++)
+        run_antenna(context, rx);
+}
+
+/**
+ * @brief Common part of ifx_rdm_run_cube_rc and ifx_rdm_run_cube_c
  *
- * @param [in,out]  vec         squared norm of spectrum
- * @param [in]      threshold   threshold for clipping
+ * The error state is per thread, so errors of the antennas are collected and
+ * set on the calling thread afterwards.
  */
-static void spectrum2_to_linear(ifx_Vector_R_t* vec, ifx_Float_t threshold)
+static void run_cube(ifx_RDM_t* handle, const ifx_Cube_R_t* input_r, const ifx_Cube_C_t* input_c, ifx_Cube_C_t* output)
 {
-    const ifx_Float_t threshold2 = threshold * threshold;
-    const ifx_Float_t clip_value = CLIPPING_VALUE;
+    const uint32_t num_antennas = input_r ? cRows(input_r) : cRows(input_c);
+
+    IFX_ERR_BRK_COND(cSlices(output) != num_antennas, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cRows(output) != mRows(handle->rdm_matrix), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(cCols(output) != mCols(handle->rdm_matrix), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(handle->num_calibrated && handle->num_calibrated != num_antennas, IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_ERR_BRK_COND(!create_workers(handle, num_antennas), IFX_ERROR_MEMORY_ALLOCATION_FAILED);
 
-    for (uint32_t i = 0; i < vLen(vec); i++)
+    const cube_task_t task = {handle, input_r, input_c, output};
+    const ifx_Error_t previous_error = ifx_error_get_and_clear();
+    ifx_Error_t error = IFX_OK;
+
+    if (handle->executor)
     {
-        if (vAt(vec, i) < threshold2)
-            vAt(vec, i) = clip_value;
-        else
-            vAt(vec, i) = SQRT(vAt(vec, i));
+        // the executor sets the first error of its threads on this thread
+        ifx_executor_parallel_for(handle->executor, num_antennas, 1, run_antennas, (void*)&task);
+        error = ifx_error_get_and_clear();
+        ifx_error_set_no_callback(error != IFX_OK ? error : previous_error);
+        return;
     }
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_antennas > 1)
+#endif
+    for (int32_t rx = 0; rx < (int32_t)num_antennas; rx++)
+    {
+        ifx_error_clear();
+
+        run_antenna(&task, rx);
+
+        const ifx_Error_t rx_error = ifx_error_get_and_clear();
+        if (rx_error != IFX_OK)
+        {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            error = rx_error;
+        }
+    }
+
+    ifx_error_set_no_callback(error != IFX_OK ? error : previous_error);
+}
+
+//-----------------------------------------------------------------------------
+
+static bool config_equal(const void* lhs, const void* rhs)
+{
+    const ifx_RDM_Config_t* a = lhs;
+    const ifx_RDM_Config_t* b = rhs;
+
+    return a->spect_threshold == b->spect_threshold && a->output_scale_type == b->output_scale_type
+           && ifx_ppfft_config_equal(&a->range_fft_config, &b->range_fft_config)
+           && ifx_ppfft_config_equal(&a->doppler_fft_config, &b->doppler_fft_config)
+           && a->first_range_bin == b->first_range_bin && a->num_range_bins == b->num_range_bins;
 }
 
+//-----------------------------------------------------------------------------
+
+static void destroy_handle(void* handle)
+{
+    ifx_rdm_destroy(handle);
+}
+
+//-----------------------------------------------------------------------------
+
+// released handles for ifx_rdm_acquire, defined after the callbacks it uses
+static ifx_Handle_Cache_t handle_cache = IFX_HANDLE_CACHE_INIT(ifx_RDM_Config_t, config_equal, destroy_handle);
+
 /*
 ==============================================================================
    7. EXPORTED FUNCTIONS
@@ -199,17 +533,34 @@ ifx_RDM_t* ifx_rdm_create(const ifx_RDM_Config_t* config)
     IFX_ERR_BRN_MEMALLOC(h);
 
     uint32_t rng_fft_out_size;
+    uint32_t rng_fft_row_size;
     uint32_t doppler_fft_out_size = config->doppler_fft_config.fft_size;
 
     if (config->range_fft_config.fft_type == IFX_FFT_TYPE_R2C)
     {
         rng_fft_out_size = config->range_fft_config.fft_size / 2;  // for real input use only positive half spectrum
+        rng_fft_row_size = rng_fft_out_size + 1;                   // the FFT computes one element more
     }
     else
     {
         rng_fft_out_size = config->range_fft_config.fft_size;  // for complex input use full spectrum
+        rng_fft_row_size = rng_fft_out_size;
     }
 
+    if (config->first_range_bin >= rng_fft_out_size
+        || config->num_range_bins > rng_fft_out_size - config->first_range_bin)
+    {
+        ifx_rdm_destroy(h);
+        ifx_error_set(IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+        return NULL;
+    }
+    h->first_range_bin = config->first_range_bin;
+    const uint32_t num_range_bins = config->num_range_bins ? config->num_range_bins : rng_fft_out_size - config->first_range_bin;
+
+    // keep the rows of range_matrix aligned
+    const uint32_t align = IFX_MEMORY_ALIGNMENT / sizeof(ifx_Complex_t);
+    rng_fft_row_size = (rng_fft_row_size + align - 1) / align * align;
+
     IFX_ERR_HANDLE_N(ifx_rdm_set_output_scale_type(h, config->output_scale_type),
                      ifx_rdm_destroy(h));
 
@@ -222,15 +573,86 @@ ifx_RDM_t* ifx_rdm_create(const ifx_RDM_Config_t* config)
     IFX_ERR_HANDLE_N(h->doppler_ppfft_handle = ifx_ppfft_create(&config->doppler_fft_config),
                      ifx_rdm_destroy(h));
 
-    h->doppler_fft_result = ifx_vec_create_c(doppler_fft_out_size);
+    IFX_ERR_HANDLE_N(h->fixed = ifx_rdm_fixed_create(config),
+                     ifx_rdm_destroy(h));
+
+    const uint32_t num_of_chirps = MIN(ifx_ppfft_get_window_size(h->doppler_ppfft_handle), doppler_fft_out_size);
+
+    IFX_ERR_HANDLE_N(h->range_matrix = ifx_mat_create_c(num_of_chirps, rng_fft_row_size),
+                     ifx_rdm_destroy(h));
 
-    IFX_ERR_HANDLE_N(h->rdm_matrix = ifx_mat_create_c(rng_fft_out_size, doppler_fft_out_size),
+    IFX_ERR_HANDLE_N(h->rdm_matrix = ifx_mat_create_c(num_range_bins, doppler_fft_out_size),
                      ifx_rdm_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->doppler_spectrum = ifx_vec_create_c(doppler_fft_out_size),
+                     ifx_rdm_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->doppler_abs2 = ifx_vec_create_r(doppler_fft_out_size),
+                     ifx_rdm_destroy(h));
+
+    h->config = *config;
     return h;
 }
 
 //-----------------------------------------------------------------------------
 
+ifx_RDM_t* ifx_rdm_acquire(const ifx_RDM_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+
+    const uint64_t start = ifx_handle_cache_now_ns();
+
+    ifx_RDM_t* h = ifx_handle_cache_take(&handle_cache, config);
+    if (h == NULL)
+        h = ifx_rdm_create(config);
+
+    if (h != NULL)
+        ifx_handle_cache_record(&handle_cache, start);
+
+    return h;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_release(ifx_RDM_t* handle)
+{
+    if (handle == NULL)
+        return;
+
+    // windows cannot be restored to the state after creation
+    if (handle->windows_changed)
+    {
+        ifx_rdm_destroy(handle);
+        return;
+    }
+
+    // the workers for cubes are kept, they only depend on the configuration
+    handle->spect_threshold = handle->config.spect_threshold;
+    handle->output_scale_type = handle->config.output_scale_type;
+    handle->executor = NULL;
+    handle->num_calibrated = 0;
+
+    ifx_handle_cache_put(&handle_cache, &handle->config, handle);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_clear_cache(void)
+{
+    ifx_handle_cache_clear(&handle_cache);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_get_cache_stats(ifx_Handle_Cache_Stats_t* stats)
+{
+    IFX_ERR_BRK_NULL(stats);
+
+    ifx_handle_cache_get_stats(&handle_cache, stats);
+}
+
+//-----------------------------------------------------------------------------
+
 void ifx_rdm_destroy(ifx_RDM_t* handle)
 {
     if (handle == NULL)
@@ -238,14 +660,24 @@ void ifx_rdm_destroy(ifx_RDM_t* handle)
         return;
     }
 
-    ifx_vec_destroy_c(handle->doppler_fft_result);
+    for (uint32_t i = 0; i < handle->num_workers; i++)
+        ifx_rdm_destroy(handle->workers[i]);
+    ifx_mem_free(handle->workers);
+
+    ifx_mat_destroy_c(handle->range_matrix);
 
     ifx_mat_destroy_c(handle->rdm_matrix);
 
+    ifx_vec_destroy_c(handle->doppler_spectrum);
+
+    ifx_vec_destroy_r(handle->doppler_abs2);
+
     ifx_ppfft_destroy(handle->range_ppfft_handle);
 
     ifx_ppfft_destroy(handle->doppler_ppfft_handle);
 
+    ifx_rdm_fixed_destroy(handle->fixed);
+
     ifx_mem_free(handle);
 }
 
@@ -266,48 +698,10 @@ void ifx_rdm_run_rc(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
-    uint32_t rng_fft_out_size = mRows(handle->rdm_matrix);
-    uint32_t dopp_fft_out_size = mCols(handle->rdm_matrix);
+    num_of_chirps = mRows(handle->range_matrix);
 
-    ifx_Vector_C_t fft_result;
-    ifx_Vector_R_t range_fft_inp;
-
-    if (mRows(input) > dopp_fft_out_size)
-    {
-        num_of_chirps = dopp_fft_out_size;
-    }
-
-    for (uint32_t i = 0; i < num_of_chirps; ++i)
-    {
-        ifx_mat_get_rowview_r(input, i, &range_fft_inp);
-
-        ifx_mat_get_colview_c(handle->rdm_matrix, i, &fft_result);
-
-        ifx_ppfft_run_rc(handle->range_ppfft_handle, &range_fft_inp, &fft_result);
-    }
-
-    ifx_Vector_C_t output_vec;
-    ifx_Vector_C_t doppler_fft_inp_view;
-    uint32_t output_len = vLen(handle->doppler_fft_result);
-
-    for (uint32_t i = 0; i < rng_fft_out_size; ++i)
-    {
-        ifx_mat_get_rowview_c(handle->rdm_matrix, i, &doppler_fft_inp_view);
-
-        vLen(&doppler_fft_inp_view) = num_of_chirps;
-
-        ifx_mat_get_rowview_c(output, i, &output_vec);
-
-        ifx_ppfft_run_c(handle->doppler_ppfft_handle, &doppler_fft_inp_view, handle->doppler_fft_result);
-
-        // shift the spectrum to bring DC to zero and then rotate around DC to bring approaching
-        //  targets on the right side of the spectrum i.e. positive velocity for approaching target
-        for (uint32_t j = 0; j < output_len / 2; ++j)
-        {
-            vAt(&output_vec, j) = vAt(handle->doppler_fft_result, output_len / 2 - 1 - j);
-            vAt(&output_vec, output_len / 2 + j) = vAt(handle->doppler_fft_result, output_len - 1 - j);
-        }
-    }
+    range_fft_r(handle, input, num_of_chirps);
+    doppler_fft_c(handle, num_of_chirps, true, output);
 }
 
 //-----------------------------------------------------------------------------
@@ -317,8 +711,8 @@ void ifx_rdm_run_r(ifx_RDM_t* handle,
                    ifx_Matrix_R_t* output)
 {
     IFX_ERR_BRK_NULL(handle);
-    IFX_ERR_BRK_NULL(input);
-    IFX_ERR_BRK_NULL(output);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
 
     uint32_t samples_per_chirp = ifx_ppfft_get_window_size(handle->range_ppfft_handle);
     uint32_t num_of_chirps = ifx_ppfft_get_window_size(handle->doppler_ppfft_handle);
@@ -327,27 +721,10 @@ void ifx_rdm_run_r(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
-    const ifx_Math_Scale_Type_t scale = handle->output_scale_type;
-
-    ifx_rdm_run_rc(handle, input, handle->rdm_matrix);
+    num_of_chirps = mRows(handle->range_matrix);
 
-    for (uint32_t i = 0; i < mRows(output); ++i)
-    {
-        ifx_Vector_C_t rdm_view;
-        ifx_mat_get_rowview_c(handle->rdm_matrix, i, &rdm_view);
-
-        ifx_Vector_R_t output_vec;
-        ifx_mat_get_rowview_r(output, i, &output_vec);
-
-        /* compute squared norm of spectrum */
-        ifx_vec_abs2_c(&rdm_view, &output_vec);
-
-        /* convert to linear or to dB */
-        if (scale == IFX_SCALE_TYPE_LINEAR)
-            spectrum2_to_linear(&output_vec, handle->spect_threshold);
-        else
-            spectrum2_to_db(&output_vec, (ifx_Float_t)scale, handle->spect_threshold);
-    }
+    range_fft_r(handle, input, num_of_chirps);
+    doppler_fft_r(handle, num_of_chirps, true, output);
 }
 
 //-----------------------------------------------------------------------------
@@ -367,43 +744,10 @@ void ifx_rdm_run_c(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
-    uint32_t rng_fft_out_size = mRows(handle->rdm_matrix);
-    uint32_t dopp_fft_out_size = mCols(handle->rdm_matrix);
-
-    ifx_Vector_C_t fft_result;
-    ifx_Vector_C_t range_fft_inp;
-
-    if (mRows(input) > dopp_fft_out_size)
-    {
-        num_of_chirps = dopp_fft_out_size;
-    }
-
-    for (uint32_t i = 0; i < num_of_chirps; ++i)
-    {
-        ifx_mat_get_rowview_c(input, i, &range_fft_inp);
-
-        ifx_mat_get_colview_c(handle->rdm_matrix, i, &fft_result);
-
-        ifx_ppfft_run_c(handle->range_ppfft_handle, &range_fft_inp, &fft_result);
-    }
-
-    ifx_Vector_C_t output_vec;
-    ifx_Vector_C_t doppler_fft_inp_view;
+    num_of_chirps = mRows(handle->range_matrix);
 
-    for (uint32_t i = 0; i < rng_fft_out_size; ++i)
-    {
-        ifx_mat_get_rowview_c(handle->rdm_matrix, i, &doppler_fft_inp_view);
-
-        vLen(&doppler_fft_inp_view) = num_of_chirps;
-
-        ifx_mat_get_rowview_c(output, i, &output_vec);
-
-        ifx_ppfft_run_c(handle->doppler_ppfft_handle, &doppler_fft_inp_view, handle->doppler_fft_result);
-
-        // only shift is enough, no rotation required for complex input data based range doppler as
-        // in this case approaching target falls on positive side.
-        ifx_fft_shift_c(handle->doppler_fft_result, &output_vec);
-    }
+    range_fft_c(handle, input, num_of_chirps);
+    doppler_fft_c(handle, num_of_chirps, false, output);
 }
 
 //-----------------------------------------------------------------------------
@@ -413,8 +757,8 @@ void ifx_rdm_run_cr(ifx_RDM_t* handle,
                     ifx_Matrix_R_t* output)
 {
     IFX_ERR_BRK_NULL(handle);
-    IFX_ERR_BRK_NULL(input);
-    IFX_ERR_BRK_NULL(output);
+    IFX_MAT_BRK_VALID(input);
+    IFX_MAT_BRK_VALID(output);
 
     uint32_t samples_per_chirp = ifx_ppfft_get_window_size(handle->range_ppfft_handle);
     uint32_t num_of_chirps = ifx_ppfft_get_window_size(handle->doppler_ppfft_handle);
@@ -423,28 +767,36 @@ void ifx_rdm_run_cr(ifx_RDM_t* handle,
     IFX_ERR_BRK_COND(mRows(input) != num_of_chirps, IFX_ERROR_DIMENSION_MISMATCH);
     IFX_MAT_BRK_DIM((handle->rdm_matrix), output);
 
-    ifx_Float_t scale = handle->output_scale_type;
+    num_of_chirps = mRows(handle->range_matrix);
 
-    ifx_rdm_run_c(handle, input, handle->rdm_matrix);
+    range_fft_c(handle, input, num_of_chirps);
+    doppler_fft_r(handle, num_of_chirps, false, output);
+}
 
-    ifx_Vector_C_t rdm_view;
-    ifx_Vector_R_t output_vec;
+//-----------------------------------------------------------------------------
 
-    for (uint32_t i = 0; i < mRows(output); ++i)
-    {
-        ifx_mat_get_rowview_r(output, i, &output_vec);
+void ifx_rdm_run_cube_rc(ifx_RDM_t* handle,
+                         const ifx_Cube_R_t* input,
+                         ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
 
-        ifx_mat_get_rowview_c(handle->rdm_matrix, i, &rdm_view);
+    run_cube(handle, input, NULL, output);
+}
 
-        ifx_vec_abs_c(&rdm_view, &output_vec);
+//-----------------------------------------------------------------------------
 
-        ifx_math_vec_clip_lt_threshold_r(&output_vec, handle->spect_threshold, CLIPPING_VALUE, &output_vec);
+void ifx_rdm_run_cube_c(ifx_RDM_t* handle,
+                        const ifx_Cube_C_t* input,
+                        ifx_Cube_C_t* output)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_CUBE_BRK_VALID(input);
+    IFX_CUBE_BRK_VALID(output);
 
-        if (scale != IFX_SCALE_TYPE_LINEAR)
-        {
-            ifx_vec_linear_to_dB(&output_vec, scale, &output_vec);
-        }
-    }
+    run_cube(handle, NULL, input, output);
 }
 
 //-----------------------------------------------------------------------------
@@ -468,6 +820,15 @@ ifx_Float_t ifx_rdm_get_threshold(const ifx_RDM_t* handle)
 
 //-----------------------------------------------------------------------------
 
+uint32_t ifx_rdm_get_num_range_bins(const ifx_RDM_t* handle)
+{
+    IFX_ERR_BRV_NULL(handle, 0)
+
+    return mRows(handle->rdm_matrix);
+}
+
+//-----------------------------------------------------------------------------
+
 void ifx_rdm_set_output_scale_type(ifx_RDM_t* handle,
                                    ifx_Math_Scale_Type_t output_scale_type)
 {
@@ -491,7 +852,16 @@ void ifx_rdm_set_range_window(const ifx_Window_Config_t* config,
                               ifx_RDM_t* handle)
 {
     IFX_ERR_BRK_NULL(handle)
+    IFX_ERR_BRK_NULL(config)
     ifx_ppfft_set_window(handle->range_ppfft_handle, config);
+    handle->windows_changed = true;
+
+    // keep the workers for cubes in sync
+    handle->config.range_fft_config.window_config = *config;
+    ifx_rdm_fixed_destroy(handle->fixed);
+    handle->fixed = ifx_rdm_fixed_create(&handle->config);
+    for (uint32_t i = 0; i < handle->num_workers; i++)
+        ifx_rdm_set_range_window(config, handle->workers[i]);
 }
 
 //-----------------------------------------------------------------------------
@@ -500,5 +870,41 @@ void ifx_rdm_set_doppler_window(const ifx_Window_Config_t* config,
                                 ifx_RDM_t* handle)
 {
     IFX_ERR_BRK_NULL(handle)
+    IFX_ERR_BRK_NULL(config)
     ifx_ppfft_set_window(handle->doppler_ppfft_handle, config);
+    handle->windows_changed = true;
+
+    // keep the workers for cubes in sync
+    handle->config.doppler_fft_config.window_config = *config;
+    ifx_rdm_fixed_destroy(handle->fixed);
+    handle->fixed = ifx_rdm_fixed_create(&handle->config);
+    for (uint32_t i = 0; i < handle->num_workers; i++)
+        ifx_rdm_set_doppler_window(config, handle->workers[i]);
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_set_executor(ifx_RDM_t* handle, ifx_Executor_t* executor)
+{
+    IFX_ERR_BRK_NULL(handle)
+
+    handle->executor = executor;
+}
+
+//-----------------------------------------------------------------------------
+
+void ifx_rdm_set_rx_calibration(ifx_RDM_t* handle, const ifx_RX_Calibration_t* calibration)
+{
+    IFX_ERR_BRK_NULL(handle)
+
+    if (calibration == NULL)
+    {
+        handle->num_calibrated = 0;
+        return;
+    }
+
+    IFX_ERR_BRK_ARGUMENT(calibration->num_antennas == 0 || calibration->num_antennas > IFX_RX_CALIBRATION_MAX_ANTENNAS)
+
+    ifx_rx_calibration_get_coefficients(calibration, handle->rx_calibration);
+    handle->num_calibrated = calibration->num_antennas;
 }
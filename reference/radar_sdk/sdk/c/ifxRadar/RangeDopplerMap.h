@@ -46,9 +46,13 @@
 
 #include "ifxAlgo/PreprocessedFFT.h"
 
+#include "ifxBase/Cube.h"
+#include "ifxBase/Executor.h"
 #include "ifxBase/Matrix.h"
 #include "ifxBase/Types.h"
 
+#include "ifxRadar/RxCalibration.h"
+
 
 #ifdef __cplusplus
 extern "C"
@@ -83,6 +87,9 @@ typedef struct
     ifx_Math_Scale_Type_t output_scale_type; /**< Linear or dB scale for the output of range spectrum module.*/
     ifx_PPFFT_Config_t range_fft_config;     /**< Preprocessed FFT settings for range FFT e.g. mean removal, FFT settings.*/
     ifx_PPFFT_Config_t doppler_fft_config;   /**< Preprocessed FFT settings for Doppler FFT e.g. mean removal, FFT settings.*/
+    uint32_t first_range_bin;                /**< First range bin of the output, see \ref ifx_rdm_get_num_range_bins.*/
+    uint32_t num_range_bins;                 /**< Number of range bins of the output starting at first_range_bin,
+                                                  0 for all bins of the range FFT from first_range_bin on.*/
 } ifx_RDM_Config_t;
 
 /*
@@ -119,10 +126,24 @@ typedef struct
  * - Thresholding (Values below threshold are clipped to threshold value)
  * - Scaling (to scale up or down the spectrum)
  *
+ * The FFT shift, absolute value, thresholding and scaling are done in a single pass over the Doppler spectrum of
+ * each range bin. All intermediate results are kept in the handle, so separate handles (e.g. one per RX antenna)
+ * can be run concurrently from different threads. FFT plans are shared between handles, see \ref ifx_fft_create.
+ *
+ * For real input without zero padding, frame geometries known at compile time (currently 64 chirps of 128 samples,
+ * the BGT60TR13C presence profile) are processed by a specialization with fixed loop bounds and fixed size buffers.
+ * It computes the same result as the generic implementation and is selected by \ref ifx_rdm_create automatically.
+ *
+ * The range bins of the output can be limited to a window of interest with first_range_bin and
+ * num_range_bins, e.g. 0.3m to 3m for presence sensing. The range FFT is still computed for all bins, but
+ * the transpose, the Doppler FFT and the amplitude spectrum are skipped for the bins outside the window and
+ * the output only has the rows of the window. As the Doppler FFT dominates the processing time, a short
+ * window saves most of it.
+ *
  * Range Doppler spectrum output format:
  * - By default dB scale, Linear scale is also possible
- * - Rows of matrix: Range with 0 (first row) to Max (last row) of matrix. For real input, only positive half
- *   of spectrum is computed, thus range is only computed for positive half of spectrum
+ * - Rows of matrix: Range with first_range_bin (first row) to Max (last row) of matrix. For real input, only
+ *   positive half of spectrum is computed, thus range is only computed for positive half of spectrum
  * - Columns of matrix: Speed values are mapped with DC in center and positive half on right
  *   and negative on left
  *
@@ -177,6 +198,52 @@ ifx_RDM_t* ifx_rdm_create(const ifx_RDM_Config_t* config);
 IFX_DLL_PUBLIC
 void ifx_rdm_destroy(ifx_RDM_t* handle);
 
+/**
+ * @brief Returns a range Doppler map object from the handle cache or creates one.
+ *
+ * Objects released with \ref ifx_rdm_release are kept in a cache and handed
+ * out again for an equal configuration, so switching between a few sensor
+ * profiles does not allocate buffers, plan FFTs or compute windows. The
+ * object is in the same state as after \ref ifx_rdm_create, except that
+ * the per antenna objects for cubes are kept. Objects in the cache keep
+ * their FFT backend, see \ref ifx_fft_set_backend.
+ *
+ * The time spent in this function is reported by \ref ifx_rdm_get_cache_stats.
+ *
+ * @param [in]     config    Range Doppler settings, see \ref ifx_rdm_create.
+ *
+ * @return Handle or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_RDM_t* ifx_rdm_acquire(const ifx_RDM_Config_t* config);
+
+/**
+ * @brief Returns a range Doppler map object to the handle cache.
+ *
+ * Threshold and output scale are reset to the configuration and the
+ * executor is removed. Objects whose range or Doppler window was changed are
+ * destroyed instead. The object may come from \ref ifx_rdm_create or
+ * \ref ifx_rdm_acquire.
+ *
+ * @param [in]     handle    A handle to the range Doppler processing object
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_release(ifx_RDM_t* handle);
+
+/**
+ * @brief Destroys all range Doppler map objects in the handle cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_clear_cache(void);
+
+/**
+ * @brief Returns hits, misses and acquire latency of the handle cache.
+ *
+ * @param [out]    stats     Statistics of the cache.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_get_cache_stats(ifx_Handle_Cache_Stats_t* stats);
+
 /**
  * @brief Performs signal processing on a real input I or Q (e.g. mean removal, windowing, zero padding,
  *        FFT transform) and produces a real amplitude range Doppler spectrum as output.
@@ -236,6 +303,42 @@ void ifx_rdm_run_cr(ifx_RDM_t* handle,
                     const ifx_Matrix_C_t* input,
                     ifx_Matrix_R_t* output);
 
+/**
+ * @brief Computes the complex range Doppler spectra of all RX antennas of a real frame.
+ *
+ * This is \ref ifx_rdm_run_rc for every antenna. The input is the cube returned
+ * for a frame by the device, the output is the cube expected by \ref ifx_dbf_run_c.
+ * If the SDK is built with OpenMP the antennas are processed in parallel. For this
+ * the handle creates additional handles with the same configuration on the first
+ * call; the FFT plans are shared through the plan cache.
+ *
+ * @param [in]     handle    A handle to the range Doppler spectrum object
+ * @param [in]     input     The real time domain data cube with rows as RX antennas, columns as chirps and
+ *                           slices as samples per chirp.
+ * @param [out]    output    Complex range Doppler spectra with rows as range bins, columns as Doppler bins and
+ *                           slices as RX antennas.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_run_cube_rc(ifx_RDM_t* handle,
+                         const ifx_Cube_R_t* input,
+                         ifx_Cube_C_t* output);
+
+/**
+ * @brief Computes the complex range Doppler spectra of all RX antennas of a complex frame.
+ *
+ * This is \ref ifx_rdm_run_c for every antenna, see \ref ifx_rdm_run_cube_rc.
+ *
+ * @param [in]     handle    A handle to the range Doppler spectrum object
+ * @param [in]     input     The complex time domain data cube with rows as RX antennas, columns as chirps and
+ *                           slices as samples per chirp.
+ * @param [out]    output    Complex range Doppler spectra with rows as range bins, columns as Doppler bins and
+ *                           slices as RX antennas.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_run_cube_c(ifx_RDM_t* handle,
+                        const ifx_Cube_C_t* input,
+                        ifx_Cube_C_t* output);
+
 /**
  * @brief Modifies the threshold value set within the range Doppler spectrum handle.
  *        Idea is to provide a runtime modification option to change threshold without destroy/create handle.
@@ -259,6 +362,19 @@ void ifx_rdm_set_threshold(ifx_RDM_t* handle,
 IFX_DLL_PUBLIC
 ifx_Float_t ifx_rdm_get_threshold(const ifx_RDM_t* handle);
 
+/**
+ * @brief Returns the number of range bins, i.e. rows, of the output.
+ *
+ * This is num_range_bins of the configuration or, if that is 0, the range
+ * bins of the range FFT from first_range_bin on.
+ *
+ * @param [in]     handle    A handle to the range Doppler spectrum object.
+ *
+ * @return Number of range bins of the output.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_rdm_get_num_range_bins(const ifx_RDM_t* handle);
+
 /**
  * @brief Configures at runtime, the range Doppler spectrum output to linear or dB scale in the handle.
  *
@@ -311,6 +427,39 @@ IFX_DLL_PUBLIC
 void ifx_rdm_set_doppler_window(const ifx_Window_Config_t* config,
                                 ifx_RDM_t* handle);
 
+/**
+ * @brief Sets the thread pool used by \ref ifx_rdm_run_cube_rc and
+ *        \ref ifx_rdm_run_cube_c.
+ *
+ * The antennas of a cube are distributed over the threads of executor. If no
+ * executor is set (the default), the antennas are processed with OpenMP if
+ * the SDK was built with SDK_RADAR_OPENMP, and one after another otherwise.
+ * The executor is not owned by the handle and must outlive it or be reset
+ * with NULL.
+ *
+ * @param [in]     handle    A handle to the range Doppler spectrum object.
+ * @param [in]     executor  Thread pool or NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_set_executor(ifx_RDM_t* handle, ifx_Executor_t* executor);
+
+/**
+ * @brief Sets the calibration of the RX antennas applied by
+ *        \ref ifx_rdm_run_cube_rc and \ref ifx_rdm_run_cube_c.
+ *
+ * Slice i of the output cube is multiplied with the correction of antenna i
+ * (see \ref ifx_rx_calibration_get_coefficients) while the FFT shifted
+ * Doppler spectra are written, so calibrated cubes take no extra pass. The
+ * number of antennas of the calibration must match the rows of the input
+ * cubes, otherwise IFX_ERROR_DIMENSION_MISMATCH is set when running. The
+ * functions for single antennas are not affected.
+ *
+ * @param [in]     handle       A handle to the range Doppler spectrum object.
+ * @param [in]     calibration  Calibration to apply, NULL to stop calibrating.
+ */
+IFX_DLL_PUBLIC
+void ifx_rdm_set_rx_calibration(ifx_RDM_t* handle, const ifx_RX_Calibration_t* calibration);
+
 /**
  * @}
  */
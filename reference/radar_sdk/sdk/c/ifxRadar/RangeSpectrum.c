@@ -36,11 +36,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "ifxAlgo/internal/Unchecked.h"
 #include "ifxAlgo/PreprocessedFFT.h"
 
 #include "ifxBase/Complex.h"
 #include "ifxBase/Defines.h"
 #include "ifxBase/Error.h"
+#include "ifxBase/internal/Kernels.h"
 #include "ifxBase/internal/Macros.h"
 #include "ifxBase/Math.h"
 #include "ifxBase/Matrix.h"
@@ -88,6 +90,14 @@ struct ifx_RS_s
     ifx_Math_Scale_Type_t output_scale_type; /**< Linear or dB scale for the output of range spectrum module.*/
     ifx_PPFFT_t* ppfft_handle;               /**< Handle to an ifx_PPFFT_t object.*/
     ifx_MTI_t* mti_handle[MAX_RX];           /**< Only used in range spectrogram function to remove static targets*/
+    ifx_Vector_R_t* chirp_mean_r;            /**< Mean chirp transformed in IFX_RS_MODE_COHERENT_INTEGRATION (real input).*/
+    ifx_Vector_C_t* chirp_mean_c;            /**< Mean chirp transformed in IFX_RS_MODE_COHERENT_INTEGRATION (complex input).*/
+    ifx_Matrix_R_t* chirps_r;                /**< Input of the last coherent integration (real input).*/
+    ifx_Matrix_C_t* chirps_c;                /**< Input of the last coherent integration (complex input).*/
+    bool spectra_pending;                    /**< fft_spectrum_matrix is computed from chirps_r or chirps_c
+                                                  on demand by ifx_rs_copy_fft_matrix.*/
+    ifx_Vector_R_t* bin_abs2;                /**< Squared magnitudes of one row of fft_spectrum_matrix in IFX_RS_MODE_MAX_BIN.*/
+    ifx_Vector_R_t* bin_max_abs2;            /**< Largest squared magnitude of each bin in IFX_RS_MODE_MAX_BIN.*/
 };
 
 /*
@@ -114,6 +124,16 @@ static void coh_integ_run_c(ifx_RS_t* handle,
                             const ifx_Matrix_C_t* input,
                             ifx_Vector_C_t* output);
 
+static void max_bin_run(ifx_RS_t* handle,
+                        uint32_t num_rows,
+                        ifx_Vector_C_t* output);
+
+static void compute_pending_spectra(ifx_RS_t* handle);
+
+static void amplitude_spectrum(const ifx_RS_t* handle,
+                               const ifx_Vector_C_t* spectrum,
+                               ifx_Vector_R_t* output);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
@@ -177,48 +197,52 @@ static void coh_integ_run_rc(ifx_RS_t* handle,
     ifx_Vector_C_t fft_result;
     ifx_Vector_R_t input_view;
 
-    if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+    if (handle->mode == IFX_RS_MODE_MAX_BIN)
     {
-        ifx_Complex_t zero;
-
-        IFX_COMPLEX_SET(zero, 0, 0);
+        for (uint32_t i = 0; i < mRows(input); i++)
+        {
+            ifx_mat_get_rowview_r(input, i, &input_view);
+            ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+            ifx_ppfft_run_rc_unchecked(handle->ppfft_handle, &input_view, &fft_result);
+        }
+        handle->spectra_pending = false;
 
-        ifx_vec_setall_c(output, zero);
+        max_bin_run(handle, mRows(input), output);
+        return;
     }
 
-    for (uint32_t i = 0; i < mRows(input); i++)
+    // IFX_RS_MODE_COHERENT_INTEGRATION: mean removal, windowing and FFT are
+    // linear, so the mean of the spectra of the chirps is the spectrum of the
+    // mean chirp and a single FFT is sufficient.
+    if (handle->chirp_mean_r == NULL || vLen(handle->chirp_mean_r) != mCols(input))
     {
-        ifx_mat_get_rowview_r(input, i, &input_view);
-
-        ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
-
-        ifx_ppfft_run_rc(handle->ppfft_handle, &input_view, &fft_result);
-
-        if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
-        {
-            ifx_vec_add_c(&fft_result, output, output);
-        }
+        ifx_vec_destroy_r(handle->chirp_mean_r);
+        handle->chirp_mean_r = ifx_vec_create_r(mCols(input));
+        if (handle->chirp_mean_r == NULL)
+            return;
     }
 
-    if (handle->mode == IFX_RS_MODE_MAX_BIN)
+    ifx_mat_get_rowview_r(input, 0, &input_view);
+    ifx_vec_copy_r(&input_view, handle->chirp_mean_r);
+    for (uint32_t i = 1; i < mRows(input); i++)
     {
-        for (uint32_t c = 0; c < mCols(handle->fft_spectrum_matrix); c++)
-        {
-            ifx_Vector_C_t view;
-
-            ifx_mat_get_colview_c(handle->fft_spectrum_matrix, c, &view);
+        ifx_mat_get_rowview_r(input, i, &input_view);
+        ifx_vec_add_r(&input_view, handle->chirp_mean_r, handle->chirp_mean_r);
+    }
+    ifx_vec_scale_r(handle->chirp_mean_r, 1.0f / (ifx_Float_t)(mRows(input)), handle->chirp_mean_r);
 
-            uint32_t idx = ifx_vec_max_idx_c(&view);
+    ifx_ppfft_run_rc_unchecked(handle->ppfft_handle, handle->chirp_mean_r, output);
 
-            vAt(output, c) = vAt(&view, idx);
-        }
-    }
-    else  // IFX_RS_MODE_COHERENT_INTEGRATION
+    // the spectra of the chirps are only computed if ifx_rs_copy_fft_matrix asks for them
+    if (handle->chirps_r == NULL || mRows(handle->chirps_r) != mRows(input) || mCols(handle->chirps_r) != mCols(input))
     {
-        ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)(mRows(input));
-
-        ifx_vec_scale_cr(output, avg_scale, output);
+        ifx_mat_destroy_r(handle->chirps_r);
+        handle->chirps_r = ifx_mat_create_r(mRows(input), mCols(input));
+        if (handle->chirps_r == NULL)
+            return;
     }
+    ifx_mat_copy_r(input, handle->chirps_r);
+    handle->spectra_pending = true;
 }
 
 //----------------------------------------------------------------------------
@@ -232,47 +256,147 @@ static void coh_integ_run_c(ifx_RS_t* handle,
     ifx_Vector_C_t fft_result;
     ifx_Vector_C_t input_view;
 
-    if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+    if (handle->mode == IFX_RS_MODE_MAX_BIN)
     {
-        ifx_Complex_t zero;
+        for (uint32_t i = 0; i < mRows(input); i++)
+        {
+            ifx_mat_get_rowview_c(input, i, &input_view);
+            ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+            ifx_ppfft_run_c_unchecked(handle->ppfft_handle, &input_view, &fft_result);
+        }
+        handle->spectra_pending = false;
 
-        IFX_COMPLEX_SET(zero, 0, 0);
+        max_bin_run(handle, mRows(input), output);
+        return;
+    }
 
-        ifx_vec_setall_c(output, zero);
+    // IFX_RS_MODE_COHERENT_INTEGRATION, see coh_integ_run_rc
+    if (handle->chirp_mean_c == NULL || vLen(handle->chirp_mean_c) != mCols(input))
+    {
+        ifx_vec_destroy_c(handle->chirp_mean_c);
+        handle->chirp_mean_c = ifx_vec_create_c(mCols(input));
+        if (handle->chirp_mean_c == NULL)
+            return;
     }
 
-    for (uint32_t i = 0; i < mRows(input); i++)
+    ifx_mat_get_rowview_c(input, 0, &input_view);
+    ifx_vec_copy_c(&input_view, handle->chirp_mean_c);
+    for (uint32_t i = 1; i < mRows(input); i++)
     {
         ifx_mat_get_rowview_c(input, i, &input_view);
+        ifx_vec_add_c(&input_view, handle->chirp_mean_c, handle->chirp_mean_c);
+    }
+    ifx_vec_scale_cr(handle->chirp_mean_c, 1.0f / (ifx_Float_t)(mRows(input)), handle->chirp_mean_c);
+
+    ifx_ppfft_run_c_unchecked(handle->ppfft_handle, handle->chirp_mean_c, output);
+
+    if (handle->chirps_c == NULL || mRows(handle->chirps_c) != mRows(input) || mCols(handle->chirps_c) != mCols(input))
+    {
+        ifx_mat_destroy_c(handle->chirps_c);
+        handle->chirps_c = ifx_mat_create_c(mRows(input), mCols(input));
+        if (handle->chirps_c == NULL)
+            return;
+    }
+    ifx_mat_copy_c(input, handle->chirps_c);
+    handle->spectra_pending = true;
+}
 
-        ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+//----------------------------------------------------------------------------
 
-        ifx_ppfft_run_c(handle->ppfft_handle, &input_view, &fft_result);
+static void max_bin_run(ifx_RS_t* handle,
+                        uint32_t num_rows,
+                        ifx_Vector_C_t* output)
+{
+    // The rows of the spectrum matrix are traversed contiguously, keeping the
+    // largest squared magnitude of each bin, instead of searching each column.
+    const ifx_Kernels_t* kernels = ifx_kernels_get();
+    const uint32_t num_bins = mCols(handle->fft_spectrum_matrix);
+    ifx_Float_t* abs2 = vDat(handle->bin_abs2);
+    ifx_Float_t* max_abs2 = vDat(handle->bin_max_abs2);
+
+    const ifx_Complex_t* row = &mAt(handle->fft_spectrum_matrix, 0, 0);
+    kernels->abs2_c(row, max_abs2, num_bins);
+    for (uint32_t c = 0; c < num_bins; c++)
+    {
+        vAt(output, c) = row[c];
+    }
+
+    for (uint32_t i = 1; i < num_rows; i++)
+    {
+        row = &mAt(handle->fft_spectrum_matrix, i, 0);
+        kernels->abs2_c(row, abs2, num_bins);
 
-        if (handle->mode == IFX_RS_MODE_COHERENT_INTEGRATION)
+        // the first maximum wins, as in ifx_vec_max_idx_c
+        for (uint32_t c = 0; c < num_bins; c++)
         {
-            ifx_vec_add_c(&fft_result, output, output);
+            if (abs2[c] > max_abs2[c])
+            {
+                max_abs2[c] = abs2[c];
+                vAt(output, c) = row[c];
+            }
         }
     }
+}
 
-    if (handle->mode == IFX_RS_MODE_MAX_BIN)
+//----------------------------------------------------------------------------
+
+static void amplitude_spectrum(const ifx_RS_t* handle,
+                               const ifx_Vector_C_t* spectrum,
+                               ifx_Vector_R_t* output)
+{
+    // absolute value, clipping and dB conversion in one kernel working on the
+    // squared norm, half the scale in dB takes the square root
+    const ifx_Math_Scale_Type_t scale_type = handle->output_scale_type;
+
+    if (vStride(spectrum) == 1 && vStride(output) == 1)
     {
-        for (uint32_t c = 0; c < mCols(handle->fft_spectrum_matrix); c++)
-        {
-            ifx_Vector_C_t view;
+        const ifx_Float_t scale = (scale_type == IFX_SCALE_TYPE_LINEAR) ? 0 : (ifx_Float_t)scale_type / 2;
+        const ifx_Float_t clip_value = (scale_type == IFX_SCALE_TYPE_LINEAR) ? CLIPPING_VALUE : ifx_math_linear_to_db(CLIPPING_VALUE, (ifx_Float_t)scale_type);
+
+        ifx_kernels_get()->spectrum_c(vDat(spectrum), handle->spect_threshold * handle->spect_threshold,
+                                      clip_value, scale, vDat(output), vLen(output));
+        return;
+    }
+
+    ifx_vec_abs_c(spectrum, output);
+
+    ifx_math_vec_clip_lt_threshold_r(output, handle->spect_threshold, CLIPPING_VALUE, output);
 
-            ifx_mat_get_colview_c(handle->fft_spectrum_matrix, c, &view);
+    if (scale_type != IFX_SCALE_TYPE_LINEAR)
+    {
+        ifx_vec_linear_to_dB(output, scale_type, output);
+    }
+}
 
-            uint32_t idx = ifx_vec_max_idx_c(&view);
+//----------------------------------------------------------------------------
 
-            vAt(output, c) = vAt(&view, idx);
+static void compute_pending_spectra(ifx_RS_t* handle)
+{
+    if (!handle->spectra_pending)
+        return;
+
+    handle->spectra_pending = false;
+
+    ifx_Vector_C_t fft_result;
+    if (ifx_ppfft_get_fft_type(handle->ppfft_handle) == IFX_FFT_TYPE_R2C)
+    {
+        for (uint32_t i = 0; i < mRows(handle->chirps_r); i++)
+        {
+            ifx_Vector_R_t input_view;
+            ifx_mat_get_rowview_r(handle->chirps_r, i, &input_view);
+            ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+            ifx_ppfft_run_rc_unchecked(handle->ppfft_handle, &input_view, &fft_result);
         }
     }
-    else  // IFX_RS_MODE_COHERENT_INTEGRATION
+    else
     {
-        ifx_Float_t avg_scale = 1.0f / (ifx_Float_t)(mRows(input));
-
-        ifx_vec_scale_cr(output, avg_scale, output);
+        for (uint32_t i = 0; i < mRows(handle->chirps_c); i++)
+        {
+            ifx_Vector_C_t input_view;
+            ifx_mat_get_rowview_c(handle->chirps_c, i, &input_view);
+            ifx_mat_get_rowview_c(handle->fft_spectrum_matrix, i, &fft_result);
+            ifx_ppfft_run_c_unchecked(handle->ppfft_handle, &input_view, &fft_result);
+        }
     }
 }
 
@@ -309,6 +433,12 @@ ifx_RS_t* ifx_rs_create(const ifx_RS_Config_t* config)
     IFX_ERR_HANDLE_N(h->ppfft_handle = ifx_ppfft_create(&config->fft_config),
                      ifx_rs_destroy(h));
 
+    IFX_ERR_HANDLE_N(h->bin_abs2 = ifx_vec_create_r(fft_out_size),
+                     ifx_rs_destroy(h));
+
+    IFX_ERR_HANDLE_N(h->bin_max_abs2 = ifx_vec_create_r(fft_out_size),
+                     ifx_rs_destroy(h));
+
     for (uint32_t i = 0; i < MAX_RX; ++i)
     {
         IFX_ERR_HANDLE_N(h->mti_handle[i] = ifx_mti_create(0.5, fft_out_size),
@@ -341,6 +471,12 @@ void ifx_rs_destroy(ifx_RS_t* handle)
     ifx_ppfft_destroy(handle->ppfft_handle);
     ifx_mat_destroy_c(handle->fft_spectrum_matrix);
     ifx_vec_destroy_c(handle->fft_mean_result);
+    ifx_vec_destroy_r(handle->chirp_mean_r);
+    ifx_vec_destroy_c(handle->chirp_mean_c);
+    ifx_mat_destroy_r(handle->chirps_r);
+    ifx_mat_destroy_c(handle->chirps_c);
+    ifx_vec_destroy_r(handle->bin_abs2);
+    ifx_vec_destroy_r(handle->bin_max_abs2);
 
     for (uint32_t i = 0; i < MAX_RX; ++i)
     {
@@ -363,14 +499,7 @@ void ifx_rs_run_r(ifx_RS_t* handle,
 
     ifx_rs_run_rc(handle, input, handle->fft_mean_result);
 
-    ifx_vec_abs_c(handle->fft_mean_result, output);
-
-    ifx_math_vec_clip_lt_threshold_r(output, handle->spect_threshold, CLIPPING_VALUE, output);
-
-    if (handle->output_scale_type != IFX_SCALE_TYPE_LINEAR)
-    {
-        ifx_vec_linear_to_dB(output, handle->output_scale_type, output);
-    }
+    amplitude_spectrum(handle, handle->fft_mean_result, output);
 }
 
 //----------------------------------------------------------------------------
@@ -383,6 +512,11 @@ void ifx_rs_run_rc(ifx_RS_t* handle,
     IFX_MAT_BRK_VALID(input);
     IFX_VEC_BRK_VALID(output);
 
+    // validated once here, the FFTs of the chirps run unchecked
+    IFX_ERR_BRK_COND(ifx_ppfft_get_fft_type(handle->ppfft_handle) != IFX_FFT_TYPE_R2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_REAL);
+    IFX_ERR_BRK_COND(mCols(input) < vLen(ifx_ppfft_get_window(handle->ppfft_handle)), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_VEC_BRK_MINSIZE(output, mCols(handle->fft_spectrum_matrix));
+
     ifx_Vector_R_t view_in;
 
     if (handle->mode == IFX_RS_MODE_MAX_ENERGY)
@@ -391,14 +525,14 @@ void ifx_rs_run_rc(ifx_RS_t* handle,
 
         ifx_mat_get_rowview_r((ifx_Matrix_R_t*)input, i, &view_in);
 
-        ifx_ppfft_run_rc(handle->ppfft_handle, &view_in, output);
+        ifx_ppfft_run_rc_unchecked(handle->ppfft_handle, &view_in, output);
     }
     else if (handle->mode == IFX_RS_MODE_SINGLE_CHIRP)
     {
         IFX_ERR_BRK_COND(mRows(input) < handle->single_chirp_mode_index, IFX_ERROR_DIMENSION_MISMATCH);
         ifx_mat_get_rowview_r((ifx_Matrix_R_t*)input, handle->single_chirp_mode_index, &view_in);
 
-        ifx_ppfft_run_rc(handle->ppfft_handle, &view_in, output);
+        ifx_ppfft_run_rc_unchecked(handle->ppfft_handle, &view_in, output);
     }
     else
     {
@@ -416,6 +550,11 @@ void ifx_rs_run_c(ifx_RS_t* handle,
     IFX_MAT_BRK_VALID(input);
     IFX_VEC_BRK_VALID(output);
 
+    // validated once here, the FFTs of the chirps run unchecked
+    IFX_ERR_BRK_COND(ifx_ppfft_get_fft_type(handle->ppfft_handle) != IFX_FFT_TYPE_C2C, IFX_ERROR_ARGUMENT_INVALID_EXPECTED_COMPLEX);
+    IFX_ERR_BRK_COND(mCols(input) < vLen(ifx_ppfft_get_window(handle->ppfft_handle)), IFX_ERROR_DIMENSION_MISMATCH);
+    IFX_VEC_BRK_MINSIZE(output, mCols(handle->fft_spectrum_matrix));
+
     ifx_Vector_C_t view_in;
 
     if (handle->mode == IFX_RS_MODE_MAX_ENERGY)
@@ -424,14 +563,14 @@ void ifx_rs_run_c(ifx_RS_t* handle,
 
         ifx_mat_get_rowview_c((ifx_Matrix_C_t*)input, i, &view_in);
 
-        ifx_ppfft_run_c(handle->ppfft_handle, &view_in, output);
+        ifx_ppfft_run_c_unchecked(handle->ppfft_handle, &view_in, output);
     }
     else if (handle->mode == IFX_RS_MODE_SINGLE_CHIRP)
     {
         IFX_ERR_BRK_COND(mRows(input) < handle->single_chirp_mode_index, IFX_ERROR_DIMENSION_MISMATCH);
         ifx_mat_get_rowview_c((ifx_Matrix_C_t*)input, handle->single_chirp_mode_index, &view_in);
 
-        ifx_ppfft_run_c(handle->ppfft_handle, &view_in, output);
+        ifx_ppfft_run_c_unchecked(handle->ppfft_handle, &view_in, output);
     }
     else
     {
@@ -451,14 +590,7 @@ void ifx_rs_run_cr(ifx_RS_t* handle,
 
     ifx_rs_run_c(handle, input, handle->fft_mean_result);
 
-    ifx_vec_abs_c(handle->fft_mean_result, output);
-
-    ifx_math_vec_clip_lt_threshold_r(output, handle->spect_threshold, CLIPPING_VALUE, output);
-
-    if (handle->output_scale_type != IFX_SCALE_TYPE_LINEAR)
-    {
-        ifx_vec_linear_to_dB(output, handle->output_scale_type, output);
-    }
+    amplitude_spectrum(handle, handle->fft_mean_result, output);
 }
 
 //----------------------------------------------------------------------------
@@ -521,6 +653,8 @@ ifx_Math_Scale_Type_t ifx_rs_get_output_scale_type(const ifx_RS_t* handle)
 void ifx_rs_set_window(ifx_RS_t* handle,
                        const ifx_Window_Config_t* config)
 {
+    // spectra pending from the last run are computed with the window they were integrated with
+    compute_pending_spectra(handle);
     ifx_ppfft_set_window(handle->ppfft_handle, config);
 }
 
@@ -529,6 +663,9 @@ void ifx_rs_set_window(ifx_RS_t* handle,
 void ifx_rs_copy_fft_matrix(const ifx_RS_t* handle,
                             ifx_Matrix_C_t* output)
 {
+    // the spectra of a coherent integration are a cache filled on demand
+    compute_pending_spectra((ifx_RS_t*)handle);
+
     ifx_mat_blit_c(handle->fft_spectrum_matrix, 0, mRows(output), 0, mCols(output), output);
 }
 
@@ -0,0 +1,267 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ifxBase/Complex.h"
+#include "ifxBase/Error.h"
+
+#include "ifxRadar/RxCalibration.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define RECORD_VERSION (1U)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+static const uint8_t record_magic[4] = {'R', 'X', 'C', 'L'};
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static uint32_t crc32(const uint8_t* data, size_t size);
+
+static void put_u32(uint8_t* p, uint32_t value);
+
+static uint32_t get_u32(const uint8_t* p);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/**
+ * @brief CRC-32 as used by IEEE 802.3, computed bitwise as records are small
+ */
+static uint32_t crc32(const uint8_t* data, size_t size)
+{
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+
+    return ~crc;
+}
+
+//----------------------------------------------------------------------------
+
+static void put_u32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t get_u32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+void ifx_rx_calibration_init(ifx_RX_Calibration_t* calibration,
+                             uint32_t num_antennas)
+{
+    IFX_ERR_BRK_NULL(calibration);
+    IFX_ERR_BRK_ARGUMENT(num_antennas > IFX_RX_CALIBRATION_MAX_ANTENNAS);
+
+    memset(calibration, 0, sizeof(*calibration));
+    calibration->num_antennas = num_antennas;
+    for (uint32_t i = 0; i < num_antennas; i++)
+        calibration->gain[i] = 1;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rx_calibration_get_coefficients(const ifx_RX_Calibration_t* calibration,
+                                         ifx_Complex_t* coefficients)
+{
+    IFX_ERR_BRK_NULL(calibration);
+    IFX_ERR_BRK_NULL(coefficients);
+    IFX_ERR_BRK_ARGUMENT(calibration->num_antennas > IFX_RX_CALIBRATION_MAX_ANTENNAS);
+
+    for (uint32_t i = 0; i < calibration->num_antennas; i++)
+    {
+        const ifx_Float_t gain = calibration->gain[i];
+        const ifx_Float_t phase = calibration->phase_rad[i];
+        IFX_COMPLEX_SET(coefficients[i], gain * cosf(phase), gain * sinf(phase));
+    }
+}
+
+//----------------------------------------------------------------------------
+
+size_t ifx_rx_calibration_encode(const ifx_RX_Calibration_t* calibration,
+                                 uint8_t* buffer,
+                                 size_t size)
+{
+    IFX_ERR_BRV_NULL(calibration, 0);
+    IFX_ERR_BRV_NULL(buffer, 0);
+
+    const uint32_t num_antennas = calibration->num_antennas;
+    IFX_ERR_BRV_ARGUMENT(num_antennas > IFX_RX_CALIBRATION_MAX_ANTENNAS, 0);
+
+    const size_t record_size = IFX_RX_CALIBRATION_SIZE(num_antennas);
+    IFX_ERR_BRV_COND(size < record_size, IFX_ERROR_INSUFFICIENT_MEMORY_ALLOCATED, 0);
+
+    memcpy(buffer, record_magic, sizeof(record_magic));
+    put_u32(buffer + 4, RECORD_VERSION | (num_antennas << 16));
+
+    uint8_t* p = buffer + 8;
+    for (uint32_t i = 0; i < num_antennas; i++, p += 8)
+    {
+        const float gain = (float)calibration->gain[i];
+        const float phase = (float)calibration->phase_rad[i];
+        uint32_t bits;
+
+        memcpy(&bits, &gain, sizeof(bits));
+        put_u32(p, bits);
+        memcpy(&bits, &phase, sizeof(bits));
+        put_u32(p + 4, bits);
+    }
+
+    put_u32(p, crc32(buffer, record_size - 4));
+    return record_size;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rx_calibration_decode(const uint8_t* buffer,
+                               size_t size,
+                               ifx_RX_Calibration_t* calibration)
+{
+    IFX_ERR_BRK_NULL(buffer);
+    IFX_ERR_BRK_NULL(calibration);
+    IFX_ERR_BRK_ARGUMENT(size < IFX_RX_CALIBRATION_SIZE(0));
+    IFX_ERR_BRK_ARGUMENT(memcmp(buffer, record_magic, sizeof(record_magic)) != 0);
+
+    const uint32_t header = get_u32(buffer + 4);
+    const uint32_t num_antennas = header >> 16;
+    IFX_ERR_BRK_ARGUMENT((header & 0xFFFFU) != RECORD_VERSION);
+    IFX_ERR_BRK_ARGUMENT(num_antennas > IFX_RX_CALIBRATION_MAX_ANTENNAS);
+
+    const size_t record_size = IFX_RX_CALIBRATION_SIZE(num_antennas);
+    IFX_ERR_BRK_ARGUMENT(size < record_size);
+    IFX_ERR_BRK_ARGUMENT(get_u32(buffer + record_size - 4) != crc32(buffer, record_size - 4));
+
+    ifx_RX_Calibration_t decoded = {0};
+    decoded.num_antennas = num_antennas;
+
+    const uint8_t* p = buffer + 8;
+    for (uint32_t i = 0; i < num_antennas; i++, p += 8)
+    {
+        float gain;
+        float phase;
+        uint32_t bits;
+
+        bits = get_u32(p);
+        memcpy(&gain, &bits, sizeof(gain));
+        bits = get_u32(p + 4);
+        memcpy(&phase, &bits, sizeof(phase));
+
+        decoded.gain[i] = gain;
+        decoded.phase_rad[i] = phase;
+    }
+
+    *calibration = decoded;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rx_calibration_load(const char* filename,
+                             ifx_RX_Calibration_t* calibration)
+{
+    IFX_ERR_BRK_NULL(filename);
+    IFX_ERR_BRK_NULL(calibration);
+
+    FILE* file = fopen(filename, "rb");
+    IFX_ERR_BRK_COND(file == NULL, IFX_ERROR_OPENING_FILE);
+
+    uint8_t record[IFX_RX_CALIBRATION_SIZE(IFX_RX_CALIBRATION_MAX_ANTENNAS)];
+    const size_t size = fread(record, 1, sizeof(record), file);
+    fclose(file);
+
+    ifx_rx_calibration_decode(record, size, calibration);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_rx_calibration_save(const char* filename,
+                             const ifx_RX_Calibration_t* calibration)
+{
+    IFX_ERR_BRK_NULL(filename);
+
+    uint8_t record[IFX_RX_CALIBRATION_SIZE(IFX_RX_CALIBRATION_MAX_ANTENNAS)];
+    const size_t size = ifx_rx_calibration_encode(calibration, record, sizeof(record));
+    if (size == 0)
+        return;
+
+    FILE* file = fopen(filename, "wb");
+    IFX_ERR_BRK_COND(file == NULL, IFX_ERROR_OPENING_FILE);
+
+    const size_t written = fwrite(record, 1, size, file);
+    const int closed = fclose(file);
+    IFX_ERR_BRK_COND(written != size || closed != 0, IFX_ERROR_OPENING_FILE);
+}
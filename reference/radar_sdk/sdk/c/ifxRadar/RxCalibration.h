@@ -0,0 +1,219 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file RxCalibration.h
+ *
+ * \brief \copybrief gr_rxcalibration
+ *
+ * For details refer to \ref gr_rxcalibration
+ */
+
+#ifndef IFX_RADAR_RX_CALIBRATION_H
+#define IFX_RADAR_RX_CALIBRATION_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ifxBase/Types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/**
+ * @brief Maximum number of RX antennas of a calibration.
+ */
+#define IFX_RX_CALIBRATION_MAX_ANTENNAS (16U)
+
+/**
+ * @brief Size in bytes of the encoded calibration of num_antennas antennas.
+ */
+#define IFX_RX_CALIBRATION_SIZE(num_antennas) (12U + 8U * (num_antennas))
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Gain and phase correction of the RX channels of a board.
+ *
+ * The spectrum of antenna i is corrected by multiplying it with
+ * gain[i] * exp(j * phase_rad[i]).
+ */
+typedef struct
+{
+    uint32_t num_antennas;                                /**< Number of calibrated RX antennas.*/
+    ifx_Float_t gain[IFX_RX_CALIBRATION_MAX_ANTENNAS];      /**< Linear gain correction of each antenna.*/
+    ifx_Float_t phase_rad[IFX_RX_CALIBRATION_MAX_ANTENNAS]; /**< Phase correction of each antenna in radians.*/
+} ifx_RX_Calibration_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_rxcalibration RX Calibration
+ * @brief API for the gain and phase calibration of RX channels
+ *
+ * Array processing (\ref gr_dbf, \ref gr_anglecapon,
+ * \ref gr_anglemonopulse) assumes RX channels of equal gain and phase.
+ * The deviations of a board are described by an \ref ifx_RX_Calibration_t,
+ * which is applied by the range Doppler map module while it writes its
+ * complex output, see \ref ifx_rdm_set_rx_calibration. This costs no extra
+ * pass over the spectra.
+ *
+ * The raw samples of a device are real, so a phase correction cannot be
+ * applied before the range FFT.
+ *
+ * Calibrations are stored in a small binary record, all fields little
+ * endian:
+ * - "RXCL" magic
+ * - u16 version (1)
+ * - u16 number of antennas n
+ * - n pairs of f32 gain and f32 phase in radians
+ * - u32 CRC-32 (IEEE 802.3) of all previous bytes
+ *
+ * The record can be kept in a file (\ref ifx_rx_calibration_load) or in the
+ * EEPROM of the RF shield, which is read by \ref ifx_fmcw_read_eeprom and
+ * decoded by \ref ifx_rx_calibration_decode.
+ * @{
+ */
+
+/**
+ * @brief Initializes a calibration which does not change the spectra.
+ *
+ * @param [out]    calibration    Calibration with unit gains and zero phases.
+ * @param [in]     num_antennas   Number of RX antennas, at most
+ *                                \ref IFX_RX_CALIBRATION_MAX_ANTENNAS.
+ */
+IFX_DLL_PUBLIC
+void ifx_rx_calibration_init(ifx_RX_Calibration_t* calibration,
+                             uint32_t num_antennas);
+
+/**
+ * @brief Computes the complex correction coefficient of each antenna.
+ *
+ * The coefficients can also be folded into beamforming weights or steering
+ * vectors instead of correcting the spectra.
+ *
+ * @param [in]     calibration    Calibration.
+ * @param [out]    coefficients   Array of calibration->num_antennas elements,
+ *                                gain[i] * exp(j * phase_rad[i]).
+ */
+IFX_DLL_PUBLIC
+void ifx_rx_calibration_get_coefficients(const ifx_RX_Calibration_t* calibration,
+                                         ifx_Complex_t* coefficients);
+
+/**
+ * @brief Encodes a calibration into a binary record.
+ *
+ * @param [in]     calibration    Calibration.
+ * @param [out]    buffer         Buffer for the record.
+ * @param [in]     size           Size of buffer in bytes, at least
+ *                                \ref IFX_RX_CALIBRATION_SIZE (num_antennas).
+ *
+ * @return Size of the record in bytes, 0 on error.
+ */
+IFX_DLL_PUBLIC
+size_t ifx_rx_calibration_encode(const ifx_RX_Calibration_t* calibration,
+                                 uint8_t* buffer,
+                                 size_t size);
+
+/**
+ * @brief Decodes a calibration from a binary record.
+ *
+ * Bytes after the record are ignored, so a fixed size block read from an
+ * EEPROM can be passed. If the record is invalid (wrong magic, version or
+ * CRC), IFX_ERROR_ARGUMENT_INVALID is set and calibration is not changed.
+ *
+ * @param [in]     buffer         Record.
+ * @param [in]     size           Size of buffer in bytes.
+ * @param [out]    calibration    Decoded calibration.
+ */
+IFX_DLL_PUBLIC
+void ifx_rx_calibration_decode(const uint8_t* buffer,
+                               size_t size,
+                               ifx_RX_Calibration_t* calibration);
+
+/**
+ * @brief Loads a calibration from a file holding a binary record.
+ *
+ * @param [in]     filename       Path of the file.
+ * @param [out]    calibration    Loaded calibration.
+ */
+IFX_DLL_PUBLIC
+void ifx_rx_calibration_load(const char* filename,
+                             ifx_RX_Calibration_t* calibration);
+
+/**
+ * @brief Saves a calibration as binary record into a file.
+ *
+ * @param [in]     filename       Path of the file, an existing file is replaced.
+ * @param [in]     calibration    Calibration.
+ */
+IFX_DLL_PUBLIC
+void ifx_rx_calibration_save(const char* filename,
+                             const ifx_RX_Calibration_t* calibration);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_RX_CALIBRATION_H */
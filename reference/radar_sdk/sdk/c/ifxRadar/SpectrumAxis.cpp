@@ -36,7 +36,14 @@
 #include <cstdlib>
 #include <cstring>
 
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 #include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
 #include "ifxRadar/SpectrumAxis.h"
 
 /*
@@ -45,12 +52,35 @@
 ==============================================================================
 */
 
+// Lock protecting the table cache
+#if defined(_WIN32)
+#define CACHE_LOCK()   AcquireSRWLockExclusive(&cache_lock)
+#define CACHE_UNLOCK() ReleaseSRWLockExclusive(&cache_lock)
+#else
+#define CACHE_LOCK()   pthread_mutex_lock(&cache_lock)
+#define CACHE_UNLOCK() pthread_mutex_unlock(&cache_lock)
+#endif
+
 /*
 ==============================================================================
    3. LOCAL TYPES
 ==============================================================================
 */
 
+/**
+ * @brief Table in the table cache.
+ *
+ * The values are stored behind the entry. Tables are shared by all users of
+ * the same configuration and stay in the cache after the last user released
+ * them.
+ */
+struct ifx_Spectrum_Axis_Entry_t
+{
+    ifx_Spectrum_Axis_Config_t config; /**< Configuration with unused parameters set to zero.*/
+    ifx_Spectrum_Axis_Table_t table;   /**< Table handed out to the users.*/
+    uint32_t users;                    /**< Number of users of the table.*/
+    ifx_Spectrum_Axis_Entry_t* next;   /**< Next table in the cache.*/
+};
 
 /*
 ==============================================================================
@@ -58,18 +88,143 @@
 ==============================================================================
 */
 
+#if defined(_WIN32)
+static SRWLOCK cache_lock = SRWLOCK_INIT;
+#else
+static pthread_mutex_t cache_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static ifx_Spectrum_Axis_Entry_t* table_cache = nullptr;
+
 /*
 ==============================================================================
    5. LOCAL FUNCTION PROTOTYPES
 ==============================================================================
 */
 
+/**
+ * @brief Copies the parameters of config used by its unit and sets all other
+ *        parameters to zero, so that equal axes have equal keys.
+ *
+ * @param [in]     config    Parameters of the axis.
+ * @param [out]    key       Key of the axis in the cache.
+ */
+static void make_key(const ifx_Spectrum_Axis_Config_t* config, ifx_Spectrum_Axis_Config_t* key);
+
+/**
+ * @brief Returns true if two keys created by make_key are equal.
+ */
+static bool equal_key(const ifx_Spectrum_Axis_Config_t* lhs, const ifx_Spectrum_Axis_Config_t* rhs);
+
+/**
+ * @brief Creates a cache entry with the table of an axis.
+ *
+ * @param [in]     key       Key of the axis created by make_key.
+ * @return Entry with no users or nullptr in case of failure.
+ */
+static ifx_Spectrum_Axis_Entry_t* create_entry(const ifx_Spectrum_Axis_Config_t* key);
+
 /*
 ==============================================================================
    6. LOCAL FUNCTIONS
 ==============================================================================
 */
 
+static void make_key(const ifx_Spectrum_Axis_Config_t* config, ifx_Spectrum_Axis_Config_t* key)
+{
+    memset(key, 0, sizeof(*key));
+    key->unit = config->unit;
+    key->fft_type = config->fft_type;
+    key->fft_size = config->fft_size;
+
+    switch (config->unit)
+    {
+        case IFX_SPECTRUM_AXIS_BEAT_FREQ:
+            key->chirptime_s = config->chirptime_s;
+            // fall through
+        case IFX_SPECTRUM_AXIS_RANGE:
+            key->samples_per_chirp = config->samples_per_chirp;
+            key->bandwidth_Hz = config->bandwidth_Hz;
+            break;
+
+        case IFX_SPECTRUM_AXIS_SPEED:
+            key->center_rf_freq_Hz = config->center_rf_freq_Hz;
+            key->pulse_repet_time_s = config->pulse_repet_time_s;
+            break;
+
+        case IFX_SPECTRUM_AXIS_SAMPLING_FREQ:
+            key->sampling_freq_Hz = config->sampling_freq_Hz;
+            break;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static bool equal_key(const ifx_Spectrum_Axis_Config_t* lhs, const ifx_Spectrum_Axis_Config_t* rhs)
+{
+    return lhs->unit == rhs->unit
+           && lhs->fft_type == rhs->fft_type
+           && lhs->fft_size == rhs->fft_size
+           && lhs->samples_per_chirp == rhs->samples_per_chirp
+           && lhs->bandwidth_Hz == rhs->bandwidth_Hz
+           && lhs->chirptime_s == rhs->chirptime_s
+           && lhs->sampling_freq_Hz == rhs->sampling_freq_Hz
+           && lhs->center_rf_freq_Hz == rhs->center_rf_freq_Hz
+           && lhs->pulse_repet_time_s == rhs->pulse_repet_time_s;
+}
+
+//----------------------------------------------------------------------------
+
+static ifx_Spectrum_Axis_Entry_t* create_entry(const ifx_Spectrum_Axis_Config_t* key)
+{
+    ifx_Math_Axis_Spec_t spec = {0, 0, 0};
+
+    switch (key->unit)
+    {
+        case IFX_SPECTRUM_AXIS_RANGE:
+            spec = ifx_spectrum_axis_calc_range_axis(key->fft_type, key->fft_size, key->samples_per_chirp,
+                                                     key->bandwidth_Hz);
+            break;
+
+        case IFX_SPECTRUM_AXIS_SPEED:
+            spec = ifx_spectrum_axis_calc_speed_axis(key->fft_type, key->fft_size, key->center_rf_freq_Hz,
+                                                     key->pulse_repet_time_s);
+            break;
+
+        case IFX_SPECTRUM_AXIS_SAMPLING_FREQ:
+            spec = ifx_spectrum_axis_calc_sampling_freq_axis(key->fft_type, key->fft_size, key->sampling_freq_Hz);
+            break;
+
+        case IFX_SPECTRUM_AXIS_BEAT_FREQ:
+            spec = ifx_spectrum_axis_calc_beat_freq_axis(key->fft_type, key->fft_size, key->samples_per_chirp,
+                                                         key->bandwidth_Hz, key->chirptime_s);
+            break;
+    }
+
+    // the axis functions set the error and return a zero step for invalid parameters
+    if (spec.value_bin_per_step == 0)
+        return nullptr;
+
+    const uint32_t num_bins = (key->fft_type == IFX_FFT_TYPE_R2C) ? key->fft_size / 2 : key->fft_size;
+    IFX_ERR_BRN_ARGUMENT(num_bins == 0);
+
+    auto* entry = static_cast<ifx_Spectrum_Axis_Entry_t*>(
+        ifx_mem_alloc(sizeof(ifx_Spectrum_Axis_Entry_t) + num_bins * sizeof(ifx_Float_t)));
+    IFX_ERR_BRN_MEMALLOC(entry);
+
+    auto* values = reinterpret_cast<ifx_Float_t*>(entry + 1);
+    for (uint32_t i = 0; i < num_bins; i++)
+        values[i] = spec.min_value + static_cast<ifx_Float_t>(i) * spec.value_bin_per_step;
+
+    entry->config = *key;
+    entry->table.spec = spec;
+    entry->table.num_bins = num_bins;
+    entry->table.values = values;
+    entry->users = 0;
+    entry->next = nullptr;
+
+    return entry;
+}
 
 /*
 ==============================================================================
@@ -221,3 +376,123 @@ ifx_Math_Axis_Spec_t ifx_spectrum_axis_calc_beat_freq_axis(const ifx_FFT_Type_t
 
     return beat_freq_axis_Hz;
 }
+
+//----------------------------------------------------------------------------
+
+const ifx_Spectrum_Axis_Table_t* ifx_spectrum_axis_acquire(const ifx_Spectrum_Axis_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->unit > IFX_SPECTRUM_AXIS_BEAT_FREQ);
+
+    ifx_Spectrum_Axis_Config_t key;
+    make_key(config, &key);
+
+    CACHE_LOCK();
+    for (ifx_Spectrum_Axis_Entry_t* entry = table_cache; entry != nullptr; entry = entry->next)
+    {
+        if (equal_key(&entry->config, &key))
+        {
+            entry->users++;
+            CACHE_UNLOCK();
+            return &entry->table;
+        }
+    }
+
+    ifx_Spectrum_Axis_Entry_t* entry = create_entry(&key);
+    if (entry != nullptr)
+    {
+        entry->users = 1;
+        entry->next = table_cache;
+        table_cache = entry;
+    }
+    CACHE_UNLOCK();
+
+    if (entry == nullptr)
+        return nullptr;
+
+    return &entry->table;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_spectrum_axis_release(const ifx_Spectrum_Axis_Table_t* table)
+{
+    if (table == nullptr)
+        return;
+
+    CACHE_LOCK();
+    for (ifx_Spectrum_Axis_Entry_t* entry = table_cache; entry != nullptr; entry = entry->next)
+    {
+        if (&entry->table == table)
+        {
+            if (entry->users > 0)
+                entry->users--;
+            break;
+        }
+    }
+    CACHE_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_spectrum_axis_clear_cache(void)
+{
+    CACHE_LOCK();
+    ifx_Spectrum_Axis_Entry_t** link = &table_cache;
+    while (*link != nullptr)
+    {
+        ifx_Spectrum_Axis_Entry_t* entry = *link;
+        if (entry->users == 0)
+        {
+            *link = entry->next;
+            ifx_mem_free(entry);
+        }
+        else
+            link = &entry->next;
+    }
+    CACHE_UNLOCK();
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_spectrum_axis_bins_to_values(const ifx_Spectrum_Axis_Table_t* table,
+                                      const uint32_t* bins,
+                                      uint32_t count,
+                                      ifx_Float_t* values)
+{
+    IFX_ERR_BRK_NULL(table);
+    if (count == 0)
+        return;
+    IFX_ERR_BRK_NULL(bins);
+    IFX_ERR_BRK_NULL(values);
+
+    const ifx_Float_t* lut = table->values;
+    const uint32_t num_bins = table->num_bins;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const uint32_t bin = bins[i];
+        IFX_ERR_BRK_COND(bin >= num_bins, IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS);
+        values[i] = lut[bin];
+    }
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_spectrum_axis_positions_to_values(const ifx_Spectrum_Axis_Table_t* table,
+                                           const ifx_Float_t* positions,
+                                           uint32_t count,
+                                           ifx_Float_t* values)
+{
+    IFX_ERR_BRK_NULL(table);
+    if (count == 0)
+        return;
+    IFX_ERR_BRK_NULL(positions);
+    IFX_ERR_BRK_NULL(values);
+
+    const ifx_Float_t offset = table->spec.min_value;
+    const ifx_Float_t step = table->spec.value_bin_per_step;
+
+    for (uint32_t i = 0; i < count; i++)
+        values[i] = offset + positions[i] * step;
+}
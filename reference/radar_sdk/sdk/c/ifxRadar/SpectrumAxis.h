@@ -67,6 +67,53 @@ extern "C"
 ==============================================================================
 */
 
+/**
+ * @brief Physical unit of the bins of a spectrum axis table.
+ */
+typedef enum
+{
+    IFX_SPECTRUM_AXIS_RANGE = 0,         /**< Range in meters, see \ref ifx_spectrum_axis_calc_range_axis.*/
+    IFX_SPECTRUM_AXIS_SPEED = 1,         /**< Speed in meters per second, see \ref ifx_spectrum_axis_calc_speed_axis.*/
+    IFX_SPECTRUM_AXIS_SAMPLING_FREQ = 2, /**< Frequency in Hz, see \ref ifx_spectrum_axis_calc_sampling_freq_axis.*/
+    IFX_SPECTRUM_AXIS_BEAT_FREQ = 3      /**< Beat frequency in Hz, see \ref ifx_spectrum_axis_calc_beat_freq_axis.*/
+} ifx_Spectrum_Axis_Unit_t;
+
+/**
+ * @brief Parameters of a spectrum axis table.
+ *
+ * Only the parameters of the axis function of the selected unit are used,
+ * the others are ignored:
+ * - \ref IFX_SPECTRUM_AXIS_RANGE: samples_per_chirp and bandwidth_Hz
+ * - \ref IFX_SPECTRUM_AXIS_SPEED: center_rf_freq_Hz and pulse_repet_time_s
+ * - \ref IFX_SPECTRUM_AXIS_SAMPLING_FREQ: sampling_freq_Hz
+ * - \ref IFX_SPECTRUM_AXIS_BEAT_FREQ: samples_per_chirp, bandwidth_Hz and chirptime_s
+ */
+typedef struct
+{
+    ifx_Spectrum_Axis_Unit_t unit;  /**< Unit of the bins.*/
+    ifx_FFT_Type_t fft_type;        /**< Real or complex input of the FFT.*/
+    uint32_t fft_size;              /**< Size of the FFT.*/
+    uint32_t samples_per_chirp;     /**< Length of input data used by FFT calculation.*/
+    ifx_Float_t bandwidth_Hz;       /**< Chirp bandwidth in Hz.*/
+    ifx_Float_t chirptime_s;        /**< Up-chirp time in seconds.*/
+    ifx_Float_t sampling_freq_Hz;   /**< Sampling frequency in Hz.*/
+    ifx_Float_t center_rf_freq_Hz;  /**< RF center frequency in Hz.*/
+    ifx_Float_t pulse_repet_time_s; /**< Pulse repetition time in seconds.*/
+} ifx_Spectrum_Axis_Config_t;
+
+/**
+ * @brief Physical value of each bin of a spectrum axis.
+ *
+ * Tables are returned by \ref ifx_spectrum_axis_acquire, shared by all users
+ * of the same configuration and must not be modified.
+ */
+typedef struct
+{
+    ifx_Math_Axis_Spec_t spec; /**< Axis as returned by the axis function of the unit.*/
+    uint32_t num_bins;         /**< Number of bins of the axis.*/
+    const ifx_Float_t* values; /**< Value of bin i is values[i] = spec.min_value + i * spec.value_bin_per_step.*/
+} ifx_Spectrum_Axis_Table_t;
+
 /*
 ==============================================================================
    4. FUNCTION PROTOTYPES
@@ -226,6 +273,73 @@ ifx_Math_Axis_Spec_t ifx_spectrum_axis_calc_beat_freq_axis(ifx_FFT_Type_t fft_ty
                                                            ifx_Float_t bandwidth_Hz,
                                                            ifx_Float_t chirptime_s);
 
+/**
+ * @brief Returns a shared table of the physical values of all bins of a spectrum axis.
+ *
+ * The table covers the bins of the axis computed by the axis function of the
+ * unit, i.e. fft_size/2 bins for \ref IFX_FFT_TYPE_R2C and fft_size bins for
+ * complex input. All users of the same configuration share one table, so the
+ * values are computed only once. Release the table with
+ * \ref ifx_spectrum_axis_release.
+ *
+ * This function is thread-safe.
+ *
+ * @param [in]     config    Parameters of the axis defined by \ref ifx_Spectrum_Axis_Config_t.
+ *
+ * @return Shared table or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+const ifx_Spectrum_Axis_Table_t* ifx_spectrum_axis_acquire(const ifx_Spectrum_Axis_Config_t* config);
+
+/**
+ * @brief Releases a table returned by \ref ifx_spectrum_axis_acquire.
+ *
+ * @param [in]     table     Spectrum axis table, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_spectrum_axis_release(const ifx_Spectrum_Axis_Table_t* table);
+
+/**
+ * @brief Frees all cached spectrum axis tables no longer acquired.
+ */
+IFX_DLL_PUBLIC
+void ifx_spectrum_axis_clear_cache(void);
+
+/**
+ * @brief Converts bin indices to physical values.
+ *
+ * Looks up values[i] = table->values[bins[i]] for i < count. If a bin is
+ * outside of the table, the conversion stops at this bin with
+ * IFX_ERROR_ARGUMENT_OUT_OF_BOUNDS.
+ *
+ * @param [in]     table     Spectrum axis table.
+ * @param [in]     bins      Array of count bin indices, e.g. \ref ifx_Peak_Search_Result_t::index.
+ * @param [in]     count     Number of bins to convert.
+ * @param [out]    values    Array of count physical values.
+ */
+IFX_DLL_PUBLIC
+void ifx_spectrum_axis_bins_to_values(const ifx_Spectrum_Axis_Table_t* table,
+                                      const uint32_t* bins,
+                                      uint32_t count,
+                                      ifx_Float_t* values);
+
+/**
+ * @brief Converts fractional bin positions to physical values.
+ *
+ * Computes values[i] = spec.min_value + positions[i] * spec.value_bin_per_step
+ * for i < count. Positions outside of the table are extrapolated.
+ *
+ * @param [in]     table     Spectrum axis table.
+ * @param [in]     positions Array of count positions in bins, e.g. \ref ifx_Peak_Search_Result_t::position.
+ * @param [in]     count     Number of positions to convert.
+ * @param [out]    values    Array of count physical values.
+ */
+IFX_DLL_PUBLIC
+void ifx_spectrum_axis_positions_to_values(const ifx_Spectrum_Axis_Table_t* table,
+                                           const ifx_Float_t* positions,
+                                           uint32_t count,
+                                           ifx_Float_t* values);
+
 /**
  * @}
  */
@@ -0,0 +1,691 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ifxBase/Defines.h"
+#include "ifxBase/Error.h"
+#include "ifxBase/Mem.h"
+
+#include "ifxRadar/Tracker.h"
+
+/*
+==============================================================================
+   2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+/* A grid cell is identified by its column in the upper and its row in the
+ * lower 16 bits, see DBSCAN.c. Cell coordinates are offset by 0x8000 as
+ * positions may be negative.
+ */
+#define CELL_KEY(cx, cy) (((uint32_t)(cx) << 16) | (uint32_t)(cy))
+#define CELL_ENTRY(key, idx) (((uint64_t)(key) << 16) | (uint64_t)(idx))
+#define ENTRY_KEY(entry) ((uint32_t)((entry) >> 16))
+#define ENTRY_INDEX(entry) ((uint16_t)((entry)&0xFFFF))
+
+// gated measurements kept per track on average, bounds the edges of the assignment
+#define EDGES_PER_TRACK 8
+
+/* Minimum bid increment of the auction relative to gate_m^2. The total
+ * benefit of the assignment is within num_tracks times this of the optimum.
+ */
+#define AUCTION_EPSILON ((ifx_Float_t)1e-3)
+
+#define NO_MEASUREMENT (-1)
+
+/*
+==============================================================================
+   3. LOCAL TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Defines the structure for the tracker.
+ *        Use type ifx_Tracker_t for this struct.
+ *
+ * Tracks are stored as arrays with the active tracks at the front; a deleted
+ * track is replaced by the last one.
+ */
+struct ifx_Tracker_s
+{
+    ifx_Tracker_Config_t config; /**< Settings of the tracker.*/
+    uint32_t next_id;            /**< Id of the next new track.*/
+
+    uint32_t num_tracks; /**< Number of active tracks.*/
+    uint32_t* id;        /**< Ids of the tracks.*/
+    ifx_Float_t* x;      /**< x positions.*/
+    ifx_Float_t* y;      /**< y positions.*/
+    ifx_Float_t* vx;     /**< Velocities along x.*/
+    ifx_Float_t* vy;     /**< Velocities along y.*/
+    ifx_Float_t* p_pp;   /**< Position variance, the same for both axes.*/
+    ifx_Float_t* p_pv;   /**< Covariance of position and velocity.*/
+    ifx_Float_t* p_vv;   /**< Velocity variance.*/
+    uint32_t* age;       /**< Frames since creation.*/
+    uint32_t* hits;      /**< Updates since creation.*/
+    uint32_t* misses;    /**< Consecutive frames without update.*/
+
+    uint32_t num_measurements; /**< Measurements of the current frame.*/
+    ifx_Float_t* mx;           /**< x positions of the measurements.*/
+    ifx_Float_t* my;           /**< y positions of the measurements.*/
+    ifx_Float_t* mvx;          /**< Radial velocities of the measurements projected on x.*/
+    ifx_Float_t* mvy;          /**< Radial velocities of the measurements projected on y.*/
+    uint32_t* count;           /**< Points merged into a measurement.*/
+    uint16_t* slot;            /**< Measurement of each cluster id plus one, max_measurements+1 elements.*/
+    uint64_t* grid;            /**< Cell key and index of the measurements, sorted.*/
+
+    uint32_t* edge_begin;  /**< First edge of each track, max_tracks+1 elements.*/
+    uint16_t* edge_meas;   /**< Measurement of each edge.*/
+    ifx_Float_t* benefit;  /**< Benefit of each edge.*/
+    uint32_t max_edges;    /**< Capacity of the edges.*/
+    ifx_Float_t* price;    /**< Auction price of each measurement.*/
+    int32_t* owner;        /**< Track assigned to each measurement or -1.*/
+    int32_t* assigned;     /**< Measurement assigned to each track or -1.*/
+    uint32_t* queue;       /**< Unassigned tracks with bids left, a ring buffer.*/
+};
+
+/*
+==============================================================================
+   4. LOCAL DATA
+==============================================================================
+*/
+
+/*
+==============================================================================
+   5. LOCAL FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+static int compare_entries(const void* a,
+                           const void* b);
+
+static uint32_t cell_of(ifx_Float_t position,
+                        ifx_Float_t cell);
+
+static uint32_t grid_lower_bound(const uint64_t* grid,
+                                 uint32_t count,
+                                 uint32_t key);
+
+static void collect_measurements(ifx_Tracker_t* h,
+                                 const ifx_Point_Cloud_t* cloud);
+
+static void predict(ifx_Tracker_t* h,
+                    ifx_Float_t dt_s);
+
+static void gate(ifx_Tracker_t* h);
+
+static void assign(ifx_Tracker_t* h);
+
+static void update(ifx_Tracker_t* h);
+
+static void remove_track(ifx_Tracker_t* h,
+                         uint32_t t);
+
+static void start_tracks(ifx_Tracker_t* h);
+
+/*
+==============================================================================
+   6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static int compare_entries(const void* a,
+                           const void* b)
+{
+    const uint64_t ea = *(const uint64_t*)a;
+    const uint64_t eb = *(const uint64_t*)b;
+
+    return (ea > eb) - (ea < eb);
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t cell_of(ifx_Float_t position,
+                        ifx_Float_t cell)
+{
+    const ifx_Float_t c = floorf(position / cell) + 0x8000;
+    return (c < 0) ? 0 : (c > 0xFFFF) ? 0xFFFF : (uint32_t)c;
+}
+
+//----------------------------------------------------------------------------
+
+static uint32_t grid_lower_bound(const uint64_t* grid,
+                                 uint32_t count,
+                                 uint32_t key)
+{
+    uint32_t first = 0;
+
+    while (count > 0)
+    {
+        const uint32_t half = count / 2;
+        if (ENTRY_KEY(grid[first + half]) < key)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Converts the points (or the clusters) of the cloud to Cartesian measurements */
+static void collect_measurements(ifx_Tracker_t* h,
+                                 const ifx_Point_Cloud_t* cloud)
+{
+    const uint32_t max_measurements = h->config.max_measurements;
+    uint32_t n = 0;
+
+    if (h->config.use_clusters)
+        memset(h->slot, 0, (max_measurements + 1) * sizeof(uint16_t));
+
+    for (uint32_t i = 0; i < cloud->num_points; i++)
+    {
+        uint32_t m = n;
+        if (h->config.use_clusters)
+        {
+            const uint16_t cluster = cloud->cluster_id[i];
+            if (cluster == 0 || cluster > max_measurements)
+                continue;
+
+            if (h->slot[cluster] == 0)
+            {
+                if (n == max_measurements)
+                    continue;
+                h->slot[cluster] = (uint16_t)(n + 1);
+            }
+            m = h->slot[cluster] - 1U;
+        }
+        else if (n == max_measurements)
+        {
+            break;
+        }
+
+        if (m == n)
+        {
+            h->mx[m] = h->my[m] = h->mvx[m] = h->mvy[m] = 0;
+            h->count[m] = 0;
+            n++;
+        }
+
+        const ifx_Float_t angle = cloud->angle_deg[i] * (ifx_Float_t)(IFX_PI / 180);
+        const ifx_Float_t s = sinf(angle);
+        const ifx_Float_t c = cosf(angle);
+
+        h->mx[m] += cloud->range_m[i] * s;
+        h->my[m] += cloud->range_m[i] * c;
+        h->mvx[m] += cloud->velocity_m_s[i] * s;
+        h->mvy[m] += cloud->velocity_m_s[i] * c;
+        h->count[m]++;
+    }
+
+    for (uint32_t m = 0; m < n; m++)
+    {
+        if (h->count[m] > 1)
+        {
+            const ifx_Float_t scale = 1.0f / (ifx_Float_t)h->count[m];
+            h->mx[m] *= scale;
+            h->my[m] *= scale;
+            h->mvx[m] *= scale;
+            h->mvy[m] *= scale;
+        }
+    }
+
+    h->num_measurements = n;
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Constant velocity prediction of all tracks */
+static void predict(ifx_Tracker_t* h,
+                    ifx_Float_t dt_s)
+{
+    const ifx_Float_t dt = dt_s;
+    const ifx_Float_t q = h->config.acceleration_sigma_m_s2 * h->config.acceleration_sigma_m_s2;
+    const ifx_Float_t q_pp = q * dt * dt * dt * dt / 4;
+    const ifx_Float_t q_pv = q * dt * dt * dt / 2;
+    const ifx_Float_t q_vv = q * dt * dt;
+    const uint32_t n = h->num_tracks;
+
+    for (uint32_t t = 0; t < n; t++)
+    {
+        h->x[t] += h->vx[t] * dt;
+        h->y[t] += h->vy[t] * dt;
+    }
+
+    for (uint32_t t = 0; t < n; t++)
+    {
+        const ifx_Float_t p_pv = h->p_pv[t];
+        const ifx_Float_t p_vv = h->p_vv[t];
+
+        h->p_pp[t] += 2 * dt * p_pv + dt * dt * p_vv + q_pp;
+        h->p_pv[t] = p_pv + dt * p_vv + q_pv;
+        h->p_vv[t] = p_vv + q_vv;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Collects the measurements within the gate of every track */
+static void gate(ifx_Tracker_t* h)
+{
+    const ifx_Float_t cell = h->config.gate_m;
+    const ifx_Float_t gate2 = cell * cell;
+    const uint32_t num_measurements = h->num_measurements;
+    uint32_t e = 0;
+
+    for (uint32_t m = 0; m < num_measurements; m++)
+    {
+        const uint32_t key = CELL_KEY(cell_of(h->mx[m], cell), cell_of(h->my[m], cell));
+        h->grid[m] = CELL_ENTRY(key, m);
+    }
+
+    qsort(h->grid, num_measurements, sizeof(uint64_t), compare_entries);
+
+    for (uint32_t t = 0; t < h->num_tracks; t++)
+    {
+        h->edge_begin[t] = e;
+
+        if (num_measurements == 0)
+            continue;
+
+        // cells are gate_m wide, so all measurements within the gate are in the 3x3 cells around
+        const int32_t cx = (int32_t)cell_of(h->x[t], cell);
+        const int32_t cy = (int32_t)cell_of(h->y[t], cell);
+
+        for (int32_t col = MAX(cx - 1, 0); col <= MIN(cx + 1, 0xFFFF); col++)
+        {
+            // the rows cy-1 to cy+1 of a column are adjacent in the sorted entries
+            const uint32_t last_key = CELL_KEY(col, MIN(cy + 1, 0xFFFF));
+
+            for (uint32_t g = grid_lower_bound(h->grid, num_measurements, CELL_KEY(col, MAX(cy - 1, 0)));
+                 g < num_measurements && ENTRY_KEY(h->grid[g]) <= last_key && e < h->max_edges;
+                 g++)
+            {
+                const uint16_t m = ENTRY_INDEX(h->grid[g]);
+                const ifx_Float_t dx = h->mx[m] - h->x[t];
+                const ifx_Float_t dy = h->my[m] - h->y[t];
+                const ifx_Float_t d2 = dx * dx + dy * dy;
+
+                if (d2 < gate2)
+                {
+                    h->edge_meas[e] = m;
+                    h->benefit[e] = gate2 - d2;
+                    e++;
+                }
+            }
+        }
+    }
+
+    h->edge_begin[h->num_tracks] = e;
+}
+
+//----------------------------------------------------------------------------
+
+/**
+ * @brief Assigns measurements to tracks by an auction on the gated pairs.
+ *
+ * An unassigned track bids for the measurement with the highest benefit
+ * minus price, raising its price by the margin to the second best option
+ * plus epsilon. Staying unassigned is an option worth 0, so prices never
+ * exceed the benefits and every track either gets a measurement or drops
+ * out once all its measurements became too expensive.
+ */
+static void assign(ifx_Tracker_t* h)
+{
+    const uint32_t num_tracks = h->num_tracks;
+    const ifx_Float_t epsilon = AUCTION_EPSILON * h->config.gate_m * h->config.gate_m;
+    uint32_t head = 0;
+    uint32_t size = 0;
+
+    for (uint32_t m = 0; m < h->num_measurements; m++)
+    {
+        h->price[m] = 0;
+        h->owner[m] = NO_MEASUREMENT;
+    }
+
+    for (uint32_t t = 0; t < num_tracks; t++)
+    {
+        h->assigned[t] = NO_MEASUREMENT;
+        if (h->edge_begin[t + 1] > h->edge_begin[t])
+            h->queue[size++] = t;
+    }
+
+    while (size > 0)
+    {
+        const uint32_t t = h->queue[head];
+        head = (head + 1) % num_tracks;
+        size--;
+
+        int32_t best = NO_MEASUREMENT;
+        ifx_Float_t best_value = 0;
+        ifx_Float_t second_value = 0;
+
+        for (uint32_t e = h->edge_begin[t]; e < h->edge_begin[t + 1]; e++)
+        {
+            const ifx_Float_t value = h->benefit[e] - h->price[h->edge_meas[e]];
+            if (value > best_value)
+            {
+                second_value = best_value;
+                best_value = value;
+                best = h->edge_meas[e];
+            }
+            else if (value > second_value)
+            {
+                second_value = value;
+            }
+        }
+
+        if (best == NO_MEASUREMENT)
+            continue;
+
+        h->price[best] += best_value - second_value + epsilon;
+
+        const int32_t previous = h->owner[best];
+        if (previous != NO_MEASUREMENT)
+        {
+            h->assigned[previous] = NO_MEASUREMENT;
+            h->queue[(head + size) % num_tracks] = (uint32_t)previous;
+            size++;
+        }
+
+        h->owner[best] = (int32_t)t;
+        h->assigned[t] = best;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Kalman update of the tracks with a measurement */
+static void update(ifx_Tracker_t* h)
+{
+    const ifx_Float_t r = h->config.measurement_sigma_m * h->config.measurement_sigma_m;
+
+    for (uint32_t t = 0; t < h->num_tracks; t++)
+    {
+        h->age[t]++;
+
+        const int32_t m = h->assigned[t];
+        if (m == NO_MEASUREMENT)
+        {
+            h->misses[t]++;
+            continue;
+        }
+
+        const ifx_Float_t p_pp = h->p_pp[t];
+        const ifx_Float_t p_pv = h->p_pv[t];
+        const ifx_Float_t k_p = p_pp / (p_pp + r);
+        const ifx_Float_t k_v = p_pv / (p_pp + r);
+        const ifx_Float_t dx = h->mx[m] - h->x[t];
+        const ifx_Float_t dy = h->my[m] - h->y[t];
+
+        h->x[t] += k_p * dx;
+        h->y[t] += k_p * dy;
+        h->vx[t] += k_v * dx;
+        h->vy[t] += k_v * dy;
+        h->p_pp[t] = (1 - k_p) * p_pp;
+        h->p_pv[t] = (1 - k_p) * p_pv;
+        h->p_vv[t] -= k_v * p_pv;
+        h->hits[t]++;
+        h->misses[t] = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+
+static void remove_track(ifx_Tracker_t* h,
+                         uint32_t t)
+{
+    const uint32_t last = --h->num_tracks;
+
+    h->id[t] = h->id[last];
+    h->x[t] = h->x[last];
+    h->y[t] = h->y[last];
+    h->vx[t] = h->vx[last];
+    h->vy[t] = h->vy[last];
+    h->p_pp[t] = h->p_pp[last];
+    h->p_pv[t] = h->p_pv[last];
+    h->p_vv[t] = h->p_vv[last];
+    h->age[t] = h->age[last];
+    h->hits[t] = h->hits[last];
+    h->misses[t] = h->misses[last];
+}
+
+//----------------------------------------------------------------------------
+
+/** @brief Starts tentative tracks at the measurements not assigned to any track */
+static void start_tracks(ifx_Tracker_t* h)
+{
+    const ifx_Float_t r = h->config.measurement_sigma_m * h->config.measurement_sigma_m;
+    const ifx_Float_t v = h->config.velocity_sigma_m_s * h->config.velocity_sigma_m_s;
+
+    for (uint32_t m = 0; m < h->num_measurements && h->num_tracks < h->config.max_tracks; m++)
+    {
+        if (h->owner[m] != NO_MEASUREMENT)
+            continue;
+
+        const uint32_t t = h->num_tracks++;
+
+        h->id[t] = h->next_id++;
+        h->x[t] = h->mx[m];
+        h->y[t] = h->my[m];
+        h->vx[t] = h->mvx[m];
+        h->vy[t] = h->mvy[m];
+        h->p_pp[t] = r;
+        h->p_pv[t] = 0;
+        h->p_vv[t] = v;
+        h->age[t] = 0;
+        h->hits[t] = 1;
+        h->misses[t] = 0;
+    }
+}
+
+/*
+==============================================================================
+   7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+ifx_Tracker_t* ifx_tracker_create(const ifx_Tracker_Config_t* config)
+{
+    IFX_ERR_BRN_NULL(config);
+    IFX_ERR_BRN_ARGUMENT(config->max_tracks == 0 || config->max_measurements == 0);
+    // measurement indices are kept in 16 bits like the detections of DBSCAN
+    IFX_ERR_BRN_ARGUMENT(config->max_measurements > UINT16_MAX);
+    IFX_ERR_BRN_ARGUMENT(config->gate_m <= 0 || config->measurement_sigma_m <= 0);
+    IFX_ERR_BRN_ARGUMENT(config->acceleration_sigma_m_s2 < 0 || config->velocity_sigma_m_s < 0);
+
+    ifx_Tracker_t* h = ifx_mem_calloc(1, sizeof(struct ifx_Tracker_s));
+    IFX_ERR_BRN_MEMALLOC(h);
+
+    h->config = *config;
+    h->next_id = 1;
+
+    const size_t t = config->max_tracks;
+    const size_t m = config->max_measurements;
+
+    h->id = ifx_mem_alloc(t * sizeof(uint32_t));
+    h->x = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->y = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->vx = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->vy = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->p_pp = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->p_pv = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->p_vv = ifx_mem_alloc(t * sizeof(ifx_Float_t));
+    h->age = ifx_mem_alloc(t * sizeof(uint32_t));
+    h->hits = ifx_mem_alloc(t * sizeof(uint32_t));
+    h->misses = ifx_mem_alloc(t * sizeof(uint32_t));
+
+    h->mx = ifx_mem_alloc(m * sizeof(ifx_Float_t));
+    h->my = ifx_mem_alloc(m * sizeof(ifx_Float_t));
+    h->mvx = ifx_mem_alloc(m * sizeof(ifx_Float_t));
+    h->mvy = ifx_mem_alloc(m * sizeof(ifx_Float_t));
+    h->count = ifx_mem_alloc(m * sizeof(uint32_t));
+    h->slot = ifx_mem_alloc((m + 1) * sizeof(uint16_t));
+    h->grid = ifx_mem_alloc(m * sizeof(uint64_t));
+
+    h->max_edges = (uint32_t)(t * EDGES_PER_TRACK);
+    h->edge_begin = ifx_mem_alloc((t + 1) * sizeof(uint32_t));
+    h->edge_meas = ifx_mem_alloc(h->max_edges * sizeof(uint16_t));
+    h->benefit = ifx_mem_alloc(h->max_edges * sizeof(ifx_Float_t));
+    h->price = ifx_mem_alloc(m * sizeof(ifx_Float_t));
+    h->owner = ifx_mem_alloc(m * sizeof(int32_t));
+    h->assigned = ifx_mem_alloc(t * sizeof(int32_t));
+    h->queue = ifx_mem_alloc(t * sizeof(uint32_t));
+
+    if (!h->id || !h->x || !h->y || !h->vx || !h->vy || !h->p_pp || !h->p_pv || !h->p_vv || !h->age || !h->hits
+        || !h->misses || !h->mx || !h->my || !h->mvx || !h->mvy || !h->count || !h->slot || !h->grid
+        || !h->edge_begin || !h->edge_meas || !h->benefit || !h->price || !h->owner || !h->assigned || !h->queue)
+    {
+        ifx_tracker_destroy(h);
+        ifx_error_set(IFX_ERROR_MEMORY_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    return h;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_destroy(ifx_Tracker_t* handle)
+{
+    if (handle == NULL)
+    {
+        return;
+    }
+
+    ifx_mem_free(handle->id);
+    ifx_mem_free(handle->x);
+    ifx_mem_free(handle->y);
+    ifx_mem_free(handle->vx);
+    ifx_mem_free(handle->vy);
+    ifx_mem_free(handle->p_pp);
+    ifx_mem_free(handle->p_pv);
+    ifx_mem_free(handle->p_vv);
+    ifx_mem_free(handle->age);
+    ifx_mem_free(handle->hits);
+    ifx_mem_free(handle->misses);
+    ifx_mem_free(handle->mx);
+    ifx_mem_free(handle->my);
+    ifx_mem_free(handle->mvx);
+    ifx_mem_free(handle->mvy);
+    ifx_mem_free(handle->count);
+    ifx_mem_free(handle->slot);
+    ifx_mem_free(handle->grid);
+    ifx_mem_free(handle->edge_begin);
+    ifx_mem_free(handle->edge_meas);
+    ifx_mem_free(handle->benefit);
+    ifx_mem_free(handle->price);
+    ifx_mem_free(handle->owner);
+    ifx_mem_free(handle->assigned);
+    ifx_mem_free(handle->queue);
+    ifx_mem_free(handle);
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_run(ifx_Tracker_t* handle,
+                     const ifx_Point_Cloud_t* cloud,
+                     ifx_Float_t dt_s)
+{
+    IFX_ERR_BRK_NULL(handle);
+    IFX_ERR_BRK_NULL(cloud);
+    IFX_ERR_BRK_ARGUMENT(dt_s < 0);
+
+    collect_measurements(handle, cloud);
+    predict(handle, dt_s);
+    gate(handle);
+    assign(handle);
+    update(handle);
+
+    for (uint32_t t = 0; t < handle->num_tracks;)
+    {
+        const bool confirmed = handle->hits[t] >= handle->config.confirm_hits;
+        if (handle->misses[t] > (confirmed ? handle->config.max_misses : 0))
+            remove_track(handle, t);  // the last track moved to t is checked next
+        else
+            t++;
+    }
+
+    start_tracks(handle);
+}
+
+//----------------------------------------------------------------------------
+
+uint32_t ifx_tracker_get_tracks(const ifx_Tracker_t* handle,
+                                ifx_Track_t* tracks,
+                                uint32_t max_tracks,
+                                bool confirmed_only)
+{
+    IFX_ERR_BRV_NULL(handle, 0);
+    IFX_ERR_BRV_NULL(tracks, 0);
+
+    uint32_t n = 0;
+    for (uint32_t t = 0; t < handle->num_tracks && n < max_tracks; t++)
+    {
+        const bool confirmed = handle->hits[t] >= handle->config.confirm_hits;
+        if (confirmed_only && !confirmed)
+            continue;
+
+        ifx_Track_t* track = &tracks[n++];
+        track->id = handle->id[t];
+        track->x_m = handle->x[t];
+        track->y_m = handle->y[t];
+        track->vx_m_s = handle->vx[t];
+        track->vy_m_s = handle->vy[t];
+        track->sigma_m = sqrtf(handle->p_pp[t]);
+        track->age = handle->age[t];
+        track->misses = handle->misses[t];
+        track->confirmed = confirmed;
+    }
+
+    return n;
+}
+
+//----------------------------------------------------------------------------
+
+void ifx_tracker_reset(ifx_Tracker_t* handle)
+{
+    IFX_ERR_BRK_NULL(handle);
+
+    handle->num_tracks = 0;
+}
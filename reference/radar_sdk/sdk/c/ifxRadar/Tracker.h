@@ -0,0 +1,213 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Tracker.h
+ *
+ * \brief \copybrief gr_tracker
+ *
+ * For details refer to \ref gr_tracker
+ */
+
+#ifndef IFX_RADAR_TRACKER_H
+#define IFX_RADAR_TRACKER_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Types.h"
+
+#include "ifxRadar/PointCloud.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*
+==============================================================================
+   2. DEFINITIONS
+==============================================================================
+*/
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief A handle for an instance of the tracker, see Tracker.h.
+ */
+typedef struct ifx_Tracker_s ifx_Tracker_t;
+
+/**
+ * @brief Defines the settings of the tracker.
+ */
+typedef struct
+{
+    uint32_t max_tracks;                 /**< Maximum number of tracks, confirmed and tentative.*/
+    uint32_t max_measurements;           /**< Maximum number of measurements per frame, at most 65535.
+                                              Further points or clusters are ignored.*/
+    bool use_clusters;                   /**< If true the measurements are the centroids of the clusters
+                                              of the point cloud and points without cluster are ignored,
+                                              otherwise every point is a measurement.*/
+    ifx_Float_t gate_m;                  /**< Maximum distance of a measurement to the predicted position of
+                                              a track it is assigned to.*/
+    ifx_Float_t measurement_sigma_m;     /**< Standard deviation of the measured positions.*/
+    ifx_Float_t acceleration_sigma_m_s2; /**< Standard deviation of the acceleration of the targets.*/
+    ifx_Float_t velocity_sigma_m_s;      /**< Standard deviation of the velocity of new tracks.*/
+    uint32_t confirm_hits;               /**< A tentative track is confirmed after this many updates.*/
+    uint32_t max_misses;                 /**< A confirmed track is deleted after more than this many frames
+                                              without measurement, a tentative one after the first.*/
+} ifx_Tracker_Config_t;
+
+/**
+ * @brief State of a track.
+ *
+ * Positions are Cartesian with the sensor in the origin, y along the
+ * boresight and x = range * sin(angle).
+ */
+typedef struct
+{
+    uint32_t id;         /**< Unique id of the track, starting at 1.*/
+    ifx_Float_t x_m;     /**< Estimated x position.*/
+    ifx_Float_t y_m;     /**< Estimated y position.*/
+    ifx_Float_t vx_m_s;  /**< Estimated velocity along x.*/
+    ifx_Float_t vy_m_s;  /**< Estimated velocity along y.*/
+    ifx_Float_t sigma_m; /**< Standard deviation of the estimated position along each axis.*/
+    uint32_t age;        /**< Frames since the track was created.*/
+    uint32_t misses;     /**< Consecutive frames without measurement.*/
+    bool confirmed;      /**< False while the track is tentative.*/
+} ifx_Track_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/** @addtogroup gr_cat_Radar
+ * @{
+ */
+
+/** @defgroup gr_tracker Tracker
+ * @brief Multi-target tracker fed by point clouds
+ *
+ * Each track is a constant velocity Kalman filter in x and y. Both axes see
+ * the same motion model and the same measurement noise, so they share one
+ * 2x2 covariance and all tracks are predicted and updated in tight loops over
+ * arrays of track states.
+ *
+ * Every frame the tracks are predicted, the measurements are sorted into a
+ * grid of gate_m wide cells and every track only looks at the 3x3 cells
+ * around its predicted position. The track and measurement pairs within the
+ * gate form a sparse assignment problem which is solved by an auction: a
+ * pair is worth gate_m^2 minus the squared distance, a track may stay
+ * unassigned. The cost per frame grows with the number of tracks times the
+ * measurements near a track instead of the number of tracks times all
+ * measurements.
+ *
+ * Measurements not assigned to a track start tentative tracks. All memory
+ * is allocated in \ref ifx_tracker_create.
+ *
+ * @{
+ */
+
+/**
+ * @brief Creates a tracker.
+ *
+ * @param [in]     config    Settings defined by \ref ifx_Tracker_Config_t.
+ *
+ * @return Handle to the newly created instance or NULL in case of failure.
+ */
+IFX_DLL_PUBLIC
+ifx_Tracker_t* ifx_tracker_create(const ifx_Tracker_Config_t* config);
+
+/**
+ * @brief Destroys a tracker.
+ *
+ * @param [in]     handle    Handle to the tracker, may be NULL.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_destroy(ifx_Tracker_t* handle);
+
+/**
+ * @brief Updates the tracks with the point cloud of a frame.
+ *
+ * @param [in]     handle    Handle to the tracker.
+ * @param [in]     cloud     Points of the frame, see \ref ifx_point_detector_run.
+ * @param [in]     dt_s      Time since the previous frame in seconds.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_run(ifx_Tracker_t* handle,
+                     const ifx_Point_Cloud_t* cloud,
+                     ifx_Float_t dt_s);
+
+/**
+ * @brief Returns the tracks.
+ *
+ * @param [in]     handle    Handle to the tracker.
+ * @param [out]    tracks    Array of max_tracks elements receiving the tracks.
+ * @param [in]     max_tracks Capacity of tracks.
+ * @param [in]     confirmed_only If true tentative tracks are skipped.
+ *
+ * @return Number of tracks written.
+ */
+IFX_DLL_PUBLIC
+uint32_t ifx_tracker_get_tracks(const ifx_Tracker_t* handle,
+                                ifx_Track_t* tracks,
+                                uint32_t max_tracks,
+                                bool confirmed_only);
+
+/**
+ * @brief Deletes all tracks.
+ *
+ * @param [in]     handle    Handle to the tracker.
+ */
+IFX_DLL_PUBLIC
+void ifx_tracker_reset(ifx_Tracker_t* handle);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif /* IFX_RADAR_TRACKER_H */
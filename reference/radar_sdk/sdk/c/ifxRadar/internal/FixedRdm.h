@@ -0,0 +1,123 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file FixedRdm.h
+ *
+ * @brief Range Doppler map stages specialized for compile-time frame geometries.
+ *
+ * A range Doppler map handle whose configuration matches a registered
+ * specialization (see FixedRdm.cpp) processes frames with an instance of
+ * ifx::FixedRdm instead of the generic matrices. The functions mirror the
+ * static range_fft and doppler_fft stages of RangeDopplerMap.c and do not
+ * validate their arguments.
+ */
+
+#ifndef IFX_RADAR_FIXED_RDM_INTERNAL_H
+#define IFX_RADAR_FIXED_RDM_INTERNAL_H
+
+/*
+==============================================================================
+   1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Matrix.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+#include "ifxRadar/RangeDopplerMap.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+
+/*
+==============================================================================
+   3. TYPES
+==============================================================================
+*/
+
+/**
+ * @brief Handle of a specialized range Doppler processing instance.
+ */
+typedef struct ifx_RDM_Fixed_s ifx_RDM_Fixed_t;
+
+/*
+==============================================================================
+   4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+/**
+ * @brief Creates a specialized instance for a range Doppler map configuration.
+ *
+ * A specialization is used if the range FFT is real, both windows are as
+ * long as their FFTs (no zero padding) and the number of chirps and samples
+ * per chirp match a registered specialization.
+ *
+ * @param [in]     config    Range Doppler map configuration.
+ *
+ * @return Handle or NULL. NULL without error means that no specialization
+ *         matches config.
+ */
+ifx_RDM_Fixed_t* ifx_rdm_fixed_create(const ifx_RDM_Config_t* config);
+
+/**
+ * @brief Destroys a specialized instance, NULL is ignored.
+ */
+void ifx_rdm_fixed_destroy(ifx_RDM_Fixed_t* handle);
+
+/**
+ * @brief Range FFT of all chirps of input (chirps x samples).
+ */
+void ifx_rdm_fixed_range_fft(ifx_RDM_Fixed_t* handle, const ifx_Matrix_R_t* input,
+                             const ifx_Vector_R_t* window, bool mean_removal);
+
+/**
+ * @brief Doppler FFT of a range bin after \ref ifx_rdm_fixed_range_fft.
+ *
+ * @return Spectrum before the FFT shift, valid until the next call.
+ */
+const ifx_Complex_t* ifx_rdm_fixed_doppler_fft(ifx_RDM_Fixed_t* handle, uint32_t range_bin,
+                                               const ifx_Vector_R_t* window, bool mean_removal);
+
+/**
+ * @brief Squared norm of the spectrum returned by the last \ref ifx_rdm_fixed_doppler_fft.
+ */
+const ifx_Float_t* ifx_rdm_fixed_doppler_abs2(ifx_RDM_Fixed_t* handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // IFX_RADAR_FIXED_RDM_INTERNAL_H
@@ -0,0 +1,206 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+#ifndef IFX_RADAR_FIXED_RDM_HPP
+#define IFX_RADAR_FIXED_RDM_HPP
+
+#include "ifxAlgo/internal/Unchecked.h"
+#include "ifxBase/Complex.h"
+#include "ifxBase/Mem.h"
+#include "ifxBase/Types.h"
+#include "ifxBase/Vector.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ifx {
+
+/**
+ * @brief Range Doppler processing of one RX antenna with compile-time frame geometry
+ *
+ * Counterpart of the range and Doppler stages of the range Doppler map for a
+ * fixed number of chirps and samples per chirp. All loops have compile-time
+ * bounds, so the compiler unrolls and vectorizes them, and all intermediate
+ * results live in std::array members, so processing a frame does not touch
+ * the heap. The FFTs themselves run on the FFT handles created by init(),
+ * whose plans come from the plan cache.
+ *
+ * The pre-processing matches the batch FFTs (mean over the window length,
+ * then subtraction and windowing), so the results are identical to the
+ * generic implementation. In addition, the transpose between range and
+ * Doppler FFT is fused into the pre-processing of the Doppler FFT.
+ *
+ * Objects are large and require IFX_MEMORY_ALIGNMENT, allocate them with
+ * ifx_mem_aligned_alloc and placement new.
+ */
+template <uint32_t NumChirps, uint32_t NumSamples>
+class FixedRdm
+{
+    static_assert(NumSamples >= 2 && NumSamples % 2 == 0, "FixedRdm requires an even number of samples");
+    static_assert(NumChirps >= 2 && NumChirps % 2 == 0, "FixedRdm requires an even number of chirps");
+
+public:
+    static constexpr uint32_t num_chirps = NumChirps;
+    static constexpr uint32_t num_samples = NumSamples;
+    static constexpr uint32_t num_range_bins = NumSamples / 2;
+
+    FixedRdm() = default;
+    FixedRdm(const FixedRdm&) = delete;
+    FixedRdm& operator=(const FixedRdm&) = delete;
+
+    ~FixedRdm()
+    {
+        ifx_fft_destroy(m_range_fft);
+        ifx_fft_destroy(m_doppler_fft);
+    }
+
+    /** @brief Creates the FFT handles, returns false on failure (error is set). */
+    bool init()
+    {
+        m_range_fft = ifx_fft_create(IFX_FFT_TYPE_R2C, NumSamples);
+        if (m_range_fft == nullptr)
+            return false;
+
+        m_doppler_fft = ifx_fft_create(IFX_FFT_TYPE_C2C, NumChirps);
+        return m_doppler_fft != nullptr;
+    }
+
+    /**
+     * @brief Range FFT of all chirps
+     *
+     * Chirp c starts at input[c * chirp_stride], its samples are
+     * sample_stride apart. window has NumSamples elements.
+     */
+    void range_fft(const ifx_Float_t* input, size_t chirp_stride, size_t sample_stride,
+                   const ifx_Float_t* window, bool mean_removal)
+    {
+        for (uint32_t c = 0; c < NumChirps; c++)
+        {
+            const ifx_Float_t* chirp = input + c * chirp_stride;
+            if (sample_stride == 1)
+                preprocess_chirp<1>(chirp, 1, window, mean_removal);
+            else
+                preprocess_chirp<0>(chirp, sample_stride, window, mean_removal);
+
+            ifx_Vector_R_t in;
+            ifx_Vector_C_t out;
+            ifx_vec_rawview_r(&in, m_chirp.data(), NumSamples, 1);
+            ifx_vec_rawview_c(&out, &m_range[c * range_row_size], num_range_bins + 1, 1);
+            ifx_fft_run_rc_unchecked(m_range_fft, &in, &out);
+        }
+    }
+
+    /**
+     * @brief Doppler FFT of one range bin after range_fft
+     *
+     * Returns the spectrum (NumChirps elements, not shifted), valid until the
+     * next call. window has NumChirps elements.
+     */
+    const ifx_Complex_t* doppler_fft(uint32_t range_bin, const ifx_Float_t* window, bool mean_removal)
+    {
+        const ifx_Complex_t* column = &m_range[range_bin];
+
+        ifx_Float_t mean_real = 0;
+        ifx_Float_t mean_imag = 0;
+        if (mean_removal)
+        {
+            for (uint32_t c = 0; c < NumChirps; c++)
+            {
+                mean_real += IFX_COMPLEX_REAL(column[c * range_row_size]);
+                mean_imag += IFX_COMPLEX_IMAG(column[c * range_row_size]);
+            }
+            mean_real /= NumChirps;
+            mean_imag /= NumChirps;
+        }
+
+        for (uint32_t c = 0; c < NumChirps; c++)
+        {
+            IFX_COMPLEX_SET(m_bin[c],
+                            (IFX_COMPLEX_REAL(column[c * range_row_size]) - mean_real) * window[c],
+                            (IFX_COMPLEX_IMAG(column[c * range_row_size]) - mean_imag) * window[c]);
+        }
+
+        ifx_Vector_C_t in;
+        ifx_Vector_C_t out;
+        ifx_vec_rawview_c(&in, m_bin.data(), NumChirps, 1);
+        ifx_vec_rawview_c(&out, m_spectrum.data(), NumChirps, 1);
+        ifx_fft_run_c_unchecked(m_doppler_fft, &in, &out);
+
+        return m_spectrum.data();
+    }
+
+    /** @brief Squared norm of the spectrum of the last doppler_fft call (NumChirps elements). */
+    const ifx_Float_t* doppler_abs2()
+    {
+        for (uint32_t c = 0; c < NumChirps; c++)
+        {
+            const ifx_Float_t re = IFX_COMPLEX_REAL(m_spectrum[c]);
+            const ifx_Float_t im = IFX_COMPLEX_IMAG(m_spectrum[c]);
+            m_abs2[c] = re * re + im * im;
+        }
+        return m_abs2.data();
+    }
+
+private:
+    // rows of the range FFT output are padded to keep every row aligned
+    static constexpr uint32_t complex_alignment = IFX_MEMORY_ALIGNMENT / sizeof(ifx_Complex_t);
+    static constexpr uint32_t range_row_size = (num_range_bins + 1 + complex_alignment - 1) / complex_alignment * complex_alignment;
+
+    /** @brief Mean removal and windowing of one chirp into m_chirp (Stride 0: use the runtime stride). */
+    template <size_t Stride>
+    void preprocess_chirp(const ifx_Float_t* chirp, size_t stride, const ifx_Float_t* window, bool mean_removal)
+    {
+        const size_t step = Stride ? Stride : stride;
+
+        ifx_Float_t mean = 0;
+        if (mean_removal)
+        {
+            for (uint32_t i = 0; i < NumSamples; i++)
+                mean += chirp[i * step];
+            mean /= NumSamples;
+        }
+
+        for (uint32_t i = 0; i < NumSamples; i++)
+            m_chirp[i] = (chirp[i * step] - mean) * window[i];
+    }
+
+    ifx_FFT_t* m_range_fft = nullptr;
+    ifx_FFT_t* m_doppler_fft = nullptr;
+
+    alignas(IFX_MEMORY_ALIGNMENT) std::array<ifx_Float_t, NumSamples> m_chirp;
+    alignas(IFX_MEMORY_ALIGNMENT) std::array<ifx_Complex_t, NumChirps * range_row_size> m_range;
+    alignas(IFX_MEMORY_ALIGNMENT) std::array<ifx_Complex_t, NumChirps> m_bin;
+    alignas(IFX_MEMORY_ALIGNMENT) std::array<ifx_Complex_t, NumChirps> m_spectrum;
+    alignas(IFX_MEMORY_ALIGNMENT) std::array<ifx_Float_t, NumChirps> m_abs2;
+};
+
+}  // namespace ifx
+
+#endif  // IFX_RADAR_FIXED_RDM_HPP
@@ -0,0 +1,274 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Async.hpp
+ *
+ * @brief Awaitables for the asynchronous frame requests of the radar devices.
+ *
+ * Wraps @ref ifx_fmcw_get_next_frame_async, @ref ifx_ltr11_get_next_frame_async
+ * and @ref ifx_mimose_get_next_frame_async for C++20 coroutines. The header
+ * only needs the C API, the SDK itself is built as C++17, and is empty if the
+ * compiler does not support coroutines.
+ *
+ * @code
+ *   rdk::async::Detached run(ifx_Device_Fmcw_t* device, ifx_Fmcw_Frame_t* frame, ifx_Executor_t* executor)
+ *   {
+ *       while(co_await rdk::async::next_frame(device, frame, executor) == IFX_OK)
+ *       {
+ *           // process data on a thread of the executor
+ *           // ...
+ *       }
+ *   }
+ * @endcode
+ *
+ * Each co_await makes one request. A frame arriving while no request is
+ * pending is dropped, so run two such coroutines per device with a frame
+ * each to receive every frame.
+ */
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#include "ifxBase/Error.h"
+#include "ifxBase/Executor.h"
+#include "ifxFmcw/DeviceFmcw.h"
+#include "ifxLtr11/DeviceLtr11.h"
+#include "ifxMimose/DeviceMimose.h"
+
+#include <coroutine>
+#include <exception>
+
+
+namespace rdk {
+namespace async {
+
+/* Return type of a coroutine that runs on its own until it finishes, the
+ * caller does not wait for it. Exceptions leaving the coroutine terminate the
+ * program.
+ */
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() noexcept
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+namespace detail {
+
+/* Common part of the awaitables. co_await returns IFX_OK or the error that
+ * completed the request, including the error of a request that could not be
+ * made. The coroutine resumes on a thread of the executor, or without an
+ * executor on the thread receiving the data, where it may only make the
+ * next request before suspending again.
+ */
+class FrameAwaiter
+{
+public:
+    explicit FrameAwaiter(ifx_Executor_t* executor) noexcept :
+        m_executor(executor)
+    {}
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    ifx_Error_t await_resume() const noexcept
+    {
+        return m_error;
+    }
+
+protected:
+    template <typename Submit>
+    bool suspend(std::coroutine_handle<> handle, Submit submit) noexcept
+    {
+        m_handle = handle;
+        ifx_error_clear();
+        submit();
+        // A queued request may complete and destroy this awaiter before
+        // submit returns, so only a failed one is looked at.
+        const ifx_Error_t error = ifx_error_get_and_clear();
+        if (error == IFX_OK)
+        {
+            return true;
+        }
+        m_error = error;
+        return false;
+    }
+
+    void complete(ifx_Error_t error) noexcept
+    {
+        m_error = error;
+        const auto handle = m_handle;
+        if (m_executor)
+        {
+            ifx_executor_post(m_executor, &FrameAwaiter::resume, handle.address());
+        }
+        else
+        {
+            handle.resume();
+        }
+    }
+
+private:
+    static void resume(void* context)
+    {
+        std::coroutine_handle<>::from_address(context).resume();
+    }
+
+    ifx_Executor_t* m_executor;
+    std::coroutine_handle<> m_handle;
+    ifx_Error_t m_error = IFX_OK;
+};
+
+}  // namespace detail
+
+class FmcwFrame : public detail::FrameAwaiter
+{
+public:
+    FmcwFrame(ifx_Device_Fmcw_t* device, ifx_Fmcw_Frame_t* frame, ifx_Executor_t* executor) noexcept :
+        FrameAwaiter(executor),
+        m_device(device),
+        m_frame(frame)
+    {}
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        return suspend(handle, [this] {
+            ifx_fmcw_get_next_frame_async(m_device, m_frame, &FmcwFrame::callback, this);
+        });
+    }
+
+private:
+    static void callback(ifx_Fmcw_Frame_t* /*frame*/, ifx_Error_t error, void* user_data)
+    {
+        static_cast<FmcwFrame*>(user_data)->complete(error);
+    }
+
+    ifx_Device_Fmcw_t* m_device;
+    ifx_Fmcw_Frame_t* m_frame;
+};
+
+class Ltr11Frame : public detail::FrameAwaiter
+{
+public:
+    Ltr11Frame(ifx_Ltr11_Device_t* device, ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, ifx_Executor_t* executor) noexcept :
+        FrameAwaiter(executor),
+        m_device(device),
+        m_frame(frame),
+        m_metadata(metadata)
+    {}
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        return suspend(handle, [this] {
+            ifx_ltr11_get_next_frame_async(m_device, m_frame, m_metadata, &Ltr11Frame::callback, this);
+        });
+    }
+
+private:
+    static void callback(ifx_Vector_C_t* /*frame*/, ifx_Ltr11_Metadata_t* /*metadata*/, ifx_Error_t error, void* user_data)
+    {
+        static_cast<Ltr11Frame*>(user_data)->complete(error);
+    }
+
+    ifx_Ltr11_Device_t* m_device;
+    ifx_Vector_C_t* m_frame;
+    ifx_Ltr11_Metadata_t* m_metadata;
+};
+
+class MimoseFrame : public detail::FrameAwaiter
+{
+public:
+    MimoseFrame(ifx_Mimose_Device_t* device, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Executor_t* executor) noexcept :
+        FrameAwaiter(executor),
+        m_device(device),
+        m_frame(frame),
+        m_metadata(metadata)
+    {}
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        return suspend(handle, [this] {
+            ifx_mimose_get_next_frame_async(m_device, m_frame, m_metadata, &MimoseFrame::callback, this);
+        });
+    }
+
+private:
+    static void callback(ifx_Cube_C_t* /*frame*/, ifx_Mimose_Metadata_t* /*metadata*/, ifx_Error_t error, void* user_data)
+    {
+        static_cast<MimoseFrame*>(user_data)->complete(error);
+    }
+
+    ifx_Mimose_Device_t* m_device;
+    ifx_Cube_C_t* m_frame;
+    ifx_Mimose_Metadata_t* m_metadata;
+};
+
+/* Awaitable filling frame (and metadata) with the next frame of device. */
+inline FmcwFrame next_frame(ifx_Device_Fmcw_t* device, ifx_Fmcw_Frame_t* frame, ifx_Executor_t* executor = nullptr) noexcept
+{
+    return {device, frame, executor};
+}
+
+inline Ltr11Frame next_frame(ifx_Ltr11_Device_t* device, ifx_Vector_C_t* frame, ifx_Ltr11_Metadata_t* metadata, ifx_Executor_t* executor = nullptr) noexcept
+{
+    return {device, frame, metadata, executor};
+}
+
+inline MimoseFrame next_frame(ifx_Mimose_Device_t* device, ifx_Cube_C_t* frame, ifx_Mimose_Metadata_t* metadata, ifx_Executor_t* executor = nullptr) noexcept
+{
+    return {device, frame, metadata, executor};
+}
+
+}  // namespace async
+}  // namespace rdk
+
+#endif
+#endif
@@ -27,9 +27,13 @@
 ** ===========================================================================
 */
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
+#include <future>
+#include <map>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "ifxBase/Uuid.h"
@@ -121,39 +125,116 @@ bool get_sensor_type_legacy(std::unique_ptr<BoardInstance>& board, ifx_Radar_Sen
     return false;
 }
 
-std::vector<ifx_Radar_Sensor_List_Entry_t> get_list(BoardManager& board_manager, rdk::RadarDeviceCommon::SelectorFunction&& selector)
+void enumerate(BoardManager& board_manager, uint16_t max_count = 0)
 {
-    std::vector<ifx_Radar_Sensor_List_Entry_t> list;
-
-    for (const auto& descriptor : board_manager.getEnumeratedList())
+    if (use_serial)
+    {
+        board_manager.useSerial();
+    }
+    if (use_ethernet)
+    {
+        board_manager.useUdp();
+    }
+    if (use_uvc)
+    {
+        board_manager.useUvc();
+    }
+    if (use_wiggler)
+    {
+        board_manager.useWiggler();
+    }
+    if (use_libusb)
     {
-        ifx_Radar_Sensor_List_Entry_t entry = {};
+        board_manager.useLibusb();
+    }
+    board_manager.enumerate(max_count);
+}
 
-        try
-        {
-            std::unique_ptr<BoardInstance> board = descriptor->createBoardInstance();
-            if (!get_sensor_type(board, entry.sensor_type))
-            {
-                // not a radar sensor that we support
-                continue;
-            }
+/* Detecting the sensor type of a board requires creating a board instance
+ * and reading the chip id, which takes a noticeable amount of time per board.
+ * The list entries of boards probed before are therefore kept in
+ * sensor_cache, keyed by the name of the board (which contains the port) and
+ * its UUID. A board plugged into another port is probed again.
+ */
+std::mutex mutex_sensor_cache;
+std::map<std::string, ifx_Radar_Sensor_List_Entry_t> sensor_cache;
 
-            entry.board_type = rdk::RadarDeviceCommon::get_boardtype_from_pid(board->getPid());
+/* Result of probing a board, see probe_board. */
+struct Probe
+{
+    bool supported = false;
+    ifx_Radar_Sensor_List_Entry_t entry = {};
+    std::unique_ptr<BoardInstance> board;  // only set if the board was not found in sensor_cache
+};
 
-            // read uuid
-            const auto uuid = board->getUuidString();
-            std::copy(uuid.begin(), uuid.end(), entry.uuid);
+Probe probe_board(BoardDescriptor* descriptor)
+{
+    Probe probe;
 
-            if (selector(entry))
-                list.push_back(entry);
+    try
+    {
+        const std::string key = std::string(descriptor->getName()) + '/' + descriptor->getUuidString();
+        {
+            std::lock_guard<std::mutex> lock(mutex_sensor_cache);
+            const auto it = sensor_cache.find(key);
+            if (it != sensor_cache.end())
+            {
+                probe.supported = true;
+                probe.entry = it->second;
+                return probe;
+            }
         }
-        catch (const EException&)
+
+        probe.board = descriptor->createBoardInstance();
+        if (!get_sensor_type(probe.board, probe.entry.sensor_type))
         {
-            continue;
+            // not a radar sensor that we support
+            probe.board.reset();
+            return probe;
         }
+
+        probe.entry.board_type = rdk::RadarDeviceCommon::get_boardtype_from_pid(probe.board->getPid());
+
+        // read uuid
+        const auto uuid = probe.board->getUuidString();
+        std::copy(uuid.begin(), uuid.end(), probe.entry.uuid);
+
+        std::lock_guard<std::mutex> lock(mutex_sensor_cache);
+        sensor_cache[key] = probe.entry;
+        probe.supported = true;
+    }
+    catch (const EException&)
+    {
+        probe.board.reset();
     }
 
-    return list;
+    return probe;
+}
+
+/* Probes all enumerated boards concurrently; the returned list keeps the
+ * order of enumeration. Boards that are not found in sensor_cache are mostly
+ * waiting for USB transfers, so probing them in parallel reduces the time to
+ * open one of several boards to about the time of probing a single board.
+ */
+std::vector<Probe> probe_boards(BoardManager& board_manager)
+{
+    auto& descriptors = board_manager.getEnumeratedList();
+
+    std::vector<std::future<Probe>> futures;
+    futures.reserve(descriptors.size());
+    for (auto& descriptor : descriptors)
+    {
+        futures.push_back(std::async(std::launch::async, probe_board, descriptor.get()));
+    }
+
+    std::vector<Probe> probes;
+    probes.reserve(futures.size());
+    for (auto& future : futures)
+    {
+        probes.push_back(future.get());
+    }
+
+    return probes;
 }
 
 }  // namespace
@@ -211,42 +292,28 @@ std::unique_ptr<BoardInstance> rdk::RadarDeviceCommon::open(SelectorFunction&& s
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
+    enumerate(board_manager);
+
+    auto probes = probe_boards(board_manager);
+    auto& descriptors = board_manager.getEnumeratedList();
+    for (size_t i = 0; i < probes.size(); i++)
     {
-        board_manager.useLibusb();
-    }
-    board_manager.enumerate();
+        auto& probe = probes[i];
+        if (!probe.supported || !selector(probe.entry))
+            continue;
 
-    auto list = ::get_list(board_manager, std::forward<SelectorFunction>(selector));
-    if (list.empty())
-        return nullptr;
+        if (probe.board)
+            return std::move(probe.board);
 
-    try
-    {
-        uint8_t uuid_array[16];
-        if (ifx_uuid_from_string(list[0].uuid, uuid_array))
+        // the sensor type was taken from the cache, so the board is opened only now
+        try
         {
-            return board_manager.createSpecificBoardInstance(uuid_array);
+            return descriptors[i]->createBoardInstance();
+        }
+        catch (EException&)
+        {
+            return nullptr;
         }
-    }
-    catch (EException&)
-    {
     }
 
     return nullptr;
@@ -274,28 +341,22 @@ std::unique_ptr<BoardInstance> rdk::RadarDeviceCommon::open_by_uuid(const char u
 
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
+    // stop enumerating as soon as the board is found
+    EnumerationSelectorHelper selector([&uuid_array](BoardDescriptor* descriptor) {
+        try
+        {
+            const auto& uuid = descriptor->getUuid();
+            return std::equal(uuid.begin(), uuid.end(), uuid_array);
+        }
+        catch (EException&)
+        {
+            return false;
+        }
+    });
+
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
-    {
-        board_manager.useLibusb();
-    }
-    board_manager.enumerate();
+    board_manager.setEnumerationSelector(&selector);
+    enumerate(board_manager, 1);
 
     try
     {
@@ -308,34 +369,21 @@ std::unique_ptr<BoardInstance> rdk::RadarDeviceCommon::open_by_uuid(const char u
     return nullptr;
 }
 
-std::vector<ifx_Radar_Sensor_List_Entry_t> rdk::RadarDeviceCommon::get_list(SelectorFunction&& selector)
+rdk::RadarDeviceCommon::SensorList rdk::RadarDeviceCommon::get_list(SelectorFunction&& selector)
 {
     std::unique_lock<std::mutex> lock(mutex_board_manager);
 
     BoardManager board_manager;
-    if (use_serial)
-    {
-        board_manager.useSerial();
-    }
-    if (use_ethernet)
-    {
-        board_manager.useUdp();
-    }
-    if (use_uvc)
-    {
-        board_manager.useUvc();
-    }
-    if (use_wiggler)
-    {
-        board_manager.useWiggler();
-    }
-    if (use_libusb)
+    enumerate(board_manager);
+
+    SensorList list;
+    for (const auto& probe : probe_boards(board_manager))
     {
-        board_manager.useLibusb();
+        if (probe.supported && selector(probe.entry))
+            list.push_back(probe.entry);
     }
-    board_manager.enumerate();
 
-    return ::get_list(board_manager, std::forward<SelectorFunction>(selector));
+    return list;
 }
 
 void rdk::RadarDeviceCommon::get_firmware_info(BoardInstance* board, ifx_Firmware_Info_t* firmware_info)
@@ -0,0 +1,100 @@
+/* ===========================================================================
+** Copyright (C) 2024 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @internal
+ * @file AsyncRequests.hpp
+ *
+ * @brief Queue of the pending frame requests of the asynchronous device APIs.
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+
+namespace rdk {
+
+/* Requests are queued by application threads and completed in order by the
+ * thread receiving the data from the board. A request stays at the front
+ * until it is popped, so a frame arriving in several parts is assembled into
+ * the buffer of the same request. The callbacks of the requests must be
+ * called without holding the queue.
+ */
+template <typename Request>
+class AsyncRequests
+{
+public:
+    void push(const Request& request)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(request);
+    }
+
+    /* Copies the oldest request, returns false if none is pending. */
+    bool front(Request& request) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_requests.empty())
+        {
+            return false;
+        }
+        request = m_requests.front();
+        return true;
+    }
+
+    /* Removes the oldest request, returns false if none is pending. */
+    bool pop(Request& request)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_requests.empty())
+        {
+            return false;
+        }
+        request = m_requests.front();
+        m_requests.pop_front();
+        return true;
+    }
+
+    /* Removes all requests, e.g. to complete them as cancelled. */
+    std::deque<Request> take_all()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::deque<Request> requests;
+        requests.swap(m_requests);
+        return requests;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::deque<Request> m_requests;
+};
+
+}  // namespace rdk
@@ -33,6 +33,7 @@
 #include <ifxBase/Exception.hpp>
 #include <ifxBase/FunctionWrapper.hpp>
 #include <ifxBase/Types.h>
+#include <ifxBase/internal/InlineList.hpp>
 #include <ifxRadarDeviceCommon/RadarDeviceCommon.h>
 
 #include <platform/BoardInstance.hpp>
@@ -43,6 +44,9 @@
 namespace rdk {
 namespace RadarDeviceCommon {
 
+/** List of enumerated sensors; the first 16 entries are stored inline */
+using SensorList = ifx::InlineList<ifx_Radar_Sensor_List_Entry_t, 16>;
+
 /** Return true if sensor belongs to Avian family */
 inline bool sensor_is_avian(ifx_Radar_Sensor_t sensor_type)
 {
@@ -202,6 +206,10 @@ inline const char* board_type_to_string(ifx_Board_Type_t board_type)
  * Opens the first board found for which the selector function returns true.
  * If not selector is given, the first board found is opened.
  *
+ * All boards are probed concurrently. The sensor type of a board probed
+ * before is taken from a cache keyed by port and UUID; such a board is only
+ * opened if it is selected.
+ *
  * @param [in]    selector    selector function
  */
 IFX_DLL_PUBLIC std::unique_ptr<BoardInstance> open(SelectorFunction&& selector = [](const ifx_Radar_Sensor_List_Entry_t&) { return true; });
@@ -238,12 +246,12 @@ IFX_DLL_PUBLIC std::unique_ptr<BoardInstance> open_by_uuid(const char uuid[]);
 /**
  * @brief Returns list of boards
  *
- * Returns a vector with all boards connected where the selector
- * function returns true.
+ * Returns a list with all boards connected where the selector
+ * function returns true. Boards are probed as described for \ref open.
  *
  * @param [in]    selector    selector function
  */
-IFX_DLL_PUBLIC std::vector<ifx_Radar_Sensor_List_Entry_t> get_list(SelectorFunction&& selector);
+IFX_DLL_PUBLIC SensorList get_list(SelectorFunction&& selector);
 
 /**
  * @brief Return firmware info
@@ -189,6 +189,20 @@ classdef RadarDevice < handle
             RxFrame = reshape(Total_samples, num_rx, num_chirps_per_frame, num_samples_per_chirp);
         end
 
+        function RxFrames = get_next_frames(obj, num_frames, timeout_ms_opt)
+            %GET_NEXT_FRAMES method to fetch several frames from radar device
+            %   This method fetches num_frames frames from the radar device
+            %   and returns them as a single precision array of size
+            %   num_rx x num_chirps_per_frame x num_samples_per_chirp x num_frames.
+            %   The frames are written directly into the returned array, so
+            %   this is the preferred way to read data at high frame rates.
+            if ~exist('timeout_ms_opt','var')
+                timeout_ms_opt = 10000;
+            end
+            [ec, RxFrames] = DeviceControlM('get_next_frames', obj.device_handle, num_frames, timeout_ms_opt);
+            obj.check_error_code(ec);
+        end
+
         function start_acquisition(obj)
             %START_ACQUISITION starts the acquisition of raw data
             %   This method starts the acquisition of raw data when the radar device is connected
@@ -42,6 +42,8 @@
  *
  *      create          ifx_avian_create               device_config       device_handle
  *      get_next_frame  ifx_avian_get_next_frame       device_handle       err_code, num_rx, num_samples_per_chirp, num_chirpts_per_frame, RxFrame
+ *      get_next_frames ifx_fmcw_get_next_frame_timeout device_handle,      err_code, RxFrames
+ *                                                     num_frames, timeout
  *      destroy         ifx_avian_destroy              device_handle       VOID
  *
  * e.g.:
@@ -68,6 +70,119 @@
 #define device_handle(ctx, argnum) ((ifx_Avian_Device_t*)arg_pointer_valid((ctx), (argnum)))
 #define cw_handle(ctx, argnum)     ((ifx_Device_Cw_t*)arg_pointer_valid((ctx), (argnum)))
 
+// maximum number of cubes (virtual channels) per frame read by get_next_frames
+#define MAX_FRAME_CUBES 16
+
+// Layout of the frames of the device last used by get_next_frames. It is
+// determined once by allocating an fmcw frame and is invalidated whenever the
+// configuration of that device might change.
+typedef struct
+{
+    const ifx_Avian_Device_t* device;
+    uint32_t num_cubes;
+    uint32_t num_rx_per_cube;
+    uint32_t num_chirps_per_frame;
+    uint32_t num_samples_per_chirp;
+} FrameLayout;
+
+static FrameLayout frame_layout = {NULL, 0, 0, 0, 0};
+
+
+static void invalidate_frame_layout(const ifx_Avian_Device_t* device)
+{
+    if (frame_layout.device == device)
+    {
+        frame_layout.device = NULL;
+    }
+}
+
+
+static bool update_frame_layout(ifx_Avian_Device_t* device)
+{
+    if (frame_layout.device == device)
+    {
+        return true;
+    }
+
+    ifx_Fmcw_Frame_t* frame = ifx_fmcw_allocate_frame(device);
+    if (ifx_error_get() != IFX_OK)
+    {
+        return false;
+    }
+
+    // all cubes are stacked along the antenna dimension, so they must share their shape
+    bool valid = (frame->num_cubes > 0) && (frame->num_cubes <= MAX_FRAME_CUBES);
+    for (uint32_t i = 0; valid && (i < frame->num_cubes); ++i)
+    {
+        const ifx_Mda_R_t* cube = frame->cubes[i];
+        valid = (cube->dimensions == 3)
+                && (cube->shape[0] == frame->cubes[0]->shape[0])
+                && (cube->shape[1] == frame->cubes[0]->shape[1])
+                && (cube->shape[2] == frame->cubes[0]->shape[2]);
+    }
+
+    if (valid)
+    {
+        frame_layout.device = device;
+        frame_layout.num_cubes = frame->num_cubes;
+        frame_layout.num_rx_per_cube = frame->cubes[0]->shape[0];
+        frame_layout.num_chirps_per_frame = frame->cubes[0]->shape[1];
+        frame_layout.num_samples_per_chirp = frame->cubes[0]->shape[2];
+    }
+    ifx_fmcw_destroy_frame(frame);
+
+    if (!valid)
+    {
+        ifx_error_set(IFX_ERROR_DIMENSION_MISMATCH);
+    }
+    return valid;
+}
+
+
+// Reads one frame directly into data, which is a column-major MATLAB array of
+// size num_rx x num_chirps_per_frame x num_samples_per_chirp. The cubes of the
+// fmcw frame are views with MATLAB strides into that array, so the samples are
+// deinterleaved straight into their final position. Like
+// ifx_avian_get_next_frame the values are converted to the range 0..1.
+static void read_frame_into(ifx_Avian_Device_t* device, float* data, uint16_t timeout_ms)
+{
+    const uint32_t num_rx_per_cube = frame_layout.num_rx_per_cube;
+    const uint32_t num_chirps = frame_layout.num_chirps_per_frame;
+    const uint32_t num_samples = frame_layout.num_samples_per_chirp;
+    const size_t num_rx = (size_t)num_rx_per_cube * frame_layout.num_cubes;
+
+    ifx_Mda_R_t cubes[MAX_FRAME_CUBES];
+    ifx_Mda_R_t* cube_ptrs[MAX_FRAME_CUBES];
+    for (uint32_t i = 0; i < frame_layout.num_cubes; ++i)
+    {
+        ifx_Mda_R_t* cube = &cubes[i];
+        memset(cube, 0, sizeof(*cube));
+        cube->dimensions = 3;
+        cube->data = data + (size_t)i * num_rx_per_cube;
+        cube->shape[0] = num_rx_per_cube;
+        cube->shape[1] = num_chirps;
+        cube->shape[2] = num_samples;
+        cube->stride[0] = 1;
+        cube->stride[1] = num_rx;
+        cube->stride[2] = num_rx * num_chirps;
+        cube_ptrs[i] = cube;
+    }
+
+    ifx_Fmcw_Frame_t frame = {frame_layout.num_cubes, cube_ptrs, 0, 0, 0};
+    ifx_fmcw_get_next_frame_timeout(device, &frame, timeout_ms);
+    if (ifx_error_get() != IFX_OK)
+    {
+        return;
+    }
+
+    // convert data from range -1..1 to range 0..1
+    float* last = data + num_rx * num_chirps * num_samples;
+    for (float* sample = data; sample < last; ++sample)
+    {
+        *sample = (*sample + 1.0f) / 2.0f;
+    }
+}
+
 
 static void get_version(WrapperContext* ctx)
 {
@@ -256,6 +371,7 @@ static void set_config(WrapperContext* ctx)
     config.hp_cutoff_Hz = pget_uint32(mcfg, 0, "hp_cutoff_Hz");
     config.aaf_cutoff_Hz = pget_uint32(mcfg, 0, "aaf_cutoff_Hz");
 
+    invalidate_frame_layout(device);
     ifx_avian_set_config(device, &config);
 
     ret_error(ctx, 0);
@@ -377,6 +493,7 @@ static void destroy(WrapperContext* ctx)
 {
     ifx_Avian_Device_t* device = device_handle(ctx, 0);
 
+    invalidate_frame_layout(device);
     ifx_avian_destroy(device);
 
     ret_error(ctx, 0);
@@ -543,6 +660,46 @@ static void get_next_frame_timeout(WrapperContext* ctx)
     ifx_cube_destroy_r(frame_ptr);
 }
 
+
+static void get_next_frames(WrapperContext* ctx)
+{
+    ifx_Avian_Device_t* device = device_handle(ctx, 0);
+    uint32_t num_frames = arg_uint32(ctx, 1);
+    uint16_t timeout = arg_uint16(ctx, 2);
+
+    mxArray* frames = NULL;
+    if (update_frame_layout(device))
+    {
+        // the array is returned as num_rx x num_chirps_per_frame x num_samples_per_chirp x num_frames
+        // and each frame is written to its slot without an intermediate copy
+        const mwSize dims[4] = {
+            (mwSize)frame_layout.num_rx_per_cube * frame_layout.num_cubes,
+            frame_layout.num_chirps_per_frame,
+            frame_layout.num_samples_per_chirp,
+            num_frames};
+        const size_t frame_size = (size_t)dims[0] * dims[1] * dims[2];
+
+        frames = mxCreateNumericArray(4, dims, mxSINGLE_CLASS, mxREAL);
+        float* data = (float*)mxGetData(frames);
+        for (uint32_t i = 0; (i < num_frames) && (ifx_error_get() == IFX_OK); ++i)
+        {
+            read_frame_into(device, data + i * frame_size, timeout);
+        }
+    }
+
+    if (ifx_error_get() != IFX_OK)
+    {
+        if (frames)
+        {
+            mxDestroyArray(frames);
+        }
+        frames = mxCreateNumericMatrix(0, 0, mxSINGLE_CLASS, mxREAL);
+    }
+
+    ret_error(ctx, 0);
+    ret(ctx, 1, frames);
+}
+
 static void get_register_list_string(WrapperContext* ctx)
 {
     ifx_Avian_Device_t* device = device_handle(ctx, 0);
@@ -574,7 +731,7 @@ static void load_register_file(WrapperContext* ctx)
     ifx_Avian_Device_t* device = device_handle(ctx, 0);
     const char* filename = arg_string(ctx, 1);
 
-    // allocates memory to c string
+    invalidate_frame_layout(device);
     ifx_avian_load_register_file(device, filename);
 
     ret_error(ctx, 0);
@@ -909,6 +1066,7 @@ static const CommandDescriptor commands[] = {
     {"load_register_file", load_register_file, 1, 2},
     {"get_next_frame", get_next_frame, 5, 1},
     {"get_next_frame_timeout", get_next_frame_timeout, 5, 2},
+    {"get_next_frames", get_next_frames, 2, 3},
     {"get_board_uuid", get_board_uuid, 2, 1},
     {"get_sensor_information", get_sensor_information, 2, 2},
     {"get_firmware_information", get_firmware_information, 2, 2},
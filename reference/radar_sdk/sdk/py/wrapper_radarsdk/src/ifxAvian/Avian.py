@@ -46,6 +46,7 @@ from ifxradarsdk.common.common_types import (
 from ifxradarsdk.common.sdk_base import (
     ifx_mda_destroy_r,
     ifx_mem_free,
+    get_sensor_uuids,
     move_ifx_list_to_python_list
 )
 
@@ -65,6 +66,8 @@ class Device():
         declare_prototype(dll, "ifx_avian_create_by_port", [c_char_p], c_void_p)
         declare_prototype(dll, "ifx_avian_get_list", None, c_void_p)
         declare_prototype(dll, "ifx_avian_get_list_by_sensor_type", [c_int], c_void_p)
+        declare_prototype(dll, "ifx_avian_get_sensor_list", [POINTER(DeviceListEntry), c_size_t], c_size_t)
+        declare_prototype(dll, "ifx_avian_get_sensor_list_by_sensor_type", [c_int, POINTER(DeviceListEntry), c_size_t], c_size_t)
         declare_prototype(dll, "ifx_avian_create_by_uuid", [c_char_p], c_void_p)
         declare_prototype(dll, "ifx_avian_get_board_uuid", [c_void_p], c_char_p)
         declare_prototype(dll, "ifx_avian_save_register_file", [c_void_p, c_char_p], None)
@@ -107,12 +110,9 @@ class Device():
         """
 
         if sensor_type == None:
-            ifx_list = cls._cdll.ifx_avian_get_list()
+            return get_sensor_uuids(cls._cdll.ifx_avian_get_sensor_list)
         else:
-            ifx_list = cls._cdll.ifx_avian_get_list_by_sensor_type(int(sensor_type))
-
-        return move_ifx_list_to_python_list(ifx_list,
-                                            lambda p: cast(p, POINTER(DeviceListEntry)).contents.uuid.decode("ascii"))
+            return get_sensor_uuids(cls._cdll.ifx_avian_get_sensor_list_by_sensor_type, int(sensor_type))
 
 
     def __init__(self, uuid : typing.Optional[str] = None, port : typing.Optional[str] = None):
@@ -0,0 +1,2 @@
+from .algo import AngleCapon, DBSCAN, DigitalBeamForming, MovingTargetIndicator, OSCFAR, RangeDopplerMap
+from .types import ScaleType, WindowType
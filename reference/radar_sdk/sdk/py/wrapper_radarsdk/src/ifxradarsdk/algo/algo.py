@@ -0,0 +1,337 @@
+# ===========================================================================
+# Copyright (C) 2022 Infineon Technologies AG
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+# ===========================================================================
+
+"""Python wrappers for the signal processing modules of the SDK
+
+The classes wrap the range Doppler map, digital beam forming, moving target
+indication, OS-CFAR, DBSCAN and Capon angle estimation modules of the
+ifxAlgo and ifxRadar libraries. NumPy arrays are passed to the C library
+without copies: inputs are only converted if they are not already C
+contiguous arrays of the required type, and results are written directly
+into the output arrays (newly allocated, or given as out to reuse them).
+"""
+
+from ctypes import *
+import typing
+
+import numpy as np
+
+from ..common.base_types import MdaComplex, MdaReal
+from ..common.cdll_helper import declare_prototype, load_library
+from ..common import sdk_base  # loads sdk_base first, which sets up the error checking of all prototypes
+from .types import (
+    AngleCaponConfig,
+    DBFConfig,
+    DBSCANConfig,
+    FftType,
+    OSCFARConfig,
+    PPFFTConfig,
+    RDMConfig,
+    ScaleType,
+    WindowConfig,
+    WindowType
+)
+
+
+def _load_algo() -> CDLL:
+    """Load the ifxAlgo library and declare the prototypes of its functions"""
+    dll = load_library("sdk_algo")
+
+    declare_prototype(dll, "ifx_mti_create", [c_float, c_uint32], c_void_p)
+    declare_prototype(dll, "ifx_mti_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_mti_run", [c_void_p, POINTER(MdaReal), POINTER(MdaReal)], None)
+    declare_prototype(dll, "ifx_oscfar_create", [POINTER(OSCFARConfig)], c_void_p)
+    declare_prototype(dll, "ifx_oscfar_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_oscfar_run", [c_void_p, POINTER(MdaReal), POINTER(MdaReal)], None)
+    declare_prototype(dll, "ifx_oscfar_run_ca", [c_void_p, POINTER(MdaReal), POINTER(MdaReal)], None)
+    declare_prototype(dll, "ifx_dbscan_create", [POINTER(DBSCANConfig)], c_void_p)
+    declare_prototype(dll, "ifx_dbscan_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_dbscan_run", [c_void_p, POINTER(c_uint16), c_uint16, POINTER(c_uint16)], None)
+    declare_prototype(dll, "ifx_dbscan_run_incremental", [c_void_p, POINTER(c_uint16), c_uint16, POINTER(c_uint16)], None)
+    declare_prototype(dll, "ifx_dbscan_reset", [c_void_p], None)
+
+    return dll
+
+
+def _load_radar() -> CDLL:
+    """Load the ifxRadar library and declare the prototypes of its functions"""
+    dll = load_library("sdk_radar")
+
+    declare_prototype(dll, "ifx_rdm_create", [POINTER(RDMConfig)], c_void_p)
+    declare_prototype(dll, "ifx_rdm_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_rdm_run_r", [c_void_p, POINTER(MdaReal), POINTER(MdaReal)], None)
+    declare_prototype(dll, "ifx_rdm_run_cr", [c_void_p, POINTER(MdaComplex), POINTER(MdaReal)], None)
+    declare_prototype(dll, "ifx_rdm_run_cube_rc", [c_void_p, POINTER(MdaReal), POINTER(MdaComplex)], None)
+    declare_prototype(dll, "ifx_rdm_run_cube_c", [c_void_p, POINTER(MdaComplex), POINTER(MdaComplex)], None)
+    declare_prototype(dll, "ifx_rdm_get_num_range_bins", [c_void_p], c_uint32)
+    declare_prototype(dll, "ifx_dbf_create", [POINTER(DBFConfig)], c_void_p)
+    declare_prototype(dll, "ifx_dbf_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_dbf_run_c", [c_void_p, POINTER(MdaComplex), POINTER(MdaComplex)], None)
+    declare_prototype(dll, "ifx_dbf_run_cells_c", [c_void_p, POINTER(MdaComplex), POINTER(c_uint16), c_uint32, POINTER(MdaComplex)], None)
+    declare_prototype(dll, "ifx_anglecapon_create", [POINTER(AngleCaponConfig)], c_void_p)
+    declare_prototype(dll, "ifx_anglecapon_destroy", [c_void_p], None)
+    declare_prototype(dll, "ifx_anglecapon_run", [c_void_p, c_uint32, POINTER(MdaComplex)], c_float)
+    declare_prototype(dll, "ifx_anglecapon_run_batch", [c_void_p, POINTER(c_uint32), c_uint32, POINTER(MdaComplex), POINTER(c_float)], None)
+
+    return dll
+
+
+_algo_cdll = _load_algo()
+_radar_cdll = _load_radar()
+
+
+def _output(out: typing.Optional[np.ndarray], shape: tuple, dtype) -> np.ndarray:
+    """Return out after checking it, or a new array if out is None"""
+    if out is None:
+        return np.empty(shape, dtype=dtype)
+    if out.shape != tuple(shape):
+        raise ValueError(f"out must have shape {tuple(shape)}")
+    return out
+
+
+class _Module():
+    """Owner of the handle of a processing module"""
+    _destroy = None  # name of the destroy function, looked up when needed so the library is loaded on first use
+
+    def __init__(self, handle):
+        self.handle = handle
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self._close()
+
+    def _close(self):
+        """Destroy handle"""
+        if getattr(self, "handle", None):
+            getattr(self._cdll, self._destroy)(self.handle)
+            self.handle = None
+
+    def __del__(self):
+        try:
+            self._close()
+        except:
+            # exceptions raised in a destructor cannot be catched
+            pass
+
+
+class RangeDopplerMap(_Module):
+    """Range Doppler map (ifx_RDM_t)
+
+    Computes the range Doppler map of the chirps of one antenna,
+    shape (num_chirps, num_samples), or of a frame cube of shape
+    (num_rx, num_chirps, num_samples) as returned by DeviceFmcw.
+    """
+    _cdll = _radar_cdll
+    _destroy = "ifx_rdm_destroy"
+
+    def __init__(self, num_samples: int, num_chirps: int,
+                 range_fft_size: typing.Optional[int] = None, doppler_fft_size: typing.Optional[int] = None,
+                 range_window: WindowType = WindowType.BLACKMANHARRIS, doppler_window: WindowType = WindowType.CHEBYSHEV,
+                 doppler_window_at_dB: float = 100, output_scale_type: ScaleType = ScaleType.DECIBEL_20LOG,
+                 threshold: float = 1e-6, mean_removal: bool = True, complex_input: bool = False,
+                 first_range_bin: int = 0, num_range_bins: int = 0):
+        """Create range Doppler map module
+
+        The FFT sizes default to twice the number of samples and chirps.
+        For real input (complex_input=False) only the positive half of the
+        range spectrum is computed. The output can be limited to
+        num_range_bins range bins starting at first_range_bin, which skips
+        the Doppler processing of all other bins (0 for all bins).
+        """
+        range_fft_size = range_fft_size or 2 * num_samples
+        doppler_fft_size = doppler_fft_size or 2 * num_chirps
+        range_type = FftType.C2C if complex_input else FftType.R2C
+
+        self.config = RDMConfig(threshold, output_scale_type,
+                                PPFFTConfig(range_type, range_fft_size, mean_removal,
+                                            WindowConfig(range_window, num_samples, 0, 1), True),
+                                PPFFTConfig(FftType.C2C, doppler_fft_size, mean_removal,
+                                            WindowConfig(doppler_window, num_chirps, doppler_window_at_dB, 1), True),
+                                first_range_bin, num_range_bins)
+        self.complex_input = complex_input
+        super().__init__(self._cdll.ifx_rdm_create(byref(self.config)))
+        self.shape = (self._cdll.ifx_rdm_get_num_range_bins(self.handle), doppler_fft_size)
+
+    def run(self, chirps: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Compute the range Doppler map (range bins x Doppler bins, float32) of one antenna"""
+        out = _output(out, self.shape, np.float32)
+        if self.complex_input:
+            self._cdll.ifx_rdm_run_cr(self.handle, MdaComplex.view_input(chirps), MdaReal.view_numpy(out))
+        else:
+            self._cdll.ifx_rdm_run_r(self.handle, MdaReal.view_input(chirps), MdaReal.view_numpy(out))
+        return out
+
+    def run_cube(self, cube: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Compute the complex range Doppler spectra of all antennas
+
+        The result has the shape (range bins, Doppler bins, num_rx), as
+        expected by DigitalBeamForming.run.
+        """
+        out = _output(out, self.shape + (cube.shape[0],), np.complex64)
+        if self.complex_input:
+            self._cdll.ifx_rdm_run_cube_c(self.handle, MdaComplex.view_input(cube), MdaComplex.view_numpy(out))
+        else:
+            self._cdll.ifx_rdm_run_cube_rc(self.handle, MdaReal.view_input(cube), MdaComplex.view_numpy(out))
+        return out
+
+
+class DigitalBeamForming(_Module):
+    """Digital beam forming (ifx_DBF_t)"""
+    _cdll = _radar_cdll
+    _destroy = "ifx_dbf_destroy"
+
+    def __init__(self, num_beams: int, num_antennas: int, min_angle: float = -45, max_angle: float = 45,
+                 d_by_lambda: float = 0.5):
+        self.config = DBFConfig(num_beams, num_antennas, min_angle, max_angle, d_by_lambda)
+        super().__init__(self._cdll.ifx_dbf_create(byref(self.config)))
+
+    def run(self, spectrum: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Compute all beams of a range Doppler spectrum
+
+        spectrum has the shape (range bins, Doppler bins, antennas), the
+        result (range bins, Doppler bins, beams).
+        """
+        out = _output(out, spectrum.shape[:2] + (self.config.num_beams,), np.complex64)
+        self._cdll.ifx_dbf_run_c(self.handle, MdaComplex.view_input(spectrum), MdaComplex.view_numpy(out))
+        return out
+
+    def run_cells(self, spectrum: np.ndarray, cells: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Compute the beams of selected cells only
+
+        cells holds the range and Doppler index of each cell, shape
+        (num_cells, 2). The result has the shape (num_cells, beams).
+        """
+        cells = np.ascontiguousarray(cells, dtype=np.uint16)
+        num_cells = cells.shape[0]
+        out = _output(out, (num_cells, self.config.num_beams), np.complex64)
+        self._cdll.ifx_dbf_run_cells_c(self.handle, MdaComplex.view_input(spectrum),
+                                       cells.ctypes.data_as(POINTER(c_uint16)), num_cells, MdaComplex.view_numpy(out))
+        return out
+
+
+class AngleCapon(_Module):
+    """Angle estimation with the Capon beam former (ifx_AngleCapon_t)"""
+    _cdll = _radar_cdll
+    _destroy = "ifx_anglecapon_destroy"
+
+    def __init__(self, chirps_per_frame: int, num_virtual_antennas: int = 2, num_beams: int = 27,
+                 min_angle_degrees: float = -40, max_angle_degrees: float = 40, range_win_size: int = 5,
+                 selected_rx: int = 0, phase_offset_degrees: float = 0, d_by_lambda: float = 0.5,
+                 diagonal_loading: float = 0):
+        self.config = AngleCaponConfig(range_win_size, selected_rx, chirps_per_frame, phase_offset_degrees,
+                                       num_virtual_antennas, num_beams, min_angle_degrees, max_angle_degrees,
+                                       d_by_lambda, diagonal_loading)
+        super().__init__(self._cdll.ifx_anglecapon_create(byref(self.config)))
+
+    def run(self, range_bin: int, rx_spectrum: np.ndarray) -> float:
+        """Return the angle in degrees of a target in range_bin"""
+        return self._cdll.ifx_anglecapon_run(self.handle, range_bin, MdaComplex.view_input(rx_spectrum))
+
+    def run_batch(self, range_bins: np.ndarray, rx_spectrum: np.ndarray) -> np.ndarray:
+        """Return the angles in degrees of targets in several range bins"""
+        range_bins = np.ascontiguousarray(range_bins, dtype=np.uint32)
+        angles = np.empty(range_bins.shape[0], dtype=np.float32)
+        self._cdll.ifx_anglecapon_run_batch(self.handle, range_bins.ctypes.data_as(POINTER(c_uint32)), range_bins.shape[0],
+                                            MdaComplex.view_input(rx_spectrum), angles.ctypes.data_as(POINTER(c_float)))
+        return angles
+
+
+class MovingTargetIndicator(_Module):
+    """Moving target indication filter (ifx_MTI_t)"""
+    _cdll = _algo_cdll
+    _destroy = "ifx_mti_destroy"
+
+    def __init__(self, alpha: float, spectrum_length: int):
+        self.spectrum_length = spectrum_length
+        super().__init__(self._cdll.ifx_mti_create(alpha, spectrum_length))
+
+    def run(self, spectrum: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Remove the static part of a spectrum of spectrum_length values"""
+        out = _output(out, (self.spectrum_length,), np.float32)
+        self._cdll.ifx_mti_run(self.handle, MdaReal.view_input(spectrum), MdaReal.view_numpy(out))
+        return out
+
+
+class OSCFAR(_Module):
+    """Ordered statistics CFAR detector (ifx_OSCFAR_t)"""
+    _cdll = _algo_cdll
+    _destroy = "ifx_oscfar_destroy"
+
+    def __init__(self, win_rank: int = 3, guard_band: int = 1, sample: float = 0, pfa: float = 2e-4,
+                 coarse_scalar: float = 1):
+        self.config = OSCFARConfig(win_rank, guard_band, sample, pfa, coarse_scalar)
+        super().__init__(self._cdll.ifx_oscfar_create(byref(self.config)))
+
+    def run(self, feature: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Return the detections (1) of a 2D feature map, e.g. a range Doppler map"""
+        out = _output(out, feature.shape, np.float32)
+        self._cdll.ifx_oscfar_run(self.handle, MdaReal.view_input(feature), MdaReal.view_numpy(out))
+        return out
+
+    def run_ca(self, feature: np.ndarray, out: typing.Optional[np.ndarray] = None) -> np.ndarray:
+        """Like run, but with a cell averaging CFAR"""
+        out = _output(out, feature.shape, np.float32)
+        self._cdll.ifx_oscfar_run_ca(self.handle, MdaReal.view_input(feature), MdaReal.view_numpy(out))
+        return out
+
+
+class DBSCAN(_Module):
+    """Density based clustering of detections (ifx_DBSCAN_t)"""
+    _cdll = _algo_cdll
+    _destroy = "ifx_dbscan_destroy"
+
+    def __init__(self, min_points: int, min_dist: float, max_num_detections: int):
+        self.config = DBSCANConfig(min_points, min_dist, max_num_detections)
+        super().__init__(self._cdll.ifx_dbscan_create(byref(self.config)))
+
+    def _run(self, function, detections: np.ndarray) -> np.ndarray:
+        detections = np.ascontiguousarray(detections, dtype=np.uint16)
+        num_detections = detections.shape[0]
+        clusters = np.zeros(num_detections, dtype=np.uint16)
+        if num_detections:
+            function(self.handle, detections.ctypes.data_as(POINTER(c_uint16)), num_detections,
+                     clusters.ctypes.data_as(POINTER(c_uint16)))
+        return clusters
+
+    def run(self, detections: np.ndarray) -> np.ndarray:
+        """Return the cluster ID of each detection (0 for noise)
+
+        detections holds the coordinates of each detection, shape
+        (num_detections, 2).
+        """
+        return self._run(self._cdll.ifx_dbscan_run, detections)
+
+    def run_incremental(self, detections: np.ndarray) -> np.ndarray:
+        """Like run, but clusters keep the IDs of overlapping clusters of the previous call"""
+        return self._run(self._cdll.ifx_dbscan_run_incremental, detections)
+
+    def reset(self) -> None:
+        """Forget the clusters of the previous call of run_incremental"""
+        self._cdll.ifx_dbscan_reset(self.handle)
@@ -0,0 +1,133 @@
+# ===========================================================================
+# Copyright (C) 2022 Infineon Technologies AG
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+#    this list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright
+#    notice, this list of conditions and the following disclaimer in the
+#    documentation and/or other materials provided with the distribution.
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+# ===========================================================================
+
+"""Definitions of the structures for the signal processing wrappers
+
+This file contains definitions of enumerations and structures of the
+ifxAlgo and ifxRadar processing modules.
+"""
+
+from ctypes import *
+from enum import IntEnum
+
+from ..common.base_types import ifxStructure
+
+
+class WindowType(IntEnum):
+    """Window functions (ifx_Window_Type_t)"""
+    HAMMING = 0
+    HANN = 1
+    BLACKMANHARRIS = 2
+    CHEBYSHEV = 3
+    BLACKMAN = 4
+
+
+class FftType(IntEnum):
+    """FFT input types (ifx_FFT_Type_t)"""
+    R2C = 1  # real input
+    C2C = 2  # complex input
+
+
+class ScaleType(IntEnum):
+    """Output scale of spectra (ifx_Math_Scale_Type_t)"""
+    LINEAR = 0
+    DECIBEL_10LOG = 10
+    DECIBEL_20LOG = 20
+
+
+class WindowConfig(ifxStructure):
+    """Wrapper for structure ifx_Window_Config_t"""
+    _fields_ = (("type", c_int),
+                ("size", c_uint32),
+                ("at_dB", c_float),
+                ("scale", c_float),
+                )
+
+
+class PPFFTConfig(ifxStructure):
+    """Wrapper for structure ifx_PPFFT_Config_t"""
+    _fields_ = (("fft_type", c_int),
+                ("fft_size", c_uint32),
+                ("mean_removal_enabled", c_bool),
+                ("window_config", WindowConfig),
+                ("is_normalized_window", c_bool),
+                )
+
+
+class RDMConfig(ifxStructure):
+    """Wrapper for structure ifx_RDM_Config_t"""
+    _fields_ = (("spect_threshold", c_float),
+                ("output_scale_type", c_int),
+                ("range_fft_config", PPFFTConfig),
+                ("doppler_fft_config", PPFFTConfig),
+                ("first_range_bin", c_uint32),
+                ("num_range_bins", c_uint32),
+                )
+
+
+class DBFConfig(ifxStructure):
+    """Wrapper for structure ifx_DBF_Config_t"""
+    _fields_ = (("num_beams", c_uint8),
+                ("num_antennas", c_uint8),
+                ("min_angle", c_float),
+                ("max_angle", c_float),
+                ("d_by_lambda", c_float),
+                )
+
+
+class OSCFARConfig(ifxStructure):
+    """Wrapper for structure ifx_OSCFAR_Config_t"""
+    _fields_ = (("win_rank", c_uint8),
+                ("guard_band", c_uint8),
+                ("sample", c_float),
+                ("pfa", c_float),
+                ("coarse_scalar", c_float),
+                )
+
+
+class DBSCANConfig(ifxStructure):
+    """Wrapper for structure ifx_DBSCAN_Config_t"""
+    _fields_ = (("min_points", c_uint8),
+                ("min_dist", c_float),
+                ("max_num_detections", c_uint32),
+                )
+
+
+class AngleCaponConfig(ifxStructure):
+    """Wrapper for structure ifx_AngleCapon_Config_t"""
+    _fields_ = (("range_win_size", c_uint8),
+                ("selected_rx", c_uint8),
+                ("chirps_per_frame", c_uint16),
+                ("phase_offset_degrees", c_float),
+                ("num_virtual_antennas", c_uint8),
+                ("num_beams", c_uint8),
+                ("min_angle_degrees", c_float),
+                ("max_angle_degrees", c_float),
+                ("d_by_lambda", c_float),
+                ("diagonal_loading", c_float),
+                )
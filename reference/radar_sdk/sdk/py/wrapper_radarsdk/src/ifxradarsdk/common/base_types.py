@@ -53,7 +53,7 @@ def c_stride(shape: tuple):
     for k in reversed(range(dimensions)):
         stride[k] = offset
         offset *= shape[k]
-    return (c_uint32 * IFX_MDA_MAX_DIM)(*stride)
+    return (c_size_t * IFX_MDA_MAX_DIM)(*stride)
 
 
 def c_shape(shape: tuple):
@@ -89,7 +89,7 @@ class MdaReal(Structure):
     _fields_ = (('dimensions', c_uint32),
                 ('data', POINTER(c_float)),
                 ('shape', c_uint32 * IFX_MDA_MAX_DIM),
-                ('stride', c_uint32 * IFX_MDA_MAX_DIM),
+                ('stride', c_size_t * IFX_MDA_MAX_DIM),
                 ('flags', c_uint32),
                 )
 
@@ -116,19 +116,66 @@ class MdaReal(Structure):
         arr.np_arr = np_arr  # avoid that memory of np_arr is freed
         return arr
 
+    @classmethod
+    def view_numpy(cls, np_arr: np.ndarray):
+        """Create ifx_Mda_R_t view of numpy array without copying it
+
+        The C library writes directly into the memory of np_arr, which must
+        be a writeable float32 array in C order.
+        """
+        shape = np_arr.shape
+        dimensions = len(shape)
+        if dimensions > IFX_MDA_MAX_DIM:
+            raise ValueError("too many dimensions")
+        if np_arr.dtype != np.float32 or not np_arr.flags.c_contiguous or not np_arr.flags.writeable:
+            raise ValueError("array must be a writeable float32 array in C order")
+
+        data = np_arr.ctypes.data_as(POINTER(c_float))
+        arr = MdaReal(dimensions, data, c_shape(shape), c_stride(shape), 0)
+        arr.np_arr = np_arr  # avoid that memory of np_arr is freed
+        return arr
+
+    @classmethod
+    def view_input(cls, np_arr: np.ndarray):
+        """Create ifx_Mda_R_t view of an input array
+
+        Like view_numpy, but for arrays only read by the C library: np_arr
+        is converted to a float32 array in C order first, which copies it
+        only if it is not already one.
+        """
+        np_arr = np.ascontiguousarray(np_arr, dtype=np.float32)
+        shape = np_arr.shape
+        dimensions = len(shape)
+        if dimensions > IFX_MDA_MAX_DIM:
+            raise ValueError("too many dimensions")
+
+        data = np_arr.ctypes.data_as(POINTER(c_float))
+        arr = MdaReal(dimensions, data, c_shape(shape), c_stride(shape), 0)
+        arr.np_arr = np_arr  # avoid that memory of np_arr is freed
+        return arr
+
     def to_numpy(self) -> np.ndarray:
         """Convert ifx_Mda_R_t type to a numpy array"""
         shape = truncate_list_at_zero(self.shape)
         data = np.ctypeslib.as_array(self.data, shape)
         return np.array(data, order="C", copy=True)
 
+    def as_numpy_view(self) -> np.ndarray:
+        """Return a numpy array sharing the memory of a contiguous ifx_Mda_R_t
+
+        The memory is owned by the C library, the array must not be used
+        after the ifx_Mda_R_t has been freed.
+        """
+        shape = truncate_list_at_zero(self.shape)
+        return np.ctypeslib.as_array(self.data, shape)
+
 
 class MdaComplex(Structure):
     """Wrapper for the ifx_Mda_C_t structure"""
     _fields_ = (('dimensions', c_uint32),
                 ('data', POINTER(Complex)),
                 ('shape', c_uint32 * IFX_MDA_MAX_DIM),
-                ('stride', c_uint32 * IFX_MDA_MAX_DIM),
+                ('stride', c_size_t * IFX_MDA_MAX_DIM),
                 ('flags', c_uint32),
                 )
 
@@ -155,6 +202,44 @@ class MdaComplex(Structure):
         arr.np_arr = np_arr  # avoid that memory of np_arr is freed
         return arr
 
+    @classmethod
+    def view_numpy(cls, np_arr: np.ndarray):
+        """Create ifx_Mda_C_t view of numpy array without copying it
+
+        The C library writes directly into the memory of np_arr, which must
+        be a writeable complex64 array in C order.
+        """
+        shape = np_arr.shape
+        dimensions = len(shape)
+        if dimensions > IFX_MDA_MAX_DIM:
+            raise ValueError("too many dimensions")
+        if np_arr.dtype != np.complex64 or not np_arr.flags.c_contiguous or not np_arr.flags.writeable:
+            raise ValueError("array must be a writeable complex64 array in C order")
+
+        data = np_arr.ctypes.data_as(POINTER(Complex))
+        arr = MdaComplex(dimensions, data, c_shape(shape), c_stride(shape), 0)
+        arr.np_arr = np_arr  # avoid that memory of np_arr is freed
+        return arr
+
+    @classmethod
+    def view_input(cls, np_arr: np.ndarray):
+        """Create ifx_Mda_C_t view of an input array
+
+        Like view_numpy, but for arrays only read by the C library: np_arr
+        is converted to a complex64 array in C order first, which copies it
+        only if it is not already one.
+        """
+        np_arr = np.ascontiguousarray(np_arr, dtype=np.complex64)
+        shape = np_arr.shape
+        dimensions = len(shape)
+        if dimensions > IFX_MDA_MAX_DIM:
+            raise ValueError("too many dimensions")
+
+        data = np_arr.ctypes.data_as(POINTER(Complex))
+        arr = MdaComplex(dimensions, data, c_shape(shape), c_stride(shape), 0)
+        arr.np_arr = np_arr  # avoid that memory of np_arr is freed
+        return arr
+
     def to_numpy(self) -> np.ndarray:
         """Convert ifx_Mda_C_t type to a numpy array"""
         shape = truncate_list_at_zero(self.shape)
@@ -29,6 +29,7 @@
 from ctypes import *
 from pathlib import Path
 import platform
+import threading
 
 
 __lib_path = Path(__file__).parent.parent.joinpath("lib")
@@ -46,18 +47,64 @@ def get_library_filename(name):
         raise RuntimeError(f"System '{__system}' not supported")
 
 
-def load_library(name: str) -> CDLL:
-    """Load SDK library and specify prototypes of common functions
+def _open_library(name: str) -> CDLL:
+    lib_path = __lib_path.joinpath(get_library_filename(name))
+    return CDLL(str(lib_path))
+
+
+class LazyLibrary():
+    """SDK library that is loaded when it is used the first time
+
+    Prototypes declared with declare_prototype are only recorded. The shared
+    library is loaded when the first of its functions is accessed, and each
+    function is set up by ctypes when it is accessed the first time. Importing
+    a wrapper therefore neither loads its library (and the libraries it
+    depends on) nor creates function objects for functions that are never
+    called, which keeps the start of short-lived scripts fast.
+    """
+
+    def __init__(self, name: str):
+        self._name = name
+        self._dll = None
+        self._prototypes = {}
+        self._lock = threading.Lock()
+
+    def _declare(self, function_name: str, argtypes, restype, errcheck) -> None:
+        self._prototypes[function_name] = (argtypes, restype, errcheck)
+
+    def _load(self) -> CDLL:
+        with self._lock:
+            if self._dll is None:
+                self._dll = _open_library(self._name)
+        return self._dll
+
+    def __getattr__(self, function_name: str):
+        # only called for functions that have not been accessed before
+        if function_name.startswith("_"):
+            raise AttributeError(function_name)
+
+        f = getattr(self._load(), function_name)
+        prototype = self._prototypes.get(function_name)
+        if prototype is not None:
+            f.argtypes, f.restype, errcheck = prototype
+            if errcheck:
+                f.errcheck = errcheck
+
+        # later accesses find the function without calling __getattr__
+        setattr(self, function_name, f)
+        return f
 
-    Load the SDK library and declare prototypes of SDK functions used by all
-    wrappers. If system is not supported or the shared library cannot be found,
-    an exception is raised.
+
+def load_library(name: str) -> LazyLibrary:
+    """Return SDK library which is loaded on first use
+
+    If system is not supported or the shared library cannot be found, an
+    exception is raised when the first function of the library is accessed.
 
     Parameters:
         name: Name of SDK library without suffix (e.g., radar_sdk)
     """
-    lib_path = __lib_path.joinpath(get_library_filename(name))
-    return CDLL(str(lib_path))
+    return LazyLibrary(name)
 
 
 def declare_prototype(dll: CDLL, function_name: str, argtypes, restype, errcheck = None) -> None:
@@ -72,14 +119,19 @@ def declare_prototype(dll: CDLL, function_name: str, argtypes, restype, errcheck
         argtypes: List of arguments or None if no arguments
         restype: Return type or None if function does not return a value
     """
+    # if argument errcheck has been specified, save it as static variable for future use
+    if errcheck:
+        declare_prototype.errcheck = errcheck
+    errcheck = getattr(declare_prototype, "errcheck", None)
+
+    if isinstance(dll, LazyLibrary):
+        dll._declare(function_name, argtypes, restype, errcheck)
+        return
+
     f = getattr(dll, function_name)
     f.restype = restype
     f.argtypes = argtypes
-
-    # if argument errcheck has been specified, save it as static variable for future use
     if errcheck:
-        declare_prototype.errcheck = errcheck
-    if hasattr(declare_prototype, "errcheck"):
-        f.errcheck = declare_prototype.errcheck
+        f.errcheck = errcheck
 
     setattr(dll, function_name, f)
@@ -163,6 +163,12 @@ class ErrorNotImplemented(ErrorApiBase):
     def __init__(self, error_description):
         super().__init__(0x10010, error_description)
 
+class ErrorAborted(ErrorApiBase):
+    '''An asynchronous request was cancelled before it completed (IFX_ERROR_ABORTED)
+    '''
+    def __init__(self, error_description):
+        super().__init__(0x10011, error_description)
+
 class ErrorNoDevice(ErrorDevBase):
     '''No device compatible to Radar SDK was found. (IFX_ERROR_NO_DEVICE)
     '''
@@ -471,6 +477,7 @@ error_mapping_exception = {
     65550: ErrorNotPossible,
     65551: ErrorMissingInterface,
     65552: ErrorNotImplemented,
+    65553: ErrorAborted,
     69632: ErrorNoDevice,
     69633: ErrorDeviceBusy,
     69634: ErrorCommunicationError,
@@ -29,11 +29,44 @@
 from ctypes import *
 import typing
 
-from .base_types import MdaComplex, MdaReal
+from .base_types import MdaComplex, MdaReal, ifxStructure
 from .cdll_helper import declare_prototype, load_library
+from .common_types import DeviceListEntry
 from .exceptions import get_exception
 
 
+class MemStats(ifxStructure):
+    """Allocation statistics (ifx_Mem_Stats_t)"""
+    _fields_ = (("num_allocs", c_uint64),
+                ("num_frees", c_uint64),
+                ("num_failed", c_uint64),
+                ("bytes", c_uint64),
+                ("peak_bytes", c_uint64),
+                )
+
+
+class MemModuleStats(ifxStructure):
+    """Allocation statistics of a module (ifx_Mem_Module_Stats_t)"""
+    _fields_ = (("module", c_char * 32),
+                ("num_allocs", c_uint64),
+                ("num_live", c_uint64),
+                ("bytes", c_uint64),
+                ("peak_bytes", c_uint64),
+                )
+
+
+class MemSiteStats(ifxStructure):
+    """Allocation statistics of a call site (ifx_Mem_Site_Stats_t)"""
+    _fields_ = (("file", c_char_p),
+                ("function", c_char_p),
+                ("line", c_int),
+                ("num_allocs", c_uint64),
+                ("num_live", c_uint64),
+                ("bytes", c_uint64),
+                ("peak_bytes", c_uint64),
+                )
+
+
 def check_error(result, func, arguments):
     """Raise exception on error or return the result
 
@@ -50,12 +83,21 @@ def check_error(result, func, arguments):
 
     error_code = _cdll.ifx_error_get_and_clear()
     if error_code:
-        error_description = _cdll.ifx_error_to_string(error_code).decode("ascii")
-        raise get_exception(error_code, error_description)
+        raise exception_from_error_code(error_code)
 
     return result
 
 
+def exception_from_error_code(error_code: int) -> Exception:
+    """Return the Python exception for an error code of the SDK
+
+    This is used for errors that are not reported through
+    ifx_error_get_and_clear(), e.g. errors passed to callbacks.
+    """
+    error_description = _cdll.ifx_error_to_string(error_code).decode("ascii")
+    return get_exception(error_code, error_description)
+
+
 def __load_cdll(errcheck : typing.Callable) -> CDLL:
     """Load SDK library and specify prototypes of common functions
 
@@ -88,6 +130,10 @@ def __load_cdll(errcheck : typing.Callable) -> CDLL:
 
     # memory management
     declare_prototype(dll, "ifx_mem_free", [c_void_p], None)
+    declare_prototype(dll, "ifx_mem_get_stats", [POINTER(MemStats)], None)
+    declare_prototype(dll, "ifx_mem_reset_stats", None, None)
+    declare_prototype(dll, "ifx_mem_get_module_stats", [POINTER(MemModuleStats), c_uint32], c_uint32)
+    declare_prototype(dll, "ifx_mem_get_site_stats", [POINTER(MemSiteStats), c_uint32], c_uint32)
 
     declare_prototype(dll, "ifx_uuid_to_string", [POINTER(c_uint8), c_char_p], None)
 
@@ -126,6 +172,22 @@ def move_ifx_list_to_python_list(ifx_list: c_void_p, func : typing.Callable) ->
     return result
 
 
+def get_sensor_uuids(func: typing.Callable, *args) -> typing.List[str]:
+    """Return uuids found by an ifx_*_get_sensor_list function
+
+    func fills a caller-provided array of DeviceListEntry and returns the
+    total number of boards found. If the array was too small the call is
+    repeated with an array of the returned size.
+    """
+    count = 16
+    while True:
+        entries = (DeviceListEntry * count)()
+        total = func(*args, entries, count)
+        if total <= count:
+            return [entries[i].uuid.decode("ascii") for i in range(total)]
+        count = total
+
+
 def ifx_mem_free(ptr):
     _cdll.ifx_mem_free(ptr)
 
@@ -136,3 +198,40 @@ def ifx_mda_destroy_r(mda):
 
 def ifx_mda_destroy_c(mda):
     _cdll.ifx_mda_destroy_c(mda)
+
+
+def get_memory_stats() -> dict:
+    """Return the allocation statistics of the SDK as dictionary"""
+    stats = MemStats()
+    _cdll.ifx_mem_get_stats(byref(stats))
+    return stats.to_dict()
+
+
+def reset_memory_stats() -> None:
+    """Reset the allocation counters and peaks to the current usage"""
+    _cdll.ifx_mem_reset_stats()
+
+
+def get_memory_module_stats() -> list:
+    """Return the allocation statistics per module
+
+    Returns a list of dictionaries, one per module (e.g., ifxAlgo). The list
+    is empty unless the SDK was built with SDK_MEMORY_TRACKING.
+    """
+    count = _cdll.ifx_mem_get_module_stats(None, 0)
+    stats = (MemModuleStats * count)()
+    count = min(count, _cdll.ifx_mem_get_module_stats(stats, count))
+    return [stats[i].to_dict(decode_byte_str=True) for i in range(count)]
+
+
+def get_memory_site_stats() -> list:
+    """Return the allocation statistics per call site
+
+    Returns a list of dictionaries with file, function, and line of the
+    call site. Call sites with num_live > 0 still hold memory. The list is
+    empty unless the SDK was built with SDK_MEMORY_TRACKING.
+    """
+    count = _cdll.ifx_mem_get_site_stats(None, 0)
+    stats = (MemSiteStats * count)()
+    count = min(count, _cdll.ifx_mem_get_site_stats(stats, count))
+    return [stats[i].to_dict(decode_byte_str=True) for i in range(count)]
@@ -42,8 +42,8 @@ from ..common.common_types import (
     RadarSensor,
     SensorInfo
 )
-from ..common.sdk_base import ifx_mda_destroy_r, move_ifx_list_to_python_list
-from .types import AdcConfig, BasebandConfig, TestSignalGeneratorConfig
+from ..common.sdk_base import ifx_mda_destroy_r, get_sensor_uuids
+from .types import AdcConfig, BasebandConfig, CwStreamStatistics, TestSignalGeneratorConfig
 
 
 class DeviceCw():
@@ -56,6 +56,7 @@ class DeviceCw():
         # declare prototypes such that ctypes knows the arguments and return types
         declare_prototype(dll, "ifx_cw_create", None, c_void_p)
         declare_prototype(dll, "ifx_cw_get_list", None, c_void_p)
+        declare_prototype(dll, "ifx_cw_get_sensor_list", [POINTER(DeviceListEntry), c_size_t], c_size_t)
         declare_prototype(dll, "ifx_cw_create_by_uuid", [c_char_p], c_void_p)
         declare_prototype(dll, "ifx_cw_create_dummy", [c_int], c_void_p)
         declare_prototype(dll, "ifx_cw_create_dummy_from_device", [c_void_p], c_void_p)
@@ -74,6 +75,11 @@ class DeviceCw():
         declare_prototype(dll, "ifx_cw_measure_temperature", [c_void_p], c_float)
         declare_prototype(dll, "ifx_cw_measure_tx_power", [c_void_p, c_uint32], c_float)
         declare_prototype(dll, "ifx_cw_capture_frame", [c_void_p, POINTER(MdaReal)], POINTER(MdaReal))
+        declare_prototype(dll, "ifx_cw_start_stream", [c_void_p, c_uint32], None)
+        declare_prototype(dll, "ifx_cw_stop_stream", [c_void_p], None)
+        declare_prototype(dll, "ifx_cw_is_streaming", [c_void_p], c_bool)
+        declare_prototype(dll, "ifx_cw_read_stream", [c_void_p, POINTER(MdaReal), c_uint32, c_uint32], POINTER(MdaReal))
+        declare_prototype(dll, "ifx_cw_get_stream_statistics", [c_void_p, POINTER(CwStreamStatistics)], None)
         declare_prototype(dll, "ifx_cw_get_sensor_information", [c_void_p], POINTER(SensorInfo))
         declare_prototype(dll, "ifx_cw_get_firmware_information", [c_void_p], POINTER(FirmwareInfo))
 
@@ -93,12 +99,7 @@ class DeviceCw():
         **Examples**
             uuids_all   = DeviceCw.get_list()
         """
-        uuids = []
-
-        ifx_list = cls._cdll.ifx_cw_get_list()
-
-        return move_ifx_list_to_python_list(ifx_list,
-                                            lambda p: cast(p, POINTER(DeviceListEntry)).contents.uuid.decode("ascii"))
+        return get_sensor_uuids(cls._cdll.ifx_cw_get_sensor_list)
 
     def __init__(self, uuid: typing.Optional[str] = None, sensor_type: typing.Optional[RadarSensor] = None,
                  handle: typing.Optional[c_void_p] = None):
@@ -250,6 +251,62 @@ class DeviceCw():
         ifx_mda_destroy_r(frame)
         return frame_numpy
 
+    def start_stream(self, capacity: int = 0) -> None:
+        """Start streaming RX signals into a ring buffer
+
+        Blocks are acquired continuously in the background until stop_stream
+        or stop_signal is called. Read them with read_stream. While streaming,
+        the configuration can't be changed and capture_frame is not possible.
+
+        Parameter:
+        - capacity: capacity of the ring buffer in samples per antenna,
+                    rounded up to a power of 2 and at least two frames."""
+        self._cdll.ifx_cw_start_stream(self.handle, capacity)
+
+    def stop_stream(self) -> None:
+        """Stop a stream started by start_stream"""
+        self._cdll.ifx_cw_stop_stream(self.handle)
+
+    def is_streaming(self) -> bool:
+        """Return True if a stream is active"""
+        return self._cdll.ifx_cw_is_streaming(self.handle)
+
+    def read_stream(self, out: typing.Optional[np.ndarray] = None, hop: int = 0, timeout_ms: int = 1000) -> np.ndarray:
+        """Read the next window of samples from the stream
+
+        The window holds one row of consecutive samples per enabled RX
+        antenna. After reading, the stream advances by hop samples (0: the
+        window length), so windows overlap for a hop smaller than the window
+        length. If blocks were dropped because the ring buffer was full, the
+        read raises an error and the next read continues after the gap.
+
+        Parameter:
+        - out: float32 array in C order of shape (num_rx_antennas, window
+               length) the window is written to. If None, a window of the
+               size of a frame of capture_frame is returned.
+        - hop: number of samples to advance
+        - timeout_ms: maximum time to wait for samples"""
+        if out is not None:
+            self._cdll.ifx_cw_read_stream(self.handle, MdaReal.view_numpy(out), hop, timeout_ms)
+            return out
+
+        window = self._cdll.ifx_cw_read_stream(self.handle, None, hop, timeout_ms)
+        window_numpy = window.contents.to_numpy()
+        ifx_mda_destroy_r(window)
+        return window_numpy
+
+    def get_stream_statistics(self) -> dict:
+        """Get the counters of the active stream
+
+        The dictionary holds the number of blocks and samples received, the
+        blocks and samples dropped because the ring buffer was full
+        (overruns, samples_dropped), and the capacity, current and maximum
+        fill level of the ring buffer in samples.
+        """
+        statistics = CwStreamStatistics()
+        self._cdll.ifx_cw_get_stream_statistics(self.handle, byref(statistics))
+        return statistics.to_dict()
+
     def __enter__(self):
         return self
 
@@ -75,3 +75,15 @@ class TestSignalGeneratorConfig(ifxStructure):
     _fields_ = (("mode", c_uint32),
                 ("frequency_Hz", c_float),
                 )
+
+
+class CwStreamStatistics(ifxStructure):
+    """Wrapper for structure ifx_Cw_Stream_Statistics_t"""
+    _fields_ = (("num_blocks", c_uint64),
+                ("num_samples", c_uint64),
+                ("overruns", c_uint64),
+                ("samples_dropped", c_uint64),
+                ("capacity", c_uint32),
+                ("fill_level", c_uint32),
+                ("high_water", c_uint32),
+                )
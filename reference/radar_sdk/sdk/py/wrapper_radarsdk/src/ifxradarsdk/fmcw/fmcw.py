@@ -28,11 +28,13 @@
 
 """Python wrapper for Infineon Radar sensors FMCW (frequency modulated continuous wave) operation"""
 
+import collections
 from ctypes import *
 import typing
 
 import numpy as np
 
+from ..common.base_types import MdaReal
 from ..common.cdll_helper import declare_prototype, load_library
 from ..common.common_types import (
     create_python_list_from_terminated_list,
@@ -41,14 +43,24 @@ from ..common.common_types import (
     RadarSensor,
     SensorInfo
 )
-from ..common.sdk_base import move_ifx_list_to_python_list
+from ..common.exceptions import error_mapping_exception, ErrorAborted
+from ..common.sdk_base import exception_from_error_code, get_sensor_uuids
 from .types import (
+    FmcwAcquisitionPolicy,
+    FmcwAsyncCallback,
+    FmcwBackpressure,
     FmcwElementType,
     FmcwFrame,
     FmcwMetrics,
+    FmcwRawFrame,
     FmcwSequenceChirp,
     FmcwSequenceElement,
-    FmcwSimpleSequenceConfig
+    FmcwSimpleSequenceConfig,
+    FmcwStatistics,
+    FmcwSyntheticScene,
+    FmcwSyntheticTarget,
+    FmcwThreadConfig,
+    FmcwThreadRole
 )
 
 
@@ -62,6 +74,8 @@ class DeviceFmcw():
         # declare prototypes such that ctypes knows the arguments and return types
         declare_prototype(dll, "ifx_fmcw_get_list", None, c_void_p)
         declare_prototype(dll, "ifx_fmcw_get_list_by_sensor_type", [c_int], c_void_p)
+        declare_prototype(dll, "ifx_fmcw_get_sensor_list", [POINTER(DeviceListEntry), c_size_t], c_size_t)
+        declare_prototype(dll, "ifx_fmcw_get_sensor_list_by_sensor_type", [c_int, POINTER(DeviceListEntry), c_size_t], c_size_t)
         declare_prototype(dll, "ifx_fmcw_create_simple_sequence", [POINTER(FmcwSimpleSequenceConfig)], POINTER(FmcwSequenceElement))
         declare_prototype(dll, "ifx_fmcw_metrics_from_sequence", [POINTER(FmcwSequenceElement), POINTER(FmcwMetrics)], None)
         declare_prototype(dll, "ifx_fmcw_sequence_from_metrics", [POINTER(FmcwMetrics), c_bool, POINTER(FmcwSequenceElement)], None)
@@ -70,12 +84,17 @@ class DeviceFmcw():
         declare_prototype(dll, "ifx_fmcw_create_by_port", [c_char_p], c_void_p)
         declare_prototype(dll, "ifx_fmcw_create_dummy", [c_void_p], c_void_p)
         declare_prototype(dll, "ifx_fmcw_create_dummy_from_device", [c_void_p], c_void_p)
+        declare_prototype(dll, "ifx_fmcw_create_playback", [c_int, c_char_p, c_int, c_bool], c_void_p)
+        declare_prototype(dll, "ifx_fmcw_create_synthetic", [c_int, POINTER(FmcwSyntheticScene), c_int], c_void_p)
+        declare_prototype(dll, "ifx_fmcw_set_synthetic_scene", [c_void_p, POINTER(FmcwSyntheticScene)], None)
         declare_prototype(dll, "ifx_fmcw_destroy", [c_void_p], None)
         declare_prototype(dll, "ifx_fmcw_destroy_sequence", [POINTER(FmcwSequenceElement)], None)
         declare_prototype(dll, "ifx_fmcw_save_register_file", [c_void_p, c_char_p], None)
+        declare_prototype(dll, "ifx_fmcw_save_register_profile", [c_void_p, c_char_p], None)
         declare_prototype(dll, "ifx_fmcw_load_register_file", [c_void_p, c_char_p], None)
         declare_prototype(dll, "ifx_fmcw_set_acquisition_sequence", [c_void_p, POINTER(FmcwSequenceElement)], None)
         declare_prototype(dll, "ifx_fmcw_get_acquisition_sequence", [c_void_p], POINTER(FmcwSequenceElement))
+        declare_prototype(dll, "ifx_fmcw_check_acquisition_sequences", [c_void_p, POINTER(POINTER(FmcwSequenceElement)), c_uint32, POINTER(c_int), POINTER(c_float)], None)
         declare_prototype(dll, "ifx_fmcw_get_board_uuid", [c_void_p], c_char_p)
         declare_prototype(dll, "ifx_fmcw_get_sensor_type", [c_void_p], RadarSensor)
         declare_prototype(dll, "ifx_fmcw_get_sensor_information", [c_void_p], POINTER(SensorInfo))
@@ -83,10 +102,29 @@ class DeviceFmcw():
         declare_prototype(dll, "ifx_fmcw_get_temperature", [c_void_p], c_float)
         declare_prototype(dll, "ifx_fmcw_start_acquisition", [c_void_p], None)
         declare_prototype(dll, "ifx_fmcw_stop_acquisition", [c_void_p], None)
+        declare_prototype(dll, "ifx_fmcw_set_acquisition_policy", [c_void_p, c_int, c_uint32], None)
+        declare_prototype(dll, "ifx_fmcw_get_acquisition_policy", [c_void_p], c_int)
+        declare_prototype(dll, "ifx_fmcw_get_slice_size", [c_void_p], c_uint32)
+        declare_prototype(dll, "ifx_fmcw_set_overflow_recovery", [c_void_p, c_bool], None)
+        declare_prototype(dll, "ifx_fmcw_get_overflow_recovery", [c_void_p], c_bool)
         declare_prototype(dll, "ifx_fmcw_get_next_frame", [c_void_p, POINTER(FmcwFrame)], None)
         declare_prototype(dll, "ifx_fmcw_get_next_frame_timeout", [c_void_p, POINTER(FmcwFrame), c_uint16], None)
+        declare_prototype(dll, "ifx_fmcw_get_next_frame_async", [c_void_p, POINTER(FmcwFrame), FmcwAsyncCallback, c_void_p], None)
+        declare_prototype(dll, "ifx_fmcw_cancel_async", [c_void_p], None)
+        declare_prototype(dll, "ifx_fmcw_get_next_frames", [c_void_p, POINTER(FmcwFrame), c_uint32, c_uint16], None)
+        declare_prototype(dll, "ifx_fmcw_get_next_raw_frames", [c_void_p, POINTER(FmcwRawFrame), c_uint32, c_uint16], None)
         declare_prototype(dll, "ifx_fmcw_allocate_frame", [c_void_p], POINTER(FmcwFrame))
         declare_prototype(dll, "ifx_fmcw_destroy_frame", [POINTER(FmcwFrame)], None)
+        declare_prototype(dll, "ifx_fmcw_allocate_raw_frame", [c_void_p], POINTER(FmcwRawFrame))
+        declare_prototype(dll, "ifx_fmcw_destroy_raw_frame", [POINTER(FmcwRawFrame)], None)
+        declare_prototype(dll, "ifx_fmcw_set_frame_ring_size", [c_void_p, c_uint32], None)
+        declare_prototype(dll, "ifx_fmcw_acquire_frame", [c_void_p, c_uint16], POINTER(FmcwFrame))
+        declare_prototype(dll, "ifx_fmcw_release_frame", [c_void_p, POINTER(FmcwFrame)], None)
+        declare_prototype(dll, "ifx_fmcw_get_statistics", [c_void_p, POINTER(FmcwStatistics)], None)
+        declare_prototype(dll, "ifx_fmcw_reset_statistics", [c_void_p], None)
+        declare_prototype(dll, "ifx_fmcw_set_thread_config", [c_int, POINTER(FmcwThreadConfig)], None)
+        declare_prototype(dll, "ifx_fmcw_get_thread_config", [c_int, POINTER(FmcwThreadConfig)], None)
+        declare_prototype(dll, "ifx_fmcw_set_thread_name_prefix", [c_char_p], None)
         declare_prototype(dll, "ifx_fmcw_get_element_duration", [c_void_p, POINTER(FmcwSequenceElement)], c_float)
         declare_prototype(dll, "ifx_fmcw_get_sequence_duration", [c_void_p, POINTER(FmcwSequenceElement)], c_float)
         declare_prototype(dll, "ifx_fmcw_get_minimum_chirp_repetition_time", [c_void_p, c_uint32, c_float], c_float)
@@ -117,15 +155,40 @@ class DeviceFmcw():
         Parameters:
             sensor_type: Sensor of type RadarSensor
         """
-        uuids = []
-
         if sensor_type == None:
-            ifx_list = cls._cdll.ifx_fmcw_get_list()
+            return get_sensor_uuids(cls._cdll.ifx_fmcw_get_sensor_list)
         else:
-            ifx_list = cls._cdll.ifx_fmcw_get_list_by_sensor_type(int(sensor_type))
+            return get_sensor_uuids(cls._cdll.ifx_fmcw_get_sensor_list_by_sensor_type, int(sensor_type))
+
+    @classmethod
+    def set_thread_config(cls, role: FmcwThreadRole, affinity_mask: int = 0, priority: int = 0,
+                          realtime: bool = False) -> None:
+        """Set the scheduling of internal threads of the given role
 
-        return move_ifx_list_to_python_list(ifx_list,
-                                            lambda p: cast(p, POINTER(DeviceListEntry)).contents.uuid.decode("ascii"))
+        The settings apply to all threads of the role started afterwards, the
+        threads reading the board data are started by start_acquisition.
+
+        Parameters:
+            role: Threads to configure
+            affinity_mask: Bit i allows CPU i, 0 keeps the default affinity
+            priority: Real-time priority if realtime is set, otherwise a
+                      nice value (Linux) or thread priority (Windows)
+            realtime: Use the SCHED_FIFO policy (Linux, needs CAP_SYS_NICE)
+        """
+        config = FmcwThreadConfig(affinity_mask, priority, realtime)
+        cls._cdll.ifx_fmcw_set_thread_config(int(role), byref(config))
+
+    @classmethod
+    def get_thread_config(cls, role: FmcwThreadRole) -> dict:
+        """Get the scheduling settings of internal threads of the given role"""
+        config = FmcwThreadConfig()
+        cls._cdll.ifx_fmcw_get_thread_config(int(role), byref(config))
+        return config.to_dict()
+
+    @classmethod
+    def set_thread_name_prefix(cls, prefix: str) -> None:
+        """Set the prefix of the names of internal threads started afterwards"""
+        cls._cdll.ifx_fmcw_set_thread_name_prefix(prefix.encode("ascii"))
 
     @classmethod
     def create_simple_sequence(cls, config: FmcwSimpleSequenceConfig) -> FmcwSequenceElement:
@@ -237,10 +300,60 @@ class DeviceFmcw():
             # ensures it is not truncated by integer handling in certain situations
             self.handle = c_void_p(h)
 
+        self._cube_shapes = None  # shapes of the frame cubes, cached for get_next_frame
+        self._num_raw_samples = None  # samples of a raw frame, cached for get_frames
+        self._ring_views = {}     # address of a ring frame -> (frame, numpy views of its cubes)
+        self._out_frames = {}     # ids of the arrays passed as out -> (arrays, frame viewing them)
+        self._last_frame = None   # C structure of the frame retrieved last, see get_frame_timestamps
+
     def create_dummy_from_device(self) -> 'DeviceFmcw':
         dummy_handle = self._cdll.ifx_fmcw_create_dummy_from_device(self.handle)
         return DeviceFmcw(handle=c_void_p(dummy_handle))
 
+    @classmethod
+    def create_playback(cls, filename: str, sensor_type: RadarSensor = RadarSensor.BGT60TR13C,
+                        real_time: bool = True, loop: bool = False) -> 'DeviceFmcw':
+        """Create a device that plays back a capture of the firmware's binary frame stream
+
+        The acquisition sequence must be set to the one the capture was
+        recorded with. With real_time frames are delivered at their recorded
+        intervals, otherwise as fast as they are fetched; with loop the
+        playback restarts after the last frame, otherwise fetching fails at
+        the end of the file.
+        """
+        h = cls._cdll.ifx_fmcw_create_playback(int(sensor_type), filename.encode("utf-8"), 0 if real_time else 1, loop)
+        return DeviceFmcw(handle=c_void_p(h))
+
+    @staticmethod
+    def _synthetic_scene(targets: typing.Sequence[FmcwSyntheticTarget], noise_amplitude: float,
+                         coupling_amplitude: float, seed: int) -> FmcwSyntheticScene:
+        target_array = (FmcwSyntheticTarget * len(targets))(*targets)
+        return FmcwSyntheticScene(target_array, len(targets), noise_amplitude, coupling_amplitude, seed)
+
+    @classmethod
+    def create_synthetic(cls, targets: typing.Sequence[FmcwSyntheticTarget] = (),
+                         sensor_type: RadarSensor = RadarSensor.BGT60TR13C, noise_amplitude: float = 0.01,
+                         coupling_amplitude: float = 0.0, seed: int = 0, real_time: bool = True) -> 'DeviceFmcw':
+        """Create a device that generates frames of a synthetic scene
+
+        The frames hold the IF signals of the point targets, the TX to RX
+        leakage and white noise for the configured acquisition sequence.
+        With real_time frames are delivered at the frame repetition time,
+        otherwise as fast as they are fetched.
+
+        Example:
+            dev = DeviceFmcw.create_synthetic([FmcwSyntheticTarget(1.5, 0.5, 20.0, 0.1)])
+        """
+        scene = cls._synthetic_scene(targets, noise_amplitude, coupling_amplitude, seed)
+        h = cls._cdll.ifx_fmcw_create_synthetic(int(sensor_type), byref(scene), 0 if real_time else 1)
+        return DeviceFmcw(handle=c_void_p(h))
+
+    def set_synthetic_scene(self, targets: typing.Sequence[FmcwSyntheticTarget], noise_amplitude: float = 0.01,
+                            coupling_amplitude: float = 0.0, seed: int = 0) -> None:
+        """Replace the scene of a device created by create_synthetic"""
+        scene = self._synthetic_scene(targets, noise_amplitude, coupling_amplitude, seed)
+        self._cdll.ifx_fmcw_set_synthetic_scene(self.handle, byref(scene))
+
     def get_firmware_information(self) -> dict:
         """Gets information about the firmware of a connected device"""
         info_p = self._cdll.ifx_fmcw_get_firmware_information(self.handle)
@@ -282,16 +395,32 @@ class DeviceFmcw():
         filename_buffer_p = c_char_p(filename_buffer)
         self._cdll.ifx_fmcw_save_register_file(self.handle, filename_buffer_p)
 
+    def save_register_profile(self, filename: str) -> None:
+        """Save register list to a binary profile
+
+        The profile can be loaded with load_register_file."""
+        filename_buffer = filename.encode("ascii")
+        filename_buffer_p = c_char_p(filename_buffer)
+        self._cdll.ifx_fmcw_save_register_profile(self.handle, filename_buffer_p)
+
     def load_register_file(self, filename: str) -> None:
         """Load register list from a file"""
         filename_buffer = filename.encode("ascii")
         filename_buffer_p = c_char_p(filename_buffer)
         self._cdll.ifx_fmcw_load_register_file(self.handle, filename_buffer_p)
+        self._cube_shapes = None
+        self._num_raw_samples = None
+        self._ring_views = {}
+        self._out_frames = {}
 
     def set_acquisition_sequence(self, first_element: FmcwSequenceElement) -> None:
         """This function tries to configure the radar device to generate the specified
          acquisition sequence"""
         self._cdll.ifx_fmcw_set_acquisition_sequence(self.handle, byref(first_element))
+        self._cube_shapes = None
+        self._num_raw_samples = None
+        self._ring_views = {}
+        self._out_frames = {}
 
     def get_acquisition_sequence(self) -> FmcwSequenceElement:
         """This function returns the first element of the currently configured
@@ -299,6 +428,21 @@ class DeviceFmcw():
         first_element = self._cdll.ifx_fmcw_get_acquisition_sequence(self.handle)
         return first_element.contents
 
+    def check_acquisition_sequences(self, sequences: typing.Sequence[FmcwSequenceElement]) -> typing.List[typing.Tuple[int, float]]:
+        """Check which acquisition sequences can be applied to the device
+
+        Returns for each sequence a tuple of the error code set_acquisition_sequence
+        would raise (0 if the sequence is feasible) and the sequence duration in
+        seconds. The configuration of the device is not changed. Checked sequences
+        are cached, so applying one of them afterwards is fast.
+        """
+        num_sequences = len(sequences)
+        first_elements = (POINTER(FmcwSequenceElement) * num_sequences)(*[pointer(s) for s in sequences])
+        errors = (c_int * num_sequences)()
+        durations = (c_float * num_sequences)()
+        self._cdll.ifx_fmcw_check_acquisition_sequences(self.handle, first_elements, num_sequences, errors, durations)
+        return [(int(errors[i]), float(durations[i])) for i in range(num_sequences)]
+
     def get_element_duration(self, element: FmcwSequenceElement) -> float:
         """Get duration of a single sequence element
         Returns the wait_time of a delay, the calculated duration of a single chirp,
@@ -350,7 +494,69 @@ class DeviceFmcw():
         """
         self._cdll.ifx_fmcw_stop_acquisition(self.handle)
 
-    def get_next_frame(self, timeout_ms: typing.Optional[int] = None) -> np.ndarray:
+    def set_acquisition_policy(self, policy: FmcwAcquisitionPolicy, slice_size: int = 0) -> None:
+        """Set how time domain data is split into slices
+
+        MAX_THROUGHPUT (default) may pack several frames into one slice,
+        MIN_LATENCY delivers every frame as soon as it is complete and
+        FRAME_ALIGNED sends every frame in exactly one slice. With SLICE_SIZE
+        the slice size in samples is given by slice_size.
+
+        A running acquisition is stopped, the next fetched frame restarts it
+        with the new slice size.
+
+        **Examples**
+            device.set_acquisition_policy(FmcwAcquisitionPolicy.FRAME_ALIGNED)
+            device.set_acquisition_policy(FmcwAcquisitionPolicy.SLICE_SIZE, 1024)
+
+        Parameters:
+            policy:     Acquisition policy
+            slice_size: Slice size in samples, only used with SLICE_SIZE
+        """
+        self._cdll.ifx_fmcw_set_acquisition_policy(self.handle, int(policy), slice_size)
+
+    def get_acquisition_policy(self) -> FmcwAcquisitionPolicy:
+        """Return the acquisition policy"""
+        return FmcwAcquisitionPolicy(self._cdll.ifx_fmcw_get_acquisition_policy(self.handle))
+
+    def set_overflow_recovery(self, enabled: bool) -> None:
+        """Recover from sensor FIFO overflows in place
+
+        With recovery enabled a FIFO overflow flushes the FIFO and restarts
+        the sequencer with the registers already programmed instead of
+        raising an error; only the frame being received is lost. Recovered
+        overflows are counted in get_statistics() (fifo_overflows,
+        overflow_recoveries).
+
+        Parameters:
+            enabled: True to recover, False to raise the error (default)
+        """
+        self._cdll.ifx_fmcw_set_overflow_recovery(self.handle, enabled)
+
+    def get_overflow_recovery(self) -> bool:
+        """Return whether FIFO overflows are recovered in place"""
+        return bool(self._cdll.ifx_fmcw_get_overflow_recovery(self.handle))
+
+    def get_slice_size(self) -> int:
+        """Return the number of samples per slice for the current sequence and policy"""
+        return int(self._cdll.ifx_fmcw_get_slice_size(self.handle))
+
+    def allocate_frame(self) -> typing.List[np.ndarray]:
+        """Allocate arrays for a frame of time domain data
+
+        Returns a list of uninitialized float32 arrays, one for each cube of
+        the current acquisition sequence, that can be passed to get_next_frame
+        as out. Reusing them avoids allocating memory for every frame.
+        """
+        if self._cube_shapes is None:
+            frame = self._cdll.ifx_fmcw_allocate_frame(self.handle)
+            self._cube_shapes = [tuple(cube.contents.as_numpy_view().shape) for cube in frame.contents.cubes[:frame.contents.num_cubes]]
+            self._cdll.ifx_fmcw_destroy_frame(frame)
+
+        return [np.empty(shape, dtype=np.float32) for shape in self._cube_shapes]
+
+    def get_next_frame(self, timeout_ms: typing.Optional[int] = None,
+                       out: typing.Optional[typing.List[np.ndarray]] = None) -> typing.List[np.ndarray]:
         """Retrieve next frame of time domain data from device
 
         Retrieve the next complete frame of time domain data from the connected
@@ -369,21 +575,262 @@ class DeviceFmcw():
 
         If timeout_ms is given, the exception ErrorTimeout is raised if a
         complete frame is not available within timeout_ms milliseconds.
+
+        If out is given, the frame is written into these arrays, as returned
+        by allocate_frame, and out is returned. Otherwise new arrays are
+        allocated. In both cases the data is written directly into the
+        arrays without intermediate copies.
+        """
+        if out is None:
+            out = self.allocate_frame()
+
+        self.get_next_frame_into(out, timeout_ms)
+        return out
+
+    def get_next_frame_into(self, out: typing.List[np.ndarray], timeout_ms: typing.Optional[int] = None) -> None:
+        """Retrieve next frame of time domain data into the given arrays
+
+        Like get_next_frame, but out is mandatory. The C frame structure
+        viewing the arrays of out is kept, so calling this repeatedly with the
+        same arrays (e.g. a small pool of frames from allocate_frame) neither
+        allocates memory nor creates ctypes objects per frame.
         """
-        frame = self._cdll.ifx_fmcw_allocate_frame(self.handle)
+        frame = self._out_frame(out)
         if timeout_ms:
-            self._cdll.ifx_fmcw_get_next_frame_timeout(self.handle, frame, timeout_ms)
+            self._cdll.ifx_fmcw_get_next_frame_timeout(self.handle, byref(frame), timeout_ms)
         else:
-            self._cdll.ifx_fmcw_get_next_frame(self.handle, frame)
+            self._cdll.ifx_fmcw_get_next_frame(self.handle, byref(frame))
+        self._last_frame = frame
+
+    async def frames(self, num_buffers: int = 3,
+                     backpressure: FmcwBackpressure = FmcwBackpressure.DROP_OLDEST) -> typing.AsyncIterator[typing.List[np.ndarray]]:
+        """Iterate asynchronously over the frames of time domain data
+
+        Usage::
+
+            async for frame in device.frames():
+                process(frame)
+
+        Frames are requested with ifx_fmcw_get_next_frame_async into a pool
+        of num_buffers frames (at least 2). Completions are handed to the
+        running event loop with call_soon_threadsafe, which wakes the loop
+        through its self-pipe, so neither a thread per device nor polling is
+        needed and many devices can be served by one loop.
+
+        The yielded arrays belong to the pool and are only valid until the
+        next iteration; copy them to keep them longer.
 
-        # convert each cube to a multi-dimensional np array
-        frame_contents = list()
-        for index in range(0, int(frame.contents.num_cubes)):
-            cube = frame.contents.cubes[index].contents.to_numpy()
-            frame_contents.append(cube)
+        If the consumer falls behind and all other buffers hold unconsumed
+        frames, DROP_OLDEST requests the next frame into the oldest of them,
+        while BLOCK stops the acquisition until the consumer takes the next
+        frame. Frames arriving without a requested buffer are dropped by the
+        SDK and counted in get_statistics.
+
+        Pending requests are cancelled when the iteration ends, e.g. by break
+        or when the task is cancelled.
+        """
+        if num_buffers < 2:
+            raise ValueError("num_buffers must be at least 2")
+
+        import asyncio  # imported here, it takes longer to import than the rest of the package
+
+        loop = asyncio.get_running_loop()
+        buffers = [self.allocate_frame() for _ in range(num_buffers)]
+        frames = [self._out_frame(buffer) for buffer in buffers]
+
+        aborted = next(code for code, exception in error_mapping_exception.items() if exception is ErrorAborted)
+        ready = collections.deque()  # (index, error) of completed requests in order of completion
+        state = {"pending": 0, "paused": False, "closing": False, "waiter": None}
+
+        def submit(index):
+            self._cdll.ifx_fmcw_get_next_frame_async(self.handle, byref(frames[index]), callback, index + 1)
+            state["pending"] += 1
+            if state["paused"]:
+                state["paused"] = False
+                self.start_acquisition()
+
+        def on_complete(index, error):
+            state["pending"] -= 1
+            if state["closing"] or error == aborted:
+                return
+            ready.append((index, error))
+
+            if state["pending"] == 0 and not error:
+                if backpressure == FmcwBackpressure.BLOCK:
+                    self.stop_acquisition()
+                    state["paused"] = True
+                elif len(ready) > 1:
+                    submit(ready.popleft()[0])
+
+            waiter = state["waiter"]
+            if waiter is not None and not waiter.done():
+                waiter.set_result(None)
+
+        def on_frame(frame, error, user_data):
+            # called on the bridge thread of the SDK, which must not be blocked
+            if not state["closing"]:
+                loop.call_soon_threadsafe(on_complete, user_data - 1, error)
+
+        # kept referenced until the requests are cancelled
+        callback = FmcwAsyncCallback(on_frame)
+
+        held = None
+        try:
+            for index in range(num_buffers):
+                submit(index)
+
+            while True:
+                if held is not None:
+                    submit(held)
+                    held = None
+
+                while not ready:
+                    state["waiter"] = loop.create_future()
+                    await state["waiter"]
+                state["waiter"] = None
+
+                held, error = ready.popleft()
+                if error:
+                    raise exception_from_error_code(error)
+
+                self._last_frame = frames[held]
+                yield buffers[held]
+        finally:
+            state["closing"] = True
+            self._cdll.ifx_fmcw_cancel_async(self.handle)
+            if state["paused"]:
+                self.start_acquisition()
+
+    def get_frames(self, num_frames: int, timeout_ms: int = 10000, raw: bool = False) -> typing.Union[typing.List[np.ndarray], np.ndarray]:
+        """Retrieve the next num_frames frames with a single call
+
+        The frames are written into stacked arrays: for each cube of the
+        acquisition sequence an array of shape (num_frames,) + cube shape,
+        e.g. (num_frames, num_rx, num_chirps, num_samples), is returned.
+
+        If raw is True, the raw interleaved samples are returned instead as a
+        single uint16 array of shape (num_frames, num_samples_per_frame).
+
+        The interpreter lock is released for the whole batch while the C
+        library waits for the frames, so other Python threads keep running.
+        timeout_ms applies to each frame.
+        """
+        if raw:
+            if self._num_raw_samples is None:
+                frame = self._cdll.ifx_fmcw_allocate_raw_frame(self.handle)
+                self._num_raw_samples = frame.contents.num_samples
+                self._cdll.ifx_fmcw_destroy_raw_frame(frame)
+
+            out = np.empty((num_frames, self._num_raw_samples), dtype=np.uint16)
+            frames = (FmcwRawFrame * num_frames)()
+            for i in range(num_frames):
+                frames[i] = FmcwRawFrame(self._num_raw_samples, out[i].ctypes.data_as(POINTER(c_uint16)))
+            self._cdll.ifx_fmcw_get_next_raw_frames(self.handle, frames, num_frames, timeout_ms)
+            self._last_frame = frames[num_frames - 1] if num_frames else None
+            return out
+
+        shapes = [cube.shape for cube in self.allocate_frame()]
+        out = [np.empty((num_frames,) + shape, dtype=np.float32) for shape in shapes]
+        views = []  # keeps the MdaReal views referenced until the call returned
+        frames = (FmcwFrame * num_frames)()
+        for i in range(num_frames):
+            cubes = (POINTER(MdaReal) * len(out))(*[pointer(MdaReal.view_numpy(stack[i])) for stack in out])
+            views.append(cubes)
+            frames[i] = FmcwFrame(len(out), cubes)
+        self._cdll.ifx_fmcw_get_next_frames(self.handle, frames, num_frames, timeout_ms)
+        self._last_frame = frames[num_frames - 1] if num_frames else None
+        return out
+
+    def _out_frame(self, out: typing.List[np.ndarray]) -> FmcwFrame:
+        """Return a FmcwFrame viewing the arrays of out, cached by their identity"""
+        key = tuple(id(cube) for cube in out)
+        entry = self._out_frames.get(key)
+        # the entry keeps the arrays alive, so their ids cannot be reused while cached
+        if entry is None:
+            views = [pointer(MdaReal.view_numpy(cube)) for cube in out]
+            frame = FmcwFrame(len(views), (POINTER(MdaReal) * len(views))(*views))
+            if len(self._out_frames) >= 16:
+                self._out_frames.clear()
+            entry = (list(out), frame)
+            self._out_frames[key] = entry
+        return entry[1]
+
+    def set_frame_ring_size(self, num_frames: int) -> None:
+        """Set the number of frames in the ring used by acquire_frame
+
+        Frames acquired from a previous ring must not be used anymore.
+        """
+        self._cdll.ifx_fmcw_set_frame_ring_size(self.handle, num_frames)
+        self._ring_views = {}
+
+    def acquire_frame(self, timeout_ms: int = 10000) -> typing.List[np.ndarray]:
+        """Retrieve the next frame into a frame of the device's ring
+
+        Like get_next_frame, but the frame is written into memory owned by
+        the device, and the returned arrays are views of that memory. The
+        views of a ring frame are created once, so in steady state neither
+        memory is allocated nor data copied. The frame must be returned with
+        release_frame; the arrays are overwritten by later frames afterwards.
+
+        Example:
+            frame = dev.acquire_frame()
+            process(frame)
+            dev.release_frame(frame)
+        """
+        frame = self._cdll.ifx_fmcw_acquire_frame(self.handle, timeout_ms)
+        address = addressof(frame.contents)
+        entry = self._ring_views.get(address)
+        if entry is None:
+            views = [cube.contents.as_numpy_view() for cube in frame.contents.cubes[:frame.contents.num_cubes]]
+            entry = (frame, views)
+            self._ring_views[address] = entry
+        self._last_frame = frame.contents
+        return entry[1]
+
+    def release_frame(self, frame: typing.List[np.ndarray]) -> None:
+        """Return a frame retrieved by acquire_frame to the ring"""
+        for ring_frame, views in self._ring_views.values():
+            if views is frame:
+                self._cdll.ifx_fmcw_release_frame(self.handle, ring_frame)
+                return
+        raise ValueError("frame was not acquired from this device")
+
+    def get_frame_timestamps(self) -> dict:
+        """Get the timestamps of the frame retrieved last
+
+        Returns the timestamps of the last frame returned by get_next_frame,
+        get_next_frame_into, get_frames or acquire_frame in microseconds since
+        the Unix epoch: the device time of the data slice completing the frame
+        (device_us, 0 if the firmware does not provide timestamps), the host
+        time when that slice was received (received_us), and the host time
+        when the frame was handed over (delivered_us). The difference of the
+        host times is the latency added by the host side of the SDK.
+        """
+        if self._last_frame is None:
+            raise ValueError("no frame has been retrieved")
+        frame = self._last_frame
+        return {"device_us": frame.timestamp_device_us,
+                "received_us": frame.timestamp_received_us,
+                "delivered_us": frame.timestamp_delivered_us}
+
+    def get_statistics(self) -> dict:
+        """Get the counters of the data received from the board
+
+        The dictionary holds the number of slices, bytes and frames received,
+        the frames lost by cause (frames_dropped, pool_depleted, queue_trimmed,
+        fifo_overflows, other_errors), the overflows recovered in place
+        (overflow_recoveries), the maximum number of slices waiting in
+        the frame queue (queue_high_water), and the time from receiving the
+        first slice of a frame until its delivery (latency_last_s,
+        latency_mean_s, latency_max_s).
+        """
+        statistics = FmcwStatistics()
+        self._cdll.ifx_fmcw_get_statistics(self.handle, byref(statistics))
+        return statistics.to_dict()
 
-        self._cdll.ifx_fmcw_destroy_frame(frame)
-        return frame_contents
+    def reset_statistics(self) -> None:
+        """Reset the counters returned by get_statistics"""
+        self._cdll.ifx_fmcw_reset_statistics(self.handle)
 
     def __enter__(self):
         return self
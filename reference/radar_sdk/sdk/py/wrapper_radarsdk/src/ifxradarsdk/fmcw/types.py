@@ -42,6 +42,71 @@ class FmcwFrame(ifxStructure):
     """Wrapper for structure ifx_Fmcw_Frame_t"""
     _fields_ = (("num_cubes", c_uint32),
                 ("cubes", POINTER(POINTER(MdaReal))),
+                ("timestamp_device_us", c_uint64),
+                ("timestamp_received_us", c_uint64),
+                ("timestamp_delivered_us", c_uint64),
+                )
+
+
+# void (*ifx_Fmcw_Async_Callback_t)(ifx_Fmcw_Frame_t* frame, ifx_Error_t error, void* user_data)
+FmcwAsyncCallback = CFUNCTYPE(None, POINTER(FmcwFrame), c_int, c_void_p)
+
+
+class FmcwRawFrame(ifxStructure):
+    """Wrapper for structure ifx_Fmcw_Raw_Frame_t"""
+    _fields_ = (("num_samples", c_uint32),
+                ("samples", POINTER(c_uint16)),
+                ("timestamp_device_us", c_uint64),
+                ("timestamp_received_us", c_uint64),
+                ("timestamp_delivered_us", c_uint64),
+                )
+
+
+class FmcwStatistics(ifxStructure):
+    """Wrapper for structure ifx_Fmcw_Statistics_t"""
+    _fields_ = (("num_slices", c_uint64),
+                ("num_bytes", c_uint64),
+                ("num_frames", c_uint64),
+                ("frames_dropped", c_uint64),
+                ("pool_depleted", c_uint64),
+                ("queue_trimmed", c_uint64),
+                ("fifo_overflows", c_uint64),
+                ("overflow_recoveries", c_uint64),
+                ("other_errors", c_uint64),
+                ("queue_high_water", c_uint32),
+                ("latency_last_s", c_float),
+                ("latency_mean_s", c_float),
+                ("latency_max_s", c_float),
+                )
+
+
+class FmcwAcquisitionPolicy(IntEnum):
+    """How time domain data is split into slices (ifx_Fmcw_Acquisition_Policy_t)"""
+    MAX_THROUGHPUT = 0  # several frames per slice, slice rate of about 20 Hz (default)
+    MIN_LATENCY = 1     # largest slices ending at frame boundaries
+    FRAME_ALIGNED = 2   # exactly one frame per slice
+    SLICE_SIZE = 3      # explicit slice size in samples
+
+
+class FmcwBackpressure(IntEnum):
+    """What DeviceFmcw.frames does when the consumer falls behind"""
+    DROP_OLDEST = 0  # the oldest frame not yet consumed is overwritten, the acquisition continues
+    BLOCK = 1        # the acquisition is paused until the consumer takes the next frame
+
+
+class FmcwThreadRole(IntEnum):
+    """Internal threads with common scheduling settings (ifx_Fmcw_Thread_Role_t)"""
+    DATA = 0         # threads reading the data of a board
+    FORWARDING = 1   # threads delivering slices and frames
+    ACQUISITION = 2  # threads reading frames for servers and device groups
+    PROCESSING = 3   # worker threads of processing chains and publishers
+
+
+class FmcwThreadConfig(ifxStructure):
+    """Wrapper for structure ifx_Fmcw_Thread_Config_t"""
+    _fields_ = (("affinity_mask", c_uint64),
+                ("priority", c_int32),
+                ("realtime", c_bool),
                 )
 
 
@@ -124,6 +189,25 @@ class FmcwMetrics(ifxStructure):
                 )
 
 
+class FmcwSyntheticTarget(ifxStructure):
+    """Wrapper for structure ifx_Fmcw_Synthetic_Target_t"""
+    _fields_ = (("range_m", c_float),
+                ("velocity_m_s", c_float),
+                ("angle_deg", c_float),
+                ("amplitude", c_float),
+                )
+
+
+class FmcwSyntheticScene(ifxStructure):
+    """Wrapper for structure ifx_Fmcw_Synthetic_Scene_t"""
+    _fields_ = (("targets", POINTER(FmcwSyntheticTarget)),
+                ("num_targets", c_uint32),
+                ("noise_amplitude", c_float),
+                ("coupling_amplitude", c_float),
+                ("seed", c_uint32),
+                )
+
+
 def create_dict_from_sequence_recursive(first_element: FmcwSequenceElement) -> dict:
     sequence = list()
     element = first_element
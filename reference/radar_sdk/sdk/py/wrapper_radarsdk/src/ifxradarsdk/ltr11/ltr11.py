@@ -41,7 +41,7 @@ from ..common.common_types import (
     FirmwareInfo,
     SensorInfo
 )
-from ..common.sdk_base import ifx_mda_destroy_c, move_ifx_list_to_python_list
+from ..common.sdk_base import get_sensor_uuids
 from .types import (
     GenericLimits,
     Ltr11Config,
@@ -63,6 +63,7 @@ class DeviceLtr11():
         declare_prototype(dll, "ifx_ltr11_destroy", [c_void_p], None)
         declare_prototype(dll, "ifx_ltr11_create_by_uuid", [c_void_p], c_void_p)
         declare_prototype(dll, "ifx_ltr11_get_list", None, c_void_p)
+        declare_prototype(dll, "ifx_ltr11_get_sensor_list", [POINTER(DeviceListEntry), c_size_t], c_size_t)
         declare_prototype(dll, "ifx_ltr11_get_config_defaults", [c_void_p, POINTER(Ltr11Config)], None)
         declare_prototype(dll, "ifx_ltr11_get_config", [c_void_p, POINTER(Ltr11Config)], None)
         declare_prototype(dll, "ifx_ltr11_set_config", [c_void_p, POINTER(Ltr11Config)], None)
@@ -95,10 +96,7 @@ class DeviceLtr11():
             uuids_all   = Device.get_list()
         """
 
-        ifx_list = cls._cdll.ifx_ltr11_get_list()
-
-        return move_ifx_list_to_python_list(ifx_list,
-                                            lambda p: cast(p, POINTER(DeviceListEntry)).contents.uuid.decode("ascii"))
+        return get_sensor_uuids(cls._cdll.ifx_ltr11_get_sensor_list)
 
     def __init__(self, uuid: typing.Optional[str] = None):
         """Create and initialize Ltr11 controller
@@ -208,7 +206,8 @@ class DeviceLtr11():
         """
         self._cdll.ifx_ltr11_stop_acquisition(self.handle)
 
-    def get_next_frame(self, timeout_ms: typing.Optional[int] = None) -> typing.Tuple[np.ndarray, Ltr11Metadata]:
+    def get_next_frame(self, timeout_ms: typing.Optional[int] = None,
+                       out: typing.Optional[np.ndarray] = None) -> typing.Tuple[np.ndarray, Ltr11Metadata]:
         """Retrieve next frame of time domain data from LTR11 device.
 
         Retrieve the next complete frame of time domain data from the connected
@@ -221,20 +220,27 @@ class DeviceLtr11():
 
         If timeout_ms is given, the exception ErrorTimeout is raised if a
         complete frame is not available within timeout_ms milliseconds.
+
+        If out is given, the frame is written into it and out is returned.
+        It must be a complex64 array of num_of_samples elements; reusing it
+        for a stream of frames avoids allocating memory for every frame.
+        Otherwise a new array is allocated. In both cases the samples are
+        written directly into the array without intermediate copies.
         """
         metadata = Ltr11Metadata()
 
+        if out is None:
+            out = np.empty(self.get_config().num_of_samples, dtype=np.complex64)
+        frame = MdaComplex.view_numpy(out)
+
         if timeout_ms:
-            frame = self._cdll.ifx_ltr11_get_next_frame_timeout(
-                self.handle, None, byref(metadata), timeout_ms)
+            self._cdll.ifx_ltr11_get_next_frame_timeout(
+                self.handle, byref(frame), byref(metadata), timeout_ms)
         else:
-            frame = self._cdll.ifx_ltr11_get_next_frame(
-                self.handle, None, byref(metadata))
-
-        frame_numpy = frame.contents.to_numpy()
-        ifx_mda_destroy_c(frame)
+            self._cdll.ifx_ltr11_get_next_frame(
+                self.handle, byref(frame), byref(metadata))
 
-        return frame_numpy, metadata
+        return out, metadata
 
     def get_active_mode_power(self, config: Ltr11Config) -> float:
         """ Return the power in active mode for a given configuration. 
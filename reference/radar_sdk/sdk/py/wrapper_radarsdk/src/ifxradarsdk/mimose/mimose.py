@@ -36,7 +36,7 @@ import numpy as np
 from ..common.base_types import MdaComplex
 from ..common.cdll_helper import load_library, declare_prototype
 from ..common.sdk_base import ifx_mda_destroy_c
-from .types import ifx_Mimose_Config_t, MimoseMetadata, ifx_Mimose_Config_Limits_t, ifx_Mimose_RF_Band_t, ifx_Mimose_Frame_Config_t
+from .types import ifx_Mimose_Config_t, MimoseMetadata, ifx_Mimose_Config_Limits_t, ifx_Mimose_RF_Band_t, ifx_Mimose_Frame_Config_t, IFX_MIMOSE_RC_LUT_SIZE
 
 
 
@@ -58,6 +58,8 @@ class DeviceMimose():
         declare_prototype(dll, "ifx_mimose_start_acquisition", [c_void_p], None)
         declare_prototype(dll, "ifx_mimose_stop_acquisition", [c_void_p], None)
         declare_prototype(dll, "ifx_mimose_update_rc_lut", [c_void_p], None)
+        declare_prototype(dll, "ifx_mimose_get_rc_lut", [c_void_p, POINTER(c_float)], None)
+        declare_prototype(dll, "ifx_mimose_set_rc_lut", [c_void_p, POINTER(c_float)], None)
         declare_prototype(dll, "ifx_mimose_get_register_value", [c_void_p, c_short], c_short)
         declare_prototype(dll, "ifx_mimose_set_registers", [c_void_p, POINTER(c_uint32), c_size_t], None)
         declare_prototype(dll, "ifx_mimose_get_next_frame", [c_void_p, POINTER(MdaComplex), POINTER(MimoseMetadata)], POINTER(MdaComplex))
@@ -247,6 +249,22 @@ class DeviceMimose():
         RC Look up table (LUT) which can have device and environment specific variations.
         """
         self._cdll.ifx_mimose_update_rc_lut(self.handle)
+
+    def get_rc_lut(self) -> typing.List[float]:
+        """Return the RC look up table
+
+        The table can be stored and restored with set_rc_lut after a restart
+        instead of running update_rc_lut again.
+        """
+        lut = (c_float * IFX_MIMOSE_RC_LUT_SIZE)()
+        self._cdll.ifx_mimose_get_rc_lut(self.handle, lut)
+        return list(lut)
+
+    def set_rc_lut(self, lut: typing.Sequence[float]) -> None:
+        """Set the RC look up table, e.g. one returned by get_rc_lut before"""
+        if len(lut) != IFX_MIMOSE_RC_LUT_SIZE:
+            raise ValueError("lut must have %d entries" % IFX_MIMOSE_RC_LUT_SIZE)
+        self._cdll.ifx_mimose_set_rc_lut(self.handle, (c_float * IFX_MIMOSE_RC_LUT_SIZE)(*lut))
 #
 #    def register_dump_to_file(self, filename: str) -> None:
 #        """Dump register list to a file"""
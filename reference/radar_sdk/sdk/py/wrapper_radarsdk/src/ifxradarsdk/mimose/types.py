@@ -37,6 +37,8 @@ from enum import IntEnum
 
 from ..common.base_types import ifxStructure
 
+IFX_MIMOSE_RC_LUT_SIZE = 32  # number of entries of the RC look up table
+
 
 class ifx_Mimose_Pulse_Config_t(ifxStructure):
     """Wrapper for structure ifx_Mimose_Pulse_Config_t."""
@@ -0,0 +1,323 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    fft_benchmark.c
+ *
+ * @brief   Compares the FFT backends of the SDK.
+ *
+ * For every backend available in this build the FFT is timed for the range
+ * FFT sizes (real input) and Doppler FFT sizes (complex input) that
+ * ifx_rdm_create and ifx_rs_create typically use, i.e. 32 to 256 samples per
+ * chirp and 16 to 128 chirps per frame with a zero padding factor of 4.
+ * Additionally the time to create an FFT object with and without a cached
+ * plan as well as the complete range Doppler map and range spectrum are
+ * measured.
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ifxAlgo/FFT.h"
+#include "ifxBase/Base.h"
+#include "ifxRadar/RangeDopplerMap.h"
+#include "ifxRadar/RangeSpectrum.h"
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+// number of FFTs per batch, like chirps of a frame
+#define BATCH_SIZE (64U)
+
+// minimum duration of each measurement
+#define MIN_SECONDS (0.5)
+
+// zero padding factor as used by the examples
+#define ZERO_PADDING (4U)
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+static const uint32_t range_fft_sizes[] = {128, 256, 512, 1024};
+static const uint32_t doppler_fft_sizes[] = {64, 128, 256, 512};
+
+static const struct
+{
+    ifx_FFT_Backend_t backend;
+    const char* name;
+} backends[] = {
+    {IFX_FFT_BACKEND_MUFFT, "muFFT"},
+    {IFX_FFT_BACKEND_FFTW, "FFTW"},
+};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static double seconds(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void fill_r(ifx_Matrix_R_t* m)
+{
+    for (size_t i = 0; i < IFX_MAT_SIZE(m); i++)
+        IFX_MAT_DAT(m)[i] = (ifx_Float_t)rand() / RAND_MAX;
+}
+
+static void fill_c(ifx_Matrix_C_t* m)
+{
+    for (size_t i = 0; i < IFX_MAT_SIZE(m); i++)
+        IFX_COMPLEX_SET(IFX_MAT_DAT(m)[i], (ifx_Float_t)rand() / RAND_MAX, (ifx_Float_t)rand() / RAND_MAX);
+}
+
+/** @brief Time to create an FFT object in microseconds, without and with cached plan */
+static void bench_create(ifx_FFT_Type_t fft_type, uint32_t fft_size, double* uncached_us, double* cached_us)
+{
+    ifx_fft_clear_plan_cache();
+
+    double start = seconds();
+    ifx_FFT_t* fft = ifx_fft_create(fft_type, fft_size);
+    *uncached_us = (seconds() - start) * 1e6;
+    ifx_fft_destroy(fft);
+
+    uint32_t count = 0;
+    start = seconds();
+    double elapsed;
+    do
+    {
+        fft = ifx_fft_create(fft_type, fft_size);
+        ifx_fft_destroy(fft);
+        count++;
+        elapsed = seconds() - start;
+    } while (elapsed < MIN_SECONDS / 10);
+    *cached_us = elapsed * 1e6 / count;
+}
+
+/** @brief Time of one FFT in microseconds, computed in batches */
+static double bench_fft(ifx_FFT_Type_t fft_type, uint32_t fft_size)
+{
+    const uint32_t len = fft_size / ZERO_PADDING;
+    ifx_FFT_t* fft = ifx_fft_create(fft_type, fft_size);
+    ifx_Matrix_C_t* output = ifx_mat_create_c(BATCH_SIZE, fft_size);
+    ifx_Matrix_R_t* input_r = NULL;
+    ifx_Matrix_C_t* input_c = NULL;
+
+    if (fft_type == IFX_FFT_TYPE_R2C)
+    {
+        input_r = ifx_mat_create_r(BATCH_SIZE, len);
+        fill_r(input_r);
+    }
+    else
+    {
+        input_c = ifx_mat_create_c(BATCH_SIZE, len);
+        fill_c(input_c);
+    }
+
+    uint32_t count = 0;
+    const double start = seconds();
+    double elapsed;
+    do
+    {
+        if (fft_type == IFX_FFT_TYPE_R2C)
+            ifx_fft_run_batch_rc(fft, input_r, IFX_FFT_BATCH_ROWS, NULL, true, output, IFX_FFT_BATCH_ROWS);
+        else
+            ifx_fft_run_batch_c(fft, input_c, IFX_FFT_BATCH_ROWS, NULL, true, output, IFX_FFT_BATCH_ROWS);
+        count += BATCH_SIZE;
+        elapsed = seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    ifx_mat_destroy_r(input_r);
+    ifx_mat_destroy_c(input_c);
+    ifx_mat_destroy_c(output);
+    ifx_fft_destroy(fft);
+
+    return elapsed * 1e6 / count;
+}
+
+static void set_window(ifx_Window_Config_t* window, ifx_Window_Type_t type, uint32_t size)
+{
+    window->type = type;
+    window->size = size;
+    window->scale = 1;
+    window->at_dB = 100;
+}
+
+/** @brief Time of one range Doppler map in microseconds for a real frame */
+static double bench_rdm(uint32_t num_chirps, uint32_t num_samples)
+{
+    ifx_RDM_Config_t config = {0};
+    config.spect_threshold = (ifx_Float_t)1e-6;
+    config.output_scale_type = IFX_SCALE_TYPE_DECIBEL_20LOG;
+    config.range_fft_config.fft_type = IFX_FFT_TYPE_R2C;
+    config.range_fft_config.fft_size = num_samples * ZERO_PADDING;
+    config.range_fft_config.mean_removal_enabled = true;
+    set_window(&config.range_fft_config.window_config, IFX_WINDOW_BLACKMANHARRIS, num_samples);
+    config.doppler_fft_config.fft_type = IFX_FFT_TYPE_C2C;
+    config.doppler_fft_config.fft_size = num_chirps * ZERO_PADDING;
+    config.doppler_fft_config.mean_removal_enabled = true;
+    set_window(&config.doppler_fft_config.window_config, IFX_WINDOW_CHEBYSHEV, num_chirps);
+
+    ifx_RDM_t* rdm = ifx_rdm_create(&config);
+    ifx_Matrix_R_t* frame = ifx_mat_create_r(num_chirps, num_samples);
+    ifx_Matrix_R_t* output = ifx_mat_create_r(num_samples * ZERO_PADDING / 2, num_chirps * ZERO_PADDING);
+    fill_r(frame);
+
+    uint32_t count = 0;
+    const double start = seconds();
+    double elapsed;
+    do
+    {
+        ifx_rdm_run_r(rdm, frame, output);
+        count++;
+        elapsed = seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    ifx_mat_destroy_r(output);
+    ifx_mat_destroy_r(frame);
+    ifx_rdm_destroy(rdm);
+
+    return elapsed * 1e6 / count;
+}
+
+/** @brief Time of one range spectrum in microseconds for a real frame */
+static double bench_rs(uint32_t num_chirps, uint32_t num_samples)
+{
+    ifx_RS_Config_t config = {0};
+    config.spect_threshold = (ifx_Float_t)1e-6;
+    config.output_scale_type = IFX_SCALE_TYPE_DECIBEL_20LOG;
+    config.fft_config.fft_type = IFX_FFT_TYPE_R2C;
+    config.fft_config.fft_size = num_samples * ZERO_PADDING;
+    config.fft_config.mean_removal_enabled = true;
+    set_window(&config.fft_config.window_config, IFX_WINDOW_BLACKMANHARRIS, num_samples);
+    config.num_of_chirps_per_frame = num_chirps;
+
+    ifx_RS_t* rs = ifx_rs_create(&config);
+    ifx_rs_set_mode(rs, IFX_RS_MODE_COHERENT_INTEGRATION);
+    ifx_Matrix_R_t* frame = ifx_mat_create_r(num_chirps, num_samples);
+    ifx_Vector_R_t* output = ifx_vec_create_r(num_samples * ZERO_PADDING / 2);
+    fill_r(frame);
+
+    uint32_t count = 0;
+    const double start = seconds();
+    double elapsed;
+    do
+    {
+        ifx_rs_run_r(rs, frame, output);
+        count++;
+        elapsed = seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    ifx_vec_destroy_r(output);
+    ifx_mat_destroy_r(frame);
+    ifx_rs_destroy(rs);
+
+    return elapsed * 1e6 / count;
+}
+
+/*
+==============================================================================
+7. MAIN METHOD
+==============================================================================
+*/
+
+int main(void)
+{
+    printf("%-8s %-5s %6s %14s %14s %12s\n", "backend", "type", "size", "create [us]", "cached [us]", "FFT [us]");
+
+    for (size_t b = 0; b < ARRAY_SIZE(backends); b++)
+    {
+        if (!ifx_fft_backend_available(backends[b].backend))
+        {
+            printf("%-8s not available in this build\n", backends[b].name);
+            continue;
+        }
+        ifx_fft_set_backend(backends[b].backend);
+
+        for (int type = 0; type < 2; type++)
+        {
+            const ifx_FFT_Type_t fft_type = type ? IFX_FFT_TYPE_C2C : IFX_FFT_TYPE_R2C;
+            const uint32_t* sizes = type ? doppler_fft_sizes : range_fft_sizes;
+
+            for (size_t i = 0; i < ARRAY_SIZE(range_fft_sizes); i++)
+            {
+                double uncached_us, cached_us;
+                bench_create(fft_type, sizes[i], &uncached_us, &cached_us);
+                const double fft_us = bench_fft(fft_type, sizes[i]);
+                printf("%-8s %-5s %6u %14.1f %14.2f %12.3f\n", backends[b].name, type ? "C2C" : "R2C",
+                       sizes[i], uncached_us, cached_us, fft_us);
+            }
+        }
+    }
+
+    printf("\n%-8s %-18s %12s %12s\n", "backend", "chirps x samples", "RDM [us]", "RS [us]");
+
+    const uint32_t frames[][2] = {{32, 64}, {64, 128}, {128, 256}};
+    for (size_t b = 0; b < ARRAY_SIZE(backends); b++)
+    {
+        if (!ifx_fft_backend_available(backends[b].backend))
+            continue;
+        ifx_fft_set_backend(backends[b].backend);
+
+        for (size_t i = 0; i < ARRAY_SIZE(frames); i++)
+        {
+            const double rdm_us = bench_rdm(frames[i][0], frames[i][1]);
+            const double rs_us = bench_rs(frames[i][0], frames[i][1]);
+            printf("%-8s %8u x %-7u %12.1f %12.1f\n", backends[b].name, frames[i][0], frames[i][1], rdm_us, rs_us);
+        }
+    }
+
+    ifx_fft_clear_plan_cache();
+
+    const ifx_Error_t error = ifx_error_get();
+    if (error != IFX_OK)
+    {
+        fprintf(stderr, "Error: %s\n", ifx_error_to_string(error));
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
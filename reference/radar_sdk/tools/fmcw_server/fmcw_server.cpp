@@ -0,0 +1,192 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    fmcw_server.cpp
+ *
+ * @brief   Shares an FMCW radar device with other processes.
+ *
+ * Opens the device, optionally loads a register file, and publishes its
+ * frames with a device server (see DeviceFmcwServer.h) until it is
+ * interrupted. Meanwhile ifx_fmcw_create_by_uuid with the uuid printed at
+ * the start attaches to the frames in any number of other processes, for
+ * example a recorder and a visualizer next to a detector. Once a second the
+ * number of published frames and of attached consumers is printed.
+ *
+ * Usage:
+ *   fmcw_server [-u uuid] [-r register_file] [-n ring_frames]
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include "ifxBase/Base.h"
+#include "ifxFmcw/DeviceFmcw.h"
+#include "ifxFmcw/DeviceFmcwServer.h"
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct Options
+{
+    const char* uuid = nullptr;           // nullptr: first connected device
+    const char* register_file = nullptr;  // nullptr: default configuration
+    uint32_t ring_frames = 16;
+};
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+volatile std::sig_atomic_t running = 1;
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+void stop(int)
+{
+    running = 0;
+}
+
+void print_usage(const char* program)
+{
+    fprintf(stderr, "usage: %s [-u uuid] [-r register_file] [-n ring_frames]\n", program);
+}
+
+bool parse_options(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc)
+            return false;
+
+        if (arg == "-u")
+            options.uuid = argv[++i];
+        else if (arg == "-r")
+            options.register_file = argv[++i];
+        else if (arg == "-n")
+            options.ring_frames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else
+            return false;
+    }
+    return options.ring_frames >= 2;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ifx_Device_Fmcw_t* device = options.uuid ? ifx_fmcw_create_by_uuid(options.uuid) : ifx_fmcw_create();
+    ifx_Error_t error = ifx_error_get_and_clear();
+    if (device == nullptr || error != IFX_OK)
+    {
+        fprintf(stderr, "Cannot open device: %s\n", ifx_error_to_string(error));
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    if (options.register_file)
+    {
+        ifx_fmcw_load_register_file(device, options.register_file);
+        error = ifx_error_get_and_clear();
+        if (error != IFX_OK)
+        {
+            fprintf(stderr, "Cannot load %s: %s\n", options.register_file, ifx_error_to_string(error));
+            ifx_fmcw_destroy(device);
+            return EXIT_FAILURE;
+        }
+    }
+
+    ifx_Fmcw_Server_t* server = ifx_fmcw_server_create(device, options.ring_frames);
+    error = ifx_error_get_and_clear();
+    if (server == nullptr || error != IFX_OK)
+    {
+        fprintf(stderr, "Cannot start the server: %s\n", ifx_error_to_string(error));
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+
+    printf("Serving %s, stop with Ctrl-C\n", ifx_fmcw_get_board_uuid(device));
+    while (running && ifx_fmcw_server_is_running(server))
+    {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        printf("%llu frames, %u consumers\n", static_cast<unsigned long long>(ifx_fmcw_server_get_num_frames(server)),
+               ifx_fmcw_server_get_num_consumers(server));
+        fflush(stdout);
+    }
+
+    const bool failed = !ifx_fmcw_server_is_running(server);
+    ifx_fmcw_server_destroy(server);
+    ifx_fmcw_destroy(device);
+
+    if (failed)
+    {
+        fprintf(stderr, "Reading frames from the device failed\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
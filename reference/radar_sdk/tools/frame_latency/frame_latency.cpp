@@ -0,0 +1,346 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    frame_latency.cpp
+ *
+ * @brief   Measures the latency of frames from the device to the application.
+ *
+ * Every frame returned by ifx_fmcw_get_next_frame carries three timestamps
+ * (see ifx_Fmcw_Frame_t): the device time of the data slice completing the
+ * frame, the host time when that slice was taken from the receive queue, and
+ * the host time when the frame was handed to the application. This tool
+ * fetches frames and reports histograms and percentiles of
+ * - sdk:        delivered - received, the time spent in the SDK
+ * - end_to_end: delivered - device, from the end of the acquisition on the
+ *               device to the application (only if the firmware provides
+ *               timestamps; the clocks of device and host must be in sync)
+ * - wakeup:     application - delivered, until the waiting thread runs
+ *
+ * Frames are read from the first connected device, or with -s from a
+ * synthetic device paced at the frame rate. With -l a number of threads
+ * keeps the CPU busy to show the latency under load. With -t the tool fails
+ * if the 99th percentile of end_to_end (or sdk if no device timestamps are
+ * available) exceeds the given number of milliseconds, so it can be used as
+ * a check in CI.
+ *
+ * Usage:
+ *   frame_latency [-s] [-n frames] [-f frame_time_ms] [-l load_threads] [-t p99_limit_ms]
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ifxBase/Base.h"
+#include "ifxFmcw/DeviceFmcw.h"
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// histogram buckets are powers of two of microseconds, starting at 2^MIN_BUCKET
+#define MIN_BUCKET (4U)
+#define NUM_BUCKETS (14U)
+
+// width of the largest bar of a histogram
+#define BAR_WIDTH (50U)
+
+#define FRAME_TIMEOUT_MS (5000U)
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct Options
+{
+    bool synthetic = false;
+    uint32_t num_frames = 1000;
+    uint32_t frame_time_ms = 20;
+    uint32_t load_threads = 0;
+    double p99_limit_ms = 0;  // 0: no limit
+};
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+const ifx_Fmcw_Synthetic_Target_t scene_targets[] = {
+    // range_m, velocity_m_s, angle_deg, amplitude
+    {1.2f, 0.5f, 10.f, 0.1f},
+};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+uint64_t epoch_time_us()
+{
+    const auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(since_epoch).count());
+}
+
+void print_usage(const char* program)
+{
+    fprintf(stderr, "usage: %s [-s] [-n frames] [-f frame_time_ms] [-l load_threads] [-t p99_limit_ms]\n", program);
+}
+
+bool parse_options(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-s")
+        {
+            options.synthetic = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            return false;
+
+        if (arg == "-n")
+            options.num_frames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (arg == "-f")
+            options.frame_time_ms = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (arg == "-l")
+            options.load_threads = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (arg == "-t")
+            options.p99_limit_ms = strtod(argv[++i], nullptr);
+        else
+            return false;
+    }
+    return (options.num_frames > 0) && (options.frame_time_ms > 0);
+}
+
+/** @brief Opens the device and sets the sequence of the BGT60TR13C examples */
+ifx_Device_Fmcw_t* open_device(const Options& options)
+{
+    ifx_Device_Fmcw_t* device;
+    if (options.synthetic)
+    {
+        ifx_Fmcw_Synthetic_Scene_t scene = {};
+        scene.targets = scene_targets;
+        scene.num_targets = sizeof(scene_targets) / sizeof(scene_targets[0]);
+        scene.noise_amplitude = 0.002f;
+        scene.seed = 1;
+        device = ifx_fmcw_create_synthetic(IFX_AVIAN_BGT60TR13C, &scene, IFX_FMCW_PLAYBACK_REAL_TIME);
+    }
+    else
+    {
+        device = ifx_fmcw_create();
+    }
+    if (device == nullptr)
+        return nullptr;
+
+    ifx_Fmcw_Simple_Sequence_Config_t config = {};
+    config.frame_repetition_time_s = static_cast<float>(options.frame_time_ms) * 1e-3f;
+    config.chirp_repetition_time_s = 0.0005f;
+    config.num_chirps = 32;
+    config.tdm_mimo = false;
+    config.chirp.start_frequency_Hz = 60e9;
+    config.chirp.end_frequency_Hz = 61.5e9;
+    config.chirp.sample_rate_Hz = 2e6f;
+    config.chirp.num_samples = 128;
+    config.chirp.rx_mask = 7;
+    config.chirp.tx_mask = 1;
+    config.chirp.tx_power_level = 31;
+    config.chirp.lp_cutoff_Hz = 500000;
+    config.chirp.hp_cutoff_Hz = 80000;
+    config.chirp.if_gain_dB = 33;
+
+    ifx_Fmcw_Sequence_Element_t* sequence = ifx_fmcw_create_simple_sequence(&config);
+    ifx_fmcw_set_acquisition_sequence(device, sequence);
+    ifx_fmcw_destroy_sequence(sequence);
+
+    return device;
+}
+
+/** @brief Value below which the given fraction of the sorted latencies lies */
+double percentile(const std::vector<uint64_t>& sorted, double fraction)
+{
+    const auto index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size()))) - 1;
+    return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]) * 1e-3;
+}
+
+/** @brief Prints histogram and percentiles of latencies in microseconds, returns the 99th percentile in ms */
+double report(const char* name, std::vector<uint64_t>& latencies)
+{
+    if (latencies.empty())
+    {
+        printf("%s: no samples\n\n", name);
+        return 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    uint32_t buckets[NUM_BUCKETS] = {};
+    for (const auto latency : latencies)
+    {
+        uint32_t bucket = 0;
+        while (bucket + 1 < NUM_BUCKETS && latency >= (uint64_t(1) << (MIN_BUCKET + bucket)))
+            bucket++;
+        buckets[bucket]++;
+    }
+    const auto largest = *std::max_element(buckets, buckets + NUM_BUCKETS);
+
+    printf("%s (%zu frames)\n", name, latencies.size());
+    for (uint32_t bucket = 0; bucket < NUM_BUCKETS; bucket++)
+    {
+        const auto limit_us = static_cast<unsigned long long>(uint64_t(1) << (MIN_BUCKET + bucket));
+        const auto bar = static_cast<uint32_t>(uint64_t(buckets[bucket]) * BAR_WIDTH / largest);
+        if (bucket + 1 < NUM_BUCKETS)
+            printf("  < %8llu us %8u %s\n", limit_us, buckets[bucket], std::string(bar, '#').c_str());
+        else
+            printf("  >=%8llu us %8u %s\n", limit_us >> 1, buckets[bucket], std::string(bar, '#').c_str());
+    }
+
+    const double p99 = percentile(latencies, 0.99);
+    printf("  p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, p99.9 %.3f ms, max %.3f ms\n\n",
+           percentile(latencies, 0.5), percentile(latencies, 0.9), p99, percentile(latencies, 0.999),
+           static_cast<double>(latencies.back()) * 1e-3);
+    return p99;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ifx_Device_Fmcw_t* device = open_device(options);
+    ifx_Error_t error = ifx_error_get_and_clear();
+    if (device == nullptr || error != IFX_OK)
+    {
+        fprintf(stderr, "Cannot open device: %s\n", ifx_error_to_string(error));
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    // keep the CPU busy while frames are fetched
+    std::atomic<bool> loaded {true};
+    std::vector<std::thread> load;
+    for (uint32_t i = 0; i < options.load_threads; i++)
+    {
+        load.emplace_back([&loaded] {
+            volatile double sink = 1.0;
+            while (loaded.load(std::memory_order_relaxed))
+                sink = std::sqrt(sink + 1.0);
+        });
+    }
+
+    std::vector<uint64_t> sdk, end_to_end, wakeup;
+    sdk.reserve(options.num_frames);
+    end_to_end.reserve(options.num_frames);
+    wakeup.reserve(options.num_frames);
+
+    ifx_Fmcw_Frame_t* frame = ifx_fmcw_allocate_frame(device);
+    ifx_fmcw_start_acquisition(device);
+    for (uint32_t i = 0; i < options.num_frames && frame; i++)
+    {
+        ifx_fmcw_get_next_frame_timeout(device, frame, FRAME_TIMEOUT_MS);
+        const uint64_t now_us = epoch_time_us();
+        error = ifx_error_get_and_clear();
+        if (error != IFX_OK)
+        {
+            fprintf(stderr, "Frame %u: %s\n", i, ifx_error_to_string(error));
+            if (error == IFX_ERROR_TIMEOUT || error == IFX_ERROR_COMMUNICATION_ERROR)
+                break;
+            continue;
+        }
+
+        sdk.push_back(frame->timestamp_delivered_us - frame->timestamp_received_us);
+        wakeup.push_back(now_us - std::min(now_us, frame->timestamp_delivered_us));
+        // a device clock behind the host would give negative latencies, skip those
+        if (frame->timestamp_device_us && frame->timestamp_device_us <= frame->timestamp_delivered_us)
+            end_to_end.push_back(frame->timestamp_delivered_us - frame->timestamp_device_us);
+    }
+    ifx_fmcw_stop_acquisition(device);
+
+    loaded = false;
+    for (auto& thread : load)
+        thread.join();
+
+    ifx_fmcw_destroy_frame(frame);
+    ifx_fmcw_destroy(device);
+    ifx_error_get_and_clear();
+
+    printf("%u load threads, frame time %u ms\n\n", options.load_threads, options.frame_time_ms);
+    const double sdk_p99 = report("sdk", sdk);
+    const double end_to_end_p99 = report("end_to_end", end_to_end);
+    report("wakeup", wakeup);
+
+    if (sdk.empty())
+        return EXIT_FAILURE;
+
+    if (options.p99_limit_ms > 0)
+    {
+        const bool device_time = !end_to_end.empty();
+        const double p99 = device_time ? end_to_end_p99 : sdk_p99;
+        if (p99 > options.p99_limit_ms)
+        {
+            fprintf(stderr, "p99 of %s is %.3f ms, above the limit of %.3f ms\n", device_time ? "end_to_end" : "sdk",
+                    p99, options.p99_limit_ms);
+            return EXIT_FAILURE;
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,228 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    kernel_benchmark.c
+ *
+ * @brief   Measures the SIMD kernels of the vector functions.
+ *
+ * Each function is timed on contiguous vectors, which use the SIMD kernels,
+ * and on vectors with a stride of 2, which use the scalar loops. The kernels
+ * are selected for the CPU at runtime; set the environment variable IFX_SIMD
+ * to scalar, sse2, avx2, avx512 or neon to measure a specific instruction
+ * set.
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "ifxBase/Base.h"
+#include "ifxBase/internal/Kernels.h"
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+// minimum duration of each measurement
+#define MIN_SECONDS (0.2)
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+typedef enum
+{
+    OP_MUL_R,
+    OP_MUL_C,
+    OP_SCALE_C,
+    OP_MAC_C,
+    OP_ABS_C,
+    OP_ABS2_C
+} op_t;
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+// a window, a chirp, a range Doppler map and a larger cube
+static const uint32_t lengths[] = {256, 4096, 65536, 1048576};
+
+static const struct
+{
+    op_t op;
+    const char* name;
+} ops[] = {
+    {OP_MUL_R, "ifx_vec_mul_r"},
+    {OP_MUL_C, "ifx_vec_mul_c"},
+    {OP_SCALE_C, "ifx_vec_scale_c"},
+    {OP_MAC_C, "ifx_vec_mac_c"},
+    {OP_ABS_C, "ifx_vec_abs_c"},
+    {OP_ABS2_C, "abs2_c (kernel)"},
+};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+static double seconds(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+/** @brief Run op once on vectors of length with the given stride */
+static void run(op_t op, uint32_t length, uint32_t stride, ifx_Float_t* r[3], ifx_Complex_t* c[3])
+{
+    const ifx_Complex_t scale = IFX_COMPLEX_DEF(0.5f, -0.25f);
+    ifx_Vector_R_t vr[3];
+    ifx_Vector_C_t vc[3];
+    for (int i = 0; i < 3; i++)
+    {
+        ifx_vec_rawview_r(&vr[i], r[i], length, stride);
+        ifx_vec_rawview_c(&vc[i], c[i], length, stride);
+    }
+
+    switch (op)
+    {
+        case OP_MUL_R:
+            ifx_vec_mul_r(&vr[0], &vr[1], &vr[2]);
+            break;
+        case OP_MUL_C:
+            ifx_vec_mul_c(&vc[0], &vc[1], &vc[2]);
+            break;
+        case OP_SCALE_C:
+            ifx_vec_scale_c(&vc[0], scale, &vc[2]);
+            break;
+        case OP_MAC_C:
+            ifx_vec_mac_c(&vc[0], &vc[1], scale, &vc[2]);
+            break;
+        case OP_ABS_C:
+            ifx_vec_abs_c(&vc[0], &vr[2]);
+            break;
+        case OP_ABS2_C:
+            // there is no vector function for the squared norm
+            if (stride == 1)
+            {
+                ifx_kernels_get()->abs2_c(c[0], r[2], length);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    const ifx_Complex_t z = c[0][i * stride];
+                    r[2][i * stride] = IFX_COMPLEX_REAL(z) * IFX_COMPLEX_REAL(z) + IFX_COMPLEX_IMAG(z) * IFX_COMPLEX_IMAG(z);
+                }
+            }
+            break;
+    }
+}
+
+/** @brief Time per element of op in nanoseconds */
+static double bench(op_t op, uint32_t length, uint32_t stride, ifx_Float_t* r[3], ifx_Complex_t* c[3])
+{
+    uint32_t count = 0;
+    const double start = seconds();
+    double elapsed;
+    do
+    {
+        run(op, length, stride, r, c);
+        count++;
+        elapsed = seconds() - start;
+    } while (elapsed < MIN_SECONDS);
+
+    return elapsed * 1e9 / ((double)count * length);
+}
+
+/*
+==============================================================================
+7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+int main(void)
+{
+    const uint32_t max_length = lengths[ARRAY_SIZE(lengths) - 1];
+
+    // twice the length for the strided vectors
+    ifx_Float_t* r[3];
+    ifx_Complex_t* c[3];
+    for (int i = 0; i < 3; i++)
+    {
+        r[i] = ifx_mem_aligned_alloc(2 * max_length * sizeof(ifx_Float_t), IFX_MEMORY_ALIGNMENT);
+        c[i] = ifx_mem_aligned_alloc(2 * max_length * sizeof(ifx_Complex_t), IFX_MEMORY_ALIGNMENT);
+        if (r[i] == NULL || c[i] == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+
+        for (uint32_t j = 0; j < 2 * max_length; j++)
+        {
+            r[i][j] = (ifx_Float_t)rand() / RAND_MAX;
+            IFX_COMPLEX_SET(c[i][j], (ifx_Float_t)rand() / RAND_MAX, (ifx_Float_t)rand() / RAND_MAX);
+        }
+    }
+
+    printf("kernels: %s\n\n", ifx_kernels_get()->name);
+    printf("%-16s %8s %14s %14s %8s\n", "function", "length", "SIMD [ns]", "scalar [ns]", "speedup");
+
+    for (size_t o = 0; o < ARRAY_SIZE(ops); o++)
+    {
+        for (size_t l = 0; l < ARRAY_SIZE(lengths); l++)
+        {
+            const double simd_ns = bench(ops[o].op, lengths[l], 1, r, c);
+            const double scalar_ns = bench(ops[o].op, lengths[l], 2, r, c);
+            printf("%-16s %8u %14.3f %14.3f %8.2f\n", ops[o].name, lengths[l], simd_ns, scalar_ns, scalar_ns / simd_ns);
+        }
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        ifx_mem_aligned_free(r[i]);
+        ifx_mem_aligned_free(c[i]);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Copyright (c) 2022, Infineon Technologies AG
+% All rights reserved.
+%
+% Redistribution and use in source and binary forms, with or without modification,are permitted provided that the
+% following conditions are met:
+%
+% Redistributions of source code must retain the above copyright notice, this list of conditions and the following
+% disclaimer.
+%
+% Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following
+% disclaimer in the documentation and/or other materials provided with the distribution.
+%
+% Neither the name of the copyright holders nor the names of its contributors may be used to endorse or promote
+% products derived from this software without specific prior written permission.
+%
+% THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+% INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+% DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE  FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+% SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+% SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+% WHETHER IN CONTRACT, STRICT LIABILITY,OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+% OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+% DESCRIPTION:
+% Load the NumPy files written by tools/ltr11_recording_parser (the native
+% parser) from a recording. The files are memory mapped, which is much faster
+% than ltr11_recording_parser for long recordings.
+%
+% Chirps has the dimensions samples x chirps x rx antennas x frames, so
+% Chirps(:,:,:,n) corresponds to Frame(n).Chirp of ltr11_recording_parser.
+% Frames is a struct array with the header of each frame.
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+
+function [Chirps, Frames] = ltr11_load_npy(sOutput)
+    [offset, descr, shape] = read_npy_header([sOutput '_samples.npy']);
+    num_values = prod(shape);
+    
+    % NumPy arrays are stored in C order, the reversed shape gives the MATLAB dimensions
+    if strcmp(descr, '<c8')
+        m = memmapfile([sOutput '_samples.npy'], 'Offset', offset, 'Format', {'single', [2 num_values], 'iq'});
+        Chirps = complex(m.Data.iq(1,:), m.Data.iq(2,:));
+    elseif strcmp(descr, '<f4')
+        m = memmapfile([sOutput '_samples.npy'], 'Offset', offset, 'Format', {'single', [1 num_values], 'i'});
+        Chirps = m.Data.i;
+    else
+        error("Data type %s not supported!", descr);
+    end
+    Chirps = reshape(Chirps, fliplr(shape));
+    
+    Frames = [];
+    if nargout > 1
+        [offset, ~, shape] = read_npy_header([sOutput '_frames.npy']);
+        m = memmapfile([sOutput '_frames.npy'], 'Offset', offset, 'Repeat', shape(1), 'Format', { ...
+            'int32',  [1 1], 'Frame_Number'; ...
+            'single', [1 1], 'Avg_Power'; ...
+            'int32',  [1 1], 'Active'; ...
+            'int32',  [1 1], 'Motion'; ...
+            'int32',  [1 1], 'Direction'; ...
+            'int32',  [1 1], 'Amplitude'; ...
+            'int32',  [1 1], 'Timestamp'});
+        Frames = m.Data;
+    end
+end
+
+%% Read header of a NumPy file
+function [offset, descr, shape] = read_npy_header(sFile)
+    fid = fopen(sFile, 'r', 'l');
+    if( isequal(fid, -1) )
+        error("file %s not found!", sFile);
+    end
+    magic = fread(fid, 6, 'uint8=>char')';
+    if( ~strcmp(magic(2:6), 'NUMPY') )
+        fclose(fid);
+        error("%s is not a NumPy file!", sFile);
+    end
+    fread(fid, 2, 'uint8'); % version
+    header_length = fread(fid, 1, 'uint16');
+    header = fread(fid, header_length, 'uint8=>char')';
+    fclose(fid);
+    
+    offset = 10 + header_length;
+    descr = regexp(header, '''descr'': ''([^'']*)''', 'tokens', 'once');
+    if( ~isempty(descr) )
+        descr = descr{1};
+    end
+    dims = regexp(header, '''shape'': \(([^\)]*)\)', 'tokens', 'once');
+    shape = str2double(strsplit(strtrim(strrep(dims{1}, ',', ' '))));
+end
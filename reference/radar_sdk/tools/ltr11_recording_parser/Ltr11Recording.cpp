@@ -0,0 +1,519 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "Ltr11Recording.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+namespace {
+
+constexpr char suffix[] = ".raw.bin";
+constexpr size_t file_header_size_v1 = 8 + 20 * 4;   // file type id, version and 20 fields
+constexpr size_t file_header_size_v3 = 8 + 13 * 4;   // file type id, version and 13 fields
+
+// the NumPy files are written in the byte order of the host, which is little endian on all supported platforms
+constexpr char samples_descr_complex[] = "'<c8'";
+constexpr char samples_descr_real[] = "'<f4'";
+constexpr char frame_info_descr[] =
+    "[('frame_number', '<i4'), ('avg_power', '<f4'), ('active', '<i4'), ('motion', '<i4'), "
+    "('direction', '<i4'), ('amplitude', '<i4'), ('timestamp', '<i4')]";
+
+static_assert(sizeof(ifx_Complex_t) == 2 * sizeof(float) && sizeof(ifx_Float_t) == sizeof(float),
+              "samples are written as complex64 or float32");
+static_assert(sizeof(Ltr11_Frame_Info) == 7 * 4, "frame headers are written as a packed structured array");
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/* Recordings are written in big endian byte order */
+uint32_t load_be32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+int32_t load_be_int(const uint8_t* p)
+{
+    return static_cast<int32_t>(load_be32(p));
+}
+
+float load_be_float(const uint8_t* p)
+{
+    const uint32_t bits = load_be32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Same as normalize() in DeviceLtr11Impl.cpp: of the 10 bit result of the
+   internal 8 bit ADC only bit9-bit2 are significant. */
+float normalize(float adc_value)
+{
+    const auto value = (static_cast<uint16_t>(adc_value) & 0x3FC) >> 2;
+    return (1.0f * value) / 0xFF;
+}
+
+bool has_suffix(const std::string& s, const char* end)
+{
+    const size_t n = std::strlen(end);
+    return s.size() >= n && s.compare(s.size() - n, n, end) == 0;
+}
+
+int seek64(std::FILE* file, uint64_t offset)
+{
+#ifdef _WIN32
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+/* Header of a NumPy file (format version 1.0), padded such that the data
+   starts at a multiple of 64 bytes */
+std::string npy_header(const char* descr, const std::vector<uint64_t>& shape)
+{
+    std::string dims;
+    for (auto dim : shape)
+        dims += (dims.empty() ? "" : ", ") + std::to_string(dim);
+    if (shape.size() == 1)
+        dims += ",";
+
+    std::string dict = std::string("{'descr': ") + descr + ", 'fortran_order': False, 'shape': (" + dims + "), }";
+    const size_t unpadded = 10 + dict.size() + 1;
+    dict.append((64 - unpadded % 64) % 64, ' ');
+    dict += '\n';
+
+    std::string header("\x93NUMPY\x01\x00", 8);
+    header += static_cast<char>(dict.size() & 0xFF);
+    header += static_cast<char>(dict.size() >> 8);
+    return header + dict;
+}
+
+/* Creates filename holding only the NumPy header and returns its size */
+uint64_t create_npy(const std::string& filename, const char* descr, const std::vector<uint64_t>& shape)
+{
+    const auto header = npy_header(descr, shape);
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file)
+        throw std::runtime_error("cannot create " + filename);
+    const bool ok = std::fwrite(header.data(), 1, header.size(), file) == header.size();
+    if (std::fclose(file) != 0 || !ok)
+        throw std::runtime_error("cannot write " + filename);
+    return header.size();
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. EXPORTED FUNCTIONS
+==============================================================================
+*/
+
+Ltr11Recording::Ltr11Recording(const std::string& filename)
+{
+    const std::string path = has_suffix(filename, suffix) ? filename : filename + suffix;
+
+#ifdef _WIN32
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+    {
+        m_file = nullptr;
+        throw std::runtime_error("cannot open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart < LONGLONG(file_header_size_v3))
+    {
+        CloseHandle(m_file);
+        throw std::runtime_error("file not found, or format not supported: " + path);
+    }
+    m_mapping_size = uint64_t(size.QuadPart);
+    m_map_handle = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_mapping = m_map_handle ? MapViewOfFile(m_map_handle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!m_mapping)
+    {
+        if (m_map_handle)
+            CloseHandle(m_map_handle);
+        CloseHandle(m_file);
+        throw std::runtime_error("cannot map " + path);
+    }
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("cannot open " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < off_t(file_header_size_v3))
+    {
+        close(fd);
+        throw std::runtime_error("file not found, or format not supported: " + path);
+    }
+    m_mapping_size = uint64_t(st.st_size);
+    m_mapping = mmap(nullptr, m_mapping_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // the mapping keeps the file open
+    if (m_mapping == MAP_FAILED)
+    {
+        m_mapping = nullptr;
+        throw std::runtime_error("cannot map " + path);
+    }
+    // frames are usually read once from start to end, so read ahead aggressively
+    madvise(m_mapping, m_mapping_size, MADV_SEQUENTIAL);
+#endif
+
+    try
+    {
+        const auto* p = static_cast<const uint8_t*>(m_mapping);
+        if (std::memcmp(p, "IFRB", 4) != 0)
+            throw std::runtime_error("file type not supported: " + path);
+
+        auto& h = m_header;
+        h.file_format_version = load_be_float(p + 4);
+        p += 8;
+        auto next_int = [&p]() { const auto v = load_be_int(p); p += 4; return v; };
+        auto next_float = [&p]() { const auto v = load_be_float(p); p += 4; return v; };
+
+        if (h.file_format_version == 1)
+        {
+            if (m_mapping_size < file_header_size_v1)
+                throw std::runtime_error("recording header incomplete: " + path);
+            next_int();  // header size
+            h.num_tx_antennas = next_int();
+            h.num_rx_antennas = next_int();
+            next_int();  // tx antenna mask
+            next_int();  // rx antenna mask
+            h.are_rx_antennas_interleaved = next_int();
+            h.modulation_type = next_int();
+            next_int();    // chirp shape
+            next_float();  // lower RF frequency
+            h.center_rf_frequency_kHz = next_float();  // upper RF frequency, like the MATLAB parser
+            h.sampling_frequency_kHz = next_float();
+            h.adc_resolution_bits = next_int();
+            h.are_adc_samples_normalized = next_int();
+            h.data_format = next_int();
+            h.chirps_per_frame = next_int();
+            h.samples_per_chirp = next_int();
+            h.samples_per_frame = next_int();
+            next_float();  // chirp time
+            h.pulse_repetition_time_s = next_float();
+            h.frame_period_s = next_float();
+        }
+        else if (h.file_format_version == 3 || h.file_format_version == 4)
+        {
+            next_int();  // header size
+            h.num_tx_antennas = next_int();
+            h.num_rx_antennas = next_int();
+            h.modulation_type = next_int();
+            h.center_rf_frequency_kHz = next_float();
+            h.sampling_frequency_kHz = next_float();
+            h.adc_resolution_bits = next_int();
+            h.are_adc_samples_normalized = next_int();
+            h.data_format = next_int();
+            h.samples_per_chirp = next_int();
+            h.samples_per_frame = next_int();
+            h.pulse_repetition_time_s = next_float();
+            h.frame_period_s = next_float();
+        }
+        else
+        {
+            throw std::runtime_error("file type version not supported: " + path);
+        }
+
+        if (h.num_rx_antennas <= 0 || h.chirps_per_frame <= 0 || h.samples_per_chirp <= 0
+            || h.data_format < 0 || h.data_format > 2)
+            throw std::runtime_error("invalid recording header: " + path);
+
+        // complex data holds I and Q values; the MATLAB parser counts only one
+        // value per sample for format 1, which would read beyond the frame
+        const size_t parts = is_complex() ? 2 : 1;
+        m_values_per_frame = size_t(h.samples_per_chirp) * size_t(h.num_rx_antennas) * parts * size_t(h.chirps_per_frame);
+        m_frame_size = frame_header_size() + m_values_per_frame * 4;
+        m_data = p;
+
+        const uint64_t payload = m_mapping_size - uint64_t(p - static_cast<const uint8_t*>(m_mapping));
+        m_num_frames = payload / m_frame_size;
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+Ltr11Recording::~Ltr11Recording()
+{
+    unmap();
+}
+
+void Ltr11Recording::unmap()
+{
+    if (!m_mapping)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(m_map_handle);
+    CloseHandle(m_file);
+#else
+    munmap(m_mapping, m_mapping_size);
+#endif
+    m_mapping = nullptr;
+}
+
+size_t Ltr11Recording::frame_header_size() const
+{
+    if (m_header.file_format_version == 4)
+        return 7 * 4;
+    if (m_header.file_format_version == 3)
+        return 5 * 4;
+    return 4;
+}
+
+size_t Ltr11Recording::samples_per_frame() const
+{
+    return size_t(m_header.num_rx_antennas) * size_t(m_header.chirps_per_frame) * size_t(m_header.samples_per_chirp);
+}
+
+void Ltr11Recording::decode(uint64_t first, uint64_t count, void* samples, Ltr11_Frame_Info* info) const
+{
+    if (first > m_num_frames || count > m_num_frames - first)
+        throw std::out_of_range("Ltr11Recording::decode: frames out of range");
+
+    const auto& h = m_header;
+    const size_t S = size_t(h.samples_per_chirp);
+    const size_t R = size_t(h.num_rx_antennas);
+    const size_t C = size_t(h.chirps_per_frame);
+    const size_t D = m_values_per_frame / C;  // values per chirp
+    const bool interleaved = h.are_rx_antennas_interleaved != 0;
+    const bool normalized = h.are_adc_samples_normalized != 0;
+
+    std::vector<float> values(m_values_per_frame);
+    auto* out_real = static_cast<float*>(samples);
+    auto* out_complex = static_cast<ifx_Complex_t*>(samples);
+    const size_t header_size = frame_header_size();
+
+    for (uint64_t n = 0; n < count; n++)
+    {
+        const uint8_t* frame = m_data + (first + n) * m_frame_size;
+
+        if (info)
+        {
+            auto& fi = info[n];
+            std::memset(&fi, 0, sizeof(fi));
+            fi.frame_number = load_be_int(frame);
+            if (h.file_format_version >= 3)
+            {
+                fi.avg_power = load_be_float(frame + 4);
+                fi.active = load_be_int(frame + 8);
+                fi.motion = load_be_int(frame + 12);
+                fi.direction = load_be_int(frame + 16);
+            }
+            if (h.file_format_version == 4)
+            {
+                fi.amplitude = load_be_int(frame + 20);
+                fi.timestamp = load_be_int(frame + 24);
+            }
+        }
+
+        // convert the whole frame first, the loop below only gathers
+        const uint8_t* raw = frame + header_size;
+        for (size_t i = 0; i < m_values_per_frame; i++)
+            values[i] = load_be_float(raw + 4 * i);
+        if (!normalized)
+        {
+            for (auto& v : values)
+                v = normalize(v);
+        }
+
+        // sample s of antenna a in chirp c is at base + s * step, see ltr11_recording_parser.m
+        for (size_t c = 0; c < C; c++)
+        {
+            for (size_t a = 0; a < R; a++)
+            {
+                size_t i_base, q_base = 0, step;
+                float q_sign = 1;
+                if (interleaved)
+                {
+                    switch (h.data_format)
+                    {
+                    case 0: i_base = a; step = R; break;
+                    case 1: i_base = a; q_base = S * R + a; step = R; break;
+                    default: i_base = a; q_base = a + 1; step = 2 * R; break;
+                    }
+                }
+                else
+                {
+                    switch (h.data_format)
+                    {
+                    case 0: i_base = a * S; step = 1; break;
+                    case 1: i_base = 2 * a * S; q_base = (2 * a + 1) * S; step = 1; break;
+                    default:
+                        i_base = 2 * a * S;
+                        q_base = i_base + 1;
+                        step = 2;
+                        q_sign = -1;  // on BGT60LTR11, the sign of the Q signal needs to be inverted
+                        break;
+                    }
+                }
+
+                const float* chirp = values.data() + D * c;
+                const size_t out = (n * R * C + a * C + c) * S;
+                if (is_complex())
+                {
+                    for (size_t s = 0; s < S; s++)
+                    {
+                        out_complex[out + s].data[0] = chirp[i_base + s * step];
+                        out_complex[out + s].data[1] = q_sign * chirp[q_base + s * step];
+                    }
+                }
+                else
+                {
+                    for (size_t s = 0; s < S; s++)
+                        out_real[out + s] = chirp[i_base + s * step];
+                }
+            }
+        }
+    }
+}
+
+void ltr11_write_npy(const Ltr11Recording& recording, const std::string& filename, const std::string& info_filename,
+                     unsigned num_threads, uint32_t chunk_frames)
+{
+    const auto& h = recording.header();
+    const uint64_t num_frames = recording.num_frames();
+    const size_t sample_size = recording.is_complex() ? sizeof(ifx_Complex_t) : sizeof(ifx_Float_t);
+    const size_t frame_bytes = recording.samples_per_frame() * sample_size;
+
+    const uint64_t data_offset =
+        create_npy(filename, recording.is_complex() ? samples_descr_complex : samples_descr_real,
+                   {num_frames, uint64_t(h.num_rx_antennas), uint64_t(h.chirps_per_frame), uint64_t(h.samples_per_chirp)});
+    const uint64_t info_offset = info_filename.empty() ? 0 : create_npy(info_filename, frame_info_descr, {num_frames});
+
+    if (chunk_frames == 0)
+        chunk_frames = 1;
+    const uint64_t num_chunks = (num_frames + chunk_frames - 1) / chunk_frames;
+    if (num_threads == 0)
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = unsigned(std::min<uint64_t>(num_threads, std::max<uint64_t>(num_chunks, 1)));
+
+    std::atomic<uint64_t> next_chunk {0};
+    std::atomic<bool> failed {false};
+    std::mutex error_lock;
+    std::string error;
+
+    auto fail = [&](const std::string& message) {
+        std::lock_guard<std::mutex> lock(error_lock);
+        if (error.empty())
+            error = message;
+        failed = true;
+    };
+
+    // each thread has its own file handles and writes its chunks at their final position
+    auto worker = [&]() {
+        std::FILE* file = std::fopen(filename.c_str(), "r+b");
+        std::FILE* info_file = info_filename.empty() ? nullptr : std::fopen(info_filename.c_str(), "r+b");
+        if (!file || (!info_filename.empty() && !info_file))
+        {
+            fail("cannot open the output files for writing");
+        }
+        else
+        {
+            std::vector<uint8_t> samples(size_t(chunk_frames) * frame_bytes);
+            std::vector<Ltr11_Frame_Info> info(info_file ? chunk_frames : 0);
+
+            for (uint64_t chunk = next_chunk++; chunk < num_chunks && !failed; chunk = next_chunk++)
+            {
+                const uint64_t first = chunk * chunk_frames;
+                const uint64_t count = std::min<uint64_t>(chunk_frames, num_frames - first);
+                recording.decode(first, count, samples.data(), info_file ? info.data() : nullptr);
+
+                const size_t bytes = size_t(count) * frame_bytes;
+                if (seek64(file, data_offset + first * frame_bytes) != 0
+                    || std::fwrite(samples.data(), 1, bytes, file) != bytes)
+                {
+                    fail("cannot write " + filename);
+                    break;
+                }
+                if (info_file
+                    && (seek64(info_file, info_offset + first * sizeof(Ltr11_Frame_Info)) != 0
+                        || std::fwrite(info.data(), sizeof(Ltr11_Frame_Info), size_t(count), info_file) != count))
+                {
+                    fail("cannot write " + info_filename);
+                    break;
+                }
+            }
+        }
+
+        if (file && std::fclose(file) != 0)
+            fail("cannot write " + filename);
+        if (info_file && std::fclose(info_file) != 0)
+            fail("cannot write " + info_filename);
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < num_threads; i++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads)
+        thread.join();
+
+    if (failed)
+        throw std::runtime_error(error);
+}
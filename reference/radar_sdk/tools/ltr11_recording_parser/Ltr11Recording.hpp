@@ -0,0 +1,160 @@
+/* ===========================================================================
+** Copyright (C) 2022 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file Ltr11Recording.hpp
+ *
+ * @brief Reads BGT60LTR11 recordings of the Radar Fusion GUI (*.raw.bin).
+ *
+ * This is the native counterpart of ltr11_recording_parser.m in
+ * tools/ltr11-recording-matlab-parser. The recording is memory mapped and
+ * frames are decoded on demand into contiguous arrays, so any range of
+ * frames can be decoded by any number of threads at the same time.
+ */
+
+#pragma once
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include "ifxBase/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+==============================================================================
+3. TYPES
+==============================================================================
+*/
+
+/* Recording header, see get_recordingheader in ltr11_recording_parser.m.
+   Fields missing in a file format version keep their default. */
+struct Ltr11_Recording_Header
+{
+    float file_format_version = 0;
+    int32_t num_tx_antennas = 0;
+    int32_t num_rx_antennas = 0;
+    int32_t are_rx_antennas_interleaved = 0;
+    int32_t modulation_type = 0;  // 0: Doppler, 1: FMCW
+    float center_rf_frequency_kHz = 0;
+    float sampling_frequency_kHz = 0;
+    int32_t adc_resolution_bits = 0;
+    int32_t are_adc_samples_normalized = 0;
+    int32_t data_format = 0;      // 0: real, 1: complex, 2: complex interleaved
+    int32_t chirps_per_frame = 1;
+    int32_t samples_per_chirp = 0;
+    int32_t samples_per_frame = 0;
+    float pulse_repetition_time_s = 0;
+    float frame_period_s = 0;
+};
+
+/* Header of a frame, see get_frameheader in ltr11_recording_parser.m. The
+   layout is that of the structured array written by ltr11_write_npy. */
+struct Ltr11_Frame_Info
+{
+    int32_t frame_number;
+    float avg_power;  // file format version 3 and later
+    int32_t active;
+    int32_t motion;
+    int32_t direction;
+    int32_t amplitude;  // file format version 4
+    int32_t timestamp;
+};
+
+/*
+==============================================================================
+4. FUNCTION PROTOTYPES
+==============================================================================
+*/
+
+class Ltr11Recording
+{
+public:
+    /* Opens and maps the recording. filename may be given with or without
+       the suffix .raw.bin. Throws std::runtime_error if the file cannot be
+       read or is not a supported recording. */
+    explicit Ltr11Recording(const std::string& filename);
+    ~Ltr11Recording();
+
+    Ltr11Recording(const Ltr11Recording&) = delete;
+    Ltr11Recording& operator=(const Ltr11Recording&) = delete;
+
+    const Ltr11_Recording_Header& header() const { return m_header; }
+
+    /* Number of complete frames. An incomplete last frame is ignored. */
+    uint64_t num_frames() const { return m_num_frames; }
+
+    /* True if frames are decoded into complex samples */
+    bool is_complex() const { return m_header.data_format != 0; }
+
+    /* Number of samples of a decoded frame, which has the shape
+       num_rx_antennas x chirps_per_frame x samples_per_chirp */
+    size_t samples_per_frame() const;
+
+    /* Decodes count frames starting with frame first. samples receives
+       count * samples_per_frame() values, ifx_Complex_t if is_complex()
+       and ifx_Float_t otherwise. info receives count frame headers and may
+       be nullptr. The method only reads the mapping and may be called from
+       several threads at the same time. */
+    void decode(uint64_t first, uint64_t count, void* samples, Ltr11_Frame_Info* info) const;
+
+private:
+    size_t frame_header_size() const;
+    void unmap();
+
+    Ltr11_Recording_Header m_header;
+    const uint8_t* m_data = nullptr;  // start of the frames
+    uint64_t m_num_frames = 0;
+    size_t m_values_per_frame = 0;  // big endian floats of frame data
+    size_t m_frame_size = 0;        // bytes of a frame including its header
+
+    void* m_mapping = nullptr;
+    uint64_t m_mapping_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_map_handle = nullptr;
+#endif
+};
+
+/* Writes all frames of recording into the NumPy file filename, an array of
+   complex64 (or float32) with the shape num_frames x num_rx_antennas x
+   chirps_per_frame x samples_per_chirp. Frame headers are written into
+   info_filename as a structured array if it is not empty.
+
+   Chunks of chunk_frames frames are decoded and written by num_threads
+   threads (0: one per core) into their place in the output files, so the
+   speed is limited by the disk rather than by decoding. Throws
+   std::runtime_error if a file cannot be written. */
+void ltr11_write_npy(const Ltr11Recording& recording, const std::string& filename, const std::string& info_filename,
+                     unsigned num_threads = 0, uint32_t chunk_frames = 4096);
@@ -0,0 +1,189 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    ltr11_recording_parser.cpp
+ *
+ * @brief   Converts BGT60LTR11 recordings of the Radar Fusion GUI into NumPy files.
+ *
+ * The recording (*.raw.bin) is decoded like ltr11_recording_parser.m in
+ * tools/ltr11-recording-matlab-parser and written as
+ * - <output>_samples.npy: complex64 (float32 for real data) array of shape
+ *   frames x rx antennas x chirps x samples, normalized like the samples
+ *   returned by ifx_ltr11_get_next_frame
+ * - <output>_frames.npy:  structured array with the header of each frame
+ *   (frame number, average power, active, motion, direction, amplitude,
+ *   timestamp)
+ *
+ * The recording is memory mapped and chunks of frames are decoded and
+ * written by several threads, so the conversion runs at the speed of the
+ * disk. Python reads the result with numpy.load(filename, mmap_mode="r"),
+ * MATLAB with ltr11_load_npy.m of the MATLAB parser.
+ *
+ * Usage:
+ *   ltr11_recording_parser <recording[.raw.bin]> <output> [-t threads] [-c chunk_frames]
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+
+#include "Ltr11Recording.hpp"
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+#define DEFAULT_CHUNK_FRAMES        (4096U)
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct Options
+{
+    const char* recording = nullptr;
+    const char* output = nullptr;
+    unsigned threads = 0;  // 0: one per core
+    uint32_t chunk_frames = DEFAULT_CHUNK_FRAMES;
+};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+void usage(const char* program)
+{
+    fprintf(stderr,
+            "usage: %s <recording[.raw.bin]> <output> [-t threads] [-c chunk_frames]\n"
+            "  writes <output>_samples.npy and <output>_frames.npy\n"
+            "  -t  number of threads decoding and writing (default: one per core)\n"
+            "  -c  frames decoded and written at once by a thread (default %u)\n",
+            program, DEFAULT_CHUNK_FRAMES);
+}
+
+bool parse_options(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if ((arg[0] == '-') && (arg[1] != '\0') && (arg[2] == '\0'))
+        {
+            if (i + 1 >= argc)
+                return false;
+            const char* value = argv[++i];
+            switch (arg[1])
+            {
+                case 't':
+                    options.threads = static_cast<unsigned>(strtoul(value, nullptr, 10));
+                    break;
+                case 'c':
+                    options.chunk_frames = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+                    break;
+                default:
+                    return false;
+            }
+        }
+        else if (!options.recording)
+        {
+            options.recording = arg;
+        }
+        else if (!options.output)
+        {
+            options.output = arg;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return options.recording && options.output && options.chunk_frames > 0;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. MAIN METHOD
+==============================================================================
+*/
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        Ltr11Recording recording(options.recording);
+        const auto& h = recording.header();
+        printf("file format version %g, %s data, %d rx antennas, %d chirps x %d samples, %llu frames\n",
+               h.file_format_version, recording.is_complex() ? "complex" : "real", h.num_rx_antennas,
+               h.chirps_per_frame, h.samples_per_chirp, static_cast<unsigned long long>(recording.num_frames()));
+
+        const std::string output(options.output);
+        ltr11_write_npy(recording, output + "_samples.npy", output + "_frames.npy", options.threads,
+                        options.chunk_frames);
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        const double mib = double(recording.num_frames()) * double(recording.samples_per_frame())
+                           * (recording.is_complex() ? 8.0 : 4.0) / (1024.0 * 1024.0);
+        printf("wrote %.1f MiB in %.2f s (%.1f MiB/s)\n", mib, seconds, seconds > 0 ? mib / seconds : 0.0);
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "Failed to convert recording: %s\n", e.what());
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
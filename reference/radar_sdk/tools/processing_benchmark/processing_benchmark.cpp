@@ -0,0 +1,765 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    processing_benchmark.cpp
+ *
+ * @brief   Times each stage of the SDK processing chain for BGT60TR13C frames.
+ *
+ * The input frames come from a synthetic device (ifx_fmcw_create_synthetic)
+ * with a fixed scene and noise seed, so every run processes the same data,
+ * or from a capture played back with ifx_fmcw_create_playback. Both use the
+ * acquisition sequence of the BGT60TR13C examples: 3 RX antennas, 64 chirps
+ * and 128 samples per chirp unless changed on the command line.
+ *
+ * The stages are, in the order of a typical processing chain:
+ * - unpacking of the Packed12 samples sent by the sensor, to uint16 and
+ *   fused with the conversion to float as done by the device driver
+ * - conversion of raw samples to float and deinterleaving into a cube
+ * - range FFT with ifx_ppfft_run_rc (chirp by chirp) and
+ *   ifx_ppfft_run_batch_rc (whole frame)
+ * - range Doppler map (ifx_rdm_run_r)
+ * - digital beam forming of the range Doppler spectrum (ifx_dbf_run_c)
+ * - OS-CFAR on the range Doppler map (ifx_oscfar_run)
+ * - DBSCAN of the detections (ifx_dbscan_run)
+ * - Capon angle estimation of the detected range bins (ifx_anglecapon_run)
+ * - presence sensing and segmentation, if the prebuilt libraries are
+ *   available in this build; segmentation is also measured for a batch of
+ *   NUM_SENSORS sensors processed by ifx_batch_run on a thread pool
+ *
+ * Each stage is repeated for at least MIN_SECONDS and the mean time per call
+ * is printed. With -j the results are also written to a JSON file, which is
+ * meant to be archived by CI to track regressions between builds.
+ *
+ * Usage:
+ *   processing_benchmark [-i capture.rcap] [-c chirps] [-s samples] [-j results.json]
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <common/Packed12.hpp>
+
+#include "ifxAlgo/DBSCAN.h"
+#include "ifxAlgo/OSCFAR.h"
+#include "ifxAlgo/PreprocessedFFT.h"
+#include "ifxBase/Base.h"
+#include "ifxFmcw/DeviceFmcw.h"
+#include "ifxRadar/AngleCapon.h"
+#include "ifxRadar/DBF.h"
+#include "ifxRadar/RangeDopplerMap.h"
+
+#if defined(BENCHMARK_PRESENCE_SENSING) || defined(BENCHMARK_SEGMENTATION)
+#include "ifxAvian/Avian.h"
+#endif
+#ifdef BENCHMARK_PRESENCE_SENSING
+#include "ifxRadarPresenceSensing/PresenceSensing.h"
+#endif
+#ifdef BENCHMARK_SEGMENTATION
+#include "ifxRadar/Batch.h"
+#include "ifxRadarSegmentation/Segmentation.h"
+#endif
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// minimum duration of each measurement
+#define MIN_SECONDS (0.5)
+
+// zero padding factor as used by the examples
+#define ZERO_PADDING (2U)
+
+// input frames kept for the stateful algorithms
+#define NUM_INPUT_FRAMES (8U)
+
+// full scale of the 12 bit ADC
+#define MAX_ADC_VALUE (4095.0f)
+
+#define NUM_BEAMS (27U)
+
+// sensors of the batched segmentation, as served by one edge device
+#define NUM_SENSORS (8U)
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct Result
+{
+    std::string name;
+    double time_us;
+    uint64_t iterations;
+    ifx_Error_t error;
+};
+
+#ifdef BENCHMARK_SEGMENTATION
+struct SegmentationOutput
+{
+    ifx_Vector_R_t* segments;
+    ifx_Matrix_R_t* tracks;
+};
+#endif
+
+struct Options
+{
+    const char* capture = nullptr;
+    const char* json = nullptr;
+    uint32_t num_chirps = 64;
+    uint32_t num_samples = 128;
+};
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+constexpr uint32_t num_rx = 3;
+
+const ifx_Fmcw_Synthetic_Target_t scene_targets[] = {
+    // range_m, velocity_m_s, angle_deg, amplitude
+    {1.2f, 0.5f, 10.f, 0.1f},
+    {2.5f, -1.0f, -20.f, 0.05f},
+    {0.8f, 0.0f, 35.f, 0.02f},
+};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+/** @brief Mean time per call of function in microseconds */
+Result measure(const char* name, const std::function<void()>& function)
+{
+    using clock = std::chrono::steady_clock;
+
+    // warm up caches and lazily created plans
+    function();
+
+    uint64_t count = 0;
+    const auto start = clock::now();
+    double elapsed;
+    do
+    {
+        function();
+        count++;
+        elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < MIN_SECONDS);
+
+    return {name, elapsed * 1e6 / count, count, ifx_error_get_and_clear()};
+}
+
+#ifdef BENCHMARK_SEGMENTATION
+/** @brief Processing function of the batched segmentation */
+void run_segmentation(void* handle, const ifx_Cube_R_t* frame, void* output)
+{
+    auto* out = static_cast<SegmentationOutput*>(output);
+    ifx_segmentation_run(static_cast<ifx_Segmentation_t*>(handle), frame, out->segments, out->tracks);
+}
+#endif
+
+void print_usage(const char* program)
+{
+    fprintf(stderr, "usage: %s [-i capture.rcap] [-c chirps] [-s samples] [-j results.json]\n", program);
+}
+
+bool parse_options(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc)
+            return false;
+
+        if (arg == "-i")
+            options.capture = argv[++i];
+        else if (arg == "-j")
+            options.json = argv[++i];
+        else if (arg == "-c")
+            options.num_chirps = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else if (arg == "-s")
+            options.num_samples = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 0));
+        else
+            return false;
+    }
+    return (options.num_chirps > 0) && (options.num_samples > 0);
+}
+
+/** @brief Opens the synthetic device or the capture with the sequence of the examples */
+ifx_Device_Fmcw_t* open_input(const Options& options)
+{
+    ifx_Device_Fmcw_t* device;
+    if (options.capture)
+    {
+        device = ifx_fmcw_create_playback(IFX_AVIAN_BGT60TR13C, options.capture, IFX_FMCW_PLAYBACK_MAX_SPEED, true);
+    }
+    else
+    {
+        ifx_Fmcw_Synthetic_Scene_t scene = {};
+        scene.targets = scene_targets;
+        scene.num_targets = sizeof(scene_targets) / sizeof(scene_targets[0]);
+        scene.noise_amplitude = 0.002f;
+        scene.coupling_amplitude = 0.05f;
+        scene.seed = 1;
+        device = ifx_fmcw_create_synthetic(IFX_AVIAN_BGT60TR13C, &scene, IFX_FMCW_PLAYBACK_MAX_SPEED);
+    }
+    if (device == nullptr)
+        return nullptr;
+
+    ifx_Fmcw_Simple_Sequence_Config_t config = {};
+    config.frame_repetition_time_s = 0.1f;
+    config.chirp_repetition_time_s = 0.0005f;
+    config.num_chirps = options.num_chirps;
+    config.tdm_mimo = false;
+    config.chirp.start_frequency_Hz = 60e9;
+    config.chirp.end_frequency_Hz = 61.5e9;
+    config.chirp.sample_rate_Hz = 2e6f;
+    config.chirp.num_samples = options.num_samples;
+    config.chirp.rx_mask = 7;
+    config.chirp.tx_mask = 1;
+    config.chirp.tx_power_level = 31;
+    config.chirp.lp_cutoff_Hz = 500000;
+    config.chirp.hp_cutoff_Hz = 80000;
+    config.chirp.if_gain_dB = 33;
+
+    ifx_Fmcw_Sequence_Element_t* sequence = ifx_fmcw_create_simple_sequence(&config);
+    ifx_fmcw_set_acquisition_sequence(device, sequence);
+    ifx_fmcw_destroy_sequence(sequence);
+
+    return device;
+}
+
+/** @brief Packs uint16 samples into Packed12, as sent by the sensor */
+std::vector<uint8_t> pack12(const uint16_t* samples, uint32_t num_samples)
+{
+    std::vector<uint8_t> packed(num_samples / 2 * 3);
+    for (uint32_t i = 0; i + 1 < num_samples; i += 2)
+    {
+        const uint16_t a = samples[i] & 0xFFF;
+        const uint16_t b = samples[i + 1] & 0xFFF;
+        packed[i / 2 * 3 + 0] = static_cast<uint8_t>(a >> 4);
+        packed[i / 2 * 3 + 1] = static_cast<uint8_t>(((a & 0x0F) << 4) | (b >> 8));
+        packed[i / 2 * 3 + 2] = static_cast<uint8_t>(b & 0xFF);
+    }
+    return packed;
+}
+
+void set_window(ifx_Window_Config_t* window, ifx_Window_Type_t type, uint32_t size)
+{
+    window->type = type;
+    window->size = size;
+    window->scale = 1;
+    window->at_dB = 100;
+}
+
+/**
+ * @brief Complex range Doppler spectrum of all antennas
+ *
+ * The cube has the layout expected by ifx_dbf_run_c and ifx_anglecapon_run:
+ * range bins x Doppler bins x antennas.
+ */
+ifx_Cube_C_t* range_doppler_spectrum(const ifx_Cube_R_t* frame, uint32_t range_fft_size, uint32_t doppler_fft_size)
+{
+    const uint32_t num_chirps = IFX_CUBE_COLS(frame);
+    const uint32_t num_samples = IFX_CUBE_SLICES(frame);
+    const uint32_t num_range_bins = range_fft_size / 2;
+
+    ifx_PPFFT_Config_t range_config = {};
+    range_config.fft_type = IFX_FFT_TYPE_R2C;
+    range_config.fft_size = range_fft_size;
+    range_config.mean_removal_enabled = true;
+    set_window(&range_config.window_config, IFX_WINDOW_BLACKMANHARRIS, num_samples);
+
+    ifx_PPFFT_Config_t doppler_config = {};
+    doppler_config.fft_type = IFX_FFT_TYPE_C2C;
+    doppler_config.fft_size = doppler_fft_size;
+    doppler_config.mean_removal_enabled = true;
+    set_window(&doppler_config.window_config, IFX_WINDOW_CHEBYSHEV, num_chirps);
+
+    ifx_PPFFT_t* range_fft = ifx_ppfft_create(&range_config);
+    ifx_PPFFT_t* doppler_fft = ifx_ppfft_create(&doppler_config);
+    ifx_Matrix_C_t* range_spectrum = ifx_mat_create_c(num_chirps, range_fft_size);
+    ifx_Vector_C_t* chirps = ifx_vec_create_c(num_chirps);
+    ifx_Vector_C_t* doppler = ifx_vec_create_c(doppler_fft_size);
+    ifx_Cube_C_t* spectrum = ifx_cube_create_c(num_range_bins, doppler_fft_size, IFX_CUBE_ROWS(frame));
+
+    for (uint32_t a = 0; spectrum && (a < IFX_CUBE_ROWS(frame)); a++)
+    {
+        ifx_Matrix_R_t antenna_data;
+        ifx_cube_get_row_r(frame, a, &antenna_data);
+        ifx_ppfft_run_batch_rc(range_fft, &antenna_data, IFX_FFT_BATCH_ROWS, range_spectrum, IFX_FFT_BATCH_ROWS);
+
+        for (uint32_t r = 0; r < num_range_bins; r++)
+        {
+            for (uint32_t c = 0; c < num_chirps; c++)
+                IFX_VEC_AT(chirps, c) = IFX_MAT_AT(range_spectrum, c, r);
+            ifx_ppfft_run_c(doppler_fft, chirps, doppler);
+            for (uint32_t d = 0; d < doppler_fft_size; d++)
+                IFX_CUBE_AT(spectrum, r, d, a) = IFX_VEC_AT(doppler, d);
+        }
+    }
+
+    ifx_vec_destroy_c(doppler);
+    ifx_vec_destroy_c(chirps);
+    ifx_mat_destroy_c(range_spectrum);
+    ifx_ppfft_destroy(doppler_fft);
+    ifx_ppfft_destroy(range_fft);
+
+    return spectrum;
+}
+
+#if defined(BENCHMARK_PRESENCE_SENSING) || defined(BENCHMARK_SEGMENTATION)
+/** @brief Fills a cube of another shape by repeating the input frame along each axis */
+void fill_frame(const ifx_Cube_R_t* source, ifx_Cube_R_t* target)
+{
+    for (uint32_t r = 0; r < IFX_CUBE_ROWS(target); r++)
+        for (uint32_t c = 0; c < IFX_CUBE_COLS(target); c++)
+            for (uint32_t s = 0; s < IFX_CUBE_SLICES(target); s++)
+                IFX_CUBE_AT(target, r, c, s) = IFX_CUBE_AT(source, r % IFX_CUBE_ROWS(source),
+                                                           c % IFX_CUBE_COLS(source), s % IFX_CUBE_SLICES(source));
+}
+
+/** @brief Input frames in the shape of a device configuration */
+std::vector<ifx_Cube_R_t*> reshape_frames(const std::vector<ifx_Cube_R_t*>& frames, const ifx_Avian_Config_t* config)
+{
+    std::vector<ifx_Cube_R_t*> result;
+    for (const auto* frame : frames)
+    {
+        ifx_Cube_R_t* cube = ifx_cube_create_r(ifx_devconf_count_rx_antennas(config), config->num_chirps_per_frame,
+                                               config->num_samples_per_chirp);
+        if (cube == nullptr)
+            break;
+        fill_frame(frame, cube);
+        result.push_back(cube);
+    }
+    return result;
+}
+#endif
+
+bool write_json(const char* filename, const Options& options, const std::vector<Result>& results)
+{
+    FILE* file = fopen(filename, "w");
+    if (file == nullptr)
+        return false;
+
+    fprintf(file, "{\n");
+    fprintf(file, "    \"benchmark\": \"processing_benchmark\",\n");
+    fprintf(file, "    \"sdk_version\": \"%s\",\n", ifx_sdk_get_version_string_full());
+    fprintf(file, "    \"input\": \"%s\",\n", options.capture ? "capture" : "synthetic");
+    fprintf(file, "    \"num_rx_antennas\": %u,\n", num_rx);
+    fprintf(file, "    \"num_chirps_per_frame\": %u,\n", options.num_chirps);
+    fprintf(file, "    \"num_samples_per_chirp\": %u,\n", options.num_samples);
+    fprintf(file, "    \"stages\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        fprintf(file, "        {\"name\": \"%s\", \"time_us\": %.3f, \"iterations\": %llu, \"error\": %d}%s\n",
+                r.name.c_str(), r.time_us, static_cast<unsigned long long>(r.iterations), r.error,
+                (i + 1 < results.size()) ? "," : "");
+    }
+    fprintf(file, "    ]\n}\n");
+
+    return fclose(file) == 0;
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. MAIN METHOD
+==============================================================================
+*/
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ifx_Device_Fmcw_t* device = open_input(options);
+    ifx_Error_t error = ifx_error_get_and_clear();
+    if (device == nullptr || error != IFX_OK)
+    {
+        fprintf(stderr, "Cannot open input: %s\n", ifx_error_to_string(error));
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    // ------------------------------------------------------------------------
+    // input frames
+    // ------------------------------------------------------------------------
+    const uint32_t num_chirps = options.num_chirps;
+    const uint32_t num_samples = options.num_samples;
+    const uint32_t frame_size = num_rx * num_chirps * num_samples;
+
+    ifx_Fmcw_Raw_Frame_t* raw_frame = ifx_fmcw_allocate_raw_frame(device);
+    ifx_Fmcw_Raw_Frame_t* deinterleaved = ifx_fmcw_allocate_raw_frame(device);
+    std::vector<ifx_Cube_R_t*> frames;
+    std::vector<uint16_t> raw_samples;
+
+    for (uint32_t i = 0; i < NUM_INPUT_FRAMES; i++)
+    {
+        ifx_fmcw_get_next_raw_frame(device, raw_frame);
+        ifx_fmcw_deinterleave_raw_frame(device, raw_frame, deinterleaved);
+        if (ifx_error_get() != IFX_OK || raw_frame->num_samples != frame_size)
+            break;
+        if (i == 0)
+            raw_samples.assign(raw_frame->samples, raw_frame->samples + raw_frame->num_samples);
+
+        ifx_Cube_R_t* frame = ifx_cube_create_r(num_rx, num_chirps, num_samples);
+        if (frame == nullptr)
+            break;
+        ifx_fmcw_convert_raw_data_to_float_array(device, frame_size, deinterleaved->samples, IFX_CUBE_DAT(frame));
+        frames.push_back(frame);
+    }
+
+    error = ifx_error_get_and_clear();
+    if (frames.size() != NUM_INPUT_FRAMES)
+    {
+        fprintf(stderr, "Cannot read %u frames of %u x %u x %u samples: %s\n", NUM_INPUT_FRAMES, num_rx, num_chirps,
+                num_samples, ifx_error_to_string(error));
+        for (auto* f : frames)
+            ifx_cube_destroy_r(f);
+        ifx_fmcw_destroy_raw_frame(deinterleaved);
+        ifx_fmcw_destroy_raw_frame(raw_frame);
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    const ifx_Cube_R_t* frame = frames[0];
+    ifx_Matrix_R_t antenna_data;
+    ifx_cube_get_row_r(frame, 0, &antenna_data);
+
+    const uint32_t range_fft_size = num_samples * ZERO_PADDING;
+    const uint32_t doppler_fft_size = num_chirps * ZERO_PADDING;
+    const uint32_t num_range_bins = range_fft_size / 2;
+
+    std::vector<Result> results;
+
+    // ------------------------------------------------------------------------
+    // data conversion
+    // ------------------------------------------------------------------------
+    {
+        const std::vector<uint8_t> packed = pack12(raw_samples.data(), frame_size);
+        std::vector<uint16_t> unpacked(frame_size);
+        std::vector<float> converted(frame_size);
+
+        results.push_back(measure("packed12_unpack", [&] {
+            unpackPacked12(packed.data(), packed.data() + packed.size(), unpacked.data());
+        }));
+        results.push_back(measure("packed12_unpack_float", [&] {
+            unpackPacked12(packed.data(), packed.data() + packed.size(), converted.data(), 2.0f / MAX_ADC_VALUE, -1.0f);
+        }));
+        results.push_back(measure("raw_deinterleave", [&] {
+            ifx_fmcw_deinterleave_raw_frame(device, raw_frame, deinterleaved);
+        }));
+
+        ifx_Cube_R_t* cube = ifx_cube_create_r(num_rx, num_chirps, num_samples);
+        results.push_back(measure("raw_to_float_cube", [&] {
+            ifx_fmcw_convert_raw_data_to_float_array(device, frame_size, deinterleaved->samples, IFX_CUBE_DAT(cube));
+        }));
+        ifx_cube_destroy_r(cube);
+    }
+
+    // ------------------------------------------------------------------------
+    // range FFT and range Doppler map
+    // ------------------------------------------------------------------------
+    ifx_Matrix_R_t* rdm_output = ifx_mat_create_r(num_range_bins, doppler_fft_size);
+    {
+        ifx_PPFFT_Config_t config = {};
+        config.fft_type = IFX_FFT_TYPE_R2C;
+        config.fft_size = range_fft_size;
+        config.mean_removal_enabled = true;
+        set_window(&config.window_config, IFX_WINDOW_BLACKMANHARRIS, num_samples);
+
+        ifx_PPFFT_t* ppfft = ifx_ppfft_create(&config);
+        ifx_Vector_C_t* spectrum = ifx_vec_create_c(range_fft_size);
+        ifx_Matrix_C_t* spectra = ifx_mat_create_c(num_chirps, range_fft_size);
+
+        results.push_back(measure("ppfft_run_rc", [&] {
+            for (uint32_t c = 0; c < num_chirps; c++)
+            {
+                ifx_Vector_R_t chirp;
+                ifx_mat_get_rowview_r(&antenna_data, c, &chirp);
+                ifx_ppfft_run_rc(ppfft, &chirp, spectrum);
+            }
+        }));
+        results.push_back(measure("ppfft_run_batch_rc", [&] {
+            ifx_ppfft_run_batch_rc(ppfft, &antenna_data, IFX_FFT_BATCH_ROWS, spectra, IFX_FFT_BATCH_ROWS);
+        }));
+
+        ifx_mat_destroy_c(spectra);
+        ifx_vec_destroy_c(spectrum);
+        ifx_ppfft_destroy(ppfft);
+
+        ifx_RDM_Config_t rdm_config = {};
+        rdm_config.spect_threshold = (ifx_Float_t)1e-6;
+        rdm_config.output_scale_type = IFX_SCALE_TYPE_LINEAR;
+        rdm_config.range_fft_config.fft_type = IFX_FFT_TYPE_R2C;
+        rdm_config.range_fft_config.fft_size = range_fft_size;
+        rdm_config.range_fft_config.mean_removal_enabled = true;
+        set_window(&rdm_config.range_fft_config.window_config, IFX_WINDOW_BLACKMANHARRIS, num_samples);
+        rdm_config.doppler_fft_config.fft_type = IFX_FFT_TYPE_C2C;
+        rdm_config.doppler_fft_config.fft_size = doppler_fft_size;
+        rdm_config.doppler_fft_config.mean_removal_enabled = true;
+        set_window(&rdm_config.doppler_fft_config.window_config, IFX_WINDOW_CHEBYSHEV, num_chirps);
+
+        ifx_RDM_t* rdm = ifx_rdm_create(&rdm_config);
+        results.push_back(measure("rdm_run_r", [&] { ifx_rdm_run_r(rdm, &antenna_data, rdm_output); }));
+        ifx_rdm_destroy(rdm);
+    }
+
+    // ------------------------------------------------------------------------
+    // beam forming, detection, clustering and angle estimation
+    // ------------------------------------------------------------------------
+    ifx_Cube_C_t* spectrum = range_doppler_spectrum(frame, range_fft_size, doppler_fft_size);
+    {
+        ifx_DBF_Config_t dbf_config = {};
+        dbf_config.num_beams = NUM_BEAMS;
+        dbf_config.num_antennas = num_rx;
+        dbf_config.min_angle = -45;
+        dbf_config.max_angle = 45;
+        dbf_config.d_by_lambda = 0.5;
+
+        ifx_DBF_t* dbf = ifx_dbf_create(&dbf_config);
+        ifx_Cube_C_t* beams = ifx_cube_create_c(num_range_bins, doppler_fft_size, NUM_BEAMS);
+        results.push_back(measure("dbf_run_c", [&] { ifx_dbf_run_c(dbf, spectrum, beams); }));
+        ifx_cube_destroy_c(beams);
+        ifx_dbf_destroy(dbf);
+    }
+
+    std::vector<uint16_t> detections;
+    {
+        ifx_OSCFAR_Config_t cfar_config = {};
+        cfar_config.win_rank = 3;
+        cfar_config.guard_band = 1;
+        cfar_config.sample = 0;
+        cfar_config.pfa = (ifx_Float_t)2e-4;
+        cfar_config.coarse_scalar = 1;
+
+        ifx_OSCFAR_t* cfar = ifx_oscfar_create(&cfar_config);
+        ifx_Matrix_R_t* feature = ifx_mat_create_r(num_range_bins, doppler_fft_size);
+        ifx_Matrix_R_t* detected = ifx_mat_create_r(num_range_bins, doppler_fft_size);
+
+        // ifx_oscfar_run modifies its input, the copy is part of the measurement
+        results.push_back(measure("oscfar_run", [&] {
+            ifx_mat_copy_r(rdm_output, feature);
+            ifx_oscfar_run(cfar, feature, detected);
+        }));
+
+        for (uint32_t r = 0; r < num_range_bins; r++)
+        {
+            for (uint32_t d = 0; d < doppler_fft_size; d++)
+            {
+                if (IFX_MAT_AT(detected, r, d) > 0)
+                {
+                    detections.push_back(static_cast<uint16_t>(r));
+                    detections.push_back(static_cast<uint16_t>(d));
+                }
+            }
+        }
+
+        ifx_mat_destroy_r(detected);
+        ifx_mat_destroy_r(feature);
+        ifx_oscfar_destroy(cfar);
+    }
+
+    {
+        // the clustering should have some work even if CFAR found few cells
+        const uint32_t min_detections = 64;
+        for (uint32_t i = static_cast<uint32_t>(detections.size() / 2); i < min_detections; i++)
+        {
+            detections.push_back(static_cast<uint16_t>((i * 7) % num_range_bins));
+            detections.push_back(static_cast<uint16_t>((i * 13) % doppler_fft_size));
+        }
+        const uint16_t num_detections = static_cast<uint16_t>(std::min<size_t>(detections.size() / 2, UINT16_MAX));
+
+        ifx_DBSCAN_Config_t dbscan_config = {};
+        dbscan_config.min_points = 2;
+        dbscan_config.min_dist = 4;
+        dbscan_config.max_num_detections = num_detections;
+
+        ifx_DBSCAN_t* dbscan = ifx_dbscan_create(&dbscan_config);
+        std::vector<uint16_t> clusters(num_detections);
+        results.push_back(measure("dbscan_run", [&] {
+            ifx_dbscan_run(dbscan, detections.data(), num_detections, clusters.data());
+        }));
+        ifx_dbscan_destroy(dbscan);
+    }
+
+    {
+        ifx_AngleCapon_Config_t capon_config = {};
+        capon_config.range_win_size = 5;
+        capon_config.selected_rx = 0;
+        capon_config.chirps_per_frame = static_cast<uint16_t>(doppler_fft_size);
+        capon_config.phase_offset_degrees = 0;
+        capon_config.num_virtual_antennas = 2;
+        capon_config.num_beams = NUM_BEAMS;
+        capon_config.min_angle_degrees = -40;
+        capon_config.max_angle_degrees = 40;
+        capon_config.d_by_lambda = 0.5;
+
+        // one range bin per target of the synthetic scene
+        std::vector<uint32_t> range_bins;
+        for (uint32_t i = 1; i <= 3; i++)
+            range_bins.push_back(i * num_range_bins / 8);
+
+        ifx_AngleCapon_t* capon = ifx_anglecapon_create(&capon_config);
+        std::vector<ifx_Float_t> angles(range_bins.size());
+        results.push_back(measure("anglecapon_run", [&] {
+            for (size_t i = 0; i < range_bins.size(); i++)
+                angles[i] = ifx_anglecapon_run(capon, range_bins[i], spectrum);
+        }));
+        ifx_anglecapon_destroy(capon);
+    }
+    ifx_cube_destroy_c(spectrum);
+
+    // ------------------------------------------------------------------------
+    // applications (prebuilt libraries)
+    // ------------------------------------------------------------------------
+#ifdef BENCHMARK_PRESENCE_SENSING
+    {
+        ifx_Avian_Config_t sensor_config;
+        ifx_Presence_Sensing_Config_t presence_config;
+        ifx_presence_sensing_get_config_defaults(IFX_AVIAN_BGT60TR13C, &sensor_config, &presence_config);
+
+        ifx_Presence_Sensing_t* presence = ifx_presence_sensing_create(&sensor_config, &presence_config);
+        std::vector<ifx_Cube_R_t*> input = reshape_frames(frames, &sensor_config);
+        ifx_Presence_Sensing_Result_t result;
+        size_t index = 0;
+        results.push_back(measure("presence_sensing_run", [&] {
+            ifx_presence_sensing_run(presence, input[index++ % input.size()], &result);
+        }));
+        for (auto* cube : input)
+            ifx_cube_destroy_r(cube);
+        ifx_presence_sensing_destroy(presence);
+    }
+#endif
+
+#ifdef BENCHMARK_SEGMENTATION
+    {
+        ifx_Avian_Config_t device_config;
+        ifx_Segmentation_t* segmentation = ifx_segmentation_create_from_mode(IFX_SEGMENTATION_1GHZ_LANDSCAPE, &device_config);
+        std::vector<ifx_Cube_R_t*> input = reshape_frames(frames, &device_config);
+        ifx_Vector_R_t* segments = ifx_vec_create_r(6);
+        ifx_Matrix_R_t* tracks = ifx_mat_create_r(5, 4);
+        size_t index = 0;
+        results.push_back(measure("segmentation_run", [&] {
+            ifx_segmentation_run(segmentation, input[index++ % input.size()], segments, tracks);
+        }));
+        ifx_mat_destroy_r(tracks);
+        ifx_vec_destroy_r(segments);
+        ifx_segmentation_destroy(segmentation);
+
+        // one handle and output per sensor, all sensors see the same frames
+        ifx_Executor_t* executor = ifx_executor_create(0);
+        std::vector<SegmentationOutput> outputs(NUM_SENSORS);
+        std::vector<ifx_Batch_Item_t> items(NUM_SENSORS);
+        for (uint32_t i = 0; i < NUM_SENSORS; i++)
+        {
+            outputs[i] = {ifx_vec_create_r(6), ifx_mat_create_r(5, 4)};
+            items[i] = {ifx_segmentation_create_from_mode(IFX_SEGMENTATION_1GHZ_LANDSCAPE, &device_config), nullptr, &outputs[i], IFX_OK};
+        }
+
+        index = 0;
+        results.push_back(measure(("segmentation_batch_" + std::to_string(NUM_SENSORS)).c_str(), [&] {
+            for (auto& item : items)
+                item.frame = input[index % input.size()];
+            index++;
+            ifx_batch_run(executor, run_segmentation, items.data(), NUM_SENSORS);
+        }));
+
+        for (uint32_t i = 0; i < NUM_SENSORS; i++)
+        {
+            ifx_segmentation_destroy(static_cast<ifx_Segmentation_t*>(items[i].handle));
+            ifx_mat_destroy_r(outputs[i].tracks);
+            ifx_vec_destroy_r(outputs[i].segments);
+        }
+        ifx_executor_destroy(executor);
+        for (auto* cube : input)
+            ifx_cube_destroy_r(cube);
+    }
+#endif
+
+    // ------------------------------------------------------------------------
+    // results
+    // ------------------------------------------------------------------------
+    printf("%u x %u x %u samples, %s input\n\n", num_rx, num_chirps, num_samples, options.capture ? "recorded" : "synthetic");
+    printf("%-24s %14s %12s\n", "stage", "time [us]", "iterations");
+
+    int exitcode = EXIT_SUCCESS;
+    for (const auto& r : results)
+    {
+        if (r.error != IFX_OK)
+        {
+            printf("%-24s failed: %s\n", r.name.c_str(), ifx_error_to_string(r.error));
+            exitcode = EXIT_FAILURE;
+            continue;
+        }
+        printf("%-24s %14.3f %12llu\n", r.name.c_str(), r.time_us, static_cast<unsigned long long>(r.iterations));
+    }
+
+    if (options.json && !write_json(options.json, options, results))
+    {
+        fprintf(stderr, "Cannot write %s\n", options.json);
+        exitcode = EXIT_FAILURE;
+    }
+
+    ifx_mat_destroy_r(rdm_output);
+    for (auto* f : frames)
+        ifx_cube_destroy_r(f);
+    ifx_fmcw_destroy_raw_frame(deinterleaved);
+    ifx_fmcw_destroy_raw_frame(raw_frame);
+    ifx_fmcw_destroy(device);
+
+    return exitcode;
+}
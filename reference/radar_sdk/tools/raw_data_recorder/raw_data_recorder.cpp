@@ -0,0 +1,603 @@
+/* ===========================================================================
+** Copyright (C) 2021 Infineon Technologies AG
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions are met:
+**
+** 1. Redistributions of source code must retain the above copyright notice,
+**    this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. Neither the name of the copyright holder nor the names of its
+**    contributors may be used to endorse or promote products derived from
+**    this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+** AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+** IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+** ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+** LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+** CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+** SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+** INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+** CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+** ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+** POSSIBILITY OF SUCH DAMAGE.
+** ===========================================================================
+*/
+
+/**
+ * @file    raw_data_recorder.cpp
+ *
+ * @brief   Records raw time domain data of an Avian sensor to an indexed capture file.
+ *
+ * The main thread only fetches raw frames with ifx_fmcw_get_next_raw_frame_timeout
+ * into a pool of preallocated frames. A writer thread adds the frames to a
+ * .rcap container (data_test/radr_capture/radr_file.h), the format written by
+ * radr_capture for the MCU stream, so radr_index, format_binary_frames.py and
+ * ifx_fmcw_create_playback read both recordings alike.
+ *
+ * Every frame gets a version 3 stream header with the frame counter, the host
+ * timestamp and the CRC-32 of the payload. A frame that could not be recorded,
+ * because the device FIFO overflowed or the writer fell behind, leaves a gap
+ * in the frame counter and sets BINARY_FRAME_FLAG_FIFO_OVERFLOW on the next
+ * recorded frame. The metadata holds the device configuration with the same
+ * keys as the MCU recordings, plus the register file of the device.
+ *
+ * Usage:
+ *   raw_data_recorder <output.rcap> [-n frames] [-d seconds] [-r register_file]
+ *                     [-u uuid] [-p pool_frames] [-b buffer_MiB]
+ */
+
+/*
+==============================================================================
+1. INCLUDE FILES
+==============================================================================
+*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ifxAvian/Avian.h"
+#include "ifxBase/Base.h"
+#include "ifxBase/internal/Util.h"  // for ifx_util_popcount
+#include "ifxFmcw/DeviceFmcw.h"
+#include "radr_file.h"
+
+/*
+==============================================================================
+2. LOCAL DEFINITIONS
+==============================================================================
+*/
+
+// stream header of the MCU firmware (binary_frame_header_t in src/main.c)
+#define STREAM_HEADER_VERSION       (3U)
+#define STREAM_HEADER_SIZE          (32U)
+#define FRAME_FORMAT_U16LE          (0U)
+#define FRAME_FLAG_FIFO_OVERFLOW    (1U << 1)
+
+#define DEFAULT_POOL_FRAMES         (256U)
+#define DEFAULT_BUFFER_MIB          (16U)
+#define FRAME_TIMEOUT_MS            (1000U)
+
+/*
+==============================================================================
+3. LOCAL TYPES
+==============================================================================
+*/
+
+namespace {
+
+struct Options
+{
+    const char* output = nullptr;
+    uint64_t max_frames = 0;  // 0: until interrupted
+    double max_seconds = 0;   // 0: until interrupted
+    const char* register_file = nullptr;
+    const char* uuid = nullptr;
+    uint32_t pool_frames = DEFAULT_POOL_FRAMES;
+    uint32_t buffer_mib = DEFAULT_BUFFER_MIB;
+};
+
+struct Slot
+{
+    ifx_Fmcw_Raw_Frame_t* frame;
+    uint32_t frame_index;
+    uint32_t timestamp_us;
+    uint16_t flags;
+};
+
+/* Recorded frames travel from the acquisition thread to the writer thread
+   through filled; the writer hands them back through free_slots. Only slot
+   numbers are exchanged, the frames themselves are never copied. */
+class SlotQueue
+{
+public:
+    void push(uint32_t slot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_slots.push_back(slot);
+            if (m_slots.size() > m_high_water)
+                m_high_water = m_slots.size();
+        }
+        m_cv.notify_one();
+    }
+
+    bool try_pop(uint32_t& slot)
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_slots.empty())
+            return false;
+        slot = m_slots.front();
+        m_slots.pop_front();
+        return true;
+    }
+
+    // waits until a slot is available or the queue is closed and empty
+    bool pop(uint32_t& slot)
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_cv.wait(lock, [this] { return !m_slots.empty() || m_closed; });
+        if (m_slots.empty())
+            return false;
+        slot = m_slots.front();
+        m_slots.pop_front();
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_closed = true;
+        }
+        m_cv.notify_all();
+    }
+
+    size_t high_water()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        return m_high_water;
+    }
+
+private:
+    std::mutex m_lock;
+    std::condition_variable m_cv;
+    std::deque<uint32_t> m_slots;
+    size_t m_high_water = 0;
+    bool m_closed = false;
+};
+
+/*
+==============================================================================
+4. LOCAL DATA
+==============================================================================
+*/
+
+std::atomic<bool> g_stop {false};
+
+/*
+==============================================================================
+6. LOCAL FUNCTIONS
+==============================================================================
+*/
+
+void on_signal(int)
+{
+    g_stop = true;
+}
+
+void put_u16(uint8_t* p, uint16_t value)
+{
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void put_u32(uint8_t* p, uint32_t value)
+{
+    put_u16(p, static_cast<uint16_t>(value));
+    put_u16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+void usage(const char* program)
+{
+    fprintf(stderr,
+            "usage: %s <output.rcap> [-n frames] [-d seconds] [-r register_file]\n"
+            "       [-u uuid] [-p pool_frames] [-b buffer_MiB]\n"
+            "  -n  stop after this many frames (default: until Ctrl-C)\n"
+            "  -d  stop after this many seconds (default: until Ctrl-C)\n"
+            "  -r  load this register file before recording\n"
+            "  -u  open the board with this UUID instead of the first one found\n"
+            "  -p  frames buffered between acquisition and writer (default %u)\n"
+            "  -b  size of the file write buffer in MiB (default %u)\n",
+            program, DEFAULT_POOL_FRAMES, DEFAULT_BUFFER_MIB);
+}
+
+bool parse_options(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if ((arg[0] == '-') && (arg[1] != '\0') && (arg[2] == '\0'))
+        {
+            if (i + 1 >= argc)
+                return false;
+            const char* value = argv[++i];
+            switch (arg[1])
+            {
+                case 'n':
+                    options.max_frames = strtoull(value, nullptr, 10);
+                    break;
+                case 'd':
+                    options.max_seconds = strtod(value, nullptr);
+                    break;
+                case 'r':
+                    options.register_file = value;
+                    break;
+                case 'u':
+                    options.uuid = value;
+                    break;
+                case 'p':
+                    options.pool_frames = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+                    break;
+                case 'b':
+                    options.buffer_mib = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+                    break;
+                default:
+                    return false;
+            }
+        }
+        else if (!options.output)
+        {
+            options.output = arg;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return options.output && (options.pool_frames >= 2);
+}
+
+const char* device_name(ifx_Radar_Sensor_t sensor)
+{
+    // spelled like XENSIV_BGT60TRXX_CONF_DEVICE in the MCU recordings
+    switch (sensor)
+    {
+        case IFX_AVIAN_BGT60TR13C:
+            return "XENSIV_DEVICE_BGT60TR13C";
+        case IFX_AVIAN_BGT60ATR24C:
+            return "XENSIV_DEVICE_BGT60ATR24C";
+        case IFX_AVIAN_BGT60UTR13DAIP:
+            return "XENSIV_DEVICE_BGT60UTR13D";
+        case IFX_AVIAN_BGT60UTR11AIP:
+            return "XENSIV_DEVICE_BGT60UTR11";
+        default:
+            return "unknown";
+    }
+}
+
+/* The register file of the device as one metadata value; its lines are
+   separated by ';' since metadata values cannot span lines. */
+std::string register_file_snapshot(ifx_Device_Fmcw_t* device, const std::string& path)
+{
+    ifx_fmcw_save_register_file(device, path.c_str());
+    if (ifx_error_get_and_clear() != IFX_OK)
+        return std::string();
+
+    std::string snapshot;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty())
+            continue;
+        if (!snapshot.empty())
+            snapshot += ';';
+        snapshot += line;
+    }
+    file.close();
+    std::remove(path.c_str());
+    return snapshot;
+}
+
+std::string build_metadata(ifx_Device_Fmcw_t* device, const ifx_Fmcw_Raw_Frame_t* frame, const std::string& output)
+{
+    std::ostringstream text;
+
+    ifx_Avian_Config_t config = {};
+    ifx_avian_get_config(device, &config);
+    const ifx_Error_t config_error = ifx_error_get_and_clear();
+
+    if (config_error == IFX_OK)
+    {
+        text << "device=" << device_name(ifx_fmcw_get_sensor_type(device)) << "\n";
+        text << "start_freq_hz=" << config.start_frequency_Hz << "\n";
+        text << "end_freq_hz=" << config.end_frequency_Hz << "\n";
+        text << "num_samples_per_chirp=" << config.num_samples_per_chirp << "\n";
+        text << "num_chirps_per_frame=" << config.num_chirps_per_frame << "\n";
+        text << "num_rx_antennas=" << ifx_util_popcount(config.rx_mask) << "\n";
+        text << "num_tx_antennas=" << ifx_util_popcount(config.tx_mask) << "\n";
+        text << "sample_rate=" << config.sample_rate_Hz << "\n";
+        text << "chirp_repetition_time_s=" << config.chirp_repetition_time_s << "\n";
+        text << "frame_repetition_time_s=" << config.frame_repetition_time_s << "\n";
+    }
+
+    const uint32_t num_registers = ifx_avian_export_register_list(device, true, nullptr);
+    if ((ifx_error_get_and_clear() == IFX_OK) && (num_registers > 0))
+    {
+        std::vector<uint32_t> registers(num_registers);
+        ifx_avian_export_register_list(device, true, registers.data());
+        if (ifx_error_get_and_clear() == IFX_OK)
+        {
+            char word[16];
+            text << "registers=";
+            for (uint32_t i = 0; i < num_registers; i++)
+            {
+                snprintf(word, sizeof(word), "%s0x%08lx", (i > 0) ? "," : "", static_cast<unsigned long>(registers[i]));
+                text << word;
+            }
+            text << "\n";
+        }
+    }
+
+    const auto snapshot = register_file_snapshot(device, output + ".registers.tmp");
+    if (!snapshot.empty())
+        text << "register_file=" << snapshot << "\n";
+
+    text << "recorder=raw_data_recorder\n";
+    text << "sdk_version=" << ifx_sdk_get_version_string_full() << "\n";
+    text << "board_uuid=" << ifx_fmcw_get_board_uuid(device) << "\n";
+    text << "samples_per_frame=" << frame->num_samples << "\n";
+    text << "adc_resolution_bits=" << static_cast<unsigned>(ifx_fmcw_get_sensor_information(device)->adc_resolution_bits) << "\n";
+    text << "timestamp=host_steady_clock_us\n";
+
+    return text.str();
+}
+
+// also read by the acquisition thread for the progress line
+struct WriterStats
+{
+    std::atomic<uint64_t> frames {0};
+    std::atomic<uint64_t> bytes {0};
+    std::atomic<bool> failed {false};
+};
+
+void writer_thread(radr_file_writer_t* writer, std::vector<Slot>& slots, SlotQueue& filled, SlotQueue& free_slots,
+                   WriterStats& stats)
+{
+    uint8_t header[STREAM_HEADER_SIZE] = {'R', 'A', 'D', 'R'};
+    uint32_t index;
+
+    while (filled.pop(index))
+    {
+        const auto& slot = slots[index];
+        const auto* payload = reinterpret_cast<const uint8_t*>(slot.frame->samples);
+        const size_t payload_size = static_cast<size_t>(slot.frame->num_samples) * sizeof(uint16_t);
+
+        // the SDK delivers host order samples, which is the U16LE payload on
+        // all supported hosts
+        put_u16(header + 4, STREAM_HEADER_VERSION);
+        put_u16(header + 6, sizeof(uint16_t));
+        put_u32(header + 8, slot.frame_index);
+        put_u32(header + 12, slot.frame->num_samples);
+        put_u16(header + 16, FRAME_FORMAT_U16LE);
+        put_u16(header + 18, slot.flags);
+        put_u32(header + 20, static_cast<uint32_t>(payload_size));
+        put_u32(header + 24, slot.timestamp_us);
+        put_u32(header + 28, radr_crc32(0, payload, payload_size));
+
+        if (!stats.failed && !radr_file_writer_add(writer, header, sizeof(header), payload, payload_size, nullptr, 0))
+        {
+            // keep draining, so acquisition does not block; the loss is reported at the end
+            stats.failed = true;
+            g_stop = true;
+        }
+        stats.frames++;
+        stats.bytes += payload_size;
+
+        free_slots.push(index);
+    }
+}
+
+}  // namespace
+
+/*
+==============================================================================
+7. MAIN METHOD
+==============================================================================
+ */
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ifx_Device_Fmcw_t* device = options.uuid ? ifx_fmcw_create_by_uuid(options.uuid) : ifx_fmcw_create();
+    ifx_Error_t error = ifx_error_get_and_clear();
+    if (error != IFX_OK)
+    {
+        fprintf(stderr, "Failed to open device: %s\n", ifx_error_to_string(error));
+        return EXIT_FAILURE;
+    }
+
+    if (options.register_file)
+    {
+        ifx_fmcw_load_register_file(device, options.register_file);
+        error = ifx_error_get_and_clear();
+        if (error != IFX_OK)
+        {
+            fprintf(stderr, "Failed to load register file: %s\n", ifx_error_to_string(error));
+            ifx_fmcw_destroy(device);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // all frames are allocated up front, nothing is allocated while recording
+    std::vector<Slot> slots(options.pool_frames);
+    SlotQueue filled;
+    SlotQueue free_slots;
+    for (uint32_t i = 0; i < options.pool_frames; i++)
+    {
+        slots[i].frame = ifx_fmcw_allocate_raw_frame(device);
+        free_slots.push(i);
+    }
+    ifx_Fmcw_Raw_Frame_t* scratch = ifx_fmcw_allocate_raw_frame(device);
+    error = ifx_error_get_and_clear();
+    if (error != IFX_OK)
+    {
+        fprintf(stderr, "Failed to allocate frames: %s\n", ifx_error_to_string(error));
+        for (auto& slot : slots)
+            ifx_fmcw_destroy_raw_frame(slot.frame);
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    const auto metadata = build_metadata(device, scratch, options.output);
+    radr_file_writer_t* writer = radr_file_writer_open_buffered(options.output, metadata.data(), metadata.size(),
+                                                                static_cast<size_t>(options.buffer_mib) << 20);
+    if (!writer)
+    {
+        fprintf(stderr, "Failed to create %s\n", options.output);
+        for (auto& slot : slots)
+            ifx_fmcw_destroy_raw_frame(slot.frame);
+        ifx_fmcw_destroy_raw_frame(scratch);
+        ifx_fmcw_destroy(device);
+        return EXIT_FAILURE;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    WriterStats writer_stats;
+    std::thread writer_worker(writer_thread, writer, std::ref(slots), std::ref(filled), std::ref(free_slots),
+                              std::ref(writer_stats));
+
+    printf("Recording %u samples per frame to %s, press Ctrl-C to stop\n", scratch->num_samples, options.output);
+
+    uint64_t acquired = 0;
+    uint64_t device_overflows = 0;
+    uint64_t host_drops = 0;
+    uint64_t other_errors = 0;
+    uint32_t frame_index = 0;
+    uint16_t pending_flags = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto last_report = start;
+
+    ifx_fmcw_start_acquisition(device);
+    while (!g_stop)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - start).count();
+        if ((options.max_frames && (acquired >= options.max_frames)) || ((options.max_seconds > 0) && (elapsed >= options.max_seconds)))
+            break;
+
+        if (now - last_report >= std::chrono::seconds(1))
+        {
+            printf("\r%.0f s: %llu frames, %.1f MB written, %llu lost",
+                   elapsed,
+                   static_cast<unsigned long long>(acquired),
+                   static_cast<double>(writer_stats.bytes.load()) / 1e6,
+                   static_cast<unsigned long long>(device_overflows + host_drops));
+            fflush(stdout);
+            last_report = now;
+        }
+
+        // when the writer falls behind, the frame is still fetched to keep
+        // the device FIFO from overflowing, but it is not recorded
+        uint32_t index;
+        const bool have_slot = free_slots.try_pop(index);
+        ifx_Fmcw_Raw_Frame_t* frame = have_slot ? slots[index].frame : scratch;
+
+        ifx_fmcw_get_next_raw_frame_timeout(device, frame, FRAME_TIMEOUT_MS);
+        const auto timestamp = std::chrono::steady_clock::now();
+        error = ifx_error_get_and_clear();
+
+        if (error != IFX_OK)
+        {
+            if (have_slot)
+                free_slots.push(index);
+
+            if (error == IFX_ERROR_FIFO_OVERFLOW)
+            {
+                // at least one frame was lost in the device
+                device_overflows++;
+                frame_index++;
+                pending_flags |= FRAME_FLAG_FIFO_OVERFLOW;
+            }
+            else if (error != IFX_ERROR_TIMEOUT)
+            {
+                fprintf(stderr, "\nFailed to get next frame: %s\n", ifx_error_to_string(error));
+                other_errors++;
+                break;
+            }
+            continue;
+        }
+
+        acquired++;
+        if (!have_slot)
+        {
+            host_drops++;
+            frame_index++;
+            pending_flags |= FRAME_FLAG_FIFO_OVERFLOW;
+            continue;
+        }
+
+        auto& slot = slots[index];
+        slot.frame_index = frame_index++;
+        slot.timestamp_us = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch()).count());
+        slot.flags = pending_flags;
+        pending_flags = 0;
+        filled.push(index);
+    }
+    ifx_fmcw_stop_acquisition(device);
+    ifx_error_get_and_clear();
+
+    filled.close();
+    writer_worker.join();
+    const bool closed = radr_file_writer_close(writer);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("\nRecorded %llu of %llu frames (%.1f MB, %.1f MB/s) in %.1f s\n",
+           static_cast<unsigned long long>(writer_stats.frames.load()),
+           static_cast<unsigned long long>(acquired),
+           static_cast<double>(writer_stats.bytes.load()) / 1e6,
+           (seconds > 0) ? static_cast<double>(writer_stats.bytes.load()) / 1e6 / seconds : 0.0,
+           seconds);
+    printf("Device FIFO overflows: %llu, frames dropped on the host: %llu, writer queue high water: %zu of %u\n",
+           static_cast<unsigned long long>(device_overflows),
+           static_cast<unsigned long long>(host_drops),
+           filled.high_water(),
+           options.pool_frames);
+    if (writer_stats.failed || !closed)
+        fprintf(stderr, "Writing %s failed\n", options.output);
+
+    for (auto& slot : slots)
+        ifx_fmcw_destroy_raw_frame(slot.frame);
+    ifx_fmcw_destroy_raw_frame(scratch);
+    ifx_fmcw_destroy(device);
+
+    const bool lossless = (device_overflows == 0) && (host_drops == 0) && (other_errors == 0);
+    return (lossless && closed && !writer_stats.failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,334 @@
+/* CM0+ side of the dual-core build (DUAL_CORE_ACQUISITION=1, see the
+   Makefile). The CM0+ owns the sensor: SPI, the FIFO interrupt and the DMA
+   readout into the frame ring the CM4 shares through ipc_frames.h. The CM4
+   only processes and transmits, and controls the sensor with mailbox
+   commands. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+#include "cybsp.h"
+
+#include "xensiv_bgt60trxx_mtb.h"
+
+#include "fifo_dma.h"
+#include "frame_ring.h"
+#include "ipc_frames.h"
+#include "spi_calib.h"
+#include "timebase.h"
+
+#define XENSIV_BGT60TRXX_CONF_IMPL
+#include "presence_radar_settings.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same wiring as in main.c. */
+#define PIN_XENSIV_BGT60TRXX_SPI_SCLK       CYBSP_SPI_CLK
+#define PIN_XENSIV_BGT60TRXX_SPI_MOSI       CYBSP_SPI_MOSI
+#define PIN_XENSIV_BGT60TRXX_SPI_MISO       CYBSP_SPI_MISO
+#define PIN_XENSIV_BGT60TRXX_SPI_CSN        CYBSP_SPI_CS
+#define PIN_XENSIV_BGT60TRXX_IRQ            CYBSP_GPIO10
+#define PIN_XENSIV_BGT60TRXX_RSTN           CYBSP_GPIO11
+#define PIN_XENSIV_BGT60TRXX_LDO_EN         CYBSP_GPIO5
+
+#define XENSIV_BGT60TRXX_SPI_FREQUENCY      (25000000UL)
+
+#define NUM_SAMPLES_PER_FRAME               (XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *\
+                                             XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME *\
+                                             XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static cyhal_spi_t cyhal_spi;
+static xensiv_bgt60trxx_mtb_t sensor;
+static ipc_frames_shared_t *shared = NULL;
+static volatile bool capture_enabled = false;
+static volatile uint32_t frame_limit = 0U;     /* 0: no limit */
+static volatile uint32_t capture_frame_index = 0U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void publish_stats(void)
+{
+    fifo_dma_stats_t stats;
+
+    fifo_dma_get_stats(&stats);
+    shared->stats = stats;
+}
+
+/* A readout ended: hand the frame (or the drop) to the CM4. */
+static void readout_done(void)
+{
+    publish_stats();
+    ipc_frames_notify();
+}
+
+#if defined(CYHAL_API_VERSION) && (CYHAL_API_VERSION >= 2)
+void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_event_t event)
+#else
+void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_irq_event_t event)
+#endif
+{
+    CY_UNUSED_PARAMETER(args);
+    CY_UNUSED_PARAMETER(event);
+
+    uint32_t timestamp_us = timebase_now_us();
+
+    if (capture_enabled)
+    {
+        if ((frame_limit == 0U) || (frame_ring_written(shared->ring) < frame_limit))
+        {
+#if FIFO_SLICE_CHIRPS
+            fifo_dma_slice_ready(timestamp_us);
+#else
+            fifo_dma_start(capture_frame_index, timestamp_us);
+#endif
+        }
+
+#if FIFO_SLICE_CHIRPS
+        capture_frame_index = fifo_dma_frame_count();
+#else
+        capture_frame_index++;
+#endif
+        shared->frame_index = capture_frame_index;
+    }
+}
+
+static bool start_sensor(void)
+{
+    fifo_dma_reset_stats();
+    fifo_dma_restart();
+    publish_stats();
+    capture_frame_index = 0U;
+    shared->frame_index = 0U;
+    frame_limit = shared->frame_limit;
+
+    if (xensiv_bgt60trxx_start_frame(&sensor.dev, true) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        return false;
+    }
+
+    capture_enabled = true;
+    return true;
+}
+
+/* capture_enabled is cleared first so the interrupt does not start another
+   readout while the SPI bus is needed. */
+static bool stop_sensor(void)
+{
+    bool was_enabled = capture_enabled;
+
+    capture_enabled = false;
+    fifo_dma_wait();
+
+    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        capture_enabled = was_enabled;
+        return false;
+    }
+
+    return true;
+}
+
+static bool apply_profile(void)
+{
+    if ((shared->num_regs == 0U) || (shared->num_regs > IPC_FRAMES_MAX_REGS))
+    {
+        return false;
+    }
+
+    return (xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_SW) == XENSIV_BGT60TRXX_STATUS_OK) &&
+           (xensiv_bgt60trxx_config(&sensor.dev, shared->regs, shared->num_regs) == XENSIV_BGT60TRXX_STATUS_OK) &&
+           (xensiv_bgt60trxx_set_fifo_limit(&sensor.dev,
+                                            (shared->slice_samples > 0U) ? shared->slice_samples
+                                                                         : shared->samples_per_frame) ==
+            XENSIV_BGT60TRXX_STATUS_OK) &&
+           (fifo_dma_set_frame_samples(shared->samples_per_frame) == CY_RSLT_SUCCESS) &&
+           (fifo_dma_set_slice_samples(shared->slice_samples) == CY_RSLT_SUCCESS);
+}
+
+static void execute_command(ipc_frames_cmd_t command)
+{
+    bool status = false;
+
+    switch (command)
+    {
+        case IPC_FRAMES_CMD_START:
+            status = start_sensor();
+            break;
+
+        case IPC_FRAMES_CMD_STOP:
+            status = stop_sensor();
+            break;
+
+        case IPC_FRAMES_CMD_PROFILE:
+            status = !capture_enabled && apply_profile();
+            break;
+
+        default:
+            break;
+    }
+
+    ipc_frames_complete_command(shared, status);
+}
+
+/* Both cores allocate DMA channels from the HAL independently. Claiming all
+   of DW0 here leaves it to the CM4 (UART) and moves the SPI readout to DW1. */
+static void reserve_cm4_dma_channels(void)
+{
+    for (uint32_t ch = 0U; ch < CPUSS_DW0_CH_NR; ch++)
+    {
+        const cyhal_resource_inst_t dw0 = {
+            .type = CYHAL_RSC_DW,
+            .block_num = 0U,
+            .channel_num = (uint8_t)ch
+        };
+
+        (void)cyhal_hwmgr_reserve(&dw0);
+    }
+}
+
+int main(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    result = cybsp_init();
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    __enable_irq();
+
+    /* CY_CORTEX_M4_APPL_ADDR must match the CM4 image of the dual-core
+       linker layout. */
+    Cy_SysEnableCM4(CY_CORTEX_M4_APPL_ADDR);
+
+    shared = ipc_frames_attach(CYHAL_ISR_PRIORITY_DEFAULT);
+    CY_ASSERT(shared != NULL);
+
+    /* Frame timestamps come from the CM4 microsecond counter. */
+    timebase_attach(&shared->timebase);
+    reserve_cm4_dma_channels();
+
+    /* Initialize the SPI interface to BGT60. */
+    result = cyhal_spi_init(&cyhal_spi,
+                            PIN_XENSIV_BGT60TRXX_SPI_MOSI,
+                            PIN_XENSIV_BGT60TRXX_SPI_MISO,
+                            PIN_XENSIV_BGT60TRXX_SPI_SCLK,
+                            NC,
+                            NULL,
+                            8,
+                            CYHAL_SPI_MODE_00_MSB,
+                            false);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* Reduce drive strength to improve EMI */
+    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_SLEW_FAST);
+    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_DRIVE_1_8);
+    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_SLEW_FAST);
+    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_DRIVE_1_8);
+
+    result = cyhal_spi_set_frequency(&cyhal_spi, XENSIV_BGT60TRXX_SPI_FREQUENCY);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* Enable the LDO and wait until it is stable. */
+    result = cyhal_gpio_init(PIN_XENSIV_BGT60TRXX_LDO_EN,
+                             CYHAL_GPIO_DIR_OUTPUT,
+                             CYHAL_GPIO_DRIVE_STRONG,
+                             true);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    (void)cyhal_system_delay_ms(5);
+
+    result = xensiv_bgt60trxx_mtb_init(&sensor,
+                                       &cyhal_spi,
+                                       PIN_XENSIV_BGT60TRXX_SPI_CSN,
+                                       PIN_XENSIV_BGT60TRXX_RSTN,
+                                       register_list,
+                                       XENSIV_BGT60TRXX_CONF_NUM_REGS);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    {
+        spi_calib_result_t spi_clock = {
+            .frequency_hz = XENSIV_BGT60TRXX_SPI_FREQUENCY,
+            .drive_sel = CY_GPIO_DRIVE_1_8
+        };
+        bool calibrated = false;
+
+#if SPI_CLOCK_CALIBRATION
+        const cyhal_gpio_t spi_outputs[] = { PIN_XENSIV_BGT60TRXX_SPI_SCLK, PIN_XENSIV_BGT60TRXX_SPI_MOSI };
+
+        calibrated = (spi_calib_run(&sensor, register_list, XENSIV_BGT60TRXX_CONF_NUM_REGS,
+                                    spi_outputs, 2U, XENSIV_BGT60TRXX_SPI_FREQUENCY,
+                                    &spi_clock) == CY_RSLT_SUCCESS);
+#endif
+        shared->spi_clock = spi_clock;
+        shared->spi_calibrated = calibrated;
+    }
+
+    result = xensiv_bgt60trxx_mtb_interrupt_init(&sensor,
+                                                 FIFO_DMA_IRQ_SAMPLES(XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *
+                                                                      XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP,
+                                                                      XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME),
+                                                 PIN_XENSIV_BGT60TRXX_IRQ,
+                                                 CYHAL_ISR_PRIORITY_DEFAULT,
+                                                 xensiv_bgt60trxx_mtb_interrupt_handler,
+                                                 NULL);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_init(&sensor, shared->ring, shared->slot_base, shared->slot_samples,
+                           CYHAL_ISR_PRIORITY_DEFAULT);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_set_frame_samples(NUM_SAMPLES_PER_FRAME);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_set_slice_samples(FIFO_DMA_SLICE_SAMPLES(XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *
+                                                               XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP));
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    fifo_dma_set_callback(readout_done);
+
+    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        CY_ASSERT(0);
+    }
+
+    shared->ready = true;
+    ipc_frames_notify();
+
+    for (;;)
+    {
+        if (fifo_dma_take_flush_request())
+        {
+            /* A frame was left in the FIFO; discard it before the next one. */
+            fifo_dma_wait();
+            (void)xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+            publish_stats();
+        }
+
+        ipc_frames_cmd_t command = ipc_frames_take_command(shared);
+
+        if (command != IPC_FRAMES_CMD_NONE)
+        {
+            execute_command(command);
+            continue;
+        }
+
+        /* Sleep until the sensor, the DMA or the CM4 raises an interrupt;
+           checked with interrupts masked so none is missed. */
+        uint32_t irq_state = cyhal_system_critical_section_enter();
+
+        if (!fifo_dma_flush_pending() && (ipc_frames_take_command(shared) == IPC_FRAMES_CMD_NONE))
+        {
+            (void)cyhal_syspm_sleep();
+        }
+
+        cyhal_system_critical_section_exit(irq_state);
+    }
+}
@@ -0,0 +1,611 @@
+/* Presence events as BLE GATT notifications (COMPONENTS+=WICED_BLE, see the
+   Makefile). The stack runs on the board's CYW43012 controller with
+   bsps/.../bluetooth/cybsp_bt_config.c; the GATT database and the stack
+   settings are kept here instead of a generated cycfg_gatt_db.c. */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#include "cybsp_bt_config.h"
+#include "cybt_platform_config.h"
+#include "wiced_bt_ble.h"
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+#include "wiced_bt_l2c.h"
+#include "wiced_bt_stack.h"
+#include "wiced_bt_uuid.h"
+#include "wiced_timer.h"
+
+#include "ble_events.h"
+
+#if !defined(COMPONENT_FREERTOS)
+#error "The BLE event service needs COMPONENTS+=FREERTOS"
+#endif
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 5a7e0001-8c1f-4b5e-9d43-6f0c2a1be0d1 and ...0002..., little endian. */
+#define BLE_EVENTS_UUID_SERVICE             0xd1, 0xe0, 0x1b, 0x2a, 0x0c, 0x6f, 0x43, 0x9d,\
+                                            0x5e, 0x4b, 0x1f, 0x8c, 0x01, 0x00, 0x7e, 0x5a
+#define BLE_EVENTS_UUID_EVENTS              0xd1, 0xe0, 0x1b, 0x2a, 0x0c, 0x6f, 0x43, 0x9d,\
+                                            0x5e, 0x4b, 0x1f, 0x8c, 0x02, 0x00, 0x7e, 0x5a
+
+#define HDL_GAP_SERVICE                     (0x0001U)
+#define HDL_GAP_DEVICE_NAME                 (0x0002U)
+#define HDL_GAP_DEVICE_NAME_VALUE           (0x0003U)
+#define HDL_GAP_APPEARANCE                  (0x0004U)
+#define HDL_GAP_APPEARANCE_VALUE            (0x0005U)
+#define HDL_EVENTS_SERVICE                  (0x0010U)
+#define HDL_EVENTS                          (0x0011U)
+#define HDL_EVENTS_VALUE                    (0x0012U)
+#define HDL_EVENTS_CCCD                     (0x0013U)
+
+#define BLE_EVENTS_APPEARANCE               (APPEARANCE_GENERIC_TAG)
+#define BLE_EVENTS_MAX_MTU                  (247U)
+#define BLE_EVENTS_ATT_HEADER_BYTES         (3U)
+#define BLE_EVENTS_CCCD_NOTIFY              (0x0001U)
+
+#define BLE_EVENTS_UNITS_TO_US(units)       ((uint32_t)(units) * 1250UL)
+
+/*******************************************************************************
+* GATT database and stack settings
+*******************************************************************************/
+static const uint8_t gatt_db[] = {
+    PRIMARY_SERVICE_UUID16(HDL_GAP_SERVICE, UUID_SERVICE_GAP),
+        CHARACTERISTIC_UUID16(HDL_GAP_DEVICE_NAME, HDL_GAP_DEVICE_NAME_VALUE,
+                              UUID_CHARACTERISTIC_DEVICE_NAME,
+                              GATTDB_CHAR_PROP_READ, GATTDB_PERM_READABLE),
+        CHARACTERISTIC_UUID16(HDL_GAP_APPEARANCE, HDL_GAP_APPEARANCE_VALUE,
+                              UUID_CHARACTERISTIC_APPEARANCE,
+                              GATTDB_CHAR_PROP_READ, GATTDB_PERM_READABLE),
+
+    PRIMARY_SERVICE_UUID128(HDL_EVENTS_SERVICE, BLE_EVENTS_UUID_SERVICE),
+        CHARACTERISTIC_UUID128(HDL_EVENTS, HDL_EVENTS_VALUE, BLE_EVENTS_UUID_EVENTS,
+                               GATTDB_CHAR_PROP_READ | GATTDB_CHAR_PROP_NOTIFY,
+                               GATTDB_PERM_READABLE),
+            CHAR_DESCRIPTOR_UUID16_WRITABLE(HDL_EVENTS_CCCD,
+                                            UUID_DESCRIPTOR_CLIENT_CHARACTERISTIC_CONFIGURATION,
+                                            GATTDB_PERM_READABLE | GATTDB_PERM_WRITE_REQ),
+};
+
+static const uint8_t service_uuid[] = { BLE_EVENTS_UUID_SERVICE };
+static const char device_name[] = BLE_EVENTS_DEVICE_NAME;
+
+static const wiced_bt_cfg_ble_scan_settings_t scan_settings = {
+    .scan_mode = BTM_BLE_SCAN_MODE_PASSIVE,
+    .high_duty_scan_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_INTERVAL,
+    .high_duty_scan_window = WICED_BT_CFG_DEFAULT_HIGH_DUTY_SCAN_WINDOW,
+    .high_duty_scan_duration = 5,
+    .low_duty_scan_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_SCAN_INTERVAL,
+    .low_duty_scan_window = WICED_BT_CFG_DEFAULT_LOW_DUTY_SCAN_WINDOW,
+    .low_duty_scan_duration = 5,
+    .high_duty_conn_scan_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_CONN_SCAN_INTERVAL,
+    .high_duty_conn_scan_window = WICED_BT_CFG_DEFAULT_HIGH_DUTY_CONN_SCAN_WINDOW,
+    .high_duty_conn_duration = 30,
+    .low_duty_conn_scan_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_CONN_SCAN_INTERVAL,
+    .low_duty_conn_scan_window = WICED_BT_CFG_DEFAULT_LOW_DUTY_CONN_SCAN_WINDOW,
+    .low_duty_conn_duration = 30,
+    .conn_min_interval = BLE_EVENTS_CONN_INTERVAL_MIN,
+    .conn_max_interval = BLE_EVENTS_CONN_INTERVAL_MAX,
+    .conn_latency = BLE_EVENTS_CONN_LATENCY,
+    .conn_supervision_timeout = BLE_EVENTS_SUPERVISION_TIMEOUT
+};
+
+/* Fast advertising for 30 s after start or disconnect, slow afterwards. */
+static const wiced_bt_cfg_ble_advert_settings_t advert_settings = {
+    .channel_map = BTM_BLE_ADVERT_CHNL_37 | BTM_BLE_ADVERT_CHNL_38 | BTM_BLE_ADVERT_CHNL_39,
+    .high_duty_min_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_ADV_MIN_INTERVAL,
+    .high_duty_max_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_ADV_MAX_INTERVAL,
+    .high_duty_duration = 30,
+    .low_duty_min_interval = 1600,     /* 1 s */
+    .low_duty_max_interval = 1600,
+    .low_duty_duration = 0,            /* until connected */
+    .high_duty_directed_min_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_DIRECTED_ADV_MIN_INTERVAL,
+    .high_duty_directed_max_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_DIRECTED_ADV_MAX_INTERVAL,
+    .low_duty_directed_min_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_DIRECTED_ADV_MIN_INTERVAL,
+    .low_duty_directed_max_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_DIRECTED_ADV_MAX_INTERVAL,
+    .low_duty_directed_duration = 30,
+    .high_duty_nonconn_min_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_NONCONN_ADV_MIN_INTERVAL,
+    .high_duty_nonconn_max_interval = WICED_BT_CFG_DEFAULT_HIGH_DUTY_NONCONN_ADV_MAX_INTERVAL,
+    .high_duty_nonconn_duration = 30,
+    .low_duty_nonconn_min_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_NONCONN_ADV_MIN_INTERVAL,
+    .low_duty_nonconn_max_interval = WICED_BT_CFG_DEFAULT_LOW_DUTY_NONCONN_ADV_MAX_INTERVAL,
+    .low_duty_nonconn_duration = 0
+};
+
+static const wiced_bt_cfg_ble_t ble_settings = {
+    .ble_max_simultaneous_links = 1,
+    .ble_max_rx_pdu_size = BLE_EVENTS_MAX_MTU,
+    .p_ble_scan_cfg = &scan_settings,
+    .p_ble_advert_cfg = &advert_settings,
+    .appearance = BLE_EVENTS_APPEARANCE,
+    .host_addr_resolution_db_size = 0,
+    .rpa_refresh_timeout = WICED_BT_CFG_DEFAULT_RANDOM_ADDRESS_NEVER_CHANGE
+};
+
+static const wiced_bt_cfg_gatt_t gatt_settings = {
+    .max_db_service_modules = 0,
+    .max_eatt_bearers = 0
+};
+
+static const wiced_bt_cfg_settings_t bt_settings = {
+    .device_name = (uint8_t *)device_name,
+    .security_required = BTM_SEC_BEST_EFFORT,
+    .p_br_cfg = NULL,
+    .p_ble_cfg = &ble_settings,
+    .p_gatt_cfg = &gatt_settings,
+    .p_isoc_cfg = NULL,
+    .p_l2cap_app_cfg = NULL
+};
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static QueueHandle_t event_queue = NULL;
+static wiced_timer_t batch_timer;
+
+/* Owned by the stack task. */
+static uint16_t conn_id = 0U;
+static wiced_bt_device_address_t peer_addr;
+static uint16_t att_mtu = 23U;
+static uint16_t cccd = 0U;
+static uint32_t conn_interval_us = 0U;
+static uint16_t conn_latency = 0U;
+static bool tx_busy = false;
+static uint8_t notify_buffer[BLE_EVENTS_MAX_MTU - BLE_EVENTS_ATT_HEADER_BYTES];
+static ble_event_record_t last_sent;
+
+/* Shared between ble_events_submit() and the stack task. */
+static volatile bool flush_scheduled = false;
+static volatile ble_events_stats_t stats;
+
+/* Owned by the caller of ble_events_submit(). */
+static bool last_present = false;
+static uint16_t last_bin = 0U;
+static TickType_t last_queued = 0U;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static bool subscribed(void)
+{
+    return (conn_id != 0U) && ((cccd & BLE_EVENTS_CCCD_NOTIFY) != 0U);
+}
+
+/* Records are sent once per window in which the peripheral has to show up
+   anyway: the connection interval times one plus the latency the central
+   granted. */
+static uint32_t batch_window_ms(void)
+{
+    uint32_t window_us = conn_interval_us * (1UL + conn_latency);
+
+    /* Until the stack reports the interval, batch as if at the slowest one
+       we ask for. */
+    if (window_us == 0U)
+    {
+        window_us = BLE_EVENTS_UNITS_TO_US(BLE_EVENTS_CONN_INTERVAL_MAX);
+    }
+
+    return (window_us + 999UL) / 1000UL;
+}
+
+static void discard_queue(void)
+{
+    ble_event_record_t record;
+
+    while (xQueueReceive(event_queue, &record, 0) == pdTRUE)
+    {
+        stats.records_dropped++;
+    }
+}
+
+/* Stack task: sends what is queued in one notification, as many records as
+   fit into the negotiated MTU. Re-arms itself while records remain. */
+static void batch_timer_expired(WICED_TIMER_PARAM_TYPE arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    if (!subscribed())
+    {
+        discard_queue();
+    }
+    else if (!tx_busy)
+    {
+        const uint32_t max_records = (uint32_t)(att_mtu - BLE_EVENTS_ATT_HEADER_BYTES) / sizeof(ble_event_record_t);
+        ble_event_record_t *records = (ble_event_record_t *)notify_buffer;
+        uint32_t count = 0U;
+
+        while ((count < max_records) && (xQueueReceive(event_queue, &records[count], 0) == pdTRUE))
+        {
+            count++;
+        }
+
+        if (count > 0U)
+        {
+            last_sent = records[count - 1U];
+
+            if (wiced_bt_gatt_server_send_notification(conn_id, HDL_EVENTS_VALUE,
+                                                       (uint16_t)(count * sizeof(ble_event_record_t)),
+                                                       notify_buffer, NULL) == WICED_BT_GATT_SUCCESS)
+            {
+                tx_busy = true;
+                stats.notifications++;
+                stats.records_sent += count;
+            }
+            else
+            {
+                stats.records_dropped += count;
+            }
+        }
+    }
+
+    /* Clear first, then look again, so a record queued in between is not
+       left behind. */
+    taskENTER_CRITICAL();
+    flush_scheduled = (uxQueueMessagesWaiting(event_queue) > 0U);
+    taskEXIT_CRITICAL();
+
+    if (flush_scheduled)
+    {
+        (void)wiced_start_timer(&batch_timer, batch_window_ms());
+    }
+}
+
+/* Stack task: the first record after an idle period opens a batch window. */
+static int schedule_flush(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    if (!subscribed())
+    {
+        discard_queue();
+        flush_scheduled = false;
+    }
+    else if (!wiced_is_timer_in_use(&batch_timer))
+    {
+        (void)wiced_start_timer(&batch_timer, batch_window_ms());
+    }
+
+    return 0;
+}
+
+static void start_advertising(void)
+{
+    uint8_t flags = BTM_BLE_GENERAL_DISCOVERABLE_FLAG | BTM_BLE_BREDR_NOT_SUPPORTED;
+    wiced_bt_ble_advert_elem_t adv[2];
+    wiced_bt_ble_advert_elem_t scan_rsp;
+
+    adv[0].advert_type = BTM_BLE_ADVERT_TYPE_FLAG;
+    adv[0].len = sizeof(flags);
+    adv[0].p_data = &flags;
+    adv[1].advert_type = BTM_BLE_ADVERT_TYPE_128SRV_COMPLETE;
+    adv[1].len = sizeof(service_uuid);
+    adv[1].p_data = (uint8_t *)service_uuid;
+
+    /* The name does not fit next to a 128-bit UUID. */
+    scan_rsp.advert_type = BTM_BLE_ADVERT_TYPE_NAME_COMPLETE;
+    scan_rsp.len = (uint16_t)strlen(device_name);
+    scan_rsp.p_data = (uint8_t *)device_name;
+
+    (void)wiced_bt_ble_set_raw_advertisement_data(2, adv);
+    (void)wiced_bt_ble_set_raw_scan_response_data(1, &scan_rsp);
+    (void)wiced_bt_start_advertisements(BTM_BLE_ADVERT_UNDIRECTED_HIGH, 0, NULL);
+}
+
+static wiced_bt_gatt_status_t read_value(uint16_t handle, const uint8_t **value, uint16_t *length)
+{
+    static const uint16_t appearance = BLE_EVENTS_APPEARANCE;
+
+    switch (handle)
+    {
+        case HDL_GAP_DEVICE_NAME_VALUE:
+            *value = (const uint8_t *)device_name;
+            *length = (uint16_t)strlen(device_name);
+            return WICED_BT_GATT_SUCCESS;
+
+        case HDL_GAP_APPEARANCE_VALUE:
+            *value = (const uint8_t *)&appearance;
+            *length = sizeof(appearance);
+            return WICED_BT_GATT_SUCCESS;
+
+        case HDL_EVENTS_VALUE:
+            *value = (const uint8_t *)&last_sent;
+            *length = sizeof(last_sent);
+            return WICED_BT_GATT_SUCCESS;
+
+        case HDL_EVENTS_CCCD:
+            *value = (const uint8_t *)&cccd;
+            *length = sizeof(cccd);
+            return WICED_BT_GATT_SUCCESS;
+
+        default:
+            return WICED_BT_GATT_INVALID_HANDLE;
+    }
+}
+
+static wiced_bt_gatt_status_t handle_attribute_request(wiced_bt_gatt_attribute_request_t *request)
+{
+    const uint8_t *value = NULL;
+    uint16_t length = 0U;
+    uint16_t offset = 0U;
+    wiced_bt_gatt_status_t status;
+
+    switch (request->opcode)
+    {
+        case GATT_REQ_READ:
+        case GATT_REQ_READ_BLOB:
+        {
+            uint16_t handle = request->data.read_req.handle;
+
+            if (request->opcode == GATT_REQ_READ_BLOB)
+            {
+                offset = request->data.read_req.offset;
+            }
+
+            status = read_value(handle, &value, &length);
+
+            if ((status == WICED_BT_GATT_SUCCESS) && (offset > length))
+            {
+                status = WICED_BT_GATT_INVALID_OFFSET;
+            }
+
+            if (status != WICED_BT_GATT_SUCCESS)
+            {
+                (void)wiced_bt_gatt_server_send_error_rsp(request->conn_id, request->opcode, handle, status);
+                return status;
+            }
+
+            length = (uint16_t)(length - offset);
+
+            if (length > (att_mtu - 1U))
+            {
+                length = (uint16_t)(att_mtu - 1U);
+            }
+
+            return wiced_bt_gatt_server_send_read_handle_rsp(request->conn_id, request->opcode, length,
+                                                             (uint8_t *)(value + offset), NULL);
+        }
+
+        case GATT_REQ_WRITE:
+        case GATT_CMD_WRITE:
+        {
+            uint16_t handle = request->data.write_req.handle;
+
+            if ((handle != HDL_EVENTS_CCCD) || (request->data.write_req.val_len != sizeof(cccd)))
+            {
+                status = (handle == HDL_EVENTS_CCCD) ? WICED_BT_GATT_INVALID_ATTR_LEN : WICED_BT_GATT_WRITE_NOT_PERMIT;
+                (void)wiced_bt_gatt_server_send_error_rsp(request->conn_id, request->opcode, handle, status);
+                return status;
+            }
+
+            cccd = (uint16_t)(request->data.write_req.p_val[0] | (request->data.write_req.p_val[1] << 8));
+
+            if (request->opcode == GATT_REQ_WRITE)
+            {
+                (void)wiced_bt_gatt_server_send_write_rsp(request->conn_id, request->opcode, handle);
+            }
+
+            return WICED_BT_GATT_SUCCESS;
+        }
+
+        case GATT_REQ_MTU:
+            att_mtu = (request->data.remote_mtu < BLE_EVENTS_MAX_MTU) ? request->data.remote_mtu : BLE_EVENTS_MAX_MTU;
+            return wiced_bt_gatt_server_send_mtu_rsp(request->conn_id, request->data.remote_mtu, BLE_EVENTS_MAX_MTU);
+
+        case GATT_HANDLE_VALUE_CONF:
+            return WICED_BT_GATT_SUCCESS;
+
+        default:
+            (void)wiced_bt_gatt_server_send_error_rsp(request->conn_id, request->opcode, 0U,
+                                                      WICED_BT_GATT_REQ_NOT_SUPPORTED);
+            return WICED_BT_GATT_REQ_NOT_SUPPORTED;
+    }
+}
+
+static void update_conn_params(void)
+{
+    wiced_bt_ble_conn_params_t params;
+
+    if (wiced_bt_ble_get_connection_parameters(peer_addr, &params) == WICED_BT_SUCCESS)
+    {
+        conn_interval_us = BLE_EVENTS_UNITS_TO_US(params.conn_interval);
+        conn_latency = params.conn_latency;
+        stats.conn_interval_us = conn_interval_us;
+    }
+}
+
+static wiced_bt_gatt_status_t gatt_event(wiced_bt_gatt_evt_t event, wiced_bt_gatt_event_data_t *data)
+{
+    switch (event)
+    {
+        case GATT_CONNECTION_STATUS_EVT:
+            if (data->connection_status.connected)
+            {
+                conn_id = data->connection_status.conn_id;
+                (void)memcpy(peer_addr, data->connection_status.bd_addr, sizeof(peer_addr));
+                att_mtu = 23U;
+                cccd = 0U;
+                tx_busy = false;
+                update_conn_params();
+
+                /* Ask for a slow, latency-tolerant link; events are rare. */
+                (void)wiced_bt_l2cap_update_ble_conn_params(peer_addr,
+                                                            BLE_EVENTS_CONN_INTERVAL_MIN,
+                                                            BLE_EVENTS_CONN_INTERVAL_MAX,
+                                                            BLE_EVENTS_CONN_LATENCY,
+                                                            BLE_EVENTS_SUPERVISION_TIMEOUT);
+            }
+            else
+            {
+                conn_id = 0U;
+                cccd = 0U;
+                tx_busy = false;
+                conn_interval_us = 0U;
+                conn_latency = 0U;
+                stats.conn_interval_us = 0U;
+                (void)wiced_stop_timer(&batch_timer);
+                discard_queue();
+                flush_scheduled = false;
+                start_advertising();
+            }
+            return WICED_BT_GATT_SUCCESS;
+
+        case GATT_ATTRIBUTE_REQUEST_EVT:
+            return handle_attribute_request(&data->attribute_request);
+
+        case GATT_GET_RESPONSE_BUFFER_EVT:
+        {
+            /* Write responses only; their payloads are tiny. */
+            static uint8_t response[BLE_EVENTS_MAX_MTU];
+
+            if (data->buffer_request.len_requested > sizeof(response))
+            {
+                return WICED_BT_GATT_INSUF_RESOURCE;
+            }
+
+            data->buffer_request.buffer.p_app_rsp_buffer = response;
+            data->buffer_request.buffer.p_app_ctxt = NULL;
+            return WICED_BT_GATT_SUCCESS;
+        }
+
+        case GATT_APP_BUFFER_TRANSMITTED_EVT:
+            if (data->buffer_xmitted.p_app_data == notify_buffer)
+            {
+                tx_busy = false;
+            }
+            return WICED_BT_GATT_SUCCESS;
+
+        default:
+            return WICED_BT_GATT_SUCCESS;
+    }
+}
+
+static wiced_result_t management_event(wiced_bt_management_evt_t event,
+                                       wiced_bt_management_evt_data_t *data)
+{
+    switch (event)
+    {
+        case BTM_ENABLED_EVT:
+            if (data->enabled.status != WICED_BT_SUCCESS)
+            {
+                return WICED_BT_ERROR;
+            }
+
+            (void)wiced_init_timer(&batch_timer, batch_timer_expired, 0, WICED_MILLI_SECONDS_TIMER);
+            (void)wiced_bt_gatt_register(gatt_event);
+            (void)wiced_bt_gatt_db_init(gatt_db, sizeof(gatt_db), NULL);
+            start_advertising();
+            return WICED_BT_SUCCESS;
+
+        case BTM_BLE_CONNECTION_PARAM_UPDATE:
+            if (data->ble_connection_param_update.status == WICED_BT_SUCCESS)
+            {
+                conn_interval_us = BLE_EVENTS_UNITS_TO_US(data->ble_connection_param_update.conn_interval);
+                conn_latency = data->ble_connection_param_update.conn_latency;
+                stats.conn_interval_us = conn_interval_us;
+            }
+            return WICED_BT_SUCCESS;
+
+        case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT:
+            /* Just Works; the service carries nothing secret. */
+            data->pairing_io_capabilities_ble_request.local_io_cap = BTM_IO_CAPABILITIES_NONE;
+            data->pairing_io_capabilities_ble_request.oob_data = BTM_OOB_NONE;
+            data->pairing_io_capabilities_ble_request.auth_req = BTM_LE_AUTH_REQ_BOND;
+            data->pairing_io_capabilities_ble_request.max_key_size = 16;
+            data->pairing_io_capabilities_ble_request.init_keys = BTM_LE_KEY_PENC | BTM_LE_KEY_PID;
+            data->pairing_io_capabilities_ble_request.resp_keys = BTM_LE_KEY_PENC | BTM_LE_KEY_PID;
+            return WICED_BT_SUCCESS;
+
+        case BTM_SECURITY_REQUEST_EVT:
+            wiced_bt_ble_security_grant(data->security_request.bd_addr, WICED_BT_SUCCESS);
+            return WICED_BT_SUCCESS;
+
+        case BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT:
+        case BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT:
+            /* No bonding storage: generate new keys every boot. */
+            return WICED_BT_ERROR;
+
+        default:
+            return WICED_BT_SUCCESS;
+    }
+}
+
+cy_rslt_t ble_events_init(void)
+{
+    event_queue = xQueueCreate(BLE_EVENTS_QUEUE_DEPTH, sizeof(ble_event_record_t));
+
+    if (event_queue == NULL)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    cybt_platform_config_init(&cybsp_bt_platform_cfg);
+
+    if (wiced_bt_stack_init(management_event, &bt_settings) != WICED_BT_SUCCESS)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+void ble_events_submit(const ble_event_record_t *record)
+{
+    TickType_t now = xTaskGetTickCount();
+    bool present = (record->present != 0U);
+    bool moved = present &&
+                 ((uint32_t)abs((int32_t)record->range_bin - (int32_t)last_bin) >= BLE_EVENTS_MIN_BIN_DELTA);
+    bool heartbeat = (now - last_queued) >= pdMS_TO_TICKS(BLE_EVENTS_HEARTBEAT_MS);
+
+    if ((event_queue == NULL) || !ble_events_connected() ||
+        ((present == last_present) && (record->changed == 0U) && !moved && !heartbeat))
+    {
+        return;
+    }
+
+    last_present = present;
+    last_bin = record->range_bin;
+    last_queued = now;
+
+    if (xQueueSend(event_queue, record, 0) != pdTRUE)
+    {
+        stats.records_dropped++;
+        return;
+    }
+
+    stats.records_queued++;
+
+    bool schedule;
+
+    taskENTER_CRITICAL();
+    schedule = !flush_scheduled;
+    flush_scheduled = true;
+    taskEXIT_CRITICAL();
+
+    if (schedule)
+    {
+        (void)wiced_app_event_serialize(schedule_flush, NULL);
+    }
+}
+
+bool ble_events_connected(void)
+{
+    return subscribed();
+}
+
+void ble_events_get_stats(ble_events_stats_t *out)
+{
+    if (out != NULL)
+    {
+        out->records_queued = stats.records_queued;
+        out->records_sent = stats.records_sent;
+        out->records_dropped = stats.records_dropped;
+        out->notifications = stats.notifications;
+        out->conn_interval_us = stats.conn_interval_us;
+    }
+}
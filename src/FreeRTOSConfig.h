@@ -0,0 +1,98 @@
+/* FreeRTOS kernel configuration for the task-based build of the firmware
+   (COMPONENTS+=FREERTOS in the Makefile). The superloop build does not use the
+   kernel. */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+#include "cy_utils.h"
+
+extern uint32_t SystemCoreClock;
+/* Run-time statistics count microseconds of the firmware timebase. */
+extern uint32_t timebase_now_us(void);
+
+#define configUSE_PREEMPTION                    1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#define configUSE_TICKLESS_IDLE                 0
+#define configCPU_CLOCK_HZ                      SystemCoreClock
+#define configTICK_RATE_HZ                      1000u
+#define configMAX_PRIORITIES                    7
+#define configMINIMAL_STACK_SIZE                128
+#define configMAX_TASK_NAME_LEN                 16
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_MUTEXES                       1
+#define configUSE_RECURSIVE_MUTEXES             0
+#define configUSE_COUNTING_SEMAPHORES           0
+#define configQUEUE_REGISTRY_SIZE               0
+#define configUSE_QUEUE_SETS                    0
+#define configUSE_TIME_SLICING                  1
+#define configENABLE_BACKWARD_COMPATIBILITY     0
+
+/* Memory allocation: tasks, the queue and the mutex come from the heap. */
+#define configSUPPORT_STATIC_ALLOCATION         0
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#if defined(COMPONENT_WICED_BLE)
+/* The Bluetooth stack adds its tasks, HCI buffers and memory pool. */
+#define configTOTAL_HEAP_SIZE                   (48 * 1024)
+#else
+#define configTOTAL_HEAP_SIZE                   (16 * 1024)
+#endif
+#define configAPPLICATION_ALLOCATED_HEAP        0
+
+/* Hooks */
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCHECK_FOR_STACK_OVERFLOW          2
+#define configUSE_MALLOC_FAILED_HOOK            0
+
+/* Statistics for the 'tasks' command. */
+#define configUSE_TRACE_FACILITY                1
+#define configGENERATE_RUN_TIME_STATS           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()        timebase_now_us()
+
+/* Software timers are only used by the Bluetooth stack (wiced_timer_t on
+   top of abstraction-rtos). */
+#if defined(COMPONENT_WICED_BLE)
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+#define configTIMER_QUEUE_LENGTH                10
+#define configTIMER_TASK_STACK_DEPTH            (configMINIMAL_STACK_SIZE * 2)
+#define INCLUDE_xTimerPendFunctionCall          1
+#else
+#define configUSE_TIMERS                        0
+#endif
+
+#define INCLUDE_vTaskPrioritySet                0
+#define INCLUDE_uxTaskPriorityGet               0
+#define INCLUDE_vTaskDelete                     0
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 0
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetSchedulerState          1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+
+/* PSoC 6 implements 3 priority bits. The kernel runs at the lowest priority;
+   interrupts that call FreeRTOS APIs (all of this firmware's, at
+   CYHAL_ISR_PRIORITY_DEFAULT) must not be above
+   configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+#define configPRIO_BITS                         3
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY 7
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY 1
+#define configKERNEL_INTERRUPT_PRIORITY         (configLIBRARY_LOWEST_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    (configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << (8 - configPRIO_BITS))
+
+#define configASSERT(x)                         CY_ASSERT(x)
+
+/* Map the port handlers to the CMSIS vector names, only when the kernel is
+   actually used. */
+#if defined(COMPONENT_FREERTOS)
+#define vPortSVCHandler                         SVC_Handler
+#define xPortPendSVHandler                      PendSV_Handler
+#define xPortSysTickHandler                     SysTick_Handler
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
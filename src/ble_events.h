@@ -0,0 +1,91 @@
+#ifndef BLE_EVENTS_H
+#define BLE_EVENTS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Name in the advertisement and the GAP device name characteristic. */
+#ifndef BLE_EVENTS_DEVICE_NAME
+#define BLE_EVENTS_DEVICE_NAME              "XENSIV Presence"
+#endif
+
+/* Records waiting for the next notification; more are dropped. */
+#ifndef BLE_EVENTS_QUEUE_DEPTH
+#define BLE_EVENTS_QUEUE_DEPTH              (32U)
+#endif
+
+/* While a target is present, a record is queued when it moved by at least
+   this many range bins. */
+#ifndef BLE_EVENTS_MIN_BIN_DELTA
+#define BLE_EVENTS_MIN_BIN_DELTA            (2U)
+#endif
+
+/* Longest time without a record while connected, so the central sees the
+   node is alive even when nothing changes. */
+#ifndef BLE_EVENTS_HEARTBEAT_MS
+#define BLE_EVENTS_HEARTBEAT_MS             (10000U)
+#endif
+
+/* Connection parameters requested from the central, in 1.25 ms interval
+   units, skipped connection events and 10 ms timeout units. A long
+   interval with some peripheral latency lets the radio sleep between
+   events. */
+#ifndef BLE_EVENTS_CONN_INTERVAL_MIN
+#define BLE_EVENTS_CONN_INTERVAL_MIN        (80U)   /* 100 ms */
+#endif
+#ifndef BLE_EVENTS_CONN_INTERVAL_MAX
+#define BLE_EVENTS_CONN_INTERVAL_MAX        (160U)  /* 200 ms */
+#endif
+#ifndef BLE_EVENTS_CONN_LATENCY
+#define BLE_EVENTS_CONN_LATENCY             (4U)
+#endif
+#ifndef BLE_EVENTS_SUPERVISION_TIMEOUT
+#define BLE_EVENTS_SUPERVISION_TIMEOUT      (600U)  /* 6 s */
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* One record of the events characteristic. A notification carries one or
+   more of them back to back. */
+typedef struct __attribute__((packed))
+{
+    uint32_t frame_index;
+    uint8_t present;
+    uint8_t changed;                /* present toggled with this frame */
+    uint16_t range_bin;             /* strongest moving target */
+    uint16_t distance_mm;
+    uint16_t level;                 /* its MTI magnitude, as in presence_event_t */
+} ble_event_record_t;
+
+typedef struct
+{
+    uint32_t records_queued;
+    uint32_t records_sent;
+    uint32_t records_dropped;       /* queue full, or no subscriber */
+    uint32_t notifications;
+    uint32_t conn_interval_us;      /* 0 while disconnected */
+} ble_events_stats_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Starts the Bluetooth stack with the board's controller configuration and
+   advertises the events service. Needs the FreeRTOS scheduler, which must be
+   started afterwards. */
+cy_rslt_t ble_events_init(void);
+
+/* Offers the presence result of one frame. Only state changes, target moves
+   and heartbeats are queued; queued records go out batched, at most one
+   notification per connection interval. Call from task context. */
+void ble_events_submit(const ble_event_record_t *record);
+
+bool ble_events_connected(void);
+void ble_events_get_stats(ble_events_stats_t *stats);
+
+#endif /* BLE_EVENTS_H */
@@ -0,0 +1,48 @@
+#include <stddef.h>
+
+#include "chirp_average.h"
+
+uint32_t chirp_average_frame(uint16_t *frame, uint32_t num_chirps, uint32_t num_samples,
+                             uint32_t num_rx, uint32_t chirp_average, uint32_t sample_decimation)
+{
+    if ((frame == NULL) || (chirp_average == 0U) || (sample_decimation == 0U) ||
+        ((num_chirps % chirp_average) != 0U) || ((num_samples % sample_decimation) != 0U))
+    {
+        return 0U;
+    }
+
+    const uint32_t out_chirps = num_chirps / chirp_average;
+    const uint32_t out_samples = num_samples / sample_decimation;
+    const uint32_t count = chirp_average * sample_decimation;
+    const uint32_t chirp_stride = num_samples * num_rx;
+    uint32_t out = 0U;
+
+    /* Output value j only reads input values at index >= j, so writing in
+       increasing order never overwrites an unread input. */
+    for (uint32_t c = 0U; c < out_chirps; c++)
+    {
+        const uint16_t *group = &frame[c * chirp_average * chirp_stride];
+
+        for (uint32_t s = 0U; s < out_samples; s++)
+        {
+            for (uint32_t rx = 0U; rx < num_rx; rx++)
+            {
+                uint32_t sum = 0U;
+
+                for (uint32_t k = 0U; k < chirp_average; k++)
+                {
+                    const uint16_t *in = &group[(k * chirp_stride) + (s * sample_decimation * num_rx) + rx];
+
+                    for (uint32_t d = 0U; d < sample_decimation; d++)
+                    {
+                        sum += in[d * num_rx];
+                    }
+                }
+
+                frame[out++] = (uint16_t)((sum + (count / 2U)) / count);
+            }
+        }
+    }
+
+    return out;
+}
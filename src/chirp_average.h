@@ -0,0 +1,25 @@
+#ifndef CHIRP_AVERAGE_H
+#define CHIRP_AVERAGE_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest shift either factor may use (the frame header keeps 4 bits each). */
+#define CHIRP_AVERAGE_MAX_SHIFT             (15U)
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Reduces a [chirp][sample][rx] frame in place: every group of chirp_average
+   consecutive chirps is averaged coherently (sample by sample), then every
+   sample_decimation consecutive fast-time samples of an antenna are averaged
+   into one. Both factors must divide their dimension. Results are rounded,
+   so they stay in the 12-bit ADC range. Returns the samples left in the
+   frame: (num_chirps / chirp_average) * (num_samples / sample_decimation) *
+   num_rx, laid out the same way. */
+uint32_t chirp_average_frame(uint16_t *frame, uint32_t num_chirps, uint32_t num_samples,
+                             uint32_t num_rx, uint32_t chirp_average, uint32_t sample_decimation);
+
+#endif /* CHIRP_AVERAGE_H */
@@ -0,0 +1,79 @@
+#include <stddef.h>
+
+#include "control.h"
+
+#define CONTROL_CRC_INIT                    (0xFFFFU)
+#define CONTROL_CRC_POLYNOMIAL              (0x1021U)
+
+static uint16_t crc16_update(uint16_t crc, uint8_t byte)
+{
+    crc ^= (uint16_t)((uint16_t)byte << 8U);
+
+    for (uint32_t bit = 0U; bit < 8U; bit++)
+    {
+        crc = ((crc & 0x8000U) != 0U) ? (uint16_t)((crc << 1U) ^ CONTROL_CRC_POLYNOMIAL) :
+                                        (uint16_t)(crc << 1U);
+    }
+
+    return crc;
+}
+
+void control_parser_reset(control_parser_t *parser)
+{
+    if (parser != NULL)
+    {
+        parser->received = 0U;
+        parser->crc = CONTROL_CRC_INIT;
+        parser->received_crc = 0U;
+    }
+}
+
+bool control_parser_idle(const control_parser_t *parser)
+{
+    return (parser->received == 0U);
+}
+
+control_parse_result_t control_parser_feed(control_parser_t *parser, uint8_t byte)
+{
+    const uint32_t header_bytes = sizeof(control_request_header_t);
+    uint32_t position = parser->received++;
+
+    if (position < header_bytes)
+    {
+        ((uint8_t *)&parser->header)[position] = byte;
+        parser->crc = crc16_update(parser->crc, byte);
+
+        if ((position + 1U) == header_bytes)
+        {
+            if (parser->header.length > CONTROL_MAX_PAYLOAD)
+            {
+                control_parser_reset(parser);
+                return CONTROL_PARSE_BAD_LENGTH;
+            }
+        }
+
+        return CONTROL_PARSE_MORE;
+    }
+
+    position -= header_bytes;
+
+    if (position < parser->header.length)
+    {
+        parser->payload[position] = byte;
+        parser->crc = crc16_update(parser->crc, byte);
+        return CONTROL_PARSE_MORE;
+    }
+
+    position -= parser->header.length;
+    parser->received_crc |= (uint16_t)((uint16_t)byte << (8U * position));
+
+    if ((position + 1U) < CONTROL_CRC_BYTES)
+    {
+        return CONTROL_PARSE_MORE;
+    }
+
+    bool valid = (parser->received_crc == parser->crc);
+
+    control_parser_reset(parser);
+    return valid ? CONTROL_PARSE_DONE : CONTROL_PARSE_BAD_CRC;
+}
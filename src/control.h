@@ -0,0 +1,108 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* A request is a control_request_header_t, `length` payload bytes and the
+   CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of both, little-endian. The
+   sync byte is not ASCII, so requests can be mixed with text commands as long
+   as they start at the beginning of a line. */
+#define CONTROL_SYNC                        (0xA5U)
+#define CONTROL_MAX_PAYLOAD                 (64U)
+#define CONTROL_CRC_BYTES                   (2U)
+
+/* Request opcodes */
+#define CONTROL_OP_PING                     (0x00U) /* no payload */
+#define CONTROL_OP_START                    (0x01U) /* control_start_t, optionally control_start_roi_t */
+#define CONTROL_OP_STOP                     (0x02U) /* no payload */
+#define CONTROL_OP_GET_STATUS               (0x03U) /* no payload; answered with the device status */
+#define CONTROL_OP_PROFILE_CLEAR            (0x10U) /* no payload */
+#define CONTROL_OP_PROFILE_REG              (0x11U) /* uint32_t register words */
+#define CONTROL_OP_PROFILE_APPLY            (0x12U) /* uint32_t samples per chirp, chirps, rx */
+#define CONTROL_OP_PROFILE_DEFAULT          (0x13U) /* no payload */
+
+/* control_response_header_t.status */
+#define CONTROL_STATUS_OK                   (0U)
+#define CONTROL_STATUS_UNKNOWN_OPCODE       (1U)
+#define CONTROL_STATUS_BAD_LENGTH           (2U)
+#define CONTROL_STATUS_BAD_CRC              (3U)
+#define CONTROL_STATUS_BUSY                 (4U)    /* not allowed while a capture runs */
+#define CONTROL_STATUS_INVALID              (5U)    /* payload values rejected */
+#define CONTROL_STATUS_FAILED               (6U)    /* the sensor reported an error */
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct __attribute__((packed))
+{
+    uint8_t sync;                   /* CONTROL_SYNC */
+    uint8_t opcode;                 /* CONTROL_OP_* */
+    uint16_t request_id;            /* echoed in the response */
+    uint16_t length;                /* payload bytes, at most CONTROL_MAX_PAYLOAD */
+} control_request_header_t;
+
+/* Payload of CONTROL_OP_START, the binary form of 'start'. */
+typedef struct __attribute__((packed))
+{
+    uint32_t frames;                /* 0 = continuous */
+    uint16_t sample_format;         /* BINARY_FRAME_FORMAT_* */
+    uint8_t compress;               /* delta/Rice payloads */
+    uint8_t reduction;              /* log2 of chirps averaged (bits 0-3) and of
+                                       fast-time decimation (bits 4-7) */
+} control_start_t;
+
+/* Longer payload of CONTROL_OP_START that also selects a region of interest
+   of every frame. Zero counts and a zero mask select the whole frame. */
+typedef struct __attribute__((packed))
+{
+    control_start_t start;
+    uint16_t rx_mask;               /* bit n = RX n */
+    uint16_t first_chirp;
+    uint16_t num_chirps;
+    uint16_t first_sample;
+    uint16_t num_samples;           /* a power of two */
+} control_start_roi_t;
+
+/* Start of every response payload. */
+typedef struct __attribute__((packed))
+{
+    uint16_t request_id;
+    uint8_t opcode;
+    uint8_t status;                 /* CONTROL_STATUS_* */
+} control_response_header_t;
+
+typedef enum
+{
+    CONTROL_PARSE_MORE,             /* request incomplete */
+    CONTROL_PARSE_DONE,             /* request valid */
+    CONTROL_PARSE_BAD_LENGTH,       /* header announced too much payload */
+    CONTROL_PARSE_BAD_CRC
+} control_parse_result_t;
+
+/* Byte-wise request assembler. The header and payload stay valid after any
+   result other than CONTROL_PARSE_MORE until the next byte is fed. */
+typedef struct
+{
+    control_request_header_t header;
+    uint8_t payload[CONTROL_MAX_PAYLOAD];
+    uint32_t received;
+    uint16_t crc;                   /* computed so far */
+    uint16_t received_crc;
+} control_parser_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+void control_parser_reset(control_parser_t *parser);
+
+/* True between requests, i.e. the next byte must be a sync byte. */
+bool control_parser_idle(const control_parser_t *parser);
+
+/* Feeds one byte, starting with the sync byte. */
+control_parse_result_t control_parser_feed(control_parser_t *parser, uint8_t byte);
+
+#endif /* CONTROL_H */
@@ -0,0 +1,66 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "cycle_stats.h"
+
+void cycle_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycle_counter_to_tenth_us(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 10000000U) / SystemCoreClock);
+}
+
+void cycle_stats_reset(cycle_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    (void)memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+void cycle_stats_add(cycle_stats_t *stats, uint32_t value)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    uint32_t bin = 0U;
+
+    while ((bin < (CYCLE_STATS_BINS - 1U)) && ((value >> (bin + 1U)) != 0U))
+    {
+        bin++;
+    }
+
+    stats->count++;
+    stats->total += value;
+    stats->histogram[bin]++;
+
+    if (value < stats->min)
+    {
+        stats->min = value;
+    }
+
+    if (value > stats->max)
+    {
+        stats->max = value;
+    }
+}
+
+uint32_t cycle_stats_mean(const cycle_stats_t *stats)
+{
+    if ((stats == NULL) || (stats->count == 0U))
+    {
+        return 0U;
+    }
+
+    return (uint32_t)(stats->total / stats->count);
+}
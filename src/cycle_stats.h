@@ -0,0 +1,55 @@
+#ifndef CYCLE_STATS_H
+#define CYCLE_STATS_H
+
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* One histogram bin per power of two: bin n counts values in [2^n, 2^(n+1)),
+   bin 0 also counts 0. */
+#define CYCLE_STATS_BINS                    (32U)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Running min/max/mean and log2 histogram of one measured stage. Values are
+   CPU cycles or microseconds, whatever the caller records. */
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[CYCLE_STATS_BINS];
+} cycle_stats_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Enables the DWT cycle counter of the CM4. It counts core clock cycles
+   (SystemCoreClock) and wraps after 2^32 cycles, so differences of two
+   readings are valid for stages shorter than that. The counter does not run
+   while the CPU sleeps; use the timebase for wall-clock spans. */
+void cycle_counter_init(void);
+
+static inline uint32_t cycle_counter_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* Converts a cycle count to tenths of a microsecond. */
+uint32_t cycle_counter_to_tenth_us(uint32_t cycles);
+
+void cycle_stats_reset(cycle_stats_t *stats);
+
+/* Adds one measurement. Not reentrant; each stats object must be updated from
+   one context only. */
+void cycle_stats_add(cycle_stats_t *stats, uint32_t value);
+
+/* Mean of the recorded values, 0 if there are none. */
+uint32_t cycle_stats_mean(const cycle_stats_t *stats);
+
+#endif /* CYCLE_STATS_H */
@@ -0,0 +1,451 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "fifo_dma.h"
+#include "packed12.h"
+#include "timebase.h"
+
+/* Error bits of GSR0, returned in the first status byte of a burst. */
+#define FIFO_DMA_GSR0_ERR_MSK               (0x0BU) /* FOU_ERR | SPI_BURST_ERR | CLK_NUM_ERR */
+#define FIFO_DMA_BURST_CMD                  (0xFFU)
+
+static xensiv_bgt60trxx_mtb_t *dma_sensor = NULL;
+static frame_ring_t *dma_ring = NULL;
+static uint16_t *dma_slot_base = NULL;
+static uint32_t dma_slot_samples = 0U;
+static uint32_t dma_samples_per_frame = 0U;
+static uint32_t dma_slice_samples = 0U;     /* 0: whole frames */
+
+static uint8_t dma_burst_cmd[FIFO_DMA_CMD_BYTES];
+static volatile bool dma_active = false;
+static volatile bool dma_flush_request = false;
+static volatile int32_t dma_slot = -1;
+static volatile uint32_t dma_frame_index = 0U;
+static volatile uint32_t dma_timestamp_us = 0U;
+static volatile fifo_dma_stats_t dma_stats;
+static fifo_dma_callback_t dma_callback = NULL;
+
+/* Slice readout: the next slice of the frame being read, the frames begun
+   since fifo_dma_restart(), where the burst in flight lands and the four
+   frame bytes its status bytes overwrite. */
+static volatile uint32_t dma_slice = 0U;
+static volatile uint32_t dma_frames = 0U;
+static uint8_t *dma_slice_dst = NULL;
+static uint8_t dma_slice_saved[FIFO_DMA_CMD_BYTES];
+static uint8_t dma_discard[FIFO_DMA_RAW_BYTES(FIFO_DMA_MAX_SLICE_SAMPLES)];
+
+/* The raw burst is written to the tail of the slot so fifo_dma_unpack() can
+   expand it towards the front without overtaking unread bytes. */
+static uint8_t *raw_area(uint16_t *slot)
+{
+    return (uint8_t *)slot + ((dma_slot_samples * sizeof(uint16_t)) -
+                              FIFO_DMA_RAW_BYTES(dma_samples_per_frame));
+}
+
+static bool start_burst(uint8_t *dst, uint32_t num_samples)
+{
+    cyhal_gpio_write(dma_sensor->iface.selpin, false);
+
+    if (cyhal_spi_transfer_async(dma_sensor->iface.spi,
+                                 dma_burst_cmd, sizeof(dma_burst_cmd),
+                                 dst, FIFO_DMA_RAW_BYTES(num_samples)) != CY_RSLT_SUCCESS)
+    {
+        cyhal_gpio_write(dma_sensor->iface.selpin, true);
+        return false;
+    }
+
+    return true;
+}
+
+/* Gives up the frame being sliced after a failed burst. The FIFO has to be
+   flushed, which may cut a frame short, so the next slice starts a frame. */
+static void abandon_sliced_frame(void)
+{
+    dma_stats.errors++;
+
+    if (dma_slot >= 0)
+    {
+        /* A frame read into the scratch buffer was counted when it began. */
+        frame_ring_count_drop(dma_ring);
+    }
+
+    dma_flush_request = true;
+    dma_slot = -1;
+    dma_slice = 0U;
+}
+
+/* Slice k of a frame lands right behind slice k - 1 in the raw area, so the
+   status bytes of its burst overwrite the last four bytes of the previous
+   slice; those are saved here and put back when the burst ends. */
+static void start_slice(uint32_t timestamp_us)
+{
+    if (dma_slice == 0U)
+    {
+        dma_frame_index = dma_frames;
+        dma_frames++;
+        dma_slot = frame_ring_begin_write(dma_ring);
+
+        if (dma_slot < 0)
+        {
+            dma_stats.ring_drops++;
+            frame_ring_count_drop(dma_ring);
+        }
+    }
+
+    uint8_t *dst = dma_discard;
+
+    if (dma_slot >= 0)
+    {
+        dst = raw_area(&dma_slot_base[(uint32_t)dma_slot * dma_slot_samples]) +
+              ((dma_slice * dma_slice_samples * 3U) / 2U);
+
+        if (dma_slice > 0U)
+        {
+            (void)memcpy(dma_slice_saved, dst, FIFO_DMA_CMD_BYTES);
+        }
+    }
+
+    dma_slice_dst = dst;
+    dma_timestamp_us = timestamp_us;
+    dma_active = true;
+
+    if (!start_burst(dst, dma_slice_samples))
+    {
+        abandon_sliced_frame();
+        dma_active = false;
+    }
+}
+
+static void slice_event(cyhal_spi_event_t event)
+{
+    const uint8_t gsr0 = dma_slice_dst[0];
+    bool frame_done = false;
+
+    if ((dma_slot >= 0) && (dma_slice > 0U))
+    {
+        (void)memcpy(dma_slice_dst, dma_slice_saved, FIFO_DMA_CMD_BYTES);
+    }
+
+    if (((event & CYHAL_SPI_IRQ_ERROR) != 0U) || ((gsr0 & FIFO_DMA_GSR0_ERR_MSK) != 0U))
+    {
+        abandon_sliced_frame();
+        frame_done = true;
+    }
+    else
+    {
+        dma_stats.slices++;
+        dma_slice++;
+
+        if (dma_slice == (dma_samples_per_frame / dma_slice_samples))
+        {
+            if (dma_slot >= 0)
+            {
+                const frame_slot_info_t info = {
+                    .frame_index = dma_frame_index,
+                    .timestamp_us = dma_timestamp_us,
+                    .packed = true
+                };
+
+                uint32_t latency_us = timebase_now_us() - dma_timestamp_us;
+
+                frame_ring_end_write(dma_ring, &info);
+                dma_stats.completed++;
+                dma_stats.last_latency_us = latency_us;
+
+                if (latency_us > dma_stats.max_latency_us)
+                {
+                    dma_stats.max_latency_us = latency_us;
+                }
+            }
+
+            dma_slot = -1;
+            dma_slice = 0U;
+            frame_done = true;
+        }
+    }
+
+    dma_active = false;
+
+    /* The threshold interrupt is level based: a slice that arrived during
+       the burst left it asserted without a new edge, so read it right away. */
+    if (!dma_flush_request && cyhal_gpio_read(dma_sensor->irqpin))
+    {
+        start_slice(timebase_now_us());
+    }
+
+    if (frame_done && (dma_callback != NULL))
+    {
+        dma_callback();
+    }
+}
+
+static void fifo_dma_event_callback(void *callback_arg, cyhal_spi_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+
+    cyhal_gpio_write(dma_sensor->iface.selpin, true);
+
+    if (dma_slice_samples > 0U)
+    {
+        slice_event(event);
+        return;
+    }
+
+    if (dma_slot < 0)
+    {
+        dma_active = false;
+        return;
+    }
+
+    uint8_t gsr0 = raw_area(&dma_slot_base[(uint32_t)dma_slot * dma_slot_samples])[0];
+
+    if (((event & CYHAL_SPI_IRQ_ERROR) != 0U) || ((gsr0 & FIFO_DMA_GSR0_ERR_MSK) != 0U))
+    {
+        dma_stats.errors++;
+        frame_ring_count_drop(dma_ring);
+        dma_flush_request = true;
+    }
+    else
+    {
+        const frame_slot_info_t info = {
+            .frame_index = dma_frame_index,
+            .timestamp_us = dma_timestamp_us,
+            .packed = true
+        };
+
+        uint32_t latency_us = timebase_now_us() - dma_timestamp_us;
+
+        frame_ring_end_write(dma_ring, &info);
+        dma_stats.completed++;
+        dma_stats.last_latency_us = latency_us;
+
+        if (latency_us > dma_stats.max_latency_us)
+        {
+            dma_stats.max_latency_us = latency_us;
+        }
+    }
+
+    dma_slot = -1;
+    dma_active = false;
+
+    if (dma_callback != NULL)
+    {
+        dma_callback();
+    }
+}
+
+cy_rslt_t fifo_dma_init(xensiv_bgt60trxx_mtb_t *sensor, frame_ring_t *ring,
+                        uint16_t *slot_base, uint32_t slot_samples,
+                        uint8_t intr_priority)
+{
+    if ((sensor == NULL) || (ring == NULL) || (slot_base == NULL) ||
+        (slot_samples == 0U) || ((slot_samples % 2U) != 0U))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    cy_rslt_t result = cyhal_spi_set_async_mode(sensor->iface.spi, CYHAL_ASYNC_DMA,
+                                                CYHAL_DMA_PRIORITY_DEFAULT);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        dma_sensor = sensor;
+        dma_ring = ring;
+        dma_slot_base = slot_base;
+        dma_slot_samples = slot_samples;
+        dma_samples_per_frame = slot_samples;
+
+        uint32_t fifo_addr = sensor->dev.type->fifo_addr;
+
+        /* Burst read starting at the FIFO register, unbounded length. */
+        dma_burst_cmd[0] = FIFO_DMA_BURST_CMD;
+        dma_burst_cmd[1] = (uint8_t)(fifo_addr << 1U);
+        dma_burst_cmd[2] = 0U;
+        dma_burst_cmd[3] = 0U;
+
+        cyhal_spi_register_callback(sensor->iface.spi, fifo_dma_event_callback, NULL);
+        cyhal_spi_enable_event(sensor->iface.spi,
+                               (cyhal_spi_event_t)(CYHAL_SPI_IRQ_DONE | CYHAL_SPI_IRQ_ERROR),
+                               intr_priority,
+                               true);
+    }
+
+    return result;
+}
+
+cy_rslt_t fifo_dma_init_layout(uint32_t slot_samples)
+{
+    if ((slot_samples == 0U) || ((slot_samples % 2U) != 0U))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    dma_slot_samples = slot_samples;
+    dma_samples_per_frame = slot_samples;
+    return CY_RSLT_SUCCESS;
+}
+
+void fifo_dma_start(uint32_t frame_index, uint32_t timestamp_us)
+{
+    if (dma_sensor == NULL)
+    {
+        return;
+    }
+
+    if (dma_active)
+    {
+        /* Previous frame still on the bus; leave this one in the FIFO. */
+        dma_stats.busy_drops++;
+        frame_ring_count_drop(dma_ring);
+        dma_flush_request = true;
+        return;
+    }
+
+    int32_t slot = frame_ring_begin_write(dma_ring);
+
+    if (slot < 0)
+    {
+        dma_stats.ring_drops++;
+        frame_ring_count_drop(dma_ring);
+        dma_flush_request = true;
+        return;
+    }
+
+    dma_slot = slot;
+    dma_frame_index = frame_index;
+    dma_timestamp_us = timestamp_us;
+    dma_active = true;
+
+    uint8_t *raw = raw_area(&dma_slot_base[(uint32_t)slot * dma_slot_samples]);
+
+    if (!start_burst(raw, dma_samples_per_frame))
+    {
+        dma_stats.errors++;
+        frame_ring_count_drop(dma_ring);
+        dma_flush_request = true;
+        dma_slot = -1;
+        dma_active = false;
+    }
+}
+
+cy_rslt_t fifo_dma_set_frame_samples(uint32_t samples_per_frame)
+{
+    if ((samples_per_frame == 0U) || ((samples_per_frame % 2U) != 0U) ||
+        (samples_per_frame > dma_slot_samples) || dma_active)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    dma_samples_per_frame = samples_per_frame;
+    dma_slice_samples = 0U;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t fifo_dma_set_slice_samples(uint32_t slice_samples)
+{
+    if ((slice_samples > 0U) &&
+        (((slice_samples % 2U) != 0U) || (slice_samples > FIFO_DMA_MAX_SLICE_SAMPLES) ||
+         ((dma_samples_per_frame % slice_samples) != 0U)))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if (dma_active)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    dma_slice_samples = slice_samples;
+    dma_slice = 0U;
+    return CY_RSLT_SUCCESS;
+}
+
+void fifo_dma_slice_ready(uint32_t timestamp_us)
+{
+    /* While a burst is running, the slice is picked up when it ends. */
+    if ((dma_sensor == NULL) || (dma_slice_samples == 0U) || dma_active)
+    {
+        return;
+    }
+
+    start_slice(timestamp_us);
+}
+
+uint32_t fifo_dma_frame_count(void)
+{
+    return dma_frames;
+}
+
+void fifo_dma_restart(void)
+{
+    dma_slot = -1;
+    dma_slice = 0U;
+    dma_frames = 0U;
+}
+
+bool fifo_dma_busy(void)
+{
+    return dma_active;
+}
+
+void fifo_dma_wait(void)
+{
+    while (dma_active)
+    {
+    }
+}
+
+bool fifo_dma_take_flush_request(void)
+{
+    bool request = dma_flush_request;
+    dma_flush_request = false;
+    return request;
+}
+
+void fifo_dma_set_callback(fifo_dma_callback_t callback)
+{
+    dma_callback = callback;
+}
+
+bool fifo_dma_flush_pending(void)
+{
+    return dma_flush_request;
+}
+
+const uint8_t *fifo_dma_packed_data(uint16_t *slot)
+{
+    return raw_area(slot) + FIFO_DMA_CMD_BYTES;
+}
+
+void fifo_dma_unpack(uint16_t *slot)
+{
+    /* Pair k is written to bytes [4k, 4k + 4) after bytes [n/2 + 3k, n/2 + 3k + 3)
+       (or later ones, in a slot larger than the frame) have been read, so the
+       write cursor never passes the read cursor. */
+    packed12_unpack(fifo_dma_packed_data(slot), slot, dma_samples_per_frame);
+}
+
+void fifo_dma_get_stats(fifo_dma_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        stats->completed = dma_stats.completed;
+        stats->busy_drops = dma_stats.busy_drops;
+        stats->ring_drops = dma_stats.ring_drops;
+        stats->errors = dma_stats.errors;
+        stats->slices = dma_stats.slices;
+        stats->last_latency_us = dma_stats.last_latency_us;
+        stats->max_latency_us = dma_stats.max_latency_us;
+    }
+}
+
+void fifo_dma_reset_stats(void)
+{
+    dma_stats.completed = 0U;
+    dma_stats.busy_drops = 0U;
+    dma_stats.ring_drops = 0U;
+    dma_stats.errors = 0U;
+    dma_stats.slices = 0U;
+    dma_stats.last_latency_us = 0U;
+    dma_stats.max_latency_us = 0U;
+}
@@ -0,0 +1,131 @@
+#ifndef FIFO_DMA_H
+#define FIFO_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+#include "xensiv_bgt60trxx_mtb.h"
+
+#include "frame_ring.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The sensor streams two 12-bit samples in three bytes, preceded by four
+   status bytes clocked out while the burst command is sent. */
+#define FIFO_DMA_CMD_BYTES                  (4U)
+#define FIFO_DMA_RAW_BYTES(num_samples)     (FIFO_DMA_CMD_BYTES + (((num_samples) * 3U) / 2U))
+
+/* 0: the sensor interrupts once per frame and the frame is read in one
+   burst. N > 0: it interrupts every N chirps and each slice is read as soon
+   as it is in the FIFO, so a frame is in RAM one slice after its last chirp
+   and only one slice ever waits in the sensor FIFO. The chirps per frame of
+   every profile must be a multiple of N. */
+#ifndef FIFO_SLICE_CHIRPS
+#define FIFO_SLICE_CHIRPS                   (0)
+#endif
+
+/* Largest slice fifo_dma_set_slice_samples() accepts. A frame that finds the
+   ring full is still read out, slice by slice, into a scratch buffer of this
+   size so the next frame starts on a slice boundary. */
+#ifndef FIFO_DMA_MAX_SLICE_SAMPLES
+#if FIFO_SLICE_CHIRPS
+#define FIFO_DMA_MAX_SLICE_SAMPLES          (1536U)
+#else
+#define FIFO_DMA_MAX_SLICE_SAMPLES          (0U)
+#endif
+#endif
+
+/* Samples per slice of chirps of chirp_samples samples (all antennas), 0
+   without slicing, and the sensor FIFO threshold that goes with it. */
+#define FIFO_DMA_SLICE_SAMPLES(chirp_samples)               ((uint32_t)(chirp_samples) * (uint32_t)FIFO_SLICE_CHIRPS)
+#define FIFO_DMA_IRQ_SAMPLES(chirp_samples, num_chirps)     ((FIFO_SLICE_CHIRPS > 0) ?\
+                                                             FIFO_DMA_SLICE_SAMPLES(chirp_samples) :\
+                                                             ((uint32_t)(chirp_samples) * (uint32_t)(num_chirps)))
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t completed;
+    uint32_t busy_drops;
+    uint32_t ring_drops;
+    uint32_t errors;
+    uint32_t slices;                /* bursts that ended a slice, FIFO_SLICE_CHIRPS only */
+    uint32_t last_latency_us;       /* sensor interrupt to frame in RAM, last readout */
+    uint32_t max_latency_us;
+} fifo_dma_stats_t;
+
+/* Called from the DMA interrupt whenever a readout ends, successful or not. */
+typedef void (*fifo_dma_callback_t)(void);
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Puts the sensor SPI into DMA async mode. Frames land in slot_base, which
+   holds FRAME_RING_NUM_SLOTS consecutive buffers of slot_samples uint16_t
+   each, and are published to ring when the transfer completes. Frames fill
+   whole slots until fifo_dma_set_frame_samples() says otherwise. */
+cy_rslt_t fifo_dma_init(xensiv_bgt60trxx_mtb_t *sensor, frame_ring_t *ring,
+                        uint16_t *slot_base, uint32_t slot_samples,
+                        uint8_t intr_priority);
+
+/* Sets up only the slot layout that fifo_dma_unpack() and
+   fifo_dma_packed_data() rely on, for a core that processes frames read out
+   by the other core (DUAL_CORE_ACQUISITION). fifo_dma_start() stays inert. */
+cy_rslt_t fifo_dma_init_layout(uint32_t slot_samples);
+
+/* Changes the number of samples read per frame, e.g. after the sensor got a
+   new register profile, and goes back to reading whole frames. Call only
+   while no readout is in flight. */
+cy_rslt_t fifo_dma_set_frame_samples(uint32_t samples_per_frame);
+
+/* Reads frames in slices of slice_samples (0: whole frames) after
+   fifo_dma_set_frame_samples(). The frame must be a multiple of the slice,
+   and the sensor FIFO threshold must be set to one slice. */
+cy_rslt_t fifo_dma_set_slice_samples(uint32_t slice_samples);
+
+/* Starts reading one frame out of the sensor FIFO. Safe to call from the
+   sensor interrupt; returns without waiting for the transfer. timestamp_us is
+   stored with the frame. */
+void fifo_dma_start(uint32_t frame_index, uint32_t timestamp_us);
+
+/* Slice counterpart of fifo_dma_start(), called from the sensor interrupt
+   for every slice. Frames are numbered by the readout from
+   fifo_dma_restart() on, since slices still waiting in the FIFO when a burst
+   ends are read without another interrupt. timestamp_us is stored with the
+   frame whose last slice it announces. */
+void fifo_dma_slice_ready(uint32_t timestamp_us);
+
+/* Frames begun by fifo_dma_slice_ready() since fifo_dma_restart(). */
+uint32_t fifo_dma_frame_count(void);
+
+/* Forgets a partly read frame and numbers the next one 0. Call before the
+   sensor starts, with no readout in flight. */
+void fifo_dma_restart(void);
+
+bool fifo_dma_busy(void);
+void fifo_dma_wait(void);
+
+/* True if a frame had to be left in the sensor FIFO; the caller must flush
+   the FIFO from thread context before the next frame. Clears the request. */
+bool fifo_dma_take_flush_request(void);
+
+/* Same condition without clearing it, e.g. to decide whether to sleep. */
+bool fifo_dma_flush_pending(void);
+
+/* Start of the Packed12 sample data inside a slot filled by DMA. */
+const uint8_t *fifo_dma_packed_data(uint16_t *slot);
+
+/* Converts a slot filled by DMA from the sensor's Packed12 layout to one
+   uint16_t per sample, in place. */
+void fifo_dma_unpack(uint16_t *slot);
+
+void fifo_dma_set_callback(fifo_dma_callback_t callback);
+
+void fifo_dma_get_stats(fifo_dma_stats_t *stats);
+void fifo_dma_reset_stats(void);
+
+#endif /* FIFO_DMA_H */
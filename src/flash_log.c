@@ -0,0 +1,622 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "cybsp.h"
+#include "cycfg_qspi_memslot.h"
+
+#include "flash_log.h"
+
+/* Every sector starts with a header; records follow back to back. A record
+   may continue in the next sector, its 8-byte record header never does. The
+   sector that receives sequence number seq is seq % num_sectors, so the log
+   wraps around and the oldest sector is erased for the newest. */
+#define FLASH_LOG_SECTOR_MAGIC              (0x474F4C52UL)  /* "RLOG" */
+#define FLASH_LOG_RECORD_MAGIC              (0x43455252UL)  /* "RREC" */
+
+#define FLASH_LOG_MAX_PIECES                (3U)
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;
+    uint32_t first_seq;             /* oldest sector of the log when this one was opened */
+    uint32_t erase_count;           /* erases of this sector, this one included */
+    uint32_t first_record;          /* offset of the first record header in this sector */
+} flash_log_sector_header_t;
+
+typedef struct
+{
+    uint32_t magic;
+    uint32_t length;                /* bytes following this header */
+} flash_log_record_header_t;
+
+typedef enum
+{
+    FLASH_OP_IDLE,
+    FLASH_OP_TRANSFER,              /* SMIF is still sending program data */
+    FLASH_OP_PROGRAM,               /* the device is programming a page */
+    FLASH_OP_ERASE                  /* the device is erasing a sector */
+} flash_op_t;
+
+typedef struct
+{
+    const uint8_t *data;
+    uint32_t length;
+} flash_log_piece_t;
+
+static cyhal_qspi_t qspi;
+static cy_stc_smif_mem_config_t *mem = NULL;
+static bool initialized = false;
+static bool reading = false;
+
+static uint32_t log_base = 0U;
+static uint32_t sector_size = 0U;
+static uint32_t page_size = 0U;
+static uint32_t num_sectors = 0U;
+static uint32_t erase_count[FLASH_LOG_MAX_SECTORS];
+
+/* Sequence numbers: [first_seq, next_seq) hold the log, the last of them is
+   open for writing while sector_open is set, [next_seq, erased_end) are
+   erased and waiting. */
+static uint32_t first_seq = 0U;
+static uint32_t next_seq = 0U;
+static uint32_t erased_end = 0U;
+static uint32_t reserve = FLASH_LOG_DEFAULT_RESERVE;
+static bool sector_open = false;
+static uint32_t write_offset = 0U;
+
+/* Record being appended. */
+static flash_log_record_header_t record_header;
+static flash_log_sector_header_t sector_header;
+static flash_log_piece_t pieces[FLASH_LOG_MAX_PIECES];
+static uint32_t piece_index = 0U;
+static uint32_t piece_count = 0U;
+static uint32_t record_left = 0U;
+static bool header_pending = false;
+static bool stalled = false;
+
+static volatile flash_op_t op = FLASH_OP_IDLE;
+static uint32_t op_seq = 0U;
+
+/* Read position. */
+static uint32_t read_seq = 0U;
+static uint32_t read_offset = 0U;
+static uint32_t read_left = 0U;
+
+static flash_log_stats_t log_stats;
+
+static bool seq_before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static uint32_t sector_index(uint32_t seq)
+{
+    return seq % num_sectors;
+}
+
+static uint32_t device_address(uint32_t seq, uint32_t offset)
+{
+    return log_base + (sector_index(seq) * sector_size) + offset;
+}
+
+static const uint8_t *mapped_address(uint32_t seq, uint32_t offset)
+{
+    return (const uint8_t *)(mem->baseAddress + device_address(seq, offset));
+}
+
+static void address_bytes(uint32_t address, uint8_t *bytes)
+{
+    const uint32_t n = mem->deviceCfg->numOfAddrBytes;
+
+    for (uint32_t i = 0U; i < n; i++)
+    {
+        bytes[i] = (uint8_t)(address >> (8U * (n - 1U - i)));
+    }
+}
+
+static void transfer_done(uint32_t event)
+{
+    CY_UNUSED_PARAMETER(event);
+    op = FLASH_OP_PROGRAM;
+}
+
+/* Sends write enable and the program command; the SMIF interrupt feeds the
+   data to the TX FIFO and transfer_done() runs once it is out. */
+static bool start_program(uint32_t address, const uint8_t *data, uint32_t length)
+{
+    uint8_t addr[CY_SMIF_FOUR_BYTES_ADDR];
+
+    address_bytes(address, addr);
+    op = FLASH_OP_TRANSFER;
+
+    if ((Cy_SMIF_MemCmdWriteEnable(qspi.base, mem, &qspi.context) != CY_SMIF_SUCCESS) ||
+        (Cy_SMIF_MemCmdProgram(qspi.base, mem, addr, (uint8_t *)data, length,
+                               transfer_done, &qspi.context) != CY_SMIF_SUCCESS))
+    {
+        op = FLASH_OP_IDLE;
+        log_stats.errors++;
+        return false;
+    }
+
+    return true;
+}
+
+/* Erasing the sector for seq overwrites whatever the sector held one lap
+   earlier. */
+static bool start_erase(uint32_t seq)
+{
+    uint8_t addr[CY_SMIF_FOUR_BYTES_ADDR];
+
+    address_bytes(device_address(seq, 0U), addr);
+
+    if (seq_before(first_seq, seq - num_sectors + 1U))
+    {
+        first_seq = seq - num_sectors + 1U;
+    }
+
+    if ((Cy_SMIF_MemCmdWriteEnable(qspi.base, mem, &qspi.context) != CY_SMIF_SUCCESS) ||
+        (Cy_SMIF_MemCmdSectorErase(qspi.base, mem, addr, &qspi.context) != CY_SMIF_SUCCESS))
+    {
+        log_stats.errors++;
+        return false;
+    }
+
+    op = FLASH_OP_ERASE;
+    op_seq = seq;
+    return true;
+}
+
+static bool append_pending(void)
+{
+    return header_pending || (piece_index < piece_count);
+}
+
+/* Takes the next erased sector and writes its header first. */
+static void open_sector(void)
+{
+    const uint32_t seq = next_seq++;
+
+    sector_open = true;
+    write_offset = sizeof(flash_log_sector_header_t);
+
+    sector_header.magic = FLASH_LOG_SECTOR_MAGIC;
+    sector_header.seq = seq;
+    sector_header.first_seq = first_seq;
+    sector_header.erase_count = erase_count[sector_index(seq)];
+    /* The next record header: here if the current record has not started
+       yet, otherwise after its rest. A value past the sector end means no
+       record starts in this sector. */
+    sector_header.first_record = (piece_index == 0U) ? write_offset : (write_offset + record_left);
+    header_pending = true;
+}
+
+static void advance_append(void)
+{
+    if (header_pending)
+    {
+        header_pending = false;
+        (void)start_program(device_address(next_seq - 1U, 0U), (const uint8_t *)&sector_header,
+                            sizeof(sector_header));
+        return;
+    }
+
+    const flash_log_piece_t *piece = &pieces[piece_index];
+    /* The record header is written in one go. */
+    const uint32_t needed = (piece->data == (const uint8_t *)&record_header) ? piece->length : 1U;
+
+    if (!sector_open || ((write_offset + needed) > sector_size))
+    {
+        if (next_seq == erased_end)
+        {
+            if (!stalled)
+            {
+                stalled = true;
+                log_stats.stalls++;
+            }
+
+            (void)start_erase(erased_end);
+            return;
+        }
+
+        open_sector();
+        advance_append();
+        return;
+    }
+
+    /* Within the sector and the program page. */
+    const uint32_t address = device_address(next_seq - 1U, write_offset);
+    uint32_t chunk = piece->length;
+
+    if (chunk > (sector_size - write_offset))
+    {
+        chunk = sector_size - write_offset;
+    }
+
+    if (chunk > (page_size - (address % page_size)))
+    {
+        chunk = page_size - (address % page_size);
+    }
+
+    if (!start_program(address, piece->data, chunk))
+    {
+        return;
+    }
+
+    write_offset += chunk;
+    record_left -= chunk;
+    pieces[piece_index].data += chunk;
+    pieces[piece_index].length -= chunk;
+
+    if (pieces[piece_index].length == 0U)
+    {
+        piece_index++;
+    }
+}
+
+static bool reserve_low(void)
+{
+    return (erased_end - next_seq) < reserve;
+}
+
+/* Reads the sector headers with blocking SMIF reads. */
+static void scan_sectors(void)
+{
+    bool found = false;
+    uint32_t newest = 0U;
+    uint32_t oldest = 0U;
+
+    for (uint32_t i = 0U; i < num_sectors; i++)
+    {
+        flash_log_sector_header_t header;
+
+        if (Cy_SMIF_MemRead(qspi.base, mem, log_base + (i * sector_size), (uint8_t *)&header,
+                            sizeof(header), &qspi.context) != CY_SMIF_SUCCESS)
+        {
+            log_stats.errors++;
+            erase_count[i] = 0U;
+            continue;
+        }
+
+        if ((header.magic != FLASH_LOG_SECTOR_MAGIC) || ((header.seq % num_sectors) != i))
+        {
+            erase_count[i] = 0U;
+            continue;
+        }
+
+        erase_count[i] = header.erase_count;
+
+        if (!found || seq_before(newest, header.seq))
+        {
+            newest = header.seq;
+            oldest = header.first_seq;
+            found = true;
+        }
+    }
+
+    if (found)
+    {
+        next_seq = newest + 1U;
+        first_seq = seq_before(oldest, next_seq - num_sectors) ? (next_seq - num_sectors) : oldest;
+    }
+    else
+    {
+        next_seq = 0U;
+        first_seq = 0U;
+    }
+
+    erased_end = next_seq;
+    sector_open = false;
+}
+
+cy_rslt_t flash_log_init(void)
+{
+    const cyhal_qspi_slave_pin_config_t pins = {
+        .io = { CYBSP_QSPI_D0, CYBSP_QSPI_D1, CYBSP_QSPI_D2, CYBSP_QSPI_D3, NC, NC, NC, NC },
+        .ssel = CYBSP_QSPI_SS
+    };
+
+    cy_rslt_t result = cyhal_qspi_init(&qspi, CYBSP_QSPI_SCK, &pins, FLASH_LOG_QSPI_FREQUENCY_HZ, 0U, NULL);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    /* Quad mode and the memory-mapped window of slot 0. */
+    if (Cy_SMIF_MemInit(qspi.base, &smifBlockConfig, &qspi.context) != CY_SMIF_SUCCESS)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    mem = smifMemConfigs[0];
+    sector_size = mem->deviceCfg->eraseSize;
+    page_size = mem->deviceCfg->programSize;
+
+    const uint32_t device_size = mem->deviceCfg->memSize;
+    const uint32_t offset = ((FLASH_LOG_OFFSET + sector_size - 1U) / sector_size) * sector_size;
+    uint32_t size = (FLASH_LOG_SIZE == 0UL) ? (device_size - offset) : FLASH_LOG_SIZE;
+
+    if ((offset >= device_size) || (size > (device_size - offset)))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    log_base = offset;
+    num_sectors = size / sector_size;
+
+    if (num_sectors > FLASH_LOG_MAX_SECTORS)
+    {
+        num_sectors = FLASH_LOG_MAX_SECTORS;
+    }
+
+    if ((num_sectors < 2U) || (sector_size <= (sizeof(flash_log_sector_header_t) +
+                                               sizeof(flash_log_record_header_t))))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    (void)memset(&log_stats, 0, sizeof(log_stats));
+    scan_sectors();
+    flash_log_reserve(reserve);
+    initialized = true;
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t flash_log_append(const void *head, uint32_t head_length,
+                           const void *body, uint32_t body_length)
+{
+    const uint32_t length = head_length + body_length;
+
+    if (!initialized || reading || append_pending() || (length < head_length) ||
+        (length > (sector_size - sizeof(flash_log_sector_header_t) - sizeof(flash_log_record_header_t))))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    record_header.magic = FLASH_LOG_RECORD_MAGIC;
+    record_header.length = length;
+
+    piece_count = 0U;
+    pieces[piece_count++] = (flash_log_piece_t){ (const uint8_t *)&record_header, sizeof(record_header) };
+
+    if (head_length > 0U)
+    {
+        pieces[piece_count++] = (flash_log_piece_t){ (const uint8_t *)head, head_length };
+    }
+
+    if (body_length > 0U)
+    {
+        pieces[piece_count++] = (flash_log_piece_t){ (const uint8_t *)body, body_length };
+    }
+
+    piece_index = 0U;
+    record_left = sizeof(record_header) + length;
+    stalled = false;
+    log_stats.records++;
+    log_stats.bytes += length;
+
+    flash_log_service();
+    return CY_RSLT_SUCCESS;
+}
+
+bool flash_log_busy(void)
+{
+    return append_pending() || ((op != FLASH_OP_IDLE) && (op != FLASH_OP_ERASE));
+}
+
+void flash_log_service(void)
+{
+    if (!initialized || reading || (op == FLASH_OP_TRANSFER))
+    {
+        return;
+    }
+
+    if (op != FLASH_OP_IDLE)
+    {
+        if (Cy_SMIF_MemIsBusy(qspi.base, mem, &qspi.context))
+        {
+            return;
+        }
+
+        if (op == FLASH_OP_ERASE)
+        {
+            erase_count[sector_index(op_seq)]++;
+            erased_end = op_seq + 1U;
+        }
+
+        op = FLASH_OP_IDLE;
+    }
+
+    /* Records first; background erases only refill the reserve. */
+    if (append_pending())
+    {
+        advance_append();
+    }
+    else if (reserve_low())
+    {
+        (void)start_erase(erased_end);
+    }
+}
+
+bool flash_log_pending(void)
+{
+    if (!initialized || reading)
+    {
+        return false;
+    }
+
+    /* The end of a transfer raises the SMIF interrupt. */
+    return (op == FLASH_OP_PROGRAM) || (op == FLASH_OP_ERASE) ||
+           ((op == FLASH_OP_IDLE) && (append_pending() || reserve_low()));
+}
+
+void flash_log_reserve(uint32_t sectors)
+{
+    reserve = (sectors < (num_sectors - 1U)) ? sectors : (num_sectors - 1U);
+}
+
+void flash_log_clear(void)
+{
+    if (append_pending())
+    {
+        return;
+    }
+
+    first_seq = next_seq;
+    sector_open = false;
+}
+
+/* First record header of a sector; false if the sector holds none. */
+static bool sector_first_record(uint32_t seq, uint32_t *offset)
+{
+    const flash_log_sector_header_t *header = (const flash_log_sector_header_t *)mapped_address(seq, 0U);
+
+    if ((header->magic != FLASH_LOG_SECTOR_MAGIC) || (header->seq != seq))
+    {
+        return false;
+    }
+
+    *offset = header->first_record;
+    return true;
+}
+
+cy_rslt_t flash_log_read_begin(void)
+{
+    if (!initialized || reading || append_pending() || (op != FLASH_OP_IDLE))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    /* The XIP cache may hold data from before the last writes. */
+    Cy_SMIF_SetMode(qspi.base, CY_SMIF_MEMORY);
+    Cy_SMIF_CacheInvalidate(qspi.base, CY_SMIF_CACHE_BOTH);
+    reading = true;
+
+    read_seq = first_seq;
+    read_left = 0U;
+
+    if (!sector_first_record(read_seq, &read_offset))
+    {
+        read_offset = sector_size;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+bool flash_log_read_next(const uint8_t **data, uint32_t *length)
+{
+    if (!reading)
+    {
+        return false;
+    }
+
+    while (seq_before(read_seq, next_seq))
+    {
+        if (read_left > 0U)
+        {
+            if (read_offset >= sector_size)
+            {
+                /* The record continues right after the next sector header. */
+                read_seq++;
+                read_offset = sizeof(flash_log_sector_header_t);
+
+                uint32_t unused;
+
+                if (!sector_first_record(read_seq, &unused))
+                {
+                    read_left = 0U;
+                    read_offset = sector_size;
+                }
+
+                continue;
+            }
+
+            uint32_t chunk = sector_size - read_offset;
+
+            if (chunk > read_left)
+            {
+                chunk = read_left;
+            }
+
+            if (chunk > FLASH_LOG_READ_CHUNK)
+            {
+                chunk = FLASH_LOG_READ_CHUNK;
+            }
+
+            *data = mapped_address(read_seq, read_offset);
+            *length = chunk;
+            read_offset += chunk;
+            read_left -= chunk;
+            return true;
+        }
+
+        const flash_log_record_header_t *record = NULL;
+
+        if ((read_offset + sizeof(flash_log_record_header_t)) <= sector_size)
+        {
+            record = (const flash_log_record_header_t *)mapped_address(read_seq, read_offset);
+        }
+
+        if ((record == NULL) || (record->magic != FLASH_LOG_RECORD_MAGIC))
+        {
+            /* End of the data in this sector. */
+            read_seq++;
+
+            if (!seq_before(read_seq, next_seq) || !sector_first_record(read_seq, &read_offset))
+            {
+                read_offset = sector_size;
+            }
+
+            continue;
+        }
+
+        read_left = record->length;
+        read_offset += sizeof(flash_log_record_header_t);
+    }
+
+    return false;
+}
+
+void flash_log_read_end(void)
+{
+    if (reading)
+    {
+        Cy_SMIF_SetMode(qspi.base, CY_SMIF_NORMAL);
+        reading = false;
+    }
+}
+
+void flash_log_get_stats(flash_log_stats_t *stats)
+{
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    *stats = log_stats;
+    stats->sector_size = sector_size;
+    stats->num_sectors = num_sectors;
+    stats->used_sectors = next_seq - first_seq;
+    stats->erased_ahead = erased_end - next_seq;
+    stats->min_erase_count = UINT32_MAX;
+    stats->max_erase_count = 0U;
+
+    for (uint32_t i = 0U; i < num_sectors; i++)
+    {
+        if (erase_count[i] < stats->min_erase_count)
+        {
+            stats->min_erase_count = erase_count[i];
+        }
+
+        if (erase_count[i] > stats->max_erase_count)
+        {
+            stats->max_erase_count = erase_count[i];
+        }
+    }
+
+    if (num_sectors == 0U)
+    {
+        stats->min_erase_count = 0U;
+    }
+}
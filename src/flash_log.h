@@ -0,0 +1,100 @@
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#ifndef FLASH_LOG_QSPI_FREQUENCY_HZ
+#define FLASH_LOG_QSPI_FREQUENCY_HZ         (50000000UL)
+#endif
+
+/* Part of the QSPI flash the log may use, in bytes from the start of the
+   device. A size of 0 extends the log to the end of the device. Both are
+   rounded to whole erase sectors. */
+#ifndef FLASH_LOG_OFFSET
+#define FLASH_LOG_OFFSET                    (0UL)
+#endif
+#ifndef FLASH_LOG_SIZE
+#define FLASH_LOG_SIZE                      (0UL)
+#endif
+
+/* Sectors beyond this count are left unused (erase counters live in RAM). */
+#define FLASH_LOG_MAX_SECTORS               (256U)
+
+/* Sectors kept erased ahead of the write position unless flash_log_reserve()
+   asks for more. */
+#ifndef FLASH_LOG_DEFAULT_RESERVE
+#define FLASH_LOG_DEFAULT_RESERVE           (1U)
+#endif
+
+/* Longest piece flash_log_read_next() hands out. */
+#define FLASH_LOG_READ_CHUNK                (4096U)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t sector_size;
+    uint32_t num_sectors;
+    uint32_t used_sectors;          /* sectors holding log data */
+    uint32_t erased_ahead;          /* erased sectors ready for records */
+    uint32_t records;               /* appended since boot */
+    uint32_t bytes;                 /* record bytes appended since boot */
+    uint32_t stalls;                /* records that had to wait for an erase */
+    uint32_t errors;                /* SMIF commands that failed */
+    uint32_t min_erase_count;
+    uint32_t max_erase_count;
+} flash_log_stats_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Brings up the QSPI block with the memory configuration from the BSP
+   (cycfg_qspi_memslot.h) and finds the end of an earlier log by reading the
+   sector headers. Writing resumes in a fresh sector. */
+cy_rslt_t flash_log_init(void);
+
+/* Starts appending one record made of head and body, which must stay
+   untouched until flash_log_busy() returns false. Fails while an earlier
+   record is still being written or a read is open. Records larger than a
+   sector minus its header are rejected. */
+cy_rslt_t flash_log_append(const void *head, uint32_t head_length,
+                           const void *body, uint32_t body_length);
+
+/* True while a record is being written. */
+bool flash_log_busy(void);
+
+/* Advances programming and background erases; never blocks. Call it until
+   flash_log_pending() returns false. Programming a page and erasing a sector
+   end without an interrupt, so the caller must not sleep while work is
+   pending. */
+void flash_log_service(void);
+bool flash_log_pending(void);
+
+/* Number of sectors to keep erased ahead of the write position, so a burst
+   of that size is written at programming speed. Capped to all sectors but
+   one; the erases overwrite the oldest data. */
+void flash_log_reserve(uint32_t sectors);
+
+/* Drops all records. The sectors are only reused, not erased; the clear
+   reaches the flash with the next record. */
+void flash_log_clear(void);
+
+/* Walks the records from the oldest on, through the memory-mapped (XIP)
+   view of the flash. Each call to flash_log_read_next() returns the next
+   piece of record data, at most FLASH_LOG_READ_CHUNK bytes, as a pointer
+   into the mapped flash; records come out back to back without framing.
+   Appends are refused until flash_log_read_end(). */
+cy_rslt_t flash_log_read_begin(void);
+bool flash_log_read_next(const uint8_t **data, uint32_t *length);
+void flash_log_read_end(void);
+
+void flash_log_get_stats(flash_log_stats_t *stats);
+
+#endif /* FLASH_LOG_H */
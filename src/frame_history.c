@@ -0,0 +1,80 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "frame_history.h"
+
+void frame_history_init(frame_history_t *history, uint8_t *storage, uint32_t slot_bytes)
+{
+    if (history == NULL)
+    {
+        return;
+    }
+
+    history->storage = storage;
+    history->slot_bytes = slot_bytes;
+    frame_history_reset(history);
+}
+
+void frame_history_reset(frame_history_t *history)
+{
+    if (history == NULL)
+    {
+        return;
+    }
+
+    history->head = 0U;
+    history->tail = 0U;
+}
+
+uint32_t frame_history_level(const frame_history_t *history)
+{
+    return history->head - history->tail;
+}
+
+void frame_history_trim(frame_history_t *history, uint32_t keep)
+{
+    if (frame_history_level(history) > keep)
+    {
+        history->tail = history->head - keep;
+    }
+}
+
+bool frame_history_push(frame_history_t *history, const void *header, uint32_t header_size,
+                        const uint8_t *payload, uint32_t payload_size)
+{
+    if ((frame_history_level(history) >= FRAME_HISTORY_SLOTS) ||
+        (header_size > history->slot_bytes) || (payload_size > (history->slot_bytes - header_size)))
+    {
+        return false;
+    }
+
+    const uint32_t slot = history->head % FRAME_HISTORY_SLOTS;
+    uint8_t *record = &history->storage[slot * history->slot_bytes];
+
+    memcpy(record, header, header_size);
+    memcpy(&record[header_size], payload, payload_size);
+    history->length[slot] = header_size + payload_size;
+    history->head++;
+    return true;
+}
+
+const uint8_t *frame_history_peek(const frame_history_t *history, uint32_t *length)
+{
+    if (frame_history_level(history) == 0U)
+    {
+        return NULL;
+    }
+
+    const uint32_t slot = history->tail % FRAME_HISTORY_SLOTS;
+
+    *length = history->length[slot];
+    return &history->storage[slot * history->slot_bytes];
+}
+
+void frame_history_pop(frame_history_t *history)
+{
+    if (frame_history_level(history) > 0U)
+    {
+        history->tail++;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef FRAME_HISTORY_H
+#define FRAME_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records the history can hold. Override from the Makefile
+   (DEFINES+=FRAME_HISTORY_SLOTS=12) to keep more frames before a trigger. */
+#ifndef FRAME_HISTORY_SLOTS
+#define FRAME_HISTORY_SLOTS                 (6U)
+#endif
+
+#if (FRAME_HISTORY_SLOTS < 1U)
+#error "FRAME_HISTORY_SLOTS must be at least 1"
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Ring of complete wire records (frame header followed by its payload) in
+   fixed-size slots of caller-owned storage. Records are kept as they would
+   have been sent, so uploading one is a single transfer. head and tail are
+   free-running counters, as in frame_ring_t. */
+typedef struct
+{
+    uint8_t *storage;               /* FRAME_HISTORY_SLOTS * slot_bytes */
+    uint32_t slot_bytes;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t length[FRAME_HISTORY_SLOTS];
+} frame_history_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+void frame_history_init(frame_history_t *history, uint8_t *storage, uint32_t slot_bytes);
+void frame_history_reset(frame_history_t *history);
+uint32_t frame_history_level(const frame_history_t *history);
+
+/* Drops the oldest records until at most keep are left. */
+void frame_history_trim(frame_history_t *history, uint32_t keep);
+
+/* Copies header and payload into the next slot as one record. Fails if every
+   slot is taken or the record does not fit a slot. */
+bool frame_history_push(frame_history_t *history, const void *header, uint32_t header_size,
+                        const uint8_t *payload, uint32_t payload_size);
+
+/* Oldest record and its length, or NULL if the history is empty. It stays
+   valid until frame_history_pop(). */
+const uint8_t *frame_history_peek(const frame_history_t *history, uint32_t *length);
+void frame_history_pop(frame_history_t *history);
+
+#endif /* FRAME_HISTORY_H */
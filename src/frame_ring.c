@@ -0,0 +1,86 @@
+#include <stddef.h>
+
+#include "cyhal.h"
+
+#include "frame_ring.h"
+
+void frame_ring_reset(frame_ring_t *ring)
+{
+    if (ring == NULL)
+    {
+        return;
+    }
+
+    ring->head = 0U;
+    ring->tail = 0U;
+    ring->drop_pending = false;
+}
+
+uint32_t frame_ring_level(const frame_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+uint32_t frame_ring_written(const frame_ring_t *ring)
+{
+    return ring->head;
+}
+
+int32_t frame_ring_begin_write(const frame_ring_t *ring)
+{
+    if (frame_ring_level(ring) >= FRAME_RING_NUM_SLOTS)
+    {
+        return -1;
+    }
+
+    return (int32_t)(ring->head % FRAME_RING_NUM_SLOTS);
+}
+
+void frame_ring_end_write(frame_ring_t *ring, const frame_slot_info_t *info)
+{
+    uint32_t slot = ring->head % FRAME_RING_NUM_SLOTS;
+
+    if (info != NULL)
+    {
+        ring->info[slot] = *info;
+    }
+
+    ring->info[slot].overflow = ring->drop_pending;
+    ring->drop_pending = false;
+
+    /* Publish the slot only after its metadata is in place. */
+    __DMB();
+    ring->head++;
+}
+
+int32_t frame_ring_begin_read(const frame_ring_t *ring)
+{
+    if (frame_ring_level(ring) == 0U)
+    {
+        return -1;
+    }
+
+    return (int32_t)(ring->tail % FRAME_RING_NUM_SLOTS);
+}
+
+int32_t frame_ring_slot_at(const frame_ring_t *ring, uint32_t position)
+{
+    if ((position - ring->tail) >= frame_ring_level(ring))
+    {
+        return -1;
+    }
+
+    return (int32_t)(position % FRAME_RING_NUM_SLOTS);
+}
+
+void frame_ring_end_read(frame_ring_t *ring)
+{
+    __DMB();
+    ring->tail++;
+}
+
+void frame_ring_count_drop(frame_ring_t *ring)
+{
+    ring->dropped++;
+    ring->drop_pending = true;
+}
@@ -0,0 +1,73 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of frame buffers between acquisition and transmission. Override from
+   the Makefile (DEFINES+=FRAME_RING_NUM_SLOTS=3) to trade RAM for slack. */
+#ifndef FRAME_RING_NUM_SLOTS
+#define FRAME_RING_NUM_SLOTS                (2U)
+#endif
+
+#if (FRAME_RING_NUM_SLOTS < 2U)
+#error "FRAME_RING_NUM_SLOTS must be at least 2"
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Metadata kept next to each frame buffer. */
+typedef struct
+{
+    uint32_t frame_index;
+    uint32_t timestamp_us;  /* timebase_now_us() when the sensor raised the frame interrupt */
+    bool packed;            /* samples still in the sensor's 3-bytes-per-2 layout */
+    bool overflow;          /* frames were dropped right before this one; set by the ring */
+} frame_slot_info_t;
+
+/* Single-producer/single-consumer ring of slot indices. The sample storage is
+   owned by the caller; the ring only tells which slot to fill or drain. head
+   and tail are free-running counters, so (head - tail) is the fill level. */
+typedef struct
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t dropped;
+    volatile bool drop_pending;     /* a drop not yet reported through info.overflow */
+    frame_slot_info_t info[FRAME_RING_NUM_SLOTS];
+} frame_ring_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Empties the ring. The drop counter is kept so it can still be reported
+   after the session; the caller clears it when a new session starts. */
+void frame_ring_reset(frame_ring_t *ring);
+
+/* Returns the slot the producer may fill next, or -1 if every slot is still
+   waiting to be drained. */
+int32_t frame_ring_begin_write(const frame_ring_t *ring);
+void frame_ring_end_write(frame_ring_t *ring, const frame_slot_info_t *info);
+
+/* Returns the oldest filled slot, or -1 if the ring is empty. */
+int32_t frame_ring_begin_read(const frame_ring_t *ring);
+void frame_ring_end_read(frame_ring_t *ring);
+
+/* Counts a frame lost before it reached the ring. The next frame written is
+   marked with info.overflow. */
+void frame_ring_count_drop(frame_ring_t *ring);
+uint32_t frame_ring_level(const frame_ring_t *ring);
+
+/* Slot of the frame at a free-running ring position, or -1 unless that frame
+   has been written and not yet read. Lets a stage between producer and
+   consumer walk the queued frames in order. */
+int32_t frame_ring_slot_at(const frame_ring_t *ring, uint32_t position);
+
+/* Number of frames written since the last reset. */
+uint32_t frame_ring_written(const frame_ring_t *ring);
+
+#endif /* FRAME_RING_H */
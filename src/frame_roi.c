@@ -0,0 +1,70 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "frame_roi.h"
+
+uint32_t frame_roi_num_rx(uint32_t rx_mask)
+{
+    uint32_t count = 0U;
+
+    while (rx_mask != 0U)
+    {
+        rx_mask &= rx_mask - 1U;
+        count++;
+    }
+
+    return count;
+}
+
+uint32_t frame_roi_gather(uint16_t *frame, uint32_t num_chirps, uint32_t num_samples,
+                          uint32_t num_rx, const frame_roi_t *roi)
+{
+    if ((frame == NULL) || (roi == NULL) || (num_rx == 0U) || (num_rx > 31U) ||
+        (roi->rx_mask == 0U) || ((roi->rx_mask >> num_rx) != 0U) ||
+        (roi->first_chirp >= num_chirps) || (roi->num_chirps > (num_chirps - roi->first_chirp)) ||
+        (roi->first_sample >= num_samples) || (roi->num_samples > (num_samples - roi->first_sample)))
+    {
+        return 0U;
+    }
+
+    const uint32_t chirp_stride = num_samples * num_rx;
+    uint32_t out = 0U;
+
+    /* Output value j only reads input values at index >= j, so writing in
+       increasing order never overwrites an unread input. */
+    if (roi->rx_mask == ((1UL << num_rx) - 1U))
+    {
+        /* With every antenna, the window of a chirp is one run. */
+        const uint32_t run = roi->num_samples * num_rx;
+
+        for (uint32_t c = 0U; c < roi->num_chirps; c++)
+        {
+            const uint32_t in = ((roi->first_chirp + c) * chirp_stride) + (roi->first_sample * num_rx);
+
+            memmove(&frame[out], &frame[in], run * sizeof(uint16_t));
+            out += run;
+        }
+
+        return out;
+    }
+
+    for (uint32_t c = 0U; c < roi->num_chirps; c++)
+    {
+        const uint16_t *in = &frame[((roi->first_chirp + c) * chirp_stride) + (roi->first_sample * num_rx)];
+
+        for (uint32_t s = 0U; s < roi->num_samples; s++)
+        {
+            for (uint32_t rx = 0U; rx < num_rx; rx++)
+            {
+                if ((roi->rx_mask & (1UL << rx)) != 0U)
+                {
+                    frame[out++] = in[rx];
+                }
+            }
+
+            in += num_rx;
+        }
+    }
+
+    return out;
+}
@@ -0,0 +1,34 @@
+#ifndef FRAME_ROI_H
+#define FRAME_ROI_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Region of interest of a [chirp][sample][rx] frame: the antennas of
+   rx_mask (bit n = RX n), num_chirps chirps from first_chirp and num_samples
+   samples of every chirp from first_sample. */
+typedef struct
+{
+    uint32_t rx_mask;
+    uint32_t first_chirp;
+    uint32_t num_chirps;
+    uint32_t first_sample;
+    uint32_t num_samples;
+} frame_roi_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Number of antennas selected by rx_mask. */
+uint32_t frame_roi_num_rx(uint32_t rx_mask);
+
+/* Gathers the region of interest of a [chirp][sample][rx] frame in place;
+   the result keeps the [chirp][sample][rx] layout with only the selected
+   antennas. The region must lie within the frame. Returns the samples left:
+   roi->num_chirps * roi->num_samples * frame_roi_num_rx(roi->rx_mask). */
+uint32_t frame_roi_gather(uint16_t *frame, uint32_t num_chirps, uint32_t num_samples,
+                          uint32_t num_rx, const frame_roi_t *roi);
+
+#endif /* FRAME_ROI_H */
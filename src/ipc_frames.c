@@ -0,0 +1,215 @@
+#include <stddef.h>
+
+#include "ipc_frames.h"
+
+#define IPC_FRAMES_MAGIC                    (0x46524D31UL)  /* "FRM1" */
+
+/* NVIC line the CM0+ routes its IPC interrupt through. */
+#ifndef IPC_FRAMES_CM0P_NVIC_MUX
+#define IPC_FRAMES_CM0P_NVIC_MUX            (NvicMux3_IRQn)
+#endif
+
+static ipc_frames_callback_t ipc_callback = NULL;
+
+static IPC_STRUCT_Type *ipc_channel(void)
+{
+    return Cy_IPC_Drv_GetIpcBaseAddress(IPC_FRAMES_CHANNEL);
+}
+
+/* Acknowledges the notify events of one IPC interrupt structure. */
+static void clear_notify(uint32_t intr)
+{
+    IPC_INTR_STRUCT_Type *intr_base = Cy_IPC_Drv_GetIntrBaseAddr(intr);
+    uint32_t status = Cy_IPC_Drv_GetInterruptStatusMasked(intr_base);
+
+    Cy_IPC_Drv_ClearInterrupt(intr_base, CY_IPC_NO_NOTIFICATION,
+                              Cy_IPC_Drv_ExtractAcquireMask(status));
+
+    /* Read back so the clear has landed before the handler returns. */
+    (void)Cy_IPC_Drv_GetInterruptStatusMasked(intr_base);
+}
+
+static void ipc_frames_cm4_isr(void)
+{
+    clear_notify(IPC_FRAMES_INTR_CM4);
+
+    if (ipc_callback != NULL)
+    {
+        ipc_callback();
+    }
+}
+
+/* A command arrived; taking the interrupt is enough to wake the CM0+ loop. */
+static void ipc_frames_cm0p_isr(void)
+{
+    clear_notify(IPC_FRAMES_INTR_CM0P);
+}
+
+static cy_rslt_t enable_notify_interrupt(uint32_t intr, cy_israddress isr, uint8_t intr_priority)
+{
+    IRQn_Type irqn;
+    cy_stc_sysint_t cfg = {
+        .intrPriority = intr_priority
+    };
+
+#if defined(CY_IP_M4CPUSS) && (CY_CPU_CORTEX_M0P) && (CY_IP_M4CPUSS_VERSION == 2U)
+    /* The CM0+ reaches system interrupts through one of its NVIC muxes. */
+    cfg.intrSrc = (IRQn_Type)(((uint32_t)IPC_FRAMES_CM0P_NVIC_MUX << CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) |
+                              ((uint32_t)cpuss_interrupts_ipc_0_IRQn + intr));
+    irqn = IPC_FRAMES_CM0P_NVIC_MUX;
+#else
+    cfg.intrSrc = (IRQn_Type)((uint32_t)cpuss_interrupts_ipc_0_IRQn + intr);
+    irqn = cfg.intrSrc;
+#endif
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(intr),
+                                CY_IPC_NO_NOTIFICATION, 1UL << IPC_FRAMES_CHANNEL);
+
+    if (Cy_SysInt_Init(&cfg, isr) != CY_SYSINT_SUCCESS)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    NVIC_ClearPendingIRQ(irqn);
+    NVIC_EnableIRQ(irqn);
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t ipc_frames_publish(ipc_frames_shared_t *shared, uint8_t intr_priority)
+{
+    if ((shared == NULL) || (shared->ring == NULL) || (shared->slot_base == NULL) ||
+        (shared->slot_samples == 0U))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    shared->command_seq = 0U;
+    shared->done_seq = 0U;
+    shared->command = (uint32_t)IPC_FRAMES_CMD_NONE;
+    shared->status = false;
+    shared->ready = false;
+    shared->frame_index = 0U;
+    shared->magic = IPC_FRAMES_MAGIC;
+
+    cy_rslt_t result = enable_notify_interrupt(IPC_FRAMES_INTR_CM4, ipc_frames_cm4_isr, intr_priority);
+
+    /* The channel stays locked for good; its DATA register holds the block. */
+    if ((result == CY_RSLT_SUCCESS) &&
+        (Cy_IPC_Drv_LockAcquire(ipc_channel()) != CY_IPC_DRV_SUCCESS))
+    {
+        result = CY_RSLT_TYPE_ERROR;
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        __DMB();
+        Cy_IPC_Drv_WriteDataValue(ipc_channel(), (uint32_t)shared);
+        __DSB();
+        __SEV();
+    }
+
+    return result;
+}
+
+void ipc_frames_set_callback(ipc_frames_callback_t callback)
+{
+    ipc_callback = callback;
+}
+
+bool ipc_frames_wait_ready(const ipc_frames_shared_t *shared, uint32_t timeout_us)
+{
+    uint32_t start = timebase_now_us();
+
+    while (!shared->ready)
+    {
+        if ((timebase_now_us() - start) > timeout_us)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ipc_frames_command(ipc_frames_shared_t *shared, ipc_frames_cmd_t command)
+{
+    /* Numbered after the last posted command, so a reply to one that timed
+       out cannot be taken for this one. */
+    uint32_t seq = shared->command_seq + 1U;
+
+    shared->command = (uint32_t)command;
+
+    /* The arguments must be visible before the sequence number. */
+    __DMB();
+    shared->command_seq = seq;
+    __DSB();
+    Cy_IPC_Drv_AcquireNotify(ipc_channel(), 1UL << IPC_FRAMES_INTR_CM0P);
+
+    uint32_t start = timebase_now_us();
+
+    while (shared->done_seq != seq)
+    {
+        if ((timebase_now_us() - start) > IPC_FRAMES_TIMEOUT_US)
+        {
+            return false;
+        }
+    }
+
+    __DMB();
+    return shared->status;
+}
+
+ipc_frames_shared_t *ipc_frames_attach(uint8_t intr_priority)
+{
+    ipc_frames_shared_t *shared = NULL;
+
+    while (shared == NULL)
+    {
+        ipc_frames_shared_t *candidate = (ipc_frames_shared_t *)Cy_IPC_Drv_ReadDataValue(ipc_channel());
+
+        if ((candidate != NULL) && (candidate->magic == IPC_FRAMES_MAGIC))
+        {
+            shared = candidate;
+        }
+        else
+        {
+            /* ipc_frames_publish() ends with an event. */
+            __WFE();
+        }
+    }
+
+    __DMB();
+
+    if (enable_notify_interrupt(IPC_FRAMES_INTR_CM0P, ipc_frames_cm0p_isr, intr_priority) != CY_RSLT_SUCCESS)
+    {
+        return NULL;
+    }
+
+    return shared;
+}
+
+ipc_frames_cmd_t ipc_frames_take_command(const ipc_frames_shared_t *shared)
+{
+    if (shared->command_seq == shared->done_seq)
+    {
+        return IPC_FRAMES_CMD_NONE;
+    }
+
+    /* Sequence number first, then the arguments it publishes. */
+    __DMB();
+    return (ipc_frames_cmd_t)shared->command;
+}
+
+void ipc_frames_complete_command(ipc_frames_shared_t *shared, bool status)
+{
+    shared->status = status;
+    __DMB();
+    shared->done_seq = shared->command_seq;
+    ipc_frames_notify();
+}
+
+void ipc_frames_notify(void)
+{
+    __DSB();
+    Cy_IPC_Drv_AcquireNotify(ipc_channel(), 1UL << IPC_FRAMES_INTR_CM4);
+}
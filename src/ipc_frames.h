@@ -0,0 +1,116 @@
+#ifndef IPC_FRAMES_H
+#define IPC_FRAMES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+#include "fifo_dma.h"
+#include "frame_ring.h"
+#include "spi_calib.h"
+#include "timebase.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* IPC channel whose DATA register hands the shared block from the CM4 to the
+   CM0+, and whose notify events carry the signals below. */
+#ifndef IPC_FRAMES_CHANNEL
+#define IPC_FRAMES_CHANNEL                  (CY_IPC_CHAN_USER)
+#endif
+
+/* IPC interrupt structures: frames and command completions for the CM4,
+   new commands for the CM0+. */
+#ifndef IPC_FRAMES_INTR_CM4
+#define IPC_FRAMES_INTR_CM4                 (CY_IPC_INTR_USER)
+#endif
+#ifndef IPC_FRAMES_INTR_CM0P
+#define IPC_FRAMES_INTR_CM0P                (CY_IPC_INTR_USER + 1U)
+#endif
+
+/* Longest register list a profile command carries. */
+#define IPC_FRAMES_MAX_REGS                 (64U)
+
+/* Default time the CM4 waits for the CM0+ to bring up the sensor or to
+   execute a command. */
+#define IPC_FRAMES_TIMEOUT_US               (500000UL)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef enum
+{
+    IPC_FRAMES_CMD_NONE = 0,
+    IPC_FRAMES_CMD_START,       /* reset the readout statistics and start the sensor */
+    IPC_FRAMES_CMD_STOP,        /* stop the sensor once no readout is in flight */
+    IPC_FRAMES_CMD_PROFILE      /* load regs into the idle sensor, new frame size */
+} ipc_frames_cmd_t;
+
+/* Everything both cores touch. The CM4 owns the memory, together with the
+   ring and the sample slots it points to, and hands the block to the CM0+
+   with ipc_frames_publish(). Both cores see the same SRAM and the PSoC 6 has
+   no data cache, so plain stores plus barriers keep it coherent. */
+typedef struct
+{
+    uint32_t magic;
+
+    /* Set by the CM4 before publishing, read-only afterwards. */
+    frame_ring_t *ring;
+    uint16_t *slot_base;
+    uint32_t slot_samples;
+    timebase_source_t timebase;
+
+    /* Command mailbox. The CM4 fills in the arguments and then bumps
+       command_seq; the CM0+ executes the command, sets status and copies
+       command_seq to done_seq. */
+    volatile uint32_t command_seq;
+    volatile uint32_t done_seq;
+    volatile uint32_t command;          /* ipc_frames_cmd_t */
+    volatile bool status;
+    uint32_t frame_limit;               /* START: frames to read out, 0 for no limit */
+    uint32_t samples_per_frame;         /* PROFILE */
+    uint32_t slice_samples;             /* PROFILE: 0 without FIFO_SLICE_CHIRPS */
+    uint32_t num_regs;                  /* PROFILE */
+    uint32_t regs[IPC_FRAMES_MAX_REGS]; /* PROFILE */
+
+    /* Written by the CM0+. */
+    volatile bool ready;                /* sensor and readout are up */
+    volatile bool spi_calibrated;       /* spi_clock was found by SPI_CLOCK_CALIBRATION */
+    volatile spi_calib_result_t spi_clock;
+    volatile uint32_t frame_index;      /* sensor frames seen since START */
+    volatile fifo_dma_stats_t stats;    /* refreshed after every readout */
+} ipc_frames_shared_t;
+
+/* Called from the CM4 IPC interrupt whenever the CM0+ signals. */
+typedef void (*ipc_frames_callback_t)(void);
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* CM4: hands shared to the CM0+ and enables the IPC interrupt that invokes
+   the callback. ring, slot_base, slot_samples and timebase must be set. */
+cy_rslt_t ipc_frames_publish(ipc_frames_shared_t *shared, uint8_t intr_priority);
+void ipc_frames_set_callback(ipc_frames_callback_t callback);
+
+/* CM4: waits until the CM0+ has initialized the sensor. */
+bool ipc_frames_wait_ready(const ipc_frames_shared_t *shared, uint32_t timeout_us);
+
+/* CM4: posts a command with its arguments already stored in shared and
+   waits for the CM0+ to execute it. Returns the command status, false on
+   timeout. Not reentrant; callers serialize sensor control anyway. */
+bool ipc_frames_command(ipc_frames_shared_t *shared, ipc_frames_cmd_t command);
+
+/* CM0+: waits for the CM4 to publish the shared block and enables the IPC
+   interrupt that wakes the CM0+ for new commands. */
+ipc_frames_shared_t *ipc_frames_attach(uint8_t intr_priority);
+
+/* CM0+: returns the pending command, IPC_FRAMES_CMD_NONE if there is none. */
+ipc_frames_cmd_t ipc_frames_take_command(const ipc_frames_shared_t *shared);
+void ipc_frames_complete_command(ipc_frames_shared_t *shared, bool status);
+
+/* CM0+: raises the CM4 interrupt, e.g. after a frame was published. Safe to
+   call from interrupt context. */
+void ipc_frames_notify(void);
+
+#endif /* IPC_FRAMES_H */
@@ -0,0 +1,102 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "link_test.h"
+#include "timebase.h"
+
+static cyhal_timer_t link_timer;
+static bool link_timer_ready = false;
+static volatile uint32_t link_due = 0U;
+static link_test_callback_t link_callback = NULL;
+
+static void link_timer_event(void *arg, cyhal_timer_event_t event)
+{
+    CY_UNUSED_PARAMETER(arg);
+    CY_UNUSED_PARAMETER(event);
+
+    link_due++;
+
+    if (link_callback != NULL)
+    {
+        link_callback();
+    }
+}
+
+cy_rslt_t link_test_start(uint32_t rate_hz, uint8_t priority, link_test_callback_t callback)
+{
+    if ((rate_hz < LINK_TEST_MIN_RATE_HZ) || (rate_hz > LINK_TEST_MAX_RATE_HZ))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    const cyhal_timer_cfg_t cfg = {
+        .is_continuous = true,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .period = (TIMEBASE_FREQUENCY_HZ / rate_hz) - 1U,
+        .compare_value = 0U,
+        .value = 0U
+    };
+
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!link_timer_ready)
+    {
+        result = cyhal_timer_init(&link_timer, NC, NULL);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = cyhal_timer_set_frequency(&link_timer, TIMEBASE_FREQUENCY_HZ);
+        }
+
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        cyhal_timer_register_callback(&link_timer, link_timer_event, NULL);
+        link_timer_ready = true;
+    }
+
+    result = cyhal_timer_configure(&link_timer, &cfg);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        link_due = 0U;
+        link_callback = callback;
+        cyhal_timer_enable_event(&link_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT, priority, true);
+        result = cyhal_timer_start(&link_timer);
+    }
+
+    return result;
+}
+
+void link_test_stop(void)
+{
+    if (link_timer_ready)
+    {
+        cyhal_timer_enable_event(&link_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT, 0U, false);
+        (void)cyhal_timer_stop(&link_timer);
+    }
+}
+
+uint32_t link_test_due(void)
+{
+    return link_due;
+}
+
+void link_test_fill(uint16_t *frame, uint32_t num_samples, uint32_t frame_index)
+{
+    uint32_t state = (frame_index ^ LINK_TEST_SEED) & 0xFFFFU;
+
+    if (state == 0U)
+    {
+        state = LINK_TEST_SEED;
+    }
+
+    for (uint32_t i = 0U; i < num_samples; i++)
+    {
+        state = (state >> 1) ^ ((0U - (state & 1U)) & LINK_TEST_LFSR_TAPS);
+        frame[i] = (uint16_t)((state + i) & LINK_TEST_SAMPLE_MASK);
+    }
+}
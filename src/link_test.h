@@ -0,0 +1,45 @@
+#ifndef LINK_TEST_H
+#define LINK_TEST_H
+
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame rates accepted by 'start test RATE'. */
+#define LINK_TEST_MIN_RATE_HZ               (1U)
+#define LINK_TEST_MAX_RATE_HZ               (10000U)
+
+/* Galois LFSR x^16 + x^14 + x^13 + x^11 + 1 (period 65535) behind the
+   pattern, seeded with frame_index ^ LINK_TEST_SEED. */
+#define LINK_TEST_LFSR_TAPS                 (0xB400U)
+#define LINK_TEST_SEED                      (0xACE1U)
+#define LINK_TEST_SAMPLE_MASK               (0x0FFFU)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Called from the timer interrupt each time a frame falls due. */
+typedef void (*link_test_callback_t)(void);
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Starts a periodic timer that makes a synthetic frame due rate_hz times a
+   second; link_test_due() counts them from zero. The timer is a TCPWM
+   counter and halts in deep sleep. */
+cy_rslt_t link_test_start(uint32_t rate_hz, uint8_t priority, link_test_callback_t callback);
+void link_test_stop(void);
+
+/* Frames due since link_test_start(). */
+uint32_t link_test_due(void);
+
+/* Fills a frame with the test pattern of frame_index: sample i is
+   (lfsr_i + i) & LINK_TEST_SAMPLE_MASK, lfsr_i the LFSR state after i + 1
+   steps from the frame's seed (LINK_TEST_SEED if the seed is zero). Values
+   stay within 12 bits so every sample format carries them unchanged. */
+void link_test_fill(uint16_t *frame, uint32_t num_samples, uint32_t frame_index);
+
+#endif /* LINK_TEST_H */
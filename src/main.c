@@ -2,6 +2,7 @@
 #include <limits.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "cyhal.h"
@@ -10,6 +11,34 @@
 #include "cy_retarget_io.h"
 #include "xensiv_bgt60trxx_mtb.h"
 
+#if defined(COMPONENT_FREERTOS)
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+#endif
+
+#include "ble_events.h"
+#include "chirp_average.h"
+#include "control.h"
+#include "cycle_stats.h"
+#include "fifo_dma.h"
+#include "flash_log.h"
+#include "frame_history.h"
+#include "frame_ring.h"
+#include "frame_roi.h"
+#include "ipc_frames.h"
+#include "link_test.h"
+#include "motion_trigger.h"
+#include "packed12.h"
+#include "presence.h"
+#include "range_fft.h"
+#include "rice_codec.h"
+#include "spi_calib.h"
+#include "timebase.h"
+#include "uart_baud.h"
+#include "uart_tx.h"
+
 #define XENSIV_BGT60TRXX_CONF_IMPL
 #include "presence_radar_settings.h"
 
@@ -31,41 +60,523 @@
 
 #define XENSIV_BGT60TRXX_SPI_FREQUENCY      (25000000UL)
 
+/* Baud rate of the KitProg3 USB-UART bridge that carries both the CLI and the
+   frame stream after reset. The native USB block of the PSoC 6 is not routed
+   to a connector on CYSBSYSKIT-DEV-01, so raising the rate is how the stream
+   gets faster: at build time here, or at run time with 'baud' (see
+   uart_baud.h, serial_logger.py --negotiate-baud). */
+#ifndef STREAM_UART_BAUDRATE
+#define STREAM_UART_BAUDRATE                CY_RETARGET_IO_BAUDRATE
+#endif
+
+/* 1: the sensor interrupt starts a DMA burst that lands the FIFO in the frame
+   ring; 0: the main loop reads the FIFO with xensiv_bgt60trxx_get_fifo_data(). */
+#ifndef FIFO_READOUT_DMA
+#define FIFO_READOUT_DMA                    (1)
+#endif
+
+/* 1: the CM0+ owns the sensor, its interrupt and the DMA readout
+   (src/COMPONENT_CM0P) and signals finished frames over IPC; the CM4 only
+   processes and transmits them. Needs the dual-core build, see the
+   Makefile. */
+#ifndef DUAL_CORE_ACQUISITION
+#define DUAL_CORE_ACQUISITION               (0)
+#endif
+
+#if DUAL_CORE_ACQUISITION && !FIFO_READOUT_DMA
+#error "DUAL_CORE_ACQUISITION requires FIFO_READOUT_DMA"
+#endif
+
+/* FIFO_SLICE_CHIRPS (fifo_dma.h) reads frames in slices of chirps. */
+#if FIFO_SLICE_CHIRPS && !FIFO_READOUT_DMA
+#error "FIFO_SLICE_CHIRPS requires FIFO_READOUT_DMA"
+#endif
+
+#if FIFO_SLICE_CHIRPS && ((XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME % FIFO_SLICE_CHIRPS) != 0)
+#error "FIFO_SLICE_CHIRPS must divide the chirps per frame of the built-in profile"
+#endif
+
 #define NUM_SAMPLES_PER_FRAME               (XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *\
                                              XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME *\
                                              XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP)
 
-#define BINARY_FRAME_HEADER_VERSION         (1U)
+#define BINARY_FRAME_HEADER_VERSION         (4U)
 #define BINARY_FRAME_SAMPLE_SIZE_BYTES      ((uint16_t)sizeof(uint16_t))
 
+/* Capacity of every frame ring slot. A runtime register profile ('profile')
+   may use any frame geometry up to this many samples; raise it from the
+   Makefile to preallocate room for longer frames. */
+#ifndef FRAME_POOL_SAMPLES
+#define FRAME_POOL_SAMPLES                  NUM_SAMPLES_PER_FRAME
+#endif
+
+#if (FRAME_POOL_SAMPLES < NUM_SAMPLES_PER_FRAME)
+#error "FRAME_POOL_SAMPLES must hold the built-in radar profile"
+#endif
+
+/* Responses to binary requests that may wait for the link at once; hosts
+   keep at most this many requests outstanding. */
+#define CONTROL_RESPONSE_SLOTS              (4U)
+#define CONTROL_RESPONSE_MAX_DATA           (32U)
+
+/* Longest register list 'profile reg' can stage. */
+#define RADAR_PROFILE_MAX_REGS              (64U)
+#define RADAR_PROFILE_MAX_RX                (3U)
+#define RADAR_PROFILE_MIN_SAMPLES           (8U)
+
+/* A range profile frame carries the positive half of every chirp's FFT. */
+#define MAX_RANGE_BINS_PER_FRAME            (FRAME_POOL_SAMPLES / 2U)
+
+/* Payload encodings (binary_frame_header_t.sample_format) */
+#define BINARY_FRAME_FORMAT_U16LE           (0U)    /* one little-endian uint16_t per sample */
+#define BINARY_FRAME_FORMAT_PACKED12        (1U)    /* two samples per three bytes, see packed12.h */
+#define BINARY_FRAME_FORMAT_RANGE_CINT16    (2U)    /* positive range bins as int16 re, im, see range_fft.h */
+#define BINARY_FRAME_FORMAT_RANGE_MAG_U16   (3U)    /* positive range bins as uint16 magnitude */
+#define BINARY_FRAME_FORMAT_PRESENCE        (4U)    /* one presence_event_t per frame */
+#define BINARY_FRAME_FORMAT_CONTROL         (5U)    /* control_response_t answering a binary request, see control.h */
+
+/* binary_frame_header_t.flags */
+#define BINARY_FRAME_FLAG_DELTA_RICE        (1U << 0)   /* payload is rice_codec.h bitstream of U16LE samples */
+#define BINARY_FRAME_FLAG_FIFO_OVERFLOW     (1U << 1)   /* frames were lost in the sensor FIFO right before this one */
+#define BINARY_FRAME_FLAG_TRIGGER           (1U << 2)   /* the motion trigger of a pre-trigger session fired on this frame */
+/* Bits 8-11: log2 of the chirps averaged into one, bits 12-15: log2 of the
+   fast-time decimation (see chirp_average.h). Same layout as
+   control_start_t.reduction. */
+#define BINARY_FRAME_FLAG_REDUCTION_POS     (8U)
+#define REDUCTION_CHIRP_SHIFT_POS           (0U)
+#define REDUCTION_SAMPLE_SHIFT_POS          (4U)
+#define REDUCTION_SHIFT_MSK                 (0x0FU)
+
+/* CRC-32 (IEEE 802.3, as zlib.crc32) over the payload, computed by the
+   hardware CRC block. */
+#define PAYLOAD_CRC_POLYNOMIAL              (0x04C11DB7UL)
+#define PAYLOAD_CRC_INIT                    (0xFFFFFFFFUL)
+#define PAYLOAD_CRC_XOR_OUT                 (0xFFFFFFFFUL)
+
+#ifndef BINARY_FRAME_DEFAULT_FORMAT
+#define BINARY_FRAME_DEFAULT_FORMAT         BINARY_FRAME_FORMAT_U16LE
+#endif
+
+/* On-device presence detection ('start presence'); override from the
+   Makefile, e.g. DEFINES+=PRESENCE_THRESHOLD=4.0f */
+#ifndef PRESENCE_MIN_RANGE_M
+#define PRESENCE_MIN_RANGE_M                (0.3f)
+#endif
+#ifndef PRESENCE_MAX_RANGE_M
+#define PRESENCE_MAX_RANGE_M                (5.0f)
+#endif
+#ifndef PRESENCE_THRESHOLD
+#define PRESENCE_THRESHOLD                  (2.0f)  /* MTI peak in ADC counts */
+#endif
+#ifndef PRESENCE_MTI_ALPHA
+#define PRESENCE_MTI_ALPHA                  (0.2f)
+#endif
+#ifndef PRESENCE_HOLD_FRAMES
+#define PRESENCE_HOLD_FRAMES                (10U)
+#endif
+
+/* c / (2 * chirp bandwidth) of the built-in profile; runtime profiles are
+   expected to keep the chirp bandwidth. */
+#define RANGE_BIN_M                         ((float)(299792458.0 / (2.0 * (double)(XENSIV_BGT60TRXX_CONF_END_FREQ_HZ -\
+                                                                                   XENSIV_BGT60TRXX_CONF_START_FREQ_HZ))))
+
+/* What the main loop does while it waits for the next event. */
+#define LOW_POWER_MODE_NONE                 (0)     /* poll with IDLE_WAIT_US delays */
+#define LOW_POWER_MODE_SLEEP                (1)     /* CPU sleep until any interrupt */
+#define LOW_POWER_MODE_DEEPSLEEP            (2)     /* deep sleep while only the next sensor frame is due */
+
+#ifndef LOW_POWER_MODE
+#define LOW_POWER_MODE                      LOW_POWER_MODE_SLEEP
+#endif
+
+/* Poll interval of LOW_POWER_MODE_NONE. */
+#define IDLE_WAIT_US                        (100U)
+
+/* Per-stage timing behind 'stats' and 'timing'. Costs a few cycles per
+   stage; DEFINES+=STAGE_TIMING=0 compiles it out. */
+#ifndef STAGE_TIMING
+#define STAGE_TIMING                        (1)
+#endif
+
+/* 'record' command: captures go to a ring of records in the QSPI flash
+   instead of the UART and are offloaded later with 'record dump'. Takes the
+   QSPI block and its pins. */
+#ifndef FLASH_RECORDING
+#define FLASH_RECORDING                     (0)
+#endif
+
+/* 'trigger' command: captures keep their frames in an SRAM history instead of
+   sending them and upload only a burst around the first frame that shows
+   motion. Costs FRAME_HISTORY_SLOTS full frames of RAM. */
+#ifndef PRETRIGGER_CAPTURE
+#define PRETRIGGER_CAPTURE                  (0)
+#endif
+
+/* Motion energy, relative to the background, that fires the trigger. */
+#ifndef PRETRIGGER_DEFAULT_RATIO
+#define PRETRIGGER_DEFAULT_RATIO            (8U)
+#endif
+
+#if defined(COMPONENT_FREERTOS)
+/* Task layout of the FreeRTOS build (COMPONENTS+=FREERTOS). Readout must never
+   wait behind processing, and the link is kept busy ahead of the next
+   encode. */
+#define ACQUIRE_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+#define TRANSMIT_TASK_PRIORITY              (configMAX_PRIORITIES - 2)
+#define PROCESS_TASK_PRIORITY               (configMAX_PRIORITIES - 3)
+#define CLI_TASK_PRIORITY                   (tskIDLE_PRIORITY + 1)
+
+#define ACQUIRE_TASK_STACK_WORDS            (512U)
+#define PROCESS_TASK_STACK_WORDS            (1024U)
+#define TRANSMIT_TASK_STACK_WORDS           (512U)
+#define CLI_TASK_STACK_WORDS                (1024U)
+
+#define MAX_TASKS_REPORTED                  (8U)
+
+/* Every slot may be encoded while an earlier one is still on the wire. */
+#define CODEC_BUFFER_SLOTS                  (FRAME_RING_NUM_SLOTS)
+#else
+#define CODEC_BUFFER_SLOTS                  (1U)
+#endif
+
+/* The first 16 bytes match the version 1 header so hosts can read them
+   before deciding how much more to read. Version 2 added the payload
+   description, version 3 the timestamp and the payload CRC, version 4 the
+   region of interest. */
 typedef struct __attribute__((packed))
 {
     uint8_t magic[4];
     uint16_t version;
-    uint16_t sample_size_bytes;
+    uint16_t sample_size_bytes;     /* size of one decoded sample */
     uint32_t frame_index;
     uint32_t sample_count;
+    uint16_t sample_format;
+    uint16_t flags;                 /* BINARY_FRAME_FLAG_* */
+    uint32_t payload_size;          /* bytes following the header */
+    uint32_t timestamp_us;          /* sensor frame interrupt, timebase_now_us() (wraps) */
+    uint32_t payload_crc32;         /* see PAYLOAD_CRC_* */
+    uint16_t roi_rx_mask;           /* antennas in the frame, bit n = RX n; 0 if no sensor frame */
+    uint16_t roi_first_chirp;       /* part of the sensor frame in the payload, */
+    uint16_t roi_num_chirps;        /* before averaging and decimation */
+    uint16_t roi_first_sample;
+    uint16_t roi_num_samples;
 } binary_frame_header_t;
 
+/* Payload of a BINARY_FRAME_FORMAT_PRESENCE frame. */
+typedef struct __attribute__((packed))
+{
+    uint8_t present;
+    uint8_t changed;                /* present toggled with this frame */
+    uint16_t range_bin;             /* strongest moving target */
+    uint16_t distance_mm;
+    uint16_t level;                 /* its MTI magnitude, ADC counts with RANGE_FFT_FRAC_BITS */
+} presence_event_t;
+
+typedef struct
+{
+    uint32_t frames;
+    uint16_t format;
+    bool compress;
+    uint32_t chirp_shift;           /* average 2^chirp_shift chirps into one */
+    uint32_t sample_shift;          /* decimate fast time by 2^sample_shift */
+    frame_roi_t roi;                /* part of the frame to send; zero counts and mask mean all */
+    uint32_t test_rate_hz;          /* link test frames per second instead of the sensor; 0 for the sensor */
+} start_options_t;
+
+/* Start options that take the next token as their value. */
+typedef enum
+{
+    START_VALUE_NONE,
+    START_VALUE_AVG,
+    START_VALUE_DECIM,
+    START_VALUE_RX,
+    START_VALUE_CHIRPS,
+    START_VALUE_SAMPLES,
+    START_VALUE_TEST
+} start_value_t;
+
+/* Payload of a BINARY_FRAME_FORMAT_CONTROL frame. */
+typedef struct __attribute__((packed))
+{
+    control_response_header_t response;
+    uint8_t data[CONTROL_RESPONSE_MAX_DATA];
+} control_response_t;
+
+/* Response data of CONTROL_OP_GET_STATUS. */
+typedef struct __attribute__((packed))
+{
+    uint8_t capture_enabled;
+    uint8_t stream_active;
+    uint16_t sample_format;         /* of the current or last session */
+    uint32_t frames_captured;       /* sensor frames since the session started */
+    uint32_t frames_sent;           /* frames taken out of the ring */
+    uint32_t frames_dropped;
+    uint16_t samples_per_chirp;
+    uint16_t num_chirps;
+    uint8_t num_rx;
+    uint8_t custom_profile;
+    uint16_t staged_regs;           /* register words staged for 'profile apply' */
+} control_status_data_t;
+
+/* Stages measured with STAGE_TIMING. */
+typedef enum
+{
+    STAGE_READOUT,                  /* blocking FIFO readout, or the sensor interrupt that starts the DMA */
+    STAGE_REDUCE,                   /* region of interest, chirp averaging / decimation */
+    STAGE_ENCODE,                   /* encode_payload(), reduction included */
+    STAGE_CRC,                      /* payload CRC of a frame */
+    STAGE_TRANSMIT,                 /* header + payload on the wire (wall clock) */
+    STAGE_CLI,                      /* a process_cli() call that received bytes */
+    STAGE_COUNT
+} stage_t;
+
+/* Frame shape produced by the sensor's register profile. */
+typedef struct
+{
+    uint32_t num_samples_per_chirp;
+    uint32_t num_chirps;
+    uint32_t num_rx;
+} frame_geometry_t;
+
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
+#if !DUAL_CORE_ACQUISITION
 static cyhal_spi_t cyhal_spi;
 static xensiv_bgt60trxx_mtb_t sensor;
+#endif
+
+/* Sensor SPI clock and output drive in use (SPI_CLOCK_CALIBRATION); found by
+   the CM0+ in the dual-core build. */
+static spi_calib_result_t spi_clock = {
+    .frequency_hz = XENSIV_BGT60TRXX_SPI_FREQUENCY,
+    .drive_sel = CY_GPIO_DRIVE_1_8
+};
+static bool spi_clock_calibrated = false;
 static volatile bool data_available = false;
-static bool capture_enabled = false;
-static bool frame_limit_enabled = false;
-static uint32_t frame_limit_total = 0U;
+static volatile uint32_t data_timestamp_us = 0U;
+static volatile bool capture_enabled = false;
+static volatile bool frame_limit_enabled = false;
+static volatile uint32_t frame_limit_total = 0U;
 static uint32_t frame_limit_sent = 0U;
 static bool binary_stream_active = false;
+static volatile uint32_t capture_frame_index = 0U;
+/* The session sends link test frames (link_test.h) and leaves the sensor
+   idle. */
+static bool stream_test = false;
+static uint32_t stream_test_rate_hz = 0U;
+#if FLASH_RECORDING
+/* 'record on' takes effect with the next capture, which then sets
+   stream_to_flash for its whole session. */
+static bool record_enabled = false;
+static bool stream_to_flash = false;
+#endif
+#if PRETRIGGER_CAPTURE
+typedef enum
+{
+    PRETRIGGER_ARMED,               /* frames go into the history, nothing is sent */
+    PRETRIGGER_BURST,               /* the trigger fired; post-trigger frames are still stored */
+    PRETRIGGER_DRAIN                /* the burst is complete; new frames are dropped until it is sent */
+} pretrigger_state_t;
+
+/* 'trigger on' takes effect with the next capture, which then sets
+   stream_pretrigger for its whole session. */
+static bool pretrigger_enabled = false;
+static uint32_t pretrigger_pre = FRAME_HISTORY_SLOTS;
+static uint32_t pretrigger_post = 0U;
+static uint32_t pretrigger_ratio = PRETRIGGER_DEFAULT_RATIO;
+static bool stream_pretrigger = false;
+static pretrigger_state_t pretrigger_state = PRETRIGGER_ARMED;
+static uint32_t pretrigger_post_left = 0U;
+static bool pretrigger_loss_pending = false;    /* a post-trigger frame did not fit the history */
+static uint32_t pretrigger_bursts = 0U;
+static uint32_t pretrigger_uploaded = 0U;
+static uint32_t pretrigger_lost = 0U;
+
+/* Encoded frames of the session, oldest first. A slot holds the largest
+   payload any format produces for a full frame. */
+static frame_history_t history;
+static uint8_t history_storage[FRAME_HISTORY_SLOTS]
+                              [sizeof(binary_frame_header_t) + (FRAME_POOL_SAMPLES * sizeof(uint16_t))];
+/* First chirp of a DMA frame, unpacked for the trigger. */
+static uint16_t trigger_chirp[MOTION_TRIGGER_MAX_VALUES];
+#endif
+
+/* Frame buffers filled by acquisition and drained by transmission. */
+static frame_ring_t frame_ring;
+static uint16_t samples[FRAME_RING_NUM_SLOTS][FRAME_POOL_SAMPLES];
 
-/* Allocate enough memory for the radar dara frame. */
-static uint16_t samples[NUM_SAMPLES_PER_FRAME];
+#if DUAL_CORE_ACQUISITION
+/* Ring, slots and sensor commands as seen by the CM0+. */
+static ipc_frames_shared_t ipc_shared;
+#endif
+
+static const frame_geometry_t default_geometry = {
+    .num_samples_per_chirp = XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP,
+    .num_chirps = XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME,
+    .num_rx = XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS
+};
+
+/* Geometry of the register profile the sensor runs now. */
+static frame_geometry_t geometry = {
+    .num_samples_per_chirp = XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP,
+    .num_chirps = XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME,
+    .num_rx = XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS
+};
+static uint32_t samples_per_frame = NUM_SAMPLES_PER_FRAME;
+static bool custom_profile_active = false;
+
+/* Rate of the CLI/stream UART; STREAM_UART_BAUDRATE until 'baud' negotiates
+   another one. */
+static uint32_t stream_baud = STREAM_UART_BAUDRATE;
+
+/* Register list collected by 'profile reg' for the next 'profile apply'. */
+static uint32_t profile_regs[RADAR_PROFILE_MAX_REGS];
+static uint32_t profile_num_regs = 0U;
+
+/* Binary control channel. control_active is set by a binary request and
+   cleared by the next text command; while set, text replies are suppressed
+   so they cannot be mistaken for the binary stream. */
+static control_parser_t control_parser;
+static bool control_active = false;
+static binary_frame_header_t control_header[CONTROL_RESPONSE_SLOTS];
+static control_response_t control_response[CONTROL_RESPONSE_SLOTS];
+static volatile uint32_t control_head = 0U;
+static volatile uint32_t control_tail = 0U;
+#if !defined(COMPONENT_FREERTOS)
+/* The frame on the wire is a control response rather than ring slot tx_slot. */
+static bool tx_control = false;
+#if PRETRIGGER_CAPTURE
+/* The record on the wire comes from the pre-trigger history. */
+static bool tx_history = false;
+#endif
+#endif
+
+/* Frame currently being streamed out (slot -1 if idle) and which part of it
+   the UART DMA is working on. */
+typedef enum
+{
+    TX_PHASE_IDLE,
+    TX_PHASE_HEADER,
+    TX_PHASE_PAYLOAD
+} tx_phase_t;
+
+static binary_frame_header_t tx_header;
+static int32_t tx_slot = -1;
+static tx_phase_t tx_phase = TX_PHASE_IDLE;
+static const uint8_t *tx_payload = NULL;
+static uint32_t tx_payload_size = 0U;
+static uint16_t stream_format = BINARY_FRAME_DEFAULT_FORMAT;
+static bool stream_compress = false;
+static uint32_t stream_chirp_shift = 0U;
+static uint32_t stream_sample_shift = 0U;
+static frame_roi_t stream_roi;
+static bool stream_roi_active = false;  /* stream_roi is less than the whole frame */
+
+/* Output of the lossless codec or the range FFT; a frame that does not
+   shrink under the codec is sent as is. */
+static uint8_t tx_codec_buffer[CODEC_BUFFER_SLOTS][MAX_RANGE_BINS_PER_FRAME * RANGE_FFT_COMPLEX_BYTES];
+static uint32_t range_fft_last_us = 0U;
+static cyhal_crc_t payload_crc;
+#if defined(COMPONENT_FREERTOS)
+static SemaphoreHandle_t crc_mutex = NULL;
+#endif
+static const crc_algorithm_t payload_crc_algorithm = {
+    .width = 32U,
+    .polynomial = PAYLOAD_CRC_POLYNOMIAL,
+    .lfsrInitState = PAYLOAD_CRC_INIT,
+    .dataReverse = 1U,
+    .dataXor = 0U,
+    .remReverse = 1U,
+    .remXor = PAYLOAD_CRC_XOR_OUT
+};
+static float range_profile[RANGE_FFT_MAX_SIZE / 2U];
+
+static const presence_config_t presence_config = {
+    .mti_alpha = PRESENCE_MTI_ALPHA,
+    .threshold = PRESENCE_THRESHOLD,
+    .min_bin = (uint32_t)((PRESENCE_MIN_RANGE_M / RANGE_BIN_M) + 0.5f),
+    .max_bin = (uint32_t)((PRESENCE_MAX_RANGE_M / RANGE_BIN_M) + 0.5f),
+    .hold_frames = PRESENCE_HOLD_FRAMES
+};
+
+#if STAGE_TIMING
+static cycle_stats_t stage_stats[STAGE_COUNT];
+/* STAGE_TRANSMIT spans CPU sleep, so it is timed in microseconds; all other
+   stages in CPU cycles. */
+static const char *const stage_names[STAGE_COUNT] = {
+    "readout", "reduce", "encode", "crc", "transmit", "cli"
+};
+#endif
+#if !defined(COMPONENT_FREERTOS)
+static uint32_t tx_start_us = 0U;
+#endif
+
+/* Session accounting for the 'stats' command, in wall-clock time. */
+static uint64_t session_start_us = 0U;
+static uint64_t session_idle_us = 0U;
+static uint64_t session_deepsleep_us = 0U;
+static uint64_t session_elapsed_us = 0U;
 
 static bool parse_frame_count_argument(const char *arg, uint32_t *out_value);
+static bool parse_start_arguments(const char *arg, start_options_t *options);
+static bool parse_u32_list(const char *arg, uint32_t *values, uint32_t max_values, uint32_t *count);
+static bool profile_geometry_valid(const frame_geometry_t *new_geometry);
+static bool apply_profile(const uint32_t *regs, uint32_t num_regs, const frame_geometry_t *new_geometry);
+static bool restore_default_profile(void);
+static void handle_profile_command(const char *arg);
+static void handle_baud_command(const char *arg);
+#if FLASH_RECORDING
+static void handle_record_command(const char *arg);
+#endif
+static bool parse_window_argument(const char *arg, uint32_t *first, uint32_t *count);
+static void resolve_roi(const start_options_t *options, frame_roi_t *roi);
+static bool start_options_valid(const start_options_t *options);
+static bool factor_to_shift(uint32_t factor, uint32_t *shift);
+static uint8_t start_capture(const start_options_t *options);
+static uint8_t stop_capture(void);
 static void handle_command(const char *cmd);
+static bool control_response_space(void);
+static void queue_response(const control_request_header_t *request, uint8_t status,
+                           const void *data, uint32_t length);
+static void handle_request(const control_request_header_t *request, const uint8_t *payload);
 static void process_cli(void);
-static void send_frame_binary(uint32_t frame_idx);
+#if !FIFO_READOUT_DMA
+static bool acquire_frame(uint32_t frame_idx, uint32_t timestamp_us);
+#endif
+static bool link_test_service(void);
+#if DUAL_CORE_ACQUISITION
+static void acquisition_event(void);
+#endif
+static bool stop_sensor(void);
+static const uint8_t *encode_payload(int32_t slot, binary_frame_header_t *header);
+static const uint8_t *build_frame(int32_t slot, binary_frame_header_t *header);
+#if PRETRIGGER_CAPTURE
+static bool pretrigger_check(int32_t slot);
+static void pretrigger_store(binary_frame_header_t *header, const uint8_t *payload);
+static const uint8_t *pretrigger_next(uint32_t *length);
+static void pretrigger_sent(void);
+static void handle_trigger_command(const char *arg);
+#if !defined(COMPONENT_FREERTOS)
+static bool pretrigger_service(void);
+#endif
+#endif
+static uint32_t compute_crc32(const uint8_t *data, uint32_t length);
+static void abort_stream(const char *reason);
+#if defined(COMPONENT_FREERTOS)
+static void start_tasks(void);
+static void drain_pipeline(void);
+static void print_task_stats(void);
+#else
+static bool transmit_service(void);
+static bool wakeup_pending(void);
+static void wait_for_event(bool allow_deepsleep);
+#endif
+static void print_stats(void);
+static uint32_t stage_begin(void);
+static void stage_end(stage_t stage, uint32_t start);
+static void stage_record(stage_t stage, uint32_t value);
+static void print_stage_timing(bool histogram);
 static void status_printf(const char *fmt, ...);
 
 static void status_printf(const char *fmt, ...)
@@ -75,7 +586,12 @@ static void status_printf(const char *fmt, ...)
         return;
     }
 
-    if (binary_stream_active)
+#if FLASH_RECORDING
+    /* While recording, the console stays usable. */
+    if ((binary_stream_active && !stream_to_flash) || control_active)
+#else
+    if (binary_stream_active || control_active)
+#endif
     {
         return;
     }
@@ -87,198 +603,2577 @@ static void status_printf(const char *fmt, ...)
     fflush(stdout);
 }
 
-static void send_frame_binary(uint32_t frame_idx)
+/* Halts frame generation. capture_enabled is cleared first so the interrupt
+   does not start another readout while the SPI bus is needed. */
+static bool stop_sensor(void)
 {
-    const binary_frame_header_t header = {
-        .magic = {'R', 'A', 'D', 'R'},
-        .version = BINARY_FRAME_HEADER_VERSION,
-        .sample_size_bytes = BINARY_FRAME_SAMPLE_SIZE_BYTES,
-        .frame_index = frame_idx,
-        .sample_count = NUM_SAMPLES_PER_FRAME
-    };
+    bool was_enabled = capture_enabled;
+
+    capture_enabled = false;
 
-    if (fwrite(&header, sizeof(header), 1U, stdout) != 1U)
+    if (stream_test)
     {
-        binary_stream_active = false;
-        capture_enabled = false;
-        frame_limit_enabled = false;
-        status_printf("Failed to write frame header.\r\n");
-        return;
+        /* The sensor was never started. */
+        link_test_stop();
+        data_available = false;
+        return true;
     }
 
-    if (fwrite(samples, sizeof(samples[0]), NUM_SAMPLES_PER_FRAME, stdout) != NUM_SAMPLES_PER_FRAME)
+#if DUAL_CORE_ACQUISITION
+    if (!ipc_frames_command(&ipc_shared, IPC_FRAMES_CMD_STOP))
     {
-        binary_stream_active = false;
-        capture_enabled = false;
-        frame_limit_enabled = false;
-        status_printf("Failed to write frame payload.\r\n");
-        return;
+        capture_enabled = was_enabled;
+        return false;
     }
+#else
+#if FIFO_READOUT_DMA
+    fifo_dma_wait();
+#endif
 
-    fflush(stdout);
+    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        capture_enabled = was_enabled;
+        return false;
+    }
+#endif
+
+    data_available = false;
+    return true;
 }
 
-/* Interrupt handler to react on sensor indicating the availability of new data */
-#if defined(CYHAL_API_VERSION) && (CYHAL_API_VERSION >= 2)
-void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_event_t event)
-#else
-void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_irq_event_t event)
+static void abort_stream(const char *reason)
+{
+    (void)stop_sensor();
+
+    uart_tx_wait();
+#if FLASH_RECORDING
+    while (flash_log_busy())
+    {
+        flash_log_service();
+    }
+#endif
+
+    session_elapsed_us = timebase_wall_us() - session_start_us;
+    binary_stream_active = false;
+    capture_enabled = false;
+    frame_limit_enabled = false;
+    tx_slot = -1;
+    tx_phase = TX_PHASE_IDLE;
+#if !defined(COMPONENT_FREERTOS)
+    if (tx_control)
+    {
+        /* The response was already on the wire. */
+        tx_control = false;
+        control_tail++;
+    }
+#if PRETRIGGER_CAPTURE
+    tx_history = false;
 #endif
+#endif
+    frame_ring_reset(&frame_ring);
+#if PRETRIGGER_CAPTURE
+    stream_pretrigger = false;
+    frame_history_reset(&history);
+#endif
+    status_printf("%s\r\n", reason);
+}
+
+#if !defined(COMPONENT_FREERTOS)
+/* Events raised from interrupts that the main loop has not handled yet.
+   Checked with interrupts masked right before sleeping, so none is missed. */
+static bool wakeup_pending(void)
 {
-    CY_UNUSED_PARAMETER(args);
-    CY_UNUSED_PARAMETER(event);
-    data_available = true;
+    if (cyhal_uart_readable(&cy_retarget_io_uart_obj) > 0U)
+    {
+        return true;
+    }
+
+#if FLASH_RECORDING
+    /* The flash signals the end of a page program or an erase only through
+       its status register. */
+    if (flash_log_pending())
+    {
+        return true;
+    }
+#endif
+
+    /* A header or payload transfer finished, or a new frame or response was
+       queued. */
+    if (((tx_phase != TX_PHASE_IDLE) && !uart_tx_busy()) ||
+        ((tx_phase == TX_PHASE_IDLE) &&
+         ((frame_ring_level(&frame_ring) > 0U) || (control_tail != control_head))))
+    {
+        return true;
+    }
+
+#if PRETRIGGER_CAPTURE
+    /* A frame waits for the history, or a burst for the link. */
+    uint32_t length = 0U;
+
+    if (stream_pretrigger &&
+        ((frame_ring_level(&frame_ring) > 0U) ||
+         ((tx_phase == TX_PHASE_IDLE) && (pretrigger_next(&length) != NULL))))
+    {
+        return true;
+    }
+#endif
+
+    if (capture_enabled && frame_limit_enabled &&
+        (frame_ring_written(&frame_ring) >= frame_limit_total))
+    {
+        return true;
+    }
+
+    if (capture_enabled && stream_test && (capture_frame_index != link_test_due()))
+    {
+        return true;
+    }
+
+#if DUAL_CORE_ACQUISITION
+    /* The CM0+ flushes the FIFO itself; new frames show in the ring level. */
+    return false;
+#elif FIFO_READOUT_DMA
+    return fifo_dma_flush_pending();
+#else
+    return data_available;
+#endif
 }
 
-int main(void)
+/* Waits for the next interrupt without work to do and books the time as CPU
+   idle. Deep sleep stops the DMA and the UART, so it is taken only when the
+   caller waits for nothing but the sensor interrupt and no transfer runs;
+   characters received meanwhile are lost. */
+static void wait_for_event(bool allow_deepsleep)
 {
-    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint64_t start = timebase_wall_us();
+    bool deep = false;
 
-    /* Initialize the device and board peripherals. */
-    result = cybsp_init();
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+#if (LOW_POWER_MODE == LOW_POWER_MODE_NONE)
+    CY_UNUSED_PARAMETER(allow_deepsleep);
+    (void)cyhal_system_delay_us(IDLE_WAIT_US);
+#else
+    uart_tx_arm_rx_wakeup();
 
-    __enable_irq();
+    uint32_t irq_state = cyhal_system_critical_section_enter();
 
-    /* Initialize retarget-io to use the debug UART port. */
-    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, CY_RETARGET_IO_BAUDRATE);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    if (!wakeup_pending())
+    {
+#if (LOW_POWER_MODE == LOW_POWER_MODE_DEEPSLEEP)
+        /* The link test timer halts in deep sleep. */
+        allow_deepsleep = allow_deepsleep && !stream_test;
+#if DUAL_CORE_ACQUISITION
+        /* The IPC interrupt from the CM0+ must be able to wake the CM4. */
+        allow_deepsleep = false;
+#elif FIFO_READOUT_DMA
+        allow_deepsleep = allow_deepsleep && !fifo_dma_busy();
+#endif
+        /* The HAL refuses deep sleep while a peripheral is still busy. */
+        if (allow_deepsleep && !uart_tx_busy() && (cyhal_syspm_deepsleep() == CY_RSLT_SUCCESS))
+        {
+            deep = true;
+        }
+        else
+#else
+        CY_UNUSED_PARAMETER(allow_deepsleep);
+#endif
+        {
+            (void)cyhal_syspm_sleep();
+        }
+    }
 
-    setvbuf(stdout, NULL, _IONBF, 0);
-    setvbuf(stdin, NULL, _IONBF, 0);
+    /* The interrupt that woke the CPU is serviced here. */
+    cyhal_system_critical_section_exit(irq_state);
+#endif
 
-    status_printf("XENSIV BGT60TRxx Example\r\n");
+    uint64_t waited_us = timebase_wall_us() - start;
 
-    /* Initialize the SPI interface to BGT60. */
-    result = cyhal_spi_init(&cyhal_spi,
-                            PIN_XENSIV_BGT60TRXX_SPI_MOSI,
-                            PIN_XENSIV_BGT60TRXX_SPI_MISO,
-                            PIN_XENSIV_BGT60TRXX_SPI_SCLK,
-                            NC,
-                            NULL,
-                            8,
-                            CYHAL_SPI_MODE_00_MSB,
-                            false);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    if (deep)
+    {
+        session_deepsleep_us += waited_us;
+    }
+    else
+    {
+        session_idle_us += waited_us;
+    }
+}
+#endif /* !COMPONENT_FREERTOS */
 
-    /* Reduce drive strength to improve EMI */
-    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
-                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_SLEW_FAST);
-    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
-                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_DRIVE_1_8);
-    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
-                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_SLEW_FAST);
-    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
-                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_DRIVE_1_8);
+static void print_stats(void)
+{
+    uart_tx_stats_t tx_stats;
+    uart_tx_get_stats(&tx_stats);
 
-    /* Set SPI data rate to communicate with sensor */
-    result = cyhal_spi_set_frequency(&cyhal_spi, XENSIV_BGT60TRXX_SPI_FREQUENCY);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    uint64_t elapsed_us = binary_stream_active ? (timebase_wall_us() - session_start_us) :
+                                                 session_elapsed_us;
+    uint32_t throughput = 0U;
+    uint32_t idle_permille = 0U;
+    uint32_t deepsleep_permille = 0U;
+    uint32_t active_permille = 0U;
 
-    /* Enable the LDO. */
-    result = cyhal_gpio_init(PIN_XENSIV_BGT60TRXX_LDO_EN,
-                             CYHAL_GPIO_DIR_OUTPUT,
-                             CYHAL_GPIO_DRIVE_STRONG,
-                             true);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    if (elapsed_us > 0U)
+    {
+        throughput = (uint32_t)(((uint64_t)tx_stats.bytes_sent * TIMEBASE_FREQUENCY_HZ) / elapsed_us);
+        idle_permille = (uint32_t)((session_idle_us * 1000U) / elapsed_us);
+        deepsleep_permille = (uint32_t)((session_deepsleep_us * 1000U) / elapsed_us);
+        active_permille = ((idle_permille + deepsleep_permille) < 1000U) ?
+                          (1000U - idle_permille - deepsleep_permille) : 0U;
+    }
 
-    /* Wait LDO stable */
-    (void)cyhal_system_delay_ms(5);
+    status_printf("Frames queued: %" PRIu32 ", dropped: %" PRIu32 " (ring slots: %u).\r\n",
+                  frame_ring_level(&frame_ring),
+                  frame_ring.dropped,
+                  (unsigned int)FRAME_RING_NUM_SLOTS);
+    status_printf("Link: %" PRIu32 " bytes in %" PRIu32 " transfers (%" PRIu32 " errors), %" PRIu32 " B/s at %" PRIu32 " baud.\r\n",
+                  tx_stats.bytes_sent,
+                  tx_stats.transfers,
+                  tx_stats.errors,
+                  throughput,
+                  stream_baud);
+    status_printf("CPU active: %" PRIu32 ".%" PRIu32 "%%, idle: %" PRIu32 ".%" PRIu32 "%%, deep sleep: %" PRIu32 ".%" PRIu32 "%%.\r\n",
+                  active_permille / 10U,
+                  active_permille % 10U,
+                  idle_permille / 10U,
+                  idle_permille % 10U,
+                  deepsleep_permille / 10U,
+                  deepsleep_permille % 10U);
+
+    if (stream_test)
+    {
+        status_printf("Link test: %" PRIu32 " frames due at %" PRIu32 " Hz, %" PRIu32 " handled.\r\n",
+                      link_test_due(),
+                      stream_test_rate_hz,
+                      capture_frame_index);
+    }
 
-    result = xensiv_bgt60trxx_mtb_init(&sensor,
-                                       &cyhal_spi,
-                                       PIN_XENSIV_BGT60TRXX_SPI_CSN,
-                                       PIN_XENSIV_BGT60TRXX_RSTN,
-                                       register_list,
-                                       XENSIV_BGT60TRXX_CONF_NUM_REGS);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    if (stream_format >= BINARY_FRAME_FORMAT_RANGE_CINT16)
+    {
+        status_printf("Range FFT: %" PRIu32 " us per frame.\r\n", range_fft_last_us);
+    }
 
-    /* The sensor will generate an interrupt once the sensor FIFO level is
-       NUM_SAMPLES_PER_FRAME */
-    result = xensiv_bgt60trxx_mtb_interrupt_init(&sensor,
-                                                 NUM_SAMPLES_PER_FRAME,
-                                                 PIN_XENSIV_BGT60TRXX_IRQ,
-                                                 CYHAL_ISR_PRIORITY_DEFAULT,
-                                                 xensiv_bgt60trxx_mtb_interrupt_handler,
-                                                 NULL);
-    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    status_printf("Sensor SPI: %" PRIu32 " kHz, drive %s%s.\r\n",
+                  spi_clock.frequency_hz / 1000U,
+                  spi_calib_drive_name(spi_clock.drive_sel),
+                  spi_clock_calibrated ? ", calibrated" : "");
 
-    /* Ensure acquisition is idle until commanded via CLI */
-    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) != XENSIV_BGT60TRXX_STATUS_OK)
+#if FIFO_READOUT_DMA
+    fifo_dma_stats_t dma_stats;
+#if DUAL_CORE_ACQUISITION
+    dma_stats = ipc_shared.stats;
+#else
+    fifo_dma_get_stats(&dma_stats);
+#endif
+
+    status_printf("FIFO DMA: %" PRIu32 " frames, %" PRIu32 " bus-busy drops, %" PRIu32 " ring-full drops, %" PRIu32 " errors.\r\n",
+                  dma_stats.completed,
+                  dma_stats.busy_drops,
+                  dma_stats.ring_drops,
+                  dma_stats.errors);
+    status_printf("FIFO readout latency: %" PRIu32 " us last, %" PRIu32 " us max.\r\n",
+                  dma_stats.last_latency_us,
+                  dma_stats.max_latency_us);
+#if FIFO_SLICE_CHIRPS
+    status_printf("FIFO slices: %" PRIu32 " of %u chirps.\r\n",
+                  dma_stats.slices,
+                  (unsigned)FIFO_SLICE_CHIRPS);
+#endif
+#endif
+
+#if defined(COMPONENT_WICED_BLE)
+    ble_events_stats_t ble_stats;
+    ble_events_get_stats(&ble_stats);
+
+    status_printf("BLE: %s, %" PRIu32 " records queued, %" PRIu32 " sent in %" PRIu32 " notifications, %" PRIu32 " dropped, interval %" PRIu32 " us.\r\n",
+                  ble_events_connected() ? "subscribed" : "idle",
+                  ble_stats.records_queued,
+                  ble_stats.records_sent,
+                  ble_stats.notifications,
+                  ble_stats.records_dropped,
+                  ble_stats.conn_interval_us);
+#endif
+
+#if PRETRIGGER_CAPTURE
+    if (stream_pretrigger || (pretrigger_bursts > 0U))
     {
-        CY_ASSERT(0);
+        status_printf("Pre-trigger: %" PRIu32 " bursts, %" PRIu32 " frames uploaded, %" PRIu32 " lost, "
+                      "%" PRIu32 " in history, last motion %" PRIu32 ".%02" PRIu32 "x background.\r\n",
+                      pretrigger_bursts,
+                      pretrigger_uploaded,
+                      pretrigger_lost,
+                      frame_history_level(&history),
+                      motion_trigger_last_ratio() / 16U,
+                      ((motion_trigger_last_ratio() % 16U) * 100U) / 16U);
+    }
+#endif
+
+#if FLASH_RECORDING
+    flash_log_stats_t log_stats;
+    flash_log_get_stats(&log_stats);
+
+    status_printf("Flash log: %" PRIu32 " records, %" PRIu32 " bytes, %" PRIu32 " erase stalls, %" PRIu32 " errors.\r\n",
+                  log_stats.records,
+                  log_stats.bytes,
+                  log_stats.stalls,
+                  log_stats.errors);
+#endif
+
+    print_stage_timing(false);
+}
+
+/* Starts timing a CPU-bound stage. */
+static uint32_t stage_begin(void)
+{
+#if STAGE_TIMING
+    return cycle_counter_now();
+#else
+    return 0U;
+#endif
+}
+
+static void stage_end(stage_t stage, uint32_t start)
+{
+#if STAGE_TIMING
+    cycle_stats_add(&stage_stats[stage], cycle_counter_now() - start);
+#else
+    CY_UNUSED_PARAMETER(stage);
+    CY_UNUSED_PARAMETER(start);
+#endif
+}
+
+static void stage_record(stage_t stage, uint32_t value)
+{
+#if STAGE_TIMING
+    cycle_stats_add(&stage_stats[stage], value);
+#else
+    CY_UNUSED_PARAMETER(stage);
+    CY_UNUSED_PARAMETER(value);
+#endif
+}
+
+/* Prints count and min/avg/max of every stage measured in the last session,
+   in microseconds, optionally followed by its log2 histogram in native units
+   (cycles, or us for transmit). */
+static void print_stage_timing(bool histogram)
+{
+#if STAGE_TIMING
+    bool any = false;
+
+    for (uint32_t i = 0U; i < (uint32_t)STAGE_COUNT; i++)
+    {
+        const cycle_stats_t *stats = &stage_stats[i];
+        const bool cycles = (i != (uint32_t)STAGE_TRANSMIT);
+        uint32_t min = stats->min;
+        uint32_t mean = cycle_stats_mean(stats);
+        uint32_t max = stats->max;
+
+        if (stats->count == 0U)
+        {
+            continue;
+        }
+
+        if (!any)
+        {
+            status_printf("Stage        count     min us     avg us     max us\r\n");
+            any = true;
+        }
+
+        if (cycles)
+        {
+            min = cycle_counter_to_tenth_us(min);
+            mean = cycle_counter_to_tenth_us(mean);
+            max = cycle_counter_to_tenth_us(max);
+        }
+        else
+        {
+            min *= 10U;
+            mean *= 10U;
+            max *= 10U;
+        }
+
+        status_printf("%-9s %8" PRIu32 " %8" PRIu32 ".%" PRIu32 " %8" PRIu32 ".%" PRIu32 " %8" PRIu32 ".%" PRIu32 "\r\n",
+                      stage_names[i],
+                      stats->count,
+                      min / 10U, min % 10U,
+                      mean / 10U, mean % 10U,
+                      max / 10U, max % 10U);
+
+        if (!histogram)
+        {
+            continue;
+        }
+
+        for (uint32_t bin = 0U; bin < CYCLE_STATS_BINS; bin++)
+        {
+            if (stats->histogram[bin] > 0U)
+            {
+                status_printf("  >= 2^%-2" PRIu32 " %s: %" PRIu32 "\r\n",
+                              bin,
+                              cycles ? "cycles" : "us",
+                              stats->histogram[bin]);
+            }
+        }
+    }
+
+    if (histogram && !any)
+    {
+        status_printf("No stage timing recorded.\r\n");
+    }
+#else
+    if (histogram)
+    {
+        status_printf("Stage timing disabled (STAGE_TIMING=0).\r\n");
+    }
+#endif
+}
+
+#if !FIFO_READOUT_DMA
+/* Reads the sensor FIFO into the next free ring slot. If transmission has not
+   released a slot yet, the frame is discarded from the FIFO and counted as
+   dropped so the sensor never overflows. Returns true if the frame was
+   queued. */
+static bool acquire_frame(uint32_t frame_idx, uint32_t timestamp_us)
+{
+    int32_t slot = frame_ring_begin_write(&frame_ring);
+
+    if (slot < 0)
+    {
+        frame_ring_count_drop(&frame_ring);
+        (void)xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+        return false;
+    }
+
+    uint32_t start = stage_begin();
+
+    if (xensiv_bgt60trxx_get_fifo_data(&sensor.dev, samples[slot],
+                                       samples_per_frame) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        frame_ring_count_drop(&frame_ring);
+        return false;
+    }
+
+    stage_end(STAGE_READOUT, start);
+
+    const frame_slot_info_t info = {
+        .frame_index = frame_idx,
+        .timestamp_us = timestamp_us,
+        .packed = false
+    };
+
+    frame_ring_end_write(&frame_ring, &info);
+    return true;
+}
+#endif /* !FIFO_READOUT_DMA */
+
+/* Generates the link test frames that fell due since the last call, each
+   into the next free ring slot. A frame that finds the ring full is counted
+   as dropped, like a sensor frame. Returns true if a frame was queued. */
+static bool link_test_service(void)
+{
+    bool queued = false;
+    uint32_t due = link_test_due();
+
+    while (capture_enabled && stream_test && (capture_frame_index != due) &&
+           (!frame_limit_enabled || (frame_ring_written(&frame_ring) < frame_limit_total)))
+    {
+        int32_t slot = frame_ring_begin_write(&frame_ring);
+
+        if (slot < 0)
+        {
+            frame_ring_count_drop(&frame_ring);
+        }
+        else
+        {
+            uint32_t start = stage_begin();
+
+            link_test_fill(samples[slot], samples_per_frame, capture_frame_index);
+            stage_end(STAGE_READOUT, start);
+
+            const frame_slot_info_t info = {
+                .frame_index = capture_frame_index,
+                .timestamp_us = timebase_now_us(),
+                .packed = false
+            };
+
+            frame_ring_end_write(&frame_ring, &info);
+            queued = true;
+        }
+
+        capture_frame_index++;
+    }
+
+    return queued;
+}
+
+/* Brings a queued slot into the wire format of the session, in place, and
+   returns where the payload starts. Fills in the payload description of the
+   header. Frames read by DMA are already Packed12. The region of interest,
+   chirp averaging and decimation shrink the frame in place first. With
+   compression enabled or in range FFT mode the payload is built in the
+   slot's tx_codec_buffer. */
+static const uint8_t *encode_payload(int32_t slot, binary_frame_header_t *header)
+{
+    uint16_t *frame = samples[slot];
+    uint8_t *codec = tx_codec_buffer[(uint32_t)slot % CODEC_BUFFER_SLOTS];
+    bool packed = frame_ring.info[slot].packed;
+    uint32_t num_chirps = geometry.num_chirps;
+    uint32_t num_samples = geometry.num_samples_per_chirp;
+    uint32_t num_rx = geometry.num_rx;
+    uint32_t frame_samples = samples_per_frame;
+
+    if (stream_roi_active || (stream_chirp_shift > 0U) || (stream_sample_shift > 0U))
+    {
+        uint32_t start = stage_begin();
+
+        if (packed)
+        {
+            fifo_dma_unpack(frame);
+            frame_ring.info[slot].packed = false;
+            packed = false;
+        }
+
+        if (stream_roi_active)
+        {
+            frame_samples = frame_roi_gather(frame, num_chirps, num_samples, num_rx, &stream_roi);
+            num_chirps = stream_roi.num_chirps;
+            num_samples = stream_roi.num_samples;
+            num_rx = frame_roi_num_rx(stream_roi.rx_mask);
+        }
+
+        if ((stream_chirp_shift > 0U) || (stream_sample_shift > 0U))
+        {
+            frame_samples = chirp_average_frame(frame, num_chirps, num_samples, num_rx,
+                                                1UL << stream_chirp_shift, 1UL << stream_sample_shift);
+            num_chirps >>= stream_chirp_shift;
+            num_samples >>= stream_sample_shift;
+        }
+
+        stage_end(STAGE_REDUCE, start);
+    }
+
+    header->sample_size_bytes = BINARY_FRAME_SAMPLE_SIZE_BYTES;
+    header->sample_count = frame_samples;
+    header->sample_format = stream_format;
+    header->flags = (uint16_t)(((stream_chirp_shift << REDUCTION_CHIRP_SHIFT_POS) |
+                                (stream_sample_shift << REDUCTION_SAMPLE_SHIFT_POS)) <<
+                               BINARY_FRAME_FLAG_REDUCTION_POS);
+    header->roi_rx_mask = (uint16_t)stream_roi.rx_mask;
+    header->roi_first_chirp = (uint16_t)stream_roi.first_chirp;
+    header->roi_num_chirps = (uint16_t)stream_roi.num_chirps;
+    header->roi_first_sample = (uint16_t)stream_roi.first_sample;
+    header->roi_num_samples = (uint16_t)stream_roi.num_samples;
+
+    if ((stream_format == BINARY_FRAME_FORMAT_RANGE_CINT16) ||
+        (stream_format == BINARY_FRAME_FORMAT_RANGE_MAG_U16))
+    {
+        bool magnitude = (stream_format == BINARY_FRAME_FORMAT_RANGE_MAG_U16);
+        uint32_t start = timebase_now_us();
+
+        if (packed)
+        {
+            fifo_dma_unpack(frame);
+            frame_ring.info[slot].packed = false;
+        }
+
+        header->sample_size_bytes = magnitude ? RANGE_FFT_MAGNITUDE_BYTES : RANGE_FFT_COMPLEX_BYTES;
+        header->sample_count = frame_samples / 2U;
+        header->payload_size = range_fft_frame(frame,
+                                               num_chirps,
+                                               num_rx,
+                                               magnitude,
+                                               codec);
+        range_fft_last_us = timebase_now_us() - start;
+        return codec;
+    }
+
+    if (stream_format == BINARY_FRAME_FORMAT_PRESENCE)
+    {
+        uint32_t start = timebase_now_us();
+        presence_result_t result;
+
+        if (packed)
+        {
+            fifo_dma_unpack(frame);
+            frame_ring.info[slot].packed = false;
+        }
+
+        (void)range_fft_profile(frame,
+                                num_chirps,
+                                num_rx,
+                                range_profile);
+        presence_process(range_profile, &result);
+
+        float level = result.peak_level * (float)(1UL << RANGE_FFT_FRAC_BITS);
+        presence_event_t *event = (presence_event_t *)codec;
+
+        *event = (presence_event_t) {
+            .present = result.present ? 1U : 0U,
+            .changed = result.changed ? 1U : 0U,
+            .range_bin = (uint16_t)result.peak_bin,
+            .distance_mm = (uint16_t)(((float)result.peak_bin * RANGE_BIN_M * 1000.0f) + 0.5f),
+            .level = (level >= 65535.0f) ? UINT16_MAX : (uint16_t)(level + 0.5f)
+        };
+
+#if defined(COMPONENT_WICED_BLE)
+        const ble_event_record_t record = {
+            .frame_index = frame_ring.info[slot].frame_index,
+            .present = event->present,
+            .changed = event->changed,
+            .range_bin = event->range_bin,
+            .distance_mm = event->distance_mm,
+            .level = event->level
+        };
+
+        ble_events_submit(&record);
+#endif
+
+        header->sample_size_bytes = (uint16_t)sizeof(presence_event_t);
+        header->sample_count = 1U;
+        header->payload_size = sizeof(presence_event_t);
+        range_fft_last_us = timebase_now_us() - start;
+        return codec;
+    }
+
+    if (stream_compress)
+    {
+        if (packed)
+        {
+            fifo_dma_unpack(frame);
+            frame_ring.info[slot].packed = false;
+        }
+
+        uint32_t compressed = rice_encode(frame,
+                                          num_chirps,
+                                          num_samples * num_rx,
+                                          num_rx,
+                                          codec,
+                                          (frame_samples * sizeof(uint16_t)) - 1U);
+
+        header->sample_format = BINARY_FRAME_FORMAT_U16LE;
+
+        if (compressed > 0U)
+        {
+            header->flags |= BINARY_FRAME_FLAG_DELTA_RICE;
+            header->payload_size = compressed;
+            return codec;
+        }
+
+        /* Incompressible frame: fall through to the plain encoding. */
+        packed = false;
+    }
+
+    if (header->sample_format == BINARY_FRAME_FORMAT_PACKED12)
+    {
+        header->payload_size = PACKED12_BYTES(frame_samples);
+
+        if (packed)
+        {
+            return fifo_dma_packed_data(frame);
+        }
+
+        packed12_pack(frame, (uint8_t *)frame, frame_samples);
+        return (const uint8_t *)frame;
+    }
+
+    if (packed)
+    {
+        fifo_dma_unpack(frame);
+    }
+
+    header->payload_size = frame_samples * sizeof(uint16_t);
+    return (const uint8_t *)frame;
+}
+
+/* Builds the complete header of a queued slot and encodes its payload. */
+static const uint8_t *build_frame(int32_t slot, binary_frame_header_t *header)
+{
+    const frame_slot_info_t *info = &frame_ring.info[slot];
+
+    *header = (binary_frame_header_t) {
+        .magic = {'R', 'A', 'D', 'R'},
+        .version = BINARY_FRAME_HEADER_VERSION,
+        .frame_index = info->frame_index,
+        .timestamp_us = info->timestamp_us
+    };
+
+    uint32_t start = stage_begin();
+#if PRETRIGGER_CAPTURE
+    /* Looks at the raw frame, before encoding changes it. */
+    const bool triggered = stream_pretrigger && pretrigger_check(slot);
+#endif
+    const uint8_t *payload = encode_payload(slot, header);
+
+    stage_end(STAGE_ENCODE, start);
+
+#if PRETRIGGER_CAPTURE
+    if (triggered)
+    {
+        header->flags |= BINARY_FRAME_FLAG_TRIGGER;
+    }
+#endif
+
+    if (info->overflow)
+    {
+        header->flags |= BINARY_FRAME_FLAG_FIFO_OVERFLOW;
+    }
+
+    start = stage_begin();
+    header->payload_crc32 = compute_crc32(payload, header->payload_size);
+    stage_end(STAGE_CRC, start);
+    return payload;
+}
+
+static uint32_t compute_crc32(const uint8_t *data, uint32_t length)
+{
+    uint32_t crc = 0U;
+
+#if defined(COMPONENT_FREERTOS)
+    /* Frames are encoded by the process task, responses by the CLI task. */
+    (void)xSemaphoreTake(crc_mutex, portMAX_DELAY);
+#endif
+
+    if ((cyhal_crc_start(&payload_crc, &payload_crc_algorithm) == CY_RSLT_SUCCESS) &&
+        (cyhal_crc_compute(&payload_crc, data, length) == CY_RSLT_SUCCESS))
+    {
+        (void)cyhal_crc_finish(&payload_crc, &crc);
+    }
+
+#if defined(COMPONENT_FREERTOS)
+    (void)xSemaphoreGive(crc_mutex);
+#endif
+
+    return crc;
+}
+
+#if !defined(COMPONENT_FREERTOS)
+/* Advances the DMA transmit of the oldest queued frame: header first, then
+   the payload straight out of its ring slot. Returns false when there was
+   nothing left to send. */
+static bool transmit_service(void)
+{
+#if PRETRIGGER_CAPTURE
+    /* Frames go into the history as soon as they are read out, even while a
+       record is on the wire. */
+    if (stream_pretrigger)
+    {
+        const int32_t slot = frame_ring_begin_read(&frame_ring);
+
+        if (slot >= 0)
+        {
+            pretrigger_store(&tx_header, build_frame(slot, &tx_header));
+            frame_ring_end_read(&frame_ring);
+            return true;
+        }
+    }
+#endif
+
+    if (uart_tx_busy())
+    {
+        return true;
+    }
+
+#if FLASH_RECORDING
+    if (flash_log_busy())
+    {
+        flash_log_service();
+        return true;
+    }
+#endif
+
+    if (tx_phase == TX_PHASE_HEADER)
+    {
+        if (uart_tx_start(tx_payload, tx_payload_size) != CY_RSLT_SUCCESS)
+        {
+            abort_stream("Failed to write frame payload.");
+            return false;
+        }
+
+        tx_phase = TX_PHASE_PAYLOAD;
+        return true;
+    }
+
+    if ((tx_phase == TX_PHASE_PAYLOAD) && tx_control)
+    {
+        tx_control = false;
+        tx_phase = TX_PHASE_IDLE;
+        control_tail++;
+        return true;
+    }
+
+#if PRETRIGGER_CAPTURE
+    if ((tx_phase == TX_PHASE_PAYLOAD) && tx_history)
+    {
+        stage_record(STAGE_TRANSMIT, timebase_now_us() - tx_start_us);
+        tx_history = false;
+        tx_phase = TX_PHASE_IDLE;
+        pretrigger_sent();
+        return true;
+    }
+#endif
+
+    if (tx_phase == TX_PHASE_PAYLOAD)
+    {
+        stage_record(STAGE_TRANSMIT, timebase_now_us() - tx_start_us);
+        frame_ring_end_read(&frame_ring);
+        tx_slot = -1;
+        tx_phase = TX_PHASE_IDLE;
+
+        if (frame_limit_enabled)
+        {
+            frame_limit_sent++;
+        }
+
+        return true;
+    }
+
+    /* Responses go out between frames, so control latency stays within one
+       frame transfer. */
+    if (control_tail != control_head)
+    {
+        const uint32_t slot = control_tail % CONTROL_RESPONSE_SLOTS;
+
+        tx_payload = (const uint8_t *)&control_response[slot];
+        tx_payload_size = control_header[slot].payload_size;
+
+        if (uart_tx_start(&control_header[slot], sizeof(control_header[slot])) != CY_RSLT_SUCCESS)
+        {
+            abort_stream("Failed to write control response.");
+            return false;
+        }
+
+        tx_control = true;
+        tx_phase = TX_PHASE_HEADER;
+        return true;
+    }
+
+#if PRETRIGGER_CAPTURE
+    if (stream_pretrigger)
+    {
+        return pretrigger_service();
+    }
+#endif
+
+    if (frame_limit_enabled && (frame_limit_sent >= frame_limit_total))
+    {
+        return false;
+    }
+
+    tx_slot = frame_ring_begin_read(&frame_ring);
+
+    if (tx_slot < 0)
+    {
+        return false;
+    }
+
+    tx_payload = build_frame(tx_slot, &tx_header);
+    tx_payload_size = tx_header.payload_size;
+    tx_start_us = timebase_now_us();
+
+#if FLASH_RECORDING
+    if (stream_to_flash)
+    {
+        /* Header and payload become one record; the payload phase ends once
+           the flash is done with both. */
+        if (flash_log_append(&tx_header, sizeof(tx_header), tx_payload, tx_payload_size) != CY_RSLT_SUCCESS)
+        {
+            abort_stream("Failed to record frame.");
+            return false;
+        }
+
+        tx_phase = TX_PHASE_PAYLOAD;
+        return true;
+    }
+#endif
+
+    if (uart_tx_start(&tx_header, sizeof(tx_header)) != CY_RSLT_SUCCESS)
+    {
+        abort_stream("Failed to write frame header.");
+        return false;
+    }
+
+    tx_phase = TX_PHASE_HEADER;
+    return true;
+}
+
+#if PRETRIGGER_CAPTURE
+/* Starts the upload of the next record of a burst. Returns false when there
+   is none. */
+static bool pretrigger_service(void)
+{
+    uint32_t length = 0U;
+    const uint8_t *record = pretrigger_next(&length);
+
+    if (record == NULL)
+    {
+        return false;
+    }
+
+    if (uart_tx_start(record, length) != CY_RSLT_SUCCESS)
+    {
+        abort_stream("Failed to write frame.");
+        return false;
+    }
+
+    tx_start_us = timebase_now_us();
+    tx_history = true;
+    tx_phase = TX_PHASE_PAYLOAD;
+    return true;
+}
+#endif
+
+#endif /* !COMPONENT_FREERTOS */
+
+#if PRETRIGGER_CAPTURE
+/* Runs the motion trigger on the first chirp of a queued frame. */
+static bool pretrigger_check(int32_t slot)
+{
+    uint16_t *frame = samples[slot];
+    const uint32_t values = geometry.num_samples_per_chirp * geometry.num_rx;
+
+    if (frame_ring.info[slot].packed)
+    {
+        packed12_unpack(fifo_dma_packed_data(frame), trigger_chirp,
+                        (values < MOTION_TRIGGER_MAX_VALUES) ? values : MOTION_TRIGGER_MAX_VALUES);
+        return motion_trigger_process(trigger_chirp);
+    }
+
+    return motion_trigger_process(frame);
+}
+
+/* Files an encoded frame of a pre-trigger session. While armed the history
+   keeps the last pretrigger_pre frames; the first frame the trigger fires on
+   starts a burst, which also keeps the next pretrigger_post frames. */
+static void pretrigger_store(binary_frame_header_t *header, const uint8_t *payload)
+{
+    switch (pretrigger_state)
+    {
+        case PRETRIGGER_ARMED:
+            frame_history_trim(&history, pretrigger_pre - 1U);
+            (void)frame_history_push(&history, header, sizeof(*header), payload, header->payload_size);
+
+            if ((header->flags & BINARY_FRAME_FLAG_TRIGGER) != 0U)
+            {
+                pretrigger_bursts++;
+                pretrigger_post_left = pretrigger_post;
+                pretrigger_state = (pretrigger_post > 0U) ? PRETRIGGER_BURST : PRETRIGGER_DRAIN;
+            }
+            break;
+
+        case PRETRIGGER_BURST:
+            if (pretrigger_loss_pending)
+            {
+                header->flags |= BINARY_FRAME_FLAG_FIFO_OVERFLOW;
+            }
+
+            /* The upload fell a whole history behind. */
+            pretrigger_loss_pending = !frame_history_push(&history, header, sizeof(*header),
+                                                          payload, header->payload_size);
+
+            if (pretrigger_loss_pending)
+            {
+                pretrigger_lost++;
+            }
+
+            if (--pretrigger_post_left == 0U)
+            {
+                pretrigger_state = PRETRIGGER_DRAIN;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Oldest record of a burst still to be uploaded, or NULL. */
+static const uint8_t *pretrigger_next(uint32_t *length)
+{
+    if (pretrigger_state == PRETRIGGER_ARMED)
+    {
+        return NULL;
+    }
+
+    return frame_history_peek(&history, length);
+}
+
+/* The record from pretrigger_next() is on the wire. Once a complete burst
+   is out, the session arms again with an empty history. */
+static void pretrigger_sent(void)
+{
+    frame_history_pop(&history);
+    pretrigger_uploaded++;
+
+    if ((pretrigger_state == PRETRIGGER_DRAIN) && (frame_history_level(&history) == 0U))
+    {
+        pretrigger_loss_pending = false;
+        pretrigger_state = PRETRIGGER_ARMED;
+    }
+}
+#endif
+
+#if defined(COMPONENT_FREERTOS)
+/* A transmit job is a ring slot plus where its encoded payload starts; the
+   frame itself is never copied. */
+typedef struct
+{
+    int32_t slot;                   /* -1 for a control response */
+    const binary_frame_header_t *header;
+    const uint8_t *payload;
+} tx_job_t;
+
+static TaskHandle_t acquire_task_handle = NULL;
+static TaskHandle_t process_task_handle = NULL;
+static TaskHandle_t transmit_task_handle = NULL;
+static TaskHandle_t cli_task_handle = NULL;
+static QueueHandle_t tx_queue = NULL;
+/* Serializes sensor control and session state between the tasks. */
+static SemaphoreHandle_t control_mutex = NULL;
+static binary_frame_header_t slot_header[FRAME_RING_NUM_SLOTS];
+/* Ring position of the next frame to encode. */
+static volatile uint32_t frames_processed = 0U;
+static volatile bool process_active = false;
+/* Set by 'stop': queued frames are released without being sent. */
+static volatile bool pipeline_draining = false;
+
+static void notify_from_isr(TaskHandle_t task)
+{
+    BaseType_t higher_priority_woken = pdFALSE;
+
+    if (task != NULL)
+    {
+        vTaskNotifyGiveFromISR(task, &higher_priority_woken);
+        portYIELD_FROM_ISR(higher_priority_woken);
+    }
+}
+
+/* A readout ended: its frame is ready for processing, or the FIFO must be
+   flushed, and the frame limit may have been reached. */
+static void fifo_dma_done(void)
+{
+    notify_from_isr(acquire_task_handle);
+    notify_from_isr(process_task_handle);
+}
+
+static void uart_event(void)
+{
+    notify_from_isr(transmit_task_handle);
+    notify_from_isr(cli_task_handle);
+}
+
+/* A link test frame fell due. */
+static void link_test_event(void)
+{
+    notify_from_isr(acquire_task_handle);
+}
+
+/* Sends one buffer and blocks the calling task until the DMA is done. */
+static bool transmit_blocking(const void *data, size_t length)
+{
+    if (uart_tx_start(data, length) != CY_RSLT_SUCCESS)
+    {
+        return false;
+    }
+
+    while (uart_tx_busy())
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+
+    return true;
+}
+
+#if FLASH_RECORDING
+/* Writes one frame as a flash log record. Sending a page to the flash takes
+   microseconds, programming it well under a tick, so the task only sleeps
+   while the device reports busy. */
+static bool record_blocking(const binary_frame_header_t *header, const uint8_t *payload)
+{
+    if (flash_log_append(header, sizeof(*header), payload, header->payload_size) != CY_RSLT_SUCCESS)
+    {
+        return false;
+    }
+
+    while (flash_log_busy())
+    {
+        flash_log_service();
+
+        if (flash_log_pending())
+        {
+            vTaskDelay(1);
+        }
+    }
+
+    return true;
+}
+#endif
+
+/* Writes one frame to the link, or to the flash while recording. */
+static bool send_frame(const binary_frame_header_t *header, const uint8_t *payload)
+{
+#if FLASH_RECORDING
+    if (stream_to_flash)
+    {
+        return record_blocking(header, payload);
+    }
+#endif
+
+    return transmit_blocking(header, sizeof(*header)) &&
+           transmit_blocking(payload, header->payload_size);
+}
+
+static void acquire_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        (void)xSemaphoreTake(control_mutex, portMAX_DELAY);
+
+#if DUAL_CORE_ACQUISITION
+        /* FIFO flushes happen on the CM0+. */
+#elif FIFO_READOUT_DMA
+        if (fifo_dma_take_flush_request())
+        {
+            /* A frame was left in the FIFO; discard it before the next one. */
+            fifo_dma_wait();
+            (void)xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+        }
+#else
+        if (data_available)
+        {
+            data_available = false;
+
+            if (capture_enabled)
+            {
+                if (acquire_frame(capture_frame_index, data_timestamp_us))
+                {
+                    (void)xTaskNotifyGive(process_task_handle);
+                }
+
+                capture_frame_index++;
+            }
+        }
+#endif
+
+        if (link_test_service())
+        {
+            (void)xTaskNotifyGive(process_task_handle);
+        }
+
+        if (capture_enabled && frame_limit_enabled &&
+            (frame_ring_written(&frame_ring) >= frame_limit_total))
+        {
+            (void)stop_sensor();
+        }
+
+        (void)xSemaphoreGive(control_mutex);
+    }
+}
+
+static void process_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        process_active = true;
+
+        int32_t slot;
+
+        while (!pipeline_draining &&
+               ((slot = frame_ring_slot_at(&frame_ring, frames_processed)) >= 0))
+        {
+            const tx_job_t job = {
+                .slot = slot,
+                .header = &slot_header[slot],
+                .payload = build_frame(slot, &slot_header[slot])
+            };
+
+            /* Never blocks: the queue holds as many jobs as the ring plus
+               the response slots. */
+            (void)xQueueSend(tx_queue, &job, portMAX_DELAY);
+            frames_processed++;
+        }
+
+        process_active = false;
+    }
+}
+
+static void finish_session(void)
+{
+    (void)xSemaphoreTake(control_mutex, portMAX_DELAY);
+
+    /* 'stop' may have ended the session meanwhile. */
+    if (frame_limit_enabled)
+    {
+        uint32_t completed_frames = frame_limit_total;
+
+        if (capture_enabled)
+        {
+            (void)stop_sensor();
+        }
+
+        frame_limit_enabled = false;
+        frame_limit_total = 0U;
+        frame_limit_sent = 0U;
+        frame_ring_reset(&frame_ring);
+        frames_processed = 0U;
+        session_elapsed_us = timebase_wall_us() - session_start_us;
+        binary_stream_active = false;
+        status_printf("Capture completed (%" PRIu32 " frame%s, %" PRIu32 " dropped).\r\n",
+                      completed_frames,
+                      (completed_frames == 1U) ? "" : "s",
+                      frame_ring.dropped);
+    }
+
+    (void)xSemaphoreGive(control_mutex);
+}
+
+static void transmit_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        tx_job_t job;
+
+#if PRETRIGGER_CAPTURE
+        /* A burst goes out record by record; frames and responses queued
+           meanwhile are handled in between. */
+        uint32_t length = 0U;
+        const uint8_t *record = (stream_pretrigger && !pipeline_draining) ? pretrigger_next(&length) : NULL;
+
+        if (xQueueReceive(tx_queue, &job, (record != NULL) ? 0U : portMAX_DELAY) != pdTRUE)
+        {
+            uint32_t start_us = timebase_now_us();
+
+            if (!transmit_blocking(record, length))
+            {
+                (void)xSemaphoreTake(control_mutex, portMAX_DELAY);
+                abort_stream("Failed to write frame.");
+                frames_processed = 0U;
+                (void)xQueueReset(tx_queue);
+                (void)xSemaphoreGive(control_mutex);
+                continue;
+            }
+
+            stage_record(STAGE_TRANSMIT, timebase_now_us() - start_us);
+            pretrigger_sent();
+            continue;
+        }
+#else
+        (void)xQueueReceive(tx_queue, &job, portMAX_DELAY);
+#endif
+
+        if (job.slot < 0)
+        {
+            /* A response that cannot be sent is lost; the host times out. */
+            if (transmit_blocking(job.header, sizeof(*job.header)))
+            {
+                (void)transmit_blocking(job.payload, job.header->payload_size);
+            }
+
+            control_tail++;
+            continue;
+        }
+
+        tx_slot = job.slot;
+
+#if PRETRIGGER_CAPTURE
+        if (stream_pretrigger)
+        {
+            if (!pipeline_draining)
+            {
+                pretrigger_store(&slot_header[job.slot], job.payload);
+            }
+
+            frame_ring_end_read(&frame_ring);
+            tx_slot = -1;
+            continue;
+        }
+#endif
+
+        if (!pipeline_draining)
+        {
+            const binary_frame_header_t *header = job.header;
+            uint32_t start_us = timebase_now_us();
+
+            if (!send_frame(header, job.payload))
+            {
+                (void)xSemaphoreTake(control_mutex, portMAX_DELAY);
+                abort_stream("Failed to write frame.");
+                frames_processed = 0U;
+                (void)xQueueReset(tx_queue);
+                (void)xSemaphoreGive(control_mutex);
+                continue;
+            }
+
+            stage_record(STAGE_TRANSMIT, timebase_now_us() - start_us);
+        }
+
+        frame_ring_end_read(&frame_ring);
+        tx_slot = -1;
+
+        if (!pipeline_draining && frame_limit_enabled &&
+            (++frame_limit_sent >= frame_limit_total))
+        {
+            finish_session();
+        }
+    }
+}
+
+static void cli_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        uart_tx_arm_rx_wakeup();
+
+        /* With every response slot taken, wait for the transmit task instead
+           of reading further requests. */
+        if ((cyhal_uart_readable(&cy_retarget_io_uart_obj) == 0U) || !control_response_space())
+        {
+#if FLASH_RECORDING
+            /* Background erases advance once per tick. */
+            (void)ulTaskNotifyTake(pdTRUE, flash_log_pending() ? 1U : portMAX_DELAY);
+#else
+            (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+#endif
+        }
+
+        (void)xSemaphoreTake(control_mutex, portMAX_DELAY);
+#if FLASH_RECORDING
+        /* During a recording the transmit task owns the flash. */
+        if (!binary_stream_active || !stream_to_flash)
+        {
+            flash_log_service();
+        }
+#endif
+        process_cli();
+        (void)xSemaphoreGive(control_mutex);
+    }
+}
+
+/* Waits until the frame on the wire is complete and every queued frame has
+   been released, then empties the ring. Called by 'stop' with the sensor
+   already halted. */
+static void drain_pipeline(void)
+{
+    pipeline_draining = true;
+
+    while (process_active || (tx_slot >= 0) || (uxQueueMessagesWaiting(tx_queue) > 0U))
+    {
+        vTaskDelay(1);
+    }
+
+    frame_ring_reset(&frame_ring);
+    frames_processed = 0U;
+    pipeline_draining = false;
+}
+
+static void print_task_stats(void)
+{
+    TaskStatus_t tasks[MAX_TASKS_REPORTED];
+    configRUN_TIME_COUNTER_TYPE total_runtime = 0U;
+    UBaseType_t count = uxTaskGetSystemState(tasks, MAX_TASKS_REPORTED, &total_runtime);
+
+    status_printf("Task        Prio     CPU  Stack free\r\n");
+
+    for (UBaseType_t i = 0U; i < count; i++)
+    {
+        uint32_t permille = 0U;
+
+        if (total_runtime > 0U)
+        {
+            permille = (uint32_t)(((uint64_t)tasks[i].ulRunTimeCounter * 1000U) / total_runtime);
+        }
+
+        status_printf("%-10s  %4u  %3" PRIu32 ".%" PRIu32 "%%  %6" PRIu32 " B\r\n",
+                      tasks[i].pcTaskName,
+                      (unsigned int)tasks[i].uxCurrentPriority,
+                      permille / 10U,
+                      permille % 10U,
+                      (uint32_t)tasks[i].usStackHighWaterMark * (uint32_t)sizeof(StackType_t));
+    }
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name)
+{
+    CY_UNUSED_PARAMETER(task);
+    CY_UNUSED_PARAMETER(name);
+    CY_ASSERT(0);
+}
+
+static void start_tasks(void)
+{
+    bool failed = false;
+
+    control_mutex = xSemaphoreCreateMutex();
+    crc_mutex = xSemaphoreCreateMutex();
+    tx_queue = xQueueCreate(FRAME_RING_NUM_SLOTS + CONTROL_RESPONSE_SLOTS, sizeof(tx_job_t));
+    CY_ASSERT((control_mutex != NULL) && (crc_mutex != NULL) && (tx_queue != NULL));
+
+    failed |= (xTaskCreate(acquire_task, "acquire", ACQUIRE_TASK_STACK_WORDS, NULL,
+                            ACQUIRE_TASK_PRIORITY, &acquire_task_handle) != pdPASS);
+    failed |= (xTaskCreate(process_task, "process", PROCESS_TASK_STACK_WORDS, NULL,
+                            PROCESS_TASK_PRIORITY, &process_task_handle) != pdPASS);
+    failed |= (xTaskCreate(transmit_task, "transmit", TRANSMIT_TASK_STACK_WORDS, NULL,
+                            TRANSMIT_TASK_PRIORITY, &transmit_task_handle) != pdPASS);
+    failed |= (xTaskCreate(cli_task, "cli", CLI_TASK_STACK_WORDS, NULL,
+                            CLI_TASK_PRIORITY, &cli_task_handle) != pdPASS);
+    CY_ASSERT(!failed);
+    CY_UNUSED_PARAMETER(failed);
+
+#if FIFO_READOUT_DMA && !DUAL_CORE_ACQUISITION
+    fifo_dma_set_callback(fifo_dma_done);
+#endif
+    uart_tx_set_callback(uart_event);
+}
+#endif /* COMPONENT_FREERTOS */
+
+#if DUAL_CORE_ACQUISITION
+/* The CM0+ published a frame, dropped one or finished a command. */
+static void acquisition_event(void)
+{
+    capture_frame_index = ipc_shared.frame_index;
+#if defined(COMPONENT_FREERTOS)
+    fifo_dma_done();
+#endif
+}
+#else
+/* Interrupt handler to react on sensor indicating the availability of new data */
+#if defined(CYHAL_API_VERSION) && (CYHAL_API_VERSION >= 2)
+void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_event_t event)
+#else
+void xensiv_bgt60trxx_mtb_interrupt_handler(void *args, cyhal_gpio_irq_event_t event)
+#endif
+{
+    CY_UNUSED_PARAMETER(args);
+    CY_UNUSED_PARAMETER(event);
+
+    uint32_t timestamp_us = timebase_now_us();
+
+#if FIFO_READOUT_DMA
+    if (capture_enabled)
+    {
+        if (!frame_limit_enabled || (frame_ring_written(&frame_ring) < frame_limit_total))
+        {
+            uint32_t start = stage_begin();
+
+#if FIFO_SLICE_CHIRPS
+            fifo_dma_slice_ready(timestamp_us);
+#else
+            fifo_dma_start(capture_frame_index, timestamp_us);
+#endif
+            stage_end(STAGE_READOUT, start);
+        }
+
+#if FIFO_SLICE_CHIRPS
+        capture_frame_index = fifo_dma_frame_count();
+#else
+        capture_frame_index++;
+#endif
+    }
+#else
+    data_timestamp_us = timestamp_us;
+    data_available = true;
+#endif
+
+#if defined(COMPONENT_FREERTOS)
+    notify_from_isr(acquire_task_handle);
+#endif
+}
+#endif /* DUAL_CORE_ACQUISITION */
+
+int main(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    /* Initialize the device and board peripherals. */
+    result = cybsp_init();
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    __enable_irq();
+
+    /* Initialize retarget-io to use the debug UART port. */
+    result = cy_retarget_io_init(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX, STREAM_UART_BAUDRATE);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    setvbuf(stdout, NULL, _IONBF, 0);
+    setvbuf(stdin, NULL, _IONBF, 0);
+
+    result = timebase_init();
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+    cycle_counter_init();
+
+    /* Frame data leaves through DMA; status text keeps using stdout while no
+       binary stream is active. */
+    result = uart_tx_init(&cy_retarget_io_uart_obj, CYHAL_ISR_PRIORITY_DEFAULT);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+#if FLASH_RECORDING
+    result = flash_log_init();
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+#endif
+#if PRETRIGGER_CAPTURE
+    frame_history_init(&history, &history_storage[0][0], (uint32_t)sizeof(history_storage[0]));
+#endif
+
+    status_printf("XENSIV BGT60TRxx Example\r\n");
+
+#if DUAL_CORE_ACQUISITION
+    /* The CM0+ brings up the sensor and reads it out into the ring and the
+       slots below; the CM4 only needs the slot layout to unpack frames. */
+    ipc_shared.ring = &frame_ring;
+    ipc_shared.slot_base = &samples[0][0];
+    ipc_shared.slot_samples = FRAME_POOL_SAMPLES;
+    timebase_get_source(&ipc_shared.timebase);
+
+    result = fifo_dma_init_layout(FRAME_POOL_SAMPLES);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_set_frame_samples(NUM_SAMPLES_PER_FRAME);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    ipc_frames_set_callback(acquisition_event);
+    result = ipc_frames_publish(&ipc_shared, CYHAL_ISR_PRIORITY_DEFAULT);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* The CM0+ may calibrate the sensor SPI clock first. */
+    if (!ipc_frames_wait_ready(&ipc_shared, (SPI_CLOCK_CALIBRATION ? 4U : 1U) * IPC_FRAMES_TIMEOUT_US))
+    {
+        CY_ASSERT(0);
+    }
+#else
+    /* Initialize the SPI interface to BGT60. */
+    result = cyhal_spi_init(&cyhal_spi,
+                            PIN_XENSIV_BGT60TRXX_SPI_MOSI,
+                            PIN_XENSIV_BGT60TRXX_SPI_MISO,
+                            PIN_XENSIV_BGT60TRXX_SPI_SCLK,
+                            NC,
+                            NULL,
+                            8,
+                            CYHAL_SPI_MODE_00_MSB,
+                            false);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* Reduce drive strength to improve EMI */
+    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_SLEW_FAST);
+    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_MOSI),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_MOSI), CY_GPIO_DRIVE_1_8);
+    Cy_GPIO_SetSlewRate(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_SLEW_FAST);
+    Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(PIN_XENSIV_BGT60TRXX_SPI_SCLK),
+                        CYHAL_GET_PIN(PIN_XENSIV_BGT60TRXX_SPI_SCLK), CY_GPIO_DRIVE_1_8);
+
+    /* Set SPI data rate to communicate with sensor */
+    result = cyhal_spi_set_frequency(&cyhal_spi, XENSIV_BGT60TRXX_SPI_FREQUENCY);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* Enable the LDO. */
+    result = cyhal_gpio_init(PIN_XENSIV_BGT60TRXX_LDO_EN,
+                             CYHAL_GPIO_DIR_OUTPUT,
+                             CYHAL_GPIO_DRIVE_STRONG,
+                             true);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    /* Wait LDO stable */
+    (void)cyhal_system_delay_ms(5);
+
+    result = xensiv_bgt60trxx_mtb_init(&sensor,
+                                       &cyhal_spi,
+                                       PIN_XENSIV_BGT60TRXX_SPI_CSN,
+                                       PIN_XENSIV_BGT60TRXX_RSTN,
+                                       register_list,
+                                       XENSIV_BGT60TRXX_CONF_NUM_REGS);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+#if SPI_CLOCK_CALIBRATION
+    {
+        /* Before the readout puts the bus into DMA mode. */
+        const cyhal_gpio_t spi_outputs[] = { PIN_XENSIV_BGT60TRXX_SPI_SCLK, PIN_XENSIV_BGT60TRXX_SPI_MOSI };
+
+        spi_clock_calibrated = (spi_calib_run(&sensor, register_list, XENSIV_BGT60TRXX_CONF_NUM_REGS,
+                                              spi_outputs, 2U, XENSIV_BGT60TRXX_SPI_FREQUENCY,
+                                              &spi_clock) == CY_RSLT_SUCCESS);
+    }
+#endif
+
+    /* The sensor will generate an interrupt once the sensor FIFO holds a
+       frame, or a slice of FIFO_SLICE_CHIRPS chirps */
+    result = xensiv_bgt60trxx_mtb_interrupt_init(&sensor,
+                                                 FIFO_DMA_IRQ_SAMPLES(XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *
+                                                                      XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP,
+                                                                      XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME),
+                                                 PIN_XENSIV_BGT60TRXX_IRQ,
+                                                 CYHAL_ISR_PRIORITY_DEFAULT,
+                                                 xensiv_bgt60trxx_mtb_interrupt_handler,
+                                                 NULL);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+#endif /* DUAL_CORE_ACQUISITION */
+
+    result = range_fft_init(XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = cyhal_crc_init(&payload_crc);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    presence_init(&presence_config, XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP / 2U);
+
+#if !DUAL_CORE_ACQUISITION
+#if FIFO_READOUT_DMA
+    result = fifo_dma_init(&sensor, &frame_ring, &samples[0][0], FRAME_POOL_SAMPLES,
+                           CYHAL_ISR_PRIORITY_DEFAULT);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_set_frame_samples(NUM_SAMPLES_PER_FRAME);
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+
+    result = fifo_dma_set_slice_samples(FIFO_DMA_SLICE_SAMPLES(XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS *
+                                                               XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP));
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+#endif
+
+    /* Ensure acquisition is idle until commanded via CLI */
+    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
+#if SPI_CLOCK_CALIBRATION
+#if DUAL_CORE_ACQUISITION
+    spi_clock = ipc_shared.spi_clock;
+    spi_clock_calibrated = ipc_shared.spi_calibrated;
+#endif
+    if (spi_clock_calibrated)
+    {
+        status_printf("Sensor SPI calibrated to %" PRIu32 " kHz, drive %s%s.\r\n",
+                      spi_clock.frequency_hz / 1000U,
+                      spi_calib_drive_name(spi_clock.drive_sel),
+                      (spi_clock.failed_hz == 0U) ? " (limit)" : "");
+    }
+    else
+    {
+        status_printf("Sensor SPI calibration failed, staying at %" PRIu32 " kHz.\r\n",
+                      (uint32_t)(XENSIV_BGT60TRXX_SPI_FREQUENCY / 1000U));
+    }
+#endif
+
+    status_printf("Ready. Type 'start' [frames] [u16|packed12|fft [mag]|presence] [rice] [avg K] [decim D] "
+                  "[rx MASK] [chirps [FIRST:]N] [samples [FIRST:]N] [test RATE] or 'stop' followed by Enter.\r\n");
+
+#if defined(COMPONENT_WICED_BLE)
+    result = ble_events_init();
+    CY_ASSERT(result == CY_RSLT_SUCCESS);
+#endif
+
+#if defined(COMPONENT_FREERTOS)
+    start_tasks();
+    vTaskStartScheduler();
+
+    /* Only reached if the scheduler could not start. */
+    CY_ASSERT(0);
+#else
+    for(;;)
+    {
+        process_cli();
+
+#if DUAL_CORE_ACQUISITION
+        /* FIFO flushes happen on the CM0+. */
+#elif FIFO_READOUT_DMA
+        if (fifo_dma_take_flush_request())
+        {
+            /* A frame was left in the FIFO; discard it before the next one. */
+            fifo_dma_wait();
+            (void)xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_FIFO);
+        }
+#else
+        if (data_available)
+        {
+            data_available = false;
+
+            if (capture_enabled)
+            {
+                (void)acquire_frame(capture_frame_index, data_timestamp_us);
+                capture_frame_index++;
+            }
+        }
+#endif
+
+        (void)link_test_service();
+
+        /* Stop the sensor once enough frames are queued; the ring keeps
+           draining below. */
+        if (capture_enabled && frame_limit_enabled &&
+            (frame_ring_written(&frame_ring) >= frame_limit_total))
+        {
+            (void)stop_sensor();
+        }
+
+#if FLASH_RECORDING
+        /* Background erases; records advance in transmit_service(). */
+        flash_log_service();
+#endif
+
+        bool tx_pending = transmit_service();
+
+        if (tx_pending || capture_enabled)
+        {
+            /* With nothing on the wire only the next sensor frame is due. */
+            wait_for_event(!tx_pending);
+            continue;
+        }
+
+        if (frame_limit_enabled && !capture_enabled && (frame_limit_sent >= frame_limit_total))
+        {
+            uint32_t completed_frames = frame_limit_total;
+
+            frame_limit_enabled = false;
+            frame_limit_total = 0U;
+            frame_limit_sent = 0U;
+            frame_ring_reset(&frame_ring);
+            session_elapsed_us = timebase_wall_us() - session_start_us;
+            binary_stream_active = false;
+            status_printf("Capture completed (%" PRIu32 " frame%s, %" PRIu32 " dropped).\r\n",
+                          completed_frames,
+                          (completed_frames == 1U) ? "" : "s",
+                          frame_ring.dropped);
+        }
+
+        wait_for_event(false);
+    }
+#endif /* COMPONENT_FREERTOS */
+}
+
+static bool parse_frame_count_argument(const char *arg, uint32_t *out_value)
+{
+    if ((arg == NULL) || (out_value == NULL))
+    {
+        return false;
+    }
+
+    while ((*arg == ' ') || (*arg == '\t'))
+    {
+        ++arg;
+    }
+
+    if (*arg == '\0')
+    {
+        *out_value = 0U;
+        return true;
+    }
+
+    uint32_t value = 0U;
+
+    while ((*arg >= '0') && (*arg <= '9'))
+    {
+        uint32_t digit = (uint32_t)(*arg - '0');
+
+        if (value > ((UINT32_MAX - digit) / 10U))
+        {
+            return false;
+        }
+
+        value = (value * 10U) + digit;
+        ++arg;
+    }
+
+    while ((*arg == ' ') || (*arg == '\t'))
+    {
+        ++arg;
+    }
+
+    if (*arg != '\0')
+    {
+        return false;
+    }
+
+    *out_value = value;
+    return true;
+}
+
+/* Parses "[frames] [u16|packed12|fft [mag]|presence] [rice] [avg K] [decim D]
+   [rx MASK] [chirps [FIRST:]COUNT] [samples [FIRST:]COUNT]" in any order.
+   The range FFT and presence formats cannot be combined with compression. */
+static bool parse_start_arguments(const char *arg, start_options_t *options)
+{
+    if ((arg == NULL) || (options == NULL))
+    {
+        return false;
+    }
+
+    options->frames = 0U;
+    options->format = BINARY_FRAME_DEFAULT_FORMAT;
+    options->compress = false;
+    options->chirp_shift = 0U;
+    options->sample_shift = 0U;
+    options->roi = (frame_roi_t) { 0 };
+    options->test_rate_hz = 0U;
+    bool magnitude = false;
+    start_value_t pending = START_VALUE_NONE;
+
+    while (*arg != '\0')
+    {
+        char token[16];
+        uint32_t len = 0U;
+
+        while ((*arg == ' ') || (*arg == '\t'))
+        {
+            ++arg;
+        }
+
+        while ((*arg != '\0') && (*arg != ' ') && (*arg != '\t'))
+        {
+            if (len >= (sizeof(token) - 1U))
+            {
+                return false;
+            }
+
+            token[len++] = *arg++;
+        }
+
+        token[len] = '\0';
+
+        if (len == 0U)
+        {
+            continue;
+        }
+
+        if (pending != START_VALUE_NONE)
+        {
+            uint32_t factor = 0U;
+            uint32_t count = 0U;
+            bool ok;
+
+            switch (pending)
+            {
+                case START_VALUE_AVG:
+                    ok = parse_frame_count_argument(token, &factor) && factor_to_shift(factor, &options->chirp_shift);
+                    break;
+
+                case START_VALUE_DECIM:
+                    ok = parse_frame_count_argument(token, &factor) && factor_to_shift(factor, &options->sample_shift);
+                    break;
+
+                case START_VALUE_RX:
+                    ok = parse_u32_list(token, &options->roi.rx_mask, 1U, &count) && (options->roi.rx_mask != 0U);
+                    break;
+
+                case START_VALUE_CHIRPS:
+                    ok = parse_window_argument(token, &options->roi.first_chirp, &options->roi.num_chirps);
+                    break;
+
+                case START_VALUE_TEST:
+                    ok = parse_frame_count_argument(token, &options->test_rate_hz) &&
+                         (options->test_rate_hz >= LINK_TEST_MIN_RATE_HZ) &&
+                         (options->test_rate_hz <= LINK_TEST_MAX_RATE_HZ);
+                    break;
+
+                default:
+                    ok = parse_window_argument(token, &options->roi.first_sample, &options->roi.num_samples);
+                    break;
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+
+            pending = START_VALUE_NONE;
+        }
+        else if (strcmp(token, "avg") == 0)
+        {
+            pending = START_VALUE_AVG;
+        }
+        else if (strcmp(token, "decim") == 0)
+        {
+            pending = START_VALUE_DECIM;
+        }
+        else if (strcmp(token, "rx") == 0)
+        {
+            pending = START_VALUE_RX;
+        }
+        else if (strcmp(token, "chirps") == 0)
+        {
+            pending = START_VALUE_CHIRPS;
+        }
+        else if (strcmp(token, "samples") == 0)
+        {
+            pending = START_VALUE_SAMPLES;
+        }
+        else if (strcmp(token, "test") == 0)
+        {
+            pending = START_VALUE_TEST;
+        }
+        else if (strcmp(token, "u16") == 0)
+        {
+            options->format = BINARY_FRAME_FORMAT_U16LE;
+        }
+        else if (strcmp(token, "packed12") == 0)
+        {
+            options->format = BINARY_FRAME_FORMAT_PACKED12;
+        }
+        else if (strcmp(token, "fft") == 0)
+        {
+            options->format = BINARY_FRAME_FORMAT_RANGE_CINT16;
+        }
+        else if (strcmp(token, "presence") == 0)
+        {
+            options->format = BINARY_FRAME_FORMAT_PRESENCE;
+        }
+        else if (strcmp(token, "mag") == 0)
+        {
+            magnitude = true;
+        }
+        else if (strcmp(token, "rice") == 0)
+        {
+            options->compress = true;
+        }
+        else if (!parse_frame_count_argument(token, &options->frames))
+        {
+            return false;
+        }
+    }
+
+    if (pending != START_VALUE_NONE)
+    {
+        return false;
+    }
+
+    if (magnitude)
+    {
+        if (options->format != BINARY_FRAME_FORMAT_RANGE_CINT16)
+        {
+            return false;
+        }
+
+        options->format = BINARY_FRAME_FORMAT_RANGE_MAG_U16;
+    }
+
+    return start_options_valid(options);
+}
+
+/* Parses "COUNT" or "FIRST:COUNT"; a bare count starts at 0. */
+static bool parse_window_argument(const char *arg, uint32_t *first, uint32_t *count)
+{
+    const char *colon = strchr(arg, ':');
+    char head[16];
+
+    if (colon == NULL)
+    {
+        *first = 0U;
+        return parse_frame_count_argument(arg, count) && (*count > 0U);
+    }
+
+    if ((colon == arg) || ((uint32_t)(colon - arg) >= sizeof(head)))
+    {
+        return false;
+    }
+
+    memcpy(head, arg, (size_t)(colon - arg));
+    head[colon - arg] = '\0';
+
+    return parse_frame_count_argument(head, first) &&
+           parse_frame_count_argument(colon + 1, count) && (*count > 0U);
+}
+
+/* Fills in the region of interest of the options against the active
+   profile: a zero antenna mask selects every antenna, a zero count every
+   chirp or sample from the first one. */
+static void resolve_roi(const start_options_t *options, frame_roi_t *roi)
+{
+    *roi = options->roi;
+
+    if (roi->rx_mask == 0U)
+    {
+        roi->rx_mask = (1UL << geometry.num_rx) - 1U;
+    }
+
+    if ((roi->num_chirps == 0U) && (roi->first_chirp < geometry.num_chirps))
+    {
+        roi->num_chirps = geometry.num_chirps - roi->first_chirp;
+    }
+
+    if ((roi->num_samples == 0U) && (roi->first_sample < geometry.num_samples_per_chirp))
+    {
+        roi->num_samples = geometry.num_samples_per_chirp - roi->first_sample;
+    }
+}
+
+/* Range and presence payloads are not Rice coded. The region of interest
+   must lie within the frame of the active profile and keep a power-of-two
+   chirp length for the range FFT. Averaging and decimation must divide the
+   region and leave a chirp long enough for the range FFT. Link test frames
+   are sent as raw samples, whole chirps only, so the host can check every
+   byte against the pattern. */
+static bool start_options_valid(const start_options_t *options)
+{
+    frame_roi_t roi;
+
+    resolve_roi(options, &roi);
+
+    if ((options->test_rate_hz > 0U) &&
+        ((options->format > BINARY_FRAME_FORMAT_PACKED12) ||
+         (options->chirp_shift > 0U) || (options->sample_shift > 0U) ||
+         (options->roi.rx_mask != 0U) || (options->roi.num_samples != 0U) ||
+         (options->roi.first_sample != 0U)))
+    {
+        return false;
+    }
+
+    return (options->format <= BINARY_FRAME_FORMAT_PRESENCE) &&
+           !(options->compress && (options->format >= BINARY_FRAME_FORMAT_RANGE_CINT16)) &&
+           ((roi.rx_mask >> geometry.num_rx) == 0U) &&
+           (roi.first_chirp < geometry.num_chirps) &&
+           (roi.num_chirps > 0U) && (roi.num_chirps <= (geometry.num_chirps - roi.first_chirp)) &&
+           (roi.first_sample < geometry.num_samples_per_chirp) &&
+           (roi.num_samples > 0U) && (roi.num_samples <= (geometry.num_samples_per_chirp - roi.first_sample)) &&
+           ((roi.num_samples & (roi.num_samples - 1U)) == 0U) &&
+           (options->chirp_shift <= CHIRP_AVERAGE_MAX_SHIFT) &&
+           (options->sample_shift <= CHIRP_AVERAGE_MAX_SHIFT) &&
+           ((roi.num_chirps >> options->chirp_shift) > 0U) &&
+           (((roi.num_chirps >> options->chirp_shift) << options->chirp_shift) == roi.num_chirps) &&
+           ((roi.num_samples >> options->sample_shift) >= RADAR_PROFILE_MIN_SAMPLES);
+}
+
+/* Accepts powers of two only. */
+static bool factor_to_shift(uint32_t factor, uint32_t *shift)
+{
+    uint32_t n = 0U;
+
+    if ((factor == 0U) || ((factor & (factor - 1U)) != 0U))
+    {
+        return false;
+    }
+
+    while ((1UL << n) < factor)
+    {
+        n++;
+    }
+
+    *shift = n;
+    return true;
+}
+
+/* Starts a capture session with the given options. Returns a
+   CONTROL_STATUS_* code for the binary protocol. */
+static uint8_t start_capture(const start_options_t *options)
+{
+    uint32_t requested_frames = options->frames;
+
+    if (capture_enabled || binary_stream_active)
+    {
+        status_printf("Capture already running.\r\n");
+        return CONTROL_STATUS_BUSY;
+    }
+
+#if PRETRIGGER_CAPTURE
+    /* A pre-trigger session runs until 'stop' and owns the link. */
+#if FLASH_RECORDING
+    if (pretrigger_enabled && ((requested_frames > 0U) || record_enabled))
+#else
+    if (pretrigger_enabled && (requested_frames > 0U))
+#endif
+    {
+        status_printf("Pre-trigger captures are continuous and streamed.\r\n");
+        return CONTROL_STATUS_INVALID;
+    }
+
+    if (pretrigger_enabled && (options->test_rate_hz > 0U))
+    {
+        status_printf("Link test frames bypass the pre-trigger history.\r\n");
+        return CONTROL_STATUS_INVALID;
+    }
+#endif
+
+    frame_ring_reset(&frame_ring);
+    frame_ring.dropped = 0U;
+    uart_tx_reset_stats();
+#if FIFO_READOUT_DMA && !DUAL_CORE_ACQUISITION
+    fifo_dma_reset_stats();
+    fifo_dma_restart();
+#endif
+#if STAGE_TIMING
+    for (uint32_t i = 0U; i < (uint32_t)STAGE_COUNT; i++)
+    {
+        cycle_stats_reset(&stage_stats[i]);
+    }
+#endif
+    tx_slot = -1;
+    tx_phase = TX_PHASE_IDLE;
+#if FLASH_RECORDING
+    stream_to_flash = record_enabled;
+#endif
+    stream_format = options->format;
+    stream_compress = options->compress;
+    stream_chirp_shift = options->chirp_shift;
+    stream_sample_shift = options->sample_shift;
+#if PRETRIGGER_CAPTURE
+    stream_pretrigger = pretrigger_enabled;
+    pretrigger_state = PRETRIGGER_ARMED;
+    pretrigger_loss_pending = false;
+    pretrigger_bursts = 0U;
+    pretrigger_uploaded = 0U;
+    pretrigger_lost = 0U;
+    frame_history_reset(&history);
+    motion_trigger_init(geometry.num_samples_per_chirp * geometry.num_rx, pretrigger_ratio);
+#endif
+    resolve_roi(options, &stream_roi);
+    stream_roi_active = (stream_roi.num_chirps != geometry.num_chirps) ||
+                        (stream_roi.num_samples != geometry.num_samples_per_chirp) ||
+                        (stream_roi.rx_mask != ((1UL << geometry.num_rx) - 1U));
+
+    /* The processing stages see the chirp length of the region after
+       decimation. */
+    const uint32_t num_samples = stream_roi.num_samples >> stream_sample_shift;
+
+    if (range_fft_init(num_samples) != CY_RSLT_SUCCESS)
+    {
+        status_printf("Failed to start capture.\r\n");
+        return CONTROL_STATUS_FAILED;
+    }
+
+    presence_init(&presence_config, num_samples / 2U);
+    presence_reset();
+    session_start_us = timebase_wall_us();
+    session_idle_us = 0U;
+    session_deepsleep_us = 0U;
+    stream_test = (options->test_rate_hz > 0U);
+    stream_test_rate_hz = options->test_rate_hz;
+
+    bool started;
+
+    if (stream_test)
+    {
+#if defined(COMPONENT_FREERTOS)
+        const link_test_callback_t callback = link_test_event;
+#else
+        const link_test_callback_t callback = NULL;
+#endif
+
+        /* Frames fall due from the timer; the sensor stays idle. */
+        capture_frame_index = 0U;
+        started = (link_test_start(stream_test_rate_hz, CYHAL_ISR_PRIORITY_DEFAULT, callback) == CY_RSLT_SUCCESS);
+    }
+    else
+    {
+#if DUAL_CORE_ACQUISITION
+        /* The CM0+ resets its readout statistics and stops reading out once
+           the ring saw requested_frames frames. */
+        ipc_shared.frame_limit = requested_frames;
+        capture_frame_index = 0U;
+        started = ipc_frames_command(&ipc_shared, IPC_FRAMES_CMD_START);
+#else
+        started = (xensiv_bgt60trxx_start_frame(&sensor.dev, true) == XENSIV_BGT60TRXX_STATUS_OK);
+#endif
+    }
+
+    if (!started)
+    {
+        stream_test = false;
+        status_printf("Failed to start capture.\r\n");
+        return CONTROL_STATUS_FAILED;
+    }
+
+    capture_enabled = true;
+    data_available = false;
+    frame_limit_enabled = (requested_frames > 0U);
+    frame_limit_total = requested_frames;
+    frame_limit_sent = 0U;
+
+    if (frame_limit_enabled)
+    {
+        status_printf("Capture started (%" PRIu32 " frame%s).\r\n",
+                      requested_frames,
+                      (requested_frames == 1U) ? "" : "s");
+    }
+    else
+    {
+        status_printf("Capture started (continuous).\r\n");
+    }
+
+    binary_stream_active = true;
+    return CONTROL_STATUS_OK;
+}
+
+/* Ends the capture session; the frame already on the wire is completed so
+   the host stays in sync and whatever is still queued is discarded. */
+static uint8_t stop_capture(void)
+{
+    if (!capture_enabled && !binary_stream_active)
+    {
+        status_printf("Capture already stopped.\r\n");
+        return CONTROL_STATUS_OK;
+    }
+
+    if (capture_enabled && !stop_sensor())
+    {
+        status_printf("Failed to stop capture.\r\n");
+        return CONTROL_STATUS_FAILED;
+    }
+
+#if defined(COMPONENT_FREERTOS)
+    drain_pipeline();
+#else
+#if PRETRIGGER_CAPTURE
+    while ((tx_slot >= 0) || tx_history)
+#else
+    while (tx_slot >= 0)
+#endif
+    {
+        (void)transmit_service();
+    }
+
+    frame_ring_reset(&frame_ring);
+#endif
+#if PRETRIGGER_CAPTURE
+    /* A burst not yet uploaded is discarded with the queued frames. */
+    stream_pretrigger = false;
+    frame_history_reset(&history);
+#endif
+    frame_limit_enabled = false;
+    frame_limit_total = 0U;
+    frame_limit_sent = 0U;
+    session_elapsed_us = timebase_wall_us() - session_start_us;
+    binary_stream_active = false;
+    status_printf("Capture stopped (%" PRIu32 " frame%s dropped).\r\n",
+                  frame_ring.dropped,
+                  (frame_ring.dropped == 1U) ? "" : "s");
+    return CONTROL_STATUS_OK;
+}
+
+/* Parses up to max_values whitespace separated numbers (decimal, or hex with
+   0x). Fails on anything else or on too many values. */
+static bool parse_u32_list(const char *arg, uint32_t *values, uint32_t max_values, uint32_t *count)
+{
+    uint32_t n = 0U;
+
+    for (;;)
+    {
+        while ((*arg == ' ') || (*arg == '\t'))
+        {
+            ++arg;
+        }
+
+        if (*arg == '\0')
+        {
+            break;
+        }
+
+        char *end = NULL;
+        unsigned long value = strtoul(arg, &end, 0);
+
+        if ((end == arg) || ((*end != '\0') && (*end != ' ') && (*end != '\t')) ||
+            ((uint64_t)value > UINT32_MAX) || (n >= max_values))
+        {
+            return false;
+        }
+
+        values[n++] = (uint32_t)value;
+        arg = end;
+    }
+
+    *count = n;
+    return true;
+}
+
+/* The range FFT needs a power-of-two chirp length, the frame has to fit a
+   preallocated slot and, with FIFO_SLICE_CHIRPS, split into whole slices. */
+static bool profile_geometry_valid(const frame_geometry_t *new_geometry)
+{
+    const uint32_t spc = new_geometry->num_samples_per_chirp;
+    const uint64_t new_samples = (uint64_t)spc * new_geometry->num_chirps * new_geometry->num_rx;
+
+    return (spc >= RADAR_PROFILE_MIN_SAMPLES) && (spc <= RANGE_FFT_MAX_SIZE) && ((spc & (spc - 1U)) == 0U) &&
+           (new_geometry->num_chirps > 0U) &&
+           (new_geometry->num_rx > 0U) && (new_geometry->num_rx <= RADAR_PROFILE_MAX_RX) &&
+           (new_samples <= FRAME_POOL_SAMPLES) &&
+           ((FIFO_SLICE_CHIRPS == 0) ||
+            (((new_geometry->num_chirps % (uint32_t)FIFO_SLICE_CHIRPS) == 0U) &&
+             (FIFO_DMA_SLICE_SAMPLES(spc * new_geometry->num_rx) <= FIFO_DMA_MAX_SLICE_SAMPLES)));
+}
+
+/* Loads a register list into the idle sensor and adapts the FIFO threshold,
+   the readout and the processing stages to the frame geometry it produces.
+   The sample pool is preallocated, so only the sizes change. */
+static bool apply_profile(const uint32_t *regs, uint32_t num_regs, const frame_geometry_t *new_geometry)
+{
+    const uint32_t spc = new_geometry->num_samples_per_chirp;
+    const uint32_t new_samples = spc * new_geometry->num_chirps * new_geometry->num_rx;
+    const uint32_t slice_samples = FIFO_DMA_SLICE_SAMPLES(spc * new_geometry->num_rx);
+
+    if ((num_regs == 0U) || !profile_geometry_valid(new_geometry))
+    {
+        return false;
+    }
+
+#if DUAL_CORE_ACQUISITION
+    if (num_regs > IPC_FRAMES_MAX_REGS)
+    {
+        return false;
+    }
+
+    (void)memcpy(ipc_shared.regs, regs, num_regs * sizeof(uint32_t));
+    ipc_shared.num_regs = num_regs;
+    ipc_shared.samples_per_frame = new_samples;
+    ipc_shared.slice_samples = slice_samples;
+
+    if (!ipc_frames_command(&ipc_shared, IPC_FRAMES_CMD_PROFILE) ||
+        (range_fft_init(spc) != CY_RSLT_SUCCESS))
+#else
+    if ((xensiv_bgt60trxx_soft_reset(&sensor.dev, XENSIV_BGT60TRXX_RESET_SW) != XENSIV_BGT60TRXX_STATUS_OK) ||
+        (xensiv_bgt60trxx_config(&sensor.dev, regs, num_regs) != XENSIV_BGT60TRXX_STATUS_OK) ||
+        (xensiv_bgt60trxx_set_fifo_limit(&sensor.dev, (slice_samples > 0U) ? slice_samples : new_samples) !=
+         XENSIV_BGT60TRXX_STATUS_OK) ||
+        (range_fft_init(spc) != CY_RSLT_SUCCESS))
+#endif
+    {
+        return false;
+    }
+
+#if FIFO_READOUT_DMA
+    if ((fifo_dma_set_frame_samples(new_samples) != CY_RSLT_SUCCESS) ||
+        (fifo_dma_set_slice_samples(slice_samples) != CY_RSLT_SUCCESS))
+    {
+        return false;
+    }
+#endif
+
+    geometry = *new_geometry;
+    samples_per_frame = new_samples;
+    presence_init(&presence_config, spc / 2U);
+    return true;
+}
+
+static bool restore_default_profile(void)
+{
+    if (!apply_profile(register_list, XENSIV_BGT60TRXX_CONF_NUM_REGS, &default_geometry))
+    {
+        status_printf("Failed to restore the built-in profile.\r\n");
+        return false;
+    }
+
+    custom_profile_active = false;
+    return true;
+}
+
+/* 'profile' [clear | reg <word>... | apply <samples> <chirps> <rx> | default] */
+static void handle_profile_command(const char *arg)
+{
+    while ((*arg == ' ') || (*arg == '\t'))
+    {
+        ++arg;
+    }
+
+    if (*arg == '\0')
+    {
+        status_printf("Profile: %s, %" PRIu32 " samples x %" PRIu32 " chirps x %" PRIu32 " RX (%" PRIu32 " of %" PRIu32 " samples per slot), %" PRIu32 " registers staged.\r\n",
+                      custom_profile_active ? "custom" : "built-in",
+                      geometry.num_samples_per_chirp,
+                      geometry.num_chirps,
+                      geometry.num_rx,
+                      samples_per_frame,
+                      (uint32_t)FRAME_POOL_SAMPLES,
+                      profile_num_regs);
+        return;
+    }
+
+    if (capture_enabled || binary_stream_active)
+    {
+        status_printf("Stop the capture before changing the profile.\r\n");
+        return;
+    }
+
+    if (strcmp(arg, "clear") == 0)
+    {
+        profile_num_regs = 0U;
+        status_printf("Profile registers cleared.\r\n");
+    }
+    else if ((strncmp(arg, "reg", 3) == 0) && ((arg[3] == ' ') || (arg[3] == '\t')))
+    {
+        uint32_t count = 0U;
+
+        if (!parse_u32_list(arg + 3, &profile_regs[profile_num_regs],
+                            RADAR_PROFILE_MAX_REGS - profile_num_regs, &count))
+        {
+            status_printf("Invalid register words (at most %u in total).\r\n",
+                          (unsigned int)RADAR_PROFILE_MAX_REGS);
+            return;
+        }
+
+        profile_num_regs += count;
+        status_printf("%" PRIu32 " registers staged.\r\n", profile_num_regs);
+    }
+    else if ((strncmp(arg, "apply", 5) == 0) && ((arg[5] == ' ') || (arg[5] == '\t')))
+    {
+        uint32_t values[3];
+        uint32_t count = 0U;
+
+        if (!parse_u32_list(arg + 5, values, 3U, &count) || (count != 3U))
+        {
+            status_printf("Usage: profile apply <samples per chirp> <chirps> <rx antennas>\r\n");
+            return;
+        }
+
+        const frame_geometry_t new_geometry = {
+            .num_samples_per_chirp = values[0],
+            .num_chirps = values[1],
+            .num_rx = values[2]
+        };
+
+        if ((profile_num_regs == 0U) || !profile_geometry_valid(&new_geometry))
+        {
+            status_printf("Invalid profile: stage registers first; samples per chirp must be a power of two "
+                          "from %u to %u, at most %u RX, at most %u samples per frame.\r\n",
+                          (unsigned int)RADAR_PROFILE_MIN_SAMPLES,
+                          (unsigned int)RANGE_FFT_MAX_SIZE,
+                          (unsigned int)RADAR_PROFILE_MAX_RX,
+                          (unsigned int)FRAME_POOL_SAMPLES);
+            return;
+        }
+
+        /* From here on the sensor is reprogrammed; fall back to a known
+           profile if anything fails. */
+        if (apply_profile(profile_regs, profile_num_regs, &new_geometry))
+        {
+            custom_profile_active = true;
+            status_printf("Profile applied (%" PRIu32 " samples per frame).\r\n", samples_per_frame);
+        }
+        else
+        {
+            status_printf("Profile rejected by the sensor; restoring the built-in profile.\r\n");
+            (void)restore_default_profile();
+        }
+    }
+    else if (strcmp(arg, "default") == 0)
+    {
+        if (restore_default_profile())
+        {
+            status_printf("Built-in profile restored.\r\n");
+        }
+    }
+    else
+    {
+        status_printf("Unknown profile command: %s\r\n", arg);
     }
+}
 
-    status_printf("Ready. Type 'start' [frames] or 'stop' followed by Enter.\r\n");
-
-    uint32_t frame_idx = 0;
+#if FLASH_RECORDING
+/* Sends every record as it was written, so a dump of recorded frames reads
+   like a live capture. */
+static void dump_recording(void)
+{
+    const uint8_t *data = NULL;
+    uint32_t length = 0U;
 
-    for(;;)
+    if (flash_log_read_begin() != CY_RSLT_SUCCESS)
     {
-        process_cli();
+        status_printf("Flash log busy.\r\n");
+        return;
+    }
 
-        if (!capture_enabled)
+    while (flash_log_read_next(&data, &length))
+    {
+        if (uart_tx_start(data, length) != CY_RSLT_SUCCESS)
         {
-            cyhal_system_delay_ms(10);
-            continue;
+            break;
         }
 
-        /* Wait for the radar device to indicate the availability of the data to fetch. */
-        while ((capture_enabled == true) && (data_available == false))
-        {
-            process_cli();
-            cyhal_system_delay_ms(1);
-        }
+        uart_tx_wait();
+    }
 
-        if (!capture_enabled)
-        {
-            continue;
-        }
+    flash_log_read_end();
+    status_printf("Dump complete.\r\n");
+}
 
-        data_available = false;
+static void print_recording_info(void)
+{
+    flash_log_stats_t log_stats;
+    flash_log_get_stats(&log_stats);
+
+    status_printf("Recording %s; %" PRIu32 " of %" PRIu32 " sectors of %" PRIu32 " KB used, %" PRIu32 " erased ahead.\r\n",
+                  record_enabled ? "on" : "off",
+                  log_stats.used_sectors,
+                  log_stats.num_sectors,
+                  log_stats.sector_size / 1024U,
+                  log_stats.erased_ahead);
+    status_printf("Sector erases: %" PRIu32 " min, %" PRIu32 " max.\r\n",
+                  log_stats.min_erase_count,
+                  log_stats.max_erase_count);
+}
 
-        if (xensiv_bgt60trxx_get_fifo_data(&sensor.dev, samples,
-                                           NUM_SAMPLES_PER_FRAME) == XENSIV_BGT60TRXX_STATUS_OK)
-        {
-            send_frame_binary(frame_idx);
-            frame_idx++;
+/* 'record on|off' selects where the frames of the next capture go; 'arm',
+   'clear' and 'dump' need a stopped capture. */
+static void handle_record_command(const char *arg)
+{
+    while ((*arg == ' ') || (*arg == '\t'))
+    {
+        ++arg;
+    }
 
-            if (frame_limit_enabled)
-            {
-                frame_limit_sent++;
+    if ((*arg == '\0') || (strcmp(arg, "info") == 0))
+    {
+        print_recording_info();
+    }
+    else if (strcmp(arg, "on") == 0)
+    {
+        record_enabled = true;
+        status_printf("Captures are recorded to flash.\r\n");
+    }
+    else if (strcmp(arg, "off") == 0)
+    {
+        record_enabled = false;
+        status_printf("Captures are streamed.\r\n");
+    }
+    else if (capture_enabled || binary_stream_active)
+    {
+        status_printf("Stop the capture first.\r\n");
+    }
+    else if ((strncmp(arg, "arm", 3) == 0) &&
+             ((arg[3] == '\0') || (arg[3] == ' ') || (arg[3] == '\t')))
+    {
+        uint32_t sectors = 0U;
 
-                if (frame_limit_sent >= frame_limit_total)
-                {
-                    uint32_t completed_frames = frame_limit_total;
-
-                    if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) == XENSIV_BGT60TRXX_STATUS_OK)
-                    {
-                        capture_enabled = false;
-                        data_available = false;
-                        frame_limit_enabled = false;
-                        frame_limit_total = 0U;
-                        frame_limit_sent = 0U;
-                        binary_stream_active = false;
-                        status_printf("Capture completed (%" PRIu32 " frame%s).\r\n",
-                                      completed_frames,
-                                      (completed_frames == 1U) ? "" : "s");
-                    }
-                    else
-                    {
-                        status_printf("Failed to stop capture.\r\n");
-                    }
-                }
-            }
+        if (!parse_frame_count_argument(arg + 3, &sectors))
+        {
+            status_printf("Invalid sector count.\r\n");
+            return;
         }
+
+        /* The erases run in the background. */
+        flash_log_reserve(sectors);
+        status_printf("Erasing up to %" PRIu32 " sectors ahead.\r\n", sectors);
+    }
+    else if (strcmp(arg, "clear") == 0)
+    {
+        flash_log_clear();
+        status_printf("Recording cleared.\r\n");
+    }
+    else if (strcmp(arg, "dump") == 0)
+    {
+        dump_recording();
+    }
+    else
+    {
+        status_printf("Unknown record command: %s\r\n", arg);
     }
 }
+#endif
 
-static bool parse_frame_count_argument(const char *arg, uint32_t *out_value)
+/* 'baud' shows the UART rate; 'baud <rate>' negotiates a new one with the
+   host. The reply goes out at the old rate and both sides switch. The host
+   then sends 'baud verify <UART_BAUD_VERIFY_PATTERN>' at the new rate, the
+   firmware echoes it, and the host confirms an intact echo with 'baud
+   commit'. A step that does not arrive intact within
+   UART_BAUD_STEP_TIMEOUT_MS switches back to the old rate. */
+static void handle_baud_command(const char *arg)
 {
-    if ((arg == NULL) || (out_value == NULL))
-    {
-        return false;
-    }
+    cyhal_uart_t *uart = &cy_retarget_io_uart_obj;
+    char line[64];
+    uint32_t baud = 0U;
 
     while ((*arg == ' ') || (*arg == '\t'))
     {
@@ -287,38 +3182,105 @@ static bool parse_frame_count_argument(const char *arg, uint32_t *out_value)
 
     if (*arg == '\0')
     {
-        *out_value = 0U;
-        return true;
+        status_printf("UART: %" PRIu32 " baud, 'baud <%" PRIu32 "-%" PRIu32 ">' to negotiate.\r\n",
+                      stream_baud,
+                      (uint32_t)UART_BAUD_MIN,
+                      (uint32_t)UART_BAUD_MAX);
+        return;
     }
 
-    uint32_t value = 0U;
+    if (capture_enabled || binary_stream_active)
+    {
+        status_printf("Stop the capture before changing the baud rate.\r\n");
+        return;
+    }
 
-    while ((*arg >= '0') && (*arg <= '9'))
+    if (!parse_frame_count_argument(arg, &baud))
     {
-        uint32_t digit = (uint32_t)(*arg - '0');
+        status_printf("Invalid baud rate: %s\r\n", arg);
+        return;
+    }
 
-        if (value > ((UINT32_MAX - digit) / 10U))
-        {
-            return false;
-        }
+    uint32_t actual = uart_baud_achievable(uart, stream_baud, baud);
 
-        value = (value * 10U) + digit;
-        ++arg;
+    if (actual == 0U)
+    {
+        status_printf("Baud: %" PRIu32 " not supported.\r\n", baud);
+        return;
+    }
+
+    status_printf("Baud: switching to %" PRIu32 " (actual %" PRIu32 ").\r\n", baud, actual);
+
+    bool ok = (uart_baud_set(uart, baud) == CY_RSLT_SUCCESS) &&
+              uart_baud_read_line(uart, line, sizeof(line), UART_BAUD_STEP_TIMEOUT_MS) &&
+              (strcmp(line, "baud verify " UART_BAUD_VERIFY_PATTERN) == 0);
+
+    if (ok)
+    {
+        status_printf("baud verify " UART_BAUD_VERIFY_PATTERN "\r\n");
+        ok = uart_baud_read_line(uart, line, sizeof(line), UART_BAUD_STEP_TIMEOUT_MS) &&
+             (strcmp(line, "baud commit") == 0);
+    }
+
+    if (!ok)
+    {
+        (void)uart_baud_set(uart, stream_baud);
+        status_printf("Baud negotiation failed, back at %" PRIu32 " baud.\r\n", stream_baud);
+        return;
     }
 
+    stream_baud = baud;
+    status_printf("Baud rate now %" PRIu32 ".\r\n", stream_baud);
+}
+
+#if PRETRIGGER_CAPTURE
+/* 'trigger on [<pre> [<post> [<ratio>]]]' makes the next captures pre-trigger
+   sessions, 'trigger off' streams them again; 'trigger' alone shows the
+   settings. */
+static void handle_trigger_command(const char *arg)
+{
     while ((*arg == ' ') || (*arg == '\t'))
     {
         ++arg;
     }
 
-    if (*arg != '\0')
+    if ((strncmp(arg, "on", 2) == 0) && ((arg[2] == '\0') || (arg[2] == ' ') || (arg[2] == '\t')))
     {
-        return false;
+        uint32_t values[3] = { FRAME_HISTORY_SLOTS, 0U, PRETRIGGER_DEFAULT_RATIO };
+        uint32_t count = 0U;
+
+        if (!parse_u32_list(arg + 2, values, 3U, &count) ||
+            (values[0] == 0U) || (values[0] > FRAME_HISTORY_SLOTS) || (values[2] == 0U))
+        {
+            status_printf("Usage: trigger on [<pre 1-%u> [<post> [<ratio>]]]\r\n",
+                          (unsigned int)FRAME_HISTORY_SLOTS);
+            return;
+        }
+
+        pretrigger_enabled = true;
+        pretrigger_pre = values[0];
+        pretrigger_post = values[1];
+        pretrigger_ratio = values[2];
+    }
+    else if (strcmp(arg, "off") == 0)
+    {
+        pretrigger_enabled = false;
+    }
+    else if (*arg != '\0')
+    {
+        status_printf("Unknown trigger command: %s\r\n", arg);
+        return;
     }
 
-    *out_value = value;
-    return true;
+    status_printf("Pre-trigger capture %s: %" PRIu32 " frames up to the trigger, %" PRIu32 " after it, "
+                  "motion above %" PRIu32 "x background (history: %u frames).\r\n",
+                  pretrigger_enabled ? "on" : "off",
+                  pretrigger_pre,
+                  pretrigger_post,
+                  pretrigger_ratio,
+                  (unsigned int)FRAME_HISTORY_SLOTS);
 }
+#endif
 
 static void handle_command(const char *cmd)
 {
@@ -335,45 +3297,15 @@ static void handle_command(const char *cmd)
     if ((strncmp(cmd, "start", 5) == 0) &&
         ((cmd[5] == '\0') || (cmd[5] == ' ') || (cmd[5] == '\t')))
     {
-        uint32_t requested_frames = 0U;
-
-        if (!parse_frame_count_argument(cmd + 5, &requested_frames))
-        {
-            status_printf("Invalid frame count.\r\n");
-            return;
-        }
+        start_options_t options;
 
-        if (capture_enabled)
+        if (!parse_start_arguments(cmd + 5, &options))
         {
-            status_printf("Capture already running.\r\n");
+            status_printf("Invalid start arguments.\r\n");
             return;
         }
 
-        if (xensiv_bgt60trxx_start_frame(&sensor.dev, true) == XENSIV_BGT60TRXX_STATUS_OK)
-        {
-            capture_enabled = true;
-            data_available = false;
-            frame_limit_enabled = (requested_frames > 0U);
-            frame_limit_total = requested_frames;
-            frame_limit_sent = 0U;
-
-            if (frame_limit_enabled)
-            {
-                status_printf("Capture started (%" PRIu32 " frame%s).\r\n",
-                              requested_frames,
-                              (requested_frames == 1U) ? "" : "s");
-            }
-            else
-            {
-                status_printf("Capture started (continuous).\r\n");
-            }
-
-            binary_stream_active = true;
-        }
-        else
-        {
-            status_printf("Failed to start capture.\r\n");
-        }
+        (void)start_capture(&options);
     }
     else if ((strncmp(cmd, "stop", 4) == 0) &&
              ((cmd[4] == '\0') || (cmd[4] == ' ') || (cmd[4] == '\t')))
@@ -391,51 +3323,321 @@ static void handle_command(const char *cmd)
             return;
         }
 
-        if (!capture_enabled)
+        (void)stop_capture();
+    }
+    else if (strcmp(cmd, "stats") == 0)
+    {
+        print_stats();
+    }
+    else if (strcmp(cmd, "timing") == 0)
+    {
+        print_stage_timing(true);
+    }
+    else if ((strncmp(cmd, "profile", 7) == 0) &&
+             ((cmd[7] == '\0') || (cmd[7] == ' ') || (cmd[7] == '\t')))
+    {
+        handle_profile_command(cmd + 7);
+    }
+    else if ((strncmp(cmd, "baud", 4) == 0) &&
+             ((cmd[4] == '\0') || (cmd[4] == ' ') || (cmd[4] == '\t')))
+    {
+        handle_baud_command(cmd + 4);
+    }
+#if PRETRIGGER_CAPTURE
+    else if ((strncmp(cmd, "trigger", 7) == 0) &&
+             ((cmd[7] == '\0') || (cmd[7] == ' ') || (cmd[7] == '\t')))
+    {
+        handle_trigger_command(cmd + 7);
+    }
+#endif
+#if FLASH_RECORDING
+    else if ((strncmp(cmd, "record", 6) == 0) &&
+             ((cmd[6] == '\0') || (cmd[6] == ' ') || (cmd[6] == '\t')))
+    {
+        handle_record_command(cmd + 6);
+    }
+#endif
+#if defined(COMPONENT_FREERTOS)
+    else if (strcmp(cmd, "tasks") == 0)
+    {
+        print_task_stats();
+    }
+#endif
+    else if (*cmd != '\0')
+    {
+        status_printf("Unknown command: %s\r\n", cmd);
+    }
+}
+
+static bool control_response_space(void)
+{
+    return ((control_head - control_tail) < CONTROL_RESPONSE_SLOTS);
+}
+
+/* Queues the answer to a binary request as a BINARY_FRAME_FORMAT_CONTROL
+   frame. The caller made sure a response slot is free. */
+static void queue_response(const control_request_header_t *request, uint8_t status,
+                           const void *data, uint32_t length)
+{
+    const uint32_t slot = control_head % CONTROL_RESPONSE_SLOTS;
+    control_response_t *response = &control_response[slot];
+
+    if (length > CONTROL_RESPONSE_MAX_DATA)
+    {
+        length = CONTROL_RESPONSE_MAX_DATA;
+    }
+
+    response->response = (control_response_header_t) {
+        .request_id = request->request_id,
+        .opcode = request->opcode,
+        .status = status
+    };
+
+    if (length > 0U)
+    {
+        memcpy(response->data, data, length);
+    }
+
+    const uint32_t size = (uint32_t)sizeof(control_response_header_t) + length;
+
+    control_header[slot] = (binary_frame_header_t) {
+        .magic = {'R', 'A', 'D', 'R'},
+        .version = BINARY_FRAME_HEADER_VERSION,
+        .sample_size_bytes = 1U,
+        .frame_index = capture_frame_index,
+        .sample_count = size,
+        .sample_format = BINARY_FRAME_FORMAT_CONTROL,
+        .flags = 0U,
+        .payload_size = size,
+        .timestamp_us = timebase_now_us(),
+        .payload_crc32 = compute_crc32((const uint8_t *)response, size)
+    };
+
+    control_head++;
+
+#if defined(COMPONENT_FREERTOS)
+    const tx_job_t job = {
+        .slot = -1,
+        .header = &control_header[slot],
+        .payload = (const uint8_t *)response
+    };
+
+    (void)xQueueSend(tx_queue, &job, portMAX_DELAY);
+#endif
+}
+
+static void handle_request(const control_request_header_t *request, const uint8_t *payload)
+{
+    const bool busy = capture_enabled || binary_stream_active;
+    uint8_t status = CONTROL_STATUS_OK;
+    control_status_data_t device_status;
+    const void *data = NULL;
+    uint32_t length = 0U;
+
+    switch (request->opcode)
+    {
+        case CONTROL_OP_PING:
+            break;
+
+        case CONTROL_OP_START:
         {
-            status_printf("Capture already stopped.\r\n");
-            return;
+            control_start_roi_t start = { 0 };
+
+            if ((request->length != sizeof(start.start)) && (request->length != sizeof(start)))
+            {
+                status = CONTROL_STATUS_BAD_LENGTH;
+                break;
+            }
+
+            memcpy(&start, payload, request->length);
+
+            const start_options_t options = {
+                .frames = start.start.frames,
+                .format = start.start.sample_format,
+                .compress = (start.start.compress != 0U),
+                .chirp_shift = (start.start.reduction >> REDUCTION_CHIRP_SHIFT_POS) & REDUCTION_SHIFT_MSK,
+                .sample_shift = (start.start.reduction >> REDUCTION_SAMPLE_SHIFT_POS) & REDUCTION_SHIFT_MSK,
+                .roi = {
+                    .rx_mask = start.rx_mask,
+                    .first_chirp = start.first_chirp,
+                    .num_chirps = start.num_chirps,
+                    .first_sample = start.first_sample,
+                    .num_samples = start.num_samples
+                }
+            };
+
+            status = start_options_valid(&options) ? start_capture(&options) : CONTROL_STATUS_INVALID;
+            break;
         }
 
-        if (xensiv_bgt60trxx_start_frame(&sensor.dev, false) == XENSIV_BGT60TRXX_STATUS_OK)
+        case CONTROL_OP_STOP:
+            status = stop_capture();
+            break;
+
+        case CONTROL_OP_GET_STATUS:
+            device_status = (control_status_data_t) {
+                .capture_enabled = capture_enabled ? 1U : 0U,
+                .stream_active = binary_stream_active ? 1U : 0U,
+                .sample_format = stream_format,
+                .frames_captured = capture_frame_index,
+                .frames_sent = frame_ring.tail,
+                .frames_dropped = frame_ring.dropped,
+                .samples_per_chirp = (uint16_t)geometry.num_samples_per_chirp,
+                .num_chirps = (uint16_t)geometry.num_chirps,
+                .num_rx = (uint8_t)geometry.num_rx,
+                .custom_profile = custom_profile_active ? 1U : 0U,
+                .staged_regs = (uint16_t)profile_num_regs
+            };
+            data = &device_status;
+            length = sizeof(device_status);
+            break;
+
+        case CONTROL_OP_PROFILE_CLEAR:
+            if (busy)
+            {
+                status = CONTROL_STATUS_BUSY;
+                break;
+            }
+
+            profile_num_regs = 0U;
+            break;
+
+        case CONTROL_OP_PROFILE_REG:
         {
-            capture_enabled = false;
-            data_available = false;
-            frame_limit_enabled = false;
-            frame_limit_total = 0U;
-            frame_limit_sent = 0U;
-            binary_stream_active = false;
-            status_printf("Capture stopped.\r\n");
+            const uint32_t count = request->length / sizeof(uint32_t);
+
+            if (busy)
+            {
+                status = CONTROL_STATUS_BUSY;
+            }
+            else if ((request->length % sizeof(uint32_t)) != 0U)
+            {
+                status = CONTROL_STATUS_BAD_LENGTH;
+            }
+            else if ((profile_num_regs + count) > RADAR_PROFILE_MAX_REGS)
+            {
+                status = CONTROL_STATUS_INVALID;
+            }
+            else
+            {
+                memcpy(&profile_regs[profile_num_regs], payload, request->length);
+                profile_num_regs += count;
+            }
+            break;
         }
-        else
+
+        case CONTROL_OP_PROFILE_APPLY:
         {
-            status_printf("Failed to stop capture.\r\n");
+            uint32_t values[3];
+
+            if (busy)
+            {
+                status = CONTROL_STATUS_BUSY;
+                break;
+            }
+
+            if (request->length != sizeof(values))
+            {
+                status = CONTROL_STATUS_BAD_LENGTH;
+                break;
+            }
+
+            memcpy(values, payload, sizeof(values));
+
+            const frame_geometry_t new_geometry = {
+                .num_samples_per_chirp = values[0],
+                .num_chirps = values[1],
+                .num_rx = values[2]
+            };
+
+            if ((profile_num_regs == 0U) || !profile_geometry_valid(&new_geometry))
+            {
+                status = CONTROL_STATUS_INVALID;
+            }
+            else if (apply_profile(profile_regs, profile_num_regs, &new_geometry))
+            {
+                custom_profile_active = true;
+            }
+            else
+            {
+                status = CONTROL_STATUS_FAILED;
+                (void)restore_default_profile();
+            }
+            break;
         }
+
+        case CONTROL_OP_PROFILE_DEFAULT:
+            if (busy)
+            {
+                status = CONTROL_STATUS_BUSY;
+            }
+            else if (!restore_default_profile())
+            {
+                status = CONTROL_STATUS_FAILED;
+            }
+            break;
+
+        default:
+            status = CONTROL_STATUS_UNKNOWN_OPCODE;
+            break;
     }
-    else if (*cmd != '\0')
-    {
-        status_printf("Unknown command: %s\r\n", cmd);
-    }
+
+    queue_response(request, status, data, length);
 }
 
 static void process_cli(void)
 {
-    static char cmd_buffer[32];
+    static char cmd_buffer[64];
     static uint32_t cmd_index = 0;
+    uint32_t start = stage_begin();
+    bool received = false;
 
     while (cyhal_uart_readable(&cy_retarget_io_uart_obj) > 0)
     {
+        /* A request that cannot be answered yet stays in the UART FIFO. */
+        if (!control_response_space())
+        {
+            break;
+        }
+
         uint8_t ch = 0;
         if (cyhal_uart_getc(&cy_retarget_io_uart_obj, &ch, 1) != CY_RSLT_SUCCESS)
         {
             break;
         }
 
+        received = true;
+
+        if (!control_parser_idle(&control_parser) || ((cmd_index == 0U) && (ch == CONTROL_SYNC)))
+        {
+            switch (control_parser_feed(&control_parser, ch))
+            {
+                case CONTROL_PARSE_DONE:
+                    control_active = true;
+                    handle_request(&control_parser.header, control_parser.payload);
+                    break;
+
+                case CONTROL_PARSE_BAD_LENGTH:
+                    queue_response(&control_parser.header, CONTROL_STATUS_BAD_LENGTH, NULL, 0U);
+                    break;
+
+                case CONTROL_PARSE_BAD_CRC:
+                    queue_response(&control_parser.header, CONTROL_STATUS_BAD_CRC, NULL, 0U);
+                    break;
+
+                default:
+                    break;
+            }
+
+            continue;
+        }
+
         if ((ch == '\r') || (ch == '\n'))
         {
             if (cmd_index > 0)
             {
                 cmd_buffer[cmd_index] = '\0';
+                control_active = false;
                 handle_command(cmd_buffer);
                 cmd_index = 0;
             }
@@ -453,5 +3655,10 @@ static void process_cli(void)
             }
         }
     }
+
+    if (received)
+    {
+        stage_end(STAGE_CLI, start);
+    }
 }
 
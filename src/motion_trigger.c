@@ -0,0 +1,90 @@
+#include <stddef.h>
+#include <string.h>
+
+#include "motion_trigger.h"
+
+static uint16_t reference[MOTION_TRIGGER_MAX_VALUES];
+static uint32_t values = 0U;
+static uint32_t trigger_ratio = 0U;
+static uint32_t frames = 0U;
+static uint64_t background = 0U;
+static uint32_t last_ratio = 0U;
+
+void motion_trigger_init(uint32_t num_values, uint32_t ratio)
+{
+    values = (num_values < MOTION_TRIGGER_MAX_VALUES) ? num_values : MOTION_TRIGGER_MAX_VALUES;
+    trigger_ratio = ratio;
+    motion_trigger_reset();
+}
+
+void motion_trigger_reset(void)
+{
+    frames = 0U;
+    background = 0U;
+    last_ratio = 0U;
+}
+
+bool motion_trigger_process(const uint16_t *chirp)
+{
+    if ((chirp == NULL) || (values == 0U))
+    {
+        return false;
+    }
+
+    if (frames == 0U)
+    {
+        memcpy(reference, chirp, values * sizeof(uint16_t));
+        frames++;
+        return false;
+    }
+
+    uint64_t energy = 0U;
+
+    for (uint32_t i = 0U; i < values; i++)
+    {
+        const int32_t diff = (int32_t)chirp[i] - (int32_t)reference[i];
+
+        energy += (uint64_t)((uint32_t)(diff * diff));
+        reference[i] = chirp[i];
+    }
+
+    const uint64_t level = energy / values;
+
+    if (background > 0U)
+    {
+        const uint64_t ratio = (level << 4) / background;
+
+        last_ratio = (ratio > UINT32_MAX) ? UINT32_MAX : (uint32_t)ratio;
+    }
+
+    if ((frames > MOTION_TRIGGER_WARMUP_FRAMES) && (level > ((uint64_t)trigger_ratio * background)))
+    {
+        return true;
+    }
+
+    /* Seed the background with the first difference, then average. */
+    if (frames == 1U)
+    {
+        background = level;
+    }
+    else if (level >= background)
+    {
+        background += (level - background) >> MOTION_TRIGGER_BACKGROUND_SHIFT;
+    }
+    else
+    {
+        background -= (background - level) >> MOTION_TRIGGER_BACKGROUND_SHIFT;
+    }
+
+    if (frames <= MOTION_TRIGGER_WARMUP_FRAMES)
+    {
+        frames++;
+    }
+
+    return false;
+}
+
+uint32_t motion_trigger_last_ratio(void)
+{
+    return last_ratio;
+}
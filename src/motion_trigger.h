@@ -0,0 +1,41 @@
+#ifndef MOTION_TRIGGER_H
+#define MOTION_TRIGGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest chirp (samples times antennas) the trigger keeps a reference of. */
+#ifndef MOTION_TRIGGER_MAX_VALUES
+#define MOTION_TRIGGER_MAX_VALUES           (1536U)
+#endif
+
+/* Frames after a reset that only train the background level. */
+#define MOTION_TRIGGER_WARMUP_FRAMES        (8U)
+
+/* log2 of the frames the background level averages over. */
+#define MOTION_TRIGGER_BACKGROUND_SHIFT     (4U)
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Configures the trigger for chirps of num_values raw samples and clears its
+   state. It fires on frames whose motion energy exceeds ratio times the
+   background level. */
+void motion_trigger_init(uint32_t num_values, uint32_t ratio);
+
+/* Forgets the reference chirp and the background level. */
+void motion_trigger_reset(void);
+
+/* Two-pulse MTI on one chirp per frame: the energy of the difference to the
+   same chirp of the previous frame, which cancels static targets, is compared
+   with its running background level. Quiet frames update the background.
+   Returns true if the frame shows motion. */
+bool motion_trigger_process(const uint16_t *chirp);
+
+/* Motion energy of the last frame relative to the background, in 1/16. */
+uint32_t motion_trigger_last_ratio(void);
+
+#endif /* MOTION_TRIGGER_H */
@@ -0,0 +1,33 @@
+#include "packed12.h"
+
+void packed12_pack(const uint16_t *src, uint8_t *dst, uint32_t num_samples)
+{
+    for (uint32_t i = 0U; i < num_samples; i += 2U)
+    {
+        uint16_t s0 = src[0] & 0x0FFFU;
+        uint16_t s1 = src[1] & 0x0FFFU;
+
+        dst[0] = (uint8_t)(s0 >> 4U);
+        dst[1] = (uint8_t)(((s0 & 0x0FU) << 4U) | (s1 >> 8U));
+        dst[2] = (uint8_t)(s1 & 0xFFU);
+
+        src += 2U;
+        dst += 3U;
+    }
+}
+
+void packed12_unpack(const uint8_t *src, uint16_t *dst, uint32_t num_samples)
+{
+    for (uint32_t i = 0U; i < num_samples; i += 2U)
+    {
+        uint8_t b0 = src[0];
+        uint8_t b1 = src[1];
+        uint8_t b2 = src[2];
+
+        dst[0] = (uint16_t)(((uint16_t)b0 << 4U) | ((uint16_t)b1 >> 4U));
+        dst[1] = (uint16_t)((((uint16_t)b1 & 0x0FU) << 8U) | (uint16_t)b2);
+
+        src += 3U;
+        dst += 2U;
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef PACKED12_H
+#define PACKED12_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Packed12 stores two 12-bit samples in three bytes:
+   b0 = s0[11:4], b1 = s0[3:0] << 4 | s1[11:8], b2 = s1[7:0].
+   This is the BGT60TRxx FIFO burst layout and the layout decoded by strata's
+   unpackPacked12() (common/Packed12.hpp). */
+#define PACKED12_BYTES(num_samples)         ((((num_samples) + 1U) / 2U) * 3U)
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Packs num_samples (even) values. dst may alias src: the write cursor stays
+   behind the read cursor. */
+void packed12_pack(const uint16_t *src, uint8_t *dst, uint32_t num_samples);
+
+/* Unpacks num_samples (even) values. dst may alias src only if src starts at
+   least num_samples / 2 bytes after dst, as with a burst stored at the tail
+   of the destination buffer. */
+void packed12_unpack(const uint8_t *src, uint16_t *dst, uint32_t num_samples);
+
+#endif /* PACKED12_H */
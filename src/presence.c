@@ -0,0 +1,105 @@
+#include <math.h>
+#include <stddef.h>
+
+#include "presence.h"
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static presence_config_t presence_config;
+static uint32_t presence_num_bins = 0U;
+static float mti_history[PRESENCE_MAX_BINS];
+static bool history_valid = false;
+
+static bool present = false;
+static uint32_t quiet_frames = 0U;
+static uint32_t last_peak_bin = 0U;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+void presence_init(const presence_config_t *config, uint32_t num_bins)
+{
+    if (config == NULL)
+    {
+        return;
+    }
+
+    presence_config = *config;
+    presence_num_bins = (num_bins > PRESENCE_MAX_BINS) ? PRESENCE_MAX_BINS : num_bins;
+
+    if (presence_config.max_bin >= presence_num_bins)
+    {
+        presence_config.max_bin = presence_num_bins - 1U;
+    }
+
+    if (presence_config.min_bin > presence_config.max_bin)
+    {
+        presence_config.min_bin = presence_config.max_bin;
+    }
+
+    presence_reset();
+}
+
+void presence_reset(void)
+{
+    history_valid = false;
+    present = false;
+    quiet_frames = 0U;
+    last_peak_bin = 0U;
+}
+
+void presence_process(const float *profile, presence_result_t *result)
+{
+    if ((profile == NULL) || (result == NULL) || (presence_num_bins == 0U))
+    {
+        return;
+    }
+
+    uint32_t peak_bin = presence_config.min_bin;
+    float peak_level = 0.0f;
+
+    if (!history_valid)
+    {
+        for (uint32_t k = 0U; k < presence_num_bins; k++)
+        {
+            mti_history[k] = profile[k];
+        }
+
+        history_valid = true;
+    }
+    else
+    {
+        for (uint32_t k = 0U; k < presence_num_bins; k++)
+        {
+            const float moving = profile[k] - mti_history[k];
+
+            mti_history[k] += presence_config.mti_alpha * moving;
+
+            if ((k >= presence_config.min_bin) && (k <= presence_config.max_bin) &&
+                (fabsf(moving) > peak_level))
+            {
+                peak_level = fabsf(moving);
+                peak_bin = k;
+            }
+        }
+    }
+
+    bool was_present = present;
+
+    if (peak_level >= presence_config.threshold)
+    {
+        present = true;
+        quiet_frames = 0U;
+        last_peak_bin = peak_bin;
+    }
+    else if (present && (++quiet_frames > presence_config.hold_frames))
+    {
+        present = false;
+    }
+
+    result->present = present;
+    result->changed = (present != was_present);
+    result->peak_bin = present ? last_peak_bin : peak_bin;
+    result->peak_level = peak_level;
+}
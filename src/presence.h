@@ -0,0 +1,51 @@
+#ifndef PRESENCE_H
+#define PRESENCE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest range profile the detector keeps MTI history for. */
+#ifndef PRESENCE_MAX_BINS
+#define PRESENCE_MAX_BINS                   (256U)
+#endif
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    float mti_alpha;            /* weight of the newest profile in the background, 0 ... 1 */
+    float threshold;            /* MTI peak (ADC counts) that counts as presence */
+    uint32_t min_bin;           /* first range bin searched */
+    uint32_t max_bin;           /* last range bin searched */
+    uint32_t hold_frames;       /* quiet frames before absence is reported */
+} presence_config_t;
+
+typedef struct
+{
+    bool present;
+    bool changed;               /* present differs from the previous frame */
+    uint32_t peak_bin;          /* strongest moving target; last one seen while holding */
+    float peak_level;           /* its MTI magnitude in ADC counts */
+} presence_result_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Configures the detector for range profiles of num_bins values and clears
+   its state. Bins outside [min_bin, max_bin] are clipped to the profile. */
+void presence_init(const presence_config_t *config, uint32_t num_bins);
+
+/* Forgets the MTI background and the presence state. */
+void presence_reset(void);
+
+/* Runs the MTI filter (ifx_mti_run: output = input - history,
+   history += alpha * output) over one range profile and searches the moving
+   part for the strongest target. The first profile after a reset only seeds
+   the background. */
+void presence_process(const float *profile, presence_result_t *result);
+
+#endif /* PRESENCE_H */
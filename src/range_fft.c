@@ -0,0 +1,271 @@
+#include <math.h>
+#include <stddef.h>
+
+#include "range_fft.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define RANGE_FFT_PI                        (3.14159265358979f)
+
+/*******************************************************************************
+* Global variables
+*******************************************************************************/
+static uint32_t fft_size = 0U;
+
+/* Window coefficients divided by their sum (unit coherent gain). */
+static float window[RANGE_FFT_MAX_SIZE];
+/* W_N^k = cos(2 pi k / N) - j sin(2 pi k / N) for k < N / 2, as re, im. */
+static float twiddle[RANGE_FFT_MAX_SIZE];
+/* Bit-reversal permutation of the N / 2 point complex FFT. */
+static uint16_t bit_reverse[RANGE_FFT_MAX_SIZE / 2U];
+/* N / 2 complex values as re, im. */
+static float work[RANGE_FFT_MAX_SIZE];
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+cy_rslt_t range_fft_init(uint32_t size)
+{
+    if ((size < 4U) || (size > RANGE_FFT_MAX_SIZE) || ((size & (size - 1U)) != 0U))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    const float a0 = 0.35875f;
+    const float a1 = 0.48829f;
+    const float a2 = 0.14128f;
+    const float a3 = 0.01168f;
+    const float scale = RANGE_FFT_PI / (float)(size - 1U);
+    float sum = 0.0f;
+
+    /* Same coefficients as ifx_window_init(IFX_WINDOW_BLACKMANHARRIS). */
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        const float phi = scale * (float)i;
+
+        window[i] = a0 - (a1 * cosf(2.0f * phi)) + (a2 * cosf(4.0f * phi)) - (a3 * cosf(6.0f * phi));
+        sum += window[i];
+    }
+
+    for (uint32_t i = 0U; i < size; i++)
+    {
+        window[i] /= sum;
+    }
+
+    const uint32_t half = size / 2U;
+
+    for (uint32_t k = 0U; k < half; k++)
+    {
+        const float phi = (2.0f * RANGE_FFT_PI * (float)k) / (float)size;
+
+        twiddle[2U * k] = cosf(phi);
+        twiddle[(2U * k) + 1U] = -sinf(phi);
+    }
+
+    uint32_t bits = 0U;
+
+    while ((1UL << bits) < half)
+    {
+        bits++;
+    }
+
+    for (uint32_t n = 0U; n < half; n++)
+    {
+        uint32_t r = 0U;
+
+        for (uint32_t b = 0U; b < bits; b++)
+        {
+            r |= ((n >> b) & 1U) << (bits - 1U - b);
+        }
+
+        bit_reverse[n] = (uint16_t)r;
+    }
+
+    fft_size = size;
+    return CY_RSLT_SUCCESS;
+}
+
+static int16_t to_fixed(float value)
+{
+    value *= (float)(1UL << RANGE_FFT_FRAC_BITS);
+    value += (value >= 0.0f) ? 0.5f : -0.5f;
+
+    if (value >= 32767.0f)
+    {
+        return INT16_MAX;
+    }
+
+    if (value <= -32768.0f)
+    {
+        return INT16_MIN;
+    }
+
+    return (int16_t)value;
+}
+
+static uint16_t to_fixed_unsigned(float value)
+{
+    value = (value * (float)(1UL << RANGE_FFT_FRAC_BITS)) + 0.5f;
+
+    if (value >= 65535.0f)
+    {
+        return UINT16_MAX;
+    }
+
+    return (uint16_t)value;
+}
+
+/* Loads one chirp as the N / 2 point complex sequence z[n] = x[2n] + j x[2n+1]
+   in bit-reversed order and runs an in-place radix-2 FFT on it. */
+static void transform_chirp(const uint16_t *in, uint32_t stride)
+{
+    const uint32_t half = fft_size / 2U;
+    float mean = 0.0f;
+
+    for (uint32_t i = 0U; i < fft_size; i++)
+    {
+        mean += (float)in[i * stride];
+    }
+
+    mean /= (float)fft_size;
+
+    for (uint32_t n = 0U; n < half; n++)
+    {
+        const uint32_t i = 2U * n;
+        float *dst = &work[2U * bit_reverse[n]];
+
+        dst[0] = ((float)in[i * stride] - mean) * window[i];
+        dst[1] = ((float)in[(i + 1U) * stride] - mean) * window[i + 1U];
+    }
+
+    for (uint32_t len = 2U; len <= half; len <<= 1)
+    {
+        /* W_len^j = W_N^(j * N / len) */
+        const uint32_t step = fft_size / len;
+
+        for (uint32_t start = 0U; start < half; start += len)
+        {
+            for (uint32_t j = 0U; j < (len / 2U); j++)
+            {
+                const float wr = twiddle[2U * j * step];
+                const float wi = twiddle[(2U * j * step) + 1U];
+                float *a = &work[2U * (start + j)];
+                float *b = &work[2U * (start + j + (len / 2U))];
+                const float tr = (b[0] * wr) - (b[1] * wi);
+                const float ti = (b[0] * wi) + (b[1] * wr);
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+
+/* Bin k of the real input's spectrum from the half-size transform in work:
+   X[k] = E[k] + W_N^k O[k] with E[k] = (Z[k] + conj(Z[M-k])) / 2 and
+   O[k] = -j (Z[k] - conj(Z[M-k])) / 2. */
+static void spectrum_bin(uint32_t k, float *re, float *im)
+{
+    const uint32_t half = fft_size / 2U;
+    const uint32_t m = (half - k) % half;
+    const float zr = work[2U * k];
+    const float zi = work[(2U * k) + 1U];
+    const float cr = work[2U * m];
+    const float ci = -work[(2U * m) + 1U];
+    const float even_r = 0.5f * (zr + cr);
+    const float even_i = 0.5f * (zi + ci);
+    const float odd_r = 0.5f * (zi - ci);
+    const float odd_i = -0.5f * (zr - cr);
+    const float wr = twiddle[2U * k];
+    const float wi = twiddle[(2U * k) + 1U];
+
+    *re = even_r + ((wr * odd_r) - (wi * odd_i));
+    *im = even_i + ((wr * odd_i) + (wi * odd_r));
+}
+
+uint32_t range_fft_frame(const uint16_t *frame, uint32_t num_chirps, uint32_t num_rx,
+                         bool magnitude, uint8_t *out)
+{
+    if ((frame == NULL) || (out == NULL) || (fft_size == 0U))
+    {
+        return 0U;
+    }
+
+    const uint32_t half = fft_size / 2U;
+    int16_t *out_complex = (int16_t *)out;
+    uint16_t *out_magnitude = (uint16_t *)out;
+
+    for (uint32_t chirp = 0U; chirp < num_chirps; chirp++)
+    {
+        for (uint32_t rx = 0U; rx < num_rx; rx++)
+        {
+            transform_chirp(&frame[(chirp * fft_size * num_rx) + rx], num_rx);
+
+            for (uint32_t k = 0U; k < half; k++)
+            {
+                const uint32_t bin = (((chirp * half) + k) * num_rx) + rx;
+                float xr;
+                float xi;
+
+                spectrum_bin(k, &xr, &xi);
+
+                if (magnitude)
+                {
+                    out_magnitude[bin] = to_fixed_unsigned(sqrtf((xr * xr) + (xi * xi)));
+                }
+                else
+                {
+                    out_complex[2U * bin] = to_fixed(xr);
+                    out_complex[(2U * bin) + 1U] = to_fixed(xi);
+                }
+            }
+        }
+    }
+
+    return num_chirps * half * num_rx * (magnitude ? RANGE_FFT_MAGNITUDE_BYTES : RANGE_FFT_COMPLEX_BYTES);
+}
+
+uint32_t range_fft_profile(const uint16_t *frame, uint32_t num_chirps, uint32_t num_rx,
+                           float *profile)
+{
+    if ((frame == NULL) || (profile == NULL) || (fft_size == 0U) ||
+        (num_chirps == 0U) || (num_rx == 0U))
+    {
+        return 0U;
+    }
+
+    const uint32_t half = fft_size / 2U;
+    const float scale = 1.0f / (float)(num_chirps * num_rx);
+
+    for (uint32_t k = 0U; k < half; k++)
+    {
+        profile[k] = 0.0f;
+    }
+
+    for (uint32_t chirp = 0U; chirp < num_chirps; chirp++)
+    {
+        for (uint32_t rx = 0U; rx < num_rx; rx++)
+        {
+            transform_chirp(&frame[(chirp * fft_size * num_rx) + rx], num_rx);
+
+            for (uint32_t k = 0U; k < half; k++)
+            {
+                float xr;
+                float xi;
+
+                spectrum_bin(k, &xr, &xi);
+                profile[k] += sqrtf((xr * xr) + (xi * xi));
+            }
+        }
+    }
+
+    for (uint32_t k = 0U; k < half; k++)
+    {
+        profile[k] *= scale;
+    }
+
+    return half;
+}
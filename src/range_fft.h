@@ -0,0 +1,48 @@
+#ifndef RANGE_FFT_H
+#define RANGE_FFT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Largest supported FFT length (samples per chirp). Sizes the static window,
+   twiddle and work tables. */
+#ifndef RANGE_FFT_MAX_SIZE
+#define RANGE_FFT_MAX_SIZE                  (512U)
+#endif
+
+/* Output bins are fixed point in ADC counts with this many fractional bits.
+   The window is normalized to unit coherent gain, so a bin never exceeds
+   4095 counts and a full-scale tone stays below 1024. */
+#define RANGE_FFT_FRAC_BITS                 (4U)
+
+/* Bytes per output bin: int16 re, im pair or uint16 magnitude. */
+#define RANGE_FFT_COMPLEX_BYTES             (4U)
+#define RANGE_FFT_MAGNITUDE_BYTES           (2U)
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Precomputes the Blackman-Harris window and twiddles for fft_size samples
+   per chirp (power of two, 4 ... RANGE_FFT_MAX_SIZE). */
+cy_rslt_t range_fft_init(uint32_t fft_size);
+
+/* Range FFT of every chirp and antenna of a frame stored as
+   [chirp][sample][rx], following ifx_ppfft_run_rc(): mean removal, window,
+   real-input FFT. Only the fft_size / 2 positive-frequency bins are kept and
+   written as [chirp][bin][rx], either as complex int16 pairs or as uint16
+   magnitudes. Returns the number of bytes written to out. */
+uint32_t range_fft_frame(const uint16_t *frame, uint32_t num_chirps, uint32_t num_rx,
+                         bool magnitude, uint8_t *out);
+
+/* Same transform, but averages the bin magnitudes over all chirps and
+   antennas into fft_size / 2 values in ADC counts. Returns the number of
+   bins written to profile. */
+uint32_t range_fft_profile(const uint16_t *frame, uint32_t num_chirps, uint32_t num_rx,
+                           float *profile);
+
+#endif /* RANGE_FFT_H */
@@ -0,0 +1,125 @@
+#include <stdbool.h>
+
+#include "rice_codec.h"
+
+typedef struct
+{
+    uint8_t *out;
+    uint32_t capacity;
+    uint32_t pos;       /* bytes completed */
+    uint32_t acc;       /* pending bits, right aligned */
+    uint32_t acc_bits;
+    bool overflow;
+} bit_writer_t;
+
+static void put_bits(bit_writer_t *bw, uint32_t value, uint32_t bits)
+{
+    /* bits <= 24 keeps acc within 32 bits (at most 7 bits are pending) */
+    bw->acc = (bw->acc << bits) | (value & ((1UL << bits) - 1U));
+    bw->acc_bits += bits;
+
+    while (bw->acc_bits >= 8U)
+    {
+        bw->acc_bits -= 8U;
+
+        if (bw->pos >= bw->capacity)
+        {
+            bw->overflow = true;
+            return;
+        }
+
+        bw->out[bw->pos++] = (uint8_t)(bw->acc >> bw->acc_bits);
+    }
+}
+
+static void put_ones(bit_writer_t *bw, uint32_t count)
+{
+    while (count > 16U)
+    {
+        put_bits(bw, 0xFFFFU, 16U);
+        count -= 16U;
+    }
+
+    put_bits(bw, (1UL << count) - 1U, count);
+}
+
+static inline int32_t predict(const uint16_t *samples, uint32_t i, uint32_t chirp_stride,
+                              uint32_t num_lanes)
+{
+    if (i >= chirp_stride)
+    {
+        return (int32_t)samples[i - chirp_stride];
+    }
+
+    if (i >= num_lanes)
+    {
+        return (int32_t)samples[i - num_lanes];
+    }
+
+    return RICE_MIDSCALE;
+}
+
+static inline uint32_t zigzag(int32_t residual)
+{
+    return (residual >= 0) ? ((uint32_t)residual << 1U) : (((uint32_t)(-residual) << 1U) - 1U);
+}
+
+uint32_t rice_encode(const uint16_t *samples, uint32_t num_chirps, uint32_t chirp_stride,
+                     uint32_t num_lanes, uint8_t *out, uint32_t out_capacity)
+{
+    bit_writer_t bw = {
+        .out = out,
+        .capacity = out_capacity,
+        .pos = 0U,
+        .acc = 0U,
+        .acc_bits = 0U,
+        .overflow = false
+    };
+
+    for (uint32_t chirp = 0U; (chirp < num_chirps) && !bw.overflow; ++chirp)
+    {
+        uint32_t first = chirp * chirp_stride;
+        uint32_t last = first + chirp_stride;
+        uint32_t sum = 0U;
+
+        for (uint32_t i = first; i < last; ++i)
+        {
+            sum += zigzag((int32_t)samples[i] - predict(samples, i, chirp_stride, num_lanes));
+        }
+
+        /* Smallest k with 2^k * count >= sum, i.e. k ~ log2(mean). */
+        uint32_t k = 0U;
+
+        while ((k < ((1U << RICE_K_BITS) - 1U)) && ((chirp_stride << k) < sum))
+        {
+            ++k;
+        }
+
+        put_bits(&bw, k, RICE_K_BITS);
+
+        for (uint32_t i = first; (i < last) && !bw.overflow; ++i)
+        {
+            uint32_t v = zigzag((int32_t)samples[i] - predict(samples, i, chirp_stride, num_lanes));
+            uint32_t q = v >> k;
+
+            if (q < RICE_ESCAPE)
+            {
+                put_ones(&bw, q);
+                put_bits(&bw, 0U, 1U);
+                put_bits(&bw, v, k);
+            }
+            else
+            {
+                put_ones(&bw, RICE_ESCAPE);
+                put_bits(&bw, v, RICE_RAW_BITS);
+            }
+        }
+    }
+
+    if ((bw.acc_bits > 0U) && !bw.overflow)
+    {
+        put_bits(&bw, 0U, 8U - bw.acc_bits);
+    }
+
+    return bw.overflow ? 0U : bw.pos;
+}
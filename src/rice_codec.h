@@ -0,0 +1,32 @@
+#ifndef RICE_CODEC_H
+#define RICE_CODEC_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bitstream (MSB first within each byte), one block per chirp:
+     4 bits  k     Rice parameter of the block
+     per sample:   zigzag(residual) as q = v >> k ones, a zero, k low bits;
+                   q >= RICE_ESCAPE is sent as RICE_ESCAPE ones and v in
+                   RICE_RAW_BITS bits.
+   Residuals: sample minus the same sample/antenna of the previous chirp;
+   in the first chirp minus the previous sample of the same antenna; the
+   very first sample of each antenna minus RICE_MIDSCALE. */
+#define RICE_K_BITS                         (4U)
+#define RICE_ESCAPE                         (24U)
+#define RICE_RAW_BITS                       (13U)
+#define RICE_MIDSCALE                       (2048)
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Encodes num_chirps * chirp_stride samples, where chirp_stride is the number
+   of interleaved values per chirp and num_lanes the number of interleaved
+   antennas. Returns the number of bytes written, or 0 if the result would not
+   fit into out_capacity (the caller then sends the frame uncompressed). */
+uint32_t rice_encode(const uint16_t *samples, uint32_t num_chirps, uint32_t chirp_stride,
+                     uint32_t num_lanes, uint8_t *out, uint32_t out_capacity);
+
+#endif /* RICE_CODEC_H */
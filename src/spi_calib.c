@@ -0,0 +1,149 @@
+#include <stddef.h>
+
+#include "spi_calib.h"
+
+/* Register list words carry the address above the 24 data bits and the
+   write flag. */
+#define SPI_CALIB_REG_ADDR_POS              (25U)
+#define SPI_CALIB_REG_DATA_MSK              (0x00FFFFFFUL)
+
+/* The main register holds self-clearing reset and start bits. */
+#define SPI_CALIB_REG_MAIN                  (0x00U)
+
+static const uint32_t drive_levels[] = {
+    CY_GPIO_DRIVE_1_8, CY_GPIO_DRIVE_1_4, CY_GPIO_DRIVE_1_2, CY_GPIO_DRIVE_FULL
+};
+
+static uint32_t reference[SPI_CALIB_MAX_REGS];
+
+static void set_drive(const cyhal_gpio_t *pins, uint32_t num_pins, uint32_t drive_sel)
+{
+    for (uint32_t i = 0U; i < num_pins; i++)
+    {
+        Cy_GPIO_SetDriveSel(CYHAL_GET_PORTADDR(pins[i]), CYHAL_GET_PIN(pins[i]), drive_sel);
+    }
+}
+
+/* Reads every register of the list once. With expected == NULL the values
+   are stored as the reference, otherwise compared against it. */
+static bool read_registers(const xensiv_bgt60trxx_t *dev, const uint32_t *regs, uint32_t num_regs,
+                           const uint32_t *expected)
+{
+    for (uint32_t i = 0U; i < num_regs; i++)
+    {
+        const uint32_t addr = regs[i] >> SPI_CALIB_REG_ADDR_POS;
+        uint32_t value = 0U;
+
+        if (addr == SPI_CALIB_REG_MAIN)
+        {
+            continue;
+        }
+
+        if (xensiv_bgt60trxx_get_reg(dev, addr, &value) != XENSIV_BGT60TRXX_STATUS_OK)
+        {
+            return false;
+        }
+
+        value &= SPI_CALIB_REG_DATA_MSK;
+
+        if (expected == NULL)
+        {
+            reference[i] = value;
+        }
+        else if (value != expected[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool step_passes(const xensiv_bgt60trxx_t *dev, const uint32_t *regs, uint32_t num_regs)
+{
+    for (uint32_t round = 0U; round < SPI_CALIB_ROUNDS; round++)
+    {
+        if (!read_registers(dev, regs, num_regs, reference))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+cy_rslt_t spi_calib_run(xensiv_bgt60trxx_mtb_t *sensor,
+                        const uint32_t *regs, uint32_t num_regs,
+                        const cyhal_gpio_t *pins, uint32_t num_pins,
+                        uint32_t base_hz, spi_calib_result_t *result)
+{
+    if ((sensor == NULL) || (regs == NULL) || (num_regs == 0U) || (num_regs > SPI_CALIB_MAX_REGS) ||
+        (pins == NULL) || (num_pins > SPI_CALIB_MAX_PINS) || (base_hz == 0U) || (result == NULL))
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    const uint32_t num_levels = (uint32_t)(sizeof(drive_levels) / sizeof(drive_levels[0]));
+
+    result->frequency_hz = base_hz;
+    result->drive_sel = drive_levels[0];
+    result->steps_passed = 0U;
+    result->failed_hz = 0U;
+
+    set_drive(pins, num_pins, drive_levels[0]);
+
+    if ((cyhal_spi_set_frequency(sensor->iface.spi, base_hz) != CY_RSLT_SUCCESS) ||
+        !read_registers(&sensor->dev, regs, num_regs, NULL) ||
+        !step_passes(&sensor->dev, regs, num_regs))
+    {
+        (void)cyhal_spi_set_frequency(sensor->iface.spi, base_hz);
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    for (uint32_t hz = base_hz + SPI_CALIB_STEP_HZ; hz <= SPI_CALIB_MAX_HZ; hz += SPI_CALIB_STEP_HZ)
+    {
+        bool passed = false;
+
+        /* The SCB may not reach the step from its clock; that ends the
+           search like a failed read. */
+        if (cyhal_spi_set_frequency(sensor->iface.spi, hz) == CY_RSLT_SUCCESS)
+        {
+            for (uint32_t level = 0U; (level < num_levels) && !passed; level++)
+            {
+                set_drive(pins, num_pins, drive_levels[level]);
+
+                if (step_passes(&sensor->dev, regs, num_regs))
+                {
+                    result->frequency_hz = hz;
+                    result->drive_sel = drive_levels[level];
+                    result->steps_passed++;
+                    passed = true;
+                }
+            }
+        }
+
+        if (!passed)
+        {
+            result->failed_hz = hz;
+            break;
+        }
+    }
+
+    set_drive(pins, num_pins, result->drive_sel);
+    return cyhal_spi_set_frequency(sensor->iface.spi, result->frequency_hz);
+}
+
+const char *spi_calib_drive_name(uint32_t drive_sel)
+{
+    switch (drive_sel)
+    {
+        case CY_GPIO_DRIVE_FULL:
+            return "full";
+        case CY_GPIO_DRIVE_1_2:
+            return "1/2";
+        case CY_GPIO_DRIVE_1_4:
+            return "1/4";
+        default:
+            return "1/8";
+    }
+}
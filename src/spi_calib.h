@@ -0,0 +1,66 @@
+#ifndef SPI_CALIB_H
+#define SPI_CALIB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+#include "xensiv_bgt60trxx_mtb.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* 1: at startup the sensor SPI clock is raised from its fixed rate to the
+   fastest one spi_calib_run() verifies on this board. */
+#ifndef SPI_CLOCK_CALIBRATION
+#define SPI_CLOCK_CALIBRATION               (0)
+#endif
+
+/* Clock steps tried above the known-good rate, up to the sensor maximum. */
+#ifndef SPI_CALIB_STEP_HZ
+#define SPI_CALIB_STEP_HZ                   (5000000UL)
+#endif
+
+#ifndef SPI_CALIB_MAX_HZ
+#define SPI_CALIB_MAX_HZ                    (50000000UL)
+#endif
+
+/* Times the whole register list is read back at every step; one mismatch
+   rejects the step. */
+#ifndef SPI_CALIB_ROUNDS
+#define SPI_CALIB_ROUNDS                    (16U)
+#endif
+
+#define SPI_CALIB_MAX_REGS                  (64U)
+#define SPI_CALIB_MAX_PINS                  (3U)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t frequency_hz;          /* clock left on the bus */
+    uint32_t drive_sel;             /* CY_GPIO_DRIVE_* left on the output pins */
+    uint32_t steps_passed;          /* clock steps above the base that passed */
+    uint32_t failed_hz;             /* first step no drive strength passed, 0 if none */
+} spi_calib_result_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Finds the fastest sensor SPI clock that reads the configured registers
+   back intact. The sensor must be idle and configured with regs. The values
+   read at base_hz, the clock the board is known to work at, are the
+   reference; every step above it is tried with the weakest output drive
+   first, and the search stops at the first step no drive passes. pins are
+   the SPI outputs (SCLK, MOSI) whose drive strength may change. The bus is
+   left at the result, or at base_hz if the reference read fails. */
+cy_rslt_t spi_calib_run(xensiv_bgt60trxx_mtb_t *sensor,
+                        const uint32_t *regs, uint32_t num_regs,
+                        const cyhal_gpio_t *pins, uint32_t num_pins,
+                        uint32_t base_hz, spi_calib_result_t *result);
+
+/* "full", "1/2", "1/4" or "1/8". */
+const char *spi_calib_drive_name(uint32_t drive_sel);
+
+#endif /* SPI_CALIB_H */
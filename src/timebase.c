@@ -0,0 +1,94 @@
+#include "timebase.h"
+
+static cyhal_timer_t timebase_timer;
+static cyhal_lptimer_t wall_timer;
+static uint32_t wall_frequency_hz = 0U;
+static uint32_t wall_last_ticks = 0U;
+static uint64_t wall_ticks = 0U;
+static TCPWM_Type *attached_base = NULL;
+static uint32_t attached_counter = 0U;
+
+cy_rslt_t timebase_init(void)
+{
+    const cyhal_timer_cfg_t cfg = {
+        .is_continuous = true,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .period = UINT32_MAX,
+        .compare_value = 0U,
+        .value = 0U
+    };
+
+    cy_rslt_t result = cyhal_timer_init(&timebase_timer, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&timebase_timer, &cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&timebase_timer, TIMEBASE_FREQUENCY_HZ);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_start(&timebase_timer);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_lptimer_init(&wall_timer);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        cyhal_lptimer_info_t info;
+
+        cyhal_lptimer_get_info(&wall_timer, &info);
+        wall_frequency_hz = info.frequency_hz;
+        wall_last_ticks = cyhal_lptimer_read(&wall_timer);
+        wall_ticks = 0U;
+    }
+
+    return result;
+}
+
+uint32_t timebase_now_us(void)
+{
+    if (attached_base != NULL)
+    {
+        return Cy_TCPWM_Counter_GetCounter(attached_base, attached_counter);
+    }
+
+    return cyhal_timer_read(&timebase_timer);
+}
+
+void timebase_get_source(timebase_source_t *source)
+{
+    /* On the TCPWM version of this device the HAL channel is the PDL counter
+       number. */
+    source->base = timebase_timer.tcpwm.base;
+    source->counter = timebase_timer.tcpwm.resource.channel_num;
+}
+
+void timebase_attach(const timebase_source_t *source)
+{
+    attached_base = source->base;
+    attached_counter = source->counter;
+}
+
+uint64_t timebase_wall_us(void)
+{
+    uint32_t now = cyhal_lptimer_read(&wall_timer);
+
+    wall_ticks += (uint32_t)(now - wall_last_ticks);
+    wall_last_ticks = now;
+
+    if (wall_frequency_hz == 0U)
+    {
+        return 0U;
+    }
+
+    return (wall_ticks * TIMEBASE_FREQUENCY_HZ) / wall_frequency_hz;
+}
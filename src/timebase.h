@@ -0,0 +1,45 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TIMEBASE_FREQUENCY_HZ               (1000000UL)
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+/* Counter behind timebase_now_us(), so the other core can read the same
+   microsecond time. */
+typedef struct
+{
+    TCPWM_Type *base;
+    uint32_t counter;
+} timebase_source_t;
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Starts a free-running 32-bit microsecond counter (wraps after ~71 minutes)
+   and the low-power wall clock. Differences of two readings are valid across
+   a wrap. The microsecond counter halts while the CPU is in deep sleep. */
+cy_rslt_t timebase_init(void);
+uint32_t timebase_now_us(void);
+
+/* Microseconds since timebase_init() from the low-frequency timer, which keeps
+   running in deep sleep (resolution one LF clock tick, ~31 us). Call it from
+   thread context only, at least once per LF counter wrap (~36 hours). */
+uint64_t timebase_wall_us(void);
+
+void timebase_get_source(timebase_source_t *source);
+
+/* Makes timebase_now_us() read a counter that timebase_init() started on the
+   other core instead of starting one, e.g. on the CM0+ in the dual-core
+   build. The wall clock is not available after attaching. */
+void timebase_attach(const timebase_source_t *source);
+
+#endif /* TIMEBASE_H */
@@ -0,0 +1,97 @@
+#include <stddef.h>
+
+#include "timebase.h"
+#include "uart_baud.h"
+
+uint32_t uart_baud_achievable(cyhal_uart_t *uart, uint32_t current, uint32_t baud)
+{
+    uint32_t actual = 0U;
+    uint32_t restored = 0U;
+
+    if ((uart == NULL) || (baud < UART_BAUD_MIN) || (baud > UART_BAUD_MAX))
+    {
+        return 0U;
+    }
+
+    /* The probe reprograms the divider, so let the previous reply finish
+       at the running rate first. */
+    while (cyhal_uart_is_tx_active(uart))
+    {
+    }
+
+    if (cyhal_uart_set_baud(uart, baud, &actual) != CY_RSLT_SUCCESS)
+    {
+        actual = 0U;
+    }
+
+    (void)cyhal_uart_set_baud(uart, current, &restored);
+
+    uint32_t error = (actual > baud) ? (actual - baud) : (baud - actual);
+
+    if ((uint64_t)error * 1000U > (uint64_t)baud * UART_BAUD_TOLERANCE_PERMILLE)
+    {
+        return 0U;
+    }
+
+    return actual;
+}
+
+cy_rslt_t uart_baud_set(cyhal_uart_t *uart, uint32_t baud)
+{
+    uint32_t actual = 0U;
+
+    if (uart == NULL)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    while (cyhal_uart_is_tx_active(uart))
+    {
+    }
+
+    return cyhal_uart_set_baud(uart, baud, &actual);
+}
+
+bool uart_baud_read_line(cyhal_uart_t *uart, char *line, size_t size, uint32_t timeout_ms)
+{
+    uint32_t start = timebase_now_us();
+    size_t length = 0U;
+    bool overflow = false;
+
+    if ((uart == NULL) || (line == NULL) || (size == 0U))
+    {
+        return false;
+    }
+
+    while ((uint32_t)(timebase_now_us() - start) < (timeout_ms * 1000U))
+    {
+        uint8_t ch = 0U;
+
+        if (cyhal_uart_getc(uart, &ch, 1U) != CY_RSLT_SUCCESS)
+        {
+            continue;
+        }
+
+        if ((ch == '\r') || (ch == '\n'))
+        {
+            if ((length > 0U) && !overflow)
+            {
+                line[length] = '\0';
+                return true;
+            }
+
+            length = 0U;
+            overflow = false;
+        }
+        else if (length < (size - 1U))
+        {
+            line[length++] = (char)ch;
+        }
+        else
+        {
+            overflow = true;
+        }
+    }
+
+    return false;
+}
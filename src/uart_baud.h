@@ -0,0 +1,54 @@
+#ifndef UART_BAUD_H
+#define UART_BAUD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Rates 'baud' accepts. The KitProg3 USB-UART bridge tops out at 4 Mbaud;
+   override for a different bridge. */
+#ifndef UART_BAUD_MIN
+#define UART_BAUD_MIN                       (9600UL)
+#endif
+#ifndef UART_BAUD_MAX
+#define UART_BAUD_MAX                       (4000000UL)
+#endif
+
+/* Largest deviation of the rate the SCB clock divider reaches from the one
+   asked for, in 1/1000. */
+#define UART_BAUD_TOLERANCE_PERMILLE        (20U)
+
+/* Time each side gets for the next step of a negotiation at the new rate
+   before the firmware falls back. */
+#define UART_BAUD_STEP_TIMEOUT_MS           (2000U)
+
+/* Line the host sends at the new rate and the firmware echoes. Runs of
+   alternating bits (U, *), long runs of ones (~) and of zeros (@, 0) catch
+   both a wrong rate and marginal edges. */
+#define UART_BAUD_VERIFY_PATTERN            "UUUU****~~~~@@@@0000!!!!U*~@0!pz"
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Rate the SCB would run at for baud, without changing the running rate
+   current. Waits until the last byte has left the shift register, since
+   the divider is briefly reprogrammed. Returns 0 if the divider cannot come
+   within UART_BAUD_TOLERANCE_PERMILLE of it. */
+uint32_t uart_baud_achievable(cyhal_uart_t *uart, uint32_t current, uint32_t baud);
+
+/* Waits until the last byte has left the shift register, then switches the
+   rate. */
+cy_rslt_t uart_baud_set(cyhal_uart_t *uart, uint32_t baud);
+
+/* Reads one CR- or LF-terminated line of at most size - 1 characters into
+   line. Empty lines and lines that overflow are skipped, so noise from a
+   mismatched rate does not end the wait early. Returns false after
+   timeout_ms without a line. */
+bool uart_baud_read_line(cyhal_uart_t *uart, char *line, size_t size, uint32_t timeout_ms);
+
+#endif /* UART_BAUD_H */
@@ -0,0 +1,130 @@
+#include <stddef.h>
+
+#include "uart_tx.h"
+
+static cyhal_uart_t *tx_uart = NULL;
+static volatile bool tx_active = false;
+static volatile size_t tx_length = 0U;
+static volatile uart_tx_stats_t tx_stats;
+static uint8_t tx_intr_priority = 0U;
+static uart_tx_callback_t tx_callback = NULL;
+
+static void uart_tx_event_callback(void *callback_arg, cyhal_uart_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+
+    if ((event & CYHAL_UART_IRQ_RX_NOT_EMPTY) != 0U)
+    {
+        /* Level-triggered while the byte is unread: disarm until the next
+           sleep so the main loop gets to read it. */
+        cyhal_uart_enable_event(tx_uart, CYHAL_UART_IRQ_RX_NOT_EMPTY, tx_intr_priority, false);
+    }
+
+    if ((event & CYHAL_UART_IRQ_TX_ERROR) != 0U)
+    {
+        tx_stats.errors++;
+        tx_active = false;
+    }
+    else if ((event & CYHAL_UART_IRQ_TX_DONE) != 0U)
+    {
+        tx_stats.bytes_sent += (uint32_t)tx_length;
+        tx_stats.transfers++;
+        tx_active = false;
+    }
+
+    if (tx_callback != NULL)
+    {
+        tx_callback();
+    }
+}
+
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart, uint8_t intr_priority)
+{
+    if (uart == NULL)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    cy_rslt_t result = cyhal_uart_set_async_mode(uart, CYHAL_ASYNC_DMA, CYHAL_DMA_PRIORITY_DEFAULT);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        tx_uart = uart;
+        tx_intr_priority = intr_priority;
+        cyhal_uart_register_callback(uart, uart_tx_event_callback, NULL);
+        cyhal_uart_enable_event(uart,
+                                (cyhal_uart_event_t)(CYHAL_UART_IRQ_TX_DONE | CYHAL_UART_IRQ_TX_ERROR),
+                                intr_priority,
+                                true);
+    }
+
+    return result;
+}
+
+cy_rslt_t uart_tx_start(const void *data, size_t length)
+{
+    if ((tx_uart == NULL) || (data == NULL) || tx_active)
+    {
+        return CY_RSLT_TYPE_ERROR;
+    }
+
+    if (length == 0U)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    tx_length = length;
+    tx_active = true;
+
+    cy_rslt_t result = cyhal_uart_write_async(tx_uart, (void *)data, length);
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        tx_active = false;
+        tx_stats.errors++;
+    }
+
+    return result;
+}
+
+bool uart_tx_busy(void)
+{
+    return tx_active;
+}
+
+void uart_tx_wait(void)
+{
+    while (tx_active)
+    {
+    }
+}
+
+void uart_tx_arm_rx_wakeup(void)
+{
+    if (tx_uart != NULL)
+    {
+        cyhal_uart_enable_event(tx_uart, CYHAL_UART_IRQ_RX_NOT_EMPTY, tx_intr_priority, true);
+    }
+}
+
+void uart_tx_set_callback(uart_tx_callback_t callback)
+{
+    tx_callback = callback;
+}
+
+void uart_tx_get_stats(uart_tx_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        stats->bytes_sent = tx_stats.bytes_sent;
+        stats->transfers = tx_stats.transfers;
+        stats->errors = tx_stats.errors;
+    }
+}
+
+void uart_tx_reset_stats(void)
+{
+    tx_stats.bytes_sent = 0U;
+    tx_stats.transfers = 0U;
+    tx_stats.errors = 0U;
+}
@@ -0,0 +1,49 @@
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t bytes_sent;
+    uint32_t transfers;
+    uint32_t errors;
+} uart_tx_stats_t;
+
+/* Called from the UART interrupt after a transfer ended or the armed RX
+   wakeup fired. */
+typedef void (*uart_tx_callback_t)(void);
+
+/*******************************************************************************
+* Functions
+*******************************************************************************/
+/* Switches the UART to DMA-backed asynchronous transmit and hooks the
+   completion interrupt. The UART itself must already be initialized. */
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart, uint8_t intr_priority);
+
+/* Queues one buffer for transmission and returns immediately. The buffer must
+   stay untouched until uart_tx_busy() returns false. */
+cy_rslt_t uart_tx_start(const void *data, size_t length);
+bool uart_tx_busy(void);
+
+/* Blocks until the current transfer, if any, has left the UART. */
+void uart_tx_wait(void);
+
+/* Lets the next received byte raise an interrupt so that it wakes the CPU
+   from sleep. The interrupt disarms itself; the byte stays in the RX FIFO
+   for cyhal_uart_getc(). Re-arm before every sleep. */
+void uart_tx_arm_rx_wakeup(void);
+
+void uart_tx_set_callback(uart_tx_callback_t callback);
+
+void uart_tx_get_stats(uart_tx_stats_t *stats);
+void uart_tx_reset_stats(void);
+
+#endif /* UART_TX_H */